@@ -1332,7 +1332,7 @@ bool AgencyComm::unlock(std::string const& key, VPackSlice const& slice,
 
 AgencyCommResult AgencyComm::sendWithFailover(
     arangodb::rest::RequestType method, double const timeout,
-    std::string const& initialUrl, VPackSlice inBody) {
+    std::string const& initialUrl, VPackSlice inBody, double requestTimeout) {
 
   std::string endpoint;
   std::unique_ptr<GeneralClientConnection> connection =
@@ -1356,7 +1356,7 @@ AgencyCommResult AgencyComm::sendWithFailover(
   std::chrono::duration<double> waitInterval (.0); // seconds
   auto started = std::chrono::steady_clock::now();
   auto timeOut = started + std::chrono::duration<double>(timeout);
-  double conTimeout = 1.0;
+  double conTimeout = requestTimeout;
 
   int tries = 0;
 
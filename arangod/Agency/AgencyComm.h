@@ -690,8 +690,11 @@ class AgencyComm {
 
   bool ensureStructureInitialized();
 
+  /// @brief the last argument is the timeout of the first try, which
+  /// needs to be raised for requests the agency answers late on purpose
   AgencyCommResult sendWithFailover(arangodb::rest::RequestType, double,
-                                    std::string const&, VPackSlice);
+                                    std::string const&, VPackSlice,
+                                    double requestTimeout = 1.0);
 
  private:
   bool lock(std::string const&, double, double,
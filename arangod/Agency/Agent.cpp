@@ -32,6 +32,7 @@
 #include "Agency/GossipCallback.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
 #include "RestServer/QueryRegistryFeature.h"
 #include "RestServer/SystemDatabaseFeature.h"
@@ -1238,6 +1239,46 @@ read_ret_t Agent::read(query_t const& query) {
 }
 
 
+/// Read from store as soon as the result differs from known
+read_ret_t Agent::poll(query_t const& query, VPackSlice known, double timeout) {
+
+  auto leader = _constituent.leaderID();
+  if (leader != id()) {
+    return read_ret_t(false, leader);
+  }
+
+  auto const endTime = steady_clock::now() + duration<double>(timeout);
+
+  // _readDB only changes together with _commitIndex, which is followed by
+  // a broadcast on _waitForCV
+  CONDITION_LOCKER(guard, _waitForCV);
+  while (true) {
+    if (!leading()) {
+      return read_ret_t(false, _constituent.leaderID());
+    }
+
+    auto const now = steady_clock::now();
+    if (getPrepareLeadership() != 0) {
+      if (now >= endTime) {
+        return read_ret_t(false, NO_LEADER);
+      }
+      _waitForCV.wait(100);
+      continue;
+    }
+
+    auto result = std::make_shared<arangodb::velocypack::Builder>();
+    std::vector<bool> success = _readDB.read(query, result);
+
+    if (known.isNone() || now >= endTime || this->isStopping() ||
+        basics::VelocyPackHelper::compare(result->slice(), known, false) != 0) {
+      return read_ret_t(true, id(), success, result);
+    }
+
+    duration<double> remain = endTime - now;
+    _waitForCV.wait(static_cast<uint64_t>(1.0e6 * remain.count()) + 1);
+  }
+}
+
 /// Send out append entries to followers regularly or on event
 void Agent::run() {
   // Only run in case we are in multi-host mode
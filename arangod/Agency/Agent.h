@@ -123,6 +123,10 @@ class Agent final : public arangodb::Thread,
   /// @brief Read from agency
   read_ret_t read(query_t const&);
 
+  /// @brief Read from agency once the result differs from known, or the
+  /// timeout has passed. Lets servers learn about changes without polling
+  read_ret_t poll(query_t const&, VPackSlice known, double timeout);
+
   /// @brief Inquire success of logs given clientIds
   write_ret_t inquire(query_t const&);
 
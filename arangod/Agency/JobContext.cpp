@@ -30,6 +30,7 @@
 #include "Agency/FailedLeader.h"
 #include "Agency/FailedServer.h"
 #include "Agency/MoveShard.h"
+#include "Agency/RebalanceShards.h"
 #include "Agency/RemoveFollower.h"
 
 using namespace arangodb::consensus;
@@ -60,6 +61,8 @@ JobContext::JobContext (JOB_STATUS status, std::string id, Node const& snapshot,
     _job = std::make_unique<AddFollower>(snapshot, agent, status, id);
   } else if (type == "removeFollower") {
     _job = std::make_unique<RemoveFollower>(snapshot, agent, status, id);
+  } else if (type == "rebalanceShards") {
+    _job = std::make_unique<RebalanceShards>(snapshot, agent, status, id);
   } else if (type == "activeFailover") {
     _job = std::make_unique<ActiveFailoverJob>(snapshot, agent, status, id);
   } else {
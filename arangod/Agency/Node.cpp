@@ -214,6 +214,7 @@ Node& Node::operator=(VPackSlice const& slice) {
       reinterpret_cast<char const*>(slice.begin()), slice.byteSize());
   }
   _vecBufDirty = true;
+  _serialized.reset();
   return *this;
 }
 
@@ -235,6 +236,7 @@ Node& Node::operator=(Node&& rhs) {
   _vecBufDirty = std::move(rhs._vecBufDirty);
   _isArray = std::move(rhs._isArray);
   _ttl = std::move(rhs._ttl);
+  _serialized.reset();
   return *this;
 }
 
@@ -257,6 +259,7 @@ Node& Node::operator=(Node const& rhs) {
   _vecBufDirty = rhs._vecBufDirty;
   _isArray = rhs._isArray;
   _ttl = rhs._ttl;
+  _serialized.reset();
   return *this;
 }
 
@@ -295,6 +298,7 @@ bool Node::removeChild(std::string const& key) {
   }
   found->second->removeTimeToLive();
   _children.erase(found);
+  _serialized.reset();
   return true;
 }
 
@@ -826,6 +830,63 @@ Builder Node::toBuilder() const {
   return builder;
 }
 
+std::shared_ptr<Builder const> Node::serialized() const {
+  bool cacheable = true;
+  return serialized(cacheable);
+}
+
+std::shared_ptr<Builder const> Node::serialized(bool& cacheable) const {
+  if (_serialized != nullptr) {
+    return _serialized;
+  }
+
+  typedef std::chrono::system_clock clock;
+  auto builder = std::make_shared<Builder>();
+  bool mine = true;
+  if (type() == NODE) {
+    VPackObjectBuilder guard(builder.get());
+    for (auto const& child : _children) {
+      auto const& cptr = child.second;
+      if (cptr->_ttl != clock::time_point()) {
+        // visible until it expires
+        mine = false;
+        if (cptr->_ttl < clock::now()) {
+          continue;
+        }
+      }
+      if (child.first[0] == '.') {
+        continue;
+      }
+      auto sub = cptr->serialized(mine);
+      if (!sub->slice().isNone()) {
+        builder->add(child.first, sub->slice());
+      }
+    }
+  } else if (!slice().isNone()) {
+    builder->add(slice());
+  }
+
+  if (mine) {
+    _serialized = builder;
+  } else {
+    cacheable = false;
+  }
+  return builder;
+}
+
+void Node::invalidateSerialized(std::vector<std::string> const& pv) {
+  Node* node = this;
+  node->_serialized.reset();
+  for (auto const& key : pv) {
+    auto it = node->_children.find(key);
+    if (it == node->_children.end()) {
+      break;
+    }
+    node = it->second.get();
+    node->_serialized.reset();
+  }
+}
+
 std::string Node::toJson() const {
   return toBuilder().toJson();
 }
@@ -1189,5 +1250,6 @@ void Node::clear() {
   _value.clear();
   _vecBuf.clear();
   _vecBufDirty = true;
+  _serialized.reset();
   _isArray = false;
 }
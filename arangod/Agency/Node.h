@@ -168,6 +168,15 @@ class Node {
   /// @brief Create Builder representing this store
   VPackBuilder toBuilder() const;
 
+  /// @brief Serialization like toBuilder(), kept in this node and its
+  /// descendants and reused until invalidateSerialized() is called along
+  /// the path of a modification
+  std::shared_ptr<Builder const> serialized() const;
+
+  /// @brief Drop kept serializations of this node and of the existing nodes
+  /// along relative path pv
+  void invalidateSerialized(std::vector<std::string> const& pv);
+
   /// @brief Access children
   Children& children();
 
@@ -324,6 +333,10 @@ protected:
 
   void rebuildVecBuf() const;
 
+  /// @brief Serialization of this node, cacheable is false if it depends on
+  /// the time to live of a descendant
+  std::shared_ptr<Builder const> serialized(bool& cacheable) const;
+
   std::string _nodeName;  ///< @brief my name
   Node* _parent;           ///< @brief parent
   Store* _store;           ///< @brief Store
@@ -332,6 +345,7 @@ protected:
   std::vector<Buffer<uint8_t>> _value; ///< @brief my value
   mutable Buffer<uint8_t> _vecBuf;
   mutable bool _vecBufDirty;
+  mutable std::shared_ptr<Builder const> _serialized;
   bool _isArray;
 };
 
@@ -0,0 +1,497 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RebalanceShards.h"
+
+#include "Agency/AgentInterface.h"
+#include "Agency/Job.h"
+#include "Agency/JobContext.h"
+#include "Agency/MoveShard.h"
+
+#include <tuple>
+
+using namespace arangodb::consensus;
+
+namespace {
+struct ShardInfo {
+  std::string database;
+  std::string collection;
+  std::string shard;
+  std::vector<std::string> servers;
+  uint64_t weight;
+  bool movable;
+};
+
+/// @brief finds the best improving move of one replica of a shard. for
+/// leaders only replica 0 is considered, otherwise all followers. the
+/// move must leave the target with less load than the source had
+bool bestMove(ShardInfo const& info, bool leader,
+              std::vector<std::string> const& servers,
+              std::unordered_map<std::string, uint64_t> const& load,
+              std::unordered_map<std::string, uint64_t> const& tieBreak,
+              size_t& replica, std::string const*& target, uint64_t& gain) {
+  bool found = false;
+  size_t const first = leader ? 0 : 1;
+  size_t const last = leader ? 1 : info.servers.size();
+
+  for (size_t i = first; i < last; ++i) {
+    uint64_t const fromLoad = load.at(info.servers[i]);
+    for (auto const& to : servers) {
+      if (std::find(info.servers.begin(), info.servers.end(), to) !=
+          info.servers.end()) {
+        continue;
+      }
+      uint64_t const toLoad = load.at(to);
+      if (toLoad + info.weight >= fromLoad) {
+        continue;
+      }
+      uint64_t const g = fromLoad - toLoad;
+      if (!found || g > gain ||
+          (g == gain && tieBreak.at(to) < tieBreak.at(*target))) {
+        found = true;
+        replica = i;
+        target = &to;
+        gain = g;
+      }
+    }
+  }
+  return found;
+}
+}
+
+RebalanceShards::RebalanceShards(Node const& snapshot, AgentInterface* agent,
+                                 std::string const& jobId,
+                                 std::string const& creator, uint64_t maxMoves)
+    : Job(NOTFOUND, snapshot, agent, jobId, creator), _maxMoves(maxMoves) {}
+
+RebalanceShards::RebalanceShards(Node const& snapshot, AgentInterface* agent,
+                                 JOB_STATUS status, std::string const& jobId)
+    : Job(status, snapshot, agent, jobId), _maxMoves(DefaultMaxMoves) {
+  // Get job details from agency:
+  std::string path = pos[status] + _jobId + "/";
+  auto tmp_creator = _snapshot.hasAsString(path + "creator");
+  auto tmp_maxMoves = _snapshot.hasAsUInt(path + "maxMoves");
+
+  if (tmp_creator.second) {
+    _creator = tmp_creator.first;
+    if (tmp_maxMoves.second && tmp_maxMoves.first > 0) {
+      _maxMoves = tmp_maxMoves.first;
+    }
+  } else {
+    std::stringstream err;
+    err << "Failed to find job " << _jobId << " in agency.";
+    LOG_TOPIC(ERR, Logger::SUPERVISION) << err.str();
+    finish("", "", false, err.str());
+    _status = FAILED;
+  }
+}
+
+RebalanceShards::~RebalanceShards() {}
+
+void RebalanceShards::run() {
+  runHelper("", "");
+}
+
+JOB_STATUS RebalanceShards::status() {
+  if (_status != PENDING) {
+    return _status;
+  }
+
+  Node::Children const todos = _snapshot.hasAsChildren(toDoPrefix).first;
+  Node::Children const pends = _snapshot.hasAsChildren(pendingPrefix).first;
+  size_t found = 0;
+
+  for (auto const& subJob : todos) {
+    if (!subJob.first.compare(0, _jobId.size() + 1, _jobId + "-")) {
+      found++;
+    }
+  }
+  for (auto const& subJob : pends) {
+    if (!subJob.first.compare(0, _jobId.size() + 1, _jobId + "-")) {
+      found++;
+    }
+  }
+
+  if (found > 0) {  // current batch still running
+    return PENDING;
+  }
+
+  Node::Children const failed = _snapshot.hasAsChildren(failedPrefix).first;
+  for (auto const& subJob : failed) {
+    if (!subJob.first.compare(0, _jobId.size() + 1, _jobId + "-")) {
+      finish("", "", false, "shard move " + subJob.first + " failed");
+      return FAILED;
+    }
+  }
+
+  // batch done, plan the next one from the current Plan
+  std::string const countPath = pendingPrefix + _jobId + "/movesScheduled";
+  auto tmp_count = _snapshot.hasAsSlice(countPath);
+  if (!tmp_count.second || !tmp_count.first.isNumber()) {
+    finish("", "", false, "job lacks movesScheduled");
+    return FAILED;
+  }
+  uint64_t const sub = tmp_count.first.getNumber<uint64_t>();
+
+  auto trx = std::make_shared<Builder>();
+  uint64_t scheduled = 0;
+  { VPackArrayBuilder listOfTransactions(trx.get());
+    { VPackObjectBuilder objectForMutation(trx.get());
+      scheduled = scheduleMoveShards(trx, sub);
+      trx->add(countPath, VPackValue(sub + scheduled));
+    }
+    { VPackObjectBuilder objectForPrecondition(trx.get());
+      addPreconditionUnchanged(*trx, countPath, tmp_count.first);
+    }
+  }
+
+  if (scheduled == 0) {
+    // nothing left to improve
+    if (finish("", "", true, "")) {
+      return FINISHED;
+    }
+    return PENDING;
+  }
+
+  write_ret_t res = singleWriteTransaction(_agent, *trx);
+
+  if (res.accepted && res.indices.size() == 1 && res.indices[0]) {
+    LOG_TOPIC(DEBUG, Logger::SUPERVISION)
+      << "Rebalance shards job " << _jobId << " scheduled " << scheduled
+      << " more moves";
+  } else {
+    LOG_TOPIC(INFO, Logger::SUPERVISION)
+      << "Precondition failed for scheduling moves of job " + _jobId;
+  }
+
+  return PENDING;
+}
+
+bool RebalanceShards::create(std::shared_ptr<VPackBuilder> envelope) {
+
+  LOG_TOPIC(DEBUG, Logger::SUPERVISION) << "Todo: Rebalance shards";
+
+  bool selfCreate = (envelope == nullptr); // Do we create ourselves?
+
+  if (selfCreate) {
+    _jb = std::make_shared<Builder>();
+  } else {
+    _jb = envelope;
+  }
+
+  std::string path = toDoPrefix + _jobId;
+
+  { VPackArrayBuilder guard(_jb.get());
+    VPackObjectBuilder guard2(_jb.get());
+    _jb->add(VPackValue(path));
+    { VPackObjectBuilder guard3(_jb.get());
+      _jb->add("type", VPackValue("rebalanceShards"));
+      _jb->add("maxMoves", VPackValue(_maxMoves));
+      _jb->add("jobId", VPackValue(_jobId));
+      _jb->add("creator", VPackValue(_creator));
+      _jb->add("timeCreated",
+             VPackValue(timepointToString(std::chrono::system_clock::now())));
+    }
+  }
+
+  _status = TODO;
+
+  if (!selfCreate) {
+    return true;
+  }
+
+  write_ret_t res = singleWriteTransaction(_agent, *_jb);
+
+  if (res.accepted && res.indices.size() == 1 && res.indices[0]) {
+    return true;
+  }
+
+  _status = NOTFOUND;
+
+  LOG_TOPIC(INFO, Logger::SUPERVISION) << "Failed to insert job " + _jobId;
+  return false;
+}
+
+bool RebalanceShards::start() {
+  // If anything throws here, the run() method catches it and finishes
+  // the job.
+
+  if (candidateServers(_snapshot).size() < 2) {
+    finish("", "", false, "need at least two healthy DBServers to rebalance");
+    return false;
+  }
+
+  // Get todo entry
+  Builder todo;
+  { VPackArrayBuilder guard(&todo);
+    // When create() was done with the current snapshot, then the job object
+    // will not be in the snapshot under ToDo, but in this case we find it
+    // in _jb:
+    if (_jb == nullptr) {
+      auto tmp_todo = _snapshot.hasAsBuilder(toDoPrefix + _jobId, todo);
+      if (!tmp_todo.second) {
+        LOG_TOPIC(INFO, Logger::SUPERVISION) << "Failed to get key " +
+          toDoPrefix + _jobId + " from agency snapshot";
+        return false;
+      }
+    } else {
+      try {
+        todo.add(_jb->slice()[0].get(toDoPrefix + _jobId));
+      } catch (std::exception const& e) {
+        LOG_TOPIC(WARN, Logger::SUPERVISION) << e.what() << ": "
+          << __FILE__ << ":" << __LINE__;
+        return false;
+      }
+    }
+  }
+
+  // Enter pending with the first batch of moves, remove todo
+  auto pending = std::make_shared<Builder>();
+  uint64_t scheduled = 0;
+  { VPackArrayBuilder listOfTransactions(pending.get());
+
+    { VPackObjectBuilder objectForMutation(pending.get());
+
+      scheduled = scheduleMoveShards(pending, 0);
+
+      Builder job;
+      { VPackObjectBuilder guard(&job);
+        for (auto const& it : VPackObjectIterator(todo.slice()[0])) {
+          if (!it.key.isEqualString("movesScheduled")) {
+            job.add(it.key.copyString(), it.value);
+          }
+        }
+        job.add("movesScheduled", VPackValue(scheduled));
+      }
+      addPutJobIntoSomewhere(*pending, "Pending", job.slice());
+      addRemoveJobFromSomewhere(*pending, "ToDo", _jobId);
+
+    }  // mutation part of transaction done
+
+    // Preconditions
+    { VPackObjectBuilder objectForPrecondition(pending.get());
+      addPreconditionUnchanged(*pending, toDoPrefix + _jobId, todo.slice()[0]);
+    }
+  }  // array for transaction done
+
+  if (scheduled == 0) {
+    finish("", "", true, "shards are balanced");
+    return false;
+  }
+
+  // Transact to agency
+  write_ret_t res = singleWriteTransaction(_agent, *pending);
+
+  if (res.accepted && res.indices.size() == 1 && res.indices[0]) {
+    LOG_TOPIC(DEBUG, Logger::SUPERVISION) << "Pending: Rebalance shards with "
+      << scheduled << " moves";
+    return true;
+  }
+
+  LOG_TOPIC(INFO, Logger::SUPERVISION)
+      << "Precondition failed for starting RebalanceShards job " + _jobId;
+
+  return false;
+}
+
+uint64_t RebalanceShards::scheduleMoveShards(std::shared_ptr<Builder>& trx,
+                                             uint64_t sub) {
+  uint64_t scheduled = 0;
+
+  for (auto const& move :
+       planMoves(_snapshot, candidateServers(_snapshot), _maxMoves)) {
+    MoveShard(_snapshot, _agent, _jobId + "-" + std::to_string(sub++),
+              _jobId, move.database, move.collection, move.shard, move.from,
+              move.to, move.isLeader, false)
+      .create(trx);
+    ++scheduled;
+  }
+
+  return scheduled;
+}
+
+std::vector<std::string> RebalanceShards::candidateServers(Node const& snapshot) {
+  std::vector<std::string> servers = availableServers(snapshot);
+
+  servers.erase(
+    std::remove_if(
+      servers.begin(), servers.end(),
+      [&snapshot](std::string const& s) {
+        return snapshot.has(blockedServersPrefix + s) ||
+               checkServerHealth(snapshot, s) != "GOOD";
+      }),
+    servers.end());
+
+  return servers;
+}
+
+std::vector<RebalanceShards::Move> RebalanceShards::planMoves(
+    Node const& snapshot, std::vector<std::string> const& servers,
+    uint64_t maxMoves) {
+  std::vector<Move> moves;
+  if (servers.size() < 2 || maxMoves == 0) {
+    return moves;
+  }
+
+  std::unordered_map<std::string, uint64_t> leaders;
+  std::unordered_map<std::string, uint64_t> replicas;
+  for (auto const& server : servers) {
+    leaders.emplace(server, 0);
+    replicas.emplace(server, 0);
+  }
+
+  std::vector<ShardInfo> shards;
+  Node::Children const& databases =
+    snapshot.hasAsChildren("/Plan/Collections").first;
+
+  for (auto const& database : databases) {
+    // Collections following another one move along with it:
+    std::unordered_map<std::string, uint64_t> followers;
+    for (auto const& collptr : database.second->children()) {
+      auto tmp_like = collptr.second->hasAsString("distributeShardsLike");
+      if (tmp_like.second && !tmp_like.first.empty()) {
+        ++followers[tmp_like.first];
+      }
+    }
+
+    for (auto const& collptr : database.second->children()) {
+      auto const& collection = *(collptr.second);
+
+      if (collection.has("distributeShardsLike")) {
+        continue;
+      }
+
+      auto it = followers.find(collptr.first);
+      uint64_t const weight = 1 + (it == followers.end() ? 0 : it->second);
+
+      for (auto const& shard : collection.hasAsChildren("shards").first) {
+        Slice plan = shard.second->slice();
+        if (!plan.isArray() || plan.length() == 0) {
+          continue;
+        }
+
+        ShardInfo info{database.first, collptr.first, shard.first, {}, weight,
+                       !snapshot.has(blockedShardsPrefix + shard.first)};
+        for (auto const& dbserver : VPackArrayIterator(plan)) {
+          std::string server = dbserver.copyString();
+          auto l = leaders.find(server);
+          if (l == leaders.end()) {
+            // resigned leader or unhealthy server, leave the shard alone
+            info.movable = false;
+          } else {
+            if (info.servers.empty()) {
+              l->second += weight;
+            }
+            replicas[server] += weight;
+          }
+          info.servers.emplace_back(std::move(server));
+        }
+        shards.emplace_back(std::move(info));
+      }
+    }
+  }
+
+  std::sort(shards.begin(), shards.end(),
+            [](ShardInfo const& a, ShardInfo const& b) {
+              return std::tie(a.database, a.collection, a.shard) <
+                     std::tie(b.database, b.collection, b.shard);
+            });
+
+  // Leaders first, then followers. Each shard moves at most once per batch.
+  for (bool const leader : {true, false}) {
+    auto const& load = leader ? leaders : replicas;
+    auto const& tieBreak = leader ? replicas : leaders;
+
+    while (moves.size() < maxMoves) {
+      ShardInfo* best = nullptr;
+      size_t bestReplica = 0;
+      std::string const* bestTarget = nullptr;
+      uint64_t bestGain = 0;
+
+      for (auto& info : shards) {
+        size_t replica;
+        std::string const* target = nullptr;
+        uint64_t gain = 0;
+        if (info.movable &&
+            ::bestMove(info, leader, servers, load, tieBreak, replica, target, gain) &&
+            (best == nullptr || gain > bestGain)) {
+          best = &info;
+          bestReplica = replica;
+          bestTarget = target;
+          bestGain = gain;
+        }
+      }
+
+      if (best == nullptr) {
+        break;
+      }
+
+      std::string& from = best->servers[bestReplica];
+      moves.emplace_back(Move{best->database, best->collection, best->shard,
+                              from, *bestTarget, leader});
+      replicas[from] -= best->weight;
+      replicas[*bestTarget] += best->weight;
+      if (leader) {
+        leaders[from] -= best->weight;
+        leaders[*bestTarget] += best->weight;
+      }
+      from = *bestTarget;
+      best->movable = false;
+    }
+  }
+
+  return moves;
+}
+
+arangodb::Result RebalanceShards::abort() {
+  // We can assume that the job is either in ToDo or in Pending.
+  Result result;
+
+  if (_status == NOTFOUND || _status == FINISHED || _status == FAILED) {
+    result = Result(TRI_ERROR_SUPERVISION_GENERAL_FAILURE,
+                    "Failed aborting rebalanceShards beyond pending stage");
+    return result;
+  }
+
+  // Can now only be TODO or PENDING
+  if (_status == TODO) {
+    finish("", "", false, "job aborted");
+    return result;
+  }
+
+  // Abort all our subjobs:
+  Node::Children const todos = _snapshot.hasAsChildren(toDoPrefix).first;
+  Node::Children const pends = _snapshot.hasAsChildren(pendingPrefix).first;
+
+  for (auto const& subJob : todos) {
+    if (!subJob.first.compare(0, _jobId.size() + 1, _jobId + "-")) {
+      JobContext(TODO, subJob.first, _snapshot, _agent).abort();
+    }
+  }
+  for (auto const& subJob : pends) {
+    if (!subJob.first.compare(0, _jobId.size() + 1, _jobId + "-")) {
+      JobContext(PENDING, subJob.first, _snapshot, _agent).abort();
+    }
+  }
+
+  finish("", "", false, "job aborted");
+
+  return result;
+}
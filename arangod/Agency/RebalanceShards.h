@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CONSENSUS_REBALANCE_SHARDS_H
+#define ARANGOD_CONSENSUS_REBALANCE_SHARDS_H 1
+
+#include "Job.h"
+#include "Supervision.h"
+
+namespace arangodb {
+namespace consensus {
+
+/// @brief evens out the number of shard leaders and shard replicas over all
+/// healthy DB servers. the job schedules MoveShard subjobs in batches of at
+/// most `maxMoves` shards, and plans the next batch once the previous one
+/// has completed. leader moves are planned before follower moves, so that
+/// the write load is balanced first.
+struct RebalanceShards : public Job {
+  /// @brief a single planned shard move
+  struct Move {
+    std::string database;
+    std::string collection;
+    std::string shard;
+    std::string from;
+    std::string to;
+    bool isLeader;
+  };
+
+  static constexpr uint64_t DefaultMaxMoves = 4;
+
+  RebalanceShards(Node const& snapshot, AgentInterface* agent, std::string const& jobId,
+                  std::string const& creator = std::string(),
+                  uint64_t maxMoves = DefaultMaxMoves);
+
+  RebalanceShards(Node const& snapshot, AgentInterface* agent,
+                  JOB_STATUS status, std::string const& jobId);
+
+  virtual ~RebalanceShards();
+
+  virtual JOB_STATUS status() override final;
+  virtual bool create(std::shared_ptr<VPackBuilder> envelope = nullptr)
+    override final;
+  virtual void run() override final;
+  virtual bool start() override final;
+  virtual Result abort() override final;
+
+  /// @brief healthy, unblocked DB servers which may send or receive shards
+  static std::vector<std::string> candidateServers(Node const& snapshot);
+
+  /// @brief plans at most maxMoves shard moves between the given servers.
+  /// every move strictly reduces the imbalance, so repeated planning on
+  /// an unchanged Plan terminates. a shard counts once per collection
+  /// following it via distributeShardsLike, since those move along
+  static std::vector<Move> planMoves(Node const& snapshot,
+                                     std::vector<std::string> const& servers,
+                                     uint64_t maxMoves);
+
+ private:
+  /// @brief adds MoveShard subjobs for the next batch to trx, numbering
+  /// them from sub onwards. returns the number of scheduled moves
+  uint64_t scheduleMoveShards(std::shared_ptr<Builder>& trx, uint64_t sub);
+
+  uint64_t _maxMoves;
+};
+}
+}
+
+#endif
@@ -30,6 +30,7 @@
 
 #include "Agency/Agent.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
 #include "Rest/Version.h"
@@ -524,6 +525,51 @@ RestStatus RestAgencyHandler::handleRead() {
   return reportMethodNotAllowed();
 }
 
+/// @brief answers a read once its result differs from the "known" one.
+/// body: {"read": <read query>, "known": <previous result>, "timeout": <s>}
+RestStatus RestAgencyHandler::handlePoll() {
+  if (_request->requestType() != rest::RequestType::POST) {
+    return reportMethodNotAllowed();
+  }
+
+  std::shared_ptr<VPackBuilder> body;
+  try {
+    body = _request->toVelocyPackBuilderPtr();
+  } catch (std::exception const& e) {
+    return reportMessage(rest::ResponseCode::BAD, e.what());
+  }
+
+  VPackSlice read = body->slice().get("read");
+  if (!read.isArray()) {
+    return reportMessage(rest::ResponseCode::BAD, "expecting array 'read'");
+  }
+  auto query = std::make_shared<VPackBuilder>();
+  query->add(read);
+
+  // every waiting poll occupies a thread, so the wait is bounded
+  double timeout = basics::VelocyPackHelper::getNumericValue<double>(
+    body->slice(), "timeout", 0.0);
+  if (timeout > MaxPollTimeout) {
+    timeout = MaxPollTimeout;
+  }
+
+  if (_agent->size() > 1 && _agent->leaderID() == NO_LEADER) {
+    return reportMessage(rest::ResponseCode::SERVICE_UNAVAILABLE, "No leader");
+  }
+
+  read_ret_t ret = _agent->poll(query, body->slice().get("known"), timeout);
+
+  if (ret.accepted) {  // I am leading
+    generateResult(rest::ResponseCode::OK, ret.result->slice());
+  } else if (_agent->leaderID() == NO_LEADER || ret.redirect == NO_LEADER ||
+             ret.redirect == _agent->id()) {
+    return reportMessage(rest::ResponseCode::SERVICE_UNAVAILABLE, "No leader");
+  } else {  // Redirect to leader
+    redirectRequest(ret.redirect);
+  }
+  return RestStatus::DONE;
+}
+
 RestStatus RestAgencyHandler::handleConfig() {
 
   // Update endpoint of peer
@@ -589,6 +635,8 @@ RestStatus RestAgencyHandler::execute() {
         return handleWrite();
       } else if (suffixes[0] == "read") {
         return handleRead();
+      } else if (suffixes[0] == "poll") {
+        return handlePoll();
       } else if (suffixes[0] == "inquire") {
         return handleInquire();
       } else if (suffixes[0] == "transient") {
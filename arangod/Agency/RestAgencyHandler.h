@@ -52,6 +52,7 @@ class RestAgencyHandler : public RestBaseHandler {
   RestStatus handleStores();
   RestStatus handleStore();
   RestStatus handleRead();
+  RestStatus handlePoll();
   RestStatus handleWrite();
   RestStatus handleTransact();
   RestStatus handleConfig();
@@ -61,6 +62,10 @@ class RestAgencyHandler : public RestBaseHandler {
   RestStatus handleInquire();
 
   void redirectRequest(std::string const& leaderId);
+
+  /// @brief longest time (in seconds) a poll request waits for a change
+  static constexpr double MaxPollTimeout = 30.0;
+
   consensus::Agent* _agent;
 };
 }
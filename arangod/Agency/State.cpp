@@ -136,6 +136,60 @@ bool State::persist(index_t index, term_t term,
   return res.ok();
 }
 
+/// Persist consecutive entries in one transaction
+bool State::persist(std::vector<log_t> const& entries) const {
+  TRI_ASSERT(!entries.empty());
+  LOG_TOPIC(TRACE, Logger::AGENCY)
+      << "persist indexes=" << entries.front().index << "-"
+      << entries.back().index;
+
+  Builder body;
+  {
+    VPackArrayBuilder a(&body);
+    for (auto const& entry : entries) {
+      VPackObjectBuilder b(&body);
+      body.add("_key", Value(stringify(entry.index)));
+      body.add("term", Value(entry.term));
+      body.add("request", Slice(entry.entry->data()));
+      body.add("clientId", Value(entry.clientId));
+      body.add("timestamp", Value(timestamp()));
+    }
+  }
+
+  TRI_ASSERT(_vocbase != nullptr);
+  auto ctx = std::make_shared<transaction::StandaloneContext>(*_vocbase);
+  SingleCollectionTransaction trx(ctx, "log", AccessMode::Type::WRITE);
+
+  Result res = trx.begin();
+
+  if (!res.ok()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  OperationResult result;
+
+  try {
+    result = trx.insert("log", body.slice(), _options);
+  } catch (std::exception const& e) {
+    LOG_TOPIC(ERR, Logger::AGENCY)
+        << "Failed to persist log entries:" << e.what();
+    return false;
+  }
+
+  if (result.ok() && !result.countErrorCodes.empty()) {
+    // all or none of the entries
+    result.result.reset(result.countErrorCodes.begin()->first);
+  }
+
+  res = trx.finish(result.result);
+
+  LOG_TOPIC(TRACE, Logger::AGENCY)
+      << "persist done indexes=" << entries.front().index << "-"
+      << entries.back().index << " ok:" << res.ok();
+
+  return res.ok() && result.ok();
+}
+
 bool State::persistconf(
   index_t index, term_t term, arangodb::velocypack::Slice const& entry,
   std::string const& clientId) const {
@@ -242,6 +296,9 @@ std::vector<index_t> State::logLeaderMulti(
 
   TRI_ASSERT(!_log.empty());  // log must never be empty
 
+  // entries are persisted together, reconfigurations on their own
+  std::vector<log_t> pending;
+
   for (auto const& i : VPackArrayIterator(slice)) {
     if (!i.isArray()) {
       THROW_ARANGO_EXCEPTION_MESSAGE(
@@ -256,14 +313,24 @@ std::vector<index_t> State::logLeaderMulti(
       TRI_ASSERT(transaction.isObject());
       TRI_ASSERT(transaction.length() > 0);
       size_t pos = transaction.keyAt(0).copyString().find(RECONFIGURE);
-      
-      idx[j] = logNonBlocking(
-        _log.back().index + 1, i[0], term, clientId, true, pos == 0 || pos == 1);
+
+      if (pos == 0 || pos == 1) {
+        logNonBlocking(pending, true);
+        idx[j] = logNonBlocking(
+          _log.back().index + 1, i[0], term, clientId, true, true);
+      } else {
+        auto buf = std::make_shared<Buffer<uint8_t>>();
+        buf->append((char const*)transaction.begin(), transaction.byteSize());
+        idx[j] = _log.back().index + 1 + pending.size();
+        pending.emplace_back(idx[j], term, buf, clientId);
+      }
 
     }
     ++j;
   }
 
+  logNonBlocking(pending, true);
+
   return idx;
 }
 
@@ -327,6 +394,55 @@ index_t State::logNonBlocking(
   return _log.back().index;
 }
 
+/// Log consecutive entries (leader & follower)
+index_t State::logNonBlocking(std::vector<log_t>& entries, bool leading) {
+
+  _logLock.assertLockedByCurrentThread();
+
+  if (entries.empty()) {
+    return _log.empty() ? 0 : _log.back().index;
+  }
+  TRI_ASSERT(_log.empty() || entries.front().index == _log.back().index + 1);
+
+  if (!persist(entries)) {  // log to disk or die
+    entries.clear();
+    if (leading) {
+      LOG_TOPIC(FATAL, Logger::AGENCY)
+          << "RAFT leader fails to persist log entries!";
+      FATAL_ERROR_EXIT();
+    } else {
+      LOG_TOPIC(ERR, Logger::AGENCY)
+          << "RAFT follower fails to persist log entries!";
+      return 0;
+    }
+  }
+
+  for (auto& entry : entries) {
+    try {
+      _log.push_back(std::move(entry));  // log to RAM or die
+    } catch (std::bad_alloc const&) {
+      LOG_TOPIC(FATAL, Logger::AGENCY)
+          << "RAFT fails to allocate volatile log entries!";
+      FATAL_ERROR_EXIT();
+    }
+
+    if (leading) {
+      try {
+        _clientIdLookupTable.emplace(  // keep track of client or die
+            std::pair<std::string, index_t>(_log.back().clientId,
+                                            _log.back().index));
+      } catch (...) {
+        LOG_TOPIC(FATAL, Logger::AGENCY)
+            << "RAFT leader fails to expand client lookup table!";
+        FATAL_ERROR_EXIT();
+      }
+    }
+  }
+  entries.clear();
+
+  return _log.back().index;
+}
+
 /// Log transactions (follower)
 index_t State::logFollower(query_t const& transactions) {
   VPackSlice slices = transactions->slice();
@@ -404,6 +520,7 @@ index_t State::logFollower(query_t const& transactions) {
     TRI_ASSERT(slices.isArray());
     size_t nqs = slices.length();
     std::string clientId;
+    std::vector<log_t> pending;
 
     for (size_t i = ndups; i < nqs; ++i) {
       VPackSlice const& slice = slices[i];
@@ -418,11 +535,23 @@ index_t State::logFollower(query_t const& transactions) {
       
       bool reconfiguration = query.keyAt(0).isEqualString(RECONFIGURE);
 
-      // first to disk
-      if (logNonBlocking(index, query, term, clientId, false, reconfiguration)==0) {
-        break;
+      // first to disk, entries together and reconfigurations on their own
+      if (reconfiguration) {
+        if ((!pending.empty() && logNonBlocking(pending, false) == 0) ||
+            logNonBlocking(index, query, term, clientId, false, true) == 0) {
+          pending.clear();
+          break;
+        }
+      } else {
+        auto buf = std::make_shared<Buffer<uint8_t>>();
+        buf->append((char const*)query.begin(), query.byteSize());
+        pending.emplace_back(index, term, buf, clientId);
       }
     }
+
+    if (!pending.empty()) {
+      logNonBlocking(pending, false);
+    }
   }
   return _log.back().index;  // never empty
 }
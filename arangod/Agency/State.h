@@ -207,10 +207,17 @@ class State {
     std::string const& clientId = std::string(), bool leading = false,
     bool reconfiguration = false);
   
+  /// @brief Log consecutive entries, which are persisted in one transaction,
+  /// and clear them. Must be guarded by caller.
+  index_t logNonBlocking(std::vector<log_t>& entries, bool leading);
+
   /// @brief Save currentTerm, votedFor, log entries
   bool persist(index_t, term_t, arangodb::velocypack::Slice const&,
                std::string const&) const;
 
+  /// @brief Save consecutive log entries in one transaction
+  bool persist(std::vector<log_t> const& entries) const;
+
   /// @brief Save currentTerm, votedFor, log entries for reconfiguration
   bool persistconf(index_t, term_t, arangodb::velocypack::Slice const&,
                    std::string const&) const;
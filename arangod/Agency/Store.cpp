@@ -80,6 +80,23 @@ inline static std::vector<std::string> split(const std::string& str,
   return result;
 }
 
+/// @brief Normalized absolute path of a path vector, e.g. /arango/Plan
+static std::string normalizedPath(std::vector<std::string> const& pv) {
+  std::string result;
+  for (auto const& p : pv) {
+    result.push_back('/');
+    result.append(p);
+  }
+  return result.empty() ? std::string("/") : result;
+}
+
+/// @brief Whether path is base or below it
+static bool isBelow(std::string const& path, std::string const& base) {
+  return base == "/" ||
+         (path.compare(0, base.size(), base) == 0 &&
+          (path.size() == base.size() || path[base.size()] == '/'));
+}
+
 /// Build endpoint from URL
 inline static bool endpointPathFromUrl(std::string const& url,
                                        std::string& endpoint,
@@ -561,30 +578,72 @@ bool Store::read(VPackSlice const& query, Builder& ret) const {
   auto cut = std::remove_if(query_strs.begin(), query_strs.end(), Empty());
   query_strs.erase(cut, query_strs.end());
 
-  // Create response tree
+  // Create response tree. Existing subtrees are serialized once and shared
+  // by all reads until they are written to, so that the lock is only held
+  // for looking them up
   Node copy("copy");
-  MUTEX_LOCKER(storeLocker, _storeLock); // Freeze KV-Store for read
-  for (auto const path : query_strs) {
-    std::vector<std::string> pv = split(path, '/');
-    size_t e = _node.exists(pv).size();
-    if (e == pv.size()) {  // existing
-      copy(pv) = _node(pv);
-    } else {  // non-existing
-      for (size_t i = 0; i < pv.size() - e + 1; ++i) {
-        pv.pop_back();
-      }
-      if (copy(pv).type() == LEAF && copy(pv).slice().isNone()) {
-        copy(pv) = arangodb::velocypack::Slice::emptyObjectSlice();
+  std::vector<std::pair<std::vector<std::string>,
+                        std::shared_ptr<VPackBuilder const>>> serialized;
+  {
+    MUTEX_LOCKER(storeLocker, _storeLock); // Freeze KV-Store for read
+    for (auto const& path : query_strs) {
+      std::vector<std::string> pv = split(path, '/');
+      size_t e = _node.exists(pv).size();
+      if (e == pv.size()) {  // existing
+        auto cached = cachedSubtree(pv);
+        if (cached != nullptr) {
+          serialized.emplace_back(std::move(pv), std::move(cached));
+        } else {
+          copy(pv) = _node(pv);
+        }
+      } else {  // non-existing
+        for (size_t i = 0; i < pv.size() - e + 1; ++i) {
+          pv.pop_back();
+        }
+        if (copy(pv).type() == LEAF && copy(pv).slice().isNone()) {
+          copy(pv) = arangodb::velocypack::Slice::emptyObjectSlice();
+        }
       }
     }
   }
 
+  for (auto const& s : serialized) {
+    copy(s.first) = s.second->slice();
+  }
+
   // Into result builder
   copy.toBuilder(ret, showHidden);
 
   return success;
 }
 
+/// Serialized subtree at pv shared by reads, guarded by caller. nullptr
+/// for the root and for subtrees at or below a time to live entry, as these
+/// depend on the time of the read. Nodes keep the serializations of their
+/// children, so that a write only reserializes the nodes along its path
+std::shared_ptr<VPackBuilder const> Store::cachedSubtree(
+    std::vector<std::string> const& pv) const {
+  _storeLock.assertLockedByCurrentThread();
+
+  if (pv.empty()) {
+    return nullptr;
+  }
+  std::string path = normalizedPath(pv);
+  for (auto const& entry : _timeTable) {
+    if (isBelow(path, entry.second)) {
+      return nullptr;
+    }
+  }
+
+  return _node(pv).serialized();
+}
+
+/// Drop serialized subtrees affected by a write to path, guarded by caller
+void Store::invalidateReadCache(std::string const& path) {
+  _storeLock.assertLockedByCurrentThread();
+  _node.invalidateSerialized(split(path, '/'));
+}
+
 /// TTL clear values from store
 query_t Store::clearExpired() const {
 
@@ -662,6 +721,7 @@ bool Store::applies(arangodb::velocypack::Slice const& transaction) {
   for (const auto& i : idx) {
     std::string const& key = keys.at(i);
     Slice value = transaction.get(key);
+    invalidateReadCache(abskeys.at(i));
 
     if (value.isObject() && value.hasKey("op")) {
       _node.hasAsWritableNode(abskeys.at(i)).first.applieOp(value);
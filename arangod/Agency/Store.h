@@ -156,6 +156,13 @@ class Store {
   /// @brief Clear entries, whose time to live has expired
   query_t clearExpired() const;
 
+  /// @brief Serialized subtree at path, shared by reads until it is written
+  std::shared_ptr<Builder const> cachedSubtree(
+    std::vector<std::string> const& pv) const;
+
+  /// @brief Drop serialized subtrees at and above path
+  void invalidateReadCache(std::string const& path);
+
   /// @brief Run thread
  private:
   /// @brief Condition variable guarding removal of expired entries
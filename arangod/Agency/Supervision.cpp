@@ -1022,6 +1022,23 @@ void Supervision::enforceReplication() {
   _lock.assertLockedByCurrentThread();
   auto const& plannedDBs = _snapshot.hasAsChildren(planColPrefix).first;
 
+  // Shards with an addFollower, removeFollower or moveShard job in ToDo,
+  // collected once instead of scanning ToDo for every shard
+  std::unordered_set<std::string> scheduled;
+  for (auto const& pair : _snapshot.hasAsChildren(toDoPrefix).first) {
+    auto const& job = pair.second;
+    auto tmp_type = job->hasAsString("type");
+    if (tmp_type.first == "addFollower" || tmp_type.first == "removeFollower" ||
+        tmp_type.first == "moveShard") {
+      auto tmp_shard = job->hasAsString("shard");
+      if (tmp_shard.second) {
+        scheduled.emplace(tmp_shard.first);
+      }
+    }
+  }
+  size_t numAvailable = 0;
+  bool haveAvailable = false;
+
   for (const auto& db_ : plannedDBs) { // Planned databases
     auto const& db = *(db_.second);
     for (const auto& col_ : db.children()) { // Planned collections
@@ -1038,8 +1055,11 @@ void Supervision::enforceReplication() {
 
       // mop: satellites => distribute to every server
       if (replicationFactor == 0) {
-        auto available = Job::availableServers(_snapshot);
-        replicationFactor = available.size();
+        if (!haveAvailable) {
+          numAvailable = Job::availableServers(_snapshot).size();
+          haveAvailable = true;
+        }
+        replicationFactor = numAvailable;
       }
 
       bool clone = col.has("distributeShardsLike");
@@ -1052,22 +1072,12 @@ void Supervision::enforceReplication() {
           if (actualReplicationFactor != replicationFactor) {
             // Check that there is not yet an addFollower or removeFollower
             // or moveShard job in ToDo for this shard:
-            auto const& todo = _snapshot.hasAsChildren(toDoPrefix).first;
             bool found = false;
-            for (auto const& pair : todo) {
-              auto const& job = pair.second;
-              auto tmp_type = job->hasAsString("type");
-              auto tmp_shard = job->hasAsString("shard");
-              if ((tmp_type.first == "addFollower"
-                   || tmp_type.first == "removeFollower"
-                   || tmp_type.first == "moveShard")
-                  && tmp_shard.first == shard_.first) {
-                found = true;
-                LOG_TOPIC(DEBUG, Logger::SUPERVISION) << "already found "
-                  "addFollower or removeFollower job in ToDo, not scheduling "
-                  "again for shard " << shard_.first;
-                break;
-              }
+            if (scheduled.find(shard_.first) != scheduled.end()) {
+              found = true;
+              LOG_TOPIC(DEBUG, Logger::SUPERVISION) << "already found "
+                "addFollower or removeFollower job in ToDo, not scheduling "
+                "again for shard " << shard_.first;
             }
             // Check that shard is not locked:
             if (_snapshot.has(blockedShardsPrefix + shard_.first)) {
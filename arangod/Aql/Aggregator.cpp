@@ -1061,6 +1061,15 @@ std::string Aggregator::runOnCoordinatorAs(std::string const& type) {
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid aggregator type");
 }
 
+bool Aggregator::isMergeable(std::string const& type) {
+  auto it = ::aggregators.find(translateAlias(type));
+  
+  if (it != ::aggregators.end()) {
+    return !(*it).second.pushToDBServerAs.empty();
+  }
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid aggregator type");
+}
+
 bool Aggregator::isValid(std::string const& type) {
   auto it = ::aggregators.find(translateAlias(type));
   
@@ -79,6 +79,11 @@ struct Aggregator {
   /// to the DB server and be used there too. However, on the coordinator we must not use
   /// COUNT on the aggregated results from the DB server, but use SUM instead
   static std::string runOnCoordinatorAs(std::string const& type);
+
+  /// @brief whether or not the aggregator can be split into a partial
+  /// aggregation (as given by pushToDBServerAs) and a final step that merges
+  /// the partial results (as given by runOnCoordinatorAs)
+  static bool isMergeable(std::string const& type);
   
   /// @brief whether or not the aggregator name is supported and part of the public API. 
   /// all internal-only aggregators count as not supported here
@@ -26,15 +26,70 @@
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
 
 #include <velocypack/Iterator.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#ifdef ARANGODB_HAVE_LZ4
+#include <lz4.h>
+#endif
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
 using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
+namespace {
+
+/// @brief size of the header of the binary format:
+/// - version (1 byte)
+/// - flags (1 byte)
+/// - reserved (2 bytes)
+/// - number of rows (4 bytes, little endian)
+/// - number of registers (4 bytes, little endian)
+/// - length of the uncompressed payload (4 bytes, little endian)
+constexpr size_t binaryHeaderSize = 16;
+
+/// @brief flag value for an LZ4-compressed payload
+constexpr uint8_t binaryFlagLZ4 = 0x01;
+
+/// @brief payloads smaller than this are never compressed, as it is not
+/// worth the effort
+constexpr size_t binaryMinCompressSize = 4096;
+
+/// @brief tags for the cells in the binary format
+enum BinaryTag : uint8_t {
+  Empty = 0,     // empty value
+  Value = 1,     // a VelocyPack value follows
+  Repeated = 2,  // same value as in the previous row
+  Range = 3      // a range follows, as two little endian int64 values
+};
+
+void appendUInt(std::string& out, uint64_t value, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    out.push_back(static_cast<char>(value & 0xffU));
+    value >>= 8;
+  }
+}
+
+uint64_t readUInt(uint8_t const* p, size_t length) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < length; ++i) {
+    value |= static_cast<uint64_t>(p[i]) << (8 * i);
+  }
+  return value;
+}
+
+void throwInvalidBinary() {
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                 "invalid binary AqlItemBlock data");
+}
+
+}  // namespace
+
 /// @brief create the block
 AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor, size_t nrItems, RegisterId nrRegs)
     : _nrItems(nrItems), _nrRegs(nrRegs), _resourceMonitor(resourceMonitor) {
@@ -291,6 +346,23 @@ void AqlItemBlock::shrink(size_t nrItems) {
   _data.resize(_nrItems * _nrRegs);
 }
 
+/// @brief transfer the memory accounting of the block to another resource
+/// monitor
+void AqlItemBlock::resourceMonitor(ResourceMonitor* resourceMonitor) {
+  TRI_ASSERT(resourceMonitor != nullptr);
+  TRI_ASSERT(_valueCount.empty());
+
+  if (resourceMonitor == _resourceMonitor) {
+    return;
+  }
+
+  size_t const memory = sizeof(AqlValue) * _nrItems * _nrRegs;
+  // may throw
+  resourceMonitor->increaseMemoryUsage(memory);
+  decreaseMemoryUsage(memory);
+  _resourceMonitor = resourceMonitor;
+}
+
 void AqlItemBlock::rescale(size_t nrItems, RegisterId nrRegs) {
   TRI_ASSERT(_valueCount.empty());
   TRI_ASSERT(nrRegs <= ExecutionNode::MaxRegisterId);
@@ -712,3 +784,210 @@ void AqlItemBlock::toVelocyPack(transaction::Methods* trx,
   raw.close();
   result.add("raw", raw.slice());
 }
+
+bool AqlItemBlock::canCompressBinary() {
+#ifdef ARANGODB_HAVE_LZ4
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// @brief serialize the block into the binary format. the layout is a
+/// fixed-size header followed by a (possibly compressed) payload with
+/// one tagged cell per row and register, in row-major order
+void AqlItemBlock::toBinary(transaction::Methods* trx, std::string& result,
+                            bool compress) const {
+  VPackOptions const* options =
+      trx->transactionContextPtr()->getVPackOptionsForDump();
+
+  std::string payload;
+  payload.reserve(_nrItems * _nrRegs * 8);
+
+  VPackBuilder builder;
+  std::equal_to<AqlValue> isEqual;
+
+  for (size_t i = 0; i < _nrItems; i++) {
+    for (RegisterId column = 0; column < _nrRegs; column++) {
+      AqlValue const& a(_data[i * _nrRegs + column]);
+
+      if (a.isEmpty()) {
+        payload.push_back(static_cast<char>(::BinaryTag::Empty));
+      } else if (i > 0 && isEqual(a, _data[(i - 1) * _nrRegs + column])) {
+        payload.push_back(static_cast<char>(::BinaryTag::Repeated));
+      } else if (a.isRange()) {
+        payload.push_back(static_cast<char>(::BinaryTag::Range));
+        ::appendUInt(payload, static_cast<uint64_t>(a.range()->_low), 8);
+        ::appendUInt(payload, static_cast<uint64_t>(a.range()->_high), 8);
+      } else {
+        payload.push_back(static_cast<char>(::BinaryTag::Value));
+        VPackSlice slice;
+        if (a.isDocvec()) {
+          builder.clear();
+          a.toVelocyPack(trx, builder, true);
+          slice = builder.slice();
+        } else {
+          slice = a.slice();
+          if (VelocyPackHelper::hasNonClientTypes(slice, true, true)) {
+            // externals and custom types cannot be sent to other servers
+            builder.clear();
+            VelocyPackHelper::sanitizeNonClientTypes(
+                slice, VPackSlice::noneSlice(), builder, options, true, true);
+            slice = builder.slice();
+          }
+        }
+        payload.append(slice.startAs<char>(), slice.byteSize());
+      }
+    }
+  }
+
+  if (payload.size() > UINT32_MAX) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "AqlItemBlock too large for binary format");
+  }
+
+  uint8_t flags = 0;
+  result.clear();
+
+#ifdef ARANGODB_HAVE_LZ4
+  if (compress && payload.size() >= ::binaryMinCompressSize &&
+      payload.size() <= static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    int const bound = LZ4_compressBound(static_cast<int>(payload.size()));
+    result.resize(::binaryHeaderSize + static_cast<size_t>(bound));
+    int const compressed = LZ4_compress_default(
+        payload.data(), &result[::binaryHeaderSize],
+        static_cast<int>(payload.size()), bound);
+    if (compressed > 0 && static_cast<size_t>(compressed) < payload.size()) {
+      flags |= ::binaryFlagLZ4;
+      result.resize(::binaryHeaderSize + static_cast<size_t>(compressed));
+    } else {
+      // compression did not pay off
+      result.clear();
+    }
+  }
+#endif
+
+  std::string header;
+  header.reserve(::binaryHeaderSize);
+  header.push_back(static_cast<char>(BinaryFormatVersion));
+  header.push_back(static_cast<char>(flags));
+  ::appendUInt(header, 0, 2);
+  ::appendUInt(header, _nrItems, 4);
+  ::appendUInt(header, _nrRegs, 4);
+  ::appendUInt(header, payload.size(), 4);
+  TRI_ASSERT(header.size() == ::binaryHeaderSize);
+
+  if (flags & ::binaryFlagLZ4) {
+    result.replace(0, ::binaryHeaderSize, header);
+  } else {
+    result.reserve(::binaryHeaderSize + payload.size());
+    result.append(header);
+    result.append(payload);
+  }
+}
+
+/// @brief create a block from the binary format, note that this can throw
+std::unique_ptr<AqlItemBlock> AqlItemBlock::fromBinary(
+    ResourceMonitor* resourceMonitor, uint8_t const* data, size_t length) {
+  TRI_ASSERT(resourceMonitor != nullptr);
+
+  if (length < ::binaryHeaderSize || data[0] != BinaryFormatVersion) {
+    ::throwInvalidBinary();
+  }
+
+  uint8_t const flags = data[1];
+  size_t const nrItems = static_cast<size_t>(::readUInt(data + 4, 4));
+  uint64_t const nrRegs = ::readUInt(data + 8, 4);
+  size_t const payloadLength = static_cast<size_t>(::readUInt(data + 12, 4));
+
+  if (nrItems == 0 || nrRegs > ExecutionNode::MaxRegisterId) {
+    ::throwInvalidBinary();
+  }
+
+  uint8_t const* p = data + ::binaryHeaderSize;
+  uint8_t const* end = data + length;
+
+  std::string uncompressed;
+  if (flags & ::binaryFlagLZ4) {
+#ifdef ARANGODB_HAVE_LZ4
+    if (payloadLength > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+      ::throwInvalidBinary();
+    }
+    uncompressed.resize(payloadLength);
+    int const n = LZ4_decompress_safe(
+        reinterpret_cast<char const*>(p), &uncompressed[0],
+        static_cast<int>(end - p), static_cast<int>(payloadLength));
+    if (n < 0 || static_cast<size_t>(n) != payloadLength) {
+      ::throwInvalidBinary();
+    }
+    p = reinterpret_cast<uint8_t const*>(uncompressed.data());
+    end = p + payloadLength;
+#else
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "received compressed AqlItemBlock, but LZ4 is not available");
+#endif
+  } else if (static_cast<size_t>(end - p) != payloadLength) {
+    ::throwInvalidBinary();
+  }
+
+  auto block = std::make_unique<AqlItemBlock>(
+      resourceMonitor, nrItems, static_cast<RegisterId>(nrRegs));
+
+  VPackValidator validator;
+
+  for (size_t i = 0; i < nrItems; i++) {
+    for (RegisterId column = 0; column < nrRegs; column++) {
+      if (p >= end) {
+        ::throwInvalidBinary();
+      }
+      uint8_t const tag = *p++;
+
+      switch (tag) {
+        case ::BinaryTag::Empty:
+          break;
+
+        case ::BinaryTag::Repeated: {
+          if (i == 0) {
+            ::throwInvalidBinary();
+          }
+          AqlValue const& a = block->getValueReference(i - 1, column);
+          if (!a.isEmpty()) {
+            // shares the value with the previous row
+            block->setValue(i, column, a);
+          }
+          break;
+        }
+
+        case ::BinaryTag::Range: {
+          if (end - p < 16) {
+            ::throwInvalidBinary();
+          }
+          int64_t low = static_cast<int64_t>(::readUInt(p, 8));
+          int64_t high = static_cast<int64_t>(::readUInt(p + 8, 8));
+          p += 16;
+          block->emplaceValue(i, column, low, high);
+          break;
+        }
+
+        case ::BinaryTag::Value: {
+          // throws if the value is invalid or exceeds the buffer
+          validator.validate(p, static_cast<size_t>(end - p), true);
+          VPackSlice slice(p);
+          p += slice.byteSize();
+          block->emplaceValue(i, column, slice);
+          break;
+        }
+
+        default:
+          ::throwInvalidBinary();
+      }
+    }
+  }
+
+  if (p != end) {
+    ::throwInvalidBinary();
+  }
+
+  return block;
+}
@@ -286,6 +286,11 @@ class AqlItemBlock {
   /// losses of still managed AqlValues 
   void rescale(size_t nrItems, RegisterId nrRegs);
 
+  /// @brief transfer the memory accounting of the block to another resource
+  /// monitor. the block must be empty. throws if the new monitor's memory
+  /// limit would be exceeded, in which case the block remains unchanged
+  void resourceMonitor(ResourceMonitor* resourceMonitor);
+
   /// @brief clears out some columns (registers), this deletes the values if
   /// necessary, using the reference count.
   void clearRegisters(std::unordered_set<RegisterId> const& toClear);
@@ -322,6 +327,26 @@ class AqlItemBlock {
   void toVelocyPack(transaction::Methods* trx,
                     arangodb::velocypack::Builder&) const;
 
+  /// @brief version of the binary format written by toBinary
+  static constexpr uint8_t BinaryFormatVersion = 1;
+
+  /// @brief whether or not this build can compress the binary format
+  static bool canCompressBinary();
+
+  /// @brief serialize the block into a compact binary format, which is
+  /// cheaper to produce and to parse than the VelocyPack format above.
+  /// cells are written row by row, and values repeated from the previous
+  /// row in the same register are written only once. if compress is true
+  /// and compression is available, large payloads are compressed with LZ4
+  void toBinary(transaction::Methods* trx, std::string& result,
+                bool compress) const;
+
+  /// @brief create a block from data produced by toBinary. the values are
+  /// copied, so the input buffer may go away afterwards
+  static std::unique_ptr<AqlItemBlock> fromBinary(ResourceMonitor*,
+                                                  uint8_t const* data,
+                                                  size_t length);
+
  private:
   /// @brief _data, the actual data as a single vector of dimensions _nrItems
   /// times _nrRegs
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlItemBlockColumn.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+void AqlItemBlockColumn::reset(AqlItemBlock const& block, RegisterId reg) {
+  TRI_ASSERT(reg < block.getNrRegs());
+
+  size_t const n = block.size();
+
+  _values.clear();
+  _numbers.clear();
+  _bools.clear();
+  _values.reserve(n);
+
+  bool allNumbers = (n > 0);
+  bool allBools = (n > 0);
+
+  for (size_t i = 0; i < n; ++i) {
+    AqlValue const& value = block.getValueReference(i, reg);
+    _values.emplace_back(&value);
+
+    // isNumber() and isBoolean() are false for empty, DOCVEC and RANGE
+    // values, so slice() is safe to use for all values below
+    allNumbers = allNumbers && value.isNumber();
+    allBools = allBools && value.isBoolean();
+  }
+
+  if (allNumbers) {
+    _type = Type::NUMBERS;
+    _numbers.reserve(n);
+    for (auto const& it : _values) {
+      _numbers.emplace_back(it->slice().getNumber<double>());
+    }
+  } else if (allBools) {
+    _type = Type::BOOLS;
+    _bools.reserve(n);
+    for (auto const& it : _values) {
+      _bools.emplace_back(it->slice().getBoolean() ? 1 : 0);
+    }
+  } else {
+    _type = Type::VALUES;
+  }
+}
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_AQL_ITEM_BLOCK_COLUMN_H
+#define ARANGOD_AQL_AQL_ITEM_BLOCK_COLUMN_H 1
+
+#include "Basics/Common.h"
+#include "Aql/types.h"
+
+namespace arangodb {
+namespace aql {
+class AqlItemBlock;
+struct AqlValue;
+
+// an <AqlItemBlockColumn> is a register-major view on a single register
+// of an <AqlItemBlock>. The block itself stores its values row by row,
+// so code that only looks at a single register would otherwise stride
+// over all registers of each row. The column gathers the values of the
+// register once into contiguous memory, so that kernels (e.g. filters or
+// arithmetic) can scan them sequentially.
+//
+// If all values of the register are numbers or all values are booleans,
+// the column additionally decodes them into a typed array of doubles or
+// bools, so that kernels do not need to dispatch on the AqlValue type per
+// row. The generic values are always available.
+//
+// The column does not own any values. It must not be used after the
+// underlying block was modified or destroyed.
+
+class AqlItemBlockColumn {
+ public:
+  enum class Type : uint8_t {
+    NUMBERS,  // all values are numbers, numbers() is valid
+    BOOLS,    // all values are booleans, bools() is valid
+    VALUES    // mixed or other types, only value() is valid
+  };
+
+  AqlItemBlockColumn() : _type(Type::VALUES) {}
+
+  AqlItemBlockColumn(AqlItemBlock const& block, RegisterId reg)
+      : AqlItemBlockColumn() {
+    reset(block, reg);
+  }
+
+  AqlItemBlockColumn(AqlItemBlockColumn const&) = delete;
+  AqlItemBlockColumn& operator=(AqlItemBlockColumn const&) = delete;
+
+  /// @brief gather the values of register reg from the block. the memory
+  /// of a previous column is reused
+  void reset(AqlItemBlock const& block, RegisterId reg);
+
+  /// @brief the type of the column
+  inline Type type() const noexcept { return _type; }
+
+  /// @brief number of rows in the column
+  inline size_t size() const noexcept { return _values.size(); }
+
+  /// @brief get the value of the register in the given row
+  inline AqlValue const& value(size_t row) const {
+    TRI_ASSERT(row < _values.size());
+    return *_values[row];
+  }
+
+  /// @brief contiguous array of size() doubles. only valid for type NUMBERS
+  inline double const* numbers() const noexcept {
+    TRI_ASSERT(_type == Type::NUMBERS);
+    return _numbers.data();
+  }
+
+  /// @brief contiguous array of size() bools (0 or 1). only valid for
+  /// type BOOLS
+  inline uint8_t const* bools() const noexcept {
+    TRI_ASSERT(_type == Type::BOOLS);
+    return _bools.data();
+  }
+
+ private:
+  /// @brief type of the values in the column
+  Type _type;
+
+  /// @brief pointers to the values in the underlying block
+  std::vector<AqlValue const*> _values;
+
+  /// @brief decoded values, if the type is NUMBERS
+  std::vector<double> _numbers;
+
+  /// @brief decoded values, if the type is BOOLS
+  std::vector<uint8_t> _bools;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "AqlItemBlockManager.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/ResourceUsage.h"
 
 using namespace arangodb::aql;
 
@@ -30,36 +31,100 @@ using namespace arangodb::aql;
 AqlItemBlockManager::AqlItemBlockManager(ResourceMonitor* resourceMonitor) 
     : _resourceMonitor(resourceMonitor) {}
 
+/// @brief pool of blocks left over by the managers of finished queries. the
+/// blocks are accounted for in the pool's own resource monitor, whose limit
+/// bounds the memory kept in the pool. idle blocks do not count towards the
+/// memory budget of the running queries
+struct AqlItemBlockManager::ThreadPool {
+  ThreadPool() : monitor(ResourceUsage(maxThreadPoolMemory), false) {}
+
+  // must be declared before the buckets, as the blocks in the buckets
+  // refer to it in their destructors
+  ResourceMonitor monitor;
+  Bucket buckets[numBuckets];
+};
+
 /// @brief destroy the manager
-AqlItemBlockManager::~AqlItemBlockManager() { }
+AqlItemBlockManager::~AqlItemBlockManager() {
+  // hand over our blocks to the pool of the current thread
+  ThreadPool& pool = threadPool();
 
-/// @brief request a block with the specified size
-AqlItemBlock* AqlItemBlockManager::requestBlock(size_t nrItems,
-                                                RegisterId nrRegs) {
-  // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "requesting AqlItemBlock of " << nrItems << " x " << nrRegs;
-  size_t const targetSize = nrItems * nrRegs;
+  for (size_t i = 0; i < numBuckets; ++i) {
+    while (!_buckets[i].empty()) {
+      AqlItemBlock* block = _buckets[i].pop();
+      if (pool.buckets[i].full()) {
+        delete block;
+        continue;
+      }
+      try {
+        block->resourceMonitor(&pool.monitor);
+      } catch (...) {
+        // pool is at its memory limit
+        delete block;
+        continue;
+      }
+      pool.buckets[i].push(block);
+    }
+  }
+}
 
-  AqlItemBlock* block = nullptr;
-  size_t i = Bucket::getId(targetSize);
+/// @brief return the pool of blocks for the current thread
+AqlItemBlockManager::ThreadPool& AqlItemBlockManager::threadPool() {
+  static thread_local ThreadPool pool;
+  return pool;
+}
 
+/// @brief take a block from the bucket with the given id or the next
+/// bigger one
+AqlItemBlock* AqlItemBlockManager::popBlock(Bucket* buckets, size_t id) noexcept {
   int tries = 0;
   while (tries++ < 2) {
-    TRI_ASSERT(i < numBuckets);
-    if (!_buckets[i].empty()) {
-      block = _buckets[i].pop();
+    TRI_ASSERT(id < numBuckets);
+    if (!buckets[id].empty()) {
+      AqlItemBlock* block = buckets[id].pop();
       TRI_ASSERT(block != nullptr);
-      block->eraseAll();
-      block->rescale(nrItems, nrRegs);
-      // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "returned cached AqlItemBlock with dimensions " << block->size() << " x " << block->getNrRegs();
-      break;
+      return block;
     }
     // try next (bigger) bucket
-    if (++i >= numBuckets) {
+    if (++id >= numBuckets) {
       break;
     }
   }
+  return nullptr;
+}
+
+/// @brief request a block with the specified size
+AqlItemBlock* AqlItemBlockManager::requestBlock(size_t nrItems,
+                                                RegisterId nrRegs) {
+  // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "requesting AqlItemBlock of " << nrItems << " x " << nrRegs;
+  size_t const targetSize = nrItems * nrRegs;
+  size_t const id = Bucket::getId(targetSize);
+
+  AqlItemBlock* block = popBlock(_buckets, id);
 
   if (block == nullptr) {
+    // try the blocks left over by earlier queries on this thread
+    block = popBlock(threadPool().buckets, id);
+    if (block != nullptr) {
+      try {
+        block->resourceMonitor(_resourceMonitor);
+      } catch (...) {
+        delete block;
+        throw;
+      }
+    }
+  }
+
+  if (block != nullptr) {
+    block->eraseAll();
+    try {
+      block->rescale(nrItems, nrRegs);
+    } catch (...) {
+      delete block;
+      throw;
+    }
+    // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "returned cached AqlItemBlock with dimensions " << block->size() << " x " << block->getNrRegs();
+  } else {
     block = new AqlItemBlock(_resourceMonitor, nrItems, nrRegs);
     // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "created AqlItemBlock with dimensions " << block->size() << " x " << block->getNrRegs();
   }
@@ -58,12 +58,29 @@ class AqlItemBlockManager {
 
   ResourceMonitor* resourceMonitor() const { return _resourceMonitor; }
 
+ private:
+  struct Bucket;
+  struct ThreadPool;
+
+  /// @brief take a block from the bucket with the given id or the next
+  /// bigger one. returns nullptr if both are empty
+  static AqlItemBlock* popBlock(Bucket* buckets, size_t id) noexcept;
+
+  /// @brief return the pool of blocks for the current thread. when a
+  /// manager is destroyed, its blocks are handed over to this pool, so that
+  /// the next query on the same thread can reuse them instead of allocating
+  /// new blocks
+  static ThreadPool& threadPool();
+
  private:
   ResourceMonitor* _resourceMonitor;
     
   static constexpr size_t numBuckets = 12;
   static constexpr size_t numBlocksPerBucket = 7;
 
+  /// @brief maximum memory for the blocks in the pool of each thread
+  static constexpr size_t maxThreadPoolMemory = 4 * 1024 * 1024;
+
   struct Bucket {
     std::array<AqlItemBlock*, numBlocksPerBucket> blocks;
     size_t numItems;
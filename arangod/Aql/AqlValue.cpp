@@ -113,6 +113,9 @@ bool AqlValue::isNumber() const noexcept {
   if (t == DOCVEC || t == RANGE) {
     return false;
   }
+  if (t == VPACK_INLINE) {
+    return VPackSlice(_data.internal).isNumber();
+  }
   try {
     return slice().isNumber();
   } catch (...) {
@@ -586,6 +589,17 @@ double AqlValue::toDouble(transaction::Methods* trx) const {
 
 double AqlValue::toDouble(transaction::Methods* trx, bool& failed) const {
   failed = false;
+  if (type() == VPACK_INLINE) {
+    // fast path for inline doubles and small ints, which is what all
+    // arithmetic operations produce
+    uint8_t const head = _data.internal[0];
+    if (head == 0x1b) {
+      return VPackSlice(_data.internal).getDouble();
+    }
+    if (head >= 0x30 && head <= 0x39) {
+      return static_cast<double>(head - 0x30);
+    }
+  }
   switch (type()) {
     case VPACK_INLINE:
     case VPACK_SLICE_POINTER:
@@ -634,6 +648,12 @@ double AqlValue::toDouble(transaction::Methods* trx, bool& failed) const {
 
 /// @brief get the numeric value of an AqlValue
 int64_t AqlValue::toInt64(transaction::Methods* trx) const {
+  if (type() == VPACK_INLINE) {
+    uint8_t const head = _data.internal[0];
+    if (head >= 0x30 && head <= 0x39) {
+      return static_cast<int64_t>(head - 0x30);
+    }
+  }
   switch (type()) {
     case VPACK_INLINE:
     case VPACK_SLICE_POINTER:
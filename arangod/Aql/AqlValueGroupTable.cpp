@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlValueGroupTable.h"
+#include "Aql/Aggregator.h"
+#include "Aql/ResourceUsage.h"
+#include "Basics/Exceptions.h"
+
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief make sure the vector has capacity for extra more elements,
+/// growing it geometrically
+template <typename T>
+void reserveExtra(std::vector<T>& v, size_t extra) {
+  size_t const needed = v.size() + extra;
+  if (needed > v.capacity()) {
+    v.reserve((std::max)(needed, v.capacity() * 2));
+  }
+}
+
+}  // namespace
+
+constexpr size_t AqlValueGroupTable::NotFound;
+constexpr uint32_t AqlValueGroupTable::EmptySlot;
+constexpr size_t AqlValueGroupTable::InitialSlots;
+
+AqlValueGroupTable::AqlValueGroupTable(transaction::Methods* trx,
+                                       ResourceMonitor* resourceMonitor,
+                                       size_t numKeys, size_t numAggregators)
+    : _trx(trx),
+      _resourceMonitor(resourceMonitor),
+      _numKeys(numKeys),
+      _numAggregators(numAggregators),
+      _keysMemoryUsage(0),
+      _chargedMemoryUsage(0) {
+  TRI_ASSERT(_numKeys > 0);
+}
+
+AqlValueGroupTable::~AqlValueGroupTable() {
+  clear();
+  if (_resourceMonitor != nullptr) {
+    _resourceMonitor->decreaseMemoryUsage(_chargedMemoryUsage);
+  }
+}
+
+std::pair<size_t, bool> AqlValueGroupTable::findOrInsert(AqlValue const* keys) {
+  if ((size() + 1) * 2 > _slots.size()) {
+    grow();
+  }
+
+  uint64_t const h = hash(keys);
+  size_t const mask = _slots.size() - 1;
+  size_t slot = static_cast<size_t>(h) & mask;
+
+  // linear probing
+  while (_slots[slot] != EmptySlot) {
+    size_t const group = _slots[slot];
+    if (_hashes[group] == h && equal(_keys.data() + group * _numKeys, keys)) {
+      return {group, false};
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  if (size() >= EmptySlot) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT,
+                                   "too many groups");
+  }
+
+  size_t const group = size();
+
+  // reserve space first, so that the following emplaces cannot throw and
+  // leave the vectors in an inconsistent state
+  reserveExtra(_keys, _numKeys);
+  reserveExtra(_aggregators, _numAggregators);
+  reserveExtra(_hashes, 1);
+
+  size_t i = 0;
+  try {
+    for (; i < _numKeys; ++i) {
+      _keys.emplace_back(keys[i].clone());
+    }
+  } catch (...) {
+    while (i-- > 0) {
+      _keys.back().destroy();
+      _keys.pop_back();
+    }
+    throw;
+  }
+  for (size_t j = _keys.size() - _numKeys; j < _keys.size(); ++j) {
+    _keysMemoryUsage += _keys[j].memoryUsage();
+  }
+
+  try {
+    updateMemoryUsage();
+  } catch (...) {
+    // the query is over its memory limit. do not insert the group
+    for (i = 0; i < _numKeys; ++i) {
+      _keysMemoryUsage -= _keys.back().memoryUsage();
+      _keys.back().destroy();
+      _keys.pop_back();
+    }
+    throw;
+  }
+
+  _aggregators.resize(_aggregators.size() + _numAggregators);
+  _hashes.emplace_back(h);
+  _slots[slot] = static_cast<uint32_t>(group);
+
+  return {group, true};
+}
+
+size_t AqlValueGroupTable::find(AqlValue const* keys) const {
+  if (_slots.empty()) {
+    return NotFound;
+  }
+
+  uint64_t const h = hash(keys);
+  size_t const mask = _slots.size() - 1;
+  size_t slot = static_cast<size_t>(h) & mask;
+
+  while (_slots[slot] != EmptySlot) {
+    size_t const group = _slots[slot];
+    if (_hashes[group] == h && equal(_keys.data() + group * _numKeys, keys)) {
+      return group;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  return NotFound;
+}
+
+size_t AqlValueGroupTable::memoryUsage() const noexcept {
+  return _slots.capacity() * sizeof(uint32_t) +
+         _hashes.capacity() * sizeof(uint64_t) +
+         _keys.capacity() * sizeof(AqlValue) +
+         _aggregators.capacity() * sizeof(std::unique_ptr<Aggregator>) +
+         _keysMemoryUsage;
+}
+
+void AqlValueGroupTable::clear() {
+  for (auto& it : _keys) {
+    it.destroy();
+  }
+  _keys.clear();
+  _keysMemoryUsage = 0;
+  _aggregators.clear();
+  _hashes.clear();
+  _slots.clear();
+  // the vectors keep their capacity, which is still charged
+  updateMemoryUsage();
+}
+
+uint64_t AqlValueGroupTable::hash(AqlValue const* keys) const {
+  uint64_t hash = 0x12345678;
+
+  for (size_t i = 0; i < _numKeys; ++i) {
+    // we must use the slow hash function here, because a value may have
+    // different representations in case its an array/object/number
+    // (calls normalizedHash() internally)
+    hash = keys[i].hash(_trx, hash);
+  }
+
+  return hash;
+}
+
+bool AqlValueGroupTable::equal(AqlValue const* lhs, AqlValue const* rhs) const {
+  for (size_t i = 0; i < _numKeys; ++i) {
+    if (AqlValue::Compare(_trx, lhs[i], rhs[i], false) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void AqlValueGroupTable::grow() {
+  size_t const numSlots = _slots.empty() ? InitialSlots : _slots.size() * 2;
+  std::vector<uint32_t> slots(numSlots, EmptySlot);
+
+  size_t const mask = numSlots - 1;
+  size_t const n = size();
+  for (size_t group = 0; group < n; ++group) {
+    size_t slot = static_cast<size_t>(_hashes[group]) & mask;
+    while (slots[slot] != EmptySlot) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = static_cast<uint32_t>(group);
+  }
+
+  _slots.swap(slots);
+
+  // the table is consistent at this point, even if the following throws
+  updateMemoryUsage();
+}
+
+void AqlValueGroupTable::updateMemoryUsage() {
+  if (_resourceMonitor == nullptr) {
+    return;
+  }
+
+  size_t const current = memoryUsage();
+  if (current > _chargedMemoryUsage) {
+    _resourceMonitor->increaseMemoryUsage(current - _chargedMemoryUsage);
+  } else {
+    _resourceMonitor->decreaseMemoryUsage(_chargedMemoryUsage - current);
+  }
+  _chargedMemoryUsage = current;
+}
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_AQL_VALUE_GROUP_TABLE_H
+#define ARANGOD_AQL_AQL_VALUE_GROUP_TABLE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+struct Aggregator;
+struct ResourceMonitor;
+
+/// @brief open-addressing hash table for the groups of a hashed COLLECT.
+/// the key values and the aggregators of all groups are stored inline in
+/// contiguous vectors, in insertion order, and the hash table itself only
+/// contains group numbers. compared to a node-based map of vectors, this
+/// saves several heap allocations per group.
+/// the table owns the key values (they are cloned on insertion) and
+/// the aggregators. key values whose ownership is handed over to someone
+/// else must be erased via keys(group)[i].erase().
+/// if a resource monitor is given, the memory of the table is charged to
+/// it while the table grows, so that a table that gets too big fails with
+/// a resource limit error
+class AqlValueGroupTable {
+ public:
+  /// @brief result of find() if there is no matching group
+  static constexpr size_t NotFound = SIZE_MAX;
+
+  AqlValueGroupTable(transaction::Methods* trx,
+                     ResourceMonitor* resourceMonitor, size_t numKeys,
+                     size_t numAggregators);
+
+  AqlValueGroupTable(AqlValueGroupTable const&) = delete;
+  AqlValueGroupTable& operator=(AqlValueGroupTable const&) = delete;
+
+  ~AqlValueGroupTable();
+
+  /// @brief find the group for the numKeys values in keys. if there is no
+  /// such group, a new group is inserted with clones of the values, and
+  /// null aggregators that must be filled in by the caller. returns the
+  /// group number, and whether or not the group was inserted
+  std::pair<size_t, bool> findOrInsert(AqlValue const* keys);
+
+  /// @brief find the group for the numKeys values in keys. returns the group
+  /// number, or NotFound if there is no such group
+  size_t find(AqlValue const* keys) const;
+
+  /// @brief number of groups
+  inline size_t size() const noexcept { return _hashes.size(); }
+
+  inline bool empty() const noexcept { return _hashes.empty(); }
+
+  /// @brief numKeys key values of the group
+  inline AqlValue* keys(size_t group) noexcept {
+    TRI_ASSERT(group < size());
+    return _keys.data() + group * _numKeys;
+  }
+
+  /// @brief numAggregators aggregators of the group
+  inline std::unique_ptr<Aggregator>* aggregators(size_t group) noexcept {
+    TRI_ASSERT(group < size());
+    return _aggregators.data() + group * _numAggregators;
+  }
+
+  /// @brief memory used by the table, including the key values
+  size_t memoryUsage() const noexcept;
+
+  /// @brief destroy all key values and remove all groups
+  void clear();
+
+ private:
+  uint64_t hash(AqlValue const* keys) const;
+
+  bool equal(AqlValue const* lhs, AqlValue const* rhs) const;
+
+  /// @brief double the number of slots (or allocate the initial slots) and
+  /// reinsert all groups
+  void grow();
+
+  /// @brief charge the change of memoryUsage() since the last call to the
+  /// resource monitor. throws if the memory limit is exceeded
+  void updateMemoryUsage();
+
+ private:
+  /// @brief marker for an empty slot
+  static constexpr uint32_t EmptySlot = UINT32_MAX;
+
+  /// @brief initial number of slots, must be a power of two
+  static constexpr size_t InitialSlots = 1024;
+
+  transaction::Methods* _trx;
+
+  /// @brief monitor the memory of the table is charged to. may be a nullptr
+  ResourceMonitor* _resourceMonitor;
+
+  size_t const _numKeys;
+
+  size_t const _numAggregators;
+
+  /// @brief hash table slots, containing group numbers or EmptySlot. the
+  /// number of slots is a power of two, and at most half of them are used
+  std::vector<uint32_t> _slots;
+
+  /// @brief hash values of all groups
+  std::vector<uint64_t> _hashes;
+
+  /// @brief key values of all groups, numKeys per group
+  std::vector<AqlValue> _keys;
+
+  /// @brief aggregators of all groups, numAggregators per group
+  std::vector<std::unique_ptr<Aggregator>> _aggregators;
+
+  /// @brief memory used by the key values outside of _keys
+  size_t _keysMemoryUsage;
+
+  /// @brief memory currently charged to the resource monitor
+  size_t _chargedMemoryUsage;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
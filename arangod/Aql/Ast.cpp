@@ -1623,6 +1623,15 @@ void Ast::injectBindParameters(
 
             // finally note that the node was created from a bind parameter
             node->setFlag(FLAG_BIND_PARAMETER);
+
+            if (!value.isArray() && !value.isObject()) {
+              // remember the occurrence of scalar values, so the value can
+              // later be exchanged in a cached execution plan
+              _bindParameterOccurrences.emplace_back(param);
+              if (_bindParameterOccurrences.size() <= AstNode::MaxBindParameterId) {
+                node->setBindParameterId(_bindParameterOccurrences.size());
+              }
+            }
           }
         } else {
           TRI_ASSERT(node->type == NODE_TYPE_PARAMETER_DATASOURCE);
@@ -3800,17 +3809,8 @@ std::pair<std::string, bool> Ast::normalizeFunctionName(char const* name, size_t
 AstNode* Ast::createNode(AstNodeType type) {
   TRI_ASSERT(_query != nullptr);
 
-  auto node = new AstNode(type);
-
-  try {
-    // register the node so it gets freed automatically later
-    _query->addNode(node);
-  } catch (...) {
-    delete node;
-    throw;
-  }
-
-  return node;
+  // the node is owned by the query and freed automatically later
+  return _query->createNode(type);
 }
 
 /// @brief validate the name of the given datasource
@@ -117,6 +117,12 @@ class Ast {
     return std::unordered_set<std::string>(_bindParameters);
   }
 
+  /// @brief return the names of the value bind parameters that have been
+  /// injected into the AST, indexed by the id of the occurrence minus one
+  std::vector<std::string> const& bindParameterOccurrences() const {
+    return _bindParameterOccurrences;
+  }
+
   /// @brief get the query scopes
   inline Scopes* scopes() { return &_scopes; }
 
@@ -597,6 +603,11 @@ class Ast {
   /// @brief the bind parameters we found in the query
   std::unordered_set<std::string> _bindParameters;
 
+  /// @brief names of the scalar value bind parameters injected into the AST,
+  /// one entry per occurrence. the position of an entry plus one is the id
+  /// stored in the value node created for the occurrence
+  std::vector<std::string> _bindParameterOccurrences;
+
   /// @brief root node of the AST
   AstNode* _root;
 
@@ -1063,6 +1063,12 @@ void AstNode::toVelocyPack(VPackBuilder& builder, bool verbose) const {
     if (verbose) {
       builder.add("vType", VPackValue(getValueTypeString()));
       builder.add("vTypeID", VPackValue(static_cast<int>(value.type)));
+
+      size_t const id = bindParameterId();
+      if (id != 0) {
+        // transport information about the bind parameter the value came from
+        builder.add("bindParameter", VPackValue(id));
+      }
     }
   }
   
@@ -70,6 +70,8 @@ enum AstNodeFlagType : AstNodeFlagsType {
   FLAG_KEEP_VARIABLENAME =       0x0010000,  // node is a reference to a variable name,  not the variable value (used in KEEP nodes)
   FLAG_BIND_PARAMETER =          0x0020000,  // node was created from a bind parameter
   FLAG_FINALIZED =               0x0040000,  // node has been finalized and should not be modified; only set and checked in maintainer mode
+
+  FLAG_BIND_PARAMETER_ID =       0xff000000,  // id of the bind parameter occurrence a value node was created from
 };
   
 /// @brief enumeration of AST node value types
@@ -221,6 +223,13 @@ struct AstNode {
     return static_cast<std::underlying_type<AstNodeFlagType>::type>(0);
   }
 
+  /// @brief maximum id of a bind parameter occurrence that can be stored
+  /// in a node
+  static constexpr size_t MaxBindParameterId = 255;
+
+  /// @brief position of the bind parameter occurrence id in the node flags
+  static constexpr AstNodeFlagsType BindParameterIdShift = 24;
+
   /// @brief create the node
   explicit AstNode(AstNodeType);
   
@@ -311,9 +320,10 @@ struct AstNode {
     return ((flags & static_cast<decltype(flags)>(flag)) != 0);
   }
 
-  /// @brief reset flags in case a node is changed drastically
+  /// @brief reset flags in case a node is changed drastically. the
+  /// information about the node's origin from a bind parameter is kept
   inline void clearFlags() {
-    flags = 0;
+    flags &= (FLAG_BIND_PARAMETER | FLAG_BIND_PARAMETER_ID);
   }
 
   /// @brief recursively clear flags
@@ -335,6 +345,22 @@ struct AstNode {
     flags &= ~flag;
   }
 
+  /// @brief return the id of the bind parameter occurrence the node was
+  /// created from. returns 0 if the node was not created from a bind parameter
+  /// or if no id was assigned
+  inline size_t bindParameterId() const {
+    return static_cast<size_t>((flags & FLAG_BIND_PARAMETER_ID) >> BindParameterIdShift);
+  }
+
+  /// @brief set the id of the bind parameter occurrence the node was created
+  /// from. the id is stored in the node flags, so it is retained when the node
+  /// is cloned
+  inline void setBindParameterId(size_t id) {
+    TRI_ASSERT(id > 0 && id <= MaxBindParameterId);
+    flags = (flags & ~FLAG_BIND_PARAMETER_ID) |
+            (static_cast<AstNodeFlagsType>(id) << BindParameterIdShift);
+  }
+
   /// @brief whether or not the node value is trueish
   bool isTrue() const;
 
@@ -24,7 +24,11 @@
 #include "BasicBlocks.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
 #include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
 #include "VocBase/vocbase.h"
 
 using namespace arangodb::aql;
@@ -199,7 +203,7 @@ std::pair<ExecutionState, arangodb::Result> FilterBlock::getOrSkipSome(
 
   while (_inflight < atMost) {
     if (_buffer.empty()) {
-      auto upstreamRes = getBlock(DefaultBatchSize());
+      auto upstreamRes = getBlock(batchSize());
       if (upstreamRes.first == ExecutionState::WAITING) {
         // We have not modified result or skipped up to now.
         // Make sure the caller does not have to retain it.
@@ -289,9 +293,39 @@ std::pair<ExecutionState, arangodb::Result> LimitBlock::initializeCursor(
   _result = nullptr;
   _limitSkipped = 0;
 
+  _trackContinuation = (_continuationRegister != ExecutionNode::MaxRegisterId);
+  if (_trackContinuation) {
+    // continue counting the rows with the last value of the previous page
+    auto const& options = _engine->getQuery()->queryOptions();
+    _continuationValue.clear();
+    _continuationSkip = 0;
+    if (options.continuationValue != nullptr) {
+      _continuationValue.add(options.continuationValue->slice());
+      _continuationSkip = options.continuationSkip;
+    }
+  }
+
   return ExecutionBlock::initializeCursor(items, pos);
 }
 
+void LimitBlock::trackContinuation(AqlItemBlock const* block) {
+  auto options = _trx->transactionContextPtr()->getVPackOptions();
+  for (size_t i = 0; i < block->size(); ++i) {
+    AqlValueMaterializer materializer(_trx);
+    VPackSlice value = materializer.slice(
+        block->getValueReference(i, _continuationRegister), false);
+    if (!_continuationValue.isEmpty() &&
+        basics::VelocyPackHelper::compare(_continuationValue.slice(), value,
+                                          true, options) == 0) {
+      ++_continuationSkip;
+    } else {
+      _continuationValue.clear();
+      _continuationValue.add(value);
+      _continuationSkip = 1;
+    }
+  }
+}
+
 std::pair<ExecutionState, arangodb::Result> LimitBlock::getOrSkipSome(
     size_t atMost, bool skipping, AqlItemBlock*& result_, size_t& skipped_) {
   TRI_ASSERT(result_ == nullptr && skipped_ == 0);
@@ -363,6 +397,20 @@ std::pair<ExecutionState, arangodb::Result> LimitBlock::getOrSkipSome(
         if (_fullCount) {
           _engine->_stats.fullCount += static_cast<int64_t>(_limitSkipped);
         }
+        if (_trackContinuation) {
+          if (_result != nullptr) {
+            trackContinuation(_result.get());
+            if (_count >= _limit) {
+              // the page is full, so there may be more rows. the next page
+              // starts after the rows counted here
+              _engine->getQuery()->continuation(QueryOptions::buildContinuation(
+                  _continuationValue.slice(), _continuationSkip));
+            }
+          } else {
+            // skipped rows cannot be tracked
+            _trackContinuation = false;
+          }
+        }
       }
       if (_count >= _limit) {
         if (!_fullCount) {
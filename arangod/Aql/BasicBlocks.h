@@ -103,7 +103,17 @@ class LimitBlock final : public ExecutionBlock {
         _state(State::INITFULLCOUNT),  // start in the beginning
         _fullCount(ep->_fullCount),
         _limitSkipped(0),
-        _result(nullptr) {}
+        _result(nullptr),
+        _continuationRegister(ExecutionNode::MaxRegisterId),
+        _trackContinuation(false),
+        _continuationSkip(0) {
+    if (ep->continuationVariable() != nullptr) {
+      auto it = ep->getRegisterPlan()->varInfo.find(
+          ep->continuationVariable()->id);
+      TRI_ASSERT(it != ep->getRegisterPlan()->varInfo.end());
+      _continuationRegister = it->second.registerId;
+    }
+  }
 
   std::pair<ExecutionState, Result> initializeCursor(AqlItemBlock* items, size_t pos) final override;
 
@@ -116,6 +126,10 @@ class LimitBlock final : public ExecutionBlock {
   ExecutionState getHasMoreState() override;
 
  private:
+  /// @brief keeps track of the last value of the continuation register and
+  /// of the number of rows with this value
+  void trackContinuation(AqlItemBlock const* block);
+
   /// @brief _offset
   size_t const _offset;
 
@@ -141,6 +155,19 @@ class LimitBlock final : public ExecutionBlock {
 
   /// @brief result to return in getOrSkipSome
   std::unique_ptr<AqlItemBlock> _result;
+
+  /// @brief register with the first sort attribute for keyset pagination,
+  /// MaxRegisterId if no continuation token is built
+  RegisterId _continuationRegister;
+
+  /// @brief whether the continuation token can be built. this is not the
+  /// case once rows have been skipped
+  bool _trackContinuation;
+
+  /// @brief last value in the continuation register, and the number of
+  /// rows returned so far with this value, including previous pages
+  arangodb::velocypack::Builder _continuationValue;
+  uint64_t _continuationSkip;
 };
 
 class ReturnBlock final : public ExecutionBlock {
@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BatchExpression.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/Ast.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/Variable.h"
+#include "Basics/Exceptions.h"
+#include "Basics/ScopeGuard.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief largest integer that can be converted to a double without loss
+constexpr int64_t maxExactInteger = int64_t(1) << 53;
+
+/// @brief whether or not the value is a number whose comparison as a double
+/// yields the same result as AqlValue::Compare
+bool toExactDouble(VPackSlice s, double& result) {
+  switch (s.type()) {
+    case VPackValueType::Double:
+      result = s.getDouble();
+      return true;
+    case VPackValueType::SmallInt:
+    case VPackValueType::Int: {
+      int64_t v = s.getInt();
+      if (v > maxExactInteger || v < -maxExactInteger) {
+        return false;
+      }
+      result = static_cast<double>(v);
+      return true;
+    }
+    case VPackValueType::UInt: {
+      uint64_t v = s.getUInt();
+      if (v > static_cast<uint64_t>(maxExactInteger)) {
+        return false;
+      }
+      result = static_cast<double>(v);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool isComparison(AstNodeType type) {
+  return (type == NODE_TYPE_OPERATOR_BINARY_EQ ||
+          type == NODE_TYPE_OPERATOR_BINARY_NE ||
+          type == NODE_TYPE_OPERATOR_BINARY_LT ||
+          type == NODE_TYPE_OPERATOR_BINARY_LE ||
+          type == NODE_TYPE_OPERATOR_BINARY_GT ||
+          type == NODE_TYPE_OPERATOR_BINARY_GE);
+}
+
+/// @brief applies the comparison to all numbers
+template <typename Op>
+void compareNumbers(std::vector<double> const& numbers, double constant,
+                    std::vector<uint8_t>& selection, Op const& op) {
+  size_t const n = numbers.size();
+  double const* values = numbers.data();
+  uint8_t* out = selection.data();
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = op(values[i], constant) ? 1 : 0;
+  }
+}
+
+}  // namespace
+
+/// @brief a node of the compiled expression. either a logical operator
+/// (&&, ||, !) or a comparison between a register value (or an attribute
+/// of it) and a constant
+struct BatchExpression::Node {
+  explicit Node(AstNodeType type)
+      : type(type), reg(ExecutionNode::MaxRegisterId),
+        constantIsNumber(false), constantNumber(0.0) {}
+
+  AstNodeType type;
+
+  /// @brief operands of logical operators (rhs is unused for !)
+  std::unique_ptr<Node> lhs;
+  std::unique_ptr<Node> rhs;
+
+  /// @brief comparisons only: register and attribute path of the operand.
+  /// an empty path means the register value itself is compared
+  RegisterId reg;
+  std::vector<std::string> path;
+
+  /// @brief comparisons only: the constant. points into the AST
+  AqlValue constant;
+  bool constantIsNumber;
+  double constantNumber;
+};
+
+BatchExpression::BatchExpression(std::unique_ptr<Node> root)
+    : _root(std::move(root)) {}
+
+BatchExpression::~BatchExpression() {}
+
+std::unique_ptr<BatchExpression> BatchExpression::compile(
+    AstNode const* node, std::vector<Variable const*> const& vars,
+    std::vector<RegisterId> const& regs) {
+  TRI_ASSERT(vars.size() == regs.size());
+  auto root = compileNode(node, vars, regs);
+  if (root == nullptr) {
+    return nullptr;
+  }
+  return std::unique_ptr<BatchExpression>(new BatchExpression(std::move(root)));
+}
+
+std::unique_ptr<BatchExpression::Node> BatchExpression::compileNode(
+    AstNode const* node, std::vector<Variable const*> const& vars,
+    std::vector<RegisterId> const& regs) {
+  AstNodeType type = node->type;
+
+  if (type == NODE_TYPE_OPERATOR_BINARY_AND ||
+      type == NODE_TYPE_OPERATOR_BINARY_OR ||
+      type == NODE_TYPE_OPERATOR_NARY_AND ||
+      type == NODE_TYPE_OPERATOR_NARY_OR) {
+    bool const isAnd = (type == NODE_TYPE_OPERATOR_BINARY_AND ||
+                        type == NODE_TYPE_OPERATOR_NARY_AND);
+    size_t const n = node->numMembers();
+    if (n == 0) {
+      return nullptr;
+    }
+    // n-ary operators are turned into a chain of binary operators
+    auto result = compileNode(node->getMemberUnchecked(0), vars, regs);
+    for (size_t i = 1; i < n && result != nullptr; ++i) {
+      auto rhs = compileNode(node->getMemberUnchecked(i), vars, regs);
+      if (rhs == nullptr) {
+        return nullptr;
+      }
+      auto combined = std::make_unique<Node>(
+          isAnd ? NODE_TYPE_OPERATOR_BINARY_AND : NODE_TYPE_OPERATOR_BINARY_OR);
+      combined->lhs = std::move(result);
+      combined->rhs = std::move(rhs);
+      result = std::move(combined);
+    }
+    return result;
+  }
+
+  if (type == NODE_TYPE_OPERATOR_UNARY_NOT) {
+    auto operand = compileNode(node->getMember(0), vars, regs);
+    if (operand == nullptr) {
+      return nullptr;
+    }
+    auto result = std::make_unique<Node>(type);
+    result->lhs = std::move(operand);
+    return result;
+  }
+
+  if (!isComparison(type)) {
+    return nullptr;
+  }
+
+  AstNode const* operand = node->getMember(0);
+  AstNode const* constant = node->getMember(1);
+  if (operand->isConstant()) {
+    // constant on the left-hand side: swap the operands
+    std::swap(operand, constant);
+    auto it = Ast::ReversedOperators.find(static_cast<int>(type));
+    TRI_ASSERT(it != Ast::ReversedOperators.end());
+    type = (*it).second;
+  }
+  if (!constant->isConstant()) {
+    return nullptr;
+  }
+
+  auto result = std::make_unique<Node>(type);
+
+  // collect the attribute path down to the variable reference
+  while (operand->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    result->path.emplace_back(operand->getString());
+    operand = operand->getMember(0);
+  }
+  if (operand->type != NODE_TYPE_REFERENCE) {
+    return nullptr;
+  }
+  std::reverse(result->path.begin(), result->path.end());
+
+  auto variable = static_cast<Variable const*>(operand->getData());
+  for (size_t i = 0; i < vars.size(); ++i) {
+    if (vars[i] == variable) {
+      result->reg = regs[i];
+      break;
+    }
+  }
+  if (result->reg == ExecutionNode::MaxRegisterId) {
+    return nullptr;
+  }
+
+  VPackSlice value = constant->computeValue();
+  result->constant = AqlValue(value.begin());
+  result->constantIsNumber = toExactDouble(value, result->constantNumber);
+
+  return result;
+}
+
+/// @brief evaluate the expression for all rows of the block
+void BatchExpression::evaluate(transaction::Methods* trx,
+                               AqlItemBlock const& block,
+                               std::vector<uint8_t>& selection) {
+  selection.resize(block.size());
+  evaluateNode(_root.get(), trx, block, selection);
+}
+
+void BatchExpression::evaluateNode(Node const* node, transaction::Methods* trx,
+                                   AqlItemBlock const& block,
+                                   std::vector<uint8_t>& selection) {
+  size_t const n = selection.size();
+
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR: {
+      // both operands are booleans and have no side effects, so we can
+      // evaluate both of them for all rows and combine the results
+      evaluateNode(node->lhs.get(), trx, block, selection);
+      std::vector<uint8_t> other(n);
+      evaluateNode(node->rhs.get(), trx, block, other);
+      if (node->type == NODE_TYPE_OPERATOR_BINARY_AND) {
+        for (size_t i = 0; i < n; ++i) {
+          selection[i] &= other[i];
+        }
+      } else {
+        for (size_t i = 0; i < n; ++i) {
+          selection[i] |= other[i];
+        }
+      }
+      break;
+    }
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      evaluateNode(node->lhs.get(), trx, block, selection);
+      for (size_t i = 0; i < n; ++i) {
+        selection[i] ^= 1;
+      }
+      break;
+    }
+    default: {
+      evaluateComparison(node, trx, block, selection);
+      break;
+    }
+  }
+}
+
+void BatchExpression::evaluateComparison(Node const* node,
+                                         transaction::Methods* trx,
+                                         AqlItemBlock const& block,
+                                         std::vector<uint8_t>& selection) {
+  size_t const n = selection.size();
+
+  // extract the operand values for all rows. attribute values are
+  // references into the documents, except for _id, which is built on the
+  // fly and must be freed afterwards
+  _values.clear();
+  _values.reserve(n);
+  std::vector<size_t> toDestroy;
+  TRI_DEFER(for (auto const& i : toDestroy) { _values[i].destroy(); });
+
+  _numbers.clear();
+  bool allNumbers = node->constantIsNumber;
+  if (allNumbers) {
+    _numbers.reserve(n);
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    AqlValue const& value = block.getValueReference(i, node->reg);
+    if (node->path.empty()) {
+      _values.emplace_back(value);
+    } else {
+      bool mustDestroy;
+      if (node->path.size() == 1) {
+        _values.emplace_back(value.get(trx, node->path[0], mustDestroy, false));
+      } else {
+        _values.emplace_back(value.get(trx, node->path, mustDestroy, false));
+      }
+      if (mustDestroy) {
+        try {
+          toDestroy.emplace_back(i);
+        } catch (...) {
+          _values.back().destroy();
+          throw;
+        }
+      }
+    }
+
+    if (allNumbers) {
+      double number;
+      AqlValue const& v = _values.back();
+      if (v.isNumber() && toExactDouble(v.slice(), number)) {
+        _numbers.emplace_back(number);
+      } else {
+        allNumbers = false;
+      }
+    }
+  }
+
+  if (allNumbers) {
+    // fast path: all operands and the constant are numbers
+    double const c = node->constantNumber;
+    switch (node->type) {
+      case NODE_TYPE_OPERATOR_BINARY_EQ:
+        compareNumbers(_numbers, c, selection, std::equal_to<double>());
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_NE:
+        compareNumbers(_numbers, c, selection, std::not_equal_to<double>());
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_LT:
+        compareNumbers(_numbers, c, selection, std::less<double>());
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_LE:
+        compareNumbers(_numbers, c, selection, std::less_equal<double>());
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_GT:
+        compareNumbers(_numbers, c, selection, std::greater<double>());
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_GE:
+        compareNumbers(_numbers, c, selection, std::greater_equal<double>());
+        break;
+      default:
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "unhandled comparison operator");
+    }
+    return;
+  }
+
+  // generic path, with the same semantics as
+  // Expression::executeSimpleExpressionComparison
+  bool const compareUtf8 = (node->type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+                            node->type != NODE_TYPE_OPERATOR_BINARY_NE);
+
+  for (size_t i = 0; i < n; ++i) {
+    int const cmp = AqlValue::Compare(trx, _values[i], node->constant, compareUtf8);
+    bool result;
+    switch (node->type) {
+      case NODE_TYPE_OPERATOR_BINARY_EQ:
+        result = (cmp == 0);
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_NE:
+        result = (cmp != 0);
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_LT:
+        result = (cmp < 0);
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_LE:
+        result = (cmp <= 0);
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_GT:
+        result = (cmp > 0);
+        break;
+      case NODE_TYPE_OPERATOR_BINARY_GE:
+        result = (cmp >= 0);
+        break;
+      default:
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "unhandled comparison operator");
+    }
+    selection[i] = result ? 1 : 0;
+  }
+}
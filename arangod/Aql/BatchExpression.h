@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_BATCH_EXPRESSION_H
+#define ARANGOD_AQL_BATCH_EXPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Aql/AstNode.h"
+#include "Aql/types.h"
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+class AqlItemBlock;
+struct Variable;
+
+/// @brief a simple boolean expression that is evaluated for all rows of an
+/// AqlItemBlock at once, instead of row by row via the AstNode interpreter
+/// in Expression. supported are the comparison operators ==, !=, <, <=, >
+/// and >= between a (possibly nested) attribute access on a variable or
+/// a variable reference on one side and a constant on the other side, and
+/// arbitrary combinations of these via &&, || and !.
+/// the result of the evaluation is a selection vector with one entry per
+/// row, which is 1 if the expression is true for the row and 0 otherwise.
+/// comparisons whose inputs are all numbers are done in tight loops over
+/// doubles, which the compiler can vectorize
+class BatchExpression {
+ public:
+  BatchExpression(BatchExpression const&) = delete;
+  BatchExpression& operator=(BatchExpression const&) = delete;
+
+  ~BatchExpression();
+
+  /// @brief try to compile the expression. returns a nullptr if the
+  /// expression is not supported. vars and regs map the variables used in
+  /// the expression to their registers
+  static std::unique_ptr<BatchExpression> compile(
+      AstNode const* node, std::vector<Variable const*> const& vars,
+      std::vector<RegisterId> const& regs);
+
+  /// @brief evaluate the expression for all rows of the block
+  void evaluate(transaction::Methods* trx, AqlItemBlock const& block,
+                std::vector<uint8_t>& selection);
+
+ private:
+  struct Node;
+
+  explicit BatchExpression(std::unique_ptr<Node> root);
+
+  static std::unique_ptr<Node> compileNode(
+      AstNode const* node, std::vector<Variable const*> const& vars,
+      std::vector<RegisterId> const& regs);
+
+  void evaluateNode(Node const* node, transaction::Methods* trx,
+                    AqlItemBlock const& block, std::vector<uint8_t>& selection);
+
+  void evaluateComparison(Node const* node, transaction::Methods* trx,
+                          AqlItemBlock const& block,
+                          std::vector<uint8_t>& selection);
+
+ private:
+  std::unique_ptr<Node> _root;
+
+  /// @brief reused buffer for the operand values of a comparison
+  std::vector<AqlValue> _values;
+
+  /// @brief reused buffer for the numeric operand values of a comparison
+  std::vector<double> _numbers;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -24,6 +24,7 @@
 #include "CalculationBlock.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/BaseExpressionContext.h"
+#include "Aql/BatchExpression.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/Functions.h"
 #include "Aql/Query.h"
@@ -66,6 +67,9 @@ CalculationBlock::CalculationBlock(ExecutionEngine* engine,
 
   if (_isReference) {
     TRI_ASSERT(_inRegs.size() == 1);
+  } else if (!_expression->willUseV8() && en->_conditionVariable == nullptr) {
+    // simple comparisons can be evaluated for an entire block at once
+    _batchExpression = BatchExpression::compile(_expression->node(), _inVars, _inRegs);
   }
 
   auto it3 = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
@@ -137,6 +141,23 @@ void CalculationBlock::executeExpression(AqlItemBlock* result) {
   }
 }
 
+/// @brief execute the batch expression for all rows of the block at once
+void CalculationBlock::executeBatchExpression(AqlItemBlock* result) {
+  TRI_ASSERT(_batchExpression != nullptr);
+
+  _batchExpression->evaluate(_trx, *result, _selection);
+
+  size_t const n = result->size();
+  TRI_ASSERT(_selection.size() == n);
+  for (size_t i = 0; i < n; i++) {
+    TRI_IF_FAILURE("CalculationBlock::executeExpression") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+    result->emplaceValue(i, _outReg, AqlValueHintBool(_selection[i] != 0));
+  }
+  throwIfKilled();  // check if we were aborted
+}
+
 /// @brief doEvaluation, private helper to do the work
 void CalculationBlock::doEvaluation(AqlItemBlock* result) {
   TRI_ASSERT(result != nullptr);
@@ -153,7 +174,9 @@ void CalculationBlock::doEvaluation(AqlItemBlock* result) {
 
   TRI_ASSERT(_expression != nullptr);
 
-  if (!_expression->willUseV8()) {
+  if (_batchExpression != nullptr) {
+    executeBatchExpression(result);
+  } else if (!_expression->willUseV8()) {
     // an expression that does not require V8
     executeExpression(result);
   } else {
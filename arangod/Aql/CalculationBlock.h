@@ -31,6 +31,7 @@ namespace arangodb {
 namespace aql {
 
 class AqlItemBlock;
+class BatchExpression;
 
 class ExecutionEngine;
 
@@ -48,6 +49,9 @@ class CalculationBlock final : public ExecutionBlock {
   /// @brief shared code for executing a simple or a V8 expression
   void executeExpression(AqlItemBlock*);
 
+  /// @brief execute the batch expression for all rows of the block at once
+  void executeBatchExpression(AqlItemBlock*);
+
   /// @brief doEvaluation, private helper to do the work
   void doEvaluation(AqlItemBlock*);
 
@@ -60,6 +64,13 @@ class CalculationBlock final : public ExecutionBlock {
   /// @brief we hold a pointer to the expression in the plan
   Expression* _expression;
 
+  /// @brief compiled version of the expression for batch evaluation, if the
+  /// expression is simple enough (nullptr otherwise)
+  std::unique_ptr<BatchExpression> _batchExpression;
+
+  /// @brief selection vector buffer for the batch evaluation
+  std::vector<uint8_t> _selection;
+
   /// @brief info about input variables
   std::vector<Variable const*> _inVars;
 
@@ -54,6 +54,7 @@
 #include <velocypack/Collection.h>
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -65,6 +66,48 @@ using StringBuffer = arangodb::basics::StringBuffer;
 
 namespace {
 
+/// @brief parse the body of a response from a DB server. responses can
+/// be sent as VelocyPack by servers that honor our Accept header, in which
+/// case the body is only validated. older servers will respond with JSON
+std::shared_ptr<VPackBuilder> parseResponseBody(
+    arangodb::httpclient::SimpleHttpResult& response) {
+  bool found = false;
+  std::string const contentType =
+      response.getHeaderField(StaticStrings::ContentTypeHeader, found);
+  arangodb::basics::StringBuffer const& body = response.getBody();
+
+  if (found && contentType.compare(0, StaticStrings::MimeTypeVPack.size(),
+                                   StaticStrings::MimeTypeVPack) == 0) {
+    uint8_t const* data = reinterpret_cast<uint8_t const*>(body.c_str());
+    VPackValidator validator;
+    validator.validate(data, body.length());
+
+    auto builder = std::make_shared<VPackBuilder>();
+    builder->add(VPackSlice(data));
+    return builder;
+  }
+
+  return VPackParser::fromJson(body.c_str(), body.length());
+}
+
+/// @brief create an AqlItemBlock from a getSome response, in either the
+/// binary or the VelocyPack format. returns a nullptr if the response does
+/// not contain a block
+std::unique_ptr<AqlItemBlock> blockFromResponse(ResourceMonitor* resourceMonitor,
+                                                VPackSlice slice) {
+  VPackSlice binary = slice.get("block");
+  if (binary.isBinary()) {
+    VPackValueLength length;
+    uint8_t const* data = binary.getBinary(length);
+    return AqlItemBlock::fromBinary(resourceMonitor, data,
+                                    static_cast<size_t>(length));
+  }
+  if (slice.hasKey("data")) {
+    return std::make_unique<AqlItemBlock>(resourceMonitor, slice);
+  }
+  return nullptr;
+}
+
 /// @brief OurLessThan: comparison method for elements of SortingGatherBlock
 class OurLessThan {
  public:
@@ -188,6 +231,98 @@ class HeapSorting final : public SortingStrategy, private OurLessThan  {
   std::vector<std::reference_wrapper<ValueType>> _heap;
 }; // HeapSorting
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class TournamentSorting
+/// @brief "Tournament" sorting strategy, using a tree of losers. after the
+/// initial build, every value costs log2(number of dependencies) comparisons,
+/// as only the path from the previous winner to the root is replayed
+////////////////////////////////////////////////////////////////////////////////
+class TournamentSorting final : public SortingStrategy, private OurLessThan {
+ public:
+  TournamentSorting(
+      arangodb::transaction::Methods* trx,
+      std::vector<std::deque<AqlItemBlock*>> const& gatherBlockBuffer,
+      std::vector<SortRegister>& sortRegisters) noexcept
+    : OurLessThan(trx, gatherBlockBuffer, sortRegisters),
+      _blockPos(nullptr),
+      _built(false) {
+  }
+
+  virtual ValueType nextValue() override {
+    TRI_ASSERT(_blockPos);
+    TRI_ASSERT(!_tree.empty());
+
+    if (!_built) {
+      build();
+    } else {
+      // the previous winner has moved on to its next row
+      replay(_tree[0]);
+    }
+    return (*_blockPos)[_tree[0]];
+  }
+
+  virtual void prepare(std::vector<ValueType>& blockPos) override {
+    TRI_ASSERT(!blockPos.empty());
+
+    if (_blockPos == &blockPos && _tree.size() == blockPos.size()) {
+      return;
+    }
+
+    _blockPos = &blockPos;
+    _tree.assign(blockPos.size(), 0);
+    _built = false;
+  }
+
+  virtual void reset() noexcept override {
+    _blockPos = nullptr;
+    _tree.clear();
+    _built = false;
+  }
+
+ private:
+  bool less(size_t a, size_t b) const {
+    return OurLessThan::operator()((*_blockPos)[a], (*_blockPos)[b]);
+  }
+
+  /// @brief play all matches. leaf i is at position n + i of an implicit
+  /// complete binary tree, the inner nodes 1 to n - 1 store the losers,
+  /// and _tree[0] stores the overall winner
+  void build() {
+    size_t const n = _tree.size();
+    std::vector<size_t> winners(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+      winners[n + i] = i;
+    }
+    for (size_t node = n - 1; node > 0; --node) {
+      size_t a = winners[2 * node];
+      size_t b = winners[2 * node + 1];
+      if (less(b, a)) {
+        std::swap(a, b);
+      }
+      winners[node] = a;
+      _tree[node] = b;
+    }
+    _tree[0] = winners[1];
+    _built = true;
+  }
+
+  /// @brief replay the matches on the path from leaf i to the root
+  void replay(size_t i) {
+    size_t const n = _tree.size();
+    size_t winner = i;
+    for (size_t node = (n + i) / 2; node > 0; node /= 2) {
+      if (less(_tree[node], winner)) {
+        std::swap(_tree[node], winner);
+      }
+    }
+    _tree[0] = winner;
+  }
+
+  std::vector<ValueType> const* _blockPos;
+  std::vector<size_t> _tree;
+  bool _built;
+}; // TournamentSorting
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @class MinElementSorting
 /// @brief "MinElement" sorting strategy
@@ -744,9 +879,7 @@ arangodb::Result RemoteBlock::handleCommErrors(ClusterCommResult* res) const {
     int errorNum = TRI_ERROR_INTERNAL;
     if (res->result != nullptr) {
       errorNum = TRI_ERROR_NO_ERROR;
-      arangodb::basics::StringBuffer const& responseBodyBuf(res->result->getBody());
-      std::shared_ptr<VPackBuilder> builder = VPackParser::fromJson(
-          responseBodyBuf.c_str(), responseBodyBuf.length());
+      std::shared_ptr<VPackBuilder> builder = ::parseResponseBody(*res->result);
       VPackSlice slice = builder->slice();
 
       if (!slice.hasKey(StaticStrings::Error) || slice.get(StaticStrings::Error).getBoolean()) {
@@ -800,7 +933,7 @@ std::shared_ptr<VPackBuilder> RemoteBlock::stealResultBody() {
   }
   // We have an open result still.
   // Result is the response which is an object containing the ErrorCode
-  std::shared_ptr<VPackBuilder> responseBodyBuilder = _lastResponse->getBodyVelocyPack();
+  std::shared_ptr<VPackBuilder> responseBodyBuilder = ::parseResponseBody(*_lastResponse);
   _lastResponse.reset();
   return responseBodyBuilder;
 }
@@ -819,12 +952,27 @@ RemoteBlock::RemoteBlock(ExecutionEngine* engine, RemoteNode const* en,
       _isResponsibleForInitializeCursor(
           en->isResponsibleForInitializeCursor()),
       _lastResponse(nullptr),
-      _lastError(TRI_ERROR_NO_ERROR) {
+      _lastError(TRI_ERROR_NO_ERROR),
+      _requestInFlight(false),
+      _prefetchedDone(false),
+      _prefetch(1),
+      _maxPrefetch((std::max)(size_t(1), engine->getQuery()->queryOptions().remotePrefetch)),
+      _requestStart(0.0),
+      _requestEnd(0.0),
+      _remoteMemoryUsage(0),
+      _remotePeakMemoryUsage(0) {
   TRI_ASSERT(!queryId.empty());
   TRI_ASSERT(
       (arangodb::ServerState::instance()->isCoordinator() && ownName.empty()) ||
       (!arangodb::ServerState::instance()->isCoordinator() &&
        !ownName.empty()));
+
+  // the DB server may have returned the first rows of the snippet already,
+  // together with the response to the setup request
+  auto setupResult = engine->getQuery()->stealSnippetSetupResult(queryId);
+  if (setupResult != nullptr) {
+    storeGetSomeResponse(setupResult->slice());
+  }
 }
 
 Result RemoteBlock::sendAsyncRequest(
@@ -842,11 +990,28 @@ Result RemoteBlock::sendAsyncRequest(
   if (!_ownName.empty()) {
     headers.emplace("Shard-Id", _ownName);
   }
+  // ask for VelocyPack responses, which saves JSON stringification and
+  // parsing on both sides
+  headers.emplace(StaticStrings::Accept, StaticStrings::MimeTypeVPack);
+  bool const trace = (_profile >= PROFILE_LEVEL_BLOCKS);
+  if (trace && _ownName.empty()) {
+    // lets the DB servers' request logs be correlated with the query
+    headers.emplace(StaticStrings::TraceId,
+                    basics::StringUtils::itoa(_engine->getQuery()->id()));
+  }
     
   std::string url = std::string("/_db/") +
     arangodb::basics::StringUtils::urlEncode(_engine->getQuery()->trx()->vocbase().name()) + 
     urlPart + _queryId;
 
+  {
+    std::lock_guard<std::mutex> guard(_communicationMutex);
+    TRI_ASSERT(!_requestInFlight);
+    _requestInFlight = true;
+    _lastRequest = urlPart;
+    _requestStart = trace ? TRI_microtime() : 0.0;
+  }
+
   ++_engine->_stats.requests;
   std::shared_ptr<ClusterCommCallback> callback =
       std::make_shared<WakeupQueryCallback>(this, _engine->getQuery());
@@ -864,6 +1029,17 @@ std::pair<ExecutionState, Result> RemoteBlock::initializeCursor(
     AqlItemBlock* items, size_t pos) {
   // For every call we simply forward via HTTP
 
+  if (isWaitingForResponse()) {
+    return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+  }
+  discardResponseUnlessFor("/_api/aql/initializeCursor/");
+
+  if (items != nullptr) {
+    // batches fetched ahead belong to the previous input. the initial call
+    // has no input, and must keep the rows returned by the snippet setup
+    resetPrefetched();
+  }
+
   if (!_isResponsibleForInitializeCursor) {
     // do nothing...
     return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
@@ -922,13 +1098,52 @@ std::pair<ExecutionState, Result> RemoteBlock::initializeCursor(
 bool RemoteBlock::handleAsyncResult(ClusterCommResult* result) {
   // TODO Handle exceptions thrown while we are in this code
   // Query will not be woken up again.
-  _lastError = handleCommErrors(result);
+  Result error = handleCommErrors(result);
+
+  std::lock_guard<std::mutex> guard(_communicationMutex);
+  _lastError = std::move(error);
   if (_lastError.ok()) {
     _lastResponse = result->result;
   }
+  if (_requestStart > 0.0) {
+    _requestEnd = TRI_microtime();
+  }
+  _requestInFlight = false;
   return true;
 }
 
+bool RemoteBlock::isWaitingForResponse() {
+  // once this returns false, the callback will not touch the response
+  // members anymore until the next request is sent
+  std::lock_guard<std::mutex> guard(_communicationMutex);
+  if (!_requestInFlight && _requestStart > 0.0) {
+    // the traced request has completed. only the query thread gets here,
+    // so the engine statistics can be modified safely
+    ExecutionStats::Span span;
+    span.server = _server;
+    span.operation = _lastRequest;
+    if (span.operation.compare(0, 10, "/_api/aql/") == 0) {
+      span.operation.erase(0, 10);
+    }
+    if (!span.operation.empty() && span.operation.back() == '/') {
+      span.operation.pop_back();
+    }
+    span.start = _requestStart;
+    span.duration = _requestEnd - _requestStart;
+    _engine->_stats.addSpan(std::move(span));
+    _requestStart = 0.0;
+  }
+  return _requestInFlight;
+}
+
+void RemoteBlock::discardResponseUnlessFor(char const* urlPart) {
+  TRI_ASSERT(!_requestInFlight);
+  if ((_lastResponse != nullptr || _lastError.fail()) && _lastRequest != urlPart) {
+    _lastResponse.reset();
+    _lastError.reset();
+  }
+}
+
 /// @brief shutdown, will be called exactly once for the whole query
 std::pair<ExecutionState, Result> RemoteBlock::shutdown(int errorCode) {
   /* We need to handle this here in ASYNC case
@@ -939,6 +1154,13 @@ std::pair<ExecutionState, Result> RemoteBlock::shutdown(int errorCode) {
     }
   */
 
+  if (isWaitingForResponse()) {
+    return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
+  }
+  discardResponseUnlessFor("/_api/aql/shutdown/");
+
+  resetPrefetched();
+
   if (_lastError.fail()) {
     TRI_ASSERT(_lastResponse == nullptr);
     Result res = _lastError;
@@ -957,6 +1179,11 @@ std::pair<ExecutionState, Result> RemoteBlock::shutdown(int errorCode) {
 
     VPackSlice slice = responseBodyBuilder->slice();
     if (slice.isObject()) {
+      // the snippet is gone now, only its peak remains of interest
+      trackRemoteMemoryUsage(slice);
+      _engine->getQuery()->addRemoteMemoryUsage(-static_cast<int64_t>(_remoteMemoryUsage), 0);
+      _remoteMemoryUsage = 0;
+
       if (slice.hasKey("stats")) {
         ExecutionStats newStats(slice.get("stats"));
         _engine->_stats.add(newStats);
@@ -1009,6 +1236,13 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSome(si
   // For every call we simply forward via HTTP
   traceGetSomeBegin(atMost);
 
+  if (isWaitingForResponse()) {
+    // we have been asked again before our response arrived, e.g. by a
+    // gather block that polls all of its dependencies
+    traceGetSomeEnd(nullptr, ExecutionState::WAITING);
+    return {ExecutionState::WAITING, nullptr};
+  }
+
   if (_lastError.fail()) {
     TRI_ASSERT(_lastResponse == nullptr);
     Result res = _lastError;
@@ -1020,25 +1254,15 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSome(si
   if (_lastResponse != nullptr) {
     TRI_ASSERT(_lastError.ok());
     // We do not have an error but a result, all is good
-    // We have an open result still.
-    std::shared_ptr<VPackBuilder> responseBodyBuilder = stealResultBody();
-    // Result is the response which will be a serialized AqlItemBlock
-
-    // both must be reset before return or throw
-    TRI_ASSERT(_lastError.ok() && _lastResponse == nullptr);
+    storeGetSomeResponse();
+  }
 
-    VPackSlice responseBody = responseBodyBuilder->slice();
+  if (!_prefetched.empty()) {
+    // serve batches received earlier, without any communication
+    return getSomeFromPrefetched(atMost);
+  }
 
-    ExecutionState state = ExecutionState::HASMORE;
-    if (VelocyPackHelper::getBooleanValue(responseBody, "done", true)) {
-      state = ExecutionState::DONE;
-    }
-    if (responseBody.hasKey("data")) {
-      auto r = std::make_unique<AqlItemBlock>(
-          _engine->getQuery()->resourceMonitor(), responseBody);
-      traceGetSomeEnd(r.get(), state);
-      return {state, std::move(r)};
-    }
+  if (_prefetchedDone) {
     traceGetSomeEnd(nullptr, ExecutionState::DONE);
     return {ExecutionState::DONE, nullptr};
   }
@@ -1047,6 +1271,16 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSome(si
   VPackBuilder builder;
   builder.openObject();
   builder.add("atMost", VPackValue(atMost));
+  if (_prefetch > 1) {
+    // older servers will ignore this and send a single batch
+    builder.add("prefetch", VPackValue(_prefetch));
+  }
+  // servers that understand the binary block format will use it,
+  // older servers will ignore these attributes
+  builder.add("blockFormat", VPackValue(AqlItemBlock::BinaryFormatVersion));
+  if (AqlItemBlock::canCompressBinary()) {
+    builder.add("compression", VPackValue("lz4"));
+  }
   builder.close();
 
   auto bodyString = std::make_shared<std::string const>(builder.slice().toJson());
@@ -1061,8 +1295,99 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSome(si
   return {ExecutionState::WAITING, nullptr};
 }
 
+/// @brief move the batches of a getSome response into _prefetched
+void RemoteBlock::storeGetSomeResponse() {
+  TRI_ASSERT(_prefetched.empty());
+
+  std::shared_ptr<VPackBuilder> responseBodyBuilder = stealResultBody();
+  // Result is the response which will contain serialized AqlItemBlocks
+
+  // both must be reset before return or throw
+  TRI_ASSERT(_lastError.ok() && _lastResponse == nullptr);
+
+  storeGetSomeResponse(responseBodyBuilder->slice());
+}
+
+void RemoteBlock::storeGetSomeResponse(VPackSlice responseBody) {
+  TRI_ASSERT(_prefetched.empty());
+
+  ResourceMonitor* resourceMonitor = _engine->getQuery()->resourceMonitor();
+
+  VPackSlice blocks = responseBody.get("blocks");
+  if (blocks.isArray()) {
+    // the remote side has sent multiple batches at once
+    for (auto const& it : VPackArrayIterator(blocks)) {
+      auto r = ::blockFromResponse(resourceMonitor, it);
+      if (r != nullptr) {
+        _prefetched.emplace_back(std::move(r));
+      }
+    }
+    _prefetch = (std::min)(_prefetch * 2, _maxPrefetch);
+  } else {
+    auto r = ::blockFromResponse(resourceMonitor, responseBody);
+    if (r != nullptr) {
+      _prefetched.emplace_back(std::move(r));
+    }
+  }
+
+  trackRemoteMemoryUsage(responseBody);
+
+  // a response without any rows means that the remote side is done
+  _prefetchedDone = _prefetched.empty() ||
+                    VelocyPackHelper::getBooleanValue(responseBody, "done", true);
+}
+
+/// @brief return the next prefetched batch, splitting it if the caller
+/// asks for fewer rows
+std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> RemoteBlock::getSomeFromPrefetched(size_t atMost) {
+  TRI_ASSERT(!_prefetched.empty());
+  TRI_ASSERT(atMost > 0);
+
+  std::unique_ptr<AqlItemBlock> result = std::move(_prefetched.front());
+  _prefetched.pop_front();
+
+  if (result->size() > atMost) {
+    // keep the remainder for the next call
+    std::unique_ptr<AqlItemBlock> rest(result->slice(atMost, result->size()));
+    result.reset(result->slice(0, atMost));
+    _prefetched.emplace_front(std::move(rest));
+  }
+
+  ExecutionState state = ExecutionState::HASMORE;
+  if (_prefetched.empty() && _prefetchedDone) {
+    state = ExecutionState::DONE;
+  }
+  traceGetSomeEnd(result.get(), state);
+  return {state, std::move(result)};
+}
+
+void RemoteBlock::resetPrefetched() {
+  _prefetched.clear();
+  _prefetchedDone = false;
+  _prefetch = 1;
+}
+
 /// @brief skipSome
+void RemoteBlock::trackRemoteMemoryUsage(VPackSlice responseBody) {
+  // older servers do not send these values, so they keep their last state
+  size_t current = VelocyPackHelper::getNumericValue<size_t>(
+      responseBody, "memoryUsage", _remoteMemoryUsage);
+  size_t peak = VelocyPackHelper::getNumericValue<size_t>(
+      responseBody, "peakMemoryUsage", _remotePeakMemoryUsage);
+  _engine->getQuery()->addRemoteMemoryUsage(
+      static_cast<int64_t>(current) - static_cast<int64_t>(_remoteMemoryUsage),
+      static_cast<int64_t>(peak) - static_cast<int64_t>(_remotePeakMemoryUsage));
+  _remoteMemoryUsage = current;
+  _remotePeakMemoryUsage = peak;
+}
+
 std::pair<ExecutionState, size_t> RemoteBlock::skipSome(size_t atMost) {
+  if (isWaitingForResponse()) {
+    traceSkipSomeBegin(atMost);
+    traceSkipSomeEnd(0, ExecutionState::WAITING);
+    return {ExecutionState::WAITING, 0};
+  }
+
   if (_lastError.fail()) {
     TRI_ASSERT(_lastResponse == nullptr);
     Result res = _lastError;
@@ -1072,6 +1397,33 @@ std::pair<ExecutionState, size_t> RemoteBlock::skipSome(size_t atMost) {
   }
   
   traceSkipSomeBegin(atMost);
+
+  if (_lastResponse != nullptr && _lastRequest == "/_api/aql/getSome/") {
+    // a getSome request was sent in parallel to other dependencies of a
+    // gather block, which now wants to skip. keep the rows for skipping
+    storeGetSomeResponse();
+  }
+
+  if (!_prefetched.empty() || _prefetchedDone) {
+    // skip over batches received earlier
+    size_t skipped = 0;
+    while (skipped < atMost && !_prefetched.empty()) {
+      std::unique_ptr<AqlItemBlock>& front = _prefetched.front();
+      size_t const n = (std::min)(atMost - skipped, front->size());
+      if (n == front->size()) {
+        _prefetched.pop_front();
+      } else {
+        front.reset(front->slice(n, front->size()));
+      }
+      skipped += n;
+    }
+    ExecutionState state = ExecutionState::HASMORE;
+    if (_prefetched.empty() && _prefetchedDone) {
+      state = ExecutionState::DONE;
+    }
+    traceSkipSomeEnd(skipped, state);
+    return {state, skipped};
+  }
   
   if (_lastResponse != nullptr) {
     TRI_ASSERT(_lastError.ok());
@@ -1098,6 +1450,7 @@ std::pair<ExecutionState, size_t> RemoteBlock::skipSome(size_t atMost) {
       }
       skipped = s.getNumericValue<size_t>();
     }
+    trackRemoteMemoryUsage(slice);
 
     // TODO Check if we can get better with HASMORE/DONE
     if (skipped == 0) {
@@ -1141,6 +1494,8 @@ std::pair<ExecutionState, arangodb::Result> UnsortingGatherBlock::initializeCurs
 
   _atDep = 0;
   _done = _dependencies.empty();
+  _depDone.assign(_dependencies.size(), false);
+  _arrived.clear();
 
   return {ExecutionState::DONE, TRI_ERROR_NO_ERROR};
 }
@@ -1149,6 +1504,16 @@ std::pair<ExecutionState, arangodb::Result> UnsortingGatherBlock::initializeCurs
 std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> UnsortingGatherBlock::getSome(size_t atMost) {
   traceGetSomeBegin(atMost);
 
+  if (_dependencies.empty()) {
+    _done = true;
+  }
+
+  if (_parallel && !_done) {
+    auto res = getSomeParallel(atMost);
+    traceGetSomeEnd(res.second.get(), res.first);
+    return res;
+  }
+
   _done = _dependencies.empty();
 
   if (_done) {
@@ -1179,6 +1544,122 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> UnsortingGatherBlock::g
   return {getHasMoreState(), std::move(res.second)};
 }
 
+/// @brief getSome in parallel mode. asks every dependency that is not done
+/// yet, so that requests to all remote dependencies stay in flight, and
+/// remote dependencies that are still waiting for their response are not
+/// blocking the others. batches are returned in the order of their arrival
+std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>>
+UnsortingGatherBlock::getSomeParallel(size_t atMost) {
+  size_t const n = _dependencies.size();
+  if (_depDone.size() != n) {
+    _depDone.assign(n, false);
+  }
+
+  if (_arrived.empty()) {
+    size_t numDone = 0;
+    for (size_t k = 0; k < n; ++k) {
+      size_t const i = (_atDep + k) % n;
+      if (_depDone[i]) {
+        ++numDone;
+        continue;
+      }
+
+      auto res = _dependencies[i]->getSome(atMost);
+      if (res.first == ExecutionState::WAITING) {
+        continue;
+      }
+      if (res.first == ExecutionState::DONE) {
+        _depDone[i] = true;
+        ++numDone;
+      }
+      if (res.second != nullptr) {
+        _arrived.emplace_back(std::move(res.second));
+      }
+    }
+    // start with a different dependency next time
+    _atDep = (_atDep + 1) % n;
+
+    if (_arrived.empty()) {
+      if (numDone == n) {
+        _done = true;
+        return {ExecutionState::DONE, nullptr};
+      }
+      return {ExecutionState::WAITING, nullptr};
+    }
+  }
+
+  std::unique_ptr<AqlItemBlock> result = std::move(_arrived.front());
+  _arrived.pop_front();
+
+  if (result->size() > atMost) {
+    // keep the remainder for the next call
+    std::unique_ptr<AqlItemBlock> rest(result->slice(atMost, result->size()));
+    result.reset(result->slice(0, atMost));
+    _arrived.emplace_front(std::move(rest));
+  }
+
+  if (_arrived.empty() &&
+      std::find(_depDone.begin(), _depDone.end(), false) == _depDone.end()) {
+    _done = true;
+  }
+
+  return {getHasMoreState(), std::move(result)};
+}
+
+/// @brief skipSome in parallel mode. rows that arrived already are skipped
+/// first. for skipping in the dependencies, only one dependency can be
+/// asked at a time, because the number of rows skipped must not exceed
+/// atMost
+std::pair<ExecutionState, size_t> UnsortingGatherBlock::skipSomeParallel(size_t atMost) {
+  size_t const n = _dependencies.size();
+  if (_depDone.size() != n) {
+    _depDone.assign(n, false);
+  }
+
+  size_t skipped = 0;
+  while (skipped < atMost && !_arrived.empty()) {
+    std::unique_ptr<AqlItemBlock>& front = _arrived.front();
+    size_t const count = (std::min)(atMost - skipped, front->size());
+    if (count == front->size()) {
+      _arrived.pop_front();
+    } else {
+      front.reset(front->slice(count, front->size()));
+    }
+    skipped += count;
+  }
+
+  if (skipped == 0) {
+    for (size_t k = 0; k < n; ++k) {
+      size_t const i = (_atDep + k) % n;
+      if (_depDone[i]) {
+        continue;
+      }
+
+      auto res = _dependencies[i]->skipSome(atMost);
+      if (res.first == ExecutionState::WAITING) {
+        // we will be called again, and continue with this dependency
+        _atDep = i;
+        return {ExecutionState::WAITING, 0};
+      }
+      if (res.first == ExecutionState::DONE || res.second == 0) {
+        _depDone[i] = true;
+      }
+      if (res.second > 0) {
+        _atDep = i;
+        skipped = res.second;
+        break;
+      }
+    }
+  }
+
+  if (_arrived.empty() &&
+      std::find(_depDone.begin(), _depDone.end(), false) == _depDone.end()) {
+    _done = true;
+  }
+
+  return {getHasMoreState(), skipped};
+}
+
 /// @brief skipSome
 std::pair<ExecutionState, size_t> UnsortingGatherBlock::skipSome(size_t atMost) {
   traceSkipSomeBegin(atMost);
@@ -1187,6 +1668,12 @@ std::pair<ExecutionState, size_t> UnsortingGatherBlock::skipSome(size_t atMost)
     return {ExecutionState::DONE, 0};
   }
 
+  if (_parallel) {
+    auto res = skipSomeParallel(atMost);
+    traceSkipSomeEnd(res.second, res.first);
+    return res;
+  }
+
   // the simple case . . .
   auto res = _dependencies[_atDep]->skipSome(atMost);
   if (res.first == ExecutionState::WAITING) {
@@ -1232,6 +1719,11 @@ SortingGatherBlock::SortingGatherBlock(
         _trx, _gatherBlockBuffer, _sortRegisters
       );
       break;
+    case GatherNode::SortMode::Tournament:
+      _strategy = std::make_unique<TournamentSorting>(
+        _trx, _gatherBlockBuffer, _sortRegisters
+      );
+      break;
     default:
       TRI_ASSERT(false);
       break;
@@ -1323,9 +1815,11 @@ std::pair<ExecutionState, size_t> SortingGatherBlock::fillBuffers(
   TRI_ASSERT(_gatherBlockBuffer.size() == _dependencies.size());
   TRI_ASSERT(_gatherBlockPos.size() == _dependencies.size());
 
-  // In the future, we should request all blocks in parallel. But not everything
-  // is yet thread safe for that to work, so we have to return immediately on
-  // the first WAITING we encounter.
+  // ask all dependencies before returning WAITING, so that the requests
+  // to all remote dependencies are in flight at the same time, and a slow
+  // shard does not delay the requests to the others. dependencies that
+  // are still waiting will not send another request when asked again
+  bool waiting = false;
   for (size_t i = 0; i < _dependencies.size(); i++) {
     // reset position to 0 if we're going to fetch a new block.
     // this doesn't hurt, even if we don't get one.
@@ -1336,12 +1830,17 @@ std::pair<ExecutionState, size_t> SortingGatherBlock::fillBuffers(
     bool blockAppended;
     std::tie(state, blockAppended) = getBlocks(i, atMost);
     if (state == ExecutionState::WAITING) {
-      return {ExecutionState::WAITING, 0};
+      waiting = true;
+      continue;
     }
 
     available += availableRows(i);
   }
 
+  if (waiting) {
+    return {ExecutionState::WAITING, 0};
+  }
+
   return {ExecutionState::DONE, available};
 }
 
@@ -1814,7 +2313,7 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> SingleRemoteOperationBl
 
   int outputCounter = 0;
   if (_buffer.empty()) {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(batchSize(), atMost);
     ExecutionState state = ExecutionState::HASMORE;
     bool blockAppended = false;
 
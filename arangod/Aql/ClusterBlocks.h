@@ -25,12 +25,15 @@
 #define ARANGOD_AQL_CLUSTER_BLOCKS_H 1
 
 #include "Basics/Common.h"
+#include "Aql/AqlItemBlock.h"
 #include "Aql/ClusterNodes.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/SortRegister.h"
 #include "Rest/GeneralRequest.h"
 
+#include <mutex>
+
 #include <velocypack/Builder.h>
 
 namespace arangodb {
@@ -259,6 +262,32 @@ class RemoteBlock final : public ExecutionBlock {
 
   std::shared_ptr<velocypack::Builder> stealResultBody();
 
+  /// @brief whether or not a request was sent, but its response has not
+  /// arrived yet. no other request must be sent in this case. records the
+  /// round trip of a traced request once it has completed
+  bool isWaitingForResponse();
+
+  /// @brief throw away a response that does not belong to a request
+  /// to urlPart. this can be a response to a getSome request that was
+  /// sent in parallel to others and is not needed anymore
+  void discardResponseUnlessFor(char const* urlPart);
+
+  /// @brief move the batches of the pending getSome response to _prefetched
+  void storeGetSomeResponse();
+
+  /// @brief move the batches of a getSome response body to _prefetched
+  void storeGetSomeResponse(arangodb::velocypack::Slice responseBody);
+
+  /// @brief return the next batch from _prefetched, with at most atMost rows
+  std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> getSomeFromPrefetched(size_t atMost);
+
+  /// @brief forget about all prefetched batches
+  void resetPrefetched();
+
+  /// @brief passes the memory usage the remote snippet has sent along with
+  /// a response on to the query
+  void trackRemoteMemoryUsage(arangodb::velocypack::Slice responseBody);
+
   /// @brief our server, can be like "shard:S1000" or like "server:Claus"
   std::string const _server;
 
@@ -279,6 +308,42 @@ class RemoteBlock final : public ExecutionBlock {
 
   /// @brief the last remote response Result object, may contain an error.
   arangodb::Result _lastError;
+
+  /// @brief protects _lastResponse, _lastError and _requestInFlight, which
+  /// are set from the communication callback. the callback may fire while
+  /// the query is still busy with other blocks
+  std::mutex _communicationMutex;
+
+  /// @brief whether or not a request is in flight
+  bool _requestInFlight;
+
+  /// @brief url part of the last request sent
+  std::string _lastRequest;
+
+  /// @brief batches received from the remote side, but not yet returned
+  std::deque<std::unique_ptr<AqlItemBlock>> _prefetched;
+
+  /// @brief whether or not the remote side is done after the batches
+  /// in _prefetched
+  bool _prefetchedDone;
+
+  /// @brief number of batches to ask for with the next getSome request.
+  /// starts at one and doubles with every round trip, so that queries
+  /// which only need a few rows do not make the remote side produce more
+  size_t _prefetch;
+
+  /// @brief maximum number of batches per getSome request
+  size_t const _maxPrefetch;
+
+  /// @brief start time of the request in flight when tracing, 0 otherwise
+  double _requestStart;
+
+  /// @brief time the response to the traced request arrived
+  double _requestEnd;
+
+  /// @brief memory usage last reported by the remote snippet
+  size_t _remoteMemoryUsage;
+  size_t _remotePeakMemoryUsage;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -288,7 +353,8 @@ class RemoteBlock final : public ExecutionBlock {
 class UnsortingGatherBlock final : public ExecutionBlock {
  public:
   UnsortingGatherBlock(ExecutionEngine& engine, GatherNode const& en)
-    : ExecutionBlock(&engine, &en) {
+    : ExecutionBlock(&engine, &en),
+      _parallel(en.parallelism() == GatherNode::Parallelism::Parallel) {
     TRI_ASSERT(en.elements().empty());
   }
 
@@ -303,8 +369,26 @@ class UnsortingGatherBlock final : public ExecutionBlock {
   std::pair<ExecutionState, size_t> skipSome(size_t atMost) override final;
 
  private:
+  /// @brief getSome, asking all dependencies at once
+  std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> getSomeParallel(size_t atMost);
+
+  /// @brief skipSome, for the parallel mode
+  std::pair<ExecutionState, size_t> skipSomeParallel(size_t atMost);
+
   /// @brief _atDep: currently pulling blocks from _dependencies.at(_atDep),
+  /// in parallel mode the dependency to ask first
   size_t _atDep{};
+
+  /// @brief whether or not all dependencies are asked at once, instead of
+  /// draining them one after the other
+  bool const _parallel;
+
+  /// @brief parallel mode only: whether or not the dependency at index is done
+  std::vector<bool> _depDone;
+
+  /// @brief parallel mode only: batches that arrived from the dependencies,
+  /// in the order of their arrival
+  std::deque<std::unique_ptr<AqlItemBlock>> _arrived;
 }; // UnsortingGatherBlock
 
 ////////////////////////////////////////////////////////////////////////////////
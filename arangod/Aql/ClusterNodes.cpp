@@ -43,6 +43,7 @@ namespace {
 arangodb::velocypack::StringRef const SortModeUnset("unset");
 arangodb::velocypack::StringRef const SortModeMinElement("minelement");
 arangodb::velocypack::StringRef const SortModeHeap("heap");
+arangodb::velocypack::StringRef const SortModeTournament("tournament");
 
 bool toSortMode(
     arangodb::velocypack::StringRef const& str,
@@ -51,7 +52,8 @@ bool toSortMode(
   // std::map ~25-30% faster than std::unordered_map for small number of elements
   static std::map<arangodb::velocypack::StringRef, GatherNode::SortMode> const NameToValue {
     { SortModeMinElement, GatherNode::SortMode::MinElement},
-    { SortModeHeap, GatherNode::SortMode::Heap}
+    { SortModeHeap, GatherNode::SortMode::Heap},
+    { SortModeTournament, GatherNode::SortMode::Tournament}
   };
 
   auto const it = NameToValue.find(str);
@@ -71,6 +73,8 @@ arangodb::velocypack::StringRef toString(GatherNode::SortMode mode) noexcept {
       return SortModeMinElement;
     case GatherNode::SortMode::Heap:
       return SortModeHeap;
+    case GatherNode::SortMode::Tournament:
+      return SortModeTournament;
     default:
       TRI_ASSERT(false);
       return {};
@@ -312,7 +316,14 @@ GatherNode::GatherNode(
     SortElementVector const& elements)
   : ExecutionNode(plan, base),
     _elements(elements),
-    _sortmode(SortMode::MinElement) {
+    _sortmode(SortMode::MinElement),
+    _parallelism(Parallelism::Serial) {
+  // plans from servers that do not know about this attribute will
+  // continue to use serial gathers
+  if (VelocyPackHelper::getStringValue(base, "parallelism", "") == "parallel") {
+    _parallelism = Parallelism::Parallel;
+  }
+
   if (!_elements.empty()) {
     auto const sortModeSlice = base.get("sortmode");
 
@@ -326,9 +337,11 @@ GatherNode::GatherNode(
 GatherNode::GatherNode(
     ExecutionPlan* plan,
     size_t id,
-    SortMode sortMode) noexcept
+    SortMode sortMode,
+    Parallelism parallelism) noexcept
   : ExecutionNode(plan, id),
-    _sortmode(sortMode) {
+    _sortmode(sortMode),
+    _parallelism(parallelism) {
 }
 
 /// @brief toVelocyPack, for GatherNode
@@ -341,6 +354,7 @@ void GatherNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
   } else {
     nodes.add("sortmode", VPackValue(toString(_sortmode).data()));
   }
+  nodes.add("parallelism", VPackValue(_parallelism == Parallelism::Parallel ? "parallel" : "serial"));
 
   nodes.add(VPackValue("elements"));
   {
@@ -309,7 +309,17 @@ class GatherNode final : public ExecutionNode {
  public:
   enum class SortMode : uint32_t {
     MinElement,
-    Heap
+    Heap,
+    Tournament
+  };
+
+  /// @brief how an unsorted gather reads its dependencies
+  enum class Parallelism : uint32_t {
+    /// drain the dependencies one after the other
+    Serial,
+    /// keep requests to all dependencies in flight, and return
+    /// batches in the order of their arrival
+    Parallel
   };
 
   /// @brief inspect dependencies starting from a specified 'node'
@@ -319,13 +329,15 @@ class GatherNode final : public ExecutionNode {
     GatherNode const& node
   ) noexcept;
 
-  /// @returns sort mode for the specified number of shards
+  /// @returns sort mode for the specified number of shards. a linear scan
+  /// is cheapest for few shards, a tree of losers needs the fewest
+  /// comparisons per row for many shards
   static SortMode evaluateSortMode(
       size_t numberOfShards,
       size_t shardsRequiredForHeapMerge = 5
   ) noexcept {
     return numberOfShards >= shardsRequiredForHeapMerge
-      ? SortMode::Heap
+      ? SortMode::Tournament
       : SortMode::MinElement;
   }
 
@@ -333,7 +345,8 @@ class GatherNode final : public ExecutionNode {
   GatherNode(
     ExecutionPlan* plan,
     size_t id,
-    SortMode sortMode
+    SortMode sortMode,
+    Parallelism parallelism = Parallelism::Parallel
   ) noexcept;
 
   GatherNode(
@@ -353,7 +366,7 @@ class GatherNode final : public ExecutionNode {
   ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
                        bool withProperties) const override final {
     return cloneHelper(
-      std::make_unique<GatherNode>(plan, _id, _sortmode),
+      std::make_unique<GatherNode>(plan, _id, _sortmode, _parallelism),
       withDependencies,
       withProperties
     );
@@ -396,6 +409,9 @@ class GatherNode final : public ExecutionNode {
   SortMode sortMode() const noexcept { return _sortmode; }
   void sortMode(SortMode sortMode) noexcept { _sortmode = sortMode; }
 
+  Parallelism parallelism() const noexcept { return _parallelism; }
+  void parallelism(Parallelism parallelism) noexcept { _parallelism = parallelism; }
+
  private:
   /// @brief sort elements, variable, ascending flags and possible attribute
   /// paths.
@@ -403,6 +419,9 @@ class GatherNode final : public ExecutionNode {
 
   /// @brief sorting mode
   SortMode _sortmode;
+
+  /// @brief parallelism, only used when there are no sort elements
+  Parallelism _parallelism;
 };
 
 
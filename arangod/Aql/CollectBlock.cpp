@@ -28,6 +28,7 @@
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Basics/Exceptions.h"
+#include "Basics/SmallVector.h"
 #include "Basics/VelocyPackHelper.h"
 #include "VocBase/vocbase.h"
 
@@ -382,7 +383,7 @@ std::pair<ExecutionState, Result> SortedCollectBlock::getOrSkipSome(
       }
     }
 
-    BufferState bufferState = getBlockIfNeeded(DefaultBatchSize());
+    BufferState bufferState = getBlockIfNeeded(batchSize());
     if (bufferState == BufferState::WAITING) {
       TRI_ASSERT(skipped == 0);
       TRI_ASSERT(result == nullptr);
@@ -559,8 +560,11 @@ HashedCollectBlock::HashedCollectBlock(ExecutionEngine* engine,
       _aggregateRegisters(),
       _collectRegister(ExecutionNode::MaxRegisterId),
       _lastBlock(nullptr),
-      _allGroups(1024, AqlValueGroupHash(_trx, en->_groupVariables.size()),
-                 AqlValueGroupEqual(_trx)) {
+      _allGroups(_trx, engine->getQuery()->resourceMonitor(),
+                 en->_groupVariables.size(),
+                 en->_aggregateVariables.empty()
+                     ? (en->_count ? 1 : 0)
+                     : en->_aggregateVariables.size()) {
   for (auto const& p : en->_groupVariables) {
     // We know that planRegisters() has been run, so
     // getPlanNode()->_registerPlan is set up
@@ -611,6 +615,64 @@ HashedCollectBlock::HashedCollectBlock(ExecutionEngine* engine,
   }
 
   TRI_ASSERT(!_groupRegisters.empty());
+
+  std::vector<std::string> aggregatorTypes;
+  if (en->_aggregateVariables.empty()) {
+    // no aggregate registers. this means we'll only count the number of items
+    if (en->_count) {
+      aggregatorTypes.emplace_back("LENGTH");
+    }
+  } else {
+    for (auto const& r : en->_aggregateVariables) {
+      aggregatorTypes.emplace_back(r.second.second);
+    }
+  }
+
+  for (auto const& type : aggregatorTypes) {
+    _aggregatorFactories.emplace_back(Aggregator::factoryFromTypeString(type));
+  }
+}
+
+bool HashedCollectBlock::aggregateRow(AqlItemBlock const* cur, size_t pos) {
+  size_t const n = _groupRegisters.size();
+  SmallVector<AqlValue>::allocator_type::arena_type arena;
+  SmallVector<AqlValue> groupValues{arena};
+  groupValues.reserve(n);
+
+  // for hashing simply re-use the aggregate registers, without cloning
+  // their contents. the table clones them if it inserts a new group
+  for (size_t i = 0; i < n; ++i) {
+    groupValues.emplace_back(
+        cur->getValueReference(pos, _groupRegisters[i].second));
+  }
+
+  auto result = _allGroups.findOrInsert(groupValues.data());
+  auto aggregators = _allGroups.aggregators(result.first);
+
+  if (result.second) {
+    // new group: create its aggregators
+    size_t j = 0;
+    for (auto const& it : _aggregatorFactories) {
+      aggregators[j++] = (*it)(_trx);
+    }
+  }
+
+  if (_aggregateRegisters.empty()) {
+    // no aggregate registers. simply increase the counter
+    if (!_aggregatorFactories.empty()) {
+      // TODO get rid of this special case if possible
+      aggregators[0]->reduce(AqlValue());
+    }
+  } else {
+    // apply the aggregators for the group
+    size_t j = 0;
+    for (auto const& r : _aggregateRegisters) {
+      aggregators[j]->reduce(getValueForRegister(cur, pos, r.second));
+      ++j;
+    }
+  }
+
+  return result.second;
 }
 
 std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
@@ -640,7 +702,7 @@ std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
       ExecutionState state;
       bool blockAppended;
       std::tie(state, blockAppended) =
-          ExecutionBlock::getBlock(DefaultBatchSize());
+          ExecutionBlock::getBlock(batchSize());
       if (state == ExecutionState::WAITING) {
         TRI_ASSERT(!blockAppended);
         return std::make_tuple(GetNextRowState::WAITING, nullptr, 0);
@@ -669,83 +731,6 @@ std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
   };
 
   auto* en = ExecutionNode::castTo<CollectNode const*>(_exeNode);
-  
-  std::vector<std::function<std::unique_ptr<Aggregator>(transaction::Methods*)> const*> aggregatorFactories;   
-  if (en->_aggregateVariables.empty()) {
-    // no aggregate registers. this means we'll only count the number of items
-    if (en->_count) {
-      aggregatorFactories.emplace_back(Aggregator::factoryFromTypeString("LENGTH"));
-    }
-  } else {
-    // we do have aggregate registers. create them as empty AqlValues
-    aggregatorFactories.reserve(_aggregateRegisters.size());
-
-    // initialize aggregators
-    for (auto const& r : en->_aggregateVariables) {
-      aggregatorFactories.emplace_back(
-          Aggregator::factoryFromTypeString(r.second.second));
-    }
-  }
-
-  // if no group exists for the current row yet, this builds a new group.
-  auto buildNewGroup = [this, &aggregatorFactories](
-      const AqlItemBlock* cur, size_t const pos,
-      const size_t n) -> std::pair<std::unique_ptr<AggregateValuesType>,
-                                   std::vector<AqlValue>> {
-    std::vector<AqlValue> group;
-    group.reserve(n);
-
-    // copy the group values before they get invalidated
-    for (size_t i = 0; i < n; ++i) {
-      group.emplace_back(
-          cur->getValueReference(pos, _groupRegisters[i].second).clone());
-    }
-
-    auto aggregateValues = std::make_unique<AggregateValuesType>();
-    aggregateValues->reserve(aggregatorFactories.size());
-
-    for (auto const& it : aggregatorFactories) {
-      aggregateValues->emplace_back((*it)(_trx));
-    }
-    return std::make_pair(std::move(aggregateValues), group);
-  };
-
-  // finds the group matching the current row, or emplaces it. in either case,
-  // it returns an iterator to the group matching the current row in _allGroups.
-  // additionally, .second is true iff a new group was emplaced.
-  auto findOrEmplaceGroup = [this, &buildNewGroup](
-      AqlItemBlock const* cur,
-      size_t const pos) -> std::pair<decltype(_allGroups)::iterator, bool> {
-    std::vector<AqlValue> groupValues;
-    size_t const n = _groupRegisters.size();
-    groupValues.reserve(n);
-
-    // for hashing simply re-use the aggregate registers, without cloning
-    // their contents
-    for (size_t i = 0; i < n; ++i) {
-      groupValues.emplace_back(
-          cur->getValueReference(pos, _groupRegisters[i].second));
-    }
-
-    auto it = _allGroups.find(groupValues);
-
-    if (it != _allGroups.end()) {
-      // group already exists
-      return {it, false};
-    }
-
-    // must create new group
-    std::unique_ptr<AggregateValuesType> aggregateValues;
-    std::vector<AqlValue> group;
-    std::tie(aggregateValues, group) = buildNewGroup(cur, pos, n);
-
-    // note: aggregateValues may be a nullptr!
-    auto emplaceResult = _allGroups.emplace(group, std::move(aggregateValues));
-    // emplace must not fail
-    TRI_ASSERT(emplaceResult.second);
-
-    return {emplaceResult.first, true};
-  };
 
   auto buildResult = [this, en, nrInRegs,
                       nrOutRegs](AqlItemBlock const* src) -> AqlItemBlock* {
@@ -759,68 +744,37 @@ std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
 
     TRI_ASSERT(!en->_count || _collectRegister != ExecutionNode::MaxRegisterId);
 
-    size_t row = 0;
-    for (auto& it : _allGroups) {
-      auto& keys = it.first;
-      TRI_ASSERT(it.second != nullptr);
-
-      TRI_ASSERT(keys.size() == _groupRegisters.size());
-      size_t i = 0;
-      for (auto& key : keys) {
-        result->setValue(row, _groupRegisters[i++].first, key);
-        const_cast<AqlValue*>(&key)
-            ->erase();  // to prevent double-freeing later
+    size_t const numGroups = _allGroups.size();
+    size_t const numKeys = _groupRegisters.size();
+    for (size_t row = 0; row < numGroups; ++row) {
+      AqlValue* keys = _allGroups.keys(row);
+      for (size_t i = 0; i < numKeys; ++i) {
+        result->setValue(row, _groupRegisters[i].first, keys[i]);
+        keys[i].erase();  // to prevent double-freeing later
       }
 
+      auto aggregators = _allGroups.aggregators(row);
       if (!en->_count) {
-        TRI_ASSERT(it.second->size() == _aggregateRegisters.size());
-        size_t j = 0;
-        for (auto const& r : *(it.second)) {
-          result->setValue(row, _aggregateRegisters[j++].first,
-                           r->stealValue());
+        size_t const numAggregators = _aggregateRegisters.size();
+        for (size_t j = 0; j < numAggregators; ++j) {
+          result->setValue(row, _aggregateRegisters[j].first,
+                           aggregators[j]->stealValue());
         }
       } else {
         // set group count in result register
-        TRI_ASSERT(!it.second->empty());
-        result->setValue(row, _collectRegister,
-                         it.second->back()->stealValue());
+        TRI_ASSERT(aggregators[0] != nullptr);
+        result->setValue(row, _collectRegister, aggregators[0]->stealValue());
       }
 
       if (row > 0) {
         // re-use already copied AQLValues for remaining registers
         result->copyValuesFromFirstRow(row, nrInRegs);
       }
-
-      ++row;
     }
 
     return result.release();
   };
 
-  // "adds" the current row to its group's aggregates.
-  auto reduceAggregates = [this, en](decltype(_allGroups)::iterator groupIt,
-                                     AqlItemBlock const* cur,
-                                     size_t const pos) {
-    AggregateValuesType* aggregateValues = groupIt->second.get();
-
-    if (en->_aggregateVariables.empty()) {
-      // no aggregate registers. simply increase the counter
-      if (en->_count) {
-        // TODO get rid of this special case if possible
-        TRI_ASSERT(!aggregateValues->empty());
-        aggregateValues->back()->reduce(AqlValue());
-      }
-    } else {
-      // apply the aggregators for the group
-      TRI_ASSERT(aggregateValues->size() == _aggregateRegisters.size());
-      size_t j = 0;
-      for (auto const& r : _aggregateRegisters) {
-        (*aggregateValues)[j]->reduce(getValueForRegister(cur, pos, r.second));
-        ++j;
-      }
-    }
-  };
-
   while (true) {
     TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSomeOuter") {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
@@ -849,16 +803,9 @@ std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
 
     _lastBlock = cur;
 
-    // NOLINTNEXTLINE(hicpp-use-auto,modernize-use-auto)
-    decltype(_allGroups)::iterator currentGroupIt;
-    bool newGroup;
-    std::tie(currentGroupIt, newGroup) = findOrEmplaceGroup(cur, pos);
-
-    if (newGroup) {
+    if (aggregateRow(cur, pos)) {
       ++_skipped;
     }
-
-    reduceAggregates(currentGroupIt, cur, pos);
   }
 
   // _lastBlock is null iff the input didn't contain a single row
@@ -881,16 +828,8 @@ std::pair<ExecutionState, Result> HashedCollectBlock::getOrSkipSome(
 HashedCollectBlock::~HashedCollectBlock() {
   // Generally, _allGroups should be empty when the block is destroyed - except
   // when an exception is thrown during getOrSkipSome, in which case the
-  // AqlValue ownership hasn't been transferred.
-  _destroyAllGroupsAqlValues();
-}
-
-void HashedCollectBlock::_destroyAllGroupsAqlValues() {
-  for (auto& it : _allGroups) {
-    for (auto& it2 : it.first) {
-      const_cast<AqlValue*>(&it2)->destroy();
-    }
-  }
+  // AqlValue ownership hasn't been transferred. the table takes care of
+  // destroying the remaining values.
 }
 
 std::pair<ExecutionState, Result>
@@ -905,7 +844,6 @@ HashedCollectBlock::initializeCursor(AqlItemBlock *items, size_t pos) {
   }
 
   _lastBlock = nullptr;
-  _destroyAllGroupsAqlValues();
   _allGroups.clear();
 
   return {state, result};
@@ -1147,7 +1085,7 @@ std::pair<ExecutionState, Result> CountCollectBlock::getOrSkipSome(size_t atMost
       returnBlock(cur);
     }
 
-    auto upstreamRes = _dependencies[0]->skipSome(DefaultBatchSize());
+    auto upstreamRes = _dependencies[0]->skipSome(batchSize());
     if (upstreamRes.first == ExecutionState::WAITING) {
       return {ExecutionState::WAITING, TRI_ERROR_NO_ERROR};
     }
@@ -29,6 +29,7 @@
 #include "Aql/AqlItemBlock.h"
 #include "Aql/AqlValue.h"
 #include "Aql/AqlValueGroup.h"
+#include "Aql/AqlValueGroupTable.h"
 #include "Aql/CollectNode.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
@@ -150,6 +151,14 @@ class HashedCollectBlock final : public ExecutionBlock {
                                                   AqlItemBlock*& result,
                                                   size_t& skipped) override;
 
+  typedef std::function<std::unique_ptr<Aggregator>(transaction::Methods*)>
+      AggregatorFactory;
+
+  /// @brief adds the row at pos in cur to its group, creating the group
+  /// if it does not exist yet. returns whether or not a new group was
+  /// created
+  bool aggregateRow(AqlItemBlock const* cur, size_t pos);
+
  private:
   /// @brief pairs, consisting of out register and in register
   std::vector<std::pair<RegisterId, RegisterId>> _groupRegisters;
@@ -157,6 +166,10 @@ class HashedCollectBlock final : public ExecutionBlock {
   /// @brief pairs, consisting of out register and in register
   std::vector<std::pair<RegisterId, RegisterId>> _aggregateRegisters;
 
+  /// @brief aggregator factories, one for each aggregate register, or for
+  /// the count
+  std::vector<AggregatorFactory const*> _aggregatorFactories;
+
   /// @brief the optional register that contains the values for each group
   /// if no values should be returned, then this has a value of MaxRegisterId
   /// this register is also used for counting in case WITH COUNT INTO var is
@@ -166,13 +179,8 @@ class HashedCollectBlock final : public ExecutionBlock {
   /// @brief the last input block
   AqlItemBlock* _lastBlock;
 
-  /// @brief hashmap of all encountered groups
-  std::unordered_map<std::vector<AqlValue>,
-                     std::unique_ptr<AggregateValuesType>, AqlValueGroupHash,
-                     AqlValueGroupEqual>
-      _allGroups;
-
-  void _destroyAllGroupsAqlValues();
+  /// @brief hash table of all encountered groups
+  AqlValueGroupTable _allGroups;
 };
 
 class DistinctCollectBlock final : public ExecutionBlock {
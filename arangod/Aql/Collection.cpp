@@ -26,9 +26,12 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/Exceptions.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
 #include "Transaction/Methods.h"
@@ -195,3 +198,39 @@ bool Collection::isSmart() const {
 bool Collection::isSatellite() const {
   return getCollection()->isSatellite();
 }
+
+/// @brief waits until the local copy of a satellite collection is in sync
+void Collection::waitForSatelliteSync(double maxWait) const {
+  auto logicalCollection = getCollection();
+  auto cid = logicalCollection->planId();
+  auto& dbName = logicalCollection->vocbase().name();
+  std::string const& shard = name();
+  std::string const& serverId = ServerState::instance()->getId();
+
+  double const endTime = TRI_microtime() + maxWait;
+  double waitInterval = 0.01;
+
+  while (true) {
+    auto collectionInfoCurrent = ClusterInfo::instance()->getCollectionCurrent(
+      dbName, std::to_string(cid));
+    auto servers = collectionInfoCurrent->servers(shard);
+    if (std::find(servers.begin(), servers.end(), serverId) != servers.end()) {
+      return;
+    }
+
+    double const now = TRI_microtime();
+    if (now >= endTime) {
+      break;
+    }
+    if (endTime - now < waitInterval) {
+      waitInterval = endTime - now;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(
+        static_cast<uint64_t>(waitInterval * 1000000.0)));
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(
+      TRI_ERROR_CLUSTER_AQL_COLLECTION_OUT_OF_SYNC,
+      "collection " + shard + " did not come into sync in time (" +
+          std::to_string(maxWait) + ")");
+}
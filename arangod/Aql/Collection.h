@@ -121,6 +121,11 @@ struct Collection {
   /// @brief check if collection is a satellite collection
   bool isSatellite() const;
 
+  /// @brief waits until the local copy of the satellite collection's shard
+  /// is an in-sync follower or the leader, and throws if this takes longer
+  /// than maxWait seconds
+  void waitForSatelliteSync(double maxWait) const;
+
  private:
   arangodb::LogicalCollection* _collection;
   
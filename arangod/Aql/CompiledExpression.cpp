@@ -0,0 +1,427 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CompiledExpression.h"
+#include "Aql/Expression.h"
+#include "Aql/ExpressionContext.h"
+#include "Basics/Exceptions.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief minimum number of operators an expression must have to be compiled
+constexpr size_t minOperators = 2;
+
+/// @brief largest integer that can be converted to a double without loss
+constexpr int64_t maxExactInteger = int64_t(1) << 53;
+
+constexpr double nullNumber = std::numeric_limits<double>::quiet_NaN();
+
+/// @brief whether or not a register value is a null number. arithmetic
+/// results that are not finite are turned into null by AqlValue, too
+inline bool isNull(double value) { return !std::isfinite(value); }
+
+/// @brief the value of a register when used as an arithmetic operand.
+/// null is converted to 0
+inline double toNumber(double value) { return isNull(value) ? 0.0 : value; }
+
+/// @brief the value of a register when used as a condition
+inline bool toBoolean(double value) { return !isNull(value) && value != 0.0; }
+
+/// @brief compares two registers of the same type in the order of
+/// AqlValue::Compare, in which null is less than any number
+inline int compare(double lhs, double rhs) {
+  bool const lhsNull = isNull(lhs);
+  bool const rhsNull = isNull(rhs);
+  if (lhsNull || rhsNull) {
+    return (lhsNull && rhsNull) ? 0 : (lhsNull ? -1 : 1);
+  }
+  return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+}
+
+void registerDivisionByZero(ExpressionContext* context, char const* op) {
+  std::string msg("in operator ");
+  msg.append(op);
+  msg.append(": ");
+  msg.append(TRI_errno_string(TRI_ERROR_QUERY_DIVISION_BY_ZERO));
+  context->registerWarning(TRI_ERROR_QUERY_DIVISION_BY_ZERO, msg.c_str());
+}
+
+}  // namespace
+
+CompiledExpression::CompiledExpression()
+    : _numberOfOperators(0),
+      _numberOfRegisters(0),
+      _result{0, ValueType::NUMBER} {}
+
+CompiledExpression::~CompiledExpression() {}
+
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(
+    AstNode const* node) {
+  std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+
+  if (!compiled->compileValue(node, compiled->_result) ||
+      compiled->_numberOfOperators < ::minOperators) {
+    return nullptr;
+  }
+
+  compiled->_registers.resize(compiled->_numberOfRegisters);
+  return compiled;
+}
+
+size_t CompiledExpression::emit(OpCode op, uint32_t result, uint32_t lhs,
+                                uint32_t rhs) {
+  _instructions.emplace_back(Instruction{op, result, lhs, rhs, 0.0, nullptr});
+  return _instructions.size() - 1;
+}
+
+bool CompiledExpression::compileValue(AstNode const* node, Operand& result) {
+  switch (node->type) {
+    case NODE_TYPE_VALUE: {
+      double value;
+      if (node->isNullValue()) {
+        value = ::nullNumber;
+        result.type = ValueType::NUMBER;
+      } else if (node->isBoolValue()) {
+        value = node->getBoolValue() ? 1.0 : 0.0;
+        result.type = ValueType::BOOLEAN;
+      } else if (node->isIntValue()) {
+        int64_t v = node->getIntValue();
+        if (v > ::maxExactInteger || v < -::maxExactInteger) {
+          return false;
+        }
+        value = static_cast<double>(v);
+        result.type = ValueType::NUMBER;
+      } else if (node->isDoubleValue()) {
+        value = node->getDoubleValue();
+        result.type = ValueType::NUMBER;
+      } else {
+        return false;
+      }
+      result.reg = nextRegister();
+      _instructions[emit(OpCode::CONSTANT, result.reg)].value = value;
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+    case NODE_TYPE_OPERATOR_BINARY_MOD: {
+      uint32_t lhs, rhs;
+      if (!compileNumber(node->getMemberUnchecked(0), lhs) ||
+          !compileNumber(node->getMemberUnchecked(1), rhs)) {
+        return false;
+      }
+      OpCode op;
+      switch (node->type) {
+        case NODE_TYPE_OPERATOR_BINARY_PLUS:
+          op = OpCode::ADD;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_MINUS:
+          op = OpCode::SUB;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_TIMES:
+          op = OpCode::MUL;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_DIV:
+          op = OpCode::DIV;
+          break;
+        default:
+          op = OpCode::MOD;
+          break;
+      }
+      result.reg = nextRegister();
+      result.type = ValueType::NUMBER;
+      emit(op, result.reg, lhs, rhs);
+      ++_numberOfOperators;
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_MINUS:
+    case NODE_TYPE_OPERATOR_UNARY_PLUS: {
+      auto member = node->getMemberUnchecked(0);
+      Operand operand;
+      if (member->type == NODE_TYPE_VALUE || !compileValue(member, operand)) {
+        // the interpreter keeps integer constants as integers
+        return false;
+      }
+      result.reg = nextRegister();
+      result.type = ValueType::NUMBER;
+      emit(node->type == NODE_TYPE_OPERATOR_UNARY_MINUS ? OpCode::NEG
+                                                        : OpCode::TO_NUMBER,
+           result.reg, operand.reg);
+      ++_numberOfOperators;
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      Operand operand;
+      if (!compileValue(node->getMemberUnchecked(0), operand)) {
+        return false;
+      }
+      result.reg = nextRegister();
+      result.type = ValueType::BOOLEAN;
+      emit(OpCode::NOT, result.reg, operand.reg);
+      ++_numberOfOperators;
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      Operand lhs, rhs;
+      if (!compileValue(node->getMemberUnchecked(0), lhs) ||
+          !compileValue(node->getMemberUnchecked(1), rhs) ||
+          lhs.type != rhs.type) {
+        // booleans and numbers are not compared by value
+        return false;
+      }
+      OpCode op;
+      switch (node->type) {
+        case NODE_TYPE_OPERATOR_BINARY_EQ:
+          op = OpCode::EQ;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_NE:
+          op = OpCode::NE;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_LT:
+          op = OpCode::LT;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_LE:
+          op = OpCode::LE;
+          break;
+        case NODE_TYPE_OPERATOR_BINARY_GT:
+          op = OpCode::GT;
+          break;
+        default:
+          op = OpCode::GE;
+          break;
+      }
+      result.reg = nextRegister();
+      result.type = ValueType::BOOLEAN;
+      emit(op, result.reg, lhs.reg, rhs.reg);
+      ++_numberOfOperators;
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR: {
+      // the result is the value of one of the operands, and the rhs is only
+      // evaluated if needed
+      result.reg = nextRegister();
+      Operand lhs, rhs;
+      if (!compileValue(node->getMemberUnchecked(0), lhs)) {
+        return false;
+      }
+      emit(OpCode::MOVE, result.reg, lhs.reg);
+      size_t jump = emit(node->type == NODE_TYPE_OPERATOR_BINARY_AND
+                             ? OpCode::JUMP_IF_FALSE
+                             : OpCode::JUMP_IF_TRUE,
+                         0, lhs.reg);
+      if (!compileValue(node->getMemberUnchecked(1), rhs) ||
+          lhs.type != rhs.type) {
+        return false;
+      }
+      emit(OpCode::MOVE, result.reg, rhs.reg);
+      _instructions[jump].rhs = static_cast<uint32_t>(_instructions.size());
+      result.type = lhs.type;
+      ++_numberOfOperators;
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_TERNARY: {
+      if (node->numMembers() != 3) {
+        return false;
+      }
+      result.reg = nextRegister();
+      Operand condition, lhs, rhs;
+      if (!compileValue(node->getMemberUnchecked(0), condition)) {
+        return false;
+      }
+      size_t jumpToFalse = emit(OpCode::JUMP_IF_FALSE, 0, condition.reg);
+      if (!compileValue(node->getMemberUnchecked(1), lhs)) {
+        return false;
+      }
+      emit(OpCode::MOVE, result.reg, lhs.reg);
+      size_t jumpToEnd = emit(OpCode::JUMP, 0);
+      _instructions[jumpToFalse].rhs = static_cast<uint32_t>(_instructions.size());
+      if (!compileValue(node->getMemberUnchecked(2), rhs) ||
+          lhs.type != rhs.type) {
+        return false;
+      }
+      emit(OpCode::MOVE, result.reg, rhs.reg);
+      _instructions[jumpToEnd].rhs = static_cast<uint32_t>(_instructions.size());
+      result.type = lhs.type;
+      ++_numberOfOperators;
+      return true;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+bool CompiledExpression::compileNumber(AstNode const* node, uint32_t& result) {
+  size_t const numberOfInstructions = _instructions.size();
+  size_t const numberOfOperators = _numberOfOperators;
+
+  Operand operand;
+  if (compileValue(node, operand)) {
+    // booleans are converted to 0 and 1, as they already are
+    result = operand.reg;
+    return true;
+  }
+
+  // let the interpreter evaluate the node, and convert the value
+  _instructions.resize(numberOfInstructions);
+  _numberOfOperators = numberOfOperators;
+
+  result = nextRegister();
+  _instructions[emit(OpCode::LOAD, result)].node = node;
+  return true;
+}
+
+AqlValue CompiledExpression::execute(Expression* expression,
+                                     transaction::Methods* trx,
+                                     ExpressionContext* context) {
+  double* registers = _registers.data();
+  Instruction const* instructions = _instructions.data();
+  size_t const n = _instructions.size();
+  size_t pc = 0;
+
+  while (pc < n) {
+    Instruction const& ins = instructions[pc++];
+
+    switch (ins.op) {
+      case OpCode::CONSTANT:
+        registers[ins.result] = ins.value;
+        break;
+      case OpCode::LOAD: {
+        bool mustDestroy;
+        AqlValue value = expression->executeSimpleExpression(ins.node, trx,
+                                                             mustDestroy, false);
+        AqlValueGuard guard(value, mustDestroy);
+        bool failed = false;
+        double number = value.toDouble(trx, failed);
+        registers[ins.result] = failed ? 0.0 : number;
+        break;
+      }
+      case OpCode::MOVE:
+        registers[ins.result] = registers[ins.lhs];
+        break;
+      case OpCode::ADD:
+        registers[ins.result] =
+            ::toNumber(registers[ins.lhs]) + ::toNumber(registers[ins.rhs]);
+        break;
+      case OpCode::SUB:
+        registers[ins.result] =
+            ::toNumber(registers[ins.lhs]) - ::toNumber(registers[ins.rhs]);
+        break;
+      case OpCode::MUL:
+        registers[ins.result] =
+            ::toNumber(registers[ins.lhs]) * ::toNumber(registers[ins.rhs]);
+        break;
+      case OpCode::DIV: {
+        double r = ::toNumber(registers[ins.rhs]);
+        if (r == 0.0) {
+          ::registerDivisionByZero(context, "/");
+          registers[ins.result] = ::nullNumber;
+        } else {
+          registers[ins.result] = ::toNumber(registers[ins.lhs]) / r;
+        }
+        break;
+      }
+      case OpCode::MOD: {
+        double r = ::toNumber(registers[ins.rhs]);
+        if (r == 0.0) {
+          ::registerDivisionByZero(context, "%");
+          registers[ins.result] = ::nullNumber;
+        } else {
+          registers[ins.result] = fmod(::toNumber(registers[ins.lhs]), r);
+        }
+        break;
+      }
+      case OpCode::NEG:
+        registers[ins.result] = -::toNumber(registers[ins.lhs]);
+        break;
+      case OpCode::TO_NUMBER:
+        registers[ins.result] = ::toNumber(registers[ins.lhs]);
+        break;
+      case OpCode::NOT:
+        registers[ins.result] = ::toBoolean(registers[ins.lhs]) ? 0.0 : 1.0;
+        break;
+      case OpCode::EQ:
+        registers[ins.result] =
+            (::compare(registers[ins.lhs], registers[ins.rhs]) == 0) ? 1.0 : 0.0;
+        break;
+      case OpCode::NE:
+        registers[ins.result] =
+            (::compare(registers[ins.lhs], registers[ins.rhs]) != 0) ? 1.0 : 0.0;
+        break;
+      case OpCode::LT:
+        registers[ins.result] =
+            (::compare(registers[ins.lhs], registers[ins.rhs]) < 0) ? 1.0 : 0.0;
+        break;
+      case OpCode::LE:
+        registers[ins.result] =
+            (::compare(registers[ins.lhs], registers[ins.rhs]) <= 0) ? 1.0 : 0.0;
+        break;
+      case OpCode::GT:
+        registers[ins.result] =
+            (::compare(registers[ins.lhs], registers[ins.rhs]) > 0) ? 1.0 : 0.0;
+        break;
+      case OpCode::GE:
+        registers[ins.result] =
+            (::compare(registers[ins.lhs], registers[ins.rhs]) >= 0) ? 1.0 : 0.0;
+        break;
+      case OpCode::JUMP:
+        pc = ins.rhs;
+        break;
+      case OpCode::JUMP_IF_FALSE:
+        if (!::toBoolean(registers[ins.lhs])) {
+          pc = ins.rhs;
+        }
+        break;
+      case OpCode::JUMP_IF_TRUE:
+        if (::toBoolean(registers[ins.lhs])) {
+          pc = ins.rhs;
+        }
+        break;
+    }
+  }
+
+  double value = registers[_result.reg];
+  if (_result.type == ValueType::BOOLEAN) {
+    return AqlValue(AqlValueHintBool(value != 0.0));
+  }
+  // this will convert NaN, +inf & -inf to null
+  return AqlValue(AqlValueHintDouble(value));
+}
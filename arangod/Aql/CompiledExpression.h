@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_AQL_COMPILED_EXPRESSION_H
+#define ARANGOD_AQL_COMPILED_EXPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Aql/AstNode.h"
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+class Expression;
+class ExpressionContext;
+
+/// @brief an expression that is lowered from its AstNode tree into a flat
+/// sequence of instructions on typed registers. this covers the arithmetic
+/// operators, unary minus and plus, the comparison operators ==, !=, <, <=,
+/// > and >=, &&, ||, ! and the ternary operator, on numbers and booleans.
+/// operands of arithmetic operators that are not supported (e.g. attribute
+/// accesses or function calls) are evaluated by the AstNode interpreter of
+/// the expression and converted to a number.
+/// registers hold doubles. booleans are stored as 0 and 1, and null numbers
+/// (the result of a division by zero, or an arithmetic overflow) as NaN
+class CompiledExpression {
+ public:
+  CompiledExpression(CompiledExpression const&) = delete;
+  CompiledExpression& operator=(CompiledExpression const&) = delete;
+
+  ~CompiledExpression();
+
+  /// @brief try to compile the expression. returns a nullptr if the
+  /// expression is not supported, or if it is too simple to benefit from
+  /// compilation
+  static std::unique_ptr<CompiledExpression> compile(AstNode const* node);
+
+  /// @brief execute the compiled expression. operands that are not compiled
+  /// are evaluated by the expression
+  AqlValue execute(Expression* expression, transaction::Methods* trx,
+                   ExpressionContext* context);
+
+  /// @brief number of instructions of the compiled expression
+  size_t numberOfInstructions() const { return _instructions.size(); }
+
+ private:
+  enum class OpCode : uint8_t {
+    CONSTANT,
+    LOAD,
+    MOVE,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    NEG,
+    TO_NUMBER,
+    NOT,
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+    JUMP,
+    JUMP_IF_FALSE,
+    JUMP_IF_TRUE
+  };
+
+  /// @brief type of the value in a register
+  enum class ValueType : uint8_t { NUMBER, BOOLEAN };
+
+  struct Instruction {
+    OpCode op;
+    /// @brief register the result is written to
+    uint32_t result;
+    /// @brief operand registers. jumps use lhs as the condition and rhs as
+    /// the target instruction
+    uint32_t lhs;
+    uint32_t rhs;
+    /// @brief CONSTANT only: the value
+    double value;
+    /// @brief LOAD only: the node to evaluate
+    AstNode const* node;
+  };
+
+  /// @brief a compiled subexpression: its register and whether it holds a
+  /// number or a boolean
+  struct Operand {
+    uint32_t reg;
+    ValueType type;
+  };
+
+  CompiledExpression();
+
+  /// @brief compile a node to a register of a known type. returns false if
+  /// the node is not supported
+  bool compileValue(AstNode const* node, Operand& result);
+
+  /// @brief compile a node whose value is converted to a number, as the
+  /// operands of arithmetic operators are
+  bool compileNumber(AstNode const* node, uint32_t& result);
+
+  /// @brief create a new register
+  uint32_t nextRegister() { return _numberOfRegisters++; }
+
+  /// @brief append an instruction, returns its position
+  size_t emit(OpCode op, uint32_t result, uint32_t lhs = 0, uint32_t rhs = 0);
+
+ private:
+  std::vector<Instruction> _instructions;
+
+  /// @brief number of operators compiled, used to tell whether compilation
+  /// is worth it
+  size_t _numberOfOperators;
+
+  uint32_t _numberOfRegisters;
+
+  /// @brief type of the result register
+  Operand _result;
+
+  /// @brief reused register values
+  std::vector<double> _registers;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
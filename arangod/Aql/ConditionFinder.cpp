@@ -40,6 +40,9 @@ bool ConditionFinder::before(ExecutionNode* en) {
     case EN::REMOTE:
     case EN::SUBQUERY:
     case EN::INDEX:
+    case EN::HASH_JOIN:
+    case EN::MERGE_JOIN:
+    case EN::MATERIALIZE:
     case EN::RETURN:
     case EN::TRAVERSAL:
     case EN::SHORTEST_PATH:
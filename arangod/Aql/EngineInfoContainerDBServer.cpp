@@ -25,9 +25,11 @@
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ClusterNodes.h"
 #include "Aql/Collection.h"
+#include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/GraphNode.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IndexNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Query.h"
@@ -100,6 +102,26 @@ ScatterNode* findFirstScatter(ExecutionNode const& root) {
   return nullptr;
 }
 
+/// @brief whether a node reading a satellite collection was joined into the
+/// snippet of another collection, i.e. it reads another collection before
+/// the snippet's input from the coordinator
+bool isSatelliteJoin(ExecutionNode const& root) {
+  ExecutionNode const* node = root.getFirstDependency();
+
+  while (node != nullptr && node->getType() != ExecutionNode::REMOTE) {
+    switch (node->getType()) {
+      case ExecutionNode::ENUMERATE_COLLECTION:
+      case ExecutionNode::INDEX:
+        return true;
+      default:
+        node = node->getFirstDependency();
+        break;
+    }
+  }
+
+  return false;
+}
+
 }
 
 EngineInfoContainerDBServer::EngineInfo::EngineInfo(size_t idOfRemoteNode) noexcept
@@ -155,6 +177,15 @@ void EngineInfoContainerDBServer::EngineInfo::addNode(ExecutionNode* node) {
 
       break;
     }
+    case ExecutionNode::HASH_JOIN: {
+      TRI_ASSERT(_type == ExecutionNode::MAX_NODE_TYPE_VALUE);
+      auto joinNode = ExecutionNode::castTo<HashJoinNode*>(node);
+      if (joinNode->isRestricted()) {
+        TRI_ASSERT(_restrictedShard.empty());
+        _restrictedShard = joinNode->restrictedShard();
+      }
+      break;
+    }
 #ifdef USE_IRESEARCH
     case ExecutionNode::ENUMERATE_IRESEARCH_VIEW:{
       TRI_ASSERT(_type == ExecutionNode::MAX_NODE_TYPE_VALUE);
@@ -205,6 +236,20 @@ LogicalView const* EngineInfoContainerDBServer::EngineInfo::view() const noexcep
 }
 #endif
 
+bool EngineInfoContainerDBServer::EngineInfo::fetchesFromCoordinator() const {
+  return std::any_of(_nodes.begin(), _nodes.end(), [](ExecutionNode const* node) {
+    return node->getType() == ExecutionNode::REMOTE;
+  });
+}
+
+size_t EngineInfoContainerDBServer::EngineInfo::numberOfSnippets(
+    std::vector<ShardID> const& shards) const {
+  if (_restrictedShard.empty()) {
+    return shards.size();
+  }
+  return std::count(shards.begin(), shards.end(), _restrictedShard);
+}
+
 void EngineInfoContainerDBServer::EngineInfo::serializeSnippet(
     ServerID const& serverId,
     Query& query,
@@ -360,9 +405,14 @@ void EngineInfoContainerDBServer::addNode(ExecutionNode* node) {
   switch (node->getType()) {
     case ExecutionNode::ENUMERATE_COLLECTION:
       {
-        auto* scatter = findFirstScatter(*node);
         auto const& colNode = *ExecutionNode::castTo<EnumerateCollectionNode const*>(node);
         auto const* col = colNode.collection();
+        if (col->isSatellite() && ::isSatelliteJoin(*node)) {
+          // reads the local copy on the servers of the snippet
+          _satellites.emplace(col);
+          break;
+        }
+        auto* scatter = findFirstScatter(*node);
 
         std::unordered_set<std::string> restrictedShard;
         if (colNode.isRestricted()) {
@@ -375,15 +425,35 @@ void EngineInfoContainerDBServer::addNode(ExecutionNode* node) {
       }
     case ExecutionNode::INDEX:
       {
-        auto* scatter = findFirstScatter(*node);
         auto const& idxNode = *ExecutionNode::castTo<IndexNode const*>(node);
         auto const* col = idxNode.collection();
+        if (col->isSatellite() && ::isSatelliteJoin(*node)) {
+          // reads the local copy on the servers of the snippet
+          _satellites.emplace(col);
+          break;
+        }
+        auto* scatter = findFirstScatter(*node);
 
         std::unordered_set<std::string> restrictedShard;
         if (idxNode.isRestricted()) {
           restrictedShard.emplace(idxNode.restrictedShard());
         }
 
+        handleCollection(col, AccessMode::Type::READ, scatter, restrictedShard);
+        updateCollection(col);
+        break;
+      }
+    case ExecutionNode::HASH_JOIN:
+      {
+        auto* scatter = findFirstScatter(*node);
+        auto const& joinNode = *ExecutionNode::castTo<HashJoinNode const*>(node);
+        auto const* col = joinNode.collection();
+
+        std::unordered_set<std::string> restrictedShard;
+        if (joinNode.isRestricted()) {
+          restrictedShard.emplace(joinNode.restrictedShard());
+        }
+
         handleCollection(col, AccessMode::Type::READ, scatter, restrictedShard);
         updateCollection(col);
         break;
@@ -527,6 +597,16 @@ void EngineInfoContainerDBServer::DBServerInfo::addShardLock(
   _shardLocking[lock].emplace_back(id);
 }
 
+bool EngineInfoContainerDBServer::DBServerInfo::hasShardLock(
+    ShardID const& id) const {
+  for (auto const& it : _shardLocking) {
+    if (std::find(it.second.begin(), it.second.end(), id) != it.second.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void EngineInfoContainerDBServer::DBServerInfo::addEngine(
     std::shared_ptr<EngineInfoContainerDBServer::EngineInfo> info,
     ShardID const& id) {
@@ -537,10 +617,15 @@ void EngineInfoContainerDBServer::DBServerInfo::buildMessage(
     ServerID const& serverId,
     EngineInfoContainerDBServer const& context,
     Query& query,
+    size_t fetch,
     VPackBuilder& infoBuilder) const {
   TRI_ASSERT(infoBuilder.isEmpty());
 
   infoBuilder.openObject();
+  if (fetch > 0) {
+    // older servers will ignore this and wait for the first getSome
+    infoBuilder.add("fetch", VPackValue(fetch));
+  }
   infoBuilder.add(VPackValue("lockInfo"));
   infoBuilder.openObject();
   for (auto const& shardLocks : _shardLocking) {
@@ -620,6 +705,26 @@ void EngineInfoContainerDBServer::DBServerInfo::buildMessage(
   infoBuilder.close(); // Object
 }
 
+bool EngineInfoContainerDBServer::DBServerInfo::countSnippets(size_t& snippets) const {
+  if (!_traverserEngineInfos.empty()) {
+    return false;
+  }
+  for (auto const& it : _engineInfos) {
+    EngineInfo const& engine = *it.first;
+#ifdef USE_IRESEARCH
+    if (engine.type() == ExecutionNode::ENUMERATE_IRESEARCH_VIEW) {
+      return false;
+    }
+#endif
+    size_t const n = engine.numberOfSnippets(it.second);
+    if (n > 0 && engine.fetchesFromCoordinator()) {
+      return false;
+    }
+    snippets += n;
+  }
+  return true;
+}
+
 void EngineInfoContainerDBServer::DBServerInfo::injectTraverserEngines(
     VPackBuilder& infoBuilder) const {
   if (_traverserEngineInfos.empty()) {
@@ -772,13 +877,51 @@ EngineInfoContainerDBServer::createDBServerMapping(
     }
   }
 
-#ifdef USE_ENTERPRISE
   prepareSatellites(dbServerMapping);
-#endif
+  for (auto const* satellite : _satellites) {
+    auto const shards = satellite->shardIds();
+    lockedShards.insert(shards->begin(), shards->end());
+  }
 
   return dbServerMapping;
 }
 
+#ifndef USE_ENTERPRISE
+// Satellite collections that were joined into the snippets of another
+// collection are read from their local copy on every server that runs
+// one of these snippets, so they are locked there, and the snippets refer
+// to them by their shard name.
+void EngineInfoContainerDBServer::prepareSatellites(
+    std::map<ServerID, DBServerInfo>& dbServerMapping) const {
+  for (auto const* satellite : _satellites) {
+    auto const shards = satellite->shardIds();
+    TRI_ASSERT(shards->size() == 1);
+    if (shards->size() != 1) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "satellite collection " + satellite->name() + " must have a single shard"
+      );
+    }
+    ShardID const& shard = shards->front();
+
+    for (auto& it : dbServerMapping) {
+      DBServerInfo& info = it.second;
+      if (info.hasEngines() && !info.hasShardLock(shard)) {
+        info.addShardLock(AccessMode::Type::READ, shard);
+      }
+    }
+
+    const_cast<Collection*>(satellite)->setCurrentShard(shard);
+  }
+}
+
+void EngineInfoContainerDBServer::resetSatellites() const {
+  for (auto const* satellite : _satellites) {
+    const_cast<Collection*>(satellite)->resetCurrentShard();
+  }
+}
+#endif
+
 void EngineInfoContainerDBServer::injectGraphNodesToMapping(
     std::map<ServerID, EngineInfoContainerDBServer::DBServerInfo>&
         dbServerMapping) const {
@@ -947,6 +1090,8 @@ Result EngineInfoContainerDBServer::buildEngines(
 
   // We create a map for DBServer => All Query snippets executed there
   auto dbServerMapping = createDBServerMapping(lockedShards);
+  // the satellites keep their shard names until all snippets are sent
+  auto satellitesGuard = scopeGuard([this]() { resetSatellites(); });
   // This Mapping does not contain Traversal Engines
   //
   // We add traversal engines if necessary
@@ -978,6 +1123,22 @@ Result EngineInfoContainerDBServer::buildEngines(
     );
   });
 
+  // a query that consists of a single snippet for a single shard, which
+  // does not need any input from the coordinator, is executed right away
+  // by the DB server, which returns the first batch of results together
+  // with the response to the setup request. this saves a roundtrip for
+  // the typical single-shard lookup
+  size_t snippets = 0;
+  bool fetchWithSetup = true;
+  for (auto const& it : dbServerMapping) {
+    if (!it.second.countSnippets(snippets)) {
+      fetchWithSetup = false;
+      break;
+    }
+  }
+  size_t const fetch =
+      (fetchWithSetup && snippets == 1) ? ExecutionBlock::DefaultBatchSize() : 0;
+
   std::unordered_map<std::string, std::string> headers;
   // Build Lookup Infos
   VPackBuilder infoBuilder;
@@ -989,7 +1150,7 @@ Result EngineInfoContainerDBServer::buildEngines(
     LOG_TOPIC(DEBUG, arangodb::Logger::AQL) << "Building Engine Info for "
                                             << it.first;
     infoBuilder.clear();
-    it.second.buildMessage(it.first, *this, *_query, infoBuilder);
+    it.second.buildMessage(it.first, *this, *_query, fetch, infoBuilder);
     LOG_TOPIC(DEBUG, arangodb::Logger::AQL) << "Sending the Engine info: "
                                             << infoBuilder.toJson();
 
@@ -1049,6 +1210,20 @@ Result EngineInfoContainerDBServer::buildEngines(
       thisServer.emplace_back(resEntry.value.copyString());
     }
 
+    VPackSlice setupResults = result.get("results");
+    if (setupResults.isObject()) {
+      // the first results of snippets that were executed right away
+      for (auto const& resEntry : VPackObjectIterator(setupResults)) {
+        VPackSlice snippetId = snippets.get(resEntry.key.copyString());
+        if (snippetId.isString() && resEntry.value.isObject()) {
+          auto setupResult = std::make_shared<VPackBuilder>();
+          setupResult->add(resEntry.value);
+          _query->addSnippetSetupResult(snippetId.copyString(),
+                                        std::move(setupResult));
+        }
+      }
+    }
+
     VPackSlice travEngines = result.get("traverserEngines");
     if (!travEngines.isNone()) {
       if (!travEngines.isArray()) {
@@ -1063,9 +1238,6 @@ Result EngineInfoContainerDBServer::buildEngines(
     }
   }
 
-#ifdef USE_ENTERPRISE
-  resetSatellites();
-#endif
   cleanupGuard.cancel();
   return TRI_ERROR_NO_ERROR;
 }
@@ -116,6 +116,14 @@ class EngineInfoContainerDBServer {
     LogicalView const* view() const noexcept;
 #endif
 
+    /// @brief whether or not the snippet reads its input from the
+    /// coordinator, i.e. contains a RemoteNode
+    bool fetchesFromCoordinator() const;
+
+    /// @brief number of snippets created for the given shards, taking
+    /// a restriction to a single shard into account
+    size_t numberOfSnippets(std::vector<ShardID> const& shards) const;
+
    private:
     EngineInfo(EngineInfo&) = delete;
     EngineInfo(EngineInfo const& other) = delete;
@@ -135,15 +143,25 @@ class EngineInfoContainerDBServer {
    public:
     void addShardLock(AccessMode::Type const& lock, ShardID const& id);
 
+    bool hasShardLock(ShardID const& id) const;
+
+    bool hasEngines() const { return !_engineInfos.empty(); }
+
     void addEngine(std::shared_ptr<EngineInfo> info, ShardID const& id);
 
     void buildMessage(
       ServerID const& serverId,
       EngineInfoContainerDBServer const& context,
       Query& query,
+      size_t fetch,
       velocypack::Builder& infoBuilder
     ) const;
 
+    /// @brief add the number of snippets created on this server to
+    /// snippets. returns false if any of them cannot return its first
+    /// results together with the response to the setup request
+    bool countSnippets(size_t& snippets) const;
+
     void addTraverserEngine(GraphNode* node,
                             TraverserEngineShardLists&& shards);
 
@@ -259,12 +277,12 @@ class EngineInfoContainerDBServer {
   void injectGraphNodesToMapping(
       std::map<ServerID, DBServerInfo>& dbServerMapping) const;
 
-#ifdef USE_ENTERPRISE
+  // @brief Helper to let the snippets read the local copies of the
+  // satellite collections joined into them
   void prepareSatellites(
       std::map<ServerID, DBServerInfo>& dbServerMapping) const;
 
   void resetSatellites() const;
-#endif
 
  private:
   struct ViewInfo {
@@ -286,10 +304,8 @@ class EngineInfoContainerDBServer {
   // std::map ~25-30% is faster than std::unordered_map for small number of elements
   std::map<LogicalView const*, ViewInfo> _viewInfos;
 
-#ifdef USE_ENTERPRISE
-  // @brief List of all satellite collections
+  // @brief List of all satellite collections joined into other snippets
   std::unordered_set<Collection const*> _satellites;
-#endif
 
   // @brief List of all graphNodes that need to create TraverserEngines on
   // DBServers
@@ -53,39 +53,8 @@ EnumerateCollectionBlock::EnumerateCollectionBlock(
   buildCallback();
 
   if (ServerState::instance()->isRunningInCluster() && _collection->isSatellite()) {
-    auto logicalCollection = _collection->getCollection();
-    auto cid = logicalCollection->planId();
-    auto& dbName = logicalCollection->vocbase().name();
-    double maxWait = _engine->getQuery()->queryOptions().satelliteSyncWait;
-    bool inSync = false;
-    unsigned long waitInterval = 10000;
-    double startTime = TRI_microtime();
-    double now = startTime;
-    double endTime = startTime + maxWait;
-
-    while (!inSync) {
-      auto collectionInfoCurrent = ClusterInfo::instance()->getCollectionCurrent(
-        dbName, std::to_string(cid));
-      auto followers = collectionInfoCurrent->servers(_collection->name());
-      inSync = std::find(followers.begin(), followers.end(),
-                         ServerState::instance()->getId()) != followers.end();
-      if (!inSync) {
-        if (endTime - now < waitInterval) {
-          waitInterval = static_cast<unsigned long>(endTime - now);
-        }
-        std::this_thread::sleep_for(std::chrono::microseconds(waitInterval));
-      }
-      now = TRI_microtime();
-      if (now > endTime) {
-        break;
-      }
-    }
-
-    if (!inSync) {
-      THROW_ARANGO_EXCEPTION_MESSAGE(
-          TRI_ERROR_CLUSTER_AQL_COLLECTION_OUT_OF_SYNC,
-          "collection " + _collection->name() + " did not come into sync in time (" + std::to_string(maxWait) +")");
-    }
+    _collection->waitForSatelliteSync(
+        _engine->getQuery()->queryOptions().satelliteSyncWait);
   }
 }
 
@@ -128,7 +97,7 @@ EnumerateCollectionBlock::getSome(size_t atMost) {
   std::unique_ptr<AqlItemBlock> res;
 
   do {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(batchSize(), atMost);
     BufferState bufferState = getBlockIfNeeded(toFetch);
     if (bufferState == BufferState::WAITING) {
       return {ExecutionState::WAITING, nullptr};
@@ -224,7 +193,7 @@ std::pair<ExecutionState, size_t> EnumerateCollectionBlock::skipSome(size_t atMo
 
   while (_inflight < atMost) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost - _inflight);
+      size_t toFetch = (std::min)(batchSize(), atMost - _inflight);
       auto upstreamRes = getBlock(toFetch);
       if (upstreamRes.first == ExecutionState::WAITING) {
         traceSkipSomeEnd(0, ExecutionState::WAITING);
@@ -83,7 +83,7 @@ EnumerateListBlock::getSome(size_t atMost) {
     // can contain zero entries, in which case we have to
     // try again!
 
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(batchSize(), atMost);
     BufferState bufferState = getBlockIfNeeded(toFetch);
     if (bufferState == BufferState::WAITING) {
       TRI_ASSERT(res == nullptr);
@@ -177,7 +177,7 @@ std::pair<ExecutionState, size_t> EnumerateListBlock::skipSome(size_t atMost) {
     return {ExecutionState::DONE, skipped};
   }
   while (_inflight < atMost) {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost - _inflight);
+    size_t toFetch = (std::min)(batchSize(), atMost - _inflight);
     BufferState bufferState = getBlockIfNeeded(toFetch);
     if (bufferState == BufferState::WAITING) {
       traceSkipSomeEnd(0, ExecutionState::WAITING);
@@ -65,6 +65,7 @@ ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
       _pos(0),
       _done(false),
       _profile(engine->getQuery()->queryOptions().profile),
+      _batchSize(computeBatchSize(ep)),
       _getSomeBegin(0.0),
       _upstreamState(ExecutionState::HASMORE),
       _skipped(0),
@@ -73,8 +74,66 @@ ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
    
   // already insert ourselves into the statistics results 
   if (_profile >= PROFILE_LEVEL_BLOCKS) {
-    _engine->_stats.nodes.emplace(ep->id(), ExecutionStats::Node());
+    ExecutionStats::Node stats;
+    stats.batchSize = _batchSize;
+    _engine->_stats.nodes.emplace(ep->id(), stats);
+  }
+}
+
+/// @brief determine the batch size for a block of the node. narrow rows
+/// allow bigger batches, so the overhead of each getSome call is amortized.
+/// wide rows lead to smaller batches, so that a block stays cache-resident.
+/// a LIMIT further down the pipeline also caps the batch size
+size_t ExecutionBlock::computeBatchSize(ExecutionNode const* node) {
+  // try to keep the values of each block within this many bytes
+  constexpr size_t targetBlockSize = 256 * 1024;
+
+  size_t width = 1;
+  auto const* registerPlan = node->getRegisterPlan();
+  if (registerPlan != nullptr && node->getDepth() >= 0 &&
+      static_cast<size_t>(node->getDepth()) < registerPlan->nrRegs.size()) {
+    width = (std::max)(width, static_cast<size_t>(registerPlan->nrRegs[node->getDepth()]));
+  }
+
+  size_t batchSize = targetBlockSize / (sizeof(AqlValue) * width);
+  batchSize = (std::max)(MinBatchSize(), (std::min)(MaxBatchSize(), batchSize));
+
+  // look for a LIMIT that is reached via nodes producing exactly one row
+  // per input row. if the node itself does so, too, it never needs to
+  // fetch more rows than the LIMIT lets through. other nodes may need more
+  // input rows, so they keep using the minimum batch size
+  bool exact = true;
+  switch (node->getType()) {
+    case ExecutionNode::CALCULATION:
+    case ExecutionNode::SUBQUERY:
+    case ExecutionNode::MATERIALIZE:
+      break;
+    default:
+      exact = false;
+  }
+
+  ExecutionNode const* current = node->getFirstParent();
+  while (current != nullptr) {
+    auto const type = current->getType();
+    if (type == ExecutionNode::LIMIT) {
+      auto const* limit = ExecutionNode::castTo<LimitNode const*>(current);
+      if (!limit->fullCount()) {
+        size_t rows = (std::max)(size_t(1), limit->offset() + limit->limit());
+        if (!exact) {
+          rows = (std::max)(rows, MinBatchSize());
+        }
+        batchSize = (std::min)(batchSize, rows);
+      }
+      break;
+    }
+    if (type != ExecutionNode::CALCULATION && type != ExecutionNode::SUBQUERY &&
+        type != ExecutionNode::MATERIALIZE) {
+      break;
+    }
+    current = current->getFirstParent();
   }
+
+  return batchSize;
 }
 
 ExecutionBlock::~ExecutionBlock() {
@@ -210,6 +269,7 @@ void ExecutionBlock::traceGetSomeEnd(AqlItemBlock const* result, ExecutionState
     ExecutionNode const* en = getPlanNode();
     ExecutionStats::Node stats;
     stats.calls = 1;
+    stats.batchSize = _batchSize;
     stats.items = result != nullptr ? result->size() : 0;
     if (state != ExecutionState::WAITING) {
       stats.runtime = TRI_microtime() - _getSomeBegin;
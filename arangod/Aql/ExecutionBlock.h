@@ -56,6 +56,18 @@ class ExecutionBlock {
   /// @brief batch size value
   static constexpr inline size_t DefaultBatchSize() { return 1000; }
 
+  /// @brief lower and upper bounds for the adaptive batch size
+  static constexpr inline size_t MinBatchSize() { return 100; }
+  static constexpr inline size_t MaxBatchSize() { return 4000; }
+
+  /// @brief the number of rows the block requests from its dependencies
+  /// at once. this is determined from the width of the rows and a LIMIT
+  /// further down the pipeline
+  size_t batchSize() const { return _batchSize; }
+
+  /// @brief determine the batch size for a block of the node
+  static size_t computeBatchSize(ExecutionNode const* node);
+
   /// @brief returns the register id for a variable id
   /// will return ExecutionNode::MaxRegisterId for an unknown variable
   RegisterId getRegister(VariableId id) const;
@@ -249,6 +261,9 @@ class ExecutionBlock {
 
   /// @brief profiling level
   uint32_t _profile;
+
+  /// @brief number of rows to request from dependencies at once
+  size_t const _batchSize;
   
   /// @brief getSome begin point in time
   double _getSomeBegin;
@@ -35,7 +35,10 @@
 #include "Aql/EnumerateCollectionBlock.h"
 #include "Aql/EnumerateListBlock.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IndexNode.h"
+#include "Aql/MaterializeNode.h"
+#include "Aql/MergeJoinNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/NodeFinder.h"
 #include "Aql/Query.h"
@@ -89,6 +92,9 @@ std::unordered_map<int, std::string const> const typeNames{
 #ifdef USE_IRESEARCH
     {static_cast<int>(ExecutionNode::ENUMERATE_IRESEARCH_VIEW), "EnumerateViewNode"},
 #endif
+    {static_cast<int>(ExecutionNode::HASH_JOIN), "HashJoinNode"},
+    {static_cast<int>(ExecutionNode::MERGE_JOIN), "MergeJoinNode"},
+    {static_cast<int>(ExecutionNode::MATERIALIZE), "MaterializeNode"},
 };
 
 } // namespace
@@ -298,6 +304,12 @@ ExecutionNode* ExecutionNode::fromVPackFactory(
       return new ShortestPathNode(plan, slice);
     case REMOTESINGLE:
       return new SingleRemoteOperationNode(plan, slice);
+    case HASH_JOIN:
+      return new HashJoinNode(plan, slice);
+    case MERGE_JOIN:
+      return new MergeJoinNode(plan, slice);
+    case MATERIALIZE:
+      return new MaterializeNode(plan, slice);
 #ifdef USE_IRESEARCH
     case ENUMERATE_IRESEARCH_VIEW:
       return new iresearch::IResearchViewNode(*plan, slice);
@@ -844,12 +856,21 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
   switch (en->getType()) {
     case ExecutionNode::ENUMERATE_COLLECTION: 
     case ExecutionNode::INDEX: {
+      // an IndexNode may additionally produce the ids of its documents, in
+      // the register following the documents
+      Variable const* documentIdVariable = nullptr;
+      if (en->getType() == ExecutionNode::INDEX) {
+        documentIdVariable =
+            ExecutionNode::castTo<IndexNode const*>(en)->outDocumentIdVariable();
+      }
+      RegisterId const regsHere = (documentIdVariable != nullptr) ? 2 : 1;
+
       depth++;
-      nrRegsHere.emplace_back(1);
+      nrRegsHere.emplace_back(regsHere);
       // create a copy of the last value here
       // this is required because back returns a reference and emplace/push_back
       // may invalidate all references
-      RegisterId registerId = 1 + nrRegs.back();
+      RegisterId registerId = regsHere + nrRegs.back();
       nrRegs.emplace_back(registerId);
 
       auto ep = dynamic_cast<DocumentProducingNode const*>(en);
@@ -859,6 +880,10 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
 
       varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
       totalNrRegs++;
+      if (documentIdVariable != nullptr) {
+        varInfo.emplace(documentIdVariable->id, VarInfo(depth, totalNrRegs));
+        totalNrRegs++;
+      }
       break;
     }
 
@@ -878,6 +903,33 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::HASH_JOIN:
+    case ExecutionNode::MERGE_JOIN: {
+      depth++;
+      nrRegsHere.emplace_back(1);
+      // create a copy of the last value here
+      // this is required because back returns a reference and emplace/push_back
+      // may invalidate all references
+      RegisterId registerId = 1 + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      auto ep = ExecutionNode::castTo<JoinNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
+    case ExecutionNode::MATERIALIZE: {
+      nrRegsHere[depth]++;
+      nrRegs[depth]++;
+      auto ep = ExecutionNode::castTo<MaterializeNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
     case ExecutionNode::CALCULATION: {
       nrRegsHere[depth]++;
       nrRegs[depth]++;
@@ -1375,7 +1427,9 @@ LimitNode::LimitNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& bas
     : ExecutionNode(plan, base),
       _offset(base.get("offset").getNumericValue<decltype(_offset)>()),
       _limit(base.get("limit").getNumericValue<decltype(_limit)>()),
-      _fullCount(base.get("fullCount").getBoolean()) {}
+      _fullCount(base.get("fullCount").getBoolean()),
+      _continuationVariable(Variable::varFromVPack(
+          plan->getAst(), base, "continuationVariable", true)) {}
 
 /// @brief creates corresponding ExecutionBlock
 std::unique_ptr<ExecutionBlock> LimitNode::createBlock(
@@ -1385,6 +1439,27 @@ std::unique_ptr<ExecutionBlock> LimitNode::createBlock(
   return std::make_unique<LimitBlock>(&engine, this);
 }
 
+/// @brief clone ExecutionNode recursively
+ExecutionNode* LimitNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                bool withProperties) const {
+  auto c = std::make_unique<LimitNode>(plan, _id, _offset, _limit);
+
+  if (_fullCount) {
+    c->setFullCount();
+  }
+
+  if (_continuationVariable != nullptr) {
+    auto continuationVariable = _continuationVariable;
+    if (withProperties) {
+      continuationVariable =
+          plan->getAst()->variables()->createVariable(continuationVariable);
+    }
+    c->continuationVariable(continuationVariable);
+  }
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
 // @brief toVelocyPack, for LimitNode
 void LimitNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
   // call base class method
@@ -1392,6 +1467,10 @@ void LimitNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
   nodes.add("offset", VPackValue(static_cast<double>(_offset)));
   nodes.add("limit", VPackValue(static_cast<double>(_limit)));
   nodes.add("fullCount", VPackValue(_fullCount));
+  if (_continuationVariable != nullptr) {
+    nodes.add(VPackValue("continuationVariable"));
+    _continuationVariable->toVelocyPack(nodes);
+  }
 
   // And close it:
   nodes.close();
@@ -1517,7 +1596,9 @@ SubqueryNode::SubqueryNode(ExecutionPlan* plan,
                            arangodb::velocypack::Slice const& base)
     : ExecutionNode(plan, base),
       _subquery(nullptr),
-      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")) {}
+      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")),
+      _cacheResults(VelocyPackHelper::getBooleanValue(base, "cacheResults", false)),
+      _interleaved(VelocyPackHelper::getBooleanValue(base, "interleaved", false)) {}
 
 /// @brief toVelocyPack, for SubqueryNode
 void SubqueryNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
@@ -1530,6 +1611,8 @@ void SubqueryNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const
   _outVariable->toVelocyPack(nodes);
 
   nodes.add("isConst", VPackValue(const_cast<SubqueryNode*>(this)->isConst()));
+  nodes.add("cacheResults", VPackValue(_cacheResults));
+  nodes.add("interleaved", VPackValue(_interleaved));
 
   // And add it:
   nodes.close();
@@ -1574,6 +1657,22 @@ bool SubqueryNode::isConst() {
   return true;
 }
 
+bool SubqueryNode::canCacheResults() {
+  if (isModificationSubquery() || !isDeterministic()) {
+    return false;
+  }
+
+  if (mayAccessCollections() && _plan->getAst()->query()->isModificationQuery()) {
+    // the outer query may modify the data the subquery reads, so the
+    // subquery may return different results for the same input values
+    return false;
+  }
+
+  // a subquery that does not depend on the outer query will be executed
+  // only once anyway
+  return !isConst() && !getVariablesUsedHere().empty();
+}
+
 bool SubqueryNode::mayAccessCollections() {
   if (_plan->getAst()->functionsMayAccessDocuments()) {
     // if the query contains any calls to functions that MAY access any
@@ -1633,6 +1732,8 @@ ExecutionNode* SubqueryNode::clone(ExecutionPlan* plan, bool withDependencies,
   }
   auto c = std::make_unique<SubqueryNode>(
       plan, _id, _subquery->clone(plan, true, withProperties), outVariable);
+  c->_cacheResults = _cacheResults;
+  c->_interleaved = _interleaved;
 
   return cloneHelper(std::move(c), withDependencies, withProperties);
 }
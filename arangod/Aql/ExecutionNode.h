@@ -150,6 +150,9 @@ class ExecutionNode {
 #ifdef USE_IRESEARCH
     ENUMERATE_IRESEARCH_VIEW,
 #endif
+    HASH_JOIN = 27,
+    MERGE_JOIN = 28,
+    MATERIALIZE = 29,
     MAX_NODE_TYPE_VALUE
   };
 
@@ -782,7 +785,8 @@ class LimitNode : public ExecutionNode {
       : ExecutionNode(plan, id),
         _offset(offset),
         _limit(limit),
-        _fullCount(false) {}
+        _fullCount(false),
+        _continuationVariable(nullptr) {}
 
   LimitNode(ExecutionPlan*, arangodb::velocypack::Slice const& base);
 
@@ -801,15 +805,7 @@ class LimitNode : public ExecutionNode {
 
   /// @brief clone ExecutionNode recursively
   ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
-                       bool withProperties) const override final {
-    auto c = std::make_unique<LimitNode>(plan, _id, _offset, _limit);
-
-    if (_fullCount) {
-      c->setFullCount();
-    }
-
-    return cloneHelper(std::move(c), withDependencies, withProperties);
-  }
+                       bool withProperties) const override final;
 
   /// @brief estimateCost
   CostEstimate estimateCost() const override final;
@@ -817,12 +813,39 @@ class LimitNode : public ExecutionNode {
   /// @brief tell the node to fully count what it will limit
   void setFullCount() { _fullCount = true; }
 
+  /// @brief whether or not the node fully counts what it will limit
+  bool fullCount() const { return _fullCount; }
+
   /// @brief return the offset value
   size_t offset() const { return _offset; }
 
   /// @brief return the limit value
   size_t limit() const { return _limit; }
 
+  /// @brief let the node build the continuation token of the query from
+  /// the values of the variable in the rows it returns
+  void continuationVariable(Variable const* variable) {
+    _continuationVariable = variable;
+  }
+
+  Variable const* continuationVariable() const { return _continuationVariable; }
+
+  /// @brief getVariablesUsedHere, returning a vector
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    if (_continuationVariable == nullptr) {
+      return std::vector<Variable const*>();
+    }
+    return std::vector<Variable const*>{_continuationVariable};
+  }
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& vars) const override final {
+    if (_continuationVariable != nullptr) {
+      vars.emplace(_continuationVariable);
+    }
+  }
+
  private:
   /// @brief the offset
   size_t _offset;
@@ -832,6 +855,9 @@ class LimitNode : public ExecutionNode {
 
   /// @brief whether or not the node should fully count what it limits
   bool _fullCount;
+
+  /// @brief first sort attribute of the rows, for keyset pagination
+  Variable const* _continuationVariable;
 };
 
 /// @brief class CalculationNode
@@ -948,7 +974,9 @@ class SubqueryNode : public ExecutionNode {
                Variable const* outVariable)
       : ExecutionNode(plan, id),
         _subquery(subquery),
-        _outVariable(outVariable) {
+        _outVariable(outVariable),
+        _cacheResults(false),
+        _interleaved(false) {
     TRI_ASSERT(_subquery != nullptr);
     TRI_ASSERT(_outVariable != nullptr);
   }
@@ -1013,12 +1041,38 @@ class SubqueryNode : public ExecutionNode {
   bool isConst();
   bool mayAccessCollections();
 
+  /// @brief whether or not the results of the subquery can be reused for
+  /// all input rows with the same values of the variables it uses
+  bool canCacheResults();
+
+  /// @brief whether or not the subquery results are cached per combination
+  /// of the variables the subquery uses
+  bool cacheResults() const { return _cacheResults; }
+
+  /// @brief turn caching of subquery results on
+  void setCacheResults() { _cacheResults = true; }
+
+  /// @brief whether or not the subquery is executed row by row together
+  /// with the subquery of the SubqueryNode this node depends on, so that
+  /// both can wait for remote responses at the same time
+  bool interleaved() const { return _interleaved; }
+
+  /// @brief interleave the subquery with the one of the dependency
+  void setInterleaved() { _interleaved = true; }
+
  private:
   /// @brief we need to have an expression and where to write the result
   ExecutionNode* _subquery;
 
   /// @brief variable to write to
   Variable const* _outVariable;
+
+  /// @brief whether or not the subquery results are cached
+  bool _cacheResults;
+
+  /// @brief whether or not the subquery is interleaved with the one of
+  /// the dependency
+  bool _interleaved;
 };
 
 /// @brief class FilterNode
@@ -201,6 +201,14 @@ std::unique_ptr<graph::BaseOptions> createShortestPathOptions(
               std::string(value->getStringValue(), value->getStringLength());
         } else if (name == "defaultWeight" && value->isNumericValue()) {
           options->defaultWeight = value->getDoubleValue();
+        } else if (name == "paths" && value->isNumericValue()) {
+          int64_t paths = value->getIntValue();
+          if (paths < 1) {
+            THROW_ARANGO_EXCEPTION_MESSAGE(
+                TRI_ERROR_BAD_PARAMETER,
+                "shortest path option 'paths' must be at least 1");
+          }
+          options->numberOfPaths = static_cast<uint64_t>(paths);
         }
       }
     }
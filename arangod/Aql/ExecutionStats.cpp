@@ -56,6 +56,20 @@ void ExecutionStats::toVelocyPack(VPackBuilder& builder, bool reportFullCount) c
       builder.add("calls", VPackValue(pair.second.calls));
       builder.add("items", VPackValue(pair.second.items));
       builder.add("runtime", VPackValue(pair.second.runtime));
+      builder.add("batchSize", VPackValue(pair.second.batchSize));
+      builder.close();
+    }
+    builder.close();
+  }
+
+  if (!spans.empty()) {
+    builder.add("spans", VPackValue(VPackValueType::Array));
+    for (auto const& span : spans) {
+      builder.openObject();
+      builder.add("server", VPackValue(span.server));
+      builder.add("operation", VPackValue(span.operation));
+      builder.add("start", VPackValue(span.start));
+      builder.add("duration", VPackValue(span.duration));
       builder.close();
     }
     builder.close();
@@ -88,6 +102,13 @@ void ExecutionStats::add(ExecutionStats const& summand) {
       result.first->second += pair.second;
     }
   }
+
+  for (auto const& span : summand.spans) {
+    if (spans.size() >= maxSpans) {
+      break;
+    }
+    spans.push_back(span);
+  }
 }
 
 ExecutionStats::ExecutionStats()
@@ -133,7 +154,22 @@ ExecutionStats::ExecutionStats(VPackSlice const& slice)
       node.calls = val.get("calls").getNumber<size_t>();
       node.items = val.get("items").getNumber<size_t>();
       node.runtime = val.get("runtime").getNumber<double>();
+      VPackSlice batchSize = val.get("batchSize");
+      node.batchSize = batchSize.isNumber() ? batchSize.getNumber<size_t>() : 0;
       nodes.emplace(nid, node);
     }
   }
+
+  // note: spans are optional, too
+  VPackSlice spanList = slice.get("spans");
+  if (spanList.isArray()) {
+    for (VPackSlice val : VPackArrayIterator(spanList)) {
+      Span span;
+      span.server = val.get("server").copyString();
+      span.operation = val.get("operation").copyString();
+      span.start = val.get("start").getNumber<double>();
+      span.duration = val.get("duration").getNumber<double>();
+      addSpan(std::move(span));
+    }
+  }
 }
@@ -47,13 +47,32 @@ struct ExecutionStats {
     size_t calls = 0;
     size_t items = 0;
     double runtime = 0.0;
+    /// @brief number of rows the block requested from its dependencies
+    size_t batchSize = 0;
     ExecutionStats::Node& operator+=(ExecutionStats::Node const& other) {
       calls += other.calls;
       items += other.items;
       runtime += other.runtime;
+      batchSize = (std::max)(batchSize, other.batchSize);
       return *this;
     }
   };
+
+  /// @brief a single round trip to another server, recorded by remote
+  /// blocks when the query is profiled at block level
+  struct Span {
+    /// @brief the remote end, e.g. "server:PRMR-..." or "shard:s1000"
+    std::string server;
+    /// @brief the remote operation, e.g. "getSome"
+    std::string operation;
+    /// @brief local start time of the request
+    double start = 0.0;
+    /// @brief time until the response arrived
+    double duration = 0.0;
+  };
+
+  /// @brief maximum number of spans kept per query
+  static constexpr size_t maxSpans = 1024;
   
  public:
   /// @brief convert the statistics to VelocyPack
@@ -68,6 +87,13 @@ struct ExecutionStats {
   /// @brief sumarize two sets of ExecutionStats
   void add(ExecutionStats const& summand);
 
+  /// @brief record a round trip, unless the span limit is reached
+  void addSpan(Span&& span) {
+    if (spans.size() < maxSpans) {
+      spans.emplace_back(std::move(span));
+    }
+  }
+
   void clear() {
     writesExecuted = 0;
     writesIgnored = 0;
@@ -110,6 +136,10 @@ struct ExecutionStats {
   
   ///  @brief statistics per ExecutionNodes
   std::map<size_t, ExecutionStats::Node> nodes;
+
+  /// @brief round trips made by remote blocks, including the ones of
+  /// DB-server snippets
+  std::vector<ExecutionStats::Span> spans;
 };
 }
 }
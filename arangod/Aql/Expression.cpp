@@ -26,6 +26,7 @@
 #include "Aql/AqlValue.h"
 #include "Aql/Ast.h"
 #include "Aql/AttributeAccessor.h"
+#include "Aql/CompiledExpression.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/ExpressionContext.h"
@@ -111,6 +112,12 @@ AqlValue Expression::execute(transaction::Methods* trx, ExpressionContext* ctx,
       return _accessor->get(trx, ctx, mustDestroy);
     }
 
+    case COMPILED: {
+      TRI_ASSERT(_compiled != nullptr);
+      mustDestroy = false;
+      return _compiled->execute(this, trx, ctx);
+    }
+
     case UNPROCESSED: {
       // fall-through to exception
     }
@@ -171,6 +178,15 @@ void Expression::freeInternals() noexcept {
       break;
     }
 
+    case COMPILED: {
+      delete _compiled;
+      _compiled = nullptr;
+      // the compiled expression refers to the nodes of the expression, so
+      // it must be compiled again
+      _type = UNPROCESSED;
+      break;
+    }
+
     case SIMPLE:
     case UNPROCESSED: {
       // nothing to do
@@ -181,7 +197,7 @@ void Expression::freeInternals() noexcept {
 
 /// @brief reset internal attributes after variables in the expression were changed
 void Expression::invalidateAfterReplacements() {
-  if (_type == ATTRIBUTE_ACCESS || _type == SIMPLE) {
+  if (_type == ATTRIBUTE_ACCESS || _type == SIMPLE || _type == COMPILED) {
     freeInternals();
     // must even set back the expression type so the expression will be analyzed
     // again
@@ -309,6 +325,16 @@ void Expression::initSimpleExpression() {
   _type = SIMPLE;
 
   if (_node->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+    if (!_willUseV8) {
+      // lower arithmetic and logic into instructions on typed registers.
+      // expressions using V8 are not compiled, as they may be invalidated
+      // between V8 contexts
+      auto compiled = CompiledExpression::compile(_node);
+      if (compiled != nullptr) {
+        _compiled = compiled.release();
+        _type = COMPILED;
+      }
+    }
     return;
   }
 
@@ -881,9 +907,26 @@ AqlValue Expression::invokeV8Function(ExpressionContext* expressionContext,
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, std::string("unable to find AQL function '") + jsName + "'");
   }
 
+  return invokeV8Function(expressionContext, trx, v8::Handle<v8::Function>::Cast(function),
+                          ucInvokeFN, AFN, rethrowV8Exception, callArgs, args, mustDestroy);
+}
+
+AqlValue Expression::invokeV8Function(ExpressionContext* expressionContext,
+                                      transaction::Methods* trx,
+                                      v8::Handle<v8::Function> function,
+                                      std::string const& ucInvokeFN,
+                                      char const* AFN,
+                                      bool rethrowV8Exception,
+                                      size_t callArgs,
+                                      v8::Handle<v8::Value>* args,
+                                      bool &mustDestroy
+                                      ){
+  ISOLATE;
+  auto current = isolate->GetCurrentContext()->Global();
+
   // actually call the V8 function
   v8::TryCatch tryCatch;
-  v8::Handle<v8::Value> result = v8::Handle<v8::Function>::Cast(function)->Call(current, static_cast<int>(callArgs), args);
+  v8::Handle<v8::Value> result = function->Call(current, static_cast<int>(callArgs), args);
 
   try {
     V8Executor::HandleV8Error(tryCatch, result, nullptr, false);
@@ -956,6 +999,11 @@ AqlValue Expression::executeSimpleExpressionFCallJS(
       // call parameters
       args[1] = params;
       // args[2] will be null
+
+      v8::Handle<v8::Function> function = _ast->query()->userFunctionCall(isolate);
+      if (!function.IsEmpty()) {
+        return invokeV8Function(_expressionContext, trx, function, "", "", true, callArgs, args.get(), mustDestroy);
+      }
     } else {
       // a call to a built-in V8 function
       auto func = static_cast<Function*>(node->getData());
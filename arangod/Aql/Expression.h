@@ -48,14 +48,17 @@ class AqlItemBlock;
 struct AqlValue;
 class Ast;
 class AttributeAccessor;
+class CompiledExpression;
 class ExecutionPlan;
 class ExpressionContext;
 class Query;
 
 /// @brief AqlExpression, used in execution plans and execution blocks
 class Expression {
+  friend class CompiledExpression;
+
  public:
-  enum ExpressionType : uint32_t { UNPROCESSED, JSON, SIMPLE, ATTRIBUTE_ACCESS };
+  enum ExpressionType : uint32_t { UNPROCESSED, JSON, SIMPLE, ATTRIBUTE_ACCESS, COMPILED };
 
   Expression(Expression const&) = delete;
   Expression& operator=(Expression const&) = delete;
@@ -139,6 +142,8 @@ class Expression {
         return "simple";
       case ATTRIBUTE_ACCESS:
         return "attribute";
+      case COMPILED:
+        return "compiled";
       case UNPROCESSED: {
       }
     }
@@ -157,6 +162,18 @@ class Expression {
                                    v8::Handle<v8::Value>* args,
                                    bool& mustDestroy);
 
+  // @brief invoke an already resolved JavaScript aql function with args as
+  // param.
+  static AqlValue invokeV8Function(arangodb::aql::ExpressionContext* expressionContext,
+                                   transaction::Methods* trx,
+                                   v8::Handle<v8::Function> function,
+                                   std::string const& ucInvokeFN,
+                                   char const* AFN,
+                                   bool rethrowV8Exception,
+                                   size_t callArgs,
+                                   v8::Handle<v8::Value>* args,
+                                   bool& mustDestroy);
+
   /// @brief check whether this is an attribute access of any degree (e.g. a.b,
   /// a.b.c, ...)
   bool isAttributeAccess() const;
@@ -348,6 +365,7 @@ class Expression {
   union {
     uint8_t* _data;
     AttributeAccessor* _accessor;
+    CompiledExpression* _compiled;
   };
 
   /// @brief type of expression
@@ -39,6 +39,7 @@ class Methods;
 namespace aql {
 struct AqlValue;
 class Query;
+struct SimpleLikePattern;
 struct Variable;
 
 class ExpressionContext {
@@ -61,6 +62,7 @@ class ExpressionContext {
   virtual icu::RegexMatcher* buildRegexMatcher(char const* ptr, size_t length, bool caseInsensitive) = 0;
   virtual icu::RegexMatcher* buildLikeMatcher(char const* ptr, size_t length, bool caseInsensitive) = 0;
   virtual icu::RegexMatcher* buildSplitMatcher(AqlValue splitExpression, transaction::Methods*, bool& isEmptyExpression) = 0;
+  virtual SimpleLikePattern const* buildSimpleLikePattern(char const* ptr, size_t length) = 0;
 
   virtual bool killed() const = 0;
   virtual TRI_vocbase_t& vocbase() const = 0;
@@ -30,6 +30,7 @@
 #include "Aql/ExpressionContext.h"
 #include "Aql/Function.h"
 #include "Aql/Query.h"
+#include "Aql/RegexCache.h"
 #include "Aql/V8Executor.h"
 #include "Basics/Exceptions.h"
 #include "Basics/Mutex.h"
@@ -2865,6 +2866,21 @@ AqlValue Functions::Like(ExpressionContext* expressionContext,
   AqlValue regex = ExtractFunctionParameterValue(parameters, 1);
   ::appendAsString(trx, adapter, regex);
 
+  if (!caseInsensitive) {
+    // patterns that are plain prefix, suffix or substring matches don't
+    // need a regex. the pattern is owned by the context!
+    SimpleLikePattern const* simple = expressionContext->buildSimpleLikePattern(
+        buffer->c_str(), buffer->length());
+
+    if (simple->type != SimpleLikePattern::Type::REGEX) {
+      buffer->clear();
+      AqlValue value = ExtractFunctionParameterValue(parameters, 0);
+      ::appendAsString(trx, adapter, value);
+
+      return AqlValue(AqlValueHintBool(simple->matches(buffer->c_str(), buffer->length())));
+    }
+  }
+
   // the matcher is owned by the context!
   ::RegexMatcher* matcher = expressionContext->buildLikeMatcher(
       buffer->c_str(), buffer->length(), caseInsensitive);
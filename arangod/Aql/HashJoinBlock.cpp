@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinBlock.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+#include "Transaction/Methods.h"
+#include "Utils/OperationCursor.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+constexpr size_t HashJoinBlock::NoDocument;
+
+HashJoinBlock::HashJoinBlock(ExecutionEngine* engine, HashJoinNode const* en)
+    : ExecutionBlock(engine, en),
+      _collection(en->collection()),
+      _probeRegister(ExecutionNode::MaxRegisterId),
+      _built(false),
+      _memoryUsage(0),
+      _table(_trx, engine->getQuery()->resourceMonitor(), 1, 0),
+      _lookedUp(false),
+      _current(NoDocument),
+      _inflight(0) {
+  auto it = en->getRegisterPlan()->varInfo.find(en->probeVariable()->id);
+
+  if (it == en->getRegisterPlan()->varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+  }
+
+  _probeRegister = (*it).second.registerId;
+  TRI_ASSERT(_probeRegister < ExecutionNode::MaxRegisterId);
+}
+
+HashJoinBlock::~HashJoinBlock() {
+  _engine->getQuery()->decreaseMemoryUsage(_memoryUsage);
+}
+
+std::pair<ExecutionState, arangodb::Result> HashJoinBlock::initializeCursor(
+    AqlItemBlock* items, size_t pos) {
+  auto res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res.first == ExecutionState::WAITING ||
+      !res.second.ok()) {
+    // If we need to wait or get an error we return as is.
+    return res;
+  }
+
+  // the hash table is kept, as the collection did not change
+  _lookedUp = false;
+  _current = NoDocument;
+  _inflight = 0;
+
+  return res;
+}
+
+void HashJoinBlock::buildHashTable() {
+  TRI_ASSERT(!_built);
+  auto en = ExecutionNode::castTo<HashJoinNode const*>(getPlanNode());
+
+  std::unique_ptr<OperationCursor> cursor(_trx->indexScan(
+      _collection->name(), transaction::Methods::CursorType::ALL));
+
+  size_t count = 0;
+  _documents.openArray();
+  cursor->allDocuments([&](LocalDocumentId const&, VPackSlice doc) {
+    _documents.add(doc);
+    ++count;
+  }, batchSize());
+  _documents.close();
+
+  _engine->_stats.scannedFull += static_cast<int64_t>(count);
+
+  _engine->getQuery()->increaseMemoryUsage(_documents.size());
+  _memoryUsage = _documents.size();
+
+  throwIfKilled();  // check if we were aborted
+
+  _documentStarts.reserve(count);
+  _nextDocument.reserve(count);
+
+  // last document of each group, for appending to the group's chain. this
+  // keeps the documents of each group in collection order
+  std::vector<size_t> lastDocument;
+
+  for (auto const& doc : VPackArrayIterator(_documents.slice())) {
+    AqlValue document(AqlValueHintDocumentNoCopy(doc.begin()));
+    bool mustDestroy;
+    AqlValue key =
+        document.get(_trx, en->buildAttributes(), mustDestroy, false);
+    AqlValueGuard guard(key, mustDestroy);
+
+    auto result = _table.findOrInsert(&key);
+    size_t const index = _documentStarts.size();
+    _documentStarts.emplace_back(doc.begin());
+    _nextDocument.emplace_back(NoDocument);
+
+    if (result.second) {
+      _firstDocument.emplace_back(index);
+      lastDocument.emplace_back(index);
+    } else {
+      _nextDocument[lastDocument[result.first]] = index;
+      lastDocument[result.first] = index;
+    }
+  }
+
+  // the chains of documents grow with the collection. the hash table
+  // charges its memory itself
+  size_t const tableMemoryUsage =
+      _documentStarts.capacity() * sizeof(uint8_t const*) +
+      (_firstDocument.capacity() + _nextDocument.capacity()) * sizeof(size_t);
+  _engine->getQuery()->increaseMemoryUsage(tableMemoryUsage);
+  _memoryUsage += tableMemoryUsage;
+
+  _built = true;
+}
+
+void HashJoinBlock::lookup(AqlItemBlock const* cur) {
+  if (_lookedUp) {
+    return;
+  }
+
+  auto en = ExecutionNode::castTo<HashJoinNode const*>(getPlanNode());
+  AqlValue const& probe = cur->getValueReference(_pos, _probeRegister);
+
+  size_t group;
+  if (en->probeAttributes().empty()) {
+    group = _table.find(&probe);
+  } else {
+    bool mustDestroy;
+    AqlValue key = probe.get(_trx, en->probeAttributes(), mustDestroy, false);
+    AqlValueGuard guard(key, mustDestroy);
+    group = _table.find(&key);
+  }
+
+  _current = (group == AqlValueGroupTable::NotFound) ? NoDocument
+                                                     : _firstDocument[group];
+  _lookedUp = true;
+}
+
+std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>>
+HashJoinBlock::getSome(size_t atMost) {
+  traceGetSomeBegin(atMost);
+  if (_done) {
+    TRI_ASSERT(getHasMoreState() == ExecutionState::DONE);
+    traceGetSomeEnd(nullptr, ExecutionState::DONE);
+    return {ExecutionState::DONE, nullptr};
+  }
+
+  std::unique_ptr<AqlItemBlock> res;
+
+  while (res == nullptr) {
+    // repeatedly try to get more stuff from upstream
+    // note that an input row may not find any matching document,
+    // in which case we have to try again!
+
+    size_t toFetch = (std::min)(batchSize(), atMost);
+    BufferState bufferState = getBlockIfNeeded(toFetch);
+    if (bufferState == BufferState::WAITING) {
+      TRI_ASSERT(res == nullptr);
+      traceGetSomeEnd(nullptr, ExecutionState::WAITING);
+      return {ExecutionState::WAITING, nullptr};
+    }
+    if (bufferState == BufferState::NO_MORE_BLOCKS) {
+      break;
+    }
+
+    TRI_ASSERT(bufferState == BufferState::HAS_BLOCKS ||
+               bufferState == BufferState::HAS_NEW_BLOCK);
+    TRI_ASSERT(!_buffer.empty());
+
+    if (!_built) {
+      buildHashTable();
+    }
+
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    lookup(cur);
+
+    if (_current != NoDocument) {
+      size_t toSend = 0;
+      for (size_t d = _current; d != NoDocument && toSend < atMost;
+           d = _nextDocument[d]) {
+        ++toSend;
+      }
+
+      // create the result
+      res.reset(requestBlock(toSend, getNrOutputRegisters()));
+
+      inheritRegisters(cur, res.get(), _pos);
+
+      for (size_t j = 0; j < toSend; j++) {
+        // the documents are owned by this block, which lives as long as
+        // the query
+        res->emplaceValue(j, cur->getNrRegs(),
+                          AqlValueHintDocumentNoCopy(_documentStarts[_current]));
+
+        if (j > 0) {
+          // re-use already copied AqlValues
+          res->copyValuesFromFirstRow(j, cur->getNrRegs());
+        }
+        _current = _nextDocument[_current];
+      }
+    }
+
+    if (_current == NoDocument) {
+      _lookedUp = false;
+
+      AqlItemBlock* removedBlock = advanceCursor(1, 0);
+      returnBlockUnlessNull(removedBlock);
+    }
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+  traceGetSomeEnd(res.get(), getHasMoreState());
+  return {getHasMoreState(), std::move(res)};
+}
+
+std::pair<ExecutionState, size_t> HashJoinBlock::skipSome(size_t atMost) {
+  traceSkipSomeBegin(atMost);
+  if (_done) {
+    size_t skipped = _inflight;
+    _inflight = 0;
+    traceSkipSomeEnd(skipped, ExecutionState::DONE);
+    return {ExecutionState::DONE, skipped};
+  }
+
+  while (_inflight < atMost) {
+    size_t toFetch = (std::min)(batchSize(), atMost - _inflight);
+    BufferState bufferState = getBlockIfNeeded(toFetch);
+    if (bufferState == BufferState::WAITING) {
+      traceSkipSomeEnd(0, ExecutionState::WAITING);
+      return {ExecutionState::WAITING, 0};
+    }
+    if (bufferState == BufferState::NO_MORE_BLOCKS) {
+      break;
+    }
+
+    TRI_ASSERT(!_buffer.empty());
+
+    if (!_built) {
+      buildHashTable();
+    }
+
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    lookup(cur);
+
+    while (_current != NoDocument && _inflight < atMost) {
+      _current = _nextDocument[_current];
+      ++_inflight;
+    }
+
+    if (_current == NoDocument) {
+      _lookedUp = false;
+
+      AqlItemBlock* removedBlock = advanceCursor(1, 0);
+      returnBlockUnlessNull(removedBlock);
+    }
+  }
+
+  size_t skipped = _inflight;
+  _inflight = 0;
+  ExecutionState state = getHasMoreState();
+  traceSkipSomeEnd(skipped, state);
+  return {state, skipped};
+}
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_BLOCK_H
+#define ARANGOD_AQL_HASH_JOIN_BLOCK_H 1
+
+#include "Aql/AqlValueGroupTable.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/HashJoinNode.h"
+
+#include <velocypack/Builder.h>
+
+namespace arangodb {
+namespace aql {
+class AqlItemBlock;
+struct Collection;
+class ExecutionEngine;
+
+class HashJoinBlock final : public ExecutionBlock {
+ public:
+  HashJoinBlock(ExecutionEngine* engine, HashJoinNode const* en);
+  ~HashJoinBlock();
+
+  std::pair<ExecutionState, Result> initializeCursor(AqlItemBlock* items,
+                                                     size_t pos) override;
+
+  std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> getSome(
+      size_t atMost) override final;
+
+  // skip atMost documents, returns the number actually skipped . . .
+  std::pair<ExecutionState, size_t> skipSome(size_t atMost) override final;
+
+ private:
+  /// @brief reads all documents of the collection and builds the hash table
+  /// from them. this is done only once per query, as the documents of the
+  /// collection cannot change during the query
+  void buildHashTable();
+
+  /// @brief looks up the first matching document for the current input row
+  /// if this has not been done yet
+  void lookup(AqlItemBlock const* cur);
+
+ private:
+  /// @brief marker for the end of a chain of documents
+  static constexpr size_t NoDocument = SIZE_MAX;
+
+  /// @brief collection
+  Collection const* _collection;
+
+  /// @brief register of the probe variable
+  RegisterId _probeRegister;
+
+  /// @brief whether or not the hash table was built already
+  bool _built;
+
+  /// @brief copies of all documents of the collection
+  arangodb::velocypack::Builder _documents;
+
+  /// @brief memory used by _documents and the hash table, as accounted for
+  /// in the query
+  size_t _memoryUsage;
+
+  /// @brief hash table of the distinct values of the build attribute
+  AqlValueGroupTable _table;
+
+  /// @brief start of each document in _documents
+  std::vector<uint8_t const*> _documentStarts;
+
+  /// @brief first document for each group in _table
+  std::vector<size_t> _firstDocument;
+
+  /// @brief next document with the same build value, or NoDocument
+  std::vector<size_t> _nextDocument;
+
+  /// @brief whether or not _current belongs to the current input row
+  bool _lookedUp;
+
+  /// @brief next document to produce for the current input row
+  size_t _current;
+
+  /// @brief number of skipped rows in the moment we hit WAITING
+  size_t _inflight;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
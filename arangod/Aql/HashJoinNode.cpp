@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/HashJoinBlock.h"
+#include "Aql/Query.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan, size_t id,
+                           aql::Collection const* collection,
+                           Variable const* outVariable,
+                           std::vector<std::string> const& buildAttributes,
+                           Variable const* probeVariable,
+                           std::vector<std::string> const& probeAttributes)
+    : JoinNode(plan, id, collection, outVariable, buildAttributes,
+               probeVariable, probeAttributes) {}
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan,
+                           arangodb::velocypack::Slice const& base)
+    : JoinNode(plan, base) {}
+
+/// @brief toVelocyPack, for HashJoinNode
+void HashJoinNode::toVelocyPackHelper(VPackBuilder& builder,
+                                      unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
+
+  // add join attributes and collection information
+  toVelocyPackHelperJoin(builder);
+
+  // And close it:
+  builder.close();
+}
+
+/// @brief creates corresponding ExecutionBlock
+std::unique_ptr<ExecutionBlock> HashJoinNode::createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+) const {
+  return std::make_unique<HashJoinBlock>(&engine, this);
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* HashJoinNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                   bool withProperties) const {
+  auto outVariable = _outVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+  }
+
+  // the probe variable is set by a node above, it is not recreated
+  auto c = std::make_unique<HashJoinNode>(plan, _id, _collection, outVariable,
+                                          _buildAttributes, _probeVariable,
+                                          _probeAttributes);
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the cost of a hash join node is the cost of reading the collection
+/// once, plus one lookup per incoming item
+CostEstimate HashJoinNode::estimateCost() const {
+  transaction::Methods* trx = _plan->getAst()->query()->trx();
+  if (trx->status() != transaction::Status::RUNNING) {
+    return CostEstimate::empty();
+  }
+
+  TRI_ASSERT(!_dependencies.empty());
+  CostEstimate estimate = _dependencies.at(0)->getCost();
+  // the documents are read only once to build the hash table. for the
+  // lookups, we assume that each incoming item finds one document
+  estimate.estimatedCost +=
+      static_cast<double>(_collection->count(trx)) + estimate.estimatedNrItems;
+  return estimate;
+}
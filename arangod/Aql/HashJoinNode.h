@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_NODE_H
+#define ARANGOD_AQL_HASH_JOIN_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/JoinNode.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+
+/// @brief class HashJoinNode. replaces the inner FOR loop of an equi-join
+/// `FOR a IN ... FOR b IN collection FILTER a.x == b.y`. the documents of
+/// the collection are read once into a hash table keyed by b.y (the build
+/// side), which is then probed with a.x for each incoming row (the probe
+/// side). produces the documents of the collection whose build attribute
+/// is equal to the probe value
+class HashJoinNode final : public JoinNode {
+  friend class ExecutionBlock;
+  friend class HashJoinBlock;
+
+ public:
+  HashJoinNode(ExecutionPlan* plan, size_t id,
+               aql::Collection const* collection, Variable const* outVariable,
+               std::vector<std::string> const& buildAttributes,
+               Variable const* probeVariable,
+               std::vector<std::string> const& probeAttributes);
+
+  HashJoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return HASH_JOIN; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+  ) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief the cost of a hash join node is the cost of reading the
+  /// collection once, plus one lookup per incoming item
+  CostEstimate estimateCost() const override final;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
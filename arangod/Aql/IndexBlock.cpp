@@ -78,9 +78,23 @@ IndexBlock::IndexBlock(ExecutionEngine* engine, IndexNode const* en)
       _hasMultipleExpansions(false),
       _returned(0),
       _copyFromRow(0),
-      _resultInFlight(nullptr) {
+      _resultInFlight(nullptr),
+      _documentIdRegister(ExecutionNode::MaxRegisterId) {
   _mmdr.reset(new ManagedDocumentResult);
 
+  if (ServerState::instance()->isRunningInCluster() && _collection->isSatellite()) {
+    // index lookups in a satellite collection read the local copy of its shard
+    _collection->waitForSatelliteSync(
+        _engine->getQuery()->queryOptions().satelliteSyncWait);
+  }
+
+  if (en->outDocumentIdVariable() != nullptr) {
+    auto it = en->getRegisterPlan()->varInfo.find(en->outDocumentIdVariable()->id);
+    TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
+    _documentIdRegister = it->second.registerId;
+    TRI_ASSERT(_documentIdRegister < ExecutionNode::MaxRegisterId);
+  }
+
   TRI_ASSERT(!_indexes.empty());
 
   if (_condition != nullptr) {
@@ -625,12 +639,20 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> IndexBlock::getSome(
         }
       }
 
+      if (_documentIdRegister != ExecutionNode::MaxRegisterId) {
+        _resultInFlight->emplaceValue(_returned, _documentIdRegister,
+                                      AqlValueHintUInt(token.id()));
+      }
       _documentProducer(_resultInFlight.get(), slice, nrInRegs, _returned, _copyFromRow);
     };
   } else {
     // No uniqueness checks
-    callback = [this, nrInRegs](LocalDocumentId const&, VPackSlice slice) {
+    callback = [this, nrInRegs](LocalDocumentId const& token, VPackSlice slice) {
       TRI_ASSERT(_resultInFlight != nullptr);
+      if (_documentIdRegister != ExecutionNode::MaxRegisterId) {
+        _resultInFlight->emplaceValue(_returned, _documentIdRegister,
+                                      AqlValueHintUInt(token.id()));
+      }
       _documentProducer(_resultInFlight.get(), slice, nrInRegs, _returned, _copyFromRow);
     };
   }
@@ -642,7 +664,7 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> IndexBlock::getSome(
         break;
       }
 
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       ExecutionState state;
       bool blockAppended;
       std::tie(state, blockAppended) = ExecutionBlock::getBlock(toFetch);
@@ -672,7 +694,7 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> IndexBlock::getSome(
         ExecutionState state;
         bool blockAppended;
         std::tie(state, blockAppended) =
-            ExecutionBlock::getBlock(DefaultBatchSize());
+            ExecutionBlock::getBlock(batchSize());
         if (state == ExecutionState::WAITING) {
           TRI_ASSERT(!blockAppended);
           traceGetSomeEnd(_resultInFlight.get(), ExecutionState::WAITING);
@@ -755,7 +777,7 @@ std::pair<ExecutionState, size_t> IndexBlock::skipSome(size_t atMost) {
 
   while (_returned < atMost) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       ExecutionState state;
       bool blockAppended;
       std::tie(state, blockAppended) = ExecutionBlock::getBlock(toFetch);
@@ -781,7 +803,7 @@ std::pair<ExecutionState, size_t> IndexBlock::skipSome(size_t atMost) {
       if (_buffer.empty()) {
         ExecutionState state;
         bool blockAppended;
-        std::tie(state, blockAppended) = ExecutionBlock::getBlock(DefaultBatchSize());
+        std::tie(state, blockAppended) = ExecutionBlock::getBlock(batchSize());
         if (state == ExecutionState::WAITING) {
           TRI_ASSERT(!blockAppended);
           traceSkipSomeEnd(0, ExecutionState::WAITING);
@@ -167,6 +167,10 @@ class IndexBlock final : public ExecutionBlock, public DocumentProducingBlock {
   /// @brief Capture of all results that are produced before the last WAITING call.
   ///        Needs to be nullptr after it got returned.
   std::unique_ptr<AqlItemBlock> _resultInFlight;
+
+  /// @brief register for the ids of the produced documents, MaxRegisterId
+  /// if the ids are not needed
+  RegisterId _documentIdRegister;
 };
 
 }  // namespace aql
@@ -50,7 +50,8 @@ IndexNode::IndexNode(ExecutionPlan* plan, size_t id,
         _indexes(indexes),
         _condition(std::move(condition)),
         _needsGatherNodeSort(false),
-        _options(opts) {
+        _options(opts),
+        _outDocumentIdVariable(nullptr) {
   TRI_ASSERT(_condition != nullptr);
 
   initIndexCoversProjections();
@@ -63,7 +64,8 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& bas
       CollectionAccessingNode(plan, base),
       _indexes(),
       _needsGatherNodeSort(basics::VelocyPackHelper::readBooleanValue(base, "needsGatherNodeSort", false)),
-      _options() {
+      _options(),
+      _outDocumentIdVariable(Variable::varFromVPack(plan->getAst(), base, "outDocumentIdVariable", true)) {
 
   _options.sorted = basics::VelocyPackHelper::readBooleanValue(base, "sorted", true);
   _options.ascending = basics::VelocyPackHelper::readBooleanValue(base, "ascending", false);
@@ -194,6 +196,11 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& builder, unsigned flags) const
   builder.add("fullRange", VPackValue(_options.fullRange));
   builder.add("limit", VPackValue(_options.limit));
 
+  if (_outDocumentIdVariable != nullptr) {
+    builder.add(VPackValue("outDocumentIdVariable"));
+    _outDocumentIdVariable->toVelocyPack(builder);
+  }
+
   // And close it:
   builder.close();
 }
@@ -209,15 +216,21 @@ std::unique_ptr<ExecutionBlock> IndexNode::createBlock(
 ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
                                 bool withProperties) const {
   auto outVariable = _outVariable;
+  auto outDocumentIdVariable = _outDocumentIdVariable;
 
   if (withProperties) {
     outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    if (outDocumentIdVariable != nullptr) {
+      outDocumentIdVariable =
+          plan->getAst()->variables()->createVariable(outDocumentIdVariable);
+    }
   }
 
   auto c = std::make_unique<IndexNode>(plan, _id,  _collection, outVariable,
                          _indexes, std::unique_ptr<Condition>(_condition->clone()), _options);
 
   c->projections(_projections);
+  c->outDocumentIdVariable(outDocumentIdVariable);
   c->needsGatherNodeSort(_needsGatherNodeSort);
   c->initIndexCoversProjections();
 
@@ -97,9 +97,22 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
 
   /// @brief getVariablesSetHere
   std::vector<Variable const*> getVariablesSetHere() const override final {
+    if (_outDocumentIdVariable != nullptr) {
+      return std::vector<Variable const*>{_outVariable, _outDocumentIdVariable};
+    }
     return std::vector<Variable const*>{_outVariable};
   }
 
+  /// @brief return the variable for the ids of the produced documents, or a
+  /// nullptr if the ids are not needed
+  Variable const* outDocumentIdVariable() const { return _outDocumentIdVariable; }
+
+  /// @brief set the variable for the ids of the produced documents. these
+  /// are used to materialize the full documents later on
+  void outDocumentIdVariable(Variable const* variable) {
+    _outDocumentIdVariable = variable;
+  }
+
   /// @brief getVariablesUsedHere, returning a vector
   std::vector<Variable const*> getVariablesUsedHere() const override final;
 
@@ -129,6 +142,9 @@ class IndexNode : public ExecutionNode, public DocumentProducingNode, public Col
 
   /// @brief the index iterator options - same for all indexes
   IndexIteratorOptions _options;
+
+  /// @brief output variable for the ids of the produced documents (optional)
+  Variable const* _outDocumentIdVariable;
 };
 
 }  // namespace arangodb::aql
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "JoinNode.h"
+#include "Aql/Ast.h"
+#include "Aql/ExecutionPlan.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+std::vector<std::string> attributesFromVPack(VPackSlice const& base,
+                                             char const* name) {
+  std::vector<std::string> result;
+  VPackSlice attributes = base.get(name);
+  if (attributes.isArray()) {
+    for (auto const& it : VPackArrayIterator(attributes)) {
+      result.emplace_back(it.copyString());
+    }
+  }
+  return result;
+}
+
+void attributesToVPack(VPackBuilder& builder, char const* name,
+                       std::vector<std::string> const& attributes) {
+  builder.add(VPackValue(name));
+  builder.openArray();
+  for (auto const& it : attributes) {
+    builder.add(VPackValue(it));
+  }
+  builder.close();
+}
+
+} // namespace
+
+JoinNode::JoinNode(ExecutionPlan* plan, size_t id,
+                   aql::Collection const* collection,
+                   Variable const* outVariable,
+                   std::vector<std::string> const& buildAttributes,
+                   Variable const* probeVariable,
+                   std::vector<std::string> const& probeAttributes)
+    : ExecutionNode(plan, id),
+      CollectionAccessingNode(collection),
+      _outVariable(outVariable),
+      _buildAttributes(buildAttributes),
+      _probeVariable(probeVariable),
+      _probeAttributes(probeAttributes) {
+  TRI_ASSERT(_outVariable != nullptr);
+  TRI_ASSERT(_probeVariable != nullptr);
+  TRI_ASSERT(!_buildAttributes.empty());
+}
+
+JoinNode::JoinNode(ExecutionPlan* plan,
+                   arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      CollectionAccessingNode(plan, base),
+      _outVariable(Variable::varFromVPack(plan->getAst(), base, "outVariable")),
+      _buildAttributes(::attributesFromVPack(base, "buildAttributes")),
+      _probeVariable(Variable::varFromVPack(plan->getAst(), base, "probeVariable")),
+      _probeAttributes(::attributesFromVPack(base, "probeAttributes")) {}
+
+/// @brief export the join attributes and the collection to VelocyPack
+void JoinNode::toVelocyPackHelperJoin(VPackBuilder& builder) const {
+  builder.add(VPackValue("outVariable"));
+  _outVariable->toVelocyPack(builder);
+  ::attributesToVPack(builder, "buildAttributes", _buildAttributes);
+
+  builder.add(VPackValue("probeVariable"));
+  _probeVariable->toVelocyPack(builder);
+  ::attributesToVPack(builder, "probeAttributes", _probeAttributes);
+
+  // add collection information
+  CollectionAccessingNode::toVelocyPack(builder);
+}
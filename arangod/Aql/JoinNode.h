@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_JOIN_NODE_H
+#define ARANGOD_AQL_JOIN_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/CollectionAccessingNode.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/Variable.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionPlan;
+
+/// @brief base class for nodes that replace the inner FOR loop of an
+/// equi-join `FOR a IN ... FOR b IN collection FILTER a.x == b.y`. for each
+/// incoming row, such a node produces the documents of the collection whose
+/// build attribute (b.y) is equal to the probe value (a.x)
+class JoinNode : public ExecutionNode, public CollectionAccessingNode {
+ public:
+  JoinNode(ExecutionPlan* plan, size_t id, aql::Collection const* collection,
+           Variable const* outVariable,
+           std::vector<std::string> const& buildAttributes,
+           Variable const* probeVariable,
+           std::vector<std::string> const& probeAttributes);
+
+  JoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base);
+
+  /// @brief getVariablesUsedHere, returning a vector
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    return std::vector<Variable const*>{_probeVariable};
+  }
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& vars) const override final {
+    vars.emplace(_probeVariable);
+  }
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  /// @brief return out variable
+  Variable const* outVariable() const { return _outVariable; }
+
+  /// @brief return the attribute path of the build side
+  std::vector<std::string> const& buildAttributes() const {
+    return _buildAttributes;
+  }
+
+  /// @brief return the variable of the probe side
+  Variable const* probeVariable() const { return _probeVariable; }
+
+  /// @brief return the attribute path of the probe side. may be empty, in
+  /// which case the value of the probe variable itself is used
+  std::vector<std::string> const& probeAttributes() const {
+    return _probeAttributes;
+  }
+
+ protected:
+  /// @brief export the join attributes and the collection to VelocyPack
+  void toVelocyPackHelperJoin(arangodb::velocypack::Builder&) const;
+
+ protected:
+  /// @brief output variable, containing the documents of the collection
+  Variable const* _outVariable;
+
+  /// @brief attribute path (in the collection's documents) of the build side
+  std::vector<std::string> const _buildAttributes;
+
+  /// @brief variable of the probe side
+  Variable const* _probeVariable;
+
+  /// @brief attribute path (in _probeVariable) of the probe side
+  std::vector<std::string> const _probeAttributes;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "MaterializeBlock.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionEngine.h"
+#include "Basics/Exceptions.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MaterializeBlock::MaterializeBlock(ExecutionEngine* engine,
+                                   MaterializeNode const* en)
+    : ExecutionBlock(engine, en),
+      _collection(en->collection()),
+      _inRegister(ExecutionNode::MaxRegisterId),
+      _outRegister(ExecutionNode::MaxRegisterId) {
+  auto it = en->getRegisterPlan()->varInfo.find(en->inDocumentIdVariable()->id);
+  TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
+  _inRegister = it->second.registerId;
+  TRI_ASSERT(_inRegister < ExecutionNode::MaxRegisterId);
+
+  it = en->getRegisterPlan()->varInfo.find(en->outVariable()->id);
+  TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
+  _outRegister = it->second.registerId;
+  TRI_ASSERT(_outRegister < ExecutionNode::MaxRegisterId);
+}
+
+/// @brief looks up the documents for all rows of the block
+void MaterializeBlock::materialize(AqlItemBlock* result) {
+  auto collection = _collection->getCollection();
+  size_t const n = result->size();
+
+  size_t row = 0;
+  auto callback = [&](LocalDocumentId const&, VPackSlice doc) {
+    result->emplaceValue(row, _outRegister, AqlValueHintCopy(doc.begin()));
+  };
+
+  for (; row < n; ++row) {
+    AqlValue const& id = result->getValueReference(row, _inRegister);
+    TRI_ASSERT(id.isNumber());
+
+    if (!collection->readDocumentWithCallback(
+            _trx, LocalDocumentId(id.slice().getUInt()), callback)) {
+      // the document was read by the index in the same transaction, so it
+      // must still be there
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
+    }
+  }
+
+  throwIfKilled();  // check if we were aborted
+}
+
+std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>>
+MaterializeBlock::getSome(size_t atMost) {
+  traceGetSomeBegin(atMost);
+
+  if (_done) {
+    return {ExecutionState::DONE, nullptr};
+  }
+
+  auto res = ExecutionBlock::getSomeWithoutRegisterClearout(atMost);
+  if (res.first == ExecutionState::WAITING) {
+    traceGetSomeEnd(nullptr, ExecutionState::WAITING);
+    return res;
+  }
+  if (res.second == nullptr) {
+    TRI_ASSERT(res.first == ExecutionState::DONE);
+    traceGetSomeEnd(nullptr, res.first);
+    return res;
+  }
+
+  materialize(res.second.get());
+  // Clear out registers no longer needed later:
+  clearRegisters(res.second.get());
+  traceGetSomeEnd(res.second.get(), res.first);
+  return res;
+}
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_AQL_MATERIALIZE_BLOCK_H
+#define ARANGOD_AQL_MATERIALIZE_BLOCK_H 1
+
+#include "Aql/ExecutionBlock.h"
+#include "Aql/MaterializeNode.h"
+
+namespace arangodb {
+namespace aql {
+class AqlItemBlock;
+struct Collection;
+class ExecutionEngine;
+
+class MaterializeBlock final : public ExecutionBlock {
+ public:
+  MaterializeBlock(ExecutionEngine* engine, MaterializeNode const* en);
+
+  /// @brief getSome
+  std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> getSome(
+      size_t atMost) override final;
+
+ private:
+  /// @brief looks up the documents for all rows of the block
+  void materialize(AqlItemBlock*);
+
+ private:
+  /// @brief collection
+  Collection const* _collection;
+
+  /// @brief register of the document ids
+  RegisterId _inRegister;
+
+  /// @brief register of the documents
+  RegisterId _outRegister;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
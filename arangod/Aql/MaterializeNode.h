@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGOD_AQL_MATERIALIZE_NODE_H
+#define ARANGOD_AQL_MATERIALIZE_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/CollectionAccessingNode.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/Variable.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+
+/// @brief class MaterializeNode. looks up the full documents for the document
+/// ids produced by an IndexNode earlier in the plan. this allows FILTER, SORT
+/// and LIMIT to work on the attributes covered by the index only, and to read
+/// the full documents only for the rows that remain afterwards
+class MaterializeNode final : public ExecutionNode, public CollectionAccessingNode {
+  friend class ExecutionBlock;
+  friend class MaterializeBlock;
+
+ public:
+  MaterializeNode(ExecutionPlan* plan, size_t id,
+                  aql::Collection const* collection,
+                  Variable const* inDocumentIdVariable,
+                  Variable const* outVariable);
+
+  MaterializeNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return MATERIALIZE; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+  ) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief the cost of a materialize node is the cost of its dependency,
+  /// plus one document lookup per incoming item
+  CostEstimate estimateCost() const override final;
+
+  /// @brief getVariablesUsedHere, returning a vector
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    return std::vector<Variable const*>{_inDocumentIdVariable};
+  }
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& vars) const override final {
+    vars.emplace(_inDocumentIdVariable);
+  }
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  /// @brief return the variable containing the document ids
+  Variable const* inDocumentIdVariable() const { return _inDocumentIdVariable; }
+
+  /// @brief return out variable, containing the full documents
+  Variable const* outVariable() const { return _outVariable; }
+
+ private:
+  /// @brief input variable, containing the document ids
+  Variable const* _inDocumentIdVariable;
+
+  /// @brief output variable, containing the full documents
+  Variable const* _outVariable;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,370 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MergeJoinBlock.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ExecutionEngine.h"
+#include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
+#include "Utils/OperationCursor.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+/// @brief compares join values. the index is sorted using UTF-8 comparison,
+/// and the index lookups replaced by the merge join find the documents with
+/// an equal value under this comparison. so it is used for splitting the
+/// runs, for advancing the scan and for matching alike
+int compareKeys(VPackSlice lhs, VPackSlice rhs, VPackOptions const* options) {
+  return basics::VelocyPackHelper::compare(lhs, rhs, true, options);
+}
+}  // namespace
+
+MergeJoinBlock::MergeJoinBlock(ExecutionEngine* engine,
+                               MergeJoinNode const* en)
+    : ExecutionBlock(engine, en),
+      _probeRegister(ExecutionNode::MaxRegisterId),
+      _mmdr(new ManagedDocumentResult),
+      _batchPos(0),
+      _hasRun(false),
+      _lookedUp(false),
+      _current(0),
+      _inflight(0) {
+  auto it = en->getRegisterPlan()->varInfo.find(en->probeVariable()->id);
+
+  if (it == en->getRegisterPlan()->varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+  }
+
+  _probeRegister = (*it).second.registerId;
+  TRI_ASSERT(_probeRegister < ExecutionNode::MaxRegisterId);
+}
+
+MergeJoinBlock::~MergeJoinBlock() {}
+
+std::pair<ExecutionState, arangodb::Result> MergeJoinBlock::initializeCursor(
+    AqlItemBlock* items, size_t pos) {
+  auto res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res.first == ExecutionState::WAITING ||
+      !res.second.ok()) {
+    // If we need to wait or get an error we return as is.
+    return res;
+  }
+
+  // the position of the index scan is kept. if the new input starts with a
+  // lower probe value, lookup() will restart the scan
+  _lookedUp = false;
+  _matches.clear();
+  _current = 0;
+  _inflight = 0;
+
+  return res;
+}
+
+uint8_t const* MergeJoinBlock::peekDocument() {
+  while (_batchPos >= _batchStarts.size()) {
+    if (_cursor == nullptr) {
+      auto en = ExecutionNode::castTo<MergeJoinNode const*>(getPlanNode());
+
+      // a full scan of the index, in ascending order
+      IndexIteratorOptions options;
+      options.sorted = true;
+      options.ascending = true;
+
+      _cursor.reset(_trx->indexScanForCondition(
+          en->index(), nullptr, en->outVariable(), _mmdr.get(), options));
+
+      if (_cursor->fail()) {
+        THROW_ARANGO_EXCEPTION(_cursor->code);
+      }
+    }
+
+    if (!_cursor->hasMore()) {
+      return nullptr;
+    }
+
+    _batch.clear();
+    _batchStarts.clear();
+    _batchPos = 0;
+
+    _batch.openArray();
+    _cursor->nextDocument([this](LocalDocumentId const&, VPackSlice doc) {
+      _batch.add(doc);
+    }, batchSize());
+    _batch.close();
+
+    for (auto const& it : VPackArrayIterator(_batch.slice())) {
+      _batchStarts.emplace_back(it.begin());
+    }
+
+    _engine->_stats.scannedIndex += static_cast<int64_t>(_batchStarts.size());
+
+    throwIfKilled();  // check if we were aborted
+  }
+
+  return _batchStarts[_batchPos];
+}
+
+bool MergeJoinBlock::nextRun() {
+  _hasRun = false;
+  _run.clear();
+  _runKeys.clear();
+  _runStarts.clear();
+
+  auto en = ExecutionNode::castTo<MergeJoinNode const*>(getPlanNode());
+  auto options = _trx->transactionContextPtr()->getVPackOptions();
+
+  // the build value of the first document of the run
+  VPackBuilder runKey;
+
+  _run.openArray();
+  _runKeys.openArray();
+
+  uint8_t const* doc;
+  while ((doc = peekDocument()) != nullptr) {
+    AqlValue document{AqlValueHintDocumentNoCopy(doc)};
+    bool mustDestroy;
+    AqlValue key =
+        document.get(_trx, en->buildAttributes(), mustDestroy, false);
+    AqlValueGuard guard(key, mustDestroy);
+    AqlValueMaterializer materializer(_trx);
+    VPackSlice keySlice = materializer.slice(key, false);
+
+    if (runKey.isEmpty()) {
+      runKey.add(keySlice);
+    } else if (::compareKeys(keySlice, runKey.slice(), options) != 0) {
+      // start of the next run
+      break;
+    }
+
+    _run.add(VPackSlice(doc));
+    _runKeys.add(keySlice);
+    ++_batchPos;
+  }
+
+  _run.close();
+  _runKeys.close();
+
+  if (runKey.isEmpty()) {
+    // index scan is exhausted
+    return false;
+  }
+
+  VPackArrayIterator keys(_runKeys.slice());
+  for (auto const& it : VPackArrayIterator(_run.slice())) {
+    _runStarts.emplace_back(it.begin(), keys.value().begin());
+    keys.next();
+  }
+
+  _hasRun = true;
+  return true;
+}
+
+void MergeJoinBlock::resetScan() {
+  if (_cursor != nullptr) {
+    _cursor->reset();
+  }
+
+  _batch.clear();
+  _batchStarts.clear();
+  _batchPos = 0;
+  _hasRun = false;
+  _run.clear();
+  _runKeys.clear();
+  _runStarts.clear();
+}
+
+void MergeJoinBlock::lookup(AqlItemBlock const* cur) {
+  if (_lookedUp) {
+    return;
+  }
+
+  auto en = ExecutionNode::castTo<MergeJoinNode const*>(getPlanNode());
+  auto options = _trx->transactionContextPtr()->getVPackOptions();
+  AqlValue const& probe = cur->getValueReference(_pos, _probeRegister);
+
+  AqlValueMaterializer materializer(_trx);
+  VPackSlice probeSlice;
+  bool mustDestroy = false;
+  AqlValue key;
+  if (en->probeAttributes().empty()) {
+    probeSlice = materializer.slice(probe, false);
+  } else {
+    key = probe.get(_trx, en->probeAttributes(), mustDestroy, false);
+    probeSlice = materializer.slice(key, false);
+  }
+  AqlValueGuard guard(key, mustDestroy);
+
+  if (!_lastProbe.isEmpty() &&
+      ::compareKeys(probeSlice, _lastProbe.slice(), options) < 0) {
+    // input is not sorted by the probe value. this cannot happen for plans
+    // created by the optimizer, but we must not produce wrong results
+    resetScan();
+  }
+  _lastProbe.clear();
+  _lastProbe.add(probeSlice);
+
+  // advance to the first run with a build value not lower than the probe
+  // value
+  while (!_hasRun ||
+         ::compareKeys(VPackSlice(_runStarts[0].second), probeSlice,
+                       options) < 0) {
+    if (!nextRun()) {
+      break;
+    }
+  }
+
+  _matches.clear();
+  if (_hasRun &&
+      ::compareKeys(VPackSlice(_runStarts[0].second), probeSlice, options) == 0) {
+    // all documents of the run have an equal build value
+    for (size_t i = 0; i < _runStarts.size(); ++i) {
+      _matches.emplace_back(i);
+    }
+  }
+
+  _current = 0;
+  _lookedUp = true;
+}
+
+std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>>
+MergeJoinBlock::getSome(size_t atMost) {
+  traceGetSomeBegin(atMost);
+  if (_done) {
+    TRI_ASSERT(getHasMoreState() == ExecutionState::DONE);
+    traceGetSomeEnd(nullptr, ExecutionState::DONE);
+    return {ExecutionState::DONE, nullptr};
+  }
+
+  std::unique_ptr<AqlItemBlock> res;
+
+  while (res == nullptr) {
+    // repeatedly try to get more stuff from upstream
+    // note that an input row may not find any matching document,
+    // in which case we have to try again!
+
+    size_t toFetch = (std::min)(batchSize(), atMost);
+    BufferState bufferState = getBlockIfNeeded(toFetch);
+    if (bufferState == BufferState::WAITING) {
+      TRI_ASSERT(res == nullptr);
+      traceGetSomeEnd(nullptr, ExecutionState::WAITING);
+      return {ExecutionState::WAITING, nullptr};
+    }
+    if (bufferState == BufferState::NO_MORE_BLOCKS) {
+      break;
+    }
+
+    TRI_ASSERT(bufferState == BufferState::HAS_BLOCKS ||
+               bufferState == BufferState::HAS_NEW_BLOCK);
+    TRI_ASSERT(!_buffer.empty());
+
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    lookup(cur);
+
+    if (_current < _matches.size()) {
+      size_t toSend = (std::min)(atMost, _matches.size() - _current);
+
+      // create the result
+      res.reset(requestBlock(toSend, getNrOutputRegisters()));
+
+      inheritRegisters(cur, res.get(), _pos);
+
+      for (size_t j = 0; j < toSend; j++) {
+        // the run is overwritten when advancing the scan, so the
+        // documents must be copied
+        res->emplaceValue(j, cur->getNrRegs(),
+                          AqlValueHintCopy(_runStarts[_matches[_current]].first));
+
+        if (j > 0) {
+          // re-use already copied AqlValues
+          res->copyValuesFromFirstRow(j, cur->getNrRegs());
+        }
+        ++_current;
+      }
+    }
+
+    if (_current >= _matches.size()) {
+      _lookedUp = false;
+
+      AqlItemBlock* removedBlock = advanceCursor(1, 0);
+      returnBlockUnlessNull(removedBlock);
+    }
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+  traceGetSomeEnd(res.get(), getHasMoreState());
+  return {getHasMoreState(), std::move(res)};
+}
+
+std::pair<ExecutionState, size_t> MergeJoinBlock::skipSome(size_t atMost) {
+  traceSkipSomeBegin(atMost);
+  if (_done) {
+    size_t skipped = _inflight;
+    _inflight = 0;
+    traceSkipSomeEnd(skipped, ExecutionState::DONE);
+    return {ExecutionState::DONE, skipped};
+  }
+
+  while (_inflight < atMost) {
+    size_t toFetch = (std::min)(batchSize(), atMost - _inflight);
+    BufferState bufferState = getBlockIfNeeded(toFetch);
+    if (bufferState == BufferState::WAITING) {
+      traceSkipSomeEnd(0, ExecutionState::WAITING);
+      return {ExecutionState::WAITING, 0};
+    }
+    if (bufferState == BufferState::NO_MORE_BLOCKS) {
+      break;
+    }
+
+    TRI_ASSERT(!_buffer.empty());
+
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    lookup(cur);
+
+    size_t toSkip = (std::min)(atMost - _inflight, _matches.size() - _current);
+    _current += toSkip;
+    _inflight += toSkip;
+
+    if (_current >= _matches.size()) {
+      _lookedUp = false;
+
+      AqlItemBlock* removedBlock = advanceCursor(1, 0);
+      returnBlockUnlessNull(removedBlock);
+    }
+  }
+
+  size_t skipped = _inflight;
+  _inflight = 0;
+  ExecutionState state = getHasMoreState();
+  traceSkipSomeEnd(skipped, state);
+  return {state, skipped};
+}
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MERGE_JOIN_BLOCK_H
+#define ARANGOD_AQL_MERGE_JOIN_BLOCK_H 1
+
+#include "Aql/ExecutionBlock.h"
+#include "Aql/MergeJoinNode.h"
+
+#include <velocypack/Builder.h>
+
+namespace arangodb {
+class ManagedDocumentResult;
+class OperationCursor;
+
+namespace aql {
+class AqlItemBlock;
+class ExecutionEngine;
+
+class MergeJoinBlock final : public ExecutionBlock {
+ public:
+  MergeJoinBlock(ExecutionEngine* engine, MergeJoinNode const* en);
+  ~MergeJoinBlock();
+
+  std::pair<ExecutionState, Result> initializeCursor(AqlItemBlock* items,
+                                                     size_t pos) override;
+
+  std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> getSome(
+      size_t atMost) override final;
+
+  // skip atMost documents, returns the number actually skipped . . .
+  std::pair<ExecutionState, size_t> skipSome(size_t atMost) override final;
+
+ private:
+  /// @brief returns the next document of the index scan without consuming
+  /// it, or a nullptr if the scan is exhausted
+  uint8_t const* peekDocument();
+
+  /// @brief reads the next run of documents with equal build values from
+  /// the index scan. returns false if the scan is exhausted
+  bool nextRun();
+
+  /// @brief restarts the index scan from the beginning
+  void resetScan();
+
+  /// @brief determines the matching documents for the current input row
+  /// if this has not been done yet
+  void lookup(AqlItemBlock const* cur);
+
+ private:
+  /// @brief register of the probe variable
+  RegisterId _probeRegister;
+
+  /// @brief document result for the index scan
+  std::unique_ptr<ManagedDocumentResult> _mmdr;
+
+  /// @brief the index scan, in ascending order of the build attribute
+  std::unique_ptr<OperationCursor> _cursor;
+
+  /// @brief documents read from the index scan but not consumed yet
+  arangodb::velocypack::Builder _batch;
+
+  /// @brief start of each document in _batch
+  std::vector<uint8_t const*> _batchStarts;
+
+  /// @brief next unconsumed document in _batchStarts
+  size_t _batchPos;
+
+  /// @brief whether or not _run contains a run of documents
+  bool _hasRun;
+
+  /// @brief the current run of documents with equal build values. these
+  /// are kept so duplicate probe values can be joined without rescanning
+  arangodb::velocypack::Builder _run;
+
+  /// @brief the build values of the documents in _run
+  arangodb::velocypack::Builder _runKeys;
+
+  /// @brief start of each document and its build value in _run / _runKeys
+  std::vector<std::pair<uint8_t const*, uint8_t const*>> _runStarts;
+
+  /// @brief the previous probe value. if a probe value is lower than this,
+  /// the input is not sorted and the index scan must be restarted
+  arangodb::velocypack::Builder _lastProbe;
+
+  /// @brief whether or not _matches belongs to the current input row
+  bool _lookedUp;
+
+  /// @brief positions in _runStarts of the documents matching the current
+  /// input row
+  std::vector<size_t> _matches;
+
+  /// @brief next position in _matches to produce for the current input row
+  size_t _current;
+
+  /// @brief number of skipped rows in the moment we hit WAITING
+  size_t _inflight;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MergeJoinNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/MergeJoinBlock.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+#include "Indexes/Index.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+MergeJoinNode::MergeJoinNode(ExecutionPlan* plan, size_t id,
+                             aql::Collection const* collection,
+                             transaction::Methods::IndexHandle const& index,
+                             Variable const* outVariable,
+                             std::vector<std::string> const& buildAttributes,
+                             Variable const* probeVariable,
+                             std::vector<std::string> const& probeAttributes)
+    : JoinNode(plan, id, collection, outVariable, buildAttributes,
+               probeVariable, probeAttributes),
+      _index(index) {}
+
+MergeJoinNode::MergeJoinNode(ExecutionPlan* plan,
+                             arangodb::velocypack::Slice const& base)
+    : JoinNode(plan, base) {
+  VPackSlice index = base.get("index");
+
+  if (!index.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, "\"index\" attribute should be an object");
+  }
+
+  auto trx = plan->getAst()->query()->trx();
+  _index = trx->getIndexByIdentifier(_collection->name(),
+                                     index.get("id").copyString());
+}
+
+/// @brief toVelocyPack, for MergeJoinNode
+void MergeJoinNode::toVelocyPackHelper(VPackBuilder& builder,
+                                       unsigned flags) const {
+  // call base class method
+  ExecutionNode::toVelocyPackHelperGeneric(builder, flags);
+
+  // add join attributes and collection information
+  toVelocyPackHelperJoin(builder);
+
+  builder.add(VPackValue("index"));
+  _index.toVelocyPack(builder, Index::makeFlags(Index::Serialize::Estimates));
+
+  // And close it:
+  builder.close();
+}
+
+/// @brief creates corresponding ExecutionBlock
+std::unique_ptr<ExecutionBlock> MergeJoinNode::createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+) const {
+  return std::make_unique<MergeJoinBlock>(&engine, this);
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* MergeJoinNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                    bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto probeVariable = _probeVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    probeVariable = plan->getAst()->variables()->createVariable(probeVariable);
+  }
+
+  auto c = std::make_unique<MergeJoinNode>(plan, _id, _collection, _index,
+                                           outVariable, _buildAttributes,
+                                           probeVariable, _probeAttributes);
+
+  return cloneHelper(std::move(c), withDependencies, withProperties);
+}
+
+/// @brief the cost of a merge join node is the cost of scanning the index
+/// once, plus one comparison per incoming item
+CostEstimate MergeJoinNode::estimateCost() const {
+  transaction::Methods* trx = _plan->getAst()->query()->trx();
+  if (trx->status() != transaction::Status::RUNNING) {
+    return CostEstimate::empty();
+  }
+
+  TRI_ASSERT(!_dependencies.empty());
+  CostEstimate estimate = _dependencies.at(0)->getCost();
+  // we assume that each incoming item finds one document
+  estimate.estimatedCost +=
+      static_cast<double>(_collection->count(trx)) + estimate.estimatedNrItems;
+  return estimate;
+}
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MERGE_JOIN_NODE_H
+#define ARANGOD_AQL_MERGE_JOIN_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/JoinNode.h"
+#include "Transaction/Methods.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionEngine;
+class ExecutionPlan;
+
+/// @brief class MergeJoinNode. replaces the inner index lookup of an
+/// equi-join `FOR a IN ... FOR b IN collection FILTER a.x == b.y` if the
+/// outer rows arrive sorted by a.x and there is a sorted index on b.y. the
+/// index is then scanned only once, in lockstep with the outer rows, instead
+/// of being looked up once per outer row. produces the documents of the
+/// collection whose build attribute (b.y) is equal to the probe value (a.x)
+class MergeJoinNode final : public JoinNode {
+  friend class ExecutionBlock;
+  friend class MergeJoinBlock;
+
+ public:
+  MergeJoinNode(ExecutionPlan* plan, size_t id,
+                aql::Collection const* collection,
+                transaction::Methods::IndexHandle const& index,
+                Variable const* outVariable,
+                std::vector<std::string> const& buildAttributes,
+                Variable const* probeVariable,
+                std::vector<std::string> const& probeAttributes);
+
+  MergeJoinNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return MERGE_JOIN; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          unsigned flags) const override final;
+
+  /// @brief creates corresponding ExecutionBlock
+  std::unique_ptr<ExecutionBlock> createBlock(
+    ExecutionEngine& engine,
+    std::unordered_map<ExecutionNode*, ExecutionBlock*> const&
+  ) const override;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief the cost of a merge join node is the cost of scanning the index
+  /// once, plus one comparison per incoming item
+  CostEstimate estimateCost() const override final;
+
+  /// @brief return the sorted index on the build attribute
+  transaction::Methods::IndexHandle const& index() const { return _index; }
+
+ private:
+  /// @brief sorted index whose first field is the build attribute
+  transaction::Methods::IndexHandle _index;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
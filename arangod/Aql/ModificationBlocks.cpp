@@ -35,6 +35,7 @@
 
 #include <velocypack/Builder.h>
 #include <velocypack/Collection.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
@@ -936,13 +937,17 @@ std::unique_ptr<AqlItemBlock> UpsertBlock::work() {
             if (updateDoc.isObject()) {
               VPackSlice toUpdate = updateDoc.slice();
 
-              _tempBuilder.clear();
-              _tempBuilder.openObject();
-              _tempBuilder.add(StaticStrings::KeyString, VPackValue(key));
-              _tempBuilder.close();
-                
-              VPackBuilder tmp = VPackCollection::merge(toUpdate, _tempBuilder.slice(), false, false);
-              updateBuilder.add(tmp.slice());
+              // write the update document with the key of the old document
+              // straight into the batch, without an intermediate merge
+              updateBuilder.openObject();
+              updateBuilder.add(StaticStrings::KeyString, VPackValue(key));
+              for (auto const& attr : VPackObjectIterator(toUpdate, true)) {
+                if (!attr.key.isEqualString(StaticStrings::KeyString)) {
+                  updateBuilder.add(attr.key);
+                  updateBuilder.add(attr.value);
+                }
+              }
+              updateBuilder.close();
               _operations.push_back(APPLY_UPDATE);
             } else {
               errorCode = TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID;
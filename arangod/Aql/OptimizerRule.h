@@ -149,6 +149,16 @@ struct OptimizerRule {
     // replace FULLTEXT with index
     applyFulltextIndexRule,
 
+    // answer COUNT over a whole collection from the collection counter
+    useCollectionCountRule,
+
+    // turn MIN/MAX over an indexed attribute into SORT + LIMIT 1, so that
+    // the index rules can make it a single index seek
+    useIndexForMinMaxRule,
+
+    // continue a sorted query after the position of a continuation token
+    keysetPaginationRule,
+
     useIndexesRule,
 
     // try to remove filters covered by index ranges
@@ -227,12 +237,10 @@ struct OptimizerRule {
     // only a SingletonNode and possibly some CalculationNodes as dependencies
     removeUnnecessaryRemoteScatterRule,
 
-#ifdef USE_ENTERPRISE
     // remove any superflous satellite collection joins...
     // put it after Scatter rule because we would do
     // the work twice otherwise
     removeSatelliteJoinsRule,
-#endif
 
     // recognize that a RemoveNode can be moved to the shards
     undistributeRemoveAfterEnumCollRule,
@@ -240,9 +248,45 @@ struct OptimizerRule {
     // push collect operations to the db servers
     collectInClusterRule,
 
+    // let each shard produce at most offset + limit rows for a LIMIT
+    // on top of a GATHER
+    distributeLimitToClusterRule,
+
     // try to restrict fragments to a single shard if possible
     restrictToSingleShardRule,
 
+    // make a SORT that is followed by a LIMIT only keep the first
+    // offset + limit rows in a heap
+    applySortLimitRule,
+
+    // replace the inner collection loop of an equi-join without a usable
+    // index by a hash join
+    hashJoinRule,
+
+    // send the input of a hash join on the DB servers only to the shard
+    // responsible for its join value
+    distributeHashJoinInClusterRule,
+
+    // replace the collection loop of a subquery that is correlated with the
+    // outer query via an equality by a hash join
+    decorrelateSubqueriesRule,
+
+    // replace the inner index lookup of an equi-join with sorted input by
+    // a merge join
+    mergeJoinRule,
+
+    // let FILTER, SORT and LIMIT on top of an index scan work on the
+    // attributes covered by the index, and read the full documents later
+    lateDocumentMaterializationRule,
+
+    // let subqueries that depend on the outer query reuse their results for
+    // repeated values of the outer variables
+    cacheSubqueryResultsRule,
+
+    // let consecutive independent subqueries send their requests to the
+    // DB servers at the same time
+    parallelizeSubqueriesRule,
+
     // simplify an EnumerationCollectionNode that fetches an
     // entire document to a projection of this document
     reduceExtractionToProjectionRule,
@@ -34,7 +34,10 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IndexNode.h"
+#include "Aql/MaterializeNode.h"
+#include "Aql/MergeJoinNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Query.h"
@@ -55,6 +58,8 @@
 #include "GeoIndex/Index.h"
 #include "Graph/TraverserOptions.h"
 #include "Indexes/Index.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
 #include "Transaction/Methods.h"
 #include "VocBase/Methods/Collections.h"
 
@@ -568,6 +573,16 @@ std::vector<arangodb::aql::ExecutionNode::NodeType> const
         arangodb::aql::ExecutionNode::UPDATE,
         arangodb::aql::ExecutionNode::REPLACE,
         arangodb::aql::ExecutionNode::UPSERT};
+std::vector<arangodb::aql::ExecutionNode::NodeType> const
+    sortLimitNodeTypes{arangodb::aql::ExecutionNode::SORT};
+std::vector<arangodb::aql::ExecutionNode::NodeType> const
+    aggregateFromIndexNodeTypes{arangodb::aql::ExecutionNode::COLLECT};
+std::vector<arangodb::aql::ExecutionNode::NodeType> const
+    hashJoinNodeTypes{arangodb::aql::ExecutionNode::ENUMERATE_COLLECTION};
+std::vector<arangodb::aql::ExecutionNode::NodeType> const
+    mergeJoinNodeTypes{arangodb::aql::ExecutionNode::INDEX};
+std::vector<arangodb::aql::ExecutionNode::NodeType> const
+    lateDocumentMaterializationNodeTypes{arangodb::aql::ExecutionNode::INDEX};
 std::vector<arangodb::aql::ExecutionNode::NodeType> const
     patchUpdateStatementsNodeTypes{arangodb::aql::ExecutionNode::UPDATE,
                                    arangodb::aql::ExecutionNode::REPLACE};
@@ -3537,9 +3552,7 @@ void arangodb::aql::optimizeClusterSingleShardRule(
     opt->disableRule(OptimizerRule::distributeFilternCalcToClusterRule);
     opt->disableRule(OptimizerRule::distributeSortToClusterRule);
     opt->disableRule(OptimizerRule::removeUnnecessaryRemoteScatterRule);
-#ifdef USE_ENTERPRISE
     opt->disableRule(OptimizerRule::removeSatelliteJoinsRule);
-#endif
     opt->disableRule(OptimizerRule::undistributeRemoveAfterEnumCollRule);
 
     // get first collection from query
@@ -4376,12 +4389,12 @@ void arangodb::aql::collectInClusterRule(Optimizer* opt,
                 aggregateVariables;
             if (!collectNode->aggregateVariables().empty()) {
               for (auto const& it : collectNode->aggregateVariables()) {
-                std::string func =
-                    Aggregator::pushToDBServerAs(it.second.second);
-                if (func.empty()) {
+                if (!Aggregator::isMergeable(it.second.second)) {
                   eligible = false;
                   break;
                 }
+                std::string func =
+                    Aggregator::pushToDBServerAs(it.second.second);
                 // eligible!
                 auto outVariable =
                     plan->getAst()->variables()->createTemporaryVariable();
@@ -4800,6 +4813,78 @@ void arangodb::aql::distributeSortToClusterRule(
   opt->addPlan(std::move(plan), rule, modified);
 }
 
+/// @brief copy a LIMIT that sits on top of a GATHER into the DB server
+/// snippets so that each shard produces at most offset + limit rows.
+/// the LIMIT on the coordinator is kept and applies offset and limit to the
+/// merged result. for a sorted GATHER, the DB server LIMIT ends up right
+/// after the SORT, which the sort-limit rule then turns into a per-shard top-k
+void arangodb::aql::distributeLimitToClusterRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::LIMIT, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto limitNode = ExecutionNode::castTo<LimitNode*>(n);
+    if (limitNode->fullCount()) {
+      // fullCount needs to see all rows
+      continue;
+    }
+
+    // only calculations may sit between the LIMIT and the GATHER, as they
+    // do not change the number of rows
+    auto current = n->getFirstDependency();
+    while (current != nullptr && current->getType() == EN::CALCULATION) {
+      current = current->getFirstDependency();
+    }
+
+    if (current == nullptr || current->getType() != EN::GATHER) {
+      continue;
+    }
+
+    auto remoteNode = current->getFirstDependency();
+    if (remoteNode == nullptr || remoteNode->getType() != EN::REMOTE) {
+      continue;
+    }
+    auto previous = remoteNode->getFirstDependency();
+    if (previous == nullptr || previous->getType() == EN::LIMIT) {
+      // nothing to do, or already limited on the DB servers
+      continue;
+    }
+
+    // rows that are cut off by the LIMIT must still be processed by any
+    // data-modification operation in the snippet
+    bool eligible = true;
+    current = previous;
+    while (current != nullptr && current->getType() != EN::REMOTE) {
+      if (current->isModificationNode() ||
+          (current->getType() == EN::SUBQUERY &&
+           ExecutionNode::castTo<SubqueryNode const*>(current)
+               ->isModificationSubquery())) {
+        eligible = false;
+        break;
+      }
+      current = current->getFirstDependency();
+    }
+
+    if (!eligible) {
+      continue;
+    }
+
+    auto dbLimitNode =
+        new LimitNode(plan.get(), plan->nextId(), 0,
+                      limitNode->offset() + limitNode->limit());
+    plan->registerNode(dbLimitNode);
+    plan->insertDependency(remoteNode, dbLimitNode);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
 void arangodb::aql::removeUnnecessaryRemoteScatterRule(
@@ -6450,6 +6535,11 @@ struct GeoIndexInfo {
   /// variable using the filter mask
   AstNode const* filterExpr = nullptr;
 
+  // ============ Range Info ============
+  /// comparisons which may apply to the range attribute stored in the
+  /// index. These are only copied into the index condition
+  std::vector<AstNode const*> rangeCandidates;
+
   // ============ Accessed Fields ============
   AstNode const* locationVar = nullptr;   // access to location field
   AstNode const* latitudeVar = nullptr;   // access path to latitude
@@ -6775,6 +6865,23 @@ bool checkGeoFilterExpression(ExecutionPlan* plan, AstNode const* node,
   }
 }
 
+// checks if a node is a comparison which might apply to the range
+// attribute of a geo index, i.e. `doc.attr [==|<|<=|>=|>] value`
+static bool isRangeCandidate(AstNode const* node) {
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      TRI_ASSERT(node->numMembers() == 2);
+      return node->getMemberUnchecked(0)->isAttributeAccessForVariable() ||
+             node->getMemberUnchecked(1)->isAttributeAccessForVariable();
+    default:
+      return false;
+  }
+}
+
 static bool optimizeSortNode(ExecutionPlan* plan, SortNode* sort,
                              GeoIndexInfo& info) {
   TRI_ASSERT(sort->getType() == EN::SORT);
@@ -6851,6 +6958,8 @@ static void optimizeFilterNode(ExecutionPlan* plan, FilterNode* fn,
           // do not visit below OR or into <=, <, >, >= expressions
           if (checkGeoFilterExpression(plan, node, info)) {
             info.exesToModify.emplace(fn, expr);
+          } else if (isRangeCandidate(node)) {
+            info.rangeCandidates.push_back(node);
           }
         }
         parents.pop_back();
@@ -6862,10 +6971,49 @@ static void optimizeFilterNode(ExecutionPlan* plan, FilterNode* fn,
 
 // modify plan
 
+// builds `doc.rangeField [==|<|<=|>=|>] value` if the comparison applies
+// to the range attribute of the geo index, nullptr otherwise
+static AstNode* buildRangeCondition(ExecutionPlan* plan, AstNode const* node,
+                                    Variable const* var,
+                                    geo_index::Index const& index) {
+  TRI_ASSERT(isRangeCandidate(node));
+  AstNodeType type = node->type;
+  AstNode const* attr = node->getMemberUnchecked(0);
+  AstNode const* value = node->getMemberUnchecked(1);
+
+  std::pair<Variable const*, std::vector<basics::AttributeName>> access;
+  if (!attr->isAttributeAccessForVariable(access, false) ||
+      access.first != var) {
+    // attribute access might be on the right side
+    std::swap(attr, value);
+    auto it = Ast::ReversedOperators.find(static_cast<int>(type));
+    if (it == Ast::ReversedOperators.end() ||
+        !attr->isAttributeAccessForVariable(access, false) ||
+        access.first != var) {
+      return nullptr;
+    }
+    type = it->second;
+  }
+  if (!basics::AttributeName::isIdentical(access.second,
+                                          index.rangeAttribute(), false)) {
+    return nullptr;
+  }
+
+  // the compared value must not depend on the document
+  std::unordered_set<Variable const*> varsUsed;
+  Ast::getReferencedVariables(value, varsUsed);
+  if (varsUsed.find(var) != varsUsed.end()) {
+    return nullptr;
+  }
+
+  return plan->getAst()->createNodeBinaryOperator(type, attr, value);
+}
+
 // builds a condition that can be used with the index interface and
 // contains all parameters required by the MMFilesGeoIndex
-static std::unique_ptr<Condition> buildGeoCondition(ExecutionPlan* plan,
-                                                    GeoIndexInfo const& info) {
+static std::unique_ptr<Condition> buildGeoCondition(
+    ExecutionPlan* plan, GeoIndexInfo const& info,
+    std::vector<AstNode*> const& rangeConditions) {
   Ast* ast = plan->getAst();
   // shared code to add symbolic `doc.geometry` or `[doc.lng, doc.lat]`
   auto addLocationArg = [ast, &info](AstNode* args) {
@@ -6945,6 +7093,9 @@ static std::unique_ptr<Condition> buildGeoCondition(ExecutionPlan* plan,
       TRI_ASSERT(false);
     }
   }
+  for (AstNode* rangeCondition : rangeConditions) {
+    cond->andCombine(rangeCondition);
+  }
 
   cond->normalize(plan);
   return cond;
@@ -6976,6 +7127,20 @@ static bool applyGeoOptimization(ExecutionPlan* plan, LimitNode* ln,
     return false;
   }
 
+  // comparisons on the range attribute are checked during the index scan,
+  // which saves fetching documents that do not match anyway
+  std::vector<AstNode*> rangeConditions;
+  auto const* geoIndex = dynamic_cast<geo_index::Index const*>(info.index.get());
+  if (geoIndex != nullptr && geoIndex->hasRangeField()) {
+    for (AstNode const* node : info.rangeCandidates) {
+      AstNode* cond = buildRangeCondition(plan, node, info.collectionNodeOutVar,
+                                          *geoIndex);
+      if (cond != nullptr && checkVars(cond->getMemberUnchecked(1))) {
+        rangeConditions.push_back(cond);
+      }
+    }
+  }
+
   size_t limit = 0;
   if (ln != nullptr) {
     limit = ln->offset() + ln->limit();
@@ -6988,7 +7153,8 @@ static bool applyGeoOptimization(ExecutionPlan* plan, LimitNode* ln,
   // opts.fullRange = info.fullRange;
   opts.limit = limit;
   opts.evaluateFCalls = false;  // workaround to avoid evaluating "doc.geo"
-  std::unique_ptr<Condition> condition(buildGeoCondition(plan, info));
+  std::unique_ptr<Condition> condition(
+      buildGeoCondition(plan, info, rangeConditions));
   auto inode = new IndexNode(plan, plan->nextId(), info.collection,
                              info.collectionNodeOutVar,
                              std::vector<transaction::Methods::IndexHandle>{
@@ -7093,6 +7259,87 @@ void arangodb::aql::geoIndexRule(Optimizer* opt,
   opt->addPlan(std::move(plan), rule, mod);
 }
 
+namespace {
+
+/// @brief how the result of a subquery is used by the rest of the query
+struct SubqueryUsage {
+  /// @brief number of rows of the subquery result that are needed.
+  /// 0 means all of them
+  int64_t limit = 0;
+  /// @brief whether or not only the number of rows is used
+  bool usedForCount = true;
+  /// @brief whether or not the result is used in an unknown way
+  bool invalid = false;
+  /// @brief nodes that use the result in one of the known ways
+  std::unordered_set<ExecutionNode const*> nodes;
+
+  /// @brief combine with another usage of the same subquery result
+  void merge(SubqueryUsage const& other) {
+    if (limit == 0 || other.limit == 0) {
+      limit = 0;
+    } else {
+      limit = (std::max)(limit, other.limit);
+    }
+    usedForCount = usedForCount && other.usedForCount;
+    invalid = invalid || other.invalid;
+  }
+};
+
+/// @brief returns the subquery node whose result is passed to LENGTH() or
+/// COUNT() in node, or nullptr
+ExecutionNode* subqueryUsedForCount(ExecutionPlan const* plan, AstNode const* node) {
+  if (node->type != NODE_TYPE_FCALL || node->numMembers() == 0) {
+    return nullptr;
+  }
+  auto func = static_cast<Function const*>(node->getData());
+  if (func->name != "LENGTH" && func->name != "COUNT") {
+    return nullptr;
+  }
+  auto args = node->getMember(0);
+  if (args->numMembers() == 0 || args->getMember(0)->type != NODE_TYPE_REFERENCE) {
+    return nullptr;
+  }
+  Variable const* v = static_cast<Variable const*>(args->getMember(0)->getData());
+  auto setter = plan->getVarSetBy(v->id);
+  if (setter == nullptr || setter->getType() != EN::SUBQUERY) {
+    return nullptr;
+  }
+  return setter;
+}
+
+/// @brief recognizes comparisons of the number of rows of a subquery result
+/// with a constant, e.g. `LENGTH(sq) > 0`. comparing min(LENGTH(sq), n + 1)
+/// with n produces the same result, so the subquery can stop after n + 1 rows
+std::pair<ExecutionNode*, int64_t> subqueryCountComparedToConstant(
+    ExecutionPlan const* plan, AstNode const* node) {
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      break;
+    default:
+      return {nullptr, 0};
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    auto setter = subqueryUsedForCount(plan, node->getMemberUnchecked(i));
+    auto other = node->getMemberUnchecked(1 - i);
+    if (setter != nullptr && other->type == NODE_TYPE_VALUE &&
+        other->isNumericValue()) {
+      double value = other->getDoubleValue();
+      if (value >= 0.0 && value < 1000000.0) {
+        return {setter, static_cast<int64_t>(value) + 1};
+      }
+    }
+  }
+  return {nullptr, 0};
+}
+
+}  // namespace
+
 void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
                                            std::unique_ptr<ExecutionPlan> plan,
                                            OptimizerRule const* rule) {
@@ -7102,10 +7349,7 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
   SmallVector<ExecutionNode*> nodes{a};
   plan->findNodesOfType(nodes, EN::CALCULATION, true);
 
-  std::unordered_map<
-      ExecutionNode*,
-      std::tuple<int64_t, std::unordered_set<ExecutionNode const*>, bool>>
-      subqueryAttributes;
+  std::unordered_map<ExecutionNode*, ::SubqueryUsage> subqueryAttributes;
 
   for (auto const& n : nodes) {
     auto cn = ExecutionNode::castTo<CalculationNode*>(n);
@@ -7121,17 +7365,23 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
 
     auto visitor = [&subqueryAttributes, &plan,
                     n](AstNode const* node) -> bool {
-      std::pair<ExecutionNode*, int64_t> found{nullptr, 0};
-      bool usedForCount = false;
+      ExecutionNode* found = nullptr;
+      ::SubqueryUsage usage;
+
+      auto compared = ::subqueryCountComparedToConstant(plan.get(), node);
 
-      if (node->type == NODE_TYPE_REFERENCE) {
+      if (compared.first != nullptr) {
+        // LENGTH(x) > 0 => LIMIT 1
+        found = compared.first;
+        usage.limit = compared.second;
+      } else if (node->type == NODE_TYPE_REFERENCE) {
         Variable const* v = static_cast<Variable const*>(node->getData());
         auto setter = plan->getVarSetBy(v->id);
         if (setter != nullptr && setter->getType() == EN::SUBQUERY) {
           // we found a subquery result being used somehow in some
           // way that will make the optimization produce wrong results
-          found.first = setter;
-          found.second = -1;  // negative values will disable the optimization
+          found = setter;
+          usage.invalid = true;
         }
       } else if (node->type == NODE_TYPE_INDEXED_ACCESS) {
         auto sub = node->getMemberUnchecked(0);
@@ -7141,66 +7391,43 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
           auto index = node->getMemberUnchecked(1);
           if (index->type == NODE_TYPE_VALUE && index->isNumericValue() &&
               setter != nullptr && setter->getType() == EN::SUBQUERY) {
-            found.first = setter;
-            found.second = index->getIntValue() + 1;  // x[0] => LIMIT 1
-            if (found.second <= 0) {
+            found = setter;
+            usage.limit = index->getIntValue() + 1;  // x[0] => LIMIT 1
+            usage.usedForCount = false;
+            if (usage.limit <= 0) {
               // turn optimization off
-              found.second = -1;
+              usage.invalid = true;
             }
           }
         }
       } else if (node->type == NODE_TYPE_FCALL && node->numMembers() > 0) {
         auto func = static_cast<Function const*>(node->getData());
         auto args = node->getMember(0);
-        if (func->name == "FIRST" || func->name == "LENGTH" ||
-            func->name == "COUNT") {
-          if (args->numMembers() > 0 &&
-              args->getMember(0)->type == NODE_TYPE_REFERENCE) {
-            Variable const* v =
-                static_cast<Variable const*>(args->getMember(0)->getData());
-            auto setter = plan->getVarSetBy(v->id);
-            if (setter != nullptr && setter->getType() == EN::SUBQUERY) {
-              found.first = setter;
-              if (func->name == "FIRST") {
-                found.second = 1;  // FIRST(x) => LIMIT 1
-              } else {
-                found.second = -1;
-                usedForCount = true;
-              }
-            }
+        if (func->name == "FIRST" && args->numMembers() > 0 &&
+            args->getMember(0)->type == NODE_TYPE_REFERENCE) {
+          Variable const* v =
+              static_cast<Variable const*>(args->getMember(0)->getData());
+          auto setter = plan->getVarSetBy(v->id);
+          if (setter != nullptr && setter->getType() == EN::SUBQUERY) {
+            found = setter;
+            usage.limit = 1;  // FIRST(x) => LIMIT 1
+            usage.usedForCount = false;
           }
+        } else {
+          // LENGTH(x) needs all rows, but not their values
+          found = ::subqueryUsedForCount(plan.get(), node);
         }
       }
 
-      if (found.first != nullptr) {
-        auto it = subqueryAttributes.find(found.first);
+      if (found != nullptr) {
+        auto it = subqueryAttributes.find(found);
         if (it == subqueryAttributes.end()) {
-          subqueryAttributes.emplace(
-              found.first,
-              std::make_tuple(found.second,
-                              std::unordered_set<ExecutionNode const*>{n},
-                              usedForCount));
+          it = subqueryAttributes.emplace(found, usage).first;
         } else {
-          auto& sq = (*it).second;
-          if (usedForCount) {
-            // COUNT + LIMIT together will turn off the optimization
-            std::get<2>(sq) = (std::get<0>(sq) <= 0);
-            std::get<0>(sq) = -1;
-            std::get<1>(sq).clear();
-          } else {
-            if (found.second <= 0 || std::get<0>(sq) < 0) {
-              // negative value will turn off the optimization
-              std::get<0>(sq) = -1;
-              std::get<1>(sq).clear();
-            } else {
-              // otherwise, use the maximum of the limits needed, and insert
-              // current node into our "safe" list
-              std::get<0>(sq) = std::max(std::get<0>(sq), found.second);
-              std::get<1>(sq).emplace(n);
-            }
-            std::get<2>(sq) = false;
-          }
+          (*it).second.merge(usage);
         }
+        // insert current node into our "safe" list
+        (*it).second.nodes.emplace(n);
         // don't descend further
         return false;
       }
@@ -7223,9 +7450,7 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
     }
 
     auto const& sq = it.second;
-    int64_t limitValue = std::get<0>(sq);
-    bool usedForCount = std::get<2>(sq);
-    if (limitValue <= 0 && !usedForCount) {
+    if (sq.invalid || (sq.limit <= 0 && !sq.usedForCount)) {
       // optimization turned off
       continue;
     }
@@ -7238,8 +7463,7 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
 
     auto current = node->getFirstParent();
     while (current != nullptr) {
-      auto const& referencedBy = std::get<1>(sq);
-      if (referencedBy.find(current) == referencedBy.end()) {
+      if (sq.nodes.find(current) == sq.nodes.end()) {
         // node not found in "safe" list
         // now check if it uses the subquery's out variable
         used.clear();
@@ -7259,11 +7483,10 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
 
     auto root = sn->getSubquery();
     if (root != nullptr && root->getType() == EN::RETURN) {
-      // now inject a limit
       auto f = root->getFirstDependency();
       TRI_ASSERT(f != nullptr);
 
-      if (std::get<2>(sq)) {
+      if (sq.usedForCount) {
         // used for count, e.g. COUNT(FOR doc IN collection RETURN ...)
         // this will be turned into
         // COUNT(FOR doc IN collection RETURN 1)
@@ -7281,16 +7504,15 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
         TRI_ASSERT(root->getType() == EN::RETURN);
         ExecutionNode::castTo<ReturnNode*>(root)->inVariable(outVariable);
         modified = true;
-        continue;
       }
 
-      if (f->getType() == EN::LIMIT) {
-        // subquery already has a LIMIT node at its end
-        // no need to do anything
+      if (sq.limit <= 0 || f->getType() == EN::LIMIT) {
+        // no limit needed, or subquery already has a LIMIT node at its end
         continue;
       }
 
-      auto limitNode = new LimitNode(plan.get(), plan->nextId(), 0, limitValue);
+      // now inject a limit
+      auto limitNode = new LimitNode(plan.get(), plan->nextId(), 0, sq.limit);
       plan->registerNode(limitNode);
       plan->insertAfter(f, limitNode);
       modified = true;
@@ -7299,3 +7521,1105 @@ void arangodb::aql::optimizeSubqueriesRule(Optimizer* opt,
 
   opt->addPlan(std::move(plan), rule, modified);
 }
+
+/// @brief let subqueries that depend on variables of the outer query reuse
+/// their results for input rows with the same values of these variables
+void arangodb::aql::cacheSubqueryResultsRule(Optimizer* opt,
+                                             std::unique_ptr<ExecutionPlan> plan,
+                                             OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::SUBQUERY, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto sn = ExecutionNode::castTo<SubqueryNode*>(n);
+    if (!sn->cacheResults() && sn->canCacheResults()) {
+      sn->setCacheResults();
+      modified = true;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief whether or not a subquery waits for responses of DB servers
+bool subqueryUsesRemote(SubqueryNode const* sn) {
+  std::vector<ExecutionNode*> stack({sn->getSubquery()});
+
+  while (!stack.empty()) {
+    ExecutionNode* current = stack.back();
+    stack.pop_back();
+
+    if (current->getType() == EN::REMOTE) {
+      return true;
+    }
+    if (current->getType() == EN::SUBQUERY) {
+      stack.emplace_back(ExecutionNode::castTo<SubqueryNode*>(current)->getSubquery());
+    }
+    current->dependencies(stack);
+  }
+
+  return false;
+}
+
+/// @brief whether or not a subquery can be interleaved with others. the
+/// rule is only registered on coordinators, where only subqueries that wait
+/// for DB servers benefit from it. the tests register it on single servers,
+/// which execute interleaved subqueries the same way
+bool canInterleaveSubquery(SubqueryNode* sn) {
+  if (sn->isModificationSubquery()) {
+    return false;
+  }
+  return !ServerState::instance()->isCoordinator() || ::subqueryUsesRemote(sn);
+}
+
+}  // namespace
+
+/// @brief let a chain of SubqueryNodes in which no subquery uses the result
+/// of another one execute its subqueries row by row together. a subquery
+/// that has to wait for a DB server then does not hold back the others, so
+/// that their requests are in flight at the same time. the subqueries still
+/// run on the thread of the query, as its transaction and memory accounting
+/// are not thread-safe
+void arangodb::aql::parallelizeSubqueriesRule(Optimizer* opt,
+                                              std::unique_ptr<ExecutionPlan> plan,
+                                              OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  // the nodes are returned from the root downwards, so we see the last
+  // SubqueryNode of a chain first
+  plan->findNodesOfType(nodes, EN::SUBQUERY, true);
+
+  std::unordered_set<ExecutionNode*> seen;
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    if (!seen.emplace(n).second) {
+      continue;
+    }
+    auto sn = ExecutionNode::castTo<SubqueryNode*>(n);
+    if (!::canInterleaveSubquery(sn)) {
+      continue;
+    }
+
+    // variables used by the subqueries in the chain so far
+    std::unordered_set<Variable const*> used;
+    sn->getVariablesUsedHere(used);
+
+    while (true) {
+      auto dep = sn->getFirstDependency();
+      if (dep == nullptr || dep->getType() != EN::SUBQUERY ||
+          dep->getParents().size() != 1 || seen.find(dep) != seen.end()) {
+        break;
+      }
+      auto depSn = ExecutionNode::castTo<SubqueryNode*>(dep);
+      if (used.find(depSn->outVariable()) != used.end() ||
+          !::canInterleaveSubquery(depSn)) {
+        break;
+      }
+      seen.emplace(dep);
+      sn->setInterleaved();
+      depSn->getVariablesUsedHere(used);
+      sn = depSn;
+      modified = true;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief restrict a SORT that is followed by a LIMIT to offset + limit rows.
+/// nodes in between are fine as long as they do not change the number of
+/// rows. the SortBlock will then only keep the first rows in a heap instead
+/// of buffering and sorting its entire input
+void arangodb::aql::sortLimitRule(Optimizer* opt,
+                                  std::unique_ptr<ExecutionPlan> plan,
+                                  OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, ::sortLimitNodeTypes, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto sortNode = ExecutionNode::castTo<SortNode*>(n);
+
+    if (sortNode->isStable() || sortNode->limit() > 0) {
+      // the heap does not preserve the order of equal rows
+      continue;
+    }
+
+    auto current = n->getFirstParent();
+    while (current != nullptr) {
+      auto const type = current->getType();
+      if (type != EN::CALCULATION && type != EN::REMOTE &&
+          type != EN::GATHER) {
+        break;
+      }
+      current = current->getFirstParent();
+    }
+
+    if (current == nullptr || current->getType() != EN::LIMIT) {
+      continue;
+    }
+
+    auto limitNode = ExecutionNode::castTo<LimitNode*>(current);
+    if (limitNode->fullCount() || limitNode->limit() == 0) {
+      // fullCount needs to see all rows
+      continue;
+    }
+
+    sortNode->setLimit(limitNode->offset() + limitNode->limit());
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief extracts the variable and the attribute path from an expression of
+/// the form `variable.attribute.attribute...` or `variable`. returns a
+/// nullptr if the expression has a different form
+arangodb::aql::Variable const* getAttributePath(
+    arangodb::aql::AstNode const* node, std::vector<std::string>& path) {
+  using namespace arangodb::aql;
+
+  path.clear();
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    path.emplace_back(node->getString());
+    node = node->getMember(0);
+  }
+
+  if (node->type != NODE_TYPE_REFERENCE) {
+    return nullptr;
+  }
+
+  std::reverse(path.begin(), path.end());
+  return static_cast<Variable const*>(node->getData());
+}
+
+/// @brief replace the collection loop n by a HashJoinNode if it is followed
+/// by a FILTER on an equality of an attribute of its documents with a value
+/// that is available before the loop. if probeVariables is set, the value
+/// must be an attribute of one of these variables
+bool replaceByHashJoin(arangodb::aql::ExecutionPlan* plan,
+                       arangodb::aql::ExecutionNode* n,
+                       std::unordered_set<arangodb::aql::Variable const*> const* probeVariables) {
+  using namespace arangodb::aql;
+  using EN = arangodb::aql::ExecutionNode;
+
+  auto collectionNode = ExecutionNode::castTo<EnumerateCollectionNode*>(n);
+
+  if (!collectionNode->isDeterministic() || collectionNode->isRestricted()) {
+    // random iteration
+    return false;
+  }
+
+  // find the FILTER that belongs to the collection loop
+  auto current = n->getFirstParent();
+  while (current != nullptr && current->getType() == EN::CALCULATION) {
+    current = current->getFirstParent();
+  }
+
+  if (current == nullptr || current->getType() != EN::FILTER) {
+    return false;
+  }
+
+  auto filterVariable = current->getVariablesUsedHere()[0];
+  auto setter = plan->getVarSetBy(filterVariable->id);
+  if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+    return false;
+  }
+
+  auto condition =
+      ExecutionNode::castTo<CalculationNode*>(setter)->expression()->node();
+  if (condition->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+    return false;
+  }
+
+  std::vector<std::string> lhsPath;
+  std::vector<std::string> rhsPath;
+  Variable const* lhs = ::getAttributePath(condition->getMember(0), lhsPath);
+  Variable const* rhs = ::getAttributePath(condition->getMember(1), rhsPath);
+  if (lhs == nullptr || rhs == nullptr) {
+    return false;
+  }
+
+  Variable const* outVariable = collectionNode->outVariable();
+  if (rhs == outVariable) {
+    std::swap(lhs, rhs);
+    lhsPath.swap(rhsPath);
+  }
+
+  // lhs must now be the build side (an attribute of the collection's
+  // documents), and rhs the probe side, which must be available before
+  // the collection loop
+  if (lhs != outVariable || lhsPath.empty() || rhs == outVariable ||
+      n->getVarsValid().find(rhs) == n->getVarsValid().end()) {
+    return false;
+  }
+
+  if (probeVariables != nullptr &&
+      probeVariables->find(rhs) == probeVariables->end()) {
+    return false;
+  }
+
+  auto hashJoinNode = new HashJoinNode(plan, plan->nextId(),
+                                       collectionNode->collection(),
+                                       outVariable, lhsPath, rhs, rhsPath);
+  plan->registerNode(hashJoinNode);
+  plan->replaceNode(n, hashJoinNode);
+  return true;
+}
+
+} // namespace
+
+/// @brief replace the inner collection loop of an equi-join of the form
+/// `FOR a IN ... FOR b IN collection FILTER a.x == b.y` by a hash join, which
+/// reads the collection only once instead of once per outer row. this is
+/// applied only to full collection scans, i.e. if no index could be used
+/// for the join condition
+void arangodb::aql::hashJoinRule(Optimizer* opt,
+                                 std::unique_ptr<ExecutionPlan> plan,
+                                 OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, ::hashJoinNodeTypes, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto dep = n->getFirstDependency();
+    if (dep == nullptr || dep->getCost().estimatedNrItems <= 1) {
+      // the collection is scanned at most once anyway
+      continue;
+    }
+
+    if (::replaceByHashJoin(plan.get(), n, nullptr)) {
+      modified = true;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief send each row that arrives at a hash join on the DB servers only
+/// to the shard that can contain its join partners. this is possible if the
+/// build attribute of the hash join is the only shard key of its collection.
+/// the SCATTER in front of the hash join snippet, which sends every row to
+/// all shards, is then replaced by a DISTRIBUTE on the probe value
+void arangodb::aql::distributeHashJoinInClusterRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::HASH_JOIN, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto joinNode = ExecutionNode::castTo<HashJoinNode*>(n);
+    auto collection = joinNode->collection();
+
+    if (collection->isSatellite() || collection->numberOfShards() <= 1) {
+      continue;
+    }
+
+    auto const shardKeys = collection->shardKeys();
+    auto const& buildAttributes = joinNode->buildAttributes();
+    if (shardKeys.size() != 1 || buildAttributes.size() != 1 ||
+        shardKeys[0] != buildAttributes[0]) {
+      continue;
+    }
+
+    // the hash join must be the first collection access of its snippet
+    auto current = n->getFirstDependency();
+    while (current != nullptr && (current->getType() == EN::CALCULATION ||
+                                  current->getType() == EN::FILTER)) {
+      current = current->getFirstDependency();
+    }
+
+    if (current == nullptr || current->getType() != EN::REMOTE) {
+      continue;
+    }
+
+    auto scatterNode = current->getFirstDependency();
+    if (scatterNode == nullptr || scatterNode->getType() != EN::SCATTER ||
+        scatterNode->getParents().size() != 1) {
+      continue;
+    }
+
+    // the probe value must be known on the coordinator
+    Variable const* probeVariable = joinNode->probeVariable();
+    auto const& varsValid = scatterNode->getVarsValid();
+    if (varsValid.find(probeVariable) == varsValid.end()) {
+      continue;
+    }
+
+    // build a document that only contains the shard key, with the probe
+    // value as its value
+    Ast* ast = plan->getAst();
+    auto value = ast->createNodeAttributeAccess(
+        ast->createNodeReference(probeVariable), joinNode->probeAttributes());
+    auto object = ast->createNodeObject();
+    char const* name = ast->query()->registerString(shardKeys[0]);
+    object->addMember(
+        ast->createNodeObjectElement(name, shardKeys[0].size(), value));
+
+    auto expr = std::make_unique<Expression>(plan.get(), ast, object);
+    Variable* outVariable = ast->variables()->createTemporaryVariable();
+    auto calcNode = new CalculationNode(plan.get(), plan->nextId(), expr.get(),
+                                        nullptr, outVariable);
+    plan->registerNode(calcNode);
+    expr.release();
+
+    auto distributeNode =
+        new DistributeNode(plan.get(), plan->nextId(), collection, outVariable,
+                           outVariable, false, false);
+    plan->registerNode(distributeNode);
+    plan->replaceNode(scatterNode, distributeNode);
+    plan->insertDependency(distributeNode, calcNode);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief decorrelate subqueries of the form
+/// `FOR a IN ... LET s = (FOR b IN collection FILTER b.y == a.x RETURN b)`.
+/// such a subquery scans the collection once per outer row. its collection
+/// loop is replaced by a hash join, which reads the collection only once and
+/// keeps its hash table while the subquery is executed for the outer rows.
+/// the subquery then only groups the matches of each outer row into an array
+void arangodb::aql::decorrelateSubqueriesRule(Optimizer* opt,
+                                              std::unique_ptr<ExecutionPlan> plan,
+                                              OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::SUBQUERY, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto sn = ExecutionNode::castTo<SubqueryNode*>(n);
+
+    auto dep = n->getFirstDependency();
+    if (dep == nullptr || dep->getCost().estimatedNrItems <= 1 ||
+        sn->isModificationSubquery()) {
+      // the subquery is executed at most once anyway
+      continue;
+    }
+
+    // the join value must come from the outer query
+    auto const used = sn->getVariablesUsedHere();
+    if (used.empty()) {
+      continue;
+    }
+    std::unordered_set<Variable const*> const outer(used.begin(), used.end());
+
+    // only look at the collection loops of the subquery itself, and not at
+    // the ones of nested subqueries
+    auto current = sn->getSubquery();
+    while (current != nullptr) {
+      auto next = current->getFirstDependency();
+      if (current->getType() == EN::ENUMERATE_COLLECTION &&
+          ::replaceByHashJoin(plan.get(), current, &outer)) {
+        modified = true;
+      }
+      current = next;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief returns the only index used by an IndexNode if it can be scanned
+/// in sorted order of its first field, or a nullptr otherwise
+arangodb::Index const* sortedJoinIndex(arangodb::aql::IndexNode const* node) {
+  auto const& indexes = node->getIndexes();
+  if (indexes.size() != 1) {
+    return nullptr;
+  }
+
+  auto index = indexes[0].getIndex();
+  if ((index->type() != arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX &&
+       index->type() != arangodb::Index::TRI_IDX_TYPE_PERSISTENT_INDEX) ||
+      index->isAttributeExpanded(0)) {
+    // array indexes produce a document once per array member
+    return nullptr;
+  }
+
+  return index.get();
+}
+
+} // namespace
+
+/// @brief replace the inner index lookup of an equi-join of the form
+/// `FOR a IN ... SORT a.x FOR b IN collection FILTER b.y == a.x` by a merge
+/// join if the outer rows are produced sorted by a.x by an index, and if the
+/// estimated costs favor it. the index on b.y is then scanned once in
+/// lockstep with the outer rows, instead of being looked up once per outer row
+void arangodb::aql::mergeJoinRule(Optimizer* opt,
+                                  std::unique_ptr<ExecutionPlan> plan,
+                                  OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, ::mergeJoinNodeTypes, true);
+
+  bool modified = false;
+  std::vector<std::string> lhsPath;
+  std::vector<std::string> rhsPath;
+
+  for (auto const& n : nodes) {
+    auto indexNode = ExecutionNode::castTo<IndexNode*>(n);
+    auto index = ::sortedJoinIndex(indexNode);
+    if (index == nullptr || index->sparse() ||
+        indexNode->isRestricted() || indexNode->options().limit != 0) {
+      // sparse indexes do not contain all documents, so the scan would not
+      // find documents with a null join value
+      continue;
+    }
+
+    // the index condition must consist of the join condition only
+    auto root = indexNode->condition()->root();
+    if (root == nullptr || root->numMembers() != 1 ||
+        root->getMember(0)->numMembers() != 1) {
+      continue;
+    }
+
+    auto condition = root->getMember(0)->getMember(0);
+    if (condition->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+      continue;
+    }
+
+    Variable const* lhs = ::getAttributePath(condition->getMember(0), lhsPath);
+    Variable const* rhs = ::getAttributePath(condition->getMember(1), rhsPath);
+    if (lhs == nullptr || rhs == nullptr) {
+      continue;
+    }
+
+    Variable const* outVariable = indexNode->outVariable();
+    if (rhs == outVariable) {
+      std::swap(lhs, rhs);
+      lhsPath.swap(rhsPath);
+    }
+
+    // lhs must now be the first field of the index, and rhs an attribute
+    // of a document produced by an outer index scan
+    if (lhs != outVariable || rhs == outVariable || rhsPath.empty() ||
+        index->fieldNames()[0] != lhsPath) {
+      continue;
+    }
+
+    // find the node producing the probe variable. in between, there may
+    // only be nodes that do not change the order of the rows
+    auto current = n->getFirstDependency();
+    while (current != nullptr &&
+           (current->getType() == EN::CALCULATION ||
+            current->getType() == EN::FILTER)) {
+      current = current->getFirstDependency();
+    }
+
+    if (current == nullptr || current->getType() != EN::INDEX) {
+      continue;
+    }
+
+    // the outer index scan must produce the documents sorted by the probe
+    // attribute
+    auto outerNode = ExecutionNode::castTo<IndexNode const*>(current);
+    auto outerIndex = ::sortedJoinIndex(outerNode);
+    if (outerNode->outVariable() != rhs || outerIndex == nullptr ||
+        outerIndex->fieldNames()[0] != rhsPath ||
+        !outerNode->options().sorted || !outerNode->options().ascending) {
+      continue;
+    }
+
+    auto outerRoot = outerNode->condition()->root();
+    if (outerRoot != nullptr && outerRoot->numMembers() > 1) {
+      // multiple index lookups, each of which is sorted on its own
+      continue;
+    }
+
+    // the merge join scans the whole inner index once, while the index
+    // lookups cost about the same per outer row. only use the merge join if
+    // there are enough outer rows to make the scan cheaper
+    CostEstimate const outerEstimate = n->getFirstDependency()->getCost();
+    double const lookupCost =
+        indexNode->getCost().estimatedCost - outerEstimate.estimatedCost;
+    double const scanCost =
+        static_cast<double>(indexNode->collection()->count(
+            plan->getAst()->query()->trx())) +
+        static_cast<double>(outerEstimate.estimatedNrItems);
+    if (scanCost >= lookupCost) {
+      continue;
+    }
+
+    auto mergeJoinNode = new MergeJoinNode(plan.get(), plan->nextId(),
+                                           indexNode->collection(),
+                                           indexNode->getIndexes()[0],
+                                           outVariable, lhsPath, rhs, rhsPath);
+    plan->registerNode(mergeJoinNode);
+    plan->replaceNode(n, mergeJoinNode);
+    // the costs of the nodes depending on the replaced one have changed
+    plan->invalidateCost();
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+/// @brief whether all <attributes> can be read from the index values of the
+/// IndexNode, which must use a single index with a covering iterator
+bool indexCoversAttributes(arangodb::aql::IndexNode const* indexNode,
+                           std::unordered_set<std::string> const& attributes) {
+  auto const& indexes = indexNode->getIndexes();
+  if (indexes.empty()) {
+    return false;
+  }
+  auto idx = indexes[0].getIndex();
+  for (size_t i = 1; i < indexes.size(); ++i) {
+    if (indexes[i].getIndex() != idx) {
+      return false;
+    }
+  }
+  if (!idx->hasCoveringIterator()) {
+    return false;
+  }
+
+  std::string name;
+  for (auto const& it : attributes) {
+    bool found = false;
+    for (auto const& field : idx->fields()) {
+      name.clear();
+      TRI_AttributeNamesToString(field, name, false);
+      if (name == it) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+/// @brief let the FILTERs, SORTs and the LIMIT on top of an index scan, as in
+/// `FOR d IN c FILTER d.ts > @t SORT d.ts LIMIT 1000, 10 RETURN d`, work on
+/// the attributes covered by the index only. the IndexNode then produces
+/// these attributes plus the document ids, and the full documents are read
+/// by a MaterializeNode after the LIMIT, only for the rows that remain.
+/// without a LIMIT, the documents are read as soon as an attribute is needed
+/// that the index does not cover, provided that a FILTER has run before
+void arangodb::aql::lateDocumentMaterializationRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const* rule) {
+  if (EngineSelectorFeature::ENGINE->useRawDocumentPointers()) {
+    // documents can be accessed directly in memory, so reading them
+    // is not more expensive than reading the index values
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, ::lateDocumentMaterializationNodeTypes, true);
+
+  bool modified = false;
+  std::unordered_set<Variable const*> vars;
+  std::unordered_set<std::string> attributes;
+  std::vector<ExecutionNode*> calculations;
+
+  for (auto const& n : nodes) {
+    auto indexNode = ExecutionNode::castTo<IndexNode*>(n);
+    if (indexNode->outDocumentIdVariable() != nullptr ||
+        indexNode->isRestricted() || !indexNode->projections().empty()) {
+      continue;
+    }
+
+    Variable const* v = indexNode->outVariable();
+    attributes.clear();
+    calculations.clear();
+
+    // find the LIMIT. in between, the documents may only be used for
+    // accessing their attributes. without a LIMIT, stop at the first node
+    // that needs more than the index values
+    ExecutionNode* limitNode = nullptr;
+    ExecutionNode* lastNode = n;
+    bool hasFilter = false;
+    ExecutionNode* current = n->getFirstParent();
+    while (current != nullptr) {
+      auto type = current->getType();
+      if (type == EN::LIMIT) {
+        limitNode = current;
+        break;
+      }
+      if (type != EN::CALCULATION && type != EN::FILTER && type != EN::SORT) {
+        break;
+      }
+
+      vars.clear();
+      current->getVariablesUsedHere(vars);
+      if (vars.find(v) != vars.end()) {
+        if (type != EN::CALCULATION) {
+          // entire document used
+          break;
+        }
+        std::unordered_set<std::string> used(attributes);
+        if (!Ast::getReferencedAttributes(
+                ExecutionNode::castTo<CalculationNode*>(current)->expression()->node(),
+                v, used) ||
+            !::indexCoversAttributes(indexNode, used)) {
+          // entire document used or attribute not in the index
+          break;
+        }
+        attributes = std::move(used);
+        calculations.emplace_back(current);
+      }
+      if (type == EN::FILTER) {
+        hasFilter = true;
+      }
+      lastNode = current;
+      current = current->getFirstParent();
+    }
+
+    // materialize the documents after the LIMIT, or otherwise directly
+    // before they are needed, provided a FILTER has removed rows before
+    ExecutionNode* materializeAfter = limitNode;
+    if (materializeAfter == nullptr && hasFilter && current != nullptr) {
+      materializeAfter = lastNode;
+    }
+
+    if (materializeAfter == nullptr || calculations.empty() ||
+        !materializeAfter->isVarUsedLater(v)) {
+      continue;
+    }
+
+    // the IndexNode and the calculations before the LIMIT now use the
+    // index values
+    auto ast = plan->getAst();
+    Variable const* projectionVariable = ast->variables()->createTemporaryVariable();
+    std::unordered_map<VariableId, Variable const*> replacements;
+    replacements.emplace(v->id, projectionVariable);
+
+    std::unique_ptr<Condition> condition(indexNode->condition()->clone());
+    if (condition->root() != nullptr) {
+      ast->replaceVariables(condition->root(), replacements);
+    }
+
+    std::unique_ptr<IndexNode> newNode(new IndexNode(
+        plan.get(), plan->nextId(), indexNode->collection(), projectionVariable,
+        indexNode->getIndexes(), std::move(condition), indexNode->options()));
+    newNode->projections(std::vector<std::string>(attributes.begin(), attributes.end()));
+    newNode->needsGatherNodeSort(indexNode->needsGatherNodeSort());
+    newNode->initIndexCoversProjections();
+
+    if (newNode->coveringIndexAttributePositions().empty()) {
+      // the index does not cover all the attributes used before the LIMIT
+      continue;
+    }
+
+    Variable const* documentIdVariable = ast->variables()->createTemporaryVariable();
+    newNode->outDocumentIdVariable(documentIdVariable);
+
+    auto newIndexNode = newNode.release();
+    plan->registerNode(newIndexNode);
+    plan->replaceNode(n, newIndexNode);
+
+    RedundantCalculationsReplacer replacer(ast, replacements);
+    for (auto const& it : calculations) {
+      replacer.before(it);
+    }
+
+    // everything after the LIMIT uses the full documents
+    auto materializeNode = new MaterializeNode(
+        plan.get(), plan->nextId(), newIndexNode->collection(),
+        documentIdVariable, v);
+    plan->registerNode(materializeNode);
+    plan->insertAfter(materializeAfter, materializeNode);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+namespace {
+
+/// @brief whether a COLLECT aggregates all its input into a single row
+bool isGlobalAggregation(arangodb::aql::CollectNode const* collectNode) {
+  return (collectNode->groupVariables().empty() &&
+          !collectNode->hasExpressionVariable() &&
+          !collectNode->hasKeepVariables() &&
+          !collectNode->hasOutVariableButNoCount());
+}
+
+/// @brief returns the full collection scan the rows of node come from, or
+/// a nullptr if there is none. the scan must not be inside another loop,
+/// and only calculations and, if allowed, filters may be in between
+arangodb::aql::EnumerateCollectionNode* collectionScanBelow(
+    arangodb::aql::ExecutionNode* node, bool allowFilters) {
+  using namespace arangodb::aql;
+  using EN = arangodb::aql::ExecutionNode;
+
+  auto current = node->getFirstDependency();
+  while (current != nullptr) {
+    auto const type = current->getType();
+    if (type != EN::CALCULATION && (type != EN::FILTER || !allowFilters)) {
+      break;
+    }
+    current = current->getFirstDependency();
+  }
+
+  if (current == nullptr || current->getType() != EN::ENUMERATE_COLLECTION ||
+      current->getFirstDependency() == nullptr ||
+      current->getFirstDependency()->getType() != EN::SINGLETON) {
+    return nullptr;
+  }
+
+  auto collectionNode = ExecutionNode::castTo<EnumerateCollectionNode*>(current);
+  if (!collectionNode->isDeterministic() || collectionNode->isRestricted()) {
+    return nullptr;
+  }
+  return collectionNode;
+}
+
+/// @brief returns the calculation below node that sets v, if it only
+/// accesses a (non-expanded) attribute of the documents of collectionNode.
+/// the attribute is returned in access
+arangodb::aql::CalculationNode* documentAttributeCalculation(
+    arangodb::aql::ExecutionPlan* plan, arangodb::aql::ExecutionNode* node,
+    arangodb::aql::EnumerateCollectionNode* collectionNode,
+    arangodb::aql::Variable const* v,
+    std::pair<arangodb::aql::Variable const*,
+              std::vector<arangodb::basics::AttributeName>>& access) {
+  using namespace arangodb::aql;
+  using EN = arangodb::aql::ExecutionNode;
+
+  auto setter = plan->getVarSetBy(v->id);
+  if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+    return nullptr;
+  }
+
+  // the calculation must be part of the scan
+  auto current = node->getFirstDependency();
+  while (current != collectionNode && current != setter) {
+    current = current->getFirstDependency();
+  }
+  if (current != setter) {
+    return nullptr;
+  }
+
+  auto calculationNode = ExecutionNode::castTo<CalculationNode*>(setter);
+  if (!calculationNode->expression()->node()->isAttributeAccessForVariable(access) ||
+      access.first != collectionNode->outVariable() ||
+      TRI_AttributeNamesHaveExpansion(access.second)) {
+    return nullptr;
+  }
+  return calculationNode;
+}
+
+}  // namespace
+
+/// @brief replace a COLLECT that counts all documents of a collection by a
+/// call to COLLECTION_COUNT(), which reads the counter maintained by the
+/// storage engine instead of scanning the collection:
+///   FOR doc IN collection COLLECT WITH COUNT INTO n
+///   FOR doc IN collection COLLECT AGGREGATE n = COUNT(doc.value)
+/// only calculations that cannot fail may be in between, so that counting
+/// the documents is all the query does
+void arangodb::aql::useCollectionCountRule(Optimizer* opt,
+                                           std::unique_ptr<ExecutionPlan> plan,
+                                           OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, ::aggregateFromIndexNodeTypes, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto collectNode = ExecutionNode::castTo<CollectNode*>(n);
+    if (!::isGlobalAggregation(collectNode)) {
+      continue;
+    }
+
+    auto collectionNode = ::collectionScanBelow(collectNode, false);
+    if (collectionNode == nullptr) {
+      continue;
+    }
+
+    auto const& aggregates = collectNode->aggregateVariables();
+    Variable const* outVariable = nullptr;
+    CalculationNode* inputNode = nullptr;
+
+    if (collectNode->count() && aggregates.empty()) {
+      outVariable = collectNode->outVariable();
+    } else if (!collectNode->hasOutVariable() && aggregates.size() == 1 &&
+               aggregates[0].second.second == "LENGTH") {
+      std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+      inputNode = ::documentAttributeCalculation(
+          plan.get(), collectNode, collectionNode, aggregates[0].second.first,
+          access);
+      if (inputNode == nullptr) {
+        continue;
+      }
+      outVariable = aggregates[0].first;
+    } else {
+      continue;
+    }
+
+    // the input of the aggregate is the only calculation that may remain
+    // below the COLLECT
+    if (collectNode->getFirstDependency() != collectionNode &&
+        collectNode->getFirstDependency() != inputNode) {
+      continue;
+    }
+
+    auto ast = plan->getAst();
+    std::string const& name = collectionNode->collection()->name();
+    auto args = ast->createNodeArray(1);
+    args->addMember(ast->createNodeValueString(name.c_str(), name.size()));
+    auto countNode = ast->createNodeFunctionCall("COLLECTION_COUNT", args);
+
+    ExecutionNode* calculationNode = nullptr;
+    auto expression = new Expression(plan.get(), ast, countNode);
+    try {
+      calculationNode = new CalculationNode(plan.get(), plan->nextId(),
+                                            expression, outVariable);
+    } catch (...) {
+      delete expression;
+      throw;
+    }
+    plan->registerNode(calculationNode);
+
+    if (inputNode != nullptr) {
+      plan->unlinkNode(inputNode);
+    }
+    plan->unlinkNode(collectionNode);
+    plan->replaceNode(collectNode, calculationNode);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief prepare a COLLECT that computes MIN or MAX of an attribute of the
+/// documents of a collection for the use of a sorted index:
+///   FOR doc IN collection COLLECT AGGREGATE m = MAX(doc.value)
+/// gets a FILTER doc.value > null (MIN ignores null, and it allows sparse
+/// indexes), a SORT on the attribute and a LIMIT 1 in front of the COLLECT.
+/// the index rules then turn this into a single seek to the first or last
+/// index entry in the range defined by the other FILTERs. this is only done
+/// if the collection has a sorted index on the attribute, as the rewritten
+/// query would still scan the collection otherwise
+void arangodb::aql::useIndexForMinMaxRule(Optimizer* opt,
+                                          std::unique_ptr<ExecutionPlan> plan,
+                                          OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, ::aggregateFromIndexNodeTypes, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto collectNode = ExecutionNode::castTo<CollectNode*>(n);
+    auto const& aggregates = collectNode->aggregateVariables();
+
+    if (!::isGlobalAggregation(collectNode) || collectNode->hasOutVariable() ||
+        aggregates.size() != 1 ||
+        (aggregates[0].second.second != "MIN" &&
+         aggregates[0].second.second != "MAX")) {
+      continue;
+    }
+
+    auto collectionNode = ::collectionScanBelow(collectNode, true);
+    if (collectionNode == nullptr) {
+      continue;
+    }
+
+    Variable const* inVariable = aggregates[0].second.first;
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+    auto inputNode = ::documentAttributeCalculation(
+        plan.get(), collectNode, collectionNode, inVariable, access);
+    if (inputNode == nullptr) {
+      continue;
+    }
+
+    bool hasIndex = false;
+    for (auto const& idx : collectionNode->collection()->getCollection()->getIndexes()) {
+      if (!idx->isSorted()) {
+        continue;
+      }
+      for (auto const& field : idx->fields()) {
+        if (field == access.second) {
+          hasIndex = true;
+          break;
+        }
+      }
+      if (hasIndex) {
+        break;
+      }
+    }
+
+    if (!hasIndex) {
+      continue;
+    }
+
+    auto ast = plan->getAst();
+
+    // FILTER doc.value > null
+    auto condition = ast->createNodeBinaryOperator(
+        NODE_TYPE_OPERATOR_BINARY_GT,
+        ast->clone(inputNode->expression()->node()), ast->createNodeValueNull());
+    ExecutionNode* calculationNode = nullptr;
+    auto filterVariable = ast->variables()->createTemporaryVariable();
+    auto expression = new Expression(plan.get(), ast, condition);
+    try {
+      calculationNode = new CalculationNode(plan.get(), plan->nextId(),
+                                            expression, filterVariable);
+    } catch (...) {
+      delete expression;
+      throw;
+    }
+    plan->registerNode(calculationNode);
+    plan->insertDependency(collectNode, calculationNode);
+
+    auto filterNode = new FilterNode(plan.get(), plan->nextId(), filterVariable);
+    plan->registerNode(filterNode);
+    plan->insertDependency(collectNode, filterNode);
+
+    // SORT doc.value ASC for MIN, DESC for MAX
+    SortElementVector sortElements;
+    sortElements.emplace_back(inVariable, aggregates[0].second.second == "MIN");
+    auto sortNode = new SortNode(plan.get(), plan->nextId(), sortElements, false);
+    plan->registerNode(sortNode);
+    plan->insertDependency(collectNode, sortNode);
+
+    auto limitNode = new LimitNode(plan.get(), plan->nextId(), 0, 1);
+    plan->registerNode(limitNode);
+    plan->insertDependency(collectNode, limitNode);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief keyset pagination. if the query is to return a continuation
+/// token, the LIMIT of a top-level FOR ... SORT ... LIMIT is told to build
+/// it from the first sort attribute of the rows it returns:
+///   FOR doc IN collection SORT doc.value LIMIT 50 RETURN doc
+/// if a token is passed in, the query continues after the position in it:
+/// a FILTER doc.value >= <last value> is added, which the index rules turn
+/// into an index seek, and the LIMIT offset is replaced by the number of
+/// rows with the last value that were already returned. the SORT is made
+/// stable, so that rows with equal sort values keep their order between
+/// the pages
+void arangodb::aql::keysetPaginationRule(Optimizer* opt,
+                                         std::unique_ptr<ExecutionPlan> plan,
+                                         OptimizerRule const* rule) {
+  auto const& options = plan->getAst()->query()->queryOptions();
+  ExecutionNode* returnNode = plan->root();
+
+  if (!options.continuation || returnNode->getType() != EN::RETURN) {
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  auto current = returnNode->getFirstDependency();
+  while (current != nullptr && current->getType() == EN::CALCULATION) {
+    current = current->getFirstDependency();
+  }
+  if (current == nullptr || current->getType() != EN::LIMIT) {
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  auto limitNode = ExecutionNode::castTo<LimitNode*>(current);
+  if (limitNode->fullCount() || limitNode->limit() == 0 ||
+      (options.continuationValue == nullptr && limitNode->offset() != 0)) {
+    // rows skipped by an offset are not counted for the token
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  current = limitNode->getFirstDependency();
+  while (current != nullptr && current->getType() == EN::CALCULATION) {
+    current = current->getFirstDependency();
+  }
+  if (current == nullptr || current->getType() != EN::SORT) {
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  auto sortNode = ExecutionNode::castTo<SortNode*>(current);
+  auto const& elements = sortNode->elements();
+  auto collectionNode = ::collectionScanBelow(sortNode, true);
+  std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>> access;
+  CalculationNode* inputNode = nullptr;
+  if (collectionNode != nullptr && !elements.empty() &&
+      elements[0].attributePath.empty()) {
+    inputNode = ::documentAttributeCalculation(plan.get(), sortNode, collectionNode,
+                                               elements[0].var, access);
+  }
+
+  if (inputNode == nullptr) {
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  Variable const* sortVariable = elements[0].var;
+
+  if (!sortNode->isStable()) {
+    auto stableSortNode =
+        new SortNode(plan.get(), plan->nextId(), elements, true);
+    plan->registerNode(stableSortNode);
+    plan->replaceNode(sortNode, stableSortNode);
+    sortNode = stableSortNode;
+  }
+
+  size_t offset = limitNode->offset();
+
+  if (options.continuationValue != nullptr) {
+    // FILTER doc.value >= <last value>, or <= for a descending sort
+    auto ast = plan->getAst();
+    auto condition = ast->createNodeBinaryOperator(
+        elements[0].ascending ? NODE_TYPE_OPERATOR_BINARY_GE
+                              : NODE_TYPE_OPERATOR_BINARY_LE,
+        ast->clone(inputNode->expression()->node()),
+        ast->nodeFromVPack(options.continuationValue->slice(), true));
+    ExecutionNode* calculationNode = nullptr;
+    auto filterVariable = ast->variables()->createTemporaryVariable();
+    auto expression = new Expression(plan.get(), ast, condition);
+    try {
+      calculationNode = new CalculationNode(plan.get(), plan->nextId(),
+                                            expression, filterVariable);
+    } catch (...) {
+      delete expression;
+      throw;
+    }
+    plan->registerNode(calculationNode);
+    plan->insertDependency(sortNode, calculationNode);
+
+    auto filterNode = new FilterNode(plan.get(), plan->nextId(), filterVariable);
+    plan->registerNode(filterNode);
+    plan->insertDependency(sortNode, filterNode);
+
+    offset = static_cast<size_t>(options.continuationSkip);
+  }
+
+  auto newLimitNode =
+      new LimitNode(plan.get(), plan->nextId(), offset, limitNode->limit());
+  plan->registerNode(newLimitNode);
+  newLimitNode->continuationVariable(sortVariable);
+  plan->replaceNode(limitNode, newLimitNode);
+
+  opt->addPlan(std::move(plan), rule, true);
+}
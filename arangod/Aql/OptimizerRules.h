@@ -107,6 +107,18 @@ void removeRedundantCalculationsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
 void removeUnnecessaryCalculationsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                        OptimizerRule const*);
 
+/// @brief replace a COUNT over a whole collection by COLLECTION_COUNT()
+void useCollectionCountRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                            OptimizerRule const*);
+
+/// @brief prepare MIN/MAX over an indexed attribute for an index seek
+void useIndexForMinMaxRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                           OptimizerRule const*);
+
+/// @brief build and apply continuation tokens for keyset pagination
+void keysetPaginationRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                          OptimizerRule const*);
+
 /// @brief useIndex, try to use an index for filtering
 void useIndexesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
@@ -154,10 +166,10 @@ ExecutionNode* distributeInClusterRuleSmartEdgeCollection(
     ExecutionNode* node,
     ExecutionNode* originalParent,
     bool& wasModified);
+#endif
 
 /// @brief remove scatter/gather and remote nodes for satellite collections
 void removeSatelliteJoinsRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
-#endif
 
 /// @brief try to restrict fragments to a single shard if possible
 void restrictToSingleShardRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
@@ -171,6 +183,10 @@ void distributeFilternCalcToClusterRule(Optimizer*, std::unique_ptr<ExecutionPla
 void distributeSortToClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                  OptimizerRule const*);
 
+/// @brief copy a LIMIT on top of a GATHER into the DB server snippets
+void distributeLimitToClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                  OptimizerRule const*);
+
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
 void removeUnnecessaryRemoteScatterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
@@ -254,6 +270,33 @@ void optimizeSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, Optimize
 /// @brief replace legacy JS functions in the plan.
 void replaceNearWithinFulltext(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
 
+/// @brief restrict a SORT that is followed by a LIMIT to offset + limit rows
+void sortLimitRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief replace the inner collection loop of an equi-join by a hash join
+void hashJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief distribute the input of a hash join on the DB servers by the
+/// shard key of its collection
+void distributeHashJoinInClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                     OptimizerRule const*);
+
+/// @brief replace the collection loop of subqueries that are correlated via
+/// an equality by a hash join
+void decorrelateSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief replace the inner index lookup of an equi-join by a merge join
+void mergeJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief read the full documents of an index scan only after a LIMIT
+void lateDocumentMaterializationRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief reuse the results of correlated subqueries for repeated inputs
+void cacheSubqueryResultsRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
+/// @brief execute independent subqueries that wait for DB servers together
+void parallelizeSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>, OptimizerRule const*);
+
 
 }  // namespace aql
 }  // namespace arangodb
@@ -23,6 +23,7 @@
 
 #include "OptimizerRules.h"
 #include "Aql/ClusterNodes.h"
+#include "Aql/Collection.h"
 #include "Aql/Condition.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
@@ -412,3 +413,74 @@ void arangodb::aql::substituteClusterSingleDocumentOperations(Optimizer* opt,
 
   opt->addPlan(std::move(plan), rule, modified);
 }
+
+#ifndef USE_ENTERPRISE
+/// @brief remove scatter/gather and remote nodes for satellite collections.
+/// a satellite collection has a copy on every DB server, so a node reading
+/// it can be moved into the snippet of the collection it is joined with,
+/// and read the local copy there instead of being fed by the coordinator
+void arangodb::aql::removeSatelliteJoinsRule(Optimizer* opt,
+                                             std::unique_ptr<ExecutionPlan> plan,
+                                             OptimizerRule const* rule) {
+  bool modified = false;
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, {EN::ENUMERATE_COLLECTION, EN::INDEX}, true);
+
+  for (auto* node : nodes) {
+    Collection const* collection = nullptr;
+    if (node->getType() == EN::INDEX) {
+      collection = ExecutionNode::castTo<IndexNode const*>(node)->collection();
+    } else {
+      collection = ExecutionNode::castTo<EnumerateCollectionNode const*>(node)->collection();
+    }
+    if (collection == nullptr || !collection->isSatellite()) {
+      continue;
+    }
+
+    // look for gather <- remote <- ... other snippet below the scatter
+    // that feeds this node: remote <- scatter <- gather <- remote
+    auto* remote = ::hasSingleDep(node, EN::REMOTE);
+    auto* scatter = remote != nullptr ? ::hasSingleDep(remote, EN::SCATTER) : nullptr;
+    auto* gather = scatter != nullptr ? ::hasSingleDep(scatter, EN::GATHER) : nullptr;
+    auto* otherRemote = gather != nullptr ? ::hasSingleDep(gather, EN::REMOTE) : nullptr;
+    if (otherRemote == nullptr || scatter->getParents().size() != 1 ||
+        gather->getParents().size() != 1 ||
+        !ExecutionNode::castTo<GatherNode const*>(gather)->elements().empty()) {
+      // a sorted gather would lose its order
+      continue;
+    }
+
+    // the other snippet must read a collection, whose shards the joined
+    // snippet then runs on
+    bool readsCollection = false;
+    for (auto* current = otherRemote->getFirstDependency();
+         current != nullptr && current->getType() != EN::REMOTE;
+         current = current->getFirstDependency()) {
+      if (current->getType() == EN::ENUMERATE_COLLECTION ||
+          current->getType() == EN::INDEX) {
+        readsCollection = true;
+      } else if (current->getType() == EN::TRAVERSAL ||
+#ifdef USE_IRESEARCH
+                 current->getType() == EN::ENUMERATE_IRESEARCH_VIEW ||
+#endif
+                 current->getType() == EN::SHORTEST_PATH) {
+        readsCollection = false;
+        break;
+      }
+    }
+    if (!readsCollection) {
+      continue;
+    }
+
+    plan->unlinkNode(remote);
+    plan->unlinkNode(scatter);
+    plan->unlinkNode(gather);
+    plan->unlinkNode(otherRemote);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+#endif
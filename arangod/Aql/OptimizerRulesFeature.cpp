@@ -222,6 +222,19 @@ void OptimizerRulesFeature::addRules() {
   registerRule("remove-redundant-or", removeRedundantOrRule,
                OptimizerRule::removeRedundantOrRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // answer COUNT over a whole collection from the collection counter
+  registerRule("use-collection-count", useCollectionCountRule,
+               OptimizerRule::useCollectionCountRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // turn MIN/MAX over an indexed attribute into SORT + LIMIT 1
+  registerRule("use-index-for-min-max", useIndexForMinMaxRule,
+               OptimizerRule::useIndexForMinMaxRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // continue a sorted query after the position of a continuation token.
+  // this is required for the correctness of the token
+  registerRule("keyset-pagination", keysetPaginationRule,
+               OptimizerRule::keysetPaginationRule, DoesNotCreateAdditionalPlans, CanNotBeDisabled);
+
   // try to find a filter after an enumerate collection and find indexes
   registerRule("use-indexes", useIndexesRule, OptimizerRule::useIndexesRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
@@ -295,6 +308,9 @@ void OptimizerRulesFeature::addRules() {
     registerRule("collect-in-cluster", collectInClusterRule,
                  OptimizerRule::collectInClusterRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+    registerRule("distribute-limit-to-cluster", distributeLimitToClusterRule,
+                 OptimizerRule::distributeLimitToClusterRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
     // distribute operations in cluster
     registerRule("distribute-filtercalc-to-cluster",
                  distributeFilternCalcToClusterRule,
@@ -311,11 +327,9 @@ void OptimizerRulesFeature::addRules() {
                  undistributeRemoveAfterEnumCollRule,
                  OptimizerRule::undistributeRemoveAfterEnumCollRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
-#ifdef USE_ENTERPRISE
     registerRule("remove-satellite-joins",
                  removeSatelliteJoinsRule,
                  OptimizerRule::removeSatelliteJoinsRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
-#endif
 
 #ifdef USE_IRESEARCH
   // distribute view queries in cluster
@@ -333,6 +347,44 @@ void OptimizerRulesFeature::addRules() {
                  OptimizerRule::restrictToSingleShardRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
   }
 
+  // let SORT keep only the rows needed by a following LIMIT
+  registerRule("sort-limit", sortLimitRule,
+               OptimizerRule::applySortLimitRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // reuse the results of correlated subqueries for repeated inputs
+  registerRule("cache-subquery-results", cacheSubqueryResultsRule,
+               OptimizerRule::cacheSubqueryResultsRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // replace the inner loop of an equi-join with a hash join. in the cluster,
+  // the hash join is executed on the DB servers for the local shards
+  registerRule("use-hash-join", hashJoinRule,
+               OptimizerRule::hashJoinRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // overlap the network round trips of independent subqueries
+    registerRule("parallelize-subqueries", parallelizeSubqueriesRule,
+                 OptimizerRule::parallelizeSubqueriesRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+    // send hash join input rows only to the shard of their join value
+    registerRule("distribute-hash-join-in-cluster", distributeHashJoinInClusterRule,
+                 OptimizerRule::distributeHashJoinInClusterRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+  }
+
+  if (arangodb::ServerState::instance()->isSingleServer()) {
+    // replace the collection loop of correlated subqueries by a hash join
+    registerRule("decorrelate-subqueries", decorrelateSubqueriesRule,
+                 OptimizerRule::decorrelateSubqueriesRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+    // replace the inner index lookup of an equi-join with a merge join
+    registerRule("use-merge-join", mergeJoinRule,
+                 OptimizerRule::mergeJoinRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+    // read the full documents of an index scan only for the rows that
+    // remain after a LIMIT
+    registerRule("late-document-materialization", lateDocumentMaterializationRule,
+                 OptimizerRule::lateDocumentMaterializationRule, DoesNotCreateAdditionalPlans, CanBeDisabled);
+  }
+
   // finally add the storage-engine specific rules
   addStorageEngineRules();
 }
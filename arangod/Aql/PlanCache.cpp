@@ -23,22 +23,161 @@
 
 #include "PlanCache.h"
 #include "Aql/Ast.h"
+#include "Aql/AstNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Query.h"
 #include "Aql/QueryString.h"
+#include "Basics/Exceptions.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/fasthash.h"
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb::aql;
 
+namespace {
+
+/// @brief create the value of an AST value node from a scalar bind parameter.
+/// this must classify values in the same way as Ast::nodeFromVPack does
+AstNodeValue valueFromVPack(VPackSlice const& slice) {
+  if (slice.isBoolean()) {
+    return AstNodeValue(slice.getBoolean());
+  }
+  if (slice.isNumber()) {
+    if (slice.isSmallInt() || slice.isInt()) {
+      return AstNodeValue(slice.getInt());
+    }
+    return AstNodeValue(slice.getNumber<double>());
+  }
+  if (slice.isString()) {
+    VPackValueLength length;
+    char const* p = slice.getString(length);
+    return AstNodeValue(p, static_cast<uint32_t>(length));
+  }
+  TRI_ASSERT(slice.isNull());
+  return AstNodeValue();
+}
+
+/// @brief mark the bind parameter occurrences contained in a (part of a)
+/// serialized execution plan. returns false if the plan cannot be reused
+/// with other bind parameter values
+bool collectBindParameterIds(VPackSlice slice, bool inArray,
+                             std::vector<bool>& seen) {
+  if (slice.isArray()) {
+    for (auto const& it : VPackArrayIterator(slice)) {
+      if (!collectBindParameterIds(it, inArray, seen)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (!slice.isObject()) {
+    return true;
+  }
+
+  VPackSlice type = slice.get("type");
+  if (type.isString()) {
+    if (type.isEqualString("value")) {
+      VPackSlice id = slice.get("bindParameter");
+      if (id.isNumber()) {
+        if (inArray) {
+          // the optimizer may have sorted or deduplicated the array
+          // members based on their actual values
+          return false;
+        }
+        size_t const i = id.getNumber<size_t>();
+        if (i == 0 || i > seen.size()) {
+          return false;
+        }
+        seen[i - 1] = true;
+      }
+      return true;
+    }
+    if (type.isEqualString("array")) {
+      inArray = true;
+    }
+  }
+
+  for (auto const& it : VPackObjectIterator(slice)) {
+    if (!collectBindParameterIds(it.value, inArray, seen)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief whether or not a serialized plan can be reused with different
+/// values for its scalar bind parameters. this is only the case if every
+/// occurrence of a bind parameter in the query is still present in the
+/// optimized plan. if an occurrence is missing, the optimizer has evaluated
+/// it, e.g. by constant folding or when removing a filter condition
+bool canReuse(VPackSlice plan, size_t occurrences) {
+  if (occurrences > AstNode::MaxBindParameterId) {
+    return false;
+  }
+
+  std::vector<bool> seen(occurrences, false);
+  if (!collectBindParameterIds(plan, false, seen)) {
+    return false;
+  }
+  return std::find(seen.begin(), seen.end(), false) == seen.end();
+}
+
+/// @brief copy a (part of a) serialized plan, putting in the actual values
+/// of the bind parameters
+void substituteBindParameters(VPackSlice slice, PlanCacheEntry const& entry,
+                              VPackSlice bindParameters, VPackBuilder& builder) {
+  if (slice.isArray()) {
+    builder.openArray();
+    for (auto const& it : VPackArrayIterator(slice)) {
+      substituteBindParameters(it, entry, bindParameters, builder);
+    }
+    builder.close();
+    return;
+  }
+
+  if (!slice.isObject()) {
+    builder.add(slice);
+    return;
+  }
+
+  VPackSlice id = slice.get("bindParameter");
+  if (id.isNumber()) {
+    size_t const i = id.getNumber<size_t>();
+    TRI_ASSERT(i > 0 && i <= entry.bindParameters.size());
+    std::string const& name = entry.bindParameters[i - 1];
+    VPackSlice value = bindParameters.get(name);
+
+    if (value.isNone()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_BIND_PARAMETER_MISSING,
+                                    name.c_str());
+    }
+
+    AstNode node(::valueFromVPack(value));
+    node.toVelocyPack(builder, true);
+    return;
+  }
+
+  builder.openObject();
+  for (auto const& it : VPackObjectIterator(slice, true)) {
+    builder.add(it.key);
+    substituteBindParameters(it.value, entry, bindParameters, builder);
+  }
+  builder.close();
+}
+
+} // namespace
+
 /// @brief singleton instance of the plan cache
 static arangodb::aql::PlanCache Instance;
 
 /// @brief create the plan cache
-PlanCache::PlanCache() : _lock(), _plans() {}
+PlanCache::PlanCache() : _lock(), _maxEntries(0), _plans() {}
 
 /// @brief destroy the plan cache
 PlanCache::~PlanCache() {}
@@ -63,6 +202,13 @@ std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase,
     return std::shared_ptr<PlanCacheEntry>();
   }
 
+  std::string const& cached = (*it2).second->queryString;
+  if (cached.size() != queryString.size() ||
+      memcmp(cached.data(), queryString.data(), queryString.size()) != 0) {
+    // hash collision
+    return std::shared_ptr<PlanCacheEntry>();
+  }
+
   // plan found in cache
   return (*it2).second;
 }
@@ -71,13 +217,36 @@ std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase,
 void PlanCache::store(
     TRI_vocbase_t* vocbase, uint64_t hash, QueryString const& queryString,
     ExecutionPlan const* plan) {
- 
-  auto entry = std::make_unique<PlanCacheEntry>(queryString.extract(SIZE_MAX), plan->toVelocyPack(plan->getAst(), true)); 
+  size_t const maxEntries = this->maxEntries();
+
+  if (maxEntries == 0) {
+    // cache turned off
+    return;
+  }
+
+  std::shared_ptr<VPackBuilder> builder = plan->toVelocyPack(plan->getAst(), true);
+  std::vector<std::string> bindParameters = plan->getAst()->bindParameterOccurrences();
+
+  if (!::canReuse(builder->slice(), bindParameters.size())) {
+    // the plan depends on the bind parameter values. still store an entry,
+    // so that further executions of the query do not try again
+    builder.reset();
+    bindParameters.clear();
+  }
+
+  auto entry = std::make_shared<PlanCacheEntry>(queryString.extract(SIZE_MAX), std::move(builder), std::move(bindParameters)); 
 
   WRITE_LOCKER(writeLocker, _lock);
+
+  auto& plans = _plans[vocbase];
+
+  if (plans.size() >= maxEntries) {
+    // cache is full. simply start over for this database
+    plans.clear();
+  }
   
   // store cache entry
-  _plans[vocbase].insert({hash, std::move(entry)});
+  plans[hash] = std::move(entry);
 }
 
 /// @brief invalidate all queries for a particular database
@@ -90,3 +259,38 @@ void PlanCache::invalidate(TRI_vocbase_t* vocbase) {
 /// @brief get the plan cache instance
 PlanCache* PlanCache::instance() { return &Instance; }
 
+/// @brief blend the bind parameters into a plan cache hash value
+uint64_t PlanCache::hashBindParameters(VPackSlice bindParameters, uint64_t hash) {
+  if (!bindParameters.isObject()) {
+    return hash;
+  }
+
+  for (auto const& it : VPackObjectIterator(bindParameters)) {
+    VPackValueLength l;
+    char const* name = it.key.getString(l);
+    hash = fasthash64(name, static_cast<size_t>(l), hash);
+
+    VPackSlice value = it.value;
+    if ((l > 0 && name[0] == '@') || value.isArray() || value.isObject()) {
+      // collection names and compound values are part of the plan
+      hash = value.hash(hash);
+    } else {
+      // for scalar values, only the type matters
+      uint8_t const type = static_cast<uint8_t>(::valueFromVPack(value).type);
+      hash = fasthash64(&type, sizeof(type), hash);
+    }
+  }
+
+  return hash;
+}
+
+/// @brief build the plan of a cache entry with the actual values of the
+/// bind parameters
+std::shared_ptr<VPackBuilder> PlanCache::instantiate(
+    PlanCacheEntry const& entry, VPackSlice bindParameters) {
+  TRI_ASSERT(entry.builder != nullptr);
+
+  auto builder = std::make_shared<VPackBuilder>();
+  ::substituteBindParameters(entry.builder->slice(), entry, bindParameters, *builder);
+  return builder;
+}
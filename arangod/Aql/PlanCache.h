@@ -27,6 +27,8 @@
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
 
+#include <velocypack/Slice.h>
+
 struct TRI_vocbase_t;
 
 namespace arangodb {
@@ -41,11 +43,22 @@ class VariableGenerator;
 
 struct PlanCacheEntry {
   PlanCacheEntry(std::string&& queryString, 
-                 std::shared_ptr<arangodb::velocypack::Builder>&& builder)
-      : queryString(std::move(queryString)), builder(std::move(builder)) {}
+                 std::shared_ptr<arangodb::velocypack::Builder>&& builder,
+                 std::vector<std::string>&& bindParameters)
+      : queryString(std::move(queryString)), 
+        builder(std::move(builder)),
+        bindParameters(std::move(bindParameters)) {}
 
   std::string queryString;
+
+  /// @brief the serialized execution plan. this is a nullptr if the plan 
+  /// depends on the actual values of the bind parameters, in which case it
+  /// cannot be reused
   std::shared_ptr<arangodb::velocypack::Builder> builder;
+
+  /// @brief names of the bind parameters whose values are put into the plan
+  /// when it is reused, indexed by the id of the occurrence minus one
+  std::vector<std::string> bindParameters;
 };
 
 class PlanCache {
@@ -69,13 +82,37 @@ class PlanCache {
   /// @brief invalidate all plans for a particular database
   void invalidate(TRI_vocbase_t*);
 
+  /// @brief return the maximum number of plans stored per database.
+  /// a value of 0 means the cache is turned off
+  size_t maxEntries() const { 
+    return _maxEntries.load(std::memory_order_relaxed); 
+  }
+
+  /// @brief set the maximum number of plans stored per database
+  void maxEntries(size_t value) {
+    _maxEntries.store(value, std::memory_order_relaxed);
+  }
+
   /// @brief get the pointer to the global plan cache
   static PlanCache* instance();
 
+  /// @brief blend the bind parameters into a plan cache hash value. for
+  /// scalar value bind parameters only the name and the value type are
+  /// used, so plans can be shared between queries with different values
+  static uint64_t hashBindParameters(arangodb::velocypack::Slice, uint64_t);
+
+  /// @brief build the plan of a cache entry with the actual values of the
+  /// bind parameters
+  static std::shared_ptr<arangodb::velocypack::Builder> instantiate(
+      PlanCacheEntry const&, arangodb::velocypack::Slice);
+
  private:
   /// @brief read-write lock for the cache
   arangodb::basics::ReadWriteLock _lock;
 
+  /// @brief maximum number of plans stored per database
+  std::atomic<size_t> _maxEntries;
+
   /// @brief cached query plans, organized per database
   std::unordered_map<TRI_vocbase_t*, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>> _plans;
 };
@@ -25,9 +25,11 @@
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/AqlTransaction.h"
+#include "Aql/Condition.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionPlan.h"
+#include "Aql/IndexNode.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Parser.h"
 #include "Aql/PlanCache.h"
@@ -36,11 +38,13 @@
 #include "Aql/QueryProfile.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/fasthash.h"
 #include "Cluster/ServerState.h"
 #include "Graph/Graph.h"
 #include "Graph/GraphManager.h"
+#include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "RestServer/AqlFeature.h"
 #include "RestServer/QueryRegistryFeature.h"
@@ -57,15 +61,158 @@
 
 #include <velocypack/Iterator.h>
 
-#ifndef USE_PLAN_CACHE
-#undef USE_PLAN_CACHE
-#endif
-
 using namespace arangodb;
 using namespace arangodb::aql;
 
 namespace {
 static std::atomic<TRI_voc_tick_t> nextQueryId(1);
+
+/// @brief add the key from a constant string value of _key or _id to the
+/// result. returns false if the value is not a string
+bool addKeyFromValue(AstNode const* value, bool isId,
+                     std::unordered_set<std::string>& keys) {
+  if (!value->isStringValue()) {
+    return false;
+  }
+  std::string key = value->getString();
+  if (isId) {
+    size_t pos = key.find('/');
+    if (pos != std::string::npos) {
+      key = key.substr(pos + 1);
+    }
+  }
+  keys.emplace(std::move(key));
+  return true;
+}
+
+/// @brief check whether the condition part is a comparison of the _key or
+/// _id attribute of the variable with constant strings, and collect them
+bool addKeysFromCompare(AstNode const* node, Variable const* variable,
+                        std::unordered_set<std::string>& keys) {
+  if (node->type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+      node->type != NODE_TYPE_OPERATOR_BINARY_IN) {
+    return false;
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    AstNode const* lhs = node->getMember(i);
+    AstNode const* rhs = node->getMember(1 - i);
+
+    if (lhs->type != NODE_TYPE_ATTRIBUTE_ACCESS ||
+        lhs->getMember(0)->type != NODE_TYPE_REFERENCE ||
+        static_cast<Variable const*>(lhs->getMember(0)->getData()) != variable) {
+      continue;
+    }
+
+    std::string const attribute = lhs->getString();
+    bool const isId = (attribute == StaticStrings::IdString);
+    if (!isId && attribute != StaticStrings::KeyString) {
+      continue;
+    }
+
+    if (node->type == NODE_TYPE_OPERATOR_BINARY_EQ) {
+      return addKeyFromValue(rhs, isId, keys);
+    }
+    if (i == 0 && rhs->isArray() && rhs->isConstant()) {
+      // attribute IN [ ... ]
+      for (size_t j = 0; j < rhs->numMembers(); ++j) {
+        if (!addKeyFromValue(rhs->getMemberUnchecked(j), isId, keys)) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief collect the keys an index node looks up in a primary index.
+/// returns false if the node may read other documents
+bool addKeysFromIndexNode(IndexNode const* node,
+                          std::unordered_set<std::string>& keys) {
+  for (auto const& handle : node->getIndexes()) {
+    if (handle.getIndex()->type() != Index::TRI_IDX_TYPE_PRIMARY_INDEX) {
+      return false;
+    }
+  }
+
+  AstNode const* root = node->condition()->root();
+  if (root == nullptr || root->numMembers() == 0) {
+    return false;
+  }
+
+  // each OR branch must restrict the primary key to constant values
+  for (size_t i = 0; i < root->numMembers(); ++i) {
+    AstNode const* andNode = root->getMemberUnchecked(i);
+    bool found = false;
+    for (size_t j = 0; j < andNode->numMembers(); ++j) {
+      if (addKeysFromCompare(andNode->getMemberUnchecked(j), node->outVariable(), keys)) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief determine the collections that the plan accesses only via lookups
+/// of constant primary keys, together with these keys. the query cache uses
+/// this to invalidate results only when one of these documents is modified
+std::unordered_map<std::string, std::unordered_set<std::string>> keysReadByPlan(
+    ExecutionPlan* plan, Ast const* ast) {
+  std::unordered_map<std::string, std::unordered_set<std::string>> result;
+
+  if (ast->functionsMayAccessDocuments()) {
+    // DOCUMENT() & co. may read arbitrary documents
+    return result;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, {
+    ExecutionNode::TRAVERSAL, ExecutionNode::SHORTEST_PATH,
+#ifdef USE_IRESEARCH
+    ExecutionNode::ENUMERATE_IRESEARCH_VIEW,
+#endif
+  }, true);
+
+  if (!nodes.empty()) {
+    // graph and view nodes access collections in their own ways
+    return result;
+  }
+
+  plan->findNodesOfType(nodes, {
+    ExecutionNode::ENUMERATE_COLLECTION, ExecutionNode::INDEX,
+    ExecutionNode::HASH_JOIN, ExecutionNode::MERGE_JOIN,
+    ExecutionNode::MATERIALIZE }, true);
+
+  std::unordered_set<std::string> fullyRead;
+  for (auto const& node : nodes) {
+    auto const* accessing = dynamic_cast<CollectionAccessingNode const*>(node);
+    TRI_ASSERT(accessing != nullptr);
+    std::string const& name = accessing->collection()->name();
+
+    if (fullyRead.find(name) != fullyRead.end()) {
+      continue;
+    }
+
+    if (node->getType() == ExecutionNode::INDEX) {
+      std::unordered_set<std::string> keys;
+      if (addKeysFromIndexNode(ExecutionNode::castTo<IndexNode const*>(node), keys)) {
+        result[name].insert(keys.begin(), keys.end());
+        continue;
+      }
+    }
+
+    fullyRead.emplace(name);
+    result.erase(name);
+  }
+
+  return result;
+}
 }
 
 /// @brief creates a query
@@ -222,6 +369,7 @@ Query::~Query() {
   cleanupPlanAndEngineSync(TRI_ERROR_INTERNAL);
 
   exitContext();
+  _userFunctionCall.Reset();
 
   _ast.reset();
   _graphs.clear();
@@ -348,76 +496,34 @@ void Query::registerWarning(int code, char const* details) {
   }
 }
 
-void Query::prepare(QueryRegistry* registry) {
-  TRI_ASSERT(registry != nullptr);
-
-  init();
-  enterState(QueryExecutionState::ValueType::PARSING);
-
-  std::unique_ptr<ExecutionPlan> plan;
-
-#if USE_PLAN_CACHE
-  if (!_queryString.empty() &&
-      hashQuery() != DontCache &&
-      _part == PART_MAIN) {
-    // LOG_TOPIC(INFO, Logger::FIXME) << "trying to find query in execution plan cache: '" << _queryString << "', hash: " << hashQuery();
-
-    // store & lookup velocypack plans!!
-    std::shared_ptr<PlanCacheEntry> planCacheEntry = PlanCache::instance()->lookup(_vocbase, hashQuery(), queryString);
-    if (planCacheEntry != nullptr) {
-      // LOG_TOPIC(INFO, Logger::FIXME) << "query found in execution plan cache: '" << _queryString << "'";
-
-      TRI_ASSERT(_trx == nullptr);
-      TRI_ASSERT(_collections.empty());
-
-      // create the transaction object, but do not start it yet
-      _trx = AqlTransaction::create(
-              createTransactionContext(), _collections.collections(),
-              _queryOptions.transactionOptions,
-              _part == PART_MAIN);
-
-      VPackBuilder* builder = planCacheEntry->builder.get();
-      VPackSlice slice = builder->slice();
-      ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), slice);
-      _ast->variables()->fromVelocyPack(slice);
-
-      enterState(QueryExecutionState::ValueType::LOADING_COLLECTIONS);
-
-      int res = trx->addCollections(*_collections.collections());
-
-      if (res == TRI_ERROR_NO_ERROR) {
-        res = _trx->begin();
-      }
-
-      if (res != TRI_ERROR_NO_ERROR) {
-        THROW_ARANGO_EXCEPTION_MESSAGE(res, buildErrorMessage(res));
-      }
+size_t Query::memoryUsage() const {
+  int64_t remote = _remoteMemoryUsage.load(std::memory_order_relaxed);
+  return _resourceMonitor.currentResources.memoryUsage +
+         static_cast<size_t>((std::max)(remote, int64_t(0)));
+}
 
-      enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
+size_t Query::peakMemoryUsage() const {
+  int64_t remote = _remotePeakMemoryUsage.load(std::memory_order_relaxed);
+  return _resourceMonitor.peakResources.memoryUsage +
+         static_cast<size_t>((std::max)(remote, int64_t(0)));
+}
 
-      plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), slice));
+void Query::addRemoteMemoryUsage(int64_t current, int64_t peak) {
+  _remoteMemoryUsage.fetch_add(current, std::memory_order_relaxed);
+  _remotePeakMemoryUsage.fetch_add(peak, std::memory_order_relaxed);
+}
 
-      TRI_ASSERT(plan != nullptr);
-    }
-  }
-#endif
+void Query::prepare(QueryRegistry* registry) {
+  TRI_ASSERT(registry != nullptr);
 
-  if (plan == nullptr) {
-    plan.reset(preparePlan());
+  // do not start while the queries of this server have used up their
+  // memory budget
+  GlobalResourceMonitor::instance().admit();
 
-    TRI_ASSERT(plan != nullptr);
+  init();
+  enterState(QueryExecutionState::ValueType::PARSING);
 
-#if USE_PLAN_CACHE
-    if (!_queryString.empty() &&
-        hashQuery() != DontCache &&
-        _part == PART_MAIN &&
-        _warnings.empty() &&
-        _ast->root()->isCacheable()) {
-      // LOG_TOPIC(INFO, Logger::FIXME) << "storing query in execution plan cache '" << _queryString << "', hash: " << hashQuery();
-      PlanCache::instance()->store(_vocbase, hashQuery(), _queryString, plan.get());
-    }
-#endif
-  }
+  std::unique_ptr<ExecutionPlan> plan(preparePlan());
 
   TRI_ASSERT(plan != nullptr);
   plan->findVarUsage();
@@ -459,7 +565,26 @@ ExecutionPlan* Query::preparePlan() {
     );
   }
 
-  if (!_queryString.empty()) {
+  // look up the query's plan in the plan cache
+  bool const usePlanCache = canUsePlanCache();
+  uint64_t planCacheHash = 0;
+  std::shared_ptr<PlanCacheEntry> planCacheEntry;
+  std::shared_ptr<VPackBuilder> cachedPlan;
+
+  if (usePlanCache) {
+    planCacheHash = calculatePlanCacheHash();
+    planCacheEntry = PlanCache::instance()->lookup(&_vocbase, planCacheHash, _queryString);
+
+    if (planCacheEntry != nullptr && planCacheEntry->builder != nullptr) {
+      // found a reusable plan. put in the values of the bind parameters
+      auto bindParameters = _bindParameters.builder();
+      cachedPlan = PlanCache::instantiate(
+          *planCacheEntry, 
+          bindParameters != nullptr ? bindParameters->slice() : VPackSlice::emptyObjectSlice());
+    }
+  }
+
+  if (!_queryString.empty() && cachedPlan == nullptr) {
     Parser parser(this);
     parser.parse();
 
@@ -490,7 +615,7 @@ ExecutionPlan* Query::preparePlan() {
 
   // As soon as we start to instantiate the plan we have to clean it
   // up before killing the unique_ptr
-  if (!_queryString.empty()) {
+  if (!_queryString.empty() && cachedPlan == nullptr) {
     // we have an AST
     // optimize the ast
     enterState(QueryExecutionState::ValueType::AST_OPTIMIZATION);
@@ -520,10 +645,26 @@ ExecutionPlan* Query::preparePlan() {
     opt.createPlans(std::move(plan), _queryOptions, false);
     // Now plan and all derived plans belong to the optimizer
     plan = opt.stealBest();  // Now we own the best one again
-  } else {  // no queryString, we are instantiating from _queryBuilder
-    VPackSlice const querySlice = _queryBuilder->slice();
+
+    if (usePlanCache && planCacheEntry == nullptr && _warnings.empty() &&
+        _views.empty() && _ast->root()->isCacheable()) {
+      PlanCache::instance()->store(&_vocbase, planCacheHash, _queryString, plan.get());
+    }
+  } else {
+    // no queryString, we are instantiating from _queryBuilder, or we are
+    // using a plan from the plan cache
+    VPackSlice const querySlice = 
+      (cachedPlan != nullptr) ? cachedPlan->slice() : _queryBuilder->slice();
     ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), querySlice);
 
+    if (cachedPlan != nullptr) {
+      // the parser has not run, so take over its findings from the plan
+      VPackSlice s = querySlice.get("isModificationQuery");
+      if (s.isBoolean() && s.getBoolean()) {
+        setIsModificationQuery();
+      }
+    }
+
     _ast->variables()->fromVelocyPack(querySlice);
     // creating the plan may have produced some collections
     // we need to add them to the transaction now (otherwise the query will
@@ -543,7 +684,7 @@ ExecutionPlan* Query::preparePlan() {
     enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
 
     // we have an execution plan in VelocyPack format
-    plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), _queryBuilder->slice()));
+    plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), querySlice));
     if (plan == nullptr) {
       // oops
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "could not create plan from vpack");
@@ -647,7 +788,7 @@ ExecutionState Query::execute(QueryRegistry* registry, QueryResult& queryResult)
         // In case of WAITING we return, this function is repeatable!
         // In case of HASMORE we loop
         while (true) {
-          auto res = _engine->getSome(ExecutionBlock::DefaultBatchSize());
+          auto res = _engine->getSome(_engine->root()->batchSize());
           if (res.first == ExecutionState::WAITING) {
             return res.first;
           }
@@ -694,6 +835,7 @@ ExecutionState Query::execute(QueryRegistry* registry, QueryResult& queryResult)
               bindParameters(),
               _trx->state()->collectionNames(_views)
           );
+          _cacheEntry->_dataSourceKeys = ::keysReadByPlan(_plan.get(), _ast.get());
         }
 
         queryResult.result = std::move(_resultBuilder);
@@ -849,11 +991,11 @@ ExecutionState Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry, Q
       uint32_t j = 0;
       ExecutionState state = ExecutionState::HASMORE;
       while (state != ExecutionState::DONE) {
-        auto res = _engine->getSome(ExecutionBlock::DefaultBatchSize());
+        auto res = _engine->getSome(_engine->root()->batchSize());
         state = res.first;
         while (state == ExecutionState::WAITING) {
           ss->waitForAsyncResponse();
-          res = _engine->getSome(ExecutionBlock::DefaultBatchSize());
+          res = _engine->getSome(_engine->root()->batchSize());
           state = res.first;
         }
         value.swap(res.second);
@@ -910,6 +1052,7 @@ ExecutionState Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry, Q
           bindParameters(),
           _trx->state()->collectionNames(_views)
       );
+      _cacheEntry->_dataSourceKeys = ::keysReadByPlan(_plan.get(), _ast.get());
     }
     // will set warnings, stats, profile and cleanup plan and engine
     ExecutionState state = finalize(queryResult);
@@ -963,7 +1106,12 @@ ExecutionState Query::finalize(QueryResult& result) {
 
     result.extra = std::make_shared<VPackBuilder>();
     result.extra->openObject(true);
-    if (_queryOptions.profile >= PROFILE_LEVEL_BLOCKS) {
+    if (_profileSampled) {
+      _profileSample = std::make_shared<VPackBuilder>();
+      _profileSample->openObject();
+      _profileSample->add(VPackValue("plan"));
+      _plan->toVelocyPack(*_profileSample, _ast.get(), false);
+    } else if (_queryOptions.profile >= PROFILE_LEVEL_BLOCKS) {
       result.extra->add(VPackValue("plan"));
       _plan->toVelocyPack(*result.extra, _ast.get(), false);
       // needed to happen before plan cleanup
@@ -976,8 +1124,16 @@ ExecutionState Query::finalize(QueryResult& result) {
   }
 
   addWarningsToVelocyPack(*result.extra);
+  if (_queryOptions.continuation) {
+    if (_continuation.empty()) {
+      result.extra->add("continuation", VPackValue(VPackValueType::Null));
+    } else {
+      result.extra->add("continuation", VPackValue(_continuation));
+    }
+  }
   double now = TRI_microtime();
-  if (_profile != nullptr && _queryOptions.profile >= PROFILE_LEVEL_BASIC) {
+  if (_profile != nullptr && _queryOptions.profile >= PROFILE_LEVEL_BASIC &&
+      !_profileSampled) {
     _profile->setStateEnd(QueryExecutionState::ValueType::FINALIZATION, now);
     _profile->toVelocyPack(*(result.extra));
   }
@@ -1164,6 +1320,17 @@ void Query::prepareV8Context() {
     if (!compiled.IsEmpty()) {
       compiled->Run();
       _preparedV8Context = true;
+
+      _userFunctionCall.Reset();
+      v8::Handle<v8::Value> module = isolate->GetCurrentContext()->Global()->Get(
+          TRI_V8_ASCII_STRING(isolate, "_AQL"));
+      if (!module.IsEmpty() && module->IsObject()) {
+        v8::Handle<v8::Value> function = v8::Handle<v8::Object>::Cast(module)->Get(
+            TRI_V8_ASCII_STRING(isolate, "FCALL_USER"));
+        if (!function.IsEmpty() && function->IsFunction()) {
+          _userFunctionCall.Reset(isolate, v8::Handle<v8::Function>::Cast(function));
+        }
+      }
     }
   }
 }
@@ -1214,6 +1381,9 @@ void Query::exitContext() {
         ctx->unregisterTransaction();
       }
 
+      // the cached function handle belongs to the context being left
+      _userFunctionCall.Reset();
+
       TRI_ASSERT(V8DealerFeature::DEALER != nullptr);
       V8DealerFeature::DEALER->exitContext(_context);
       _context = nullptr;
@@ -1259,6 +1429,15 @@ void Query::init() {
   _id = nextId();
   TRI_ASSERT(_id != 0);
 
+  if (_part == PART_MAIN && _queryOptions.profile == PROFILE_LEVEL_NONE &&
+      !_queryOptions.stream && !_queryString.empty() &&
+      _vocbase.queryList()->sampleProfile()) {
+    // profile this query at block level, but report the results only
+    // in the list of slow queries
+    _queryOptions.profile = PROFILE_LEVEL_BLOCKS;
+    _profileSampled = true;
+  }
+
   TRI_ASSERT(_profile == nullptr);
   // adds query to QueryList which is needed for /_api/query/current
   _profile.reset(new QueryProfile(this));
@@ -1321,12 +1500,55 @@ uint64_t Query::calculateHash() const {
   return hash ^ _bindParameters.hash();
 }
 
+/// @brief calculate the hash value under which the query's plan is stored
+/// in the plan cache. this only uses the types of scalar bind parameter
+/// values, so that the plan can be reused when only their values differ
+uint64_t Query::calculatePlanCacheHash() const {
+  TRI_ASSERT(!_queryString.empty());
+
+  // hash the query string first
+  uint64_t hash = _queryString.hash();
+
+  // all query options may influence the plan, e.g. the optimizer rules or
+  // the "fullCount" option
+  if (_options != nullptr && _options->slice().isObject()) {
+    hash = _options->slice().hash(hash);
+  }
+  if (_queryOptions.fullCount) {
+    hash = fasthash64(TRI_CHAR_LENGTH_PAIR("fullcount:true"), hash);
+  } else {
+    hash = fasthash64(TRI_CHAR_LENGTH_PAIR("fullcount:false"), hash);
+  }
+
+  auto bindParameters = _bindParameters.builder();
+  if (bindParameters != nullptr) {
+    hash = PlanCache::hashBindParameters(bindParameters->slice(), hash);
+  }
+  return hash;
+}
+
+/// @brief whether or not the plan cache can be used for the query
+bool Query::canUsePlanCache() const {
+  if (_queryString.empty() || _part != PART_MAIN) {
+    return false;
+  }
+
+  if (PlanCache::instance()->maxEntries() == 0) {
+    // plan cache turned off
+    return false;
+  }
+
+  // cannot use plan cache on a coordinator at the moment
+  return !arangodb::ServerState::instance()->isRunningInCluster();
+}
+
 /// @brief whether or not the query cache can be used for the query
 bool Query::canUseQueryCache() const {
   if (_queryString.size() < 8) {
     return false;
   }
-  if (_isModificationQuery) {
+  if (_isModificationQuery || _queryOptions.continuation) {
+    // the continuation token differs between the pages
     return false;
   }
 
@@ -1396,6 +1618,15 @@ ExecutionState Query::cleanupPlanAndEngine(int errorCode, VPackBuilder* statsBui
       if (state == ExecutionState::WAITING) {
         return state;
       }
+      if (_profileSample != nullptr && _profileSample->isOpenObject()) {
+        // keep the per-node statistics of a sampled query out of the result
+        _profileSample->add(VPackValue("stats"));
+        _engine->_stats.toVelocyPack(*_profileSample, _queryOptions.fullCount);
+        _profileSample->add("peakMemoryUsage", VPackValue(peakMemoryUsage()));
+        _profileSample->close();
+        _engine->_stats.nodes.clear();
+        _engine->_stats.spans.clear();
+      }
       if (statsBuilder != nullptr) {
         TRI_ASSERT(statsBuilder->isOpenObject());
         statsBuilder->add(VPackValue("stats"));
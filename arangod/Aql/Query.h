@@ -141,15 +141,35 @@ class Query {
     return _profile.get();
   }
 
+  /// @brief block-level profile of a sampled query, only set once the
+  /// query has been finalized
+  std::shared_ptr<velocypack::Builder> profileSample() const {
+    if (_profileSample == nullptr || !_profileSample->isClosed()) {
+      return nullptr;
+    }
+    return _profileSample;
+  }
+
   velocypack::Slice optionsSlice() const { return _options->slice(); }
   TEST_VIRTUAL QueryOptions const& queryOptions() const { return _queryOptions; }
   TEST_VIRTUAL QueryOptions& queryOptions() { return _queryOptions; }
 
+  /// @brief sets the continuation token that is returned with the results
+  void continuation(std::string&& token) { _continuation = std::move(token); }
+
   void increaseMemoryUsage(size_t value) { _resourceMonitor.increaseMemoryUsage(value); }
   void decreaseMemoryUsage(size_t value) { _resourceMonitor.decreaseMemoryUsage(value); }
 
   ResourceMonitor* resourceMonitor() { return &_resourceMonitor; }
 
+  /// @brief memory used by the query, including what its snippets on other
+  /// servers have reported so far
+  size_t memoryUsage() const;
+  size_t peakMemoryUsage() const;
+
+  /// @brief adds changes of the memory used by a remote snippet
+  void addRemoteMemoryUsage(int64_t current, int64_t peak);
+
   /// @brief return the start timestamp of the query
   double startTime() const { return _startTime; }
 
@@ -193,6 +213,9 @@ class Query {
   /// @brief add a node to the list of nodes
   void addNode(AstNode* node) { _resources.addNode(node); }
 
+  /// @brief create an AST node in the query's node arena
+  AstNode* createNode(AstNodeType type) { return _resources.createNode(type); }
+
   /// @brief register a string
   /// the string is freed when the query is destroyed
   char* registerString(char const* p, size_t length) { return _resources.registerString(p, length); }
@@ -282,6 +305,14 @@ class Query {
   // @brief resets the contexts load-state of the AQL functions.
   void unPrepareV8Context() {
     _preparedV8Context = false;
+    _userFunctionCall.Reset();
+  }
+
+  /// @brief the JavaScript function dispatching calls to user-defined
+  /// functions, resolved once by prepareV8Context(). returns an empty
+  /// handle if it could not be resolved
+  v8::Local<v8::Function> userFunctionCall(v8::Isolate* isolate) const {
+    return v8::Local<v8::Function>::New(isolate, _userFunctionCall);
   }
 
   /// @brief returns statistics for current query.
@@ -318,6 +349,26 @@ class Query {
   
   /// @brief pass-thru a resolver object from the transaction context
   CollectionNameResolver const& resolver();
+
+  /// @brief remember the first results of a DB server snippet, which were
+  /// returned together with the response to the snippet's setup
+  void addSnippetSetupResult(std::string const& snippetId,
+                             std::shared_ptr<arangodb::velocypack::Builder> result) {
+    _snippetSetupResults.emplace(snippetId, std::move(result));
+  }
+
+  /// @brief return and forget the setup results of a DB server snippet.
+  /// returns a nullptr if the snippet did not return any results yet
+  std::shared_ptr<arangodb::velocypack::Builder> stealSnippetSetupResult(
+      std::string const& snippetId) {
+    auto it = _snippetSetupResults.find(snippetId);
+    if (it == _snippetSetupResults.end()) {
+      return nullptr;
+    }
+    auto result = std::move((*it).second);
+    _snippetSetupResults.erase(it);
+    return result;
+  }
   
  private:
   /// @brief initializes the query
@@ -338,6 +389,13 @@ class Query {
   /// @brief calculate a hash value for the query string and bind parameters
   uint64_t calculateHash() const;
 
+  /// @brief calculate a hash value for the query string and the types of
+  /// the bind parameters, used as the key for the plan cache
+  uint64_t calculatePlanCacheHash() const;
+
+  /// @brief whether or not the plan cache can be used for the query
+  bool canUsePlanCache() const;
+
   /// @brief whether or not the query cache can be used for the query
   bool canUseQueryCache() const;
 
@@ -425,6 +483,13 @@ class Query {
   /// @brief warnings collected during execution
   std::vector<std::pair<int, std::string>> _warnings;
 
+  /// @brief continuation token for the next page, empty if there is none
+  std::string _continuation;
+
+  /// @brief first results of DB server snippets, by snippet id
+  std::unordered_map<std::string, std::shared_ptr<arangodb::velocypack::Builder>>
+      _snippetSetupResults;
+
   /// @brief cache for regular expressions constructed by the query
   RegexCache _regexCache;
 
@@ -448,6 +513,10 @@ class Query {
   /// it needs to be run once before any V8-based function is called
   bool _preparedV8Context;
 
+  /// @brief cached handle of _AQL.FCALL_USER in the current V8 context, so
+  /// user-defined function calls do not look it up by name for every row
+  v8::Persistent<v8::Function> _userFunctionCall;
+
   /// Create the result in this builder. It is also used to determine
   /// if we are continuing the query or of we called
   std::shared_ptr<arangodb::velocypack::Builder> _resultBuilder;
@@ -475,6 +544,17 @@ class Query {
   
   /// @brief whether or not the hash was already calculated
   mutable bool _queryHashCalculated = false;
+
+  /// @brief whether the query was picked for sampled profiling
+  bool _profileSampled = false;
+
+  /// @brief plan and per-node statistics of a sampled query
+  std::shared_ptr<velocypack::Builder> _profileSample;
+
+  /// @brief memory reported by the snippets on other servers. updated by
+  /// the RemoteBlocks, and read by the query list
+  std::atomic<int64_t> _remoteMemoryUsage{0};
+  std::atomic<int64_t> _remotePeakMemoryUsage{0};
 };
 
 }
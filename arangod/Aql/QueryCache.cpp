@@ -58,6 +58,22 @@ static std::atomic<bool> includeSystem(false); // default value. can be changed
 
 /// @brief whether or not the query cache will return bind vars in its list of cached results
 static bool showBindVars = true; // will be set once on startup. cannot be changed at runtime
+
+/// @brief approximate overhead of a node in a hash table
+constexpr size_t hashNodeOverhead = 2 * sizeof(void*);
+
+/// @brief memory used by a builder, including the allocated buffer
+size_t memoryUsage(std::shared_ptr<VPackBuilder> const& builder) {
+  if (builder == nullptr) {
+    return 0;
+  }
+  size_t size = sizeof(VPackBuilder);
+  auto const& buffer = builder->buffer();
+  if (buffer != nullptr) {
+    size += sizeof(*buffer) + buffer->capacity();
+  }
+  return size;
+}
 }
 
 /// @brief create a cache entry
@@ -72,24 +88,39 @@ QueryCacheResultEntry::QueryCacheResultEntry(
       _queryResult(queryResult),
       _bindVars(bindVars),
       _dataSources(std::move(dataSources)),
-      _size(_queryString.size()),
+      _size(0),
       _rows(0),
       _hits(0),
+      _referenced(false),
       _stamp(0.0),
       _prev(nullptr),
       _next(nullptr) {
-  // add result size
   try {
     if (_queryResult) {
-      _size += _queryResult->size();
       _rows = _queryResult->slice().length();
     }
-    if (_bindVars) {
-      _size += _bindVars->size();
-    }
+    _size = memoryUsage();
   } catch (...) {}
 }
 
+/// @brief approximate memory used by the entry
+size_t QueryCacheResultEntry::memoryUsage() const {
+  size_t size = sizeof(QueryCacheResultEntry) + _queryString.capacity() +
+                ::memoryUsage(_queryResult) + ::memoryUsage(_bindVars) +
+                ::memoryUsage(_stats);
+
+  for (auto const& it : _dataSources) {
+    size += sizeof(std::string) + it.capacity();
+  }
+  for (auto const& it : _dataSourceKeys) {
+    size += sizeof(it) + it.first.capacity();
+    for (auto const& key : it.second) {
+      size += ::hashNodeOverhead + sizeof(std::string) + key.capacity();
+    }
+  }
+  return size;
+}
+
 double QueryCacheResultEntry::executionTime() const {
   if (!_stats) {
     return -1.0;
@@ -114,6 +145,30 @@ double QueryCacheResultEntry::executionTime() const {
   return -1.0;
 }
 
+/// @brief whether or not the result depends on any of the keys of the
+/// data source
+bool QueryCacheResultEntry::dependsOnKeys(
+    std::string const& dataSource,
+    std::unordered_set<std::string> const& keys) const {
+  auto it = _dataSourceKeys.find(dataSource);
+
+  if (it == _dataSourceKeys.end()) {
+    // data source was not only accessed by key
+    return true;
+  }
+
+  auto const& ours = (*it).second;
+  auto const& smaller = (ours.size() < keys.size()) ? ours : keys;
+  auto const& larger = (ours.size() < keys.size()) ? keys : ours;
+
+  for (auto const& key : smaller) {
+    if (larger.find(key) != larger.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void QueryCacheResultEntry::toVelocyPack(VPackBuilder& builder) const {
   builder.openObject();
  
@@ -319,15 +374,70 @@ void QueryCacheDatabaseEntry::invalidate(std::string const& dataSource) {
   _entriesByDataSource.erase(it);
 }
 
+/// @brief invalidate all entries for a data source in the database-specific
+/// cache that depend on any of the given document keys
+void QueryCacheDatabaseEntry::invalidate(
+    std::string const& dataSource, std::unordered_set<std::string> const& keys) {
+  auto it = _entriesByDataSource.find(dataSource);
+
+  if (it == _entriesByDataSource.end()) {
+    return;
+  }
+
+  std::vector<uint64_t> hashes;
+  for (auto const& hash : (*it).second) {
+    auto it2 = _entriesByHash.find(hash);
+
+    if (it2 == _entriesByHash.end() ||
+        (*it2).second->dependsOnKeys(dataSource, keys)) {
+      hashes.emplace_back(hash);
+    }
+  }
+
+  for (auto const& hash : hashes) {
+    auto it2 = _entriesByHash.find(hash);
+
+    if (it2 != _entriesByHash.end()) {
+      // remove entry from the linked list and all data sources
+      auto entry = (*it2).second;
+      removeDatasources(entry.get());
+      unlink(entry.get());
+
+      // erase it from hash table
+      _entriesByHash.erase(it2);
+    } else {
+      // entry is already gone
+      (*it).second.erase(hash);
+    }
+  }
+
+  if ((*it).second.empty()) {
+    _entriesByDataSource.erase(it);
+  }
+}
+
 /// @brief enforce maximum number of results
 /// must be called under the shard's lock
 void QueryCacheDatabaseEntry::enforceMaxResults(size_t numResults, size_t sizeResults) {
+  size_t skipped = 0;
   while (_numResults > numResults || 
          _sizeResults > sizeResults) {
     // too many elements. now wipe the first element from the list
 
     // copy old _head value as unlink() will change it...
     auto head = _head;
+
+    if (skipped < _numResults &&
+        head->_referenced.exchange(false, std::memory_order_relaxed)) {
+      // entry was used recently. give it a second chance by moving it to
+      // the end of the list. after a full round all entries have lost their
+      // flag, so the loop will terminate
+      unlink(head);
+      link(head);
+      ++skipped;
+      continue;
+    }
+
     removeDatasources(head);
     unlink(head);
     auto it = _entriesByHash.find(head->_hash);
@@ -599,6 +709,9 @@ std::shared_ptr<QueryCacheResultEntry> QueryCache::lookup(TRI_vocbase_t* vocbase
 void QueryCache::store(TRI_vocbase_t* vocbase, std::shared_ptr<QueryCacheResultEntry> entry) {
   TRI_ASSERT(entry != nullptr);
   auto* e = entry.get();
+
+  // statistics and keys have been set after the entry was created
+  e->_size = e->memoryUsage();
   
   if (e->_size > ::maxEntrySize.load()) {
     // entry is too big
@@ -678,6 +791,23 @@ void QueryCache::invalidate(TRI_vocbase_t* vocbase, std::string const& dataSourc
   (*it).second->invalidate(dataSource);
 }
 
+/// @brief invalidate all queries for a particular data source that depend
+/// on any of the given document keys
+void QueryCache::invalidate(TRI_vocbase_t* vocbase, std::string const& dataSource,
+                            std::unordered_set<std::string> const& keys) {
+  auto const part = getPart(vocbase);
+  WRITE_LOCKER(writeLocker, _entriesLock[part]);
+
+  auto it = _entries[part].find(vocbase);
+
+  if (it == _entries[part].end()) {
+    return;
+  }
+
+  // invalidate while holding the lock
+  (*it).second->invalidate(dataSource, keys);
+}
+
 /// @brief invalidate all queries for a particular database
 void QueryCache::invalidate(TRI_vocbase_t* vocbase) {
   std::unique_ptr<QueryCacheDatabaseEntry> databaseQueryCache;
@@ -27,7 +27,7 @@
 #include "Aql/QueryString.h"
 #include "Basics/Common.h"
 #include "Basics/Mutex.h"
-#include "Basics/ReadWriteLock.h"
+#include "Basics/StripedReadWriteLock.h"
 
 struct TRI_vocbase_t;
 
@@ -67,16 +67,37 @@ struct QueryCacheResultEntry {
   std::shared_ptr<arangodb::velocypack::Builder> const _bindVars;
   std::shared_ptr<arangodb::velocypack::Builder> _stats;
   std::vector<std::string> const _dataSources;
+  /// @brief the document keys the result depends on, for data sources that
+  /// were only accessed via their primary keys. data sources not contained
+  /// in here are assumed to be read completely
+  std::unordered_map<std::string, std::unordered_set<std::string>> _dataSourceKeys;
   size_t _size;
   size_t _rows;
   std::atomic<uint64_t> _hits;
+  /// @brief whether or not the entry was hit since the eviction last
+  /// inspected it (second chance)
+  std::atomic<bool> _referenced;
   double _stamp;
   QueryCacheResultEntry* _prev;
   QueryCacheResultEntry* _next;
 
-  void increaseHits() { _hits.fetch_add(1, std::memory_order_relaxed); }
+  void increaseHits() {
+    _hits.fetch_add(1, std::memory_order_relaxed);
+    if (!_referenced.load(std::memory_order_relaxed)) {
+      _referenced.store(true, std::memory_order_relaxed);
+    }
+  }
   double executionTime() const;
 
+  /// @brief approximate memory used by the entry, including its result,
+  /// bind parameters, statistics and data sources
+  size_t memoryUsage() const;
+
+  /// @brief whether or not the result depends on any of the keys of the
+  /// data source
+  bool dependsOnKeys(std::string const& dataSource,
+                     std::unordered_set<std::string> const& keys) const;
+
   void toVelocyPack(arangodb::velocypack::Builder& builder) const;
 };
 
@@ -107,10 +128,16 @@ struct QueryCacheDatabaseEntry {
   /// @brief invalidate all entries for a data source in the 
   /// database-specific cache
   void invalidate(std::string const& dataSource);
+
+  /// @brief invalidate all entries for a data source in the
+  /// database-specific cache that depend on any of the given document keys
+  void invalidate(std::string const& dataSource,
+                  std::unordered_set<std::string> const& keys);
   
   void queriesToVelocyPack(arangodb::velocypack::Builder& builder) const;
 
-  /// @brief enforce maximum number of results
+  /// @brief enforce maximum number of results. entries that were hit
+  /// since they were last inspected get a second chance
   /// must be called under the shard's lock
   void enforceMaxResults(size_t numResults, size_t sizeResults);
   
@@ -206,6 +233,11 @@ class QueryCache {
   /// @brief invalidate all queries for a particular data source
   void invalidate(TRI_vocbase_t* vocbase, std::string const& dataSource);
 
+  /// @brief invalidate all queries for a particular data source that depend
+  /// on any of the given document keys
+  void invalidate(TRI_vocbase_t* vocbase, std::string const& dataSource,
+                  std::unordered_set<std::string> const& keys);
+
   /// @brief invalidate all queries for a particular database
   void invalidate(TRI_vocbase_t* vocbase);
 
@@ -252,12 +284,17 @@ class QueryCache {
  private:
   /// @brief number of R/W locks for the query cache
   static constexpr uint64_t numberOfParts = 16;
+
+  /// @brief number of stripes per R/W lock. lookups only acquire one
+  /// stripe, modifications acquire all of them
+  static constexpr size_t numberOfLockStripes = 16;
   
   /// @brief protect mode changes with a mutex
   mutable arangodb::Mutex _propertiesLock;
 
   /// @brief read-write lock for the cache
-  mutable arangodb::basics::ReadWriteLock _entriesLock[numberOfParts];
+  mutable arangodb::basics::StripedReadWriteLock<numberOfLockStripes>
+      _entriesLock[numberOfParts];
 
   /// @brief cached query entries, organized per database
   std::unordered_map<TRI_vocbase_t*, std::unique_ptr<QueryCacheDatabaseEntry>>
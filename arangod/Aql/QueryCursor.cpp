@@ -55,7 +55,9 @@ QueryResultCursor::QueryResultCursor(
       _guard(vocbase),
       _result(std::move(result)),
       _iterator(_result.result->slice()),
-      _cached(_result.cached) {
+      _cached(_result.cached),
+      // cached results are owned by the query cache
+      _memoryUsage(_cached ? 0 : static_cast<size_t>(_result.result->size())) {
   TRI_ASSERT(_result.result->slice().isArray());
 }
 
@@ -58,6 +58,8 @@ class QueryResultCursor final : public arangodb::Cursor {
 
   size_t count() const override final;
 
+  size_t memoryUsage() const override final { return _memoryUsage; }
+
   std::pair<ExecutionState, Result> dump(
     velocypack::Builder& result,
     std::function<void()> const& continueHandler) override final;
@@ -78,6 +80,7 @@ class QueryResultCursor final : public arangodb::Cursor {
   aql::QueryResult _result;
   arangodb::velocypack::ArrayIterator _iterator;
   bool _cached;
+  size_t _memoryUsage;
 };
 
 /// Cursor managing a query from which it continuously gets
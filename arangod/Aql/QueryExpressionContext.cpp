@@ -50,6 +50,10 @@ icu::RegexMatcher* QueryExpressionContext::buildSplitMatcher(AqlValue splitExpre
   return _query->regexCache()->buildSplitMatcher(splitExpression, trx, isEmptyExpression);
 }
 
+SimpleLikePattern const* QueryExpressionContext::buildSimpleLikePattern(char const* ptr, size_t length) {
+  return _query->regexCache()->buildSimpleLikePattern(ptr, length);
+}
+
 bool QueryExpressionContext::killed() const {
   return _query->killed();
 }
@@ -42,6 +42,7 @@ class QueryExpressionContext : public ExpressionContext {
   icu::RegexMatcher* buildRegexMatcher(char const* ptr, size_t length, bool caseInsensitive) override;
   icu::RegexMatcher* buildLikeMatcher(char const* ptr, size_t length, bool caseInsensitive) override;
   icu::RegexMatcher* buildSplitMatcher(AqlValue splitExpression, transaction::Methods*, bool& isEmptyExpression) override;
+  SimpleLikePattern const* buildSimpleLikePattern(char const* ptr, size_t length) override;
 
   bool killed() const override final;
   TRI_vocbase_t& vocbase() const override final;
@@ -45,9 +45,14 @@ QueryEntryCopy::QueryEntryCopy(TRI_voc_tick_t id,
                                double started,
                                double runTime, 
                                QueryExecutionState::ValueType state,
-                               bool stream)
+                               bool stream,
+                               size_t memoryUsage,
+                               size_t peakMemoryUsage,
+                               std::shared_ptr<arangodb::velocypack::Builder> const& profile)
     : id(id), queryString(std::move(queryString)), bindParameters(bindParameters), 
-      started(started), runTime(runTime), state(state), stream(stream) {}
+      started(started), runTime(runTime), state(state), stream(stream),
+      memoryUsage(memoryUsage), peakMemoryUsage(peakMemoryUsage),
+      profile(profile) {}
 
 /// @brief create a query list
 QueryList::QueryList(TRI_vocbase_t*)
@@ -61,7 +66,9 @@ QueryList::QueryList(TRI_vocbase_t*)
       _slowQueryThreshold(application_features::ApplicationServer::getFeature<arangodb::QueryRegistryFeature>("QueryRegistry")->slowQueryThreshold()),
       _slowStreamingQueryThreshold(application_features::ApplicationServer::getFeature<arangodb::QueryRegistryFeature>("QueryRegistry")->slowStreamingQueryThreshold()),
       _maxSlowQueries(defaultMaxSlowQueries),
-      _maxQueryStringLength(defaultMaxQueryStringLength) {
+      _maxQueryStringLength(defaultMaxQueryStringLength),
+      _profileSampling(application_features::ApplicationServer::getFeature<arangodb::QueryRegistryFeature>("QueryRegistry")->profileSampling()),
+      _profileCounter(0) {
   _current.reserve(64);
 }
 
@@ -166,7 +173,10 @@ void QueryList::remove(Query* query) {
           _trackBindVars ? query->bindParameters() : nullptr,
           started, now - started,
           QueryExecutionState::ValueType::FINISHED,
-          isStreaming
+          isStreaming,
+          0,
+          query->peakMemoryUsage(),
+          query->profileSample()
       );
 
       if (++_slowCount > _maxSlowQueries) {
@@ -250,7 +260,9 @@ std::vector<QueryEntryCopy> QueryList::listCurrent() {
           started, 
           now - started,
           query->state(),
-          query->queryOptions().stream
+          query->queryOptions().stream,
+          query->memoryUsage(),
+          query->peakMemoryUsage()
       );
     }
   }
@@ -258,6 +270,22 @@ std::vector<QueryEntryCopy> QueryList::listCurrent() {
   return result;
 }
 
+/// @brief get the number of running queries and the memory they use
+std::pair<size_t, size_t> QueryList::currentMemoryUsage() {
+  size_t count = 0;
+  size_t memoryUsage = 0;
+
+  READ_LOCKER(readLocker, _lock);
+  for (auto const& it : _current) {
+    if (it.second != nullptr) {
+      ++count;
+      memoryUsage += it.second->memoryUsage();
+    }
+  }
+
+  return {count, memoryUsage};
+}
+
 /// @brief get the list of slow queries
 std::vector<QueryEntryCopy> QueryList::listSlow() {
   std::vector<QueryEntryCopy> result;
@@ -49,7 +49,10 @@ struct QueryEntryCopy {
                   double started,
                   double runTime,
                   QueryExecutionState::ValueType state,
-                  bool stream);
+                  bool stream,
+                  size_t memoryUsage,
+                  size_t peakMemoryUsage,
+                  std::shared_ptr<arangodb::velocypack::Builder> const& profile = nullptr);
 
   TRI_voc_tick_t const id;
   std::string const queryString;
@@ -58,6 +61,12 @@ struct QueryEntryCopy {
   double const runTime;
   QueryExecutionState::ValueType const state;
   bool stream;
+  /// @brief memory used by the query on this server and by its snippets on
+  /// the DB servers. finished queries only report their peak
+  size_t const memoryUsage;
+  size_t const peakMemoryUsage;
+  /// @brief plan and per-node statistics, only set for sampled queries
+  std::shared_ptr<arangodb::velocypack::Builder> const profile;
 };
 
 class QueryList {
@@ -166,6 +175,26 @@ class QueryList {
     _maxQueryStringLength.store(value);
   }
 
+  /// @brief profile every n-th query at block level (0 = never)
+  /// we're not using a lock here for performance reasons - thus concurrent
+  /// modifications of this variable are possible but are considered unharmful
+  inline uint64_t profileSampling() const { return _profileSampling.load(std::memory_order_relaxed); }
+
+  /// @brief set the profile sampling interval
+  /// we're not using a lock here for performance reasons - thus concurrent
+  /// modifications of this variable are possible but are considered unharmful
+  inline void profileSampling(uint64_t value) { _profileSampling.store(value); }
+
+  /// @brief whether or not the next query should be profiled. only
+  /// queries that can end up in the list of slow queries are sampled
+  bool sampleProfile() {
+    uint64_t const interval = _profileSampling.load(std::memory_order_relaxed);
+    if (interval == 0 || !_enabled || !_trackSlowQueries) {
+      return false;
+    }
+    return _profileCounter.fetch_add(1, std::memory_order_relaxed) % interval == 0;
+  }
+
   /// @brief enter a query
   bool insert(Query*);
 
@@ -181,6 +210,9 @@ class QueryList {
   /// @brief return the list of running queries
   std::vector<QueryEntryCopy> listCurrent();
 
+  /// @brief return the number of running queries and the memory they use
+  std::pair<size_t, size_t> currentMemoryUsage();
+
   /// @brief return the list of slow queries
   std::vector<QueryEntryCopy> listSlow();
 
@@ -229,6 +261,12 @@ class QueryList {
 
   /// @brief max length of query strings to return
   std::atomic<size_t> _maxQueryStringLength;
+
+  /// @brief profile every n-th query (0 = never)
+  std::atomic<uint64_t> _profileSampling;
+
+  /// @brief number of queries considered for profile sampling
+  std::atomic<uint64_t> _profileCounter;
 };
 }
 }
@@ -24,11 +24,14 @@
 #include "QueryOptions.h"
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/QueryCache.h"
+#include "Basics/Exceptions.h"
+#include "Basics/StringUtils.h"
 #include "RestServer/QueryRegistryFeature.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb::aql;
@@ -39,6 +42,7 @@ QueryOptions::QueryOptions() :
       maxWarningCount(10),
       literalSizeThreshold(-1),
       satelliteSyncWait(60.0),
+      remotePrefetch(4),
       profile(PROFILE_LEVEL_NONE),
       allPlans(false),
       verbosePlans(false),
@@ -49,7 +53,9 @@ QueryOptions::QueryOptions() :
       fullCount(false),
       count(false),
       verboseErrors(false),
-      inspectSimplePlans(true) {
+      inspectSimplePlans(true),
+      continuation(false),
+      continuationSkip(0) {
 
   // now set some default values from server configuration options
   QueryRegistryFeature* q = application_features::ApplicationServer::getFeature<QueryRegistryFeature>("QueryRegistry");
@@ -109,6 +115,13 @@ void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
   if (value.isNumber()) {
     satelliteSyncWait = value.getNumber<double>();
   }
+  value = slice.get("remotePrefetch"); 
+  if (value.isNumber()) {
+    int64_t v = value.getNumber<int64_t>();
+    if (v > 0) {
+      remotePrefetch = static_cast<size_t>(v);
+    }
+  }
 
   // boolean options 
   value = slice.get("profile");
@@ -159,6 +172,34 @@ void QueryOptions::fromVelocyPack(VPackSlice const& slice) {
   if (value.isBool()) {
     verboseErrors = value.getBool();
   }
+  value = slice.get("continuation");
+  if (value.isTrue()) {
+    continuation = true;
+  } else if (value.isString()) {
+    // a token returned with the previous page. it is an encoded array of
+    // the last sort value and the number of rows with this value
+    continuation = true;
+    std::string const token =
+        basics::StringUtils::decodeBase64U(value.copyString());
+    bool valid = false;
+    try {
+      VPackValidator validator;
+      valid = !token.empty() && validator.validate(token.data(), token.size());
+    } catch (...) {
+    }
+    VPackSlice position;
+    if (valid) {
+      position = VPackSlice(token.data());
+    }
+    if (!valid || !position.isArray() || position.length() != 2 ||
+        !position.at(1).isNumber()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "invalid continuation token");
+    }
+    continuationValue = std::make_shared<VPackBuilder>();
+    continuationValue->add(position.at(0));
+    continuationSkip = position.at(1).getNumber<uint64_t>();
+  }
 
   VPackSlice optimizer = slice.get("optimizer");
   if (optimizer.isObject()) {
@@ -213,6 +254,7 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder, bool disableOptimizerRule
   builder.add("maxWarningCount", VPackValue(maxWarningCount));
   builder.add("literalSizeThreshold", VPackValue(literalSizeThreshold));
   builder.add("satelliteSyncWait", VPackValue(satelliteSyncWait));
+  builder.add("remotePrefetch", VPackValue(remotePrefetch));
   builder.add("profile", VPackValue(static_cast<uint32_t>(profile)));
   builder.add("allPlans", VPackValue(allPlans));
   builder.add("verbosePlans", VPackValue(verbosePlans));
@@ -263,3 +305,13 @@ void QueryOptions::toVelocyPack(VPackBuilder& builder, bool disableOptimizerRule
 
   builder.close();
 }
+
+std::string QueryOptions::buildContinuation(VPackSlice value, uint64_t skip) {
+  VPackBuilder builder;
+  builder.openArray();
+  builder.add(value);
+  builder.add(VPackValue(skip));
+  builder.close();
+  return basics::StringUtils::encodeBase64U(std::string(
+      builder.slice().startAs<char>(), builder.slice().byteSize()));
+}
@@ -54,11 +54,20 @@ struct QueryOptions {
   void fromVelocyPack(arangodb::velocypack::Slice const&);
   void toVelocyPack(arangodb::velocypack::Builder&, bool disableOptimizerRules) const;
 
+  /// @brief builds the opaque continuation token for keyset pagination from
+  /// the value of the first sort attribute of the last row and the number of
+  /// rows returned so far that have this value
+  static std::string buildContinuation(arangodb::velocypack::Slice value,
+                                       uint64_t skip);
+
   size_t memoryLimit;
   size_t maxNumberOfPlans;
   size_t maxWarningCount;
   int64_t literalSizeThreshold;
   double satelliteSyncWait;
+  /// number of batches a coordinator may request from a DB server with
+  /// a single getSome request. 1 means no prefetching
+  size_t remotePrefetch;
   /// Level 0 nothing, Level 1 profile, Level 2,3 log tracing info
   ProfileLevel profile;
   bool allPlans;
@@ -71,6 +80,12 @@ struct QueryOptions {
   bool count;
   bool verboseErrors;
   bool inspectSimplePlans;
+  /// keyset pagination: whether the query is to return a continuation token
+  /// for the next page. if a token was passed in, continuationValue and
+  /// continuationSkip contain the position after which the next page starts
+  bool continuation;
+  std::shared_ptr<arangodb::velocypack::Builder> continuationValue;
+  uint64_t continuationSkip;
   std::vector<std::string> optimizerRules;
   std::unordered_set<std::string> shardIds;
 #ifdef USE_ENTERPRISE
@@ -30,6 +30,7 @@
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 #include "Transaction/Methods.h"
+#include "VocBase/ticks.h"
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -244,6 +245,21 @@ void QueryRegistry::expireQueries() {
     LOG_TOPIC(TRACE, Logger::QUERIES) << "queries left in QueryRegistry: " << queriesLeft;
   }
 
+  {
+    WRITE_LOCKER(writeLocker, _lock);
+    for (auto& x : _statements) {
+      auto& statements = x.second;
+      for (auto it = statements.begin(); it != statements.end(); /* no hoisting */) {
+        if (now > (*it).second._expires.load()) {
+          LOG_TOPIC(DEBUG, arangodb::Logger::AQL) << "timeout for prepared statement with id " << (*it).first;
+          it = statements.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
+
   for (auto& p : toDelete) {
     try {  // just in case
       LOG_TOPIC(DEBUG, arangodb::Logger::AQL) << "timeout for query with id " << p.second;
@@ -282,6 +298,62 @@ void QueryRegistry::destroyAll() {
       // ignore any errors here
     }
   }
+
+  WRITE_LOCKER(writeLocker, _lock);
+  _statements.clear();
+}
+
+/// @brief register a prepared statement
+QueryId QueryRegistry::insertStatement(TRI_vocbase_t* vocbase,
+                                       std::string const& user,
+                                       std::shared_ptr<PreparedStatement> statement,
+                                       double ttl) {
+  TRI_ASSERT(statement != nullptr);
+  QueryId const id = TRI_NewServerSpecificTick(); // embedded server id
+  LOG_TOPIC(DEBUG, arangodb::Logger::AQL) << "Register prepared statement with id " << id << " : " << statement->queryString;
+
+  WRITE_LOCKER(writeLocker, _lock);
+  _statements[vocbase->name()].emplace(
+      std::piecewise_construct, std::forward_as_tuple(id),
+      std::forward_as_tuple(std::move(statement), user, ttl));
+
+  return id;
+}
+
+/// @brief look up a prepared statement and extend its lifetime
+std::shared_ptr<PreparedStatement> QueryRegistry::lookupStatement(
+    TRI_vocbase_t* vocbase, std::string const& user, QueryId id) {
+  READ_LOCKER(readLocker, _lock);
+
+  auto m = _statements.find(vocbase->name());
+  if (m == _statements.end()) {
+    return nullptr;
+  }
+  auto it = m->second.find(id);
+  if (it == m->second.end() || (*it).second._user != user) {
+    return nullptr;
+  }
+
+  StatementInfo& si = (*it).second;
+  si._expires.store(TRI_microtime() + si._timeToLive);
+  return si._statement;
+}
+
+/// @brief remove a prepared statement
+bool QueryRegistry::destroyStatement(TRI_vocbase_t* vocbase,
+                                     std::string const& user, QueryId id) {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  auto m = _statements.find(vocbase->name());
+  if (m == _statements.end()) {
+    return false;
+  }
+  auto it = m->second.find(id);
+  if (it == m->second.end() || (*it).second._user != user) {
+    return false;
+  }
+  m->second.erase(it);
+  return true;
 }
 
 QueryRegistry::QueryInfo::QueryInfo(QueryId id, Query* query, double ttl, bool isPrepared)
@@ -293,6 +365,13 @@ QueryRegistry::QueryInfo::QueryInfo(QueryId id, Query* query, double ttl, bool i
       _timeToLive(ttl),
       _expires(TRI_microtime() + ttl) {}
 
+QueryRegistry::StatementInfo::StatementInfo(std::shared_ptr<PreparedStatement> statement,
+                                            std::string const& user, double ttl)
+    : _statement(std::move(statement)),
+      _user(user),
+      _timeToLive(ttl),
+      _expires(TRI_microtime() + ttl) {}
+
 QueryRegistry::QueryInfo::~QueryInfo() {
   delete _query;
 }
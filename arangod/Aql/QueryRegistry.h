@@ -31,10 +31,27 @@
 struct TRI_vocbase_t;
 
 namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
 namespace aql {
 class ExecutionEngine;
 class Query;
 
+/// @brief a query string registered for repeated execution, so that clients
+/// only need to send its id and the bind parameters
+struct PreparedStatement {
+  PreparedStatement(std::string&& queryString,
+                    std::shared_ptr<arangodb::velocypack::Builder> options)
+      : queryString(std::move(queryString)), options(std::move(options)) {}
+
+  std::string const queryString;
+
+  /// @brief query options stored with the statement. may be a nullptr
+  std::shared_ptr<arangodb::velocypack::Builder> const options;
+};
+
 class QueryRegistry {
  public:
   explicit QueryRegistry(double defTTL) : _defaultTTL(defTTL) {}
@@ -88,6 +105,24 @@ public:
   /// @brief return the default TTL value
   TEST_VIRTUAL double defaultTTL() const { return _defaultTTL; }
 
+  /// @brief register a prepared statement of the user <user> for the
+  /// vocbase <vocbase> and return its id. The statement is deleted if it is
+  /// not used for <ttl> seconds.
+  QueryId insertStatement(TRI_vocbase_t* vocbase, std::string const& user,
+                          std::shared_ptr<PreparedStatement> statement,
+                          double ttl);
+
+  /// @brief look up a prepared statement of the user <user> and extend its
+  /// lifetime. returns a nullptr if the statement is not found
+  std::shared_ptr<PreparedStatement> lookupStatement(TRI_vocbase_t* vocbase,
+                                                     std::string const& user,
+                                                     QueryId id);
+
+  /// @brief remove a prepared statement of the user <user>. returns false
+  /// if the statement is not found
+  bool destroyStatement(TRI_vocbase_t* vocbase, std::string const& user,
+                        QueryId id);
+
  private:
 
   /**
@@ -114,11 +149,30 @@ public:
     double _expires;          // UNIX UTC timestamp of expiration
   };
 
+  /// @brief a struct for all information regarding one prepared statement
+  /// in the registry
+  struct StatementInfo {
+    StatementInfo(std::shared_ptr<PreparedStatement> statement,
+                  std::string const& user, double ttl);
+
+    std::shared_ptr<PreparedStatement> const _statement;
+    std::string const _user;  // user who prepared the statement
+    double const _timeToLive; // in seconds
+    std::atomic<double> _expires; // UNIX UTC timestamp of expiration, is
+                                  // extended under the read lock
+  };
+
   /// @brief _queries, the actual map of maps for the registry
   /// maps from vocbase name to list queries
   std::unordered_map<std::string, std::unordered_map<QueryId, std::unique_ptr<QueryInfo>>>
       _queries;
 
+  /// @brief _statements, the prepared statements, also organized per
+  /// vocbase name. a statement is only found for the user who prepared it.
+  /// protected by _lock as well
+  std::unordered_map<std::string, std::unordered_map<QueryId, StatementInfo>>
+      _statements;
+
   /// @brief _lock, the read/write lock for access
   basics::ReadWriteLock _lock;
   
@@ -33,11 +33,15 @@ using namespace arangodb::aql;
 namespace {
 /// @brief empty string singleton
 static char const* EmptyString = "";
+
+/// @brief number of nodes per arena block
+constexpr size_t nodesPerBlock = 128;
 }
 
 QueryResources::QueryResources(ResourceMonitor* resourceMonitor)
     : _resourceMonitor(resourceMonitor),
       _stringsLength(0),
+      _nodesInLastBlock(0),
       _shortStringStorage(_resourceMonitor, 1024) {}
 
 QueryResources::~QueryResources() {
@@ -51,12 +55,23 @@ QueryResources::~QueryResources() {
     delete it;
   }
 
+  // destroy arena nodes and free their blocks
+  for (size_t i = 0; i < _nodeBlocks.size(); ++i) {
+    AstNode* block = _nodeBlocks[i];
+    size_t const n = (i + 1 == _nodeBlocks.size()) ? _nodesInLastBlock : nodesPerBlock;
+    for (size_t j = 0; j < n; ++j) {
+      block[j].~AstNode();
+    }
+    ::operator delete(static_cast<void*>(block));
+  }
+
 #ifdef ARANGODB_USE_MAINTAINER_MODE
   // we are in the destructor here already. decreasing the memory usage counters will only
   // provide a benefit (in terms of assertions) if we are in maintainer mode, so we can
   // save all these operations in non-maintainer mode
   _resourceMonitor->decreaseMemoryUsage(_strings.capacity() * sizeof(char*) + _stringsLength);
   _resourceMonitor->decreaseMemoryUsage(_nodes.size() * sizeof(AstNode) + _nodes.capacity() * sizeof(AstNode*));
+  _resourceMonitor->decreaseMemoryUsage(_nodeBlocks.size() * nodesPerBlock * sizeof(AstNode) + _nodeBlocks.capacity() * sizeof(AstNode*));
 #endif
 }
 
@@ -64,6 +79,35 @@ void QueryResources::steal() {
   // we are not responsible for freeing any data, so we delete our inventory
   _strings.clear();
   _nodes.clear();
+  _nodeBlocks.clear();
+  _nodesInLastBlock = 0;
+}
+
+/// @brief create a node of the given type in the node arena
+AstNode* QueryResources::createNode(AstNodeType type) {
+  if (_nodeBlocks.empty() || _nodesInLastBlock == nodesPerBlock) {
+    // current block is exhausted. all nodes of a query are freed together,
+    // so carving them out of larger blocks saves one allocation per node
+    size_t const capacityBefore = _nodeBlocks.capacity();
+    _nodeBlocks.reserve(_nodeBlocks.size() + 1);
+    size_t const bytes = nodesPerBlock * sizeof(AstNode) +
+                         (_nodeBlocks.capacity() - capacityBefore) * sizeof(AstNode*);
+    _resourceMonitor->increaseMemoryUsage(bytes);
+
+    try {
+      _nodeBlocks.emplace_back(static_cast<AstNode*>(::operator new(nodesPerBlock * sizeof(AstNode))));
+    } catch (...) {
+      // revert change in memory increase
+      _resourceMonitor->decreaseMemoryUsage(bytes);
+      throw;
+    }
+    _nodesInLastBlock = 0;
+  }
+
+  // the constructor may throw, in which case the slot remains unused
+  AstNode* node = new (_nodeBlocks.back() + _nodesInLastBlock) AstNode(type);
+  ++_nodesInLastBlock;
+  return node;
 }
 
 /// @brief add a node to the list of nodes
@@ -31,6 +31,7 @@ namespace arangodb {
 namespace aql {
 
 struct AstNode;
+enum AstNodeType : uint32_t;
 struct ResourceMonitor;
 
 class QueryResources {
@@ -44,7 +45,11 @@ class QueryResources {
  
   void steal();
    
-  /// @brief add a node to the list of nodes
+  /// @brief create a node of the given type in the node arena
+  /// the node is destroyed when the query is destroyed
+  AstNode* createNode(AstNodeType type);
+
+  /// @brief add a heap-allocated node to the list of nodes
   void addNode(AstNode*);
   
   /// @brief register a string
@@ -70,6 +75,13 @@ class QueryResources {
   /// @brief all nodes created in the AST - will be used for freeing them later
   std::vector<AstNode*> _nodes;
 
+  /// @brief blocks of nodes created via createNode(). all blocks but the
+  /// last one are full
+  std::vector<AstNode*> _nodeBlocks;
+
+  /// @brief number of nodes constructed in the last block of _nodeBlocks
+  size_t _nodesInLastBlock;
+
   /// @brief strings created in the query - used for easy memory deallocation
   std::vector<char*> _strings;
   
@@ -22,7 +22,12 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RegexCache.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/Utf8Helper.h"
+#include "Basics/system-functions.h"
+
+#include <list>
 
 #include <velocypack/Collection.h>
 #include <velocypack/Dumper.h>
@@ -46,8 +51,95 @@ static void escapeRegexParams(std::string &out, const char* ptr, size_t length)
   }
 }
 
+/// @brief process-wide cache of compiled regex patterns. compiled ICU
+/// patterns are immutable and can be shared by all threads, whereas the
+/// matchers built from them are not thread-safe and are owned by the
+/// per-query RegexCache
+class PatternCache {
+ public:
+  /// @brief return the compiled pattern, compiling it if it is not yet
+  /// in the cache. returns a nullptr if the pattern is invalid
+  std::shared_ptr<icu::RegexPattern const> get(std::string const& pattern) {
+    {
+      MUTEX_LOCKER(locker, _lock);
+      auto it = _patterns.find(pattern);
+      if (it != _patterns.end()) {
+        // move to the front of the LRU list
+        _lru.splice(_lru.begin(), _lru, (*it).second.second);
+        return (*it).second.first;
+      }
+    }
+
+    // compile the pattern without holding the lock
+    UErrorCode status = U_ZERO_ERROR;
+    std::shared_ptr<icu::RegexPattern const> compiled(
+        icu::RegexPattern::compile(icu::UnicodeString::fromUTF8(pattern), 0, status));
+    if (U_FAILURE(status) || compiled == nullptr) {
+      return nullptr;
+    }
+
+    MUTEX_LOCKER(locker, _lock);
+    auto it = _patterns.find(pattern);
+    if (it != _patterns.end()) {
+      // another thread was faster
+      return (*it).second.first;
+    }
+
+    _lru.emplace_front(pattern);
+    try {
+      _patterns.emplace(pattern, std::make_pair(compiled, _lru.begin()));
+    } catch (...) {
+      _lru.pop_front();
+      throw;
+    }
+
+    while (_patterns.size() > maxEntries) {
+      // evict the least recently used pattern. matchers still using it
+      // keep it alive
+      _patterns.erase(_lru.back());
+      _lru.pop_back();
+    }
+    return compiled;
+  }
+
+ private:
+  /// @brief maximum number of compiled patterns in the cache
+  static constexpr size_t maxEntries = 256;
+
+  arangodb::Mutex _lock;
+  /// @brief patterns, most recently used first
+  std::list<std::string> _lru;
+  std::unordered_map<std::string, std::pair<std::shared_ptr<icu::RegexPattern const>,
+                                            std::list<std::string>::iterator>> _patterns;
+};
+
+static PatternCache patternCache;
+
 } // namespace
 
+/// @brief whether or not the value matches the pattern
+bool SimpleLikePattern::matches(char const* value, size_t length) const {
+  switch (type) {
+    case Type::EXACT:
+      return length == literal.size() &&
+             memcmp(value, literal.data(), length) == 0;
+    case Type::PREFIX:
+      return length >= literal.size() &&
+             memcmp(value, literal.data(), literal.size()) == 0;
+    case Type::SUFFIX:
+      return length >= literal.size() &&
+             memcmp(value + length - literal.size(), literal.data(), literal.size()) == 0;
+    case Type::CONTAINS:
+      return literal.empty() ||
+             memmem(value, length, literal.data(), literal.size()) != nullptr;
+    case Type::REGEX:
+      break;
+  }
+
+  TRI_ASSERT(false);
+  return false;
+}
+
 RegexCache::~RegexCache() {
   clear();
 }
@@ -55,6 +147,7 @@ RegexCache::~RegexCache() {
 void RegexCache::clear() noexcept {
   _regexCache.clear();
   _likeCache.clear();
+  _simpleLikeCache.clear();
 }
 
 icu::RegexMatcher* RegexCache::buildRegexMatcher(char const* ptr, size_t length, bool caseInsensitive) {
@@ -103,21 +196,42 @@ icu::RegexMatcher* RegexCache::buildSplitMatcher(AqlValue const& splitExpression
   return fromCache(rx, _likeCache);
 }
 
+/// @brief return the simple version of a case-sensitive LIKE pattern
+SimpleLikePattern const* RegexCache::buildSimpleLikePattern(char const* ptr, size_t length) {
+  _temp.assign(ptr, length);
+  auto it = _simpleLikeCache.find(_temp);
+
+  if (it == _simpleLikeCache.end()) {
+    it = _simpleLikeCache.emplace(_temp, inspectSimpleLikePattern(ptr, length)).first;
+  }
+
+  return &((*it).second);
+}
+
 /// @brief get matcher from cache, or insert a new matcher for the specified pattern
 icu::RegexMatcher* RegexCache::fromCache(std::string const& pattern,
-                                         std::unordered_map<std::string, std::unique_ptr<icu::RegexMatcher>>& cache) {
+                                         std::unordered_map<std::string, CachedMatcher>& cache) {
   auto it = cache.find(pattern);
 
   if (it != cache.end()) {
-    return (*it).second.get();
+    return (*it).second.matcher.get();
   }
 
-  auto matcher = std::unique_ptr<icu::RegexMatcher>(arangodb::basics::Utf8Helper::DefaultUtf8Helper.buildMatcher(pattern));
+  CachedMatcher entry;
+  entry.pattern = ::patternCache.get(pattern);
+
+  if (entry.pattern != nullptr) {
+    UErrorCode status = U_ZERO_ERROR;
+    entry.matcher.reset(entry.pattern->matcher(status));
+    if (U_FAILURE(status)) {
+      entry.matcher.reset();
+    }
+  }
 
-  auto p = matcher.get();
+  auto p = entry.matcher.get();
 
   // insert into cache, no matter if pattern is valid or not
-  cache.emplace(pattern, std::move(matcher));
+  cache.emplace(pattern, std::move(entry));
 
   return p;
 }
@@ -253,3 +367,74 @@ std::pair<bool, bool> RegexCache::inspectLikePattern(std::string& out,
 
   return std::make_pair(false, false);
 }
+
+/// @brief inspect a LIKE pattern, and determine whether it can be matched
+/// without a regex. this is the case if it contains no _ wildcards, and %
+/// wildcards only at its start and/or end
+SimpleLikePattern RegexCache::inspectSimpleLikePattern(char const* ptr, size_t length) {
+  SimpleLikePattern result{SimpleLikePattern::Type::REGEX, ""};
+
+  std::string& out = result.literal;
+  out.reserve(length);
+  bool escaped = false;
+  bool leadingWildcard = false;
+  bool trailingWildcard = false;
+
+  for (size_t i = 0; i < length; ++i) {
+    char const c = ptr[i];
+
+    if (c == '\\') {
+      if (escaped) {
+        // literal backslash
+        out.push_back('\\');
+        if (trailingWildcard) {
+          return result;
+        }
+      }
+      escaped = !escaped;
+      continue;
+    }
+
+    if (!escaped && c == '_') {
+      // single character wildcard
+      return result;
+    }
+
+    if (!escaped && c == '%') {
+      if (out.empty()) {
+        leadingWildcard = true;
+      } else {
+        trailingWildcard = true;
+      }
+      continue;
+    }
+
+    if (trailingWildcard) {
+      // wildcard in the middle of the pattern
+      return result;
+    }
+
+    if (escaped && c != '%' && c != '_' && c != '?' && c != '+' &&
+        c != '[' && c != '(' && c != ')' && c != '{' && c != '}' &&
+        c != '^' && c != '$' && c != '|' && c != '.' && c != '*') {
+      // found a backslash followed by no special character
+      out.push_back('\\');
+    }
+
+    // literal character
+    out.push_back(c);
+    escaped = false;
+  }
+
+  if (leadingWildcard && trailingWildcard) {
+    result.type = SimpleLikePattern::Type::CONTAINS;
+  } else if (leadingWildcard) {
+    result.type = out.empty() ? SimpleLikePattern::Type::CONTAINS
+                              : SimpleLikePattern::Type::SUFFIX;
+  } else if (trailingWildcard) {
+    result.type = SimpleLikePattern::Type::PREFIX;
+  } else {
+    result.type = SimpleLikePattern::Type::EXACT;
+  }
+  return result;
+}
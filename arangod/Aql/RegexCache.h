@@ -37,6 +37,21 @@ class Methods;
 
 namespace aql {
 
+/// @brief a LIKE pattern that can be matched without a regex, because it
+/// is a plain string comparison, or a prefix, suffix or substring match
+struct SimpleLikePattern {
+  enum class Type { EXACT, PREFIX, SUFFIX, CONTAINS, REGEX };
+
+  /// @brief type of the pattern. REGEX means the pattern is not simple
+  Type type;
+  /// @brief the unescaped literal part of the pattern
+  std::string literal;
+
+  /// @brief whether or not the value matches the pattern. must not be
+  /// called for patterns of type REGEX
+  bool matches(char const* value, size_t length) const;
+};
+
 class RegexCache {
  public:
   RegexCache(RegexCache const&) = delete;
@@ -50,6 +65,13 @@ class RegexCache {
   icu::RegexMatcher* buildRegexMatcher(char const* ptr, size_t length, bool caseInsensitive);
   icu::RegexMatcher* buildLikeMatcher(char const* ptr, size_t length, bool caseInsensitive);
   icu::RegexMatcher* buildSplitMatcher(AqlValue const& splitExpression, arangodb::transaction::Methods* trx, bool& isEmptyExpression);
+
+  /// @brief return the simple version of a case-sensitive LIKE pattern
+  SimpleLikePattern const* buildSimpleLikePattern(char const* ptr, size_t length);
+
+  /// @brief inspect a LIKE pattern, and determine whether it can be
+  /// matched without a regex
+  static SimpleLikePattern inspectSimpleLikePattern(char const* ptr, size_t length);
   
   /// @brief inspect a LIKE pattern from a string, and remove all
   /// of its escape characters. will stop at the first wildcards found.
@@ -62,18 +84,26 @@ class RegexCache {
   static std::pair<bool, bool> inspectLikePattern(std::string& out, char const* ptr, size_t length);
  
  private: 
+  /// @brief a matcher, together with the shared compiled pattern it uses
+  struct CachedMatcher {
+    std::shared_ptr<icu::RegexPattern const> pattern;
+    std::unique_ptr<icu::RegexMatcher> matcher;
+  };
+
   /// @brief get matcher from cache, or insert a new matcher for the specified pattern
   icu::RegexMatcher* fromCache(std::string const& pattern, 
-                               std::unordered_map<std::string, std::unique_ptr<icu::RegexMatcher>>& cache);
+                               std::unordered_map<std::string, CachedMatcher>& cache);
 
   static void buildRegexPattern(std::string& out, char const* ptr, size_t length, bool caseInsensitive);
   static void buildLikePattern(std::string& out, char const* ptr, size_t length, bool caseInsensitive);
 
  private:
   /// @brief cache for compiled regexes (REGEX function)
-  std::unordered_map<std::string, std::unique_ptr<icu::RegexMatcher>> _regexCache;
+  std::unordered_map<std::string, CachedMatcher> _regexCache;
   /// @brief cache for compiled regexes (LIKE function)
-  std::unordered_map<std::string, std::unique_ptr<icu::RegexMatcher>> _likeCache;
+  std::unordered_map<std::string, CachedMatcher> _likeCache;
+  /// @brief cache for LIKE patterns that don't need a regex
+  std::unordered_map<std::string, SimpleLikePattern> _simpleLikeCache;
   /// @brief a reusable string object for pattern generation
   std::string _temp;
 };
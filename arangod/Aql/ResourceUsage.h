@@ -27,6 +27,8 @@
 #include "Basics/Common.h"
 #include "Basics/Exceptions.h"
 
+#include <atomic>
+
 namespace arangodb {
 namespace aql {
 
@@ -39,9 +41,59 @@ struct ResourceUsage {
   size_t memoryUsage;
 };
 
+/// @brief memory used by all queries of this server. the shared counter is
+/// only maintained if a limit is set, so that queries do not contend for it
+/// otherwise. the limit must be set before any query runs
+class GlobalResourceMonitor {
+ public:
+  static GlobalResourceMonitor& instance() { return INSTANCE; }
+
+  void setMemoryLimit(size_t value) { _limit.store(value); }
+  size_t memoryLimit() const { return _limit.load(std::memory_order_relaxed); }
+  size_t currentMemoryUsage() const { return _current.load(std::memory_order_relaxed); }
+
+  bool enabled() const { return memoryLimit() > 0; }
+
+  inline void increaseMemoryUsage(size_t value) {
+    size_t previous = _current.fetch_add(value, std::memory_order_relaxed);
+    if (previous + value > memoryLimit()) {
+      _current.fetch_sub(value, std::memory_order_relaxed);
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT, "queries would use more memory than allowed on this server");
+    }
+  }
+
+  inline void decreaseMemoryUsage(size_t value) noexcept {
+    TRI_ASSERT(currentMemoryUsage() >= value);
+    _current.fetch_sub(value, std::memory_order_relaxed);
+  }
+
+  /// @brief admission control for new queries. throws if the running
+  /// queries have used up the memory budget. the query fails right away
+  /// instead of waiting, so that it does not hold a server thread that the
+  /// queries which would free the memory may need
+  void admit() const;
+
+ private:
+  GlobalResourceMonitor() : _limit(0), _current(0) {}
+
+  static GlobalResourceMonitor INSTANCE;
+
+  std::atomic<size_t> _limit;
+  std::atomic<size_t> _current;
+};
+
 struct ResourceMonitor {
-  ResourceMonitor() : currentResources(), maxResources() {}
-  explicit ResourceMonitor(ResourceUsage const& maxResources) : currentResources(), maxResources(maxResources) {}
+  ResourceMonitor() : currentResources(), maxResources(), peakResources(), chargeGlobal(true) {}
+  explicit ResourceMonitor(ResourceUsage const& maxResources, bool chargeGlobal = true)
+      : currentResources(), maxResources(maxResources), peakResources(), chargeGlobal(chargeGlobal) {}
+
+  ~ResourceMonitor() {
+    // hand back whatever the owners of our memory have not released
+    if (currentResources.memoryUsage > 0 && chargeGlobal &&
+        GlobalResourceMonitor::instance().enabled()) {
+      GlobalResourceMonitor::instance().decreaseMemoryUsage(currentResources.memoryUsage);
+    }
+  }
  
   void setMemoryLimit(size_t value) {
     maxResources.memoryUsage = value;
@@ -52,20 +104,38 @@ struct ResourceMonitor {
         currentResources.memoryUsage + value > maxResources.memoryUsage) {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT, "query would use more memory than allowed");
     }
+    GlobalResourceMonitor& global = GlobalResourceMonitor::instance();
+    if (chargeGlobal && global.enabled()) {
+      global.increaseMemoryUsage(value);
+    }
     currentResources.memoryUsage += value;
+    if (currentResources.memoryUsage > peakResources.memoryUsage) {
+      peakResources.memoryUsage = currentResources.memoryUsage;
+    }
   }
   
   inline void decreaseMemoryUsage(size_t value) noexcept {
     TRI_ASSERT(currentResources.memoryUsage >= value);
     currentResources.memoryUsage -= value;
+    GlobalResourceMonitor& global = GlobalResourceMonitor::instance();
+    if (chargeGlobal && global.enabled()) {
+      global.decreaseMemoryUsage(value);
+    }
   }
 
+  /// @brief forgets the current usage without handing it back to the
+  /// global monitor. only to be used on a copy of another monitor
   void clear() {
     currentResources.clear();
   }
 
   ResourceUsage currentResources;
   ResourceUsage maxResources;
+  /// @brief high-water mark of currentResources
+  ResourceUsage peakResources;
+  /// @brief whether the usage also counts towards the memory budget of all
+  /// queries. not the case for memory that is not used by a query
+  bool chargeGlobal;
 };
 
 }
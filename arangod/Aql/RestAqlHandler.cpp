@@ -58,6 +58,8 @@ using namespace arangodb::aql;
 
 using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
+constexpr size_t RestAqlHandler::MaxPrefetch;
+
 RestAqlHandler::RestAqlHandler(GeneralRequest* request,
                                GeneralResponse* response,
                                std::pair<QueryRegistry*, traverser::TraverserEngineRegistry*>* registries)
@@ -224,8 +226,10 @@ void RestAqlHandler::setupClusterQuery() {
   VPackBuilder answerBuilder;
   answerBuilder.openObject();
   bool needToLock = true;
+  size_t const fetch =
+      VelocyPackHelper::getNumericValue<size_t>(querySlice, "fetch", 0);
   bool res = registerSnippets(snippetsSlice, collectionBuilder.slice(), variablesSlice,
-                              options, ctx, ttl, needToLock, answerBuilder);
+                              options, ctx, ttl, fetch, needToLock, answerBuilder);
   if (!res) {
     // TODO we need to trigger cleanup here??
     // Registering the snippets failed.
@@ -254,10 +258,17 @@ bool RestAqlHandler::registerSnippets(
     std::shared_ptr<VPackBuilder> options,
     std::shared_ptr<transaction::Context> const& ctx,
     double const ttl,
+    size_t fetch,
     bool& needToLock,
     VPackBuilder& answerBuilder
     ) {
   TRI_ASSERT(answerBuilder.isOpenObject());
+  if (snippetsSlice.length() != 1) {
+    // the first results are only fetched for a single snippet, as the
+    // execution of snippets may depend on each other
+    fetch = 0;
+  }
+  VPackBuilder results;
   answerBuilder.add(VPackValue("snippets"));
   answerBuilder.openObject();
   // NOTE: We need to clean up all engines if we bail out during the following
@@ -336,6 +347,37 @@ bool RestAqlHandler::registerSnippets(
         // No need to cleanup...
       }
 
+      if (fetch > 0) {
+        // execute the snippet right away, so the coordinator does not need
+        // to ask for the first rows in a separate request
+        try {
+          auto result = query->engine()->getSome(fetch);
+          if (result.first != ExecutionState::WAITING) {
+            results.openObject();
+            results.add(VPackValue(it.key.copyString()));
+            results.openObject();
+            results.add("done", VPackValue(result.first == ExecutionState::DONE));
+            results.add("memoryUsage", VPackValue(query->resourceMonitor()->currentResources.memoryUsage));
+            results.add("peakMemoryUsage", VPackValue(query->resourceMonitor()->peakResources.memoryUsage));
+            if (result.second == nullptr) {
+              results.add("exhausted", VPackValue(true));
+              results.add(StaticStrings::Error, VPackValue(false));
+            } else {
+              result.second->toVelocyPack(query->trx(), results);
+            }
+            results.close();
+            results.close();
+          }
+        } catch (basics::Exception const& e) {
+          generateError(rest::ResponseCode::SERVER_ERROR, e.code(), e.message());
+          return false;
+        } catch (std::exception const& ex) {
+          generateError(rest::ResponseCode::SERVER_ERROR, TRI_ERROR_INTERNAL,
+                        ex.what());
+          return false;
+        }
+      }
+
       _queryRegistry->insert(qId, query.get(), ttl, true);
       query.release();
       answerBuilder.add(it.key);
@@ -350,6 +392,10 @@ bool RestAqlHandler::registerSnippets(
   }
   answerBuilder.close(); // Snippets
 
+  if (!results.isEmpty()) {
+    answerBuilder.add("results", results.slice());
+  }
+
   return true;
 }
 
@@ -721,34 +767,80 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
       } else if (operation == "getSome") {
         auto atMost = VelocyPackHelper::getNumericValue<size_t>(
             querySlice, "atMost", ExecutionBlock::DefaultBatchSize());
+        // callers may ask for multiple batches per round trip. these
+        // are collected in _prefetched, which survives WAITING
+        size_t prefetch = VelocyPackHelper::getNumericValue<size_t>(
+            querySlice, "prefetch", 1);
+        prefetch = (std::max)(size_t(1), (std::min)(prefetch, MaxPrefetch));
         std::unique_ptr<AqlItemBlock> items;
         ExecutionState state;
-        if (shardId.empty()) {
-          std::tie(state, items) = query->engine()->getSome(atMost);
-          if (state == ExecutionState::WAITING) {
-            return RestStatus::WAITING;
+        do {
+          if (shardId.empty()) {
+            std::tie(state, items) = query->engine()->getSome(atMost);
+            if (state == ExecutionState::WAITING) {
+              return RestStatus::WAITING;
+            }
+          } else {
+            auto block = dynamic_cast<BlockWithClients*>(query->engine()->root());
+            if (block == nullptr) {
+              THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unexpected node type");
+            }
+            TRI_ASSERT(block->getPlanNode()->getType() == ExecutionNode::SCATTER ||
+                       block->getPlanNode()->getType() == ExecutionNode::DISTRIBUTE);
+            std::tie(state, items) = block->getSomeForShard(atMost, shardId);
+            if (state == ExecutionState::WAITING) {
+              return RestStatus::WAITING;
+            }
           }
-        } else {
-          auto block = dynamic_cast<BlockWithClients*>(query->engine()->root());
-          if (block == nullptr) {
-            THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unexpected node type");
+          if (prefetch == 1) {
+            break;
           }
-          TRI_ASSERT(block->getPlanNode()->getType() == ExecutionNode::SCATTER ||
-                     block->getPlanNode()->getType() == ExecutionNode::DISTRIBUTE);
-          std::tie(state, items) = block->getSomeForShard(atMost, shardId);
-          if (state == ExecutionState::WAITING) {
-            return RestStatus::WAITING;
+          if (items != nullptr) {
+            _prefetched.emplace_back(std::move(items));
           }
-        }
+        } while (state == ExecutionState::HASMORE && _prefetched.size() < prefetch);
+
+        bool binary = _request->contentTypeResponse() == rest::ContentType::VPACK &&
+                      VelocyPackHelper::getNumericValue<int>(querySlice, "blockFormat", 0) >=
+                          AqlItemBlock::BinaryFormatVersion;
+        bool compress = binary && AqlItemBlock::canCompressBinary() &&
+                        VelocyPackHelper::getStringValue(querySlice, "compression", "") == "lz4";
+        auto writeItems = [&](AqlItemBlock const& block) {
+          if (binary) {
+            // the caller understands the binary format, and the response
+            // will be sent as VelocyPack, so the binary value survives
+            std::string buffer;
+            block.toBinary(query->trx(), buffer, compress);
+            answerBuilder.add(StaticStrings::Error, VPackValue(false));
+            answerBuilder.add("blockFormat", VPackValue(AqlItemBlock::BinaryFormatVersion));
+            answerBuilder.add("block", VPackValuePair(buffer.data(), buffer.size(), VPackValueType::Binary));
+          } else {
+            block.toVelocyPack(query->trx(), answerBuilder);
+          }
+        };
+
         // Used in 3.4.0 onwards.
         answerBuilder.add("done", VPackValue(state == ExecutionState::DONE));
-        if (items.get() == nullptr) {
+        if (prefetch > 1) {
+          // only sent to callers that asked for it
+          answerBuilder.add(StaticStrings::Error, VPackValue(false));
+          answerBuilder.add("blocks", VPackValue(VPackValueType::Array));
+          for (auto const& it : _prefetched) {
+            VPackObjectBuilder blockGuard(&answerBuilder);
+            writeItems(*it);
+          }
+          answerBuilder.close();
+          _prefetched.clear();
+        } else if (items.get() == nullptr) {
           // Backwards Compatibility
           answerBuilder.add("exhausted", VPackValue(true));
           answerBuilder.add(StaticStrings::Error, VPackValue(false));
         } else {
-          items->toVelocyPack(query->trx(), answerBuilder);
+          writeItems(*items);
         }
+        // lets the coordinator account for the memory of this snippet
+        answerBuilder.add("memoryUsage", VPackValue(query->resourceMonitor()->currentResources.memoryUsage));
+        answerBuilder.add("peakMemoryUsage", VPackValue(query->resourceMonitor()->peakResources.memoryUsage));
       } else if (operation == "skipSome") {
         auto atMost = VelocyPackHelper::getNumericValue<size_t>(
             querySlice, "atMost", ExecutionBlock::DefaultBatchSize());
@@ -775,6 +867,8 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
         }
         answerBuilder.add("skipped", VPackValue(skipped));
         answerBuilder.add(StaticStrings::Error, VPackValue(false));
+        answerBuilder.add("memoryUsage", VPackValue(query->resourceMonitor()->currentResources.memoryUsage));
+        answerBuilder.add("peakMemoryUsage", VPackValue(query->resourceMonitor()->peakResources.memoryUsage));
       } else if (operation == "initialize") {
         // this is a no-op now
         answerBuilder.add(StaticStrings::Error, VPackValue(false));
@@ -814,6 +908,8 @@ RestStatus RestAqlHandler::handleUseQuery(std::string const& operation, Query* q
         answerBuilder.add(VPackValue("stats"));
         query->getStats(answerBuilder);
 
+        answerBuilder.add("peakMemoryUsage", VPackValue(query->resourceMonitor()->peakResources.memoryUsage));
+
         // return warnings if present
         query->addWarningsToVelocyPack(answerBuilder);
 
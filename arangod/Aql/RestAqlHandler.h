@@ -25,6 +25,7 @@
 #define ARANGOD_AQL_REST_AQL_HANDLER_H 1
 
 #include "Basics/Common.h"
+#include "Aql/AqlItemBlock.h"
 #include "Aql/types.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
 #include "RestServer/VocbaseContext.h"
@@ -53,6 +54,9 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
   RestStatus execute() override;
   RestStatus continueExecute() override;
 
+  /// @brief maximum number of batches returned by a single getSome request
+  static constexpr size_t MaxPrefetch = 16;
+
  public:
   // POST method for /_api/aql/instantiate
   // The body is a VelocyPack with attributes "plan" for the execution plan and
@@ -68,6 +72,9 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
   //             more than "atMost" items.
   //             The result is the JSON representation of an
   //             AqlItemBlock.
+  //   "prefetch": optional number of batches of "atMost" items to return
+  //             at once. if greater than 1, the result contains an array
+  //             "blocks" with up to that many AqlItemBlocks.
   // For the "skip" operation one has to give:
   //   "number": must be a positive integer, the cursor skips as many items,
   //             possibly exhausting the cursor.
@@ -98,8 +105,12 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
   //    snippets: {
   //      <queryId: {nodes: [ <nodes>]}>
   //    },
-  //    variables: [ <variables> ]
+  //    variables: [ <variables> ],
+  //    fetch: <number of rows>
   //  }
+  // If fetch is set and there is only a single snippet, the snippet is
+  // executed right away and its first rows are returned together with
+  // the snippet ids, as results: { <queryId>: <getSome response> }
 
   void setupClusterQuery();
 
@@ -109,6 +120,7 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
                         std::shared_ptr<arangodb::velocypack::Builder> options,
                         std::shared_ptr<transaction::Context> const& ctx,
                         double const ttl,
+                        size_t fetch,
                         bool& needToLock,
                         arangodb::velocypack::Builder& answer);
 
@@ -145,6 +157,10 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
 
   // id of current query
   QueryId _qId;
+
+  // batches produced for a getSome request with "prefetch", kept
+  // while the request is WAITING
+  std::vector<std::unique_ptr<AqlItemBlock>> _prefetched;
 };
 }
 }
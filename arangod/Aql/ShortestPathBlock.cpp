@@ -29,6 +29,7 @@
 #include "Cluster/ClusterComm.h"
 #include "Graph/AttributeWeightShortestPathFinder.h"
 #include "Graph/ConstantWeightShortestPathFinder.h"
+#include "Graph/KShortestPathsFinder.h"
 #include "Graph/ShortestPathFinder.h"
 #include "Graph/ShortestPathResult.h"
 #include "Transaction/Methods.h"
@@ -55,6 +56,8 @@ ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
       _posInPath(0),
       _pathLength(0),
       _path(nullptr),
+      _kPathsFinder(nullptr),
+      _pathsLeft(0),
       _startReg(ExecutionNode::MaxRegisterId),
       _useStartRegister(false),
       _targetReg(ExecutionNode::MaxRegisterId),
@@ -90,7 +93,10 @@ ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
   }
   _path = std::make_unique<arangodb::graph::ShortestPathResult>();
 
-  if (_opts->useWeight()) {
+  if (_opts->numberOfPaths > 1) {
+    _kPathsFinder = new arangodb::graph::KShortestPathsFinder(_opts);
+    _finder.reset(_kPathsFinder);
+  } else if (_opts->useWeight()) {
     _finder.reset(
         new arangodb::graph::AttributeWeightShortestPathFinder(_opts));
   } else {
@@ -131,6 +137,7 @@ std::pair<ExecutionState, arangodb::Result> ShortestPathBlock::initializeCursor(
   }
   _posInPath = 0;
   _pathLength = 0;
+  _pathsLeft = 0;
   _usedConstant = false;
 
   return res;
@@ -184,6 +191,18 @@ std::pair<ExecutionState, Result> ShortestPathBlock::shutdown(int errorCode) {
 }
 
 bool ShortestPathBlock::nextPath(AqlItemBlock const* items) {
+  if (_pathsLeft > 0) {
+    // further paths of the current input, cheapest first
+    TRI_ASSERT(_kPathsFinder != nullptr);
+    --_pathsLeft;
+    if (_kPathsFinder->getNextPath(*_path, [this]() { throwIfKilled(); })) {
+      _posInPath = 0;
+      _pathLength = _path->length();
+      return true;
+    }
+    _pathsLeft = 0;
+    return false;
+  }
   if (_usedConstant) {
     // Both source and target are constant.
     // Just one path to compute
@@ -273,6 +292,7 @@ bool ShortestPathBlock::nextPath(AqlItemBlock const* items) {
   if (hasPath) {
     _posInPath = 0;
     _pathLength = _path->length();
+    _pathsLeft = _opts->numberOfPaths - 1;
   }
 
   return hasPath;
@@ -291,7 +311,7 @@ ShortestPathBlock::getSome(size_t atMost) {
     }
 
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       ExecutionState state;
       bool blockAppended;
       std::tie(state, blockAppended) = ExecutionBlock::getBlock(toFetch);
@@ -353,7 +373,7 @@ ShortestPathBlock::getSome(size_t atMost) {
       ++_posInPath;
     }
 
-    if (_posInPath >= _pathLength) {
+    if (_posInPath >= _pathLength && _pathsLeft == 0) {
       // Advance read position for next call
       if (++_pos >= cur->size()) {
         _buffer.pop_front();  // does not throw
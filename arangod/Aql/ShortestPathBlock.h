@@ -32,6 +32,7 @@ namespace arangodb {
 class ManagedDocumentResult;
 
 namespace graph {
+class KShortestPathsFinder;
 class ShortestPathFinder;
 class ShortestPathResult;
 }
@@ -60,7 +61,8 @@ class ShortestPathBlock final : public ExecutionBlock {
   std::pair<ExecutionState, size_t> skipSome(size_t atMost) override final;
   
  private:
-  /// @brief Compute the next shortest path
+  /// @brief Compute the next shortest path, either the next path of the
+  /// current input or the first one of the next input
   bool nextPath(AqlItemBlock const*);
 
   /// @brief Checks if we output the vertex
@@ -98,6 +100,14 @@ class ShortestPathBlock final : public ExecutionBlock {
   /// @brief the shortest path finder.
   std::unique_ptr<arangodb::graph::ShortestPathFinder> _finder;
 
+  /// @brief _finder if more than one path is requested per input, owned
+  /// by _finder
+  arangodb::graph::KShortestPathsFinder* _kPathsFinder;
+
+  /// @brief number of paths which may still be returned for the current
+  /// input
+  uint64_t _pathsLeft;
+
   /// @brief The information to get the starting point, when a register id is
   /// used
   arangodb::aql::RegisterId _startReg;
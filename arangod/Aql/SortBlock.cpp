@@ -25,12 +25,45 @@
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
 #include "VocBase/vocbase.h"
 
+#include <atomic>
+#include <exception>
+#include <queue>
+#include <thread>
+
 using namespace arangodb::aql;
 
 namespace {
 
+/// @brief compares two rows, which may live in different blocks. returns
+/// true if the row on the left-hand side sorts before the one on the right
+bool rowLessThan(arangodb::transaction::Methods* trx,
+                 std::vector<SortRegister> const& sortRegisters,
+                 AqlItemBlock const* lhsBlock, size_t lhsRow,
+                 AqlItemBlock const* rhsBlock, size_t rhsRow) {
+  for (auto const& reg : sortRegisters) {
+    auto const& lhs = lhsBlock->getValueReference(lhsRow, reg.reg);
+    auto const& rhs = rhsBlock->getValueReference(rhsRow, reg.reg);
+
+#ifdef USE_IRESEARCH
+    TRI_ASSERT(reg.comparator);
+    int const cmp = (*reg.comparator)(reg.scorer.get(), trx, lhs, rhs);
+#else
+    int const cmp = AqlValue::Compare(trx, lhs, rhs, true);
+#endif
+
+    if (cmp < 0) {
+      return reg.asc;
+    } else if (cmp > 0) {
+      return !reg.asc;
+    }
+  }
+
+  return false;
+}
+
 /// @brief OurLessThan
 class OurLessThan {
  public:
@@ -45,21 +78,41 @@ class OurLessThan {
 
   bool operator()(std::pair<uint32_t, uint32_t> const& a,
                   std::pair<uint32_t, uint32_t> const& b) const {
-    for (auto const& reg : _sortRegisters) {
-      auto const& lhs = _buffer[a.first]->getValueReference(a.second, reg.reg);
-      auto const& rhs = _buffer[b.first]->getValueReference(b.second, reg.reg);
+    return rowLessThan(_trx, _sortRegisters, _buffer[a.first], a.second,
+                       _buffer[b.first], b.second);
+  }
 
-#ifdef USE_IRESEARCH
-      TRI_ASSERT(reg.comparator);
-      int const cmp = (*reg.comparator)(reg.scorer.get(), _trx, lhs, rhs);
-#else
-      int const cmp = AqlValue::Compare(_trx, lhs, rhs, true);
-#endif
+ private:
+  arangodb::transaction::Methods* _trx;
+  std::deque<AqlItemBlock*>& _buffer;
+  std::vector<SortRegister>& _sortRegisters;
+}; // OurLessThan
+
+/// @brief compares rows by their precomputed sort keys. the keys are
+/// scalar velocypack values, so comparing them needs neither the
+/// transaction nor its velocypack options, and can be done on any thread
+class KeyLessThan {
+ public:
+  KeyLessThan(std::vector<arangodb::velocypack::Slice> const& keys,
+              std::vector<SortRegister> const& sortRegisters) noexcept
+    : _keys(keys),
+      _sortRegisters(sortRegisters) {
+  }
+
+  bool operator()(uint32_t a, uint32_t b) const {
+    size_t const n = _sortRegisters.size();
+    auto const* lhs = _keys.data() + a * n;
+    auto const* rhs = _keys.data() + b * n;
+
+    for (size_t i = 0; i < n; ++i) {
+      int const cmp = arangodb::basics::VelocyPackHelper::compare(
+        lhs[i], rhs[i], true
+      );
 
       if (cmp < 0) {
-        return reg.asc;
+        return _sortRegisters[i].asc;
       } else if (cmp > 0) {
-        return !reg.asc;
+        return !_sortRegisters[i].asc;
       }
     }
 
@@ -67,17 +120,112 @@ class OurLessThan {
   }
 
  private:
-  arangodb::transaction::Methods* _trx;
-  std::deque<AqlItemBlock*>& _buffer;
-  std::vector<SortRegister>& _sortRegisters;
-}; // OurLessThan
+  std::vector<arangodb::velocypack::Slice> const& _keys;
+  std::vector<SortRegister> const& _sortRegisters;
+}; // KeyLessThan
+
+/// @brief sorts the row indexes in independent runs on multiple threads and
+/// merges the sorted runs into a single sequence afterwards. runs are
+/// contiguous ranges of the input, so breaking ties by run index during
+/// the merge keeps the overall result stable if the runs are sorted stably
+void parallelSort(std::vector<uint32_t>& rows, KeyLessThan const& less,
+                  bool stable, size_t numRuns) {
+  TRI_ASSERT(numRuns > 1);
+  size_t const runSize = (rows.size() + numRuns - 1) / numRuns;
+
+  // run boundaries: run i covers [bounds[i], bounds[i + 1])
+  std::vector<size_t> bounds;
+  bounds.reserve(numRuns + 1);
+  for (size_t i = 0; i < rows.size(); i += runSize) {
+    bounds.emplace_back(i);
+  }
+  bounds.emplace_back(rows.size());
+  numRuns = bounds.size() - 1;
+
+  std::atomic<size_t> nextRun(0);
+  std::vector<std::exception_ptr> errors(numRuns);
+
+  auto sortRuns = [&]() {
+    size_t run;
+    while ((run = nextRun.fetch_add(1)) < numRuns) {
+      try {
+        auto first = rows.begin() + bounds[run];
+        auto last = rows.begin() + bounds[run + 1];
+        if (stable) {
+          std::stable_sort(first, last, less);
+        } else {
+          std::sort(first, last, less);
+        }
+      } catch (...) {
+        errors[run] = std::current_exception();
+      }
+    }
+  };
+
+  // the current thread works on runs, too, so we only need numRuns - 1
+  // helper threads. if we cannot start a thread, the remaining runs are
+  // simply picked up by the threads we already have
+  std::vector<std::thread> threads;
+  threads.reserve(numRuns - 1);
+  for (size_t i = 1; i < numRuns; ++i) {
+    try {
+      threads.emplace_back(sortRuns);
+    } catch (...) {
+      break;
+    }
+  }
+  sortRuns();
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto const& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
 
+  // k-way merge of the sorted runs, using a heap (min-heap via inverted
+  // comparison) that contains the current head of each run
+  std::vector<size_t> positions(bounds.begin(), bounds.end() - 1);
+  auto cmp = [&](size_t a, size_t b) {
+    uint32_t const lhs = rows[positions[a]];
+    uint32_t const rhs = rows[positions[b]];
+    if (less(rhs, lhs)) {
+      return true;
+    }
+    if (less(lhs, rhs)) {
+      return false;
+    }
+    return a > b;
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(cmp)> heads(cmp);
+  for (size_t run = 0; run < numRuns; ++run) {
+    heads.push(run);
+  }
+
+  std::vector<uint32_t> merged;
+  merged.reserve(rows.size());
+  while (!heads.empty()) {
+    size_t run = heads.top();
+    heads.pop();
+    merged.emplace_back(rows[positions[run]]);
+    if (++positions[run] < bounds[run + 1]) {
+      heads.push(run);
+    }
+  }
+  rows.swap(merged);
 }
 
+}
+
+constexpr size_t SortBlock::ParallelSortMinRows;
+constexpr size_t SortBlock::MaxParallelSortRuns;
+
 SortBlock::SortBlock(ExecutionEngine* engine, SortNode const* en)
   : ExecutionBlock(engine, en),
     _stable(en->_stable),
-    _mustFetchAll(true) {
+    _mustFetchAll(true),
+    _limit(en->limit()) {
   TRI_ASSERT(en && en->plan() && en->getRegisterPlan());
   SortRegister::fill(
     *en->plan(),
@@ -87,7 +235,9 @@ SortBlock::SortBlock(ExecutionEngine* engine, SortNode const* en)
   );
 }
 
-SortBlock::~SortBlock() {}
+SortBlock::~SortBlock() {
+  clearHeap();
+}
 
 std::pair<ExecutionState, arangodb::Result> SortBlock::initializeCursor(
     AqlItemBlock* items, size_t pos) {
@@ -101,8 +251,9 @@ std::pair<ExecutionState, arangodb::Result> SortBlock::initializeCursor(
 
   _mustFetchAll = !_done;
   _pos = 0;
+  clearHeap();
 
-  return res; 
+  return res;
 }
 
 std::pair<ExecutionState, arangodb::Result> SortBlock::getOrSkipSome(
@@ -113,13 +264,28 @@ std::pair<ExecutionState, arangodb::Result> SortBlock::getOrSkipSome(
     ExecutionState res = ExecutionState::HASMORE;
     // suck all blocks into _buffer
     while (res != ExecutionState::DONE) {
-      res = getBlock(DefaultBatchSize()).first;
+      res = getBlock(batchSize()).first;
       if (res == ExecutionState::WAITING) {
         return {res, TRI_ERROR_NO_ERROR};
       }
+      if (_limit > 0) {
+        // constrained sort: only keep the first _limit rows
+        pushBufferIntoHeap();
+      }
     }
 
     _mustFetchAll = false;
+    if (_limit > 0) {
+      // the heap rows are all we need to sort
+      TRI_ASSERT(_buffer.empty());
+      _buffer.swap(_heapBuffer);
+      if (!_buffer.empty() &&
+          _heap.size() % DefaultBatchSize() != 0) {
+        // the last heap block may not have been filled completely
+        _buffer.back()->shrink(_heap.size() % DefaultBatchSize());
+      }
+      _heap.clear();
+    }
     if (!_buffer.empty()) {
       doSorting();
     }
@@ -128,6 +294,145 @@ std::pair<ExecutionState, arangodb::Result> SortBlock::getOrSkipSome(
   return ExecutionBlock::getOrSkipSome(atMost, skipping, result, skipped);
 }
 
+/// @brief number of runs to sort in parallel for the given number of rows.
+/// a return value of 1 means that sorting should be done single-threaded
+size_t SortBlock::parallelSortRuns(size_t numRows) const {
+  if (numRows < ParallelSortMinRows) {
+    return 1;
+  }
+  size_t numRuns = std::thread::hardware_concurrency();
+  numRuns = (std::min)(numRuns, MaxParallelSortRuns);
+  numRuns = (std::min)(numRuns, numRows / (ParallelSortMinRows / 2));
+  return (std::max)(numRuns, size_t(1));
+}
+
+/// @brief collects the sort keys of all rows in _buffer, row by row. returns
+/// false if some key can only be compared with the help of the transaction,
+/// i.e. if it is not a scalar velocypack value or if an IResearch scorer
+/// compares it. the keys point into the blocks in _buffer
+bool SortBlock::collectSortKeys(size_t numRows,
+                                std::vector<VPackSlice>& keys) const {
+#ifdef USE_IRESEARCH
+  for (auto const& reg : _sortRegisters) {
+    if (reg.scorer) {
+      return false;
+    }
+  }
+#endif
+
+  keys.reserve(numRows * _sortRegisters.size());
+
+  for (auto const& block : _buffer) {
+    size_t const n = block->size();
+
+    for (size_t i = 0; i < n; ++i) {
+      for (auto const& reg : _sortRegisters) {
+        auto const& value = block->getValueReference(i, reg.reg);
+        if (value.isRange() || value.isDocvec()) {
+          return false;
+        }
+        VPackSlice const key = value.slice();
+        if (!key.isNone() && !key.isNull() && !key.isBoolean() &&
+            !key.isNumber() && !key.isString()) {
+          return false;
+        }
+        keys.emplace_back(key);
+      }
+    }
+  }
+
+  return true;
+}
+
+/// @brief moves all rows from _buffer into the heap of the constrained
+/// sort. the heap keeps at most _limit rows, ordered so that its top is the
+/// row that sorts last. an incoming row that sorts before the top replaces
+/// it, all other incoming rows are dropped
+void SortBlock::pushBufferIntoHeap() {
+  TRI_ASSERT(_limit > 0);
+
+  auto heapLess = [this](std::pair<uint32_t, uint32_t> const& a,
+                         std::pair<uint32_t, uint32_t> const& b) {
+    return rowLessThan(_trx, _sortRegisters, _heapBuffer[a.first], a.second,
+                       _heapBuffer[b.first], b.second);
+  };
+
+  while (!_buffer.empty()) {
+    AqlItemBlock* block = _buffer.front();
+    RegisterId const nrRegs = block->getNrRegs();
+    size_t const n = block->size();
+
+    for (size_t row = 0; row < n; ++row) {
+      std::pair<uint32_t, uint32_t> target;
+
+      if (_heap.size() < _limit) {
+        // heap not yet full: use the next free slot
+        size_t const slot = _heap.size();
+        if (slot % DefaultBatchSize() == 0) {
+          size_t const rows = (std::min)(_limit - slot, DefaultBatchSize());
+          AqlItemBlock* next = requestBlock(rows, nrRegs);
+          try {
+            _heapBuffer.emplace_back(next);
+          } catch (...) {
+            delete next;
+            throw;
+          }
+        }
+        target = std::make_pair(static_cast<uint32_t>(slot / DefaultBatchSize()),
+                                static_cast<uint32_t>(slot % DefaultBatchSize()));
+      } else {
+        auto const& top = _heap.front();
+        if (!rowLessThan(_trx, _sortRegisters, block, row,
+                         _heapBuffer[top.first], top.second)) {
+          // row sorts after all rows in the heap
+          continue;
+        }
+        // evict the top row and reuse its slot
+        std::pop_heap(_heap.begin(), _heap.end(), heapLess);
+        target = _heap.back();
+        _heap.pop_back();
+        for (RegisterId j = 0; j < nrRegs; ++j) {
+          _heapBuffer[target.first]->destroyValue(target.second, j);
+        }
+      }
+
+      AqlItemBlock* heapBlock = _heapBuffer[target.first];
+      for (RegisterId j = 0; j < nrRegs; ++j) {
+        auto const& a = block->getValueReference(row, j);
+        if (a.isEmpty()) {
+          continue;
+        }
+        if (a.requiresDestruction()) {
+          AqlValue b = a.clone();
+          try {
+            heapBlock->setValue(target.second, j, b);
+          } catch (...) {
+            b.destroy();
+            throw;
+          }
+        } else {
+          heapBlock->setValue(target.second, j, a);
+        }
+      }
+
+      _heap.emplace_back(target);
+      std::push_heap(_heap.begin(), _heap.end(), heapLess);
+    }
+
+    returnBlock(block);
+    _buffer.pop_front();
+  }
+}
+
+/// @brief frees all rows of the constrained sort heap
+void SortBlock::clearHeap() {
+  for (auto& it : _heapBuffer) {
+    delete it;
+  }
+  _heapBuffer.clear();
+  _heap.clear();
+}
+
 void SortBlock::doSorting() {
   size_t sum = 0;
   for (auto const& block : _buffer) {
@@ -156,13 +461,32 @@ void SortBlock::doSorting() {
     ++count;
   }
 
-  // comparison function
-  OurLessThan ourLessThan(_trx, _buffer, _sortRegisters);
+  // sort coords. large inputs are sorted on several threads, but only if
+  // their sort keys can be compared without the transaction, which must
+  // not be used by other threads
+  size_t const numRuns = parallelSortRuns(sum);
+  std::vector<VPackSlice> keys;
+  if (numRuns > 1 && collectSortKeys(sum, keys)) {
+    // the keys of the row coords[i] start at keys[i * _sortRegisters.size()]
+    std::vector<uint32_t> rows;
+    rows.reserve(sum);
+    for (size_t i = 0; i < sum; ++i) {
+      rows.emplace_back(static_cast<uint32_t>(i));
+    }
+
+    parallelSort(rows, KeyLessThan(keys, _sortRegisters), _stable, numRuns);
 
-  // sort coords
-  if (_stable) {
+    std::vector<std::pair<uint32_t, uint32_t>> sorted;
+    sorted.reserve(sum);
+    for (auto const& row : rows) {
+      sorted.emplace_back(coords[row]);
+    }
+    coords.swap(sorted);
+  } else if (_stable) {
+    OurLessThan ourLessThan(_trx, _buffer, _sortRegisters);
     std::stable_sort(coords.begin(), coords.end(), ourLessThan);
   } else {
+    OurLessThan ourLessThan(_trx, _buffer, _sortRegisters);
     std::sort(coords.begin(), coords.end(), ourLessThan);
   }
 
@@ -49,10 +49,31 @@ class SortBlock final : public ExecutionBlock {
       size_t atMost, bool skipping, AqlItemBlock*&,
       size_t& skipped) override final;
 
+  /// @brief minimum number of rows from which on the rows are sorted in
+  /// multiple runs on separate threads, which are merged afterwards
+  static constexpr size_t ParallelSortMinRows = 100000;
+
+  /// @brief maximum number of runs (and threads) used for sorting
+  static constexpr size_t MaxParallelSortRuns = 8;
+
   /// @brief dosorting
  private:
   void doSorting();
 
+  /// @brief number of runs to sort in parallel for the given number of rows
+  size_t parallelSortRuns(size_t numRows) const;
+
+  /// @brief collects the sort keys of all rows, if they can be compared
+  /// on other threads
+  bool collectSortKeys(size_t numRows,
+                       std::vector<arangodb::velocypack::Slice>& keys) const;
+
+  /// @brief moves all rows from _buffer into the constrained sort heap
+  void pushBufferIntoHeap();
+
+  /// @brief frees all rows of the constrained sort heap
+  void clearHeap();
+
   /// @brief pairs, consisting of variable and sort direction
   /// (true = ascending | false = descending)
   std::vector<SortRegister> _sortRegisters;
@@ -61,6 +82,16 @@ class SortBlock final : public ExecutionBlock {
   bool _stable;
 
   bool _mustFetchAll;
+
+  /// @brief maximum number of rows to produce (0 = unlimited). if set, only
+  /// this many rows are kept in a heap while the input is consumed
+  size_t const _limit;
+
+  /// @brief blocks holding the rows of the constrained sort heap
+  std::deque<AqlItemBlock*> _heapBuffer;
+
+  /// @brief the heap, containing the coordinates of all rows in _heapBuffer
+  std::vector<std::pair<uint32_t, uint32_t>> _heap;
 };
 
 }  // namespace arangodb::aql
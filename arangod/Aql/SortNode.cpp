@@ -27,13 +27,15 @@
 #include "Aql/SortBlock.h"
 #include "Aql/WalkerWorker.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackHelper.h"
 
 using namespace arangodb::basics;
 using namespace arangodb::aql;
 
 SortNode::SortNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base,
                    SortElementVector const& elements, bool stable)
-    : ExecutionNode(plan, base), _reinsertInCluster(true),  _elements(elements), _stable(stable){}
+    : ExecutionNode(plan, base), _reinsertInCluster(true),  _elements(elements), _stable(stable),
+      _limit(arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(base, "limit", 0)) {}
 
 /// @brief toVelocyPack, for SortNode
 void SortNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
@@ -57,6 +59,7 @@ void SortNode::toVelocyPackHelper(VPackBuilder& nodes, unsigned flags) const {
     }
   }
   nodes.add("stable", VPackValue(_stable));
+  nodes.add("limit", VPackValue(_limit));
 
   // And close it:
   nodes.close();
@@ -199,6 +202,11 @@ CostEstimate SortNode::estimateCost() const {
   CostEstimate estimate = _dependencies.at(0)->getCost();
   if (estimate.estimatedNrItems <= 3) {
     estimate.estimatedCost += estimate.estimatedNrItems;
+  } else if (_limit > 0 && _limit < estimate.estimatedNrItems) {
+    // constrained sort: every input row is pushed into a heap of at most
+    // _limit rows, and the sort never produces more rows than that
+    estimate.estimatedCost += estimate.estimatedNrItems * std::log2(static_cast<double>((std::max)(_limit, size_t(2))));
+    estimate.estimatedNrItems = _limit;
   } else {
     estimate.estimatedCost += estimate.estimatedNrItems * std::log2(static_cast<double>(estimate.estimatedNrItems));
   }
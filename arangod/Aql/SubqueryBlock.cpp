@@ -31,6 +31,17 @@
 using namespace arangodb;
 using namespace arangodb::aql;
 
+namespace {
+
+/// @brief maximum number of subquery results kept in the cache
+constexpr size_t maxCachedResults = 1024;
+
+/// @brief number of lookups after which the cache is turned off if it
+/// produced too few hits
+constexpr size_t minCacheLookups = 1000;
+
+}
+
 SubqueryBlock::SubqueryBlock(ExecutionEngine* engine, SubqueryNode const* en,
                              ExecutionBlock* subquery)
     : ExecutionBlock(engine, en),
@@ -43,16 +54,129 @@ SubqueryBlock::SubqueryBlock(ExecutionEngine* engine, SubqueryNode const* en,
       _subqueryPos(0),
       _subqueryInitialized(false),
       _subqueryCompleted(false),
-      _hasShutdownMainQuery(false) {
+      _hasShutdownMainQuery(false),
+      _cacheLookups(0),
+      _cacheHits(0),
+      _cacheMemoryUsage(0),
+      _deferred(false) {
   auto it = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
   TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
   _outReg = it->second.registerId;
   TRI_ASSERT(_outReg < ExecutionNode::MaxRegisterId);
+
+  if (en->cacheResults() && !_subqueryIsConst && _subqueryReturnsData) {
+    for (auto const& v : en->getVariablesUsedHere()) {
+      auto reg = en->getRegisterPlan()->varInfo.find(v->id);
+      TRI_ASSERT(reg != en->getRegisterPlan()->varInfo.end());
+      _cacheKeyRegisters.emplace_back(reg->second.registerId);
+    }
+    if (!_cacheKeyRegisters.empty()) {
+      _cacheKey.reserve(_cacheKeyRegisters.size());
+      _cache = std::make_unique<std::unordered_map<std::vector<AqlValue>, AqlValue,
+                                                   AqlValueGroupHash, AqlValueGroupEqual>>(
+          16, AqlValueGroupHash(_trx, _cacheKeyRegisters.size()),
+          AqlValueGroupEqual(_trx));
+    }
+  }
+}
+
+SubqueryBlock::~SubqueryBlock() { destroyCache(); }
+
+/// @brief destroy all cached subquery results
+void SubqueryBlock::destroyCache() {
+  if (_cache == nullptr) {
+    return;
+  }
+  for (auto& it : *_cache) {
+    for (auto& key : it.first) {
+      const_cast<AqlValue&>(key).destroy();
+    }
+    it.second.destroy();
+  }
+  _cache->clear();
+
+  _engine->getQuery()->resourceMonitor()->decreaseMemoryUsage(_cacheMemoryUsage);
+  _cacheMemoryUsage = 0;
+}
+
+/// @brief build the cache key for the input row at position
+void SubqueryBlock::buildCacheKey(AqlItemBlock* block, size_t position) {
+  _cacheKey.clear();
+  for (auto const& reg : _cacheKeyRegisters) {
+    _cacheKey.emplace_back(block->getValueReference(position, reg));
+  }
+}
+
+/// @brief write a cached subquery result for the key in _cacheKey into
+/// the input row at position. returns false if there is no cached result
+bool SubqueryBlock::useCachedResult(AqlItemBlock* block, size_t position) {
+  TRI_ASSERT(_cache != nullptr);
+  ++_cacheLookups;
+
+  auto it = _cache->find(_cacheKey);
+  if (it == _cache->end()) {
+    if (_cacheLookups >= ::minCacheLookups && _cacheHits * 10 < _cacheLookups) {
+      // the outer variables rarely repeat, so the cache is not worth its
+      // memory and the hashing
+      destroyCache();
+      _cache.reset();
+    }
+    return false;
+  }
+
+  ++_cacheHits;
+  AqlValue value = (*it).second.clone();
+  AqlValueGuard guard(value, true);
+  block->setValue(position, _outReg, value);
+  guard.steal();
+  return true;
+}
+
+/// @brief store the subquery result of the input row at position in the
+/// cache, using the key in _cacheKey
+void SubqueryBlock::storeCachedResult(AqlItemBlock* block, size_t position) {
+  TRI_ASSERT(_cache != nullptr);
+  if (_cache->size() >= ::maxCachedResults) {
+    return;
+  }
+
+  ResourceMonitor* resourceMonitor = _engine->getQuery()->resourceMonitor();
+
+  std::vector<AqlValue> key;
+  key.reserve(_cacheKey.size());
+  try {
+    size_t memoryUsage = sizeof(AqlValue) * (_cacheKey.size() + 1);
+    for (auto const& it : _cacheKey) {
+      key.emplace_back(it.clone());
+      memoryUsage += key.back().memoryUsage();
+    }
+    AqlValue value = block->getValueReference(position, _outReg).clone();
+    AqlValueGuard guard(value, true);
+    memoryUsage += value.memoryUsage();
+
+    // throws if the memory limit of the query would be exceeded
+    resourceMonitor->increaseMemoryUsage(memoryUsage);
+    try {
+      if (_cache->emplace(key, value).second) {
+        guard.steal();
+        _cacheMemoryUsage += memoryUsage;
+        return;
+      }
+    } catch (...) {
+    }
+    resourceMonitor->decreaseMemoryUsage(memoryUsage);
+  } catch (...) {
+    // caching is optional
+  }
+  for (auto& it : key) {
+    it.destroy();
+  }
 }
 
-ExecutionState SubqueryBlock::initSubquery(size_t position) {
+ExecutionState SubqueryBlock::initSubquery(AqlItemBlock* block,
+                                           size_t position) {
   TRI_ASSERT(!_subqueryInitialized);
-  auto ret = _subquery->initializeCursor(_result.get(), position);
+  auto ret = _subquery->initializeCursor(block, position);
   if (ret.first == ExecutionState::WAITING) {
     // Position is captured, we can continue from here again
     return ret.first;
@@ -71,7 +195,7 @@ ExecutionState SubqueryBlock::getSomeConstSubquery(size_t atMost) {
     return ExecutionState::DONE;
   }
   if (!_subqueryInitialized) {
-    auto state = initSubquery(0);
+    auto state = initSubquery(_result.get(), 0);
     if (state == ExecutionState::WAITING) {
       TRI_ASSERT(!_subqueryInitialized);
       return state;
@@ -119,8 +243,15 @@ ExecutionState SubqueryBlock::getSomeNonConstSubquery(size_t atMost) {
     return ExecutionState::DONE;
   }
   for (; _subqueryPos < _result->size(); _subqueryPos++) {
+    if (_cache != nullptr && !_subqueryInitialized) {
+      buildCacheKey(_result.get(), _subqueryPos);
+      if (useCachedResult(_result.get(), _subqueryPos)) {
+        throwIfKilled();
+        continue;
+      }
+    }
     if (!_subqueryInitialized) {
-      auto state = initSubquery(_subqueryPos);
+      auto state = initSubquery(_result.get(), _subqueryPos);
       if (state == ExecutionState::WAITING) {
         TRI_ASSERT(!_subqueryInitialized);
         return state;
@@ -150,6 +281,11 @@ ExecutionState SubqueryBlock::getSomeNonConstSubquery(size_t atMost) {
     // Responsibility is handed over
     _subqueryResults.release();
     TRI_ASSERT(_subqueryResults == nullptr);
+    if (_cache != nullptr) {
+      // the key may be gone if we had to wait for the subquery
+      buildCacheKey(_result.get(), _subqueryPos);
+      storeCachedResult(_result.get(), _subqueryPos);
+    }
     _subqueryCompleted = false;
     _subqueryInitialized = false;
     throwIfKilled();
@@ -160,9 +296,110 @@ ExecutionState SubqueryBlock::getSomeNonConstSubquery(size_t atMost) {
   return ExecutionState::DONE;
 }
 
+ExecutionState SubqueryBlock::computeRow(AqlItemBlock* block,
+                                         size_t position) {
+  if (_subqueryIsConst && position > 0) {
+    // the rows are processed in order, so the result is in the first row
+    block->setValue(position, _outReg, block->getValueReference(0, _outReg));
+    return ExecutionState::DONE;
+  }
+
+  if (!_subqueryInitialized) {
+    if (_cache != nullptr) {
+      buildCacheKey(block, position);
+      if (useCachedResult(block, position)) {
+        return ExecutionState::DONE;
+      }
+    }
+    auto state = initSubquery(block, position);
+    if (state == ExecutionState::WAITING) {
+      return state;
+    }
+  }
+  if (!_subqueryCompleted) {
+    auto state = executeSubquery();
+    if (state == ExecutionState::WAITING) {
+      return state;
+    }
+    // Subquery does not allow to HASMORE!
+    TRI_ASSERT(state == ExecutionState::DONE);
+  }
+
+  TRI_ASSERT(_subqueryResults != nullptr);
+  TRI_IF_FAILURE("SubqueryBlock::getSome") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  block->emplaceValue(position, _outReg, _subqueryResults.get());
+  // Responsibility is handed over
+  _subqueryResults.release();
+  if (_cache != nullptr) {
+    buildCacheKey(block, position);
+    storeCachedResult(block, position);
+  }
+  _subqueryCompleted = false;
+  _subqueryInitialized = false;
+  return ExecutionState::DONE;
+}
+
+ExecutionState SubqueryBlock::getSomeInterleavedSubqueries() {
+  for (; _subqueryPos < _result->size(); _subqueryPos++) {
+    // start all subqueries of the row before returning WAITING, so that
+    // their requests to the DB servers are in flight at the same time
+    bool waiting = false;
+    for (size_t i = 0; i < _interleaved.size(); ++i) {
+      if (_interleavedDone[i]) {
+        continue;
+      }
+      auto state = _interleaved[i]->computeRow(_result.get(), _subqueryPos);
+      if (state == ExecutionState::WAITING) {
+        waiting = true;
+      } else {
+        _interleavedDone[i] = true;
+      }
+    }
+    if (waiting) {
+      return ExecutionState::WAITING;
+    }
+    std::fill(_interleavedDone.begin(), _interleavedDone.end(), false);
+    throwIfKilled();
+  }
+
+  return ExecutionState::DONE;
+}
+
+void SubqueryBlock::setupInterleaved() {
+  TRI_ASSERT(_interleaved.empty());
+  SubqueryBlock* current = this;
+  while (ExecutionNode::castTo<SubqueryNode const*>(current->getPlanNode())
+             ->interleaved()) {
+    TRI_ASSERT(current->_dependencies.size() == 1);
+    ExecutionBlock* dependency = current->_dependencies[0];
+    if (dependency->getPlanNode()->getType() != ExecutionNode::SUBQUERY) {
+      break;
+    }
+    current = static_cast<SubqueryBlock*>(dependency);
+    current->_deferred = true;
+    _interleaved.emplace_back(current);
+  }
+  // execute the subqueries in the order of the plan
+  std::reverse(_interleaved.begin(), _interleaved.end());
+  _interleaved.emplace_back(this);
+  _interleavedDone.assign(_interleaved.size(), false);
+}
+
 /// @brief getSome
 std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> SubqueryBlock::getSome(size_t atMost) {
   traceGetSomeBegin(atMost);
+  if (_deferred) {
+    // our subquery is executed by the following block. the registers are
+    // cleared there as well, as the subquery may still need them
+    auto res = ExecutionBlock::getSomeWithoutRegisterClearout(atMost);
+    traceGetSomeEnd(res.second.get(), res.first);
+    return res;
+  }
+  if (_interleaved.empty()) {
+    setupInterleaved();
+  }
   if (_result == nullptr) {
     auto res = ExecutionBlock::getSomeWithoutRegisterClearout(atMost);
     if (res.first == ExecutionState::WAITING) {
@@ -182,7 +419,9 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> SubqueryBlock::getSome(
   }
 
   ExecutionState state;
-  if (_subqueryIsConst) {
+  if (_interleaved.size() > 1) {
+    state = getSomeInterleavedSubqueries();
+  } else if (_subqueryIsConst) {
     state = getSomeConstSubquery(atMost);
   } else {
     state = getSomeNonConstSubquery(atMost);
@@ -197,8 +436,11 @@ std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> SubqueryBlock::getSome(
   // Need to reset to position zero here
   _subqueryPos = 0;
 
-  // Clear out registers no longer needed later:
-  clearRegisters(_result.get());
+  // Clear out registers no longer needed later, including the ones of the
+  // subqueries executed here for the preceding blocks:
+  for (auto& it : _interleaved) {
+    it->clearRegisters(_result.get());
+  }
   // If we get here, we have handed over responsibilty for all subquery results
   // computed here to this specific result. We cannot reuse them in the next
   // getSome call, hence we need to reset it.
@@ -253,7 +495,7 @@ ExecutionState SubqueryBlock::executeSubquery() {
 
   TRI_ASSERT(_subqueryResults != nullptr);
   do {
-    auto res = _subquery->getSome(DefaultBatchSize());
+    auto res = _subquery->getSome(_subquery->batchSize());
     if (res.first == ExecutionState::WAITING) {
       TRI_ASSERT(res.second == nullptr);
       return res.first;
@@ -24,6 +24,8 @@
 #ifndef ARANGOD_AQL_SUBQUERY_BLOCK_H
 #define ARANGOD_AQL_SUBQUERY_BLOCK_H 1
 
+#include "Aql/AqlValue.h"
+#include "Aql/AqlValueGroup.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
 
@@ -37,7 +39,7 @@ class ExecutionEngine;
 class SubqueryBlock final : public ExecutionBlock {
  public:
   SubqueryBlock(ExecutionEngine*, SubqueryNode const*, ExecutionBlock*);
-  ~SubqueryBlock() = default;
+  ~SubqueryBlock();
 
   /// @brief getSome
   std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>> getSome(
@@ -58,9 +60,9 @@ class SubqueryBlock final : public ExecutionBlock {
   /// @brief destroy the results of a subquery
   void destroySubqueryResults();
 
-  /// @brief initialize the subquery,
+  /// @brief initialize the subquery with the row at position of block,
   /// is repeatable in case of WAITING
-  ExecutionState initSubquery(size_t position);
+  ExecutionState initSubquery(AqlItemBlock* block, size_t position);
 
   /// @brief forward getSome to const subquery
   /// is repeatable in case of WAITING
@@ -70,6 +72,33 @@ class SubqueryBlock final : public ExecutionBlock {
   /// is repeatable in case of WAITING
   ExecutionState getSomeNonConstSubquery(size_t atMost);
 
+  /// @brief execute the interleaved subqueries for all rows of _result
+  /// is repeatable in case of WAITING
+  ExecutionState getSomeInterleavedSubqueries();
+
+  /// @brief execute the subquery for the row at position of block and
+  /// write its result into the row. is repeatable in case of WAITING.
+  /// used for interleaved subqueries, which process the rows in order
+  ExecutionState computeRow(AqlItemBlock* block, size_t position);
+
+  /// @brief find the blocks of the subqueries that are interleaved with
+  /// this one and let them pass their input rows through
+  void setupInterleaved();
+
+  /// @brief build the cache key for the input row at position
+  void buildCacheKey(AqlItemBlock* block, size_t position);
+
+  /// @brief write a cached subquery result for the key in _cacheKey into
+  /// the input row at position. returns false if there is no cached result
+  bool useCachedResult(AqlItemBlock* block, size_t position);
+
+  /// @brief store the subquery result of the input row at position in the
+  /// cache, using the key in _cacheKey
+  void storeCachedResult(AqlItemBlock* block, size_t position);
+
+  /// @brief destroy all cached subquery results
+  void destroyCache();
+
  private:
 
   /// @brief output register
@@ -107,6 +136,41 @@ class SubqueryBlock final : public ExecutionBlock {
 
   /// @brief result of the main query shutdown. is only valid if _hasShutdownMainQuery == true.
   Result _mainQueryShutdownResult;
+
+  /// @brief registers of the outer variables the subquery uses. only
+  /// populated if subquery results are cached
+  std::vector<RegisterId> _cacheKeyRegisters;
+
+  /// @brief values of _cacheKeyRegisters for the current input row. these
+  /// are not owned by the vector
+  std::vector<AqlValue> _cacheKey;
+
+  /// @brief cached subquery results, by the values of the outer variables
+  /// the subquery uses. the keys and values are owned by the cache
+  std::unique_ptr<std::unordered_map<std::vector<AqlValue>, AqlValue,
+                                     AqlValueGroupHash, AqlValueGroupEqual>>
+      _cache;
+
+  /// @brief number of cache lookups and hits, used to turn the cache off
+  /// if the outer variables do not repeat
+  size_t _cacheLookups;
+  size_t _cacheHits;
+
+  /// @brief memory used by the keys and values of _cache, as accounted in
+  /// the resource monitor of the query
+  size_t _cacheMemoryUsage;
+
+  /// @brief the blocks of the interleaved subqueries in execution order,
+  /// ending with this block. empty before the first call to getSome
+  std::vector<SubqueryBlock*> _interleaved;
+
+  /// @brief whether the subquery of the corresponding entry of
+  /// _interleaved has completed for the current row
+  std::vector<bool> _interleavedDone;
+
+  /// @brief whether the subquery is executed by a following block, which
+  /// gets the input rows of this block passed through
+  bool _deferred;
 };
 
 }  // namespace arangodb::aql
@@ -85,9 +85,12 @@ TraversalBlock::TraversalBlock(ExecutionEngine* engine, TraversalNode const* ep)
       ));
     } else {
 #endif
-      _traverser.reset(new arangodb::traverser::ClusterTraverser(
+      auto traverser = std::make_unique<arangodb::traverser::ClusterTraverser>(
         _opts, _mmdr.get(), ep->engines(), _trx->vocbase().name(), _trx
-      ));
+      );
+      traverser->setPrefetchVertices(ep->usesVertexOutVariable() ||
+                                     ep->usesPathOutVariable());
+      _traverser = std::move(traverser);
 #ifdef USE_ENTERPRISE
     }
 #endif
@@ -355,7 +358,7 @@ TraversalBlock::getSome(size_t atMost) {
   RegisterId const nrInRegs = getNrInputRegisters();
 
   while (!_done && _skipped < atMost) {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(batchSize(), atMost);
     BufferState bufferState = getBlockIfNeeded(toFetch);
 
     if (bufferState == BufferState::WAITING) {
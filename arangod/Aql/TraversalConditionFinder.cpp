@@ -518,6 +518,9 @@ bool TraversalConditionFinder::before(ExecutionNode* en) {
     case EN::RETURN:
     case EN::SORT:
     case EN::ENUMERATE_COLLECTION:
+    case EN::HASH_JOIN:
+    case EN::MERGE_JOIN:
+    case EN::MATERIALIZE:
     case EN::LIMIT:
     case EN::SHORTEST_PATH:
 #ifdef USE_IRESEARCH
@@ -26,6 +26,7 @@
 
 #include "Agency/AgencyComm.h"
 #include "Auth/Handler.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/ReadUnlocker.h"
 #include "Basics/VelocyPackHelper.h"
@@ -51,7 +52,7 @@ auth::TokenCache::TokenCache(auth::UserManager* um, double timeout)
       _authTimeout(timeout),
       _basicCacheVersion(0),
       _jwtSecret(""),
-      _jwtCache(16384) {}
+      _invalidations(0) {}
 
 auth::TokenCache::~TokenCache() {
   // properly clear structs while using the appropriate locks
@@ -59,10 +60,7 @@ auth::TokenCache::~TokenCache() {
     WRITE_LOCKER(readLocker, _basicLock);
     _basicCache.clear();
   }
-  {
-    WRITE_LOCKER(writeLocker, _jwtLock);
-    _jwtCache.clear();
-  }
+  clearJwtCache();
 }
 
 void auth::TokenCache::setJwtSecret(std::string const& jwtSecret) {
@@ -70,10 +68,18 @@ void auth::TokenCache::setJwtSecret(std::string const& jwtSecret) {
   LOG_TOPIC(DEBUG, Logger::AUTHENTICATION)
       << "Setting jwt secret " << Logger::BINARY(jwtSecret.data(), jwtSecret.size());
   _jwtSecret = jwtSecret;
-  _jwtCache.clear();
+  clearJwtCache();
+  _invalidations.fetch_add(1, std::memory_order_release);
   generateJwtToken();
 }
 
+void auth::TokenCache::clearJwtCache() {
+  for (auto& shard : _jwtCache) {
+    MUTEX_LOCKER(locker, shard.mutex);
+    shard.cache.clear();
+  }
+}
+
 std::string auth::TokenCache::jwtSecret() const {
   READ_LOCKER(writeLocker, _jwtLock);
   return _jwtSecret; // intentional copy
@@ -99,6 +105,16 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthentication(
 void auth::TokenCache::invalidateBasicCache() {
   WRITE_LOCKER(guard, _basicLock);
   _basicCache.clear();
+  _invalidations.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t auth::TokenCache::validityVersion() const {
+  // both counters only ever grow, so their sum changes whenever one does
+  uint64_t version = _invalidations.load(std::memory_order_acquire);
+  if (_userManager != nullptr) {
+    version += _userManager->globalVersion();
+  }
+  return version;
 }
 
 // private
@@ -173,26 +189,28 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(
 
 auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(
     std::string const& jwt) {
-  // note that we need the write lock here because it is an LRU
-  // cache. reading from it will move the read entry to the start of
-  // the cache's linked list. so acquiring just a read-lock is
-  // insufficient!!
+  JwtCacheShard& shard = jwtCacheShard(jwt);
   {
-    WRITE_LOCKER(writeLocker, _jwtLock);
-    // intentionally copy the entry from the cache
-    auth::TokenCache::Entry const* entry = _jwtCache.get(jwt);
+    // note that we need an exclusive lock here because it is an LRU
+    // cache. reading from it will move the read entry to the start of
+    // the cache's linked list
+    MUTEX_LOCKER(locker, shard.mutex);
+    auth::TokenCache::Entry const* entry = shard.cache.get(jwt);
     if (entry != nullptr) {
-      // would have thrown if not found
       if (entry->expired()) {
-        _jwtCache.remove(jwt);
+        shard.cache.remove(jwt);
         LOG_TOPIC(TRACE, Logger::AUTHENTICATION) << "JWT Token expired";
         return auth::TokenCache::Entry::Unauthenticated();
       }
+      // intentionally copy the entry from the cache
+      auth::TokenCache::Entry result = *entry;
+      locker.unlock();
+
       if (_userManager != nullptr) {
         // LDAP rights might need to be refreshed
-        _userManager->refreshUser(entry->username());
+        _userManager->refreshUser(result.username());
       }
-      return *entry;
+      return result;
     }
   }
   std::vector<std::string> const parts = StringUtils::split(jwt, '.');
@@ -227,8 +245,8 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(
     return auth::TokenCache::Entry::Unauthenticated();
   }
 
-  WRITE_LOCKER(writeLocker, _jwtLock);
-  _jwtCache.put(jwt, newEntry);
+  MUTEX_LOCKER(locker, shard.mutex);
+  shard.cache.put(jwt, newEntry);
   return newEntry;
 }
 
@@ -321,7 +339,29 @@ auth::TokenCache::Entry auth::TokenCache::validateJwtBody(
       return auth::TokenCache::Entry::Unauthenticated();
     }
     authResult._username = usernameSlice.copyString();
-    if (_userManager == nullptr || !_userManager->userExists(authResult._username)) {
+
+    VPackSlice const routingSlice = bodySlice.get("routing");
+    if (routingSlice.isObject()) {
+      VPackSlice const dbSlice = routingSlice.get("db");
+      VPackSlice const collectionSlice = routingSlice.get("collection");
+      VPackSlice const levelSlice = routingSlice.get("level");
+      if (!dbSlice.isString() || !collectionSlice.isString() ||
+          !levelSlice.isString() || !bodySlice.get("exp").isNumber()) {
+        LOG_TOPIC(TRACE, Logger::AUTHENTICATION) << "invalid routing token";
+        return auth::TokenCache::Entry::Unauthenticated();
+      }
+      authResult._routingDatabase = dbSlice.copyString();
+      authResult._routingCollection =
+          StringUtils::uint64(collectionSlice.copyString());
+      authResult._routingLevel = auth::convertToAuthLevel(levelSlice);
+    }
+
+    if (_userManager != nullptr) {
+      if (!_userManager->userExists(authResult._username)) {
+        return auth::TokenCache::Entry::Unauthenticated();
+      }
+    } else if (!routingSlice.isObject()) {
+      // servers without users (DB servers) only accept routing tokens
       return auth::TokenCache::Entry::Unauthenticated();
     }
   } else if (bodySlice.hasKey("server_id")) {
@@ -416,6 +456,25 @@ std::string auth::TokenCache::generateJwt(VPackSlice const& payload) const {
   }
 }
 
+std::string auth::TokenCache::generateRoutingJwt(std::string const& user,
+                                                std::string const& database,
+                                                TRI_voc_cid_t collection,
+                                                auth::Level level,
+                                                double ttl) const {
+  VPackBuilder body;
+  {
+    VPackObjectBuilder p(&body);
+    body.add("preferred_username", VPackValue(user));
+    body.add("exp", VPackValue(static_cast<uint64_t>(TRI_microtime() + ttl)));
+    body.add(VPackValue("routing"));
+    VPackObjectBuilder r(&body);
+    body.add("db", VPackValue(database));
+    body.add("collection", VPackValue(std::to_string(collection)));
+    body.add("level", VPackValue(auth::convertFromAuthLevel(level)));
+  }
+  return generateJwt(body.slice());
+}
+
 /// generate a JWT token for internal cluster communication
 void auth::TokenCache::generateJwtToken() {
   VPackBuilder body;
@@ -24,12 +24,16 @@
 #ifndef ARANGOD_AUTHENTICATION_TOKEN_CACHE_H
 #define ARANGOD_AUTHENTICATION_TOKEN_CACHE_H 1
 
+#include "Auth/Common.h"
 #include "Basics/Common.h"
 #include "Basics/LruCache.h"
 #include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/Result.h"
 #include "Rest/CommonDefines.h"
+#include "VocBase/voc-types.h"
+
+#include <array>
 
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
@@ -53,7 +57,11 @@ class TokenCache {
 
    public:
     explicit Entry(std::string const& username, bool a, double t)
-        : _username(username), _authenticated(a), _expiry(t) {}
+        : _username(username),
+          _authenticated(a),
+          _expiry(t),
+          _routingCollection(0),
+          _routingLevel(auth::Level::NONE) {}
     
     static Entry Unauthenticated() {
       return Entry("", false, 0);
@@ -72,6 +80,11 @@ class TokenCache {
     bool _authenticated;
     /// expiration time (in seconds since epoch) of this entry
     double _expiry;
+    /// database, collection (plan id) and access level granted by a
+    /// routing token, only set for those
+    std::string _routingDatabase;
+    TRI_voc_cid_t _routingCollection;
+    auth::Level _routingLevel;
   };
 
  public:
@@ -81,6 +94,11 @@ class TokenCache {
   /// Clear the cache of username / password auth
   void invalidateBasicCache();
 
+  /// Changes whenever previously returned entries may have become invalid,
+  /// i.e. when users, permissions or the jwt secret change. Callers can
+  /// keep an authentication result for as long as this value is unchanged
+  uint64_t validityVersion() const;
+
   /// set new jwt secret, regenerate _jetToken
   void setJwtSecret(std::string const&);
   std::string jwtSecret() const;
@@ -93,6 +111,13 @@ class TokenCache {
   std::string generateRawJwt(velocypack::Slice const&) const;
   std::string generateJwt(velocypack::Slice const&) const;
 
+  /// generate an expiring token which lets a user access the shards of
+  /// one collection on the DB servers directly, which do not know users
+  std::string generateRoutingJwt(std::string const& user,
+                                 std::string const& database,
+                                 TRI_voc_cid_t collection, auth::Level level,
+                                 double ttl) const;
+
  private:
   /// Check basic HTTP Authentication header
   TokenCache::Entry checkAuthenticationBasic(std::string const& secret);
@@ -109,6 +134,24 @@ class TokenCache {
   /// generate new _jwtToken
   void generateJwtToken();
 
+  /// number of independently locked jwt cache shards
+  static constexpr size_t JwtCacheShards = 16;
+
+  /// reading from an LRU cache modifies it, so each lookup needs an
+  /// exclusive lock. sharding keeps concurrent lookups of different
+  /// tokens from serializing on a single lock
+  struct JwtCacheShard {
+    JwtCacheShard() : cache(16384 / JwtCacheShards) {}
+    arangodb::Mutex mutex;
+    arangodb::basics::LruCache<std::string, TokenCache::Entry> cache;
+  };
+
+  JwtCacheShard& jwtCacheShard(std::string const& jwt) {
+    return _jwtCache[std::hash<std::string>()(jwt) % JwtCacheShards];
+  }
+
+  void clearJwtCache();
+
  private:
   auth::UserManager* const _userManager;
   /// Timeout in seconds
@@ -122,7 +165,10 @@ class TokenCache {
   std::string _jwtToken;
   
   mutable arangodb::basics::ReadWriteLock _jwtLock;
-  arangodb::basics::LruCache<std::string, TokenCache::Entry> _jwtCache;
+  std::array<JwtCacheShard, JwtCacheShards> _jwtCache;
+
+  /// incremented when the basic cache is invalidated or the jwt secret changes
+  std::atomic<uint64_t> _invalidations;
 };
 }  // auth
 }  // arangodb
@@ -75,7 +75,10 @@ bool BucketState::lock(uint64_t maxTries, BucketState::CallbackType cb) {
 
 void BucketState::unlock() {
   TRI_ASSERT(isLocked());
-  _state.fetch_and(~static_cast<uint32_t>(Flag::locked), std::memory_order_release);
+  // clear the lock flag and increment the version at once, the lock flag is
+  // known to be set
+  _state.fetch_add(versionIncrement - static_cast<uint32_t>(Flag::locked),
+                   std::memory_order_release);
 }
 
 bool BucketState::isSet(BucketState::Flag flag) const {
@@ -97,5 +100,21 @@ void BucketState::toggleFlag(BucketState::Flag flag) {
 
 void BucketState::clear() {
   TRI_ASSERT(isLocked());
-  _state = static_cast<uint32_t>(Flag::locked);
+  // keep the version, optimistic readers must still see the change
+  _state = (_state.load() & ~(versionIncrement - 1)) |
+           static_cast<uint32_t>(Flag::locked);
+}
+
+uint32_t BucketState::snapshot() const {
+  return _state.load(std::memory_order_acquire);
+}
+
+bool BucketState::isSet(uint32_t snapshot, BucketState::Flag flag) {
+  return ((snapshot & static_cast<uint32_t>(flag)) > 0);
+}
+
+bool BucketState::validate(uint32_t snapshot) const {
+  // the reads of the guarded data must not be moved past the second load
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return (_state.load(std::memory_order_relaxed) == snapshot);
 }
@@ -42,6 +42,11 @@ namespace cache {
 /// state is locked and, of course, to lock it. Any flags besides the lock flag
 /// are treated uniformly, and can be checked or toggled. Each flag is defined
 /// via an enum and must correspond to exactly one set bit.
+///
+/// The upper half of the state is a version which is incremented on every
+/// unlock. Together with the lock flag it allows optimistic readers to check
+/// whether the state and the data it guards were modified while they read
+/// them without locking, like a sequence lock.
 ////////////////////////////////////////////////////////////////////////////////
 struct BucketState {
   typedef std::function<void()> CallbackType;
@@ -68,6 +73,11 @@ struct BucketState {
     shuttingDown = 0x00000200,
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Value of the lowest version bit.
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr uint32_t versionIncrement = 0x00010000;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Initializes state with no flags set and unlocked
   //////////////////////////////////////////////////////////////////////////////
@@ -120,6 +130,23 @@ struct BucketState {
   //////////////////////////////////////////////////////////////////////////////
   void clear();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the full state, including flags and version, without
+  /// locking. Used to start an optimistic read.
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t snapshot() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Checks whether the given flag is set in a snapshot.
+  //////////////////////////////////////////////////////////////////////////////
+  static bool isSet(uint32_t snapshot, BucketState::Flag flag);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Checks whether the state is still unchanged since the given
+  /// snapshot was taken, i.e. whether an optimistic read was consistent.
+  //////////////////////////////////////////////////////////////////////////////
+  bool validate(uint32_t snapshot) const;
+
  private:
   std::atomic<uint32_t> _state;
 };
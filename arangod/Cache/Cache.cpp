@@ -29,7 +29,11 @@
 #include "Cache/Common.h"
 #include "Cache/Manager.h"
 #include "Cache/Metadata.h"
+#include "Cache/NumaPlacement.h"
+#include "Cache/OptimisticReaders.h"
+#include "Cache/PlainBucket.h"
 #include "Cache/Table.h"
+#include "Cache/TransactionalBucket.h"
 #include "Random/RandomGenerator.h"
 
 #include <stdint.h>
@@ -37,6 +41,7 @@
 #include <chrono>
 #include <cmath>
 #include <list>
+#include <queue>
 #include <thread>
 
 using namespace arangodb::cache;
@@ -58,6 +63,7 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, uint64_t id, Metadata&&
       _findStats(nullptr),
       _findHits(),
       _findMisses(),
+      _ghostHits(),
       _manager(manager),
       _id(id),
       _metadata(std::move(metadata)),
@@ -307,6 +313,16 @@ void Cache::recordStat(Stat stat) {
   }
 }
 
+void Cache::recordLocality(void const* bucket) {
+  if (!_manager->tracksLocality() ||
+      (basics::SharedPRNG::rand() % Manager::localitySampleInterval) != 0) {
+    return;
+  }
+
+  _manager->reportLocality(NumaPlacement::currentNode() ==
+                           NumaPlacement::nodeOf(bucket));
+}
+
 bool Cache::reportInsert(bool hadEviction) {
   bool shouldMigrate = false;
   if (hadEviction) {
@@ -330,6 +346,22 @@ bool Cache::reportInsert(bool hadEviction) {
   return shouldMigrate;
 }
 
+bool Cache::admit(Table* source, uint32_t hash,
+                  CachedValue const* victim) const {
+  // TinyLFU: a new value only replaces a value of another key if its key
+  // was accessed more often recently, so that a single scan over many keys
+  // cannot push the frequently used values out of the cache
+  FrequencySketch const& sketch = source->admission();
+  uint32_t victimHash = hashKey(victim->key(), victim->keySize());
+  return sketch.frequency(hash) > sketch.frequency(victimHash);
+}
+
+uint64_t Cache::takeGhostHits() {
+  int64_t hits = _ghostHits.value(std::memory_order_relaxed);
+  _ghostHits.reset(std::memory_order_relaxed);
+  return (hits > 0) ? static_cast<uint64_t>(hits) : 0;
+}
+
 Metadata* Cache::metadata() { return &_metadata; }
 
 std::shared_ptr<Table> Cache::table() const {
@@ -356,6 +388,9 @@ void Cache::shutdown() {
     }
     _metadata.readUnlock();
 
+    // optimistic readers check for shutdown, but may not be done yet
+    OptimisticReaders::waitForReaders();
+
     cache::Table* table = _table.load(std::memory_order_relaxed);
     if (table != nullptr) {
       std::shared_ptr<Table> extra = table->setAuxiliary(std::shared_ptr<Table>(nullptr));
@@ -382,10 +417,11 @@ bool Cache::canResize() {
     return false;
   }
 
+  // a running migration does not prevent resizing, as the buckets are
+  // moved one by one and freeMemoryFrom() finds them in either table
   bool allowed = true;
   _metadata.readLock();
-  if (_metadata.isResizing() ||
-      _metadata.isMigrating()) {
+  if (_metadata.isResizing()) {
     allowed = false;
   }
   _metadata.readUnlock();
@@ -438,6 +474,56 @@ bool Cache::freeMemory() {
   return true;
 }
 
+template <typename BucketType>
+std::vector<std::string> Cache::collectHotKeys(size_t limit) {
+  std::vector<std::string> result;
+  std::shared_ptr<Table> table = this->table();
+  if (limit == 0 || isShutdown() || table == nullptr) {
+    return result;
+  }
+
+  // keep the limit most frequently accessed keys according to the
+  // admission sketch, with the least frequent one on top
+  typedef std::pair<uint32_t, std::string> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> hottest;
+  FrequencySketch const& sketch = table->admission();
+  for (uint64_t i = 0; i < table->size() && !isShutdown(); i++) {
+    auto bucket = reinterpret_cast<BucketType*>(table->primaryBucket(i));
+    if (bucket == nullptr || !bucket->lock(Cache::triesFast)) {
+      // disabled table or busy bucket, it is only a sample anyway
+      continue;
+    }
+    for (size_t j = 0; j < BucketType::slotsData; j++) {
+      CachedValue const* value = bucket->_cachedData[j];
+      if (value == nullptr) {
+        continue;
+      }
+      uint32_t frequency = sketch.frequency(bucket->_cachedHashes[j]);
+      if (hottest.size() < limit || frequency > hottest.top().first) {
+        hottest.emplace(frequency,
+                        std::string(reinterpret_cast<char const*>(value->key()),
+                                    value->keySize()));
+        if (hottest.size() > limit) {
+          hottest.pop();
+        }
+      }
+    }
+    bucket->unlock();
+  }
+
+  result.reserve(hottest.size());
+  while (!hottest.empty()) {
+    result.emplace_back(hottest.top().second);
+    hottest.pop();
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+template std::vector<std::string> Cache::collectHotKeys<PlainBucket>(size_t);
+template std::vector<std::string> Cache::collectHotKeys<TransactionalBucket>(
+    size_t);
+
 bool Cache::migrate(std::shared_ptr<Table> newTable) {
   if (isShutdown()) {
     return false;
@@ -450,7 +536,10 @@ bool Cache::migrate(std::shared_ptr<Table> newTable) {
   TRI_ASSERT(table != nullptr);
   table->setAuxiliary(newTable);
 
-  // do the actual migration
+  // do the actual migration, one bucket at a time. until the tables are
+  // swapped, operations on buckets which have already been moved are
+  // redirected to the new table by Table::fetchAndLockBucket, so the cache
+  // stays fully usable in the meantime
   for (uint32_t i = 0; i < table->size(); i++) {
     migrateBucket(table->primaryBucket(i), table->auxiliaryBuckets(i), newTable);
   }
@@ -463,13 +552,15 @@ bool Cache::migrate(std::shared_ptr<Table> newTable) {
       oldTable->setAuxiliary(std::shared_ptr<Table>(nullptr));
   _taskLock.writeUnlock();
 
-  // clear out old table and release it
+  // clear out old table and release it, once no optimistic reader can still
+  // be reading it
+  OptimisticReaders::waitForReaders();
   oldTable->clear();
   _manager->reclaimTable(oldTable);
 
   // unmarking migrating flag
   _metadata.writeLock();
-  _metadata.changeTable(table->memoryUsage());
+  _metadata.changeTable(newTable->memoryUsage());
   _metadata.toggleMigrating();
   _metadata.writeUnlock();
 
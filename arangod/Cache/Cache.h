@@ -131,6 +131,9 @@ class Cache : public std::enable_shared_from_this<Cache> {
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Check whether the cache is currently in the process of migrating.
+  ///
+  /// While migrating, the buckets are moved to the new table one at a time,
+  /// and operations find each bucket in whichever table currently holds it.
   //////////////////////////////////////////////////////////////////////////////
   bool isMigrating();
 
@@ -161,6 +164,10 @@ class Cache : public std::enable_shared_from_this<Cache> {
   mutable basics::SharedCounter<64> _findHits;
   mutable basics::SharedCounter<64> _findMisses;
 
+  // misses on recently evicted or rejected keys, i.e. misses which a larger
+  // cache would have avoided. read and reset by the manager when rebalancing
+  basics::SharedCounter<64> _ghostHits;
+
   // allow communication with manager
   Manager* _manager;
   uint64_t _id;
@@ -203,8 +210,11 @@ class Cache : public std::enable_shared_from_this<Cache> {
 
   uint32_t hashKey(void const* key, size_t keySize) const;
   void recordStat(Stat stat);
+  void recordLocality(void const* bucket);
 
   bool reportInsert(bool hadEviction);
+  bool admit(Table* source, uint32_t hash, CachedValue const* victim) const;
+  uint64_t takeGhostHits();
 
   // management
   Metadata* metadata();
@@ -219,6 +229,11 @@ class Cache : public std::enable_shared_from_this<Cache> {
   virtual void migrateBucket(void* sourcePtr,
                              std::unique_ptr<Table::Subtable> targets,
                              std::shared_ptr<Table> newTable) = 0;
+
+  // sample the keys which were accessed most often recently
+  virtual std::vector<std::string> hotKeys(size_t limit) = 0;
+  template <typename BucketType>
+  std::vector<std::string> collectHotKeys(size_t limit);
 };
 
 };  // end namespace cache
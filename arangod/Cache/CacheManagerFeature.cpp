@@ -35,6 +35,7 @@
 #include "Cache/Manager.h"
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
+#include "RestServer/DatabasePathFeature.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 #include "Scheduler/Scheduler.h"
@@ -60,9 +61,14 @@ CacheManagerFeature::CacheManagerFeature(
       _cacheSize((TRI_PhysicalMemory >= (static_cast<uint64_t>(4) << 30))
                   ? static_cast<uint64_t>((TRI_PhysicalMemory - (static_cast<uint64_t>(2) << 30)) * 0.3)
                   : (256 << 20)),
-      _rebalancingInterval(static_cast<uint64_t>(2 * 1000 * 1000)) {
+      _rebalancingInterval(static_cast<uint64_t>(2 * 1000 * 1000)),
+      _rebalancingMode("frequency"),
+      _numaInterleave(false),
+      _hotSetInterval(0),
+      _hotSetSize(10000) {
   setOptional(true);
   startsAfter("BasicsPhase");
+  startsAfter("DatabasePath");
 }
 
 CacheManagerFeature::~CacheManagerFeature() {}
@@ -77,6 +83,30 @@ void CacheManagerFeature::collectOptions(
   options->addOption("--cache.rebalancing-interval",
                      "microseconds between rebalancing attempts",
                      new UInt64Parameter(&_rebalancingInterval));
+
+  options->addOption("--cache.rebalancing-mode",
+                     "how memory is shared among the caches (frequency: by access "
+                     "frequency and usage, utility: gradually towards the caches "
+                     "which gain the most hits from more memory)",
+                     new DiscreteValuesParameter<StringParameter>(
+                         &_rebalancingMode,
+                         std::unordered_set<std::string>{"frequency", "utility"}));
+
+  options->addOption("--cache.numa-interleave",
+                     "spread the hash tables of the caches across all NUMA "
+                     "nodes instead of placing them on the node of the "
+                     "allocating thread",
+                     new BooleanParameter(&_numaInterleave));
+
+  options->addOption("--cache.hot-set-interval",
+                     "seconds between saving the most frequently accessed keys "
+                     "of the index caches, which are loaded again after a "
+                     "restart (0 = off)",
+                     new UInt64Parameter(&_hotSetInterval));
+
+  options->addOption("--cache.hot-set-size",
+                     "maximum number of keys saved per index cache",
+                     new UInt64Parameter(&_hotSetSize));
 }
 
 void CacheManagerFeature::validateOptions(
@@ -108,11 +138,26 @@ void CacheManagerFeature::start() {
     scheduler->queue(RequestPriority::LOW, fn);
     return true;
   };
-  _manager.reset(new Manager(postFn, _cacheSize));
+  Manager::RebalancingMode mode = (_rebalancingMode == "utility")
+                                      ? Manager::RebalancingMode::utility
+                                      : Manager::RebalancingMode::frequency;
+  _manager.reset(new Manager(postFn, _cacheSize, true, mode, _numaInterleave));
   MANAGER = _manager.get();
   _rebalancer.reset(
       new CacheRebalancerThread(_manager.get(), _rebalancingInterval));
   _rebalancer->start();
+
+  if (_hotSetInterval > 0 && _hotSetSize > 0) {
+    auto databasePath =
+        application_features::ApplicationServer::getFeature<DatabasePathFeature>(
+            "DatabasePath");
+    std::string path = databasePath->subdirectoryName("CACHE-HOT-SETS");
+    _manager->setLoadedHotSets(CacheHotSetThread::load(path));
+    _hotSetThread.reset(new CacheHotSetThread(
+        _manager.get(), path, _hotSetInterval * 1000 * 1000,
+        static_cast<size_t>(_hotSetSize)));
+    _hotSetThread->start();
+  }
   LOG_TOPIC(DEBUG, Logger::STARTUP) << "cache manager has started";
 }
 
@@ -120,11 +165,16 @@ void CacheManagerFeature::beginShutdown() {
   if (_manager != nullptr) {
     _manager->beginShutdown();
     _rebalancer->beginShutdown();
+    if (_hotSetThread != nullptr) {
+      _hotSetThread->beginShutdown();
+    }
   }
 }
 
 void CacheManagerFeature::stop() {
   if (_manager != nullptr) {
+    // wait for the final save of the hot sets before the caches go away
+    _hotSetThread.reset();
     _manager->shutdown();
   }
 }
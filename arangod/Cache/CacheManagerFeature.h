@@ -52,8 +52,13 @@ class CacheManagerFeature final
 
   std::unique_ptr<cache::Manager> _manager;
   std::unique_ptr<CacheRebalancerThread> _rebalancer;
+  std::unique_ptr<CacheHotSetThread> _hotSetThread;
   uint64_t _cacheSize;
   uint64_t _rebalancingInterval;
+  std::string _rebalancingMode;
+  bool _numaInterleave;
+  uint64_t _hotSetInterval;
+  uint64_t _hotSetSize;
 };
 
 }
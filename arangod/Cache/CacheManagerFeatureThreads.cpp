@@ -25,9 +25,18 @@
 #include "Basics/Common.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/FileUtils.h"
 #include "Basics/Thread.h"
+#include "Basics/files.h"
 #include "Cache/Manager.h"
 #include "Cache/Rebalancer.h"
+#include "Logger/Logger.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
+#include <velocypack/velocypack-aliases.h>
 
 #include <stdint.h>
 
@@ -60,3 +69,107 @@ void CacheRebalancerThread::run() {
     guard.wait(interval);
   }
 }
+
+CacheHotSetThread::CacheHotSetThread(cache::Manager* manager,
+                                     std::string const& path,
+                                     uint64_t interval, size_t keysPerCache)
+    : Thread("CacheHotSetThread"),
+      _manager(manager),
+      _path(path),
+      _interval(interval),
+      _keysPerCache(keysPerCache) {}
+
+CacheHotSetThread::~CacheHotSetThread() { shutdown(); }
+
+void CacheHotSetThread::beginShutdown() {
+  Thread::beginShutdown();
+
+  CONDITION_LOCKER(guard, _condition);
+  guard.signal();
+}
+
+void CacheHotSetThread::run() {
+  while (!isStopping()) {
+    {
+      CONDITION_LOCKER(guard, _condition);
+      guard.wait(_interval);
+    }
+    // also save when woken up for shutdown, as the caches are hottest then
+    save();
+  }
+}
+
+std::unordered_map<std::string, std::vector<std::string>>
+CacheHotSetThread::load(std::string const& path) {
+  std::unordered_map<std::string, std::vector<std::string>> result;
+  if (!TRI_ExistsFile(path.c_str())) {
+    return result;
+  }
+
+  try {
+    std::string content = basics::FileUtils::slurp(path);
+    VPackValidator validator;
+    validator.validate(content.data(), content.size());
+
+    VPackSlice hotSets = VPackSlice(content.data()).get("hotSets");
+    if (!hotSets.isObject()) {
+      return result;
+    }
+    for (auto const& it : VPackObjectIterator(hotSets)) {
+      if (!it.value.isArray()) {
+        continue;
+      }
+      std::vector<std::string>& keys = result[it.key.copyString()];
+      for (VPackSlice key : VPackArrayIterator(it.value)) {
+        if (key.isBinary()) {
+          VPackValueLength length;
+          uint8_t const* data = key.getBinary(length);
+          keys.emplace_back(reinterpret_cast<char const*>(data),
+                            static_cast<size_t>(length));
+        }
+      }
+    }
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(WARN, Logger::CACHE)
+        << "ignoring unreadable cache hot set file '" << path
+        << "': " << ex.what();
+    result.clear();
+  }
+  return result;
+}
+
+void CacheHotSetThread::save() {
+  try {
+    auto hotSets = _manager->sampleHotSets(_keysPerCache);
+
+    VPackBuilder builder;
+    builder.openObject();
+    builder.add("version", VPackValue(1));
+    builder.add("hotSets", VPackValue(VPackValueType::Object));
+    for (auto const& it : hotSets) {
+      builder.add(it.first, VPackValue(VPackValueType::Array));
+      for (auto const& key : it.second) {
+        builder.add(VPackValuePair(key.data(), key.size(),
+                                   VPackValueType::Binary));
+      }
+      builder.close();
+    }
+    builder.close();
+    builder.close();
+
+    // write to a temporary file first, so that a crash cannot leave a
+    // truncated file behind
+    std::string tmp = _path + ".tmp";
+    basics::FileUtils::spit(tmp, builder.slice().startAs<char>(),
+                            builder.slice().byteSize(), true);
+    int res = TRI_RenameFile(tmp.c_str(), _path.c_str());
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_TOPIC(WARN, Logger::CACHE)
+          << "unable to save cache hot sets to '" << _path
+          << "': " << TRI_errno_string(res);
+    }
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(WARN, Logger::CACHE)
+        << "unable to save cache hot sets to '" << _path << "': " << ex.what();
+  }
+}
@@ -52,6 +52,35 @@ class CacheRebalancerThread final : public Thread {
   basics::ConditionVariable _condition;
 };
 
+/// @brief periodically saves the hot sets of the named caches to a file, and
+/// once more when the server shuts down, so that the caches can be warmed up
+/// after a restart
+class CacheHotSetThread final : public Thread {
+ public:
+  CacheHotSetThread(cache::Manager* manager, std::string const& path,
+                    uint64_t interval, size_t keysPerCache);
+  ~CacheHotSetThread();
+
+  void beginShutdown() override;
+
+  /// @brief read the hot sets saved by a previous run
+  static std::unordered_map<std::string, std::vector<std::string>> load(
+      std::string const& path);
+
+ protected:
+  void run() override;
+
+ private:
+  void save();
+
+ private:
+  cache::Manager* _manager;
+  std::string const _path;
+  uint64_t _interval;
+  size_t _keysPerCache;
+  basics::ConditionVariable _condition;
+};
+
 };  // end namespace arangodb
 
 #endif
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_CACHE_FREQUENCY_SKETCH_H
+#define ARANGODB_CACHE_FREQUENCY_SKETCH_H
+
+#include "Basics/Common.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+namespace arangodb {
+namespace cache {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Lockless count-min sketch to estimate the recent access frequency
+/// of individual keys.
+///
+/// Each key hash is counted in four 4-bit counters, and its frequency is
+/// the minimum of them. After ten recorded accesses per 64-bit word of
+/// counters, all counters are halved, so that the estimates
+/// follow the recent history. Used as a TinyLFU admission filter: a new value
+/// may only evict an existing one if it was accessed more often recently.
+////////////////////////////////////////////////////////////////////////////////
+class FrequencySketch {
+ public:
+  static constexpr uint32_t maxFrequency = 15;
+  static constexpr size_t countersPerWord = 16;
+
+ private:
+  static constexpr size_t depth = 4;
+  static constexpr uint64_t resetMask = 0x7777777777777777ULL;
+
+  size_t _capacity;
+  size_t _mask;
+  uint64_t _sampleSize;
+  std::vector<std::atomic<uint64_t>> _table;
+  std::atomic<uint64_t> _additions;
+
+ private:
+  static size_t powerOf2(size_t capacity) {
+    size_t i = 0;
+    for (; (static_cast<size_t>(1) << i) < capacity; i++) {
+    }
+    return (static_cast<size_t>(1) << i);
+  }
+
+  /// @brief the position of the i-th counter of a hash, as word index in
+  /// the upper half and as shift inside the word in the lower half
+  std::pair<size_t, uint32_t> position(uint32_t hash, size_t i) const {
+    static uint64_t const seeds[depth] = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+        0xcbf29ce484222325ULL};
+    uint64_t h = (static_cast<uint64_t>(hash) + 1) * seeds[i];
+    h ^= h >> 32;
+    return std::make_pair(static_cast<size_t>(h >> 4) & _mask,
+                          static_cast<uint32_t>(h & 15) << 2);
+  }
+
+  void reset() {
+    for (size_t i = 0; i < _capacity; i++) {
+      uint64_t word = _table[i].load(std::memory_order_relaxed);
+      while (!_table[i].compare_exchange_weak(word, (word >> 1) & resetMask,
+                                              std::memory_order_relaxed)) {
+      }
+    }
+  }
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Initialize with the given number of counters, rounded up to a
+  /// power of 2.
+  //////////////////////////////////////////////////////////////////////////////
+  explicit FrequencySketch(size_t counters)
+      : _capacity(powerOf2((counters + countersPerWord - 1) / countersPerWord)),
+        _mask(_capacity - 1),
+        _sampleSize(10 * _capacity),
+        _table(_capacity),
+        _additions(0) {
+    for (size_t i = 0; i < _capacity; i++) {
+      _table[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reports the hidden allocation size (not captured by sizeof).
+  //////////////////////////////////////////////////////////////////////////////
+  static size_t allocationSize(size_t counters) {
+    return powerOf2((counters + countersPerWord - 1) / countersPerWord) *
+           sizeof(uint64_t);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reports the memory usage in bytes.
+  //////////////////////////////////////////////////////////////////////////////
+  size_t memoryUsage() const {
+    return ((_capacity * sizeof(uint64_t)) + sizeof(FrequencySketch));
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Record an access to the key with the given hash.
+  //////////////////////////////////////////////////////////////////////////////
+  void record(uint32_t hash) {
+    bool added = false;
+    for (size_t i = 0; i < depth; i++) {
+      auto pos = position(hash, i);
+      uint64_t word = _table[pos.first].load(std::memory_order_relaxed);
+      while (((word >> pos.second) & maxFrequency) != maxFrequency) {
+        uint64_t updated = word + (static_cast<uint64_t>(1) << pos.second);
+        if (_table[pos.first].compare_exchange_weak(
+                word, updated, std::memory_order_relaxed)) {
+          added = true;
+          break;
+        }
+      }
+    }
+
+    if (added) {
+      uint64_t additions = _additions.fetch_add(1, std::memory_order_relaxed);
+      if (additions + 1 == _sampleSize) {
+        // only the thread reaching the sample size ages the counters
+        reset();
+        _additions.fetch_sub(_sampleSize / 2, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reset all counters.
+  //////////////////////////////////////////////////////////////////////////////
+  void clear() {
+    for (size_t i = 0; i < _capacity; i++) {
+      _table[i].store(0, std::memory_order_relaxed);
+    }
+    _additions.store(0, std::memory_order_relaxed);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Estimate the recent access frequency of the key with the given
+  /// hash.
+  //////////////////////////////////////////////////////////////////////////////
+  uint32_t frequency(uint32_t hash) const {
+    uint32_t result = maxFrequency;
+    for (size_t i = 0; i < depth; i++) {
+      auto pos = position(hash, i);
+      uint64_t word = _table[pos.first].load(std::memory_order_relaxed);
+      result = std::min(result, static_cast<uint32_t>((word >> pos.second) &
+                                                      maxFrequency));
+    }
+    return result;
+  }
+};
+
+};  // end namespace cache
+};  // end namespace arangodb
+
+#endif
@@ -30,6 +30,7 @@
 #include "Cache/FrequencyBuffer.h"
 #include "Cache/ManagerTasks.h"
 #include "Cache/Metadata.h"
+#include "Cache/NumaPlacement.h"
 #include "Cache/PlainCache.h"
 #include "Cache/Table.h"
 #include "Cache/Transaction.h"
@@ -56,12 +57,15 @@ const uint64_t Manager::minCacheAllocation =
 const std::chrono::milliseconds Manager::rebalancingGracePeriod(10);
 
 Manager::Manager(PostFn schedulerPost, uint64_t globalLimit,
-                 bool enableWindowedStats)
+                 bool enableWindowedStats, RebalancingMode rebalancingMode,
+                 bool numaInterleave)
     : _lock(),
       _shutdown(false),
       _shuttingDown(false),
       _resizing(false),
       _rebalancing(false),
+      _rebalancingMode(rebalancingMode),
+      _numaInterleave(numaInterleave),
       _accessStats((globalLimit >= (1024 * 1024 * 1024))
                        ? ((1024 * 1024) / sizeof(uint64_t))
                        : (globalLimit / (1024 * sizeof(uint64_t)))),
@@ -69,6 +73,9 @@ Manager::Manager(PostFn schedulerPost, uint64_t globalLimit,
       _findStats(nullptr),
       _findHits(),
       _findMisses(),
+      _trackLocality(NumaPlacement::nodes() > 1),
+      _localHits(),
+      _remoteHits(),
       _caches(),
       _nextCacheId(1),
       _globalSoftLimit(globalLimit),
@@ -281,6 +288,15 @@ std::pair<double, double> Manager::globalHitRates() {
   return std::make_pair(lifetimeRate, windowedRate);
 }
 
+std::pair<uint64_t, uint64_t> Manager::globalHitLocality() {
+  int64_t local = _localHits.value(std::memory_order_relaxed);
+  int64_t remote = _remoteHits.value(std::memory_order_relaxed);
+  return std::make_pair(
+      (local > 0) ? static_cast<uint64_t>(local) * localitySampleInterval : 0,
+      (remote > 0) ? static_cast<uint64_t>(remote) * localitySampleInterval
+                   : 0);
+}
+
 Transaction* Manager::beginTransaction(bool readOnly) {
   return _transactions.begin(readOnly);
 }
@@ -326,6 +342,7 @@ std::tuple<bool, Metadata, std::shared_ptr<Table>> Manager::registerCache(
 void Manager::unregisterCache(uint64_t id) {
   _lock.writeLock();
   _accessStats.purgeRecord(id);
+  _hotSetNames.erase(id);
   auto it = _caches.find(id);
   if (it == _caches.end()) {
     _lock.writeUnlock();
@@ -350,8 +367,7 @@ std::pair<bool, Manager::time_point> Manager::requestGrow(Cache* cache) {
       Metadata* metadata = cache->metadata();
       metadata->writeLock();
 
-      allowed = !metadata->isResizing() &&
-                !metadata->isMigrating();
+      allowed = !metadata->isResizing();
       if (allowed) {
         if (metadata->allocatedSize >= metadata->deservedSize &&
             pastRebalancingGracePeriod()) {
@@ -466,6 +482,70 @@ void Manager::reportHitStat(Stat stat) {
   }
 }
 
+void Manager::setHotSetName(uint64_t id, std::string const& name) {
+  _lock.writeLock();
+  if (_caches.find(id) != _caches.end()) {
+    _hotSetNames[id] = name;
+  }
+  _lock.writeUnlock();
+}
+
+std::unordered_map<std::string, std::vector<std::string>>
+Manager::sampleHotSets(size_t keysPerCache) {
+  // collect the caches first, sampling takes too long to hold the lock
+  std::vector<std::pair<std::string, std::shared_ptr<Cache>>> named;
+  _lock.readLock();
+  for (auto const& it : _hotSetNames) {
+    auto cache = _caches.find(it.first);
+    if (cache != _caches.end()) {
+      named.emplace_back(it.second, cache->second);
+    }
+  }
+  _lock.readUnlock();
+
+  std::unordered_map<std::string, std::vector<std::string>> result;
+  for (auto& it : named) {
+    std::vector<std::string> keys = it.second->hotKeys(keysPerCache);
+    if (!keys.empty()) {
+      result.emplace(it.first, std::move(keys));
+    }
+  }
+  return result;
+}
+
+void Manager::setLoadedHotSets(
+    std::unordered_map<std::string, std::vector<std::string>>&& hotSets) {
+  _lock.writeLock();
+  _loadedHotSets = std::move(hotSets);
+  _lock.writeUnlock();
+}
+
+std::vector<std::string> Manager::takeLoadedHotSet(std::string const& name) {
+  std::vector<std::string> result;
+  _lock.writeLock();
+  auto it = _loadedHotSets.find(name);
+  if (it != _loadedHotSets.end()) {
+    result = std::move(it->second);
+    _loadedHotSets.erase(it);
+  }
+  _lock.writeUnlock();
+  return result;
+}
+
+void Manager::clearLoadedHotSets() {
+  _lock.writeLock();
+  _loadedHotSets.clear();
+  _lock.writeUnlock();
+}
+
+void Manager::reportLocality(bool local) {
+  if (local) {
+    _localHits.add(1, std::memory_order_relaxed);
+  } else {
+    _remoteHits.add(1, std::memory_order_relaxed);
+  }
+}
+
 bool Manager::isOperational() const {
   TRI_ASSERT(_lock.isLocked());
   return (!_shutdown && !_shuttingDown);
@@ -539,7 +619,9 @@ int Manager::rebalance(bool onlyCalculate) {
   }
 
   // adjust deservedSize for each cache
-  std::shared_ptr<PriorityList> cacheList = priorityList();
+  std::shared_ptr<PriorityList> cacheList =
+      (_rebalancingMode == RebalancingMode::utility) ? utilityList()
+                                                     : priorityList();
   for (auto pair : (*cacheList)) {
     std::shared_ptr<Cache>& cache = pair.first;
     double weight = pair.second;
@@ -690,7 +772,7 @@ std::shared_ptr<Table> Manager::leaseTable(uint32_t logSize) {
   if (_tables[logSize].empty()) {
     if (increaseAllowed(Table::allocationSize(logSize), true)) {
       try {
-        table = std::make_shared<Table>(logSize);
+        table = std::make_shared<Table>(logSize, _numaInterleave);
         _globalAllocation += table->memoryUsage();
       } catch (std::bad_alloc const&) {
         table.reset();
@@ -742,7 +824,7 @@ bool Manager::increaseAllowed(uint64_t increase, bool privileged) const {
   return (increase <= (_globalHighwaterMark - _globalAllocation));
 }
 
-std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
+double Manager::baseWeight() const {
   TRI_ASSERT(_lock.isWriteLocked());
   double minimumWeight = static_cast<double>(Manager::minCacheAllocation) /
   static_cast<double>(_globalHighwaterMark);
@@ -752,10 +834,14 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
   }
 
   double uniformMarginalWeight = 0.2 / static_cast<double>(_caches.size());
-  double baseWeight = std::max(minimumWeight, uniformMarginalWeight);
+  return std::max(minimumWeight, uniformMarginalWeight);
+}
+
+std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
+  TRI_ASSERT(_lock.isWriteLocked());
+  double baseWeight = this->baseWeight();
 
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
-  LOG_TOPIC(DEBUG, Logger::CACHE) << "uniformMarginalWeight " << uniformMarginalWeight;
   LOG_TOPIC(DEBUG, Logger::CACHE) << "baseWeight " << baseWeight;
   if (1.0 < (baseWeight * static_cast<double>(_caches.size()))) {
     LOG_TOPIC(FATAL, Logger::CACHE)
@@ -821,6 +907,79 @@ std::shared_ptr<Manager::PriorityList> Manager::priorityList() {
   return list;
 }
 
+std::shared_ptr<Manager::PriorityList> Manager::utilityList() {
+  TRI_ASSERT(_lock.isWriteLocked());
+  double baseWeight = this->baseWeight();
+  double remainingWeight =
+  1.0 - (baseWeight * static_cast<double>(_caches.size()));
+  TRI_ASSERT(remainingWeight >= 0.0);
+
+  struct Share {
+    std::shared_ptr<Cache>* cache;
+    double weight;  // on top of the base weight
+    double gain;    // misses on evicted keys per byte of usage
+    bool canGrow;
+  };
+  std::vector<Share> shares;
+  shares.reserve(_caches.size());
+
+  // start from the current distribution, so that memory moves gradually
+  double totalWeight = 0.0;
+  for (auto it = _caches.begin(); it != _caches.end(); it++) {
+    std::shared_ptr<Cache>& cache = it->second;
+    Metadata* metadata = cache->metadata();
+    metadata->readLock();
+    uint64_t deserved = metadata->deservedSize;
+    bool canGrow = (deserved < metadata->maxSize);
+    metadata->readUnlock();
+
+    double weight = std::max(0.0, (static_cast<double>(deserved) /
+                                   static_cast<double>(_globalHighwaterMark)) -
+                                      baseWeight);
+    uint64_t usage = std::max(cache->usage(), Manager::minCacheAllocation);
+    double gain = static_cast<double>(cache->takeGhostHits()) /
+                  static_cast<double>(usage);
+    shares.emplace_back(Share{&cache, weight, gain, canGrow});
+    totalWeight += weight;
+  }
+
+  for (auto& share : shares) {
+    share.weight = (totalWeight > 0.0)
+                       ? (share.weight * remainingWeight / totalWeight)
+                       : (remainingWeight / static_cast<double>(shares.size()));
+  }
+
+  // move one step from the caches with the lowest gain to the cache with
+  // the highest gain
+  std::sort(shares.begin(), shares.end(),
+            [](Share const& left, Share const& right) {
+              return left.gain < right.gain;
+            });
+  auto receiver = std::find_if(shares.rbegin(), shares.rend(),
+                               [](Share const& share) {
+                                 return share.canGrow && share.gain > 0.0;
+                               });
+  if (receiver != shares.rend()) {
+    double step = Manager::utilityRebalancingStep * remainingWeight;
+    for (auto donor = shares.begin();
+         step > 0.0 && donor != shares.end() && donor->gain < receiver->gain;
+         donor++) {
+      double moved = std::min(step, donor->weight);
+      donor->weight -= moved;
+      receiver->weight += moved;
+      step -= moved;
+    }
+  }
+
+  std::shared_ptr<PriorityList> list(new PriorityList());
+  list->reserve(shares.size());
+  for (auto const& share : shares) {
+    list->emplace_back(*(share.cache), baseWeight + share.weight);
+  }
+
+  return list;
+}
+
 Manager::time_point Manager::futureTime(uint64_t millisecondsFromNow) {
   return (std::chrono::steady_clock::now() +
           std::chrono::milliseconds(millisecondsFromNow));
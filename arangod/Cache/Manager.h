@@ -42,7 +42,10 @@
 #include <map>
 #include <memory>
 #include <stack>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace arangodb {
 namespace cache {
@@ -76,18 +79,35 @@ class Manager {
 
  public:
   static const uint64_t minSize;
+  static constexpr uint64_t localitySampleInterval = 1024;
   typedef FrequencyBuffer<uint64_t> AccessStatBuffer;
   typedef FrequencyBuffer<uint8_t> FindStatBuffer;
   typedef std::vector<std::pair<std::shared_ptr<Cache>&, double>> PriorityList;
   typedef std::chrono::time_point<std::chrono::steady_clock> time_point;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief How the global memory is shared among the caches.
+  ///
+  /// With frequency, each cache gets a share based on its recent access
+  /// frequency and its usage. With utility, each rebalancing moves a small
+  /// part of the memory from the caches with the lowest to the cache with
+  /// the highest marginal gain, i.e. the most misses on recently evicted
+  /// keys per byte it uses.
+  //////////////////////////////////////////////////////////////////////////////
+  enum class RebalancingMode { frequency, utility };
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Initialize the manager with a scheduler post method and global
   /// usage limit.
+  ///
+  /// If numaInterleave is set, the tables of all caches are spread across
+  /// all NUMA nodes of the machine.
   //////////////////////////////////////////////////////////////////////////////
   Manager(PostFn schedulerPost, uint64_t globalLimit,
-          bool enableWindowedStats = true);
+          bool enableWindowedStats = true,
+          RebalancingMode rebalancingMode = RebalancingMode::frequency,
+          bool numaInterleave = false);
   ~Manager();
 
   //////////////////////////////////////////////////////////////////////////////
@@ -144,6 +164,48 @@ class Manager {
 
   std::pair<double, double> globalHitRates();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Report the estimated number of hits which found their bucket in
+  /// the memory of the NUMA node the thread ran on, and of those which had to
+  /// access another node.
+  ///
+  /// Both are zero on machines with a single node. Only every
+  /// localitySampleInterval-th hit is measured, so the numbers are estimates.
+  //////////////////////////////////////////////////////////////////////////////
+  std::pair<uint64_t, uint64_t> globalHitLocality();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Give a cache a name under which its hot set is stored.
+  ///
+  /// The name must identify the owner of the cache across restarts.
+  //////////////////////////////////////////////////////////////////////////////
+  void setHotSetName(uint64_t id, std::string const& name);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Sample the hot sets of all named caches, i.e. up to the given
+  /// number of their most frequently accessed keys, hottest first.
+  //////////////////////////////////////////////////////////////////////////////
+  std::unordered_map<std::string, std::vector<std::string>> sampleHotSets(
+      size_t keysPerCache);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Keep hot sets persisted by a previous run until their caches
+  /// are warmed up.
+  //////////////////////////////////////////////////////////////////////////////
+  void setLoadedHotSets(
+      std::unordered_map<std::string, std::vector<std::string>>&& hotSets);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Remove and return the loaded hot set with the given name. Returns
+  /// an empty list if there is none.
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<std::string> takeLoadedHotSet(std::string const& name);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Forget the loaded hot sets which were not taken.
+  //////////////////////////////////////////////////////////////////////////////
+  void clearLoadedHotSets();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Open a new transaction.
   ///
@@ -181,6 +243,8 @@ class Manager {
   bool _shuttingDown;
   bool _resizing;
   bool _rebalancing;
+  RebalancingMode _rebalancingMode;
+  bool const _numaInterleave;
 
   // structure to handle access frequency monitoring
   Manager::AccessStatBuffer _accessStats;
@@ -190,11 +254,19 @@ class Manager {
   std::unique_ptr<Manager::FindStatBuffer> _findStats;
   basics::SharedCounter<64> _findHits;
   basics::SharedCounter<64> _findMisses;
+  bool const _trackLocality;
+  basics::SharedCounter<64> _localHits;
+  basics::SharedCounter<64> _remoteHits;
 
   // registry to keep track of registered caches
   std::map<uint64_t, std::shared_ptr<Cache>> _caches;
   uint64_t _nextCacheId;
 
+  // names of the caches whose hot sets are persisted, and the hot sets of the
+  // previous run which have not been used for warmup yet
+  std::unordered_map<uint64_t, std::string> _hotSetNames;
+  std::unordered_map<std::string, std::vector<std::string>> _loadedHotSets;
+
   // actual tables to lease out
   std::stack<std::shared_ptr<Table>> _tables[32];
 
@@ -241,9 +313,13 @@ class Manager {
   // stat reporting
   void reportAccess(uint64_t id);
   void reportHitStat(Stat stat);
+  bool tracksLocality() const { return _trackLocality; }
+  void reportLocality(bool local);
 
  private:  // used internally and by tasks
   static constexpr double highwaterMultiplier = 0.8;
+  // fraction of the distributable memory moved by one utility rebalancing
+  static constexpr double utilityRebalancingStep = 0.05;
   static const uint64_t minCacheAllocation;
   static const std::chrono::milliseconds rebalancingGracePeriod;
 
@@ -275,8 +351,10 @@ class Manager {
   // helpers for individual allocations
   bool increaseAllowed(uint64_t increase, bool privileged = false) const;
 
-  // helper for lr-accessed heuristics
+  // helpers for lr-accessed heuristics
+  double baseWeight() const;
   std::shared_ptr<PriorityList> priorityList();
+  std::shared_ptr<PriorityList> utilityList();
 
   // helper for wait times
   Manager::time_point futureTime(uint64_t millisecondsFromNow);
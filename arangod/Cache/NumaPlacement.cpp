@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/NumaPlacement.h"
+
+#ifdef __linux__
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace arangodb::cache;
+
+#ifdef __linux__
+namespace {
+// from linux/mempolicy.h, which is not available everywhere
+constexpr int policyInterleave = 3;      // MPOL_INTERLEAVE
+constexpr unsigned flagMove = (1 << 1);  // MPOL_MF_MOVE
+constexpr unsigned long flagNode = (1 << 0);     // MPOL_F_NODE
+constexpr unsigned long flagAddress = (1 << 1);  // MPOL_F_ADDR
+
+// a single word of node mask is enough for the machines we run on
+constexpr uint32_t maxNodes = 8 * sizeof(unsigned long);
+
+uint32_t countNodes() {
+  uint32_t n = 1;
+  while (n < maxNodes) {
+    struct stat st;
+    std::string path = "/sys/devices/system/node/node" + std::to_string(n);
+    if (::stat(path.c_str(), &st) != 0) {
+      break;
+    }
+    n++;
+  }
+  return n;
+}
+}  // namespace
+#endif
+
+uint32_t NumaPlacement::nodes() {
+#ifdef __linux__
+  static uint32_t const n = countNodes();
+  return n;
+#else
+  return 1;
+#endif
+}
+
+bool NumaPlacement::interleave(void* memory, size_t size) {
+#ifdef __linux__
+  uint32_t n = nodes();
+  if (n <= 1) {
+    return false;
+  }
+
+  // only whole pages can be placed
+  uintptr_t pageSize = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+  uintptr_t start = (reinterpret_cast<uintptr_t>(memory) + pageSize - 1) &
+                    ~(pageSize - 1);
+  uintptr_t end = (reinterpret_cast<uintptr_t>(memory) + size) &
+                  ~(pageSize - 1);
+  if (end <= start) {
+    return false;
+  }
+
+  unsigned long mask = (n == maxNodes) ? ~0UL : ((1UL << n) - 1);
+  long res = ::syscall(SYS_mbind, start, end - start, policyInterleave, &mask,
+                       static_cast<unsigned long>(maxNodes), flagMove);
+  return (res == 0);
+#else
+  return false;
+#endif
+}
+
+uint32_t NumaPlacement::currentNode() {
+#ifdef __linux__
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return 0;
+  }
+  return node;
+#else
+  return 0;
+#endif
+}
+
+uint32_t NumaPlacement::nodeOf(void const* address) {
+#ifdef __linux__
+  int node = 0;
+  if (::syscall(SYS_get_mempolicy, &node, nullptr, 0UL, address,
+                flagNode | flagAddress) != 0) {
+    return 0;
+  }
+  return static_cast<uint32_t>(node);
+#else
+  return 0;
+#endif
+}
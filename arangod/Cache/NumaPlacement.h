@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_CACHE_NUMA_PLACEMENT_H
+#define ARANGODB_CACHE_NUMA_PLACEMENT_H
+
+#include "Basics/Common.h"
+
+#include <stdint.h>
+
+namespace arangodb {
+namespace cache {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Helpers to place cache memory on NUMA nodes and to find out where
+/// it lives.
+///
+/// Uses the Linux system calls directly, so that no additional library is
+/// needed. On other platforms, and on machines with a single node, all
+/// memory is reported to be on node 0 and placement requests are ignored.
+////////////////////////////////////////////////////////////////////////////////
+struct NumaPlacement {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The number of NUMA nodes of the machine.
+  //////////////////////////////////////////////////////////////////////////////
+  static uint32_t nodes();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Spread the pages of the given memory range round-robin across
+  /// all nodes. Returns false if the placement could not be changed.
+  //////////////////////////////////////////////////////////////////////////////
+  static bool interleave(void* memory, size_t size);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The node the calling thread currently runs on.
+  //////////////////////////////////////////////////////////////////////////////
+  static uint32_t currentNode();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The node which holds the page of the given address.
+  //////////////////////////////////////////////////////////////////////////////
+  static uint32_t nodeOf(void const* address);
+};
+
+};  // end namespace cache
+};  // end namespace arangodb
+
+#endif
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/OptimisticReaders.h"
+#include "Basics/Common.h"
+#include "Basics/cpu-relax.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace arangodb::basics;
+using namespace arangodb::cache;
+
+OptimisticReaders::Slot OptimisticReaders::_slots[OptimisticReaders::slots];
+std::atomic<uint32_t> OptimisticReaders::_last(0);
+thread_local int OptimisticReaders::_mySlot = -1;
+
+OptimisticReaders::Guard::Guard() : _counter(&(_slots[mySlot()].readers)) {
+  // sequentially consistent, so that either a writer sees the reader, or
+  // the reader sees the changes of the writer
+  _counter->fetch_add(1);
+}
+
+OptimisticReaders::Guard::~Guard() {
+  _counter->fetch_sub(1, std::memory_order_release);
+}
+
+void OptimisticReaders::waitForReaders() {
+  // order the unlinking of values before the reads of the counters
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  for (int i = 0; i < slots; i++) {
+    uint64_t attempt = 0;
+    while (_slots[i].readers.load(std::memory_order_acquire) > 0) {
+      if (++attempt < 1000) {
+        cpu_relax();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
+int OptimisticReaders::mySlot() {
+  int id = _mySlot;
+  if (id < 0) {
+    // hand out the slots round robin
+    id = static_cast<int>(_last.fetch_add(1, std::memory_order_relaxed) %
+                          slots);
+    _mySlot = id;
+  }
+  return id;
+}
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_CACHE_OPTIMISTIC_READERS_H
+#define ARANGODB_CACHE_OPTIMISTIC_READERS_H
+
+#include "Basics/Common.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace arangodb {
+namespace cache {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Tracks the threads which read buckets without locking them.
+///
+/// An optimistic reader may still see a value which has just been unlinked
+/// from its bucket, so such values must not be freed before all readers which
+/// might have seen them are done. Readers register in one of several
+/// counters, each in its own cache line, like in basics::DataProtector.
+/// Writers wait until every counter has been seen at zero once after the
+/// value was unlinked. Read sections are very short, so this is fast.
+////////////////////////////////////////////////////////////////////////////////
+class OptimisticReaders {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Registers the current thread as optimistic reader for the
+  /// lifetime of the guard.
+  //////////////////////////////////////////////////////////////////////////////
+  class Guard {
+   public:
+    Guard();
+    ~Guard();
+
+    Guard(Guard const&) = delete;
+    Guard& operator=(Guard const&) = delete;
+
+   private:
+    std::atomic<uint64_t>* _counter;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Waits until all optimistic readers which were active when the
+  /// method was called are done.
+  //////////////////////////////////////////////////////////////////////////////
+  static void waitForReaders();
+
+ private:
+  static constexpr int slots = 64;
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> readers;
+  };
+
+  static Slot _slots[slots];
+  static std::atomic<uint32_t> _last;
+  static thread_local int _mySlot;
+
+ private:
+  static int mySlot();
+};
+
+};  // end namespace cache
+};  // end namespace arangodb
+
+#endif
@@ -54,7 +54,7 @@ bool PlainBucket::isFull() const {
   bool hasEmptySlot = false;
   for (size_t i = 0; i < slotsData; i++) {
     size_t slot = slotsData - (i + 1);
-    if (_cachedHashes[slot] == 0) {
+    if (hashAt(slot) == 0) {
       hasEmptySlot = true;
       break;
     }
@@ -69,11 +69,12 @@ CachedValue* PlainBucket::find(uint32_t hash, void const* key, size_t keySize,
   CachedValue* result = nullptr;
 
   for (size_t i = 0; i < slotsData; i++) {
-    if (_cachedHashes[i] == 0) {
+    uint32_t slotHash = hashAt(i);
+    if (slotHash == 0) {
       break;
     }
-    if (_cachedHashes[i] == hash && _cachedData[i]->sameKey(key, keySize)) {
-      result = _cachedData[i];
+    if (slotHash == hash && valueAt(i)->sameKey(key, keySize)) {
+      result = valueAt(i);
       if (moveToFront) {
         moveSlot(i, true);
       }
@@ -84,14 +85,54 @@ CachedValue* PlainBucket::find(uint32_t hash, void const* key, size_t keySize,
   return result;
 }
 
+bool PlainBucket::findOptimistic(uint32_t hash, void const* key,
+                                 size_t keySize, Finding& result) const {
+  uint32_t snapshot = _state.snapshot();
+  if (BucketState::isSet(snapshot, BucketState::Flag::locked) ||
+      BucketState::isSet(snapshot, BucketState::Flag::migrated)) {
+    return false;
+  }
+
+  CachedValue* value = nullptr;
+  size_t i = 0;
+  for (; i < slotsData; i++) {
+    uint32_t slotHash = hashAt(i);
+    if (slotHash == 0) {
+      break;
+    }
+    if (slotHash == hash) {
+      // a concurrent writer may have shifted the slots, but the value itself
+      // is not freed while we are registered as reader
+      CachedValue* candidate = valueAt(i);
+      if (candidate != nullptr && candidate->sameKey(key, keySize)) {
+        value = candidate;
+        break;
+      }
+    }
+  }
+
+  if (value != nullptr) {
+    if (i >= slotsData / 2) {
+      return false;
+    }
+    result.set(value);
+  }
+
+  if (!_state.validate(snapshot)) {
+    result.release();
+    return false;
+  }
+
+  return true;
+}
+
 // requires there to be an open slot, otherwise will not be inserted
 void PlainBucket::insert(uint32_t hash, CachedValue* value) {
   TRI_ASSERT(isLocked());
   for (size_t i = 0; i < slotsData; i++) {
-    if (_cachedHashes[i] == 0) {
+    if (hashAt(i) == 0) {
       // found an empty slot
-      _cachedHashes[i] = hash;
-      _cachedData[i] = value;
+      setSlot(i, hash, value);
       if (i != 0) {
         moveSlot(i, true);
       }
@@ -115,11 +156,12 @@ CachedValue* PlainBucket::evictionCandidate(bool ignoreRefCount) const {
   TRI_ASSERT(isLocked());
   for (size_t i = 0; i < slotsData; i++) {
     size_t slot = slotsData - (i + 1);
-    if (_cachedData[slot] == nullptr) {
+    CachedValue* value = valueAt(slot);
+    if (value == nullptr) {
       continue;
     }
-    if (ignoreRefCount || _cachedData[slot]->isFreeable()) {
-      return _cachedData[slot];
+    if (ignoreRefCount || value->isFreeable()) {
+      return value;
     }
   }
 
@@ -130,10 +172,9 @@ void PlainBucket::evict(CachedValue* value, bool optimizeForInsertion) {
   TRI_ASSERT(isLocked());
   for (size_t i = 0; i < slotsData; i++) {
     size_t slot = slotsData - (i + 1);
-    if (_cachedData[slot] == value) {
+    if (valueAt(slot) == value) {
       // found a match
-      _cachedHashes[slot] = 0;
-      _cachedData[slot] = nullptr;
+      setSlot(slot, 0, nullptr);
       moveSlot(slot, optimizeForInsertion);
       return;
     }
@@ -145,8 +186,7 @@ void PlainBucket::clear() {
   _state.clear(); // "clear" will keep the lock!
 
   for (size_t i = 0; i < slotsData; ++i) {
-    _cachedHashes[i] = 0;
-    _cachedData[i] = nullptr;
+    setSlot(i, 0, nullptr);
   }
 
   _state.unlock();
@@ -154,22 +194,19 @@ void PlainBucket::clear() {
 
 void PlainBucket::moveSlot(size_t slot, bool moveToFront) {
   TRI_ASSERT(isLocked());
-  uint32_t hash = _cachedHashes[slot];
-  CachedValue* value = _cachedData[slot];
+  uint32_t hash = hashAt(slot);
+  CachedValue* value = valueAt(slot);
   size_t i = slot;
   if (moveToFront) {
     // move slot to front
     for (; i >= 1; i--) {
-      _cachedHashes[i] = _cachedHashes[i - 1];
-      _cachedData[i] = _cachedData[i - 1];
+      setSlot(i, hashAt(i - 1), valueAt(i - 1));
     }
   } else {
     // move slot to back
-    for (; (i < slotsData - 1) && (_cachedHashes[i + 1] != 0); i++) {
-      _cachedHashes[i] = _cachedHashes[i + 1];
-      _cachedData[i] = _cachedData[i + 1];
+    for (; (i < slotsData - 1) && (hashAt(i + 1) != 0); i++) {
+      setSlot(i, hashAt(i + 1), valueAt(i + 1));
     }
   }
-  _cachedHashes[i] = hash;
-  _cachedData[i] = value;
+  setSlot(i, hash, value);
 }
@@ -28,6 +28,7 @@
 #include "Cache/BucketState.h"
 #include "Cache/CachedValue.h"
 #include "Cache/Common.h"
+#include "Cache/Finding.h"
 
 #include <stdint.h>
 #include <atomic>
@@ -49,10 +50,12 @@ struct PlainBucket {
 
   uint32_t _paddingExplicit; // fill 4-byte gap for alignment purposes
 
-  // actual cached entries
+  // actual cached entries. optimistic lookups read them without holding the
+  // lock, so they are atomic. writers hold the lock and store them relaxed,
+  // and readers validate the state after loading them relaxed
   static constexpr size_t slotsData = 10;
-  uint32_t _cachedHashes[slotsData];
-  CachedValue* _cachedData[slotsData];
+  std::atomic<uint32_t> _cachedHashes[slotsData];
+  std::atomic<CachedValue*> _cachedData[slotsData];
 
 // padding, if necessary?
 #ifdef TRI_PADDING_32
@@ -103,6 +106,20 @@ struct PlainBucket {
   CachedValue* find(uint32_t hash, void const* key, size_t keySize,
                     bool moveToFront = true);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Looks up a given key without locking the bucket.
+  ///
+  /// Returns false if the lookup cannot be answered optimistically, because
+  /// the bucket is locked, migrated or was modified during the lookup, or
+  /// because the value was found in the back half of the bucket and should be
+  /// moved to the front by a locked lookup. Otherwise returns true, and a found
+  /// value is leased into the result. The caller must hold an
+  /// OptimisticReaders::Guard, and values unlinked from the bucket must only be
+  /// freed after OptimisticReaders::waitForReaders.
+  //////////////////////////////////////////////////////////////////////////////
+  bool findOptimistic(uint32_t hash, void const* key, size_t keySize,
+                      Finding& result) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Inserts a given value. Requires state to be locked.
   ///
@@ -154,6 +171,22 @@ struct PlainBucket {
   //////////////////////////////////////////////////////////////////////////////
   void clear();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Access to the slots. Writing requires state to be locked.
+  //////////////////////////////////////////////////////////////////////////////
+  inline uint32_t hashAt(size_t slot) const {
+    return _cachedHashes[slot].load(std::memory_order_relaxed);
+  }
+
+  inline CachedValue* valueAt(size_t slot) const {
+    return _cachedData[slot].load(std::memory_order_relaxed);
+  }
+
+  inline void setSlot(size_t slot, uint32_t hash, CachedValue* value) {
+    _cachedHashes[slot].store(hash, std::memory_order_relaxed);
+    _cachedData[slot].store(value, std::memory_order_relaxed);
+  }
+
  private:
   void moveSlot(size_t slot, bool moveToFront);
 };
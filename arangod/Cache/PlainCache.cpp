@@ -29,6 +29,7 @@
 #include "Cache/Finding.h"
 #include "Cache/FrequencyBuffer.h"
 #include "Cache/Metadata.h"
+#include "Cache/OptimisticReaders.h"
 #include "Cache/PlainBucket.h"
 #include "Cache/Table.h"
 
@@ -45,6 +46,10 @@ Finding PlainCache::find(void const* key, uint32_t keySize) {
   Finding result;
   uint32_t hash = hashKey(key, keySize);
 
+  if (findOptimistic(hash, key, keySize, result)) {
+    return result;
+  }
+
   Result status;
   PlainBucket* bucket;
   Table* source;
@@ -54,11 +59,16 @@ Finding PlainCache::find(void const* key, uint32_t keySize) {
     return result;
   }
 
+  source->admission().record(hash);
   result.set(bucket->find(hash, key, keySize));
   if (result.found()) {
     recordStat(Stat::findHit);
+    recordLocality(bucket);
   } else {
     recordStat(Stat::findMiss);
+    if (source->isGhost(hash)) {
+      _ghostHits.add(1, std::memory_order_relaxed);
+    }
     status.reset(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
     result.reportError(status);
   }
@@ -81,6 +91,7 @@ Result PlainCache::insert(CachedValue* value) {
 
   bool allowed = true;
   bool maybeMigrate = false;
+  CachedValue* retired = nullptr;
   int64_t change = static_cast<int64_t>(value->size());
   CachedValue* candidate = bucket->find(hash, value->key(), value->keySize());
 
@@ -89,6 +100,13 @@ Result PlainCache::insert(CachedValue* value) {
     if (candidate == nullptr) {
       allowed = false;
       status.reset(TRI_ERROR_ARANGO_BUSY);
+    } else if (!admit(source, hash, candidate)) {
+      // the new value is not used often enough to replace the candidate,
+      // but the full bucket still counts towards the eviction rate
+      allowed = false;
+      maybeMigrate = reportInsert(true);
+      source->recordGhost(hash);
+      status.reset(TRI_ERROR_RESOURCE_LIMIT);
     }
   }
 
@@ -107,8 +125,10 @@ Result PlainCache::insert(CachedValue* value) {
         bucket->evict(candidate, true);
         if (!candidate->sameKey(value->key(), value->keySize())) {
           eviction = true;
+          source->recordGhost(
+              hashKey(candidate->key(), candidate->keySize()));
         }
-        freeValue(candidate);
+        retired = candidate;
       }
       bucket->insert(hash, value);
       if (!eviction) {
@@ -122,6 +142,9 @@ Result PlainCache::insert(CachedValue* value) {
   }
 
   bucket->unlock();
+  if (retired != nullptr) {
+    retireValue(retired);
+  }
   if (maybeMigrate) {
     requestMigrate(source->idealSize());  // let function do the hard work
   }
@@ -152,11 +175,13 @@ Result PlainCache::remove(void const* key, uint32_t keySize) {
     TRI_ASSERT(allowed);
     _metadata.readUnlock();
 
-    freeValue(candidate);
     maybeMigrate = source->slotEmptied();
   }
 
   bucket->unlock();
+  if (candidate != nullptr) {
+    retireValue(candidate);
+  }
   if (maybeMigrate) {
     requestMigrate(source->idealSize());
   }
@@ -196,6 +221,10 @@ PlainCache::~PlainCache() {
       // no exceptions allowed here
     }
   }
+
+  std::vector<CachedValue*> retired;
+  retired.swap(_retired);
+  freeRetired(retired);
 }
 
 uint64_t PlainCache::freeMemoryFrom(uint32_t hash) {
@@ -215,11 +244,13 @@ uint64_t PlainCache::freeMemoryFrom(uint32_t hash) {
   if (candidate != nullptr) {
     reclaimed = candidate->size();
     bucket->evict(candidate);
-    freeValue(candidate);
     maybeMigrate = source->slotEmptied();
   }
 
   bucket->unlock();
+  if (candidate != nullptr) {
+    retireValue(candidate);
+  }
   
   cache::Table* table = _table.load(std::memory_order_relaxed);
   if (table) {
@@ -235,6 +266,8 @@ uint64_t PlainCache::freeMemoryFrom(uint32_t hash) {
 void PlainCache::migrateBucket(void* sourcePtr,
                                std::unique_ptr<Table::Subtable> targets,
                                std::shared_ptr<Table> newTable) {
+  std::vector<CachedValue*> retired;
+
   // lock current bucket
   auto source = reinterpret_cast<PlainBucket*>(sourcePtr);
   source->lock(Cache::triesGuarantee);
@@ -247,9 +280,9 @@ void PlainCache::migrateBucket(void* sourcePtr,
 
   for (size_t j = 0; j < PlainBucket::slotsData; j++) {
     size_t k = PlainBucket::slotsData - (j + 1);
-    if (source->_cachedHashes[k] != 0) {
-      uint32_t hash = source->_cachedHashes[k];
-      CachedValue* value = source->_cachedData[k];
+    if (source->hashAt(k) != 0) {
+      uint32_t hash = source->hashAt(k);
+      CachedValue* value = source->valueAt(k);
 
       auto targetBucket =
           reinterpret_cast<PlainBucket*>(targets->fetchBucket(hash));
@@ -258,9 +291,8 @@ void PlainCache::migrateBucket(void* sourcePtr,
         CachedValue* candidate = targetBucket->evictionCandidate();
         if (candidate != nullptr) {
           targetBucket->evict(candidate, true);
-          uint64_t size = candidate->size();
-          freeValue(candidate);
-          reclaimMemory(size);
+          reclaimMemory(candidate->size());
+          retired.emplace_back(candidate);
           newTable->slotEmptied();
         } else {
           haveSpace = false;
@@ -270,13 +302,11 @@ void PlainCache::migrateBucket(void* sourcePtr,
         targetBucket->insert(hash, value);
         newTable->slotFilled();
       } else {
-        uint64_t size = value->size();
-        freeValue(value);
-        reclaimMemory(size);
+        reclaimMemory(value->size());
+        retired.emplace_back(value);
       }
 
-      source->_cachedHashes[k] = 0;
-      source->_cachedData[k] = nullptr;
+      source->setSlot(k, 0, nullptr);
     }
   }
 
@@ -290,6 +320,43 @@ void PlainCache::migrateBucket(void* sourcePtr,
   // finish up this bucket's migration
   source->_state.toggleFlag(BucketState::Flag::migrated);
   source->unlock();
+
+  retireValues(retired);
+}
+
+std::vector<std::string> PlainCache::hotKeys(size_t limit) {
+  return collectHotKeys<PlainBucket>(limit);
+}
+
+bool PlainCache::findOptimistic(uint32_t hash, void const* key,
+                                uint32_t keySize, Finding& result) {
+  // tables are only released and values only freed once we are done
+  OptimisticReaders::Guard guard;
+
+  Table* table = _table.load(std::memory_order_acquire);
+  if (isShutdown() || table == nullptr) {
+    return false;
+  }
+
+  auto bucket = reinterpret_cast<PlainBucket*>(table->optimisticBucket(hash));
+  if (!bucket->findOptimistic(hash, key, keySize, result)) {
+    return false;
+  }
+
+  _manager->reportAccess(_id);
+  table->admission().record(hash);
+  if (result.found()) {
+    recordStat(Stat::findHit);
+    recordLocality(bucket);
+  } else {
+    recordStat(Stat::findMiss);
+    if (table->isGhost(hash)) {
+      _ghostHits.add(1, std::memory_order_relaxed);
+    }
+    result.reportError(Result(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND));
+  }
+
+  return true;
 }
 
 std::tuple<Result, PlainBucket*, Table*> PlainCache::getBucket(
@@ -325,9 +392,10 @@ Table::BucketClearer PlainCache::bucketClearer(Metadata* metadata) {
     auto bucket = reinterpret_cast<PlainBucket*>(ptr);
     bucket->lock(Cache::triesGuarantee);
     for (size_t j = 0; j < PlainBucket::slotsData; j++) {
-      if (bucket->_cachedData[j] != nullptr) {
-        uint64_t size = bucket->_cachedData[j]->size();
-        freeValue(bucket->_cachedData[j]);
+      CachedValue* value = bucket->valueAt(j);
+      if (value != nullptr) {
+        uint64_t size = value->size();
+        freeValue(value);
         metadata->readLock(); // special case
         metadata->adjustUsageIfAllowed(-static_cast<int64_t>(size));
         metadata->readUnlock();
@@ -336,3 +404,61 @@ Table::BucketClearer PlainCache::bucketClearer(Metadata* metadata) {
     bucket->clear();
   };
 }
+
+void PlainCache::retireValue(CachedValue* value) {
+  std::vector<CachedValue*> retired;
+  _retiredLock.writeLock();
+  try {
+    _retired.emplace_back(value);
+  } catch (...) {
+    // cannot defer it, so free it right away
+    _retiredLock.writeUnlock();
+    OptimisticReaders::waitForReaders();
+    freeValue(value);
+    return;
+  }
+  if (_retired.size() >= retiredBatchSize) {
+    retired.swap(_retired);
+  }
+  _retiredLock.writeUnlock();
+
+  freeRetired(retired);
+}
+
+void PlainCache::retireValues(std::vector<CachedValue*>& values) {
+  if (values.empty()) {
+    return;
+  }
+
+  std::vector<CachedValue*> retired;
+  _retiredLock.writeLock();
+  if (_retired.size() + values.size() < retiredBatchSize) {
+    try {
+      _retired.insert(_retired.end(), values.begin(), values.end());
+      values.clear();
+    } catch (...) {
+      // free them right away below
+    }
+  } else {
+    // this thread frees the pending values together with its own
+    retired.swap(_retired);
+  }
+  _retiredLock.writeUnlock();
+
+  freeRetired(values);
+  for (CachedValue* value : retired) {
+    freeValue(value);
+  }
+}
+
+void PlainCache::freeRetired(std::vector<CachedValue*> const& values) {
+  if (values.empty()) {
+    return;
+  }
+  // a single wait for the whole batch, so that writers do not wait for the
+  // readers on every eviction
+  OptimisticReaders::waitForReaders();
+  for (CachedValue* value : values) {
+    freeValue(value);
+  }
+}
@@ -25,6 +25,7 @@
 #define ARANGODB_CACHE_PLAIN_CACHE_H
 
 #include "Basics/Common.h"
+#include "Basics/ReadWriteSpinLock.h"
 #include "Cache/Cache.h"
 #include "Cache/CachedValue.h"
 #include "Cache/Common.h"
@@ -40,6 +41,7 @@
 #include <atomic>
 #include <chrono>
 #include <list>
+#include <vector>
 
 namespace arangodb {
 namespace cache {
@@ -66,7 +68,9 @@ class PlainCache final : public Cache {
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Looks up the given key.
   ///
-  /// May report a false negative if it fails to acquire a lock in a timely
+  /// Misses and hits in the front half of a bucket are answered without
+  /// locking the bucket, see PlainBucket::findOptimistic. Otherwise, may
+  /// report a false negative if it fails to acquire a lock in a timely
   /// fashion. The Result contained in the return value should report an error
   /// code in this case. Should not block for long.
   //////////////////////////////////////////////////////////////////////////////
@@ -113,13 +117,28 @@ class PlainCache final : public Cache {
   virtual void migrateBucket(void* sourcePtr,
                              std::unique_ptr<Table::Subtable> targets,
                              std::shared_ptr<Table> newTable) override;
+  virtual std::vector<std::string> hotKeys(size_t limit) override;
 
   // helpers
+  bool findOptimistic(uint32_t hash, void const* key, uint32_t keySize,
+                      Finding& result);
   std::tuple<Result, PlainBucket*, Table*> getBucket(
       uint32_t hash, uint64_t maxTries, bool singleOperation = true);
   uint32_t getIndex(uint32_t hash, bool useAuxiliary) const;
 
   static Table::BucketClearer bucketClearer(Metadata* metadata);
+
+  // frees values unlinked from their buckets, once no optimistic reader
+  // can see them anymore. the values are collected and freed in batches
+  void retireValue(CachedValue* value);
+  void retireValues(std::vector<CachedValue*>& values);
+  static void freeRetired(std::vector<CachedValue*> const& values);
+
+ private:
+  static constexpr size_t retiredBatchSize = 64;
+
+  basics::ReadWriteSpinLock _retiredLock;
+  std::vector<CachedValue*> _retired;
 };
 
 };  // end namespace cache
@@ -24,6 +24,7 @@
 #include "Cache/Table.h"
 #include "Basics/Common.h"
 #include "Cache/Common.h"
+#include "Cache/NumaPlacement.h"
 
 #include <stdint.h>
 #include <memory>
@@ -84,7 +85,7 @@ bool Table::Subtable::applyToAllBuckets(std::function<bool(void*)> cb) {
   return ok;
 }
 
-Table::Table(uint32_t logSize)
+Table::Table(uint32_t logSize, bool interleave)
     : _lock(),
       _disabled(true),
       _evictions(false),
@@ -99,10 +100,19 @@ Table::Table(uint32_t logSize)
       _auxiliary(nullptr),
       _bucketClearer(defaultClearer),
       _slotsTotal(_size),
-      _slotsUsed(static_cast<uint64_t>(0)) {
+      _slotsUsed(static_cast<uint64_t>(0)),
+      _admission(_size * FrequencySketch::countersPerWord),
+      _ghosts(new std::atomic<uint32_t>[_size]) {
+  if (interleave) {
+    // must happen before the buckets are initialized, so that the pages
+    // are not yet bound to the node of this thread
+    NumaPlacement::interleave(_buffer.get(),
+                              (_size * BUCKET_SIZE) + Table::padding);
+  }
   for (size_t i = 0; i < _size; i++) {
     // use placement new in order to properly initialize the bucket
     new (_buckets + i) GenericBucket();
+    _ghosts[i].store(0, std::memory_order_relaxed);
   }
 }
 
@@ -117,7 +127,11 @@ Table::~Table() {
 
 uint64_t Table::allocationSize(uint32_t logSize) {
   return sizeof(Table) + (BUCKET_SIZE * (static_cast<uint64_t>(1) << logSize)) +
-         Table::padding;
+         Table::padding +
+         FrequencySketch::allocationSize(
+             FrequencySketch::countersPerWord *
+             (static_cast<uint64_t>(1) << logSize)) +
+         (sizeof(std::atomic<uint32_t>) * (static_cast<uint64_t>(1) << logSize));
 }
 
 uint64_t Table::memoryUsage() const { return Table::allocationSize(_logSize); }
@@ -182,6 +196,10 @@ void* Table::primaryBucket(uint64_t index) {
   return &(_buckets[index]);
 }
 
+void* Table::optimisticBucket(uint32_t hash) const {
+  return &(_buckets[(hash & _mask) >> _shift]);
+}
+
 std::unique_ptr<Table::Subtable> Table::auxiliaryBuckets(uint32_t index) {
   if (!isEnabled()) {
     return std::unique_ptr<Subtable>(nullptr);
@@ -227,6 +245,10 @@ void Table::clear() {
   }
   _bucketClearer = Table::defaultClearer;
   _slotsUsed = 0;
+  _admission.clear();
+  for (uint64_t i = 0; i < _size; i++) {
+    _ghosts[i].store(0, std::memory_order_relaxed);
+  }
 }
 
 void Table::disable() {
@@ -271,6 +293,16 @@ void Table::signalEvictions() {
   }
 }
 
+void Table::recordGhost(uint32_t hash) {
+  _ghosts[(hash & _mask) >> _shift].store(hash, std::memory_order_relaxed);
+}
+
+bool Table::isGhost(uint32_t hash) const {
+  // hashes are never 0, so an empty slot never matches
+  return _ghosts[(hash & _mask) >> _shift].load(std::memory_order_relaxed) ==
+         hash;
+}
+
 uint32_t Table::idealSize() {
   bool ok = _lock.writeLock(triesGuarantee);
   bool forceGrowth = false;
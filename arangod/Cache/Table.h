@@ -28,6 +28,7 @@
 #include "Basics/ReadWriteSpinLock.h"
 #include "Cache/BucketState.h"
 #include "Cache/Common.h"
+#include "Cache/FrequencySketch.h"
 
 #include <stdint.h>
 #include <memory>
@@ -87,8 +88,11 @@ class Table : public std::enable_shared_from_this<Table> {
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Construct a new table of size 2^(logSize) in disabled state.
+  ///
+  /// If interleave is set, the buckets are spread across all NUMA nodes
+  /// instead of being placed on the node of the allocating thread.
   //////////////////////////////////////////////////////////////////////////////
-  explicit Table(uint32_t logSize);
+  explicit Table(uint32_t logSize, bool interleave = false);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Destroy the table
@@ -145,6 +149,13 @@ class Table : public std::enable_shared_from_this<Table> {
   //////////////////////////////////////////////////////////////////////////////
   void* primaryBucket(uint64_t index);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns a pointer to the bucket in the primary table mapped by the
+  /// given hash, without locking the table or the bucket. Only for optimistic
+  /// readers, which must validate what they read from the bucket.
+  //////////////////////////////////////////////////////////////////////////////
+  void* optimisticBucket(uint32_t hash) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns a subtable in the auxiliary index which corresponds to the
   /// specified bucket in the primary table.
@@ -196,6 +207,27 @@ class Table : public std::enable_shared_from_this<Table> {
   //////////////////////////////////////////////////////////////////////////////
   uint32_t idealSize();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the admission filter of the table.
+  ///
+  /// The filter estimates the recent access frequency of the keys mapped to
+  /// the table, with 16 counters per bucket. It is reset with the table.
+  //////////////////////////////////////////////////////////////////////////////
+  FrequencySketch& admission() { return _admission; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Remember the hash of a key that was evicted or not admitted.
+  ///
+  /// Each bucket remembers the last such hash. A later miss on a remembered
+  /// hash is a miss that a larger cache would have turned into a hit.
+  //////////////////////////////////////////////////////////////////////////////
+  void recordGhost(uint32_t hash);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Check whether the hash was the last one remembered in its bucket.
+  //////////////////////////////////////////////////////////////////////////////
+  bool isGhost(uint32_t hash) const;
+
  private:
   basics::ReadWriteSpinLock _lock;
   bool _disabled;
@@ -215,6 +247,9 @@ class Table : public std::enable_shared_from_this<Table> {
   uint64_t _slotsTotal;
   std::atomic<uint64_t> _slotsUsed;
 
+  FrequencySketch _admission;
+  std::unique_ptr<std::atomic<uint32_t>[]> _ghosts;
+
  private:
   void disable();
   bool isEnabled(uint64_t maxTries = triesGuarantee);
@@ -55,11 +55,16 @@ Finding TransactionalCache::find(void const* key, uint32_t keySize) {
     return result;
   }
 
+  source->admission().record(hash);
   result.set(bucket->find(hash, key, keySize));
   if (result.found()) {
     recordStat(Stat::findHit);
+    recordLocality(bucket);
   } else {
     recordStat(Stat::findMiss);
+    if (source->isGhost(hash)) {
+      _ghostHits.add(1, std::memory_order_relaxed);
+    }
     status.reset(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
     result.reportError(status);
   }
@@ -92,6 +97,13 @@ Result TransactionalCache::insert(CachedValue* value) {
       if (candidate == nullptr) {
         allowed = false;
         status.reset(TRI_ERROR_ARANGO_BUSY);
+      } else if (!admit(source, hash, candidate)) {
+        // the new value is not used often enough to replace the candidate,
+        // but the full bucket still counts towards the eviction rate
+        allowed = false;
+        maybeMigrate = reportInsert(true);
+        source->recordGhost(hash);
+        status.reset(TRI_ERROR_RESOURCE_LIMIT);
       }
     }
 
@@ -110,6 +122,8 @@ Result TransactionalCache::insert(CachedValue* value) {
           bucket->evict(candidate, true);
           if (!candidate->sameKey(value->key(), value->keySize())) {
             eviction = true;
+            source->recordGhost(
+                hashKey(candidate->key(), candidate->keySize()));
           }
           freeValue(candidate);
         }
@@ -379,6 +393,10 @@ void TransactionalCache::migrateBucket(void* sourcePtr,
   source->unlock();
 }
 
+std::vector<std::string> TransactionalCache::hotKeys(size_t limit) {
+  return collectHotKeys<TransactionalBucket>(limit);
+}
+
 std::tuple<Result, TransactionalBucket*, Table*>
 TransactionalCache::getBucket(uint32_t hash, uint64_t maxTries,
                               bool singleOperation) {
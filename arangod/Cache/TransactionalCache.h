@@ -129,6 +129,7 @@ class TransactionalCache final : public Cache {
   virtual void migrateBucket(void* sourcePtr,
                              std::unique_ptr<Table::Subtable> targets,
                              std::shared_ptr<Table> newTable) override;
+  virtual std::vector<std::string> hotKeys(size_t limit) override;
 
   // helpers
   std::tuple<Result, TransactionalBucket*, Table*> getBucket(
@@ -114,6 +114,9 @@ public:
   /// @brief check if action matches worker options
   bool matches(std::unordered_set<std::string> const& labels) const;
 
+  /// @brief ready actions of higher priority are executed first
+  int priority() const { return _action->priority(); }
+
   /// @brief return progress statistic
   uint64_t getProgress() const { return _action->getProgress(); }
 
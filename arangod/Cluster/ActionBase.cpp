@@ -36,6 +36,9 @@ using namespace arangodb::maintenance;
 
 std::string const ActionBase::FAST_TRACK = "fastTrack";
 
+int const ActionBase::NORMAL_PRIORITY = 0;
+int const ActionBase::HIGH_PRIORITY = 1;
+
 inline static std::chrono::system_clock::duration secs_since_epoch() {
   return std::chrono::system_clock::now().time_since_epoch();
 }
@@ -59,6 +62,7 @@ void ActionBase::init() {
   _hash = _description.hash();
   _clientId = std::to_string(_hash);
   _id = _feature.nextActionId();
+  _priority = NORMAL_PRIORITY;
 
   // initialization of duration struct is not guaranteed in atomic form
   _actionCreated = secs_since_epoch();
@@ -179,9 +179,15 @@ class ActionBase {
 
   /// @brief check if worker lables match ours
   bool matches(std::unordered_set<std::string> const& options) const;
+
+  /// @brief ready actions of higher priority are executed first
+  int priority() const {return _priority;}
   
   std::string const static FAST_TRACK; 
 
+  int const static NORMAL_PRIORITY;
+  int const static HIGH_PRIORITY;
+
 protected:
 
   /// @brief common initialization for all constructors
@@ -194,6 +200,10 @@ protected:
   // @brief optional labels for matching to woker labels
   std::unordered_set<std::string> _labels;
 
+  // @brief priority among ready actions, set by the constructors of actions
+  //  which unblock other servers
+  int _priority;
+
   uint64_t _hash;
   std::string _clientId;
 
@@ -29,8 +29,10 @@
 #include "Basics/HybridLogicalClock.h"
 #include "Basics/StringUtils.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/ConnectionPool.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
+#include "GeneralServer/RestHandler.h"
 #include "Logger/Logger.h"
 #include "Scheduler/JobGuard.h"
 #include "Scheduler/SchedulerFeature.h"
@@ -43,6 +45,88 @@
 using namespace arangodb;
 using namespace arangodb::communicator;
 
+namespace {
+fuerte::RestVerb toRestVerb(rest::RequestType type) {
+  switch (type) {
+    case rest::RequestType::DELETE_REQ:
+      return fuerte::RestVerb::Delete;
+    case rest::RequestType::GET:
+      return fuerte::RestVerb::Get;
+    case rest::RequestType::POST:
+      return fuerte::RestVerb::Post;
+    case rest::RequestType::PUT:
+      return fuerte::RestVerb::Put;
+    case rest::RequestType::HEAD:
+      return fuerte::RestVerb::Head;
+    case rest::RequestType::PATCH:
+      return fuerte::RestVerb::Patch;
+    case rest::RequestType::OPTIONS:
+      return fuerte::RestVerb::Options;
+    default:
+      return fuerte::RestVerb::Illegal;
+  }
+}
+
+/// @brief split a path like /_db/<name>/_api/...?a=b into its parts. the
+/// parts are url-encoded in the path, but fuerte encodes them again
+void setPath(fuerte::RequestHeader& header, std::string const& path) {
+  header.parseArangoPath(path);
+  header.database = basics::StringUtils::urlDecode(header.database);
+
+  fuerte::StringMap parameters;
+  for (auto const& it : header.parameters) {
+    parameters.emplace(basics::StringUtils::urlDecode(it.first),
+                       basics::StringUtils::urlDecode(it.second));
+  }
+  header.parameters = std::move(parameters);
+}
+
+/// @brief error code of a failed request, like the ones reported by the
+/// communicators
+int toArangoError(fuerte::Error error) {
+  switch (fuerte::intToError(error)) {
+    case fuerte::ErrorCondition::CouldNotConnect:
+    case fuerte::ErrorCondition::MalformedURL:
+    case fuerte::ErrorCondition::WriteError:
+      return TRI_SIMPLE_CLIENT_COULD_NOT_CONNECT;
+    case fuerte::ErrorCondition::Timeout:
+    case fuerte::ErrorCondition::ReadError:
+    case fuerte::ErrorCondition::ConnectionClosed:
+      return TRI_ERROR_CLUSTER_TIMEOUT;
+    case fuerte::ErrorCondition::Canceled:
+    case fuerte::ErrorCondition::CloseRequested:
+      return TRI_COMMUNICATOR_REQUEST_ABORTED;
+    default:
+      return TRI_ERROR_INTERNAL;
+  }
+}
+
+/// @brief response as delivered by the communicators. ClusterCommResult
+/// expects a JSON body, VelocyPack bodies of VelocyStream are converted
+std::unique_ptr<HttpResponse> toHttpResponse(fuerte::Response& res) {
+  auto response = std::make_unique<HttpResponse>(
+      static_cast<rest::ResponseCode>(res.statusCode()));
+
+  std::unordered_map<std::string, std::string> headers;
+  for (auto const& it : res.header.meta) {
+    headers.emplace(basics::StringUtils::tolower(it.first), it.second);
+  }
+
+  if (res.isContentTypeVPack()) {
+    for (auto const& slice : res.slices()) {
+      response->body().appendText(slice.toJson());
+    }
+    headers[StaticStrings::ContentTypeHeader] = StaticStrings::MimeTypeJson;
+  } else {
+    auto payload = res.payload();
+    response->body().appendText(static_cast<char const*>(payload.data()),
+                                payload.size());
+  }
+  response->setHeaders(std::move(headers));
+  return response;
+}
+}  // namespace
+
 /// @brief empty map with headers
 std::unordered_map<std::string, std::string> const ClusterCommRequest::noHeaders;
 
@@ -423,7 +507,7 @@ OperationID ClusterComm::asyncRequest(
     std::unordered_map<std::string, std::string> const& headerFields,
     std::shared_ptr<ClusterCommCallback> callback, ClusterCommTimeout timeout,
     bool singleRequest, ClusterCommTimeout initTimeout) {
-  auto prepared = prepareRequest(destination, reqtype, body.get(), headerFields);
+  auto prepared = prepareRequest(destination, reqtype, body.get(), headerFields, timeout);
   std::shared_ptr<ClusterCommResult> result(prepared.first);
   result->coordTransactionID = coordTransactionID;
   result->single = singleRequest;
@@ -486,8 +570,16 @@ OperationID ClusterComm::asyncRequest(
 
   TRI_ASSERT(request != nullptr);
   CONDITION_LOCKER(locker, somethingReceived);
-  auto ticketId = communicator()->addRequest(createCommunicatorDestination(result->endpoint, path),
-               std::move(request), callbacks, opt);
+  communicator::Ticket ticketId;
+  if (_pool != nullptr) {
+    // the callbacks are executed by the scheduler, so they cannot run
+    // before the response is registered below
+    ticketId = getOperationID();
+    sendViaPool(result->endpoint, path, std::move(request), callbacks, timeout);
+  } else {
+    ticketId = communicator()->addRequest(createCommunicatorDestination(result->endpoint, path),
+                 std::move(request), callbacks, opt);
+  }
 
   result->operationID = ticketId;
   responses.emplace(ticketId, AsyncResponse{TRI_microtime(), result});
@@ -519,7 +611,7 @@ std::unique_ptr<ClusterCommResult> ClusterComm::syncRequest(
     std::string const& body,
     std::unordered_map<std::string, std::string> const& headerFields,
     ClusterCommTimeout timeout) {
-  auto prepared = prepareRequest(destination, reqtype, &body, headerFields);
+  auto prepared = prepareRequest(destination, reqtype, &body, headerFields, timeout);
   std::unique_ptr<ClusterCommResult> result(prepared.first);
   // mop: this is used to distinguish a syncRequest from an asyncRequest while processing
   // the answer...
@@ -556,8 +648,12 @@ std::unique_ptr<ClusterCommResult> ClusterComm::syncRequest(
   TRI_ASSERT(request != nullptr);
   result->status = CL_COMM_SENDING;
   CONDITION_LOCKER(isen, cv);
-  communicator()->addRequest(createCommunicatorDestination(result->endpoint, path),
-               std::move(request), callbacks, opt);
+  if (_pool != nullptr) {
+    sendViaPool(result->endpoint, path, std::move(request), callbacks, timeout);
+  } else {
+    communicator()->addRequest(createCommunicatorDestination(result->endpoint, path),
+                 std::move(request), callbacks, opt);
+  }
 
   while (!wasSignaled) {
     cv.wait(100000);
@@ -1075,16 +1171,24 @@ private:
   std::vector<ClusterCommTimeout> dueTime;
   size_t nrDone = 0;
   size_t nrGood = 0;
+  bool _finished = false;
 
 public:
 
-  // scheduler requests that are due
+  // scheduler requests that are due. the callbacks of the requests lock
+  // the mutex as well, so they cannot run before the operation ids are
+  // registered
   void performTasks(bool lock) {
     std::unique_lock<std::mutex> guard(mutex, std::defer_lock);
     if (lock) {
       guard.lock();
     }
 
+    if (_finished) {
+      // a timer fired after the last response arrived
+      return;
+    }
+
     double now = TRI_microtime();
     if (now > _endTime || nrDone == _requests.size() ||
         application_features::ApplicationServer::isStopping()) {
@@ -1113,7 +1217,6 @@ public:
                                               req.getHeaders(), shared_from_this(), localTimeout, false,
                                               2.0);
           TRI_ASSERT(opId != 0);
-          std::lock_guard<std::mutex> guard(mutex);
           opIDtoIndex.insert(std::make_pair(opId, i));
 
         } else if (dueTime[i] < actionNeeded) {
@@ -1128,11 +1231,11 @@ public:
       _timer.reset(SchedulerFeature::SCHEDULER->newSteadyTimer());
     }
 
-    // TODO what about a shutdown, this will leak ??
+    // the timer keeps us alive until the next due time, the scheduler
+    // cancels it on shutdown
     auto self = shared_from_this();
-    auto duration = std::chrono::duration<double>(actionNeeded);
-    std::chrono::steady_clock::time_point tp(std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
-    _timer->expires_at(tp);
+    auto duration = std::chrono::duration<double>(actionNeeded - now);
+    _timer->expires_from_now(std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
     _timer->async_wait([self, this] (asio_ns::error_code ec) {
       if (!ec) {
         this->performTasks(true);
@@ -1143,20 +1246,27 @@ public:
 private:
 
   void finishExecution() {
+    _finished = true;
     if (nrDone < _requests.size()) {
       // We only get here if the global timeout was triggered, not all
       // requests are marked by done!
       ClusterComm::instance()->drop(_coordTransactionID, 0, "");
     }
-    _timer->cancel();
-    _timer.reset();
+    if (_timer) {
+      _timer->cancel();
+      _timer.reset();
+    }
     TRI_ASSERT(_callback);
-    _callback(_requests, nrDone, nrGood);
+    _callback(std::move(_requests), nrDone, nrGood);
   }
 
   bool operator()(ClusterCommResult* res) override {
 
     std::lock_guard<std::mutex> guard(mutex);
+    if (_finished) {
+      // a late answer to a request we gave up on
+      return true;
+    }
     auto it = opIDtoIndex.find(res->operationID);
     TRI_ASSERT(it != opIDtoIndex.end());
     TRI_ASSERT(res->status != CL_COMM_DROPPED);
@@ -1240,6 +1350,18 @@ void ClusterComm::performAsyncRequests(std::vector<ClusterCommRequest>&& reqs, C
   state->performTasks(true);
 }
 
+futures::Future<std::vector<ClusterCommRequest>> ClusterComm::performRequestsAsync(
+    std::vector<ClusterCommRequest>&& requests, ClusterCommTimeout timeout,
+    bool retryOnCollNotFound) {
+  auto promise = std::make_shared<futures::Promise<std::vector<ClusterCommRequest>>>();
+  auto future = promise->getFuture();
+  performAsyncRequests(std::move(requests), timeout, retryOnCollNotFound,
+                       [promise](std::vector<ClusterCommRequest>&& requests, size_t, size_t) {
+                         promise->setValue(std::move(requests));
+                       });
+  return future;
+}
+
 communicator::Destination ClusterComm::createCommunicatorDestination(std::string const& endpoint, std::string const& path) {
   std::string httpEndpoint;
   if (endpoint.substr(0, 6) == "tcp://") {
@@ -1253,7 +1375,8 @@ communicator::Destination ClusterComm::createCommunicatorDestination(std::string
 
 std::pair<ClusterCommResult*, HttpRequest*> ClusterComm::prepareRequest(std::string const& destination,
       arangodb::rest::RequestType reqtype, std::string const* body,
-      std::unordered_map<std::string, std::string> const& headerFields) {
+      std::unordered_map<std::string, std::string> const& headerFields,
+      ClusterCommTimeout timeout) {
   HttpRequest* request = nullptr;
   auto result = std::make_unique<ClusterCommResult>();
   result->setDestination(destination, logConnectionErrors());
@@ -1280,6 +1403,23 @@ std::pair<ClusterCommResult*, HttpRequest*> ClusterComm::prepareRequest(std::str
     }
   }
 
+  // tell the receiver when we stop waiting, so that it can drop the request
+  // instead of executing it after we gave up. if we are executing a request
+  // with a deadline ourselves, nobody waits longer than that
+  if (headersCopy.find(StaticStrings::RequestTimeout) == headersCopy.end()) {
+    rest::RestHandler const* handler = rest::RestHandler::CURRENT_HANDLER;
+    if (handler != nullptr && handler->deadline() > 0.0) {
+      double const remaining = handler->remainingTime();
+      if (timeout <= 0.0 || remaining < timeout) {
+        timeout = remaining;
+      }
+    }
+    if (timeout > 0.0) {
+      headersCopy.emplace(StaticStrings::RequestTimeout,
+                          std::to_string(timeout));
+    }
+  }
+
 #ifdef DEBUG_CLUSTER_COMM
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
 #if ARANGODB_ENABLE_BACKTRACE
@@ -1327,6 +1467,61 @@ void ClusterComm::disable() {
     thread->communicator()->disable();
     thread->communicator()->abortRequests();
   }
+  if (_pool != nullptr) {
+    _pool->shutdown();
+  }
+}
+
+void ClusterComm::setConnectionPool(std::unique_ptr<ConnectionPool> pool) {
+  TRI_ASSERT(_pool == nullptr);
+  LOG_TOPIC(INFO, Logger::CLUSTER)
+      << "sending cluster-internal requests via pooled "
+      << fuerte::to_string(pool->protocol()) << " connections";
+  _pool = std::move(pool);
+}
+
+void ClusterComm::sendViaPool(std::string const& endpoint,
+                              std::string const& path,
+                              std::unique_ptr<HttpRequest> request,
+                              communicator::Callbacks const& callbacks,
+                              ClusterCommTimeout timeout) {
+  auto req = std::make_unique<fuerte::Request>();
+  req->header.restVerb = ::toRestVerb(request->requestType());
+  ::setPath(req->header, path);
+  for (auto const& it : request->headers()) {
+    req->header.addMeta(it.first, it.second);
+  }
+  // does not overwrite a content type set by the caller
+  req->header.contentType(fuerte::ContentType::Json);
+
+  std::string const& body = request->body();
+  if (!body.empty()) {
+    req->addBinary(reinterpret_cast<uint8_t const*>(body.data()), body.size());
+  }
+  if (timeout > 0.0) {
+    req->timeout(std::chrono::milliseconds(static_cast<int64_t>(timeout * 1000.0)));
+  }
+
+  // the future is fulfilled on an I/O thread of the pool, which must not
+  // block in the callbacks
+  _pool->sendRequest(endpoint, std::move(req))
+      .thenFinal([callbacks](futures::Try<ConnectionPool::Result>&& t) {
+        auto result = std::make_shared<ConnectionPool::Result>(std::move(t.get()));
+        callbacks._scheduleMe([callbacks, result]() {
+          if (result->error != fuerte::errorToInt(fuerte::ErrorCondition::NoError)) {
+            callbacks._onError(::toArangoError(result->error), {nullptr});
+            return;
+          }
+          TRI_ASSERT(result->response != nullptr);
+          std::unique_ptr<HttpResponse> response = ::toHttpResponse(*result->response);
+          int const code = static_cast<int>(response->responseCode());
+          if (code < 400) {
+            callbacks._onSuccess(std::move(response));
+          } else {
+            callbacks._onError(code, std::move(response));
+          }
+        });
+      });
 }
 
 void ClusterComm::scheduleMe(std::function<void()> task) {
@@ -34,6 +34,7 @@
 #include "Basics/ReadWriteLock.h"
 #include "Basics/Thread.h"
 #include "Cluster/ClusterInfo.h"
+#include "Futures/Future.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralRequest.h"
 #include "Rest/GeneralResponse.h"
@@ -47,6 +48,7 @@
 
 namespace arangodb {
 class ClusterCommThread;
+class ConnectionPool;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief type of a coordinator transaction ID
@@ -579,10 +581,26 @@ class ClusterComm {
   ////////////////////////////////////////////////////////////////////////////////
   void fireAndForgetRequests(std::vector<ClusterCommRequest> const& requests);
 
-  typedef std::function<void(std::vector<ClusterCommRequest> const&, size_t, size_t)> AsyncCallback;
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief performs the requests like performRequests does, including the
+  /// retries, but without blocking the calling thread. the callback is
+  /// called with the requests, the number of finished requests and the
+  /// number of successful ones on a scheduler thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  typedef std::function<void(std::vector<ClusterCommRequest>&&, size_t, size_t)> AsyncCallback;
   void performAsyncRequests(std::vector<ClusterCommRequest>&&, ClusterCommTimeout timeout,
                             bool retryOnCollNotFound, AsyncCallback const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief performAsyncRequests, with a future for the requests. requests
+  /// which did not finish in time are not marked as done
+  //////////////////////////////////////////////////////////////////////////////
+
+  futures::Future<std::vector<ClusterCommRequest>> performRequestsAsync(
+      std::vector<ClusterCommRequest>&& requests, ClusterCommTimeout timeout,
+      bool retryOnCollNotFound);
+
   void addAuthorization(std::unordered_map<std::string, std::string>* headers);
 
   //////////////////////////////////////////////////////////////////////////////
@@ -591,6 +609,13 @@ class ClusterComm {
 
   void disable();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief send requests via a pool of fuerte connections instead of the
+  /// libcurl communicators. must be called before the first request
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setConnectionPool(std::unique_ptr<ConnectionPool> pool);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief push all libcurl callback work to Scheduler threads.  It is a
   ///  public static function that any object can use.
@@ -608,7 +633,8 @@ class ClusterComm {
   std::pair<ClusterCommResult*, HttpRequest*> prepareRequest(
       std::string const& destination, arangodb::rest::RequestType reqtype,
       std::string const* body,
-      std::unordered_map<std::string, std::string> const& headerFields);
+      std::unordered_map<std::string, std::string> const& headerFields,
+      ClusterCommTimeout timeout = 0.0);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the pointer to the singleton instance
@@ -709,6 +735,18 @@ class ClusterComm {
 
   std::shared_ptr<communicator::Communicator> communicator();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief send a prepared request via the connection pool. the callbacks
+  /// are executed like the ones of the communicators
+  //////////////////////////////////////////////////////////////////////////////
+
+  void sendViaPool(std::string const& endpoint, std::string const& path,
+                   std::unique_ptr<HttpRequest> request,
+                   communicator::Callbacks const& callbacks,
+                   ClusterCommTimeout timeout);
+
+  std::unique_ptr<ConnectionPool> _pool;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief whether or not connection errors should be logged as errors
   //////////////////////////////////////////////////////////////////////////////
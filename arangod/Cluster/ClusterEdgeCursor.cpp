@@ -45,6 +45,9 @@ ClusterEdgeCursor::ClusterEdgeCursor(StringRef vertexId, uint64_t depth,
       _opts(opts),
       _cache(static_cast<ClusterTraverserCache*>(opts->cache())) {
   TRI_ASSERT(_cache != nullptr);
+  if (_cache->takePrefetchedEdges(vertexId, depth, _edgeList)) {
+    return;
+  }
   auto trx = _opts->trx();
   transaction::BuilderLeaser leased(trx);
   transaction::BuilderLeaser b(trx);
@@ -28,7 +28,9 @@
 #include "Basics/files.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/ConnectionPool.h"
 #include "Cluster/HeartbeatThread.h"
+#include "Cluster/RequestCoalescer.h"
 #include "Endpoint/Endpoint.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "Logger/Logger.h"
@@ -43,6 +45,9 @@ using namespace arangodb::application_features;
 using namespace arangodb::basics;
 using namespace arangodb::options;
 
+RequestCoalescer* ClusterFeature::INSERT_COALESCER = nullptr;
+RequestCoalescer* ClusterFeature::REPLICATION_COALESCER = nullptr;
+
 ClusterFeature::ClusterFeature(application_features::ApplicationServer& server)
   : ApplicationFeature(server, "Cluster"),
     _unregisterOnShutdown(false),
@@ -129,6 +134,42 @@ void ClusterFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addHiddenOption("--cluster.index-create-timeout",
                            "amount of time (in seconds) the coordinator will wait for an index to be created before giving up",
                            new DoubleParameter(&_indexCreationTimeout));
+
+  options->addOption("--cluster.transport",
+                     "transport of cluster-internal requests (curl: one "
+                     "connection per request in flight, http: pooled "
+                     "HTTP/1.1 connections, vst: pooled VelocyStream "
+                     "connections which multiplex requests)",
+                     new DiscreteValuesParameter<StringParameter>(
+                         &_transport,
+                         std::unordered_set<std::string>{"curl", "http", "vst"}));
+
+  options->addHiddenOption("--cluster.max-connections-per-endpoint",
+                           "maximal number of pooled connections to each "
+                           "server (http and vst transport only)",
+                           new UInt64Parameter(&_maxConnectionsPerEndpoint));
+
+  options->addOption("--cluster.coalesce-inserts-window",
+                     "time (in microseconds) a coordinator waits for more "
+                     "concurrent single-document inserts into a shard, to "
+                     "send them to the shard in one request (0 = disabled)",
+                     new UInt64Parameter(&_coalesceInsertsWindow));
+
+  options->addHiddenOption("--cluster.coalesce-inserts-max-batch",
+                           "maximal number of documents of coalesced inserts "
+                           "sent in one request",
+                           new UInt64Parameter(&_coalesceInsertsMaxBatch));
+
+  options->addOption("--cluster.synchronous-replication-batch-window",
+                     "time (in microseconds) a leader waits for more "
+                     "concurrent operations on a shard, to replicate them "
+                     "to the followers in one request (0 = disabled)",
+                     new UInt64Parameter(&_replicationBatchWindow));
+
+  options->addHiddenOption("--cluster.synchronous-replication-max-batch",
+                           "maximal number of operations replicated to a "
+                           "follower in one request",
+                           new UInt64Parameter(&_replicationMaxBatch));
 }
 
 void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -194,6 +235,24 @@ void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
     FATAL_ERROR_EXIT();
   }
 
+  if (_coalesceInsertsMaxBatch == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::CLUSTER)
+        << "invalid value for --cluster.coalesce-inserts-max-batch";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_replicationMaxBatch == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::CLUSTER)
+        << "invalid value for --cluster.synchronous-replication-max-batch";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_maxConnectionsPerEndpoint == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::CLUSTER)
+        << "invalid value for --cluster.max-connections-per-endpoint";
+    FATAL_ERROR_EXIT();
+  }
+
   // validate system-replication-factor
   if (_systemReplicationFactor == 0) {
     LOG_TOPIC(FATAL, arangodb::Logger::CLUSTER) << "system replication factor must be greater 0";
@@ -255,6 +314,20 @@ void ClusterFeature::prepare() {
   // create an instance (this will not yet create a thread)
   ClusterComm::instance();
 
+  if (_transport != "curl") {
+    ConnectionPool::Config config;
+    config.protocol = (_transport == "vst") ? fuerte::ProtocolType::Vst
+                                            : fuerte::ProtocolType::Http;
+    config.numIOThreads = static_cast<unsigned>(TRI_numberProcessors() / 8 + 1);
+    config.maxConnectionsPerEndpoint = _maxConnectionsPerEndpoint;
+    AuthenticationFeature* af = AuthenticationFeature::instance();
+    if (af->isActive()) {
+      config.jwtToken = af->tokenCache().jwtToken();
+    }
+    ClusterComm::instance()->setConnectionPool(
+        std::make_unique<ConnectionPool>(config));
+  }
+
 #ifdef DEBUG_SYNC_REPLICATION
   bool startClusterComm = true;
 #else
@@ -367,6 +440,18 @@ void ClusterFeature::start() {
     return;
   }
 
+  if (ServerState::instance()->isCoordinator() && _coalesceInsertsWindow > 0) {
+    _insertCoalescer.reset(new RequestCoalescer(
+        _coalesceInsertsWindow, static_cast<size_t>(_coalesceInsertsMaxBatch)));
+    INSERT_COALESCER = _insertCoalescer.get();
+  }
+
+  if (ServerState::instance()->isDBServer() && _replicationBatchWindow > 0) {
+    _replicationCoalescer.reset(new RequestCoalescer(
+        _replicationBatchWindow, static_cast<size_t>(_replicationMaxBatch)));
+    REPLICATION_COALESCER = _replicationCoalescer.get();
+  }
+
   ServerState::instance()->setState(ServerState::STATE_STARTUP);
 
   // the agency about our state
@@ -446,6 +531,9 @@ void ClusterFeature::stop() {
 
 
 void ClusterFeature::unprepare() {
+  INSERT_COALESCER = nullptr;
+  REPLICATION_COALESCER = nullptr;
+
   if (!_enableCluster) {
     ClusterComm::cleanup();
     return;
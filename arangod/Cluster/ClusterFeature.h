@@ -33,9 +33,18 @@ namespace arangodb {
 
 class AgencyCallbackRegistry;
 class HeartbeatThread;
+class RequestCoalescer;
 
 class ClusterFeature : public application_features::ApplicationFeature {
  public:
+  /// @brief merges concurrent single-document inserts of a coordinator into
+  /// the same shard, nullptr if disabled
+  static RequestCoalescer* INSERT_COALESCER;
+
+  /// @brief merges the synchronous replication of concurrent operations of
+  /// a DB server on the same shard, nullptr if disabled
+  static RequestCoalescer* REPLICATION_COALESCER;
+
   explicit ClusterFeature(application_features::ApplicationServer& server);
   ~ClusterFeature();
 
@@ -71,6 +80,14 @@ protected:
   uint32_t _systemReplicationFactor = 2;
   bool _createWaitsForSyncReplication = true;
   double _indexCreationTimeout = 3600.0;
+  std::string _transport = "curl";
+  uint64_t _maxConnectionsPerEndpoint = 8;
+  uint64_t _coalesceInsertsWindow = 0;
+  uint64_t _coalesceInsertsMaxBatch = 1000;
+  std::unique_ptr<RequestCoalescer> _insertCoalescer;
+  uint64_t _replicationBatchWindow = 0;
+  uint64_t _replicationMaxBatch = 1000;
+  std::unique_ptr<RequestCoalescer> _replicationCoalescer;
 
   void reportRole(ServerState::RoleEnum);
 
@@ -37,6 +37,8 @@
 #include "Random/RandomGenerator.h"
 #include "Rest/HttpResponse.h"
 #include "RestServer/DatabaseFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/PhysicalCollection.h"
 #include "Utils/Events.h"
 #include "VocBase/LogicalCollection.h"
@@ -115,6 +117,36 @@ class RecursiveMutexLocker {
 #define RECURSIVE_MUTEX_LOCKER_NAMED(name, lock, owner, acquire) RecursiveMutexLocker<typename std::decay<decltype (lock)>::type> name(lock, owner, arangodb::basics::LockerType::BLOCKING, acquire, __FILE__, __LINE__)
 #define RECURSIVE_MUTEX_LOCKER(lock, owner) RECURSIVE_MUTEX_LOCKER_NAMED(NAME(RecursiveLocker), lock, owner, true)
 
+/// @brief the entry of a collection in a previous Plan or Current, or a none
+/// slice if there was none
+VPackSlice previousEntry(std::shared_ptr<VPackBuilder> const& previous,
+                         std::string const& databaseName,
+                         std::string const& collectionId) {
+  if (previous == nullptr || !previous->slice().isObject()) {
+    return VPackSlice::noneSlice();
+  }
+  VPackSlice collections = previous->slice().get("Collections");
+  if (!collections.isObject()) {
+    return VPackSlice::noneSlice();
+  }
+  VPackSlice database = collections.get(databaseName);
+  if (!database.isObject()) {
+    return VPackSlice::noneSlice();
+  }
+  return database.get(collectionId);
+}
+
+/// @brief whether two slices are byte-wise identical. the agency serializes
+/// unchanged parts of its tree identically, so this detects entries which
+/// did not change between two versions of Plan or Current
+bool sameEntry(VPackSlice a, VPackSlice b) {
+  if (a.isNone() || b.isNone()) {
+    return false;
+  }
+  auto const size = a.byteSize();
+  return size == b.byteSize() && memcmp(a.start(), b.start(), size) == 0;
+}
+
 }
 
 #ifdef _WIN32
@@ -211,6 +243,9 @@ ClusterInfo::ClusterInfo(AgencyCallbackRegistry* agencyCallbackRegistry)
       _uniqid() {
   _uniqid._currentValue = 1ULL;
   _uniqid._upperValue = 0ULL;
+  _uniqid._nextValue = 0ULL;
+  _uniqid._nextUpperValue = 0ULL;
+  _uniqid._prefetching = false;
 
   // Actual loading into caches is postponed until necessary
 }
@@ -244,7 +279,9 @@ void ClusterInfo::cleanup() {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief increase the uniqid value. if it exceeds the upper bound, fetch a
-/// new upper bound value from the agency
+/// new upper bound value from the agency. once a quarter of a batch is
+/// left, the next batch is fetched in the background, so that callers only
+/// wait for the agency if ids are used up faster than the agency answers
 ////////////////////////////////////////////////////////////////////////////////
 
 uint64_t ClusterInfo::uniqid(uint64_t count) {
@@ -258,8 +295,30 @@ uint64_t ClusterInfo::uniqid(uint64_t count) {
         uint64_t result = _uniqid._currentValue;
         _uniqid._currentValue += count;
 
+        if (!_uniqid._prefetching && _uniqid._nextUpperValue == 0 &&
+            _uniqid._currentValue + MinIdsPerBatch / 4 > _uniqid._upperValue &&
+            SchedulerFeature::SCHEDULER != nullptr) {
+          _uniqid._prefetching = SchedulerFeature::SCHEDULER->queue(
+              RequestPriority::LOW, []() {
+                ClusterInfo* ci = ClusterInfo::instance();
+                if (ci != nullptr) {
+                  ci->prefetchUniqids();
+                }
+              });
+        }
+
         return result;
       }
+
+      if (_uniqid._nextUpperValue != 0) {
+        // switch over to the prefetched block. the ids left in the current
+        // block are given up, as they are too few for this request
+        _uniqid._currentValue = _uniqid._nextValue;
+        _uniqid._upperValue = _uniqid._nextUpperValue;
+        _uniqid._nextValue = 0;
+        _uniqid._nextUpperValue = 0;
+        continue;
+      }
       oldValue = _uniqid._currentValue;
     }
 
@@ -288,6 +347,24 @@ uint64_t ClusterInfo::uniqid(uint64_t count) {
   }
 }
 
+void ClusterInfo::prefetchUniqids() {
+  uint64_t result = 0;
+  try {
+    result = _agency.uniqid(MinIdsPerBatch, 0.0);
+  } catch (...) {
+  }
+
+  MUTEX_LOCKER(mutexLocker, _idLock);
+  _uniqid._prefetching = false;
+
+  // ids handed out must keep increasing. if some caller has fetched a
+  // block synchronously in the meantime, the prefetched one may be older
+  if (result > _uniqid._upperValue && _uniqid._nextUpperValue == 0) {
+    _uniqid._nextValue = result;
+    _uniqid._nextUpperValue = result + MinIdsPerBatch - 1;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief flush the caches (used for testing)
 ////////////////////////////////////////////////////////////////////////////////
@@ -718,55 +795,73 @@ void ClusterInfo::loadPlan() {
             try {
               std::shared_ptr<LogicalCollection> newCollection;
 
-            #if defined(USE_ENTERPRISE)
-              VPackSlice isSmart = collectionSlice.get(StaticStrings::IsSmart);
-
-              if (isSmart.isTrue()) {
-                auto type =
-                  collectionSlice.get(arangodb::StaticStrings::DataSourceType);
-
-                if (type.isInteger() && type.getUInt() == TRI_COL_TYPE_EDGE) {
-                  newCollection = std::make_shared<VirtualSmartEdgeCollection>(
-                    *vocbase, collectionSlice, newPlanVersion
-                  );
-                } else {
-                  newCollection = std::make_shared<SmartVertexCollection>(
-                    *vocbase, collectionSlice, newPlanVersion
-                  );
+              // collections whose Plan entry did not change are reused as
+              // they are, instead of being rebuilt from the new Plan.
+              // it is effectively safe to access _plan and _plannedCollections
+              // in read-only mode here, as the only places that modify them are
+              // the shutdown and this function itself, which is protected by a
+              // mutex
+              if (sameEntry(collectionSlice,
+                            previousEntry(_plan, databaseName, collectionId))) {
+                auto it = _plannedCollections.find(databaseName);
+                if (it != _plannedCollections.end()) {
+                  auto it2 = (*it).second.find(collectionId);
+                  if (it2 != (*it).second.end() &&
+                      &(*it2).second->vocbase() == vocbase) {
+                    newCollection = (*it2).second;
+                  }
                 }
-              } else
-            #endif
-              {
-                newCollection = std::make_shared<LogicalCollection>(
-                  *vocbase, collectionSlice, true, newPlanVersion
-                );
               }
 
-              auto& collectionName = newCollection->name();
+              if (newCollection == nullptr) {
+              #if defined(USE_ENTERPRISE)
+                VPackSlice isSmart = collectionSlice.get(StaticStrings::IsSmart);
+
+                if (isSmart.isTrue()) {
+                  auto type =
+                    collectionSlice.get(arangodb::StaticStrings::DataSourceType);
+
+                  if (type.isInteger() && type.getUInt() == TRI_COL_TYPE_EDGE) {
+                    newCollection = std::make_shared<VirtualSmartEdgeCollection>(
+                      *vocbase, collectionSlice, newPlanVersion
+                    );
+                  } else {
+                    newCollection = std::make_shared<SmartVertexCollection>(
+                      *vocbase, collectionSlice, newPlanVersion
+                    );
+                  }
+                } else
+              #endif
+                {
+                  newCollection = std::make_shared<LogicalCollection>(
+                    *vocbase, collectionSlice, true, newPlanVersion
+                  );
+                }
 
-              if (isCoordinator) {
-                // copying over index estimates from the old version of the collection
-                // into the new one
-                LOG_TOPIC(TRACE, Logger::CLUSTER) << "copying index estimates";
-                // it is effectively safe to access _plannedCollections in read-only mode
-                // here, as the only places that modify _plannedCollections are the shutdown
-                // and this function itself, which is protected by a mutex
-                auto it = _plannedCollections.find(databaseName);
-                if (it != _plannedCollections.end()) {
-                  auto it2 = (*it).second.find(collectionId);
-                  if (it2 != (*it).second.end()) {
-                    try {
-                      auto estimates = (*it2).second->clusterIndexEstimates(false);
-                      if (!estimates.empty()) {
-                        // already have an estimate... now copy it over
-                        newCollection->clusterIndexEstimates(std::move(estimates));
+                if (isCoordinator) {
+                  // copying over index estimates from the old version of the collection
+                  // into the new one
+                  LOG_TOPIC(TRACE, Logger::CLUSTER) << "copying index estimates";
+                  auto it = _plannedCollections.find(databaseName);
+                  if (it != _plannedCollections.end()) {
+                    auto it2 = (*it).second.find(collectionId);
+                    if (it2 != (*it).second.end()) {
+                      try {
+                        auto estimates = (*it2).second->clusterIndexEstimates(false);
+                        if (!estimates.empty()) {
+                          // already have an estimate... now copy it over
+                          newCollection->clusterIndexEstimates(std::move(estimates));
+                        }
+                      } catch (...) {
+                        // this may fail during unit tests, when mocks are used
                       }
-                    } catch (...) {
-                      // this may fail during unit tests, when mocks are used
                     }
                   }
                 }
               }
+
+              auto& collectionName = newCollection->name();
+
               // register with name as well as with id:
               databaseCollections.emplace(
                   std::make_pair(collectionName, newCollection));
@@ -953,12 +1048,33 @@ void ClusterInfo::loadCurrent() {
                VPackObjectIterator(databaseSlice.value)) {
             std::string const collectionName = collectionSlice.key.copyString();
 
-            auto collectionDataCurrent =
-                std::make_shared<CollectionInfoCurrent>(newCurrentVersion);
+            // the information of collections whose Current entry did not
+            // change is reused as it is. it is safe to access _current and
+            // _currentCollections here, as only this function, which is
+            // protected by a mutex, and the shutdown modify them
+            std::shared_ptr<CollectionInfoCurrent> collectionDataCurrent;
+            if (sameEntry(collectionSlice.value,
+                          previousEntry(_current, databaseName, collectionName))) {
+              auto it = _currentCollections.find(databaseName);
+              if (it != _currentCollections.end()) {
+                auto it2 = (*it).second.find(collectionName);
+                if (it2 != (*it).second.end()) {
+                  collectionDataCurrent = (*it2).second;
+                }
+              }
+            }
+            bool const reused = (collectionDataCurrent != nullptr);
+            if (!reused) {
+              collectionDataCurrent =
+                  std::make_shared<CollectionInfoCurrent>(newCurrentVersion);
+            }
+
             for (auto const& shardSlice :
                  VPackObjectIterator(collectionSlice.value)) {
               std::string const shardID = shardSlice.key.copyString();
-              collectionDataCurrent->add(shardID, shardSlice.value);
+              if (!reused) {
+                collectionDataCurrent->add(shardID, shardSlice.value);
+              }
 
               // Note that we have only inserted the CollectionInfoCurrent under
               // the collection ID and not under the name! It is not possible
@@ -279,6 +279,16 @@ class ClusterInfo {
 
   uint64_t uniqid(uint64_t = 1);
 
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fetches the next block of unique IDs in the background, so that
+  /// uniqid() can switch to it without waiting for the agency
+  //////////////////////////////////////////////////////////////////////////////
+
+  void prefetchUniqids();
+
+ public:
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief flush the caches (used for testing only)
   //////////////////////////////////////////////////////////////////////////////
@@ -757,6 +767,11 @@ class ClusterInfo {
   struct {
     uint64_t _currentValue;
     uint64_t _upperValue;
+    /// @brief block fetched ahead of time, _nextUpperValue is 0 if none
+    uint64_t _nextValue;
+    uint64_t _nextUpperValue;
+    /// @brief whether a background fetch of the next block is running
+    bool _prefetching;
   } _uniqid;
 
   //////////////////////////////////////////////////////////////////////////////
@@ -30,7 +30,10 @@
 #include "Basics/tri-strings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/RequestCoalescer.h"
+#include "Futures/Utilities.h"
 #include "Graph/Traverser.h"
 #include "Indexes/Index.h"
 #include "Utils/CollectionNameResolver.h"
@@ -183,6 +186,84 @@ static int handleGeneralCommErrors(ClusterCommResult const* res) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts the documents of coalesced single-document inserts into a
+/// shard with one request, and hands each operation the outcome of its
+/// document like a single-document insert would have reported it
+////////////////////////////////////////////////////////////////////////////////
+
+static void insertCoalescedDocuments(
+    ShardID const& shard, std::string const& url,
+    std::vector<RequestCoalescer::Operation*>& ops) {
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr should only happen during controlled shutdown
+    for (auto* op : ops) {
+      op->_result.reset(TRI_ERROR_SHUTTING_DOWN);
+    }
+    return;
+  }
+
+  auto body = std::make_shared<std::string>();
+  size_t length = 2;
+  for (auto const* op : ops) {
+    length += op->_body.size() + 1;
+  }
+  body->reserve(length);
+  body->push_back('[');
+  for (auto const* op : ops) {
+    if (body->size() > 1) {
+      body->push_back(',');
+    }
+    body->append(op->_body);
+  }
+  body->push_back(']');
+
+  std::vector<ClusterCommRequest> requests;
+  requests.emplace_back("shard:" + shard, arangodb::rest::RequestType::POST,
+                        url, body);
+
+  size_t nrDone = 0;
+  cc->performRequests(requests, CL_DEFAULT_LONG_TIMEOUT, nrDone,
+                      Logger::COMMUNICATION, true);
+
+  auto& res = requests[0].result;
+  int commError = handleGeneralCommErrors(&res);
+  if (commError != TRI_ERROR_NO_ERROR) {
+    for (auto* op : ops) {
+      op->_result.reset(commError);
+    }
+    return;
+  }
+
+  TRI_ASSERT(res.answer != nullptr);
+  auto parsedResult = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
+  VPackSlice answer = parsedResult->slice();
+
+  if (!answer.isArray() || answer.length() != ops.size()) {
+    // the request failed as a whole, e.g. because the shard is gone
+    for (auto* op : ops) {
+      op->_responseCode = res.answer_code;
+      op->_resultBody = parsedResult;
+    }
+    return;
+  }
+
+  size_t i = 0;
+  for (VPackSlice doc : VPackArrayIterator(answer)) {
+    auto* op = ops[i++];
+    op->_resultBody = std::make_shared<VPackBuilder>();
+    op->_resultBody->add(doc);
+    if (doc.isObject() && doc.get(StaticStrings::Error).isTrue()) {
+      op->_responseCode = GeneralResponse::responseCode(
+          VelocyPackHelper::getNumericValue<int>(
+              doc, StaticStrings::ErrorNum.c_str(), TRI_ERROR_INTERNAL));
+    } else {
+      op->_responseCode = res.answer_code;
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extracts a numeric value from an hierarchical VelocyPack
 ////////////////////////////////////////////////////////////////////////////////
@@ -1154,6 +1235,40 @@ Result createDocumentOnCoordinator(
 
   VPackBuilder reqBuilder;
 
+  RequestCoalescer* coalescer = ClusterFeature::INSERT_COALESCER;
+  if (!useMultiple && coalescer != nullptr) {
+    TRI_ASSERT(shardMap.size() == 1);
+    auto const& it = *shardMap.begin();
+    // documents of locked shards belong to a transaction of their own
+    if (!trx.isLockedShard(it.first)) {
+      RequestCoalescer::Operation op;
+      auto idx = it.second.front();
+      if (idx.second.empty()) {
+        op._body = slice.toJson();
+      } else {
+        reqBuilder.openObject();
+        reqBuilder.add(StaticStrings::KeyString, VPackValue(idx.second));
+        TRI_SanitizeObject(slice, reqBuilder);
+        reqBuilder.close();
+        op._body = reqBuilder.slice().toJson();
+      }
+
+      std::string const url =
+          baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart;
+      ShardID const shard = it.first;
+      coalescer->execute(url, op, [&shard, &url](std::vector<RequestCoalescer::Operation*>& ops) {
+        insertCoalescedDocuments(shard, url, ops);
+      });
+
+      if (op._result.fail()) {
+        return op._result;
+      }
+      responseCode = op._responseCode;
+      resultBody = std::move(op._resultBody);
+      return Result{};
+    }
+  }
+
   // Now prepare the requests:
   std::vector<ClusterCommRequest> requests;
   std::shared_ptr<std::string> body;
@@ -1524,6 +1639,106 @@ int truncateCollectionOnCoordinator(std::string const& dbname,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the requests to read a single document: one to the responsible
+/// shard if it follows from the document, one to every shard otherwise
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<ClusterCommRequest> singleDocumentRequests(
+    std::string const& dbname, std::string const& collid,
+    std::shared_ptr<LogicalCollection> const& collinfo,
+    arangodb::transaction::Methods const& trx,
+    VPackSlice slice, OperationOptions const& options) {
+  TRI_ASSERT(!slice.isArray());
+  ClusterInfo* ci = ClusterInfo::instance();
+
+  std::string const baseUrl =
+      "/_db/" + StringUtils::urlEncode(dbname) + "/_api/document/";
+  std::string const optsUrlPart =
+      std::string("?ignoreRevs=") + (options.ignoreRevs ? "true" : "false");
+  arangodb::rest::RequestType const reqType =
+      options.silent ? arangodb::rest::RequestType::HEAD
+                     : arangodb::rest::RequestType::GET;
+
+  std::unordered_map<std::string, std::string> headers;
+  if (!options.ignoreRevs && slice.hasKey(StaticStrings::RevString)) {
+    headers.emplace("if-match",
+                    slice.get(StaticStrings::RevString).copyString());
+  }
+
+  VPackSlice keySlice = slice;
+  if (slice.isObject()) {
+    keySlice = slice.get(StaticStrings::KeyString);
+  }
+  std::string const key = StringUtils::urlEncode(keySlice.copyString());
+
+  std::unordered_map<ShardID, std::vector<VPackSlice>> shardMap;
+  std::vector<std::pair<ShardID, VPackValueLength>> reverseMapping;
+  std::vector<ShardID> shards;
+  if (distributeBabyOnShards(shardMap, ci, collid, collinfo, reverseMapping,
+                             slice) == TRI_ERROR_NO_ERROR) {
+    TRI_ASSERT(shardMap.size() == 1);
+    shards.emplace_back(shardMap.begin()->first);
+  } else {
+    // not all shard keys are known, so we ask all shards and ignore
+    // NOT_FOUND
+    shards = *ci->getShardList(collid);
+  }
+
+  std::vector<ClusterCommRequest> requests;
+  requests.reserve(shards.size());
+  for (auto const& shard : shards) {
+    auto headersCopy =
+        std::make_unique<std::unordered_map<std::string, std::string>>(headers);
+    ::InjectNoLockHeader(trx, shard, headersCopy.get());
+    requests.emplace_back(
+        "shard:" + shard, reqType,
+        baseUrl + StringUtils::urlEncode(shard) + "/" + key + optsUrlPart,
+        nullptr, std::move(headersCopy));
+  }
+  return requests;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluates the responses to the requests for a single document.
+/// at most one shard may know the document
+////////////////////////////////////////////////////////////////////////////////
+
+static int evaluateSingleDocumentResponses(
+    std::vector<ClusterCommRequest> const& requests,
+    arangodb::rest::ResponseCode& responseCode,
+    std::shared_ptr<VPackBuilder>& resultBody) {
+  size_t count;
+  int nrok = 0;
+  int commError = TRI_ERROR_NO_ERROR;
+  for (count = requests.size(); count > 0; count--) {
+    auto const& req = requests[count - 1];
+    auto res = req.result;
+    if (res.status == CL_COMM_RECEIVED) {
+      if (res.answer_code !=
+              arangodb::rest::ResponseCode::NOT_FOUND ||
+          (nrok == 0 && count == 1 && commError == TRI_ERROR_NO_ERROR)) {
+        nrok++;
+        responseCode = res.answer_code;
+        TRI_ASSERT(res.answer != nullptr);
+        auto parsedResult = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
+        resultBody.swap(parsedResult);
+      }
+    } else {
+      commError = handleGeneralCommErrors(&res);
+    }
+  }
+  if (nrok == 0) {
+    // This can only happen, if a commError was encountered!
+    return commError;
+  }
+  if (nrok > 1) {
+    return TRI_ERROR_CLUSTER_GOT_CONTRADICTING_ANSWERS;
+  }
+  return TRI_ERROR_NO_ERROR;  // the cluster operation was OK, however,
+                              // the DBserver could have reported an error.
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a document in a coordinator
 ////////////////////////////////////////////////////////////////////////////////
@@ -1554,36 +1769,31 @@ int getDocumentOnCoordinator(
 
   auto collid = std::to_string(collinfo->id());
 
-  // If _key is the one and only sharding attribute, we can do this quickly,
-  // because we can easily determine which shard is responsible for the
-  // document. Otherwise we have to contact all shards and ask them to
-  // delete the document. All but one will not know it.
-  // Now find the responsible shard(s)
+  if (!slice.isArray()) {
+    std::vector<ClusterCommRequest> requests =
+        singleDocumentRequests(dbname, collid, collinfo, trx, slice, options);
+    size_t nrDone = 0;
+    cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone, Logger::COMMUNICATION, true);
+    return evaluateSingleDocumentResponses(requests, responseCode, resultBody);
+  }
 
-  ShardID shardID;
+  // If the shard keys are known in all documents, we can determine which
+  // shard is responsible for each of them. Otherwise we have to contact
+  // all shards with all documents.
 
   std::unordered_map<ShardID, std::vector<VPackSlice>> shardMap;
   std::vector<std::pair<ShardID, VPackValueLength>> reverseMapping;
-  bool useMultiple = slice.isArray();
 
   int res = TRI_ERROR_NO_ERROR;
   bool canUseFastPath = true;
-  if (useMultiple) {
-    for (VPackSlice value : VPackArrayIterator(slice)) {
-      res = distributeBabyOnShards(shardMap, ci, collid, collinfo,
-                                   reverseMapping, value);
-      if (res != TRI_ERROR_NO_ERROR) {
-        canUseFastPath = false;
-        shardMap.clear();
-        reverseMapping.clear();
-        break;
-      }
-    }
-  } else {
-    res = distributeBabyOnShards(shardMap, ci, collid, collinfo, reverseMapping,
-                                 slice);
+  for (VPackSlice value : VPackArrayIterator(slice)) {
+    res = distributeBabyOnShards(shardMap, ci, collid, collinfo,
+                                 reverseMapping, value);
     if (res != TRI_ERROR_NO_ERROR) {
       canUseFastPath = false;
+      shardMap.clear();
+      reverseMapping.clear();
+      break;
     }
   }
 
@@ -1594,22 +1804,12 @@ int getDocumentOnCoordinator(
   std::string optsUrlPart =
       std::string("?ignoreRevs=") + (options.ignoreRevs ? "true" : "false");
 
-  arangodb::rest::RequestType reqType;
-  if (!useMultiple) {
-    if (options.silent) {
-      reqType = arangodb::rest::RequestType::HEAD;
-    } else {
-      reqType = arangodb::rest::RequestType::GET;
-    }
-  } else {
-    reqType = arangodb::rest::RequestType::PUT;
-    if (options.silent) {
-      optsUrlPart += std::string("&silent=true");
-    }
-    optsUrlPart += std::string("&onlyget=true");
+  arangodb::rest::RequestType reqType = arangodb::rest::RequestType::PUT;
+  if (options.silent) {
+    optsUrlPart += std::string("&silent=true");
   }
+  optsUrlPart += std::string("&onlyget=true");
 
-  auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
   if (canUseFastPath) {
     // All shard keys are known in all documents.
     // Contact all shards directly with the correct information.
@@ -1618,42 +1818,19 @@ int getDocumentOnCoordinator(
 
     // Now prepare the requests:
     std::vector<ClusterCommRequest> requests;
-    auto body = std::make_shared<std::string>();
     for (auto const& it : shardMap) {
-      if (!useMultiple) {
-        TRI_ASSERT(it.second.size() == 1);
-        if (!options.ignoreRevs && slice.hasKey(StaticStrings::RevString)) {
-          headers->emplace("if-match",
-                           slice.get(StaticStrings::RevString).copyString());
-        }
-
-        VPackSlice keySlice = slice;
-        if (slice.isObject()) {
-          keySlice = slice.get(StaticStrings::KeyString);
-        }
-
-        ::InjectNoLockHeader(trx, it.first, headers.get());
-        // We send to single endpoint
-        requests.emplace_back(
-            "shard:" + it.first, reqType,
-            baseUrl + StringUtils::urlEncode(it.first) + "/" +
-                StringUtils::urlEncode(keySlice.copyString()) +
-                optsUrlPart, body,
-                std::move(headers));
-      } else {
-        reqBuilder.clear();
-        reqBuilder.openArray();
-        for (auto const& value : it.second) {
-          reqBuilder.add(value);
-        }
-        reqBuilder.close();
-        body = std::make_shared<std::string>(reqBuilder.slice().toJson());
-        // We send to Babies endpoint
-        requests.emplace_back(
-            "shard:" + it.first, reqType,
-            baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart, body,
-            ::CreateNoLockHeader(trx, it.first));
+      reqBuilder.clear();
+      reqBuilder.openArray();
+      for (auto const& value : it.second) {
+        reqBuilder.add(value);
       }
+      reqBuilder.close();
+      auto body = std::make_shared<std::string>(reqBuilder.slice().toJson());
+      // We send to Babies endpoint
+      requests.emplace_back(
+          "shard:" + it.first, reqType,
+          baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart, body,
+          ::CreateNoLockHeader(trx, it.first));
     }
 
     // Perform the requests
@@ -1661,24 +1838,6 @@ int getDocumentOnCoordinator(
     cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone, Logger::COMMUNICATION, true);
 
     // Now listen to the results:
-    if (!useMultiple) {
-      TRI_ASSERT(requests.size() == 1);
-      auto const& req = requests[0];
-      auto res = req.result;
-
-      int commError = handleGeneralCommErrors(&res);
-      if (commError != TRI_ERROR_NO_ERROR) {
-        return commError;
-      }
-
-      responseCode = res.answer_code;
-      TRI_ASSERT(res.answer != nullptr);
-
-      auto parsedResult = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
-      resultBody.swap(parsedResult);
-      return TRI_ERROR_NO_ERROR;
-    }
-
     std::unordered_map<ShardID, std::shared_ptr<VPackBuilder>> resultMap;
     collectResultsFromAllShards<VPackSlice>(
         shardMap, requests, errorCounter, resultMap, responseCode);
@@ -1695,35 +1854,12 @@ int getDocumentOnCoordinator(
 
   std::vector<ClusterCommRequest> requests;
   auto shardList = ci->getShardList(collid);
-  if (!useMultiple) {
-    if (!options.ignoreRevs && slice.hasKey(StaticStrings::RevString)) {
-      headers->emplace("if-match",
-                       slice.get(StaticStrings::RevString).copyString());
-    }
-    for (auto const& shard : *shardList) {
-      VPackSlice keySlice = slice;
-      if (slice.isObject()) {
-        keySlice = slice.get(StaticStrings::KeyString);
-      }
-      auto headersCopy =
-          std::make_unique<std::unordered_map<std::string, std::string>>(
-              *headers);
-      ::InjectNoLockHeader(trx, shard, headersCopy.get());
-      requests.emplace_back(
-          "shard:" + shard, reqType,
-          baseUrl + StringUtils::urlEncode(shard) + "/" +
-              StringUtils::urlEncode(keySlice.copyString()) +
-              optsUrlPart, nullptr,
-              std::move(headersCopy));
-    }
-  } else {
-    auto body = std::make_shared<std::string>(slice.toJson());
-    for (auto const& shard : *shardList) {
-      requests.emplace_back(
-          "shard:" + shard, reqType,
-          baseUrl + StringUtils::urlEncode(shard) + optsUrlPart, body,
-          ::CreateNoLockHeader(trx, shard));
-    }
+  auto body = std::make_shared<std::string>(slice.toJson());
+  for (auto const& shard : *shardList) {
+    requests.emplace_back(
+        "shard:" + shard, reqType,
+        baseUrl + StringUtils::urlEncode(shard) + optsUrlPart, body,
+        ::CreateNoLockHeader(trx, shard));
   }
 
   // Perform the requests
@@ -1731,39 +1867,6 @@ int getDocumentOnCoordinator(
   cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone, Logger::COMMUNICATION, true);
 
   // Now listen to the results:
-  if (!useMultiple) {
-    // Only one can answer, we react a bit differently
-    size_t count;
-    int nrok = 0;
-    int commError = TRI_ERROR_NO_ERROR;
-    for (count = requests.size(); count > 0; count--) {
-      auto const& req = requests[count - 1];
-      auto res = req.result;
-      if (res.status == CL_COMM_RECEIVED) {
-        if (res.answer_code !=
-                arangodb::rest::ResponseCode::NOT_FOUND ||
-            (nrok == 0 && count == 1 && commError == TRI_ERROR_NO_ERROR)) {
-          nrok++;
-          responseCode = res.answer_code;
-          TRI_ASSERT(res.answer != nullptr);
-          auto parsedResult = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
-          resultBody.swap(parsedResult);
-        }
-      } else {
-        commError = handleGeneralCommErrors(&res);
-      }
-    }
-    if (nrok == 0) {
-      // This can only happen, if a commError was encountered!
-      return commError;
-    }
-    if (nrok > 1) {
-      return TRI_ERROR_CLUSTER_GOT_CONTRADICTING_ANSWERS;
-    }
-    return TRI_ERROR_NO_ERROR;  // the cluster operation was OK, however,
-                                // the DBserver could have reported an error.
-  }
-
   // We select all results from all shards and merge them back again.
   std::vector<std::shared_ptr<VPackBuilder>> allResults;
   allResults.reserve(shardList->size());
@@ -1791,6 +1894,44 @@ int getDocumentOnCoordinator(
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a single document in a coordinator, without blocking a thread
+/// while the DB servers work on it
+////////////////////////////////////////////////////////////////////////////////
+
+futures::Future<ClusterOperationResult> getDocumentOnCoordinatorAsync(
+    std::string const& dbname, std::string const& collname,
+    arangodb::transaction::Methods const& trx,
+    VPackSlice slice, OperationOptions const& options) {
+  TRI_ASSERT(!slice.isArray());
+  ClusterInfo* ci = ClusterInfo::instance();
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    return futures::makeFuture(ClusterOperationResult(TRI_ERROR_SHUTTING_DOWN));
+  }
+
+  std::shared_ptr<LogicalCollection> collinfo;
+  try {
+    collinfo = ci->getCollection(dbname, collname);
+  } catch (...) {
+    return futures::makeFuture(
+        ClusterOperationResult(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND));
+  }
+  TRI_ASSERT(collinfo != nullptr);
+
+  std::vector<ClusterCommRequest> requests = singleDocumentRequests(
+      dbname, std::to_string(collinfo->id()), collinfo, trx, slice, options);
+
+  return cc->performRequestsAsync(std::move(requests), CL_DEFAULT_TIMEOUT, true)
+      .thenValue([](std::vector<ClusterCommRequest>&& requests) {
+        ClusterOperationResult result;
+        result.errorCode = evaluateSingleDocumentResponses(
+            requests, result.responseCode, result.resultBody);
+        return result;
+      });
+}
+
 /// @brief fetch edges from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
@@ -1891,6 +2032,143 @@ int fetchEdgesFromEngines(
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief fetch edges of a list of vertices from TraverserEngines
+///        Sends one request per DBServer for all vertices.
+///        The edges are grouped by vertex in the result,
+///        vertices without edges are contained as well.
+///        Otherwise like the TraversalVariant.
+///        Returns TRI_ERROR_NOT_IMPLEMENTED if a DBServer
+///        does not group the edges by vertex.
+///        If vertices is given, the DBServers add the
+///        documents of the vertices the edges lead to
+///        which they store, and these are inserted.
+
+int fetchEdgesFromEngines(
+    std::string const& dbname,
+    std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines,
+    std::vector<StringRef> const& vertexIds,
+    size_t depth,
+    std::unordered_map<StringRef, VPackSlice>& cache,
+    std::unordered_map<StringRef, std::vector<VPackSlice>>& result,
+    std::unordered_map<StringRef, std::shared_ptr<VPackBuffer<uint8_t>>>*
+        vertices,
+    std::vector<std::shared_ptr<VPackBuilder>>& datalake,
+    VPackBuilder& builder,
+    size_t& filtered,
+    size_t& read) {
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    return TRI_ERROR_SHUTTING_DOWN;
+  }
+
+  builder.clear();
+  builder.openObject();
+  builder.add("depth", VPackValue(depth));
+  builder.add(VPackValue("keys"));
+  builder.openArray();
+  for (auto const& v : vertexIds) {
+    builder.add(VPackValuePair(v.data(), v.length(), VPackValueType::String));
+  }
+  builder.close();
+  if (vertices != nullptr) {
+    builder.add("vertices", VPackValue(true));
+  }
+  builder.close();
+
+  std::string const url =
+      "/_db/" + StringUtils::urlEncode(dbname) + "/_internal/traverser/edge/";
+
+  std::vector<ClusterCommRequest> requests;
+  auto body = std::make_shared<std::string>(builder.toJson());
+  for (auto const& engine : *engines) {
+    requests.emplace_back("server:" + engine.first, RequestType::PUT,
+                          url + StringUtils::itoa(engine.second), body);
+  }
+
+  // Perform the requests
+  size_t nrDone = 0;
+  cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone, Logger::COMMUNICATION, false);
+
+  result.clear();
+  for (auto const& v : vertexIds) {
+    result[v];
+  }
+  // Now listen to the results:
+  for (auto const& req : requests) {
+    bool allCached = true;
+    auto res = req.result;
+    int commError = handleGeneralCommErrors(&res);
+    if (commError != TRI_ERROR_NO_ERROR) {
+      // oh-oh cluster is in a bad state
+      return commError;
+    }
+    TRI_ASSERT(res.answer != nullptr);
+    auto resBody = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
+    VPackSlice resSlice = resBody->slice();
+    if (!resSlice.isObject()) {
+      // Response has invalid format
+      return TRI_ERROR_HTTP_CORRUPTED_JSON;
+    }
+    VPackSlice edges = resSlice.get("edges");
+    VPackSlice counts = resSlice.get("counts");
+    if (!edges.isArray() || !counts.isArray() ||
+        counts.length() != vertexIds.size()) {
+      // DBServer does not group the edges
+      return TRI_ERROR_NOT_IMPLEMENTED;
+    }
+    filtered += arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
+        resSlice, "filtered", 0);
+    read += arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
+        resSlice, "readIndex", 0);
+
+    VPackArrayIterator it(edges);
+    size_t i = 0;
+    for (auto const& c : VPackArrayIterator(counts)) {
+      auto& list = result[vertexIds[i++]];
+      size_t n = c.getNumber<size_t>();
+      for (; n > 0 && it.valid(); --n, it.next()) {
+        VPackSlice e = it.value();
+        VPackSlice id = e.get(StaticStrings::IdString);
+        if (!id.isString()) {
+          // invalid id type
+          LOG_TOPIC(ERR, Logger::GRAPHS)
+              << "got invalid edge id type: " << id.typeName();
+          continue;
+        }
+        StringRef idRef(id);
+        auto resE = cache.insert({idRef, e});
+        if (resE.second) {
+          // This edge is not yet cached.
+          allCached = false;
+          list.emplace_back(e);
+        } else {
+          list.emplace_back(resE.first->second);
+        }
+      }
+    }
+    if (!allCached) {
+      datalake.emplace_back(resBody);
+    }
+
+    VPackSlice docs = resSlice.get("vertices");
+    if (vertices != nullptr && docs.isObject()) {
+      for (auto const& pair : VPackObjectIterator(docs)) {
+        if (vertices->find(StringRef(pair.key)) != vertices->end()) {
+          continue;
+        }
+        auto val = VPackBuilder::clone(pair.value);
+        VPackSlice id = val.slice().get(StaticStrings::IdString);
+        if (!id.isString()) {
+          continue;
+        }
+        vertices->emplace(StringRef(id), val.steal());
+      }
+    }
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 /// @brief fetch vertices from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
@@ -2552,6 +2830,144 @@ int flushWalOnAllDBServers(bool waitForSync, bool waitForCollector, double maxWa
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sends the same hot backup request to all given DBservers. the
+/// answers are added to answers (an open object, if given) by server id
+////////////////////////////////////////////////////////////////////////////////
+
+static Result hotBackupRequest(std::vector<ServerID> const& servers,
+                               rest::RequestType type, std::string const& path,
+                               VPackSlice body, VPackBuilder* answers) {
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr happens only during controlled shutdown
+    return Result(TRI_ERROR_SHUTTING_DOWN);
+  }
+
+  auto payload = std::make_shared<std::string const>(
+      body.isNone() ? std::string() : body.toJson());
+  std::vector<ClusterCommRequest> requests;
+  for (auto const& server : servers) {
+    requests.emplace_back("server:" + server, type, "/_admin/backup" + path,
+                          payload);
+  }
+  size_t nrDone = 0;
+  cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone, Logger::CLUSTER,
+                      false);
+
+  Result result;
+  for (size_t i = 0; i < servers.size(); ++i) {
+    auto const& res = requests[i].result;
+    int commError = handleGeneralCommErrors(&res);
+    if (commError != TRI_ERROR_NO_ERROR) {
+      result.reset(commError, "hot backup request to server '" + servers[i] +
+                                  "' failed");
+      continue;
+    }
+
+    TRI_ASSERT(res.answer != nullptr);
+    auto answer = res.answer->toVelocyPackBuilderPtrNoUniquenessChecks();
+    if (answers != nullptr) {
+      answers->add(servers[i], answer->slice());
+    }
+    if (static_cast<int>(res.answer_code) >= 400) {
+      VPackSlice slice = answer->slice();
+      int code = TRI_ERROR_INTERNAL;
+      std::string message;
+      if (slice.isObject()) {
+        code = basics::VelocyPackHelper::getNumericValue<int>(
+            slice, "errorNum", TRI_ERROR_INTERNAL);
+        message = basics::VelocyPackHelper::getStringValue(
+            slice, "errorMessage", "");
+      }
+      result.reset(code, "server '" + servers[i] + "': " + message);
+    }
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a hot backup on all DBservers. commits are paused on all
+/// of them while the checkpoints are created, so that the backups form a
+/// consistent cut of the cluster
+////////////////////////////////////////////////////////////////////////////////
+
+Result hotBackupOnAllDBServers(std::string const& label, double pauseTtl,
+                               VPackBuilder& result) {
+  ClusterInfo* ci = ClusterInfo::instance();
+  std::vector<ServerID> servers = ci->getCurrentDBServers();
+  if (servers.empty()) {
+    return Result(TRI_ERROR_CLUSTER_BACKEND_UNAVAILABLE, "no DBservers found");
+  }
+
+  VPackBuilder body;
+  body.openObject();
+  body.add("ttl", VPackValue(pauseTtl));
+  body.close();
+
+  double const start = TRI_microtime();
+  // the pause expires by itself on servers we lose contact with
+  Result res = hotBackupRequest(servers, rest::RequestType::POST, "/pause",
+                                body.slice(), nullptr);
+
+  if (res.ok()) {
+    body.clear();
+    body.openObject();
+    body.add("label", VPackValue(label));
+    body.add("paused", VPackValue(true));
+    body.add("meta", VPackValue(VPackValueType::Object));
+    body.add("planVersion", VPackValue(ci->getPlanVersion()));
+    body.add("servers", VPackValue(VPackValueType::Array));
+    for (auto const& server : servers) {
+      body.add(VPackValue(server));
+    }
+    body.close();
+    body.close();
+    body.close();
+
+    result.openObject();
+    res = hotBackupRequest(servers, rest::RequestType::POST, "/create",
+                           body.slice(), &result);
+    result.close();
+  }
+
+  Result resumed = hotBackupRequest(servers, rest::RequestType::POST,
+                                    "/resume", VPackSlice(), nullptr);
+  if (!resumed.ok()) {
+    LOG_TOPIC(WARN, Logger::CLUSTER)
+        << "could not resume commits after hot backup: "
+        << resumed.errorMessage() << ". they resume within " << pauseTtl
+        << "s";
+  }
+
+  if (res.fail()) {
+    // do not keep the backups of a partial cut around
+    hotBackupRequest(servers, rest::RequestType::DELETE_REQ, "/" + label,
+                     VPackSlice(), nullptr);
+    return res;
+  }
+
+  LOG_TOPIC(INFO, Logger::CLUSTER)
+      << "created hot backup '" << label << "' on " << servers.size()
+      << " DBservers, commits were paused for " << (TRI_microtime() - start)
+      << "s";
+  return Result();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief forwards a hot backup request other than create to all DBservers
+////////////////////////////////////////////////////////////////////////////////
+
+Result hotBackupRequestOnAllDBServers(rest::RequestType type,
+                                      std::string const& path, VPackSlice body,
+                                      VPackBuilder& result) {
+  std::vector<ServerID> servers = ClusterInfo::instance()->getCurrentDBServers();
+  result.openObject();
+  Result res = hotBackupRequest(servers, type, path, body, &result);
+  result.close();
+  return res;
+}
+
 #ifndef USE_ENTERPRISE
 std::shared_ptr<LogicalCollection> ClusterMethods::createCollectionOnCoordinator(
     TRI_col_type_e collectionType,
@@ -31,6 +31,7 @@
 
 #include "Agency/AgencyComm.h"
 #include "Cluster/TraverserEngineRegistry.h"
+#include "Futures/Future.h"
 #include "Rest/HttpResponse.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/voc-types.h"
@@ -45,6 +46,24 @@ class Slice;
 
 struct OperationOptions;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief outcome of a document operation in a coordinator, as the blocking
+/// functions report it through their out parameters
+////////////////////////////////////////////////////////////////////////////////
+
+struct ClusterOperationResult {
+  ClusterOperationResult() : ClusterOperationResult(TRI_ERROR_NO_ERROR) {}
+  explicit ClusterOperationResult(int errorCode)
+      : errorCode(errorCode),
+        responseCode(rest::ResponseCode::SERVER_ERROR),
+        resultBody(std::make_shared<velocypack::Builder>()) {}
+
+  int errorCode;
+  rest::ResponseCode responseCode;
+  std::unordered_map<int, size_t> errorCounter;
+  std::shared_ptr<velocypack::Builder> resultBody;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief creates a copy of all HTTP headers to forward
 ////////////////////////////////////////////////////////////////////////////////
@@ -133,6 +152,17 @@ int getDocumentOnCoordinator(
     std::unordered_map<int, size_t>& errorCounter,
     std::shared_ptr<arangodb::velocypack::Builder>& resultBody);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a single document in a coordinator. the future is fulfilled on
+/// a scheduler thread once the DB servers have answered, so callers can
+/// suspend instead of blocking a thread
+////////////////////////////////////////////////////////////////////////////////
+
+futures::Future<ClusterOperationResult> getDocumentOnCoordinatorAsync(
+    std::string const& dbname, std::string const& collname,
+    transaction::Methods const& trx,
+    VPackSlice slice, OperationOptions const& options);
+
 /// @brief fetch edges from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
@@ -154,6 +184,31 @@ int fetchEdgesFromEngines(
     std::vector<std::shared_ptr<arangodb::velocypack::Builder>>&,
     arangodb::velocypack::Builder&, size_t&, size_t&);
 
+/// @brief fetch edges of a list of vertices from TraverserEngines
+///        Sends one request per DBServer for all vertices.
+///        The edges are grouped by vertex in the result,
+///        vertices without edges are contained as well.
+///        Otherwise like the TraversalVariant.
+///        Returns TRI_ERROR_NOT_IMPLEMENTED if a DBServer
+///        does not group the edges by vertex.
+///        If vertices is given, the DBServers add the
+///        documents of the vertices the edges lead to
+///        which they store, and these are inserted.
+///        TraversalVariant for batches
+
+int fetchEdgesFromEngines(
+    std::string const& dbname,
+    std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines,
+    std::vector<StringRef> const& vertexIds, size_t depth,
+    std::unordered_map<StringRef, arangodb::velocypack::Slice>& cache,
+    std::unordered_map<StringRef, std::vector<arangodb::velocypack::Slice>>&
+        result,
+    std::unordered_map<StringRef,
+                       std::shared_ptr<arangodb::velocypack::Buffer<uint8_t>>>*
+        vertices,
+    std::vector<std::shared_ptr<arangodb::velocypack::Builder>>& datalake,
+    arangodb::velocypack::Builder& builder, size_t& filtered, size_t& read);
+
 /// @brief fetch edges from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
@@ -250,6 +305,24 @@ int truncateCollectionOnCoordinator(std::string const& dbname,
 
 int flushWalOnAllDBServers(bool waitForSync, bool waitForCollector, double maxWaitTime = -1.0);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a hot backup on all DBservers, with commits paused on all
+/// of them for at most pauseTtl seconds
+////////////////////////////////////////////////////////////////////////////////
+
+Result hotBackupOnAllDBServers(std::string const& label, double pauseTtl,
+                               arangodb::velocypack::Builder& result);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief forwards a hot backup request to all DBservers. result gets the
+/// answers by server id
+////////////////////////////////////////////////////////////////////////////////
+
+Result hotBackupRequestOnAllDBServers(rest::RequestType type,
+                                      std::string const& path,
+                                      arangodb::velocypack::Slice body,
+                                      arangodb::velocypack::Builder& result);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief rotate the active journals for the collection on all DBservers
 ////////////////////////////////////////////////////////////////////////////////
@@ -43,7 +43,10 @@ ClusterTraverser::ClusterTraverser(
     ManagedDocumentResult* mmdr,
     std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines,
     std::string const& dbname, transaction::Methods* trx)
-    : Traverser(opts, trx, mmdr), _dbname(dbname), _engines(engines) {
+    : Traverser(opts, trx, mmdr),
+      _dbname(dbname),
+      _engines(engines),
+      _prefetchVertices(false) {
   _opts->linkTraverser(this);
 }
 
@@ -83,6 +86,14 @@ void ClusterTraverser::setStartVertex(std::string const& vid) {
   _done = false;
 }
 
+void ClusterTraverser::prefetchEdges(std::vector<StringRef> const& vertexIds,
+                                     uint64_t depth) {
+  bool const withVertices =
+      _prefetchVertices || _opts->vertexHasFilter(depth + 1);
+  static_cast<ClusterTraverserCache*>(traverserCache())
+      ->prefetchEdges(vertexIds, depth, withVertices ? &_vertices : nullptr);
+}
+
 bool ClusterTraverser::getVertex(VPackSlice edge,
                                  std::vector<StringRef>& result) {
   bool res = _vertexGetter->getVertex(edge, result);
@@ -55,6 +55,14 @@ class ClusterTraverser final : public Traverser {
 
   void setStartVertex(std::string const& id) override;
 
+  /// @brief fetch the edges of vertices of a depth in one batch, together
+  /// with the documents of the vertices they lead to if these are needed
+  void prefetchEdges(std::vector<StringRef> const& vertexIds, uint64_t depth);
+
+  /// @brief the documents of vertices are needed for the output, not only
+  /// for filtering
+  void setPrefetchVertices(bool value) { _prefetchVertices = value; }
+
  protected:
   /// @brief Function to load the other sides vertex of an edge
   ///        Returns true if the vertex passes filtering conditions
@@ -95,6 +103,8 @@ class ClusterTraverser final : public Traverser {
 
   std::unordered_set<StringRef> _verticesToFetch;
 
+  bool _prefetchVertices;
+
 };
 
 }  // traverser
@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ConnectionPool.h"
+
+#include "Basics/MutexLocker.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+#include "Logger/Logger.h"
+
+using namespace arangodb;
+
+namespace {
+/// @brief fuerte endpoint of an endpoint like tcp://host:port, which
+/// additionally names the protocol to use
+std::string fuerteEndpoint(std::string const& endpoint,
+                           fuerte::ProtocolType protocol) {
+  std::string result =
+      (protocol == fuerte::ProtocolType::Vst) ? "vst+" : "http+";
+  result.append(endpoint);
+  return result;
+}
+
+int64_t toMilliseconds(std::chrono::steady_clock::time_point tp) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             tp.time_since_epoch())
+      .count();
+}
+}  // namespace
+
+ConnectionPool::ConnectionPool(Config const& config)
+    : _config(config),
+      _loop(config.numIOThreads),
+      _stopping(false),
+      _lastPrune(toMilliseconds(clock::now())) {
+  TRI_ASSERT(_config.maxConnectionsPerEndpoint > 0);
+}
+
+ConnectionPool::~ConnectionPool() { shutdown(); }
+
+futures::Future<ConnectionPool::Result> ConnectionPool::sendRequest(
+    std::string const& endpoint, std::unique_ptr<fuerte::Request> request) {
+  // the callback of fuerte must be copyable
+  auto promise = std::make_shared<futures::Promise<Result>>();
+  auto future = promise->getFuture();
+
+  std::shared_ptr<fuerte::Connection> connection;
+  if (!_stopping.load(std::memory_order_relaxed)) {
+    try {
+      connection = leaseConnection(endpoint);
+    } catch (std::exception const& ex) {
+      LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+          << "cannot connect to endpoint '" << endpoint << "': " << ex.what();
+      promise->setValue(Result{
+          fuerte::errorToInt(fuerte::ErrorCondition::CouldNotConnect),
+          nullptr});
+      return future;
+    }
+  }
+
+  if (connection == nullptr) {
+    promise->setValue(
+        Result{fuerte::errorToInt(fuerte::ErrorCondition::Canceled), nullptr});
+    return future;
+  }
+
+  connection->sendRequest(
+      std::move(request),
+      [promise](fuerte::Error error, std::unique_ptr<fuerte::Request>,
+                std::unique_ptr<fuerte::Response> response) {
+        promise->setValue(Result{error, std::move(response)});
+      });
+  return future;
+}
+
+void ConnectionPool::shutdown() {
+  _stopping.store(true);
+
+  WRITE_LOCKER(guard, _lock);
+  for (auto& it : _buckets) {
+    MUTEX_LOCKER(locker, it.second->_mutex);
+    for (auto& c : it.second->_connections) {
+      c._fuerte->cancel();
+    }
+    it.second->_connections.clear();
+  }
+  _buckets.clear();
+}
+
+size_t ConnectionPool::numConnections() const {
+  size_t result = 0;
+
+  READ_LOCKER(guard, _lock);
+  for (auto const& it : _buckets) {
+    MUTEX_LOCKER(locker, it.second->_mutex);
+    result += it.second->_connections.size();
+  }
+  return result;
+}
+
+std::shared_ptr<fuerte::Connection> ConnectionPool::leaseConnection(
+    std::string const& endpoint) {
+  clock::time_point const now = clock::now();
+  pruneConnections(now);
+
+  Bucket* bucket = nullptr;
+  {
+    READ_LOCKER(guard, _lock);
+    auto it = _buckets.find(endpoint);
+    if (it != _buckets.end()) {
+      bucket = it->second.get();
+    }
+  }
+  if (bucket == nullptr) {
+    WRITE_LOCKER(guard, _lock);
+    auto& b = _buckets[endpoint];
+    if (b == nullptr) {
+      b.reset(new Bucket());
+    }
+    bucket = b.get();
+  }
+
+  // buckets are only removed on shutdown
+  MUTEX_LOCKER(locker, bucket->_mutex);
+  pruneBucket(*bucket, now);
+
+  Connection* best = nullptr;
+  size_t bestLoad = 0;
+  for (auto& c : bucket->_connections) {
+    size_t const load = c._fuerte->requestsLeft();
+    if (best == nullptr || load < bestLoad) {
+      best = &c;
+      bestLoad = load;
+      if (load == 0) {
+        break;
+      }
+    }
+  }
+
+  // an HTTP/1.1 connection handles one request after the other, a
+  // VelocyStream connection interleaves a number of them
+  bool const busy =
+      best == nullptr || (bestLoad > 0 && (_config.protocol !=
+                                               fuerte::ProtocolType::Vst ||
+                                           bestLoad >= _config.maxRequestsPerConnection));
+
+  if (busy && bucket->_connections.size() < _config.maxConnectionsPerEndpoint) {
+    bucket->_connections.emplace_back(
+        Connection{createConnection(endpoint), now});
+    return bucket->_connections.back()._fuerte;
+  }
+
+  TRI_ASSERT(best != nullptr);
+  best->_lastLeased = now;
+  return best->_fuerte;
+}
+
+std::shared_ptr<fuerte::Connection> ConnectionPool::createConnection(
+    std::string const& endpoint) {
+  fuerte::ConnectionBuilder builder;
+  builder.endpoint(fuerteEndpoint(endpoint, _config.protocol));
+  if (_config.protocol == fuerte::ProtocolType::Vst &&
+      !_config.jwtToken.empty()) {
+    builder.authenticationType(fuerte::AuthenticationType::Jwt);
+    builder.jwtToken(_config.jwtToken);
+  }
+
+  LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+      << "opening " << fuerte::to_string(_config.protocol)
+      << " connection to endpoint '" << endpoint << "'";
+  return builder.connect(_loop);
+}
+
+void ConnectionPool::pruneBucket(Bucket& bucket, clock::time_point now) {
+  auto const idleTimeout = std::chrono::duration_cast<clock::duration>(
+      std::chrono::duration<double>(_config.idleTimeout));
+
+  auto it = bucket._connections.begin();
+  while (it != bucket._connections.end()) {
+    auto const state = it->_fuerte->state();
+    bool const idle = it->_fuerte->requestsLeft() == 0;
+
+    if (state == fuerte::Connection::State::Failed ||
+        (idle && (state == fuerte::Connection::State::Disconnected ||
+                  now - it->_lastLeased > idleTimeout))) {
+      it->_fuerte->cancel();
+      it = bucket._connections.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ConnectionPool::pruneConnections(clock::time_point now) {
+  int64_t const ms = toMilliseconds(now);
+  int64_t last = _lastPrune.load(std::memory_order_relaxed);
+  if (ms - last < static_cast<int64_t>(_config.idleTimeout * 1000.0) ||
+      !_lastPrune.compare_exchange_strong(last, ms)) {
+    return;
+  }
+
+  READ_LOCKER(guard, _lock);
+  for (auto& it : _buckets) {
+    MUTEX_LOCKER(locker, it.second->_mutex);
+    pruneBucket(*it.second, now);
+  }
+}
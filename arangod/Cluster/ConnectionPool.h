@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_CONNECTION_POOL_H
+#define ARANGOD_CLUSTER_CONNECTION_POOL_H 1
+
+#include "Basics/Common.h"
+
+#include <chrono>
+
+#include <fuerte/connection.h>
+#include <fuerte/loop.h>
+#include <fuerte/message.h>
+
+#include "Basics/Mutex.h"
+#include "Basics/ReadWriteLock.h"
+#include "Futures/Future.h"
+
+namespace arangodb {
+
+/// @brief fuerte connections to the other servers of a cluster, reused per
+/// endpoint. VelocyStream multiplexes requests, so that a few connections
+/// carry all requests to an endpoint. HTTP/1.1 connections carry one request
+/// at a time and are reused as soon as they are idle. connections which
+/// broke or were idle for too long are closed
+class ConnectionPool {
+ public:
+  struct Config {
+    fuerte::ProtocolType protocol = fuerte::ProtocolType::Vst;
+    /// @brief number of threads doing the I/O of the connections
+    unsigned numIOThreads = 1;
+    /// @brief maximal number of connections per endpoint, further requests
+    /// queue on the least busy connection
+    uint64_t maxConnectionsPerEndpoint = 8;
+    /// @brief number of requests in flight on a VelocyStream connection
+    /// before another connection to the endpoint is opened
+    uint64_t maxRequestsPerConnection = 32;
+    /// @brief idle time after which a connection is closed, in seconds
+    double idleTimeout = 120.0;
+    /// @brief JWT to authenticate VelocyStream connections with, HTTP
+    /// requests carry their own authorization header
+    std::string jwtToken;
+  };
+
+  /// @brief outcome of a request. response is only set if error is
+  /// fuerte::ErrorCondition::NoError
+  struct Result {
+    fuerte::Error error;
+    std::unique_ptr<fuerte::Response> response;
+  };
+
+  explicit ConnectionPool(Config const& config);
+  ~ConnectionPool();
+
+  ConnectionPool(ConnectionPool const&) = delete;
+  ConnectionPool& operator=(ConnectionPool const&) = delete;
+
+  fuerte::ProtocolType protocol() const { return _config.protocol; }
+
+  /// @brief send a request to an endpoint like tcp://host:port or
+  /// ssl://host:port. the future is fulfilled on an I/O thread of the pool,
+  /// it is fulfilled with an error if the request cannot be sent
+  futures::Future<Result> sendRequest(std::string const& endpoint,
+                                      std::unique_ptr<fuerte::Request> request);
+
+  /// @brief cancel the requests of all connections and close them. later
+  /// requests fail with fuerte::ErrorCondition::Canceled
+  void shutdown();
+
+  /// @brief number of open connections to all endpoints
+  size_t numConnections() const;
+
+ private:
+  typedef std::chrono::steady_clock clock;
+
+  struct Connection {
+    std::shared_ptr<fuerte::Connection> _fuerte;
+    clock::time_point _lastLeased;
+  };
+
+  struct Bucket {
+    Mutex _mutex;
+    std::vector<Connection> _connections;
+  };
+
+  /// @brief a connection to the endpoint, reused if possible
+  std::shared_ptr<fuerte::Connection> leaseConnection(
+      std::string const& endpoint);
+
+  std::shared_ptr<fuerte::Connection> createConnection(
+      std::string const& endpoint);
+
+  /// @brief close broken and idle connections of a bucket, the mutex of
+  /// the bucket must be held
+  void pruneBucket(Bucket& bucket, clock::time_point now);
+
+  /// @brief close broken and idle connections of all endpoints, at most
+  /// once per idle timeout
+  void pruneConnections(clock::time_point now);
+
+ private:
+  Config const _config;
+
+  fuerte::EventLoopService _loop;
+
+  mutable basics::ReadWriteLock _lock;
+  std::unordered_map<std::string, std::unique_ptr<Bucket>> _buckets;
+
+  std::atomic<bool> _stopping;
+  std::atomic<int64_t> _lastPrune;
+};
+
+}  // namespace arangodb
+
+#endif
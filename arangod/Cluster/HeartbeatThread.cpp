@@ -24,6 +24,7 @@
 #include "HeartbeatThread.h"
 
 #include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
 #include <velocypack/velocypack-aliases.h>
 #include <date/date.h>
 
@@ -180,6 +181,93 @@ private:
 
   uint64_t _backgroundJobsLaunched;
 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief long-polls the agency leader for changes of the version keys, and
+/// wakes up the heartbeat thread as soon as one of them has changed. the
+/// heartbeat keeps polling in its interval, so a failing watch (e.g. with
+/// an agency that does not support polling yet) only costs latency
+////////////////////////////////////////////////////////////////////////////////
+
+class HeartbeatWatchThread : public Thread {
+
+public:
+  HeartbeatWatchThread(HeartbeatThread* heartbeatThread,
+                       std::vector<std::string> const& keys)
+      : Thread("HeartbeatWatch"),
+        _heartbeatThread(heartbeatThread),
+        _keys(keys) {}
+
+  ~HeartbeatWatchThread() { shutdown(); }
+
+protected:
+  void run() override {
+    AgencyComm agency;
+    VPackBuilder known;
+
+    while (!isStopping()) {
+      VPackBuilder body;
+      {
+        VPackObjectBuilder o(&body);
+        body.add(VPackValue("read"));
+        {
+          VPackArrayBuilder trxs(&body);
+          VPackArrayBuilder trx(&body);
+          for (auto const& key : _keys) {
+            body.add(VPackValue(AgencyCommManager::path(key)));
+          }
+        }
+        if (!known.isEmpty()) {
+          body.add("known", known.slice());
+        }
+        body.add("timeout", VPackValue(PollTimeout));
+      }
+
+      AgencyCommResult result = agency.sendWithFailover(
+        arangodb::rest::RequestType::POST, PollTimeout + 5.0,
+        "/_api/agency/poll", body.slice(), PollTimeout + 1.0);
+
+      if (isStopping()) {
+        break;
+      }
+
+      std::shared_ptr<VPackBuilder> values;
+      if (result.successful()) {
+        try {
+          values = VPackParser::fromJson(result.bodyRef());
+        } catch (...) {
+        }
+      }
+
+      if (values == nullptr) {
+        LOG_TOPIC(DEBUG, Logger::HEARTBEAT)
+            << "unable to watch the agency for changes: " << result.errorMessage();
+        known.clear();
+        for (int i = 0; i < 50 && !isStopping(); ++i) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        continue;
+      }
+
+      if (!known.isEmpty() &&
+          basics::VelocyPackHelper::compare(values->slice(), known.slice(), false) != 0) {
+        LOG_TOPIC(TRACE, Logger::HEARTBEAT) << "agency watch noticed a change";
+        _heartbeatThread->wakeUp();
+      }
+      known.clear();
+      known.add(values->slice());
+    }
+  }
+
+private:
+  /// @brief longest time (in seconds) a single poll waits in the agency
+  static constexpr double PollTimeout = 5.0;
+
+  HeartbeatThread* _heartbeatThread;
+
+  /// @brief the agency keys to watch, without prefix
+  std::vector<std::string> const _keys;
+};
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -206,7 +294,8 @@ HeartbeatThread::HeartbeatThread(AgencyCallbackRegistry* agencyCallbackRegistry,
       _wasNotified(false),
       _backgroundJobsPosted(0),
       _lastSyncTime(0),
-      _maintenanceThread(nullptr) {
+      _maintenanceThread(nullptr),
+      _watchThread(nullptr) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -217,6 +306,9 @@ HeartbeatThread::~HeartbeatThread() {
   if (_maintenanceThread) {
     _maintenanceThread->stop();
   }
+  if (_watchThread) {
+    _watchThread->beginShutdown();
+  }
   shutdown();
 }
 
@@ -290,6 +382,8 @@ void HeartbeatThread::runDBServer() {
     LOG_TOPIC(ERR, Logger::HEARTBEAT) << "Failed to start dedicated thread for maintenance";
   }
 
+  startWatchThread({"Plan/Version", "Current/Version"});
+
   std::function<bool(VPackSlice const& result)> updatePlan =
     [=](VPackSlice const& result) {
 
@@ -812,6 +906,8 @@ void HeartbeatThread::runCoordinator() {
   // For periodic update of the current DBServer list:
   int DBServerUpdateCounter = 0;
 
+  startWatchThread({"Plan/Version", "Current/Version", "Sync/UserVersion"});
+
   while (!isStopping()) {
     try {
       logThreadDeaths();
@@ -1067,6 +1163,28 @@ void HeartbeatThread::beginShutdown() {
   _condition.signal();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up the heartbeat loop, so that it looks at the agency right
+/// away instead of at the end of its interval
+////////////////////////////////////////////////////////////////////////////////
+
+void HeartbeatThread::wakeUp() {
+  CONDITION_LOCKER(guard, _condition);
+  _condition.signal();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts watching the given agency keys for changes
+////////////////////////////////////////////////////////////////////////////////
+
+void HeartbeatThread::startWatchThread(std::vector<std::string> const& keys) {
+  _watchThread = std::make_unique<HeartbeatWatchThread>(this, keys);
+  if (!_watchThread->start()) {
+    LOG_TOPIC(WARN, Logger::HEARTBEAT)
+        << "Failed to start thread for watching the agency";
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief finished plan change
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,6 +51,7 @@ struct AgencyVersions {
 
 class AgencyCallbackRegistry;
 class HeartbeatBackgroundJobThread;
+class HeartbeatWatchThread;
 
 class HeartbeatThread : public CriticalThread,
                         public std::enable_shared_from_this<HeartbeatThread> {
@@ -95,6 +96,13 @@ class HeartbeatThread : public CriticalThread,
   //////////////////////////////////////////////////////////////////////////////
   virtual void beginShutdown() override;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief wakes up the heartbeat loop, so that it looks at the agency right
+  /// away instead of at the end of its interval
+  //////////////////////////////////////////////////////////////////////////////
+
+  void wakeUp();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief add thread name to ongoing list of threads that have crashed
   ///        unexpectedly
@@ -129,6 +137,12 @@ class HeartbeatThread : public CriticalThread,
 
   void runDBServer();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief starts watching the given agency keys for changes
+  //////////////////////////////////////////////////////////////////////////////
+
+  void startWatchThread(std::vector<std::string> const& keys);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief heartbeat main loop, single server version
   //////////////////////////////////////////////////////////////////////////////
@@ -278,6 +292,12 @@ public:
   /// code. Only created on dbservers.
   //////////////////////////////////////////////////////////////////////////////
   std::unique_ptr<HeartbeatBackgroundJobThread> _maintenanceThread;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief handle of the thread which long-polls the agency for changes and
+  /// wakes up the heartbeat. Only created on coordinators and dbservers.
+  //////////////////////////////////////////////////////////////////////////////
+  std::unique_ptr<HeartbeatWatchThread> _watchThread;
 };
 }
 
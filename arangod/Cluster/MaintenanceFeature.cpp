@@ -60,6 +60,8 @@ MaintenanceFeature::MaintenanceFeature(application_features::ApplicationServer&
 void MaintenanceFeature::init() {
   _isShuttingDown = false;
   _nextActionId = 1;
+  _workersStarted = false;
+  _idleWorkers = 0;
 
   setOptional(true);
   requiresElevatedPrivileges(false); // ??? this mean admin priv?
@@ -122,28 +124,46 @@ void MaintenanceFeature::start() {
     return ;
   }
 
-  // start threads
-  for (uint32_t loop = 0; loop < _maintenanceThreadsMax; ++loop) {
-
-    // First worker will be available only to fast track
-    std::unordered_set<std::string> labels {};
-    if (loop == 0) {
-      labels.emplace(ActionBase::FAST_TRACK);
-    }
-    
-    auto newWorker =  
-      std::make_unique<maintenance::MaintenanceWorker>(*this, labels);
-    
-    if (!newWorker->start(&_workerCompletion)) {
-      LOG_TOPIC(ERR, Logger::MAINTENANCE)
-        << "MaintenanceFeature::start:  newWorker start failed";
-    } else {
-      _activeWorkers.push_back(std::move(newWorker));
-    }
+  // start the fast track worker and one other worker, further workers are
+  // started by findReadyAction() when actions queue up
+  {
+    MUTEX_LOCKER(guard, _workersLock);
+    _workersStarted = true;
+  }
+  for (uint32_t loop = 0; loop < minThreadLimit; ++loop) {
+    startWorker();
   } // for
 } // MaintenanceFeature::start
 
 
+void MaintenanceFeature::startWorker() {
+  MUTEX_LOCKER(guard, _workersLock);
+
+  if (!_workersStarted || _isShuttingDown ||
+      _activeWorkers.size() >= _maintenanceThreadsMax) {
+    return;
+  }
+
+  // First worker will be available only to fast track
+  std::unordered_set<std::string> labels {};
+  if (_activeWorkers.empty()) {
+    labels.emplace(ActionBase::FAST_TRACK);
+  }
+
+  auto newWorker =
+    std::make_unique<maintenance::MaintenanceWorker>(*this, labels);
+
+  if (!newWorker->start(&_workerCompletion)) {
+    LOG_TOPIC(ERR, Logger::MAINTENANCE)
+      << "MaintenanceFeature::startWorker:  newWorker start failed";
+  } else {
+    LOG_TOPIC(DEBUG, Logger::MAINTENANCE)
+      << "started maintenance worker #" << (_activeWorkers.size() + 1);
+    _activeWorkers.push_back(std::move(newWorker));
+  }
+} // MaintenanceFeature::startWorker
+
+
 void MaintenanceFeature::beginShutdown() {
   _isShuttingDown = true;
   CONDITION_LOCKER(cLock, _actionRegistryCond);
@@ -152,7 +172,14 @@ void MaintenanceFeature::beginShutdown() {
 
 
 void MaintenanceFeature::stop() {
-  for (auto const& itWorker : _activeWorkers ) {
+  // workers may try to start more workers while we wait for them
+  std::vector<std::unique_ptr<maintenance::MaintenanceWorker>> workers;
+  {
+    MUTEX_LOCKER(guard, _workersLock);
+    workers.swap(_activeWorkers);
+  }
+
+  for (auto const& itWorker : workers ) {
     CONDITION_LOCKER(cLock, _workerCompletion);
 
     // loop on each worker, retesting at 10ms just in case
@@ -423,26 +450,54 @@ std::shared_ptr<Action> MaintenanceFeature::findActionIdNoLock(uint64_t id) {
 std::shared_ptr<Action> MaintenanceFeature::findReadyAction(
   std::unordered_set<std::string> const& labels) {
   std::shared_ptr<Action> ret_ptr;
+  bool idle = false;
 
   while(!_isShuttingDown && !ret_ptr) {
+    size_t backlog = 0;
 
-    // scan for ready action (and purge any that are done waiting)
+    // scan for the ready action of the highest priority (and purge any
+    // that are done waiting)
     {
       WRITE_LOCKER(wLock, _actionRegistryLock);
 
-      for (auto loop=_actionRegistry.begin(); _actionRegistry.end()!=loop && !ret_ptr; ) {
+      for (auto loop=_actionRegistry.begin(); _actionRegistry.end()!=loop; ) {
         auto state = (*loop)->getState();
-        if (state == maintenance::READY && (*loop)->matches(labels)) {
-          ret_ptr=*loop;
-          ret_ptr->setState(maintenance::EXECUTING);
+        if (state == maintenance::READY) {
+          ++backlog;
+          if ((*loop)->matches(labels) &&
+              (!ret_ptr || (*loop)->priority() > ret_ptr->priority())) {
+            ret_ptr=*loop;
+          } // if
+          ++loop;
         } else if ((*loop)->done()) {
           loop = _actionRegistry.erase(loop);
         } else {
           ++loop;
         } // else
       } // for
+
+      if (ret_ptr) {
+        ret_ptr->setState(maintenance::EXECUTING);
+        --backlog;
+      } // if
+
+      // only workers without labels can take any action
+      if (labels.empty()) {
+        if (ret_ptr && idle) {
+          --_idleWorkers;
+          idle = false;
+        } else if (!ret_ptr && !idle) {
+          ++_idleWorkers;
+          idle = true;
+        } // else
+      } // if
     } // WRITE
 
+    // more ready actions than workers waiting for them
+    if (ret_ptr && backlog > _idleWorkers.load()) {
+      startWorker();
+    } // if
+
     // no pointer ... wait 5 second
     if (!_isShuttingDown && !ret_ptr) {
     CONDITION_LOCKER(cLock, _actionRegistryCond);
@@ -451,6 +506,11 @@ std::shared_ptr<Action> MaintenanceFeature::findReadyAction(
 
   } // while
 
+  if (idle) {
+    // shutting down
+    --_idleWorkers;
+  } // if
+
   return ret_ptr;
 
 } // MaintenanceFeature::findReadyAction
@@ -137,7 +137,9 @@ public:
   /// @brief Returns json array of all MaintenanceActions within the deque
   Result toJson(VPackBuilder & builder);
 
-  /// @brief Return pointer to next ready action, or nullptr
+  /// @brief Return pointer to next ready action of the highest priority,
+  ///  or nullptr on shutdown. Starts another worker if more actions are
+  ///  ready than workers are idle
   std::shared_ptr<maintenance::Action> findReadyAction(
     std::unordered_set<std::string> const& options =
     std::unordered_set<std::string>());
@@ -321,6 +323,10 @@ protected:
   /// @brief common code used by multiple constructors
   void init();
 
+  /// @brief start another worker unless the pool is at its limit. the first
+  ///  worker is reserved for fast track actions
+  void startWorker();
+
   /// @brief Search for action by hash
   /// @return shared pointer to action object if exists, _actionRegistry.end() if not
   std::shared_ptr<maintenance::Action> findActionHash(size_t hash);
@@ -373,9 +379,20 @@ protected:
   /// @brief condition variable to motivate workers to find new action
   arangodb::basics::ConditionVariable _actionRegistryCond;
 
-  /// @brief list of background workers
+  /// @brief lock to protect _activeWorkers and _workersStarted
+  arangodb::Mutex _workersLock;
+
+  /// @brief list of background workers, grows with the backlog of actions
+  ///  up to _maintenanceThreadsMax
   std::vector<std::unique_ptr<maintenance::MaintenanceWorker>> _activeWorkers;
 
+  /// @brief start() was called, workers may be added
+  bool _workersStarted;
+
+  /// @brief number of workers without labels which wait for an action,
+  ///  only changed while holding the write lock of _actionRegistryLock
+  std::atomic<uint32_t> _idleWorkers;
+
   /// @brief condition variable to indicate thread completion
   arangodb::basics::ConditionVariable _workerCompletion;
 
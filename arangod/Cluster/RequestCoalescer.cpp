@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RequestCoalescer.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
+
+using namespace arangodb;
+
+RequestCoalescer::RequestCoalescer(uint64_t window, size_t maxBatchSize)
+    : _window(window), _maxBatchSize(maxBatchSize) {
+  TRI_ASSERT(_maxBatchSize > 0);
+}
+
+RequestCoalescer::~RequestCoalescer() { TRI_ASSERT(_open.empty()); }
+
+void RequestCoalescer::execute(std::string const& key, Operation& operation,
+                               Executor const& executor) {
+  std::shared_ptr<Batch> batch;
+  bool opened = false;
+  bool full = false;
+
+  {
+    MUTEX_LOCKER(locker, _lock);
+    auto it = _open.find(key);
+    if (it == _open.end()) {
+      batch = std::make_shared<Batch>();
+      _open.emplace(key, batch);
+      opened = true;
+    } else {
+      batch = it->second;
+    }
+
+    batch->_operations.push_back(&operation);
+    if (batch->_operations.size() >= _maxBatchSize) {
+      batch->_closed = true;
+      _open.erase(key);
+      full = true;
+    }
+  }
+
+  if (!opened) {
+    CONDITION_LOCKER(guard, batch->_condition);
+    if (full) {
+      // the caller which opened the batch need not wait any longer
+      guard.broadcast();
+    }
+    while (!batch->_done) {
+      guard.wait();
+    }
+    return;
+  }
+
+  if (!full) {
+    auto const deadline = std::chrono::steady_clock::now() +
+                          std::chrono::microseconds(_window);
+
+    CONDITION_LOCKER(guard, batch->_condition);
+    while (true) {
+      {
+        MUTEX_LOCKER(locker, _lock);
+        if (batch->_closed) {
+          break;
+        }
+      }
+      auto const now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        break;
+      }
+      guard.wait(
+          std::chrono::duration_cast<std::chrono::microseconds>(deadline - now));
+    }
+  }
+
+  {
+    MUTEX_LOCKER(locker, _lock);
+    if (!batch->_closed) {
+      batch->_closed = true;
+      _open.erase(key);
+    }
+  }
+
+  // no operations are added from here on. the waiting callers are released
+  // on every path
+  auto release = [&batch]() {
+    CONDITION_LOCKER(guard, batch->_condition);
+    batch->_done = true;
+    guard.broadcast();
+  };
+  TRI_DEFER(release());
+
+  Result res;
+  try {
+    executor(batch->_operations);
+  } catch (basics::Exception const& ex) {
+    res.reset(ex.code(), ex.what());
+  } catch (std::exception const& ex) {
+    res.reset(TRI_ERROR_INTERNAL, ex.what());
+  } catch (...) {
+    res.reset(TRI_ERROR_INTERNAL, "unknown exception in coalesced request");
+  }
+
+  if (res.fail()) {
+    for (auto* op : batch->_operations) {
+      op->_result = res;
+    }
+  }
+}
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_REQUEST_COALESCER_H
+#define ARANGOD_CLUSTER_REQUEST_COALESCER_H 1
+
+#include "Basics/Common.h"
+
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
+#include "Rest/CommonDefines.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief merges operations of concurrent requests which can be executed
+/// together, e.g. single-document operations on the same shard. the first
+/// operation of a key opens a batch and waits up to a window for more
+/// operations of the key, then executes the batch for all of them in its
+/// own thread. the other callers wait for the outcome of the batch
+class RequestCoalescer {
+ public:
+  struct Operation {
+    /// @brief input of the operation, e.g. a document as JSON
+    std::string _body;
+    /// @brief number of documents in _body
+    size_t _count = 1;
+
+    /// @brief outcome of the operation, set by the executor. if _result
+    /// is ok, _responseCode and _resultBody are set like for a request of
+    /// the operation on its own
+    Result _result;
+    rest::ResponseCode _responseCode = rest::ResponseCode::SERVER_ERROR;
+    std::shared_ptr<velocypack::Builder> _resultBody;
+  };
+
+  /// @brief executes all operations of a batch and sets their outcome
+  typedef std::function<void(std::vector<Operation*>&)> Executor;
+
+  /// @brief window in microseconds, batches contain at most maxBatchSize
+  /// operations and are executed once they are full
+  RequestCoalescer(uint64_t window, size_t maxBatchSize);
+  ~RequestCoalescer();
+
+  RequestCoalescer(RequestCoalescer const&) = delete;
+  RequestCoalescer& operator=(RequestCoalescer const&) = delete;
+
+  /// @brief execute an operation together with concurrent operations of the
+  /// same key. the executor of the caller which opened the batch is used,
+  /// so operations of a key must be executable by the same executor
+  void execute(std::string const& key, Operation& operation,
+               Executor const& executor);
+
+ private:
+  struct Batch {
+    basics::ConditionVariable _condition;
+    std::vector<Operation*> _operations;
+    /// @brief no more operations are added, protected by _lock
+    bool _closed = false;
+    /// @brief all operations are executed, protected by _condition
+    bool _done = false;
+  };
+
+ private:
+  uint64_t const _window;
+  size_t const _maxBatchSize;
+
+  /// @brief protects _open and the operations of the open batches
+  Mutex _lock;
+  std::unordered_map<std::string, std::shared_ptr<Batch>> _open;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -54,6 +54,8 @@ ResignShardLeadership::ResignShardLeadership(
   std::stringstream error;
   
   _labels.emplace(FAST_TRACK);
+  // other servers wait for us to give up leadership
+  _priority = HIGH_PRIORITY;
 
   if (!desc.has(DATABASE)) {
     error << "database must be specified";
@@ -87,6 +87,9 @@ SynchronizeShard::SynchronizeShard(
 
   std::stringstream error;
 
+  // shards without in-sync followers are not replicated
+  _priority = HIGH_PRIORITY;
+
   if (!desc.has(COLLECTION)) {
     error << "collection must be specified";
   }
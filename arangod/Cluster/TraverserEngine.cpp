@@ -33,6 +33,7 @@
 #include "Graph/TraverserCache.h"
 #include "Graph/TraverserOptions.h"
 #include "Transaction/Context.h"
+#include "Transaction/Helpers.h"
 #include "Utils/CollectionNameResolver.h"
 #include "VocBase/ManagedDocumentResult.h"
 
@@ -284,15 +285,24 @@ BaseTraverserEngine::BaseTraverserEngine(
 BaseTraverserEngine::~BaseTraverserEngine() {}
 
 void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
-                                   VPackBuilder& builder) {
+                                   VPackBuilder& builder, bool withVertices) {
   // We just hope someone has locked the shards properly. We have no clue...
   // Thanks locking
   TRI_ASSERT(vertex.isString() || vertex.isArray());
   ManagedDocumentResult mmdr;
+  // edges to vertices which are filtered out anyway are not returned
+  bool const filterVertices = _opts->vertexHasFilter(depth + 1);
+  ManagedDocumentResult vertexMmdr;
+  // vertices the returned edges lead to
+  std::unordered_set<std::string> targets;
+  // number of edges per vertex of a list, so that the coordinator
+  // can tell the edges of the vertices apart
+  std::vector<size_t> counts;
   builder.openObject();
   builder.add(VPackValue("edges"));
   builder.openArray();
   if (vertex.isArray()) {
+    counts.reserve(vertex.length());
     for (VPackSlice v : VPackArrayIterator(vertex)) {
       TRI_ASSERT(v.isString());
       // result.clear();
@@ -300,6 +310,7 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
       std::unique_ptr<arangodb::graph::EdgeCursor> edgeCursor(
           _opts->nextCursor(&mmdr, vertexId, depth));
 
+      size_t count = 0;
       edgeCursor->readAll([&](EdgeDocumentToken&& eid,
                               VPackSlice edge, size_t cursorId) {
         if (edge.isString()) {
@@ -309,10 +320,22 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
           return;
         }
         if (_opts->evaluateEdgeExpression(edge, StringRef(v), depth,
-                                          cursorId)) {
+                                          cursorId) &&
+            (!filterVertices ||
+             otherVertexMatchesConditions(edge, vertexId, depth + 1,
+                                          vertexMmdr))) {
           builder.add(edge);
+          ++count;
+          if (withVertices) {
+            VPackSlice other = transaction::helpers::extractFromFromDocument(edge);
+            if (StringRef(other) == vertexId) {
+              other = transaction::helpers::extractToFromDocument(edge);
+            }
+            targets.emplace(other.copyString());
+          }
         }
       });
+      counts.emplace_back(count);
       // Result now contains all valid edges, probably multiples.
     }
   } else if (vertex.isString()) {
@@ -327,7 +350,10 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
         return;
       }
       if (_opts->evaluateEdgeExpression(edge, StringRef(vertex), depth,
-                                        cursorId)) {
+                                        cursorId) &&
+          (!filterVertices ||
+           otherVertexMatchesConditions(edge, StringRef(vertex), depth + 1,
+                                        vertexMmdr))) {
         builder.add(edge);
       }
     });
@@ -336,13 +362,72 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
     THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
   }
   builder.close();
+  size_t read = 0;
+  if (vertex.isArray()) {
+    builder.add(VPackValue("counts"));
+    builder.openArray();
+    for (size_t count : counts) {
+      builder.add(VPackValue(count));
+    }
+    builder.close();
+
+    if (withVertices) {
+      builder.add(VPackValue("vertices"));
+      builder.openObject();
+      for (auto const& id : targets) {
+        if (lookupLocalVertex(StringRef(id), vertexMmdr)) {
+          ++read;
+          builder.add(VPackValue(id));
+          vertexMmdr.addToBuilder(builder, true);
+        }
+      }
+      builder.close();
+    }
+  }
   builder.add("readIndex",
-              VPackValue(_opts->cache()->getAndResetInsertedDocuments()));
+              VPackValue(_opts->cache()->getAndResetInsertedDocuments() + read));
   builder.add("filtered",
               VPackValue(_opts->cache()->getAndResetFilteredDocuments()));
   builder.close();
 }
 
+bool BaseTraverserEngine::otherVertexMatchesConditions(
+    VPackSlice edge, StringRef vertexId, uint64_t depth,
+    ManagedDocumentResult& mmdr) {
+  StringRef other(transaction::helpers::extractFromFromDocument(edge));
+  if (other == vertexId) {
+    other = StringRef(transaction::helpers::extractToFromDocument(edge));
+  }
+  if (!lookupLocalVertex(other, mmdr)) {
+    // leave the decision to the coordinator
+    return true;
+  }
+  return _opts->evaluateVertexExpression(VPackSlice(mmdr.vpack()), depth);
+}
+
+bool BaseTraverserEngine::lookupLocalVertex(StringRef id,
+                                            ManagedDocumentResult& mmdr) {
+  size_t pos = id.find('/');
+  if (pos == std::string::npos || pos + 1 == id.size()) {
+    return false;
+  }
+  auto shards = _vertexShards.find(id.substr(0, pos).toString());
+  if (shards == _vertexShards.end()) {
+    return false;
+  }
+  StringRef key = id.substr(pos + 1);
+  for (std::string const& shard : shards->second) {
+    Result res = _trx->documentFastPathLocal(shard, key, mmdr, false);
+    if (res.ok()) {
+      return true;
+    }
+    if (res.isNot(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
+      return false;
+    }
+  }
+  return false;
+}
+
 void BaseTraverserEngine::getVertexData(VPackSlice vertex, size_t depth,
                                         VPackBuilder& builder) {
   // We just hope someone has locked the shards properly. We have no clue...
@@ -31,7 +31,9 @@ struct TRI_vocbase_t;
 
 namespace arangodb {
 
+class ManagedDocumentResult;
 class Result;
+class StringRef;
 
 namespace transaction {
 class Methods;
@@ -124,8 +126,11 @@ class BaseTraverserEngine : public BaseEngine {
 
   virtual ~BaseTraverserEngine();
 
+  /// @brief the edges of one or a list of vertices. with withVertices,
+  /// the documents of the vertices the edges lead to are added as far as
+  /// they are stored on this server
   void getEdges(arangodb::velocypack::Slice, size_t,
-                arangodb::velocypack::Builder&);
+                arangodb::velocypack::Builder&, bool withVertices = false);
 
   void getVertexData(arangodb::velocypack::Slice, size_t,
                      arangodb::velocypack::Builder&);
@@ -138,6 +143,18 @@ class BaseTraverserEngine : public BaseEngine {
 
   EngineType getType() const override { return TRAVERSER; }
 
+ protected:
+  /// @brief false if the vertex at the other end of the edge is stored on
+  /// this server and does not match the vertex conditions of the depth.
+  /// vertices of other servers are checked by the coordinator
+  bool otherVertexMatchesConditions(arangodb::velocypack::Slice edge,
+                                    StringRef vertexId, uint64_t depth,
+                                    ManagedDocumentResult& mmdr);
+
+  /// @brief read a vertex from the shards of this server into mmdr,
+  /// false if it is not stored here
+  bool lookupLocalVertex(StringRef id, ManagedDocumentResult& mmdr);
+
  protected:
   std::unique_ptr<traverser::TraverserOptions> _opts;
 };
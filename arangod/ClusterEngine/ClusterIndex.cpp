@@ -61,7 +61,8 @@ ClusterIndex::ClusterIndex(
       _engineType(engineType),
       _indexType(itype),
       _info(info),
-      _clusterSelectivity(/* default */0.1) {
+      _clusterSelectivity(/* default */0.1),
+      _clusterSelectivityStamp(0.0) {
   TRI_ASSERT(_info.slice().isObject());
   TRI_ASSERT(_info.isClosed());
 }
@@ -83,12 +84,24 @@ void ClusterIndex::toVelocyPack(VPackBuilder& builder,
   builder.add(StaticStrings::IndexUnique, VPackValue(_unique));
   builder.add(StaticStrings::IndexSparse, VPackValue(_sparse));
 
+  if (Index::hasFlag(flags, Index::Serialize::Estimates) &&
+      hasSelectivityEstimate() && !_unique) {
+    // lets explain output show how outdated the estimate used for planning is
+    double stamp = _clusterSelectivityStamp.load(std::memory_order_relaxed);
+    if (stamp > 0.0) {
+      builder.add("selectivityEstimateAge", VPackValue(TRI_microtime() - stamp));
+    } else {
+      builder.add("selectivityEstimateAge", VPackValue(VPackValueType::Null));
+    }
+  }
+
   // static std::vector forbidden = {};
   for (auto pair : VPackObjectIterator(_info.slice())) {
     if (!pair.key.isEqualString(StaticStrings::IndexId) &&
         !pair.key.isEqualString(StaticStrings::IndexType) &&
         !pair.key.isEqualString(StaticStrings::IndexFields) &&
         !pair.key.isEqualString("selectivityEstimate") &&
+        !pair.key.isEqualString("selectivityEstimateAge") &&
         !pair.key.isEqualString("figures") &&
         !pair.key.isEqualString(StaticStrings::IndexUnique) &&
         !pair.key.isEqualString(StaticStrings::IndexSparse)) {
@@ -109,7 +122,8 @@ bool ClusterIndex::hasSelectivityEstimate() const {
     _indexType == Index::TRI_IDX_TYPE_EDGE_INDEX ||
     _indexType == Index::TRI_IDX_TYPE_HASH_INDEX ||
     _indexType == Index::TRI_IDX_TYPE_SKIPLIST_INDEX ||
-    _indexType == Index::TRI_IDX_TYPE_PERSISTENT_INDEX;
+    _indexType == Index::TRI_IDX_TYPE_PERSISTENT_INDEX ||
+    _indexType == Index::TRI_IDX_TYPE_TTL_INDEX;
   } else if (_engineType == ClusterEngineType::MockEngine) {
     return false;
   }
@@ -133,6 +147,7 @@ double ClusterIndex::selectivityEstimate(StringRef const&) const {
 
 void ClusterIndex::updateClusterSelectivityEstimate(double estimate) {
   _clusterSelectivity = estimate;
+  _clusterSelectivityStamp.store(TRI_microtime(), std::memory_order_relaxed);
 }
 
 bool ClusterIndex::isPersistent() const {
@@ -157,6 +172,7 @@ bool ClusterIndex::isSorted() const {
     _indexType == Index::TRI_IDX_TYPE_HASH_INDEX ||
     _indexType == Index::TRI_IDX_TYPE_SKIPLIST_INDEX ||
     _indexType == Index::TRI_IDX_TYPE_PERSISTENT_INDEX ||
+    _indexType == Index::TRI_IDX_TYPE_TTL_INDEX ||
     _indexType == Index::TRI_IDX_TYPE_FULLTEXT_INDEX;
   } else if (_engineType == ClusterEngineType::MockEngine) {
     return false;
@@ -197,7 +213,8 @@ bool ClusterIndex::hasCoveringIterator() const {
            _indexType == Index::TRI_IDX_TYPE_EDGE_INDEX ||
            _indexType == Index::TRI_IDX_TYPE_HASH_INDEX ||
            _indexType == Index::TRI_IDX_TYPE_SKIPLIST_INDEX ||
-           _indexType == Index::TRI_IDX_TYPE_PERSISTENT_INDEX;
+           _indexType == Index::TRI_IDX_TYPE_PERSISTENT_INDEX ||
+           _indexType == Index::TRI_IDX_TYPE_TTL_INDEX;
   }
   return false;
 }
@@ -258,7 +275,8 @@ bool ClusterIndex::supportsFilterCondition(
       }
       break;
     }
-    case TRI_IDX_TYPE_PERSISTENT_INDEX: {
+    case TRI_IDX_TYPE_PERSISTENT_INDEX:
+    case TRI_IDX_TYPE_TTL_INDEX: {
       // same for both engines
       return PersistentIndexAttributeMatcher::supportsFilterCondition(allIndexes, this, node, reference, itemsInIndex,
                                                                       estimatedItems, estimatedCost);
@@ -318,7 +336,8 @@ bool ClusterIndex::supportsSortCondition(
       }
       break;
     }
-    case TRI_IDX_TYPE_PERSISTENT_INDEX: {
+    case TRI_IDX_TYPE_PERSISTENT_INDEX:
+    case TRI_IDX_TYPE_TTL_INDEX: {
       // same for both indexes
       return PersistentIndexAttributeMatcher::supportsSortCondition(this, sortCondition, reference, itemsInIndex,
                                                                     estimatedCost, coveredAttributes);
@@ -377,7 +396,8 @@ aql::AstNode* ClusterIndex::specializeCondition(
       }
       break;
     }
-    case TRI_IDX_TYPE_PERSISTENT_INDEX: {
+    case TRI_IDX_TYPE_PERSISTENT_INDEX:
+    case TRI_IDX_TYPE_TTL_INDEX: {
       return PersistentIndexAttributeMatcher::specializeCondition(this, node, reference);
     }
 
@@ -29,6 +29,8 @@
 #include "ClusterEngine/Common.h"
 #include "Indexes/Index.h"
 
+#include <atomic>
+
 namespace arangodb {
 class LogicalCollection;
 
@@ -120,6 +122,8 @@ class ClusterIndex : public Index {
   Index::IndexType _indexType;
   velocypack::Builder _info;
   double _clusterSelectivity;
+  /// @brief when _clusterSelectivity was last updated, 0 if never
+  std::atomic<double> _clusterSelectivityStamp;
 };
 }  // namespace arangodb
 
@@ -89,7 +89,9 @@ ClusterIndexFactory::ClusterIndexFactory() {
     }
   );
 
-  // both engines support all types right now
+  // both engines support all types right now, except for "ttl" which is
+  // only supported by the RocksDB engine. the definitions are validated
+  // by the actual engine in enhanceIndexDefinition
   static const std::vector<std::string> supported = {
     "fulltext",
     "geo",
@@ -97,7 +99,8 @@ ClusterIndexFactory::ClusterIndexFactory() {
     "geo2",
     "hash",
     "persistent",
-    "skiplist"
+    "skiplist",
+    "ttl"
   };
 
   for (auto& typeStr: supported) {
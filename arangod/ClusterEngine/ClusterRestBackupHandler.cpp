@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ClusterRestBackupHandler.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cluster/ClusterMethods.h"
+#include "Utils/ExecContext.h"
+#include "VocBase/ticks.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+/// @brief commits stay paused on DBservers we lose contact with at most
+/// this long
+double const defaultPauseTtl = 10.0;
+}
+
+ClusterRestBackupHandler::ClusterRestBackupHandler(GeneralRequest* request,
+                                                   GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+RestStatus ClusterRestBackupHandler::execute() {
+  if (ExecContext::CURRENT != nullptr &&
+      !ExecContext::CURRENT->isAdminUser()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return RestStatus::DONE;
+  }
+
+  std::vector<std::string> const& suffixes = _request->suffixes();
+  auto const type = _request->requestType();
+
+  if (suffixes.empty()) {
+    if (type == rest::RequestType::GET) {
+      forward("", VPackSlice());
+      return RestStatus::DONE;
+    }
+  } else if (suffixes.size() == 1) {
+    if (type == rest::RequestType::DELETE_REQ) {
+      forward("/" + suffixes[0], VPackSlice());
+      return RestStatus::DONE;
+    }
+    if (type == rest::RequestType::POST) {
+      VPackSlice body;
+      try {
+        body = _request->payload();
+      } catch (...) {
+      }
+      if (body.isNone()) {
+        body = VPackSlice::emptyObjectSlice();
+      } else if (!body.isObject()) {
+        generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                      "invalid body value. expecting object");
+        return RestStatus::DONE;
+      }
+
+      std::string const& operation = suffixes[0];
+      if (operation == "create") {
+        create(body);
+      } else if (operation == "pause" || operation == "resume" ||
+                 operation == "restore") {
+        forward("/" + operation, body);
+      } else {
+        generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                      "expecting /_admin/backup/<operation>");
+      }
+      return RestStatus::DONE;
+    }
+  } else {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting /_admin/backup/<operation>");
+    return RestStatus::DONE;
+  }
+
+  generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+  return RestStatus::DONE;
+}
+
+void ClusterRestBackupHandler::create(VPackSlice body) {
+  std::string label = basics::VelocyPackHelper::getStringValue(
+      body, "label", std::to_string(TRI_NewTickServer()));
+  double ttl = basics::VelocyPackHelper::getNumericValue<double>(
+      body, "ttl", ::defaultPauseTtl);
+  if (ttl <= 0.0) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                  "<ttl> needs to be positive");
+    return;
+  }
+
+  VPackBuilder servers;
+  Result res = hotBackupOnAllDBServers(label, ttl, servers);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("label", VPackValue(label));
+  builder.add("servers", servers.slice());
+  builder.close();
+  generateResult(rest::ResponseCode::CREATED, builder.slice());
+}
+
+void ClusterRestBackupHandler::forward(std::string const& path,
+                                       VPackSlice body) {
+  VPackBuilder servers;
+  Result res = hotBackupRequestOnAllDBServers(_request->requestType(), path,
+                                              body, servers);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("servers", servers.slice());
+  builder.close();
+  generateResult(rest::ResponseCode::OK, builder.slice());
+}
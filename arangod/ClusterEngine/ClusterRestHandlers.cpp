@@ -23,6 +23,7 @@
 #include "ClusterRestHandlers.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "RestHandler/RestHandlerCreator.h"
+#include "ClusterEngine/ClusterRestBackupHandler.h"
 #include "ClusterEngine/ClusterRestCollectionHandler.h"
 #include "ClusterEngine/ClusterRestExportHandler.h"
 #include "ClusterEngine/ClusterRestReplicationHandler.h"
@@ -39,4 +40,5 @@ void ClusterRestHandlers::registerResources(
   handlerFactory->addPrefixHandler("/_api/replication",
       RestHandlerCreator<ClusterRestReplicationHandler>::createNoData);
   handlerFactory->addPrefixHandler("/_admin/wal", RestHandlerCreator<ClusterRestWalHandler>::createNoData);
+  handlerFactory->addPrefixHandler("/_admin/backup", RestHandlerCreator<ClusterRestBackupHandler>::createNoData);
 }
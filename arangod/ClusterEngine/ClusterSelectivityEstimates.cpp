@@ -25,20 +25,27 @@
 
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Cluster/ClusterInfo.h"
 #include "Cluster/ClusterMethods.h"
 #include "Indexes/Index.h"
+#include "Logger/Logger.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
 
 using namespace arangodb;
 
 ClusterSelectivityEstimates::ClusterSelectivityEstimates(LogicalCollection& collection) 
     : _collection(collection), 
-      _expireStamp(0.0) {}
+      _expireStamp(0.0),
+      _updateStamp(0.0) {}
 
 void ClusterSelectivityEstimates::flush() {
   WRITE_LOCKER(lock, _lock);
   _estimates.clear();
   _expireStamp = 0.0;
+  _updateStamp = 0.0;
 }
 
 std::unordered_map<std::string, double> ClusterSelectivityEstimates::get(bool allowUpdate) const {
@@ -63,13 +70,30 @@ std::unordered_map<std::string, double> ClusterSelectivityEstimates::get(bool al
   // we have given up the read lock here
   // because we now need to modify the estimates
 
+  {
+    WRITE_LOCKER(writeLock, _lock);
+
+    if (!_estimates.empty()) {
+      if (_expireStamp <= now && scheduleRefresh()) {
+        // postpone expiry so that only one refresh is in flight. set()
+        // will move it out further once the refresh has arrived
+        _expireStamp = now + retryTtl;
+      }
+      // expired estimates are still good enough for planning, so we do
+      // not make the query wait for the DB servers
+      return _estimates;
+    }
+  }
+
+  // have no estimate at all yet. fetch it synchronously, as plans made
+  // with default estimates can be arbitrarily bad
   int tries = 0;
   while (true) {
     decltype(_estimates) estimates;
 
     WRITE_LOCKER(writeLock, _lock);
     
-    if (!_estimates.empty() && _expireStamp > now) {
+    if (!_estimates.empty()) {
       // some other thread has updated the estimates for us... just use them
       return _estimates;
     }
@@ -80,6 +104,7 @@ std::unordered_map<std::string, double> ClusterSelectivityEstimates::get(bool al
       _estimates = estimates;
       // let selectivity estimates expire less seldom for system collections
       _expireStamp = now + defaultTtl * (_collection.name()[0] == '_' ? 10.0 : 1.0);
+      _updateStamp = now;
 
       // give up the lock, and then update the selectivity values for each index
       writeLock.unlock();
@@ -104,6 +129,47 @@ std::unordered_map<std::string, double> ClusterSelectivityEstimates::get(bool al
   }
 }
 
+double ClusterSelectivityEstimates::age() const {
+  READ_LOCKER(readLock, _lock);
+  if (_updateStamp == 0.0) {
+    return -1.0;
+  }
+  return TRI_microtime() - _updateStamp;
+}
+
+/// @brief refreshes the estimates on a scheduler thread. the refresh looks
+/// the collection up again, because the plan may have replaced this
+/// instance until the DB servers have answered
+bool ClusterSelectivityEstimates::scheduleRefresh() const {
+  if (SchedulerFeature::SCHEDULER == nullptr) {
+    return false;
+  }
+
+  std::string database = _collection.vocbase().name();
+  std::string cid = std::to_string(_collection.id());
+  std::string name = _collection.name();
+
+  return SchedulerFeature::SCHEDULER->queue(RequestPriority::LOW, [database, cid, name]() {
+    std::unordered_map<std::string, double> estimates;
+    int res = selectivityEstimatesOnCoordinator(database, name, estimates);
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_TOPIC(DEBUG, Logger::CLUSTER)
+          << "unable to refresh selectivity estimates of collection '"
+          << database << "/" << name << "': " << TRI_errno_string(res);
+      return;
+    }
+
+    try {
+      auto collection = ClusterInfo::instance()->getCollection(database, cid);
+      if (collection != nullptr) {
+        collection->clusterIndexEstimates(std::move(estimates));
+      }
+    } catch (...) {
+      // collection has been dropped in the meantime
+    }
+  });
+}
+
 void ClusterSelectivityEstimates::set(std::unordered_map<std::string, double>&& estimates) {
   double const now = TRI_microtime();
   
@@ -125,5 +191,6 @@ void ClusterSelectivityEstimates::set(std::unordered_map<std::string, double>&&
     _estimates = std::move(estimates);
     // let selectivity estimates expire less seldom for system collections
     _expireStamp = now + defaultTtl * (_collection.name()[0] == '_' ? 10.0 : 1.0);
+    _updateStamp = now;
   }
 }
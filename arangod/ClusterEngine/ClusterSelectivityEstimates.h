@@ -30,7 +30,9 @@
 namespace arangodb {
 class LogicalCollection;
 
-///@brief basic cache for selectivity estimates in the cluster
+///@brief basic cache for selectivity estimates in the cluster.
+/// only the very first lookup waits for the DB servers. expired estimates
+/// are returned as they are and refreshed in the background
 class ClusterSelectivityEstimates {
  public:
   explicit ClusterSelectivityEstimates(LogicalCollection& collection);
@@ -38,13 +40,21 @@ class ClusterSelectivityEstimates {
   std::unordered_map<std::string, double> get(bool allowUpdate) const;
   void set(std::unordered_map<std::string, double>&& estimates);
 
+  /// @brief seconds since the estimates were fetched, -1 if never
+  double age() const;
+
+ private:
+  bool scheduleRefresh() const;
+
  private:
   LogicalCollection& _collection;
   mutable basics::ReadWriteLock _lock;
   mutable std::unordered_map<std::string, double> _estimates;
   mutable double _expireStamp;
+  mutable double _updateStamp;
   
   static constexpr double defaultTtl = 60.0;
+  static constexpr double retryTtl = 5.0;
 };
 
 }
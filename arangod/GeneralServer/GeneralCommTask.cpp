@@ -29,6 +29,7 @@
 #include "Basics/Locking.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AsyncJobManager.h"
 #include "GeneralServer/AuthenticationFeature.h"
@@ -339,9 +340,7 @@ void GeneralCommTask::executeRequest(
 
       addResponse(*response, nullptr);
     } else {
-      addErrorResponse(rest::ResponseCode::SERVICE_UNAVAILABLE,
-                       request->contentTypeResponse(), messageId,
-                       TRI_ERROR_QUEUE_FULL);
+      addQueueFullResponse(request->contentTypeResponse(), messageId);
     }
   } else {
     // synchronous request
@@ -433,14 +432,38 @@ void GeneralCommTask::addErrorResponse(rest::ResponseCode code,
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
 
+/// @brief send a 503 response for a request that could not be queued,
+/// asking the client to retry later
+void GeneralCommTask::addQueueFullResponse(rest::ContentType respType,
+                                           uint64_t messageId) {
+  VPackBuffer<uint8_t> buffer;
+  VPackBuilder builder(buffer);
+  builder.openObject();
+  builder.add(StaticStrings::Error, VPackValue(true));
+  builder.add(StaticStrings::ErrorNum, VPackValue(TRI_ERROR_QUEUE_FULL));
+  builder.add(StaticStrings::ErrorMessage,
+              VPackValue(TRI_errno_string(TRI_ERROR_QUEUE_FULL)));
+  builder.add(StaticStrings::Code,
+              VPackValue((int)rest::ResponseCode::SERVICE_UNAVAILABLE));
+  builder.close();
+
+  std::unique_ptr<GeneralResponse> response =
+      createResponse(rest::ResponseCode::SERVICE_UNAVAILABLE, messageId);
+  response->setContentType(respType);
+  response->setHeaderNC(StaticStrings::RetryAfter, "1");
+  response->setPayload(std::move(buffer), true, VPackOptions::Defaults);
+  addResponse(*response, nullptr);
+}
+
 // Execute a request either on the network thread or put it in a background
 // thread. Depending on the number of running threads requests may be queued
 // and scheduled later when the number of used threads decreases
 bool GeneralCommTask::handleRequestSync(std::shared_ptr<RestHandler> handler) {
+  auto const lane = handler->lane();
   auto const prio = handler->priority();
   auto self = shared_from_this();
 
-  bool ok = SchedulerFeature::SCHEDULER->queue(prio, [self, this, handler]() {
+  bool ok = SchedulerFeature::SCHEDULER->queue(lane, prio, [self, this, handler]() {
     handleRequestDirectly(basics::ConditionalLocking::DoLock,
                           std::move(handler));
   });
@@ -448,9 +471,7 @@ bool GeneralCommTask::handleRequestSync(std::shared_ptr<RestHandler> handler) {
   uint64_t messageId = handler->messageId();
 
   if (!ok) {
-    addErrorResponse(rest::ResponseCode::SERVICE_UNAVAILABLE,
-                     handler->request()->contentTypeResponse(), messageId,
-                     TRI_ERROR_QUEUE_FULL);
+    addQueueFullResponse(handler->request()->contentTypeResponse(), messageId);
   }
 
   return ok;
@@ -485,7 +506,7 @@ bool GeneralCommTask::handleRequestAsync(std::shared_ptr<RestHandler> handler,
 
     // callback will persist the response with the AsyncJobManager
     return SchedulerFeature::SCHEDULER->queue(
-          handler->priority(), [self, handler] {
+          handler->lane(), handler->priority(), [self, handler] {
           handler->runHandler([](RestHandler* h) {
             GeneralServerFeature::JOB_MANAGER->finishAsyncJob(h);
           });
@@ -493,7 +514,7 @@ bool GeneralCommTask::handleRequestAsync(std::shared_ptr<RestHandler> handler,
   } else {
     // here the response will just be ignored
     return SchedulerFeature::SCHEDULER->queue(
-        handler->priority(),
+        handler->lane(), handler->priority(),
         [self, handler] { handler->runHandler([](RestHandler*) {}); });
   }
 }
@@ -584,3 +605,172 @@ rest::ResponseCode GeneralCommTask::canAccessPath(GeneralRequest& req) const {
 
   return result;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether credentialed CORS requests of an origin are allowed
+////////////////////////////////////////////////////////////////////////////////
+
+bool GeneralCommTask::allowCorsCredentials(std::string const& origin) const {
+  if (origin.empty()) {
+    // default is to allow nothing
+    return false;
+  }
+
+  // if the request asks to allow credentials, we'll check against the
+  // configured whitelist of origins
+  std::vector<std::string> const& accessControlAllowOrigins =
+      GeneralServerFeature::accessControlAllowOrigins();
+
+  if (accessControlAllowOrigins.empty()) {
+    return false;
+  }
+
+  if (accessControlAllowOrigins[0] == "*") {
+    // special case: allow everything
+    return true;
+  }
+
+  if (origin[origin.size() - 1] == '/') {
+    // strip trailing slash
+    return std::find(accessControlAllowOrigins.begin(),
+                     accessControlAllowOrigins.end(),
+                     origin.substr(0, origin.size() - 1)) !=
+           accessControlAllowOrigins.end();
+  }
+
+  return std::find(accessControlAllowOrigins.begin(),
+                   accessControlAllowOrigins.end(),
+                   origin) != accessControlAllowOrigins.end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief answers a CORS preflight request
+////////////////////////////////////////////////////////////////////////////////
+
+void GeneralCommTask::processCorsOptions(GeneralRequest& request,
+                                         std::string const& origin,
+                                         uint64_t messageId) {
+  std::unique_ptr<GeneralResponse> resp =
+      createResponse(rest::ResponseCode::OK, messageId);
+
+  resp->setHeaderNCIfNotSet(StaticStrings::Allow, StaticStrings::CorsMethods);
+
+  if (!origin.empty()) {
+    LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "got CORS preflight request";
+    std::string const allowHeaders = StringUtils::trim(
+        request.header(StaticStrings::AccessControlRequestHeaders));
+
+    // send back which HTTP methods are allowed for the resource
+    // we'll allow all
+    resp->setHeaderNCIfNotSet(StaticStrings::AccessControlAllowMethods,
+                              StaticStrings::CorsMethods);
+
+    if (!allowHeaders.empty()) {
+      // allow all extra headers the client requested
+      // we don't verify them here. the worst that can happen is that the
+      // client sends some broken headers and then later cannot access the data
+      // on
+      // the server. that's a client problem.
+      resp->setHeaderNCIfNotSet(StaticStrings::AccessControlAllowHeaders,
+                                allowHeaders);
+
+      LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "client requested validation of the following headers: "
+                 << allowHeaders;
+    }
+
+    // set caching time (hard-coded value)
+    resp->setHeaderNCIfNotSet(StaticStrings::AccessControlMaxAge,
+                              StaticStrings::N1800);
+  }
+
+  addResponse(*resp, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief authenticates a request using its authorization header
+////////////////////////////////////////////////////////////////////////////////
+
+rest::ResponseCode GeneralCommTask::handleAuthHeader(GeneralRequest* req) {
+  bool found;
+  std::string const& authStr = req->header(StaticStrings::Authorization, found);
+  if (!found) {
+    if (_auth->isActive()) {
+      events::CredentialsMissing(req);
+      return rest::ResponseCode::UNAUTHORIZED;
+    }
+    return rest::ResponseCode::OK;
+  }
+
+  size_t methodPos = authStr.find_first_of(' ');
+  if (methodPos != std::string::npos) {
+    // skip over authentication method
+    char const* auth = authStr.c_str() + methodPos;
+    while (*auth == ' ') {
+      ++auth;
+    }
+
+    if (Logger::logRequestParameters()) {
+      LOG_TOPIC(DEBUG, arangodb::Logger::REQUESTS) << "\"authorization-header\",\""
+        << (void*)this << "\",\"" << authStr << "\"";
+    }
+
+    try {
+      // note that these methods may throw in case of an error
+      AuthenticationMethod authMethod = AuthenticationMethod::NONE;
+      if (TRI_CaseEqualString(authStr.c_str(), "basic ", 6)) {
+        authMethod = AuthenticationMethod::BASIC;
+      } else if (TRI_CaseEqualString(authStr.c_str(), "bearer ", 7)) {
+        authMethod = AuthenticationMethod::JWT;
+      }
+
+      req->setAuthenticationMethod(authMethod);
+      if (authMethod != AuthenticationMethod::NONE) {
+        auth::TokenCache& cache = _auth->tokenCache();
+        uint64_t const version = cache.validityVersion();
+        if (!_lastAuthHeader.empty() && _lastAuthHeader == authStr &&
+            _lastAuthVersion == version &&
+            (_lastAuthExpiry == 0.0 || _lastAuthExpiry > TRI_microtime()) &&
+            (_auth->userManager() == nullptr ||
+             !_auth->userManager()->refreshUser(_lastAuthUser))) {
+          // same credentials as the previous request on this connection,
+          // and nothing has changed since they were checked
+          req->setAuthenticated(true);
+          req->setUser(_lastAuthUser);
+        } else {
+          auto entry = cache.checkAuthentication(authMethod, auth);
+          req->setAuthenticated(entry.authenticated());
+          if (entry.authenticated()) {
+            _lastAuthHeader = authStr;
+            _lastAuthUser = entry.username();
+            _lastAuthExpiry = entry._expiry;
+            _lastAuthVersion = version;
+          } else {
+            _lastAuthHeader.clear();
+          }
+          req->setUser(std::move(entry._username));
+        }
+      }
+      
+      if (req->authenticated() || !_auth->isActive()) {
+        events::Authenticated(req, authMethod);
+        return rest::ResponseCode::OK;
+      } else if (_auth->isActive()) {
+        events::CredentialsBad(req, authMethod);
+        return rest::ResponseCode::UNAUTHORIZED;
+      }
+
+      // intentionally falls through
+    } catch (arangodb::basics::Exception const& ex) {
+      // translate error
+      if (ex.code() == TRI_ERROR_USER_NOT_FOUND) {
+        return rest::ResponseCode::UNAUTHORIZED;
+      }
+      return GeneralResponse::responseCode(ex.what());
+    } catch (...) {
+      return rest::ResponseCode::SERVER_ERROR;
+    }
+  }
+
+  events::UnknownAuthenticationMethod(req);
+  return rest::ResponseCode::UNAUTHORIZED;
+}
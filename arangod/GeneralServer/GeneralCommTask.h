@@ -150,11 +150,30 @@ class GeneralCommTask : public SocketTask {
   ////////////////////////////////////////////////////////////////////////////////
   rest::ResponseCode canAccessPath(GeneralRequest&) const;
 
+  /// @brief whether credentialed CORS requests of an origin are allowed
+  bool allowCorsCredentials(std::string const& origin) const;
+
+  /// @brief answers a CORS preflight request
+  void processCorsOptions(GeneralRequest&, std::string const& origin,
+                          uint64_t messageId);
+
+  /// @brief authenticates a request using its authorization header
+  rest::ResponseCode handleAuthHeader(GeneralRequest*);
+
  private:
+  void addQueueFullResponse(rest::ContentType, uint64_t messageId);
   bool handleRequestSync(std::shared_ptr<RestHandler>);
   void handleRequestDirectly(bool doLock, std::shared_ptr<RestHandler>);
   bool handleRequestAsync(std::shared_ptr<RestHandler>,
                           uint64_t* jobId = nullptr);
+
+  /// @brief last successfully authenticated authorization header of this
+  /// connection. keep-alive clients usually send the same header with each
+  /// request, which then does not need to be checked again
+  std::string _lastAuthHeader;
+  std::string _lastAuthUser;
+  double _lastAuthExpiry = 0.0;
+  uint64_t _lastAuthVersion = 0;
 };
 }
 }
@@ -40,9 +40,13 @@ using namespace arangodb::rest;
 // --SECTION--                                                    public methods
 // -----------------------------------------------------------------------------
 
-GeneralServer::GeneralServer(uint64_t numIoThreads) 
+GeneralServer::GeneralServer(uint64_t numIoThreads,
+                             uint64_t acceptorsPerEndpoint)
     : _numIoThreads(numIoThreads),
-      _contexts(numIoThreads) {}
+      // at most one acceptor of an endpoint per io thread
+      _acceptorsPerEndpoint(std::min(acceptorsPerEndpoint, numIoThreads)),
+      _contexts(numIoThreads),
+      _nextContext(0) {}
 
 void GeneralServer::setEndpointList(EndpointList const* list) {
   _endpointList = list;
@@ -55,9 +59,19 @@ void GeneralServer::startListening() {
     LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "trying to bind to endpoint '"
                                               << it.first << "' for requests";
 
-    // distribute endpoints across all io contexts
-    IoContext& ioContext = _contexts[i++ % _numIoThreads];
-    bool ok = openEndpoint(ioContext, it.second);
+    // distribute endpoints across all io contexts. the acceptors of one
+    // endpoint run in different io contexts
+    uint64_t acceptors = 1;
+    if (it.second->domainType() == Endpoint::DomainType::IPV4 ||
+        it.second->domainType() == Endpoint::DomainType::IPV6) {
+      acceptors = _acceptorsPerEndpoint;
+    }
+
+    bool ok = true;
+    for (uint64_t j = 0; ok && j < acceptors; ++j) {
+      IoContext& ioContext = _contexts[i++ % _numIoThreads];
+      ok = openEndpoint(ioContext, it.second);
+    }
 
     if (ok) {
       LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "bound to endpoint '"
@@ -134,15 +148,22 @@ void GeneralServer::IoContext::stop() {
 }
 
 
-GeneralServer::IoContext& GeneralServer::selectIoContext() { 
-  uint32_t low = _contexts[0]._clients.load();
-  size_t lowpos = 0;
+GeneralServer::IoContext& GeneralServer::selectIoContext() {
+  // pick the context with the fewest connections. the search starts at a
+  // rotating position, so that ties are broken round-robin and concurrent
+  // accepts do not all end up in the first context
+  size_t const n = _contexts.size();
+  size_t const start = _nextContext.fetch_add(1, std::memory_order_relaxed) % n;
+
+  uint64_t low = _contexts[start]._clients.load();
+  size_t lowpos = start;
 
-  for (size_t i = 1; i < _contexts.size(); ++i) {
-    uint32_t x = _contexts[i]._clients.load();
+  for (size_t i = 1; i < n; ++i) {
+    size_t const pos = (start + i) % n;
+    uint64_t x = _contexts[pos]._clients.load();
     if (x < low) {
       low = x;
-      lowpos = i;
+      lowpos = pos;
     }
   }
 
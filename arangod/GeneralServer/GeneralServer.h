@@ -42,7 +42,7 @@ class GeneralServer {
   GeneralServer const& operator=(GeneralServer const&) = delete;
 
  public:
-  explicit GeneralServer(uint64_t numIoThreads);
+  GeneralServer(uint64_t numIoThreads, uint64_t acceptorsPerEndpoint);
 
  public:
   void setEndpointList(EndpointList const* list);
@@ -135,6 +135,10 @@ public:
 
   GeneralServer::IoContext& selectIoContext();
 
+  // TCP endpoints are opened by several acceptors with SO_REUSEPORT. every
+  // acceptor hands its connections to the io context it runs in
+  bool reusePort() const { return _acceptorsPerEndpoint > 1; }
+
  protected:
   bool openEndpoint(IoContext &ioContext, Endpoint* endpoint);
 
@@ -144,7 +148,9 @@ public:
   friend class IoContext;
 
   uint64_t _numIoThreads;
+  uint64_t _acceptorsPerEndpoint;
   std::vector<IoContext> _contexts;
+  std::atomic<size_t> _nextContext;
   EndpointList const* _endpointList = nullptr;
 };
 }
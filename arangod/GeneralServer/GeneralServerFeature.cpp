@@ -46,9 +46,11 @@
 #include "ProgramOptions/Section.h"
 #include "RestHandler/RestAdminDatabaseHandler.h"
 #include "RestHandler/RestAdminLogHandler.h"
+#include "RestHandler/RestAdminMemoryHandler.h"
 #include "RestHandler/RestAdminRoutingHandler.h"
 #include "RestHandler/RestAdminServerHandler.h"
 #include "RestHandler/RestAdminStatisticsHandler.h"
+#include "RestHandler/RestAggregateViewHandler.h"
 #include "RestHandler/RestAqlFunctionsHandler.h"
 #include "RestHandler/RestAqlUserFunctionsHandler.h"
 #include "RestHandler/RestAuthHandler.h"
@@ -70,6 +72,7 @@
 #include "RestHandler/RestJobHandler.h"
 #include "RestHandler/RestPleaseUpgradeHandler.h"
 #include "RestHandler/RestPregelHandler.h"
+#include "RestHandler/RestProfileHandler.h"
 #include "RestHandler/RestQueryCacheHandler.h"
 #include "RestHandler/RestQueryHandler.h"
 #include "RestHandler/RestRepairHandler.h"
@@ -148,6 +151,12 @@ void GeneralServerFeature::collectOptions(
       "Number of threads used to handle IO",
       new UInt64Parameter(&_numIoThreads));
 
+  options->addHiddenOption(
+      "--server.allow-profiling",
+      "allow taking sampled CPU profiles via /_admin/profile and heap "
+      "profiles via /_admin/memory/profile",
+      new BooleanParameter(&_allowProfiling));
+
   options->addSection("http", "HttpServer features");
 
   options->addHiddenOption("--http.allow-method-override",
@@ -287,7 +296,8 @@ void GeneralServerFeature::buildServers() {
     ssl->SSL->verifySslOptions();
   }
 
-  GeneralServer* server = new GeneralServer(_numIoThreads);
+  GeneralServer* server =
+      new GeneralServer(_numIoThreads, endpoint->acceptorsPerEndpoint());
 
   server->setEndpointList(&endpointList);
   _servers.push_back(server);
@@ -397,6 +407,16 @@ void GeneralServerFeature::defineHandlers() {
       RestHandlerCreator<RestSimpleHandler>::createData<aql::QueryRegistry*>,
       queryRegistry);
 
+  _handlerFactory->addPrefixHandler(
+      RestVocbaseBaseHandler::SIMPLE_FIRST_EXAMPLE,
+      RestHandlerCreator<RestSimpleHandler>::createData<aql::QueryRegistry*>,
+      queryRegistry);
+
+  _handlerFactory->addPrefixHandler(
+      RestVocbaseBaseHandler::SIMPLE_REMOVE_BY_EXAMPLE,
+      RestHandlerCreator<RestSimpleHandler>::createData<aql::QueryRegistry*>,
+      queryRegistry);
+
   _handlerFactory->addPrefixHandler(
       RestVocbaseBaseHandler::TASKS_PATH,
       RestHandlerCreator<RestTasksHandler>::createNoData);
@@ -422,6 +442,10 @@ void GeneralServerFeature::defineHandlers() {
           std::pair<aql::QueryRegistry*, traverser::TraverserEngineRegistry*>*>,
           _combinedRegistries.get());
 
+  _handlerFactory->addPrefixHandler(
+      "/_api/aggregate-view",
+      RestHandlerCreator<RestAggregateViewHandler>::createNoData);
+
   _handlerFactory->addPrefixHandler(
       "/_api/aql-builtin",
       RestHandlerCreator<RestAqlFunctionsHandler>::createNoData);
@@ -493,7 +517,7 @@ void GeneralServerFeature::defineHandlers() {
   _handlerFactory->addHandler(
       "/_api/version", RestHandlerCreator<RestVersionHandler>::createNoData);
 
-  _handlerFactory->addHandler(
+  _handlerFactory->addPrefixHandler(
     "/_api/transaction", RestHandlerCreator<RestTransactionHandler>::createNoData);
 
   // ...........................................................................
@@ -554,6 +578,20 @@ void GeneralServerFeature::defineHandlers() {
     "/_admin/statistics-description",
     RestHandlerCreator<arangodb::RestAdminStatisticsHandler>::createNoData);
 
+  _handlerFactory->addHandler(
+    "/_admin/metrics",
+    RestHandlerCreator<arangodb::RestAdminStatisticsHandler>::createNoData);
+
+  _handlerFactory->addPrefixHandler(
+    "/_admin/memory",
+    RestHandlerCreator<arangodb::RestAdminMemoryHandler>::createNoData);
+
+  if (_allowProfiling) {
+    _handlerFactory->addHandler(
+      "/_admin/profile",
+      RestHandlerCreator<arangodb::RestProfileHandler>::createNoData);
+  }
+
   if (cluster->isEnabled()) {
     _handlerFactory->addPrefixHandler(
       "/_admin/repair",
@@ -75,6 +75,10 @@ class GeneralServerFeature final
     return GENERAL_SERVER->_allowMethodOverride;
   }
 
+  static bool allowProfiling() {
+    return GENERAL_SERVER != nullptr && GENERAL_SERVER->_allowProfiling;
+  }
+
   static std::vector<std::string> const& accessControlAllowOrigins() {
     static std::vector<std::string> empty;
 
@@ -103,6 +107,7 @@ class GeneralServerFeature final
  private:
   double _keepAliveTimeout = 300.0;
   bool _allowMethodOverride;
+  bool _allowProfiling = false;
 
   bool _proxyCheck;
   std::vector<std::string> _trustedProxies;
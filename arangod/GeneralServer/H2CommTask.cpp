@@ -0,0 +1,690 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "H2CommTask.h"
+
+#include <nghttp2/nghttp2.h>
+
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Cluster/ServerState.h"
+#include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/HttpCommTask.h"
+#include "Logger/Logger.h"
+#include "Rest/HttpRequest.h"
+#include "Statistics/ConnectionStatistics.h"
+#include "Statistics/RequestStatistics.h"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+uint32_t const H2CommTask::MaximalConcurrentStreams = 128;
+
+struct H2CommTask::Stream {
+  explicit Stream(int32_t id) : _id(id) {}
+
+  int32_t const _id;
+
+  // request
+  std::string _method;
+  std::string _path;
+  std::string _headers;  // "key: value\r\n" lines
+  std::string _cookies;
+  std::string _body;
+  bool _bodyTooLarge = false;
+  rest::RequestType _requestType = rest::RequestType::ILLEGAL;
+  std::string _origin;
+  bool _denyCredentials = true;
+
+  // response
+  bool _responded = false;
+  basics::StringBuffer* _responseBody = nullptr;
+  size_t _responseOffset = 0;
+  RequestStatistics* _statistics = nullptr;
+};
+
+/// @brief the nghttp2 callbacks. all of them run in the I/O thread of the
+/// connection while nghttp2 processes input or serializes frames
+struct arangodb::rest::H2Callbacks {
+  static int onBeginHeaders(nghttp2_session*, nghttp2_frame const* frame,
+                            void* userData) {
+    if (frame->hd.type != NGHTTP2_HEADERS ||
+        frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+      return 0;
+    }
+
+    auto task = static_cast<H2CommTask*>(userData);
+    int32_t const id = frame->hd.stream_id;
+    task->_streams.emplace(id, std::make_unique<H2CommTask::Stream>(id));
+
+    RequestStatistics* stat =
+        task->acquireStatistics(static_cast<uint64_t>(id));
+    RequestStatistics::SET_READ_START(stat, task->_readStartTime);
+    return 0;
+  }
+
+  static int onHeader(nghttp2_session*, nghttp2_frame const* frame,
+                      uint8_t const* name, size_t nameLength,
+                      uint8_t const* value, size_t valueLength, uint8_t,
+                      void* userData) {
+    auto task = static_cast<H2CommTask*>(userData);
+    H2CommTask::Stream* stream = task->findStream(frame->hd.stream_id);
+    if (stream == nullptr) {
+      return 0;
+    }
+
+    // nghttp2 has already checked that names are lower case and that values
+    // contain no line breaks
+    std::string key(reinterpret_cast<char const*>(name), nameLength);
+    char const* v = reinterpret_cast<char const*>(value);
+
+    if (!key.empty() && key[0] == ':') {
+      if (key == ":method") {
+        stream->_method.assign(v, valueLength);
+      } else if (key == ":path") {
+        stream->_path.assign(v, valueLength);
+      } else if (key == ":authority") {
+        stream->_headers.append("host: ").append(v, valueLength).append("\r\n");
+      }
+      // the scheme is implied by the endpoint
+      return 0;
+    }
+
+    if (key == "cookie") {
+      // HTTP/2 clients may send every cookie in a header of its own
+      if (!stream->_cookies.empty()) {
+        stream->_cookies.append("; ");
+      }
+      stream->_cookies.append(v, valueLength);
+      return 0;
+    }
+
+    if (key == StaticStrings::ContentLength) {
+      // recomputed from the received body
+      return 0;
+    }
+
+    if (stream->_headers.size() + nameLength + valueLength >
+        HttpCommTask::MaximalHeaderSize) {
+      // resets the stream
+      return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+    }
+
+    stream->_headers.append(key).append(": ").append(v, valueLength).append(
+        "\r\n");
+    return 0;
+  }
+
+  static int onDataChunk(nghttp2_session*, uint8_t, int32_t streamId,
+                         uint8_t const* data, size_t length, void* userData) {
+    auto task = static_cast<H2CommTask*>(userData);
+    H2CommTask::Stream* stream = task->findStream(streamId);
+    if (stream == nullptr || stream->_bodyTooLarge) {
+      return 0;
+    }
+
+    if (stream->_body.size() + length > HttpCommTask::MaximalBodySize) {
+      // the request is answered when the client has sent all of it
+      stream->_bodyTooLarge = true;
+      std::string().swap(stream->_body);
+      return 0;
+    }
+
+    stream->_body.append(reinterpret_cast<char const*>(data), length);
+    return 0;
+  }
+
+  static int onFrame(nghttp2_session*, nghttp2_frame const* frame,
+                     void* userData) {
+    if ((frame->hd.type != NGHTTP2_HEADERS &&
+         frame->hd.type != NGHTTP2_DATA) ||
+        (frame->hd.flags & NGHTTP2_FLAG_END_STREAM) == 0) {
+      return 0;
+    }
+
+    auto task = static_cast<H2CommTask*>(userData);
+    H2CommTask::Stream* stream = task->findStream(frame->hd.stream_id);
+    if (stream != nullptr) {
+      task->processStream(*stream);
+    }
+    return 0;
+  }
+
+  static int onStreamClose(nghttp2_session*, int32_t streamId, uint32_t,
+                           void* userData) {
+    auto task = static_cast<H2CommTask*>(userData);
+    auto it = task->_streams.find(streamId);
+    if (it != task->_streams.end()) {
+      task->releaseStream(*it->second);
+      task->_streams.erase(it);
+    }
+    return 0;
+  }
+
+  static ssize_t readResponseBody(nghttp2_session*, int32_t, uint8_t* buffer,
+                                  size_t length, uint32_t* flags,
+                                  nghttp2_data_source* source, void*) {
+    auto stream = static_cast<H2CommTask::Stream*>(source->ptr);
+    basics::StringBuffer* body = stream->_responseBody;
+    TRI_ASSERT(body != nullptr);
+
+    size_t const n =
+        (std::min)(length, body->length() - stream->_responseOffset);
+    memcpy(buffer, body->c_str() + stream->_responseOffset, n);
+    stream->_responseOffset += n;
+    RequestStatistics::ADD_SENT_BYTES(stream->_statistics, n);
+
+    if (stream->_responseOffset == body->length()) {
+      *flags |= NGHTTP2_DATA_FLAG_EOF;
+    }
+    return static_cast<ssize_t>(n);
+  }
+};
+
+H2CommTask::H2CommTask(GeneralServer& server,
+                       GeneralServer::IoContext& context,
+                       std::unique_ptr<Socket> socket, ConnectionInfo&& info,
+                       double timeout, bool skipSocketInit)
+    : IoTask(server, context, "H2CommTask"),
+      GeneralCommTask(server, context, std::move(socket), std::move(info),
+                      timeout, skipSocketInit),
+      _session(nullptr),
+      _allowMethodOverride(GeneralServerFeature::allowMethodOverride()),
+      _readStartTime(0.0),
+      _processingInput(false) {
+  _protocol = "http2";
+  _protocolVersion = rest::ProtocolVersion::HTTP_2;
+
+  ConnectionStatistics::SET_HTTP(_connectionStatistics);
+
+  nghttp2_session_callbacks* callbacks;
+  if (nghttp2_session_callbacks_new(&callbacks) != 0) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  nghttp2_session_callbacks_set_on_begin_headers_callback(
+      callbacks, H2Callbacks::onBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks,
+                                                   H2Callbacks::onHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+      callbacks, H2Callbacks::onDataChunk);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks,
+                                                       H2Callbacks::onFrame);
+  nghttp2_session_callbacks_set_on_stream_close_callback(
+      callbacks, H2Callbacks::onStreamClose);
+
+  int res = nghttp2_session_server_new(&_session, callbacks, this);
+  nghttp2_session_callbacks_del(callbacks);
+
+  if (res != 0) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  // sent together with the first response to the client preface
+  nghttp2_settings_entry settings[] = {
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, MaximalConcurrentStreams}};
+  nghttp2_submit_settings(_session, NGHTTP2_FLAG_NONE, settings,
+                          sizeof(settings) / sizeof(settings[0]));
+}
+
+H2CommTask::~H2CommTask() {
+  for (auto& it : _streams) {
+    releaseStream(*it.second);
+  }
+  _streams.clear();
+
+  nghttp2_session_del(_session);
+}
+
+// whether or not this task can mix sync and async I/O
+bool H2CommTask::canUseMixedIO() const {
+  // in case SSL is used, we cannot use a combination of sync and async I/O
+  // because that will make TLS fall apart
+  return !_peer->isEncrypted();
+}
+
+bool H2CommTask::processRead(double startTime) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  cancelKeepAlive();
+
+  if (_readBuffer.empty()) {
+    return false;
+  }
+
+  _readStartTime = startTime;
+  _processingInput = true;
+  ssize_t res = nghttp2_session_mem_recv(
+      _session, reinterpret_cast<uint8_t const*>(_readBuffer.c_str()),
+      _readBuffer.length());
+  _processingInput = false;
+
+  // nghttp2 keeps incomplete frames itself
+  _readBuffer.reset();
+
+  if (res < 0) {
+    LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+        << "invalid HTTP/2 input, closing connection: "
+        << nghttp2_strerror(static_cast<int>(res));
+    // send the GOAWAY frame, if any
+    sendFrames();
+    _closeRequested = true;
+    return false;
+  }
+
+  sendFrames();
+  return false;
+}
+
+std::unique_ptr<GeneralResponse> H2CommTask::createResponse(
+    rest::ResponseCode responseCode, uint64_t messageId) {
+  auto response =
+      std::make_unique<HttpResponse>(responseCode, leaseStringBuffer(0));
+  response->setMessageId(messageId);
+  return std::move(response);
+}
+
+/// @brief send error response including response body
+void H2CommTask::addSimpleResponse(rest::ResponseCode code,
+                                   rest::ContentType respType,
+                                   uint64_t messageId,
+                                   velocypack::Buffer<uint8_t>&& buffer) {
+  try {
+    HttpResponse resp(code, leaseStringBuffer(buffer.size()));
+    resp.setMessageId(messageId);
+    resp.setContentType(respType);
+    if (!buffer.empty()) {
+      resp.setPayload(std::move(buffer), true, VPackOptions::Defaults);
+    }
+    addResponse(resp, stealStatistics(messageId));
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(WARN, Logger::COMMUNICATION)
+        << "addSimpleResponse received an exception, closing connection:"
+        << ex.what();
+    _closeRequested = true;
+  } catch (...) {
+    LOG_TOPIC(WARN, Logger::COMMUNICATION)
+        << "addSimpleResponse received an exception, closing connection";
+    _closeRequested = true;
+  }
+}
+
+void H2CommTask::addResponse(GeneralResponse& baseResponse,
+                             RequestStatistics* stat) {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+  HttpResponse& response = dynamic_cast<HttpResponse&>(baseResponse);
+#else
+  HttpResponse& response = static_cast<HttpResponse&>(baseResponse);
+#endif
+
+  finishExecution(baseResponse);
+
+  int32_t const streamId = static_cast<int32_t>(response.messageId());
+  Stream* stream = findStream(streamId);
+
+  if (stream == nullptr || stream->_responded) {
+    // the client has reset the stream in the meantime
+    LOG_TOPIC(DEBUG, Logger::REQUESTS)
+        << "\"http2-request-dropped\",\"" << (void*)this << "/" << streamId
+        << "\"";
+    if (stat != nullptr) {
+      stat->release();
+    }
+    returnStringBuffer(response.stealBody().release());
+    return;
+  }
+
+  // CORS response handling
+  if (!stream->_origin.empty()) {
+    // send back original value of "Origin" header
+    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowOrigin,
+                                 stream->_origin);
+
+    // send back "Access-Control-Allow-Credentials" header
+    response.setHeaderNCIfNotSet(
+        StaticStrings::AccessControlAllowCredentials,
+        (stream->_denyCredentials ? "false" : "true"));
+
+    // use "IfNotSet" here because we should not override HTTP headers set
+    // by Foxx applications
+    response.setHeaderNCIfNotSet(StaticStrings::AccessControlExposeHeaders,
+                                 StaticStrings::ExposedCorsHeaders);
+  }
+
+  if (!ServerState::instance()->isDBServer()) {
+    // DB server is not user-facing, and does not need to set this header
+    // use "IfNotSet" to not overwrite an existing response header
+    response.setHeaderNCIfNotSet(StaticStrings::XContentTypeOptions,
+                                 StaticStrings::NoSniff);
+  }
+
+  size_t const responseBodyLength = response.bodySize();
+  bool const isHead = (stream->_requestType == rest::RequestType::HEAD);
+
+  if (isHead) {
+    // HEAD must not return a body
+    response.headResponse(responseBodyLength);
+  }
+
+  // the header is rendered like for HTTP/1.1 and then translated into header
+  // fields, so that both protocols send the same headers. nghttp2 compresses
+  // them
+  StringBuffer header(false);
+  response.writeHeader(&header);
+
+  std::vector<std::pair<std::string, std::string>> fields;
+  fields.emplace_back(
+      ":status", std::to_string(static_cast<int>(response.responseCode())));
+
+  char const* p = header.c_str();
+  char const* end = p + header.length();
+  // skip the status line
+  p = static_cast<char const*>(memchr(p, '\n', end - p));
+
+  while (p != nullptr && ++p < end) {
+    char const* eol = static_cast<char const*>(memchr(p, '\n', end - p));
+    if (eol == nullptr) {
+      break;
+    }
+    char const* colon = static_cast<char const*>(memchr(p, ':', eol - p));
+    if (colon != nullptr) {
+      std::string key = StringUtils::tolower(std::string(p, colon - p));
+      // connection-specific headers are not allowed in HTTP/2
+      if (key != StaticStrings::Connection && key != "keep-alive" &&
+          key != "transfer-encoding") {
+        char const* value = colon + 1;
+        while (value < eol && *value == ' ') {
+          ++value;
+        }
+        char const* valueEnd = eol;
+        if (valueEnd > value && *(valueEnd - 1) == '\r') {
+          --valueEnd;
+        }
+        fields.emplace_back(std::move(key), std::string(value, valueEnd));
+      }
+    }
+    p = eol;
+  }
+
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(fields.size());
+  for (auto const& it : fields) {
+    nva.push_back({(uint8_t*)it.first.data(), (uint8_t*)it.second.data(),
+                   it.first.size(), it.second.size(), NGHTTP2_NV_FLAG_NONE});
+  }
+
+  std::unique_ptr<basics::StringBuffer> body = response.stealBody();
+  nghttp2_data_provider provider;
+  nghttp2_data_provider* providerPtr = nullptr;
+
+  if (isHead || body == nullptr || body->empty()) {
+    returnStringBuffer(body.release());
+  } else {
+    // kept until the stream is closed, nghttp2 reads the body as the flow
+    // control windows of the client permit
+    stream->_responseBody = body.release();
+    stream->_responseOffset = 0;
+    provider.source.ptr = stream;
+    provider.read_callback = H2Callbacks::readResponseBody;
+    providerPtr = &provider;
+  }
+
+  RequestStatistics::SET_WRITE_START(stat);
+  stream->_statistics = stat;
+  stream->_responded = true;
+
+  int res = nghttp2_submit_response(_session, streamId, nva.data(), nva.size(),
+                                    providerPtr);
+  if (res != 0) {
+    LOG_TOPIC(WARN, Logger::COMMUNICATION)
+        << "cannot submit HTTP/2 response: " << nghttp2_strerror(res);
+    nghttp2_submit_rst_stream(_session, NGHTTP2_FLAG_NONE, streamId,
+                              NGHTTP2_INTERNAL_ERROR);
+  }
+
+  // and give some request information
+  LOG_TOPIC(INFO, Logger::REQUESTS)
+      << "\"http2-request-end\",\"" << (void*)this << "/" << streamId
+      << "\",\"" << _connectionInfo.clientAddress << "\",\""
+      << HttpRequest::translateMethod(stream->_requestType) << "\","
+      << static_cast<int>(response.responseCode()) << ","
+      << stream->_body.size() << "," << responseBodyLength << ","
+      << Logger::FIXED(RequestStatistics::ELAPSED_SINCE_READ_START(stat), 6);
+
+  if (!_processingInput) {
+    sendFrames();
+  }
+}
+
+H2CommTask::Stream* H2CommTask::findStream(int32_t streamId) const {
+  auto it = _streams.find(streamId);
+  if (it == _streams.end()) {
+    return nullptr;
+  }
+  return it->second.get();
+}
+
+void H2CommTask::processStream(Stream& stream) {
+  uint64_t const messageId = static_cast<uint64_t>(stream._id);
+
+  RequestStatistics* stat = statistics(messageId);
+  RequestStatistics::SET_READ_END(stat);
+  RequestStatistics::ADD_RECEIVED_BYTES(
+      stat, stream._headers.size() + stream._body.size());
+
+  if (stream._bodyTooLarge) {
+    addSimpleResponse(rest::ResponseCode::REQUEST_ENTITY_TOO_LARGE,
+                      rest::ContentType::UNSET, messageId,
+                      VPackBuffer<uint8_t>());
+    return;
+  }
+
+  // an HTTP/1.1 request header is put together from the header fields, so
+  // that URL parameters, cookies and method overrides are parsed the same
+  // way for both protocols
+  std::string header;
+  header.reserve(stream._method.size() + stream._path.size() +
+                 stream._headers.size() + stream._cookies.size() + 64);
+  header.append(stream._method)
+      .append(" ")
+      .append(stream._path)
+      .append(" HTTP/1.1\r\n")
+      .append(stream._headers);
+  if (!stream._cookies.empty()) {
+    header.append("cookie: ").append(stream._cookies).append("\r\n");
+  }
+  header.append("content-length: ")
+      .append(std::to_string(stream._body.size()))
+      .append("\r\n\r\n");
+  std::string().swap(stream._headers);
+
+  std::unique_ptr<HttpRequest> request(new HttpRequest(
+      _connectionInfo, header.c_str(), header.size(), _allowMethodOverride));
+  request->setClientTaskId(_taskId);
+  request->setProtocol(_protocol);
+  request->setMessageId(messageId);
+
+  stream._requestType = request->requestType();
+  RequestStatistics::SET_REQUEST_TYPE(stat, stream._requestType);
+
+  switch (stream._requestType) {
+    case rest::RequestType::GET:
+    case rest::RequestType::DELETE_REQ:
+    case rest::RequestType::HEAD:
+    case rest::RequestType::OPTIONS:
+    case rest::RequestType::POST:
+    case rest::RequestType::PUT:
+    case rest::RequestType::PATCH:
+      break;
+
+    default: {
+      // bad request, method not allowed
+      addSimpleResponse(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                        rest::ContentType::UNSET, messageId,
+                        VPackBuffer<uint8_t>());
+      return;
+    }
+  }
+
+  std::string const& fullUrl = request->fullUrl();
+
+  if (fullUrl.size() > 16384) {
+    addSimpleResponse(rest::ResponseCode::REQUEST_URI_TOO_LONG,
+                      rest::ContentType::UNSET, messageId,
+                      VPackBuffer<uint8_t>());
+    return;
+  }
+
+  if (!stream._body.empty()) {
+    std::string const& encoding =
+        request->header(StaticStrings::ContentEncoding);
+    if (encoding == "gzip") {
+      std::string uncompressed;
+      if (!StringUtils::gzipUncompress(stream._body.c_str(),
+                                       stream._body.size(), uncompressed)) {
+        addErrorResponse(rest::ResponseCode::BAD,
+                         request->contentTypeResponse(), messageId,
+                         TRI_ERROR_BAD_PARAMETER, "gzip decoding error");
+        return;
+      }
+      request->setBody(uncompressed.c_str(), uncompressed.size());
+    } else if (encoding == "deflate") {
+      std::string uncompressed;
+      if (!StringUtils::gzipDeflate(stream._body.c_str(), stream._body.size(),
+                                    uncompressed)) {
+        addErrorResponse(rest::ResponseCode::BAD,
+                         request->contentTypeResponse(), messageId,
+                         TRI_ERROR_BAD_PARAMETER, "gzip deflate error");
+        return;
+      }
+      request->setBody(uncompressed.c_str(), uncompressed.size());
+    } else {
+      request->setBody(stream._body.c_str(), stream._body.size());
+    }
+  }
+
+  // keep track of the original value of the "origin" request header (if
+  // any), we need this value to handle CORS requests
+  stream._origin = request->header(StaticStrings::Origin);
+  stream._denyCredentials = !allowCorsCredentials(stream._origin);
+
+  LOG_TOPIC(DEBUG, Logger::REQUESTS)
+      << "\"http2-request-begin\",\"" << (void*)this << "/" << stream._id
+      << "\",\"" << _connectionInfo.clientAddress << "\",\""
+      << HttpRequest::translateMethod(stream._requestType) << "\",\""
+      << (Logger::logRequestParameters()
+              ? fullUrl
+              : fullUrl.substr(0, fullUrl.find_first_of('?')))
+      << "\"";
+
+  // OPTIONS requests currently go unauthenticated
+  if (stream._requestType == rest::RequestType::OPTIONS) {
+    processCorsOptions(*request, stream._origin, messageId);
+    return;
+  }
+
+  // first scrape the auth headers and try to determine and authenticate the
+  // user
+  rest::ResponseCode authResult = handleAuthHeader(request.get());
+
+  if (authResult == rest::ResponseCode::SERVER_ERROR) {
+    std::string realm = "Bearer token_type=\"JWT\", realm=\"ArangoDB\"";
+    HttpResponse resp(rest::ResponseCode::UNAUTHORIZED, leaseStringBuffer(0));
+    resp.setMessageId(messageId);
+    resp.setHeaderNC(StaticStrings::WwwAuthenticate, std::move(realm));
+    addResponse(resp, stealStatistics(messageId));
+    return;
+  }
+
+  // prepare execution will send an error message
+  if (prepareExecution(*request) != RequestFlow::Continue) {
+    return;
+  }
+
+  auto resp = std::make_unique<HttpResponse>(rest::ResponseCode::SERVER_ERROR,
+                                             leaseStringBuffer(1024));
+  resp->setMessageId(messageId);
+  resp->setContentType(request->contentTypeResponse());
+  resp->setContentTypeRequested(request->contentTypeResponse());
+
+  executeRequest(std::move(request), std::move(resp));
+}
+
+void H2CommTask::releaseStream(Stream& stream) {
+  if (stream._responseBody != nullptr) {
+    returnStringBuffer(stream._responseBody);
+    stream._responseBody = nullptr;
+  }
+
+  if (stream._statistics != nullptr) {
+    RequestStatistics::SET_WRITE_END(stream._statistics);
+    stream._statistics->release();
+    stream._statistics = nullptr;
+  }
+
+  // the request may not have been executed
+  setStatistics(static_cast<uint64_t>(stream._id), nullptr);
+}
+
+void H2CommTask::sendFrames() {
+  basics::StringBuffer* buffer = nullptr;
+
+  while (true) {
+    uint8_t const* data = nullptr;
+    ssize_t n = nghttp2_session_mem_send(_session, &data);
+
+    if (n < 0) {
+      LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+          << "cannot serialize HTTP/2 frames, closing connection: "
+          << nghttp2_strerror(static_cast<int>(n));
+      _closeRequested = true;
+      break;
+    }
+    if (n == 0) {
+      break;
+    }
+
+    if (buffer == nullptr) {
+      buffer = leaseStringBuffer(static_cast<size_t>(n));
+    }
+    buffer->appendText(reinterpret_cast<char const*>(data),
+                       static_cast<size_t>(n));
+  }
+
+  bool const done = nghttp2_session_want_read(_session) == 0 &&
+                    nghttp2_session_want_write(_session) == 0;
+
+  if (buffer != nullptr) {
+    addWriteBuffer(WriteBuffer(buffer, nullptr));
+    if (done) {
+      // closes the connection when the last frames are written
+      _closeRequested = true;
+    }
+  } else if (done) {
+    closeStream();
+  }
+
+  if (_streams.empty()) {
+    resetKeepAlive();
+  }
+}
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_H2_COMM_TASK_H
+#define ARANGOD_GENERAL_SERVER_H2_COMM_TASK_H 1
+
+#include "Basics/Common.h"
+#include "GeneralServer/GeneralCommTask.h"
+#include "Rest/HttpResponse.h"
+
+struct nghttp2_session;
+
+namespace arangodb {
+namespace rest {
+struct H2Callbacks;
+
+/// @brief HTTP/2 connection. the framing, HPACK header compression and flow
+/// control are done by nghttp2, requests of all streams of the connection
+/// are executed concurrently. requests and responses are represented by
+/// HttpRequest and HttpResponse with the stream id as message id, so that
+/// handlers do not see a difference between HTTP/1.1 and HTTP/2
+class H2CommTask final : public GeneralCommTask {
+  friend struct H2Callbacks;
+
+ public:
+  static uint32_t const MaximalConcurrentStreams;
+
+ public:
+  H2CommTask(GeneralServer& server, GeneralServer::IoContext& context,
+             std::unique_ptr<Socket> socket, ConnectionInfo&&, double timeout,
+             bool skipSocketInit = false);
+  ~H2CommTask();
+
+  arangodb::Endpoint::TransportType transportType() override {
+    return arangodb::Endpoint::TransportType::HTTP;
+  }
+
+  // whether or not this task can mix sync and async I/O
+  bool canUseMixedIO() const override;
+
+ private:
+  bool processRead(double startTime) override;
+
+  std::unique_ptr<GeneralResponse> createResponse(
+      rest::ResponseCode, uint64_t messageId) override final;
+
+  void addResponse(GeneralResponse& response,
+                   RequestStatistics* stat) override;
+
+  /// @brief send error response including response body
+  void addSimpleResponse(rest::ResponseCode, rest::ContentType,
+                         uint64_t messageId,
+                         velocypack::Buffer<uint8_t>&&) override;
+
+ private:
+  struct Stream;
+
+  Stream* findStream(int32_t streamId) const;
+
+  /// @brief execute the request of a stream, called when the client has
+  /// sent all of it
+  void processStream(Stream&);
+
+  /// @brief release the resources of a closed stream
+  void releaseStream(Stream&);
+
+  /// @brief hand all frames nghttp2 wants to send to the socket
+  void sendFrames();
+
+ private:
+  nghttp2_session* _session;
+  std::unordered_map<int32_t, std::unique_ptr<Stream>> _streams;
+
+  bool const _allowMethodOverride;
+
+  /// @brief read start of the current input, for the statistics of
+  /// streams which begin in it
+  double _readStartTime;
+
+  /// @brief true while nghttp2 processes input. frames must not be sent
+  /// from its callbacks, they are sent when the input is processed
+  bool _processingInput;
+};
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
@@ -24,18 +24,19 @@
 
 #include "HttpCommTask.h"
 
-#include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "GeneralServer/GeneralServer.h"
 #include "GeneralServer/GeneralServerFeature.h"
+#ifdef USE_NGHTTP2
+#include "GeneralServer/H2CommTask.h"
+#endif
 #include "GeneralServer/RestHandler.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "GeneralServer/VstCommTask.h"
 #include "Meta/conversion.h"
 #include "Rest/HttpRequest.h"
 #include "Statistics/ConnectionStatistics.h"
-#include "Utils/Events.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -45,6 +46,8 @@ size_t const HttpCommTask::MaximalHeaderSize = 2 * 1024 * 1024;       //    2 MB
 size_t const HttpCommTask::MaximalBodySize = 1024 * 1024 * 1024;      // 1024 MB
 size_t const HttpCommTask::MaximalPipelineSize = 1024 * 1024 * 1024;  // 1024 MB
 size_t const HttpCommTask::RunCompactEvery = 500;
+size_t const HttpCommTask::MaximalUnsentStreamSize = 1024 * 1024;     //    1 MB
+double const HttpCommTask::StreamWriteTimeout = 300.0;
 
 HttpCommTask::HttpCommTask(GeneralServer &server, GeneralServer::IoContext &context,
                            std::unique_ptr<Socket> socket,
@@ -64,7 +67,10 @@ HttpCommTask::HttpCommTask(GeneralServer &server, GeneralServer::IoContext &cont
       _fullUrl(),
       _origin(),
       _sinceCompactification(0),
-      _originalBodyLength(0) {
+      _originalBodyLength(0),
+      _postedStreamBytes(0),
+      _streamTimer(context.newDeadlineTimer(boost::posix_time::milliseconds(
+          static_cast<long>(StreamWriteTimeout * 1000)))) {
   _protocol = "http";
 
   ConnectionStatistics::SET_HTTP(_connectionStatistics);
@@ -109,63 +115,57 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse,
   HttpResponse& response = static_cast<HttpResponse&>(baseResponse);
 #endif
 
-  finishExecution(baseResponse);
   resetKeepAlive();
 
   // response has been queued, allow further requests
   _requestPending = false;
 
-  // CORS response handling
-  if (!_origin.empty()) {
-    // the request contained an Origin header. We have to send back the
-    // access-control-allow-origin header now
-    LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "handling CORS response";
-
-    // send back original value of "Origin" header
-    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowOrigin,
-                                 _origin);
-
-    // send back "Access-Control-Allow-Credentials" header
-    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowCredentials,
-                                 (_denyCredentials ? "false" : "true"));
-
-    // use "IfNotSet" here because we should not override HTTP headers set
-    // by Foxx applications
-    response.setHeaderNCIfNotSet(StaticStrings::AccessControlExposeHeaders,
-                                 StaticStrings::ExposedCorsHeaders);
-  }
-
-  if (!ServerState::instance()->isDBServer()) {
-    // DB server is not user-facing, and does not need to set this header
-    // use "IfNotSet" to not overwrite an existing response header
-    response.setHeaderNCIfNotSet(StaticStrings::XContentTypeOptions,
-                                 StaticStrings::NoSniff);
-  }
-
-  // set "connection" header, keep-alive is the default
-  response.setConnectionType(_closeRequested
-                                  ? rest::ConnectionType::C_CLOSE
-                                  : rest::ConnectionType::C_KEEP_ALIVE);
-
   size_t const responseBodyLength = response.bodySize();
-
-  if (_requestType == rest::RequestType::HEAD) {
-    // clear body if this is an HTTP HEAD request
-    // HEAD must not return a body
-    response.headResponse(responseBodyLength);
+  WriteBuffer buffer(leaseStringBuffer(220), stat);
+  std::unique_ptr<basics::StringBuffer> body;
+
+  if (response._streamBroken) {
+    // the handler failed after a part of the body was sent. the client can
+    // only be told by closing the connection
+    LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+        << "streamed response failed, closing connection";
+    buffer.release(this);
+    _closeRequested = true;
+    closeStreamNoLock();
+    return;
   }
 
-  // reserve a buffer with some spare capacity
-  WriteBuffer buffer(leaseStringBuffer(responseBodyLength + 220), stat);
+  if (response._streamed) {
+    // the last chunk and the end of the body. the remainder of the body is
+    // smaller than a chunk, so it is copied
+    body = response.stealBody();
+    buffer._buffer->appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+    if (!body->empty()) {
+      buffer._buffer->appendHex(body->length());
+      buffer._buffer->appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+      buffer._buffer->appendText(body->c_str(), body->length());
+      buffer._buffer->appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+    }
+    buffer._buffer->appendText(TRI_CHAR_LENGTH_PAIR("0\r\n\r\n"));
+  } else {
+    prepareResponse(response);
 
-  // write header
-  response.writeHeader(buffer._buffer);
+    if (_requestType == rest::RequestType::HEAD) {
+      // clear body if this is an HTTP HEAD request
+      // HEAD must not return a body
+      response.headResponse(responseBodyLength);
+    }
 
-  // write body
-  if (_requestType != rest::RequestType::HEAD) {
-    buffer._buffer->appendText(response.body());
-  }
+    // write header. the body is written from the buffer of the response, so
+    // that large bodies are not copied once more
+    response.writeHeader(buffer._buffer);
 
+    body = response.stealBody();
+    if (_requestType != rest::RequestType::HEAD && body != nullptr &&
+        !body->empty()) {
+      buffer._body = body.release();
+    }
+  }
   buffer._buffer->ensureNullTerminated();
 
   if (!buffer._buffer->empty()) {
@@ -177,7 +177,10 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse,
         << "\",\""
         << (Logger::logRequestParameters()
              ? StringUtils::escapeUnicode(
-                 std::string(buffer._buffer->c_str(), buffer._buffer->length()))
+                 std::string(buffer._buffer->c_str(), buffer._buffer->length()) +
+                 (buffer._body != nullptr
+                      ? std::string(buffer._body->c_str(), buffer._body->length())
+                      : std::string()))
 	    : "--body--")
         << "\"";
   }
@@ -199,6 +202,18 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse,
              : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
         << "\"," << stat->timingsCsv();
   }
+
+  double const slowThreshold = StatisticsFeature::slowRequestThreshold();
+  if (stat != nullptr && slowThreshold > 0.0 && totalTime >= slowThreshold) {
+    LOG_TOPIC(WARN, Logger::REQUESTS)
+        << "slow request: " << HttpRequest::translateMethod(_requestType)
+        << " '"
+        << (Logger::logRequestParameters()
+             ? _fullUrl
+             : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
+        << "', took: " << Logger::FIXED(totalTime, 6) << " s, "
+        << stat->timingsCsv();
+  }
   addWriteBuffer(std::move(buffer));
   // read pipelined requests
   triggerProcessAll();
@@ -216,8 +231,9 @@ void HttpCommTask::addResponse(GeneralResponse& baseResponse,
              : _fullUrl.substr(0, _fullUrl.find_first_of('?')))
      << "\"," << Logger::FIXED(totalTime, 6);
 
-  std::unique_ptr<basics::StringBuffer> body = response.stealBody();
-  returnStringBuffer(body.release()); // takes care of deleting
+  if (body != nullptr) {
+    returnStringBuffer(body.release());
+  }
 }
 
 // reads data from the socket
@@ -309,6 +325,38 @@ bool HttpCommTask::processRead(double startTime) {
       return false;
     }
 
+#ifdef USE_NGHTTP2
+    // HTTP/2 clients with prior knowledge and TLS clients which negotiated
+    // "h2" start with the client connection preface
+    static char const H2Preface[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+    size_t const h2PrefaceLength = sizeof(H2Preface) - 1;
+
+    if (_startPosition == 0 &&
+        std::memcmp(_readBuffer.c_str(), H2Preface,
+                    (std::min)(_readBuffer.length(), h2PrefaceLength)) == 0) {
+      if (_readBuffer.length() < h2PrefaceLength) {
+        // let client send more
+        return false;
+      }
+
+      LOG_TOPIC(TRACE, Logger::COMMUNICATION) << "switching from HTTP/1.1 to HTTP/2";
+
+      // mark task as abandoned, no more reads will happen on _peer
+      if (!abandon()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "task is already abandoned");
+      }
+
+      std::shared_ptr<GeneralCommTask> commTask = std::make_shared<H2CommTask>(
+          _server, _context, std::move(_peer), std::move(_connectionInfo),
+          GeneralServerFeature::keepAliveTimeout(), /*skipSocketInit*/ true);
+      // nghttp2 expects the preface
+      commTask->addToReadBuffer(_readBuffer.c_str(), _readBuffer.length());
+      commTask->processAll();
+      commTask->start();
+      return false;
+    }
+#endif
+
     // header is complete
     if (ptr < end) {
       _readPosition = ptr - _readBuffer.c_str() + 4;
@@ -365,37 +413,7 @@ bool HttpCommTask::processRead(double startTime) {
       // any), we need this value to handle CORS requests
       _origin = _incompleteRequest->header(StaticStrings::Origin);
 
-      if (!_origin.empty()) {
-        // default is to allow nothing
-        _denyCredentials = true;
-
-        // if the request asks to allow credentials, we'll check against the
-        // configured whitelist of origins
-        std::vector<std::string> const& accessControlAllowOrigins =
-            GeneralServerFeature::accessControlAllowOrigins();
-
-        if (!accessControlAllowOrigins.empty()) {
-          if (accessControlAllowOrigins[0] == "*") {
-            // special case: allow everything
-            _denyCredentials = false;
-          } else if (!_origin.empty()) {
-            // copy origin string
-            if (_origin[_origin.size() - 1] == '/') {
-              // strip trailing slash
-              auto result = std::find(accessControlAllowOrigins.begin(),
-                                      accessControlAllowOrigins.end(),
-                                      _origin.substr(0, _origin.size() - 1));
-              _denyCredentials = (result == accessControlAllowOrigins.end());
-            } else {
-              auto result = std::find(accessControlAllowOrigins.begin(),
-                                      accessControlAllowOrigins.end(), _origin);
-              _denyCredentials = (result == accessControlAllowOrigins.end());
-            }
-          } else {
-            TRI_ASSERT(_denyCredentials);
-          }
-        }
-      }
+      _denyCredentials = !allowCorsCredentials(_origin);
 
       // store the original request's type. we need it later when responding
       // (original request object gets deleted before responding)
@@ -566,7 +584,7 @@ bool HttpCommTask::processRead(double startTime) {
   // OPTIONS requests currently go unauthenticated
   if (isOptionsRequest) {
     // handle HTTP OPTIONS requests directly
-    processCorsOptions(std::move(_incompleteRequest));
+    processCorsOptions(*_incompleteRequest, _origin, 1);
     _incompleteRequest.reset(nullptr);
     return true;
   }
@@ -598,6 +616,149 @@ bool HttpCommTask::processRead(double startTime) {
   return true;
 }
 
+void HttpCommTask::prepareResponse(HttpResponse& response) {
+  finishExecution(response);
+
+  // CORS response handling
+  if (!_origin.empty()) {
+    // the request contained an Origin header. We have to send back the
+    // access-control-allow-origin header now
+    LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "handling CORS response";
+
+    // send back original value of "Origin" header
+    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowOrigin,
+                                 _origin);
+
+    // send back "Access-Control-Allow-Credentials" header
+    response.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowCredentials,
+                                 (_denyCredentials ? "false" : "true"));
+
+    // use "IfNotSet" here because we should not override HTTP headers set
+    // by Foxx applications
+    response.setHeaderNCIfNotSet(StaticStrings::AccessControlExposeHeaders,
+                                 StaticStrings::ExposedCorsHeaders);
+  }
+
+  if (!ServerState::instance()->isDBServer()) {
+    // DB server is not user-facing, and does not need to set this header
+    // use "IfNotSet" to not overwrite an existing response header
+    response.setHeaderNCIfNotSet(StaticStrings::XContentTypeOptions,
+                                 StaticStrings::NoSniff);
+  }
+
+  // set "connection" header, keep-alive is the default
+  response.setConnectionType(_closeRequested
+                                  ? rest::ConnectionType::C_CLOSE
+                                  : rest::ConnectionType::C_KEEP_ALIVE);
+}
+
+bool HttpCommTask::sendChunk(HttpResponse& response) {
+  TRI_ASSERT(!response._streamBroken);
+
+  auto buffer =
+      std::make_shared<WriteBuffer>(leaseStringBuffer(220), nullptr);
+
+  if (!response._streamed) {
+    // the members used for the header do not change while the request
+    // is pending
+    prepareResponse(response);
+    response.setHeaderNC("transfer-encoding", "chunked");
+    response.writeHeader(buffer->_buffer);
+    response._streamed = true;
+  } else {
+    // end of the previous chunk
+    buffer->_buffer->appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+  }
+
+  // the response continues with an empty buffer, the chunk is written
+  // without copying it
+  basics::StringBuffer* chunk = leaseStringBuffer(0);
+  chunk->swap(&response.body());
+  response._streamedLength += chunk->length();
+
+  buffer->_buffer->appendHex(chunk->length());
+  buffer->_buffer->appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
+  buffer->_buffer->ensureNullTerminated();
+  buffer->_body = chunk;
+
+  size_t const length = buffer->length();
+  _postedStreamBytes.fetch_add(length, std::memory_order_relaxed);
+
+  auto self = shared_from_this();
+  _peer->post([self, this, buffer, length]() {
+    // the bytes are counted as unsent by addWriteBuffer, which may already
+    // write them
+    _postedStreamBytes.fetch_sub(length, std::memory_order_relaxed);
+    addWriteBuffer(std::move(*buffer));
+  });
+
+  if (_closedSend.load(std::memory_order_acquire) ||
+      _abandoned.load(std::memory_order_acquire)) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_REQUEST_CANCELED);
+  }
+
+  if (_peer->runningInThisThread()) {
+    // a handler executed directly by the io thread cannot be paused, the
+    // chunks could not be written before it finishes
+    return false;
+  }
+
+  // backpressure: do not generate more of the body before the client has
+  // received most of it
+  return unsentBytes() + _postedStreamBytes.load(std::memory_order_relaxed) >
+         MaximalUnsentStreamSize;
+}
+
+void HttpCommTask::waitForStream(std::function<void()> const& callback) {
+  auto self = shared_from_this();
+  _peer->post([self, this, callback]() {
+    TRI_ASSERT(!_streamWaiter);
+    _streamWaiter = callback;
+
+    asio_ns::error_code err;
+    _streamTimer->expires_from_now(
+        boost::posix_time::milliseconds(
+            static_cast<long>(StreamWriteTimeout * 1000)),
+        err);
+    if (!err) {
+      _streamTimer->async_wait([self, this](asio_ns::error_code const& error) {
+        if (!error) {  // error will be true if timer was canceled
+          LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+              << "client does not read streamed response, closing connection";
+          closeStream();
+        }
+      });
+    }
+
+    // the client may have caught up already
+    writeProgress();
+  });
+}
+
+// caller must run in _peer->strand()
+void HttpCommTask::writeProgress() {
+  TRI_ASSERT(_peer->runningInThisThread());
+
+  if (!_streamWaiter) {
+    return;
+  }
+
+  if (!_closedSend.load(std::memory_order_acquire) &&
+      !_abandoned.load(std::memory_order_acquire) &&
+      unsentBytes() + _postedStreamBytes.load(std::memory_order_relaxed) >
+          MaximalUnsentStreamSize) {
+    return;
+  }
+
+  asio_ns::error_code err;
+  _streamTimer->cancel(err);
+
+  // the handler fails on a closed connection when it continues
+  std::function<void()> callback = std::move(_streamWaiter);
+  _streamWaiter = nullptr;
+  callback();
+}
+
 void HttpCommTask::processRequest(std::unique_ptr<HttpRequest> request) {
   TRI_ASSERT(_peer->runningInThisThread());
 
@@ -628,6 +789,22 @@ void HttpCommTask::processRequest(std::unique_ptr<HttpRequest> request) {
   resp->setContentType(request->contentTypeResponse());
   resp->setContentTypeRequested(request->contentTypeResponse());
 
+  // large bodies can be sent while the handler generates them. not to
+  // HTTP/1.0 clients, which do not know chunked transfer encoding, and
+  // not if the response is stored for an async job
+  bool found;
+  request->header(StaticStrings::Async, found);
+  if (!found && _protocolVersion == rest::ProtocolVersion::HTTP_1_1 &&
+      _requestType != rest::RequestType::HEAD) {
+    auto self = shared_from_this();
+    resp->_bodyStream = [self, this](HttpResponse& response) {
+      return sendChunk(response);
+    };
+    resp->_bodyStreamWait = [self, this](std::function<void()> const& callback) {
+      waitForStream(callback);
+    };
+  }
+
   executeRequest(std::move(request), std::move(resp));
 }
 
@@ -673,42 +850,6 @@ bool HttpCommTask::checkContentLength(HttpRequest* request,
   return true;
 }
 
-void HttpCommTask::processCorsOptions(std::unique_ptr<HttpRequest> request) {
-  HttpResponse resp(rest::ResponseCode::OK, leaseStringBuffer(0));
-
-  resp.setHeaderNCIfNotSet(StaticStrings::Allow, StaticStrings::CorsMethods);
-
-  if (!_origin.empty()) {
-    LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "got CORS preflight request";
-    std::string const allowHeaders = StringUtils::trim(
-        request->header(StaticStrings::AccessControlRequestHeaders));
-
-    // send back which HTTP methods are allowed for the resource
-    // we'll allow all
-    resp.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowMethods,
-                              StaticStrings::CorsMethods);
-
-    if (!allowHeaders.empty()) {
-      // allow all extra headers the client requested
-      // we don't verify them here. the worst that can happen is that the
-      // client sends some broken headers and then later cannot access the data
-      // on
-      // the server. that's a client problem.
-      resp.setHeaderNCIfNotSet(StaticStrings::AccessControlAllowHeaders,
-                                allowHeaders);
-
-      LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "client requested validation of the following headers: "
-                 << allowHeaders;
-    }
-
-    // set caching time (hard-coded value)
-    resp.setHeaderNCIfNotSet(StaticStrings::AccessControlMaxAge,
-                              StaticStrings::N1800);
-  }
-
-  addResponse(resp, nullptr);
-}
-
 std::unique_ptr<GeneralResponse> HttpCommTask::createResponse(
     rest::ResponseCode responseCode, uint64_t /* messageId */) {
   return std::make_unique<HttpResponse>(responseCode, leaseStringBuffer(0));
@@ -763,67 +904,3 @@ void HttpCommTask::resetState() {
   _newRequest = true;
   _readRequestBody = false;
 }
-
-ResponseCode HttpCommTask::handleAuthHeader(HttpRequest* req) const {
-  bool found;
-  std::string const& authStr = req->header(StaticStrings::Authorization, found);
-  if (!found) {
-    if (_auth->isActive()) {
-      events::CredentialsMissing(req);
-      return rest::ResponseCode::UNAUTHORIZED;
-    }
-    return rest::ResponseCode::OK;
-  }
-
-  size_t methodPos = authStr.find_first_of(' ');
-  if (methodPos != std::string::npos) {
-    // skip over authentication method
-    char const* auth = authStr.c_str() + methodPos;
-    while (*auth == ' ') {
-      ++auth;
-    }
-
-    if (Logger::logRequestParameters()) {
-      LOG_TOPIC(DEBUG, arangodb::Logger::REQUESTS) << "\"authorization-header\",\""
-        << (void*)this << "\",\"" << authStr << "\"";
-    }
-
-    try {
-      // note that these methods may throw in case of an error
-      AuthenticationMethod authMethod = AuthenticationMethod::NONE;
-      if (TRI_CaseEqualString(authStr.c_str(), "basic ", 6)) {
-        authMethod = AuthenticationMethod::BASIC;
-      } else if (TRI_CaseEqualString(authStr.c_str(), "bearer ", 7)) {
-        authMethod = AuthenticationMethod::JWT;
-      }
-
-      req->setAuthenticationMethod(authMethod);
-      if (authMethod != AuthenticationMethod::NONE) {
-        auto entry = _auth->tokenCache().checkAuthentication(authMethod, auth);
-        req->setAuthenticated(entry.authenticated());
-        req->setUser(std::move(entry._username));
-      }
-      
-      if (req->authenticated() || !_auth->isActive()) {
-        events::Authenticated(req, authMethod);
-        return rest::ResponseCode::OK;
-      } else if (_auth->isActive()) {
-        events::CredentialsBad(req, authMethod);
-        return rest::ResponseCode::UNAUTHORIZED;
-      }
-
-      // intentionally falls through
-    } catch (arangodb::basics::Exception const& ex) {
-      // translate error
-      if (ex.code() == TRI_ERROR_USER_NOT_FOUND) {
-        return rest::ResponseCode::UNAUTHORIZED;
-      }
-      return GeneralResponse::responseCode(ex.what());
-    } catch (...) {
-      return rest::ResponseCode::SERVER_ERROR;
-    }
-  }
-
-  events::UnknownAuthenticationMethod(req);
-  return rest::ResponseCode::UNAUTHORIZED;
-}
@@ -15,6 +15,8 @@ class HttpCommTask final : public GeneralCommTask {
   static size_t const MaximalBodySize;
   static size_t const MaximalPipelineSize;
   static size_t const RunCompactEvery;
+  static size_t const MaximalUnsentStreamSize;
+  static double const StreamWriteTimeout;
 
  public:
   HttpCommTask(GeneralServer &server, GeneralServer::IoContext &context, std::unique_ptr<Socket> socket,
@@ -43,7 +45,20 @@ class HttpCommTask final : public GeneralCommTask {
 
  private:
   void processRequest(std::unique_ptr<HttpRequest>);
-  void processCorsOptions(std::unique_ptr<HttpRequest>);
+
+  // set the headers which depend on the connection and the request
+  void prepareResponse(HttpResponse&);
+
+  // send the part of the body generated so far as a chunk, called by the
+  // thread executing the handler. returns true if too much of the body is
+  // not yet written to the socket
+  bool sendChunk(HttpResponse&);
+
+  // invokes the callback once the client has caught up with a streamed
+  // body, or the connection is closed
+  void waitForStream(std::function<void()> const&);
+
+  void writeProgress() override;
 
   void resetState();
 
@@ -52,7 +67,6 @@ class HttpCommTask final : public GeneralCommTask {
 
   std::string authenticationRealm() const;
   ResponseCode authenticateRequest(HttpRequest*);
-  ResponseCode handleAuthHeader(HttpRequest* request) const;
 
 
  private:
@@ -79,6 +93,15 @@ class HttpCommTask final : public GeneralCommTask {
   bool _requestPending = false;
 
   std::unique_ptr<HttpRequest> _incompleteRequest;
+
+  // bytes of chunks of a streamed response which were posted to the io
+  // thread but not yet added as write buffers
+  std::atomic<size_t> _postedStreamBytes;
+
+  // continues the handler of a streamed response once the client has caught
+  // up. only used in the strand
+  std::function<void()> _streamWaiter;
+  std::unique_ptr<asio_ns::deadline_timer> _streamTimer;
 };
 }
 }
@@ -44,6 +44,31 @@ using namespace arangodb::rest;
 
 thread_local RestHandler const* RestHandler::CURRENT_HANDLER = nullptr;
 
+namespace {
+/// @brief adds the CPU time and memory allocated by the current thread
+/// during its lifetime to the request statistics
+class ExecutionCostsScope {
+ public:
+  explicit ExecutionCostsScope(RequestStatistics* stat)
+      : _stat(stat),
+        _cpuStart(stat != nullptr ? RequestStatistics::threadCpuTime() : 0.0),
+        _allocatedStart(stat != nullptr ? RequestStatistics::threadAllocatedBytes() : 0) {}
+
+  ~ExecutionCostsScope() {
+    if (_stat != nullptr) {
+      RequestStatistics::ADD_EXECUTION_COSTS(
+          _stat, RequestStatistics::threadCpuTime() - _cpuStart,
+          RequestStatistics::threadAllocatedBytes() - _allocatedStart);
+    }
+  }
+
+ private:
+  RequestStatistics* _stat;
+  double const _cpuStart;
+  uint64_t const _allocatedStart;
+};
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -54,7 +79,20 @@ RestHandler::RestHandler(GeneralRequest* request, GeneralResponse* response)
       _response(response),
       _statistics(nullptr),
       _handlerId(0),
-      _state(HandlerState::PREPARE) {}
+      _deadline(0.0),
+      _state(HandlerState::PREPARE) {
+  if (_request != nullptr) {
+    bool found;
+    std::string const& timeout =
+        _request->header(StaticStrings::RequestTimeout, found);
+    if (found) {
+      double const value = std::strtod(timeout.c_str(), nullptr);
+      if (value > 0.0 && std::isfinite(value)) {
+        _deadline = TRI_microtime() + value;
+      }
+    }
+  }
+}
 
 RestHandler::~RestHandler() {
   RequestStatistics* stat = _statistics.exchange(nullptr);
@@ -68,6 +106,15 @@ RestHandler::~RestHandler() {
 // --SECTION--                                                    public methods
 // -----------------------------------------------------------------------------
 
+double RestHandler::remainingTime() const {
+  if (_deadline <= 0.0) {
+    return 0.0;
+  }
+  // a small positive value, so that an expired deadline is distinguishable
+  // from no deadline
+  return (std::max)(_deadline - TRI_microtime(), 0.001);
+}
+
 void RestHandler::assignHandlerId() {
   _handlerId = TRI_NewServerSpecificTick();
 }
@@ -260,10 +307,15 @@ bool RestHandler::forwardRequest() {
   return true;
 }
 
-void RestHandler::runHandlerStateMachine() {
+void RestHandler::runHandlerStateMachine(bool onlyIfPaused) {
   TRI_ASSERT(_callback);
   MUTEX_LOCKER(locker, _executionMutex);
 
+  if (onlyIfPaused && _state != HandlerState::PAUSED) {
+    TRI_ASSERT(_state == HandlerState::DONE || _state == HandlerState::FAILED);
+    return;
+  }
+
   while (true) {
     switch (_state) {
       case HandlerState::PREPARE:
@@ -372,6 +424,23 @@ void RestHandler::prepareEngine() {
     return;
   }
 
+  if (isExpired()) {
+    // the client has given up while the request was queued. do not spend
+    // any more resources on it
+    _state = HandlerState::FAILED;
+    RequestStatistics::SET_EXECUTE_ERROR(_statistics);
+
+    LOG_TOPIC(DEBUG, Logger::REQUESTS)
+        << "dropping request " << _request->fullUrl()
+        << " because its deadline has expired";
+
+    Exception err(TRI_ERROR_REQUEST_CANCELED,
+                  "request deadline expired before execution", __FILE__,
+                  __LINE__);
+    handleError(err);
+    return;
+  }
+
   try {
     prepareExecute(false);
     _state = HandlerState::EXECUTE;
@@ -394,13 +463,9 @@ void RestHandler::prepareEngine() {
 
 /// Execute the rest handler state machine
 void RestHandler::continueHandlerExecution() {
-#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
-  {
-    MUTEX_LOCKER(locker, _executionMutex);
-    TRI_ASSERT(_state == HandlerState::PAUSED);
-  }
-#endif
-  runHandlerStateMachine();
+  // an AQL query with requests to multiple servers in flight is woken up
+  // once per response, so late wakeups may find the handler finished
+  runHandlerStateMachine(true);
 }
 
 void RestHandler::shutdownEngine() {
@@ -417,6 +482,7 @@ void RestHandler::executeEngine(bool isContinue) {
   TRI_ASSERT(ExecContext::CURRENT == nullptr);
   ExecContext* exec = static_cast<ExecContext*>(_request->requestContext());
   ExecContextScope scope(exec);
+  ExecutionCostsScope costs(_statistics.load());
 
   RestHandler::CURRENT_HANDLER = this;
 
@@ -25,6 +25,7 @@
 #define ARANGOD_HTTP_SERVER_REST_HANDLER_H 1
 
 #include "Basics/Common.h"
+#include "Basics/system-functions.h"
 
 #include "Rest/GeneralResponse.h"
 #include "Scheduler/Scheduler.h"
@@ -70,6 +71,21 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
 
   void setStatistics(RequestStatistics* stat);
 
+  /// @brief the point in time (as TRI_microtime) at which the client stops
+  /// waiting for the response, as sent in the x-arango-request-timeout
+  /// header. 0.0 if the client did not send a timeout
+  double deadline() const { return _deadline; }
+
+  /// @brief seconds until the deadline, or 0.0 if there is no deadline.
+  /// never returns 0.0 if there is a deadline
+  double remainingTime() const;
+
+  /// @brief whether the client has given up waiting for the response.
+  /// long-running handlers may check this and stop early
+  bool isExpired() const {
+    return _deadline > 0.0 && TRI_microtime() > _deadline;
+  }
+
   /// Execute the rest handler state machine
   void runHandler(std::function<void(rest::RestHandler*)> cb) {
     TRI_ASSERT(_state == HandlerState::PREPARE);
@@ -137,7 +153,9 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
 
   enum class HandlerState { PREPARE, EXECUTE, PAUSED, CONTINUED, FINALIZE, DONE, FAILED };
 
-  void runHandlerStateMachine();
+  /// @brief run the state machine. if onlyIfPaused is set, nothing is done
+  /// unless the handler is paused
+  void runHandlerStateMachine(bool onlyIfPaused = false);
 
   void prepareEngine();
   /// @brief Executes the RestHandler
@@ -157,6 +175,7 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
 
  private:
   uint64_t _handlerId;
+  double _deadline;
 
   HandlerState _state;
   std::function<void(rest::RestHandler*)> _callback;
@@ -166,6 +166,14 @@ void VstCommTask::addResponse(GeneralResponse& baseResponse,
         << _connectionInfo.clientAddress << "\"," << stat->timingsCsv();
   }
 
+  double const slowThreshold = StatisticsFeature::slowRequestThreshold();
+  if (stat != nullptr && slowThreshold > 0.0 && totalTime >= slowThreshold) {
+    LOG_TOPIC(WARN, Logger::REQUESTS)
+        << "slow request: vst message " << mid << " from "
+        << _connectionInfo.clientAddress << ", took: "
+        << Logger::FIXED(totalTime, 6) << " s, " << stat->timingsCsv();
+  }
+
   if (buffers.empty()) {
     if (stat != nullptr) {
       stat->release();
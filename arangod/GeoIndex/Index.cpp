@@ -34,6 +34,8 @@
 #include "Aql/AstNode.h"
 #include "Aql/Function.h"
 #include "Aql/Variable.h"
+#include "Basics/StringRef.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Geo/GeoJson.h"
 #include "Geo/GeoParams.h"
 #include "Geo/GeoUtils.h"
@@ -42,6 +44,26 @@
 namespace arangodb {
 namespace geo_index {
 
+void RangeFilter::add(VPackSlice const& bound, bool lower, bool inclusive) {
+  _bounds.emplace_back();
+  _bounds.back().value.add(bound);
+  _bounds.back().lower = lower;
+  _bounds.back().inclusive = inclusive;
+}
+
+bool RangeFilter::matches(VPackSlice const& value) const {
+  for (Bound const& bound : _bounds) {
+    int cmp = basics::VelocyPackHelper::compare(value, bound.value.slice(), true);
+    if (!bound.lower) {
+      cmp = -cmp;
+    }
+    if (cmp < 0 || (cmp == 0 && !bound.inclusive)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Index::Index(VPackSlice const& info,
              std::vector<std::vector<basics::AttributeName>> const& fields)
     : _variant(Variant::NONE) {
@@ -76,6 +98,15 @@ Index::Index(VPackSlice const& info,
         TRI_ERROR_BAD_PARAMETER,
         "geo index can only be created with one or two fields.");
   }
+
+  VPackSlice range = info.get("rangeField");
+  if (range.isString()) {
+    TRI_ParseAttributeString(StringRef(range), _rangeAttribute, false);
+    _rangeField.reserve(_rangeAttribute.size());
+    for (auto const& it : _rangeAttribute) {
+      _rangeField.emplace_back(it.name);
+    }
+  }
 }
 
 /// @brief Parse document and return cells for indexing
@@ -149,6 +180,12 @@ Result Index::shape(velocypack::Slice const& doc,
   return TRI_ERROR_INTERNAL;
 }
 
+VPackSlice Index::rangeValue(VPackSlice const& doc) const {
+  TRI_ASSERT(hasRangeField());
+  VPackSlice value = doc.get(_rangeField);
+  return value.isNone() ? VPackSlice::nullSlice() : value;
+}
+
 // Handle GEO_DISTANCE(<something>, doc.field)
 S2LatLng Index::parseGeoDistance(aql::AstNode const* args,
                                  aql::Variable const* ref) {
@@ -208,7 +245,14 @@ S2LatLng Index::parseDistFCall(aql::AstNode const* node,
 }
 
 void Index::handleNode(aql::AstNode const* node, aql::Variable const* ref,
-                       geo::QueryParams& qp) {
+                       geo::QueryParams& qp, RangeFilter* range) {
+  if (node->type != aql::NODE_TYPE_FCALL && node->numMembers() == 2 &&
+      node->getMemberUnchecked(0)->type != aql::NODE_TYPE_FCALL) {
+    // doc.rangeField [==|<|<=|>=|>] <value>
+    handleRangeNode(node, range);
+    return;
+  }
+
   switch (node->type) {
     // Handle GEO_CONTAINS(<geoJson-object>, doc.field)
     // or GEO_INTERSECTS(<geoJson-object>, doc.field)
@@ -289,15 +333,48 @@ void Index::handleNode(aql::AstNode const* node, aql::Variable const* ref,
   }
 }
 
+void Index::handleRangeNode(aql::AstNode const* node, RangeFilter* range) {
+  TRI_ASSERT(range != nullptr);
+  TRI_ASSERT(node->getMemberUnchecked(0)->isAttributeAccessForVariable());
+  if (range == nullptr) {
+    return;  // index does not store a range attribute
+  }
+
+  aql::AstNode const* value = node->getMemberUnchecked(1);
+  TRI_ASSERT(value->isConstant());
+  VPackBuilder bound;
+  value->toVelocyPackValue(bound);
+
+  switch (node->type) {
+    case aql::NODE_TYPE_OPERATOR_BINARY_EQ:
+      range->add(bound.slice(), /*lower*/ true, /*inclusive*/ true);
+      range->add(bound.slice(), /*lower*/ false, /*inclusive*/ true);
+      break;
+    case aql::NODE_TYPE_OPERATOR_BINARY_LT:
+    case aql::NODE_TYPE_OPERATOR_BINARY_LE:
+      range->add(bound.slice(), /*lower*/ false,
+                 node->type == aql::NODE_TYPE_OPERATOR_BINARY_LE);
+      break;
+    case aql::NODE_TYPE_OPERATOR_BINARY_GT:
+    case aql::NODE_TYPE_OPERATOR_BINARY_GE:
+      range->add(bound.slice(), /*lower*/ true,
+                 node->type == aql::NODE_TYPE_OPERATOR_BINARY_GE);
+      break;
+    default:
+      TRI_ASSERT(false);
+      break;
+  }
+}
+
 void Index::parseCondition(aql::AstNode const* node,
                            aql::Variable const* reference,
-                           geo::QueryParams& params) {
+                           geo::QueryParams& params, RangeFilter* range) {
   if (aql::Ast::IsAndOperatorType(node->type)) {
     for (size_t i = 0; i < node->numMembers(); i++) {
-      handleNode(node->getMemberUnchecked(i), reference, params);
+      handleNode(node->getMemberUnchecked(i), reference, params, range);
     }
   } else {
-    handleNode(node, reference, params);
+    handleNode(node, reference, params, range);
   }
 }
 
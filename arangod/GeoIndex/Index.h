@@ -26,6 +26,9 @@
 #include <s2/s2latlng.h>
 #include <s2/s2cell_id.h>
 
+#include <velocypack/Builder.h>
+
+#include "Basics/AttributeNameParser.h"
 #include "Basics/Result.h"
 #include "Geo/GeoParams.h"
 
@@ -34,13 +37,6 @@ namespace aql {
 struct AstNode;
 struct Variable;
 }  // namespace aql
-namespace basics {
-struct AttributeName;
-}
-namespace velocypack {
-class Slice;
-}
-
 namespace geo {
 struct Coordinate;
 struct QueryParams;
@@ -49,6 +45,27 @@ class ShapeContainer;
 
 namespace geo_index {
 
+/// @brief bounds on the range attribute stored with the index entries,
+/// values are compared the same way AQL compares them
+class RangeFilter {
+ public:
+  bool empty() const noexcept { return _bounds.empty(); }
+
+  /// @brief add a bound, lower bounds are `value >= bound`
+  void add(velocypack::Slice const& bound, bool lower, bool inclusive);
+
+  /// @brief whether the value satisfies all bounds
+  bool matches(velocypack::Slice const& value) const;
+
+ private:
+  struct Bound {
+    velocypack::Builder value;
+    bool lower;
+    bool inclusive;
+  };
+  std::vector<Bound> _bounds;
+};
+
 /// Mixin for geo indexes
 struct Index {
   /// @brief geo index variants
@@ -76,14 +93,26 @@ struct Index {
 
   Result shape(velocypack::Slice const& doc, geo::ShapeContainer& shape) const;
 
+  /// @brief value of the range attribute stored with every index entry,
+  /// null if the document does not have the attribute
+  velocypack::Slice rangeValue(velocypack::Slice const& doc) const;
+
   /// @brief Parse AQL condition into query parameters
   /// Public to allow usage by legacy geo indexes
   static void parseCondition(aql::AstNode const* node,
                              aql::Variable const* reference,
-                             geo::QueryParams& params);
+                             geo::QueryParams& params,
+                             RangeFilter* range = nullptr);
 
   Variant variant() const { return _variant; }
 
+  /// @brief whether a range attribute is stored with the index entries
+  bool hasRangeField() const { return !_rangeField.empty(); }
+
+  std::vector<basics::AttributeName> const& rangeAttribute() const {
+    return _rangeAttribute;
+  }
+
  private:
   static S2LatLng parseGeoDistance(aql::AstNode const* node,
                                    aql::Variable const* ref);
@@ -91,7 +120,8 @@ struct Index {
   static S2LatLng parseDistFCall(aql::AstNode const* node,
                                  aql::Variable const* ref);
   static void handleNode(aql::AstNode const* node, aql::Variable const* ref,
-                         geo::QueryParams& params);
+                         geo::QueryParams& params, RangeFilter* range);
+  static void handleRangeNode(aql::AstNode const* node, RangeFilter* range);
 
  protected:
   /// @brief immutable region coverer parameters
@@ -103,6 +133,10 @@ struct Index {
   std::vector<std::string> _location;
   std::vector<std::string> _latitude;
   std::vector<std::string> _longitude;
+
+  /// @brief optional attribute stored with every index entry
+  std::vector<basics::AttributeName> _rangeAttribute;
+  std::vector<std::string> _rangeField;
 };
 
 }  // namespace geo_index
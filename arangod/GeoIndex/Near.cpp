@@ -22,6 +22,10 @@
 
 #include "Near.h"
 
+#include <cmath>
+#include <list>
+#include <unordered_map>
+
 #include <s2/s2cell_union.h>
 #include <s2/s2latlng.h>
 #include <s2/s2metrics.h>
@@ -36,6 +40,8 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 #include "Geo/GeoParams.h"
 #include "Geo/GeoUtils.h"
 #include "Logger/Logger.h"
@@ -43,6 +49,108 @@
 namespace arangodb {
 namespace geo_index {
 
+namespace {
+
+/// Process-wide cache of initial search cap coverings. Queries around the
+/// same hotspots compute the same coverings over and over again, so the
+/// origin and radius are quantized and the resulting cells are reused.
+/// The cached covering is computed for a slightly enlarged cap around the
+/// quantized origin, hence it always contains the original search cap
+class CoveringCache {
+ public:
+  struct Key {
+    uint64_t cell;
+    int32_t radius;
+    int32_t maxCells;
+    int32_t minLevel;
+    int32_t maxLevel;
+
+    bool operator==(Key const& other) const noexcept {
+      return cell == other.cell && radius == other.radius &&
+             maxCells == other.maxCells && minLevel == other.minLevel &&
+             maxLevel == other.maxLevel;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(Key const& key) const noexcept {
+      size_t h = std::hash<uint64_t>()(key.cell);
+      h ^= std::hash<int64_t>()((int64_t(key.radius) << 32) ^ key.maxCells) +
+           0x9e3779b9 + (h << 6) + (h >> 2);
+      h ^= std::hash<int64_t>()((int64_t(key.minLevel) << 32) ^ key.maxLevel) +
+           0x9e3779b9 + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+
+  static constexpr size_t kMaxEntries = 4096;
+
+  bool lookup(Key const& key, std::vector<S2CellId>& cover) {
+    MUTEX_LOCKER(guard, _lock);
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+      return false;
+    }
+    _lru.splice(_lru.begin(), _lru, it->second);  // mark as recently used
+    cover = it->second->second;
+    return true;
+  }
+
+  void insert(Key const& key, std::vector<S2CellId> const& cover) {
+    MUTEX_LOCKER(guard, _lock);
+    if (_entries.find(key) != _entries.end()) {
+      return;  // inserted concurrently
+    }
+    if (_entries.size() >= kMaxEntries) {
+      _entries.erase(_lru.back().first);
+      _lru.pop_back();
+    }
+    _lru.emplace_front(key, cover);
+    _entries.emplace(key, _lru.begin());
+  }
+
+ private:
+  typedef std::list<std::pair<Key, std::vector<S2CellId>>> List;
+
+  Mutex _lock;
+  List _lru;
+  std::unordered_map<Key, List::iterator, KeyHash> _entries;
+};
+
+CoveringCache coveringCache;
+
+/// Fast covering of the cap with the given radius around origin,
+/// the returned cells may cover a slightly larger area
+void cachedCapCovering(S2RegionCoverer& coverer, S2Point const& origin,
+                       S1ChordAngle radius, std::vector<S2CellId>* cover) {
+  double const rad = radius.radians();
+  if (rad <= 0.0) {
+    coverer.GetFastCovering(S2Cap(origin, radius), cover);
+    return;
+  }
+  // round the radius up in steps of 1/8 of a binary order of magnitude
+  int32_t const bucket = static_cast<int32_t>(std::ceil(std::log2(rad) * 8.0));
+  double const qrad = std::exp2(bucket / 8.0);
+  // snap the origin to a cell much smaller than the search radius
+  int const level = std::min(S2::kMaxDiag.GetLevelForMaxValue(qrad / 16.0),
+                             S2::kMaxCellLevel);
+  S2CellId const cell = S2CellId(origin).parent(level);
+
+  S2RegionCoverer::Options const& opts = coverer.options();
+  CoveringCache::Key const key{cell.id(), bucket, opts.max_cells(),
+                               opts.min_level(), opts.max_level()};
+  if (coveringCache.lookup(key, *cover)) {
+    return;
+  }
+  // every point within rad of origin is within qrad + diag of the cell center
+  double const enlarged = std::min(qrad + S2::kMaxDiag.GetValue(level), M_PI);
+  coverer.GetFastCovering(S2Cap(cell.ToPoint(), S1ChordAngle::Radians(enlarged)),
+                          cover);
+  coveringCache.insert(key, *cover);
+}
+
+}  // namespace
+
 template <typename CMP>
 NearUtils<CMP>::NearUtils(geo::QueryParams&& qp) noexcept
     : _params(std::move(qp)),
@@ -179,8 +287,9 @@ std::vector<geo::Interval> NearUtils<CMP>::intervals() {
     // LOG_TOPIC(INFO, Logger::FIXME) << "[Scan] 0 to something";
     S2Cap ob = S2Cap(_origin, _outerAngle);
     //_coverer.GetCovering(ob, &cover);
-    if (_scannedCells.empty() == 0) {
-      _coverer.GetFastCovering(ob, &cover);
+    if (_scannedCells.empty()) {
+      // initial scan, likely to repeat for queries around the same spot
+      cachedCapCovering(_coverer, _origin, _outerAngle, &cover);
     } else {
       std::vector<S2CellId> tmpCover;
       _coverer.GetFastCovering(ob, &tmpCover);
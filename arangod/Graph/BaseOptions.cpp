@@ -29,12 +29,16 @@
 #include "Aql/Expression.h"
 #include "Aql/IndexNode.h"
 #include "Aql/Query.h"
+#include "Basics/StaticStrings.h"
+#include "Graph/EdgeSnapshot.h"
 #include "Graph/ShortestPathOptions.h"
 #include "Graph/SingleServerEdgeCursor.h"
+#include "Graph/SnapshotEdgeCursor.h"
 #include "Graph/TraverserCache.h"
 #include "Graph/TraverserCacheFactory.h"
 #include "Graph/TraverserOptions.h"
 #include "Indexes/Index.h"
+#include "StorageEngine/TransactionState.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
@@ -403,6 +407,12 @@ EdgeCursor* BaseOptions::nextCursorLocal(ManagedDocumentResult* mmdr,
                                          StringRef vid,
                                          std::vector<LookupInfo>& list) {
   TRI_ASSERT(mmdr != nullptr);
+  if (EdgeSnapshotCache::instance()->memoryLimit() > 0) {
+    auto snapshots = edgeSnapshots(list);
+    if (!snapshots.empty()) {
+      return new SnapshotEdgeCursor(std::move(snapshots), vid);
+    }
+  }
   auto allCursor =
       std::make_unique<SingleServerEdgeCursor>(this, list.size());
   auto& opCursors = allCursor->getCursors();
@@ -433,6 +443,53 @@ EdgeCursor* BaseOptions::nextCursorLocal(ManagedDocumentResult* mmdr,
   return allCursor.release();
 }
 
+std::vector<std::shared_ptr<EdgeSnapshot const>> BaseOptions::edgeSnapshots(
+    std::vector<LookupInfo> const& list) const {
+  std::vector<std::shared_ptr<EdgeSnapshot const>> snapshots;
+#ifdef USE_ENTERPRISE
+  if (_trx->state()->options().skipInaccessibleCollections) {
+    // snapshots do not check the collections of the vertices
+    return snapshots;
+  }
+#endif
+  bool complete = true;
+  snapshots.reserve(list.size());
+  for (auto const& info : list) {
+    // only plain lookups of _from or _to in an edge index. all snapshots
+    // are looked up, so that missing ones are built
+    auto node = info.indexCondition;
+    if (!info.conditionNeedUpdate || node->numMembers() != 1 ||
+        info.idxHandles.size() != 1) {
+      complete = false;
+      continue;
+    }
+    auto idx = info.idxHandles[0].getIndex();
+    auto attr = node->getMemberUnchecked(info.conditionMemberToUpdate)
+                    ->getMemberUnchecked(0);
+    if (idx->type() != Index::TRI_IDX_TYPE_EDGE_INDEX ||
+        attr->type != aql::NODE_TYPE_ATTRIBUTE_ACCESS) {
+      complete = false;
+      continue;
+    }
+    bool isFrom = attr->stringEquals(StaticStrings::FromString);
+    if (!isFrom && !attr->stringEquals(StaticStrings::ToString)) {
+      complete = false;
+      continue;
+    }
+    auto snapshot = EdgeSnapshotCache::instance()->lookup(
+        _trx, idx->collection(), isFrom);
+    if (snapshot == nullptr) {
+      complete = false;
+      continue;
+    }
+    snapshots.emplace_back(std::move(snapshot));
+  }
+  if (!complete) {
+    snapshots.clear();
+  }
+  return snapshots;
+}
+
 TraverserCache* BaseOptions::cache() {
   if (_cache == nullptr) {
     // If the Coordinator does NOT activate the Cache
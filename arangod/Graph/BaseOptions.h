@@ -48,6 +48,7 @@ class Slice;
 namespace graph {
 
 class EdgeCursor;
+class EdgeSnapshot;
 class TraverserCache;
 
 struct BaseOptions {
@@ -156,6 +157,11 @@ struct BaseOptions {
   EdgeCursor* nextCursorLocal(ManagedDocumentResult*, StringRef vid,
                               std::vector<LookupInfo>&);
 
+  /// @brief the edge snapshots for all lookups of the list, in the same
+  /// order. empty if any of the lookups cannot be answered by a snapshot
+  std::vector<std::shared_ptr<EdgeSnapshot const>> edgeSnapshots(
+      std::vector<LookupInfo> const&) const;
+
  protected:
   aql::Query* _query;
   
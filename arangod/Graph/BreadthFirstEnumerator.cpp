@@ -36,6 +36,12 @@ using namespace arangodb;
 using namespace arangodb::graph;
 using namespace arangodb::traverser;
 
+namespace {
+/// @brief number of vertices of a depth whose edges are fetched from the
+/// DBServers in one request
+size_t const prefetchBatchSize = 1000;
+}
+
 BreadthFirstEnumerator::PathStep::PathStep(StringRef const vertex)
     : sourceIdx(0), edge(EdgeDocumentToken()), vertex(vertex) {}
 
@@ -58,7 +64,8 @@ BreadthFirstEnumerator::BreadthFirstEnumerator(Traverser* traverser,
       _schreierIndex(1),
       _lastReturned(0),
       _currentDepth(0),
-      _toSearchPos(0) {
+      _toSearchPos(0),
+      _prefetchedPos(0) {
   _schreier.reserve(32);
   StringRef startVId = _opts->cache()->persistString(StringRef(startVertex));
 
@@ -107,6 +114,7 @@ bool BreadthFirstEnumerator::next() {
       // and next is empty.
       _toSearch.clear();
       _toSearchPos = 0;
+      _prefetchedPos = 0;
       _toSearch.swap(_nextDepth);
       _currentDepth++;
       TRI_ASSERT(_toSearchPos < _toSearch.size());
@@ -117,6 +125,20 @@ bool BreadthFirstEnumerator::next() {
     // If not it should have bailed out before.
     TRI_ASSERT(_toSearchPos < _toSearch.size());
 
+    if (_toSearchPos >= _prefetchedPos) {
+      // in a cluster the edges of the next vertices of this depth are
+      // fetched in one round trip instead of one per vertex
+      size_t const end =
+          (std::min)(_toSearch.size(), _toSearchPos + prefetchBatchSize);
+      std::vector<StringRef> vertices;
+      vertices.reserve(end - _toSearchPos);
+      for (size_t i = _toSearchPos; i < end; ++i) {
+        vertices.emplace_back(_schreier[_toSearch[i].sourceIdx]->vertex);
+      }
+      _opts->prefetchEdges(vertices, _currentDepth);
+      _prefetchedPos = end;
+    }
+
     _tmpEdges.clear();
     auto const nextIdx = _toSearch[_toSearchPos++].sourceIdx;
     auto const nextVertex = _schreier[nextIdx]->vertex;
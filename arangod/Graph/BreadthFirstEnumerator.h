@@ -123,6 +123,13 @@ class BreadthFirstEnumerator final
 
   size_t _toSearchPos;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief position in _toSearch up to which the edges have been fetched
+  ///        ahead (cluster only)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _prefetchedPos;
+
  public:
   BreadthFirstEnumerator(arangodb::traverser::Traverser* traverser,
                          arangodb::velocypack::Slice startVertex,
@@ -26,9 +26,12 @@
 #include "Aql/Query.h"
 #include "Basics/StringRef.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
 #include "Graph/EdgeDocumentToken.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
+#include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
@@ -41,7 +44,10 @@ using namespace arangodb::graph;
 ClusterTraverserCache::ClusterTraverserCache(
     aql::Query* query,
     std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines)
-    : TraverserCache(query), _engines(engines) {}
+    : TraverserCache(query),
+      _engines(engines),
+      _prefetchedDepth(0),
+      _canPrefetch(true) {}
 
 VPackSlice ClusterTraverserCache::lookupToken(EdgeDocumentToken const& token) {
   return VPackSlice(token.vpack());
@@ -92,3 +98,45 @@ void ClusterTraverserCache::insertVertexIntoResult(StringRef id,
     result.add(it->second);
   }
 }
+
+void ClusterTraverserCache::prefetchEdges(
+    std::vector<StringRef> const& vertexIds, uint64_t depth,
+    std::unordered_map<StringRef, std::shared_ptr<VPackBuffer<uint8_t>>>*
+        vertices) {
+  TRI_ASSERT(ServerState::instance()->isCoordinator());
+  _prefetched.clear();
+  if (!_canPrefetch || vertexIds.size() < 2) {
+    return;
+  }
+
+  transaction::BuilderLeaser leased(_trx);
+  int res = fetchEdgesFromEngines(_trx->vocbase().name(), _engines, vertexIds,
+                                  depth, _cache, _prefetched, vertices,
+                                  _datalake, *(leased.get()),
+                                  _filteredDocuments, _insertedDocuments);
+  if (res != TRI_ERROR_NO_ERROR) {
+    // edges are fetched per vertex instead, which reports the error
+    // if there is one
+    _prefetched.clear();
+    if (res == TRI_ERROR_NOT_IMPLEMENTED) {
+      _canPrefetch = false;
+    }
+    return;
+  }
+  _prefetchedDepth = depth;
+}
+
+bool ClusterTraverserCache::takePrefetchedEdges(StringRef vertexId,
+                                                uint64_t depth,
+                                                std::vector<VPackSlice>& result) {
+  if (depth != _prefetchedDepth) {
+    return false;
+  }
+  auto it = _prefetched.find(vertexId);
+  if (it == _prefetched.end()) {
+    return false;
+  }
+  result.swap(it->second);
+  _prefetched.erase(it);
+  return true;
+}
@@ -98,6 +98,21 @@ class ClusterTraverserCache : public TraverserCache {
   size_t& filteredDocuments() {
     return _filteredDocuments;
   }
+
+  /// @brief fetch the edges of vertices of a traversal depth in one batch,
+  /// later lookups of these vertices are served by takePrefetchedEdges.
+  /// if vertices is given, the documents of the vertices the edges lead to
+  /// are fetched along as far as the DBServers of the edges store them
+  void prefetchEdges(
+      std::vector<StringRef> const& vertexIds, uint64_t depth,
+      std::unordered_map<StringRef,
+                         std::shared_ptr<arangodb::velocypack::Buffer<uint8_t>>>*
+          vertices);
+
+  /// @brief the edges of a vertex fetched by prefetchEdges, false if they
+  /// were not fetched ahead
+  bool takePrefetchedEdges(StringRef vertexId, uint64_t depth,
+                           std::vector<arangodb::velocypack::Slice>& result);
   
  private:
 
@@ -106,6 +121,11 @@ class ClusterTraverserCache : public TraverserCache {
   /// @brief dump for our edge and vertex documents
   std::vector<std::shared_ptr<arangodb::velocypack::Builder>> _datalake;
   std::unordered_map<ServerID, traverser::TraverserEngineID> const* _engines;
+  /// @brief edges of the vertices fetched ahead, all of depth _prefetchedDepth
+  std::unordered_map<StringRef, std::vector<arangodb::velocypack::Slice>> _prefetched;
+  uint64_t _prefetchedDepth;
+  /// @brief the DBServers support fetching edges in batches
+  bool _canPrefetch;
 };
 
 }  // namespace graph
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "EdgeSnapshot.h"
+
+#include "Basics/MutexLocker.h"
+#include "Logger/Logger.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "Transaction/Helpers.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/DatabaseGuard.h"
+#include "Utils/OperationCursor.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::graph;
+
+EdgeSnapshot::EdgeSnapshot(TRI_voc_cid_t cid, TRI_voc_rid_t revision,
+                           bool isFrom)
+    : _cid(cid), _revision(revision), _isFrom(isFrom) {}
+
+std::unique_ptr<EdgeSnapshot> EdgeSnapshot::build(transaction::Methods* trx,
+                                                  LogicalCollection* collection,
+                                                  bool isFrom) {
+  std::unique_ptr<EdgeSnapshot> snapshot(
+      new EdgeSnapshot(collection->id(), collection->revision(trx), isFrom));
+
+  struct Entry {
+    size_t vertex;
+    size_t target;
+    LocalDocumentId id;
+  };
+  std::vector<Entry> entries;
+  std::unordered_map<std::string, size_t> offsets;
+
+  auto intern = [&](VPackSlice id) -> size_t {
+    TRI_ASSERT(id.isString());
+    auto it = offsets.emplace(id.copyString(), snapshot->_strings.size());
+    if (it.second) {
+      snapshot->_strings.insert(snapshot->_strings.end(), id.begin(),
+                                id.begin() + id.byteSize());
+    }
+    return it.first->second;
+  };
+
+  auto cursor = trx->indexScan(collection->name(),
+                               transaction::Methods::CursorType::ALL);
+  cursor->allDocuments([&](LocalDocumentId const& token, VPackSlice doc) {
+    VPackSlice from = transaction::helpers::extractFromFromDocument(doc);
+    VPackSlice to = transaction::helpers::extractToFromDocument(doc);
+    size_t const vertex = intern(isFrom ? from : to);
+    size_t const target = intern(isFrom ? to : from);
+    entries.emplace_back(Entry{vertex, target, token});
+  }, 1000);
+
+  EdgeSnapshot const* s = snapshot.get();
+  std::sort(entries.begin(), entries.end(),
+            [s](Entry const& lhs, Entry const& rhs) {
+              if (lhs.vertex == rhs.vertex) {
+                return false;
+              }
+              return StringRef(s->string(lhs.vertex))
+                         .compare(StringRef(s->string(rhs.vertex))) < 0;
+            });
+
+  snapshot->_edges.reserve(entries.size());
+  snapshot->_targets.reserve(entries.size());
+  for (auto const& it : entries) {
+    if (snapshot->_vertices.empty() || snapshot->_vertices.back() != it.vertex) {
+      snapshot->_vertices.emplace_back(it.vertex);
+      snapshot->_rows.emplace_back(snapshot->_edges.size());
+    }
+    snapshot->_edges.emplace_back(it.id);
+    snapshot->_targets.emplace_back(it.target);
+  }
+  snapshot->_rows.emplace_back(snapshot->_edges.size());
+
+  snapshot->_strings.shrink_to_fit();
+  snapshot->_vertices.shrink_to_fit();
+  snapshot->_rows.shrink_to_fit();
+  return snapshot;
+}
+
+size_t EdgeSnapshot::memoryUsage() const {
+  return sizeof(EdgeSnapshot) + _strings.capacity() +
+         (_vertices.capacity() + _rows.capacity() + _targets.capacity()) *
+             sizeof(size_t) +
+         _edges.capacity() * sizeof(LocalDocumentId);
+}
+
+void EdgeSnapshot::edges(StringRef vertex, EdgeCallback const& callback) const {
+  auto it = std::lower_bound(_vertices.begin(), _vertices.end(), vertex,
+                             [this](size_t offset, StringRef const& value) {
+                               return StringRef(string(offset)).compare(value) < 0;
+                             });
+  if (it == _vertices.end() || StringRef(string(*it)) != vertex) {
+    return;
+  }
+  size_t const row = static_cast<size_t>(it - _vertices.begin());
+  for (size_t i = _rows[row]; i < _rows[row + 1]; ++i) {
+    callback(_edges[i], string(_targets[i]));
+  }
+}
+
+/// @brief singleton instance of the edge snapshot cache
+static EdgeSnapshotCache Instance;
+
+EdgeSnapshotCache::EdgeSnapshotCache()
+    : _memoryUsage(0), _uses(0), _memoryLimit(0) {}
+
+EdgeSnapshotCache::~EdgeSnapshotCache() {}
+
+std::shared_ptr<EdgeSnapshot const> EdgeSnapshotCache::lookup(
+    transaction::Methods* trx, LogicalCollection* collection, bool isFrom) {
+  if (memoryLimit() == 0) {
+    return nullptr;
+  }
+
+  TRI_voc_rid_t const revision = collection->revision(trx);
+  Key key(collection->vocbase().id(), collection->id(), isFrom);
+
+  MUTEX_LOCKER(locker, _lock);
+  Entry& entry = _entries[key];
+  entry._lastUse = ++_uses;
+  if (entry._snapshot != nullptr && entry._snapshot->revision() == revision) {
+    return entry._snapshot;
+  }
+  if (entry._building || entry._built == revision ||
+      SchedulerFeature::SCHEDULER == nullptr) {
+    return nullptr;
+  }
+
+  entry._building = true;
+  bool queued = SchedulerFeature::SCHEDULER->queue(
+      RequestPriority::LOW, [this, key]() { build(key); });
+  if (!queued) {
+    entry._building = false;
+  }
+  return nullptr;
+}
+
+void EdgeSnapshotCache::build(Key const& key) {
+  std::unique_ptr<EdgeSnapshot> snapshot;
+  try {
+    DatabaseGuard guard(std::get<0>(key));
+    auto collection = guard.database().lookupCollection(std::get<1>(key));
+    if (collection != nullptr) {
+      SingleCollectionTransaction trx(
+          transaction::StandaloneContext::Create(guard.database()),
+          *collection, AccessMode::Type::READ);
+      Result res = trx.begin();
+      if (res.ok()) {
+        snapshot = EdgeSnapshot::build(&trx, collection.get(), std::get<2>(key));
+        trx.finish(res);
+      }
+    }
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(DEBUG, Logger::GRAPHS)
+        << "unable to build edge snapshot: " << ex.what();
+  }
+
+  MUTEX_LOCKER(locker, _lock);
+  auto it = _entries.find(key);
+  if (it == _entries.end()) {
+    // the cache was cleared in the meantime
+    return;
+  }
+  Entry& entry = it->second;
+  entry._building = false;
+  if (snapshot == nullptr) {
+    return;
+  }
+  entry._built = snapshot->revision();
+
+  if (entry._snapshot != nullptr) {
+    _memoryUsage -= entry._snapshot->memoryUsage();
+    entry._snapshot.reset();
+  }
+
+  size_t const limit = memoryLimit();
+  size_t const needed = snapshot->memoryUsage();
+  if (needed > limit) {
+    LOG_TOPIC(DEBUG, Logger::GRAPHS)
+        << "edge snapshot of collection " << std::get<1>(key) << " needs "
+        << needed << " bytes, which exceeds the memory limit";
+    return;
+  }
+  evict(limit - needed);
+
+  entry._snapshot = std::move(snapshot);
+  _memoryUsage += needed;
+}
+
+void EdgeSnapshotCache::evict(size_t target) {
+  while (_memoryUsage > target) {
+    Entry* oldest = nullptr;
+    for (auto& it : _entries) {
+      if (it.second._snapshot != nullptr &&
+          (oldest == nullptr || it.second._lastUse < oldest->_lastUse)) {
+        oldest = &it.second;
+      }
+    }
+    if (oldest == nullptr) {
+      break;
+    }
+    _memoryUsage -= oldest->_snapshot->memoryUsage();
+    oldest->_snapshot.reset();
+  }
+}
+
+void EdgeSnapshotCache::clear() {
+  MUTEX_LOCKER(locker, _lock);
+  _entries.clear();
+  _memoryUsage = 0;
+}
+
+size_t EdgeSnapshotCache::memoryUsage() const {
+  MUTEX_LOCKER(locker, _lock);
+  return _memoryUsage;
+}
+
+void EdgeSnapshotCache::memoryLimit(size_t value) {
+  _memoryLimit.store(value, std::memory_order_relaxed);
+  MUTEX_LOCKER(locker, _lock);
+  evict(value);
+}
+
+/// @brief get the edge snapshot cache instance
+EdgeSnapshotCache* EdgeSnapshotCache::instance() { return &Instance; }
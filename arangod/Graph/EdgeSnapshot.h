@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GRAPH_EDGE_SNAPSHOT_H
+#define ARANGOD_GRAPH_EDGE_SNAPSHOT_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Basics/StringRef.h"
+#include "VocBase/LocalDocumentId.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+class LogicalCollection;
+
+namespace transaction {
+class Methods;
+}
+
+namespace graph {
+
+/// @brief immutable adjacency of one edge collection in one direction, in
+/// compressed sparse row layout. it reflects the documents of a single
+/// revision of the collection
+class EdgeSnapshot {
+ public:
+  typedef std::function<void(LocalDocumentId const&, arangodb::velocypack::Slice)>
+      EdgeCallback;
+
+  EdgeSnapshot(EdgeSnapshot const&) = delete;
+  EdgeSnapshot& operator=(EdgeSnapshot const&) = delete;
+
+  /// @brief build the snapshot from the documents of the collection visible
+  /// to the transaction. isFrom selects the edges by _from, otherwise by _to
+  static std::unique_ptr<EdgeSnapshot> build(transaction::Methods* trx,
+                                             LogicalCollection* collection,
+                                             bool isFrom);
+
+  TRI_voc_cid_t cid() const { return _cid; }
+  TRI_voc_rid_t revision() const { return _revision; }
+  bool isFrom() const { return _isFrom; }
+
+  size_t numberEdges() const { return _edges.size(); }
+
+  /// @brief the memory used by the snapshot in bytes
+  size_t memoryUsage() const;
+
+  /// @brief call the callback for all edges of the vertex, with the id of
+  /// the other vertex of the edge as velocypack string
+  void edges(arangodb::StringRef vertex, EdgeCallback const& callback) const;
+
+ private:
+  EdgeSnapshot(TRI_voc_cid_t cid, TRI_voc_rid_t revision, bool isFrom);
+
+  arangodb::velocypack::Slice string(size_t offset) const {
+    return arangodb::velocypack::Slice(_strings.data() + offset);
+  }
+
+ private:
+  TRI_voc_cid_t const _cid;
+  TRI_voc_rid_t const _revision;
+  bool const _isFrom;
+
+  /// @brief the vertex ids as velocypack strings, each stored once
+  std::vector<uint8_t> _strings;
+
+  /// @brief offsets in _strings of the vertices with edges, sorted by id
+  std::vector<size_t> _vertices;
+
+  /// @brief the edges of _vertices[i] are at positions _rows[i] up to
+  /// _rows[i + 1] of _edges and _targets
+  std::vector<size_t> _rows;
+
+  std::vector<LocalDocumentId> _edges;
+
+  /// @brief offsets in _strings of the other vertex of each edge
+  std::vector<size_t> _targets;
+};
+
+/// @brief global cache of edge snapshots. snapshots are built in the
+/// background on first use and replaced once the collection has changed.
+/// the memory of all snapshots is limited, the least recently used ones
+/// are dropped first. a limit of 0 turns the cache off
+class EdgeSnapshotCache {
+ public:
+  EdgeSnapshotCache(EdgeSnapshotCache const&) = delete;
+  EdgeSnapshotCache& operator=(EdgeSnapshotCache const&) = delete;
+
+  EdgeSnapshotCache();
+  ~EdgeSnapshotCache();
+
+  /// @brief the snapshot of the edges of the collection for the revision
+  /// visible to the transaction. returns a nullptr if there is none yet,
+  /// and schedules building it
+  std::shared_ptr<EdgeSnapshot const> lookup(transaction::Methods* trx,
+                                             LogicalCollection* collection,
+                                             bool isFrom);
+
+  /// @brief drop all snapshots
+  void clear();
+
+  /// @brief memory used by all snapshots in bytes
+  size_t memoryUsage() const;
+
+  /// @brief the maximum memory used by all snapshots in bytes
+  size_t memoryLimit() const {
+    return _memoryLimit.load(std::memory_order_relaxed);
+  }
+
+  /// @brief set the maximum memory used by all snapshots
+  void memoryLimit(size_t value);
+
+  /// @brief get the pointer to the global edge snapshot cache
+  static EdgeSnapshotCache* instance();
+
+ private:
+  /// @brief database, collection, direction
+  typedef std::tuple<TRI_voc_tick_t, TRI_voc_cid_t, bool> Key;
+
+  struct Entry {
+    std::shared_ptr<EdgeSnapshot const> _snapshot;
+    /// @brief revision of the latest build, which is not retried
+    TRI_voc_rid_t _built = 0;
+    bool _building = false;
+    uint64_t _lastUse = 0;
+  };
+
+  /// @brief build the snapshot of an entry, runs in the scheduler
+  void build(Key const& key);
+
+  /// @brief drop the least recently used snapshots until at most target
+  /// bytes are used. must be called with _lock held
+  void evict(size_t target);
+
+ private:
+  mutable Mutex _lock;
+
+  std::map<Key, Entry> _entries;
+
+  /// @brief memory used by all snapshots, protected by _lock
+  size_t _memoryUsage;
+
+  /// @brief counter for the least recently used order, protected by _lock
+  uint64_t _uses;
+
+  std::atomic<size_t> _memoryLimit;
+};
+
+}  // namespace graph
+}  // namespace arangodb
+
+#endif
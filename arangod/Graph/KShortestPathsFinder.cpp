@@ -0,0 +1,333 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KShortestPathsFinder.h"
+
+#include "Basics/StringRef.h"
+#include "Graph/EdgeCursor.h"
+#include "Graph/ShortestPathOptions.h"
+#include "Graph/ShortestPathResult.h"
+#include "Graph/TraverserCache.h"
+#include "Transaction/Helpers.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <queue>
+
+using namespace arangodb;
+using namespace arangodb::graph;
+
+void KShortestPathsFinder::Path::clear() {
+  _vertices.clear();
+  _edges.clear();
+  _weights.clear();
+  _weight = 0.0;
+}
+
+/// @brief append the part of other from vertex position from to vertex
+/// position to. the vertex at from is left out if this path already ends
+/// with it
+void KShortestPathsFinder::Path::append(Path const& other, size_t from,
+                                        size_t to) {
+  TRI_ASSERT(from <= to && to < other._vertices.size());
+  if (_vertices.empty()) {
+    _vertices.emplace_back(other._vertices[from]);
+  }
+  TRI_ASSERT(_vertices.back() == other._vertices[from]);
+  for (size_t i = from; i < to; ++i) {
+    _edges.emplace_back(other._edges[i]);
+    _weights.emplace_back(other._weights[i]);
+    _vertices.emplace_back(other._vertices[i + 1]);
+    _weight += other._weights[i];
+  }
+}
+
+bool KShortestPathsFinder::Path::equals(Path const& other) const {
+  if (_vertices.size() != other._vertices.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < _vertices.size(); ++i) {
+    if (_vertices[i] != other._vertices[i]) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < _edges.size(); ++i) {
+    if (!_edges[i].equals(other._edges[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+KShortestPathsFinder::KShortestPathsFinder(ShortestPathOptions* options)
+    : _exhausted(true), _options(options), _mmdr(new ManagedDocumentResult{}) {}
+
+KShortestPathsFinder::~KShortestPathsFinder() {}
+
+bool KShortestPathsFinder::shortestPath(VPackSlice const& start,
+                                        VPackSlice const& target,
+                                        ShortestPathResult& result,
+                                        std::function<void()> const& callback) {
+  startKShortestPathsTraversal(start, target);
+  return getNextPath(result, callback);
+}
+
+void KShortestPathsFinder::startKShortestPathsTraversal(
+    VPackSlice const& start, VPackSlice const& target) {
+  TRI_ASSERT(start.isString());
+  TRI_ASSERT(target.isString());
+  _start = _options->cache()->persistString(StringRef(start));
+  _target = _options->cache()->persistString(StringRef(target));
+  _paths.clear();
+  _candidates.clear();
+  _exhausted = false;
+}
+
+bool KShortestPathsFinder::getNextPath(ShortestPathResult& result,
+                                       std::function<void()> const& callback) {
+  result.clear();
+  if (_exhausted) {
+    return false;
+  }
+
+  if (_paths.empty()) {
+    Path path;
+    if (!computeShortestPath(_start, {}, {}, path, callback)) {
+      _exhausted = true;
+      return false;
+    }
+    _paths.emplace_back(std::move(path));
+  } else {
+    computeCandidates(callback);
+    if (_candidates.empty()) {
+      _exhausted = true;
+      return false;
+    }
+    auto best = std::min_element(
+        _candidates.begin(), _candidates.end(),
+        [](Path const& lhs, Path const& rhs) { return lhs._weight < rhs._weight; });
+    _paths.emplace_back(std::move(*best));
+    _candidates.erase(best);
+  }
+
+  TRI_IF_FAILURE("TraversalOOMPath") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  fillResult(_paths.back(), result);
+  return true;
+}
+
+void KShortestPathsFinder::computeCandidates(
+    std::function<void()> const& callback) {
+  TRI_ASSERT(!_paths.empty());
+  Path const& last = _paths.back();
+
+  // every vertex of the last path but the target is a spur vertex: the
+  // candidate shares the path up to it (the root) and deviates from all
+  // paths found so far which share the same root
+  std::unordered_set<StringRef> blockedVertices;
+  std::vector<EdgeDocumentToken> blockedEdges;
+  Path spur;
+  for (size_t i = 0; i + 1 < last._vertices.size(); ++i) {
+    callback();
+
+    blockedEdges.clear();
+    for (auto const& path : _paths) {
+      if (path._vertices.size() <= i + 1) {
+        continue;
+      }
+      bool sameRoot = true;
+      for (size_t j = 0; j <= i && sameRoot; ++j) {
+        sameRoot = path._vertices[j] == last._vertices[j] &&
+                   (j == 0 || path._edges[j - 1].equals(last._edges[j - 1]));
+      }
+      if (sameRoot) {
+        blockedEdges.emplace_back(path._edges[i]);
+      }
+    }
+
+    if (i > 0) {
+      // the root must not be visited again
+      blockedVertices.emplace(last._vertices[i - 1]);
+    }
+
+    if (!computeShortestPath(last._vertices[i], blockedVertices, blockedEdges,
+                             spur, callback)) {
+      continue;
+    }
+
+    Path candidate;
+    candidate.append(last, 0, i);
+    candidate.append(spur, 0, spur._edges.size());
+
+    bool known = false;
+    for (auto const& path : _candidates) {
+      if (path.equals(candidate)) {
+        known = true;
+        break;
+      }
+    }
+    if (!known) {
+      _candidates.emplace_back(std::move(candidate));
+    }
+  }
+}
+
+bool KShortestPathsFinder::computeShortestPath(
+    StringRef start, std::unordered_set<StringRef> const& blockedVertices,
+    std::vector<EdgeDocumentToken> const& blockedEdges, Path& result,
+    std::function<void()> const& callback) {
+  typedef std::pair<double, StringRef> QueueEntry;
+  auto cmp = [](QueueEntry const& lhs, QueueEntry const& rhs) {
+    return lhs.first > rhs.first;
+  };
+
+  result.clear();
+
+  // queue entries of vertices whose distance decreased later on are left in
+  // the queue and skipped when they come up
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, decltype(cmp)> queue(cmp);
+  std::unordered_map<StringRef, Step> steps;
+
+  steps.emplace(start, Step{StringRef(), EdgeDocumentToken(), 0.0, 0.0, false});
+  queue.emplace(0.0, start);
+
+  while (!queue.empty()) {
+    QueueEntry const top = queue.top();
+    queue.pop();
+
+    Step& step = steps.find(top.second)->second;
+    if (step._done) {
+      continue;
+    }
+    step._done = true;
+
+    if (top.second == _target) {
+      // walk back to the start
+      std::vector<StringRef> vertices;
+      StringRef v = top.second;
+      while (v != start) {
+        vertices.emplace_back(v);
+        v = steps.find(v)->second._pred;
+      }
+      result._vertices.emplace_back(start);
+      for (auto it = vertices.rbegin(); it != vertices.rend(); ++it) {
+        Step const& s = steps.find(*it)->second;
+        result._vertices.emplace_back(*it);
+        result._edges.emplace_back(s._edge);
+        result._weights.emplace_back(s._weight);
+      }
+      result._weight = top.first;
+      return true;
+    }
+
+    callback();
+
+    expandVertex(top.second);
+    size_t const neighborsSize = _neighbors.size();
+    TRI_ASSERT(_edges.size() == neighborsSize);
+    TRI_ASSERT(_weights.size() == neighborsSize);
+
+    for (size_t i = 0; i < neighborsSize; ++i) {
+      StringRef const& n = _neighbors[i];
+      if (blockedVertices.find(n) != blockedVertices.end()) {
+        continue;
+      }
+      bool blocked = false;
+      for (auto const& e : blockedEdges) {
+        if (e.equals(_edges[i])) {
+          blocked = true;
+          break;
+        }
+      }
+      if (blocked) {
+        continue;
+      }
+
+      double const distance = top.first + _weights[i];
+      auto it = steps.find(n);
+      if (it == steps.end()) {
+        steps.emplace(n, Step{top.second, std::move(_edges[i]), _weights[i],
+                              distance, false});
+        queue.emplace(distance, n);
+      } else if (!it->second._done && distance < it->second._distance) {
+        it->second._pred = top.second;
+        it->second._edge = std::move(_edges[i]);
+        it->second._weight = _weights[i];
+        it->second._distance = distance;
+        queue.emplace(distance, n);
+      }
+    }
+  }
+  return false;
+}
+
+void KShortestPathsFinder::expandVertex(StringRef vertex) {
+  _neighbors.clear();
+  _edges.clear();
+  _weights.clear();
+
+  std::unique_ptr<EdgeCursor> edgeCursor(
+      _options->nextCursor(_mmdr.get(), vertex));
+
+  auto callback = [&](EdgeDocumentToken&& eid, VPackSlice edge,
+                      size_t cursorIdx) -> void {
+    StringRef other;
+    double weight = 1.0;
+    if (edge.isString()) {
+      if (edge.compareString(vertex.data(), vertex.length()) == 0) {
+        return;
+      }
+      other = StringRef(edge);
+      if (_options->useWeight()) {
+        weight = _options->weightEdge(_options->cache()->lookupToken(eid));
+      }
+    } else {
+      other = StringRef(transaction::helpers::extractFromFromDocument(edge));
+      if (other == vertex) {
+        other = StringRef(transaction::helpers::extractToFromDocument(edge));
+      }
+      if (other == vertex) {
+        return;
+      }
+      if (_options->useWeight()) {
+        weight = _options->weightEdge(edge);
+      }
+    }
+    _neighbors.emplace_back(_options->cache()->persistString(other));
+    _edges.emplace_back(std::move(eid));
+    _weights.emplace_back(weight);
+  };
+  edgeCursor->readAll(callback);
+}
+
+void KShortestPathsFinder::fillResult(Path const& path,
+                                      ShortestPathResult& result) {
+  result.clear();
+  for (auto const& v : path._vertices) {
+    result._vertices.emplace_back(v);
+  }
+  for (auto const& e : path._edges) {
+    result._edges.emplace_back(e);
+  }
+  _options->fetchVerticesCoordinator(result._vertices);
+}
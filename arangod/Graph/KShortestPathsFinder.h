@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_GRAPH_K_SHORTEST_PATHS_FINDER_H
+#define ARANGODB_GRAPH_K_SHORTEST_PATHS_FINDER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/StringRef.h"
+#include "Graph/EdgeDocumentToken.h"
+#include "Graph/ShortestPathFinder.h"
+
+namespace arangodb {
+
+class ManagedDocumentResult;
+
+namespace velocypack {
+class Slice;
+}
+
+namespace graph {
+
+struct ShortestPathOptions;
+
+/// @brief finds the paths from a start to a target vertex in increasing
+/// order of their weight, using Yen's algorithm. the paths are computed
+/// lazily, one per call of getNextPath. every path is loopless
+class KShortestPathsFinder : public ShortestPathFinder {
+ private:
+  struct Path {
+    std::vector<arangodb::StringRef> _vertices;
+    std::vector<graph::EdgeDocumentToken> _edges;
+    /// @brief weight of each edge, _weights[i] belongs to _edges[i]
+    std::vector<double> _weights;
+    double _weight = 0.0;
+
+    void clear();
+    void append(Path const& other, size_t from, size_t to);
+    bool equals(Path const& other) const;
+  };
+
+  struct Step {
+    arangodb::StringRef _pred;
+    graph::EdgeDocumentToken _edge;
+    double _weight;
+    double _distance;
+    bool _done;
+  };
+
+ public:
+  explicit KShortestPathsFinder(ShortestPathOptions* options);
+  ~KShortestPathsFinder();
+
+  /// @brief the cheapest path only
+  bool shortestPath(arangodb::velocypack::Slice const& start,
+                    arangodb::velocypack::Slice const& target,
+                    arangodb::graph::ShortestPathResult& result,
+                    std::function<void()> const& callback) override;
+
+  /// @brief forget the paths found so far and prepare to find the paths
+  /// between start and target
+  void startKShortestPathsTraversal(arangodb::velocypack::Slice const& start,
+                                    arangodb::velocypack::Slice const& target);
+
+  /// @brief the next cheapest path between start and target, false if
+  /// there are no more paths
+  bool getNextPath(arangodb::graph::ShortestPathResult& result,
+                   std::function<void()> const& callback);
+
+ private:
+  /// @brief cheapest path from start to the target of the traversal which
+  /// avoids the blocked vertices and edges
+  bool computeShortestPath(arangodb::StringRef start,
+                           std::unordered_set<arangodb::StringRef> const& blockedVertices,
+                           std::vector<graph::EdgeDocumentToken> const& blockedEdges,
+                           Path& result, std::function<void()> const& callback);
+
+  /// @brief add the deviations of the last path found to the candidates
+  void computeCandidates(std::function<void()> const& callback);
+
+  void expandVertex(arangodb::StringRef vertex);
+
+  void fillResult(Path const& path,
+                  arangodb::graph::ShortestPathResult& result);
+
+ private:
+  arangodb::StringRef _start;
+  arangodb::StringRef _target;
+
+  /// @brief the paths found so far, in increasing order of weight
+  std::vector<Path> _paths;
+
+  /// @brief candidates for the next path
+  std::vector<Path> _candidates;
+
+  /// @brief no more paths exist
+  bool _exhausted;
+
+  std::vector<arangodb::StringRef> _neighbors;
+  std::vector<graph::EdgeDocumentToken> _edges;
+  std::vector<double> _weights;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The options to modify this shortest path computation
+  //////////////////////////////////////////////////////////////////////////////
+  arangodb::graph::ShortestPathOptions* _options;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reusable ManagedDocumentResult that temporarily takes
+  ///        responsibility for one document.
+  //////////////////////////////////////////////////////////////////////////////
+  std::unique_ptr<ManagedDocumentResult> _mmdr;
+};
+
+}  // namespace graph
+}  // namespace arangodb
+#endif
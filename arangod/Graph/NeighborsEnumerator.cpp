@@ -40,7 +40,7 @@ NeighborsEnumerator::NeighborsEnumerator(Traverser* traverser,
       _searchDepth(0) {
   StringRef vId = _traverser->traverserCache()->persistString(StringRef(startVertex));
   _allFound.insert(vId);
-  _currentDepth.insert(vId);
+  _currentDepth.emplace_back(vId);
   _iterator = _currentDepth.begin();
 }
 
@@ -62,6 +62,13 @@ bool NeighborsEnumerator::next() {
 
       _lastDepth.swap(_currentDepth);
       _currentDepth.clear();
+      // expand the vertices of the depth in the order of their ids, so that
+      // the edge index is looked up in key order, which makes the lookups
+      // hit the blocks read by their predecessors
+      std::sort(_lastDepth.begin(), _lastDepth.end(),
+                [](StringRef const& lhs, StringRef const& rhs) {
+                  return lhs.compare(rhs) < 0;
+                });
       for (auto const& nextVertex : _lastDepth) {
         auto callback = [&](EdgeDocumentToken&& eid,
                             VPackSlice other, size_t cursorId) {
@@ -94,7 +101,7 @@ bool NeighborsEnumerator::next() {
 
           if (_allFound.find(v) == _allFound.end()) {
             if (_traverser->vertexMatchesConditions(v, _searchDepth + 1)) {
-              _currentDepth.emplace(v);
+              _currentDepth.emplace_back(v);
               _allFound.emplace(v);
             }
           } else {
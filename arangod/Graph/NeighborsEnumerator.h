@@ -35,9 +35,11 @@ namespace graph {
 
 class NeighborsEnumerator final : public arangodb::traverser::PathEnumerator {
   std::unordered_set<arangodb::StringRef> _allFound;
-  std::unordered_set<arangodb::StringRef> _currentDepth;
-  std::unordered_set<arangodb::StringRef> _lastDepth;
-  std::unordered_set<arangodb::StringRef>::iterator _iterator;
+  // the vertices of a depth are unique, they are checked against _allFound
+  // before they are added
+  std::vector<arangodb::StringRef> _currentDepth;
+  std::vector<arangodb::StringRef> _lastDepth;
+  std::vector<arangodb::StringRef>::iterator _iterator;
 
   uint64_t _searchDepth;
  
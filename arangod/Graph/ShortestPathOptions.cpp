@@ -44,6 +44,7 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query)
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      numberOfPaths(1),
       bidirectional(true),
       multiThreaded(true) {}
 
@@ -53,6 +54,7 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query,
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      numberOfPaths(1),
       bidirectional(true),
       multiThreaded(true) {
   TRI_ASSERT(info.isObject());
@@ -65,6 +67,8 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query,
       VelocyPackHelper::getStringValue(info, "weightAttribute", "");
   defaultWeight =
       VelocyPackHelper::getNumericValue<double>(info, "defaultWeight", 1);
+  numberOfPaths =
+      VelocyPackHelper::getNumericValue<uint64_t>(info, "paths", 1);
 }
 
 ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info,
@@ -73,6 +77,7 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info,
       direction("outbound"),
       weightAttribute(""),
       defaultWeight(1),
+      numberOfPaths(1),
       bidirectional(true),
       multiThreaded(true) {
   TRI_ASSERT(info.isObject());
@@ -85,6 +90,8 @@ ShortestPathOptions::ShortestPathOptions(aql::Query* query, VPackSlice info,
       VelocyPackHelper::getStringValue(info, "weightAttribute", "");
   defaultWeight =
       VelocyPackHelper::getNumericValue<double>(info, "defaultWeight", 1);
+  numberOfPaths =
+      VelocyPackHelper::getNumericValue<uint64_t>(info, "paths", 1);
 
   VPackSlice read = info.get("reverseLookupInfos");
   if (!read.isArray()) {
@@ -142,6 +149,7 @@ void ShortestPathOptions::toVelocyPack(VPackBuilder& builder) const {
   VPackObjectBuilder guard(&builder);
   builder.add("weightAttribute", VPackValue(weightAttribute));
   builder.add("defaultWeight", VPackValue(defaultWeight));
+  builder.add("paths", VPackValue(numberOfPaths));
   builder.add("type", VPackValue("shortestPath"));
 }
 
@@ -45,6 +45,8 @@ struct ShortestPathOptions final : public BaseOptions {
   std::string direction;
   std::string weightAttribute;
   double defaultWeight;
+  /// @brief number of paths to find, in increasing order of weight
+  uint64_t numberOfPaths;
   bool bidirectional;
   bool multiThreaded;
   std::string end;
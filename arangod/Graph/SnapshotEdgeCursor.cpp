@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SnapshotEdgeCursor.h"
+
+#include "Basics/StringRef.h"
+#include "Graph/EdgeDocumentToken.h"
+#include "Graph/EdgeSnapshot.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::graph;
+
+SnapshotEdgeCursor::SnapshotEdgeCursor(
+    std::vector<std::shared_ptr<EdgeSnapshot const>>&& snapshots,
+    StringRef vertex)
+    : _snapshots(std::move(snapshots)), _position(0) {
+  for (size_t cursorId = 0; cursorId < _snapshots.size(); ++cursorId) {
+    TRI_ASSERT(_snapshots[cursorId] != nullptr);
+    _snapshots[cursorId]->edges(
+        vertex, [&](LocalDocumentId const& id, VPackSlice other) {
+          _edges.emplace_back(Edge{cursorId, id, other});
+        });
+  }
+}
+
+SnapshotEdgeCursor::~SnapshotEdgeCursor() {}
+
+bool SnapshotEdgeCursor::next(
+    std::function<void(EdgeDocumentToken&&, VPackSlice, size_t)> callback) {
+  if (_position >= _edges.size()) {
+    return false;
+  }
+  Edge const& edge = _edges[_position++];
+  callback(EdgeDocumentToken(_snapshots[edge._cursorId]->cid(), edge._id),
+           edge._other, edge._cursorId);
+  return true;
+}
+
+void SnapshotEdgeCursor::readAll(
+    std::function<void(EdgeDocumentToken&&, VPackSlice, size_t)> callback) {
+  for (; _position < _edges.size(); ++_position) {
+    Edge const& edge = _edges[_position];
+    callback(EdgeDocumentToken(_snapshots[edge._cursorId]->cid(), edge._id),
+             edge._other, edge._cursorId);
+  }
+}
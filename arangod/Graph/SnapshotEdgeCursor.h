@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GRAPH_SNAPSHOT_EDGE_CURSOR_H
+#define ARANGOD_GRAPH_SNAPSHOT_EDGE_CURSOR_H 1
+
+#include "Basics/Common.h"
+
+#include "Graph/EdgeCursor.h"
+#include "VocBase/LocalDocumentId.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+class StringRef;
+
+namespace graph {
+class EdgeSnapshot;
+
+/// @brief edge cursor reading the edges of a vertex from edge snapshots
+/// instead of the edge indexes. like the edge index, it returns the id of
+/// the other vertex instead of the edge document
+class SnapshotEdgeCursor final : public EdgeCursor {
+ public:
+  /// @brief one snapshot per cursor id
+  SnapshotEdgeCursor(std::vector<std::shared_ptr<EdgeSnapshot const>>&& snapshots,
+                     arangodb::StringRef vertex);
+
+  ~SnapshotEdgeCursor();
+
+  bool next(std::function<void(EdgeDocumentToken&&,
+                               arangodb::velocypack::Slice, size_t)>
+                callback) override;
+
+  void readAll(
+      std::function<void(EdgeDocumentToken&&,
+                         arangodb::velocypack::Slice, size_t)>) override;
+
+ private:
+  struct Edge {
+    size_t _cursorId;
+    LocalDocumentId _id;
+    /// @brief the other vertex, points into the snapshot
+    arangodb::velocypack::Slice _other;
+  };
+
+  /// @brief keeps the snapshots alive while their edges are in use
+  std::vector<std::shared_ptr<EdgeSnapshot const>> _snapshots;
+
+  std::vector<Edge> _edges;
+  size_t _position;
+};
+
+}  // namespace graph
+}  // namespace arangodb
+
+#endif
@@ -52,29 +52,50 @@ TraverserCache::TraverserCache(aql::Query* query)
 
 TraverserCache::~TraverserCache() {}
 
-VPackSlice TraverserCache::lookupToken(EdgeDocumentToken const& idToken) {
-  TRI_ASSERT(!ServerState::instance()->isCoordinator());
-  auto col = _trx->vocbase().lookupCollection(idToken.cid());
-
+namespace {
+void logMissingEdge(LogicalCollection const* col) {
   if (col == nullptr) {
     // collection gone... should not happen
     LOG_TOPIC(ERR, arangodb::Logger::GRAPHS) << "Could not extract indexed edge document. collection not found";
     TRI_ASSERT(col != nullptr); // for maintainer mode
-    return arangodb::velocypack::Slice::nullSlice();
+    return;
   }
+  // We already had this token, inconsistent state. Return NULL in Production
+  LOG_TOPIC(ERR, arangodb::Logger::GRAPHS) << "Could not extract indexed edge document, return 'null' instead. "
+    << "This is most likely a caching issue. Try: 'db."
+    << col->name() <<".unload(); db." << col->name() << ".load()' in arangosh to fix this.";
+  TRI_ASSERT(false); // for maintainer mode
+}
+}
 
-  if (!col->readDocument(_trx, idToken.localDocumentId(), *_mmdr.get())) {
-    // We already had this token, inconsistent state. Return NULL in Production
-    LOG_TOPIC(ERR, arangodb::Logger::GRAPHS) << "Could not extract indexed edge document, return 'null' instead. "
-      << "This is most likely a caching issue. Try: 'db."
-      << col->name() <<".unload(); db." << col->name() << ".load()' in arangosh to fix this.";
-    TRI_ASSERT(false); // for maintainer mode
+VPackSlice TraverserCache::lookupToken(EdgeDocumentToken const& idToken) {
+  TRI_ASSERT(!ServerState::instance()->isCoordinator());
+  auto col = _trx->vocbase().lookupCollection(idToken.cid());
+
+  if (col == nullptr ||
+      !col->readDocument(_trx, idToken.localDocumentId(), *_mmdr.get())) {
+    logMissingEdge(col.get());
     return arangodb::velocypack::Slice::nullSlice();
   }
 
   return VPackSlice(_mmdr->vpack());
 }
 
+void TraverserCache::readToken(
+    EdgeDocumentToken const& idToken,
+    std::function<void(VPackSlice const&)> const& cb) {
+  TRI_ASSERT(!ServerState::instance()->isCoordinator());
+  auto col = _trx->vocbase().lookupCollection(idToken.cid());
+
+  if (col == nullptr ||
+      !col->readDocumentWithCallback(
+          _trx, idToken.localDocumentId(),
+          [&cb](LocalDocumentId const&, VPackSlice doc) { cb(doc); })) {
+    logMissingEdge(col.get());
+    cb(arangodb::velocypack::Slice::nullSlice());
+  }
+}
+
 VPackSlice TraverserCache::lookupInCollection(StringRef id) {
   //TRI_ASSERT(!ServerState::instance()->isCoordinator());
   size_t pos = id.find('/');
@@ -107,8 +128,7 @@ VPackSlice TraverserCache::lookupInCollection(StringRef id) {
 
 void TraverserCache::insertEdgeIntoResult(EdgeDocumentToken const& idToken,
                                       VPackBuilder& builder) {
-  TRI_ASSERT(!ServerState::instance()->isCoordinator());
-  builder.add(lookupToken(idToken));
+  readToken(idToken, [&builder](VPackSlice const& edge) { builder.add(edge); });
 }
 
 void TraverserCache::insertVertexIntoResult(StringRef idString,
@@ -117,8 +137,10 @@ void TraverserCache::insertVertexIntoResult(StringRef idString,
 }
 
 aql::AqlValue TraverserCache::fetchEdgeAqlResult(EdgeDocumentToken const& idToken) {
-  TRI_ASSERT(!ServerState::instance()->isCoordinator());
-  return aql::AqlValue(lookupToken(idToken));
+  aql::AqlValue result;
+  readToken(idToken,
+            [&result](VPackSlice const& edge) { result = aql::AqlValue(edge); });
+  return result;
 }
 
 aql::AqlValue TraverserCache::fetchVertexAqlResult(StringRef idString) {
@@ -116,6 +116,15 @@ class TraverserCache {
 
   protected:
 
+   //////////////////////////////////////////////////////////////////////////////
+   /// @brief Hands the document stored within the token to the callback,
+   ///        or a null slice if it cannot be found. The document is not
+   ///        copied, so a slice from the storage engine's document cache
+   ///        is only valid during the callback.
+   //////////////////////////////////////////////////////////////////////////////
+  void readToken(EdgeDocumentToken const& token,
+                 std::function<void(velocypack::Slice const&)> const& cb);
+
    //////////////////////////////////////////////////////////////////////////////
    /// @brief Lookup a document from the database.
    ///        The Slice returned here is only valid until the NEXT call of this
@@ -100,8 +100,7 @@ VPackSlice TraverserDocumentCache::lookupAndCache(StringRef id) {
 // These two do not use the cache.
 void TraverserDocumentCache::insertEdgeIntoResult(EdgeDocumentToken const& idToken,
                                                   VPackBuilder& builder) {
-  TRI_ASSERT(!ServerState::instance()->isCoordinator());
-  builder.add(lookupToken(idToken));
+  TraverserCache::insertEdgeIntoResult(idToken, builder);
 }
 
 void TraverserDocumentCache::insertVertexIntoResult(StringRef idString,
@@ -121,8 +120,7 @@ void TraverserDocumentCache::insertVertexIntoResult(StringRef idString,
 }
 
 aql::AqlValue TraverserDocumentCache::fetchEdgeAqlResult(EdgeDocumentToken const& idToken) {
-  TRI_ASSERT(!ServerState::instance()->isCoordinator());
-  return aql::AqlValue(lookupToken(idToken));
+  return TraverserCache::fetchEdgeAqlResult(idToken);
 }
 
 aql::AqlValue TraverserDocumentCache::fetchVertexAqlResult(StringRef idString) {
@@ -28,6 +28,7 @@
 #include "Aql/Query.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterEdgeCursor.h"
+#include "Cluster/ClusterTraverser.h"
 #include "Graph/SingleServerTraverser.h"
 #include "Indexes/Index.h"
 
@@ -515,6 +516,15 @@ EdgeCursor* arangodb::traverser::TraverserOptions::nextCursor(
   return nextCursorLocal(mmdr, vid, list);
 }
 
+void TraverserOptions::prefetchEdges(std::vector<StringRef> const& vids,
+                                     uint64_t depth) {
+  if (!_isCoordinator) {
+    return;
+  }
+  TRI_ASSERT(_traverser != nullptr);
+  _traverser->prefetchEdges(vids, depth);
+}
+
 EdgeCursor* TraverserOptions::nextCursorCoordinator(StringRef vid,
                                                     uint64_t depth) {
   TRI_ASSERT(_traverser != nullptr);
@@ -121,6 +121,11 @@ struct TraverserOptions : public graph::BaseOptions {
 
   graph::EdgeCursor* nextCursor(ManagedDocumentResult*, StringRef vid, uint64_t);
 
+  /// @brief on a coordinator, fetch the edges of the given vertices of a
+  /// depth in one request per DBServer. cursors of these vertices do not
+  /// send requests of their own then
+  void prefetchEdges(std::vector<StringRef> const& vids, uint64_t depth);
+
   void linkTraverser(arangodb::traverser::ClusterTraverser*);
 
   double estimateCost(size_t& nrItems) const override;
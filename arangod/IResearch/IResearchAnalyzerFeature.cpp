@@ -53,6 +53,8 @@
 #include "VocBase/ManagedDocumentResult.h"
 #include "VocBase/vocbase.h"
 
+#include <list>
+
 NS_LOCAL
 
 static std::string const ANALYZER_COLLECTION_NAME("_iresearch_analyzers");
@@ -122,6 +124,76 @@ bool IdentityAnalyzer::reset(irs::string_ref const& data) {
   return !_empty;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a small per-thread LRU cache of TOKENS(...) results for short,
+///        frequently repeated values, e.g. tags or categories
+////////////////////////////////////////////////////////////////////////////////
+class TokensCache {
+ public:
+  typedef std::shared_ptr<arangodb::velocypack::Buffer<uint8_t> const> Tokens;
+  typedef arangodb::iresearch::IResearchAnalyzerFeature::AnalyzerPool::ptr Pool;
+
+  static size_t const CAPACITY = 128; // arbitrary value
+  static size_t const MAX_INPUT_SIZE = 64; // arbitrary value
+
+  static TokensCache& instance() {
+    static thread_local TokensCache cache;
+    return cache;
+  }
+
+  static bool cacheable(irs::string_ref const& data) noexcept {
+    return data.size() <= MAX_INPUT_SIZE;
+  }
+
+  Tokens find(Pool const& pool, irs::string_ref const& data) {
+    auto const itr = _index.find(key(pool, data));
+
+    if (itr == _index.end()) {
+      return nullptr;
+    }
+
+    _entries.splice(_entries.begin(), _entries, itr->second); // most recently used
+
+    return itr->second->_tokens;
+  }
+
+  void emplace(Pool const& pool, irs::string_ref const& data, Tokens&& tokens) {
+    auto entryKey = key(pool, data);
+
+    if (_index.find(entryKey) != _index.end()) {
+      return; // already cached
+    }
+
+    if (_entries.size() >= CAPACITY) {
+      _index.erase(_entries.back()._key);
+      _entries.pop_back(); // least recently used
+    }
+
+    // the entry holds a reference to 'pool' so that its address stays unique
+    _entries.push_front(Entry{ pool, std::move(entryKey), std::move(tokens) });
+    _index.emplace(_entries.front()._key, _entries.begin());
+  }
+
+ private:
+  struct Entry {
+    Pool _pool;
+    std::string _key;
+    Tokens _tokens;
+  };
+
+  static std::string key(Pool const& pool, irs::string_ref const& data) {
+    auto const* poolPtr = pool.get();
+    std::string result(reinterpret_cast<char const*>(&poolPtr), sizeof(poolPtr));
+
+    result.append(data.c_str(), data.size());
+
+    return result;
+  }
+
+  std::list<Entry> _entries; // most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+};
+
 arangodb::aql::AqlValue aqlFnTokens(
     arangodb::aql::ExpressionContext* expressionContext,
     arangodb::transaction::Methods* trx,
@@ -159,6 +231,16 @@ arangodb::aql::AqlValue aqlFnTokens(
     return arangodb::aql::AqlValue();
   }
 
+  auto const cacheable = TokensCache::cacheable(data);
+
+  if (cacheable) {
+    auto const tokens = TokensCache::instance().find(pool, data);
+
+    if (tokens) {
+      return arangodb::aql::AqlValue(arangodb::velocypack::Slice(tokens->data()));
+    }
+  }
+
   auto analyzer = pool->get();
 
   if (!analyzer) {
@@ -210,6 +292,14 @@ arangodb::aql::AqlValue aqlFnTokens(
 
   builder.close();
 
+  if (cacheable) {
+    TokensCache::instance().emplace(
+      pool,
+      data,
+      std::make_shared<arangodb::velocypack::Buffer<uint8_t>>(*buffer)
+    );
+  }
+
   bool bufOwner = true; // out parameter from AqlValue denoting ownership aquisition (must be true initially)
   auto release = irs::make_finally([&buffer, &bufOwner]()->void {
     if (!bufOwner) {
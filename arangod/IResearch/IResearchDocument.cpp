@@ -66,6 +66,7 @@ static_assert(
 
 irs::string_ref const CID_FIELD("@_CID");
 irs::string_ref const PK_COLUMN("@_PK");
+irs::string_ref const STORED_VALUE_COLUMN_PREFIX("@_SV:");
 
 // wrapper for use objects with the IResearch unbounded_object_pool
 template<typename T>
@@ -433,6 +434,16 @@ NS_BEGIN(iresearch)
   setPkValue(field, pk);
 }
 
+/*static*/ void Field::setStoredValue(
+    Field& field,
+    irs::string_ref const& column,
+    arangodb::velocypack::Slice const& value
+) {
+  field._name = column;
+  field._features = &irs::flags::empty_instance();
+  field._storeValues = ValueStorage::FULL;
+  field._value = irs::bytes_ref(value.begin(), value.byteSize());
+}
 
 Field::Field(Field&& rhs)
   : _features(rhs._features),
@@ -633,6 +644,16 @@ void FieldIterator::next() {
   } while (!pushAndSetValue(topValue().value, context));
 }
 
+std::string storedValueColumn(irs::string_ref const& attribute) {
+  std::string column;
+
+  column.reserve(STORED_VALUE_COLUMN_PREFIX.size() + attribute.size());
+  column.append(STORED_VALUE_COLUMN_PREFIX.c_str(), STORED_VALUE_COLUMN_PREFIX.size());
+  column.append(attribute.c_str(), attribute.size());
+
+  return column;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                DocumentPrimaryKey implementation
 // ----------------------------------------------------------------------------
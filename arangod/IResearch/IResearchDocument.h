@@ -83,6 +83,12 @@ char const NESTING_LIST_OFFSET_SUFFIX = ']';
 struct IResearchViewMeta; // forward declaration
 class DocumentPrimaryKey; // forward declaration
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the name of the column holding the raw VPack value of the specified
+///        top-level document attribute (see IResearchLinkMeta::_storedValues)
+////////////////////////////////////////////////////////////////////////////////
+std::string storedValueColumn(irs::string_ref const& attribute);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief indexed/stored document field adapter for IResearch
 ////////////////////////////////////////////////////////////////////////////////
@@ -93,6 +99,11 @@ struct Field {
   static void setCidValue(Field& field, TRI_voc_cid_t const& cid, init_stream_t);
   static void setPkValue(Field& field, DocumentPrimaryKey const& pk);
   static void setPkValue(Field& field, DocumentPrimaryKey const& pk, init_stream_t);
+  static void setStoredValue(
+    Field& field,
+    irs::string_ref const& column,
+    arangodb::velocypack::Slice const& value
+  );
 
   Field() = default;
   Field(Field&& rhs);
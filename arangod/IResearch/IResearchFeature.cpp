@@ -698,6 +698,13 @@ IResearchFeature::IResearchFeature(
   : ApplicationFeature(server, IResearchFeature::name()),
     _async(std::make_unique<Async>()),
     _running(false),
+    _asyncIndexingLimit(0),
+    _consolidationConcurrency(0),
+    _consolidationDeletesThreshold(0.),
+    _consolidationMaxQueries(0),
+    _consolidationSegmentsThreshold(0),
+    _consolidations(0),
+    _queries(0),
     _threads(0),
     _threadsLimit(0) {
   setOptional(true);
@@ -706,6 +713,28 @@ IResearchFeature::IResearchFeature(
   startsAfter("AQLFunctions");
 }
 
+bool IResearchFeature::acquireConsolidation() noexcept {
+  if (_consolidationMaxQueries && _queries.load() > _consolidationMaxQueries) {
+    return false; // hold off while queries are busy
+  }
+
+  if (!_consolidationConcurrency) {
+    ++_consolidations;
+
+    return true; // unlimited
+  }
+
+  auto running = _consolidations.load();
+
+  do {
+    if (running >= _consolidationConcurrency) {
+      return false; // budget exhausted
+    }
+  } while (!_consolidations.compare_exchange_weak(running, running + 1));
+
+  return true;
+}
+
 void IResearchFeature::async(
     std::shared_ptr<ResourceMutex> const& mutex,
     Async::Fn &&fn
@@ -731,6 +760,31 @@ void IResearchFeature::collectOptions(
   std::transform(section.begin(), section.end(), section.begin(), ::tolower);
   ApplicationFeature::collectOptions(options);
   options->addSection(section, std::string("Configure the ") + FEATURE_NAME + " feature");
+  options->addOption(
+    std::string("--") + section + ".async-indexing-limit",
+    "index committed documents in background threads, allowing at most this many operations per view to wait for indexing (0 == index within transactions)",
+    new arangodb::options::UInt64Parameter(&_asyncIndexingLimit)
+  );
+  options->addOption(
+    std::string("--") + section + ".consolidation-concurrency",
+    "maximum number of views consolidating their segments at the same time (0 == unlimited)",
+    new arangodb::options::UInt64Parameter(&_consolidationConcurrency)
+  );
+  options->addOption(
+    std::string("--") + section + ".consolidation-deletes-threshold",
+    "consolidate a view before its consolidation interval once this ratio of its documents is deleted (0 == disabled)",
+    new arangodb::options::DoubleParameter(&_consolidationDeletesThreshold)
+  );
+  options->addOption(
+    std::string("--") + section + ".consolidation-max-queries",
+    "hold off consolidation while more ArangoSearch queries are running (0 == never hold off)",
+    new arangodb::options::UInt64Parameter(&_consolidationMaxQueries)
+  );
+  options->addOption(
+    std::string("--") + section + ".consolidation-segments-threshold",
+    "consolidate a view before its consolidation interval once it has more segments (0 == disabled)",
+    new arangodb::options::UInt64Parameter(&_consolidationSegmentsThreshold)
+  );
   options->addOption(
     std::string("--") + section + ".threads",
     "the exact number of threads to use for asynchronous tasks (0 == autodetect)",
@@ -785,6 +839,11 @@ void IResearchFeature::prepare() {
   }
 }
 
+void IResearchFeature::releaseConsolidation() noexcept {
+  TRI_ASSERT(_consolidations.load());
+  --_consolidations;
+}
+
 void IResearchFeature::start() {
   if (!isEnabled()) {
     return;
@@ -834,6 +893,12 @@ void IResearchFeature::validateOptions(
 ) {
   _running.store(false);
   ApplicationFeature::validateOptions(options);
+
+  if (_consolidationDeletesThreshold < 0. || _consolidationDeletesThreshold > 1.) {
+    LOG_TOPIC(FATAL, arangodb::iresearch::TOPIC)
+      << "invalid value for '--arangosearch.consolidation-deletes-threshold', expecting a ratio between 0 and 1";
+    FATAL_ERROR_EXIT();
+  }
 }
 
 NS_END // iresearch
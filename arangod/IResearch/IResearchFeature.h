@@ -66,6 +66,44 @@ class IResearchFeature final : public application_features::ApplicationFeature {
   //////////////////////////////////////////////////////////////////////////////
   void asyncNotify() const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return maximum number of committed operations per view that may wait
+  ///         for asynchronous indexing (0 == index within transactions)
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t asyncIndexingLimit() const noexcept { return _asyncIndexingLimit; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adaptive consolidation: number of segments of a view that triggers
+  ///        consolidation before the configured interval (0 == disabled)
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t consolidationSegmentsThreshold() const noexcept {
+    return _consolidationSegmentsThreshold;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adaptive consolidation: ratio of deleted documents in a view that
+  ///        triggers consolidation before the configured interval (0 == disabled)
+  //////////////////////////////////////////////////////////////////////////////
+  double consolidationDeletesThreshold() const noexcept {
+    return _consolidationDeletesThreshold;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief acquire one of the '--arangosearch.consolidation-concurrency'
+  ///        slots for running a consolidation
+  /// @return false if no slot is available or consolidation should be held off
+  ///         because of too many running ArangoSearch queries
+  /// @note a successful call must be followed by releaseConsolidation()
+  //////////////////////////////////////////////////////////////////////////////
+  bool acquireConsolidation() noexcept;
+  void releaseConsolidation() noexcept;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief track the number of running ArangoSearch queries
+  //////////////////////////////////////////////////////////////////////////////
+  void queryStarted() noexcept { ++_queries; }
+  void queryFinished() noexcept { --_queries; }
+
   void beginShutdown() override;
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override;
   static std::string const& name();
@@ -80,6 +118,13 @@ class IResearchFeature final : public application_features::ApplicationFeature {
 
   std::shared_ptr<Async> _async; // object managing async jobs (never null!!!)
   std::atomic<bool> _running;
+  uint64_t _asyncIndexingLimit;
+  uint64_t _consolidationConcurrency; // max number of concurrent consolidations (0 == unlimited)
+  double _consolidationDeletesThreshold;
+  uint64_t _consolidationMaxQueries; // hold off consolidation above this number of running queries (0 == never)
+  uint64_t _consolidationSegmentsThreshold;
+  std::atomic<uint64_t> _consolidations; // number of running consolidations
+  std::atomic<uint64_t> _queries; // number of running ArangoSearch queries
   uint64_t _threads;
   uint64_t _threadsLimit;
 };
@@ -124,6 +124,11 @@ class IResearchLink {
     arangodb::velocypack::Slice const& slice
   ) const; // arangodb::Index override
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief how this collection is indexed
+  ////////////////////////////////////////////////////////////////////////////////
+  IResearchLinkMeta const& meta() const noexcept { return _meta; }
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief amount of memory in bytes occupied by this iResearch Link
   ////////////////////////////////////////////////////////////////////////////////
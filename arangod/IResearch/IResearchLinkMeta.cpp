@@ -21,6 +21,7 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -76,7 +77,8 @@ IResearchLinkMeta::Mask::Mask(bool mask /*= false*/) noexcept
     _fields(mask),
     _includeAllFields(mask),
     _trackListPositions(mask),
-    _storeValues(mask) {
+    _storeValues(mask),
+    _storedValues(mask) {
 }
 
 IResearchLinkMeta::IResearchLinkMeta()
@@ -84,6 +86,7 @@ IResearchLinkMeta::IResearchLinkMeta()
     _includeAllFields(false), // true to match all encountered fields, false match only fields in '_fields'
     _trackListPositions(false), // treat '_trackListPositions' as SQL-IN
     _storeValues(ValueStorage::NONE) { // do not track values at all
+  //_storedValues(<empty>), // no attributes are kept in columns by default
   auto analyzer = IResearchAnalyzerFeature::identity();
 
   // identity-only tokenization
@@ -107,6 +110,7 @@ IResearchLinkMeta& IResearchLinkMeta::operator=(IResearchLinkMeta&& other) noexc
     _includeAllFields = std::move(other._includeAllFields);
     _trackListPositions = std::move(other._trackListPositions);
     _storeValues = other._storeValues;
+    _storedValues = std::move(other._storedValues);
   }
 
   return *this;
@@ -119,6 +123,7 @@ IResearchLinkMeta& IResearchLinkMeta::operator=(IResearchLinkMeta const& other)
     _includeAllFields = other._includeAllFields;
     _trackListPositions = other._trackListPositions;
     _storeValues = other._storeValues;
+    _storedValues = other._storedValues;
   }
 
   return *this;
@@ -157,6 +162,10 @@ bool IResearchLinkMeta::operator==(
     return false; // values do not match
   }
 
+  if (_storedValues != other._storedValues) {
+    return false; // values do not match
+  }
+
   return true;
 }
 
@@ -311,6 +320,46 @@ bool IResearchLinkMeta::init(
     }
   }
 
+  {
+    // optional string list
+    static const std::string fieldName("storedValues");
+
+    mask->_storedValues = slice.hasKey(fieldName);
+
+    if (!mask->_storedValues) {
+      _storedValues = defaults._storedValues;
+    } else {
+      auto field = slice.get(fieldName);
+
+      if (!field.isArray()) {
+        errorField = fieldName;
+
+        return false;
+      }
+
+      _storedValues.clear(); // reset to match read values exactly
+
+      for (arangodb::velocypack::ArrayIterator itr(field); itr.valid(); ++itr) {
+        auto value = *itr;
+
+        if (!value.isString() || 0 == value.getStringLength()) {
+          errorField = fieldName + "=>[" + arangodb::basics::StringUtils::itoa(itr.index()) + "]";
+
+          return false;
+        }
+
+        _storedValues.emplace_back(value.copyString());
+      }
+
+      // keep a canonical order for comparisons
+      std::sort(_storedValues.begin(), _storedValues.end());
+      _storedValues.erase(
+        std::unique(_storedValues.begin(), _storedValues.end()),
+        _storedValues.end()
+      );
+    }
+  }
+
   // .............................................................................
   // process fields last since children inherit from parent
   // .............................................................................
@@ -449,6 +498,16 @@ bool IResearchLinkMeta::json(
     builder.add("storeValues", arangodb::velocypack::Value(policies[policyIdx]));
   }
 
+  // only output non-default stored values, they do not apply to fields
+  if ((ignoreEqual ? _storedValues != ignoreEqual->_storedValues : !_storedValues.empty())
+      && (!mask || mask->_storedValues)) {
+    arangodb::velocypack::ArrayBuilder storedValuesBuilder(&builder, "storedValues");
+
+    for (auto& entry: _storedValues) {
+      builder.add(arangodb::velocypack::Value(entry));
+    }
+  }
+
   return true;
 }
 
@@ -471,6 +530,10 @@ size_t IResearchLinkMeta::memory() const {
     size += entry.value()->memory();
   }
 
+  for (auto& entry: _storedValues) {
+    size += sizeof(entry) + entry.size();
+  }
+
   return size;
 }
 
@@ -70,6 +70,7 @@ struct IResearchLinkMeta {
     bool _includeAllFields;
     bool _trackListPositions;
     bool _storeValues;
+    bool _storedValues;
     explicit Mask(bool mask = false) noexcept;
   };
 
@@ -81,6 +82,7 @@ struct IResearchLinkMeta {
   bool _includeAllFields; // include all fields or only fields listed in '_fields'
   bool _trackListPositions; // append relative offset in list to attribute name (as opposed to without offset)
   ValueStorage _storeValues; // how values should be stored inside the view
+  std::vector<std::string> _storedValues; // top-level attributes kept in columns of the view, only used for the link itself
   // NOTE: if adding fields don't forget to modify the default constructor !!!
   // NOTE: if adding fields don't forget to modify the copy assignment operator !!!
   // NOTE: if adding fields don't forget to modify the move assignment operator !!!
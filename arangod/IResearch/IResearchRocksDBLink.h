@@ -117,6 +117,15 @@ class IResearchRocksDBLink final
     return IResearchLink::remove(trx, documentId, doc, mode);
   }
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief a removal and an insertion of the same document id within one
+  ///        transaction cannot be told apart by the view, so updates always
+  ///        have to create a new document id
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual bool supportsInPlaceUpdates() const override {
+    return false;
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief fill and return a JSON description of a IResearchLink object
   /// @param withFigures output 'figures' section with e.g. memory size
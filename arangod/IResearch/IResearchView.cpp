@@ -267,6 +267,8 @@ irs::utf8_path getPersistedPath(
 inline void insertDocument(
     irs::segment_writer::document& doc,
     arangodb::iresearch::FieldIterator& body,
+    arangodb::velocypack::Slice const& document,
+    arangodb::iresearch::IResearchLinkMeta const& meta,
     TRI_voc_cid_t cid,
     TRI_voc_rid_t rid) {
   using namespace arangodb::iresearch;
@@ -296,6 +298,21 @@ inline void insertDocument(
   // Indexed: CID
   Field::setCidValue(field, primaryKey.cid());
   doc.insert(irs::action::index, field);
+
+  // Stored: configured top-level attributes as raw VPack
+  std::string column;
+
+  for (auto& attribute: meta._storedValues) {
+    auto const value = document.get(attribute);
+
+    if (value.isNone()) {
+      continue; // missing attributes are reconstructed as 'null' on read
+    }
+
+    column = storedValueColumn(attribute);
+    Field::setStoredValue(field, column, value);
+    doc.insert(irs::action::store, field);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -415,6 +432,28 @@ arangodb::Result persistProperties(
   );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @return the segment count or the ratio of deleted documents of 'reader'
+///         exceed the adaptive consolidation thresholds of 'feature'
+////////////////////////////////////////////////////////////////////////////////
+bool exceedsConsolidationThresholds(
+    irs::index_reader const& reader,
+    arangodb::iresearch::IResearchFeature const& feature
+) {
+  auto const segmentsThreshold = feature.consolidationSegmentsThreshold();
+
+  if (segmentsThreshold && reader.size() > segmentsThreshold) {
+    return true;
+  }
+
+  auto const deletesThreshold = feature.consolidationDeletesThreshold();
+  auto const docs = reader.docs_count();
+
+  return deletesThreshold > 0.
+    && docs
+    && double(docs - reader.live_docs_count()) / double(docs) > deletesThreshold;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief consolidates and optionally cleanups an IResearch DataStore if required
 /// @return at least consolidation was executed
@@ -701,6 +740,37 @@ class IResearchView::ViewStateWrite final
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief container storing the operations of a given TransactionState that
+///        are indexed asynchronously after the transaction commits
+////////////////////////////////////////////////////////////////////////////////
+class IResearchView::ViewStateQueue final
+  : public arangodb::TransactionState::Cookie {
+ public:
+  std::lock_guard<ReadMutex> _viewLock; // prevent data-store deallocation (lock @ AsyncSelf)
+  std::vector<PendingOperation> _operations;
+
+  explicit ViewStateQueue(ReadMutex& viewMutex) noexcept
+    : _viewLock(viewMutex) {
+  }
+
+  // a single copy of the link definition per link and transaction
+  std::shared_ptr<IResearchLinkMeta const> const& meta(
+      IResearchLinkMeta const& meta
+  ) {
+    auto& copy = _metas[&meta];
+
+    if (!copy) {
+      copy = std::make_shared<IResearchLinkMeta>(meta);
+    }
+
+    return copy;
+  }
+
+ private:
+  std::unordered_map<IResearchLinkMeta const*, std::shared_ptr<IResearchLinkMeta const>> _metas;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief helper class for retrieving/setting view transaction states
 ////////////////////////////////////////////////////////////////////////////////
@@ -772,6 +842,57 @@ class IResearchView::ViewStateHelper {
     return false;
   }
 
+  static IResearchView::ViewStateQueue* queue(
+      arangodb::TransactionState& state,
+      IResearchView const& view
+  ) {
+    static_assert(sizeof(IResearchView) > Queue, "'Queue' offset >= sizeof(IResearchView)");
+    auto* key = &view + Queue;
+
+    // TODO FIXME find a better way to look up a ViewState
+    #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+      return dynamic_cast<IResearchView::ViewStateQueue*>(state.cookie(key));
+    #else
+      return static_cast<IResearchView::ViewStateQueue*>(state.cookie(key));
+    #endif
+  }
+
+  static bool queue(
+      arangodb::TransactionState& state,
+      IResearchView const& view,
+      std::unique_ptr<IResearchView::ViewStateQueue>&& value
+  ) {
+    static_assert(sizeof(IResearchView) > Queue, "'Queue' offset >= sizeof(IResearchView)");
+    auto* key = &view + Queue;
+    auto prev = state.cookie(key, std::move(value));
+
+    if (!prev) {
+      return true;
+    }
+
+    state.cookie(key, std::move(prev)); // put back original value
+
+    return false;
+  }
+
+  static std::unique_ptr<IResearchView::ViewStateQueue> releaseQueue(
+      arangodb::TransactionState& state,
+      IResearchView const& view
+  ) noexcept {
+    static_assert(sizeof(IResearchView) > Queue, "'Queue' offset >= sizeof(IResearchView)");
+    auto* key = &view + Queue;
+    auto prev = state.cookie(key, nullptr); // get existing cookie
+
+    // TODO FIXME find a better way to look up a ViewState
+    #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+      TRI_ASSERT(!prev || dynamic_cast<IResearchView::ViewStateQueue*>(prev.get()));
+    #endif
+
+    return std::unique_ptr<IResearchView::ViewStateQueue>(
+      static_cast<IResearchView::ViewStateQueue*>(prev.release())
+    );
+  }
+
   static void commitWrite(
       arangodb::TransactionState& state,
       IResearchView const& view,
@@ -796,7 +917,7 @@ class IResearchView::ViewStateHelper {
   }
 
  private:
-  enum offsets { Reader, Writer }; // offsets from key
+  enum offsets { Reader, Writer, Queue }; // offsets from key
 };
 
 IResearchView::IResearchView(
@@ -810,6 +931,7 @@ IResearchView::IResearchView(
    _asyncSelf(irs::memory::make_unique<AsyncSelf>(this)),
    _meta(std::make_shared<AsyncMeta>()),
    _storePersisted(getPersistedPath(dbPathFeature, vocbase, id())),
+   _pendingCount(0),
    _asyncTerminate(false),
    _inRecovery(false) {
   // set up in-recovery insertion hooks
@@ -914,16 +1036,58 @@ IResearchView::IResearchView(
           return true; // reschedule
         }
 
+        static size_t const ADAPTIVE_CHECK_MSEC = 1000; // arbitrary value
         size_t usedMsec = std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::system_clock::now() - state._last
         ).count();
+        auto const adaptive = _asyncFeature->consolidationSegmentsThreshold()
+                           || _asyncFeature->consolidationDeletesThreshold() > 0.;
 
         if (usedMsec < state._consolidationIntervalMsec) {
-          timeoutMsec = state._consolidationIntervalMsec - usedMsec; // still need to sleep
+          bool early = false;
+
+          // consolidate early if segments pile up or many documents are deleted,
+          // but not more often than every tenth of the configured interval
+          if (adaptive
+              && _storePersisted
+              && usedMsec >= state._consolidationIntervalMsec / 10) {
+            irs::directory_reader reader;
+
+            {
+              SCOPED_LOCK(_readerLock);
+              reader = _storePersisted._reader;
+            }
+
+            early = reader && exceedsConsolidationThresholds(reader, *_asyncFeature);
+          }
+
+          if (!early) {
+            timeoutMsec = state._consolidationIntervalMsec - usedMsec; // still need to sleep
+
+            if (adaptive) {
+              timeoutMsec = std::min(timeoutMsec, ADAPTIVE_CHECK_MSEC);
+            }
+
+            return true; // reschedule (with possibly updated '_consolidationIntervalMsec')
+          }
+        }
+
+        // hold off while the consolidation budget is exhausted or queries are
+        // busy, but not longer than the configured interval once more
+        auto const acquired = _asyncFeature->acquireConsolidation();
+
+        if (!acquired && usedMsec < 2 * state._consolidationIntervalMsec) {
+          timeoutMsec = ADAPTIVE_CHECK_MSEC;
 
-          return true; // reschedule (with possibly updated '_consolidationIntervalMsec')
+          return true; // reschedule
         }
 
+        auto release = irs::make_finally([this, acquired]()->void {
+          if (acquired) {
+            _asyncFeature->releaseConsolidation();
+          }
+        });
+
         state._last = std::chrono::system_clock::now(); // remember last task start time
         timeoutMsec = state._consolidationIntervalMsec;
 
@@ -946,6 +1110,28 @@ IResearchView::IResearchView(
 
         return true; // reschedule
     });
+
+    // index operations queued for asynchronous indexing
+    _asyncFeature->async(
+      self(),
+      [this](size_t& timeoutMsec, bool) ->bool {
+        static size_t const BATCH_SIZE = 10000; // arbitrary value
+        static size_t const IDLE_TIMEOUT_MSEC = 1000; // arbitrary value
+
+        if (_asyncTerminate.load()) {
+          return false; // termination requested
+        }
+
+        // '_storePersisted' protected by the resource lock held by the task
+        if (_storePersisted && _pendingCount.load()) {
+          indexPending(BATCH_SIZE);
+        }
+
+        // continue right away if more operations are waiting
+        timeoutMsec = _pendingCount.load() ? 1 : IDLE_TIMEOUT_MSEC;
+
+        return true; // reschedule
+    });
   }
 
   auto& viewRef = *this;
@@ -978,6 +1164,26 @@ IResearchView::IResearchView(
       *state, viewRef, arangodb::transaction::Status::COMMITTED != status
     );
   };
+
+  // initialize transaction queue callback
+  _trxQueueCallback = [&viewRef](
+      arangodb::transaction::Methods& trx,
+      arangodb::transaction::Status status
+  )->void {
+    auto* state = trx.state();
+
+    // check state of the top-most transaction only
+    if (!state || arangodb::transaction::Status::RUNNING == status) {
+      return; // NOOP
+    }
+
+    // the released cookie holds the view lock until the end of scope
+    auto queue = ViewStateHelper::releaseQueue(*state, viewRef);
+
+    if (queue && arangodb::transaction::Status::COMMITTED == status) {
+      viewRef.enqueue(std::move(queue->_operations));
+    }
+  };
 }
 
 IResearchView::~IResearchView() {
@@ -1031,6 +1237,13 @@ arangodb::Result IResearchView::appendVelocyPackDetailed(
       );
     }
 
+    // number of committed operations not yet indexed (runtime state only)
+    if (!forPersistence && asyncIndexingLimit()) {
+      builder.add(
+        "asyncIndexingLag", arangodb::velocypack::Value(_pendingCount.load())
+      );
+    }
+
     if (forPersistence) {
       _metaState.json(builder);
 
@@ -1145,6 +1358,10 @@ bool IResearchView::apply(arangodb::transaction::Methods& trx) {
   return trx.addStatusChangeCallback(&_trxReadCallback); // add shapshot
 }
 
+size_t IResearchView::asyncIndexingLimit() const noexcept {
+  return _asyncFeature ? _asyncFeature->asyncIndexingLimit() : 0;
+}
+
 arangodb::Result IResearchView::drop(
     TRI_voc_cid_t cid,
     bool unlink /*= true*/
@@ -1410,6 +1627,48 @@ bool IResearchView::emplace(TRI_voc_cid_t cid) {
   return factory;
 }
 
+void IResearchView::enqueue(std::vector<PendingOperation>&& operations) {
+  if (operations.empty()) {
+    return; // nothing to do
+  }
+
+  size_t pending;
+
+  try {
+    SCOPED_LOCK(_pendingLock);
+
+    for (auto& operation: operations) {
+      _pending.emplace_back(std::move(operation));
+    }
+
+    pending = _pending.size();
+    _pendingCount.store(pending);
+  } catch (std::exception const& e) {
+    LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
+      << "caught exception while queueing operations for asynchronous indexing in arangosearch view '" << name() << "': " << e.what();
+    IR_LOG_EXCEPTION();
+
+    return;
+  } catch (...) {
+    LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
+      << "caught exception while queueing operations for asynchronous indexing in arangosearch view '" << name() << "'";
+    IR_LOG_EXCEPTION();
+
+    return;
+  }
+
+  auto const limit = asyncIndexingLimit();
+
+  // bound the indexing lag, the committing thread catches up on its own
+  if (_storePersisted && pending > limit) {
+    indexPending(pending - limit);
+  }
+
+  if (_asyncFeature) {
+    _asyncFeature->asyncNotify();
+  }
+}
+
 arangodb::Result IResearchView::commit() {
   // '_storePersisted' protected by '_asyncSelf' held by snapshot()/registerFlushCallback()
   if (!_storePersisted) {
@@ -1420,6 +1679,8 @@ arangodb::Result IResearchView::commit() {
     LOG_TOPIC(TRACE, arangodb::iresearch::TOPIC)
       << "starting persisted-sync sync for arangosearch view '" << name() << "'";
 
+    indexPending(0); // operations committed before the flush must be durable
+
     _storePersisted._writer->commit(); // finishing flush transaction
 
     {
@@ -1466,6 +1727,79 @@ arangodb::Result IResearchView::commit() {
   return {TRI_ERROR_INTERNAL};
 }
 
+size_t IResearchView::indexPending(size_t limit) {
+  TRI_ASSERT(_storePersisted);
+  SCOPED_LOCK(_indexingLock); // apply batches in the order they were queued
+  std::vector<PendingOperation> batch;
+
+  {
+    SCOPED_LOCK(_pendingLock);
+    auto const count = limit ? std::min(limit, _pending.size()) : _pending.size();
+    auto const end = _pending.begin() + count;
+
+    batch.reserve(count);
+    std::move(_pending.begin(), end, std::back_inserter(batch));
+    _pending.erase(_pending.begin(), end);
+    _pendingCount.store(_pending.size());
+  }
+
+  if (batch.empty()) {
+    return 0; // nothing to do
+  }
+
+  try {
+    PrimaryKeyFilterContainer removals; // must outlive 'ctx'
+    auto ctx = _storePersisted._writer->documents();
+    FieldIterator body;
+
+    for (auto& operation: batch) {
+      if (!operation._meta) {
+        ctx.remove(removals.emplace(operation._cid, operation._rid));
+
+        continue;
+      }
+
+      arangodb::velocypack::Slice const document(operation._document.c_str());
+
+      body.reset(document, *operation._meta);
+
+      if (!body.valid()) {
+        continue; // nothing to index
+      }
+
+      auto doc = ctx.insert();
+      insertDocument(doc, body, document, *operation._meta, operation._cid, operation._rid);
+
+      if (!doc) {
+        LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+          << "failed asynchronous indexing in arangosearch view '" << id()
+          << "', collection '" << operation._cid << "', revision '" << operation._rid << "'";
+      }
+    }
+
+    if (!removals.empty()) {
+      // hold references until the documents are flushed
+      ctx.remove(
+        irs::filter::make<PrimaryKeyFilterContainer>(std::move(removals))
+      );
+    }
+  } catch (arangodb::basics::Exception const& e) {
+    LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
+      << "caught exception during asynchronous indexing in arangosearch view '" << name() << "': " << e.code() << " " << e.what();
+    IR_LOG_EXCEPTION();
+  } catch (std::exception const& e) {
+    LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
+      << "caught exception during asynchronous indexing in arangosearch view '" << name() << "': " << e.what();
+    IR_LOG_EXCEPTION();
+  } catch (...) {
+    LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
+      << "caught exception during asynchronous indexing in arangosearch view '" << name() << "'";
+    IR_LOG_EXCEPTION();
+  }
+
+  return batch.size();
+}
+
 int IResearchView::insert(
     transaction::Methods& trx,
     TRI_voc_cid_t cid,
@@ -1482,9 +1816,11 @@ int IResearchView::insert(
       return TRI_ERROR_NO_ERROR; // nothing to index
     }
 
+    auto const& document = doc; // shadowed by the segment writer document below
+
     try {
       auto doc = ctx.insert();
-      insertDocument(doc, body, cid, documentId.id());
+      insertDocument(doc, body, document, meta, cid, documentId.id());
 
       if (doc) {
         return TRI_ERROR_NO_ERROR;
@@ -1517,6 +1853,10 @@ int IResearchView::insert(
     return TRI_ERROR_BAD_PARAMETER; // 'trx' and transaction state required
   }
 
+  if (!_inRecovery && asyncIndexingLimit()) {
+    return queue(trx, cid, documentId.id(), doc, &meta);
+  }
+
   if (trx.isSingleOperationTransaction()) {
     auto ctx = _storePersisted._writer->documents();
     return insertImpl(ctx);
@@ -1578,7 +1918,7 @@ int IResearchView::insert(
           }
 
           auto doc = ctx.insert();
-          insertDocument(doc, body, cid, begin->first.id());
+          insertDocument(doc, body, begin->second, meta, cid, begin->first.id());
 
           if (!doc) {
             LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
@@ -1608,6 +1948,18 @@ int IResearchView::insert(
     return TRI_ERROR_BAD_PARAMETER; // 'trx' and transaction state required
   }
 
+  if (!_inRecovery && asyncIndexingLimit()) {
+    for (auto const& doc : batch) {
+      auto const res = queue(trx, cid, doc.first.id(), doc.second, &meta);
+
+      if (TRI_ERROR_NO_ERROR != res) {
+        return res;
+      }
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
   auto& state = *(trx.state());
   auto* ctx = ViewStateHelper::write(state, *this);
 
@@ -1760,6 +2112,97 @@ void IResearchView::open() {
   );
 }
 
+int IResearchView::queue(
+    transaction::Methods& trx,
+    TRI_voc_cid_t cid,
+    TRI_voc_rid_t rid,
+    arangodb::velocypack::Slice const& doc,
+    IResearchLinkMeta const* meta
+) {
+  TRI_ASSERT(trx.state());
+
+  try {
+    if (trx.isSingleOperationTransaction()) {
+      // no commit notification, queue right away as done for direct indexing
+      std::vector<PendingOperation> operations(1);
+      auto& operation = operations.back();
+
+      operation._cid = cid;
+      operation._rid = rid;
+
+      if (meta) {
+        operation._meta = std::make_shared<IResearchLinkMeta>(*meta);
+        operation._document.assign(doc.begin(), doc.byteSize());
+      }
+
+      SCOPED_LOCK(_asyncSelf->mutex()); // '_storePersisted' may be modified asynchronously
+
+      if (!_asyncSelf->get()) {
+        return TRI_ERROR_INTERNAL; // the current view is no longer valid
+      }
+
+      enqueue(std::move(operations));
+
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    auto& state = *(trx.state());
+    auto* ctx = ViewStateHelper::queue(state, *this);
+
+    if (!ctx) {
+      auto ptr = irs::memory::make_unique<ViewStateQueue>(
+        _asyncSelf->mutex()
+      ); // will aquire read-lock to prevent data-store deallocation
+
+      if (!_asyncSelf->get()) {
+        return TRI_ERROR_INTERNAL; // the current view is no longer valid (checked after ReadLock aquisition)
+      }
+
+      ctx = ptr.get();
+
+      if (!ViewStateHelper::queue(state, *this, std::move(ptr))
+          || !trx.addStatusChangeCallback(&_trxQueueCallback)) {
+        LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+          << "failed to store state into a TransactionState for asynchronous indexing in arangosearch view '" << name() << "'"
+          << "', tid '" << state.id() << "', collection '" << cid << "', revision '" << rid << "'";
+
+        return TRI_ERROR_INTERNAL;
+      }
+    }
+
+    TRI_ASSERT(ctx);
+    ctx->_operations.emplace_back();
+    auto& operation = ctx->_operations.back();
+
+    operation._cid = cid;
+    operation._rid = rid;
+
+    if (meta) {
+      operation._meta = ctx->meta(*meta);
+      operation._document.assign(doc.begin(), doc.byteSize());
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  } catch (arangodb::basics::Exception const& e) {
+    LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+      << "caught exception while queueing for asynchronous indexing in arangosearch view '" << id()
+      << "', collection '" << cid << "', revision '" << rid << "': " << e.code() << " " << e.what();
+    IR_LOG_EXCEPTION();
+  } catch (std::exception const& e) {
+    LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+      << "caught exception while queueing for asynchronous indexing in arangosearch view '" << id()
+      << "', collection '" << cid << "', revision '" << rid << "': " << e.what();
+    IR_LOG_EXCEPTION();
+  } catch (...) {
+    LOG_TOPIC(WARN, arangodb::iresearch::TOPIC)
+      << "caught exception while queueing for asynchronous indexing in arangosearch view '" << id()
+      << "', collection '" << cid << "', revision '" << rid << "'";
+    IR_LOG_EXCEPTION();
+  }
+
+  return TRI_ERROR_INTERNAL;
+}
+
 int IResearchView::remove(
     transaction::Methods& trx,
     TRI_voc_cid_t cid,
@@ -1771,6 +2214,12 @@ int IResearchView::remove(
     return TRI_ERROR_BAD_PARAMETER; // 'trx' and transaction state required
   }
 
+  if (!_inRecovery && asyncIndexingLimit()) {
+    return queue(
+      trx, cid, documentId.id(), arangodb::velocypack::Slice::noneSlice(), nullptr
+    );
+  }
+
   auto& state = *(trx.state());
   auto* ctx = ViewStateHelper::write(state, *this);
 
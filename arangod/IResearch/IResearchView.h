@@ -39,6 +39,8 @@
 #include "utils/async_utils.hpp"
 #include "utils/utf8_path.hpp"
 
+#include <deque>
+
 namespace {
 
 typedef irs::async_utils::read_write_mutex::read_mutex ReadMutex;
@@ -326,8 +328,19 @@ class IResearchView final
     PersistedStore(irs::utf8_path&& path);
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a committed operation waiting for asynchronous indexing
+  //////////////////////////////////////////////////////////////////////////////
+  struct PendingOperation {
+    TRI_voc_cid_t _cid;
+    TRI_voc_rid_t _rid;
+    std::shared_ptr<IResearchLinkMeta const> _meta; // how to index '_document' (nullptr == removal)
+    irs::bstring _document; // VPack of the document to insert
+  };
+
   struct ViewFactory; // forward declaration
   class ViewStateHelper; // forward declaration
+  class ViewStateQueue; // forward declaration
   struct ViewStateRead; // forward declaration
   class ViewStateWrite; // forward declaration
 
@@ -347,6 +360,39 @@ class IResearchView final
     uint64_t planVersion
   );
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @return maximum number of committed operations that may wait for
+  ///         asynchronous indexing (0 == index within transactions)
+  ////////////////////////////////////////////////////////////////////////////////
+  size_t asyncIndexingLimit() const noexcept;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief append committed operations to the asynchronous indexing queue,
+  ///        operations exceeding asyncIndexingLimit() are indexed right away
+  /// @note '_asyncSelf' must be locked by the caller
+  ////////////////////////////////////////////////////////////////////////////////
+  void enqueue(std::vector<PendingOperation>&& operations);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief index queued operations in the order they were committed
+  /// @param limit maximum number of operations to index (0 == all)
+  /// @return number of indexed operations
+  /// @note '_asyncSelf' must be locked by the caller
+  ////////////////////////////////////////////////////////////////////////////////
+  size_t indexPending(size_t limit);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief queue an insertion ('meta' != nullptr) or a removal of a document
+  ///        for asynchronous indexing once 'trx' commits
+  ////////////////////////////////////////////////////////////////////////////////
+  int queue(
+    transaction::Methods& trx,
+    TRI_voc_cid_t cid,
+    TRI_voc_rid_t rid,
+    arangodb::velocypack::Slice const& doc,
+    IResearchLinkMeta const* meta
+  );
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief registers a callback for flush feature
   ////////////////////////////////////////////////////////////////////////////////
@@ -368,6 +414,11 @@ class IResearchView final
   FlushCallback _flushCallback; // responsible for flush callback unregistration
   std::function<void(arangodb::transaction::Methods& trx, arangodb::transaction::Status status)> _trxReadCallback; // for snapshot(...)
   std::function<void(arangodb::transaction::Methods& trx, arangodb::transaction::Status status)> _trxWriteCallback; // for insert(...)/remove(...)
+  std::function<void(arangodb::transaction::Methods& trx, arangodb::transaction::Status status)> _trxQueueCallback; // for queue(...)
+  std::mutex _pendingLock; // for use with '_pending'
+  std::deque<PendingOperation> _pending; // committed operations waiting for asynchronous indexing
+  std::atomic<size_t> _pendingCount; // size of '_pending' for lock-free reporting
+  std::mutex _indexingLock; // keeps queued operations in commit order while indexing
   std::atomic<bool> _asyncTerminate; // trigger termination of long-running async jobs
   std::atomic<bool> _inRecovery;
 };
@@ -25,11 +25,13 @@
 #include "AqlHelper.h"
 #include "IResearchCommon.h"
 #include "IResearchDocument.h"
+#include "IResearchFeature.h"
 #include "IResearchFilterFactory.h"
 #include "IResearchOrderFactory.h"
 #include "IResearchView.h"
 #include "IResearchViewBlock.h"
 #include "IResearchViewNode.h"
+#include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/AqlValue.h"
 #include "Aql/Ast.h"
@@ -48,6 +50,8 @@
 #include "search/boolean_filter.hpp"
 #include "search/score.hpp"
 
+#include <numeric>
+
 namespace arangodb {
 namespace iresearch {
 
@@ -70,11 +74,45 @@ IResearchViewBlockBase::IResearchViewBlockBase(
     _inflight(0),
     _hasMore(true), // has more data initially
     _volatileSort(true),
-    _volatileFilter(true) {
+    _volatileFilter(true),
+    _feature(arangodb::application_features::ApplicationServer::lookupFeature<
+      IResearchFeature
+    >()) {
   TRI_ASSERT(_trx);
 
   // add expression execution context
   _filterCtx.emplace(_execCtx);
+
+  // running queries hold off adaptive consolidation
+  if (_feature) {
+    _feature->queryStarted();
+  }
+
+  // lookup stored-value columns of the projected attributes
+  auto const& projections = en.projections();
+
+  if (!projections.empty()) {
+    _projectionColumns.resize(_reader.size());
+
+    for (size_t i = 0, count = _reader.size(); i < count; ++i) {
+      auto& columns = _projectionColumns[i];
+      columns.reserve(projections.size());
+
+      for (auto const& projection : projections) {
+        auto const* column = _reader[i].column_reader(storedValueColumn(projection));
+
+        columns.emplace_back(
+          column ? column->values() : irs::columnstore_reader::values_reader_f()
+        );
+      }
+    }
+  }
+}
+
+IResearchViewBlockBase::~IResearchViewBlockBase() {
+  if (_feature) {
+    _feature->queryFinished();
+  }
 }
 
 std::pair<ExecutionState, Result> IResearchViewBlockBase::initializeCursor(
@@ -162,6 +200,12 @@ bool IResearchViewBlockBase::readDocument(
     return false; // not a valid document reference
   }
 
+  if (!_projectionColumns.empty() && readProjections(subReaderId, docId)) {
+    callback(arangodb::LocalDocumentId(docPk.rid()), _projectionBuilder.slice());
+
+    return true;
+  }
+
   TRI_ASSERT(_trx->state());
 
   // this is necessary for MMFiles
@@ -185,6 +229,39 @@ bool IResearchViewBlockBase::readDocument(
   );
 }
 
+bool IResearchViewBlockBase::readProjections(
+    size_t segmentId,
+    irs::doc_id_t const docId
+) {
+  TRI_ASSERT(segmentId < _projectionColumns.size());
+  auto const& viewNode = *ExecutionNode::castTo<IResearchViewNode const*>(getPlanNode());
+  auto const& projections = viewNode.projections();
+  auto const& columns = _projectionColumns[segmentId];
+  TRI_ASSERT(projections.size() == columns.size());
+  irs::bytes_ref value;
+
+  _projectionBuilder.clear();
+  _projectionBuilder.openObject();
+
+  for (size_t i = 0, count = columns.size(); i < count; ++i) {
+    auto const& column = columns[i];
+
+    if (!column) {
+      return false; // the segment was written without the column
+    }
+
+    if (column(docId, value) && !value.empty()) {
+      _projectionBuilder.add(projections[i], VPackSlice(value.c_str()));
+    } else {
+      _projectionBuilder.add(projections[i], VPackValue(VPackValueType::Null));
+    }
+  }
+
+  _projectionBuilder.close();
+
+  return true;
+}
+
 std::pair<ExecutionState, std::unique_ptr<AqlItemBlock>>
 IResearchViewBlockBase::getSome(size_t atMost) {
   traceGetSomeBegin(atMost);
@@ -207,7 +284,7 @@ IResearchViewBlockBase::getSome(size_t atMost) {
       needMore = false;
 
       if (_buffer.empty()) {
-        size_t const toFetch = (std::min)(DefaultBatchSize(), atMost);
+        size_t const toFetch = (std::min)(batchSize(), atMost);
         auto upstreamRes = ExecutionBlock::getBlock(toFetch);
         if (upstreamRes.first == ExecutionState::WAITING) {
           traceGetSomeEnd(nullptr, ExecutionState::WAITING);
@@ -293,7 +370,7 @@ std::pair<ExecutionState, size_t> IResearchViewBlockBase::skipSome(size_t atMost
 
   while (_inflight < atMost) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       auto upstreamRes = getBlock(toFetch);
       if (upstreamRes.first == ExecutionState::WAITING) {
         traceSkipSomeEnd(0, upstreamRes.first);
@@ -572,73 +649,102 @@ IResearchViewOrderedBlock::IResearchViewOrderedBlock(
     PrimaryKeyIndexReader const& reader,
     aql::ExecutionEngine& engine,
     IResearchViewNode const& node
-): IResearchViewBlockBase(reader, engine, node) {
+): IResearchViewBlockBase(reader, engine, node),
+   _position(0),
+   _limit(node.scoreLimit()),
+   _collected(false) {
+  TRI_ASSERT(_limit > 0);
 }
 
-bool IResearchViewOrderedBlock::next(
-    ReadContext& ctx,
-    size_t limit
-) {
-  TRI_ASSERT(_filter);
-
-  auto scoreLess = [this](irs::bstring const& lhs, irs::bstring const& rhs) {
-    return _order.less(lhs.c_str(), rhs.c_str());
+void IResearchViewOrderedBlock::collectSegment(
+    size_t segment,
+    std::vector<Document>& heap
+) const {
+  // the top of the heap is the worst document kept
+  auto const scoreLess = [this](Document const& lhs, Document const& rhs) {
+    return _order.less(lhs.score.c_str(), rhs.score.c_str());
   };
 
-  // FIXME use irs::memory_pool
-  typedef std::pair<size_t, irs::doc_id_t> DocumentToken;
-
-  std::multimap<irs::bstring, DocumentToken, decltype(scoreLess)> orderedDocTokens(scoreLess);
-  auto const maxDocCount = _skip + limit;
-
-  for (size_t i = 0, count = _reader.size(); i < count; ++i) {
-    auto& segmentReader = _reader[i];
-    auto itr = segmentReader.mask(_filter->execute(segmentReader, _order, _filterCtx));
-    irs::score const* score = itr->attributes().get<irs::score>().get();
+  auto& segmentReader = _reader[segment];
+  auto itr = segmentReader.mask(_filter->execute(segmentReader, _order, _filterCtx));
+  irs::score const* score = itr->attributes().get<irs::score>().get();
 
-    if (!score) {
-      LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
-        << "failed to retrieve document score attribute while iterating arangosearch view, ignoring: reader_id '" << i << "'";
-      IR_LOG_STACK_TRACE();
+  if (!score) {
+    LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
+      << "failed to retrieve document score attribute while iterating arangosearch view, ignoring: reader_id '" << segment << "'";
+    IR_LOG_STACK_TRACE();
 
-      continue; // if here then there is probably a bug in IResearchView while querying
-    }
+    return; // if here then there is probably a bug in IResearchView while querying
+  }
 
 #if defined(__GNUC__) && !defined(_GLIBCXX_USE_CXX11_ABI)
-    // workaround for std::basic_string's COW with old compilers
-    const irs::bytes_ref scoreValue = score->value();
+  // workaround for std::basic_string's COW with old compilers
+  const irs::bytes_ref scoreValue = score->value();
 #else
-    const auto& scoreValue = score->value();
+  const auto& scoreValue = score->value();
 #endif
 
-    while (itr->next()) {
-      score->evaluate(); // compute a score for the current document
-
-      orderedDocTokens.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(scoreValue),
-        std::forward_as_tuple(i, itr->value())
-      );
-
-      if (orderedDocTokens.size() > maxDocCount) {
-        orderedDocTokens.erase(--(orderedDocTokens.end())); // remove element with the least score
-      }
+  while (itr->next()) {
+    score->evaluate(); // compute a score for the current document
+
+    if (heap.size() < _limit) {
+      heap.emplace_back(Document{irs::bstring(scoreValue.c_str(), scoreValue.size()), segment, itr->value()});
+      std::push_heap(heap.begin(), heap.end(), scoreLess);
+    } else if (_order.less(scoreValue.c_str(), heap.front().score.c_str())) {
+      std::pop_heap(heap.begin(), heap.end(), scoreLess);
+      heap.back().score.assign(scoreValue.c_str(), scoreValue.size());
+      heap.back().segment = segment;
+      heap.back().doc = itr->value();
+      std::push_heap(heap.begin(), heap.end(), scoreLess);
     }
   }
+}
+
+void IResearchViewOrderedBlock::collect() {
+  TRI_ASSERT(_filter);
+  TRI_ASSERT(_documents.empty());
+
+  // the segments are scored on the query thread, as the prepared filter and
+  // order as well as the transaction are not meant to be shared between
+  // threads. keeping only the best documents in a bounded heap still saves
+  // reading all other documents from the collections
+  //
+  // the largest segments are scored first. the heap is then filled from the
+  // most candidates early on, and most documents of the smaller segments
+  // fail the comparison with the worst kept score instead of being pushed
+  // into the heap and popped again
+  std::vector<size_t> segments(_reader.size());
+  std::iota(segments.begin(), segments.end(), size_t(0));
+  std::sort(segments.begin(), segments.end(), [this](size_t lhs, size_t rhs) {
+    return _reader[lhs].live_docs_count() > _reader[rhs].live_docs_count();
+  });
+
+  for (auto const segment : segments) {
+    throwIfKilled(); // check if we were aborted
+    collectSegment(segment, _documents);
+  }
 
-  auto tokenItr = orderedDocTokens.begin();
-  auto tokenEnd = orderedDocTokens.end();
+  auto const scoreLess = [this](Document const& lhs, Document const& rhs) {
+    return _order.less(lhs.score.c_str(), rhs.score.c_str());
+  };
 
-  // skip documents previously returned
-  for (size_t i = _skip; i; --i, ++tokenItr) {
-    if (tokenItr == tokenEnd) {
-      LOG_TOPIC(ERR, arangodb::iresearch::TOPIC)
-        << "document count less than the document count during the previous iteration on the same query while iterating arangosearch view'";
+  // the heap holds at most _limit documents already
+  std::sort_heap(_documents.begin(), _documents.end(), scoreLess);
 
-      break; // if here then there is probably a bug in the iResearch library
-    }
+  _collected = true;
+}
+
+bool IResearchViewOrderedBlock::next(
+    ReadContext& ctx,
+    size_t limit
+) {
+  if (!_collected) {
+    collect();
   }
 
+  auto const& viewNode = *ExecutionNode::castTo<IResearchViewNode const*>(getPlanNode());
+  auto const numSorts = viewNode.sortCondition().size();
+
   // capture only one reference
   // to potentially avoid heap allocation
   IndexIterator::DocumentCallback const copyDocument = [&ctx] (
@@ -647,25 +753,29 @@ bool IResearchViewOrderedBlock::next(
     ctx.res->setValue(ctx.pos, ctx.curRegs, AqlValue(doc));
   };
 
-  // iterate through documents
-  while (limit && tokenItr != tokenEnd) {
-    auto& token = tokenItr->second;
+  while (limit && _position < _documents.size()) {
+    auto const& document = _documents[_position++];
 
-    readDocument(token.first, token.second, copyDocument);
-    // The result is in the first variable of this depth,
-    // we do not need to do a lookup in
-    // getPlanNode()->_registerPlan->varInfo,
-    // but can just take cur->getNrRegs() as registerId:
+    if (readDocument(document.segment, document.doc, copyDocument)) {
+      // copy scores, registerId's are sequential
+      auto scoreRegs = ctx.curRegs;
+
+      for (size_t i = 0; i < numSorts; ++i) {
+        ctx.res->setValue(
+          ctx.pos,
+          ++scoreRegs,
+          _order.to_string<AqlValue, std::char_traits<char>>(document.score.c_str(), i)
+        );
+      }
+    }
 
     // FIXME why?
     if (ctx.pos > 0) {
       // re-use already copied AQLValues
-      ctx.res->copyValuesFromFirstRow(ctx.pos, ctx.curRegs);
+      ctx.res->copyValuesFromFirstRow(ctx.pos, static_cast<RegisterId>(ctx.curRegs));
     }
     ++ctx.pos;
 
-    ++tokenItr;
-    ++_skip;
     --limit;
   }
 
@@ -673,28 +783,12 @@ bool IResearchViewOrderedBlock::next(
 }
 
 size_t IResearchViewOrderedBlock::skip(size_t limit) {
-  TRI_ASSERT(_filter);
-
-  size_t skipped = 0;
-  auto skip = _skip;
-
-  for (size_t i = 0, readerCount = _reader.size(); i < readerCount; ++i) {
-    auto& segmentReader = _reader[i];
-
-    auto itr = segmentReader.mask(_filter->execute(
-      segmentReader, irs::order::prepared::unordered(), _filterCtx
-    ));
-
-    while (skip && itr->next()) {
-      --skip;
-    }
-
-    while (limit > skipped && itr->next()) {
-      ++skipped;
-    }
+  if (!_collected) {
+    collect();
   }
 
-  _skip += skipped;
+  size_t const skipped = (std::min)(limit, _documents.size() - _position);
+  _position += skipped;
 
   return skipped;
 }
@@ -43,6 +43,7 @@ class score;
 namespace arangodb {
 namespace iresearch {
 
+class IResearchFeature;
 class IResearchViewNode;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -56,6 +57,8 @@ class IResearchViewBlockBase : public aql::ExecutionBlock {
     IResearchViewNode const&
   );
 
+  virtual ~IResearchViewBlockBase();
+
   std::pair<aql::ExecutionState, std::unique_ptr<aql::AqlItemBlock>> getSome(size_t atMost) override final;
 
   // skip between atLeast and atMost returns the number actually skipped . . .
@@ -81,6 +84,13 @@ class IResearchViewBlockBase : public aql::ExecutionBlock {
     IndexIterator::DocumentCallback const& callback
   );
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief build an object of the projected attributes from the stored-value
+  ///        columns into '_projectionBuilder'
+  /// @return false if a column is missing in the segment
+  ////////////////////////////////////////////////////////////////////////////////
+  bool readProjections(size_t segmentId, irs::doc_id_t docId);
+
   virtual void reset();
 
   virtual bool next(
@@ -100,6 +110,9 @@ class IResearchViewBlockBase : public aql::ExecutionBlock {
   bool _hasMore;
   bool _volatileSort;
   bool _volatileFilter;
+  std::vector<std::vector<irs::columnstore_reader::values_reader_f>> _projectionColumns; // per segment, per projection (empty function == missing column)
+  arangodb::velocypack::Builder _projectionBuilder;
+  IResearchFeature* _feature; // tracks running queries (nullptr == not tracked)
 }; // IResearchViewBlockBase
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -161,6 +174,9 @@ class IResearchViewBlock final : public IResearchViewUnorderedBlock {
 
 ///////////////////////////////////////////////////////////////////////////////
 /// @class IResearchViewOrderedBlock
+/// @brief produces only the best scored documents of a view, used for
+///        `SORT <scorers> LIMIT k` queries. only the best documents of all
+///        segments are kept in a bounded heap
 ///////////////////////////////////////////////////////////////////////////////
 class IResearchViewOrderedBlock final : public IResearchViewBlockBase {
  public:
@@ -173,7 +189,9 @@ class IResearchViewOrderedBlock final : public IResearchViewBlockBase {
  protected:
   virtual void reset() override {
     IResearchViewBlockBase::reset();
-    _skip = 0;
+    _documents.clear();
+    _position = 0;
+    _collected = false;
   }
 
   virtual bool next(
@@ -184,7 +202,22 @@ class IResearchViewOrderedBlock final : public IResearchViewBlockBase {
   virtual size_t skip(size_t count) override;
 
  private:
-  size_t _skip{};
+  struct Document {
+    irs::bstring score;
+    size_t segment;
+    irs::doc_id_t doc;
+  };
+
+  /// @brief find the best scored documents of all segments
+  void collect();
+
+  /// @brief add the best scored documents of a segment to a bounded heap
+  void collectSegment(size_t segment, std::vector<Document>& heap) const;
+
+  std::vector<Document> _documents; // best documents, in sort order
+  size_t _position;
+  size_t const _limit;
+  bool _collected;
 }; // IResearchViewOrderedBlock
 
 } // iresearch
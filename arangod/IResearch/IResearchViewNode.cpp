@@ -28,6 +28,7 @@
 #include "IResearchViewBlock.h"
 #include "IResearchOrderFactory.h"
 #include "IResearchView.h"
+#include "IResearchLink.h"
 #include "AqlHelper.h"
 #include "Aql/Ast.h"
 #include "Aql/BasicBlocks.h"
@@ -452,6 +453,24 @@ IResearchViewNode::IResearchViewNode(
   if (volatilityMaskSlice.isNumber()) {
     _volatilityMask = volatilityMaskSlice.getNumber<int>();
   }
+
+  // score limit
+  auto const scoreLimitSlice = base.get("scoreLimit");
+
+  if (scoreLimitSlice.isNumber()) {
+    _scoreLimit = scoreLimitSlice.getNumber<size_t>();
+  }
+
+  // projections
+  auto const projectionsSlice = base.get("projections");
+
+  if (projectionsSlice.isArray()) {
+    for (auto const projection : VPackArrayIterator(projectionsSlice)) {
+      if (projection.isString()) {
+        _projections.emplace_back(projection.copyString());
+      }
+    }
+  }
 }
 
 void IResearchViewNode::planNodeRegisters(
@@ -539,6 +558,20 @@ void IResearchViewNode::toVelocyPackHelper(
   // volatility mask
   nodes.add("volatility", VPackValue(_volatilityMask));
 
+  // score limit
+  if (_scoreLimit > 0) {
+    nodes.add("scoreLimit", VPackValue(_scoreLimit));
+  }
+
+  // projections
+  if (!_projections.empty()) {
+    nodes.add("projections", VPackValue(VPackValueType::Array));
+    for (auto const& projection : _projections) {
+      nodes.add(VPackValue(projection));
+    }
+    nodes.close();
+  }
+
   nodes.close();
 }
 
@@ -595,10 +628,40 @@ aql::ExecutionNode* IResearchViewNode::clone(
   node->_shards = _shards;
   node->_options = _options;
   node->_volatilityMask = _volatilityMask;
+  node->_scoreLimit = _scoreLimit;
+  node->_projections = _projections;
 
   return cloneHelper(std::move(node), withDependencies, withProperties);
 }
 
+bool IResearchViewNode::storesValues(
+    std::vector<std::string> const& attributes
+) const {
+  auto visitor = [this, &attributes](TRI_voc_cid_t cid)->bool {
+    auto const collection = _vocbase.lookupCollection(cid);
+
+    if (!collection) {
+      return false;
+    }
+
+    auto const link = IResearchLink::find(*collection, *_view);
+
+    if (!link) {
+      return false;
+    }
+
+    auto const& stored = link->meta()._storedValues; // sorted and unique
+
+    return std::all_of(
+      attributes.begin(), attributes.end(),
+      [&stored](std::string const& attribute) {
+        return std::binary_search(stored.begin(), stored.end(), attribute);
+    });
+  };
+
+  return !empty() && _view->visitCollections(visitor);
+}
+
 bool IResearchViewNode::empty() const noexcept {
   return _view->visitCollections(viewIsEmpty);
 }
@@ -709,13 +772,10 @@ std::unique_ptr<aql::ExecutionBlock> IResearchViewNode::createBlock(
     return std::make_unique<IResearchViewUnorderedBlock>(*reader, engine, *this);
   }
 
-//FIXME uncomment when the following method will be there:
-// `int getAndSkip(size_t skip, size_t& skipped, size_t read, size_t& count, AqlItemBlock*& res)`
-//
-//  if (!isInInnerLoop()) {
-//    // optimized execution for simple queries
-//    return new IResearchViewOrderedBlock(*reader, engine, *this);
-//  }
+  if (_scoreLimit > 0 && !isInInnerLoop()) {
+    // only the best scored documents are needed
+    return std::make_unique<IResearchViewOrderedBlock>(*reader, engine, *this);
+  }
 
   // generic case
   return std::make_unique<IResearchViewBlock>(*reader, engine, *this);
@@ -173,6 +173,35 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
     _sortCondition = std::move(sortCondition);
   }
 
+  /// @brief return the number of best scored documents the view has to
+  ///        produce, 0 means all matching documents
+  size_t scoreLimit() const noexcept {
+    return _scoreLimit;
+  }
+
+  /// @brief set the number of best scored documents the view has to produce
+  /// @note only valid if the sort condition covers a SORT which is followed
+  ///       by a LIMIT of at most 'limit' documents
+  void scoreLimit(size_t limit) noexcept {
+    _scoreLimit = limit;
+  }
+
+  /// @brief return the top-level attributes of the out variable which are
+  ///        read from the stored-value columns instead of the documents,
+  ///        empty means the whole document has to be materialized
+  std::vector<std::string> const& projections() const noexcept {
+    return _projections;
+  }
+
+  /// @brief set the top-level attributes to read from stored-value columns
+  void projections(std::vector<std::string>&& projections) noexcept {
+    _projections = std::move(projections);
+  }
+
+  /// @returns true if every link of the underlying view keeps the specified
+  ///          top-level attributes in stored-value columns
+  bool storesValues(std::vector<std::string> const& attributes) const;
+
   /// @brief getVariablesUsedHere, returning a vector
   std::vector<aql::Variable const*> getVariablesUsedHere() const override final;
 
@@ -231,6 +260,12 @@ class IResearchViewNode final : public arangodb::aql::ExecutionNode {
   /// @brief volatility mask
   mutable int _volatilityMask{ -1 };
 
+  /// @brief number of best scored documents to produce, 0 for all
+  size_t _scoreLimit{ 0 };
+
+  /// @brief top-level attributes read from stored-value columns
+  std::vector<std::string> _projections;
+
   /// @brief IResearchViewNode options
   Options _options;
 }; // IResearchViewNode
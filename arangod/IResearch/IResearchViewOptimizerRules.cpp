@@ -34,6 +34,7 @@
 #include "Aql/SortNode.h"
 #include "Aql/Optimizer.h"
 #include "Aql/WalkerWorker.h"
+#include "Basics/StaticStrings.h"
 #include "Cluster/ServerState.h"
 #include "Utils/CollectionNameResolver.h"
 #include "VocBase/LogicalCollection.h"
@@ -158,6 +159,9 @@ class IResearchViewConditionHandler final
 
   ExecutionPlan* _plan;
   std::vector<std::pair<Variable const*, bool>> _sorts;
+  // number of documents a SORT followed by a LIMIT keeps, 0 if the
+  // nodes below the view do not form a `SORT ... LIMIT` pattern
+  size_t _limit{};
   // map and set are 25-30% faster than corresponding
   // unordered_set for small number of elements
   std::map<VariableId, AstNode const*> _variableDefinitions;
@@ -166,10 +170,21 @@ class IResearchViewConditionHandler final
 
 bool IResearchViewConditionHandler::before(ExecutionNode* en) {
   switch (en->getType()) {
-    case EN::LIMIT:
+    case EN::LIMIT: {
       // LIMIT invalidates the sort expression we already found
       _sorts.clear();
+      _limit = 0;
+
+      auto const* limit = EN::castTo<LimitNode const*>(en);
+      auto const* dependency = en->getFirstDependency();
+
+      if (!limit->fullCount() && dependency &&
+          EN::SORT == dependency->getType() &&
+          limit->limit() <= std::numeric_limits<size_t>::max() - limit->offset()) {
+        _limit = limit->offset() + limit->limit();
+      }
       break;
+    }
 
     case EN::SINGLETON:
     case EN::NORESULTS:
@@ -178,6 +193,10 @@ bool IResearchViewConditionHandler::before(ExecutionNode* en) {
 
     case EN::SORT: {
       // register which variables are used in a SORT
+      if (!_sorts.empty()) {
+        // only the SORT directly followed by the LIMIT is covered
+        _limit = 0;
+      }
       if (_sorts.empty()) {
         for (auto& it : EN::castTo<SortNode const*>(en)->elements()) {
           _sorts.emplace_back(it.var, it.ascending);
@@ -205,6 +224,8 @@ bool IResearchViewConditionHandler::before(ExecutionNode* en) {
     case EN::ENUMERATE_IRESEARCH_VIEW: {
       auto node = EN::castTo<IResearchViewNode*>(en);
       auto& view = *node->view();
+      size_t const limit = _limit;
+      _limit = 0;
 
       // add view and linked collections to the query
       TRI_ASSERT(_plan && _plan->getAst() && _plan->getAst()->query());
@@ -256,6 +277,13 @@ bool IResearchViewConditionHandler::before(ExecutionNode* en) {
         );
       }
 
+      // the view only has to produce the documents passing the LIMIT if
+      // it evaluates the whole SORT and nothing filters in between
+      if (limit > 0 && sortCondition.size() == _sorts.size() &&
+          !node->isInInnerLoop()) {
+        node->scoreLimit(limit);
+      }
+
       node->filterCondition(filterCondition.root());
       node->sortCondition(std::move(sortCondition));
 
@@ -272,6 +300,8 @@ bool IResearchViewConditionHandler::before(ExecutionNode* en) {
       // in these cases we simply ignore the intermediate nodes, note
       // that we have taken care of nodes that could throw exceptions
       // above.
+      // they may however drop or add rows between the view and the LIMIT
+      _limit = 0;
       break;
   }
 
@@ -309,6 +339,54 @@ bool IResearchViewConditionHandler::handleFilterCondition(
   return true;
 }
 
+/// @returns true if the view node output is only used for accessing
+///          top-level attributes stored by all links and has been set up
+///          to produce them from stored-value columns
+bool tryProjectStoredValues(IResearchViewNode& viewNode) {
+  auto const* outVariable = &viewNode.outVariable();
+  std::unordered_set<std::string> attributes;
+  std::unordered_set<Variable const*> vars;
+
+  for (auto* current = viewNode.getFirstParent();
+       current;
+       current = current->getFirstParent()) {
+    vars.clear();
+    current->getVariablesUsedHere(vars);
+
+    if (vars.find(outVariable) == vars.end()) {
+      continue;
+    }
+
+    if (EN::CALCULATION != current->getType()) {
+      return false; // entire document used
+    }
+
+    auto const* expression =
+      EN::castTo<CalculationNode const*>(current)->expression();
+
+    if (!expression
+        || !Ast::getReferencedAttributes(expression->node(), outVariable, attributes)) {
+      return false; // entire document used
+    }
+  }
+
+  if (attributes.empty()
+      || attributes.find(arangodb::StaticStrings::IdString) != attributes.end()) {
+    return false; // nothing to read at all or '_id' (stored as a custom type)
+  }
+
+  std::vector<std::string> projections(attributes.begin(), attributes.end());
+  std::sort(projections.begin(), projections.end());
+
+  if (!viewNode.storesValues(projections)) {
+    return false;
+  }
+
+  viewNode.projections(std::move(projections));
+
+  return true;
+}
+
 }
 
 NS_BEGIN(arangodb)
@@ -361,7 +439,29 @@ void handleViewsRule(
     plan->unlinkNodes(toUnlink);
   }
 
-  opt->addPlan(std::move(plan), rule, !processedViewNodes.empty());
+  bool modified = !processedViewNodes.empty();
+
+  // read the attributes from stored-value columns instead of the documents
+  // if the view output is only used to access top-level attributes which
+  // are stored by every link of the view (links are local on single servers)
+  if (arangodb::ServerState::instance()->isSingleServer()) {
+    nodes.clear();
+    plan->findNodesOfType(nodes, ExecutionNode::ENUMERATE_IRESEARCH_VIEW, true);
+
+    for (auto* node : nodes) {
+      auto& viewNode = *EN::castTo<IResearchViewNode*>(node);
+
+      if (!viewNode.projections().empty()) {
+        continue;
+      }
+
+      if (tryProjectStoredValues(viewNode)) {
+        modified = true;
+      }
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
 }
 
 void scatterViewInClusterRule(
@@ -463,6 +563,9 @@ void scatterViewInClusterRule(
     remoteNode->addDependency(node);
 
     // insert gather node
+    // the node carries its 'scoreLimit' to the DB servers, so each of them
+    // only returns its best scored documents which are then merged by the
+    // sort elements the gather node receives from 'distribute-sort-to-cluster'
     auto const sortMode = GatherNode::evaluateSortMode(
       numberOfShards(*resolver, view)
     );
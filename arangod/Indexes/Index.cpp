@@ -254,6 +254,9 @@ Index::IndexType Index::type(char const* type) {
   if (::strcmp(type, "noaccess") == 0) {
     return TRI_IDX_TYPE_NO_ACCESS_INDEX;
   }
+  if (::strcmp(type, "ttl") == 0) {
+    return TRI_IDX_TYPE_TTL_INDEX;
+  }
 
   return TRI_IDX_TYPE_UNKNOWN;
 }
@@ -289,6 +292,8 @@ char const* Index::oldtypeName(Index::IndexType type) {
 #endif
     case TRI_IDX_TYPE_NO_ACCESS_INDEX:
       return "noaccess";
+    case TRI_IDX_TYPE_TTL_INDEX:
+      return "ttl";
     case TRI_IDX_TYPE_UNKNOWN: {
     }
   }
@@ -406,6 +411,14 @@ bool Index::Compare(VPackSlice const& lhs, VPackSlice const& rhs) {
         return false;
       }
     }
+    // rangeField must be identical if present
+    value = lhs.get("rangeField");
+    if (value.isString() || rhs.get("rangeField").isString()) {
+      if (arangodb::basics::VelocyPackHelper::compare(value, rhs.get("rangeField"),
+                                                      false) != 0) {
+        return false;
+      }
+    }
   } else if (type == IndexType::TRI_IDX_TYPE_FULLTEXT_INDEX) {
     // minLength
     value = lhs.get("minLength");
@@ -415,6 +428,15 @@ bool Index::Compare(VPackSlice const& lhs, VPackSlice const& rhs) {
         return false;
       }
     }
+  } else if (type == IndexType::TRI_IDX_TYPE_TTL_INDEX) {
+    // expireAfter
+    value = lhs.get(arangodb::StaticStrings::IndexExpireAfter);
+    if (value.isNumber()) {
+      if (arangodb::basics::VelocyPackHelper::compare(
+              value, rhs.get(arangodb::StaticStrings::IndexExpireAfter), false) != 0) {
+        return false;
+      }
+    }
   }
 #ifdef USE_IRESEARCH
   else if (type == IndexType::TRI_IDX_TYPE_IRESEARCH_LINK) {
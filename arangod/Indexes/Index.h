@@ -98,7 +98,8 @@ class Index {
 #ifdef USE_IRESEARCH
     TRI_IDX_TYPE_IRESEARCH_LINK,
 #endif
-    TRI_IDX_TYPE_NO_ACCESS_INDEX
+    TRI_IDX_TYPE_NO_ACCESS_INDEX,
+    TRI_IDX_TYPE_TTL_INDEX
   };
 
   // mode to signal how operation should behave
@@ -193,7 +193,8 @@ void InternalRestTraverserHandler::queryEngine() {
         // Save Cast BaseTraverserEngines are all of type TRAVERSER
         auto eng = static_cast<BaseTraverserEngine*>(engine);
         TRI_ASSERT(eng != nullptr);
-        eng->getEdges(keysSlice, depthSlice.getNumericValue<size_t>(), result);
+        eng->getEdges(keysSlice, depthSlice.getNumericValue<size_t>(), result,
+                      body.get("vertices").isTrue());
         break;
       }
       case BaseEngine::EngineType::SHORTESTPATH: {
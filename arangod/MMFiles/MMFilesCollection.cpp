@@ -26,11 +26,13 @@
 #include "Aql/PlanCache.h"
 #include "Basics/Exceptions.h"
 #include "Basics/FileUtils.h"
+#include "Basics/LocalTaskQueue.h"
 #include "Basics/PerformanceLogScope.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/ReadUnlocker.h"
 #include "Basics/Result.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/StringRef.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/WriteUnlocker.h"
@@ -46,6 +48,7 @@
 #include "MMFiles/MMFilesDocumentOperation.h"
 #include "MMFiles/MMFilesDocumentPosition.h"
 #include "MMFiles/MMFilesEngine.h"
+#include "MMFiles/MMFilesIndex.h"
 #include "MMFiles/MMFilesIndexElement.h"
 #include "MMFiles/MMFilesLogfileManager.h"
 #include "MMFiles/MMFilesPrimaryIndex.h"
@@ -70,6 +73,8 @@
 #include "VocBase/ManagedDocumentResult.h"
 #include "VocBase/ticks.h"
 
+#include <thread>
+
 using namespace arangodb;
 using Helper = arangodb::basics::VelocyPackHelper;
 
@@ -109,6 +114,33 @@ struct OpenIteratorState {
     }
   }
 };
+
+/// @brief result of scanning a single datafile on its own while opening a
+/// collection. for each key, only the last marker in the datafile is kept.
+/// the statistics only cover the markers of the datafile itself, the effects
+/// on documents in earlier datafiles are applied when merging the scan
+struct OpenIteratorDatafileScan {
+  struct Entry {
+    MMFilesMarker const* _marker;
+    LocalDocumentId _localDocumentId;
+    // whether the first marker of the key in the datafile was a removal
+    bool _firstRemoved;
+  };
+
+  explicit OpenIteratorDatafileScan(MMFilesDatafile* datafile)
+      : _datafile(datafile) {}
+
+  MMFilesDatafile* _datafile;
+  // the keys point into the datafile
+  std::unordered_map<StringRef, Entry> _keys;
+  MMFilesDatafileStatisticsContainer _stats;
+  TRI_voc_rid_t _maxRevision{0};
+  TRI_voc_tick_t _maxTick{0};
+  uint64_t _markers{0};
+  uint64_t _deletions{0};
+  uint64_t _documents{0};
+  bool _hasAllPersistentLocalIds{true};
+};
 }
 
 namespace {
@@ -139,6 +171,43 @@ class MMFilesIndexFillerTask : public basics::LocalTask {
   std::shared_ptr<std::vector<std::pair<LocalDocumentId, VPackSlice>>> _documents;
 };
 
+/// @brief helper class for scanning a datafile when opening a collection
+class MMFilesDatafileScanTask : public basics::LocalTask {
+ public:
+  MMFilesDatafileScanTask(std::shared_ptr<basics::LocalTaskQueue> const& queue,
+                          OpenIteratorDatafileScan* scan,
+                          std::function<bool(MMFilesMarker const*,
+                                             OpenIteratorDatafileScan*)> const& cb)
+      : LocalTask(queue), _scan(scan), _cb(cb) {}
+
+  void run() override {
+    MMFilesDatafile* datafile = _scan->_datafile;
+    try {
+      datafile->sequentialAccess();
+      datafile->willNeed();
+
+      auto cb = [this](MMFilesMarker const* marker, MMFilesDatafile*) -> bool {
+        return _cb(marker, _scan);
+      };
+      if (!TRI_IterateDatafile(datafile, cb)) {
+        _queue->setStatus(TRI_ERROR_INTERNAL);
+      }
+
+      if (datafile->isPhysical() && datafile->isSealed()) {
+        datafile->randomAccess();
+      }
+    } catch (std::exception const&) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+
+    _queue->join();
+  }
+
+ private:
+  OpenIteratorDatafileScan* _scan;
+  std::function<bool(MMFilesMarker const*, OpenIteratorDatafileScan*)> _cb;
+};
+
 /// @brief find a statistics container for a given file id
 static MMFilesDatafileStatisticsContainer* FindDatafileStats(
     OpenIteratorState* state, TRI_voc_fid_t fid) {
@@ -593,6 +662,253 @@ bool MMFilesCollection::OpenIterator(MMFilesMarker const* marker,
   return (res == TRI_ERROR_NO_ERROR);
 }
 
+/// @brief iterator for scanning a single datafile on open. unlike
+/// OpenIterator, this only looks at the datafile itself and does not touch
+/// the collection, so several datafiles can be scanned in parallel
+bool MMFilesCollection::OpenIteratorScanMarker(
+    MMFilesMarker const* marker, OpenIteratorDatafileScan* scan) {
+  MMFilesDatafile* datafile = scan->_datafile;
+  TRI_voc_tick_t const tick = marker->getTick();
+  MMFilesMarkerType const type = marker->getType();
+
+  ++scan->_markers;
+
+  if (type == TRI_DF_MARKER_VPACK_DOCUMENT ||
+      type == TRI_DF_MARKER_VPACK_REMOVE) {
+    VPackSlice const slice(reinterpret_cast<char const*>(marker) +
+                           MMFilesDatafileHelper::VPackOffset(type));
+
+    VPackSlice keySlice;
+    TRI_voc_rid_t revisionId;
+    transaction::helpers::extractKeyAndRevFromDocument(slice, keySlice,
+                                                       revisionId);
+    if (revisionId > scan->_maxRevision) {
+      scan->_maxRevision = revisionId;
+    }
+
+    VPackValueLength length;
+    char const* p = keySlice.getString(length);
+    StringRef key(p, static_cast<size_t>(length));
+
+    OpenIteratorDatafileScan::Entry entry{marker, LocalDocumentId(),
+                                          type == TRI_DF_MARKER_VPACK_REMOVE};
+
+    if (type == TRI_DF_MARKER_VPACK_DOCUMENT) {
+      uint8_t const* vpack = slice.begin();
+      if (marker->getSize() ==
+          MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT) +
+              slice.byteSize() + sizeof(LocalDocumentId::BaseType)) {
+        // we do have a LocalDocumentId stored at the end of the marker
+        uint8_t const* ptr = vpack + slice.byteSize();
+        entry._localDocumentId =
+            LocalDocumentId(encoding::readNumber<LocalDocumentId::BaseType>(
+                ptr, sizeof(LocalDocumentId::BaseType)));
+      } else {
+        entry._localDocumentId = LocalDocumentId::create();
+        scan->_hasAllPersistentLocalIds = false;
+      }
+      ++scan->_documents;
+
+      if (datafile->_dataMin == 0) {
+        datafile->_dataMin = tick;
+      }
+      if (tick > datafile->_dataMax) {
+        datafile->_dataMax = tick;
+      }
+    } else {
+      ++scan->_deletions;
+    }
+
+    auto it = scan->_keys.find(key);
+    if (it != scan->_keys.end()) {
+      // a previous revision in the same datafile is now dead
+      MMFilesMarker const* previous = (*it).second._marker;
+      if (previous->getType() == TRI_DF_MARKER_VPACK_DOCUMENT) {
+        int64_t size =
+            MMFilesDatafileHelper::AlignedMarkerSize<int64_t>(previous);
+        scan->_stats.numberAlive--;
+        scan->_stats.sizeAlive -= size;
+        scan->_stats.numberDead++;
+        scan->_stats.sizeDead += size;
+      }
+      entry._firstRemoved = (*it).second._firstRemoved;
+      (*it).second = entry;
+    } else {
+      scan->_keys.emplace(key, entry);
+    }
+
+    if (type == TRI_DF_MARKER_VPACK_DOCUMENT) {
+      scan->_stats.numberAlive++;
+      scan->_stats.sizeAlive +=
+          MMFilesDatafileHelper::AlignedMarkerSize<int64_t>(marker);
+    } else {
+      scan->_stats.numberDeletions++;
+    }
+  }
+
+  if (datafile->_tickMin == 0) {
+    datafile->_tickMin = tick;
+  }
+
+  if (tick > datafile->_tickMax) {
+    datafile->_tickMax = tick;
+  }
+
+  if (tick > scan->_maxTick && type != TRI_DF_MARKER_HEADER &&
+      type != TRI_DF_MARKER_FOOTER && type != TRI_DF_MARKER_COL_HEADER &&
+      type != TRI_DF_MARKER_PROLOGUE) {
+    scan->_maxTick = tick;
+  }
+
+  return true;
+}
+
+/// @brief apply the scan of a datafile to the collection. the scans must be
+/// merged in the order of the datafiles
+int MMFilesCollection::OpenIteratorMergeScan(OpenIteratorDatafileScan* scan,
+                                             OpenIteratorState* state) {
+  LogicalCollection* collection = state->_collection;
+  auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+  TRI_ASSERT(physical != nullptr);
+  transaction::Methods* trx = state->_trx;
+  TRI_voc_fid_t const fid = scan->_datafile->fid();
+
+  physical->setRevision(scan->_maxRevision, false);
+  if (scan->_maxTick > physical->maxTick()) {
+    physical->maxTick(scan->_maxTick);
+  }
+  state->_documents += scan->_documents;
+  state->_deletions += scan->_deletions;
+  if (!scan->_hasAllPersistentLocalIds) {
+    state->_hasAllPersistentLocalIds = false;
+  }
+
+  if (scan->_markers == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  state->_fid = fid;
+  state->_dfi = FindDatafileStats(state, fid);
+  state->_dfi->update(scan->_stats);
+
+  for (auto const& it : scan->_keys) {
+    OpenIteratorDatafileScan::Entry const& entry = it.second;
+    MMFilesMarker const* marker = entry._marker;
+    bool const isDocument =
+        (marker->getType() == TRI_DF_MARKER_VPACK_DOCUMENT);
+    VPackSlice const slice(reinterpret_cast<char const*>(marker) +
+                           MMFilesDatafileHelper::VPackOffset(marker->getType()));
+    uint8_t const* vpack = slice.begin();
+    VPackSlice keySlice = transaction::helpers::extractKeyFromDocument(slice);
+
+    collection->keyGenerator()->track(it.first.data(), it.first.size());
+
+    MMFilesSimpleIndexElement* found =
+        state->_primaryIndex->lookupKeyRef(trx, keySlice, state->_mdr);
+
+    if (found != nullptr && found->isSet()) {
+      // the revision from an earlier datafile is now dead
+      LocalDocumentId const oldLocalDocumentId = found->localDocumentId();
+      MMFilesDocumentPosition const old =
+          physical->lookupDocument(oldLocalDocumentId);
+      uint8_t const* oldVPack = static_cast<uint8_t const*>(old.dataptr());
+
+      if (oldVPack != nullptr) {
+        MMFilesMarker const* oldMarker = reinterpret_cast<MMFilesMarker const*>(
+            oldVPack -
+            MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT));
+        int64_t size =
+            MMFilesDatafileHelper::AlignedMarkerSize<int64_t>(oldMarker);
+        MMFilesDatafileStatisticsContainer* dfi =
+            FindDatafileStats(state, old.fid());
+        dfi->numberAlive--;
+        dfi->sizeAlive -= size;
+        dfi->numberDead++;
+        dfi->sizeDead += size;
+      }
+
+      if (isDocument) {
+        found->updateLocalDocumentId(
+            entry._localDocumentId,
+            static_cast<uint32_t>(keySlice.begin() - vpack));
+        physical->removeLocalDocumentId(oldLocalDocumentId,
+                                        entry._firstRemoved);
+        physical->insertLocalDocumentId(entry._localDocumentId, vpack, fid,
+                                        false, false);
+      } else {
+        TRI_ASSERT(oldVPack != nullptr);
+        state->_primaryIndex->removeKey(trx, oldLocalDocumentId,
+                                        VPackSlice(oldVPack), state->_mdr,
+                                        Index::OperationMode::normal);
+        physical->removeLocalDocumentId(oldLocalDocumentId, true);
+      }
+    } else if (isDocument) {
+      physical->insertLocalDocumentId(entry._localDocumentId, vpack, fid,
+                                      false, false);
+
+      Result res = state->_primaryIndex->insertKey(
+          trx, entry._localDocumentId, VPackSlice(vpack), state->_mdr,
+          Index::OperationMode::normal);
+
+      if (res.fail()) {
+        physical->removeLocalDocumentId(entry._localDocumentId, false);
+        LOG_TOPIC(ERR, arangodb::Logger::ENGINES)
+            << "inserting document into primary index failed with error: "
+            << res.errorMessage();
+
+        return res.errorNumber();
+      }
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+void MMFilesCollection::iterateDatafilesOnLoadParallel(
+    OpenIteratorState* state, size_t concurrency) {
+  READ_LOCKER(readLocker, _filesLock);
+
+  // same order as in iterateDatafiles
+  std::vector<MMFilesDatafile*> files;
+  files.reserve(_datafiles.size() + _compactors.size() + _journals.size());
+  files.insert(files.end(), _datafiles.begin(), _datafiles.end());
+  files.insert(files.end(), _compactors.begin(), _compactors.end());
+  files.insert(files.end(), _journals.begin(), _journals.end());
+
+  auto poster = [](std::function<void()> fn) -> void {
+    SchedulerFeature::SCHEDULER->queue(RequestPriority::LOW, fn);
+  };
+  std::function<bool(MMFilesMarker const*, OpenIteratorDatafileScan*)> const
+      cb = &MMFilesCollection::OpenIteratorScanMarker;
+
+  // scan a batch of datafiles in parallel, then merge their results. the
+  // batches limit the memory used for the keys of the scans
+  for (size_t offset = 0; offset < files.size(); offset += concurrency) {
+    size_t const n = (std::min)(concurrency, files.size() - offset);
+    std::vector<std::unique_ptr<OpenIteratorDatafileScan>> scans;
+    scans.reserve(n);
+
+    auto queue = std::make_shared<arangodb::basics::LocalTaskQueue>(poster);
+    for (size_t i = 0; i < n; ++i) {
+      scans.emplace_back(new OpenIteratorDatafileScan(files[offset + i]));
+      queue->enqueue(std::make_shared<MMFilesDatafileScanTask>(
+          queue, scans.back().get(), cb));
+    }
+    queue->dispatchAndWait();
+
+    if (queue->status() != TRI_ERROR_NO_ERROR) {
+      // like the sequential iteration, stop at the first broken datafile
+      return;
+    }
+
+    for (auto& scan : scans) {
+      if (OpenIteratorMergeScan(scan.get(), state) != TRI_ERROR_NO_ERROR) {
+        return;
+      }
+    }
+  }
+}
+
 MMFilesCollection::MMFilesCollection(
     LogicalCollection& collection,
     arangodb::velocypack::Slice const& info
@@ -1142,6 +1458,10 @@ MMFilesDatafile* MMFilesCollection::createDatafile(TRI_voc_fid_t fid,
   // datafile is there now
   TRI_ASSERT(datafile != nullptr);
 
+  // journals and compactors are written to, so they profit most from
+  // fewer TLB misses
+  datafile->adviseHugePages();
+
   if (isCompactor) {
     LOG_TOPIC(TRACE, arangodb::Logger::DATAFILES) << "created new compactor '"
                                                   << datafile->getName() << "'";
@@ -1396,13 +1716,34 @@ void MMFilesCollection::figuresSpecific(
     builder->close();  // compactionStatus
   }
 
+  // only the hash-based indexes can use huge pages. not all other index
+  // types derive from MMFilesIndex
+  size_t hugePageIndexSize = 0;
+  {
+    READ_LOCKER(guard, _indexesLock);
+    for (auto const& idx : _indexes) {
+      switch (idx->type()) {
+        case Index::TRI_IDX_TYPE_PRIMARY_INDEX:
+        case Index::TRI_IDX_TYPE_EDGE_INDEX:
+        case Index::TRI_IDX_TYPE_HASH_INDEX:
+          hugePageIndexSize +=
+              static_cast<MMFilesIndex const*>(idx.get())->hugePageMemory();
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
   // add file statistics
   READ_LOCKER(readLocker, _filesLock);
 
+  size_t hugePageFileSize = 0;
   size_t sizeDatafiles = 0;
   builder->add("datafiles", VPackValue(VPackValueType::Object));
   for (auto const& it : _datafiles) {
     sizeDatafiles += it->initSize();
+    hugePageFileSize += it->hugePageSize();
   }
 
   builder->add("count", VPackValue(_datafiles.size()));
@@ -1412,6 +1753,7 @@ void MMFilesCollection::figuresSpecific(
   size_t sizeJournals = 0;
   for (auto const& it : _journals) {
     sizeJournals += it->initSize();
+    hugePageFileSize += it->hugePageSize();
   }
   builder->add("journals", VPackValue(VPackValueType::Object));
   builder->add("count", VPackValue(_journals.size()));
@@ -1421,12 +1763,18 @@ void MMFilesCollection::figuresSpecific(
   size_t sizeCompactors = 0;
   for (auto const& it : _compactors) {
     sizeCompactors += it->initSize();
+    hugePageFileSize += it->hugePageSize();
   }
   builder->add("compactors", VPackValue(VPackValueType::Object));
   builder->add("count", VPackValue(_compactors.size()));
   builder->add("fileSize", VPackValue(sizeCompactors));
   builder->close();  // compactors
 
+  builder->add("hugePages", VPackValue(VPackValueType::Object));
+  builder->add("fileSize", VPackValue(hugePageFileSize));
+  builder->add("indexSize", VPackValue(hugePageIndexSize));
+  builder->close();  // hugePages
+
   builder->add("revisions", VPackValue(VPackValueType::Object));
   builder->add("count", VPackValue(_revisionsCache.size()));
   builder->add("size", VPackValue(_revisionsCache.memoryUsage()));
@@ -1991,13 +2339,28 @@ int MMFilesCollection::iterateMarkersOnLoad(transaction::Methods* trx) {
     openState._initialCount = _initialCount;
   }
 
-  // read all documents and fill primary index
-  auto cb = [&openState](MMFilesMarker const* marker,
-                         MMFilesDatafile* datafile) -> bool {
-    return OpenIterator(marker, &openState, datafile);
-  };
+  // read all documents and fill primary index. with several datafiles,
+  // these are scanned in parallel
+  size_t const concurrency =
+      (std::max)(static_cast<size_t>(std::thread::hardware_concurrency()),
+                 static_cast<size_t>(1));
+  size_t numberOfFiles;
+  {
+    READ_LOCKER(readLocker, _filesLock);
+    numberOfFiles = _datafiles.size() + _compactors.size() + _journals.size();
+  }
 
-  iterateDatafiles(cb);
+  if (concurrency > 1 && numberOfFiles > 1 &&
+      SchedulerFeature::SCHEDULER != nullptr) {
+    iterateDatafilesOnLoadParallel(&openState, concurrency);
+  } else {
+    auto cb = [&openState](MMFilesMarker const* marker,
+                           MMFilesDatafile* datafile) -> bool {
+      return OpenIterator(marker, &openState, datafile);
+    };
+
+    iterateDatafiles(cb);
+  }
 
   LOG_TOPIC(TRACE, arangodb::Logger::ENGINES)
       << "found " << openState._documents << " document markers, "
@@ -2278,10 +2641,8 @@ std::shared_ptr<Index> MMFilesCollection::createIndex(transaction::Methods* trx,
     THROW_ARANGO_EXCEPTION(res);
   }
 
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(
-      _logicalCollection->vocbase());
-#endif
+      &_logicalCollection.vocbase());
   // Until here no harm is done if sth fails. The shared ptr will clean up. if
   // left before
 
@@ -3076,6 +3437,21 @@ Result MMFilesCollection::insert(transaction::Methods* trx,
   return res;
 }
 
+/// @brief inserts multiple documents, acquiring the collection write lock
+/// only once for the whole batch instead of once per document
+void MMFilesCollection::insertMany(transaction::Methods* trx,
+                                   VPackSlice const documents,
+                                   ManagedDocumentResult& result,
+                                   OperationOptions& options, bool lock,
+                                   InsertManyCallback const& cb) {
+  bool const useDeadlockDetector =
+    (lock && !trx->isSingleOperationTransaction() && !trx->state()->hasHint(transaction::Hints::Hint::NO_DLD));
+  arangodb::MMFilesCollectionWriteLocker collectionLocker(
+      this, useDeadlockDetector, trx->state(), lock);
+
+  PhysicalCollection::insertMany(trx, documents, result, options, false, cb);
+}
+
 bool MMFilesCollection::isFullyCollected() const {
   int64_t uncollected = _uncollectedLogfileEntries.load();
   return (uncollected == 0);
@@ -3599,6 +3975,27 @@ Result MMFilesCollection::replace(
     return TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD;
   }
 
+  // the new document only depends on the old document's _key and _id,
+  // which are known up front. build it before acquiring the collection
+  // lock, so concurrent writers only serialize on the index and WAL updates
+  TRI_voc_rid_t revisionId = 0;
+  transaction::BuilderLeaser builder(trx);
+  bool const prebuilt = key.isString();
+  if (prebuilt) {
+    transaction::BuilderLeaser stub(trx);
+    stub->openObject();
+    stub->add(StaticStrings::KeyString, key);
+    addIdAttribute(*stub.get());
+    stub->close();
+
+    Result res = newObjectForReplace(trx, stub->slice(), newSlice,
+                                     isEdgeCollection, *builder.get(),
+                                     options.isRestore, revisionId);
+    if (res.fail()) {
+      return res;
+    }
+  }
+
   bool const useDeadlockDetector =
       (lock && !trx->isSingleOperationTransaction() && !trx->state()->hasHint(transaction::Hints::Hint::NO_DLD));
   arangodb::MMFilesCollectionWriteLocker collectionLocker(
@@ -3641,14 +4038,13 @@ Result MMFilesCollection::replace(
     }
   }
 
-  // merge old and new values
-  TRI_voc_rid_t revisionId;
-  transaction::BuilderLeaser builder(trx);
-  res = newObjectForReplace(trx, oldDoc, newSlice, isEdgeCollection, *builder.get(),
-                            options.isRestore, revisionId);
+  if (!prebuilt) {
+    res = newObjectForReplace(trx, oldDoc, newSlice, isEdgeCollection,
+                              *builder.get(), options.isRestore, revisionId);
 
-  if (res.fail()) {
-    return res;
+    if (res.fail()) {
+      return res;
+    }
   }
 
   if (options.recoveryData == nullptr) {
@@ -48,6 +48,7 @@ class ManagedDocumentResult;
 struct MMFilesDocumentOperation;
 class MMFilesPrimaryIndex;
 class MMFilesWalMarker;
+struct OpenIteratorDatafileScan;
 struct OpenIteratorState;
 class Result;
 class TransactionState;
@@ -326,6 +327,12 @@ class MMFilesCollection final : public PhysicalCollection {
                 TRI_voc_tick_t& resultMarkerTick, bool lock,
                 TRI_voc_tick_t& revisionId) override;
 
+  void insertMany(arangodb::transaction::Methods* trx,
+                  arangodb::velocypack::Slice const documents,
+                  arangodb::ManagedDocumentResult& result,
+                  OperationOptions& options, bool lock,
+                  InsertManyCallback const& cb) override;
+
   Result update(arangodb::transaction::Methods* trx,
                 arangodb::velocypack::Slice const newSlice,
                 arangodb::ManagedDocumentResult& result,
@@ -404,6 +411,15 @@ class MMFilesCollection final : public PhysicalCollection {
                                               OpenIteratorState* state);
   static bool OpenIterator(MMFilesMarker const* marker, OpenIteratorState* data,
                            MMFilesDatafile* datafile);
+  static bool OpenIteratorScanMarker(MMFilesMarker const* marker,
+                                     OpenIteratorDatafileScan* scan);
+  static int OpenIteratorMergeScan(OpenIteratorDatafileScan* scan,
+                                   OpenIteratorState* state);
+
+  /// @brief iterate all datafiles on load, scanning several datafiles in
+  /// parallel and merging their results in datafile order
+  void iterateDatafilesOnLoadParallel(OpenIteratorState* state,
+                                      size_t concurrency);
 
   /// @brief create statistics for a datafile, using the stats provided
   void createStats(TRI_voc_fid_t fid,
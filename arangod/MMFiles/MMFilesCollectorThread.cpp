@@ -32,6 +32,7 @@
 #include "Basics/memory-map.h"
 #include "Logger/Logger.h"
 #include "MMFiles/MMFilesCollection.h"
+#include "MMFiles/MMFilesCompactionFeature.h"
 #include "MMFiles/MMFilesCompactionLocker.h"
 #include "MMFiles/MMFilesDatafileHelper.h"
 #include "MMFiles/MMFilesEngine.h"
@@ -1011,6 +1012,10 @@ int MMFilesCollectorThread::transferMarkers(MMFilesWalLogfile* logfile,
     LOG_TOPIC(TRACE, Logger::COLLECTOR) << "wal collector transferred markers for '"
              << collection->name() << ", number of bytes transferred: " << numBytesTransferred;
 
+    // the collector is never delayed, but its writes reduce the budget of
+    // the compactors
+    MMFilesCompactionFeature::COMPACTOR->ioRateLimiter().account(numBytesTransferred);
+
     if (res == TRI_ERROR_NO_ERROR && !cache->operations->empty()) {
       queueOperations(logfile, cache);
     }
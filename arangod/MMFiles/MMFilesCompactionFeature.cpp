@@ -49,7 +49,10 @@ MMFilesCompactionFeature::MMFilesCompactionFeature(
     _maxResultFilesize(128 * 1024 * 1024),
     _deadNumberThreshold(16384),
     _deadSizeThreshold(128 * 1024),
-    _deadShare(0.1) { 
+    _deadShare(0.1),
+    _threads(1),
+    _maxIoRate(0),
+    _ioRateLimiter(new MMFilesIoRateLimiter(0)) { 
   setOptional(true);
   onlyEnabledWith("MMFilesEngine");
 
@@ -90,6 +93,12 @@ void MMFilesCompactionFeature::collectOptions(std::shared_ptr<options::ProgramOp
 
   options->addOption("--compaction.max-file-size-factor", "how large the resulting file may be in comparison to the collections '--database.maximal-journal-size' setting",
                      new UInt64Parameter(&_maxSizeFactor));
+
+  options->addOption("--compaction.threads", "maximum number of collections per database that are compacted concurrently",
+                     new UInt64Parameter(&_threads));
+
+  options->addOption("--compaction.max-io-rate", "maximum number of bytes per second written by compaction and WAL collection together (0 = unlimited)",
+                     new UInt64Parameter(&_maxIoRate));
 }
 
 void MMFilesCompactionFeature::validateOptions(std::shared_ptr<options::ProgramOptions> options) {
@@ -123,4 +132,12 @@ void MMFilesCompactionFeature::validateOptions(std::shared_ptr<options::ProgramO
     _maxSizeFactor = 1;
   }
 
+  if (_threads < 1) {
+    LOG_TOPIC(WARN, Logger::COMPACTOR)
+      << "compaction.threads should be at least: 1";
+    _threads = 1;
+  }
+
+  _ioRateLimiter.reset(new MMFilesIoRateLimiter(_maxIoRate));
+
 }
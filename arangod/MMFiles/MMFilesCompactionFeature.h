@@ -25,6 +25,7 @@
 #define ARANGOD_MMFILES_COMPACTION_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "MMFiles/MMFilesIoRateLimiter.h"
 
 namespace arangodb {
 namespace options {
@@ -71,6 +72,17 @@ class MMFilesCompactionFeature : public application_features::ApplicationFeature
   /// if this value if higher than the threshold, the datafile will be compacted
   double _deadShare;
 
+  /// @brief maximum number of collections of a database that are compacted
+  /// concurrently
+  uint64_t _threads;
+
+  /// @brief maximum number of bytes per second written by the compactors
+  /// and the WAL collector together (0 = unlimited)
+  uint64_t _maxIoRate;
+
+  /// @brief rate limiter shared by the compactors and the WAL collector
+  std::unique_ptr<MMFilesIoRateLimiter> _ioRateLimiter;
+
   MMFilesCompactionFeature(MMFilesCompactionFeature const&) = delete;
   MMFilesCompactionFeature& operator=(MMFilesCompactionFeature const&) = delete;
 
@@ -116,6 +128,12 @@ class MMFilesCompactionFeature : public application_features::ApplicationFeature
   /// if this value if higher than the threshold, the datafile will be compacted
   double deadShare() const { return _deadShare; }
 
+  /// @brief maximum number of collections of a database that are compacted
+  /// concurrently
+  size_t threads() const { return static_cast<size_t>(_threads); }
+
+  /// @brief rate limiter shared by the compactors and the WAL collector
+  MMFilesIoRateLimiter& ioRateLimiter() const { return *_ioRateLimiter; }
   
  public:
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
@@ -29,6 +29,7 @@
 #include "Basics/conversions.h"
 #include "Basics/files.h"
 #include "Basics/FileUtils.h"
+#include "Basics/LocalTaskQueue.h"
 #include "Basics/memory-map.h"
 #include "Logger/Logger.h"
 #include "MMFiles/MMFilesCollection.h"
@@ -39,6 +40,8 @@
 #include "MMFiles/MMFilesEngine.h"
 #include "MMFiles/MMFilesIndexElement.h"
 #include "MMFiles/MMFilesPrimaryIndex.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Utils/SingleCollectionTransaction.h"
 #include "Transaction/Helpers.h"
@@ -78,10 +81,30 @@ struct CompactionContext {
   LogicalCollection* _collection;
   MMFilesDatafile* _compactor;
   MMFilesDatafileStatisticsContainer _dfi;
+  uint64_t _bytesWritten;
   bool _keepDeletions;
 
   CompactionContext(CompactionContext const&) = delete;
-  CompactionContext() : _trx(nullptr), _collection(nullptr), _compactor(nullptr), _dfi(), _keepDeletions(true) {}
+  CompactionContext() : _trx(nullptr), _collection(nullptr), _compactor(nullptr), _dfi(), _bytesWritten(0), _keepDeletions(true) {}
+};
+
+/// @brief task compacting a single collection on a scheduler thread
+class CompactCollectionTask : public basics::LocalTask {
+ public:
+  CompactCollectionTask(std::shared_ptr<basics::LocalTaskQueue> const& queue,
+                        std::function<void()> const& cb)
+      : LocalTask(queue), _cb(cb) {}
+
+  void run() override {
+    try {
+      _cb();
+    } catch (...) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+  }
+
+ private:
+  std::function<void()> _cb;
 };
 }
 
@@ -376,7 +399,7 @@ MMFilesCompactorThread::CompactionInitialContext MMFilesCompactorThread::getComp
 }
 
 /// @brief compact the specified datafiles
-void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
+uint64_t MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
     std::vector<CompactionInfo> const& toCompact) {
   TRI_ASSERT(collection != nullptr);
   auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
@@ -429,6 +452,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
       if (res != TRI_ERROR_NO_ERROR) {
         THROW_ARANGO_EXCEPTION_MESSAGE(res, std::string("cannot write document marker into compactor file: ") + TRI_errno_string(res)); 
       }
+      context->_bytesWritten += marker->getSize();
 
       // let marker point to the new position
       uint8_t const* dataptr = reinterpret_cast<uint8_t const*>(result) + MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT);
@@ -448,6 +472,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
         if (res != TRI_ERROR_NO_ERROR) {
           THROW_ARANGO_EXCEPTION_MESSAGE(res, std::string("cannot write remove marker into compactor file: ") + TRI_errno_string(res));
         }
+        context->_bytesWritten += marker->getSize();
 
         // update datafile info
         context->_dfi.numberDeletions++;
@@ -476,7 +501,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
   if (initial._failed) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "could not create initialize compaction";
 
-    return;
+    return 0;
   }
 
   LOG_TOPIC(DEBUG, Logger::COMPACTOR) << "compaction writes to be executed for collection '" << collection->id() << "', number of source datafiles: " << n << ", target datafile size: " << initial._targetSize;
@@ -488,10 +513,10 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
     compactor = physical->createCompactor(initial._fid, static_cast<uint32_t>(initial._targetSize));
   } catch (std::exception const& ex) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "could not create compactor file: " << ex.what();
-    return;
+    return 0;
   } catch (...) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "could not create compactor file: unknown exception";
-    return;
+    return 0;
   }
 
   TRI_ASSERT(compactor != nullptr);
@@ -507,7 +532,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
 
   if (!res.ok()) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "error during compaction: " << res.errorMessage();
-    return;
+    return 0;
   }
 
   // now compact all datafiles
@@ -537,7 +562,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
       LOG_TOPIC(WARN, Logger::COMPACTOR) << "failed to compact datafile '" << df->getName() << "'";
       // compactor file does not need to be removed now. will be removed on next
       // startup
-      return;
+      return context->_bytesWritten;
     }
 
     ++nrCombined;
@@ -563,7 +588,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
   if (physical->closeCompactor(compactor) != TRI_ERROR_NO_ERROR) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "could not close compactor file";
     // TODO: how do we recover from this state?
-    return;
+    return context->_bytesWritten;
   }
 
   if (context->_dfi.numberAlive == 0 && context->_dfi.numberDead == 0 &&
@@ -656,10 +681,13 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
       }
     }
   }
+
+  return context->_bytesWritten;
 }
 
 /// @brief checks all datafiles of a collection
-bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bool& wasBlocked) {
+bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bool& wasBlocked,
+                                               uint64_t& bytesWritten) {
   // we can hopefully get away without the lock here...
   //  if (! document->isFullyCollected()) {
   //    return false;
@@ -890,7 +918,7 @@ bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bo
   TRI_ASSERT(reason != nullptr);
   physical->setCompactionStatus(reason);
   physical->setNextCompactionStartIndex(start);
-  compactDatafiles(collection, toCompact);
+  bytesWritten += compactDatafiles(collection, toCompact);
 
   return true;
 }
@@ -905,10 +933,125 @@ void MMFilesCompactorThread::signal() {
   locker.signal();
 }
 
+/// @brief sort the collections so that the ones with the most reclaimable
+/// bytes come first
+void MMFilesCompactorThread::sortByReclaimableSize(
+    std::vector<std::shared_ptr<arangodb::LogicalCollection>>& collections) {
+  std::vector<std::pair<int64_t, std::shared_ptr<arangodb::LogicalCollection>>> ranked;
+  ranked.reserve(collections.size());
+
+  for (auto& collection : collections) {
+    auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+    TRI_ASSERT(physical != nullptr);
+    ranked.emplace_back(physical->_datafileStatistics.all().sizeDead, collection);
+  }
+
+  // stable, so that collections without dead bytes keep their order
+  std::stable_sort(ranked.begin(), ranked.end(),
+    [](std::pair<int64_t, std::shared_ptr<arangodb::LogicalCollection>> const& lhs,
+       std::pair<int64_t, std::shared_ptr<arangodb::LogicalCollection>> const& rhs) {
+      return lhs.first > rhs.first;
+    });
+
+  for (size_t i = 0; i < ranked.size(); ++i) {
+    collections[i] = std::move(ranked[i].second);
+  }
+}
+
+/// @brief compact a single collection if it is loaded and due
+bool MMFilesCompactorThread::processCollection(LogicalCollection* collection,
+                                               uint64_t& bytesWritten) {
+  MMFilesEngine* engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
+  bool worked = false;
+
+  auto callback = [this, &collection, &worked, &engine, &bytesWritten]() -> void {
+    if (collection->status() != TRI_VOC_COL_STATUS_LOADED &&
+        collection->status() != TRI_VOC_COL_STATUS_UNLOADING) {
+      return;
+    }
+
+    bool doCompact = static_cast<MMFilesCollection*>(collection->getPhysical())->doCompact();
+
+    if (engine->isCompactionDisabled()) {
+      doCompact = false;
+    }
+
+    // for document collection, compactify datafiles
+    if (collection->status() == TRI_VOC_COL_STATUS_LOADED && doCompact) {
+      // check whether someone else holds a read-lock on the compaction
+      // lock
+      
+      auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+      TRI_ASSERT(physical != nullptr);
+
+      MMFilesTryCompactionLocker compactionLocker(physical);
+
+      if (!compactionLocker.isLocked()) {
+        // someone else is holding the compactor lock, we'll not compact
+        return;
+      }
+
+      try {
+        double const now = TRI_microtime();
+        if (physical->lastCompactionStamp() + MMFilesCompactionFeature::COMPACTOR->compactionCollectionInterval() <= now) {
+          auto ce = arangodb::MMFilesCollection::toMMFilesCollection(collection)
+                        ->ditches()
+                        ->createMMFilesCompactionDitch(__FILE__, __LINE__);
+
+          if (ce == nullptr) {
+            // out of memory
+            LOG_TOPIC(WARN, Logger::COMPACTOR) << "out of memory when trying to create compaction ditch";
+          } else {
+            try {
+              bool wasBlocked = false;
+              worked = compactCollection(collection, wasBlocked, bytesWritten);
+
+              if (!worked && !wasBlocked) {
+                // set compaction stamp
+                physical->lastCompactionStamp(now);
+              }
+              // if we worked or were blocked, then we don't set the compaction stamp to
+              // force another round of compaction
+            } catch (std::exception const& ex) {
+              LOG_TOPIC(ERR, Logger::COMPACTOR) << "caught exception during compaction: " << ex.what();
+            } catch (...) {
+              LOG_TOPIC(ERR, Logger::COMPACTOR) << "an unknown exception occurred during compaction";
+              // in case an error occurs, we must still free this ditch
+            }
+
+            arangodb::MMFilesCollection::toMMFilesCollection(collection)
+                ->ditches()
+                ->freeDitch(ce);
+          }
+        }
+      } catch (std::exception const& ex) {
+        LOG_TOPIC(ERR, Logger::COMPACTOR) << "caught exception during compaction: " << ex.what();
+      } catch (...) {
+        // in case an error occurs, we must still relase the lock
+        LOG_TOPIC(ERR, Logger::COMPACTOR) << "an unknown exception occurred during compaction";
+      }
+    }
+  };
+
+  if (!collection->tryExecuteWhileStatusLocked(callback)) {
+    return false;
+  }
+
+  if (worked) {
+    // signal the cleanup thread that we worked and that it can now wake
+    // up
+    CONDITION_LOCKER(locker, _condition);
+    locker.signal();
+  }
+
+  return worked;
+}
+
 void MMFilesCompactorThread::run() {
   MMFilesEngine* engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
   std::vector<std::shared_ptr<arangodb::LogicalCollection>> collections;
   int numCompacted = 0;
+  uint64_t bytesWritten = 0;
   while (true) {
     // keep initial _state value as vocbase->_state might change during
     // compaction loop
@@ -917,108 +1060,73 @@ void MMFilesCompactorThread::run() {
     try {
       engine->tryPreventCompaction(
         &_vocbase,
-        [this, &numCompacted, &collections, &engine](TRI_vocbase_t* vocbase) {
+        [this, &numCompacted, &collections, &engine, &bytesWritten](TRI_vocbase_t* vocbase) {
         // compaction is currently allowed
         numCompacted = 0;
 
         try {
           // copy all collections
           collections = _vocbase.collections(false);
+          // collections that accumulate dead space quickly go first
+          sortByReclaimableSize(collections);
         } catch (...) {
           collections.clear();
         }
-  
-        for (auto& collection : collections) {
-          bool worked = false;
-            
-          if (engine->isCompactionDisabled()) {
-            continue;
-          }
 
-          auto callback = [this, &collection, &worked, &engine]() -> void {
-            if (collection->status() != TRI_VOC_COL_STATUS_LOADED &&
-                collection->status() != TRI_VOC_COL_STATUS_UNLOADING) {
-              return;
-            }
-
-            bool doCompact = static_cast<MMFilesCollection*>(collection->getPhysical())->doCompact();
+        size_t const concurrency = MMFilesCompactionFeature::COMPACTOR->threads();
 
+        if (concurrency <= 1 || collections.size() <= 1 ||
+            SchedulerFeature::SCHEDULER == nullptr) {
+          for (auto& collection : collections) {
             if (engine->isCompactionDisabled()) {
-              doCompact = false;
+              continue;
             }
 
-            // for document collection, compactify datafiles
-            if (collection->status() == TRI_VOC_COL_STATUS_LOADED && doCompact) {
-              // check whether someone else holds a read-lock on the compaction
-              // lock
-              
-              auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
-              TRI_ASSERT(physical != nullptr);
-
-              MMFilesTryCompactionLocker compactionLocker(physical);
-
-              if (!compactionLocker.isLocked()) {
-                // someone else is holding the compactor lock, we'll not compact
-                return;
-              }
-
-              try {
-                double const now = TRI_microtime();
-                if (physical->lastCompactionStamp() + MMFilesCompactionFeature::COMPACTOR->compactionCollectionInterval() <= now) {
-                  auto ce = arangodb::MMFilesCollection::toMMFilesCollection(collection.get())
-                                ->ditches()
-                                ->createMMFilesCompactionDitch(__FILE__, __LINE__);
-
-                  if (ce == nullptr) {
-                    // out of memory
-                    LOG_TOPIC(WARN, Logger::COMPACTOR) << "out of memory when trying to create compaction ditch";
-                  } else {
-                    try {
-                      bool wasBlocked = false;
-                      worked = compactCollection(collection.get(), wasBlocked);
-
-                      if (!worked && !wasBlocked) {
-                        // set compaction stamp
-                        physical->lastCompactionStamp(now);
-                      }
-                      // if we worked or were blocked, then we don't set the compaction stamp to
-                      // force another round of compaction
-                    } catch (std::exception const& ex) {
-                      LOG_TOPIC(ERR, Logger::COMPACTOR) << "caught exception during compaction: " << ex.what();
-                    } catch (...) {
-                      LOG_TOPIC(ERR, Logger::COMPACTOR) << "an unknown exception occurred during compaction";
-                      // in case an error occurs, we must still free this ditch
-                    }
-
-                    arangodb::MMFilesCollection::toMMFilesCollection(collection.get())
-                        ->ditches()
-                        ->freeDitch(ce);
-                  }
-                }
-              } catch (std::exception const& ex) {
-                LOG_TOPIC(ERR, Logger::COMPACTOR) << "caught exception during compaction: " << ex.what();
-              } catch (...) {
-                // in case an error occurs, we must still relase the lock
-                LOG_TOPIC(ERR, Logger::COMPACTOR) << "an unknown exception occurred during compaction";
-              }
+            if (processCollection(collection.get(), bytesWritten)) {
+              ++numCompacted;
             }
-          };
-
-          if (!collection->tryExecuteWhileStatusLocked(callback)) {
-            continue;
           }
+          return;
+        }
 
-          if (worked) {
-            ++numCompacted;
+        // compact batches of collections in parallel. the batches keep the
+        // order of the ranking
+        auto poster = [](std::function<void()> fn) -> void {
+          SchedulerFeature::SCHEDULER->queue(RequestPriority::LOW, fn);
+        };
+        std::atomic<int> compacted(0);
+        std::atomic<uint64_t> written(0);
+
+        for (size_t offset = 0; offset < collections.size(); offset += concurrency) {
+          if (engine->isCompactionDisabled()) {
+            break;
+          }
 
-            // signal the cleanup thread that we worked and that it can now wake
-            // up
-            CONDITION_LOCKER(locker, _condition);
-            locker.signal();
+          size_t const n = (std::min)(concurrency, collections.size() - offset);
+          auto queue = std::make_shared<arangodb::basics::LocalTaskQueue>(poster);
+          for (size_t i = 0; i < n; ++i) {
+            LogicalCollection* collection = collections[offset + i].get();
+            queue->enqueue(std::make_shared<CompactCollectionTask>(
+                queue, [this, collection, &compacted, &written]() {
+                  uint64_t bytes = 0;
+                  if (processCollection(collection, bytes)) {
+                    ++compacted;
+                  }
+                  written += bytes;
+                }));
           }
+          queue->dispatchAndWait();
         }
+
+        numCompacted = compacted.load();
+        bytesWritten += written.load();
       }, true);
 
+      // pay for the bytes written outside of the compaction lock, so that
+      // waiting does not block compaction blockers or other databases
+      MMFilesCompactionFeature::COMPACTOR->ioRateLimiter().throttle(bytesWritten);
+      bytesWritten = 0;
+
       if (numCompacted > 0) {
         // no need to sleep long or go into wait state if we worked.
         // maybe there's still work left
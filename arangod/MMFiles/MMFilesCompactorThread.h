@@ -85,11 +85,22 @@ class MMFilesCompactorThread final : public Thread {
     transaction::Methods* trx, LogicalCollection* collection,
     std::vector<CompactionInfo> const& toCompact);
 
-  /// @brief compact the specified datafiles
-  void compactDatafiles(LogicalCollection* collection, std::vector<CompactionInfo> const&);
+  /// @brief compact the specified datafiles. returns the number of bytes
+  /// written to the compactor file
+  uint64_t compactDatafiles(LogicalCollection* collection, std::vector<CompactionInfo> const&);
 
   /// @brief checks all datafiles of a collection
-  bool compactCollection(LogicalCollection* collection, bool& wasBlocked);
+  bool compactCollection(LogicalCollection* collection, bool& wasBlocked,
+                         uint64_t& bytesWritten);
+
+  /// @brief compact a single collection if it is loaded and due. returns
+  /// whether or not the collection was compacted
+  bool processCollection(LogicalCollection* collection, uint64_t& bytesWritten);
+
+  /// @brief sort the collections so that the ones with the most reclaimable
+  /// bytes come first
+  static void sortByReclaimableSize(
+      std::vector<std::shared_ptr<arangodb::LogicalCollection>>& collections);
 
   int removeCompactor(LogicalCollection* collection, MMFilesDatafile* datafile);
 
@@ -548,6 +548,10 @@ void MMFilesDatafile::dontDump() {
   TRI_MMFileAdvise(_data, _initSize, TRI_MADVISE_DONTDUMP);
 }
 
+void MMFilesDatafile::adviseHugePages() {
+  _hugePageSize = static_cast<uint32_t>(TRI_MMFileAdviseHugePages(_data, _initSize));
+}
+
 int MMFilesDatafile::lockInMemory() {
   TRI_ASSERT(!_lockedInMemory);
   int res = TRI_MMFileLock(_data, _initSize);
@@ -1007,6 +1011,7 @@ MMFilesDatafile::MMFilesDatafile(std::string const& filename, int fd, void* mmHa
           _maximalSize(maximalSize),
           _currentSize(currentSize),
           _footerSize(sizeof(MMFilesDatafileFooterMarker)),
+          _hugePageSize(0),
           _full(false),
           _isSealed(false),
           _lockedInMemory(false),
@@ -1079,6 +1084,7 @@ int MMFilesDatafile::close() {
     _data = nullptr;
     _next = nullptr;
     _fd = -1;
+    _hugePageSize = 0;
 
     return TRI_ERROR_NO_ERROR;
   }
@@ -1245,6 +1251,7 @@ int MMFilesDatafile::truncateAndSeal(uint32_t position) {
   TRI_ASSERT(maximalSize <= _initSize);
   _maximalSize = static_cast<uint32_t>(maximalSize);
   _initSize = static_cast<uint32_t>(maximalSize);
+  _hugePageSize = 0;
   _fd = fd;
   _mmHandle = mmHandle;
   _state = TRI_DF_STATE_WRITE;
@@ -249,6 +249,9 @@ struct MMFilesDatafile {
   void willNeed();
   void dontNeed();
   void dontDump();
+  /// @brief advise the OS to back the mapping with transparent huge pages,
+  /// if enabled
+  void adviseHugePages();
   bool readOnly();
   bool readWrite();
 
@@ -264,6 +267,7 @@ struct MMFilesDatafile {
   uint32_t maximalSize() const { return _maximalSize; }
   uint32_t currentSize() const { return _currentSize; }
   uint32_t footerSize() const { return _footerSize; }
+  uint32_t hugePageSize() const { return _hugePageSize; }
 
   void setState(TRI_df_state_e state) { _state = state; }
 
@@ -316,6 +320,7 @@ struct MMFilesDatafile {
   uint32_t _maximalSize;    // maximal size of the datafile (may be adjusted/reduced at runtime)
   uint32_t _currentSize;    // current size of the datafile
   uint32_t _footerSize;     // size of the final footer
+  uint32_t _hugePageSize;   // part of the mapping advised to use huge pages
 
   bool _full;  // at least one request was rejected because there is not enough
                // room
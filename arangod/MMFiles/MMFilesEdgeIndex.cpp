@@ -245,6 +245,12 @@ size_t MMFilesEdgeIndex::memory() const {
   return _edgesFrom->memoryUsage() + _edgesTo->memoryUsage();
 }
 
+size_t MMFilesEdgeIndex::hugePageMemory() const {
+  TRI_ASSERT(_edgesFrom != nullptr);
+  TRI_ASSERT(_edgesTo != nullptr);
+  return _edgesFrom->hugePageMemoryUsage() + _edgesTo->hugePageMemoryUsage();
+}
+
 /// @brief return a VelocyPack representation of the index
 void MMFilesEdgeIndex::toVelocyPack(VPackBuilder& builder,
        std::underlying_type<Index::Serialize>::type flags) const {
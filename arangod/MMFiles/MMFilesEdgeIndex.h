@@ -162,6 +162,8 @@ class MMFilesEdgeIndex final : public MMFilesIndex {
 
   size_t memory() const override;
 
+  size_t hugePageMemory() const override;
+
   void toVelocyPack(VPackBuilder&,
                     std::underlying_type<Index::Serialize>::type) const override;
 
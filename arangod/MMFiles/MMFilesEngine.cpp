@@ -32,6 +32,7 @@
 #include "Basics/build.h"
 #include "Basics/encoding.h"
 #include "Basics/files.h"
+#include "Basics/memory-map.h"
 #include "MMFiles/MMFilesCleanupThread.h"
 #include "MMFiles/MMFilesCollection.h"
 #include "MMFiles/MMFilesCompactionFeature.h"
@@ -54,6 +55,8 @@
 #include "MMFiles/MMFilesWalAccess.h"
 #include "MMFiles/MMFilesWalRecoveryFeature.h"
 #include "MMFiles/mmfiles-replication-dump.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "ProgramOptions/Section.h"
 #include "Random/RandomGenerator.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/DatabasePathFeature.h"
@@ -70,6 +73,7 @@
 
 using namespace arangodb;
 using namespace arangodb::basics;
+using namespace arangodb::options;
 
 namespace {
 /// @brief collection meta info filename
@@ -164,6 +168,7 @@ MMFilesEngine::MMFilesEngine(application_features::ApplicationServer& server)
         std::unique_ptr<IndexFactory>(new MMFilesIndexFactory())
       ),
       _isUpgrade(false),
+      _useHugePages(false),
       _maxTick(0),
       _walAccess(new MMFilesWalAccess()),
       _releasedTick(0),
@@ -216,7 +221,14 @@ Result MMFilesEngine::dropDatabase(TRI_vocbase_t& database) {
 }
 
 // add the storage engine's specific options to the global list of options
-void MMFilesEngine::collectOptions(std::shared_ptr<options::ProgramOptions>) {}
+void MMFilesEngine::collectOptions(std::shared_ptr<options::ProgramOptions> options) {
+  options->addSection("mmfiles", "MMFiles engine specific configuration");
+
+  options->addOption("--mmfiles.use-huge-pages",
+                     "advise the OS to back journals, compactors and large "
+                     "in-memory index tables with transparent huge pages",
+                     new BooleanParameter(&_useHugePages));
+}
 
 // validate the storage engine's specific options
 void MMFilesEngine::validateOptions(std::shared_ptr<options::ProgramOptions>) {}
@@ -238,6 +250,8 @@ void MMFilesEngine::prepare() {
 
   TRI_ASSERT(!_basePath.empty());
   TRI_ASSERT(!_databasePath.empty());
+
+  TRI_SetHugePagesMMFile(_useHugePages);
 }
 
 // initialize engine
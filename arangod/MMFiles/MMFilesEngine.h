@@ -577,6 +577,8 @@ class MMFilesEngine final : public StorageEngine {
   std::string _basePath;
   std::string _databasePath;
   bool _isUpgrade;
+  /// @brief whether or not to advise the use of transparent huge pages
+  bool _useHugePages;
   TRI_voc_tick_t _maxTick;
   /// @brief Local wal access abstraction
   std::unique_ptr<MMFilesWalAccess> _walAccess;
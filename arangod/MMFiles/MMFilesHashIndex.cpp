@@ -374,6 +374,13 @@ size_t MMFilesHashIndex::memory() const {
                              _multiArray->_hashArray->memoryUsage());
 }
 
+size_t MMFilesHashIndex::hugePageMemory() const {
+  if (_unique) {
+    return _uniqueArray->_hashArray->hugePageMemoryUsage();
+  }
+  return _multiArray->_hashArray->hugePageMemoryUsage();
+}
+
 /// @brief return a velocypack representation of the index figures
 void MMFilesHashIndex::toVelocyPackFigures(VPackBuilder& builder) const {
   MMFilesPathBasedIndex::toVelocyPackFigures(builder);
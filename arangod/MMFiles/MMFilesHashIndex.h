@@ -257,6 +257,8 @@ class MMFilesHashIndex final : public MMFilesPathBasedIndex {
 
   size_t memory() const override;
 
+  size_t hugePageMemory() const override;
+
   void toVelocyPackFigures(VPackBuilder&) const override;
 
   bool matchesDefinition(VPackSlice const& info) const override;
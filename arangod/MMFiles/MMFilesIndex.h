@@ -57,6 +57,9 @@ class MMFilesIndex : public Index {
     // for mmfiles, truncating the index just unloads it
     unload();
   }
+
+  /// @brief the part of the index memory that is advised to use huge pages
+  virtual size_t hugePageMemory() const { return 0; }
 };
 }
 
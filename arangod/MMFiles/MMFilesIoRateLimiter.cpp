@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFilesIoRateLimiter.h"
+#include "Basics/MutexLocker.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace arangodb;
+
+MMFilesIoRateLimiter::MMFilesIoRateLimiter(uint64_t bytesPerSecond)
+    : _rate(bytesPerSecond),
+      _available(static_cast<double>(bytesPerSecond)),
+      _lastRefill(TRI_microtime()) {}
+
+void MMFilesIoRateLimiter::account(uint64_t bytes) {
+  if (_rate == 0) {
+    return;
+  }
+
+  MUTEX_LOCKER(locker, _mutex);
+  refill(TRI_microtime());
+  _available -= static_cast<double>(bytes);
+}
+
+void MMFilesIoRateLimiter::throttle(uint64_t bytes) {
+  if (_rate == 0) {
+    return;
+  }
+
+  double wait;
+  {
+    MUTEX_LOCKER(locker, _mutex);
+    refill(TRI_microtime());
+    _available -= static_cast<double>(bytes);
+    if (_available >= 0.0) {
+      return;
+    }
+    // the debt is paid off by the time the sleep is over. concurrent
+    // callers queue up behind each other, because each one adds to it
+    wait = -_available / static_cast<double>(_rate);
+  }
+
+  std::this_thread::sleep_for(std::chrono::microseconds(
+      static_cast<uint64_t>(wait * 1000000.0)));
+}
+
+void MMFilesIoRateLimiter::refill(double now) {
+  if (now > _lastRefill) {
+    _available += (now - _lastRefill) * static_cast<double>(_rate);
+    // allow bursts of at most one second
+    _available = (std::min)(_available, static_cast<double>(_rate));
+    _lastRefill = now;
+  }
+}
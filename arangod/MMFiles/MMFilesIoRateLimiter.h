@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_MMFILES_MMFILES_IO_RATE_LIMITER_H
+#define ARANGOD_MMFILES_MMFILES_IO_RATE_LIMITER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+namespace arangodb {
+
+/// @brief token bucket limiting the number of bytes written per second by
+/// the background threads of the MMFiles engine. the WAL collector only
+/// accounts for its writes, because delaying it would let the WAL grow.
+/// the compactors wait until there is budget left. a rate of 0 disables
+/// the limiter
+class MMFilesIoRateLimiter {
+ public:
+  explicit MMFilesIoRateLimiter(uint64_t bytesPerSecond);
+
+  MMFilesIoRateLimiter(MMFilesIoRateLimiter const&) = delete;
+  MMFilesIoRateLimiter& operator=(MMFilesIoRateLimiter const&) = delete;
+
+  /// @brief whether or not the limiter is active
+  bool isEnabled() const { return _rate > 0; }
+
+  /// @brief record bytes that were written without waiting
+  void account(uint64_t bytes);
+
+  /// @brief record bytes that are about to be written, and wait until the
+  /// budget allows writing them
+  void throttle(uint64_t bytes);
+
+ private:
+  /// @brief add the budget accrued since the last refill. must be called
+  /// with the mutex held
+  void refill(double now);
+
+ private:
+  uint64_t const _rate;
+
+  Mutex _mutex;
+  /// @brief remaining budget in bytes, may become negative
+  double _available;
+  double _lastRefill;
+};
+
+}  // namespace arangodb
+
+#endif
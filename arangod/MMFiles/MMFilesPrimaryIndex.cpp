@@ -220,6 +220,10 @@ size_t MMFilesPrimaryIndex::memory() const {
   return _primaryIndex->memoryUsage();
 }
 
+size_t MMFilesPrimaryIndex::hugePageMemory() const {
+  return _primaryIndex->hugePageMemoryUsage();
+}
+
 /// @brief return a VelocyPack representation of the index
 void MMFilesPrimaryIndex::toVelocyPack(VPackBuilder& builder,
                                        std::underlying_type<Serialize>::type flags) const {
@@ -192,6 +192,8 @@ class MMFilesPrimaryIndex final : public MMFilesIndex {
 
   size_t memory() const override;
 
+  size_t hugePageMemory() const override;
+
   void toVelocyPack(VPackBuilder&,
                     std::underlying_type<Index::Serialize>::type) const override;
   void toVelocyPackFigures(VPackBuilder&) const override;
@@ -1022,4 +1022,9 @@ void MMFilesRestReplicationHandler::handleCommandDump() {
 
   // avoid double freeing
   TRI_StealStringBuffer(dump._buffer);
+
+  res = deflateDump(*response);
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateError(rest::ResponseCode::SERVER_ERROR, res);
+  }
 }
@@ -84,20 +84,26 @@ class MMFilesWalSlot {
 
  private:
   /// @brief whether or not the slot is unused
-  inline bool isUnused() const { return _status == StatusType::UNUSED; }
+  inline bool isUnused() const {
+    return _status.load(std::memory_order_acquire) == StatusType::UNUSED;
+  }
 
   /// @brief whether or not the slot is used
-  inline bool isUsed() const { return _status == StatusType::USED; }
+  inline bool isUsed() const {
+    return _status.load(std::memory_order_acquire) == StatusType::USED;
+  }
 
   /// @brief whether or not the slot is returned
   inline bool isReturned() const {
-    return (_status == StatusType::RETURNED ||
-            _status == StatusType::RETURNED_WFS);
+    StatusType status = _status.load(std::memory_order_acquire);
+    return (status == StatusType::RETURNED ||
+            status == StatusType::RETURNED_WFS);
   }
 
   /// @brief whether or not a sync was requested for the slot
   inline bool waitForSync() const {
-    return (_status == StatusType::RETURNED_WFS);
+    return (_status.load(std::memory_order_acquire) ==
+            StatusType::RETURNED_WFS);
   }
 
   /// @brief mark as slot as unused
@@ -126,8 +132,9 @@ class MMFilesWalSlot {
   /// @brief slot raw memory size
   uint32_t _size;
 
-  /// @brief slot status
-  StatusType _status; 
+  /// @brief slot status. slots are returned by their writers without
+  /// holding the slots lock
+  std::atomic<StatusType> _status;
 };
 
 static_assert(sizeof(MMFilesWalSlot) == 32, "invalid slot size");
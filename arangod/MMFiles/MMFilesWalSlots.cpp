@@ -75,12 +75,11 @@ void MMFilesWalSlots::statistics(MMFilesWalSlot::TickType& lastAssignedTick,
                        MMFilesWalSlot::TickType& lastCommittedDataTick,
                        uint64_t& numEvents,
                        uint64_t& numEventsSync) {
-  MUTEX_LOCKER(mutexLocker, _lock);
-  lastAssignedTick = _lastAssignedTick;
-  lastCommittedTick = _lastCommittedTick;
-  lastCommittedDataTick = _lastCommittedDataTick;
-  numEvents = _numEvents;
-  numEventsSync = _numEventsSync;
+  lastAssignedTick = _lastAssignedTick.load();
+  lastCommittedTick = _lastCommittedTick.load();
+  lastCommittedDataTick = _lastCommittedDataTick.load();
+  numEvents = _numEvents.load();
+  numEventsSync = _numEventsSync.load();
 }
 
 /// @brief initially set the last ticks on start
@@ -130,12 +129,6 @@ int MMFilesWalSlots::flush(bool waitForSync) {
   return res;
 }
 
-/// @brief return the last committed tick
-MMFilesWalSlot::TickType MMFilesWalSlots::lastCommittedTick() {
-  MUTEX_LOCKER(mutexLocker, _lock);
-  return _lastCommittedTick;
-}
-
 /// @brief return the next unused slot
 MMFilesWalSlotInfo MMFilesWalSlots::nextUnused(uint32_t size) {
   return nextUnused(0, 0, size);
@@ -301,13 +294,7 @@ MMFilesWalSlotInfo MMFilesWalSlots::nextUnused(TRI_voc_tick_t databaseId, TRI_vo
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(mutexLocker, _lock);
-      mustWait = (_freeSlots < 2);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() < 2) {
       guard.wait(10 * 1000);
     }
   }
@@ -323,20 +310,17 @@ int MMFilesWalSlots::returnUsed(MMFilesWalSlotInfo& slotInfo, bool wakeUpSynchro
   TRI_ASSERT(!waitUntilSyncDone || waitForSyncRequested);
 
   MMFilesWalSlot::TickType tick = slotInfo.slot->tick();
-  MMFilesMarker const* marker = reinterpret_cast<MMFilesMarker const*>(slotInfo.slot->mem());
-  MMFilesWalLogfile const* logfile = slotInfo.logfile;
 
   TRI_ASSERT(tick > 0);
 
-  {
-    MUTEX_LOCKER(mutexLocker, _lock);
-    TRI_UpdateTicksDatafile(logfile->df(), marker);
-    slotInfo.slot->setReturned(waitForSyncRequested);
-    if (waitForSyncRequested) {
-      ++_numEventsSync;
-    } else {
-      ++_numEvents;
-    }
+  // the ticks of the logfile are updated when the synchronizer hands back
+  // the region containing the slot, so returning needs no lock. the slot
+  // must not be accessed after this, as it may be recycled right away
+  slotInfo.slot->setReturned(waitForSyncRequested);
+  if (waitForSyncRequested) {
+    ++_numEventsSync;
+  } else {
+    ++_numEvents;
   }
 
   wakeUpSynchronizer |= waitForSyncRequested;
@@ -360,75 +344,80 @@ int MMFilesWalSlots::returnUsed(MMFilesWalSlotInfo& slotInfo, bool wakeUpSynchro
 
 /// @brief get the next synchronizable region
 MMFilesWalSyncRegion MMFilesWalSlots::getSyncRegion() {
-  bool sealRequested = false;
+  // whether the region is followed by a slot not handed out yet
+  bool followedByUnused = false;
   MMFilesWalSyncRegion region;
 
-  MUTEX_LOCKER(mutexLocker, _lock);
+  {
+    MUTEX_LOCKER(mutexLocker, _lock);
 
-  size_t slotIndex = _recycleIndex;
+    size_t slotIndex = _recycleIndex;
 
-  while (true) {
-    MMFilesWalSlot const* slot = &_slots[slotIndex];
-    TRI_ASSERT(slot != nullptr);
+    while (true) {
+      MMFilesWalSlot const* slot = &_slots[slotIndex];
+      TRI_ASSERT(slot != nullptr);
 
-    if (sealRequested && slot->isUnused()) {
-      region.canSeal = true;
-    }
+      if (!slot->isReturned()) {
+        followedByUnused = (region.logfileId != 0 && slot->isUnused());
+        // found a slot that is not yet returned
+        // if it belongs to another logfile, we can seal the logfile we created
+        // the region for
+        auto otherId = slot->logfileId();
+
+        if (region.logfileId != 0 && otherId != 0 &&
+            otherId != region.logfileId) {
+          region.canSeal = true;
+        }
+        break;
+      }
+
+      if (region.logfileId == 0) {
+        // first member
+        region.logfileId = slot->logfileId();
+        region.mem = static_cast<char*>(slot->mem());
+        region.size = slot->size();
+        region.firstSlotIndex = slotIndex;
+        region.lastSlotIndex = slotIndex;
+        region.waitForSync = slot->waitForSync();
+      } else {
+        if (slot->logfileId() != region.logfileId) {
+          // got a different logfile
+          region.checkMore = true;
+          region.canSeal = true;
+          break;
+        }
 
-    if (!slot->isReturned()) {
-      // found a slot that is not yet returned
-      // if it belongs to another logfile, we can seal the logfile we created
-      // the region for
-      auto otherId = slot->logfileId();
+        // this is a group commit!!
 
-      if (region.logfileId != 0 && otherId != 0 &&
-          otherId != region.logfileId) {
-        region.canSeal = true;
+        // update the region
+        region.size += (uint32_t)(static_cast<char*>(slot->mem()) -
+                                  (region.mem + region.size) + slot->size());
+        region.lastSlotIndex = slotIndex;
+        region.waitForSync |= slot->waitForSync();
       }
-      break;
-    }
 
-    if (region.logfileId == 0) {
-      // first member
-      MMFilesWalLogfile::StatusType status;
-
-      region.logfileId = slot->logfileId();
-      // the following call also updates status
-      region.logfile = _logfileManager->getLogfile(slot->logfileId(), status);
-      region.mem = static_cast<char*>(slot->mem());
-      region.size = slot->size();
-      region.logfileStatus = status;
-      region.firstSlotIndex = slotIndex;
-      region.lastSlotIndex = slotIndex;
-      region.waitForSync = slot->waitForSync();
-
-      if (status == MMFilesWalLogfile::StatusType::SEAL_REQUESTED) {
-        sealRequested = true;
+      if (++slotIndex >= _numberOfSlots) {
+        slotIndex = 0;
       }
-    } else {
-      if (slot->logfileId() != region.logfileId) {
-        // got a different logfile
-        region.checkMore = true;
-        region.canSeal = true;
+
+      if (slotIndex == _recycleIndex) {
+        // one full loop
         break;
       }
-
-      // this is a group commit!!
-
-      // update the region
-      region.size += (uint32_t)(static_cast<char*>(slot->mem()) -
-                                (region.mem + region.size) + slot->size());
-      region.lastSlotIndex = slotIndex;
-      region.waitForSync |= slot->waitForSync();
     }
+  }
 
-    if (++slotIndex >= _numberOfSlots) {
-      slotIndex = 0;
-    }
+  if (region.logfileId != 0) {
+    // the logfile manager has its own lock, so it is consulted only after
+    // the slots lock has been released
+    MMFilesWalLogfile::StatusType status;
+    // the following call also updates status
+    region.logfile = _logfileManager->getLogfile(region.logfileId, status);
+    region.logfileStatus = status;
 
-    if (slotIndex == _recycleIndex) {
-      // one full loop
-      break;
+    if (status == MMFilesWalLogfile::StatusType::SEAL_REQUESTED &&
+        followedByUnused) {
+      region.canSeal = true;
     }
   }
 
@@ -614,13 +603,7 @@ int MMFilesWalSlots::closeLogfile(MMFilesWalSlot::TickType& lastCommittedTick, b
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(mutexLocker, _lock);
-      mustWait = (_freeSlots < 2);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() < 2) {
       guard.wait(10 * 1000);
     }
 
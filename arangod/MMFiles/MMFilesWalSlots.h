@@ -98,7 +98,9 @@ class MMFilesWalSlots {
   void setLastTick(MMFilesWalSlot::TickType const&);
 
   /// @brief return the last committed tick
-  MMFilesWalSlot::TickType lastCommittedTick();
+  MMFilesWalSlot::TickType lastCommittedTick() const {
+    return _lastCommittedTick.load(std::memory_order_acquire);
+  }
 
   /// @brief return the next unused slot
   MMFilesWalSlotInfo nextUnused(uint32_t size);
@@ -107,7 +109,8 @@ class MMFilesWalSlots {
   MMFilesWalSlotInfo nextUnused(TRI_voc_tick_t databaseId, 
                       TRI_voc_cid_t collectionId, uint32_t size);
 
-  /// @brief return a used slot, allowing its synchronization
+  /// @brief return a used slot, allowing its synchronization. this does
+  /// not acquire the slots lock
   int returnUsed(MMFilesWalSlotInfo&, bool wakeUpSynchronizer,
                  bool waitForSyncRequested, bool waitUntilSyncDone);
 
@@ -158,7 +161,8 @@ class MMFilesWalSlots {
   /// @brief condition variable for slots
   basics::ConditionVariable _condition;
 
-  /// @brief mutex protecting the slots interface
+  /// @brief mutex protecting the handout of slots and the sync regions.
+  /// returning slots and reading the ticks and statistics do not need it
   Mutex _lock;
 
   /// @brief all slots
@@ -168,7 +172,7 @@ class MMFilesWalSlots {
   size_t const _numberOfSlots;
 
   /// @brief the number of currently free slots
-  size_t _freeSlots;
+  std::atomic<size_t> _freeSlots;
 
   /// @brief whether or not someone is waiting for a slot
   uint32_t _waiting;
@@ -183,19 +187,19 @@ class MMFilesWalSlots {
   MMFilesWalLogfile* _logfile;
 
   /// @brief last assigned tick value
-  MMFilesWalSlot::TickType _lastAssignedTick;
+  std::atomic<MMFilesWalSlot::TickType> _lastAssignedTick;
 
   /// @brief last committed tick value
-  MMFilesWalSlot::TickType _lastCommittedTick;
+  std::atomic<MMFilesWalSlot::TickType> _lastCommittedTick;
 
   /// @brief last committed data tick value
-  MMFilesWalSlot::TickType _lastCommittedDataTick;
+  std::atomic<MMFilesWalSlot::TickType> _lastCommittedDataTick;
 
   /// @brief number of log events handled
-  uint64_t _numEvents;
+  std::atomic<uint64_t> _numEvents;
 
   /// @brief number of sync log events handled
-  uint64_t _numEventsSync;
+  std::atomic<uint64_t> _numEventsSync;
   
   /// @brief last written database id (in prologue marker)
   TRI_voc_tick_t _lastDatabaseId;
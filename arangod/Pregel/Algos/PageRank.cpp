@@ -50,6 +50,15 @@ struct PRWorkerContext : public WorkerContext {
 
 PageRank::PageRank(VPackSlice const& params)
     : SimpleAlgorithm("PageRank", params), _useSource(params.hasKey("sourceField")) {
+  VPackSlice incremental = params.get("incremental");
+  if (incremental.isBool() && incremental.getBool()) {
+    // continue from the ranks stored by the previous run. after small
+    // changes of the graph these are close to the new ranks already
+    _sourceField = _resultField;
+    _useSource = true;
+  }
+  VPackSlice t = params.get("threshold");
+  _threshold = t.isNumber() ? t.getNumber<float>() : EPS;
 }
 
 /// will use a seed value for pagerank if available
@@ -103,8 +112,40 @@ struct PRComputation : public VertexComputation<float, float, float> {
   }
 };
 
+/// delta-accumulative PageRank for the async mode. messages carry rank
+/// changes instead of ranks, so there is no need for a global barrier
+/// between iterations. a vertex is only scheduled again when it receives
+/// changes, and it only forwards changes which are larger than the
+/// threshold relative to its rank. small residuals are dropped.
+struct DeltaPRComputation : public VertexComputation<float, float, float> {
+  float const _threshold;
+  explicit DeltaPRComputation(float threshold) : _threshold(threshold) {}
+
+  void compute(MessageIterator<float> const& messages) override {
+    float* ptr = mutableVertexData();
+    float delta = 0.0f;
+    if (localSuperstep() == 0 && globalSuperstep() == 0) {
+      // seed weights cannot be used, ranks are accumulated from zero
+      delta = 0.15f / context()->vertexCount();
+      *ptr = 0.0f;
+    }
+    for (const float* msg : messages) {
+      delta += *msg;
+    }
+    *ptr += delta;
+
+    if (delta > _threshold * *ptr && getEdgeCount() > 0) {
+      sendMessageToAllNeighbours(0.85f * delta / getEdgeCount());
+    }
+    voteHalt();
+  }
+};
+
 VertexComputation<float, float, float>* PageRank::createComputation(
     WorkerConfig const* config) const {
+  if (config->asynchronousMode()) {
+    return new DeltaPRComputation(_threshold);
+  }
   return new PRComputation();
 }
 
@@ -114,9 +155,12 @@ WorkerContext* PageRank::workerContext(VPackSlice userParams) const {
 
 struct PRMasterContext : public MasterContext {
   float _threshold = EPS;
+  bool _async = false;
   explicit PRMasterContext(VPackSlice params) {
     VPackSlice t = params.get("threshold");
     _threshold = t.isNumber() ? t.getNumber<float>() : EPS;
+    VPackSlice async = params.get("async");
+    _async = async.isBool() && async.getBoolean();
   }
 
   void preApplication() override {
@@ -124,6 +168,10 @@ struct PRMasterContext : public MasterContext {
   };
 
   bool postGlobalSuperstep() override {
+    if (_async) {
+      // the delta computation halts once all changes were propagated
+      return true;
+    }
     float const* diff = getAggregatedValue<float>(kConvergence);
     return globalSuperstep() < 1 || *diff > _threshold;
   };
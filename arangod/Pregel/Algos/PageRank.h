@@ -30,7 +30,9 @@ namespace arangodb {
 namespace pregel {
 namespace algos {
 
-/// PageRank
+/// PageRank. In async mode the ranks are computed delta-accumulatively:
+/// vertices only forward rank changes above the threshold, and the
+/// computation ends once no more changes are propagated
 struct PageRank : public SimpleAlgorithm<float, float, float> {
 
   explicit PageRank(arangodb::velocypack::Slice const& params);
@@ -53,9 +55,12 @@ struct PageRank : public SimpleAlgorithm<float, float, float> {
   MasterContext* masterContext(VPackSlice userParams) const override;
 
   IAggregator* aggregator(std::string const& name) const override;
-  
+
+  bool supportsAsyncMode() const override { return true; }
+
 private:
-  bool const _useSource;
+  bool _useSource;
+  float _threshold;
 };
 }
 }
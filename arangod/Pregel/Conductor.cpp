@@ -231,6 +231,10 @@ void Conductor::finishedWorkerStartup(VPackSlice const& data) {
 
   _totalVerticesCount += data.get(Utils::vertexCountKey).getUInt();
   _totalEdgesCount += data.get(Utils::edgeCountKey).getUInt();
+  _vertexLoadTimeSecs = std::max(_vertexLoadTimeSecs,
+      basics::VelocyPackHelper::getNumericValue<double>(data, Utils::vertexLoadTimeKey.c_str(), 0.0));
+  _edgeLoadTimeSecs = std::max(_edgeLoadTimeSecs,
+      basics::VelocyPackHelper::getNumericValue<double>(data, Utils::edgeLoadTimeKey.c_str(), 0.0));
   if (_respondedServers.size() != _dbServers.size()) {
     return;
   }
@@ -737,6 +741,12 @@ VPackBuilder Conductor::toVelocyPack() const {
   result.add("state", VPackValue(pregel::ExecutionStateNames[_state]));
   result.add("gss", VPackValue(_globalSuperstep));
   result.add("totalRuntime", VPackValue(totalRuntimeSecs()));
+  if (_computationStartTimeSecs > 0) {
+    result.add("startupTime",
+               VPackValue(_computationStartTimeSecs - _startTimeSecs));
+    result.add("vertexLoadTime", VPackValue(_vertexLoadTimeSecs));
+    result.add("edgeLoadTime", VPackValue(_edgeLoadTimeSecs));
+  }
   _aggregators->serializeValues(result);
   _statistics.serializeValues(result);
   if (_state != ExecutionState::RUNNING) {
@@ -91,6 +91,9 @@ class Conductor {
   double _startTimeSecs = 0;
   double _computationStartTimeSecs = 0;
   double _endTimeSecs = 0;
+  /// seconds the slowest worker spent loading vertices / edges
+  double _vertexLoadTimeSecs = 0;
+  double _edgeLoadTimeSecs = 0;
   std::unique_ptr<asio::steady_timer> _steady_timer;
 
   bool _startGlobalStep();
@@ -68,17 +68,18 @@ class Edge {
 
   // PregelShard _sourceShard;
   PregelShard _targetShard;
-  PregelKey _toKey;
+  /// points into the key dictionary of the graph store
+  PregelKey const* _toKey;
   E _data;
 
  public:
   // EdgeEntry() : _nextEntryOffset(0), _dataSize(0), _vertexIDSize(0) {}
-  Edge() : _targetShard(InvalidPregelShard) {}
-  Edge(PregelShard target, PregelKey const& key)
+  Edge() : _targetShard(InvalidPregelShard), _toKey(nullptr) {}
+  Edge(PregelShard target, PregelKey const* key)
       : _targetShard(target), _toKey(key), _data(0) {}
 
   // size_t getSize() { return sizeof(EdgeEntry) + _vertexIDSize + _dataSize; }
-  PregelKey const& toKey() const { return _toKey; }
+  PregelKey const& toKey() const { return *_toKey; }
   // size_t getDataSize() { return _dataSize; }
   inline E* data() {
     return &_data;  // static_cast<E>(this + sizeof(EdgeEntry) + _vertexIDSize);
@@ -92,15 +93,16 @@ class VertexEntry {
   friend class GraphStore;
 
   PregelShard _shard;
-  PregelKey _key;
+  /// points into the key dictionary of the graph store
+  PregelKey const* _key;
   size_t _vertexDataOffset = 0;
   size_t _edgeDataOffset = 0;
   size_t _edgeCount = 0;
   bool _active = true;
 
  public:
-  VertexEntry() : _shard(InvalidPregelShard) {}
-  VertexEntry(PregelShard shard, PregelKey const& key)
+  VertexEntry() : _shard(InvalidPregelShard), _key(nullptr) {}
+  VertexEntry(PregelShard shard, PregelKey const* key)
       : _shard(shard), _key(key) {}
 
   inline size_t getVertexDataOffset() const { return _vertexDataOffset; }
@@ -112,8 +114,8 @@ class VertexEntry {
   inline void setActive(bool bb) { _active = bb; }
 
   inline PregelShard shard() const { return _shard; }
-  inline PregelKey const& key() const { return _key; };
-  PregelID pregelId() const { return PregelID(_shard, _key); }
+  inline PregelKey const& key() const { return *_key; };
+  PregelID pregelId() const { return PregelID(_shard, *_key); }
   /*std::string const& key() const {
     return std::string(_key, _keySize);
   };*/
@@ -33,6 +33,7 @@
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Context.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/CollectionNameResolver.h"
@@ -74,7 +75,9 @@ GraphStore<V, E>::GraphStore(TRI_vocbase_t& vb, GraphFormat<V, E>* graphFormat)
       _graphFormat(graphFormat),
       _localVerticeCount(0),
       _localEdgeCount(0),
-      _runningThreads(0) {}
+      _runningThreads(0),
+      _vertexLoadMicros(0),
+      _edgeLoadMicros(0) {}
 
 template <typename V, typename E>
 GraphStore<V, E>::~GraphStore() {
@@ -296,7 +299,7 @@ void GraphStore<V, E>::loadDocument(WorkerConfig* config,
 
   VPackSlice doc(mmdr.vpack());
   std::string documentId = trx->extractIdString(doc);
-  _index.emplace_back(sourceShard, _key);
+  _index.emplace_back(sourceShard, _keys.intern(_key));
 
   VertexEntry& entry = _index.back();
   if (_graphFormat->estimatedVertexSize() > 0) {
@@ -396,6 +399,16 @@ void GraphStore<V, E>::_loadVertices(transaction::Methods& trx,
   TRI_ASSERT(vertexOffset < _index.size());
   uint64_t originalVertexOffset = vertexOffset;
 
+  // scanning the edge shards sequentially is much cheaper than looking up
+  // the edges of every single vertex in the edge index
+  double start = TRI_microtime();
+  std::unordered_map<std::string, std::vector<Edge<E>>> buckets;
+  for (ShardID const& edgeShard : edgeShards) {
+    _scanEdges(trx, edgeShard, buckets);
+  }
+  double edgesDone = TRI_microtime();
+  _edgeLoadMicros += static_cast<uint64_t>((edgesDone - start) * 1000000.0);
+
   PregelShard sourceShard = (PregelShard)_config->shardId(vertexShard);
   std::unique_ptr<OperationCursor> cursor =
     trx.indexScan(vertexShard, transaction::Methods::CursorType::ALL);
@@ -416,7 +429,8 @@ void GraphStore<V, E>::_loadVertices(transaction::Methods& trx,
     }
     VertexEntry& ventry = _index[vertexOffset];
     ventry._shard = sourceShard;
-    ventry._key = transaction::helpers::extractKeyFromDocument(slice).copyString();
+    ventry._key = _keys.intern(
+        transaction::helpers::extractKeyFromDocument(slice).copyString());
     ventry._edgeDataOffset = edgeOffset;
 
     // load vertex data
@@ -427,9 +441,21 @@ void GraphStore<V, E>::_loadVertices(transaction::Methods& trx,
       V* ptr = _vertexData->data() + vertexOffset;
       _graphFormat->copyVertexData(documentId, slice, ptr, sizeof(V));
     }
-    // load edges
-    for (ShardID const& edgeShard : edgeShards) {
-      _loadEdges(trx, edgeShard, ventry, documentId);
+    // take over the edges of the vertex
+    auto bucket = buckets.find(documentId);
+    if (bucket != buckets.end()) {
+      std::vector<Edge<E>>& edges = bucket->second;
+      if (_edges->size() < edgeOffset + edges.size()) {
+        LOG_TOPIC(ERR, Logger::PREGEL) << "Pregel did not preallocate enough "
+                                       << "space for all edges. This hints "
+                                       << "at a bug with collection count()";
+        TRI_ASSERT(false);
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+      }
+      std::move(edges.begin(), edges.end(), _edges->data() + edgeOffset);
+      ventry._edgeCount += edges.size();
+      _localEdgeCount += edges.size();
+      buckets.erase(bucket);
     }
     vertexOffset++;
     edgeOffset += ventry._edgeCount;
@@ -443,6 +469,8 @@ void GraphStore<V, E>::_loadVertices(transaction::Methods& trx,
 
   // Add all new vertices
   _localVerticeCount += (vertexOffset - originalVertexOffset);
+  _vertexLoadMicros +=
+      static_cast<uint64_t>((TRI_microtime() - edgesDone) * 1000000.0);
 
   if (!trx.commit().ok()) {
     LOG_TOPIC(WARN, Logger::PREGEL)
@@ -487,32 +515,10 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods& trx,
       ((VectorTypedBuffer<Edge<E>>*)_edges)->appendEmptyElement();
     }
 
-    std::string toValue = slice.get(StaticStrings::ToString).copyString();
-    std::size_t pos = toValue.find('/');
-    std::string collectionName = toValue.substr(0, pos);
     Edge<E>* edge = _edges->data() + offset;
-    edge->_toKey = toValue.substr(pos + 1, toValue.length() - pos - 1);
-
-    // resolve the shard of the target vertex.
-    ShardID responsibleShard;
-    int res =
-        Utils::resolveShard(_config, collectionName, StaticStrings::KeyString,
-                            edge->_toKey, responsibleShard);
-
-    if (res == TRI_ERROR_NO_ERROR) {
-      // PregelShard sourceShard = (PregelShard)_config->shardId(edgeShard);
-      edge->_targetShard = (PregelShard)_config->shardId(responsibleShard);
-      _graphFormat->copyEdgeData(slice, edge->data(), sizeof(E));
-      if (edge->_targetShard != (PregelShard)-1) {
-        added++;
-        offset++;
-      } else {
-        LOG_TOPIC(ERR, Logger::PREGEL)
-            << "Could not resolve target shard of edge";
-      }
-    } else {
-      LOG_TOPIC(ERR, Logger::PREGEL)
-          << "Could not resolve target shard of edge";
+    if (_copyEdge(slice, edge)) {
+      added++;
+      offset++;
     }
   };
   while (cursor->nextDocument(cb, 1000)) {
@@ -527,6 +533,59 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods& trx,
   _localEdgeCount += added;
 }
 
+template <typename V, typename E>
+void GraphStore<V, E>::_scanEdges(
+    transaction::Methods& trx, ShardID const& edgeShard,
+    std::unordered_map<std::string, std::vector<Edge<E>>>& buckets) {
+  std::unique_ptr<OperationCursor> cursor =
+    trx.indexScan(edgeShard, transaction::Methods::CursorType::ALL);
+  if (cursor->fail()) {
+    THROW_ARANGO_EXCEPTION_FORMAT(cursor->code, "while looking up shard '%s'",
+                                  edgeShard.c_str());
+  }
+
+  auto cb = [&](LocalDocumentId const& token, VPackSlice slice) {
+    if (slice.isExternal()) {
+      slice = slice.resolveExternal();
+    }
+    Edge<E> edge;
+    if (_copyEdge(slice, &edge)) {
+      VPackSlice from = transaction::helpers::extractFromFromDocument(slice);
+      buckets[from.copyString()].emplace_back(std::move(edge));
+    }
+  };
+  while (cursor->nextDocument(cb, 1000)) {
+    if (_destroyed) {
+      LOG_TOPIC(WARN, Logger::PREGEL) << "Aborted loading graph";
+      break;
+    }
+  }
+}
+
+template <typename V, typename E>
+bool GraphStore<V, E>::_copyEdge(VPackSlice slice, Edge<E>* edge) {
+  std::string toValue = slice.get(StaticStrings::ToString).copyString();
+  std::size_t pos = toValue.find('/');
+  std::string collectionName = toValue.substr(0, pos);
+  edge->_toKey = _keys.intern(toValue.substr(pos + 1, toValue.length() - pos - 1));
+
+  // resolve the shard of the target vertex.
+  ShardID responsibleShard;
+  int res =
+      Utils::resolveShard(_config, collectionName, StaticStrings::KeyString,
+                          *edge->_toKey, responsibleShard);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    edge->_targetShard = (PregelShard)_config->shardId(responsibleShard);
+    _graphFormat->copyEdgeData(slice, edge->data(), sizeof(E));
+    if (edge->_targetShard != (PregelShard)-1) {
+      return true;
+    }
+  }
+  LOG_TOPIC(ERR, Logger::PREGEL) << "Could not resolve target shard of edge";
+  return false;
+}
+
 /// Loops over the array starting a new transaction for different shards
 /// Should not dead-lock unless we have to wait really long for other threads
 template <typename V, typename E>
@@ -557,13 +616,28 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
 
       transactionOptions.waitForSync = false;
       transactionOptions.allowImplicitCollections = false;
-      trx.reset(new transaction::Methods(
-        transaction::StandaloneContext::Create(_vocbaseGuard.database()),
-        {},
-        {shard},
-        {},
-        transactionOptions
-      ));
+      if (_config->bulkStore()) {
+        // lock the shard exclusively, so the updates can be ingested as
+        // SST files instead of going through the WAL and the memtables
+        trx.reset(new transaction::Methods(
+          transaction::StandaloneContext::Create(_vocbaseGuard.database()),
+          {},
+          {},
+          {shard},
+          transactionOptions
+        ));
+        trx->addHint(transaction::Hints::Hint::BULK_LOAD);
+        trx->addHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS);
+        trx->addHint(transaction::Hints::Hint::LOW_PRIORITY);
+      } else {
+        trx.reset(new transaction::Methods(
+          transaction::StandaloneContext::Create(_vocbaseGuard.database()),
+          {},
+          {shard},
+          {},
+          transactionOptions
+        ));
+      }
       res = trx->begin();
 
       if (!res.ok()) {
@@ -602,6 +676,7 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
 
     ShardID const& shard = globalShards[currentShard];
     OperationOptions options;
+    options.silent = true;
     OperationResult result = trx->update(shard, b->slice(), options);
     if (result.fail()) {
       THROW_ARANGO_EXCEPTION(result.result);
@@ -30,6 +30,7 @@
 #include "Pregel/Graph.h"
 #include "Pregel/GraphFormat.h"
 #include "Pregel/Iterators.h"
+#include "Pregel/KeyDictionary.h"
 #include "Pregel/TypedBuffer.h"
 #include "Utils/DatabaseGuard.h"
 
@@ -73,6 +74,10 @@ class GraphStore {
 
   uint64_t localVertexCount() const { return _localVerticeCount; }
   uint64_t localEdgeCount() const { return _localEdgeCount; }
+  /// seconds spent loading vertices resp. scanning edges, summed up over
+  /// all loading threads
+  double vertexLoadTime() const { return _vertexLoadMicros / 1000000.0; }
+  double edgeLoadTime() const { return _edgeLoadMicros / 1000000.0; }
   GraphFormat<V, E> const* graphFormat() { return _graphFormat.get(); }
 
   // ====================== NOT THREAD SAFE ===========================
@@ -106,6 +111,12 @@ private:
                      size_t& edgeOffset);
   void _loadEdges(transaction::Methods& trx, ShardID const& shard,
                   VertexEntry& vertexEntry, std::string const& documentID);
+  /// scan the edge shard sequentially and bucket its edges by _from
+  void _scanEdges(transaction::Methods& trx, ShardID const& edgeShard,
+                  std::unordered_map<std::string, std::vector<Edge<E>>>& buckets);
+  /// fill the edge from the edge document, false if the target vertex
+  /// cannot be resolved
+  bool _copyEdge(arangodb::velocypack::Slice slice, Edge<E>* edge);
   void _storeVertices(std::vector<ShardID> const& globalShards,
                       RangeIterator<VertexEntry>& it);
   std::unique_ptr<transaction::Methods> _createTransaction();
@@ -114,6 +125,9 @@ private:
   const std::unique_ptr<GraphFormat<V, E>> _graphFormat;
   WorkerConfig* _config = nullptr;
 
+  /// Holds the keys of the vertices and of the targets of the edges
+  KeyDictionary _keys;
+
   /// Holds vertex keys and pointers to vertex data and edges
   std::vector<VertexEntry> _index;
 
@@ -130,6 +144,8 @@ private:
   std::atomic<size_t> _localVerticeCount;
   std::atomic<size_t> _localEdgeCount;
   std::atomic<uint32_t> _runningThreads;
+  std::atomic<uint64_t> _vertexLoadMicros;
+  std::atomic<uint64_t> _edgeLoadMicros;
   bool _destroyed = false;
 };
 
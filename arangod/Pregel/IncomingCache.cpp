@@ -53,7 +53,9 @@ void InCache<M>::parseMessages(VPackSlice const& incomingData) {
 
   for (VPackSlice current : VPackArrayIterator(messages)) {
     if (i % 2 == 0) {  // TODO support multiple recipients
-      key = current.copyString();
+      VPackValueLength length;
+      char const* value = current.getString(length);
+      key.assign(value, static_cast<size_t>(length));
     } else {
       if (current.isArray()) {
         VPackValueLength c = 0;
@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KeyDictionary.h"
+
+#include "Basics/MutexLocker.h"
+
+using namespace arangodb;
+using namespace arangodb::pregel;
+
+constexpr size_t KeyDictionary::NumStripes;
+
+PregelKey const* KeyDictionary::intern(std::string&& key) {
+  Stripe& stripe = _stripes[std::hash<std::string>()(key) % NumStripes];
+  MUTEX_LOCKER(locker, stripe._lock);
+  // elements of unordered containers do not move on rehashing
+  return &(*stripe._keys.emplace(std::move(key)).first);
+}
+
+size_t KeyDictionary::size() const {
+  size_t result = 0;
+  for (auto const& stripe : _stripes) {
+    MUTEX_LOCKER(locker, stripe._lock);
+    result += stripe._keys.size();
+  }
+  return result;
+}
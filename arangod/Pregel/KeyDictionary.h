@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_PREGEL_KEY_DICTIONARY_H
+#define ARANGODB_PREGEL_KEY_DICTIONARY_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Pregel/Graph.h"
+
+#include <array>
+
+namespace arangodb {
+namespace pregel {
+
+/// @brief stores every vertex key of a graph store once. vertices and edges
+/// point to their keys in the dictionary instead of holding a copy each.
+/// keys are never removed, so the pointers stay valid as long as the
+/// dictionary. thread-safe, concurrent loaders mostly lock different stripes
+class KeyDictionary {
+ public:
+  KeyDictionary() {}
+  KeyDictionary(KeyDictionary const&) = delete;
+  KeyDictionary& operator=(KeyDictionary const&) = delete;
+
+  /// @brief the stored copy of the key, which is added if necessary
+  PregelKey const* intern(std::string&& key);
+  PregelKey const* intern(std::string const& key) {
+    return intern(std::string(key));
+  }
+
+  /// @brief number of distinct keys
+  size_t size() const;
+
+ private:
+  static constexpr size_t NumStripes = 16;
+
+  struct Stripe {
+    mutable Mutex _lock;
+    std::unordered_set<PregelKey> _keys;
+  };
+
+  std::array<Stripe, NumStripes> _stripes;
+};
+
+}  // namespace pregel
+}  // namespace arangodb
+
+#endif
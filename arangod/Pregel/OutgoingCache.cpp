@@ -38,6 +38,21 @@
 using namespace arangodb;
 using namespace arangodb::pregel;
 
+namespace {
+/// @brief messages are sent as velocypack, so that the receiver does not
+/// need to parse all values from JSON again
+std::unique_ptr<std::unordered_map<std::string, std::string>> messageHeaders() {
+  auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
+  headers->emplace(StaticStrings::ContentTypeHeader, StaticStrings::MimeTypeVPack);
+  return headers;
+}
+
+std::shared_ptr<std::string const> messageBody(VPackBuilder const& data) {
+  return std::make_shared<std::string const>(
+      reinterpret_cast<char const*>(data.data()), data.size());
+}
+}  // namespace
+
 template <typename M>
 OutCache<M>::OutCache(WorkerConfig* state, MessageFormat<M> const* format)
     : _config(state), _format(format) {
@@ -126,9 +141,9 @@ void ArrayOutCache<M>::flushMessages() {
     data.close();
     // add a request
     ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
     requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
-                          this->_baseUrl + Utils::messagesPath, body);
+                          this->_baseUrl + Utils::messagesPath,
+                          messageBody(data), messageHeaders());
   }
   size_t nrDone = 0;
   ClusterComm::instance()->performRequests(requests, 120, nrDone,
@@ -228,9 +243,9 @@ void CombiningOutCache<M>::flushMessages() {
     data.close();
     // add a request
     ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
     requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
-                          this->_baseUrl + Utils::messagesPath, body);
+                          this->_baseUrl + Utils::messagesPath,
+                          messageBody(data), messageHeaders());
   }
   size_t nrDone = 0;
   ClusterComm::instance()->performRequests(requests, 180, nrDone,
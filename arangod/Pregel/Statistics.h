@@ -34,7 +34,10 @@ namespace pregel {
 struct MessageStats {
   size_t sendCount = 0;
   size_t receivedCount = 0;
+  /// summed up runtime of all processing threads
   double superstepRuntimeSecs = 0;
+  /// runtime of the slowest processing thread
+  double maxThreadRuntimeSecs = 0;
 
   MessageStats() {}
   MessageStats(VPackSlice statValues) { accumulate(statValues); }
@@ -44,6 +47,8 @@ struct MessageStats {
     sendCount += other.sendCount;
     receivedCount += other.receivedCount;
     superstepRuntimeSecs += other.superstepRuntimeSecs;
+    maxThreadRuntimeSecs =
+        std::max(maxThreadRuntimeSecs, other.maxThreadRuntimeSecs);
   }
 
   void accumulate(VPackSlice statValues) {
@@ -55,21 +60,29 @@ struct MessageStats {
     if (p.isInteger()) {
       receivedCount += p.getUInt();
     }
-    // p = statValues.get(Utils::superstepRuntimeKey);
-    // if (p.isNumber()) {
-    //  superstepRuntimeSecs += p.getNumber<double>();
-    //}
+    // the slowest threads of consecutive steps add up
+    p = statValues.get(Utils::threadRuntimeKey);
+    if (p.isNumber()) {
+      superstepRuntimeSecs += p.getNumber<double>();
+    }
+    p = statValues.get(Utils::maxThreadRuntimeKey);
+    if (p.isNumber()) {
+      maxThreadRuntimeSecs += p.getNumber<double>();
+    }
   }
 
   void serializeValues(VPackBuilder& b) const {
     b.add(Utils::sendCountKey, VPackValue(sendCount));
     b.add(Utils::receivedCountKey, VPackValue(receivedCount));
+    b.add(Utils::threadRuntimeKey, VPackValue(superstepRuntimeSecs));
+    b.add(Utils::maxThreadRuntimeKey, VPackValue(maxThreadRuntimeSecs));
   }
 
   void resetTracking() {
     sendCount = 0;
     receivedCount = 0;
     superstepRuntimeSecs = 0;
+    maxThreadRuntimeSecs = 0;
   }
 
   bool allMessagesProcessed() { return sendCount == receivedCount; }
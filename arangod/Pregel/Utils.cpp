@@ -60,10 +60,13 @@ std::string const Utils::userParametersKey = "userparams";
 std::string const Utils::asyncModeKey = "asyncMode";
 std::string const Utils::lazyLoadingKey = "lazyloading";
 std::string const Utils::parallelismKey = "parallelism";
+std::string const Utils::bulkStoreKey = "bulkStore";
 
 std::string const Utils::globalSuperstepKey = "gss";
 std::string const Utils::vertexCountKey = "vertexCount";
 std::string const Utils::edgeCountKey = "edgeCount";
+std::string const Utils::vertexLoadTimeKey = "vertexLoadTime";
+std::string const Utils::edgeLoadTimeKey = "edgeLoadTime";
 std::string const Utils::shardIdKey = "shrdId";
 std::string const Utils::messagesKey = "msgs";
 std::string const Utils::senderKey = "sender";
@@ -73,6 +76,8 @@ std::string const Utils::aggregatorValuesKey = "aggregators";
 std::string const Utils::activeCountKey = "activeCount";
 std::string const Utils::receivedCountKey = "receivedCount";
 std::string const Utils::sendCountKey = "sendCount";
+std::string const Utils::threadRuntimeKey = "threadRuntime";
+std::string const Utils::maxThreadRuntimeKey = "maxThreadRuntime";
 std::string const Utils::enterNextGSSKey = "nextGSS";
 
 std::string const Utils::compensate = "compensate";
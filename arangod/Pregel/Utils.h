@@ -70,6 +70,7 @@ class Utils {
   static std::string const asyncModeKey;
   static std::string const lazyLoadingKey;
   static std::string const parallelismKey;
+  static std::string const bulkStoreKey;
 
   /// Current global superstep
   static std::string const globalSuperstepKey;
@@ -80,6 +81,10 @@ class Utils {
   /// Communicate number of loaded edges to conductor
   static std::string const edgeCountKey;
 
+  /// Communicate the seconds spent loading vertices / edges to conductor
+  static std::string const vertexLoadTimeKey;
+  static std::string const edgeLoadTimeKey;
+
   /// Shard id, part of message header
   static std::string const shardIdKey;
 
@@ -110,6 +115,12 @@ class Utils {
   /// superstep (bookkeeping)
   static std::string const sendCountKey;
 
+  /// Summed up runtime of all vertex processing threads
+  static std::string const threadRuntimeKey;
+
+  /// Runtime of the slowest vertex processing thread
+  static std::string const maxThreadRuntimeKey;
+
   /// Used to communicate to enter the next phase
   /// only send by the conductor
   static std::string const enterNextGSSKey;
@@ -65,6 +65,7 @@ Worker<V, E, M>::Worker(
     : _state(WorkerState::IDLE),
       _config(&vocbase, initConfig),
       _algorithm(algo),
+      _nextVertex(0),
       _nextGSSSendMessageCount(0),
       _requestedNextGSS(false) {
   MUTEX_LOCKER(guard, _commandMutex);
@@ -153,6 +154,9 @@ void Worker<V, E, M>::setupWorker() {
     package.add(Utils::vertexCountKey,
                 VPackValue(_graphStore->localVertexCount()));
     package.add(Utils::edgeCountKey, VPackValue(_graphStore->localEdgeCount()));
+    package.add(Utils::vertexLoadTimeKey,
+                VPackValue(_graphStore->vertexLoadTime()));
+    package.add(Utils::edgeLoadTimeKey, VPackValue(_graphStore->edgeLoadTime()));
     package.close();
     _callConductor(Utils::finishedStartupPath, package);
   };
@@ -323,37 +327,31 @@ void Worker<V, E, M>::_startProcessing() {
   TRI_ASSERT(SchedulerFeature::SCHEDULER != nullptr);
   rest::Scheduler* scheduler = SchedulerFeature::SCHEDULER;
 
-  size_t total = _graphStore->localVertexCount();
-  size_t delta = total / _config.parallelism();
-  size_t start = 0, end = delta;
-  if (delta < 100 || total < 100) {
-    _runningThreads = 1;
-    end = total;
-  } else {
-    _runningThreads = total / delta;  // rounds-up unsigned integers
-  }
-  size_t i = 0;
-  do {
-    scheduler->queue(RequestPriority::LOW, [this, start, end, i] {
+  // threads claim small chunks of vertices until none are left, so that
+  // threads which get cheap vertices take over work from the others
+  size_t const total = _graphStore->localVertexCount();
+  size_t const parallelism = _config.parallelism();
+  _vertexChunkSize = std::max<size_t>(100, total / (parallelism * 32));
+  _nextVertex = 0;
+  _lastVertex = total;
+  size_t const chunks = (total + _vertexChunkSize - 1) / _vertexChunkSize;
+  _runningThreads = std::max<size_t>(1, std::min(parallelism, chunks));
+
+  for (size_t i = 0; i < _runningThreads; i++) {
+    scheduler->queue(RequestPriority::LOW, [this, i] {
       if (_state != WorkerState::COMPUTING) {
         LOG_TOPIC(WARN, Logger::PREGEL) << "Execution aborted prematurely.";
         return;
       }
-      auto vertices = _graphStore->vertexIterator(start, end);
       // should work like a join operation
-      if (_processVertices(i, vertices) && _state == WorkerState::COMPUTING) {
+      if (_processVertices(i) && _state == WorkerState::COMPUTING) {
         _finishedProcessing();  // last thread turns the lights out
       }
       });
-    start = end;
-    end = end + delta;
-    if (total < end + delta) {  // swallow the rest
-      end = total;
-    }
-    i++;
-  } while (start != total);
-  // TRI_ASSERT(_runningThreads == i);
-  LOG_TOPIC(DEBUG, Logger::PREGEL) << "Using " << i << " Threads";
+  }
+  LOG_TOPIC(DEBUG, Logger::PREGEL) << "Using " << _runningThreads
+                                   << " Threads, chunks of "
+                                   << _vertexChunkSize << " vertices";
 }
 
 template <typename V, typename E, typename M>
@@ -367,8 +365,7 @@ void Worker<V, E, M>::_initializeVertexContext(VertexContext<V, E, M>* ctx) {
 
 // internally called in a WORKER THREAD!!
 template <typename V, typename E, typename M>
-bool Worker<V, E, M>::_processVertices(
-    size_t threadId, RangeIterator<VertexEntry>& vertexIterator) {
+bool Worker<V, E, M>::_processVertices(size_t threadId) {
   double start = TRI_microtime();
 
   // thread local caches
@@ -396,20 +393,27 @@ bool Worker<V, E, M>::_processVertices(
   }
 
   size_t activeCount = 0;
-  for (VertexEntry* vertexEntry : vertexIterator) {
-    MessageIterator<M> messages =
-        _readCache->getMessages(vertexEntry->shard(), vertexEntry->key());
-
-    if (messages.size() > 0 || vertexEntry->active()) {
-      vertexComputation->_vertexEntry = vertexEntry;
-      vertexComputation->compute(messages);
-      if (vertexEntry->active()) {
-        activeCount++;
-      }
-    }
-    if (_state != WorkerState::COMPUTING) {
+  while (_state == WorkerState::COMPUTING) {
+    size_t const begin = _nextVertex.fetch_add(_vertexChunkSize);
+    if (begin >= _lastVertex) {
       break;
     }
+    size_t const end = std::min(begin + _vertexChunkSize, _lastVertex);
+    for (VertexEntry* vertexEntry : _graphStore->vertexIterator(begin, end)) {
+      MessageIterator<M> messages =
+          _readCache->getMessages(vertexEntry->shard(), vertexEntry->key());
+
+      if (messages.size() > 0 || vertexEntry->active()) {
+        vertexComputation->_vertexEntry = vertexEntry;
+        vertexComputation->compute(messages);
+        if (vertexEntry->active()) {
+          activeCount++;
+        }
+      }
+      if (_state != WorkerState::COMPUTING) {
+        break;
+      }
+    }
   }
   // ==================== send messages to other shards ====================
   outCache->flushMessages();
@@ -431,6 +435,7 @@ bool Worker<V, E, M>::_processVertices(
   MessageStats stats;
   stats.sendCount = outCache->sendCount();
   stats.superstepRuntimeSecs = TRI_microtime() - start;
+  stats.maxThreadRuntimeSecs = stats.superstepRuntimeSecs;
   inCache->clear();
   outCache->clear();
 
@@ -502,9 +507,9 @@ void Worker<V, E, M>::_finishedProcessing() {
         } else {
           // TODO call _startProcessing ???
           _runningThreads = 1;
-          auto addedVertices =
-              _graphStore->vertexIterator(currentAVCount, total);
-          _processVertices(0, addedVertices);
+          _nextVertex = currentAVCount;
+          _lastVertex = total;
+          _processVertices(0);
         }
       }
     }
@@ -132,6 +132,12 @@ class Worker : public IWorker {
   uint64_t _activeCount = 0;
   /// current number of running threads
   size_t _runningThreads = 0;
+  /// next vertex to be claimed by a processing thread
+  std::atomic<size_t> _nextVertex;
+  /// end of the vertex range processed in the current step
+  size_t _lastVertex = 0;
+  /// number of vertices claimed by a thread at once
+  size_t _vertexChunkSize = 0;
   /// During async mode this should keep track of the send messages
   std::atomic<uint64_t> _nextGSSSendMessageCount;
   /// if the worker has started sendng messages to the next GSS
@@ -141,8 +147,7 @@ class Worker : public IWorker {
   void _initializeMessageCaches();
   void _initializeVertexContext(VertexContext<V, E, M>* ctx);
   void _startProcessing();
-  bool _processVertices(size_t threadId,
-                        RangeIterator<VertexEntry>& vertexIterator);
+  bool _processVertices(size_t threadId);
   void _finishedProcessing();
   void _continueAsync();
   void _callConductor(std::string const& path, VPackBuilder const& message);
@@ -61,6 +61,8 @@ void WorkerConfig::updateConfig(VPackSlice params) {
     _parallelism =
         std::min(std::max((uint64_t)1, parallel.getUInt()), _parallelism);
   }
+  VPackSlice bulkStore = userParams.get(Utils::bulkStoreKey);
+  _bulkStore = bulkStore.isBool() && bulkStore.getBool();
 
   // list of all shards, equal on all workers. Used to avoid storing strings of
   // shard names
@@ -60,6 +60,8 @@ class WorkerConfig {
 
   inline uint64_t parallelism() const { return _parallelism; }
 
+  inline bool bulkStore() const { return _bulkStore; }
+
   inline std::string const& coordinatorId() const { return _coordinatorId; }
 
   inline TRI_vocbase_t* const& vocbase() const { return _vocbase; }
@@ -129,6 +131,8 @@ class WorkerConfig {
   bool _lazyLoading = false;
 
   uint64_t _parallelism = 1;
+  /// store results with exclusive bulk load transactions
+  bool _bulkStore = false;
 
   std::string _coordinatorId;
   TRI_vocbase_t* _vocbase;
@@ -766,6 +766,7 @@ Result DatabaseInitialSyncer::fetchCollectionDump(
     trx.addHint(transaction::Hints::Hint::RECOVERY);
     // do not index the operations in our own transaction
     trx.addHint(transaction::Hints::Hint::NO_INDEXING);
+    trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
 
     // smaller batch sizes should work better here
 #if VPACK_DUMP
@@ -1290,6 +1291,24 @@ Result DatabaseInitialSyncer::handleCollection(VPackSlice const& parameters,
       reloadUsers();
     }
 
+    return res;
+  }
+
+  // create the indexes once the data of all collections is loaded
+  // -------------------------------------------------------------------------------------
+
+  else if (phase == PHASE_INDEXES) {
+    auto* col = resolveCollection(vocbase(), parameters).get();
+
+    if (col == nullptr) {
+      return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND,
+                    std::string("cannot create indexes: ") + collectionMsg +
+                        " not found on slave. Collection info " +
+                        parameters.toJson());
+    }
+
+    Result res;
+
     // schmutz++ creates indexes on DBServers
     if (_config.applier._skipCreateDrop) {
       _config.progress.set("creating indexes for " + collectionMsg +
@@ -1516,11 +1535,23 @@ Result DatabaseInitialSyncer::handleCollectionsAndViews(VPackSlice const& collSl
     _config.progress.set("view creation skipped because of configuration");
   }
   
-  // STEP 4: sync collection data from master and create initial indexes
+  // STEP 4: sync collection data from master
   // ----------------------------------------------------------------------------------
   
   // now load the data into the collections
-  return iterateCollections(collections, incremental, PHASE_DUMP);
+  Result r = iterateCollections(collections, incremental, PHASE_DUMP);
+
+  if (r.fail()) {
+    return r;
+  }
+
+  // STEP 5: create the indexes
+  // ----------------------------------------------------------------------------------
+
+  // all indexes are created after the data of all collections is loaded, so
+  // that the dump phase, during which the master keeps the batch and the
+  // WAL for us, is as short as possible
+  return iterateCollections(collections, incremental, PHASE_INDEXES);
 }
 
 /// @brief iterate over all collections from an array and apply an action
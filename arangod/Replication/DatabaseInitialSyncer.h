@@ -62,7 +62,8 @@ class DatabaseInitialSyncer final : public InitialSyncer {
     PHASE_INIT,
     PHASE_VALIDATE,
     PHASE_DROP_CREATE,
-    PHASE_DUMP
+    PHASE_DUMP,
+    PHASE_INDEXES
   } SyncPhase;
 
   struct Configuration {
@@ -122,6 +123,8 @@ class DatabaseInitialSyncer final : public InitialSyncer {
         return "drop-create";
       case PHASE_DUMP:
         return "dump";
+      case PHASE_INDEXES:
+        return "indexes";
       case PHASE_NONE:
         break;
     }
@@ -42,6 +42,7 @@ class ReplicationTransaction : public transaction::Methods {
       _guard(vocbase) {
     TRI_ASSERT(_state != nullptr);
     _state->setType(AccessMode::Type::EXCLUSIVE);
+    addHint(transaction::Hints::Hint::LOW_PRIORITY);
   }
 
  private:
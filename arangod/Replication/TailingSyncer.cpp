@@ -64,6 +64,10 @@ using namespace arangodb::rest;
   
 namespace {
 
+/// @brief maximum number of standalone document operations applied in one
+/// transaction before it is committed
+uint64_t const MaxStandaloneOperations = 1000;
+
 bool hasHeader(std::unique_ptr<httpclient::SimpleHttpResult> const& response, std::string const& name) {
   return response->hasHeaderField(name);
 }
@@ -102,10 +106,10 @@ TailingSyncer::TailingSyncer(
       _usersModified(false),
       _useTick(useTick),
       _requireFromPresent(configuration._requireFromPresent),
-      _supportsSingleOperations(false),
       _ignoreRenameCreateDrop(false),
       _ignoreDatabaseMarkers(true),
-      _workInParallel(false) {
+      _workInParallel(false),
+      _standaloneOperations(0) {
   if (barrierId > 0) {
     _state.barrier.id = barrierId;
     _state.barrier.updateTime = TRI_microtime();
@@ -113,13 +117,15 @@ TailingSyncer::TailingSyncer(
 
   // FIXME: move this into engine code
   std::string const& engineName = EngineSelectorFeature::ENGINE->typeName();
-  _supportsSingleOperations = (engineName == "mmfiles");
- 
+
   // Replication for RocksDB expects only one open transaction at a time 
   _supportsMultipleOpenTransactions = (engineName != "rocksdb");
 }
 
-TailingSyncer::~TailingSyncer() { abortOngoingTransactions(); }
+TailingSyncer::~TailingSyncer() {
+  _standaloneTrx.reset();
+  abortOngoingTransactions();
+}
 
 /// @brief decide based on _state.master which api to use
 ///        GlobalTailingSyncer should overwrite this probably
@@ -398,6 +404,9 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
   }
 
   if (tid > 0) {  // part of a transaction
+    // applyLog() commits the standalone operations before
+    TRI_ASSERT(_standaloneTrx == nullptr);
+
     auto it = _ongoingTransactions.find(tid);
 
     if (it == _ongoingTransactions.end()) {
@@ -430,43 +439,89 @@ Result TailingSyncer::processDocument(TRI_replication_operation_e type,
     return r;  // done
   }
 
-  // standalone operation
-  // update the apply tick for all standalone operations
-  SingleCollectionTransaction trx(
-    transaction::StandaloneContext::Create(*vocbase),
-    *coll,
-    AccessMode::Type::EXCLUSIVE
-  );
+  // standalone operation. consecutive ones on the same collection share a
+  // transaction, which applyLog() commits before any other marker is applied
+  TRI_ASSERT(_standaloneTrx == nullptr || _standaloneTrx->cid() == coll->id());
 
-  if (_supportsSingleOperations) {
-    trx.addHint(transaction::Hints::Hint::SINGLE_OPERATION);
-  }
+  if (_standaloneTrx == nullptr) {
+    auto trx = std::make_unique<SingleCollectionTransaction>(
+      transaction::StandaloneContext::Create(*vocbase),
+      *coll,
+      AccessMode::Type::EXCLUSIVE
+    );
 
-  Result res = trx.begin();
+    trx->addHint(transaction::Hints::Hint::LOW_PRIORITY);
 
-  // fix error handling here when function returns result
-  if (!res.ok()) {
-    return Result(res.errorNumber(),
-                  std::string("unable to create replication transaction: ") +
-                      res.errorMessage());
+    Result res = trx->begin();
+
+    // fix error handling here when function returns result
+    if (!res.ok()) {
+      return Result(res.errorNumber(),
+                    std::string("unable to create replication transaction: ") +
+                        res.errorMessage());
+    }
+    _standaloneTrx = std::move(trx);
+    _standaloneOperations = 0;
   }
 
-  std::string collectionName = trx.name();
+  ++_standaloneOperations;
 
-  res = applyCollectionDumpMarker(trx, coll, type, applySlice);
+  Result res = applyCollectionDumpMarker(*_standaloneTrx, coll, type, applySlice);
   if (res.errorNumber() == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED &&
       isSystem) {
     // ignore unique constraint violations for system collections
     res.reset();
   }
 
-  // fix error handling here when function returns result
-  if (res.ok()) {
-    res = trx.commit();
+  return res;
+}
 
-    if (res.ok() && collectionName == TRI_COL_NAME_USERS) {
-      _usersModified = true;
-    }
+/// @brief whether the marker is a standalone document operation that can
+/// be applied in the transaction of the preceding standalone operations
+bool TailingSyncer::continuesStandaloneOperations(VPackSlice const& slice) {
+  TRI_ASSERT(_standaloneTrx != nullptr);
+
+  if (_standaloneOperations >= ::MaxStandaloneOperations) {
+    return false;
+  }
+
+  int typeValue = VelocyPackHelper::getNumericValue<int>(slice, "type", 0);
+  if (typeValue != REPLICATION_MARKER_DOCUMENT &&
+      typeValue != REPLICATION_MARKER_REMOVE) {
+    return false;
+  }
+
+  std::string const transactionId =
+      VelocyPackHelper::getStringValue(slice, "tid", "");
+  if (!transactionId.empty() &&
+      NumberUtils::atoi_zero<TRI_voc_tid_t>(
+          transactionId.data(),
+          transactionId.data() + transactionId.size()) > 0) {
+    return false;
+  }
+
+  TRI_vocbase_t* vocbase = resolveVocbase(slice);
+  if (vocbase == nullptr) {
+    return false;
+  }
+
+  auto coll = resolveCollection(*vocbase, slice);
+  return coll != nullptr && coll->id() == _standaloneTrx->cid();
+}
+
+/// @brief commit the standalone document operations applied so far
+Result TailingSyncer::commitStandaloneOperations() {
+  if (_standaloneTrx == nullptr) {
+    return Result();
+  }
+
+  std::unique_ptr<SingleCollectionTransaction> trx = std::move(_standaloneTrx);
+  std::string collectionName = trx->name();
+
+  Result res = trx->commit();
+
+  if (res.ok() && collectionName == TRI_COL_NAME_USERS) {
+    _usersModified = true;
   }
 
   return res;
@@ -955,6 +1010,26 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response,
     }
   };
   TRI_DEFER(reloader());
+  // operations which are not committed on return are rolled back
+  TRI_DEFER(_standaloneTrx.reset());
+
+  // ticks of standalone operations are applied once they are committed
+  auto updateTicks = [this](bool skipped) {
+    WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
+
+    if (_applier->_state._lastProcessedContinuousTick >
+        _applier->_state._lastAppliedContinuousTick) {
+      _applier->_state._lastAppliedContinuousTick =
+          _applier->_state._lastProcessedContinuousTick;
+    }
+
+    if (skipped) {
+      ++_applier->_state._skippedOperations;
+    } else if (_ongoingTransactions.empty()) {
+      _applier->_state._safeResumeTick =
+          _applier->_state._lastProcessedContinuousTick;
+    }
+  };
 
   StringBuffer& data = response->getBody();
   char const* p = data.begin();
@@ -978,7 +1053,7 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response,
 
     if (lineLength < 2) {
       // we are done
-      return Result();
+      break;
     }
 
     TRI_ASSERT(q <= end);
@@ -1011,6 +1086,16 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response,
       res.reset();
       skipped = true;
     } else {
+      if (_standaloneTrx != nullptr && !continuesStandaloneOperations(slice)) {
+        // a failed commit is never ignored. the ticks stay before the
+        // uncommitted operations, so these are applied again on resume
+        res = commitStandaloneOperations();
+        if (res.fail()) {
+          return res;
+        }
+        updateTicks(false);
+      }
+
       res = applyLogMarker(slice, firstRegularTick);
       skipped = false;
     }
@@ -1040,23 +1125,22 @@ Result TailingSyncer::applyLog(SimpleHttpResult* response,
 
     // update tick value
     // postApplyMarker(processedMarkers, skipped);
-    WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
-
-    if (_applier->_state._lastProcessedContinuousTick >
-        _applier->_state._lastAppliedContinuousTick) {
-      _applier->_state._lastAppliedContinuousTick =
-          _applier->_state._lastProcessedContinuousTick;
-    }
-
-    if (skipped) {
+    if (_standaloneTrx == nullptr) {
+      updateTicks(skipped);
+    } else if (skipped) {
+      WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
       ++_applier->_state._skippedOperations;
-    } else if (_ongoingTransactions.empty()) {
-      _applier->_state._safeResumeTick =
-          _applier->_state._lastProcessedContinuousTick;
     }
   }
 
   // reached the end
+  if (_standaloneTrx != nullptr) {
+    Result res = commitStandaloneOperations();
+    if (res.fail()) {
+      return res;
+    }
+    updateTicks(false);
+  }
   return Result();
 }
 
@@ -1669,7 +1753,9 @@ void TailingSyncer::fetchMasterLog(std::shared_ptr<Syncer::JobSynchronizer> shar
         (firstRegularTick > fetchTick
           ? "&firstRegular=" + StringUtils::itoa(firstRegularTick) : "") +
         "&serverId=" + _state.localServerIdString +
-        "&includeSystem=" + (_state.applier._includeSystem ? "true" : "false");
+        "&includeSystem=" + (_state.applier._includeSystem ? "true" : "false") +
+        // let the master wait for new writes instead of polling it
+        "&waitTime=" + StringUtils::ftoa(static_cast<double>(_state.applier._idleMaxWaitTime) / (1000.0 * 1000.0));
 
     // send request
     setProgress(std::string("fetching master log from tick ") + StringUtils::itoa(fetchTick) +
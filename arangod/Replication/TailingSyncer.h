@@ -37,6 +37,7 @@ namespace arangodb {
 class InitialSyncer;
 class ReplicationApplier;
 class ReplicationTransaction;
+class SingleCollectionTransaction;
   
 namespace httpclient {
 class SimpleHttpResult;
@@ -94,6 +95,13 @@ class TailingSyncer : public Syncer {
   Result processDocument(TRI_replication_operation_e,
                          arangodb::velocypack::Slice const&);
 
+  /// @brief whether the marker is a standalone document operation that can
+  /// be applied in the transaction of the preceding standalone operations
+  bool continuesStandaloneOperations(arangodb::velocypack::Slice const&);
+
+  /// @brief commit the standalone document operations applied so far
+  Result commitStandaloneOperations();
+
   /// @brief renames a collection, based on the VelocyPack provided
   Result renameCollection(arangodb::velocypack::Slice const&);
 
@@ -185,9 +193,6 @@ class TailingSyncer : public Syncer {
   /// data from a master
   bool _requireFromPresent;
 
-  /// @brief whether we can use single operation transactions
-  bool _supportsSingleOperations;
-
   /// @brief ignore rename, create and drop operations for collections
   bool _ignoreRenameCreateDrop;
 
@@ -207,6 +212,13 @@ class TailingSyncer : public Syncer {
 
   /// @brief recycled builder for repeated document creation
   arangodb::velocypack::Builder _documentBuilder;
+
+  /// @brief transaction of consecutive standalone document operations on
+  /// one collection, committed before any other marker is applied
+  std::unique_ptr<SingleCollectionTransaction> _standaloneTrx;
+
+  /// @brief number of operations applied in _standaloneTrx
+  uint64_t _standaloneOperations;
   
   static std::string const WalAccessUrl;
 };
@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestAdminMemoryHandler.h"
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "ApplicationFeatures/V8PlatformFeature.h"
+#include "Aql/QueryList.h"
+#include "Aql/ResourceUsage.h"
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
+#include "Basics/process-utils.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/Manager.h"
+#include "GeneralServer/GeneralServerFeature.h"
+#include "Rest/HttpResponse.h"
+#include "RestServer/DatabaseFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+#include "Utils/ExecContext.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+extern "C" int mallctl(char const*, void*, size_t*, void*, size_t);
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+namespace {
+#ifdef ARANGODB_HAVE_JEMALLOC
+template <typename T>
+bool readMallctl(std::string const& name, T& value) {
+  size_t length = sizeof(T);
+  return mallctl(name.c_str(), &value, &length, nullptr, 0) == 0;
+}
+
+/// @brief adds the totals and the per-arena figures of jemalloc
+void addJemallocStatistics(VPackBuilder& builder) {
+  // jemalloc only refreshes its statistics when the epoch is advanced
+  uint64_t epoch = 1;
+  size_t length = sizeof(epoch);
+  mallctl("epoch", &epoch, &length, &epoch, length);
+
+  auto add = [&builder](char const* name, std::string const& key) {
+    size_t value = 0;
+    if (readMallctl(key, value)) {
+      builder.add(name, VPackValue(value));
+    }
+  };
+
+  add("allocated", "stats.allocated");
+  add("active", "stats.active");
+  add("metadata", "stats.metadata");
+  add("resident", "stats.resident");
+  add("mapped", "stats.mapped");
+  add("retained", "stats.retained");
+
+  size_t pageSize = 4096;
+  readMallctl("arenas.page", pageSize);
+  unsigned numArenas = 0;
+  readMallctl("arenas.narenas", numArenas);
+
+  builder.add("arenas", VPackValue(VPackValueType::Array));
+  for (unsigned i = 0; i < numArenas; ++i) {
+    bool initialized = false;
+    if (!readMallctl("arena." + std::to_string(i) + ".initialized",
+                     initialized) ||
+        !initialized) {
+      continue;
+    }
+
+    std::string const prefix = "stats.arenas." + std::to_string(i) + ".";
+    unsigned threads = 0;
+    size_t activePages = 0;
+    size_t dirtyPages = 0;
+    size_t muzzyPages = 0;
+    size_t resident = 0;
+    size_t small = 0;
+    size_t large = 0;
+    readMallctl(prefix + "nthreads", threads);
+    readMallctl(prefix + "pactive", activePages);
+    readMallctl(prefix + "pdirty", dirtyPages);
+    readMallctl(prefix + "pmuzzy", muzzyPages);
+    readMallctl(prefix + "resident", resident);
+    readMallctl(prefix + "small.allocated", small);
+    readMallctl(prefix + "large.allocated", large);
+
+    builder.openObject();
+    builder.add("index", VPackValue(i));
+    builder.add("threads", VPackValue(threads));
+    builder.add("allocated", VPackValue(small + large));
+    builder.add("active", VPackValue(activePages * pageSize));
+    builder.add("dirty", VPackValue(dirtyPages * pageSize));
+    builder.add("muzzy", VPackValue(muzzyPages * pageSize));
+    builder.add("resident", VPackValue(resident));
+    builder.close();
+  }
+  builder.close();
+}
+#endif
+
+/// @brief adds the memory that the subsystems account for themselves
+void addSubsystems(VPackBuilder& builder) {
+  builder.add("cache", VPackValue(VPackValueType::Object));
+  cache::Manager* manager = CacheManagerFeature::MANAGER;
+  builder.add("allocated",
+              VPackValue(manager != nullptr ? manager->globalAllocation() : 0));
+  builder.add("limit",
+              VPackValue(manager != nullptr ? manager->globalLimit() : 0));
+  builder.close();
+
+  builder.add("storageEngine", VPackValue(VPackValueType::Object));
+  StorageEngine* engine = EngineSelectorFeature::ENGINE;
+  if (engine != nullptr) {
+    engine->getMemoryUsage(builder);
+  }
+  builder.close();
+
+  size_t queries = 0;
+  size_t queryMemory = 0;
+  if (DatabaseFeature::DATABASE != nullptr) {
+    DatabaseFeature::DATABASE->enumerateDatabases(
+        [&queries, &queryMemory](TRI_vocbase_t& vocbase) {
+          auto usage = vocbase.queryList()->currentMemoryUsage();
+          queries += usage.first;
+          queryMemory += usage.second;
+        });
+  }
+  auto& globalMonitor = aql::GlobalResourceMonitor::instance();
+  builder.add("aql", VPackValue(VPackValueType::Object));
+  builder.add("queries", VPackValue(queries));
+  builder.add("memoryUsage", VPackValue(queryMemory));
+  builder.add("limit", VPackValue(globalMonitor.memoryLimit()));
+  builder.close();
+
+  builder.add("v8", VPackValue(VPackValueType::Object));
+  auto platform =
+      application_features::ApplicationServer::lookupFeature<V8PlatformFeature>(
+          "V8Platform");
+  if (platform != nullptr && platform->isEnabled()) {
+    auto usage = platform->heapUsage();
+    builder.add("isolates", VPackValue(usage.first));
+    builder.add("heapSize", VPackValue(usage.second));
+  }
+  builder.close();
+}
+}  // namespace
+
+RestAdminMemoryHandler::RestAdminMemoryHandler(GeneralRequest* request,
+                                               GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+RestStatus RestAdminMemoryHandler::execute() {
+  std::vector<std::string> const& suffixes = _request->suffixes();
+
+  if (suffixes.empty()) {
+    if (_request->requestType() != rest::RequestType::GET) {
+      generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                    TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+      return RestStatus::DONE;
+    }
+    getMemory();
+  } else if (suffixes.size() == 1 && suffixes[0] == "profile") {
+    if (_request->requestType() != rest::RequestType::POST) {
+      generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                    TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+      return RestStatus::DONE;
+    }
+    dumpHeapProfile();
+  } else {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND);
+  }
+
+  return RestStatus::DONE;
+}
+
+void RestAdminMemoryHandler::getMemory() {
+  VPackBuilder builder;
+  builder.openObject();
+
+  ProcessInfo info = TRI_ProcessInfoSelf();
+  builder.add("residentSize", VPackValue(info._residentSize));
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+  builder.add("allocator", VPackValue("jemalloc"));
+  builder.add("jemalloc", VPackValue(VPackValueType::Object));
+  ::addJemallocStatistics(builder);
+  builder.close();
+#else
+  builder.add("allocator", VPackValue("system"));
+#endif
+
+  builder.add("subsystems", VPackValue(VPackValueType::Object));
+  ::addSubsystems(builder);
+  builder.close();
+
+  builder.close();
+  generateResult(rest::ResponseCode::OK, builder.slice());
+}
+
+void RestAdminMemoryHandler::dumpHeapProfile() {
+  if (!GeneralServerFeature::allowProfiling()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN,
+                  "heap profiles require --server.allow-profiling");
+    return;
+  }
+  if (ExecContext::CURRENT != nullptr &&
+      !ExecContext::CURRENT->isAdminUser()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return;
+  }
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+  bool enabled = false;
+  if (!::readMallctl("opt.prof", enabled) || !enabled) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                  "heap profiling requires jemalloc to be built with "
+                  "--enable-prof and the server to be started with "
+                  "MALLOC_CONF=prof:true");
+    return;
+  }
+
+  auto response = dynamic_cast<HttpResponse*>(_response.get());
+  if (response == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid response type");
+  }
+
+  std::string filename;
+  long systemError;
+  std::string errorMessage;
+  int res = TRI_GetTempName(nullptr, filename, false, systemError, errorMessage);
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateError(rest::ResponseCode::SERVER_ERROR, res, errorMessage);
+    return;
+  }
+
+  char const* name = filename.c_str();
+  if (mallctl("prof.dump", nullptr, nullptr, &name, sizeof(name)) != 0) {
+    generateError(rest::ResponseCode::SERVER_ERROR, TRI_ERROR_INTERNAL,
+                  "unable to dump heap profile");
+    return;
+  }
+
+  std::string profile;
+  try {
+    profile = FileUtils::slurp(filename);
+  } catch (...) {
+    TRI_UnlinkFile(filename.c_str());
+    throw;
+  }
+  TRI_UnlinkFile(filename.c_str());
+
+  resetResponse(rest::ResponseCode::OK);
+  response->setContentType("text/plain");
+  response->body().appendText(profile);
+#else
+  generateError(rest::ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                "heap profiling requires jemalloc");
+#endif
+}
@@ -21,9 +21,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestAdminStatisticsHandler.h"
+#include "Basics/StringUtils.h"
+#include "Rest/HttpResponse.h"
 #include "Statistics/Descriptions.h"
 #include "Statistics/StatisticsFeature.h"
 
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
@@ -43,6 +48,8 @@ RestStatus RestAdminStatisticsHandler::execute() {
     getStatistics();
   } else if (_request->requestPath() == "/_admin/statistics-description") {
     getStatisticsDescription();
+  } else if (_request->requestPath() == "/_admin/metrics") {
+    getMetrics();
   } else {
     generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND);
   }
@@ -51,20 +58,9 @@ RestStatus RestAdminStatisticsHandler::execute() {
   return RestStatus::DONE;
 }
 
-void RestAdminStatisticsHandler::getStatistics() {
-  stats::Descriptions const* desc = StatisticsFeature::descriptions();
-  if (!desc) {
-    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_DISABLED, "statistics not enabled");
-    return;
-  }
-  
-  VPackBuffer<uint8_t> buffer;
-  VPackBuilder tmp(buffer);
-  tmp.add(VPackValue(VPackValueType::Object, true));
-  
-  tmp.add("time", VPackValue(TRI_microtime()));
-  tmp.add("enabled", VPackValue(StatisticsFeature::enabled()));
-  
+namespace {
+/// @brief adds the statistics of all groups to an open object
+void addStatistics(stats::Descriptions const* desc, VPackBuilder& tmp) {
   tmp.add("system", VPackValue(VPackValueType::Object, true));
   desc->processStatistics(tmp);
   tmp.close(); // system
@@ -80,6 +76,71 @@ void RestAdminStatisticsHandler::getStatistics() {
   tmp.add("server", VPackValue(VPackValueType::Object, true));
   desc->serverStatistics(tmp);
   tmp.close(); // server
+}
+
+/// @brief metric name in Prometheus style, e.g. "arangodb_client_total_time"
+std::string metricName(std::string const& group, std::string const& name) {
+  std::string result = "arangodb_" + group + "_";
+  for (char c : name) {
+    if (c >= 'A' && c <= 'Z') {
+      result.push_back('_');
+      result.push_back(c - 'A' + 'a');
+    } else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+      result.push_back(c);
+    } else {
+      result.push_back('_');
+    }
+  }
+  return result;
+}
+
+void addMetric(std::string& out, std::string const& name,
+               std::string const& help, char const* type, double value) {
+  out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+  out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+  out.append(name).append(" ").append(basics::StringUtils::ftoa(value)).append("\n");
+}
+
+void addHistogram(std::string& out, std::string const& name,
+                  std::string const& help, std::vector<double> const& cuts,
+                  VPackSlice dist) {
+  VPackSlice counts = dist.get("counts");
+  if (!counts.isArray() || counts.length() != cuts.size() + 1) {
+    return;
+  }
+  out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+  out.append("# TYPE ").append(name).append(" histogram\n");
+  uint64_t sum = 0;
+  for (size_t i = 0; i < cuts.size(); ++i) {
+    sum += counts.at(i).getNumber<uint64_t>();
+    out.append(name).append("_bucket{le=\"")
+        .append(basics::StringUtils::ftoa(cuts[i])).append("\"} ")
+        .append(std::to_string(sum)).append("\n");
+  }
+  uint64_t const count = dist.get("count").getNumber<uint64_t>();
+  out.append(name).append("_bucket{le=\"+Inf\"} ")
+      .append(std::to_string(count)).append("\n");
+  out.append(name).append("_sum ")
+      .append(basics::StringUtils::ftoa(dist.get("sum").getNumber<double>())).append("\n");
+  out.append(name).append("_count ").append(std::to_string(count)).append("\n");
+}
+}  // namespace
+
+void RestAdminStatisticsHandler::getStatistics() {
+  stats::Descriptions const* desc = StatisticsFeature::descriptions();
+  if (!desc) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_DISABLED, "statistics not enabled");
+    return;
+  }
+  
+  VPackBuffer<uint8_t> buffer;
+  VPackBuilder tmp(buffer);
+  tmp.add(VPackValue(VPackValueType::Object, true));
+  
+  tmp.add("time", VPackValue(TRI_microtime()));
+  tmp.add("enabled", VPackValue(StatisticsFeature::enabled()));
+  
+  addStatistics(desc, tmp);
   
   tmp.add(StaticStrings::Error, VPackValue(false));
   tmp.add(StaticStrings::Code, VPackValue(static_cast<int>(ResponseCode::OK)));
@@ -119,3 +180,58 @@ void RestAdminStatisticsHandler::getStatisticsDescription() {
   tmp.close(); // outer
   generateResult(ResponseCode::OK, std::move(buffer));
 }
+
+/// @brief all statistics figures in the Prometheus text exposition format
+void RestAdminStatisticsHandler::getMetrics() {
+  stats::Descriptions const* desc = StatisticsFeature::descriptions();
+  if (!desc) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_DISABLED, "statistics not enabled");
+    return;
+  }
+
+  auto response = dynamic_cast<HttpResponse*>(_response.get());
+  if (response == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid response type");
+  }
+
+  VPackBuilder tmp;
+  tmp.openObject();
+  addStatistics(desc, tmp);
+  tmp.close();
+  VPackSlice stats = tmp.slice();
+
+  std::string out;
+  for (stats::Figure const& figure : desc->figures()) {
+    std::string const group = stats::fromGroupType(figure.groupType);
+    VPackSlice value = stats.get(group).get(figure.identifier);
+    std::string const name = metricName(group, figure.identifier);
+    if (figure.type == stats::FigureType::Distribution) {
+      if (value.isObject()) {
+        addHistogram(out, name, figure.description, figure.cuts, value);
+      }
+    } else if (value.isNumber()) {
+      addMetric(out, name, figure.description,
+                figure.type == stats::FigureType::Accumulated ? "counter" : "gauge",
+                value.getNumber<double>());
+    }
+  }
+
+  // scheduler queues and lanes are not described by figures
+  for (char const* section : {"threads", "lanes", "v8Context"}) {
+    VPackSlice values = stats.get("server").get(section);
+    if (!values.isObject()) {
+      continue;
+    }
+    for (auto const& it : VPackObjectIterator(values)) {
+      if (it.value.isNumber()) {
+        std::string const name = metricName(std::string("server_") + section,
+                                            it.key.copyString());
+        addMetric(out, name, name, "gauge", it.value.getNumber<double>());
+      }
+    }
+  }
+
+  resetResponse(rest::ResponseCode::OK);
+  response->setContentType("text/plain; version=0.0.4");
+  response->body().appendText(out);
+}
@@ -39,6 +39,7 @@ class RestAdminStatisticsHandler : public RestBaseHandler {
  private:
   void getStatistics();
   void getStatisticsDescription();
+  void getMetrics();
 };
 }
 
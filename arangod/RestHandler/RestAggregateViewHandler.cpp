@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestAggregateViewHandler.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RestServer/AggregateViewFeature.h"
+#include "Utils/AggregateView.h"
+#include "Utils/ExecContext.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+RestAggregateViewHandler::RestAggregateViewHandler(GeneralRequest* request,
+                                                   GeneralResponse* response)
+    : RestVocbaseBaseHandler(request, response) {}
+
+RestStatus RestAggregateViewHandler::execute() {
+  AggregateViewFeature* feature = AggregateViewFeature::AGGREGATE_VIEWS;
+  if (feature == nullptr) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED,
+                  TRI_ERROR_NOT_IMPLEMENTED,
+                  "aggregate views are only available on single servers");
+    return RestStatus::DONE;
+  }
+
+  std::vector<std::string> const& suffixes = _request->suffixes();
+  auto const type = _request->requestType();
+
+  if (suffixes.empty()) {
+    if (type == rest::RequestType::POST) {
+      createView(feature);
+      return RestStatus::DONE;
+    }
+    if (type == rest::RequestType::GET) {
+      listViews(feature);
+      return RestStatus::DONE;
+    }
+  } else if (suffixes.size() == 1) {
+    if (type == rest::RequestType::GET) {
+      readView(feature, suffixes[0]);
+      return RestStatus::DONE;
+    }
+    if (type == rest::RequestType::DELETE_REQ) {
+      dropView(feature, suffixes[0]);
+      return RestStatus::DONE;
+    }
+  } else {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting /_api/aggregate-view/<name>");
+    return RestStatus::DONE;
+  }
+
+  generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+  return RestStatus::DONE;
+}
+
+void RestAggregateViewHandler::createView(AggregateViewFeature* feature) {
+  bool parseSuccess = false;
+  VPackSlice body = parseVPackBody(parseSuccess);
+  if (!parseSuccess) {
+    return;
+  }
+  if (!body.isObject()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "invalid body value. expecting object");
+    return;
+  }
+
+  std::string const collection =
+      basics::VelocyPackHelper::getStringValue(body, "collection", "");
+  ExecContext const* exec = ExecContext::CURRENT;
+  if (exec != nullptr &&
+      (!exec->canUseDatabase(_vocbase.name(), auth::Level::RW) ||
+       !exec->canUseCollection(_vocbase.name(), collection,
+                               auth::Level::RO))) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return;
+  }
+
+  Result res = feature->create(_vocbase, body);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+
+  auto view = feature->lookup(_vocbase.name(),
+      basics::VelocyPackHelper::getStringValue(body, "name", ""));
+  VPackBuilder builder;
+  if (view != nullptr) {
+    view->toVelocyPack(builder);
+  } else {
+    // dropped concurrently
+    builder.add(body);
+  }
+  generateResult(rest::ResponseCode::CREATED, builder.slice());
+}
+
+void RestAggregateViewHandler::listViews(AggregateViewFeature* feature) {
+  ExecContext const* exec = ExecContext::CURRENT;
+  if (exec != nullptr && !exec->canUseDatabase(_vocbase.name(),
+                                               auth::Level::RO)) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("views", VPackValue(VPackValueType::Array));
+  feature->list(_vocbase.name(), builder);
+  builder.close();
+  builder.close();
+  generateResult(rest::ResponseCode::OK, builder.slice());
+}
+
+void RestAggregateViewHandler::readView(AggregateViewFeature* feature,
+                                        std::string const& name) {
+  auto view = feature->lookup(_vocbase.name(), name);
+  if (view == nullptr) {
+    generateError(rest::ResponseCode::NOT_FOUND,
+                  TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+    return;
+  }
+
+  ExecContext const* exec = ExecContext::CURRENT;
+  if (exec != nullptr &&
+      !exec->canUseCollection(_vocbase.name(), view->collection(),
+                              auth::Level::RO)) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return;
+  }
+
+  VPackBuilder builder;
+  view->toResult(builder);
+  generateResult(rest::ResponseCode::OK, builder.slice());
+}
+
+void RestAggregateViewHandler::dropView(AggregateViewFeature* feature,
+                                        std::string const& name) {
+  ExecContext const* exec = ExecContext::CURRENT;
+  if (exec != nullptr && !exec->canUseDatabase(_vocbase.name(),
+                                               auth::Level::RW)) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return;
+  }
+
+  Result res = feature->drop(_vocbase.name(), name);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("name", VPackValue(name));
+  builder.close();
+  generateResult(rest::ResponseCode::OK, builder.slice());
+}
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_REST_HANDLER_REST_AGGREGATE_VIEW_HANDLER_H
+#define ARANGOD_REST_HANDLER_REST_AGGREGATE_VIEW_HANDLER_H 1
+
+#include "Basics/Common.h"
+#include "RestHandler/RestVocbaseBaseHandler.h"
+
+namespace arangodb {
+
+class AggregateViewFeature;
+
+/// @brief handler for /_api/aggregate-view
+///   POST /_api/aggregate-view         creates a view
+///   GET /_api/aggregate-view          lists the view definitions
+///   GET /_api/aggregate-view/<name>   returns the grouped result
+///   DELETE /_api/aggregate-view/<name> drops a view
+class RestAggregateViewHandler : public RestVocbaseBaseHandler {
+ public:
+  RestAggregateViewHandler(GeneralRequest*, GeneralResponse*);
+
+ public:
+  char const* name() const override final {
+    return "RestAggregateViewHandler";
+  }
+  RequestLane lane() const override final { return RequestLane::CLIENT_FAST; }
+  RestStatus execute() override;
+
+ private:
+  void createView(AggregateViewFeature* feature);
+  void listViews(AggregateViewFeature* feature);
+  void readView(AggregateViewFeature* feature, std::string const& name);
+  void dropView(AggregateViewFeature* feature, std::string const& name);
+};
+
+}  // namespace arangodb
+
+#endif
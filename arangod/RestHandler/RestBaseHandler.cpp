@@ -34,6 +34,8 @@
 #include "Meta/conversion.h"
 #include "Rest/HttpRequest.h"
 #include "Rest/HttpResponse.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Context.h"
 
 using namespace arangodb;
@@ -44,6 +46,29 @@ RestBaseHandler::RestBaseHandler(GeneralRequest* request,
                                  GeneralResponse* response)
     : RestHandler(request, response) {}
 
+RestStatus RestBaseHandler::waitForPayload() {
+  if (!_response->payloadPending()) {
+    return RestStatus::DONE;
+  }
+
+  auto self = shared_from_this();
+  _response->waitForPayload([self]() {
+    // invoked by the io thread, which must not generate the body
+    auto scheduler = SchedulerFeature::SCHEDULER;
+    if (scheduler != nullptr) {
+      scheduler->queue(RequestPriority::HIGH,
+                       [self]() { self->continueHandlerExecution(); });
+    }
+  });
+  return RestStatus::WAITING;
+}
+
+RestStatus RestBaseHandler::continuePayload() {
+  TRI_ASSERT(_response->payloadPending());
+  _response->continuePayload();
+  return waitForPayload();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief parses the body as VelocyPack
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +70,15 @@ class RestBaseHandler : public rest::RestHandler {
   // generates a canceled message
   void generateCanceled();
 
+  /// @brief returns WAITING if the generation of a streamed body was paused
+  /// until the client has read more of it, and DONE otherwise. the handler
+  /// is continued once the client has caught up, and must then call
+  /// continuePayload() from continueExecute()
+  RestStatus waitForPayload();
+
+  /// @brief continues the generation of a paused body
+  RestStatus continuePayload();
+
  protected:
   /// @brief parses the body as VelocyPack
   std::shared_ptr<arangodb::velocypack::Builder> parseVelocyPackBody(bool& success);
@@ -27,12 +27,14 @@
 #include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
+#include "GeneralServer/AuthenticationFeature.h"
 #include "Rest/HttpRequest.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/PhysicalCollection.h"
 #include "StorageEngine/StorageEngine.h"
 #include "Transaction/Methods.h"
 #include "Transaction/StandaloneContext.h"
+#include "Utils/ExecContext.h"
 #include "Utils/OperationOptions.h"
 #include "Utils/SingleCollectionTransaction.h"
 #include "VocBase/LogicalCollection.h"
@@ -234,6 +236,13 @@ void RestCollectionHandler::handleCommandGet() {
             /*detailedCount*/ true
           );
 
+          if (_request->parsedValue("details", false)) {
+            // routing information for clients that talk to the shard
+            // leaders directly
+            shardDetails(builder, *coll);
+            return;
+          }
+
           auto shards = ClusterInfo::instance()->getShardList(
             std::to_string(coll->planId())
           );
@@ -264,6 +273,51 @@ void RestCollectionHandler::handleCommandGet() {
   }
 }
 
+void RestCollectionHandler::shardDetails(VPackBuilder& builder,
+                                         LogicalCollection const& coll) {
+  ClusterInfo* ci = ClusterInfo::instance();
+
+  // read the version first, so the shard map is at least as recent.
+  // DB servers refuse requests with an older version
+  uint64_t const planVersion = ci->getPlanVersion();
+  auto current = ci->getCollection(_vocbase.name(), std::to_string(coll.planId()));
+  auto shards = current->shardIds();
+
+  builder.add("planVersion", VPackValue(planVersion));
+
+  std::unordered_map<ServerID, std::string> endpoints;
+  { VPackObjectBuilder obj(&builder, "shards");
+    for (auto const& shard : *shards) {
+      VPackArrayBuilder arr(&builder, shard.first);
+      for (ServerID const& server : shard.second) {
+        builder.add(VPackValue(server));
+        if (endpoints.find(server) == endpoints.end()) {
+          endpoints.emplace(server, ci->getServerEndpoint(server));
+        }
+      }
+    }
+  }
+
+  { VPackObjectBuilder obj(&builder, "endpoints");
+    for (auto const& it : endpoints) {
+      builder.add(it.first, VPackValue(it.second));
+    }
+  }
+
+  // DB servers do not know any users, so hand out a short-lived token
+  // that grants the user's access to this collection's shards
+  ExecContext const* exec = ExecContext::CURRENT;
+  AuthenticationFeature* auth = AuthenticationFeature::instance();
+  if (auth != nullptr && auth->isActive() && exec != nullptr &&
+      !exec->user().empty()) {
+    auth::Level level = exec->collectionAuthLevel(_vocbase.name(), coll.name());
+    builder.add("token", VPackValue(auth->tokenCache().generateRoutingJwt(
+                             exec->user(), _vocbase.name(), coll.planId(),
+                             level, RoutingTokenTtl)));
+    builder.add("tokenTtl", VPackValue(RoutingTokenTtl));
+  }
+}
+
 // create a collection
 void RestCollectionHandler::handleCommandPost() {
   bool parseSuccess = false;
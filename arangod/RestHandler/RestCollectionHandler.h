@@ -64,6 +64,14 @@ class RestCollectionHandler : public arangodb::RestVocbaseBaseHandler {
                                        velocypack::Builder& builder) = 0;
   
  private:
+  /// @brief lifetime (in seconds) of the tokens handed out with the
+  /// routing information
+  static constexpr double RoutingTokenTtl = 60.0;
+
+  /// @brief adds plan version, shard map, server endpoints and a routing
+  /// token for collection to builder
+  void shardDetails(VPackBuilder& builder, LogicalCollection const& coll);
+
   void handleCommandGet();
   void handleCommandPost();
   void handleCommandPut();
@@ -33,6 +33,7 @@
 #include "Utils/Cursor.h"
 #include "Utils/CursorRepository.h"
 
+#include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/Value.h>
 #include <velocypack/velocypack-aliases.h>
@@ -68,6 +69,9 @@ RestStatus RestCursorHandler::execute() {
   if (type == rest::RequestType::POST) {
     return createQueryCursor();
   } else if (type == rest::RequestType::PUT) {
+    if (_request->suffixes().empty()) {
+      return executePreparedStatement();
+    }
     return modifyQueryCursor();
   } else if (type == rest::RequestType::DELETE_REQ) {
     return deleteQueryCursor();
@@ -78,6 +82,11 @@ RestStatus RestCursorHandler::execute() {
 }
 
 RestStatus RestCursorHandler::continueExecute() {
+  if (_response->payloadPending()) {
+    // the client has read the part of the result sent so far
+    return continuePayload();
+  }
+
   // extract the sub-request type
   rest::RequestType const type = _request->requestType();
   
@@ -92,8 +101,10 @@ RestStatus RestCursorHandler::continueExecute() {
     if (type == rest::RequestType::POST) {
       return generateCursorResult(rest::ResponseCode::CREATED, cs);
     } else if (type == rest::RequestType::PUT) {
-      if (_request->requestPath() == SIMPLE_QUERY_ALL_PATH) {
-        // RestSimpleQueryHandler::allDocuments uses PUT for cursor creation
+      if (_request->requestPath() == SIMPLE_QUERY_ALL_PATH ||
+          _request->suffixes().empty()) {
+        // RestSimpleQueryHandler::allDocuments uses PUT for cursor creation,
+        // and so does the execution of a prepared statement
         return generateCursorResult(ResponseCode::CREATED, cs);
       }
       return generateCursorResult(ResponseCode::OK, cs);
@@ -158,6 +169,17 @@ RestStatus RestCursorHandler::registerQueryOrCursor(VPackSlice const& slice) {
   double ttl = VelocyPackHelper::getNumericValue<double>(opts, "ttl", 30);
   bool count = VelocyPackHelper::getBooleanValue(opts, "count", false);
 
+  if (!stream && !count && !opts.get("stream").isBoolean() &&
+      canStreamResult() && CursorRepository::memoryBudgetExceeded() &&
+      !isModificationQuery(querySlice, bindVarsBuilder)) {
+    // the results of existing cursors already use up the memory budget.
+    // produce the results on demand instead of building them all up front.
+    // this is not done if the client asked for a non-streaming cursor
+    // explicitly, nor for data-modification queries, which would keep their
+    // write transaction open until the client has fetched all results
+    stream = true;
+  }
+
   if (stream) {
     if (count) {
       generateError(Result(TRI_ERROR_BAD_PARAMETER, "cannot use 'count' option for a streaming query"));
@@ -198,6 +220,27 @@ RestStatus RestCursorHandler::registerQueryOrCursor(VPackSlice const& slice) {
   return processQuery();
 }
 
+/// @brief whether the query contains a data-modification operation. a
+/// query which cannot be parsed is treated like one
+bool RestCursorHandler::isModificationQuery(
+    VPackSlice const& querySlice,
+    std::shared_ptr<VPackBuilder> const& bindVars) {
+  VPackValueLength l;
+  char const* queryStr = querySlice.getString(l);
+
+  aql::Query query(
+    false,
+    _vocbase,
+    arangodb::aql::QueryString(queryStr, static_cast<size_t>(l)),
+    bindVars,
+    nullptr,
+    arangodb::aql::PART_MAIN
+  );
+
+  return query.parse().code != TRI_ERROR_NO_ERROR ||
+         query.isModificationQuery();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief Process the query registered in _query.
 /// The function is repeatable, so whenever we need to WAIT
@@ -302,9 +345,11 @@ RestStatus RestCursorHandler::handleQueryResult() {
     } catch (...) {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
+    // large results are sent while they are converted to JSON
+    _response->allowStreaming();
     generateResult(rest::ResponseCode::CREATED, std::move(buffer),
                    _queryResult.context);
-    return RestStatus::DONE;
+    return waitForPayload();
   } else {
     // result is bigger than batchSize, and a cursor will be created
     CursorRepository* cursors = _vocbase.cursorRepository();
@@ -501,10 +546,11 @@ RestStatus RestCursorHandler::generateCursorResult(rest::ResponseCode code,
 
   if (r.ok()) {
     _response->setContentType(rest::ContentType::JSON);
+    _response->allowStreaming();
     generateResult(code, std::move(buffer), std::move(ctx));
-  } else {
-    generateError(r);
+    return waitForPayload();
   }
+  generateError(r);
   return RestStatus::DONE;
 }
 
@@ -542,6 +588,79 @@ RestStatus RestCursorHandler::createQueryCursor() {
   return registerQueryOrCursor(body);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a cursor for a statement registered via
+/// POST /_api/query/prepare. the request body contains the statement id
+/// instead of the query string, plus the usual cursor attributes
+////////////////////////////////////////////////////////////////////////////////
+
+RestStatus RestCursorHandler::executePreparedStatement() {
+  bool parseSuccess = false;
+  VPackSlice body = this->parseVPackBody(parseSuccess);
+
+  if (!parseSuccess) {
+    // error message generated in parseVPackBody
+    return RestStatus::DONE;
+  }
+
+  if (!body.isObject()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting a JSON object as body");
+    return RestStatus::DONE;
+  }
+
+  VPackSlice const id = body.get("statement");
+  if (!id.isString()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting PUT /_api/cursor with <statement> or PUT /_api/cursor/<cursor-id>");
+    return RestStatus::DONE;
+  }
+
+  TRI_ASSERT(_queryRegistry != nullptr);
+  auto statement = _queryRegistry->lookupStatement(
+      &_vocbase, _request->user(),
+      arangodb::basics::StringUtils::uint64(id.copyString()));
+
+  if (statement == nullptr) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_QUERY_NOT_FOUND,
+                  "prepared statement '" + id.copyString() + "' not found");
+    return RestStatus::DONE;
+  }
+
+  // tell RestCursorHandler::finalizeExecute that the request
+  // could be parsed successfully and that it may look at it
+  _isValidForFinalize = true;
+
+  // build the regular cursor request from the statement and the request
+  // body. options sent with the request override the statement's options
+  VPackBuilder request;
+  request.openObject();
+  request.add("query", VPackValue(statement->queryString));
+  for (auto const& it : VPackObjectIterator(body)) {
+    if (it.key.isEqualString("statement") || it.key.isEqualString("query") ||
+        it.key.isEqualString("options")) {
+      continue;
+    }
+    request.add(it.key.copyString(), it.value);
+  }
+
+  VPackSlice options = body.get("options");
+  if (statement->options != nullptr) {
+    if (options.isObject()) {
+      request.add("options", 
+                  VPackCollection::merge(statement->options->slice(), options, false, false).slice());
+    } else {
+      request.add("options", statement->options->slice());
+    }
+  } else if (!options.isNone()) {
+    request.add("options", options);
+  }
+  request.close();
+
+  TRI_ASSERT(_query == nullptr);
+  return registerQueryOrCursor(request.slice());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief was docuBlock JSF_post_api_cursor_identifier
 ////////////////////////////////////////////////////////////////////////////////
@@ -104,6 +104,12 @@ class RestCursorHandler : public RestVocbaseBaseHandler {
   //////////////////////////////////////////////////////////////////////////////
   virtual RestStatus handleQueryResult();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the results of a non-streaming query may be
+  ///        produced by a streaming cursor instead
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool canStreamResult() const { return true; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief whether or not the query was canceled
   //////////////////////////////////////////////////////////////////////////////
@@ -111,6 +117,15 @@ class RestCursorHandler : public RestVocbaseBaseHandler {
   bool wasCanceled();
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the query contains a data-modification operation. a
+  ///        query which cannot be parsed is treated like one
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool isModificationQuery(
+      arangodb::velocypack::Slice const& querySlice,
+      std::shared_ptr<arangodb::velocypack::Builder> const& bindVars);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief register the currently running query
   //////////////////////////////////////////////////////////////////////////////
@@ -144,6 +159,13 @@ class RestCursorHandler : public RestVocbaseBaseHandler {
 
   RestStatus createQueryCursor();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create a cursor for a prepared statement and return the first
+  /// results
+  //////////////////////////////////////////////////////////////////////////////
+
+  RestStatus executePreparedStatement();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the next results from an existing cursor
   //////////////////////////////////////////////////////////////////////////////
@@ -27,7 +27,10 @@
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ServerState.h"
+#include "Futures/Future.h"
 #include "Rest/HttpRequest.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Hints.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/OperationOptions.h"
@@ -44,6 +47,8 @@ RestDocumentHandler::RestDocumentHandler(GeneralRequest* request,
                                          GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
 
+RestDocumentHandler::~RestDocumentHandler() {}
+
 RestStatus RestDocumentHandler::execute() {
   // extract the sub-request type
   auto const type = _request->requestType();
@@ -71,10 +76,25 @@ RestStatus RestDocumentHandler::execute() {
     default: { generateNotImplemented("ILLEGAL " + DOCUMENT_PATH); }
   }
 
+  if (_pendingRead != nullptr) {
+    return RestStatus::WAITING;
+  }
+
   // this handler is done
   return RestStatus::DONE;
 }
 
+RestStatus RestDocumentHandler::continueExecute() {
+  TRI_ASSERT(_pendingRead != nullptr);
+  std::unique_ptr<PendingRead> read = std::move(_pendingRead);
+
+  // rethrows a failure of the request
+  OperationResult& result = read->result.get();
+  finishSingleDocument(*read->trx, result, read->collection, read->key,
+                       read->ifRid, read->ifNoneRid, read->generateBody);
+  return RestStatus::DONE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief was docuBlock REST_DOCUMENT_CREATE
 ////////////////////////////////////////////////////////////////////////////////
@@ -231,6 +251,7 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
   auto trx = createTransaction(collection, AccessMode::Type::READ);
 
   trx->addHint(transaction::Hints::Hint::SINGLE_OPERATION);
+  trx->addHint(transaction::Hints::Hint::SINGLE_READ);
 
   // ...........................................................................
   // inside read transaction
@@ -243,9 +264,46 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
     return false;
   }
 
+  // on a coordinator, the handler is suspended while the DB server looks up
+  // the document. stream transactions are released on suspension, so reads
+  // inside them keep blocking
+  bool isStream = false;
+  _request->header(StaticStrings::XArangoTrxId, isStream);
+  if (ServerState::instance()->isCoordinator() && !isStream) {
+    auto future = trx->documentAsync(collection, search, options);
+    if (!future.isReady()) {
+      _pendingRead.reset(new PendingRead{std::move(trx), collection, key, ifRid,
+                                         ifNoneRid, generateBody,
+                                         futures::Try<OperationResult>()});
+      auto self = shared_from_this();
+      std::move(future).thenFinal(
+          [this, self](futures::Try<OperationResult>&& result) {
+            _pendingRead->result = std::move(result);
+            // the future may be fulfilled while execute() is still running,
+            // so the handler must not be continued on this thread
+            auto scheduler = SchedulerFeature::SCHEDULER;
+            if (scheduler != nullptr) {
+              scheduler->queue(RequestPriority::HIGH,
+                               [self]() { self->continueHandlerExecution(); });
+            }
+          });
+      return true;
+    }
+    OperationResult result = std::move(future).get();
+    return finishSingleDocument(*trx, result, collection, key, ifRid,
+                                ifNoneRid, generateBody);
+  }
+
   OperationResult result = trx->document(collection, search, options);
+  return finishSingleDocument(*trx, result, collection, key, ifRid, ifNoneRid,
+                              generateBody);
+}
 
-  res = trx->finish(result.result);
+bool RestDocumentHandler::finishSingleDocument(
+    SingleCollectionTransaction& trx, OperationResult& result,
+    std::string const& collection, std::string const& key, TRI_voc_rid_t ifRid,
+    TRI_voc_rid_t ifNoneRid, bool generateBody) {
+  Result res = trx.finish(result.result);
 
   if (!result.ok()) {
     if (result.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
@@ -273,7 +331,7 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
   }
 
   // use default options
-  generateDocument(result.slice(), generateBody, trx->transactionContextPtr()->getVPackOptionsForDump());
+  generateDocument(result.slice(), generateBody, trx.transactionContextPtr()->getVPackOptionsForDump());
   return true;
 }
 
@@ -25,15 +25,18 @@
 #define ARANGOD_REST_HANDLER_REST_DOCUMENT_HANDLER_H 1
 
 #include "Basics/Common.h"
+#include "Futures/Try.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
 
 namespace arangodb {
 class RestDocumentHandler : public RestVocbaseBaseHandler {
  public:
   RestDocumentHandler(GeneralRequest*, GeneralResponse*);
+  ~RestDocumentHandler();
 
  public:
   RestStatus execute() override final;
+  RestStatus continueExecute() override final;
   char const* name() const override final { return "RestDocumentHandler"; }
   RequestLane lane() const override final { return RequestLane::CLIENT_SLOW; }
 
@@ -51,6 +54,13 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
   // reads a single document
   bool readSingleDocument(bool generateBody);
 
+  // generates the response of a single document read
+  bool finishSingleDocument(SingleCollectionTransaction& trx,
+                            OperationResult& result,
+                            std::string const& collection,
+                            std::string const& key, TRI_voc_rid_t ifRid,
+                            TRI_voc_rid_t ifNoneRid, bool generateBody);
+
   // reads multiple documents
   bool readManyDocuments();
 
@@ -68,6 +78,21 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
 
   // removes a document
   bool removeDocument();
+
+ private:
+  // a single document read on a coordinator, during which the handler is
+  // suspended until the DB server has answered
+  struct PendingRead {
+    std::unique_ptr<SingleCollectionTransaction> trx;
+    std::string collection;
+    std::string key;
+    TRI_voc_rid_t ifRid;
+    TRI_voc_rid_t ifNoneRid;
+    bool generateBody;
+    futures::Try<OperationResult> result;
+  };
+
+  std::unique_ptr<PendingRead> _pendingRead;
 };
 }
 
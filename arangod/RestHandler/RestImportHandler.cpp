@@ -29,6 +29,8 @@
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Helpers.h"
 #include "Utils/OperationOptions.h"
 #include "Utils/SingleCollectionTransaction.h"
@@ -128,6 +130,14 @@ RestStatus RestImportHandler::execute() {
       break;
   }
 
+  // report the load of the server, so that clients can adjust the rate of
+  // their imports before requests are rejected
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler != nullptr) {
+    _response->setHeaderNC(StaticStrings::QueueFillGrade,
+                           std::to_string(scheduler->queueFillGrade()));
+  }
+
   // this handler is done
   return RestStatus::DONE;
 }
@@ -299,6 +309,8 @@ bool RestImportHandler::createFromJson(std::string const& type) {
   bool const overwrite = _request->parsedValue("overwrite", false);
   OperationOptions opOptions;
   opOptions.waitForSync = _request->parsedValue("waitForSync", false);
+  // bulk loads lock the collection exclusively and ingest SST files
+  bool const bulkLoad = _request->parsedValue("bulkLoad", false);
 
   // extract the collection name
   bool found;
@@ -361,7 +373,13 @@ bool RestImportHandler::createFromJson(std::string const& type) {
 
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
-  SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
+  SingleCollectionTransaction trx(
+      ctx, collectionName,
+      bulkLoad ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE);
+  trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
+  if (bulkLoad) {
+    trx.addHint(transaction::Hints::Hint::BULK_LOAD);
+  }
   trx.addHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS);
 
   // .............................................................................
@@ -552,6 +570,8 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
   bool const overwrite = _request->parsedValue("overwrite", false);
   OperationOptions opOptions;
   opOptions.waitForSync = _request->parsedValue("waitForSync", false);
+  // bulk loads lock the collection exclusively and ingest SST files
+  bool const bulkLoad = _request->parsedValue("bulkLoad", false);
 
   // extract the collection name
   bool found;
@@ -567,7 +587,13 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
 
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
-  SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
+  SingleCollectionTransaction trx(
+      ctx, collectionName,
+      bulkLoad ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE);
+  trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
+  if (bulkLoad) {
+    trx.addHint(transaction::Hints::Hint::BULK_LOAD);
+  }
 
   // .............................................................................
   // inside write transaction
@@ -664,6 +690,8 @@ bool RestImportHandler::createFromKeyValueList() {
   _ignoreMissing = _request->parsedValue("ignoreMissing", false);
   OperationOptions opOptions;
   opOptions.waitForSync = _request->parsedValue("waitForSync", false);
+  // bulk loads lock the collection exclusively and ingest SST files
+  bool const bulkLoad = _request->parsedValue("bulkLoad", false);
 
   // extract the collection name
   bool found;
@@ -751,7 +779,13 @@ bool RestImportHandler::createFromKeyValueList() {
 
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
-  SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
+  SingleCollectionTransaction trx(
+      ctx, collectionName,
+      bulkLoad ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE);
+  trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
+  if (bulkLoad) {
+    trx.addHint(transaction::Hints::Hint::BULK_LOAD);
+  }
 
   // .............................................................................
   // inside write transaction
@@ -0,0 +1,369 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestProfileHandler.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/StringUtils.h"
+#include "Rest/HttpResponse.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifndef _WIN32
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+namespace {
+#ifndef _WIN32
+/// @brief sampling interval (in microseconds)
+constexpr long samplingInterval = 10 * 1000;
+
+/// @brief maximum number of frames recorded per sample
+constexpr int maxFrames = 48;
+
+/// @brief maximum number of samples recorded per profile
+constexpr size_t maxSamples = 16384;
+
+/// @brief frames belonging to the signal handler itself
+constexpr int skipFrames = 2;
+#endif
+}
+
+struct RestProfileHandler::Sample {
+#ifndef _WIN32
+  void* frames[::maxFrames];
+  int depth;
+  int lane;
+  char const* handler;
+  std::atomic<bool> complete;
+#endif
+};
+
+namespace {
+#ifndef _WIN32
+typedef RestProfileHandler::Sample Sample;
+
+/// @brief whether or not a profile is currently being taken
+std::atomic<bool> profiling(false);
+
+/// @brief sample buffer the signal handler writes into, nullptr when idle
+std::atomic<Sample*> samples(nullptr);
+
+/// @brief index of the next free sample
+std::atomic<size_t> nextSample(0);
+
+/// @brief number of signal handlers currently running. the sample buffer
+/// is only freed once this has dropped to 0 after resetting samples
+std::atomic<size_t> handlersInFlight(0);
+
+/// @brief whether the SIGPROF handler is installed. it stays installed
+/// once a profile was taken, so that signals which are still pending when
+/// sampling stops are ignored instead of terminating the process
+std::atomic<bool> handlerInstalled(false);
+
+/// @brief SIGPROF handler. only uses backtrace(), which does not allocate
+/// once it has been called outside of a signal handler, and the
+/// thread-local handler pointer
+void onProfileSignal(int) {
+  int const savedErrno = errno;
+  ::handlersInFlight.fetch_add(1);
+  Sample* buffer = ::samples.load();
+  if (buffer != nullptr) {
+    size_t const index = ::nextSample.fetch_add(1, std::memory_order_relaxed);
+    if (index < maxSamples) {
+      Sample& sample = buffer[index];
+      sample.depth = backtrace(sample.frames, maxFrames);
+      RestHandler const* handler = RestHandler::CURRENT_HANDLER;
+      if (handler != nullptr) {
+        sample.handler = handler->name();
+        sample.lane = static_cast<int>(handler->lane());
+      } else {
+        sample.handler = nullptr;
+        sample.lane = -1;
+      }
+      sample.complete.store(true, std::memory_order_release);
+    }
+  }
+  ::handlersInFlight.fetch_sub(1, std::memory_order_release);
+  errno = savedErrno;
+}
+
+char const* laneName(int lane) {
+  if (lane < 0) {
+    return "no-request";
+  }
+  switch (static_cast<RequestLane>(lane)) {
+    case RequestLane::CLIENT_FAST:
+      return "client-fast";
+    case RequestLane::CLIENT_AQL:
+      return "client-aql";
+    case RequestLane::CLIENT_V8:
+      return "client-v8";
+    case RequestLane::CLIENT_SLOW:
+      return "client-slow";
+    case RequestLane::AGENCY_INTERNAL:
+      return "agency-internal";
+    case RequestLane::AGENCY_CLUSTER:
+      return "agency-cluster";
+    case RequestLane::CLUSTER_INTERNAL:
+      return "cluster-internal";
+    case RequestLane::CLUSTER_V8:
+      return "cluster-v8";
+    case RequestLane::CLUSTER_ADMIN:
+      return "cluster-admin";
+    case RequestLane::SERVER_REPLICATION:
+      return "server-replication";
+    case RequestLane::TASK_V8:
+      return "task-v8";
+  }
+  return "unknown";
+}
+
+/// @brief turns a frame address into a function name
+std::string symbolize(void* address) {
+  std::string result;
+  char** strings = backtrace_symbols(&address, 1);
+
+  if (strings != nullptr) {
+    // format is "binary(mangled+offset) [address]"
+    char* begin = strchr(strings[0], '(');
+    char* end = (begin != nullptr) ? strchr(begin, '+') : nullptr;
+    if (begin != nullptr && end != nullptr && end > begin + 1) {
+      std::string mangled(begin + 1, end - begin - 1);
+      int status = 0;
+      char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+      if (demangled != nullptr) {
+        if (status == 0) {
+          result = demangled;
+        }
+        free(demangled);
+      }
+      if (result.empty()) {
+        result = std::move(mangled);
+      }
+    }
+    free(strings);
+  }
+
+  if (result.empty()) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%p", address);
+    result = buffer;
+  }
+
+  // the collapsed stack format uses ';' as frame separator
+  std::replace(result.begin(), result.end(), ';', ',');
+  return result;
+}
+#endif
+}
+
+RestProfileHandler::RestProfileHandler(GeneralRequest* request,
+                                       GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+RestProfileHandler::~RestProfileHandler() {
+#ifndef _WIN32
+  // the request may be abandoned while sampling, e.g. on shutdown
+  stopSampling();
+#endif
+}
+
+RestStatus RestProfileHandler::execute() {
+  if (_request->requestType() != rest::RequestType::GET) {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                  TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+    return RestStatus::DONE;
+  }
+
+#ifdef _WIN32
+  generateError(rest::ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                "profiling is not supported on this platform");
+  return RestStatus::DONE;
+#else
+  double duration = 30.0;
+  bool found;
+  std::string const& value = _request->value("duration", found);
+  if (found) {
+    duration = StringUtils::doubleDecimal(value);
+  }
+  if (duration <= 0.0 || duration > 300.0) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "duration must be between 0 and 300 seconds");
+    return RestStatus::DONE;
+  }
+
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr) {
+    generateError(rest::ResponseCode::SERVICE_UNAVAILABLE,
+                  TRI_ERROR_SHUTTING_DOWN);
+    return RestStatus::DONE;
+  }
+
+  bool expected = false;
+  if (!::profiling.compare_exchange_strong(expected, true)) {
+    generateError(rest::ResponseCode::CONFLICT, TRI_ERROR_LOCKED,
+                  "another profile is being taken");
+    return RestStatus::DONE;
+  }
+
+  auto guard = scopeGuard([this]() {
+    if (_samples != nullptr) {
+      stopSampling();
+    } else {
+      ::profiling.store(false);
+    }
+  });
+
+  _samples.reset(new Sample[::maxSamples]);
+  for (size_t i = 0; i < ::maxSamples; ++i) {
+    _samples[i].complete.store(false, std::memory_order_relaxed);
+  }
+
+  // the first call of backtrace() may load libgcc and allocate, which
+  // must not happen inside the signal handler
+  void* dummy[2];
+  backtrace(dummy, 2);
+
+  ::nextSample.store(0);
+  ::samples.store(_samples.get());
+
+  if (!::handlerInstalled.exchange(true)) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = ::onProfileSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, nullptr);
+  }
+
+  struct itimerval timer;
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = ::samplingInterval;
+  timer.it_value = timer.it_interval;
+  setitimer(ITIMER_PROF, &timer, nullptr);
+
+  // no thread is blocked while sampling. the handler is continued when
+  // the duration has passed
+  _timer.reset(scheduler->newSteadyTimer());
+  _timer->expires_from_now(std::chrono::microseconds(
+      static_cast<int64_t>(duration * 1000.0 * 1000.0)));
+
+  auto self = shared_from_this();
+  _timer->async_wait([self, this](asio_ns::error_code const&) {
+    // symbolizing the samples takes a while, so it is not done on the
+    // I/O thread
+    auto scheduler = SchedulerFeature::SCHEDULER;
+    if (scheduler == nullptr ||
+        !scheduler->queue(RequestPriority::LOW,
+                          [self]() { self->continueHandlerExecution(); })) {
+      continueHandlerExecution();
+    }
+  });
+
+  guard.cancel();
+  return RestStatus::WAITING;
+#endif
+}
+
+RestStatus RestProfileHandler::continueExecute() {
+#ifdef _WIN32
+  return RestStatus::DONE;
+#else
+  auto response = dynamic_cast<HttpResponse*>(_response.get());
+  if (response == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid response type");
+  }
+
+  std::unique_ptr<RestProfileHandler::Sample[]> buffer = stopSampling();
+  TRI_ASSERT(buffer != nullptr);
+
+  size_t const numSamples = (std::min)(::nextSample.load(), ::maxSamples);
+
+  // aggregate identical stacks, root frame first
+  std::unordered_map<void*, std::string> names;
+  std::map<std::string, size_t> stacks;
+  std::string key;
+  for (size_t i = 0; i < numSamples; ++i) {
+    Sample const& sample = buffer[i];
+    if (!sample.complete.load(std::memory_order_acquire)) {
+      continue;
+    }
+    key = ::laneName(sample.lane);
+    key.push_back(';');
+    key.append(sample.handler != nullptr ? sample.handler : "-");
+    for (int j = sample.depth - 1; j >= ::skipFrames; --j) {
+      auto it = names.find(sample.frames[j]);
+      if (it == names.end()) {
+        it = names.emplace(sample.frames[j], ::symbolize(sample.frames[j])).first;
+      }
+      key.push_back(';');
+      key.append(it->second);
+    }
+    ++stacks[key];
+  }
+
+  std::string out;
+  for (auto const& it : stacks) {
+    out.append(it.first);
+    out.push_back(' ');
+    out.append(std::to_string(it.second));
+    out.push_back('\n');
+  }
+
+  resetResponse(rest::ResponseCode::OK);
+  response->setContentType("text/plain");
+  response->body().appendText(out);
+  return RestStatus::DONE;
+#endif
+}
+
+#ifndef _WIN32
+std::unique_ptr<RestProfileHandler::Sample[]> RestProfileHandler::stopSampling() {
+  if (_samples == nullptr) {
+    return nullptr;
+  }
+
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, nullptr);
+
+  // signal handlers which are still running on other threads may write
+  // into the buffer until they are done
+  ::samples.store(nullptr);
+  while (::handlersInFlight.load(std::memory_order_acquire) != 0) {
+    std::this_thread::yield();
+  }
+
+  _timer.reset();
+  ::profiling.store(false);
+  return std::move(_samples);
+}
+#endif
@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_REST_HANDLER_REST_PROFILE_HANDLER_H
+#define ARANGOD_REST_HANDLER_REST_PROFILE_HANDLER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/asio_ns.h"
+#include "RestHandler/RestBaseHandler.h"
+
+namespace arangodb {
+/// @brief samples the stacks of all threads via SIGPROF for the requested
+/// duration and returns them in the collapsed format used by flame graph
+/// tools. the first two frames of each stack are the request lane and the
+/// name of the rest handler the thread was executing, if any. the handler
+/// does not block a thread while sampling, it is continued by a timer
+class RestProfileHandler : public RestBaseHandler {
+ public:
+  RestProfileHandler(GeneralRequest*, GeneralResponse*);
+  ~RestProfileHandler();
+
+ public:
+  char const* name() const override final { return "RestProfileHandler"; }
+  RequestLane lane() const override final { return RequestLane::CLUSTER_ADMIN; }
+  RestStatus execute() override final;
+  RestStatus continueExecute() override final;
+
+  /// @brief stack of a thread, recorded by the signal handler
+  struct Sample;
+
+ private:
+
+  /// @brief stop sampling and return the sample buffer once no signal
+  /// handler writes into it anymore. returns nullptr if not sampling
+  std::unique_ptr<Sample[]> stopSampling();
+
+  /// @brief samples of the profile being taken
+  std::unique_ptr<Sample[]> _samples;
+
+  /// @brief continues the handler when the profile duration has passed
+  std::unique_ptr<asio_ns::steady_timer> _timer;
+};
+}
+
+#endif
@@ -25,6 +25,7 @@
 
 #include "Aql/Query.h"
 #include "Aql/QueryList.h"
+#include "Aql/QueryRegistry.h"
 #include "Basics/conversions.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
@@ -34,6 +35,7 @@
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
 #include "Rest/HttpRequest.h"
+#include "RestServer/QueryRegistryFeature.h"
 #include "VocBase/vocbase.h"
 
 using namespace arangodb;
@@ -61,7 +63,11 @@ RestStatus RestQueryHandler::execute() {
       replaceProperties();
       break;
     case rest::RequestType::POST:
-      parseQuery();
+      if (_request->suffixes().size() == 1 && _request->suffixes()[0] == "prepare") {
+        prepareQuery();
+      } else {
+        parseQuery();
+      }
       break;
     default:
       generateNotImplemented("ILLEGAL " + DOCUMENT_PATH);
@@ -87,6 +93,8 @@ bool RestQueryHandler::readQueryProperties() {
               VPackValue(queryList->slowQueryThreshold()));
   result.add("maxQueryStringLength",
               VPackValue(queryList->maxQueryStringLength()));
+  result.add("profileSampling",
+              VPackValue(queryList->profileSampling()));
   result.close();
 
   generateResult(rest::ResponseCode::OK, result.slice());
@@ -116,6 +124,11 @@ bool RestQueryHandler::readQuery(bool slow) {
     result.add("runTime", VPackValue(q.runTime));
     result.add("state", VPackValue(QueryExecutionState::toString(q.state)));
     result.add("stream", VPackValue(q.stream));
+    result.add("memoryUsage", VPackValue(q.memoryUsage));
+    result.add("peakMemoryUsage", VPackValue(q.peakMemoryUsage));
+    if (q.profile != nullptr) {
+      result.add("profile", q.profile->slice());
+    }
     result.close();
   }
   result.close();
@@ -192,14 +205,41 @@ bool RestQueryHandler::deleteQuery(std::string const& name) {
   return true;
 }
 
+/// @brief removes a prepared statement
+bool RestQueryHandler::deletePreparedQuery(std::string const& name) {
+  auto registry = QueryRegistryFeature::registry();
+  TRI_ASSERT(registry != nullptr);
+
+  if (!registry->destroyStatement(&_vocbase, _request->user(),
+                                  StringUtils::uint64(name))) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_QUERY_NOT_FOUND,
+                  "prepared statement '" + name + "' not found");
+    return true;
+  }
+
+  VPackBuilder result;
+  result.add(VPackValue(VPackValueType::Object));
+  result.add(StaticStrings::Error, VPackValue(false));
+  result.add(StaticStrings::Code, VPackValue((int)rest::ResponseCode::OK));
+  result.close();
+
+  generateResult(rest::ResponseCode::OK, result.slice());
+
+  return true;
+}
+
 /// @brief interrupts a query
 bool RestQueryHandler::deleteQuery() {
   auto const& suffixes = _request->suffixes();
 
+  if (suffixes.size() == 2 && suffixes[0] == "prepare") {
+    return deletePreparedQuery(suffixes[1]);
+  }
+
   if (suffixes.size() != 1) {
     generateError(rest::ResponseCode::BAD,
                   TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "expecting DELETE /_api/query/<id> or /_api/query/slow");
+                  "expecting DELETE /_api/query/<id>, /_api/query/slow or /_api/query/prepare/<id>");
     return true;
   }
 
@@ -242,6 +282,7 @@ bool RestQueryHandler::replaceProperties() {
   size_t maxSlowQueries = queryList->maxSlowQueries();
   double slowQueryThreshold = queryList->slowQueryThreshold();
   size_t maxQueryStringLength = queryList->maxQueryStringLength();
+  uint64_t profileSampling = queryList->profileSampling();
 
   VPackSlice attribute;
   attribute = body.get("enabled");
@@ -274,12 +315,18 @@ bool RestQueryHandler::replaceProperties() {
     maxQueryStringLength = static_cast<size_t>(attribute.getUInt());
   }
 
+  attribute = body.get("profileSampling");
+  if (attribute.isInteger()) {
+    profileSampling = attribute.getUInt();
+  }
+
   queryList->enabled(enabled);
   queryList->trackSlowQueries(trackSlowQueries);
   queryList->trackBindVars(trackBindVars);
   queryList->maxSlowQueries(maxSlowQueries);
   queryList->slowQueryThreshold(slowQueryThreshold);
   queryList->maxQueryStringLength(maxQueryStringLength);
+  queryList->profileSampling(profileSampling);
 
   return readQueryProperties();
 }
@@ -354,3 +401,94 @@ bool RestQueryHandler::parseQuery() {
   generateResult(rest::ResponseCode::OK, result.slice());
   return true;
 }
+
+bool RestQueryHandler::prepareQuery() {
+  bool parseSuccess = false;
+  VPackSlice body = this->parseVPackBody(parseSuccess);
+  if (!parseSuccess) {
+    // error message generated in parseVPackBody
+    return true;
+  }
+
+  if (!body.isObject()) {
+    generateError(rest::ResponseCode::BAD,
+                  TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting a JSON object as body");
+    return true;
+  }
+
+  VPackSlice const querySlice = body.get("query");
+  if (!querySlice.isString() || querySlice.getStringLength() == 0) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_EMPTY);
+    return true;
+  }
+
+  VPackSlice const options = body.get("options");
+  if (!options.isNone() && !options.isObject()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                  "expecting object for <options>");
+    return true;
+  }
+
+  std::string queryString = querySlice.copyString();
+
+  // parse the query once, so that syntax errors are reported right away
+  Query query(
+    false,
+    _vocbase,
+    QueryString(queryString),
+    nullptr,
+    nullptr,
+    PART_MAIN
+  );
+  auto parseResult = query.parse();
+
+  if (parseResult.code != TRI_ERROR_NO_ERROR) {
+    generateError(GeneralResponse::responseCode(parseResult.code), parseResult.code,
+                  parseResult.details);
+    return true;
+  }
+
+  std::shared_ptr<VPackBuilder> optionsBuilder;
+  if (options.isObject()) {
+    optionsBuilder = std::make_shared<VPackBuilder>();
+    optionsBuilder->add(options);
+  }
+
+  auto registry = QueryRegistryFeature::registry();
+  TRI_ASSERT(registry != nullptr);
+
+  double ttl = VelocyPackHelper::getNumericValue<double>(body, "ttl", registry->defaultTTL());
+  if (ttl <= 0) {
+    ttl = registry->defaultTTL();
+  }
+
+  QueryId const id = registry->insertStatement(
+      &_vocbase, _request->user(),
+      std::make_shared<PreparedStatement>(std::move(queryString), std::move(optionsBuilder)),
+      ttl);
+
+  VPackBuilder result;
+  {
+    VPackObjectBuilder b(&result);
+    result.add(StaticStrings::Error, VPackValue(false));
+    result.add(StaticStrings::Code, VPackValue((int)rest::ResponseCode::CREATED));
+    result.add("id", VPackValue(StringUtils::itoa(id)));
+    result.add("ttl", VPackValue(ttl));
+
+    result.add("collections", VPackValue(VPackValueType::Array));
+    for (const auto& it : parseResult.collectionNames) {
+      result.add(VPackValue(it));
+    }
+    result.close();  // Collections
+
+    result.add("bindVars", VPackValue(VPackValueType::Array));
+    for (const auto& it : parseResult.bindParameters) {
+      result.add(VPackValue(it));
+    }
+    result.close();  // bindVars
+  }
+
+  generateResult(rest::ResponseCode::CREATED, result.slice());
+  return true;
+}
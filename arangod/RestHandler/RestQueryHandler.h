@@ -77,6 +77,12 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
 
   bool deleteQuery(std::string const& name);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes a prepared statement
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool deletePreparedQuery(std::string const& name);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief interrupts a query
   //////////////////////////////////////////////////////////////////////////////
@@ -94,6 +100,12 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
   //////////////////////////////////////////////////////////////////////////////
 
   bool parseQuery();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief registers a query as prepared statement
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool prepareQuery();
 };
 }
 
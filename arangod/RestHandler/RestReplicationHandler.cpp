@@ -76,6 +76,7 @@ std::string const typeString("type");
 
 uint64_t const RestReplicationHandler::_defaultChunkSize = 128 * 1024;
 uint64_t const RestReplicationHandler::_maxChunkSize = 128 * 1024 * 1024;
+size_t const RestReplicationHandler::_minDeflateSize = 16 * 1024;
 
 static bool ignoreHiddenEnterpriseCollection(std::string const& name, bool force) {
 #ifdef USE_ENTERPRISE
@@ -1154,10 +1155,19 @@ Result RestReplicationHandler::processRestoreData(std::string const& colName) {
     return processRestoreUsersBatch(colName);
   }
 
+  // bulk loads lock the collection exclusively and ingest SST files
+  bool const bulkLoad = _request->parsedValue("bulkLoad", false);
+
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
-  SingleCollectionTransaction trx(ctx, colName, AccessMode::Type::WRITE);
+  SingleCollectionTransaction trx(
+      ctx, colName,
+      bulkLoad ? AccessMode::Type::EXCLUSIVE : AccessMode::Type::WRITE);
 
   trx.addHint(transaction::Hints::Hint::RECOVERY);  // to turn off waitForSync!
+  trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
+  if (bulkLoad) {
+    trx.addHint(transaction::Hints::Hint::BULK_LOAD);
+  }
 
   Result res = trx.begin();
 
@@ -2735,6 +2745,21 @@ uint64_t RestReplicationHandler::determineChunkSize() const {
   return chunkSize;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compress a dump response
+////////////////////////////////////////////////////////////////////////////////
+
+int RestReplicationHandler::deflateDump(HttpResponse& response) const {
+  bool found = false;
+  std::string const& encoding =
+      _request->header(StaticStrings::AcceptEncoding, found);
+  if (!found || encoding.find("deflate") == std::string::npos ||
+      response.body().length() < _minDeflateSize) {
+    return TRI_ERROR_NO_ERROR;
+  }
+  return response.deflate();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief Grant temporary restore rights
 //////////////////////////////////////////////////////////////////////////////
@@ -234,6 +234,13 @@ class RestReplicationHandler : public RestVocbaseBaseHandler {
 
   uint64_t determineChunkSize() const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compress the body of a dump response using deflate, if the
+  ///        client accepts it and the body is large enough to benefit
+  //////////////////////////////////////////////////////////////////////////////
+
+  int deflateDump(HttpResponse& response) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Grant temporary restore rights
   //////////////////////////////////////////////////////////////////////////////
@@ -342,6 +349,12 @@ class RestReplicationHandler : public RestVocbaseBaseHandler {
 
   static uint64_t const _maxChunkSize;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief minimum size of a dump response to compress
+  //////////////////////////////////////////////////////////////////////////////
+
+  static size_t const _minDeflateSize;
+
  protected:
 
   //////////////////////////////////////////////////////////////////////////////
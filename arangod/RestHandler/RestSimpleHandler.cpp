@@ -24,16 +24,21 @@
 #include "RestSimpleHandler.h"
 #include "Aql/BindParameters.h"
 #include "Aql/QueryString.h"
+#include "Basics/AttributeNameParser.h"
 #include "Basics/Exceptions.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Graph/Traverser.h"
+#include "Indexes/Index.h"
+#include "RestHandler/RestSimpleQueryHandler.h"
 #include "Transaction/Context.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/CollectionNameResolver.h"
 #include "VocBase/LogicalCollection.h"
+#include "VocBase/Methods/Collections.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Dumper.h>
@@ -44,6 +49,31 @@
 using namespace arangodb;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief whether or not the attribute is covered by a unique index of
+/// its own. returns true if the collection does not exist, so that the
+/// query reports the error
+bool hasUniqueIndex(TRI_vocbase_t& vocbase, std::string const& collection,
+                    std::string const& attribute) {
+  bool found = false;
+  Result res = methods::Collections::lookup(
+      &vocbase, collection,
+      [&](std::shared_ptr<LogicalCollection> const& coll) {
+        for (auto const& idx : coll->getIndexes()) {
+          if (!idx->unique() || idx->fields().size() != 1) {
+            continue;
+          }
+          std::string name;
+          TRI_AttributeNamesToString(idx->fields()[0], name, false);
+          if (name == attribute) {
+            found = true;
+          }
+        }
+      });
+  return found || res.fail();
+}
+}  // namespace
+
 RestSimpleHandler::RestSimpleHandler(
     GeneralRequest* request, GeneralResponse* response,
     arangodb::aql::QueryRegistry* queryRegistry)
@@ -73,6 +103,10 @@ RestStatus RestSimpleHandler::execute() {
       return removeByKeys(body);
     } else if (prefix == RestVocbaseBaseHandler::SIMPLE_LOOKUP_PATH) {
       return lookupByKeys(body);
+    } else if (prefix == RestVocbaseBaseHandler::SIMPLE_FIRST_EXAMPLE) {
+      return firstExample(body);
+    } else if (prefix == RestVocbaseBaseHandler::SIMPLE_REMOVE_BY_EXAMPLE) {
+      return removeByExample(body);
     } else {
       generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
                     "unsupported value for <operation>");
@@ -190,6 +224,12 @@ RestStatus RestSimpleHandler::handleQueryResult() {
     } else if (prefix == RestVocbaseBaseHandler::SIMPLE_LOOKUP_PATH) {
       handleQueryResultLookupByKeys();
       return RestStatus::DONE;
+    } else if (prefix == RestVocbaseBaseHandler::SIMPLE_FIRST_EXAMPLE) {
+      handleQueryResultFirstExample();
+      return RestStatus::DONE;
+    } else if (prefix == RestVocbaseBaseHandler::SIMPLE_REMOVE_BY_EXAMPLE) {
+      handleQueryResultRemoveByExample();
+      return RestStatus::DONE;
     }
   }
 
@@ -253,6 +293,51 @@ void RestSimpleHandler::handleQueryResultLookupByKeys() {
                  _queryResult.context);
 }
 
+void RestSimpleHandler::handleQueryResultFirstExample() {
+  VPackSlice documents = _queryResult.result->slice();
+  if (!documents.isArray() || documents.length() == 0) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
+                  "no match");
+    return;
+  }
+
+  VPackBuffer<uint8_t> resultBuffer;
+  VPackBuilder result(resultBuffer);
+  {
+    VPackObjectBuilder guard(&result);
+    result.add(VPackValue("document"));
+    result.addExternal(documents.at(0).begin());
+    result.add(StaticStrings::Error, VPackValue(false));
+    result.add(StaticStrings::Code,
+               VPackValue(static_cast<int>(rest::ResponseCode::OK)));
+  }
+
+  generateResult(rest::ResponseCode::OK, std::move(resultBuffer),
+                 _queryResult.context);
+}
+
+void RestSimpleHandler::handleQueryResultRemoveByExample() {
+  size_t removed = 0;
+  if (_queryResult.extra) {
+    VPackSlice stats = _queryResult.extra->slice().get("stats");
+    if (stats.isObject()) {
+      VPackSlice found = stats.get("writesExecuted");
+      if (found.isNumber()) {
+        removed = found.getNumericValue<size_t>();
+      }
+    }
+  }
+
+  VPackBuilder result;
+  result.add(VPackValue(VPackValueType::Object));
+  result.add("deleted", VPackValue(removed));
+  result.add(StaticStrings::Error, VPackValue(false));
+  result.add(StaticStrings::Code, VPackValue(static_cast<int>(rest::ResponseCode::OK)));
+  result.close();
+
+  generateResult(rest::ResponseCode::OK, result.slice());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief was docuBlock RestLookupByKeys
 ////////////////////////////////////////////////////////////////////////////////
@@ -293,8 +378,37 @@ RestStatus RestSimpleHandler::lookupByKeys(VPackSlice const& slice) {
     return RestStatus::DONE;
   }
 
-  std::string const aql(
-      "FOR doc IN @@collection FILTER doc._key IN @keys RETURN doc");
+  // the documents can also be looked up by the values of another
+  // attribute, as long as a unique index makes this a batch of lookups
+  std::vector<std::string> path;
+  VPackSlice const attribute = slice.get("attribute");
+  if (!attribute.isNone() && !attribute.isNull()) {
+    if (!attribute.isString() || attribute.getStringLength() == 0) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                    "expecting string for <attribute>");
+      return RestStatus::DONE;
+    }
+    std::string const name = attribute.copyString();
+    if (name != StaticStrings::KeyString) {
+      if (!::hasUniqueIndex(_vocbase, collectionName, name)) {
+        generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                      "attribute '" + name +
+                          "' is not covered by a unique index");
+        return RestStatus::DONE;
+      }
+      path = basics::StringUtils::split(name, '.');
+    }
+  }
+
+  std::string aql("FOR doc IN @@collection FILTER doc");
+  if (path.empty()) {
+    aql.append("._key");
+  } else {
+    for (size_t i = 0; i < path.size(); ++i) {
+      aql.append(".@attribute").append(std::to_string(i));
+    }
+  }
+  aql.append(" IN @keys RETURN doc");
 
   VPackBuilder data;
   data.openObject();
@@ -303,9 +417,129 @@ RestStatus RestSimpleHandler::lookupByKeys(VPackSlice const& slice) {
   data.openObject();  // bindVars
   data.add("@collection", VPackValue(collectionName));
   data.add(VPackValue("keys"));
-  arangodb::aql::BindParameters::stripCollectionNames(keys, collectionName, data);
+  if (path.empty()) {
+    arangodb::aql::BindParameters::stripCollectionNames(keys, collectionName, data);
+  } else {
+    data.add(keys);
+    for (size_t i = 0; i < path.size(); ++i) {
+      data.add("attribute" + std::to_string(i), VPackValue(path[i]));
+    }
+  }
   data.close();  // bindVars
   data.close();
 
   return registerQueryOrCursor(data.slice());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief was docuBlock JSA_put_api_simple_first_example
+////////////////////////////////////////////////////////////////////////////////
+
+RestStatus RestSimpleHandler::firstExample(VPackSlice const& slice) {
+  TRI_ASSERT(slice.isObject());
+  VPackSlice const value = slice.get("collection");
+
+  if (!value.isString()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                  "expecting string for <collection>");
+    return RestStatus::DONE;
+  }
+
+  VPackSlice const example = slice.get("example");
+
+  if (!example.isObject()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                  "expecting object for <example>");
+    return RestStatus::DONE;
+  }
+
+  std::string collectionName = value.copyString();
+  auto col = _vocbase.lookupCollection(collectionName);
+
+  if (col != nullptr && collectionName != col->name()) {
+    // user has probably passed in a numeric collection id.
+    // translate it into a "real" collection name
+    collectionName = col->name();
+  }
+
+  VPackBuilder data;
+  data.openObject();
+  data.add(VPackValue("bindVars"));
+  data.openObject();  // bindVars
+  data.add("@collection", VPackValue(collectionName));
+  std::string aql("FOR doc IN @@collection");
+  aql.append(RestSimpleQueryHandler::buildExampleFilter(data, example));
+  data.close();  // bindVars
+  aql.append(" LIMIT 1 RETURN doc");
+  data.add("query", VPackValue(aql));
+  data.close();
+
+  return registerQueryOrCursor(data.slice());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief was docuBlock JSA_put_api_simple_remove_by_example
+////////////////////////////////////////////////////////////////////////////////
+
+RestStatus RestSimpleHandler::removeByExample(VPackSlice const& slice) {
+  TRI_ASSERT(slice.isObject());
+  VPackSlice const value = slice.get("collection");
+
+  if (!value.isString()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                  "expecting string for <collection>");
+    return RestStatus::DONE;
+  }
+
+  VPackSlice const example = slice.get("example");
+
+  if (!example.isObject()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                  "expecting object for <example>");
+    return RestStatus::DONE;
+  }
+
+  std::string collectionName = value.copyString();
+  auto col = _vocbase.lookupCollection(collectionName);
+
+  if (col != nullptr && collectionName != col->name()) {
+    // user has probably passed in a numeric collection id.
+    // translate it into a "real" collection name
+    collectionName = col->name();
+  }
+
+  bool waitForSync = false;
+  VPackSlice limit = VPackSlice::noneSlice();
+  {
+    // options may also be passed on the top level
+    VPackSlice options = slice.get("options");
+    if (!options.isObject()) {
+      options = slice;
+    }
+    VPackSlice wfs = options.get("waitForSync");
+    if (wfs.isBool()) {
+      waitForSync = wfs.getBool();
+    }
+    limit = options.get("limit");
+  }
+
+  VPackBuilder data;
+  data.openObject();
+  data.add(VPackValue("bindVars"));
+  data.openObject();  // bindVars
+  data.add("@collection", VPackValue(collectionName));
+  std::string aql("FOR doc IN @@collection");
+  aql.append(RestSimpleQueryHandler::buildExampleFilter(data, example));
+  if (limit.isNumber() && limit.getNumber<int64_t>() > 0) {
+    aql.append(" LIMIT @limit");
+    data.add("limit", limit);
+  }
+  data.close();  // bindVars
+  aql.append(" REMOVE doc IN @@collection OPTIONS { waitForSync: ");
+  aql.append(waitForSync ? "true" : "false");
+  aql.append(" }");
+  data.add("query", VPackValue(aql));
+  data.close();
+
+  return registerQueryOrCursor(data.slice());
+}
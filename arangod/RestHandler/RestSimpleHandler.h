@@ -51,6 +51,13 @@ class RestSimpleHandler : public RestCursorHandler {
 
   RestStatus handleQueryResult() override final;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the results are post-processed by handleQueryResult and must
+  ///        not go into a streaming cursor
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool canStreamResult() const override final { return false; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief handle result of a remove-by-keys query
   //////////////////////////////////////////////////////////////////////////////
@@ -75,6 +82,30 @@ class RestSimpleHandler : public RestCursorHandler {
 
   RestStatus lookupByKeys(VPackSlice const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief handle result of a first-example query
+  //////////////////////////////////////////////////////////////////////////////
+
+  void handleQueryResultFirstExample();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief handle result of a remove-by-example query
+  //////////////////////////////////////////////////////////////////////////////
+
+  void handleQueryResultRemoveByExample();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the first document matching an example
+  //////////////////////////////////////////////////////////////////////////////
+
+  RestStatus firstExample(VPackSlice const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief remove all documents matching an example
+  //////////////////////////////////////////////////////////////////////////////
+
+  RestStatus removeByExample(VPackSlice const&);
+
  private:
 
   //////////////////////////////////////////////////////////////////////////////
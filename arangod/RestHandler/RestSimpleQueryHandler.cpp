@@ -223,6 +223,21 @@ RestStatus RestSimpleQueryHandler::allDocumentKeys() {
   return registerQueryOrCursor(data.slice());
 }
 
+std::string RestSimpleQueryHandler::buildExampleFilter(VPackBuilder& bindVars,
+                                                      VPackSlice example) {
+  TRI_ASSERT(example.isObject());
+  std::string filter;
+  size_t i = 0;
+  for (auto pair : VPackObjectIterator(example, true)) {
+    std::string key = basics::StringUtils::replace(pair.key.copyString(), "`", "");
+    key = basics::StringUtils::join(basics::StringUtils::split(key, "."), "`.`");
+    std::string istr = std::to_string(i++);
+    filter.append(" FILTER doc.`").append(key).append("` == @value").append(istr);
+    bindVars.add(std::string("value") + istr, pair.value);
+  }
+  return filter;
+}
+
 static void buildExampleQuery(VPackBuilder& result,
                               std::string const& cname,
                               VPackSlice const& doc,
@@ -232,14 +247,7 @@ static void buildExampleQuery(VPackBuilder& result,
   
   result.add("bindVars", VPackValue(VPackValueType::Object));
   result.add("@collection", VPackValue(cname));
-  size_t i = 0;
-  for (auto pair : VPackObjectIterator(doc, true)) {
-    std::string key = basics::StringUtils::replace(pair.key.copyString(), "`", "");
-    key = basics::StringUtils::join(basics::StringUtils::split(key, "."), "`.`");
-    std::string istr = std::to_string(i++);
-    query.append(" FILTER doc.`").append(key).append("` == @value").append(istr);
-    result.add(std::string("value") + istr, pair.value);
-  }
+  query.append(RestSimpleQueryHandler::buildExampleFilter(result, doc));
   result.close();
   
   if (limit > 0 || skip > 0) {
@@ -41,6 +41,11 @@ class RestSimpleQueryHandler : public RestCursorHandler {
   RestStatus execute() override final;
   char const* name() const override final { return "RestSimpleQueryHandler"; }
 
+  /// @brief returns the FILTER conditions for an example document on `doc`,
+  /// and adds their bind parameters to the open bindVars object
+  static std::string buildExampleFilter(arangodb::velocypack::Builder& bindVars,
+                                        arangodb::velocypack::Slice example);
+
  private:
   RestStatus allDocuments();
   RestStatus allDocumentKeys();
@@ -24,9 +24,11 @@
 #include "RestTransactionHandler.h"
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/StringUtils.h"
 #include "Basics/WriteLocker.h"
 #include "Cluster/ServerState.h"
 #include "Rest/HttpRequest.h"
+#include "Utils/TransactionRepository.h"
 #include "V8Server/V8Context.h"
 #include "V8Server/V8DealerFeature.h"
 #include "VocBase/Methods/Transactions.h"
@@ -49,16 +51,110 @@ void RestTransactionHandler::returnContext() {
   _v8Context = nullptr;
 }
 
+RequestLane RestTransactionHandler::lane() const {
+  // only JavaScript transactions need a V8 context
+  if (_request->suffixes().empty()) {
+    return RequestLane::CLIENT_V8;
+  }
+  return RequestLane::CLIENT_FAST;
+}
+
 RestStatus RestTransactionHandler::execute() {
+  if (_request->suffixes().empty()) {
+    executeJavaScript();
+  } else {
+    executeStream();
+  }
+  return RestStatus::DONE;
+}
+
+void RestTransactionHandler::executeStream() {
+  if (ServerState::instance()->isCoordinator()) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                  "stream transactions are not supported on coordinators");
+    return;
+  }
+
+  std::vector<std::string> const& suffixes = _request->suffixes();
+  if (suffixes.size() != 1) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_SUPERFLUOUS_SUFFICES,
+                  "expecting /_api/transaction/begin or /_api/transaction/<id>");
+    return;
+  }
+
+  TransactionRepository* transactions = _vocbase.transactionRepository();
+  auto const type = _request->requestType();
+
+  if (suffixes[0] == "begin") {
+    if (type != rest::RequestType::POST) {
+      generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                    TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+      return;
+    }
+    bool parseSuccess = false;
+    VPackSlice body = parseVPackBody(parseSuccess);
+    if (!parseSuccess) {
+      return;
+    }
+    TRI_voc_tid_t tid = 0;
+    Result res = transactions->begin(body, tid);
+    if (res.fail()) {
+      generateError(res);
+      return;
+    }
+    generateTransactionResult(tid, transaction::Status::RUNNING);
+    return;
+  }
+
+  TRI_voc_tid_t tid = StringUtils::uint64(suffixes[0]);
+  transaction::Status status = transaction::Status::UNDEFINED;
+  Result res;
+
+  switch (type) {
+    case rest::RequestType::GET:
+      res = transactions->status(tid, status);
+      break;
+    case rest::RequestType::PUT:
+      res = transactions->commit(tid);
+      status = transaction::Status::COMMITTED;
+      break;
+    case rest::RequestType::DELETE_REQ:
+      res = transactions->abort(tid);
+      status = transaction::Status::ABORTED;
+      break;
+    default:
+      generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                    TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+      return;
+  }
+
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+  generateTransactionResult(tid, status);
+}
+
+void RestTransactionHandler::generateTransactionResult(TRI_voc_tid_t tid,
+                                                       transaction::Status status) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("id", VPackValue(std::to_string(tid)));
+  builder.add("status", VPackValue(transaction::statusString(status)));
+  builder.close();
+  generateOk(rest::ResponseCode::OK, builder.slice());
+}
+
+void RestTransactionHandler::executeJavaScript() {
   if (_request->requestType() != rest::RequestType::POST) {
     generateError(rest::ResponseCode::METHOD_NOT_ALLOWED, 405);
-    return RestStatus::DONE;
+    return;
   }
   
   auto slice = _request->payload();
   if (!slice.isObject()) {
     generateError(Result(TRI_ERROR_BAD_PARAMETER, "could not acquire v8 context"));
-    return RestStatus::DONE;
+    return;
   }
   
   std::string portType = _request->connectionInfo().portType();
@@ -68,7 +164,7 @@ RestStatus RestTransactionHandler::execute() {
   
   if (!_v8Context) {
     generateError(Result(TRI_ERROR_INTERNAL, "could not acquire v8 context"));
-    return RestStatus::DONE;
+    return;
   }
   
   TRI_DEFER(returnContext());
@@ -79,7 +175,7 @@ RestStatus RestTransactionHandler::execute() {
       WRITE_LOCKER(lock, _lock);
       if (_canceled) {
         generateCanceled();
-        return RestStatus::DONE;
+        return;
       }
     }
     
@@ -101,14 +197,15 @@ RestStatus RestTransactionHandler::execute() {
   } catch (...) {
     generateError(Result(TRI_ERROR_INTERNAL));
   }
-  
-  return RestStatus::DONE;
 }
 
 bool RestTransactionHandler::cancel() {
   //cancel v8 transaction
   WRITE_LOCKER(writeLock, _lock);
   _canceled.store(true);
+  if (_v8Context == nullptr) {
+    return true;
+  }
   auto isolate = _v8Context->_isolate;
   if (!v8::V8::IsExecutionTerminating(isolate)) {
     v8::V8::TerminateExecution(isolate);
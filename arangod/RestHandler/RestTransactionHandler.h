@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
+#include "Transaction/Status.h"
 
 namespace arangodb {
 class V8Context;
@@ -40,12 +41,21 @@ class RestTransactionHandler : public arangodb::RestVocbaseBaseHandler {
 
  public:
   char const* name() const override final { return "RestTransactionHandler"; }
-  RequestLane lane() const override final { return RequestLane::CLIENT_V8; }
+  RequestLane lane() const override final;
   RestStatus execute() override;
   bool cancel() override final;
 
  private:
   void returnContext();
+
+  /// @brief runs a JavaScript transaction
+  void executeJavaScript();
+
+  /// @brief begins, commits, aborts or inspects a stream transaction
+  void executeStream();
+
+  /// @brief returns id and status of a stream transaction
+  void generateTransactionResult(TRI_voc_tid_t tid, transaction::Status status);
 };
 }
 
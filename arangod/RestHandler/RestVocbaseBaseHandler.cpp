@@ -29,6 +29,8 @@
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/conversions.h"
 #include "Basics/tri-strings.h"
+#include "Cluster/ClusterInfo.h"
+#include "Cluster/FollowerInfo.h"
 #include "Cluster/ServerState.h"
 #include "Meta/conversion.h"
 #include "Rest/CommonDefines.h"
@@ -36,6 +38,8 @@
 #include "Transaction/Methods.h"
 #include "Transaction/StandaloneContext.h"
 #include "Utils/SingleCollectionTransaction.h"
+#include "Utils/TransactionRepository.h"
+#include "VocBase/LogicalCollection.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Dumper.h>
@@ -545,7 +549,42 @@ void RestVocbaseBaseHandler::extractStringParameter(
 
 std::unique_ptr<SingleCollectionTransaction> RestVocbaseBaseHandler::createTransaction(
     std::string const& name, AccessMode::Type type) const {
-  auto ctx = transaction::StandaloneContext::Create(_vocbase);
+  bool found;
+  std::string const& planVersion =
+      _request->header(StaticStrings::XArangoPlanVersion, found);
+  if (found && ServerState::instance()->isDBServer()) {
+    // a client routed this request by itself, make it fall back to a
+    // coordinator if its shard map is outdated
+    uint64_t const current = ClusterInfo::instance()->getPlanVersion();
+    if (basics::StringUtils::uint64(planVersion) < current) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_CLUSTER_NOT_LEADER,
+          "routing information is outdated, current plan version is " +
+              std::to_string(current));
+    }
+    auto collection = _vocbase.lookupCollection(name);
+    if (collection != nullptr && !collection->followers()->getLeader().empty()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_NOT_LEADER,
+                                     "not the leader of shard " + name);
+    }
+  }
+
+  std::shared_ptr<transaction::Context> ctx;
+  std::string const& value = _request->header(StaticStrings::XArangoTrxId, found);
+  if (found) {
+    TRI_voc_tid_t tid = basics::StringUtils::uint64(value);
+    if (tid != _leasedTransactionId) {
+      if (_leasedTransactionId != 0) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_TRANSACTION_INTERNAL);
+      }
+      // throws if the transaction does not exist or is in use
+      _leasedTransactionContext = _vocbase.transactionRepository()->lease(tid);
+      _leasedTransactionId = tid;
+    }
+    ctx = _leasedTransactionContext;
+  } else {
+    ctx = transaction::StandaloneContext::Create(_vocbase);
+  }
   auto trx = std::make_unique<SingleCollectionTransaction>(ctx, name, type);
   if (_nolockHeaderSet != nullptr) {
     for (auto const& it : *_nolockHeaderSet) {
@@ -570,6 +609,11 @@ void RestVocbaseBaseHandler::prepareExecute(bool isContinue) {
 
 void RestVocbaseBaseHandler::shutdownExecute(bool isFinalized) noexcept {
   clearNoLockHeaders();
+  if (_leasedTransactionId != 0) {
+    _leasedTransactionContext.reset();
+    _vocbase.transactionRepository()->release(_leasedTransactionId);
+    _leasedTransactionId = 0;
+  }
   RestBaseHandler::shutdownExecute(isFinalized);
 }
 
@@ -39,6 +39,10 @@ namespace arangodb {
 class SingleCollectionTransaction;
 class VocbaseContext;
 
+namespace transaction {
+class Context;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief abstract base request handler
@@ -342,6 +346,11 @@ class RestVocbaseBaseHandler : public RestBaseHandler {
   /**
    * @brief Helper to create a new Transaction for a single collection. The helper method will consider
    *        no-lock headers send via http and will lock the collection accordingly.
+   *        If the request carries an x-arango-trx-id header, the transaction is embedded into the
+   *        stream transaction with that id, which is leased until the request is finished.
+   *        Requests sent to a DB server directly by a client that routes by itself carry an
+   *        x-arango-plan-version header, and are refused unless this server leads the shard
+   *        and the client's routing information is current.
    *
    * @param collectionName Name of the collection to be locked
    * @param mode The access mode (READ / WRITE / EXCLUSIVE)
@@ -397,6 +406,12 @@ class RestVocbaseBaseHandler : public RestBaseHandler {
   /// @brief Container that holds the no-lock header set
   ////////////////////////////////////////////////////////////////////////////////
   std::unique_ptr<std::unordered_set<std::string>> _nolockHeaderSet;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief id and context of the stream transaction leased by this request
+  ////////////////////////////////////////////////////////////////////////////////
+  mutable TRI_voc_tid_t _leasedTransactionId = 0;
+  mutable std::shared_ptr<transaction::Context> _leasedTransactionContext;
 };
 
 }
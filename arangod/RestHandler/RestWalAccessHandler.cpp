@@ -25,12 +25,15 @@
 #include "Basics/StaticStrings.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Basics/system-functions.h"
 #include "Replication/common-defines.h"
 #include "Replication/utilities.h"
 #include "Rest/HttpResponse.h"
 #include "Rest/Version.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/ServerIdFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/WalAccess.h"
@@ -46,6 +49,13 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief maximum time a tailing request waits for new writes (in seconds)
+constexpr double MaxWaitTime = 60.0;
+/// @brief minimum response size for deflate compression
+constexpr size_t MinDeflateSize = 16 * 1024;
+}
+
 struct MyTypeHandler final : public VPackCustomTypeHandler {
   explicit MyTypeHandler(TRI_vocbase_t& vocbase): resolver(vocbase) {}
 
@@ -66,7 +76,7 @@ struct MyTypeHandler final : public VPackCustomTypeHandler {
 
 RestWalAccessHandler::RestWalAccessHandler(GeneralRequest* request,
                                            GeneralResponse* response)
-    : RestVocbaseBaseHandler(request, response) {}
+    : RestVocbaseBaseHandler(request, response), _waitUntil(0.0) {}
 
 bool RestWalAccessHandler::parseFilter(WalAccess::Filter& filter) {
   // determine start and end tick
@@ -93,20 +103,22 @@ bool RestWalAccessHandler::parseFilter(WalAccess::Filter& filter) {
     // filter for database
     filter.vocbase = _vocbase.id();
 
-    // extract collection
+    // extract collections, separated by commas
     bool found = false;
     std::string const& value2 = _request->value("collection", found);
     if (found) {
-      auto c = _vocbase.lookupCollection(value2);
+      for (std::string const& name : StringUtils::split(value2, ',')) {
+        auto c = _vocbase.lookupCollection(name);
 
-      if (c == nullptr) {
-        generateError(rest::ResponseCode::NOT_FOUND,
-                      TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
-        return false;
-      }
+        if (c == nullptr) {
+          generateError(rest::ResponseCode::NOT_FOUND,
+                        TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+          return false;
+        }
 
-      // filter for collection
-      filter.collection = c->id();
+        // filter for collection
+        filter.collections.emplace(c->id());
+      }
     }
   }
 
@@ -180,7 +192,7 @@ RestStatus RestWalAccessHandler::execute() {
   } else if (suffixes[0] == "tail" &&
              (_request->requestType() == RequestType::GET ||
               _request->requestType() == RequestType::PUT)) {
-    handleCommandTail(wal);
+    return handleCommandTail(wal);
   } else if (suffixes[0] == "open-transactions" &&
              _request->requestType() == RequestType::GET) {
     handleCommandDetermineOpenTransactions(wal);
@@ -193,6 +205,11 @@ RestStatus RestWalAccessHandler::execute() {
   return RestStatus::DONE;
 }
 
+RestStatus RestWalAccessHandler::continueExecute() {
+  // a tailing request was woken up by new writes, or its wait time passed
+  return execute();
+}
+
 void RestWalAccessHandler::handleCommandTickRange(WalAccess const* wal) {
   std::pair<TRI_voc_tick_t, TRI_voc_tick_t> minMax;
   Result r = wal->tickRange(minMax);
@@ -233,7 +250,7 @@ void RestWalAccessHandler::handleCommandLastTick(WalAccess const* wal) {
   generateResult(rest::ResponseCode::OK, result.slice());
 }
 
-void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
+RestStatus RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   bool useVst = false;
   if (_request->transportType() == Endpoint::TransportType::VST) {
     useVst = true;
@@ -241,7 +258,7 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
   
   WalAccess::Filter filter;
   if (!parseFilter(filter)) {
-    return;
+    return RestStatus::DONE;
   }
 
   // check for serverId
@@ -259,6 +276,15 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
     chunkSize = std::min((size_t)128 * 1024 * 1024, chunkSize);
   }
 
+  // instead of returning an empty response, the request can wait for new
+  // writes, so that followers do not need to poll the WAL. the handler is
+  // paused meanwhile, it does not occupy a thread
+  if (_waitUntil == 0.0) {
+    _waitUntil = TRI_microtime() +
+                 std::min(std::max(_request->parsedValue("waitTime", 0.0), 0.0),
+                          MaxWaitTime);
+  }
+
   WalAccessResult result;
   std::map<TRI_voc_tick_t, std::unique_ptr<MyTypeHandler>> handlers;
   VPackOptions opts = VPackOptions::Defaults;
@@ -278,6 +304,7 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
 
   size_t length = 0;
 
+  HttpResponse* httpResponse = nullptr;
   if (useVst) {
     result =
         wal->tail(filter, chunkSize, barrierId,
@@ -291,7 +318,7 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
                     _response->addPayload(marker, &opts, true);
                   });
   } else {
-    HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(_response.get());
+    httpResponse = dynamic_cast<HttpResponse*>(_response.get());
     TRI_ASSERT(httpResponse);
     if (httpResponse == nullptr) {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
@@ -318,7 +345,24 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
 
   if (result.fail()) {
     generateError(result);
-    return;
+    return RestStatus::DONE;
+  }
+
+  if (length == 0 && result.latestTick() < filter.tickEnd) {
+    double const remaining = _waitUntil - TRI_microtime();
+    if (remaining > 0.0) {
+      auto self = shared_from_this();
+      wal->waitForWritesAsync(result.latestTick(), remaining, [self]() {
+        // invoked by a committing thread or the io thread
+        auto scheduler = SchedulerFeature::SCHEDULER;
+        if (scheduler == nullptr ||
+            !scheduler->queue(RequestPriority::LOW,
+                              [self]() { self->continueHandlerExecution(); })) {
+          self->continueHandlerExecution();
+        }
+      });
+      return RestStatus::WAITING;
+    }
   }
 
   // transfer ownership of the buffer contents
@@ -341,6 +385,20 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
 
   if (length > 0) {
     _response->setResponseCode(rest::ResponseCode::OK);
+    // followers accept deflated responses, and the markers of a batch
+    // compress well
+    bool found = false;
+    std::string const& encoding =
+        _request->header(StaticStrings::AcceptEncoding, found);
+    if (httpResponse != nullptr && found &&
+        encoding.find("deflate") != std::string::npos &&
+        httpResponse->body().length() >= MinDeflateSize) {
+      int res = httpResponse->deflate();
+      if (res != TRI_ERROR_NO_ERROR) {
+        generateError(rest::ResponseCode::SERVER_ERROR, res);
+        return RestStatus::DONE;
+      }
+    }
     LOG_TOPIC(DEBUG, Logger::REPLICATION) << "WAL tailing after " << filter.tickStart
       << ", lastIncludedTick " << result.lastIncludedTick()
       << ", fromTickIncluded " << result.fromTickIncluded();
@@ -356,6 +414,7 @@ void RestWalAccessHandler::handleCommandTail(WalAccess const* wal) {
       );
     }
   );
+  return RestStatus::DONE;
 }
 
 void RestWalAccessHandler::handleCommandDetermineOpenTransactions(
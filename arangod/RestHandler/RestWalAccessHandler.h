@@ -38,16 +38,20 @@ class RestWalAccessHandler : public arangodb::RestVocbaseBaseHandler {
   char const* name() const override final { return "RestWalAccessHandler"; }
   RequestLane lane() const override final { return RequestLane::SERVER_REPLICATION; }
   RestStatus execute() override;
+  RestStatus continueExecute() override;
 
  private:
   bool parseFilter(WalAccess::Filter& filter);
 
   void handleCommandTickRange(WalAccess const* wal);
   void handleCommandLastTick(WalAccess const* wal);
-  void handleCommandTail(WalAccess const* wal);
+  RestStatus handleCommandTail(WalAccess const* wal);
   void handleCommandDetermineOpenTransactions(WalAccess const* wal);
 
   void grantTemporaryRights();
+
+  /// @brief until when a tailing request without new writes waits for them
+  double _waitUntil;
 };
 }
 
@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AggregateViewFeature.h"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
+#include "Cluster/ServerState.h"
+#include "Logger/Logger.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/DatabasePathFeature.h"
+#include "Utils/AggregateView.h"
+#include "Utils/AggregateViewThread.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::application_features;
+using namespace arangodb::basics;
+
+namespace arangodb {
+
+AggregateViewFeature* AggregateViewFeature::AGGREGATE_VIEWS = nullptr;
+
+AggregateViewFeature::AggregateViewFeature(ApplicationServer& server)
+    : ApplicationFeature(server, "AggregateView") {
+  setOptional(true);
+  startsAfter("BasicsPhase");
+
+  startsAfter("Database");
+  startsAfter("DatabasePath");
+  startsAfter("StorageEngine");
+  startsAfter("SystemDatabase");
+}
+
+void AggregateViewFeature::prepare() {
+  // the views follow the local WAL, which only has all the data of a
+  // collection on a single server
+  setEnabled(ServerState::instance()->isSingleServer());
+}
+
+void AggregateViewFeature::start() {
+  load();
+  _thread.reset(new AggregateViewThread(*this));
+
+  DatabaseFeature::DATABASE->registerPostRecoveryCallback(
+    [this]() -> Result {
+      if (!_thread->start()) {
+        LOG_TOPIC(FATAL, Logger::VIEWS)
+            << "unable to start aggregate view thread";
+        FATAL_ERROR_EXIT();
+      }
+      return Result();
+    }
+  );
+
+  AGGREGATE_VIEWS = this;
+}
+
+void AggregateViewFeature::beginShutdown() {
+  if (_thread != nullptr) {
+    _thread->beginShutdown();
+  }
+}
+
+void AggregateViewFeature::stop() {
+  if (_thread != nullptr) {
+    while (_thread->isRunning()) {
+      std::this_thread::sleep_for(std::chrono::microseconds(10000));
+    }
+  }
+}
+
+void AggregateViewFeature::unprepare() {
+  AGGREGATE_VIEWS = nullptr;
+  _thread.reset();
+
+  MUTEX_LOCKER(guard, _viewsLock);
+  _views.clear();
+}
+
+Result AggregateViewFeature::create(TRI_vocbase_t& vocbase,
+                                    VPackSlice definition) {
+  std::shared_ptr<AggregateView> view;
+  Result res = AggregateView::create(vocbase.name(), definition, view);
+  if (res.fail()) {
+    return res;
+  }
+
+  auto collection = vocbase.lookupCollection(view->collection());
+  if (collection == nullptr || collection->deleted()) {
+    return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND,
+                  "collection '" + view->collection() + "' not found");
+  }
+
+  {
+    MUTEX_LOCKER(guard, _viewsLock);
+    auto& views = _views[vocbase.name()];
+    if (!views.emplace(view->name(), view).second) {
+      return Result(TRI_ERROR_ARANGO_DUPLICATE_NAME,
+                    "aggregate view '" + view->name() + "' already exists");
+    }
+    res = save();
+    if (res.fail()) {
+      views.erase(view->name());
+      return res;
+    }
+  }
+
+  _thread->signal();
+  return Result();
+}
+
+Result AggregateViewFeature::drop(std::string const& database,
+                                  std::string const& name) {
+  MUTEX_LOCKER(guard, _viewsLock);
+  auto it = _views.find(database);
+  if (it == _views.end()) {
+    return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND,
+                  "aggregate view '" + name + "' not found");
+  }
+  auto view = it->second.find(name);
+  if (view == it->second.end()) {
+    return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND,
+                  "aggregate view '" + name + "' not found");
+  }
+
+  std::shared_ptr<AggregateView> dropped = view->second;
+  it->second.erase(view);
+  Result res = save();
+  if (res.fail()) {
+    it->second.emplace(name, std::move(dropped));
+  }
+  return res;
+}
+
+std::shared_ptr<AggregateView> AggregateViewFeature::lookup(
+    std::string const& database, std::string const& name) const {
+  MUTEX_LOCKER(guard, _viewsLock);
+  auto it = _views.find(database);
+  if (it != _views.end()) {
+    auto view = it->second.find(name);
+    if (view != it->second.end()) {
+      return view->second;
+    }
+  }
+  return nullptr;
+}
+
+void AggregateViewFeature::list(std::string const& database,
+                                VPackBuilder& result) const {
+  TRI_ASSERT(result.isOpenArray());
+  MUTEX_LOCKER(guard, _viewsLock);
+  auto it = _views.find(database);
+  if (it != _views.end()) {
+    for (auto const& view : it->second) {
+      view.second->toVelocyPack(result);
+    }
+  }
+}
+
+std::vector<std::shared_ptr<AggregateView>> AggregateViewFeature::views()
+    const {
+  std::vector<std::shared_ptr<AggregateView>> result;
+  MUTEX_LOCKER(guard, _viewsLock);
+  for (auto const& it : _views) {
+    for (auto const& view : it.second) {
+      result.emplace_back(view.second);
+    }
+  }
+  return result;
+}
+
+std::string AggregateViewFeature::filename() const {
+  auto databasePath =
+      ApplicationServer::getFeature<DatabasePathFeature>("DatabasePath");
+  return FileUtils::buildFilename(databasePath->directory(),
+                                  "aggregate-views.json");
+}
+
+void AggregateViewFeature::load() {
+  std::string const file = filename();
+  if (!FileUtils::exists(file)) {
+    return;
+  }
+
+  std::shared_ptr<VPackBuilder> builder;
+  try {
+    builder = VPackParser::fromJson(FileUtils::slurp(file));
+  } catch (...) {
+    LOG_TOPIC(ERR, Logger::VIEWS)
+        << "unable to read aggregate view definitions from '" << file << "'";
+    return;
+  }
+
+  MUTEX_LOCKER(guard, _viewsLock);
+  VPackSlice slice = builder->slice();
+  if (!slice.isObject()) {
+    return;
+  }
+  for (auto const& database : VPackObjectIterator(slice)) {
+    if (!database.value.isArray()) {
+      continue;
+    }
+    for (auto const& definition : VPackArrayIterator(database.value)) {
+      std::shared_ptr<AggregateView> view;
+      Result res =
+          AggregateView::create(database.key.copyString(), definition, view);
+      if (res.fail()) {
+        LOG_TOPIC(WARN, Logger::VIEWS)
+            << "ignoring invalid aggregate view definition "
+            << definition.toJson() << ": " << res.errorMessage();
+        continue;
+      }
+      _views[view->database()].emplace(view->name(), view);
+    }
+  }
+}
+
+Result AggregateViewFeature::save() const {
+  VPackBuilder builder;
+  builder.openObject();
+  for (auto const& it : _views) {
+    if (it.second.empty()) {
+      continue;
+    }
+    builder.add(it.first, VPackValue(VPackValueType::Array));
+    for (auto const& view : it.second) {
+      view.second->toVelocyPack(builder);
+    }
+    builder.close();
+  }
+  builder.close();
+
+  try {
+    FileUtils::spit(filename(), builder.slice().toJson(), true);
+  } catch (...) {
+    return Result(TRI_ERROR_CANNOT_WRITE_FILE,
+                  "unable to write aggregate view definitions");
+  }
+  return Result();
+}
+
+}  // namespace arangodb
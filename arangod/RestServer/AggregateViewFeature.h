@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_REST_SERVER_AGGREGATE_VIEW_FEATURE_H
+#define ARANGODB_REST_SERVER_AGGREGATE_VIEW_FEATURE_H 1
+
+#include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+struct TRI_vocbase_t;
+
+namespace arangodb {
+
+class AggregateView;
+class AggregateViewThread;
+
+/// @brief manages the aggregate views of all databases. the definitions
+/// are stored in a file in the database directory, the grouped results
+/// are kept in memory only and are rebuilt after a restart. only
+/// available on single servers
+class AggregateViewFeature final
+    : public application_features::ApplicationFeature {
+ public:
+  static AggregateViewFeature* AGGREGATE_VIEWS;
+
+  explicit AggregateViewFeature(
+    application_features::ApplicationServer& server
+  );
+
+  void prepare() override;
+  void start() override;
+  void beginShutdown() override;
+  void stop() override;
+  void unprepare() override;
+
+  /// @brief creates a view in the database. the view is built in the
+  /// background
+  Result create(TRI_vocbase_t& vocbase, velocypack::Slice definition);
+
+  Result drop(std::string const& database, std::string const& name);
+
+  /// @brief returns the view, or nullptr if there is none
+  std::shared_ptr<AggregateView> lookup(std::string const& database,
+                                        std::string const& name) const;
+
+  /// @brief adds the definitions of the views of a database to result
+  /// (an open array)
+  void list(std::string const& database, velocypack::Builder& result) const;
+
+  /// @brief all views, for the background thread
+  std::vector<std::shared_ptr<AggregateView>> views() const;
+
+ private:
+  std::string filename() const;
+
+  /// @brief reads the stored definitions
+  void load();
+
+  /// @brief writes the definitions. must be called under _viewsLock
+  Result save() const;
+
+  mutable Mutex _viewsLock;
+  /// @brief database name => view name => view
+  std::unordered_map<std::string,
+                     std::map<std::string, std::shared_ptr<AggregateView>>>
+      _views;
+
+  std::unique_ptr<AggregateViewThread> _thread;
+};
+
+}  // namespace arangodb
+
+#endif
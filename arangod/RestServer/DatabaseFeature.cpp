@@ -35,6 +35,7 @@
 #include "Basics/StringUtils.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/files.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ServerState.h"
 #include "Cluster/TraverserEngineRegistry.h"
 #include "Cluster/v8-cluster.h"
@@ -52,6 +53,7 @@
 #include "Utils/CollectionNameResolver.h"
 #include "Utils/Events.h"
 #include "Utils/CursorRepository.h"
+#include "Utils/TransactionRepository.h"
 #include "V8Server/V8DealerFeature.h"
 #include "V8Server/v8-query.h"
 #include "V8Server/v8-vocbase.h"
@@ -62,6 +64,8 @@
 
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::application_features;
 using namespace arangodb::basics;
@@ -207,6 +211,10 @@ void DatabaseManagerThread::run() {
               vocbase->cursorRepository()->garbageCollect(force);
             } catch (...) {
             }
+            try {
+              vocbase->transactionRepository()->garbageCollect(force);
+            } catch (...) {
+            }
             vocbase->garbageCollectReplicationClients(TRI_microtime());
           }
         }
@@ -231,7 +239,8 @@ DatabaseFeature::DatabaseFeature(
       _databasesLists(new DatabasesLists()),
       _isInitiallyEmpty(false),
       _checkVersion(false),
-      _upgrade(false) {
+      _upgrade(false),
+      _startupThreads(0) {
   setOptional(false);
   startsAfter("BasicsPhase");
 
@@ -281,6 +290,12 @@ void DatabaseFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "throw an error when accessing a collection that is still loading",
       new AtomicBooleanParameter(&_throwCollectionNotLoadedError));
 
+  options->addOption(
+      "--database.startup-threads",
+      "number of threads opening databases in parallel at startup "
+      "(0 = automatic)",
+      new UInt64Parameter(&_startupThreads));
+
   // the following option was removed in 3.2
   // index-creation is now automatically parallelized via the Boost ASIO thread pool
   options->addObsoleteOption(
@@ -709,9 +724,7 @@ int DatabaseFeature::dropDatabase(std::string const& name, bool waitForDeletion,
     vocbase->setIsOwnAppsDirectory(removeAppsDirectory);
 
     // invalidate all entries for the database
-#if USE_PLAN_CACHE
     arangodb::aql::PlanCache::instance()->invalidate(vocbase);
-#endif
     arangodb::aql::QueryCache::instance()->invalidate(vocbase);
 
     engine->prepareDropDatabase(*vocbase, !engine->inRecovery(), res);
@@ -1141,6 +1154,8 @@ int DatabaseFeature::iterateDatabases(VPackSlice const& databases) {
   ServerState::RoleEnum role = arangodb::ServerState::instance()->getRole();
 
   try {
+    std::vector<VPackSlice> toOpen;
+
     for (auto const& it : VPackArrayIterator(databases)) {
       TRI_ASSERT(it.isObject());
 
@@ -1161,10 +1176,64 @@ int DatabaseFeature::iterateDatabases(VPackSlice const& databases) {
         break;
       }
 
-      // open the database and scan collections in it
+      toOpen.emplace_back(it);
+    }
+
+    // open the databases and scan collections in them. opening a database
+    // instantiates all of its collections and indexes, so with many
+    // databases this is spread over multiple threads if the engine allows it
+    std::vector<std::unique_ptr<TRI_vocbase_t>> opened(toOpen.size());
+    std::vector<std::exception_ptr> errors(toOpen.size());
+    std::atomic<size_t> next(0);
+
+    auto worker = [&]() {
+      size_t i;
+      while ((i = next.fetch_add(1)) < toOpen.size()) {
+        try {
+          opened[i] = engine->openDatabase(toOpen[i], _upgrade);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+
+    size_t numThreads = 1;
+    if (engine->supportsParallelDatabaseOpening()) {
+      numThreads = (_startupThreads > 0)
+                       ? static_cast<size_t>(_startupThreads)
+                       : (std::min)(TRI_numberProcessors(), size_t(16));
+    }
+    numThreads = (std::min)(numThreads, toOpen.size());
+
+    if (numThreads > 1) {
+      LOG_TOPIC(DEBUG, Logger::FIXME) << "opening " << toOpen.size()
+                                      << " databases using " << numThreads
+                                      << " threads";
+      std::vector<std::thread> threads;
+      threads.reserve(numThreads - 1);
+      try {
+        for (size_t i = 1; i < numThreads; ++i) {
+          threads.emplace_back(worker);
+        }
+      } catch (...) {
+        // could not start another thread. the remaining ones will do
+      }
+      worker();
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    } else {
+      worker();
+    }
+
+    for (size_t i = 0; i < toOpen.size(); ++i) {
+      if (errors[i] != nullptr) {
+        std::rethrow_exception(errors[i]);
+      }
+    }
 
-      // try to open this database
-      auto* database = engine->openDatabase(it, _upgrade).release();
+    for (auto& it : opened) {
+      auto* database = it.release();
 
       if (!ServerState::isCoordinator(role) && !ServerState::isAgent(role)) {
         try {
@@ -172,6 +172,9 @@ class DatabaseFeature : public application_features::ApplicationFeature {
   bool _checkVersion;
   bool _upgrade;
 
+  /// @brief number of threads opening databases at startup, 0 = automatic
+  uint64_t _startupThreads;
+
   /// @brief lock for serializing the creation of databases
   arangodb::Mutex _databaseCreateLock;
 
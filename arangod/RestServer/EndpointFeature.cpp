@@ -40,7 +40,8 @@ EndpointFeature::EndpointFeature(
 )
     : ApplicationFeature(server, "Endpoint"),
       _reuseAddress(true),
-      _backlogSize(64) {
+      _backlogSize(64),
+      _acceptorsPerEndpoint(1) {
   setOptional(true);
   requiresElevatedPrivileges(true);
   startsAfter("AQLPhase");
@@ -73,6 +74,13 @@ void EndpointFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
 
   options->addHiddenOption("--tcp.backlog-size", "listen backlog size",
                            new UInt64Parameter(&_backlogSize));
+
+  options->addHiddenOption(
+      "--tcp.acceptors-per-endpoint",
+      "number of acceptors per TCP endpoint, each on its own io thread. "
+      "more than one uses SO_REUSEPORT to let the kernel distribute the "
+      "incoming connections",
+      new UInt64Parameter(&_acceptorsPerEndpoint));
 }
 
 void EndpointFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
@@ -81,6 +89,18 @@ void EndpointFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
                  "header SOMAXCONN value "
               << SOMAXCONN << ". trying to use " << SOMAXCONN << " anyway";
   }
+
+  if (_acceptorsPerEndpoint == 0) {
+    _acceptorsPerEndpoint = 1;
+  }
+#ifndef SO_REUSEPORT
+  if (_acceptorsPerEndpoint > 1) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "SO_REUSEPORT is not supported on this platform, ignoring "
+           "--tcp.acceptors-per-endpoint";
+    _acceptorsPerEndpoint = 1;
+  }
+#endif
 }
 
 void EndpointFeature::prepare() {
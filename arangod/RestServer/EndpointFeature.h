@@ -45,10 +45,12 @@ class EndpointFeature final : public application_features::ApplicationFeature,
   std::vector<std::string> _endpoints;
   bool _reuseAddress;
   uint64_t _backlogSize;
+  uint64_t _acceptorsPerEndpoint;
 
  public:
   std::vector<std::string> httpEndpoints() override;
   EndpointList const& endpointList() const { return _endpointList; }
+  uint64_t acceptorsPerEndpoint() const { return _acceptorsPerEndpoint; }
 
  private:
   void buildEndpointLists();
@@ -26,11 +26,14 @@
 #include "Aql/QueryCache.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ServerState.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 #include "RestServer/DatabaseFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
 #include "Utils/FlushThread.h"
 #include "Utils/FlushTransaction.h"
 
@@ -44,7 +47,8 @@ std::atomic<bool> FlushFeature::_isRunning(false);
 
 FlushFeature::FlushFeature(application_features::ApplicationServer& server)
     : ApplicationFeature(server, "Flush"),
-      _flushInterval(1000000) {
+      _flushInterval(1000000),
+      _maxRetentionTime(60.0) {
   setOptional(true);
   startsAfter("BasicsPhase");
 
@@ -58,6 +62,12 @@ void FlushFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "--server.flush-interval",
       "interval (in microseconds) for flushing data",
       new UInt64Parameter(&_flushInterval));
+
+  options->addHiddenOption(
+      "--server.flush-max-retention-time",
+      "seconds a flush subscriber may keep the WAL before its commits "
+      "are retried outside of the flush interval",
+      new DoubleParameter(&_maxRetentionTime));
 }
 
 void FlushFeature::validateOptions(std::shared_ptr<options::ProgramOptions> options) {
@@ -65,6 +75,9 @@ void FlushFeature::validateOptions(std::shared_ptr<options::ProgramOptions> opti
     // do not go below 1000 microseconds
     _flushInterval = 1000;
   }
+  if (_maxRetentionTime < 1.0) {
+    _maxRetentionTime = 1.0;
+  }
 }
 
 void FlushFeature::prepare() {
@@ -133,8 +146,14 @@ void FlushFeature::unprepare() {
 }
 
 void FlushFeature::registerCallback(void* ptr, FlushFeature::FlushCallback const& cb) {
+  // the callback only needs the WAL written after its registration
+  StorageEngine* engine = EngineSelectorFeature::ENGINE;
+  Subscription subscription{
+      cb, {"", engine != nullptr ? engine->currentTick() : 0, TRI_microtime()},
+      false};
+
   WRITE_LOCKER(locker, _callbacksLock);
-  _callbacks.emplace(ptr, std::move(cb));
+  _callbacks.emplace(ptr, std::move(subscription));
   LOG_TOPIC(TRACE, arangodb::Logger::FLUSH) << "registered new flush callback";
 }
 
@@ -151,26 +170,33 @@ bool FlushFeature::unregisterCallback(void* ptr) {
   return true;
 }
 
-void FlushFeature::executeCallbacks() {
-  std::vector<FlushTransactionPtr> transactions;
+void FlushFeature::executeCallbacks(TRI_voc_tick_t tick, bool laggingOnly) {
+  std::vector<std::pair<void*, FlushTransactionPtr>> transactions;
 
   {
     READ_LOCKER(locker, _callbacksLock);
     transactions.reserve(_callbacks.size());
+    double const now = TRI_microtime();
 
     // execute all callbacks. this will create as many transactions as
     // there are callbacks
     for (auto const& cb: _callbacks) {
+      if (laggingOnly && !isLagging(cb.second, now)) {
+        continue;
+      }
       // copy elision, std::move(..) not required
       LOG_TOPIC(TRACE, arangodb::Logger::FLUSH) << "executing flush callback";
-      transactions.emplace_back(cb.second());
+      transactions.emplace_back(cb.first, cb.second.callback());
     }
   }
 
   // TODO: make sure all data is synced
 
   // commit all transactions
-  for (auto const& trx : transactions) {
+  std::vector<std::tuple<void*, std::string, bool>> results;
+  results.reserve(transactions.size());
+  for (auto const& it : transactions) {
+    auto const& trx = it.second;
     LOG_TOPIC(DEBUG, Logger::FLUSH)
         << "commiting flush transaction '" << trx->name() << "'";
 
@@ -179,8 +205,71 @@ void FlushFeature::executeCallbacks() {
     LOG_TOPIC_IF(ERR, Logger::FLUSH, res.fail())
       << "could not commit flush transaction '" << trx->name() << "': "
       << res.errorMessage();
-    // TODO: honor the commit results here
+    results.emplace_back(it.first, trx->name(), res.ok());
+  }
+
+  // the transactions may hold locks of the callback owners, which must
+  // not be held while acquiring _callbacksLock
+  transactions.clear();
+
+  WRITE_LOCKER(locker, _callbacksLock);
+  double const now = TRI_microtime();
+  for (auto const& it : results) {
+    auto cb = _callbacks.find(std::get<0>(it));
+    if (cb == _callbacks.end()) {
+      // unregistered in the meantime
+      continue;
+    }
+    Subscription& subscription = cb->second;
+    subscription.info.name = std::get<1>(it);
+    if (std::get<2>(it)) {
+      subscription.info.tick = std::max(subscription.info.tick, tick);
+      subscription.info.lastFlush = now;
+      subscription.warned = false;
+    } else if (isLagging(subscription, now) && !subscription.warned) {
+      // a failed commit keeps the WAL the callback needs
+      LOG_TOPIC(WARN, Logger::FLUSH)
+          << "flush transaction '" << subscription.info.name
+          << "' did not commit for " << (now - subscription.info.lastFlush)
+          << "s, keeping the WAL from tick " << subscription.info.tick;
+      subscription.warned = true;
+    }
   }
 }
 
+TRI_voc_tick_t FlushFeature::releasableTick(TRI_voc_tick_t tick) const {
+  READ_LOCKER(locker, _callbacksLock);
+  for (auto const& cb : _callbacks) {
+    tick = std::min(tick, cb.second.info.tick);
+  }
+  return tick;
+}
+
+bool FlushFeature::hasLaggingCallbacks() const {
+  READ_LOCKER(locker, _callbacksLock);
+  double const now = TRI_microtime();
+  for (auto const& cb : _callbacks) {
+    if (isLagging(cb.second, now)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<FlushFeature::SubscriptionInfo> FlushFeature::subscriptions()
+    const {
+  std::vector<SubscriptionInfo> result;
+  READ_LOCKER(locker, _callbacksLock);
+  result.reserve(_callbacks.size());
+  for (auto const& cb : _callbacks) {
+    result.emplace_back(cb.second.info);
+  }
+  return result;
+}
+
+bool FlushFeature::isLagging(Subscription const& subscription,
+                             double now) const {
+  return now - subscription.info.lastFlush > _maxRetentionTime;
+}
+
 } // arangodb
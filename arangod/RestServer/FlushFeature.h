@@ -25,6 +25,7 @@
 
 #include "ApplicationFeatures/ApplicationFeature.h"
 #include "Basics/ReadWriteLock.h"
+#include "VocBase/voc-types.h"
 
 namespace arangodb {
 
@@ -40,6 +41,16 @@ class FlushFeature final
 
   typedef std::function<FlushTransactionPtr()> FlushCallback;
 
+  /// @brief the WAL retention of a registered callback
+  struct SubscriptionInfo {
+    /// @brief name of the last flush transaction
+    std::string name;
+    /// @brief WAL before this tick is not needed by the callback anymore
+    TRI_voc_tick_t tick;
+    /// @brief time of the last successful commit
+    double lastFlush;
+  };
+
   explicit FlushFeature(
     application_features::ApplicationServer& server
   );
@@ -62,17 +73,42 @@ class FlushFeature final
   /// if the callback is unknown, returns false.
   bool unregisterCallback(void* ptr);
 
-  /// @brief executes all callbacks. the order in which they are executed is undefined
-  void executeCallbacks();
+  /// @brief executes all callbacks. the order in which they are executed is undefined.
+  /// the callbacks that commit successfully do not need the WAL up to tick
+  /// anymore. with laggingOnly, only the callbacks that have not committed
+  /// successfully within the maximum retention time are executed
+  void executeCallbacks(TRI_voc_tick_t tick = 0, bool laggingOnly = false);
+
+  /// @brief the tick up to which no callback needs the WAL anymore, at
+  /// most tick
+  TRI_voc_tick_t releasableTick(TRI_voc_tick_t tick) const;
+
+  /// @brief whether a callback has not committed successfully within the
+  /// maximum retention time
+  bool hasLaggingCallbacks() const;
+
+  std::vector<SubscriptionInfo> subscriptions() const;
 
  private:
+  struct Subscription {
+    FlushCallback callback;
+    SubscriptionInfo info;
+    /// @brief whether the exceeded retention time was logged
+    bool warned;
+  };
+
+  bool isLagging(Subscription const& subscription, double now) const;
+
   uint64_t _flushInterval;
+  /// @brief seconds a callback may fail to commit before it is retried
+  /// outside of the regular flush interval
+  double _maxRetentionTime;
   std::unique_ptr<FlushThread> _flushThread;
   static std::atomic<bool> _isRunning;
   basics::ReadWriteLock _threadLock;
 
-  basics::ReadWriteLock _callbacksLock;
-  std::unordered_map<void*, FlushCallback> _callbacks;
+  mutable basics::ReadWriteLock _callbacksLock;
+  std::unordered_map<void*, Subscription> _callbacks;
 };
 
 }
@@ -22,12 +22,16 @@
 
 #include "QueryRegistryFeature.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/Query.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryRegistry.h"
+#include "Aql/ResourceUsage.h"
+#include "Graph/EdgeSnapshot.h"
 #include "Cluster/ServerState.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
+#include "Utils/CursorRepository.h"
 
 using namespace arangodb::application_features;
 using namespace arangodb::basics;
@@ -45,14 +49,19 @@ QueryRegistryFeature::QueryRegistryFeature(
       _trackBindVars(true),
       _failOnWarning(false),
       _queryMemoryLimit(0),
+      _queryGlobalMemoryLimit(0),
       _maxQueryPlans(128),
       _slowQueryThreshold(10.0),
       _slowStreamingQueryThreshold(10.0),
+      _profileSampling(0),
       _queryCacheMode("off"),
       _queryCacheMaxResultsCount(0),
       _queryCacheMaxResultsSize(0),
       _queryCacheMaxEntrySize(0),
       _queryCacheIncludeSystem(false),
+      _planCacheMaxEntries(0),
+      _cursorsMaxMemoryUsage(0),
+      _graphSnapshotsMaxMemoryUsage(0),
       _queryRegistryTTL(DefaultQueryTTL) {
   setOptional(false);
   startsAfter("V8Phase");
@@ -75,6 +84,10 @@ void QueryRegistryFeature::collectOptions(
   options->addOption("--query.memory-limit", "memory threshold for AQL queries (in bytes)",
                      new UInt64Parameter(&_queryMemoryLimit));
 
+  options->addOption("--query.global-memory-limit",
+                     "memory threshold for all AQL queries running on this server together (in bytes, 0 = unlimited)",
+                     new UInt64Parameter(&_queryGlobalMemoryLimit));
+
   options->addOption("--query.tracking", "whether to track slow AQL queries",
                      new BooleanParameter(&_trackSlowQueries));
 
@@ -90,6 +103,9 @@ void QueryRegistryFeature::collectOptions(
   options->addOption("--query.slow-streaming-threshold", "threshold for slow streaming AQL queries (in seconds)",
                      new DoubleParameter(&_slowStreamingQueryThreshold));
 
+  options->addOption("--query.profile-sampling", "profile every n-th AQL query and keep its profile with the slow queries (0 = off)",
+                     new UInt64Parameter(&_profileSampling));
+
   options->addOption("--query.cache-mode",
                      "mode for the AQL query result cache (on, off, demand)",
                      new StringParameter(&_queryCacheMode));
@@ -110,6 +126,18 @@ void QueryRegistryFeature::collectOptions(
                      "whether or not to include system collection queries in the query result cache",
                      new BooleanParameter(&_queryCacheIncludeSystem));
   
+  options->addOption("--query.plan-cache-entries",
+                     "maximum number of execution plans in the AQL plan cache per database (0 = turn plan cache off)",
+                     new UInt64Parameter(&_planCacheMaxEntries));
+  
+  options->addOption("--query.cursors-max-memory",
+                     "maximum cumulated size of the results kept by non-streaming cursors, above which new queries get streaming cursors (in bytes, 0 = unlimited)",
+                     new UInt64Parameter(&_cursorsMaxMemoryUsage));
+
+  options->addOption("--query.graph-snapshots-max-memory",
+                     "maximum cumulated size of the in-memory edge snapshots used by traversals on single servers and DB servers (in bytes, 0 = no snapshots)",
+                     new UInt64Parameter(&_graphSnapshotsMaxMemoryUsage));
+  
   options->addOption("--query.optimizer-max-plans", "maximum number of query plans to create for a query",
                      new UInt64Parameter(&_maxQueryPlans));
 
@@ -146,6 +174,27 @@ void QueryRegistryFeature::prepare() {
   };
   arangodb::aql::QueryCache::instance()->properties(properties);
 
+  if (ServerState::instance()->isCoordinator()) {
+    // plans on the coordinator are distributed to the DB servers, which
+    // the plan cache does not handle
+    _planCacheMaxEntries = 0;
+  }
+
+  // configure the plan cache
+  arangodb::aql::PlanCache::instance()->maxEntries(static_cast<size_t>(_planCacheMaxEntries));
+
+  CursorRepository::setMaxMemoryUsage(_cursorsMaxMemoryUsage);
+
+  arangodb::aql::GlobalResourceMonitor::instance().setMemoryLimit(
+      static_cast<size_t>(_queryGlobalMemoryLimit));
+
+  if (ServerState::instance()->isCoordinator()) {
+    // coordinators do not read edges themselves
+    _graphSnapshotsMaxMemoryUsage = 0;
+  }
+  arangodb::graph::EdgeSnapshotCache::instance()->memoryLimit(
+      static_cast<size_t>(_graphSnapshotsMaxMemoryUsage));
+
   if (_queryRegistryTTL <= 0) {
     _queryRegistryTTL = DefaultQueryTTL;
   }
@@ -160,6 +209,10 @@ void QueryRegistryFeature::start() {}
 void QueryRegistryFeature::unprepare() {
   // clear the query registery
   QUERY_REGISTRY.store(nullptr, std::memory_order_release);
+
+  // free the memory of the edge snapshots
+  arangodb::graph::EdgeSnapshotCache::instance()->memoryLimit(0);
+  arangodb::graph::EdgeSnapshotCache::instance()->clear();
 }
 
 } // arangodb
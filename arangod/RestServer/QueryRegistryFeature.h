@@ -56,6 +56,7 @@ class QueryRegistryFeature final : public application_features::ApplicationFeatu
   bool trackBindVars() const { return _trackBindVars; }
   double slowQueryThreshold() const { return _slowQueryThreshold; }
   double slowStreamingQueryThreshold() const { return _slowStreamingQueryThreshold; }
+  uint64_t profileSampling() const { return _profileSampling; }
   bool failOnWarning() const { return _failOnWarning; }
   uint64_t queryMemoryLimit() const { return _queryMemoryLimit; }
   uint64_t maxQueryPlans() const { return _maxQueryPlans; }
@@ -65,14 +66,19 @@ class QueryRegistryFeature final : public application_features::ApplicationFeatu
   bool _trackBindVars;
   bool _failOnWarning;
   uint64_t _queryMemoryLimit;
+  uint64_t _queryGlobalMemoryLimit;
   uint64_t _maxQueryPlans;
   double _slowQueryThreshold;
   double _slowStreamingQueryThreshold;
+  uint64_t _profileSampling;
   std::string _queryCacheMode;
   uint64_t _queryCacheMaxResultsCount;
   uint64_t _queryCacheMaxResultsSize;
   uint64_t _queryCacheMaxEntrySize;
   bool _queryCacheIncludeSystem;
+  uint64_t _planCacheMaxEntries;
+  uint64_t _cursorsMaxMemoryUsage;
+  uint64_t _graphSnapshotsMaxMemoryUsage;
   double _queryRegistryTTL;
 
  public:
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "VocbaseContext.h"
+#include "Basics/StaticStrings.h"
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "Logger/Logger.h"
@@ -29,6 +30,33 @@
 
 using namespace arangodb::rest;
 
+namespace {
+/// @brief the authentication entry of a request's JWT, which has been
+/// validated (and cached) by the comm task already
+arangodb::auth::TokenCache::Entry routingGrant(
+    arangodb::GeneralRequest& req, arangodb::AuthenticationFeature* auth) {
+  if (req.authenticationMethod() != AuthenticationMethod::JWT) {
+    return arangodb::auth::TokenCache::Entry::Unauthenticated();
+  }
+  bool found;
+  std::string const& header =
+      req.header(arangodb::StaticStrings::Authorization, found);
+  size_t pos = found ? header.find(' ') : std::string::npos;
+  if (pos != std::string::npos) {
+    pos = header.find_first_not_of(' ', pos);
+  }
+  if (pos == std::string::npos) {
+    return arangodb::auth::TokenCache::Entry::Unauthenticated();
+  }
+  auto entry = auth->tokenCache().checkAuthentication(AuthenticationMethod::JWT,
+                                                       header.substr(pos));
+  if (!entry.authenticated() || entry.username() != req.user()) {
+    return arangodb::auth::TokenCache::Entry::Unauthenticated();
+  }
+  return entry;
+}
+}
+
 namespace arangodb {
 
 VocbaseContext::VocbaseContext(
@@ -88,8 +116,18 @@ VocbaseContext* VocbaseContext::create(GeneralRequest& req, TRI_vocbase_t& vocba
   
   auth::UserManager* um = auth->userManager();
   if (um == nullptr) {
-    LOG_TOPIC(WARN, Logger::AUTHENTICATION) << "users are not supported on this server";
-    return nullptr;
+    // servers without users only grant what a routing token carries
+    auth::TokenCache::Entry grant = ::routingGrant(req, auth);
+    if (grant._routingCollection == 0 ||
+        grant._routingDatabase != req.databaseName()) {
+      LOG_TOPIC(WARN, Logger::AUTHENTICATION) << "users are not supported on this server";
+      return nullptr;
+    }
+    auto context = new VocbaseContext(req, vocbase, ExecContext::Type::Default,
+                                      /*sysLevel*/ auth::Level::NONE,
+                                      /*dbLevel*/ grant._routingLevel);
+    context->_routingCollection = grant._routingCollection;
+    return context;
   }
   
   auth::Level dbLvl = um->databaseAuthLevel(req.user(), req.databaseName());
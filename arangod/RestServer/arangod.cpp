@@ -69,6 +69,7 @@
 #include "ProgramOptions/ProgramOptions.h"
 #include "Random/RandomFeature.h"
 #include "Replication/ReplicationFeature.h"
+#include "RestServer/AggregateViewFeature.h"
 #include "RestServer/AqlFeature.h"
 #include "RestServer/BootstrapFeature.h"
 #include "RestServer/CheckVersionFeature.h"
@@ -164,6 +165,7 @@ static int runServer(int argc, char** argv, ArangoGlobalContext &context) {
     // Adding the features
     server.addFeature(new ActionFeature(server));
     server.addFeature(new AgencyFeature(server));
+    server.addFeature(new AggregateViewFeature(server));
     server.addFeature(new AqlFeature(server));
     server.addFeature(new AuthenticationFeature(server));
     server.addFeature(new BootstrapFeature(server));
@@ -47,6 +47,7 @@ void RocksDBBackgroundThread::beginShutdown() {
 
 void RocksDBBackgroundThread::run() {
   double const startTime = TRI_microtime();
+  bool warmedUp = false;
 
   while (!isStopping()) {
     {
@@ -59,6 +60,12 @@ void RocksDBBackgroundThread::run() {
     }
 
     try {
+      if (!warmedUp && !isStopping()) {
+        // the hot sets can only be loaded once the recovery is done
+        warmedUp = true;
+        _engine->warmupHotSets();
+      }
+
       if (!isStopping()) {
         double start = TRI_microtime();
         Result res = _engine->settingsManager()->sync(false);
@@ -22,6 +22,7 @@
 
 #include "RocksDBCollection.h"
 #include "Aql/PlanCache.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
 #include "Basics/StaticStrings.h"
@@ -40,14 +41,18 @@
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBIndexBuilder.h"
 #include "RocksDBEngine/RocksDBIterators.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBObjectStatistics.h"
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "RocksDBEngine/RocksDBVPackIndex.h"
 #include "RocksDBEngine/RocksDBValue.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
@@ -103,6 +108,10 @@ RocksDBCollection::RocksDBCollection(
       _objectId(basics::VelocyPackHelper::stringUInt64(info, "objectId")),
       _numberDocuments(0),
       _revisionId(0),
+      _pendingWrites(0),
+      _lastWriteSeq(0),
+      _keyChunksSize(0),
+      _keyChunksLastWrite(0),
       _primaryIndex(nullptr),
       _cache(nullptr),
       _cachePresent(false),
@@ -136,6 +145,10 @@ RocksDBCollection::RocksDBCollection(
       _objectId(static_cast<RocksDBCollection const*>(physical)->_objectId),
       _numberDocuments(0),
       _revisionId(0),
+      _pendingWrites(0),
+      _lastWriteSeq(0),
+      _keyChunksSize(0),
+      _keyChunksLastWrite(0),
       _primaryIndex(nullptr),
       _cache(nullptr),
       _cachePresent(false),
@@ -401,10 +414,8 @@ std::shared_ptr<Index> RocksDBCollection::createIndex(
     THROW_ARANGO_EXCEPTION(res);
   }
 
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(
-      _logicalCollection->vocbase());
-#endif
+      &_logicalCollection.vocbase());
   // Until here no harm is done if something fails. The shared_ptr will
   // clean up, if left before
   {
@@ -605,6 +616,124 @@ std::unique_ptr<IndexIterator> RocksDBCollection::getAllIterator(transaction::Me
   );
 }
 
+/// @brief split the documents of the collection into numPartitions key
+/// ranges of roughly equal size. all returned iterators read from the
+/// snapshot of the transaction. the transaction must not modify the
+/// collection while the iterators are used from different threads
+std::vector<std::unique_ptr<IndexIterator>> RocksDBCollection::getAllIterators(
+    transaction::Methods* trx, size_t numPartitions) const {
+  std::vector<std::unique_ptr<IndexIterator>> iterators;
+  std::vector<RocksDBKeyBounds> partitions;
+  if (numPartitions > 1) {
+    partitions = partitionDocuments(
+        RocksDBTransactionState::toMethods(trx)->iteratorReadOptions(),
+        numPartitions);
+  }
+  if (partitions.size() <= 1) {
+    iterators.emplace_back(getAllIterator(trx));
+    return iterators;
+  }
+
+  for (RocksDBKeyBounds& partition : partitions) {
+    iterators.emplace_back(new RocksDBAllIndexIterator(
+        &_logicalCollection, trx, std::move(partition)));
+  }
+  return iterators;
+}
+
+std::vector<RocksDBKeyBounds> RocksDBCollection::partitionDocuments(
+    rocksdb::ReadOptions const& readOptions, size_t numPartitions) const {
+  std::vector<RocksDBKeyBounds> partitions;
+  RocksDBKeyBounds const bounds = RocksDBKeyBounds::CollectionDocuments(_objectId);
+  if (numPartitions <= 1) {
+    partitions.emplace_back(bounds);
+    return partitions;
+  }
+
+  // the partitions are defined over the eight key bytes following the
+  // object id, see RocksDBKeyBounds::CollectionDocuments
+  auto keySuffix = [](rocksdb::Slice const& key) -> uint64_t {
+    TRI_ASSERT(key.size() >= 2 * sizeof(uint64_t));
+    return rocksutils::uintFromPersistentBigEndian<uint64_t>(key.data() +
+                                                             sizeof(uint64_t));
+  };
+
+  // determine the first and the last document in the snapshot
+  rocksdb::ColumnFamilyHandle* cf = bounds.columnFamily();
+  rocksdb::Slice const end = bounds.end();
+  rocksdb::ReadOptions ro = readOptions;
+  ro.iterate_upper_bound = &end;
+  ro.prefix_same_as_start = false;
+  ro.total_order_seek = true;
+  ro.fill_cache = false;
+  std::unique_ptr<rocksdb::Iterator> it(rocksutils::globalRocksDB()->NewIterator(ro, cf));
+
+  it->Seek(bounds.start());
+  if (!it->Valid()) {
+    partitions.emplace_back(bounds);
+    return partitions;
+  }
+  uint64_t const first = keySuffix(it->key());
+  it->SeekForPrev(end);
+  TRI_ASSERT(it->Valid());
+  uint64_t const last = it->Valid() ? keySuffix(it->key()) : first;
+  it.reset();
+
+  // cut [first, last] into slices that are considerably smaller than a
+  // partition, and let rocksdb estimate the data size of each of them
+  size_t numSlices = numPartitions * 16;
+  uint64_t step = 1;
+  if (last - first >= numSlices) {
+    step = (last - first) / numSlices;
+  } else {
+    numSlices = static_cast<size_t>(last - first) + 1;
+  }
+
+  std::vector<RocksDBKeyBounds> slices;
+  std::vector<rocksdb::Range> ranges;
+  slices.reserve(numSlices);
+  ranges.reserve(numSlices);
+  for (size_t i = 0; i < numSlices; ++i) {
+    uint64_t lower = first + i * step;
+    uint64_t upper = (i + 1 == numSlices) ? UINT64_MAX : lower + step;
+    slices.emplace_back(RocksDBKeyBounds::CollectionDocuments(_objectId, lower, upper));
+    ranges.emplace_back(slices.back().start(), slices.back().end());
+  }
+  std::vector<uint64_t> sizes(numSlices, 0);
+  rocksutils::globalRocksDB()->GetApproximateSizes(
+      cf, ranges.data(), static_cast<int>(numSlices), sizes.data(),
+      static_cast<uint8_t>(
+          rocksdb::DB::SizeApproximationFlags::INCLUDE_MEMTABLES |
+          rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES));
+
+  uint64_t total = 0;
+  for (uint64_t size : sizes) {
+    total += size;
+  }
+  if (total == 0) {
+    // no estimates available, assume all slices are equally filled
+    std::fill(sizes.begin(), sizes.end(), 1);
+    total = numSlices;
+  }
+
+  // combine adjacent slices to partitions. the first partition starts at
+  // the beginning and the last one ends at the end of the collection, so
+  // that documents outside of [first, last] are not lost
+  uint64_t lower = 0;
+  uint64_t sum = 0;
+  for (size_t i = 0; i + 1 < numSlices && partitions.size() + 1 < numPartitions; ++i) {
+    sum += sizes[i];
+    if (sum * numPartitions >= total * (partitions.size() + 1)) {
+      uint64_t upper = first + (i + 1) * step;
+      partitions.emplace_back(RocksDBKeyBounds::CollectionDocuments(_objectId, lower, upper));
+      lower = upper;
+    }
+  }
+  partitions.emplace_back(RocksDBKeyBounds::CollectionDocuments(_objectId, lower, UINT64_MAX));
+
+  return partitions;
+}
+
 std::unique_ptr<IndexIterator> RocksDBCollection::getAnyIterator(
     transaction::Methods* trx) const {
   return std::unique_ptr<IndexIterator>(
@@ -699,6 +828,11 @@ Result RocksDBCollection::truncate(transaction::Methods* trx,
       return rocksutils::convertStatus(s);
     }
 
+    beginWrite();
+    auto writeGuard = scopeGuard([this] {
+      endWrite(rocksutils::latestSequenceNumber());
+    });
+
     rocksdb::WriteOptions wo;
     s = rocksutils::globalRocksDB()->Write(wo, &batch);
     if (!s.ok()) {
@@ -720,8 +854,15 @@ Result RocksDBCollection::truncate(transaction::Methods* trx,
     engine->settingsManager()->updateCounter(_objectId, update);
 
     if (numDocs > 64 * 1024) {
-      // also compact the ranges in order to speed up all further accesses
-      compact();
+      // also compact the ranges in order to speed up all further accesses.
+      // this is done in the background, so truncate returns right away
+      rocksutils::compactRangeInBackground(
+          RocksDBKeyBounds::CollectionDocuments(_objectId));
+      READ_LOCKER(guard, _indexesLock);
+      for (std::shared_ptr<Index> const& idx : _indexes) {
+        rocksutils::compactRangeInBackground(
+            static_cast<RocksDBIndex*>(idx.get())->getBounds());
+      }
     }
     TRI_ASSERT(!state->hasOperations()); // not allowed
     return Result{};
@@ -859,6 +1000,39 @@ Result RocksDBCollection::read(transaction::Methods* trx,
   return Result(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND);
 }
 
+Result RocksDBCollection::readMany(
+    transaction::Methods* trx, std::vector<StringRef> const& keys,
+    std::function<void(size_t, VPackSlice)> const& cb, bool) {
+  std::vector<LocalDocumentId> documentIds;
+  primaryIndex()->lookupKeys(trx, keys, documentIds);
+
+  std::vector<LocalDocumentId> found;
+  found.reserve(documentIds.size());
+  std::vector<size_t> positions;
+  positions.reserve(documentIds.size());
+  for (size_t i = 0; i < documentIds.size(); ++i) {
+    if (documentIds[i].isSet()) {
+      found.emplace_back(documentIds[i]);
+      positions.emplace_back(i);
+    }
+  }
+
+  // the callback is called in the order of found, but skips the
+  // documents that could not be read
+  size_t next = 0;
+  readDocumentWithCallback(trx, found, [&](LocalDocumentId const& documentId,
+                                           VPackSlice doc) {
+    while (next < found.size() && found[next] != documentId) {
+      ++next;
+    }
+    TRI_ASSERT(next < found.size());
+    cb(positions[next], doc);
+    ++next;
+  });
+
+  return Result();
+}
+
 // read using a token!
 bool RocksDBCollection::readDocument(transaction::Methods* trx,
                                      LocalDocumentId const& documentId,
@@ -880,6 +1054,122 @@ bool RocksDBCollection::readDocumentWithCallback(
   return false;
 }
 
+size_t RocksDBCollection::readDocumentWithCallback(
+    transaction::Methods* trx, std::vector<LocalDocumentId> const& documentIds,
+    IndexIterator::DocumentCallback const& cb) const {
+  TRI_ASSERT(trx->state()->isRunning());
+  TRI_ASSERT(_objectId != 0);
+
+  size_t const n = documentIds.size();
+  if (n <= 1) {
+    size_t count = 0;
+    for (auto const& documentId : documentIds) {
+      if (readDocumentWithCallback(trx, documentId, cb)) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  // documents found in the cache
+  std::vector<cache::Finding> cached(n);
+  // keys of all documents, and the positions of those not found in the cache
+  std::vector<std::string> keys;
+  keys.reserve(n);
+  std::vector<size_t> positions;
+  positions.reserve(n);
+
+  bool lockTimeout = false;
+  RocksDBKeyLeaser key(trx);
+  for (size_t i = 0; i < n; ++i) {
+    key->constructDocument(_objectId, documentIds[i]);
+    keys.emplace_back(key->string().data(), key->string().size());
+
+    if (useCache()) {
+      TRI_ASSERT(_cache != nullptr);
+      cached[i] = _cache->find(keys[i].data(), static_cast<uint32_t>(keys[i].size()));
+      if (cached[i].found()) {
+        continue;
+      }
+      if (cached[i].result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+        // assuming someone is currently holding a write lock, which
+        // is why we cannot access the TransactionalBucket.
+        lockTimeout = true;  // we skip the inserts in this case
+      }
+    }
+    positions.emplace_back(i);
+  }
+
+  // look up the remaining documents in key order
+  std::sort(positions.begin(), positions.end(), [&keys](size_t lhs, size_t rhs) {
+    return keys[lhs] < keys[rhs];
+  });
+
+  std::vector<rocksdb::Slice> lookupKeys;
+  lookupKeys.reserve(positions.size());
+  for (auto const& i : positions) {
+    lookupKeys.emplace_back(keys[i]);
+  }
+
+  std::vector<std::string> values;
+  std::vector<Result> results;
+  // position in values for each document, SIZE_MAX if found in the cache
+  std::vector<size_t> valuePositions(n, SIZE_MAX);
+  if (!lookupKeys.empty()) {
+    RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
+    mthd->MultiGet(RocksDBColumnFamily::documents(), lookupKeys, &values, &results);
+    TRI_ASSERT(values.size() == positions.size());
+    TRI_ASSERT(results.size() == positions.size());
+
+    for (size_t j = 0; j < positions.size(); ++j) {
+      valuePositions[positions[j]] = j;
+
+      if (results[j].fail()) {
+        LOG_TOPIC(DEBUG, Logger::ENGINES)
+            << "NOT FOUND rev: " << documentIds[positions[j]].id()
+            << " trx: " << trx->state()->id()
+            << " seq: " << mthd->sequenceNumber()
+            << " objectID " << _objectId << " name: " << _logicalCollection.name();
+        continue;
+      }
+
+      if (useCache() && !lockTimeout) {
+        TRI_ASSERT(_cache != nullptr);
+        // write entry back to cache
+        auto entry = cache::CachedValue::construct(
+            lookupKeys[j].data(), static_cast<uint32_t>(lookupKeys[j].size()),
+            values[j].data(), static_cast<uint64_t>(values[j].size()));
+        if (entry) {
+          auto status = _cache->insert(entry);
+          if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+            // the writeLock uses cpu_relax internally, so we can try yield
+            std::this_thread::yield();
+            status = _cache->insert(entry);
+          }
+          if (status.fail()) {
+            delete entry;
+          }
+        }
+      }
+    }
+  }
+
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (valuePositions[i] == SIZE_MAX) {
+      TRI_ASSERT(cached[i].found());
+      cb(documentIds[i],
+         VPackSlice(reinterpret_cast<char const*>(cached[i].value()->value())));
+      ++count;
+    } else if (results[valuePositions[i]].ok()) {
+      cb(documentIds[i], VPackSlice(values[valuePositions[i]].data()));
+      ++count;
+    }
+  }
+
+  return count;
+}
+
 Result RocksDBCollection::insert(arangodb::transaction::Methods* trx,
                                  arangodb::velocypack::Slice const slice,
                                  arangodb::ManagedDocumentResult& mdr,
@@ -928,9 +1218,20 @@ Result RocksDBCollection::insert(arangodb::transaction::Methods* trx,
     }
   }
 
+  auto state = RocksDBTransactionState::toState(trx);
+  if (state->isBulkLoad()) {
+    // a bulk load collects its operations in a WriteBatchWithIndex, and
+    // rolling that back to a savepoint rebuilds its whole index. so check
+    // the unique constraints before anything is written, as otherwise
+    // every rejected document would cost time linear in the batch size
+    res = checkUniqueConstraints(trx, newSlice, options);
+    if (res.fail()) {
+      return res;
+    }
+  }
+
   RocksDBSavePoint guard(trx, TRI_VOC_DOCUMENT_OPERATION_INSERT);
 
-  auto state = RocksDBTransactionState::toState(trx);
   state->prepareOperation(
     _logicalCollection.id(), revisionId, TRI_VOC_DOCUMENT_OPERATION_INSERT
   );
@@ -973,7 +1274,6 @@ Result RocksDBCollection::update(arangodb::transaction::Methods* trx,
                                  arangodb::velocypack::Slice const key) {
   resultMarkerTick = 0;
 
-  LocalDocumentId const documentId = LocalDocumentId::create();
   auto isEdgeCollection = (TRI_COL_TYPE_EDGE == _logicalCollection.type());
   Result res = this->read(trx, key, previous, /*lock*/false);
 
@@ -984,6 +1284,8 @@ Result RocksDBCollection::update(arangodb::transaction::Methods* trx,
   TRI_ASSERT(!previous.empty());
 
   LocalDocumentId const oldDocumentId = previous.localDocumentId();
+  LocalDocumentId const documentId =
+      canUpdateInPlace() ? oldDocumentId : LocalDocumentId::create();
   VPackSlice oldDoc(previous.vpack());
   TRI_voc_rid_t const oldRevisionId =
       transaction::helpers::extractRevFromDocument(oldDoc);
@@ -1084,7 +1386,6 @@ Result RocksDBCollection::replace(transaction::Methods* trx,
                                   ManagedDocumentResult& previous) {
   resultMarkerTick = 0;
 
-  LocalDocumentId const documentId = LocalDocumentId::create();
   auto isEdgeCollection = (TRI_COL_TYPE_EDGE == _logicalCollection.type());
 
   // get the previous revision
@@ -1103,6 +1404,8 @@ Result RocksDBCollection::replace(transaction::Methods* trx,
 
   TRI_ASSERT(!previous.empty());
   LocalDocumentId const oldDocumentId = previous.localDocumentId();
+  LocalDocumentId const documentId =
+      canUpdateInPlace() ? oldDocumentId : LocalDocumentId::create();
 
   VPackSlice oldDoc(previous.vpack());
   TRI_voc_rid_t oldRevisionId =
@@ -1295,6 +1598,31 @@ void RocksDBCollection::figuresSpecific(
     builder->add("cacheSize", VPackValue(0));
     builder->add("cacheUsage", VPackValue(0));
   }
+
+  // sampled read statistics of the documents and of each index
+  RocksDBObjectStatistics* statistics =
+      rocksutils::globalRocksEngine()->objectStatistics();
+  if (statistics != nullptr) {
+    builder->add("readStatistics", VPackValue(VPackValueType::Object));
+    builder->add("documents", VPackValue(VPackValueType::Object));
+    statistics->toVelocyPack(_objectId, *builder);
+    builder->close();  // documents
+
+    builder->add("indexes", VPackValue(VPackValueType::Array));
+    {
+      READ_LOCKER(guard, _indexesLock);
+      for (auto const& idx : _indexes) {
+        auto* rIdx = static_cast<RocksDBIndex*>(idx.get());
+        builder->openObject();
+        builder->add("id", VPackValue(std::to_string(idx->id())));
+        builder->add("type", VPackValue(idx->oldtypeName()));
+        statistics->toVelocyPack(rIdx->objectId(), *builder);
+        builder->close();
+      }
+    }
+    builder->close();  // indexes
+    builder->close();  // readStatistics
+  }
 }
 
 void RocksDBCollection::addIndex(std::shared_ptr<arangodb::Index> idx) {
@@ -1346,6 +1674,14 @@ arangodb::Result RocksDBCollection::fillIndexes(
   ));
 
   RocksDBIndex* ridx = static_cast<RocksDBIndex*>(added.get());
+
+  if (_numberDocuments >= 256 * 1024 && RocksDBIndexBuilder::canBuild(ridx)) {
+    // scan the collection in parallel and ingest the sorted index entries
+    // as SST files. this is a lot faster for large collections
+    RocksDBIndexBuilder builder(this, static_cast<RocksDBVPackIndex*>(ridx));
+    return builder.build(trx);
+  }
+
   auto state = RocksDBTransactionState::toState(trx);
   std::unique_ptr<IndexIterator> it(new RocksDBAllIndexIterator(
     &_logicalCollection, trx, primaryIndex()
@@ -1467,6 +1803,23 @@ Result RocksDBCollection::insertDocument(
   return res;
 }
 
+Result RocksDBCollection::checkUniqueConstraints(
+    arangodb::transaction::Methods* trx, VPackSlice const& doc,
+    OperationOptions& options) const {
+  RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
+
+  READ_LOCKER(guard, _indexesLock);
+  for (std::shared_ptr<Index> const& idx : _indexes) {
+    RocksDBIndex* rIdx = static_cast<RocksDBIndex*>(idx.get());
+    Result res = rIdx->checkUniqueConstraint(trx, mthds, doc,
+                                             options.indexOperationMode);
+    if (res.fail()) {
+      return res;
+    }
+  }
+  return Result();
+}
+
 Result RocksDBCollection::removeDocument(
     arangodb::transaction::Methods* trx, LocalDocumentId const& documentId,
     VPackSlice const& doc, OperationOptions& options) const {
@@ -1522,6 +1875,10 @@ Result RocksDBCollection::updateDocument(
   TRI_ASSERT(trx->state()->isRunning());
   TRI_ASSERT(_objectId != 0);
 
+  if (oldDocumentId == newDocumentId) {
+    return updateDocumentInPlace(trx, oldDocumentId, oldDoc, newDoc, options);
+  }
+
   RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
 
   // We NEED to do the PUT first, otherwise WAL tailing breaks
@@ -1569,6 +1926,71 @@ Result RocksDBCollection::updateDocument(
   return res;
 }
 
+Result RocksDBCollection::updateDocumentInPlace(
+    transaction::Methods* trx, LocalDocumentId const& documentId,
+    VPackSlice const& oldDoc, VPackSlice const& newDoc,
+    OperationOptions& options) const {
+  RocksDBMethods* mthd = RocksDBTransactionState::toMethods(trx);
+
+  RocksDBKeyLeaser key(trx);
+  key->constructDocument(_objectId, documentId);
+  blackListKey(key->string().data(),
+               static_cast<uint32_t>(key->string().size()));
+
+  // disable indexing in this transaction if we are allowed to
+  IndexingDisabler disabler(mthd, trx->isSingleOperationTransaction());
+
+  // remove the old version before writing the new one under the same key.
+  // this keeps exactly one PUT per SingleDelete, and recovery counts a
+  // removal plus an insertion as for any other update. WAL tailing ignores
+  // deletions in the documents column family
+  Result res = mthd->SingleDelete(RocksDBColumnFamily::documents(), key.ref());
+  if (res.fail()) {
+    return res;
+  }
+
+  res = mthd->Put(RocksDBColumnFamily::documents(), key.ref(),
+                  rocksdb::Slice(reinterpret_cast<char const*>(newDoc.begin()),
+                                 static_cast<size_t>(newDoc.byteSize())));
+  if (res.fail()) {
+    return res;
+  }
+
+  READ_LOCKER(guard, _indexesLock);
+  for (std::shared_ptr<Index> const& idx : _indexes) {
+    RocksDBIndex* rIdx = static_cast<RocksDBIndex*>(idx.get());
+    if (!rIdx->hasChangedAttributes(oldDoc, newDoc)) {
+      // index entries only depend on the document id and the indexed
+      // attributes, so they are still valid
+      continue;
+    }
+    Result tmpres = rIdx->updateInternal(trx, mthd, documentId, oldDoc,
+                                         documentId, newDoc,
+                                         options.indexOperationMode);
+    if (tmpres.fail()) {
+      if (tmpres.is(TRI_ERROR_OUT_OF_MEMORY)) {
+        // in case of OOM return immediately
+        return tmpres;
+      }
+      res.reset(tmpres);
+    }
+  }
+
+  return res;
+}
+
+/// @brief a document can keep its id on update if all indexes identify
+/// documents only by their id, so that unchanged index entries stay valid
+bool RocksDBCollection::canUpdateInPlace() const {
+  READ_LOCKER(guard, _indexesLock);
+  for (std::shared_ptr<Index> const& idx : _indexes) {
+    if (!static_cast<RocksDBIndex*>(idx.get())->supportsInPlaceUpdates()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 arangodb::Result RocksDBCollection::lookupDocumentVPack(
     LocalDocumentId const& documentId, transaction::Methods* trx,
     arangodb::ManagedDocumentResult& mdr, bool withCache) const {
@@ -1715,6 +2137,56 @@ void RocksDBCollection::adjustNumberDocuments(TRI_voc_rid_t revId,
   }
 }
 
+void RocksDBCollection::endWrite(rocksdb::SequenceNumber seq) {
+  // publish the sequence number before the writes count as finished
+  rocksdb::SequenceNumber last = _lastWriteSeq.load();
+  while (last < seq && !_lastWriteSeq.compare_exchange_weak(last, seq)) {
+  }
+  TRI_ASSERT(_pendingWrites > 0);
+  --_pendingWrites;
+}
+
+rocksdb::SequenceNumber RocksDBCollection::keyChunksLastWrite() const {
+  if (_pendingWrites.load() != 0) {
+    return std::numeric_limits<rocksdb::SequenceNumber>::max();
+  }
+  return _lastWriteSeq.load();
+}
+
+std::shared_ptr<velocypack::Builder> RocksDBCollection::cachedKeyChunks(
+    rocksdb::Snapshot const* snapshot, uint64_t chunkSize) const {
+  // a snapshot which contains the last write sees the same documents as
+  // any other such snapshot, as long as no more writes happen
+  rocksdb::SequenceNumber const lastWrite = keyChunksLastWrite();
+  if (lastWrite > snapshot->GetSequenceNumber()) {
+    return nullptr;
+  }
+
+  MUTEX_LOCKER(guard, _keyChunksLock);
+  if (_keyChunks == nullptr || _keyChunksSize != chunkSize ||
+      _keyChunksLastWrite != lastWrite) {
+    return nullptr;
+  }
+  return _keyChunks;
+}
+
+void RocksDBCollection::cacheKeyChunks(
+    rocksdb::Snapshot const* snapshot, uint64_t chunkSize,
+    rocksdb::SequenceNumber lastWrite,
+    std::shared_ptr<velocypack::Builder> chunks) {
+  // the snapshot must contain the last write, and no writes may have
+  // happened while the chunks were computed
+  if (lastWrite > snapshot->GetSequenceNumber() ||
+      keyChunksLastWrite() != lastWrite) {
+    return;
+  }
+
+  MUTEX_LOCKER(guard, _keyChunksLock);
+  _keyChunksSize = chunkSize;
+  _keyChunksLastWrite = lastWrite;
+  _keyChunks = std::move(chunks);
+}
+
 /// load the number of docs from storage, use careful
 void RocksDBCollection::loadInitialNumberDocuments() {
   auto* engine = static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
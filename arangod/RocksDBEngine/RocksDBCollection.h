@@ -25,6 +25,7 @@
 #define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_COLLECTION_H 1
 
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "Indexes/IndexLookupContext.h"
 #include "RocksDBEngine/RocksDBCommon.h"
@@ -32,6 +33,7 @@
 #include "VocBase/LogicalCollection.h"
 
 namespace rocksdb {
+class Snapshot;
 class Transaction;
 }
 
@@ -106,6 +108,13 @@ class RocksDBCollection final : public PhysicalCollection {
   /// @brief Drop an index with the given iid.
   bool dropIndex(TRI_idx_iid_t iid) override;
   std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx) const override;
+  std::vector<std::unique_ptr<IndexIterator>> getAllIterators(
+      transaction::Methods* trx, size_t numPartitions) const override;
+  /// @brief split the documents visible with readOptions into at most
+  /// numPartitions disjoint key ranges of roughly equal size. the ranges
+  /// cover all documents of the collection
+  std::vector<RocksDBKeyBounds> partitionDocuments(
+      rocksdb::ReadOptions const& readOptions, size_t numPartitions) const;
   std::unique_ptr<IndexIterator> getAnyIterator(
       transaction::Methods* trx) const override;
 
@@ -149,6 +158,21 @@ class RocksDBCollection final : public PhysicalCollection {
       transaction::Methods* trx, LocalDocumentId const& token,
       IndexIterator::DocumentCallback const& cb) const override;
 
+  /// @brief looks up the keys in the primary index and then reads the
+  /// documents, each with a single MultiGet in key order. the callback
+  /// gets slices into the MultiGet buffers or the cache
+  Result readMany(
+      transaction::Methods* trx, std::vector<arangodb::StringRef> const& keys,
+      std::function<void(size_t, arangodb::velocypack::Slice)> const& cb,
+      bool lock) override;
+
+  /// @brief reads multiple documents with a single MultiGet, and calls the
+  /// callback for each of them in the order of documentIds. returns the
+  /// number of documents found
+  size_t readDocumentWithCallback(
+      transaction::Methods* trx, std::vector<LocalDocumentId> const& documentIds,
+      IndexIterator::DocumentCallback const& cb) const;
+
   Result insert(arangodb::transaction::Methods* trx,
                 arangodb::velocypack::Slice const newSlice,
                 arangodb::ManagedDocumentResult& result,
@@ -180,6 +204,26 @@ class RocksDBCollection final : public PhysicalCollection {
   /// load the number of docs from storage
   void loadInitialNumberDocuments();
 
+  /// documents are about to be written. key chunks for the incremental sync
+  /// are neither cached nor served from the cache until endWrite() is called
+  void beginWrite() { ++_pendingWrites; }
+  /// written documents are visible from the sequence number on
+  void endWrite(rocksdb::SequenceNumber seq);
+
+  /// key chunks for the incremental sync as computed from an earlier
+  /// snapshot, if they equal the chunks of the given snapshot because
+  /// the collection was not modified since. nullptr otherwise
+  std::shared_ptr<velocypack::Builder> cachedKeyChunks(
+      rocksdb::Snapshot const* snapshot, uint64_t chunkSize) const;
+  /// remember key chunks computed from a snapshot. lastWrite is the value
+  /// of keyChunksLastWrite() before the computation
+  void cacheKeyChunks(rocksdb::Snapshot const* snapshot, uint64_t chunkSize,
+                      rocksdb::SequenceNumber lastWrite,
+                      std::shared_ptr<velocypack::Builder> chunks);
+  /// sequence number of the last write to the collection, or UINT64_MAX if
+  /// writes are going on
+  rocksdb::SequenceNumber keyChunksLastWrite() const;
+
   uint64_t objectId() const { return _objectId; }
 
   int lockWrite(double timeout = 0.0);
@@ -231,6 +275,12 @@ class RocksDBCollection final : public PhysicalCollection {
       arangodb::transaction::Methods* trx, LocalDocumentId const& documentId,
       arangodb::velocypack::Slice const& doc, OperationOptions& options) const;
 
+  /// @brief checks the unique constraints of all indexes for a document
+  /// that is about to be inserted, without writing anything
+  arangodb::Result checkUniqueConstraints(
+      arangodb::transaction::Methods* trx,
+      arangodb::velocypack::Slice const& doc, OperationOptions& options) const;
+
   arangodb::Result removeDocument(
       arangodb::transaction::Methods* trx, LocalDocumentId const& documentId,
       arangodb::velocypack::Slice const& doc, OperationOptions& options) const;
@@ -241,6 +291,17 @@ class RocksDBCollection final : public PhysicalCollection {
       LocalDocumentId const& newDocumentId,
       arangodb::velocypack::Slice const& newDoc, OperationOptions& options) const;
 
+  /// @brief overwrite a document under its existing document id. only the
+  /// entries of indexes whose attributes have changed are rewritten
+  arangodb::Result updateDocumentInPlace(
+      transaction::Methods* trx, LocalDocumentId const& documentId,
+      arangodb::velocypack::Slice const& oldDoc,
+      arangodb::velocypack::Slice const& newDoc, OperationOptions& options) const;
+
+  /// @brief whether or not updates can keep the document id of the
+  /// previous revision
+  bool canUpdateInPlace() const;
+
   arangodb::Result lookupDocumentVPack(LocalDocumentId const& documentId,
                                        transaction::Methods*,
                                        arangodb::ManagedDocumentResult&,
@@ -269,6 +330,17 @@ class RocksDBCollection final : public PhysicalCollection {
   std::atomic<uint64_t> _numberDocuments;
   std::atomic<TRI_voc_rid_t> _revisionId;
 
+  /// number of transactions which are committing writes to the collection
+  std::atomic<uint64_t> _pendingWrites;
+  /// sequence number from which on all committed writes are visible
+  std::atomic<rocksdb::SequenceNumber> _lastWriteSeq;
+
+  /// key chunks computed by the last incremental sync from this collection
+  mutable Mutex _keyChunksLock;
+  uint64_t _keyChunksSize;
+  rocksdb::SequenceNumber _keyChunksLastWrite;
+  std::shared_ptr<velocypack::Builder> _keyChunks;
+
   /// cache the primary index for performance, do not delete
   RocksDBPrimaryIndex* _primaryIndex;
 
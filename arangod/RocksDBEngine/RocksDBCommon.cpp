@@ -33,6 +33,8 @@
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBKeyBounds.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Methods.h"
 
@@ -189,6 +191,9 @@ Result removeLargeRange(rocksdb::TransactionDB* db,
         << "RocksDB key deletion failed: " << s.ToString();
         return rocksutils::convertStatus(s);
       }
+      // get rid of the range tombstone and the data it covers, otherwise
+      // all later scans over neighboring ranges have to skip over it
+      compactRangeInBackground(bounds);
       return {};
     }
 
@@ -258,5 +263,35 @@ Result removeLargeRange(rocksdb::TransactionDB* db,
   }
 }
 
+/// @brief compact the given range on a low priority scheduler thread
+void compactRangeInBackground(RocksDBKeyBounds const& bounds) {
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr || scheduler->isStopping()) {
+    // compaction is only an optimization, rocksdb will get to the
+    // range eventually by itself
+    return;
+  }
+
+  try {
+    // bounds are copied, the object owning them may be gone by now
+    scheduler->queue(RequestPriority::LOW, [bounds]() {
+      if (SchedulerFeature::SCHEDULER->isStopping()) {
+        return;
+      }
+      rocksdb::CompactRangeOptions opts;
+      // do not hold back automatic compactions while we are running
+      opts.exclusive_manual_compaction = false;
+      rocksdb::Slice b = bounds.start(), e = bounds.end();
+      rocksdb::Status s = globalRocksDB()->CompactRange(opts, bounds.columnFamily(), &b, &e);
+      if (!s.ok()) {
+        LOG_TOPIC(DEBUG, arangodb::Logger::ENGINES)
+            << "RocksDB range compaction failed: " << s.ToString();
+      }
+    });
+  } catch (...) {
+    // ignore, see above
+  }
+}
+
 }  // namespace rocksutils
 }  // namespace arangodb
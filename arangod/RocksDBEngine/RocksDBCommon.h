@@ -90,6 +90,11 @@ Result removeLargeRange(rocksdb::TransactionDB* db,
                         bool prefixSameAsStart,
                         bool useRangeDelete);
 
+/// @brief compact the given range on a low priority scheduler thread, so
+/// that range tombstones left by removeLargeRange are purged without
+/// blocking the caller
+void compactRangeInBackground(RocksDBKeyBounds const& bounds);
+
 // optional switch to std::function to reduce amount of includes and
 // to avoid template
 // this helper is not meant for transactional usage!
@@ -26,6 +26,8 @@
 
 #include "Basics/Common.h"
 #include "Basics/Exceptions.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/StringRef.h"
@@ -34,6 +36,8 @@
 #include "Logger/Logger.h"
 #include "RocksDBEngine/RocksDBFormat.h"
 
+#include <array>
+
 #include <rocksdb/types.h>
 
 // In the following template:
@@ -137,6 +141,20 @@ class RocksDBCuckooIndexEstimator {
     void injectCounter(uint32_t* cnt) { _counter = cnt; }
   };
 
+  // number of independently locked buffers for the updates of committing
+  // transactions, so that they do not contend with each other or with
+  // lookups and serialization of the estimator
+  static constexpr size_t NumBufferStripes = 16;
+
+  struct BufferStripe {
+    arangodb::Mutex lock;
+    std::map<uint64_t, rocksdb::SequenceNumber> blockers;
+    std::set<std::pair<rocksdb::SequenceNumber, uint64_t>> blockersBySeq;
+    std::multimap<rocksdb::SequenceNumber, std::vector<Key>> insertBuffers;
+    std::multimap<rocksdb::SequenceNumber, std::vector<Key>> removalBuffers;
+    std::set<rocksdb::SequenceNumber> truncateBuffer;
+  };
+
   enum SerializeFormat : char {
     // To describe this format we use | as a seperator for readability, but it
     // is NOT a printed character in the serialized string
@@ -259,54 +277,68 @@ class RocksDBCuckooIndexEstimator {
     // must apply updates first to be valid
     applyUpdates(outputSeq);
 
+    // copy the filter state under the lock, and encode it afterwards.
+    // lookups and estimates are only blocked for the time of the copy
+    uint64_t size, nrUsed, nrCuckood, nrTotal, niceSize, logSize;
+    std::string slots;
+    std::string counters;
     {
       // Sorry we need a consistent state, so we have to read-lock
       READ_LOCKER(locker, _lock);
 
-      // type
-      serialized += SerializeFormat::NOCOMPRESSION;
-
-      // length
-      uint64_t serialLength =
-          (sizeof(SerializeFormat) + sizeof(uint64_t) + sizeof(_size) +
-           sizeof(_nrUsed) + sizeof(_nrCuckood) + sizeof(_nrTotal) +
-           sizeof(_niceSize) + sizeof(_logSize) +
-           (_size * _slotSize * SlotsPerBucket)) +
-          (_size * _counterSize * SlotsPerBucket);
-
-      serialized.reserve(sizeof(uint64_t) + serialLength);
-      // We always prepend the length, so parsing is easier
-      rocksutils::uint64ToPersistent(serialized, serialLength);
-
-      // Add all member variables
-      rocksutils::uint64ToPersistent(serialized, _size);
-      rocksutils::uint64ToPersistent(serialized, _nrUsed);
-      rocksutils::uint64ToPersistent(serialized, _nrCuckood);
-      rocksutils::uint64ToPersistent(serialized, _nrTotal);
-      rocksutils::uint64ToPersistent(serialized, _niceSize);
-      rocksutils::uint64ToPersistent(serialized, _logSize);
-
-      // Add the data blob
-      // Size is as follows: nrOfBuckets * SlotsPerBucket * SlotSize
-      TRI_ASSERT((_size * _slotSize * SlotsPerBucket) <= _slotAllocSize);
-
-      for (uint64_t i = 0; i < (_size * _slotSize * SlotsPerBucket);
-           i += _slotSize) {
-        rocksutils::uint16ToPersistent(
-            serialized, *(reinterpret_cast<uint16_t*>(_base + i)));
-      }
+      size = _size;
+      nrUsed = _nrUsed;
+      nrCuckood = _nrCuckood;
+      nrTotal = _nrTotal;
+      niceSize = _niceSize;
+      logSize = _logSize;
 
+      TRI_ASSERT((_size * _slotSize * SlotsPerBucket) <= _slotAllocSize);
+      slots.assign(_base, _size * _slotSize * SlotsPerBucket);
       TRI_ASSERT((_size * _counterSize * SlotsPerBucket) <= _counterAllocSize);
+      counters.assign(_counters, _size * _counterSize * SlotsPerBucket);
+    }
 
-      for (uint64_t i = 0; i < (_size * _counterSize * SlotsPerBucket);
-           i += _counterSize) {
-        rocksutils::uint32ToPersistent(
-            serialized, *(reinterpret_cast<uint32_t*>(_counters + i)));
-      }
+    // type
+    serialized += SerializeFormat::NOCOMPRESSION;
+
+    // length
+    uint64_t serialLength =
+        (sizeof(SerializeFormat) + sizeof(uint64_t) + sizeof(_size) +
+         sizeof(_nrUsed) + sizeof(_nrCuckood) + sizeof(_nrTotal) +
+         sizeof(_niceSize) + sizeof(_logSize) + slots.size()) +
+        counters.size();
+
+    serialized.reserve(sizeof(uint64_t) + serialLength);
+    // We always prepend the length, so parsing is easier
+    rocksutils::uint64ToPersistent(serialized, serialLength);
+
+    // Add all member variables
+    rocksutils::uint64ToPersistent(serialized, size);
+    rocksutils::uint64ToPersistent(serialized, nrUsed);
+    rocksutils::uint64ToPersistent(serialized, nrCuckood);
+    rocksutils::uint64ToPersistent(serialized, nrTotal);
+    rocksutils::uint64ToPersistent(serialized, niceSize);
+    rocksutils::uint64ToPersistent(serialized, logSize);
+
+    // Add the data blob
+    // Size is as follows: nrOfBuckets * SlotsPerBucket * SlotSize
+    for (size_t i = 0; i < slots.size(); i += _slotSize) {
+      uint16_t value;
+      memcpy(&value, slots.data() + i, sizeof(value));
+      rocksutils::uint16ToPersistent(serialized, value);
+    }
 
-      bool havePendingUpdates = !_blockers.empty() || !_insertBuffers.empty() ||
-                                !_removalBuffers.empty() || !_truncateBuffer.empty();
-      _needToPersist.store(havePendingUpdates);
+    for (size_t i = 0; i < counters.size(); i += _counterSize) {
+      uint32_t value;
+      memcpy(&value, counters.data() + i, sizeof(value));
+      rocksutils::uint32ToPersistent(serialized, value);
+    }
+
+    // reset first, so that updates buffered concurrently are not lost
+    _needToPersist.store(false);
+    if (havePendingUpdates()) {
+      _needToPersist.store(true);
     }
 
     {
@@ -340,8 +372,9 @@ class RocksDBCuckooIndexEstimator {
   
   Result bufferTruncate(rocksdb::SequenceNumber seq) {
     Result res = basics::catchVoidToResult([&]() -> void {
-      WRITE_LOCKER(locker, _lock);
-      _truncateBuffer.emplace(seq);
+      BufferStripe& stripe = stripeFor(seq);
+      MUTEX_LOCKER(locker, stripe.lock);
+      stripe.truncateBuffer.emplace(seq);
       _needToPersist.store(true);
     });
     return res;
@@ -391,32 +424,8 @@ class RocksDBCuckooIndexEstimator {
     // simply be expunged. If something is expunged, the function will return
     // false, otherwise true.
 
-    uint64_t hash1 = _hasherKey(k);
-    uint64_t pos1 = hashToPos(hash1);
-    uint16_t fingerprint = keyToFingerprint(k);
-    // We compute the second hash already here to let it survive a
-    // mispredicted
-    // branch in the first loop:
-    uint64_t hash2 = _hasherPosFingerprint(pos1, fingerprint);
-    uint64_t pos2 = hashToPos(hash2);
-
-    {
-      WRITE_LOCKER(guard, _lock);
-      Slot slot = findSlotCuckoo(pos1, pos2, fingerprint);
-      if (slot.isEmpty()) {
-        // Free slot insert ourself.
-        slot.init(fingerprint);
-        ++_nrUsed;
-        TRI_ASSERT(_nrUsed > 0);
-      } else {
-        TRI_ASSERT(slot.isEqual(fingerprint));
-        slot.increase();
-      }
-      ++_nrTotal;
-      _needToPersist.store(true);
-    }
-
-    return true;
+    WRITE_LOCKER(guard, _lock);
+    return insertNoLock(k);
   }
 
   /// @brief only call directly during startup/recovery; otherwise buffer
@@ -425,39 +434,8 @@ class RocksDBCuckooIndexEstimator {
     // a key was removed and false otherwise.
     // look up a key, return either false if no pair with key k is
     // found or true.
-    uint64_t hash1 = _hasherKey(k);
-    uint64_t pos1 = hashToPos(hash1);
-    uint16_t fingerprint = keyToFingerprint(k);
-    // We compute the second hash already here to allow the result to
-    // survive a mispredicted branch in the first loop. Is this sensible?
-    uint64_t hash2 = _hasherPosFingerprint(pos1, fingerprint);
-    uint64_t pos2 = hashToPos(hash2);
-
-    bool found = false;
-    {
-      WRITE_LOCKER(guard, _lock);
-      Slot slot = findSlotNoCuckoo(pos1, pos2, fingerprint, found);
-      if (found) {
-        // only decrease the total if we actually found it
-        --_nrTotal;
-        if (!slot.decrease()) {
-          // Removed last element. Have to remove
-          slot.reset();
-          --_nrUsed;
-        }
-        _needToPersist.store(true);
-        return true;
-      }
-      // If we get here we assume that the element was once inserted, but
-      // removed by cuckoo
-      // Reduce nrCuckood;
-      if (_nrCuckood > 0) {
-        // not included in _nrTotal, just decrease here
-        --_nrCuckood;
-      }
-      _needToPersist.store(true);
-    }
-    return false;
+    WRITE_LOCKER(guard, _lock);
+    return removeNoLock(k);
   }
 
   uint64_t capacity() const { return _size * SlotsPerBucket; }
@@ -472,7 +450,6 @@ class RocksDBCuckooIndexEstimator {
   uint64_t nrCuckood() const { return _nrCuckood; }
 
   bool needToPersist() const {
-    READ_LOCKER(locker, _lock);
     return _needToPersist.load();
   }
 
@@ -489,13 +466,13 @@ class RocksDBCuckooIndexEstimator {
    */
   Result placeBlocker(uint64_t trxId, rocksdb::SequenceNumber seq) {
     Result res = basics::catchToResult([&]() -> Result {
-      TRI_ASSERT(_blockers.end() == _blockers.find(trxId));
-      TRI_ASSERT(_blockersBySeq.end() ==
-                 _blockersBySeq.find(std::make_pair(seq, trxId)));
-      Result res;
-      WRITE_LOCKER(locker, _lock);
-      auto insert = _blockers.emplace(trxId, seq);
-      auto crosslist = _blockersBySeq.emplace(seq, trxId);
+      BufferStripe& stripe = stripeFor(trxId);
+      MUTEX_LOCKER(locker, stripe.lock);
+      TRI_ASSERT(stripe.blockers.end() == stripe.blockers.find(trxId));
+      TRI_ASSERT(stripe.blockersBySeq.end() ==
+                 stripe.blockersBySeq.find(std::make_pair(seq, trxId)));
+      auto insert = stripe.blockers.emplace(trxId, seq);
+      auto crosslist = stripe.blockersBySeq.emplace(seq, trxId);
       if (!insert.second || !crosslist.second) {
         return {TRI_ERROR_INTERNAL};
       }
@@ -516,15 +493,16 @@ class RocksDBCuckooIndexEstimator {
    *              earlier `placeBlocker` call)
    */
   void removeBlocker(uint64_t trxId) {
-    WRITE_LOCKER(locker, _lock);
-    auto it = _blockers.find(trxId);
-    if (ADB_LIKELY(_blockers.end() != it)) {
-      auto cross = _blockersBySeq.find(std::make_pair(it->second, it->first));
-      TRI_ASSERT(_blockersBySeq.end() != cross);
-      if (ADB_LIKELY(_blockersBySeq.end() != cross)) {
-        _blockersBySeq.erase(cross);
+    BufferStripe& stripe = stripeFor(trxId);
+    MUTEX_LOCKER(locker, stripe.lock);
+    auto it = stripe.blockers.find(trxId);
+    if (ADB_LIKELY(stripe.blockers.end() != it)) {
+      auto cross = stripe.blockersBySeq.find(std::make_pair(it->second, it->first));
+      TRI_ASSERT(stripe.blockersBySeq.end() != cross);
+      if (ADB_LIKELY(stripe.blockersBySeq.end() != cross)) {
+        stripe.blockersBySeq.erase(cross);
       }
-      _blockers.erase(it);
+      stripe.blockers.erase(it);
     }
   }
 
@@ -533,7 +511,8 @@ class RocksDBCuckooIndexEstimator {
    *
    * Buffers updates associated with a given commit seq/tick. Will hold updates
    * until all previous blockers have been removed to ensure a consistent state
-   * for sync/recovery and avoid any missed updates.
+   * for sync/recovery and avoid any missed updates. Concurrent transactions
+   * buffer into different stripes, and only the sync thread merges them.
    *
    * @param  seq      The seq/tick post-commit, prior to call
    * @param  inserts  Vector of hashes to insert
@@ -543,14 +522,15 @@ class RocksDBCuckooIndexEstimator {
   Result bufferUpdates(rocksdb::SequenceNumber seq, std::vector<Key>&& inserts,
                        std::vector<Key>&& removals) {
     Result res = basics::catchVoidToResult([&]() -> void {
-      WRITE_LOCKER(locker, _lock);
+      BufferStripe& stripe = stripeFor(seq);
+      MUTEX_LOCKER(locker, stripe.lock);
       bool foundSomething = false;
       if (!inserts.empty()) {
-        _insertBuffers.emplace(seq, std::move(inserts));
+        stripe.insertBuffers.emplace(seq, std::move(inserts));
         foundSomething = true;
       }
       if (!removals.empty()) {
-        _removalBuffers.emplace(seq, std::move(removals));
+        stripe.removalBuffers.emplace(seq, std::move(removals));
         foundSomething = true;
       }
       if (foundSomething) {
@@ -578,94 +558,166 @@ class RocksDBCuckooIndexEstimator {
   /// @brief call with output from committableSeq(current), and before serialize
   Result applyUpdates(rocksdb::SequenceNumber commitSeq) {
     Result res = basics::catchVoidToResult([&]() -> void {
-      std::vector<Key> inserts;
-      std::vector<Key> removals;
-
+      // (seq, is removal) => buffered keys
+      typedef std::pair<std::pair<rocksdb::SequenceNumber, bool>,
+                        std::vector<Key>> BufferedUpdate;
+      std::vector<BufferedUpdate> updates;
       // truncate will increase this sequence
       rocksdb::SequenceNumber ignoreSeq = 0;
-      while (true) {
-        bool foundTruncate = false;
-        // find out if we have buffers to apply
-        {
-          WRITE_LOCKER(locker, _lock);
-
-          // check for a truncate marker
-          auto it = _truncateBuffer.begin(); // sorted ASC
-          while (it != _truncateBuffer.end() && *it <= commitSeq) {
-            ignoreSeq = *it;
-            TRI_ASSERT(ignoreSeq != 0);
-            foundTruncate = true;
-            it = _truncateBuffer.erase(it);
-          }
-            
-          // check for inserts
-          if (!_insertBuffers.empty()) {
-            auto it = _insertBuffers.begin(); // sorted ASC
-            if (it->first <= commitSeq) {
-              if (it->first >= ignoreSeq) {
-                inserts = std::move(it->second);
-                TRI_ASSERT(!inserts.empty());
-              }
-              _insertBuffers.erase(it);
-            }
-          }
+      bool foundTruncate = false;
+
+      // take all buffers up to commitSeq out of the stripes
+      for (BufferStripe& stripe : _stripes) {
+        MUTEX_LOCKER(locker, stripe.lock);
+
+        auto it = stripe.truncateBuffer.begin(); // sorted ASC
+        while (it != stripe.truncateBuffer.end() && *it <= commitSeq) {
+          TRI_ASSERT(*it != 0);
+          ignoreSeq = std::max(ignoreSeq, *it);
+          foundTruncate = true;
+          it = stripe.truncateBuffer.erase(it);
+        }
 
-          // check for removals
-          if (!_removalBuffers.empty()) {
-            auto it = _removalBuffers.begin(); // sorted ASC
-            if (it->first <= commitSeq) {
-              if (it->first >= ignoreSeq) {
-                removals = std::move(it->second);
-                TRI_ASSERT(!removals.empty());
-              }
-              _removalBuffers.erase(it);
-            }
+        auto moveBuffers = [&](std::multimap<rocksdb::SequenceNumber, std::vector<Key>>& buffers,
+                               bool isRemoval) {
+          auto it = buffers.begin(); // sorted ASC
+          while (it != buffers.end() && it->first <= commitSeq) {
+            TRI_ASSERT(!it->second.empty());
+            updates.emplace_back(std::make_pair(it->first, isRemoval),
+                                 std::move(it->second));
+            it = buffers.erase(it);
           }
-        }
-        
-        if (foundTruncate) {
-          clear(); // clear estimates
-        }
+        };
+        moveBuffers(stripe.insertBuffers, false);
+        moveBuffers(stripe.removalBuffers, true);
+      }
+
+      if (foundTruncate) {
+        clear(); // clear estimates
+      }
+
+      // apply in commit order, inserts before removals of the same commit
+      std::sort(updates.begin(), updates.end(),
+                [](BufferedUpdate const& lhs, BufferedUpdate const& rhs) {
+                  return lhs.first < rhs.first;
+                });
 
-        // no inserts or removals left to apply, drop out of loop
-        if (inserts.empty() && removals.empty()) {
-          break;
+      for (auto const& update : updates) {
+        if (update.first.first < ignoreSeq) {
+          // superseded by a truncate
+          continue;
         }
-        
-        if (!inserts.empty()) {
-          // apply inserts
-          for (auto const& key : inserts) {
-            insert(key);
+        // one lock acquisition per buffered commit instead of per key
+        WRITE_LOCKER(locker, _lock);
+        if (update.first.second) {
+          for (auto const& key : update.second) {
+            removeNoLock(key);
           }
-          inserts.clear();
-        }
-
-        if (!removals.empty()) {
-          // apply removals
-          for (auto const& key : removals) {
-            remove(key);
+        } else {
+          for (auto const& key : update.second) {
+            insertNoLock(key);
           }
-          removals.clear();
         }
-      } // </while(true)>
+      }
     });
     return res;
   }
 
   /// @brief updates and returns the largest safe seq to consider committed
   rocksdb::SequenceNumber committableSeq(rocksdb::SequenceNumber current) {
-    WRITE_LOCKER(locker, _lock);
     auto minSeq = current;
 
     // if we have a blocker with a lower value than current, compare it
-    if (!_blockersBySeq.empty()) {
-      auto it = _blockersBySeq.begin();
-      minSeq = std::min(minSeq, it->first);
+    for (BufferStripe& stripe : _stripes) {
+      MUTEX_LOCKER(locker, stripe.lock);
+      if (!stripe.blockersBySeq.empty()) {
+        auto it = stripe.blockersBySeq.begin();
+        minSeq = std::min(minSeq, it->first);
+      }
     }
 
     return minSeq;
   }
 
+  /// @brief whether or not any transaction is still running or any update
+  /// has not yet been applied
+  bool havePendingUpdates() {
+    for (BufferStripe& stripe : _stripes) {
+      MUTEX_LOCKER(locker, stripe.lock);
+      if (!stripe.blockers.empty() || !stripe.insertBuffers.empty() ||
+          !stripe.removalBuffers.empty() || !stripe.truncateBuffer.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief buffers of concurrent transactions are spread over the stripes
+  /// by transaction id or commit sequence number
+  BufferStripe& stripeFor(uint64_t value) {
+    return _stripes[fasthash64_uint64(value, 0xdeadbeefdeadbeefULL) % NumBufferStripes];
+  }
+
+  /// @brief insert the key k. must hold the write lock
+  bool insertNoLock(Key const& k) {
+    uint64_t hash1 = _hasherKey(k);
+    uint64_t pos1 = hashToPos(hash1);
+    uint16_t fingerprint = keyToFingerprint(k);
+    // We compute the second hash already here to let it survive a
+    // mispredicted
+    // branch in the first loop:
+    uint64_t hash2 = _hasherPosFingerprint(pos1, fingerprint);
+    uint64_t pos2 = hashToPos(hash2);
+
+    Slot slot = findSlotCuckoo(pos1, pos2, fingerprint);
+    if (slot.isEmpty()) {
+      // Free slot insert ourself.
+      slot.init(fingerprint);
+      ++_nrUsed;
+      TRI_ASSERT(_nrUsed > 0);
+    } else {
+      TRI_ASSERT(slot.isEqual(fingerprint));
+      slot.increase();
+    }
+    ++_nrTotal;
+    _needToPersist.store(true);
+
+    return true;
+  }
+
+  /// @brief remove one element with key k. must hold the write lock
+  bool removeNoLock(Key const& k) {
+    uint64_t hash1 = _hasherKey(k);
+    uint64_t pos1 = hashToPos(hash1);
+    uint16_t fingerprint = keyToFingerprint(k);
+    // We compute the second hash already here to allow the result to
+    // survive a mispredicted branch in the first loop. Is this sensible?
+    uint64_t hash2 = _hasherPosFingerprint(pos1, fingerprint);
+    uint64_t pos2 = hashToPos(hash2);
+
+    bool found = false;
+    Slot slot = findSlotNoCuckoo(pos1, pos2, fingerprint, found);
+    _needToPersist.store(true);
+    if (found) {
+      // only decrease the total if we actually found it
+      --_nrTotal;
+      if (!slot.decrease()) {
+        // Removed last element. Have to remove
+        slot.reset();
+        --_nrUsed;
+      }
+      return true;
+    }
+    // If we get here we assume that the element was once inserted, but
+    // removed by cuckoo
+    // Reduce nrCuckood;
+    if (_nrCuckood > 0) {
+      // not included in _nrTotal, just decrease here
+      --_nrCuckood;
+    }
+    return false;
+  }
+
   uint64_t memoryUsage() const {
     return sizeof(RocksDBCuckooIndexEstimator) + _slotAllocSize +
            _counterAllocSize;
@@ -999,11 +1051,7 @@ class RocksDBCuckooIndexEstimator {
   rocksdb::SequenceNumber mutable _committedSeq;
   std::atomic<bool> _needToPersist;
 
-  std::map<uint64_t, rocksdb::SequenceNumber> _blockers;
-  std::set<std::pair<rocksdb::SequenceNumber, uint64_t>> _blockersBySeq;
-  std::map<rocksdb::SequenceNumber, std::vector<Key>> _insertBuffers;
-  std::map<rocksdb::SequenceNumber, std::vector<Key>> _removalBuffers;
-  std::set<rocksdb::SequenceNumber> _truncateBuffer;
+  std::array<BufferStripe, NumBufferStripes> _stripes;
 
   HashKey _hasherKey;        // Instance to compute the first hash function
   Fingerprint _fingerprint;  // Instance to compute a fingerprint of a key
@@ -458,9 +458,11 @@ void RocksDBEdgeIndexIterator::lookupInRocksDB(StringRef fromTo) {
   rocksdb::Comparator const* cmp = _index->comparator();
 
   cache::Cache* cc = _cache.get();
+  uint64_t numEdges = 0;
   _builder.openArray(true);
   auto end = _bounds.end();
   while (_iterator->Valid() && (cmp->Compare(_iterator->key(), end) < 0)) {
+    ++numEdges;
     LocalDocumentId const documentId = RocksDBKey::indexDocumentId(
         RocksDBEntryType::EdgeIndexValue, _iterator->key());
 
@@ -473,7 +475,8 @@ void RocksDBEdgeIndexIterator::lookupInRocksDB(StringRef fromTo) {
     _iterator->Next();
   }
   _builder.close();
-  if (cc != nullptr) {
+  if (cc != nullptr &&
+      (_index->_cacheMaxEdges == 0 || numEdges <= _index->_cacheMaxEdges)) {
     // TODO Add cache retry on next call
     // Now we have something in _inplaceMemory.
     // It may be an empty array or a filled one, never mind, we cache both
@@ -527,6 +530,9 @@ RocksDBEdgeIndex::RocksDBEdgeIndex(
                    !ServerState::instance()->isCoordinator() /*useCache*/),
       _directionAttr(attr),
       _isFromIndex(attr == StaticStrings::FromString),
+      _cacheMaxEdges(ServerState::instance()->isCoordinator()
+                         ? 0
+                         : rocksutils::globalRocksEngine()->edgeCacheMaxEdges()),
       _estimator(nullptr) {
   TRI_ASSERT(_cf == RocksDBColumnFamily::edge());
 
@@ -573,6 +579,14 @@ void RocksDBEdgeIndex::toVelocyPack(VPackBuilder& builder,
   builder.close();
 }
 
+bool RocksDBEdgeIndex::hasChangedAttributes(VPackSlice const& oldDoc,
+                                            VPackSlice const& newDoc) const {
+  return StringRef(transaction::helpers::extractFromFromDocument(oldDoc)) !=
+             StringRef(transaction::helpers::extractFromFromDocument(newDoc)) ||
+         StringRef(transaction::helpers::extractToFromDocument(oldDoc)) !=
+             StringRef(transaction::helpers::extractToFromDocument(newDoc));
+}
+
 Result RocksDBEdgeIndex::insertInternal(transaction::Methods* trx,
                                         RocksDBMethods* mthd,
                                         LocalDocumentId const& documentId,
@@ -851,7 +865,6 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
                                       rocksdb::Slice const& lower,
                                       rocksdb::Slice const& upper) {
   auto scheduler = SchedulerFeature::SCHEDULER;
-  auto rocksColl = toRocksDBCollection(_collection);
   bool needsInsert = false;
   std::string previous = "";
   VPackBuilder builder;
@@ -869,6 +882,7 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
       rocksutils::globalRocksDB()->NewIterator(options, _cf));
 
   size_t n = 0;
+  uint64_t numEdges = 0;
   cache::Cache* cc = _cache.get();
   for (it->Seek(lower); it->Valid(); it->Next()) {
     if (scheduler->isStopping()) {
@@ -898,14 +912,16 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
     }
 
     if (v != previous) {
+      numEdges = 0;
       if (needsInsert) {
         // Switch to next vertex id.
         // Store what we have.
         builder.close();
 
-        while (cc->isBusy()) {
+        while (cc->isResizing()) {
           // We should wait here, the cache will reject
-          // any inserts anyways.
+          // any inserts anyways. A migration does not
+          // block inserts, so there is no need to wait for it.
           std::this_thread::sleep_for(std::chrono::microseconds(10000));
         }
 
@@ -941,22 +957,19 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
         builder.openArray(true);
       }
     }
+    if (needsInsert && _cacheMaxEdges > 0 && ++numEdges > _cacheMaxEdges) {
+      // too many edges, this vertex is not cached
+      needsInsert = false;
+      builder.clear();
+    }
     if (needsInsert) {
+      // the index value contains the opposite vertex, so there is no need
+      // to read the edge document
       LocalDocumentId const docId = RocksDBKey::indexDocumentId(RocksDBEntryType::EdgeIndexValue, key);
-      if (!rocksColl->readDocumentWithCallback(trx, docId, [&](LocalDocumentId const&, VPackSlice doc) {
-        builder.add(VPackValue(docId.id()));
-        VPackSlice toFrom =
-            _isFromIndex ? transaction::helpers::extractToFromDocument(doc)
-                         : transaction::helpers::extractFromFromDocument(doc);
-        TRI_ASSERT(toFrom.isString());
-        builder.add(toFrom);
-      })) {
-#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
-        // Data Inconsistency.
-        // We have a revision id without a document...
-        TRI_ASSERT(false);
-#endif
-      }
+      builder.add(VPackValue(docId.id()));
+      StringRef toFrom = RocksDBValue::vertexId(it->value());
+      builder.add(VPackValuePair(toFrom.data(), toFrom.size(),
+                                 VPackValueType::String));
     }
   }
 
@@ -988,6 +1001,28 @@ void RocksDBEdgeIndex::warmupInternal(transaction::Methods* trx,
   LOG_TOPIC(DEBUG, Logger::ENGINES) << "loaded n: " << n ;
 }
 
+void RocksDBEdgeIndex::warmupHotSet(transaction::Methods* trx,
+                                    std::vector<std::string> const& keys) {
+  if (!useCache() || keys.empty()) {
+    return;
+  }
+
+  // the cache keys are the vertex ids. looking them up with an iterator
+  // loads their edges into the cache
+  transaction::BuilderLeaser builder(trx);
+  std::unique_ptr<VPackBuilder> lookup(builder.steal());
+  lookup->openArray();
+  for (auto const& key : keys) {
+    lookup->add(VPackValuePair(key.data(), key.size(), VPackValueType::String));
+  }
+  lookup->close();
+
+  RocksDBEdgeIndexIterator it(&_collection, trx, this, std::move(lookup),
+                              _cache);
+  while (it.next([](LocalDocumentId const&) {}, 1000)) {
+  }
+}
+
 // ===================== Helpers ==================
 
 /// @brief create the iterator
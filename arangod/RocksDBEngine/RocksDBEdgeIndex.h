@@ -171,6 +171,9 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
   void warmup(arangodb::transaction::Methods* trx,
               std::shared_ptr<basics::LocalTaskQueue> queue) override;
 
+  void warmupHotSet(transaction::Methods* trx,
+                    std::vector<std::string> const& keys) override;
+
   rocksdb::SequenceNumber serializeEstimate(
       std::string& output, rocksdb::SequenceNumber seq) const override;
 
@@ -189,6 +192,11 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
                         arangodb::velocypack::Slice const&,
                         OperationMode mode) override;
 
+  /// @brief the stored value contains the opposite vertex, so both _from
+  /// and _to have to be compared
+  bool hasChangedAttributes(arangodb::velocypack::Slice const& oldDoc,
+                            arangodb::velocypack::Slice const& newDoc) const override;
+
  private:
   /// @brief create the iterator
   IndexIterator* createEqIterator(transaction::Methods*,
@@ -210,6 +218,8 @@ class RocksDBEdgeIndex final : public RocksDBIndex {
 
   std::string const _directionAttr;
   bool const _isFromIndex;
+  /// @brief vertices with more edges are not cached (0 = unlimited)
+  uint64_t const _cacheMaxEdges;
 
   /// @brief A fixed size library to estimate the selectivity of the index.
   /// On insertion of a document we have to insert it into the estimator,
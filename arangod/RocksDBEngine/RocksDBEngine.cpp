@@ -43,18 +43,22 @@
 #include "ProgramOptions/Section.h"
 #include "Rest/Version.h"
 #include "RestHandler/RestHandlerCreator.h"
+#include "RestServer/DatabaseFeature.h"
 #include "RestServer/DatabasePathFeature.h"
+#include "RestServer/FlushFeature.h"
 #include "RestServer/ServerIdFeature.h"
 #include "RocksDBEngine/RocksDBBackgroundThread.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBHotBackup.h"
 #include "RocksDBEngine/RocksDBIncrementalSync.h"
 #include "RocksDBEngine/RocksDBIndex.h"
 #include "RocksDBEngine/RocksDBIndexFactory.h"
 #include "RocksDBEngine/RocksDBKey.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
+#include "RocksDBEngine/RocksDBObjectStatistics.h"
 #include "RocksDBEngine/RocksDBOptimizerRules.h"
 #include "RocksDBEngine/RocksDBPrefixExtractor.h"
 #include "RocksDBEngine/RocksDBRecoveryManager.h"
@@ -63,6 +67,7 @@
 #include "RocksDBEngine/RocksDBRestHandlers.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBSyncThread.h"
+#include "RocksDBEngine/RocksDBTtlThread.h"
 #include "RocksDBEngine/RocksDBThrottle.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "RocksDBEngine/RocksDBTransactionContextData.h"
@@ -73,9 +78,13 @@
 #include "RocksDBEngine/RocksDBV8Functions.h"
 #include "RocksDBEngine/RocksDBValue.h"
 #include "RocksDBEngine/RocksDBWalAccess.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Transaction/Context.h"
 #include "Transaction/Options.h"
 #include "Transaction/StandaloneContext.h"
+#include "Utils/DatabaseGuard.h"
+#include "Utils/SingleCollectionTransaction.h"
 #include "VocBase/ticks.h"
 #include "VocBase/LogicalView.h"
 
@@ -146,6 +155,7 @@ RocksDBEngine::RocksDBEngine(application_features::ApplicationServer& server)
           transaction::Options::defaultIntermediateCommitCount),
       _pruneWaitTime(10.0),
       _pruneWaitTimeInitial(180.0),
+      _settingsSyncInterval(2.5),
       _releasedTick(0),
 #ifdef _WIN32
       // background syncing is not supported on Windows
@@ -153,7 +163,11 @@ RocksDBEngine::RocksDBEngine(application_features::ApplicationServer& server)
 #else
       _syncInterval(100),
 #endif
+      _ttlFrequency(30.0),
+      _ttlBatchSize(1000),
+      _objectStatisticsInterval(1000),
       _useThrottle(true),
+      _edgeCacheMaxEdges(0),
       _debugLogging(false) {
 
   startsAfter("BasicsPhase");
@@ -252,10 +266,33 @@ void RocksDBEngine::collectOptions(
                            "initial timeout after which unused WAL files deletion kicks in after server start",
                            new DoubleParameter(&_pruneWaitTimeInitial));
 
+  options->addOption("--rocksdb.settings-sync-interval",
+                     "interval for syncing the document counts, index estimates and key generators (in seconds). "
+                     "lower values shorten the WAL replay after a crash",
+                     new DoubleParameter(&_settingsSyncInterval));
+
+  options->addOption("--rocksdb.ttl-frequency",
+                     "interval for removing the expired documents of TTL indexes (in seconds, 0 = off)",
+                     new DoubleParameter(&_ttlFrequency));
+
+  options->addOption("--rocksdb.ttl-batch-size",
+                     "maximum number of expired documents removed in a single transaction",
+                     new UInt64Parameter(&_ttlBatchSize));
+
+  options->addOption("--rocksdb.object-statistics-interval",
+                     "sample every n-th read operation for the per-collection and "
+                     "per-index read statistics (0 = off)",
+                     new UInt64Parameter(&_objectStatisticsInterval));
+
   options->addOption("--rocksdb.throttle",
                      "enable write-throttling",
                      new BooleanParameter(&_useThrottle));
 
+  options->addOption("--rocksdb.edge-cache-max-edges",
+                     "maximum number of edges of a vertex stored in the edge index cache. "
+                     "vertices with more edges are always looked up in rocksdb (0 = unlimited)",
+                     new UInt64Parameter(&_edgeCacheMaxEdges));
+
   options->addHiddenOption("--rocksdb.debug-logging",
                            "true to enable rocksdb debug logging",
                            new BooleanParameter(&_debugLogging));
@@ -290,6 +327,20 @@ void RocksDBEngine::validateOptions(
   }
 #endif
   
+  if (_settingsSyncInterval <= 0.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::CONFIG)
+        << "invalid value for --rocksdb.settings-sync-interval. Please use a "
+        << "value greater than 0";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_ttlFrequency < 0.0 || _ttlBatchSize == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::CONFIG)
+        << "invalid value for --rocksdb.ttl-frequency or --rocksdb.ttl-batch-size. "
+        << "Please use a non-negative frequency and a batch size greater than 0";
+    FATAL_ERROR_EXIT();
+  }
+
   if (_pruneWaitTimeInitial < 10) {
     LOG_TOPIC(WARN, arangodb::Logger::ENGINES)
     << "consider increasing the value for --rocksdb.wal-file-timeout-initial. "
@@ -343,6 +394,16 @@ void RocksDBEngine::start() {
     }
   }
 
+  // a requested restore of a hot backup replaces the RocksDB directory
+  // before it is opened
+  _hotBackup.reset(new RocksDBHotBackup(_basePath, _path));
+  _hotBackup->restoreIfRequested();
+
+  // remove leftovers of index builds and bulk loads that were interrupted
+  if (basics::FileUtils::isDirectory(ingestPath())) {
+    TRI_RemoveDirectory(ingestPath().c_str());
+  }
+
   // options imported set by RocksDBOptionFeature
   auto const* opts =
   ApplicationServer::getFeature<arangodb::RocksDBOptionFeature>(
@@ -467,14 +528,34 @@ void RocksDBEngine::start() {
   rocksdb::BlockBasedTableOptions tableOptions;
   if (opts->_blockCacheSize > 0) {
     tableOptions.block_cache = rocksdb::NewLRUCache(
-        opts->_blockCacheSize, static_cast<int>(opts->_blockCacheShardBits));
-    // tableOptions.cache_index_and_filter_blocks =
-    // opts->_compactionReadaheadSize > 0;
+        opts->_blockCacheSize, static_cast<int>(opts->_blockCacheShardBits),
+        false, opts->_blockCacheHighPriorityRatio);
+    // index and filter blocks of L0 files are accessed all the time, so
+    // they are pinned. all others compete with the data blocks, but are
+    // evicted last
+    tableOptions.cache_index_and_filter_blocks =
+        opts->_cacheIndexAndFilterBlocks;
+    tableOptions.cache_index_and_filter_blocks_with_high_priority =
+        opts->_cacheIndexAndFilterBlocks;
+    tableOptions.pin_l0_filter_and_index_blocks_in_cache =
+        opts->_cacheIndexAndFilterBlocks;
   } else {
     tableOptions.no_block_cache = true;
   }
   tableOptions.block_size = opts->_tableBlockSize;
-  tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, true));
+  if (opts->_partitionIndexAndFilters) {
+    // two-level index and filters, of which only the top level is pinned
+    tableOptions.index_type =
+        rocksdb::BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
+    tableOptions.partition_filters = true;
+    tableOptions.pin_top_level_index_and_filter = true;
+  }
+  if (opts->_bloomFilterBitsPerKey > 0) {
+    // partitioned filters can only be built from full filters
+    tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(
+        static_cast<int>(opts->_bloomFilterBitsPerKey),
+        !opts->_partitionIndexAndFilters));
+  }
   // use slightly space-optimized format version 3
   tableOptions.format_version = 3;
   tableOptions.block_align = opts->_blockAlignDataBlocks;
@@ -517,12 +598,56 @@ void RocksDBEngine::start() {
   fixedPrefCF.prefix_extractor = std::shared_ptr<rocksdb::SliceTransform const>(
       rocksdb::NewFixedPrefixTransform(RocksDBKey::objectIdSize()));
 
+  // documents get their own table and compaction settings, as their
+  // workload can differ a lot from the one of the indexes
+  rocksdb::ColumnFamilyOptions documentsCF(fixedPrefCF);
+  rocksdb::BlockBasedTableOptions documentsTableOptions(tableOptions);
+  documentsTableOptions.block_size = opts->_documentsTableBlockSize;
+  documentsCF.table_factory = std::shared_ptr<rocksdb::TableFactory>(
+      rocksdb::NewBlockBasedTableFactory(documentsTableOptions));
+  rocksdb::CompressionType documentsCompression = rocksdb::kSnappyCompression;
+  if (opts->_documentsCompression == "lz4") {
+    documentsCompression = rocksdb::kLZ4Compression;
+  } else if (opts->_documentsCompression == "zstd") {
+    documentsCompression = rocksdb::kZSTD;
+  }
+  auto const supported = rocksdb::GetSupportedCompressions();
+  if (std::find(supported.begin(), supported.end(), documentsCompression) ==
+      supported.end()) {
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "compression '" << opts->_documentsCompression
+        << "' is not supported by this build, using snappy for the documents "
+        << "column family. supported compression types: "
+        << getCompressionSupport();
+    documentsCompression = rocksdb::kSnappyCompression;
+  }
+  for (int level = 0; level < _options.num_levels; ++level) {
+    documentsCF.compression_per_level[level] =
+        (((uint64_t)level >= opts->_documentsNumUncompressedLevels)
+             ? documentsCompression
+             : rocksdb::kNoCompression);
+  }
+  if (documentsCompression != rocksdb::kSnappyCompression) {
+    // documents share most of their attribute names and many values, which
+    // a dictionary captures better than block-wise compression alone
+    documentsCF.compression_opts.max_dict_bytes =
+        static_cast<uint32_t>(opts->_documentsCompressionDictionarySize);
+    documentsCF.compression_opts.zstd_max_train_bytes =
+        static_cast<uint32_t>(opts->_documentsCompressionDictionaryTrainingSize);
+  }
+  documentsCF.ttl = opts->_documentsCompactionTtl;
+
   // construct column family options with prefix containing indexed value
   rocksdb::ColumnFamilyOptions dynamicPrefCF(_options);
   dynamicPrefCF.prefix_extractor = std::make_shared<RocksDBPrefixExtractor>();
   // also use hash-search based SST file format
   rocksdb::BlockBasedTableOptions tblo(tableOptions);
   tblo.index_type = rocksdb::BlockBasedTableOptions::IndexType::kHashSearch;
+  tblo.partition_filters = false;  // requires a partitioned index
+  // edges are only looked up by seeking to the vertex id prefix, so the
+  // bloom filters only need to contain the prefixes. this makes them a lot
+  // smaller than filters over the whole keys, which include the edge ids
+  tblo.whole_key_filtering = false;
   dynamicPrefCF.table_factory = std::shared_ptr<rocksdb::TableFactory>(
       rocksdb::NewBlockBasedTableFactory(tblo));
 
@@ -539,7 +664,7 @@ void RocksDBEngine::start() {
   // no prefix families for default column family (Has to be there)
   cfFamilies.emplace_back(rocksdb::kDefaultColumnFamilyName,
                           definitionsCF);                   // 0
-  cfFamilies.emplace_back("Documents", fixedPrefCF);        // 1
+  cfFamilies.emplace_back("Documents", documentsCF);        // 1
   cfFamilies.emplace_back("PrimaryIndex", fixedPrefCF);     // 2
   cfFamilies.emplace_back("EdgeIndex", dynamicPrefCF);      // 3
   cfFamilies.emplace_back("VPackIndex", vpackFixedPrefCF);  // 4
@@ -679,15 +804,28 @@ void RocksDBEngine::start() {
 
   _settingsManager->retrieveInitialValues();
 
-  double const counterSyncSeconds = 2.5;
+  if (_objectStatisticsInterval > 0) {
+    _objectStatistics.reset(
+        new RocksDBObjectStatistics(_objectStatisticsInterval));
+  }
+
   _backgroundThread.reset(
-      new RocksDBBackgroundThread(this, counterSyncSeconds));
+      new RocksDBBackgroundThread(this, _settingsSyncInterval));
   if (!_backgroundThread->start()) {
     LOG_TOPIC(FATAL, Logger::ENGINES)
         << "could not start rocksdb counter manager";
     FATAL_ERROR_EXIT();
   }
 
+  if (_ttlFrequency > 0.0) {
+    _ttlThread.reset(new RocksDBTtlThread(this, _ttlFrequency,
+                                          static_cast<size_t>(_ttlBatchSize)));
+    if (!_ttlThread->start()) {
+      LOG_TOPIC(FATAL, Logger::ENGINES) << "could not start rocksdb ttl thread";
+      FATAL_ERROR_EXIT();
+    }
+  }
+
   if (!systemDatabaseExists()) {
     addSystemDatabase();
   }
@@ -714,6 +852,17 @@ void RocksDBEngine::stop() {
 
   replicationManager()->dropAll();
 
+  if (_ttlThread) {
+    // _ttlThread may be a nullptr, in case the expiry is turned off
+    _ttlThread->beginShutdown();
+
+    // wait until ttl thread stops
+    while (_ttlThread->isRunning()) {
+      std::this_thread::yield();
+    }
+    _ttlThread.reset();
+  }
+
   if (_backgroundThread) {
     // stop the press
     _backgroundThread->beginShutdown();
@@ -1279,6 +1428,10 @@ arangodb::Result RocksDBEngine::dropCollection(
     _collectionMap.erase(collection.id());
   }
 
+  if (_objectStatistics) {
+    _objectStatistics->remove(coll->objectId());
+  }
+
   // delete documents
   RocksDBKeyBounds bounds =
       RocksDBKeyBounds::CollectionDocuments(coll->objectId());
@@ -1321,13 +1474,11 @@ arangodb::Result RocksDBEngine::dropCollection(
     }
   }
 
-  // run compaction for data only if collection contained a considerable
-  // amount of documents. otherwise don't run compaction, because it will
-  // slow things down a lot, especially during tests that create/drop LOTS
-  // of collections
-  if (useRangeDelete) {
-    coll->compact();
-  }
+  // no explicit compaction here: for collections with a considerable
+  // amount of documents, removeLargeRange has used range deletes and already
+  // scheduled a background compaction of the affected ranges. small
+  // collections are not compacted at all, because it would slow things down
+  // a lot, especially during tests that create/drop LOTS of collections
 
   // if we get here all documents / indexes are gone.
   // We have no data garbage left.
@@ -1738,6 +1889,87 @@ void RocksDBEngine::pruneWalFiles() {
   }
 }
 
+void RocksDBEngine::warmupHotSets() {
+  auto* manager = CacheManagerFeature::MANAGER;
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (manager == nullptr || DatabaseFeature::DATABASE == nullptr) {
+    return;
+  }
+  if (scheduler == nullptr || scheduler->isStopping()) {
+    manager->clearLoadedHotSets();
+    return;
+  }
+
+  // collect the hot sets per collection first. the transactions must not
+  // run from within the callbacks, as these hold the database locks
+  typedef std::unordered_map<TRI_idx_iid_t, std::vector<std::string>> HotSets;
+  std::vector<std::pair<CollectionPair, std::shared_ptr<HotSets>>> work;
+
+  DatabaseFeature::DATABASE->enumerateDatabases(
+    [&work, manager](TRI_vocbase_t& vocbase) -> void {
+      vocbase.processCollections(
+        [&work, &vocbase, manager](LogicalCollection* collection) -> void {
+          auto sets = std::make_shared<HotSets>();
+          for (auto const& idx : collection->getIndexes()) {
+            auto* rIdx = static_cast<RocksDBIndex*>(idx.get());
+            std::vector<std::string> keys =
+                manager->takeLoadedHotSet(rIdx->hotSetName());
+            if (!keys.empty()) {
+              sets->emplace(idx->id(), std::move(keys));
+            }
+          }
+          if (!sets->empty()) {
+            work.emplace_back(CollectionPair(vocbase.id(), collection->id()),
+                              std::move(sets));
+          }
+        }, false);
+    }
+  );
+  // hot sets of dropped indexes are not needed anymore
+  manager->clearLoadedHotSets();
+
+  for (auto& it : work) {
+    CollectionPair pair = it.first;
+    std::shared_ptr<HotSets> sets = std::move(it.second);
+    try {
+      scheduler->queue(RequestPriority::LOW, [pair, sets]() {
+        if (SchedulerFeature::SCHEDULER->isStopping()) {
+          return;
+        }
+        try {
+          DatabaseGuard guard(pair.first);
+          auto collection = guard.database().lookupCollection(pair.second);
+          if (collection == nullptr || collection->deleted()) {
+            return;
+          }
+          SingleCollectionTransaction trx(
+            transaction::StandaloneContext::Create(guard.database()),
+            *collection, AccessMode::Type::READ);
+          trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
+          if (trx.begin().fail()) {
+            return;
+          }
+          for (auto const& idx : collection->getIndexes()) {
+            auto set = sets->find(idx->id());
+            if (set != sets->end()) {
+              static_cast<RocksDBIndex*>(idx.get())
+                  ->warmupHotSet(&trx, set->second);
+            }
+          }
+          trx.commit();
+        } catch (std::exception const& ex) {
+          LOG_TOPIC(DEBUG, Logger::CACHE)
+              << "unable to warm up index caches: " << ex.what();
+        } catch (...) {
+          // the warmup is only an optimization
+        }
+      });
+    } catch (...) {
+      // ignore, see above
+    }
+  }
+}
+
 Result RocksDBEngine::dropDatabase(TRI_voc_tick_t id) {
   using namespace rocksutils;
   Result res;
@@ -1997,6 +2229,24 @@ std::unique_ptr<TRI_vocbase_t> RocksDBEngine::openExistingDatabase(
   }
 }
 
+void RocksDBEngine::getMemoryUsage(VPackBuilder& builder) const {
+  auto add = [&](char const* name, std::string const& property,
+                 bool aggregate) {
+    uint64_t value = 0;
+    // the block cache is shared by all column families, so it must not be
+    // summed up
+    if (aggregate ? _db->GetAggregatedIntProperty(property, &value)
+                  : _db->GetIntProperty(property, &value)) {
+      builder.add(name, VPackValue(value));
+    }
+  };
+
+  add("memtables", rocksdb::DB::Properties::kSizeAllMemTables, true);
+  add("tableReaders", rocksdb::DB::Properties::kEstimateTableReadersMem, true);
+  add("blockCache", rocksdb::DB::Properties::kBlockCacheUsage, false);
+  add("blockCachePinned", rocksdb::DB::Properties::kBlockCachePinnedUsage, false);
+}
+
 void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
   // add int properties
   auto addInt = [&](std::string const& s) {
@@ -2041,6 +2291,11 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
             rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES));
 
     builder.add("memory", VPackValue(out));
+
+    // memory of index and filter blocks that are not kept in the block cache
+    if (_db->GetProperty(c, rocksdb::DB::Properties::kEstimateTableReadersMem, &v)) {
+      builder.add("indexAndFilterMemory", VPackValue(basics::StringUtils::uint64(v)));
+    }
     builder.close();
   };
 
@@ -2090,6 +2345,10 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
     }
   }
 
+  if (_listener != nullptr) {
+    _listener->GetStatistics(builder);
+  }
+
   cache::Manager* manager = CacheManagerFeature::MANAGER;
   if (manager != nullptr) {
     // cache turned on
@@ -2099,6 +2358,9 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
     // handle NaN
     builder.add("cache.hit-rate-lifetime", VPackValue(rates.first >= 0.0 ? rates.first : 0.0));
     builder.add("cache.hit-rate-recent", VPackValue(rates.second >= 0.0 ? rates.second : 0.0));
+    auto locality = manager->globalHitLocality();
+    builder.add("cache.hits-local-node", VPackValue(locality.first));
+    builder.add("cache.hits-remote-node", VPackValue(locality.second));
   } else {
     // cache turned off
     builder.add("cache.limit", VPackValue(0));
@@ -2106,6 +2368,38 @@ void RocksDBEngine::getStatistics(VPackBuilder& builder) const {
     // handle NaN
     builder.add("cache.hit-rate-lifetime", VPackValue(0));
     builder.add("cache.hit-rate-recent", VPackValue(0));
+    builder.add("cache.hits-local-node", VPackValue(0));
+    builder.add("cache.hits-remote-node", VPackValue(0));
+  }
+
+  // WAL kept for each flush subscriber, e.g. the ArangoSearch links
+  FlushFeature* flush =
+      application_features::ApplicationServer::lookupFeature<FlushFeature>(
+          "Flush");
+  if (flush != nullptr && flush->isEnabled()) {
+    rocksdb::VectorLogPtr files;
+    if (!_db->GetSortedWalFiles(files).ok()) {
+      files.clear();
+    }
+    double const now = TRI_microtime();
+    builder.add("rocksdb.wal-retention", VPackValue(VPackValueType::Array));
+    for (auto const& it : flush->subscriptions()) {
+      // a file is needed if it contains sequences from the tick onwards
+      uint64_t walSize = 0;
+      for (size_t i = 0; i < files.size(); ++i) {
+        if (i + 1 == files.size() ||
+            files[i + 1]->StartSequence() > it.tick) {
+          walSize += files[i]->SizeFileBytes();
+        }
+      }
+      builder.openObject();
+      builder.add("name", VPackValue(it.name));
+      builder.add("tick", VPackValue(std::to_string(it.tick)));
+      builder.add("lastFlushAge", VPackValue(now - it.lastFlush));
+      builder.add("walSize", VPackValue(walSize));
+      builder.close();
+    }
+    builder.close();
   }
 
   // print column family statistics
@@ -2261,6 +2555,11 @@ WalAccess const* RocksDBEngine::walAccess() const {
   return _walAccess.get();
 }
 
+void RocksDBEngine::notifyWalWrites() const {
+  TRI_ASSERT(_walAccess);
+  _walAccess->notifyWrites();
+}
+
 /// @brief get compression supported by RocksDB
 std::string RocksDBEngine::getCompressionSupport() const {
   std::string result;
@@ -2297,6 +2596,21 @@ void RocksDBEngine::releaseTick(TRI_voc_tick_t tick) {
   }
 }
 
+Result RocksDBEngine::createHotBackup(std::string const& label,
+                                      VPackSlice meta) {
+  // the counters, index estimates and key generators would otherwise have
+  // to be recovered from the WAL after a restore
+  Result res = settingsManager()->sync(true);
+  if (res.fail()) {
+    return res;
+  }
+  return _hotBackup->create(_db, label, meta);
+}
+
+std::string RocksDBEngine::ingestPath() const {
+  return basics::FileUtils::buildFilename(_path, "ingest");
+}
+
 bool RocksDBEngine::canUseRangeDeleteInWal() const {
   return ServerState::instance()->isSingleServer();
 }
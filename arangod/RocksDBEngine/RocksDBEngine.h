@@ -50,12 +50,15 @@ namespace arangodb {
 class PhysicalCollection;
 class PhysicalView;
 class RocksDBBackgroundThread;
+class RocksDBHotBackup;
 class RocksDBKey;
 class RocksDBLogValue;
+class RocksDBObjectStatistics;
 class RocksDBRecoveryHelper;
 class RocksDBReplicationManager;
 class RocksDBSettingsManager;
 class RocksDBSyncThread;
+class RocksDBTtlThread;
 class RocksDBThrottle;    // breaks tons if RocksDBThrottle.h included here
 class RocksDBVPackComparator;
 class RocksDBWalAccess;
@@ -101,6 +104,7 @@ class RocksDBEngine final : public StorageEngine {
   double minimumSyncReplicationTimeout() const override { return 1.0; }
 
   bool supportsDfdb() const override { return false; }
+  bool supportsParallelDatabaseOpening() const override { return true; }
   bool useRawDocumentPointers() override { return false; }
 
   std::unique_ptr<TransactionManager> createTransactionManager() override;
@@ -123,6 +127,7 @@ class RocksDBEngine final : public StorageEngine {
   ) override;
 
   void getStatistics(velocypack::Builder& builder) const override;
+  void getMemoryUsage(velocypack::Builder& builder) const override;
 
   // inventory functionality
   // -----------------------
@@ -160,6 +165,10 @@ class RocksDBEngine final : public StorageEngine {
     return std::string(); // no path to be returned here
   }
 
+  /// @brief directory for temporary SST files that are to be ingested. it
+  /// is inside the RocksDB directory, so files can be ingested without copying
+  std::string ingestPath() const;
+
   velocypack::Builder getReplicationApplierConfiguration(
     TRI_vocbase_t& vocbase,
     int& status
@@ -192,6 +201,8 @@ class RocksDBEngine final : public StorageEngine {
     std::shared_ptr<velocypack::Builder>& builderSPtr
   ) override;
   WalAccess const* walAccess() const override;
+  /// @brief wake up WAL tailing requests which wait for new writes
+  void notifyWalWrites() const;
 
   // database, collection and index management
   // -----------------------------------------
@@ -340,7 +351,12 @@ class RocksDBEngine final : public StorageEngine {
   void determinePrunableWalFiles(TRI_voc_tick_t minTickToKeep);
   void pruneWalFiles();
 
+  /// @brief load the index cache hot sets saved by the previous run into
+  /// the caches, using low priority scheduler threads
+  void warmupHotSets();
+
   double pruneWaitTimeInitial() const { return _pruneWaitTimeInitial; }
+  uint64_t edgeCacheMaxEdges() const { return _edgeCacheMaxEdges; }
 
   // management methods for synchronizing with external persistent stores
   virtual TRI_voc_tick_t currentTick() const override;
@@ -397,6 +413,21 @@ class RocksDBEngine final : public StorageEngine {
     return _replicationManager.get();
   }
 
+  /// @brief per-object read statistics
+  /// note: returns a nullptr if the statistics are turned off!
+  RocksDBObjectStatistics* objectStatistics() const {
+    return _objectStatistics.get();
+  }
+
+  /// @brief hot backups of the engine directory
+  RocksDBHotBackup* hotBackup() const {
+    TRI_ASSERT(_hotBackup);
+    return _hotBackup.get();
+  }
+
+  /// @brief syncs the settings and creates a hot backup of the engine
+  Result createHotBackup(std::string const& label, velocypack::Slice meta);
+
   /// @brief returns a pointer to the sync thread
   /// note: returns a nullptr if automatic syncing is turned off!
   RocksDBSyncThread* syncThread() const {
@@ -426,6 +457,8 @@ class RocksDBEngine final : public StorageEngine {
   std::unique_ptr<RocksDBSettingsManager> _settingsManager;
   /// @brief Local wal access abstraction
   std::unique_ptr<RocksDBWalAccess> _walAccess;
+  /// @brief hot backups, and the pausing of commits for them
+  std::unique_ptr<RocksDBHotBackup> _hotBackup;
 
   /// Background thread handling garbage collection etc
   std::unique_ptr<RocksDBBackgroundThread> _backgroundThread;
@@ -454,6 +487,10 @@ class RocksDBEngine final : public StorageEngine {
   // kicks in
   double _pruneWaitTimeInitial;
 
+  // number of seconds between two syncs of the counters, index estimates and
+  // key generators. the WAL has to be replayed from the oldest synced state
+  double _settingsSyncInterval;
+
   // do not release walfiles containing writes later than this
   TRI_voc_tick_t _releasedTick;
 
@@ -461,12 +498,34 @@ class RocksDBEngine final : public StorageEngine {
   /// note: this is a nullptr if automatic syncing is turned off!
   std::unique_ptr<RocksDBSyncThread> _syncThread;
 
+  /// Background thread removing the expired documents of TTL indexes
+  /// note: this is a nullptr if the expiry is turned off!
+  std::unique_ptr<RocksDBTtlThread> _ttlThread;
+
+  // number of seconds between two runs of the TTL index expiry (0 = off)
+  double _ttlFrequency;
+
+  // maximum number of expired documents removed in a single transaction
+  uint64_t _ttlBatchSize;
+
+  /// per-object read statistics
+  /// note: this is a nullptr if the statistics are turned off!
+  std::unique_ptr<RocksDBObjectStatistics> _objectStatistics;
+
+  // only every n-th read operation of a thread is sampled for the
+  // per-object statistics (0 = off)
+  uint64_t _objectStatisticsInterval;
+
   // WAL sync interval, specified in milliseconds by end user, but uses microseconds internally
   uint64_t _syncInterval;
 
   // use write-throttling
   bool _useThrottle;
 
+  // maximum number of edges of a vertex kept in the edge index cache
+  // (0 = unlimited)
+  uint64_t _edgeCacheMaxEdges;
+
   // activate rocksdb's debug logging
   bool _debugLogging;
 
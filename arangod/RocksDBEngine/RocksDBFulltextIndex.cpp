@@ -392,7 +392,7 @@ Result RocksDBFulltextIndex::parseQueryString(std::string const& qstr,
 }
 
 Result RocksDBFulltextIndex::executeQuery(transaction::Methods* trx, FulltextQuery const& query,
-                                          std::set<LocalDocumentId>& resultSet) {
+                                          std::vector<LocalDocumentId>& resultSet) {
   for (size_t i = 0; i < query.size(); i++) {
     FulltextQueryToken const& token = query[i];
     if (i > 0 && token.operation != FulltextQueryToken::OR
@@ -419,9 +419,48 @@ static RocksDBKeyBounds MakeBounds(uint64_t oid,
   THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
 }
 
+/// @brief intersect two sorted lists of document ids. every element of the
+/// shorter list is searched in the longer one with an exponential search
+/// starting at the previous match, so a short list is intersected with a
+/// long one in logarithmic time per element
+static std::vector<LocalDocumentId> IntersectSorted(
+    std::vector<LocalDocumentId> const& lhs,
+    std::vector<LocalDocumentId> const& rhs) {
+  std::vector<LocalDocumentId> const& small = lhs.size() <= rhs.size() ? lhs : rhs;
+  std::vector<LocalDocumentId> const& large = lhs.size() <= rhs.size() ? rhs : lhs;
+
+  std::vector<LocalDocumentId> output;
+  output.reserve(small.size());
+
+  auto pos = large.begin();
+  for (LocalDocumentId const& id : small) {
+    // gallop until the element is enclosed, then search the last step
+    size_t step = 1;
+    auto hi = pos;
+    while (hi != large.end() && *hi < id) {
+      pos = hi;
+      if (static_cast<size_t>(large.end() - hi) <= step) {
+        hi = large.end();
+        break;
+      }
+      hi += step;
+      step *= 2;
+    }
+    pos = std::lower_bound(pos, hi, id);
+    if (pos == large.end()) {
+      break;
+    }
+    if (*pos == id) {
+      output.push_back(id);
+      ++pos;
+    }
+  }
+  return output;
+}
+
 Result RocksDBFulltextIndex::applyQueryToken(
     transaction::Methods* trx, FulltextQueryToken const& token,
-    std::set<LocalDocumentId>& resultSet) {
+    std::vector<LocalDocumentId>& resultSet) {
   auto mthds = RocksDBTransactionState::toMethods(trx);
   // why can't I have an assignment operator when I want one
   RocksDBKeyBounds bounds = MakeBounds(_objectId, token);
@@ -431,40 +470,98 @@ Result RocksDBFulltextIndex::applyQueryToken(
   rocksdb::ReadOptions ro = mthds->iteratorReadOptions();
   ro.iterate_upper_bound = &end;
   std::unique_ptr<rocksdb::Iterator> iter = mthds->NewIterator(ro, _cf);
-  iter->Seek(bounds.start());
 
-  // set is used to perform an intersection with the result set
-  std::set<LocalDocumentId> intersect;
-  // apply left to right logic, merging all current results with ALL previous
-  while (iter->Valid() && cmp->Compare(iter->key(), end) < 0) {
-    TRI_ASSERT(_objectId == RocksDBKey::objectId(iter->key()));
+  if (token.operation == FulltextQueryToken::AND &&
+      token.matchType == FulltextQueryToken::COMPLETE) {
+    TRI_ASSERT(!resultSet.empty());
+    // probe the posting list of the word for the current candidates only,
+    // instead of reading all of it. the keys of the candidates are probed
+    // in key order, so the iterator only moves forward and skips all
+    // entries in between with a seek
+    std::vector<std::pair<std::string, LocalDocumentId>> probes;
+    probes.reserve(resultSet.size());
+    RocksDBKeyLeaser key(trx);
+    for (LocalDocumentId const& documentId : resultSet) {
+      key->constructFulltextIndexValue(_objectId, StringRef(token.value), documentId);
+      probes.emplace_back(key->string().ToString(), documentId);
+    }
+    std::sort(probes.begin(), probes.end(),
+              [cmp](std::pair<std::string, LocalDocumentId> const& lhs,
+                    std::pair<std::string, LocalDocumentId> const& rhs) {
+                return cmp->Compare(lhs.first, rhs.first) < 0;
+              });
+
+    std::vector<LocalDocumentId> output;
+    iter->Seek(probes.front().first);
+    for (auto const& probe : probes) {
+      if (!iter->Valid()) {
+        break;
+      }
+      int c = cmp->Compare(iter->key(), probe.first);
+      if (c < 0) {
+        iter->Seek(probe.first);
+        if (!iter->Valid()) {
+          break;
+        }
+        c = cmp->Compare(iter->key(), probe.first);
+      }
+      if (c == 0) {
+        output.push_back(probe.second);
+      }
+    }
 
     rocksdb::Status s = iter->status();
     if (!s.ok()) {
       return rocksutils::convertStatus(s);
     }
 
-    LocalDocumentId documentId = RocksDBKey::indexDocumentId(
-        RocksDBEntryType::FulltextIndexValue, iter->key());
-    if (token.operation == FulltextQueryToken::AND) {
-      intersect.insert(documentId);
-    } else if (token.operation == FulltextQueryToken::OR) {
-      resultSet.insert(documentId);
-    } else if (token.operation == FulltextQueryToken::EXCLUDE) {
-      resultSet.erase(documentId);
-    }
+    std::sort(output.begin(), output.end());
+    resultSet = std::move(output);
+    return Result();
+  }
+
+  iter->Seek(bounds.start());
+
+  // all documents matching the token. a prefix matches several words, so
+  // the document ids are neither sorted nor unique
+  std::vector<LocalDocumentId> matches;
+  while (iter->Valid() && cmp->Compare(iter->key(), end) < 0) {
+    TRI_ASSERT(_objectId == RocksDBKey::objectId(iter->key()));
+
+    matches.push_back(RocksDBKey::indexDocumentId(
+        RocksDBEntryType::FulltextIndexValue, iter->key()));
     iter->Next();
   }
+
+  rocksdb::Status s = iter->status();
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s);
+  }
+
+  std::sort(matches.begin(), matches.end());
+  matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+  // apply left to right logic, merging all current results with ALL previous
   if (token.operation == FulltextQueryToken::AND) {
-    if (resultSet.empty() || intersect.empty()) {
-      resultSet.clear();
+    resultSet = IntersectSorted(resultSet, matches);
+  } else if (token.operation == FulltextQueryToken::OR) {
+    if (resultSet.empty()) {
+      resultSet = std::move(matches);
     } else {
-      std::set<LocalDocumentId> output;
-      std::set_intersection(resultSet.begin(), resultSet.end(),
-                            intersect.begin(), intersect.end(),
-                            std::inserter(output, output.begin()));
+      std::vector<LocalDocumentId> output;
+      output.reserve(resultSet.size() + matches.size());
+      std::set_union(resultSet.begin(), resultSet.end(),
+                     matches.begin(), matches.end(),
+                     std::back_inserter(output));
       resultSet = std::move(output);
     }
+  } else if (token.operation == FulltextQueryToken::EXCLUDE) {
+    std::vector<LocalDocumentId> output;
+    output.reserve(resultSet.size());
+    std::set_difference(resultSet.begin(), resultSet.end(),
+                        matches.begin(), matches.end(),
+                        std::back_inserter(output));
+    resultSet = std::move(output);
   }
   return Result();
 }
@@ -499,7 +596,7 @@ IndexIterator* RocksDBFulltextIndex::iteratorForCondition(transaction::Methods*
     THROW_ARANGO_EXCEPTION(res);
   }
 
-  std::set<LocalDocumentId> results;
+  std::vector<LocalDocumentId> results;
   res = executeQuery(trx, parsedQuery, results);
   if (res.fail()) {
     THROW_ARANGO_EXCEPTION(res);
@@ -106,8 +106,9 @@ class RocksDBFulltextIndex final : public RocksDBIndex {
                                       IndexIteratorOptions const&) override;
 
   arangodb::Result parseQueryString(std::string const&, FulltextQuery&);
+  /// @brief execute the query. the result is sorted by document id
   Result executeQuery(transaction::Methods* trx, FulltextQuery const& query,
-                      std::set<LocalDocumentId>& resultSet);
+                      std::vector<LocalDocumentId>& resultSet);
 
  protected:
   /// insert index elements into the specified write batch.
@@ -133,7 +134,7 @@ class RocksDBFulltextIndex final : public RocksDBIndex {
 
   arangodb::Result applyQueryToken(transaction::Methods* trx,
                                    FulltextQueryToken const&,
-                                   std::set<LocalDocumentId>& resultSet);
+                                   std::vector<LocalDocumentId>& resultSet);
 };
   
 /// El Cheapo index iterator
@@ -141,7 +142,7 @@ class RocksDBFulltextIndexIterator : public IndexIterator {
 public:
   RocksDBFulltextIndexIterator(LogicalCollection* collection,
                                transaction::Methods* trx,
-                               std::set<LocalDocumentId>&& docs)
+                               std::vector<LocalDocumentId>&& docs)
   : IndexIterator(collection, trx),
   _docs(std::move(docs)),
   _pos(_docs.begin()) {}
@@ -170,8 +171,8 @@ public:
   }
   
 private:
-  std::set<LocalDocumentId> const _docs;
-  std::set<LocalDocumentId>::iterator _pos;
+  std::vector<LocalDocumentId> const _docs;
+  std::vector<LocalDocumentId>::const_iterator _pos;
 };
   
 }  // namespace arangodb
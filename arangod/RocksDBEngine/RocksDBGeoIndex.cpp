@@ -49,10 +49,12 @@ class RDBNearIterator final : public IndexIterator {
   /// @brief Construct an RocksDBGeoIndexIterator based on Ast Conditions
   RDBNearIterator(LogicalCollection* collection, transaction::Methods* trx,
                   RocksDBGeoIndex const* index,
-                  geo::QueryParams&& params)
+                  geo::QueryParams&& params,
+                  geo_index::RangeFilter&& range)
       : IndexIterator(collection, trx),
         _index(index),
-        _near(std::move(params)) {
+        _near(std::move(params)),
+        _range(std::move(range)) {
     RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
     rocksdb::ReadOptions options = mthds->iteratorReadOptions();
     TRI_ASSERT(options.prefix_same_as_start);
@@ -205,9 +207,13 @@ class RDBNearIterator final : public IndexIterator {
       }
 
       while (_iter->Valid() && cmp->Compare(_iter->key(), bds.end()) <= 0) {
-        LocalDocumentId documentId = RocksDBKey::indexDocumentId(
-            RocksDBEntryType::GeoIndexValue, _iter->key());
-        _near.reportFound(documentId, RocksDBValue::centroid(_iter->value()));
+        // check the stored range attribute, saves fetching the document
+        if (_range.empty() ||
+            _range.matches(RocksDBValue::rangeValue(_iter->value()))) {
+          LocalDocumentId documentId = RocksDBKey::indexDocumentId(
+              RocksDBEntryType::GeoIndexValue, _iter->key());
+          _near.reportFound(documentId, RocksDBValue::centroid(_iter->value()));
+        }
         _iter->Next();
       }
     }
@@ -235,6 +241,7 @@ class RDBNearIterator final : public IndexIterator {
  private:
   RocksDBGeoIndex const* _index;
   geo_index::NearUtils<CMP> _near;
+  geo_index::RangeFilter const _range;
   std::unique_ptr<rocksdb::Iterator> _iter;
 };
 typedef RDBNearIterator<geo_index::DocumentsAscending> LegacyIterator;
@@ -263,6 +270,11 @@ void RocksDBGeoIndex::toVelocyPack(VPackBuilder& builder,
   _coverParams.toVelocyPack(builder);
   builder.add("geoJson",
               VPackValue(_variant == geo_index::Index::Variant::GEOJSON));
+  if (hasRangeField()) {
+    std::string rangeField;
+    TRI_AttributeNamesToString(_rangeAttribute, rangeField, true);
+    builder.add("rangeField", VPackValue(rangeField));
+  }
   // geo indexes are always non-unique
   builder.add(
     arangodb::StaticStrings::IndexUnique,
@@ -334,6 +346,18 @@ bool RocksDBGeoIndex::matchesDefinition(VPackSlice const& info) const {
     }
   }
 
+  value = info.get("rangeField");
+  if (value.isString() != hasRangeField()) {
+    return false;
+  } else if (value.isString()) {
+    std::vector<arangodb::basics::AttributeName> rangeAttribute;
+    TRI_ParseAttributeString(StringRef(value), rangeAttribute, false);
+    if (!arangodb::basics::AttributeName::isIdentical(_rangeAttribute,
+                                                      rangeAttribute, false)) {
+      return false;
+    }
+  }
+
   // This check takes ordering of attributes into account.
   std::vector<arangodb::basics::AttributeName> translate;
   for (size_t i = 0; i < n; ++i) {
@@ -368,7 +392,9 @@ IndexIterator* RocksDBGeoIndex::iteratorForCondition(
   params.pointsOnly = pointsOnly();
   params.fullRange = opts.fullRange;
   params.limit = opts.limit;
-  geo_index::Index::parseCondition(node, reference, params);
+  geo_index::RangeFilter range;
+  geo_index::Index::parseCondition(node, reference, params,
+                                   hasRangeField() ? &range : nullptr);
 
   // FIXME: <Optimize away>
   params.sorted = true;
@@ -390,11 +416,11 @@ IndexIterator* RocksDBGeoIndex::iteratorForCondition(
 
   if (params.ascending) {
     return new RDBNearIterator<geo_index::DocumentsAscending>(
-      &_collection, trx, this, std::move(params)
+      &_collection, trx, this, std::move(params), std::move(range)
     );
   } else {
     return new RDBNearIterator<geo_index::DocumentsDescending>(
-      &_collection, trx, this, std::move(params)
+      &_collection, trx, this, std::move(params), std::move(range)
     );
   }
 }
@@ -418,7 +444,9 @@ Result RocksDBGeoIndex::insertInternal(transaction::Methods* trx,
   TRI_ASSERT(!cells.empty());
   TRI_ASSERT(S2::IsUnitLength(centroid));
 
-  RocksDBValue val = RocksDBValue::S2Value(centroid);
+  RocksDBValue val = hasRangeField()
+                         ? RocksDBValue::S2Value(centroid, rangeValue(doc))
+                         : RocksDBValue::S2Value(centroid);
   RocksDBKeyLeaser key(trx);
   for (S2CellId cell : cells) {
     key->constructGeoIndexValue(_objectId, cell.id(), documentId);
@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBHotBackup.h"
+#include "Basics/FileUtils.h"
+#include "Basics/StringUtils.h"
+#include "Basics/conversions.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "Logger/Logger.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/utilities/checkpoint.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+std::string const restoreMarker("RESTORE");
+std::string const metaSuffix(".json");
+}
+
+RocksDBHotBackup::RocksDBHotBackup(std::string const& basePath,
+                                   std::string const& enginePath)
+    : _path(basics::FileUtils::buildFilename(basePath, "backups")),
+      _enginePath(enginePath),
+      _pausedUntil(0.0),
+      _commitsInFlight(0) {}
+
+void RocksDBHotBackup::beginCommit() {
+  while (true) {
+    // announce the commit first, so that pauseCommits either sees it or
+    // we see the pause
+    _commitsInFlight.fetch_add(1);
+    if (!commitsPaused()) {
+      return;
+    }
+    _commitsInFlight.fetch_sub(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+void RocksDBHotBackup::endCommit() {
+  TRI_ASSERT(_commitsInFlight.load() > 0);
+  _commitsInFlight.fetch_sub(1);
+}
+
+Result RocksDBHotBackup::pauseCommits(double ttl, double timeout) {
+  if (ttl <= 0.0) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "<ttl> needs to be positive");
+  }
+
+  double const now = TRI_microtime();
+  _pausedUntil.store(now + ttl);
+
+  double const end = now + timeout;
+  while (_commitsInFlight.load() > 0) {
+    if (TRI_microtime() > end) {
+      resumeCommits();
+      return Result(TRI_ERROR_LOCK_TIMEOUT,
+                    "timeout waiting for running commits");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  LOG_TOPIC(DEBUG, Logger::ENGINES) << "paused commits for at most " << ttl
+                                    << "s";
+  return Result();
+}
+
+void RocksDBHotBackup::resumeCommits() { _pausedUntil.store(0.0); }
+
+bool RocksDBHotBackup::commitsPaused() const {
+  return _pausedUntil.load() > TRI_microtime();
+}
+
+Result RocksDBHotBackup::create(rocksdb::DB* db, std::string const& label,
+                                VPackSlice meta) {
+  if (!isValidLabel(label)) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "invalid backup label");
+  }
+
+  std::string const dir = basics::FileUtils::buildFilename(_path, label);
+  if (basics::FileUtils::exists(dir) ||
+      basics::FileUtils::exists(metaFilename(label))) {
+    return Result(TRI_ERROR_FILE_EXISTS,
+                  "a backup with label '" + label + "' already exists");
+  }
+
+  if (!basics::FileUtils::isDirectory(_path)) {
+    std::string systemErrorStr;
+    long errorNo;
+    int res = TRI_CreateRecursiveDirectory(_path.c_str(), errorNo,
+                                           systemErrorStr);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return Result(res, "unable to create backup directory '" + _path +
+                             "': " + systemErrorStr);
+    }
+  }
+
+  double const start = TRI_microtime();
+
+  rocksdb::Checkpoint* checkpoint = nullptr;
+  rocksdb::Status s = rocksdb::Checkpoint::Create(db, &checkpoint);
+  std::unique_ptr<rocksdb::Checkpoint> guard(checkpoint);
+  if (s.ok()) {
+    // flush the memtables, so that only little WAL has to be copied
+    s = checkpoint->CreateCheckpoint(dir, 0);
+  }
+  if (!s.ok()) {
+    Result res = rocksutils::convertStatus(s);
+    return Result(res.errorNumber(),
+                  "unable to create checkpoint: " + res.errorMessage());
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("label", VPackValue(label));
+  builder.add("createdAt", VPackValue(TRI_StringTimeStamp(start, false)));
+  if (meta.isObject()) {
+    for (auto const& it : VPackObjectIterator(meta)) {
+      if (!it.key.isEqualString("label") && !it.key.isEqualString("createdAt")) {
+        builder.add(it.key.copyString(), it.value);
+      }
+    }
+  }
+  builder.close();
+
+  try {
+    basics::FileUtils::spit(metaFilename(label), builder.slice().toJson(), true);
+  } catch (...) {
+    TRI_RemoveDirectory(dir.c_str());
+    return Result(TRI_ERROR_CANNOT_WRITE_FILE,
+                  "unable to write meta data of backup '" + label + "'");
+  }
+
+  LOG_TOPIC(INFO, Logger::ENGINES) << "created hot backup '" << label
+                                   << "' in " << (TRI_microtime() - start)
+                                   << "s";
+  return Result();
+}
+
+Result RocksDBHotBackup::remove(std::string const& label) {
+  if (!isValidLabel(label)) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "invalid backup label");
+  }
+
+  std::string const dir = basics::FileUtils::buildFilename(_path, label);
+  if (!basics::FileUtils::isDirectory(dir)) {
+    return Result(TRI_ERROR_FILE_NOT_FOUND,
+                  "backup '" + label + "' not found");
+  }
+
+  // remove the meta data first, so a partially removed backup is not listed
+  basics::FileUtils::remove(metaFilename(label));
+  int res = TRI_RemoveDirectory(dir.c_str());
+  if (res != TRI_ERROR_NO_ERROR) {
+    return Result(res, "unable to remove backup '" + label + "'");
+  }
+  return Result();
+}
+
+void RocksDBHotBackup::list(VPackBuilder& result) const {
+  TRI_ASSERT(result.isOpenArray());
+  if (!basics::FileUtils::isDirectory(_path)) {
+    return;
+  }
+
+  std::vector<std::string> files = basics::FileUtils::listFiles(_path);
+  std::sort(files.begin(), files.end());
+  for (auto const& file : files) {
+    std::string const label =
+        basics::FileUtils::stripExtension(file, metaSuffix);
+    if (label == file ||
+        !basics::FileUtils::isDirectory(
+            basics::FileUtils::buildFilename(_path, label))) {
+      continue;
+    }
+    try {
+      auto meta = VPackParser::fromJson(
+          basics::FileUtils::slurp(metaFilename(label)));
+      result.add(meta->slice());
+    } catch (...) {
+      LOG_TOPIC(WARN, Logger::ENGINES) << "ignoring backup '" << label
+                                       << "' with unreadable meta data";
+    }
+  }
+}
+
+Result RocksDBHotBackup::requestRestore(std::string const& label) {
+  if (!isValidLabel(label)) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "invalid backup label");
+  }
+  if (!basics::FileUtils::isDirectory(
+          basics::FileUtils::buildFilename(_path, label)) ||
+      !basics::FileUtils::exists(metaFilename(label))) {
+    return Result(TRI_ERROR_FILE_NOT_FOUND,
+                  "backup '" + label + "' not found");
+  }
+
+  try {
+    basics::FileUtils::spit(
+        basics::FileUtils::buildFilename(_path, ::restoreMarker), label, true);
+  } catch (...) {
+    return Result(TRI_ERROR_CANNOT_WRITE_FILE,
+                  "unable to write restore marker");
+  }
+
+  LOG_TOPIC(INFO, Logger::ENGINES) << "backup '" << label
+                                   << "' will be restored on the next start";
+  return Result();
+}
+
+void RocksDBHotBackup::restoreIfRequested() {
+  std::string const marker =
+      basics::FileUtils::buildFilename(_path, ::restoreMarker);
+  if (!basics::FileUtils::exists(marker)) {
+    return;
+  }
+
+  std::string label;
+  try {
+    label = basics::StringUtils::trim(basics::FileUtils::slurp(marker));
+  } catch (...) {
+  }
+  // the marker is only ever acted upon once
+  basics::FileUtils::remove(marker);
+
+  std::string const source = basics::FileUtils::buildFilename(_path, label);
+  if (!isValidLabel(label) || !basics::FileUtils::isDirectory(source)) {
+    LOG_TOPIC(ERR, Logger::ENGINES)
+        << "not restoring backup '" << label << "', as it does not exist";
+    return;
+  }
+
+  // keep the current data until the operator removes it
+  std::string const aside = _enginePath + ".before-restore-" +
+                            std::to_string(static_cast<uint64_t>(TRI_microtime()));
+  std::string systemErrorStr;
+  int res = TRI_RenameFile(_enginePath.c_str(), aside.c_str(), nullptr,
+                           &systemErrorStr);
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(ERR, Logger::ENGINES)
+        << "not restoring backup '" << label << "', as the RocksDB directory '"
+        << _enginePath << "' cannot be moved: " << systemErrorStr;
+    return;
+  }
+
+  res = TRI_RenameFile(source.c_str(), _enginePath.c_str(), nullptr,
+                       &systemErrorStr);
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(FATAL, Logger::ENGINES)
+        << "unable to move backup '" << label << "' into place: "
+        << systemErrorStr << ". the previous data is in '" << aside << "'";
+    FATAL_ERROR_EXIT();
+  }
+  basics::FileUtils::remove(metaFilename(label));
+
+  // the checkpoint contains the live WAL files in its top-level directory,
+  // but the engine expects them in its WAL directory
+  std::string const walPath =
+      basics::FileUtils::buildFilename(_enginePath, "journals");
+  basics::FileUtils::createDirectory(walPath);
+  for (auto const& file : basics::FileUtils::listFiles(_enginePath)) {
+    if (basics::StringUtils::isSuffix(file, ".log")) {
+      TRI_RenameFile(basics::FileUtils::buildFilename(_enginePath, file).c_str(),
+                     basics::FileUtils::buildFilename(walPath, file).c_str());
+    }
+  }
+
+  LOG_TOPIC(INFO, Logger::ENGINES)
+      << "restored backup '" << label << "'. the previous data was moved to '"
+      << aside << "' and can be removed";
+}
+
+bool RocksDBHotBackup::isValidLabel(std::string const& label) {
+  if (label.empty() || label.size() > 128 || label == ::restoreMarker) {
+    return false;
+  }
+  for (char c : label) {
+    if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          (c >= '0' && c <= '9') || c == '_' || c == '-')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string RocksDBHotBackup::metaFilename(std::string const& label) const {
+  return basics::FileUtils::buildFilename(_path, label + ::metaSuffix);
+}
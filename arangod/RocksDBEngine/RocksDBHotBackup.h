@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_HOT_BACKUP_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_HOT_BACKUP_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <atomic>
+
+namespace rocksdb {
+class DB;
+}
+
+namespace arangodb {
+
+/// @brief hot backups of the RocksDB engine. a backup is a RocksDB
+/// checkpoint of the engine directory, which hard-links the SST files and
+/// is thus created within seconds regardless of the data size. commits of
+/// transactions can be paused for a short time, so that the backups of
+/// several servers form a consistent cut.
+class RocksDBHotBackup {
+ public:
+  /// @brief time commits stay paused unless resumed earlier
+  static constexpr double DefaultPauseTtl = 10.0;
+
+  RocksDBHotBackup(std::string const& basePath, std::string const& enginePath);
+
+  /// @brief directory all backups are stored in
+  std::string const& path() const { return _path; }
+
+  /// @brief brackets the commit of a transaction. blocks as long as
+  /// commits are paused
+  void beginCommit();
+  void endCommit();
+
+  /// @brief pauses commits for at most ttl seconds and waits up to timeout
+  /// seconds for the commits already in progress
+  Result pauseCommits(double ttl, double timeout);
+  void resumeCommits();
+  bool commitsPaused() const;
+
+  /// @brief creates a checkpoint of db under the given label. meta is
+  /// stored along with the backup
+  Result create(rocksdb::DB* db, std::string const& label,
+                velocypack::Slice meta);
+
+  /// @brief removes a backup
+  Result remove(std::string const& label);
+
+  /// @brief adds the meta data of all backups to result (an open array)
+  void list(velocypack::Builder& result) const;
+
+  /// @brief marks a backup to replace the engine directory on the next start
+  Result requestRestore(std::string const& label);
+
+  /// @brief must be called before RocksDB is opened. if a restore was
+  /// requested, moves the engine directory aside and the backup into its
+  /// place. the backup is consumed by this
+  void restoreIfRequested();
+
+ private:
+  /// @brief labels end up as directory names
+  static bool isValidLabel(std::string const& label);
+
+  std::string metaFilename(std::string const& label) const;
+
+  /// @brief directory of the backups, inside the database directory
+  std::string const _path;
+  /// @brief the RocksDB directory
+  std::string const _enginePath;
+  /// @brief commits are paused until this point in time
+  std::atomic<double> _pausedUntil;
+  /// @brief number of commits in progress
+  std::atomic<uint64_t> _commitsInFlight;
+};
+
+}  // namespace arangodb
+
+#endif
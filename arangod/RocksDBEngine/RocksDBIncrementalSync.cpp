@@ -68,6 +68,7 @@ Result removeKeysOutsideRange(VPackSlice chunkSlice,
 
   trx.addHint(transaction::Hints::Hint::RECOVERY);  // turn off waitForSync!
   trx.addHint(transaction::Hints::Hint::NO_INDEXING);
+  trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
   // turn on intermediate commits as the number of keys to delete can be huge here
   trx.addHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS);
 
@@ -652,6 +653,7 @@ Result handleSyncKeysRocksDB(DatabaseInitialSyncer& syncer,
 
     trx.addHint(transaction::Hints::Hint::RECOVERY);  // turn off waitForSync!
     trx.addHint(transaction::Hints::Hint::NO_INDEXING);
+    trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
     // turn on intermediate commits as the number of operations can be huge here
     trx.addHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS);
     
@@ -31,7 +31,9 @@
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBComparator.h"
+#include "RocksDBEngine/RocksDBEngine.h"
 #include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBObjectStatistics.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "VocBase/LogicalCollection.h"
@@ -186,6 +188,9 @@ void RocksDBIndex::createCache() {
   _cache = CacheManagerFeature::MANAGER->createCache(
       cache::CacheType::Transactional);
   _cachePresent = (_cache.get() != nullptr);
+  if (_cachePresent) {
+    CacheManagerFeature::MANAGER->setHotSetName(_cache->id(), hotSetName());
+  }
   TRI_ASSERT(_cacheEnabled);
 }
 
@@ -230,6 +235,12 @@ int RocksDBIndex::drop() {
   arangodb::Result r = rocksutils::removeLargeRange(rocksutils::globalRocksDB(), this->getBounds(),
                                                     prefixSameAsStart, useRangeDelete);
 
+  RocksDBObjectStatistics* statistics =
+      rocksutils::globalRocksEngine()->objectStatistics();
+  if (statistics != nullptr) {
+    statistics->remove(_objectId);
+  }
+
   // Try to drop the cache as well.
   if (_cachePresent) {
     try {
@@ -281,6 +292,33 @@ Result RocksDBIndex::updateInternal(transaction::Methods* trx, RocksDBMethods* m
   return insertInternal(trx, mthd, newDocumentId, newDoc, mode);
 }
 
+bool RocksDBIndex::hasChangedAttributes(VPackSlice const& oldDoc,
+                                        VPackSlice const& newDoc) const {
+  std::vector<std::string> path;
+  for (auto const& field : _fields) {
+    // compare everything up to and including the first expanded attribute,
+    // i.e. the complete array for "a.b[*].c"
+    path.clear();
+    for (auto const& part : field) {
+      path.emplace_back(part.name);
+      if (part.shouldExpand) {
+        break;
+      }
+    }
+    TRI_ASSERT(!path.empty());
+    // values which only compare equal (e.g. 1 and 1.0) are still considered
+    // changed, as the index may return the stored values
+    VPackSlice oldValue = oldDoc.get(path);
+    VPackSlice newValue = newDoc.get(path);
+    if (oldValue.byteSize() != newValue.byteSize() ||
+        memcmp(oldValue.start(), newValue.start(),
+               static_cast<size_t>(oldValue.byteSize())) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /// @brief return the memory usage of the index
 size_t RocksDBIndex::memory() const {
   rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
@@ -334,6 +372,7 @@ RocksDBKeyBounds RocksDBIndex::getBounds(Index::IndexType type,
     case RocksDBIndex::TRI_IDX_TYPE_HASH_INDEX:
     case RocksDBIndex::TRI_IDX_TYPE_SKIPLIST_INDEX:
     case RocksDBIndex::TRI_IDX_TYPE_PERSISTENT_INDEX:
+    case RocksDBIndex::TRI_IDX_TYPE_TTL_INDEX:
       if (unique) {
         return RocksDBKeyBounds::UniqueVPackIndex(objectId);
       }
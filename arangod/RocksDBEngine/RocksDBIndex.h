@@ -114,6 +114,14 @@ class RocksDBIndex : public Index {
                                 arangodb::velocypack::Slice const&,
                                 OperationMode mode) = 0;
 
+  /// @brief checks whether inserting the document would violate a unique
+  /// constraint of the index, without writing anything
+  virtual Result checkUniqueConstraint(transaction::Methods*, RocksDBMethods*,
+                                       arangodb::velocypack::Slice const&,
+                                       OperationMode) {
+    return Result();
+  }
+
   virtual Result updateInternal(transaction::Methods* trx, RocksDBMethods*,
                                 LocalDocumentId const& oldDocumentId,
                                 arangodb::velocypack::Slice const& oldDoc,
@@ -121,6 +129,16 @@ class RocksDBIndex : public Index {
                                 velocypack::Slice const& newDoc,
                                 OperationMode mode);
 
+  /// @brief whether or not the index entries of a document only depend on
+  /// its document id and the indexed attributes. documents can then keep
+  /// their id on update, and entries of unchanged attributes stay valid
+  virtual bool supportsInPlaceUpdates() const { return true; }
+
+  /// @brief whether or not an update from oldDoc to newDoc changes the
+  /// index entries of a document which keeps its document id
+  virtual bool hasChangedAttributes(arangodb::velocypack::Slice const& oldDoc,
+                                    arangodb::velocypack::Slice const& newDoc) const;
+
   /// remove index elements and put it in the specified write batch.
   virtual Result removeInternal(transaction::Methods* trx, RocksDBMethods*,
                                 LocalDocumentId const& documentId,
@@ -141,6 +159,14 @@ class RocksDBIndex : public Index {
   virtual RocksDBCuckooIndexEstimator<uint64_t>* estimator();
   virtual bool needToPersistEstimate() const;
 
+  /// @brief load the entries of the given cache keys into the cache. the
+  /// keys are taken from the hot set of this index saved by a previous run
+  virtual void warmupHotSet(transaction::Methods*,
+                            std::vector<std::string> const& /*keys*/) {}
+
+  /// @brief name of the hot set of this index' cache
+  std::string hotSetName() const { return std::to_string(_objectId); }
+
  protected:
   RocksDBIndex(
     TRI_idx_iid_t id,
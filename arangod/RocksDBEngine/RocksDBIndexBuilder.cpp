@@ -0,0 +1,393 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBIndexBuilder.h"
+#include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
+#include "Basics/LocalTaskQueue.h"
+#include "Basics/SmallVector.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "Indexes/IndexIterator.h"
+#include "Logger/Logger.h"
+#include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBTransactionState.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "RocksDBEngine/RocksDBVPackIndex.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <rocksdb/comparator.h>
+#include <rocksdb/sst_file_writer.h>
+#include <rocksdb/utilities/transaction_db.h>
+#include <velocypack/Builder.h>
+
+#include <fstream>
+#include <queue>
+
+using namespace arangodb;
+
+namespace {
+/// @brief index entries a task buffers before it sorts and spills them
+constexpr size_t RunBufferSize = 64 * 1024 * 1024;
+
+/// @brief size after which the next SST file is started
+constexpr uint64_t SstFileSize = 256 * 1024 * 1024;
+
+/// @brief maximum number of partitions read in parallel
+constexpr size_t MaxBuilderTasks = 8;
+
+/// @brief memory a buffered key occupies, including the string itself and
+/// its heap allocation if the key does not fit into the inline buffer
+size_t keyMemory(std::string const& key) {
+  static size_t const inlineCapacity = std::string().capacity();
+  size_t memory = sizeof(std::string);
+  if (key.capacity() > inlineCapacity) {
+    memory += key.capacity() + 1;
+  }
+  return memory;
+}
+
+/// @brief sequential reader for a sorted run written by RocksDBIndexBuilderTask
+/// the run file consists of keys, each prefixed with its 32 bit length
+class RunReader {
+ public:
+  explicit RunReader(std::string const& path)
+      : _in(path, std::ios::in | std::ios::binary), _valid(true), _failed(false) {
+    next();
+  }
+
+  bool valid() const { return _valid; }
+  /// @brief whether the run ended in the middle of a key
+  bool failed() const { return _failed; }
+  std::string const& key() const { return _key; }
+
+  void next() {
+    uint32_t length;
+    if (!_in.read(reinterpret_cast<char*>(&length), sizeof(length))) {
+      _valid = false;
+      return;
+    }
+    _key.resize(length);
+    _valid = static_cast<bool>(_in.read(&_key[0], length));
+    _failed = !_valid;
+  }
+
+ private:
+  std::ifstream _in;
+  std::string _key;
+  bool _valid;
+  bool _failed;
+};
+
+/// @brief computes the index entries of one partition of the collection
+/// and writes them to sorted runs. the estimator hashes are only collected
+/// here, they are tracked in the transaction by the builder afterwards
+class RocksDBIndexBuilderTask : public basics::LocalTask {
+ public:
+  RocksDBIndexBuilderTask(std::shared_ptr<basics::LocalTaskQueue> const& queue,
+                          RocksDBVPackIndex* index, IndexIterator* iterator,
+                          std::string const& prefix)
+      : LocalTask(queue),
+        _collection(index->collection()),
+        _index(index),
+        _iterator(iterator),
+        _prefix(prefix),
+        _cmp(index->columnFamily()->GetComparator()),
+        _memory(0) {}
+
+  void run() override {
+    try {
+      fill();
+    } catch (basics::Exception const& ex) {
+      _queue->setStatus(ex.code());
+    } catch (std::bad_alloc const&) {
+      _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+    } catch (...) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+    _queue->join();
+  }
+
+  std::vector<std::string> const& runs() const { return _runs; }
+  std::vector<uint64_t> const& hashes() const { return _hashes; }
+
+ private:
+  void fill() {
+    VPackBuilder builder;
+    int res = TRI_ERROR_NO_ERROR;
+
+    auto cb = [&](LocalDocumentId const& documentId, VPackSlice doc) {
+      if (res != TRI_ERROR_NO_ERROR) {
+        return;
+      }
+      SmallVector<RocksDBKey>::allocator_type::arena_type elementsArena;
+      SmallVector<RocksDBKey> elements{elementsArena};
+      SmallVector<uint64_t>::allocator_type::arena_type hashesArena;
+      SmallVector<uint64_t> hashes{hashesArena};
+
+      builder.clear();
+      res = _index->computeElements(builder, documentId, doc, elements, hashes);
+      if (res != TRI_ERROR_NO_ERROR) {
+        return;
+      }
+      for (RocksDBKey const& key : elements) {
+        _keys.emplace_back(key.string().data(), key.string().size());
+        _memory += keyMemory(_keys.back());
+      }
+      _hashes.insert(_hashes.end(), hashes.begin(), hashes.end());
+    };
+
+    bool hasMore = true;
+    while (hasMore && res == TRI_ERROR_NO_ERROR &&
+           _queue->status() == TRI_ERROR_NO_ERROR) {
+      if (_collection->deleted()) {
+        res = TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND;
+        break;
+      }
+      hasMore = _iterator->nextDocument(cb, 1000);
+      if (_memory >= RunBufferSize) {
+        spill();
+      }
+    }
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      _queue->setStatus(res);
+      return;
+    }
+    spill();
+  }
+
+  /// @brief sort the buffered keys and write them to a new run
+  void spill() {
+    if (_keys.empty()) {
+      return;
+    }
+    std::sort(_keys.begin(), _keys.end(),
+              [this](std::string const& lhs, std::string const& rhs) {
+                return _cmp->Compare(lhs, rhs) < 0;
+              });
+
+    std::string path = _prefix + "-" + std::to_string(_runs.size());
+    std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    for (std::string const& key : _keys) {
+      uint32_t length = static_cast<uint32_t>(key.size());
+      out.write(reinterpret_cast<char const*>(&length), sizeof(length));
+      out.write(key.data(), key.size());
+    }
+    out.close();
+    if (!out) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE,
+                                     "unable to write '" + path + "'");
+    }
+
+    _runs.emplace_back(std::move(path));
+    _keys.clear();
+    _memory = 0;
+  }
+
+ private:
+  LogicalCollection const* _collection;
+  RocksDBVPackIndex* _index;
+  IndexIterator* _iterator;
+  std::string const _prefix;
+  rocksdb::Comparator const* _cmp;
+  std::vector<std::string> _keys;
+  size_t _memory;
+  std::vector<std::string> _runs;
+  std::vector<uint64_t> _hashes;
+};
+}  // namespace
+
+RocksDBIndexBuilder::RocksDBIndexBuilder(RocksDBCollection* collection,
+                                         RocksDBVPackIndex* index)
+    : _collection(collection),
+      _index(index),
+      _directory(basics::FileUtils::buildFilename(
+          rocksutils::globalRocksEngine()->ingestPath(),
+          "index-" + std::to_string(index->objectId()))) {}
+
+RocksDBIndexBuilder::~RocksDBIndexBuilder() {
+  if (basics::FileUtils::isDirectory(_directory)) {
+    TRI_RemoveDirectory(_directory.c_str());
+  }
+}
+
+bool RocksDBIndexBuilder::canBuild(RocksDBIndex const* index) {
+  switch (index->type()) {
+    case Index::TRI_IDX_TYPE_HASH_INDEX:
+    case Index::TRI_IDX_TYPE_SKIPLIST_INDEX:
+    case Index::TRI_IDX_TYPE_PERSISTENT_INDEX:
+    case Index::TRI_IDX_TYPE_TTL_INDEX:
+      return !index->unique();
+    default:
+      return false;
+  }
+}
+
+Result RocksDBIndexBuilder::build(transaction::Methods* trx) {
+  TRI_ASSERT(canBuild(_index));
+
+  long systemError;
+  std::string systemErrorStr;
+  int res = TRI_CreateRecursiveDirectory(_directory.c_str(), systemError,
+                                         systemErrorStr);
+  if (res != TRI_ERROR_NO_ERROR) {
+    return Result(res, "unable to create directory '" + _directory +
+                           "': " + systemErrorStr);
+  }
+
+  size_t const numTasks =
+      std::max<size_t>(1, std::min(TRI_numberProcessors(), MaxBuilderTasks));
+  std::vector<std::unique_ptr<IndexIterator>> iterators =
+      _collection->getAllIterators(trx, numTasks);
+
+  auto poster = [](std::function<void()> fn) -> void {
+    SchedulerFeature::SCHEDULER->queue(RequestPriority::LOW, fn);
+  };
+  auto queue = std::make_shared<basics::LocalTaskQueue>(poster);
+
+  std::vector<std::shared_ptr<RocksDBIndexBuilderTask>> tasks;
+  for (size_t i = 0; i < iterators.size(); ++i) {
+    auto task = std::make_shared<RocksDBIndexBuilderTask>(
+        queue, _index, iterators[i].get(),
+        basics::FileUtils::buildFilename(_directory, "run-" + std::to_string(i)));
+    tasks.emplace_back(task);
+    queue->enqueue(task);
+  }
+  queue->dispatchAndWait();
+
+  if (queue->status() != TRI_ERROR_NO_ERROR) {
+    return Result(queue->status());
+  }
+
+  std::vector<std::string> runs;
+  for (auto const& task : tasks) {
+    runs.insert(runs.end(), task->runs().begin(), task->runs().end());
+  }
+  iterators.clear();
+
+  std::vector<std::string> files;
+  Result r = writeSstFiles(runs, files);
+  if (r.fail() || files.empty()) {
+    return r;
+  }
+  if (_index->collection()->deleted()) {
+    return Result(TRI_ERROR_ARANGO_DATA_SOURCE_NOT_FOUND);
+  }
+
+  // the files do not overlap each other, and the range of the new index is
+  // still empty, so rocksdb can put all of them into the bottommost level
+  rocksdb::IngestExternalFileOptions options;
+  options.move_files = true;
+  rocksdb::Status s = rocksutils::globalRocksDB()->IngestExternalFile(
+      _index->columnFamily(), files, options);
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+  }
+
+  // the estimates are applied on commit, like for any other index insert
+  auto state = RocksDBTransactionState::toState(trx);
+  TRI_voc_cid_t const cid = _index->collection()->id();
+  for (auto const& task : tasks) {
+    for (uint64_t hash : task->hashes()) {
+      state->trackIndexInsert(cid, _index->id(), hash);
+    }
+  }
+
+  LOG_TOPIC(DEBUG, Logger::ENGINES)
+      << "ingested " << files.size() << " SST files for index "
+      << _index->id() << " from " << runs.size() << " runs";
+  return {};
+}
+
+Result RocksDBIndexBuilder::writeSstFiles(std::vector<std::string> const& runs,
+                                          std::vector<std::string>& files) {
+  rocksdb::ColumnFamilyHandle* cf = _index->columnFamily();
+  rocksdb::Comparator const* cmp = cf->GetComparator();
+  rocksdb::Options options = rocksutils::globalRocksDB()->GetOptions(cf);
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options, cf);
+  std::string const value = RocksDBValue::VPackIndexValue().string();
+
+  std::vector<std::unique_ptr<RunReader>> readers;
+  for (std::string const& run : runs) {
+    readers.emplace_back(new RunReader(run));
+  }
+
+  // k-way merge of all runs, smallest key first
+  auto greater = [&](size_t lhs, size_t rhs) {
+    return cmp->Compare(readers[lhs]->key(), readers[rhs]->key()) > 0;
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+  for (size_t i = 0; i < readers.size(); ++i) {
+    if (readers[i]->valid()) {
+      heap.push(i);
+    }
+  }
+
+  bool open = false;
+  bool hasPrevious = false;
+  std::string previous;
+  rocksdb::Status s;
+  while (!heap.empty() && s.ok()) {
+    size_t i = heap.top();
+    heap.pop();
+    RunReader& reader = *readers[i];
+
+    // array indexes can produce the same entry twice for a document
+    if (!hasPrevious || cmp->Compare(reader.key(), previous) != 0) {
+      if (!open) {
+        files.emplace_back(basics::FileUtils::buildFilename(
+            _directory, std::to_string(files.size()) + ".sst"));
+        s = writer.Open(files.back());
+        open = true;
+      }
+      if (s.ok()) {
+        s = writer.Put(reader.key(), value);
+      }
+      previous = reader.key();
+      hasPrevious = true;
+      if (s.ok() && writer.FileSize() >= SstFileSize) {
+        s = writer.Finish();
+        open = false;
+      }
+    }
+
+    reader.next();
+    if (reader.valid()) {
+      heap.push(i);
+    } else if (reader.failed()) {
+      return Result(TRI_ERROR_INTERNAL, "unable to read '" + runs[i] + "'");
+    }
+  }
+
+  if (s.ok() && open) {
+    s = writer.Finish();
+  }
+  if (!s.ok()) {
+    return rocksutils::convertStatus(s, rocksutils::StatusHint::index);
+  }
+  return {};
+}
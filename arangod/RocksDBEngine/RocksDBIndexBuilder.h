@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_INDEX_BUILDER_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_INDEX_BUILDER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Result.h"
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+class RocksDBCollection;
+class RocksDBIndex;
+class RocksDBVPackIndex;
+
+/// @brief fills a new non-unique velocypack index of an existing collection
+/// in bulk. the documents are read in several partitions in parallel. the
+/// index entries are sorted externally and written to SST files, which are
+/// then ingested into rocksdb at once, bypassing the WAL and the memtables.
+/// unique indexes are not supported, because they have to check every
+/// entry against all others while they are inserted
+class RocksDBIndexBuilder {
+ public:
+  RocksDBIndexBuilder(RocksDBCollection* collection, RocksDBVPackIndex* index);
+  ~RocksDBIndexBuilder();
+
+  /// @brief whether or not the index can be filled by the builder
+  static bool canBuild(RocksDBIndex const* index);
+
+  /// @brief fill the index with all documents visible to the transaction.
+  /// the entries are ingested atomically, so on failure the index is empty
+  Result build(transaction::Methods* trx);
+
+ private:
+  /// @brief merge the sorted runs of the tasks into SST files
+  Result writeSstFiles(std::vector<std::string> const& runs,
+                       std::vector<std::string>& files);
+
+ private:
+  RocksDBCollection* _collection;
+  RocksDBVPackIndex* _index;
+  /// @brief directory for all temporary files of this build
+  std::string const _directory;
+};
+
+}  // namespace arangodb
+
+#endif
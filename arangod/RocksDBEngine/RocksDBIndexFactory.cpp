@@ -35,6 +35,7 @@
 #include "RocksDBEngine/RocksDBPersistentIndex.h"
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
 #include "RocksDBEngine/RocksDBSkiplistIndex.h"
+#include "RocksDBEngine/RocksDBTtlIndex.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
@@ -184,6 +185,38 @@ static void ProcessIndexGeoJsonFlag(VPackSlice const definition,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the optional range attribute of a geo index, its value
+/// is stored with every index entry
+////////////////////////////////////////////////////////////////////////////////
+
+static int ProcessIndexGeoRangeField(VPackSlice const definition,
+                                     VPackBuilder& builder) {
+  VPackSlice rangeField = definition.get("rangeField");
+
+  if (rangeField.isNone() || rangeField.isNull()) {
+    return TRI_ERROR_NO_ERROR;
+  }
+  if (!rangeField.isString() || rangeField.getStringLength() == 0) {
+    return TRI_ERROR_BAD_PARAMETER;
+  }
+
+  std::vector<basics::AttributeName> attribute;
+  try {
+    TRI_ParseAttributeString(StringRef(rangeField), attribute, false);
+  } catch (...) {
+    return TRI_ERROR_BAD_PARAMETER;
+  }
+  if (attribute.size() == 1 &&
+      attribute[0].name == arangodb::StaticStrings::IdString) {
+    // _id is not stored in the document
+    return TRI_ERROR_BAD_PARAMETER;
+  }
+
+  builder.add("rangeField", rangeField);
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief enhances the json of a geo1 index
 ////////////////////////////////////////////////////////////////////////////////
@@ -248,6 +281,7 @@ static int EnhanceJsonIndexGeo(VPackSlice const definition,
       arangodb::velocypack::Value(false)
     );
     ProcessIndexGeoJsonFlag(definition, builder);
+    res = ProcessIndexGeoRangeField(definition, builder);
   }
 
   return res;
@@ -288,6 +322,46 @@ static int EnhanceJsonIndexFulltext(VPackSlice const definition,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enhances the json of a ttl index
+////////////////////////////////////////////////////////////////////////////////
+
+static int EnhanceJsonIndexTtl(VPackSlice const definition,
+                               VPackBuilder& builder, bool create) {
+  int res = ProcessIndexFields(definition, builder, 1, 1, create);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    auto fieldsSlice = definition.get(arangodb::StaticStrings::IndexFields);
+    if (fieldsSlice.at(0).copyString().find("[*]") != std::string::npos) {
+      // a document must have a single expiry date
+      return TRI_ERROR_BAD_PARAMETER;
+    }
+
+    // hard-coded defaults. documents without the attribute never expire
+    builder.add(
+      arangodb::StaticStrings::IndexSparse,
+      arangodb::velocypack::Value(true)
+    );
+    builder.add(
+      arangodb::StaticStrings::IndexUnique,
+      arangodb::velocypack::Value(false)
+    );
+
+    // handle "expireAfter" attribute
+    VPackSlice expireAfter =
+        definition.get(arangodb::StaticStrings::IndexExpireAfter);
+
+    if (!expireAfter.isNumber() || expireAfter.getNumericValue<double>() < 0.0) {
+      return TRI_ERROR_BAD_PARAMETER;
+    }
+
+    builder.add(arangodb::StaticStrings::IndexExpireAfter,
+                VPackValue(expireAfter.getNumericValue<double>()));
+  }
+
+  return res;
+}
+
 RocksDBIndexFactory::RocksDBIndexFactory() {
   emplaceFactory("edge",
                  [](LogicalCollection& collection,
@@ -380,6 +454,14 @@ RocksDBIndexFactory::RocksDBIndexFactory() {
                                                                  definition);
                  });
 
+  emplaceFactory("ttl",
+                 [](LogicalCollection& collection,
+                    velocypack::Slice const& definition, TRI_idx_iid_t id,
+                    bool isClusterConstructor) -> std::shared_ptr<Index> {
+                   return std::make_shared<RocksDBTtlIndex>(id, collection,
+                                                            definition);
+                 });
+
   emplaceNormalizer(
       "edge",
       [](velocypack::Builder& normalized, velocypack::Slice definition,
@@ -582,6 +664,27 @@ RocksDBIndexFactory::RocksDBIndexFactory() {
 
         return EnhanceJsonIndexVPack(definition, normalized, isCreation);
       });
+
+  emplaceNormalizer(
+      "ttl",
+      [](velocypack::Builder& normalized, velocypack::Slice definition,
+         bool isCreation) -> arangodb::Result {
+        TRI_ASSERT(normalized.isOpenObject());
+        normalized.add(
+          arangodb::StaticStrings::IndexType,
+          arangodb::velocypack::Value(
+            Index::oldtypeName(Index::TRI_IDX_TYPE_TTL_INDEX)
+          )
+        );
+
+        if (isCreation && !ServerState::instance()->isCoordinator() &&
+            !definition.hasKey("objectId")) {
+          normalized.add("objectId", velocypack::Value(
+                                         std::to_string(TRI_NewTickServer())));
+        }
+
+        return EnhanceJsonIndexTtl(definition, normalized, isCreation);
+      });
 }
 
 
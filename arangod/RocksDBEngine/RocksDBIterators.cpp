@@ -41,9 +41,13 @@ constexpr bool AnyIteratorFillBlockCache = false;
 
 RocksDBAllIndexIterator::RocksDBAllIndexIterator(
     LogicalCollection* col, transaction::Methods* trx, RocksDBPrimaryIndex const* index)
+    : RocksDBAllIndexIterator(col, trx, RocksDBKeyBounds::CollectionDocuments(
+          static_cast<RocksDBCollection*>(col->getPhysical())->objectId())) {}
+
+RocksDBAllIndexIterator::RocksDBAllIndexIterator(
+    LogicalCollection* col, transaction::Methods* trx, RocksDBKeyBounds&& bounds)
     : IndexIterator(col, trx),
-      _bounds(RocksDBKeyBounds::CollectionDocuments(
-          static_cast<RocksDBCollection*>(col->getPhysical())->objectId())),
+      _bounds(std::move(bounds)),
       _upperBound(_bounds.end()),
       _cmp(RocksDBColumnFamily::documents()->GetComparator()) {
   // acquire rocksdb transaction
@@ -70,7 +74,9 @@ RocksDBAllIndexIterator::RocksDBAllIndexIterator(
 
 bool RocksDBAllIndexIterator::outOfRange() const {
   TRI_ASSERT(_trx->state()->isRunning());
-  return _cmp->Compare(_iterator->key(), _bounds.end()) > 0;
+  // the end of the bounds is exclusive. this matters for partitions of the
+  // collection, where it is the start of the next partition
+  return _cmp->Compare(_iterator->key(), _bounds.end()) >= 0;
 }
 
 bool RocksDBAllIndexIterator::next(LocalDocumentIdCallback const& cb, size_t limit) {
@@ -128,7 +134,7 @@ bool RocksDBAllIndexIterator::nextDocument(
 void RocksDBAllIndexIterator::skip(uint64_t count, uint64_t& skipped) {
   TRI_ASSERT(_trx->state()->isRunning());
 
-  while (count > 0 && _iterator->Valid()) {
+  while (count > 0 && _iterator->Valid() && !outOfRange()) {
     --count;
     ++skipped;
 
@@ -51,6 +51,11 @@ class RocksDBAllIndexIterator final : public IndexIterator {
   RocksDBAllIndexIterator(LogicalCollection* collection,
                           transaction::Methods* trx,
                           RocksDBPrimaryIndex const* index);
+  /// @brief iterator over a part of the documents in the collection,
+  /// see RocksDBKeyBounds::CollectionDocuments
+  RocksDBAllIndexIterator(LogicalCollection* collection,
+                          transaction::Methods* trx,
+                          RocksDBKeyBounds&& bounds);
   ~RocksDBAllIndexIterator() {}
 
   char const* typeName() const override { return "all-index-iterator"; }
@@ -52,6 +52,12 @@ RocksDBKeyBounds RocksDBKeyBounds::CollectionDocuments(
   return RocksDBKeyBounds(RocksDBEntryType::Document, collectionObjectId);
 }
 
+RocksDBKeyBounds RocksDBKeyBounds::CollectionDocuments(
+    uint64_t collectionObjectId, uint64_t lower, uint64_t upper) {
+  return RocksDBKeyBounds(RocksDBEntryType::Document, collectionObjectId,
+                          lower, upper);
+}
+
 RocksDBKeyBounds RocksDBKeyBounds::PrimaryIndex(uint64_t indexId) {
   return RocksDBKeyBounds(RocksDBEntryType::PrimaryIndexValue, indexId);
 }
@@ -436,6 +442,17 @@ RocksDBKeyBounds::RocksDBKeyBounds(RocksDBEntryType type, uint64_t first,
                                    uint64_t second, uint64_t third)
     : _type(type) {
   switch (_type) {
+    case RocksDBEntryType::Document: {
+      // Key: 8-byte object ID of collection + 8-byte document revision ID
+      _internals.reserve(sizeof(uint64_t) * 2 * 2);
+      uint64ToPersistent(_internals.buffer(), first);
+      uintToPersistentBigEndian<uint64_t>(_internals.buffer(), second);
+      _internals.separate();
+      uint64ToPersistent(_internals.buffer(), first);
+      uintToPersistentBigEndian<uint64_t>(_internals.buffer(), third);
+      break;
+    }
+
     case RocksDBEntryType::GeoIndexValue: {
       _internals.reserve(sizeof(uint64_t) * 3 * 2);
       uint64ToPersistent(_internals.buffer(), first);
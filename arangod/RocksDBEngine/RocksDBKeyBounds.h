@@ -64,6 +64,16 @@ class RocksDBKeyBounds {
   //////////////////////////////////////////////////////////////////////////////
   static RocksDBKeyBounds CollectionDocuments(uint64_t collectionObjectId);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Bounds for a part of the documents of a specified collection.
+  /// lower (inclusive) and upper (exclusive) are compared against the eight
+  /// key bytes following the object id, read as a big-endian number. This
+  /// does not depend on the endianess used for the document ids, so adjacent
+  /// parts can be used to split a collection into disjoint partitions
+  //////////////////////////////////////////////////////////////////////////////
+  static RocksDBKeyBounds CollectionDocuments(uint64_t collectionObjectId,
+                                              uint64_t lower, uint64_t upper);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Bounds for all index-entries- belonging to a specified primary
   /// index
@@ -22,7 +22,10 @@
 
 #include "RocksDBMethods.h"
 #include "Logger/Logger.h"
+#include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBObjectStatistics.h"
 #include "RocksDBEngine/RocksDBTransactionState.h"
 #include "Transaction/Methods.h"
 
@@ -35,6 +38,28 @@
 
 using namespace arangodb;
 
+namespace {
+/// @brief the per-object read statistics, or a nullptr if they are turned
+/// off or if the column family is not keyed by object id
+RocksDBObjectStatistics* objectStatistics(rocksdb::ColumnFamilyHandle* cf) {
+  if (cf == RocksDBColumnFamily::definitions()) {
+    return nullptr;
+  }
+  return rocksutils::globalRocksEngine()->objectStatistics();
+}
+
+/// @brief wrap a new iterator so that its operations are sampled, if the
+/// statistics are turned on
+std::unique_ptr<rocksdb::Iterator> sampledIterator(
+    rocksdb::ColumnFamilyHandle* cf, rocksdb::Iterator* iterator) {
+  RocksDBObjectStatistics* statistics = objectStatistics(cf);
+  if (statistics == nullptr) {
+    return std::unique_ptr<rocksdb::Iterator>(iterator);
+  }
+  return statistics->wrap(iterator);
+}
+}  // namespace
+
 // ================= RocksDBSavePoint ==================
 
 RocksDBSavePoint::RocksDBSavePoint(
@@ -108,11 +133,26 @@ arangodb::Result RocksDBMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   return Get(cf, key.string(), val);
 }
 
+void RocksDBMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf,
+                              std::vector<rocksdb::Slice> const& keys,
+                              std::vector<std::string>* values,
+                              std::vector<arangodb::Result>* results) {
+  values->resize(keys.size());
+  results->clear();
+  results->reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    results->emplace_back(Get(cf, keys[i], &(*values)[i]));
+  }
+}
+
 rocksdb::SequenceNumber RocksDBMethods::sequenceNumber() {
   return _state->sequenceNumber();
 }
 
 rocksdb::ReadOptions RocksDBMethods::iteratorReadOptions() {
+  // long read-only queries can opt into newer snapshots, so that they do
+  // not keep compactions from dropping old versions for their whole runtime
+  _state->refreshReadSnapshot();
   if (_state->hasHint(transaction::Hints::Hint::INTERMEDIATE_COMMITS)) {
     rocksdb::ReadOptions ro = _state->_rocksReadOptions;
     TRI_ASSERT(_state->_readSnapshot);
@@ -180,8 +220,11 @@ arangodb::Result RocksDBReadOnlyMethods::Get(rocksdb::ColumnFamilyHandle* cf,
                                              std::string* val) {
   TRI_ASSERT(cf != nullptr);
   rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
-  TRI_ASSERT(ro.snapshot != nullptr);
+  TRI_ASSERT(ro.snapshot != nullptr || _state->isSingleRead());
+  RocksDBReadSample sample(objectStatistics(cf));
   rocksdb::Status s = _db->Get(ro, cf, key, val);
+  sample.finish(key, RocksDBObjectStatistics::Operation::Get,
+                s.ok() ? val->size() : 0);
   return s.ok() ? arangodb::Result() : rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "Get - in RocksDBReadOnlyMethods");
 }
 
@@ -190,11 +233,30 @@ arangodb::Result RocksDBReadOnlyMethods::Get(rocksdb::ColumnFamilyHandle* cf,
                                              rocksdb::PinnableSlice* val) {
   TRI_ASSERT(cf != nullptr);
   rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
-  TRI_ASSERT(ro.snapshot != nullptr);
+  TRI_ASSERT(ro.snapshot != nullptr || _state->isSingleRead());
+  RocksDBReadSample sample(objectStatistics(cf));
   rocksdb::Status s = _db->Get(ro, cf, key, val);
+  sample.finish(key, RocksDBObjectStatistics::Operation::Get,
+                s.ok() ? val->size() : 0);
   return s.ok() ? arangodb::Result() : rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "Get - in RocksDBReadOnlyMethods");
 }
 
+void RocksDBReadOnlyMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf,
+                                      std::vector<rocksdb::Slice> const& keys,
+                                      std::vector<std::string>* values,
+                                      std::vector<arangodb::Result>* results) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr);
+  std::vector<rocksdb::Status> statuses = _db->MultiGet(
+      ro, std::vector<rocksdb::ColumnFamilyHandle*>(keys.size(), cf), keys, values);
+  results->clear();
+  results->reserve(statuses.size());
+  for (auto const& s : statuses) {
+    results->emplace_back(s.ok() ? arangodb::Result() : rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "MultiGet - in RocksDBReadOnlyMethods"));
+  }
+}
+
 arangodb::Result RocksDBReadOnlyMethods::Put(rocksdb::ColumnFamilyHandle* cf,
                                              RocksDBKey const&,
                                              rocksdb::Slice const&,
@@ -215,7 +277,7 @@ arangodb::Result RocksDBReadOnlyMethods::SingleDelete(rocksdb::ColumnFamilyHandl
 std::unique_ptr<rocksdb::Iterator> RocksDBReadOnlyMethods::NewIterator(
     rocksdb::ReadOptions const& opts, rocksdb::ColumnFamilyHandle* cf) {
   TRI_ASSERT(cf != nullptr);
-  return std::unique_ptr<rocksdb::Iterator>(_db->NewIterator(opts, cf));
+  return sampledIterator(cf, _db->NewIterator(opts, cf));
 }
 
 // =================== RocksDBTrxMethods ====================
@@ -256,7 +318,10 @@ arangodb::Result RocksDBTrxMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   TRI_ASSERT(cf != nullptr);
   rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
   TRI_ASSERT(ro.snapshot != nullptr);
+  RocksDBReadSample sample(objectStatistics(cf));
   rocksdb::Status s = _state->_rocksTransaction->Get(ro, cf, key, val);
+  sample.finish(key, RocksDBObjectStatistics::Operation::Get,
+                s.ok() ? val->size() : 0);
   if (!s.ok()) {
     rv = rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "Get - in RocksDBTrxMethods");
   }
@@ -270,13 +335,32 @@ arangodb::Result RocksDBTrxMethods::Get(rocksdb::ColumnFamilyHandle* cf,
   TRI_ASSERT(cf != nullptr);
   rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
   TRI_ASSERT(ro.snapshot != nullptr);
+  RocksDBReadSample sample(objectStatistics(cf));
   rocksdb::Status s = _state->_rocksTransaction->Get(ro, cf, key, val);
+  sample.finish(key, RocksDBObjectStatistics::Operation::Get,
+                s.ok() ? val->size() : 0);
   if (!s.ok()) {
     rv = rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "Get - in RocksDBTrxMethods");
   }
   return rv;
 }
 
+void RocksDBTrxMethods::MultiGet(rocksdb::ColumnFamilyHandle* cf,
+                                 std::vector<rocksdb::Slice> const& keys,
+                                 std::vector<std::string>* values,
+                                 std::vector<arangodb::Result>* results) {
+  TRI_ASSERT(cf != nullptr);
+  rocksdb::ReadOptions const& ro = _state->_rocksReadOptions;
+  TRI_ASSERT(ro.snapshot != nullptr);
+  std::vector<rocksdb::Status> statuses = _state->_rocksTransaction->MultiGet(
+      ro, std::vector<rocksdb::ColumnFamilyHandle*>(keys.size(), cf), keys, values);
+  results->clear();
+  results->reserve(statuses.size());
+  for (auto const& s : statuses) {
+    results->emplace_back(s.ok() ? arangodb::Result() : rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "MultiGet - in RocksDBTrxMethods"));
+  }
+}
+
 arangodb::Result RocksDBTrxMethods::Put(rocksdb::ColumnFamilyHandle* cf,
                                         RocksDBKey const& key,
                                         rocksdb::Slice const& val,
@@ -304,8 +388,7 @@ arangodb::Result RocksDBTrxMethods::SingleDelete(rocksdb::ColumnFamilyHandle* cf
 std::unique_ptr<rocksdb::Iterator> RocksDBTrxMethods::NewIterator(
     rocksdb::ReadOptions const& opts, rocksdb::ColumnFamilyHandle* cf) {
   TRI_ASSERT(cf != nullptr);
-  return std::unique_ptr<rocksdb::Iterator>(
-      _state->_rocksTransaction->GetIterator(opts, cf));
+  return sampledIterator(cf, _state->_rocksTransaction->GetIterator(opts, cf));
 }
 
 void RocksDBTrxMethods::SetSavePoint() {
@@ -376,7 +459,10 @@ arangodb::Result RocksDBBatchedMethods::Get(rocksdb::ColumnFamilyHandle* cf,
                                             std::string* val) {
   TRI_ASSERT(cf != nullptr);
   rocksdb::ReadOptions ro;
+  RocksDBReadSample sample(objectStatistics(cf));
   rocksdb::Status s = _wb->GetFromBatchAndDB(_db, ro, cf, key, val);
+  sample.finish(key, RocksDBObjectStatistics::Operation::Get,
+                s.ok() ? val->size() : 0);
   return s.ok() ? arangodb::Result() : rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "Get - in RocksDBBatchedMethods");
 }
 
@@ -385,7 +471,10 @@ arangodb::Result RocksDBBatchedMethods::Get(rocksdb::ColumnFamilyHandle* cf,
                                             rocksdb::PinnableSlice* val) {
   TRI_ASSERT(cf != nullptr);
   rocksdb::ReadOptions ro;
+  RocksDBReadSample sample(objectStatistics(cf));
   rocksdb::Status s = _wb->GetFromBatchAndDB(_db, ro, cf, key, val);
+  sample.finish(key, RocksDBObjectStatistics::Operation::Get,
+                s.ok() ? val->size() : 0);
   return s.ok() ? arangodb::Result() : rocksutils::convertStatus(s, rocksutils::StatusHint::document, "", "Get - in RocksDBBatchedMethods");
 }
 
@@ -415,6 +504,20 @@ arangodb::Result RocksDBBatchedMethods::SingleDelete(rocksdb::ColumnFamilyHandle
 std::unique_ptr<rocksdb::Iterator> RocksDBBatchedMethods::NewIterator(
     rocksdb::ReadOptions const& ro, rocksdb::ColumnFamilyHandle* cf) {
   TRI_ASSERT(cf != nullptr);
-  return std::unique_ptr<rocksdb::Iterator>(
-      _wb->NewIteratorWithBase(_db->NewIterator(ro, cf)));
+  return sampledIterator(cf, _wb->NewIteratorWithBase(_db->NewIterator(ro, cf)));
+}
+
+void RocksDBBatchedMethods::SetSavePoint() { _wb->SetSavePoint(); }
+
+arangodb::Result RocksDBBatchedMethods::RollbackToSavePoint() {
+  return rocksutils::convertStatus(_wb->RollbackToSavePoint());
+}
+
+void RocksDBBatchedMethods::PopSavePoint() {
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+  rocksdb::Status s = _wb->PopSavePoint();
+  TRI_ASSERT(s.ok());
+#else
+  _wb->PopSavePoint();
+#endif
 }
@@ -89,6 +89,12 @@ class RocksDBMethods {
                                std::string*) = 0;
   virtual arangodb::Result Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const&,
                                rocksdb::PinnableSlice*) = 0;
+  /// @brief looks up multiple keys at once. values and results are resized
+  /// to the number of keys. the default implementation calls Get for each key
+  virtual void MultiGet(rocksdb::ColumnFamilyHandle*,
+                        std::vector<rocksdb::Slice> const& keys,
+                        std::vector<std::string>* values,
+                        std::vector<arangodb::Result>* results);
   virtual arangodb::Result Put(
       rocksdb::ColumnFamilyHandle*, RocksDBKey const&, rocksdb::Slice const&,
       rocksutils::StatusHint hint = rocksutils::StatusHint::none) = 0;
@@ -131,6 +137,10 @@ class RocksDBReadOnlyMethods final : public RocksDBMethods {
                        std::string* val) override;
   arangodb::Result Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const& key,
                        rocksdb::PinnableSlice* val) override;
+  void MultiGet(rocksdb::ColumnFamilyHandle*,
+                std::vector<rocksdb::Slice> const& keys,
+                std::vector<std::string>* values,
+                std::vector<arangodb::Result>* results) override;
   arangodb::Result Put(
       rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
       rocksdb::Slice const& val,
@@ -166,6 +176,10 @@ class RocksDBTrxMethods : public RocksDBMethods {
                        std::string* val) override;
   arangodb::Result Get(rocksdb::ColumnFamilyHandle*, rocksdb::Slice const& key,
                        rocksdb::PinnableSlice* val) override;
+  void MultiGet(rocksdb::ColumnFamilyHandle*,
+                std::vector<rocksdb::Slice> const& keys,
+                std::vector<std::string>* values,
+                std::vector<arangodb::Result>* results) override;
   arangodb::Result Put(
       rocksdb::ColumnFamilyHandle*, RocksDBKey const& key,
       rocksdb::Slice const& val,
@@ -223,9 +237,9 @@ class RocksDBBatchedMethods final : public RocksDBMethods {
   std::unique_ptr<rocksdb::Iterator> NewIterator(
       rocksdb::ReadOptions const&, rocksdb::ColumnFamilyHandle*) override;
 
-  void SetSavePoint() override {}
-  arangodb::Result RollbackToSavePoint() override { return arangodb::Result(); }
-  void PopSavePoint() override {}
+  void SetSavePoint() override;
+  arangodb::Result RollbackToSavePoint() override;
+  void PopSavePoint() override;
 
  private:
   rocksdb::TransactionDB* _db;
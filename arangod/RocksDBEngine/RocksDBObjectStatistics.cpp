@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBObjectStatistics.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+#include "RocksDBEngine/RocksDBFormat.h"
+
+#include <rocksdb/perf_context.h>
+#include <rocksdb/perf_level.h>
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+/// @brief number of read operations of the current thread until the
+/// next one is sampled
+thread_local uint64_t sampleCountdown = 0;
+
+/// @brief iterator that samples the operations of the wrapped iterator
+class SampledIterator final : public rocksdb::Iterator {
+ public:
+  SampledIterator(RocksDBObjectStatistics* statistics,
+                  rocksdb::Iterator* iterator)
+      : _statistics(statistics), _iterator(iterator) {}
+
+  bool Valid() const override { return _iterator->Valid(); }
+
+  void SeekToFirst() override { _iterator->SeekToFirst(); }
+
+  void SeekToLast() override { _iterator->SeekToLast(); }
+
+  void Seek(rocksdb::Slice const& target) override {
+    RocksDBReadSample sample(_statistics);
+    _iterator->Seek(target);
+    sample.finish(target, RocksDBObjectStatistics::Operation::Seek,
+                  bytesRead());
+  }
+
+  void SeekForPrev(rocksdb::Slice const& target) override {
+    RocksDBReadSample sample(_statistics);
+    _iterator->SeekForPrev(target);
+    sample.finish(target, RocksDBObjectStatistics::Operation::Seek,
+                  bytesRead());
+  }
+
+  void Next() override {
+    RocksDBReadSample sample(_statistics);
+    _iterator->Next();
+    if (_iterator->Valid()) {
+      sample.finish(_iterator->key(), RocksDBObjectStatistics::Operation::Step,
+                    bytesRead());
+    }
+  }
+
+  void Prev() override {
+    RocksDBReadSample sample(_statistics);
+    _iterator->Prev();
+    if (_iterator->Valid()) {
+      sample.finish(_iterator->key(), RocksDBObjectStatistics::Operation::Step,
+                    bytesRead());
+    }
+  }
+
+  rocksdb::Slice key() const override { return _iterator->key(); }
+
+  rocksdb::Slice value() const override { return _iterator->value(); }
+
+  rocksdb::Status status() const override { return _iterator->status(); }
+
+  rocksdb::Status Refresh() override { return _iterator->Refresh(); }
+
+  rocksdb::Status GetProperty(std::string prop_name,
+                              std::string* prop) override {
+    return _iterator->GetProperty(prop_name, prop);
+  }
+
+ private:
+  size_t bytesRead() const {
+    if (!_iterator->Valid()) {
+      return 0;
+    }
+    return _iterator->key().size() + _iterator->value().size();
+  }
+
+ private:
+  RocksDBObjectStatistics* _statistics;
+  std::unique_ptr<rocksdb::Iterator> _iterator;
+};
+}  // namespace
+
+struct RocksDBObjectStatistics::Counters {
+  std::atomic<uint64_t> reads{0};
+  std::atomic<uint64_t> seeks{0};
+  std::atomic<uint64_t> steps{0};
+  std::atomic<uint64_t> bytesRead{0};
+  std::atomic<uint64_t> blockCacheHits{0};
+  std::atomic<uint64_t> blockCacheMisses{0};
+  std::atomic<uint64_t> blockBytesRead{0};
+};
+
+RocksDBObjectStatistics::RocksDBObjectStatistics(uint64_t sampleInterval)
+    : _sampleInterval(sampleInterval) {
+  TRI_ASSERT(_sampleInterval > 0);
+}
+
+RocksDBObjectStatistics::~RocksDBObjectStatistics() {}
+
+bool RocksDBObjectStatistics::sampleNext() {
+  if (sampleCountdown > 0) {
+    --sampleCountdown;
+    return false;
+  }
+  sampleCountdown = _sampleInterval - 1;
+  return true;
+}
+
+void RocksDBObjectStatistics::beginSample() {
+  rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableCount);
+  rocksdb::get_perf_context()->Reset();
+}
+
+void RocksDBObjectStatistics::endSample(rocksdb::Slice const& key,
+                                        Operation op, size_t bytesRead) {
+  rocksdb::SetPerfLevel(rocksdb::PerfLevel::kDisable);
+  if (key.size() < sizeof(uint64_t)) {
+    return;
+  }
+  uint64_t objectId = rocksutils::uint64FromPersistent(key.data());
+  if (objectId == 0) {
+    return;
+  }
+
+  rocksdb::PerfContext const* perf = rocksdb::get_perf_context();
+  auto record = [&](Counters& c) {
+    switch (op) {
+      case Operation::Get:
+        c.reads.fetch_add(1, std::memory_order_relaxed);
+        break;
+      case Operation::Seek:
+        c.seeks.fetch_add(1, std::memory_order_relaxed);
+        break;
+      case Operation::Step:
+        c.steps.fetch_add(1, std::memory_order_relaxed);
+        break;
+    }
+    c.bytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
+    c.blockCacheHits.fetch_add(perf->block_cache_hit_count,
+                               std::memory_order_relaxed);
+    c.blockCacheMisses.fetch_add(perf->block_read_count,
+                                 std::memory_order_relaxed);
+    c.blockBytesRead.fetch_add(perf->block_read_byte,
+                               std::memory_order_relaxed);
+  };
+
+  // the counters are only modified under the lock, so that a concurrent
+  // remove() cannot free them
+  {
+    READ_LOCKER(guard, _lock);
+    auto it = _counters.find(objectId);
+    if (it != _counters.end()) {
+      record(*(it->second));
+      return;
+    }
+  }
+
+  WRITE_LOCKER(guard, _lock);
+  auto& c = _counters[objectId];
+  if (c == nullptr) {
+    c.reset(new Counters());
+  }
+  record(*c);
+}
+
+void RocksDBObjectStatistics::cancelSample() {
+  rocksdb::SetPerfLevel(rocksdb::PerfLevel::kDisable);
+}
+
+void RocksDBObjectStatistics::toVelocyPack(uint64_t objectId,
+                                           VPackBuilder& builder) const {
+  TRI_ASSERT(builder.isOpenObject());
+  uint64_t reads = 0;
+  uint64_t seeks = 0;
+  uint64_t steps = 0;
+  uint64_t bytesRead = 0;
+  uint64_t blockCacheHits = 0;
+  uint64_t blockCacheMisses = 0;
+  uint64_t blockBytesRead = 0;
+  {
+    READ_LOCKER(guard, _lock);
+    auto it = _counters.find(objectId);
+    if (it != _counters.end()) {
+      Counters const* c = it->second.get();
+      reads = c->reads.load(std::memory_order_relaxed);
+      seeks = c->seeks.load(std::memory_order_relaxed);
+      steps = c->steps.load(std::memory_order_relaxed);
+      bytesRead = c->bytesRead.load(std::memory_order_relaxed);
+      blockCacheHits = c->blockCacheHits.load(std::memory_order_relaxed);
+      blockCacheMisses = c->blockCacheMisses.load(std::memory_order_relaxed);
+      blockBytesRead = c->blockBytesRead.load(std::memory_order_relaxed);
+    }
+  }
+
+  builder.add("reads", VPackValue(reads * _sampleInterval));
+  builder.add("seeks", VPackValue(seeks * _sampleInterval));
+  builder.add("steps", VPackValue(steps * _sampleInterval));
+  builder.add("bytesRead", VPackValue(bytesRead * _sampleInterval));
+  builder.add("blockCacheHits", VPackValue(blockCacheHits * _sampleInterval));
+  builder.add("blockCacheMisses",
+              VPackValue(blockCacheMisses * _sampleInterval));
+  builder.add("blockBytesRead", VPackValue(blockBytesRead * _sampleInterval));
+}
+
+void RocksDBObjectStatistics::remove(uint64_t objectId) {
+  WRITE_LOCKER(guard, _lock);
+  _counters.erase(objectId);
+}
+
+std::unique_ptr<rocksdb::Iterator> RocksDBObjectStatistics::wrap(
+    rocksdb::Iterator* iterator) {
+  return std::unique_ptr<rocksdb::Iterator>(
+      new SampledIterator(this, iterator));
+}
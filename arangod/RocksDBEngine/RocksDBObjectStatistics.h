@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_OBJECT_STATISTICS_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_OBJECT_STATISTICS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ReadWriteLock.h"
+
+#include <rocksdb/iterator.h>
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief read statistics per rocksdb object id, i.e. per collection and
+/// per index. only every n-th read operation of a thread is measured, using
+/// rocksdb's thread-local perf context. the reported values are the sampled
+/// values multiplied by n, so they are estimates
+class RocksDBObjectStatistics {
+ public:
+  enum class Operation { Get, Seek, Step };
+
+  explicit RocksDBObjectStatistics(uint64_t sampleInterval);
+  ~RocksDBObjectStatistics();
+
+  RocksDBObjectStatistics(RocksDBObjectStatistics const&) = delete;
+  RocksDBObjectStatistics& operator=(RocksDBObjectStatistics const&) = delete;
+
+  /// @brief whether or not the next read operation of the current
+  /// thread is sampled
+  bool sampleNext();
+
+  /// @brief start measuring a sampled operation of the current thread
+  void beginSample();
+
+  /// @brief stop measuring a sampled operation of the current thread and
+  /// attribute the results to the object id at the start of the key
+  void endSample(rocksdb::Slice const& key, Operation op, size_t bytesRead);
+
+  /// @brief stop measuring a sampled operation without recording it
+  void cancelSample();
+
+  /// @brief add the estimated statistics of an object to an open object
+  void toVelocyPack(uint64_t objectId, velocypack::Builder& builder) const;
+
+  /// @brief forget the statistics of a dropped object
+  void remove(uint64_t objectId);
+
+  /// @brief wrap an iterator so that its operations are sampled
+  std::unique_ptr<rocksdb::Iterator> wrap(rocksdb::Iterator* iterator);
+
+ private:
+  struct Counters;
+
+ private:
+  uint64_t const _sampleInterval;
+
+  mutable basics::ReadWriteLock _lock;
+  std::unordered_map<uint64_t, std::unique_ptr<Counters>> _counters;
+};
+
+/// @brief measures a single read operation, if it is sampled. the
+/// statistics are disabled if the pointer is a nullptr
+class RocksDBReadSample {
+ public:
+  explicit RocksDBReadSample(RocksDBObjectStatistics* statistics)
+      : _statistics(nullptr) {
+    if (statistics != nullptr && statistics->sampleNext()) {
+      _statistics = statistics;
+      _statistics->beginSample();
+    }
+  }
+
+  ~RocksDBReadSample() {
+    if (_statistics != nullptr) {
+      _statistics->cancelSample();
+    }
+  }
+
+  RocksDBReadSample(RocksDBReadSample const&) = delete;
+  RocksDBReadSample& operator=(RocksDBReadSample const&) = delete;
+
+  void finish(rocksdb::Slice const& key,
+              RocksDBObjectStatistics::Operation op, size_t bytesRead) {
+    if (_statistics != nullptr) {
+      _statistics->endSample(key, op, bytesRead);
+      _statistics = nullptr;
+    }
+  }
+
+ private:
+  RocksDBObjectStatistics* _statistics;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -247,6 +247,114 @@ LocalDocumentId RocksDBPrimaryIndex::lookupKey(transaction::Methods* trx,
   return RocksDBValue::documentId(value);
 }
 
+void RocksDBPrimaryIndex::lookupKeys(transaction::Methods* trx,
+                                     std::vector<StringRef> const& keys,
+                                     std::vector<LocalDocumentId>& result) const {
+  size_t const n = keys.size();
+  result.assign(n, LocalDocumentId());
+
+  // index keys of all keys not found in the cache, and their positions
+  std::vector<std::string> indexKeys;
+  indexKeys.reserve(n);
+  std::vector<size_t> positions;
+  positions.reserve(n);
+
+  bool lockTimeout = false;
+  RocksDBKeyLeaser key(trx);
+  for (size_t i = 0; i < n; ++i) {
+    if (keys[i].empty()) {
+      continue;
+    }
+    key->constructPrimaryIndexValue(_objectId, keys[i]);
+
+    if (useCache()) {
+      TRI_ASSERT(_cache != nullptr);
+      auto f = _cache->find(key->string().data(),
+                            static_cast<uint32_t>(key->string().size()));
+      if (f.found()) {
+        rocksdb::Slice s(reinterpret_cast<char const*>(f.value()->value()),
+                         f.value()->valueSize());
+        result[i] = RocksDBValue::documentId(s);
+        continue;
+      } else if (f.result().errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+        lockTimeout = true;  // we skip the inserts in this case
+      }
+    }
+    indexKeys.emplace_back(key->string().data(), key->string().size());
+    positions.emplace_back(i);
+  }
+
+  if (indexKeys.empty()) {
+    return;
+  }
+
+  // look up the remaining keys in index order
+  std::vector<size_t> order(indexKeys.size());
+  for (size_t j = 0; j < order.size(); ++j) {
+    order[j] = j;
+  }
+  std::sort(order.begin(), order.end(), [&indexKeys](size_t lhs, size_t rhs) {
+    return indexKeys[lhs] < indexKeys[rhs];
+  });
+
+  std::vector<rocksdb::Slice> lookupKeys;
+  lookupKeys.reserve(order.size());
+  for (auto const& j : order) {
+    lookupKeys.emplace_back(indexKeys[j]);
+  }
+
+  std::vector<std::string> values;
+  std::vector<Result> results;
+  RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
+  mthds->MultiGet(_cf, lookupKeys, &values, &results);
+  TRI_ASSERT(values.size() == order.size());
+  TRI_ASSERT(results.size() == order.size());
+
+  for (size_t k = 0; k < order.size(); ++k) {
+    if (results[k].fail()) {
+      continue;
+    }
+    result[positions[order[k]]] = RocksDBValue::documentId(values[k]);
+
+    if (useCache() && !lockTimeout) {
+      TRI_ASSERT(_cache != nullptr);
+      // write entry back to cache
+      auto entry = cache::CachedValue::construct(
+          lookupKeys[k].data(), static_cast<uint32_t>(lookupKeys[k].size()),
+          values[k].data(), static_cast<uint64_t>(values[k].size()));
+      if (entry) {
+        Result status = _cache->insert(entry);
+        if (status.errorNumber() == TRI_ERROR_LOCK_TIMEOUT) {
+          //the writeLock uses cpu_relax internally, so we can try yield
+          std::this_thread::yield();
+          status = _cache->insert(entry);
+        }
+        if (status.fail()) {
+          delete entry;
+        }
+      }
+    }
+  }
+}
+
+void RocksDBPrimaryIndex::warmupHotSet(transaction::Methods* trx,
+                                       std::vector<std::string> const& keys) {
+  if (!useCache()) {
+    return;
+  }
+  // the cache keys are the rocksdb keys, so they can be looked up in order
+  std::vector<std::string> sorted(keys);
+  std::sort(sorted.begin(), sorted.end());
+  for (auto const& key : sorted) {
+    if (key.size() <= sizeof(uint64_t) ||
+        rocksutils::uint64FromPersistent(key.data()) != _objectId) {
+      continue;
+    }
+    // fills the cache on the way
+    lookupKey(trx, RocksDBKey::primaryKey(rocksdb::Slice(key)));
+  }
+}
+
 /// @brief reads a revision id from the primary index 
 /// if the document does not exist, this function will return false
 /// if the document exists, the function will return true
@@ -310,6 +418,27 @@ Result RocksDBPrimaryIndex::insertInternal(transaction::Methods* trx,
   return IndexResult(status.errorNumber(), this);
 }
 
+Result RocksDBPrimaryIndex::checkUniqueConstraint(transaction::Methods* trx,
+                                                  RocksDBMethods* mthd,
+                                                  VPackSlice const& slice,
+                                                  OperationMode mode) {
+  VPackSlice keySlice = transaction::helpers::extractKeyFromDocument(slice);
+  RocksDBKeyLeaser key(trx);
+  key->constructPrimaryIndexValue(_objectId, StringRef(keySlice));
+
+  if (mthd->Exists(_cf, key.ref())) {
+    std::string existingId(keySlice.copyString());
+
+    if (mode == OperationMode::internal) {
+      return IndexResult(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED,
+                         std::move(existingId));
+    }
+    return IndexResult(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED, this,
+                       existingId);
+  }
+  return Result();
+}
+
 Result RocksDBPrimaryIndex::updateInternal(transaction::Methods* trx,
                                            RocksDBMethods* mthd,
                                            LocalDocumentId const& oldDocumentId,
@@ -115,6 +115,16 @@ class RocksDBPrimaryIndex final : public RocksDBIndex {
   LocalDocumentId lookupKey(transaction::Methods* trx,
                          arangodb::StringRef key) const;
 
+  /// @brief looks up multiple keys with a single MultiGet, in index order.
+  /// result contains the document id for each key, which is not set if
+  /// the key was not found or is empty
+  void lookupKeys(transaction::Methods* trx,
+                  std::vector<arangodb::StringRef> const& keys,
+                  std::vector<LocalDocumentId>& result) const;
+
+  void warmupHotSet(transaction::Methods* trx,
+                    std::vector<std::string> const& keys) override;
+
   /// @brief reads a revision id from the primary index 
   /// if the document does not exist, this function will return false
   /// if the document exists, the function will return true
@@ -152,6 +162,10 @@ class RocksDBPrimaryIndex final : public RocksDBIndex {
                         arangodb::velocypack::Slice const&,
                         OperationMode mode) override;
 
+  Result checkUniqueConstraint(transaction::Methods* trx, RocksDBMethods*,
+                               arangodb::velocypack::Slice const&,
+                               OperationMode mode) override;
+
   Result updateInternal(transaction::Methods* trx, RocksDBMethods*,
                         LocalDocumentId const& oldDocumentId,
                         arangodb::velocypack::Slice const& oldDoc,
@@ -159,6 +173,13 @@ class RocksDBPrimaryIndex final : public RocksDBIndex {
                         velocypack::Slice const& newDoc,
                         OperationMode mode) override;
 
+  /// @brief the stored value contains the revision id, which changes
+  /// on every update
+  bool hasChangedAttributes(arangodb::velocypack::Slice const&,
+                            arangodb::velocypack::Slice const&) const override {
+    return true;
+  }
+
   /// remove index elements and put it in the specified write batch.
   Result removeInternal(transaction::Methods*, RocksDBMethods*,
                         LocalDocumentId const& documentId,
@@ -25,13 +25,18 @@
 #include "RocksDBRecoveryManager.h"
 
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/NumberUtils.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/Exceptions.h"
 #include "Basics/exitcodes.h"
+#include "Basics/system-functions.h"
 #include "Logger/Logger.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "ProgramOptions/Section.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RocksDBEngine/RocksDBCollection.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
@@ -59,7 +64,11 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <deque>
+#include <thread>
+
 using namespace arangodb::application_features;
+using namespace arangodb::options;
 
 namespace arangodb {
 
@@ -74,6 +83,7 @@ RocksDBRecoveryManager::RocksDBRecoveryManager(
 )
     : ApplicationFeature(server, featureName()),
       _db(nullptr),
+      _recoveryThreads(0),
       _inRecovery(true) {
   setOptional(true);
   startsAfter("BasicsPhase");
@@ -87,6 +97,18 @@ RocksDBRecoveryManager::RocksDBRecoveryManager(
   onlyEnabledWith("RocksDBEngine");
 }
 
+void RocksDBRecoveryManager::collectOptions(
+    std::shared_ptr<ProgramOptions> options) {
+  options->addSection("rocksdb", "RocksDB engine specific configuration");
+
+  options->addOption("--rocksdb.recovery-threads",
+                     "number of threads replaying the WAL after an unclean "
+                     "shutdown. documents and index estimates are split "
+                     "among them by collection and index (0 = number of cores, "
+                     "up to 8)",
+                     new UInt64Parameter(&_recoveryThreads));
+}
+
 void RocksDBRecoveryManager::start() {
   if (!isEnabled()) {
     return;
@@ -150,26 +172,46 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
   /// @brief last document removed
   TRI_voc_rid_t _lastRemovedDocRid = 0;
 
+  /// @brief the WAL can be replayed by several readers in parallel. each
+  /// reader only counts the documents and adjusts the estimates of the
+  /// object ids in its shard. the reader of shard 0 additionally tracks
+  /// ticks and key generators, and feeds the recovery helpers
+  size_t const _shard;
+  size_t const _numShards;
+
  public:
 
   /// @param seqs sequence number from which to count operations
-  explicit WBReader(std::unordered_map<uint64_t, rocksdb::SequenceNumber> const& seqs)
-      : currentSeqNum(0) {
+  WBReader(std::unordered_map<uint64_t, rocksdb::SequenceNumber> const& seqs,
+           size_t shard, size_t numShards)
+      : currentSeqNum(0), _shard(shard), _numShards(numShards) {
+        TRI_ASSERT(_shard < _numShards);
         for (auto const& pair : seqs) {
+          if (!ownsObject(pair.first)) {
+            continue;
+          }
           try {
             _deltas.emplace(pair.first, Operations(pair.second));
           } catch(...) {}
         }
       }
 
+  bool ownsObject(uint64_t objectId) const {
+    return (objectId % _numShards) == _shard;
+  }
+
+  bool isGlobal() const { return _shard == 0; }
+
   Result shutdownWBReader() {
     Result rv = basics::catchVoidToResult([&]() -> void {
-      // update ticks after parsing wal
-      LOG_TOPIC(TRACE, Logger::ENGINES) << "max tick found in WAL: " << _maxTick
-                                        << ", last HLC value: " << _maxHLC;
+      if (isGlobal()) {
+        // update ticks after parsing wal
+        LOG_TOPIC(TRACE, Logger::ENGINES) << "max tick found in WAL: " << _maxTick
+                                          << ", last HLC value: " << _maxHLC;
 
-      TRI_UpdateTickServer(_maxTick);
-      TRI_HybridLogicalClock(_maxHLC);
+        TRI_UpdateTickServer(_maxTick);
+        TRI_HybridLogicalClock(_maxHLC);
+      }
 
       auto dbfeature = ApplicationServer::getFeature<DatabaseFeature>("Database");
       
@@ -405,11 +447,13 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
                         const rocksdb::Slice& value) override {
     LOG_TOPIC(TRACE, Logger::ENGINES) << "recovering PUT " << RocksDBKey(key);
 
-    updateMaxTick(column_family_id, key, value);
+    if (isGlobal()) {
+      updateMaxTick(column_family_id, key, value);
+    }
     if (column_family_id == RocksDBColumnFamily::documents()->GetID()) {
       uint64_t objectId = RocksDBKey::objectId(key);
       Operations* ops = nullptr;
-      if (shouldHandleCollection(objectId, &ops)) {
+      if (ownsObject(objectId) && shouldHandleCollection(objectId, &ops)) {
         TRI_ASSERT(ops != nullptr);
         ops->lastSequenceNumber = currentSeqNum;
         ops->added++;
@@ -426,7 +470,7 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
 
       if (hash != 0) {
         uint64_t objectId = RocksDBKey::objectId(key);
-        auto est = findEstimator(objectId);
+        auto est = ownsObject(objectId) ? findEstimator(objectId) : nullptr;
         if (est != nullptr && est->commitSeq() < currentSeqNum) {
           // We track estimates for this index
           est->insert(hash);
@@ -434,10 +478,12 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
       }
     }
 
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->PutCF(column_family_id, key, value);
+    if (isGlobal()) {
+      RocksDBEngine* engine =
+          static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
+      for (auto helper : engine->recoveryHelpers()) {
+        helper->PutCF(column_family_id, key, value);
+      }
     }
 
     return rocksdb::Status();
@@ -449,11 +495,13 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
     if (cfId == RocksDBColumnFamily::documents()->GetID()) {
       uint64_t objectId = RocksDBKey::objectId(key);
       
-      storeMaxHLC(RocksDBKey::documentId(key).id());
-      storeMaxTick(objectId);
+      if (isGlobal()) {
+        storeMaxHLC(RocksDBKey::documentId(key).id());
+        storeMaxTick(objectId);
+      }
       
       Operations* ops = nullptr;
-      if (shouldHandleCollection(objectId, &ops)) {
+      if (ownsObject(objectId) && shouldHandleCollection(objectId, &ops)) {
         TRI_ASSERT(ops != nullptr);
         ops->lastSequenceNumber = currentSeqNum;
         ops->removed++;
@@ -473,7 +521,7 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
 
       if (hash != 0) {
         uint64_t objectId = RocksDBKey::objectId(key);
-        auto est = findEstimator(objectId);
+        auto est = ownsObject(objectId) ? findEstimator(objectId) : nullptr;
         if (est != nullptr && est->commitSeq() < currentSeqNum) {
           // We track estimates for this index
           est->remove(hash);
@@ -488,10 +536,12 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
         << "recovering DELETE " << RocksDBKey(key);
     
     handleDeleteCF(column_family_id, key);
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->DeleteCF(column_family_id, key);
+    if (isGlobal()) {
+      RocksDBEngine* engine =
+          static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
+      for (auto helper : engine->recoveryHelpers()) {
+        helper->DeleteCF(column_family_id, key);
+      }
     }
 
     return rocksdb::Status();
@@ -504,10 +554,12 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
 
     handleDeleteCF(column_family_id, key);
 
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->SingleDeleteCF(column_family_id, key);
+    if (isGlobal()) {
+      RocksDBEngine* engine =
+          static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
+      for (auto helper : engine->recoveryHelpers()) {
+        helper->SingleDeleteCF(column_family_id, key);
+      }
     }
 
     return rocksdb::Status();
@@ -520,10 +572,12 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
         << "recovering DELETE RANGE from " << RocksDBKey(begin_key)
         << " to " << RocksDBKey(end_key);
     // drop and truncate can use this, truncate is handled via a Log marker
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->DeleteRangeCF(column_family_id, begin_key, end_key);
+    if (isGlobal()) {
+      RocksDBEngine* engine =
+          static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
+      for (auto helper : engine->recoveryHelpers()) {
+        helper->DeleteRangeCF(column_family_id, begin_key, end_key);
+      }
     }
 
     return rocksdb::Status(); // make WAL iterator happy
@@ -543,6 +597,10 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
         break;
       case RocksDBLogType::CollectionTruncate: {
         uint64_t objectId = RocksDBLogValue::objectId(blob);
+        if (!ownsObject(objectId)) {
+          _lastRemovedDocRid = 0;
+          break;
+        }
         Operations* ops = nullptr;
         if (shouldHandleCollection(objectId, &ops)) {
           TRI_ASSERT(ops != nullptr);
@@ -565,14 +623,118 @@ class WBReader final : public rocksdb::WriteBatch::Handler {
         _lastRemovedDocRid = 0; // reset in any other case
         break;
     }
-    RocksDBEngine* engine =
-        static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
-    for (auto helper : engine->recoveryHelpers()) {
-      helper->LogData(blob);
+    if (isGlobal()) {
+      RocksDBEngine* engine =
+          static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
+      for (auto helper : engine->recoveryHelpers()) {
+        helper->LogData(blob);
+      }
     }
   }
 };
 
+/// @brief hands the batches read from the WAL to the readers of all shards.
+/// the batches are shared, as every reader has to see all of them in order
+class WBDispatcher {
+ public:
+  typedef std::pair<rocksdb::SequenceNumber, std::shared_ptr<rocksdb::WriteBatch>> Batch;
+
+  explicit WBDispatcher(std::vector<std::unique_ptr<WBReader>>& readers)
+      : _readers(readers), _queues(readers.size()), _done(false) {}
+
+  ~WBDispatcher() { finish(); }
+
+  /// @brief start one thread per reader
+  void start() {
+    for (size_t i = 0; i < _readers.size(); ++i) {
+      _threads.emplace_back([this, i]() { run(i); });
+    }
+  }
+
+  /// @brief queue a batch for all readers. returns false if a reader failed
+  bool dispatch(rocksdb::SequenceNumber seq,
+                std::shared_ptr<rocksdb::WriteBatch> const& batch) {
+    CONDITION_LOCKER(guard, _condition);
+    // limit the memory used by batches which are not yet replayed
+    while (_result.ok() && maxQueued() >= MaxQueuedBatches) {
+      guard.wait(10000);
+    }
+    if (_result.fail()) {
+      return false;
+    }
+    for (auto& queue : _queues) {
+      queue.emplace_back(seq, batch);
+    }
+    guard.broadcast();
+    return true;
+  }
+
+  /// @brief wait until all readers have replayed all batches
+  Result finish() {
+    {
+      CONDITION_LOCKER(guard, _condition);
+      _done = true;
+      guard.broadcast();
+    }
+    for (auto& thread : _threads) {
+      thread.join();
+    }
+    _threads.clear();
+    return _result;
+  }
+
+ private:
+  static constexpr size_t MaxQueuedBatches = 4096;
+
+  size_t maxQueued() const {
+    size_t result = 0;
+    for (auto const& queue : _queues) {
+      result = std::max(result, queue.size());
+    }
+    return result;
+  }
+
+  void run(size_t shard) {
+    WBReader& reader = *_readers[shard];
+    while (true) {
+      Batch batch;
+      {
+        CONDITION_LOCKER(guard, _condition);
+        while (_queues[shard].empty() && !_done && _result.ok()) {
+          guard.wait(10000);
+        }
+        if (_queues[shard].empty() || _result.fail()) {
+          return;
+        }
+        batch = std::move(_queues[shard].front());
+        _queues[shard].pop_front();
+        guard.broadcast();
+      }
+
+      Result res = basics::catchToResult([&]() -> Result {
+        reader.currentSeqNum = batch.first;
+        return rocksutils::convertStatus(batch.second->Iterate(&reader));
+      });
+      if (res.fail()) {
+        CONDITION_LOCKER(guard, _condition);
+        if (_result.ok()) {
+          _result.reset(res.errorNumber(),
+                        "error during WAL scan: " + res.errorMessage());
+        }
+        guard.broadcast();
+        return;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<WBReader>>& _readers;
+  std::vector<std::deque<Batch>> _queues;
+  std::vector<std::thread> _threads;
+  basics::ConditionVariable _condition;
+  Result _result;
+  bool _done;
+};
+
 /// parse the WAL with the above handler parser class
 Result RocksDBRecoveryManager::parseRocksWAL() {
   Result shutdownRv;
@@ -585,8 +747,18 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
       helper->prepare();
     }
 
-    // Tell the WriteBatch reader the transaction markers to look for
-    WBReader handler(engine->settingsManager()->counterSeqs());
+    size_t numShards = static_cast<size_t>(_recoveryThreads);
+    if (numShards == 0) {
+      numShards = std::min(TRI_numberProcessors(), static_cast<size_t>(8));
+    }
+    numShards = std::max(numShards, static_cast<size_t>(1));
+
+    // Tell the WriteBatch readers the transaction markers to look for
+    auto const counterSeqs = engine->settingsManager()->counterSeqs();
+    std::vector<std::unique_ptr<WBReader>> readers;
+    for (size_t i = 0; i < numShards; ++i) {
+      readers.emplace_back(new WBReader(counterSeqs, i, numShards));
+    }
 
     auto minTick = std::min(engine->settingsManager()->earliestSeqNeeded(),
                             engine->releasedTick());
@@ -596,7 +768,8 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
 
     rv = rocksutils::convertStatus(s);
 
-    if (rv.ok()) {
+    if (rv.ok() && numShards == 1) {
+      WBReader& handler = *readers[0];
       while (iterator->Valid()) {
         s = iterator->status();
         if (s.ok()) {
@@ -616,9 +789,42 @@ Result RocksDBRecoveryManager::parseRocksWAL() {
 
         iterator->Next();
       }
+    } else if (rv.ok()) {
+      LOG_TOPIC(DEBUG, Logger::ENGINES)
+          << "replaying WAL with " << numShards << " threads";
+
+      // this thread reads the WAL, the readers replay it in parallel
+      WBDispatcher dispatcher(readers);
+      dispatcher.start();
+      while (iterator->Valid()) {
+        s = iterator->status();
+        if (!s.ok()) {
+          rv = rocksutils::convertStatus(s);
+          rv.reset(rv.errorNumber(), "error during WAL scan: " + rv.errorMessage());
+          break;
+        }
+        rocksdb::BatchResult batch = iterator->GetBatch();
+        std::shared_ptr<rocksdb::WriteBatch> wb(batch.writeBatchPtr.release());
+        if (!dispatcher.dispatch(batch.sequence, wb)) {
+          break;
+        }
+        iterator->Next();
+      }
+      Result dispatchRv = dispatcher.finish();
+      if (rv.ok()) {
+        rv = dispatchRv;
+      }
+      if (rv.fail()) {
+        LOG_TOPIC(ERR, Logger::ENGINES) << rv.errorMessage();
+      }
     }
 
-    shutdownRv = handler.shutdownWBReader();
+    for (auto& reader : readers) {
+      Result tmp = reader->shutdownWBReader();
+      if (shutdownRv.ok()) {
+        shutdownRv = tmp;
+      }
+    }
 
     return rv;
   });
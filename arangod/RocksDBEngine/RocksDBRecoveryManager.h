@@ -46,6 +46,7 @@ class RocksDBRecoveryManager final
   static std::string featureName() { return "RocksDBRecoveryManager"; }
   static RocksDBRecoveryManager* instance();
 
+  void collectOptions(std::shared_ptr<options::ProgramOptions>) override;
   void start() override;
 
   void runRecovery();
@@ -63,6 +64,9 @@ class RocksDBRecoveryManager final
   //////////////////////////////////////////////////////////////////////////////
   rocksdb::TransactionDB* _db;
 
+  /// @brief number of threads replaying the WAL (0 = automatic)
+  uint64_t _recoveryThreads;
+
   std::atomic<bool> _inRecovery;
 };
 
@@ -82,6 +82,7 @@ RocksDBReplicationContext::RocksDBReplicationContext(double ttl,
 RocksDBReplicationContext::~RocksDBReplicationContext() {
   MUTEX_LOCKER(guard, _contextLock);
   _iterators.clear();
+  _streamIterators.clear();
   if (_snapshot != nullptr) {
     globalRocksDB()->ReleaseSnapshot(_snapshot);
     _snapshot = nullptr;
@@ -116,7 +117,20 @@ void RocksDBReplicationContext::removeVocbase(TRI_vocbase_t& vocbase) {
       it++;
     }
   }
-  if (_iterators.empty() && found) {
+  auto it2 = _streamIterators.begin();
+  while (it2 != _streamIterators.end()) {
+    if (it2->second->vocbase.id() == vocbase.id()) {
+      if (it2->second->isUsed()) {
+        LOG_TOPIC(ERR, Logger::REPLICATION) << "trying to delete used context";
+      } else {
+        found = true;
+        it2 = _streamIterators.erase(it2);
+      }
+    } else {
+      it2++;
+    }
+  }
+  if (_iterators.empty() && _streamIterators.empty() && found) {
     _isDeleted = true; // setDeleted also gets the lock
   }
 }
@@ -124,14 +138,27 @@ void RocksDBReplicationContext::removeVocbase(TRI_vocbase_t& vocbase) {
 /// remove matching iterator
 void RocksDBReplicationContext::releaseIterators(TRI_vocbase_t& vocbase, TRI_voc_cid_t cid) {
   MUTEX_LOCKER(locker, _contextLock);
+  bool found = false;
   auto it = _iterators.find(cid);
   if (it != _iterators.end()) {
+    found = true;
     if (it->second->isUsed()) {
       LOG_TOPIC(ERR, Logger::REPLICATION) << "trying to delete used iterator";
     } else {
       _iterators.erase(it);
     }
-  } else {
+  }
+  auto it2 = _streamIterators.lower_bound(std::make_pair(cid, uint64_t(0)));
+  while (it2 != _streamIterators.end() && it2->first.first == cid) {
+    found = true;
+    if (it2->second->isUsed()) {
+      LOG_TOPIC(ERR, Logger::REPLICATION) << "trying to delete used iterator";
+      ++it2;
+    } else {
+      it2 = _streamIterators.erase(it2);
+    }
+  }
+  if (!found) {
     LOG_TOPIC(ERR, Logger::REPLICATION) << "trying to delete non-existent iterator";
   }
 }
@@ -244,7 +271,8 @@ Result RocksDBReplicationContext::getInventory(TRI_vocbase_t& vocbase,
 RocksDBReplicationContext::DumpResult
   RocksDBReplicationContext::dumpJson(
     TRI_vocbase_t& vocbase, std::string const& cname,
-    basics::StringBuffer& buff, uint64_t chunkSize) {
+    basics::StringBuffer& buff, uint64_t chunkSize,
+    uint64_t stream, uint64_t numStreams) {
   TRI_ASSERT(_users > 0);
   CollectionIterator* cIter{nullptr};
   auto guard = scopeGuard([&]{
@@ -257,8 +285,16 @@ RocksDBReplicationContext::DumpResult
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
     
+    if (numStreams == 0 || stream >= numStreams) {
+      return DumpResult(TRI_ERROR_BAD_PARAMETER);
+    }
+
     MUTEX_LOCKER(writeLocker, _contextLock);
-    cIter = getCollectionIterator(vocbase, cid, /*sorted*/false, /*create*/true);
+    if (numStreams == 1) {
+      cIter = getCollectionIterator(vocbase, cid, /*sorted*/false, /*create*/true);
+    } else {
+      cIter = getStreamIterator(vocbase, cid, stream, numStreams);
+    }
     if (!cIter || cIter->sorted() || !cIter->iter) {
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
@@ -283,14 +319,16 @@ RocksDBReplicationContext::DumpResult
   if (hasMore) {
     cIter->currentTick++;
   }
-  return DumpResult(TRI_ERROR_NO_ERROR, hasMore, cIter->currentTick);
+  return DumpResult(TRI_ERROR_NO_ERROR, hasMore, cIter->currentTick,
+                    cIter->numberStreams);
 }
 
 // iterates over at most 'limit' documents in the collection specified,
 // creating a new iterator if one does not exist for this collection
 RocksDBReplicationContext::DumpResult
   RocksDBReplicationContext::dumpVPack(TRI_vocbase_t& vocbase, std::string const& cname,
-                                       VPackBuffer<uint8_t>& buffer, uint64_t chunkSize) {
+                                       VPackBuffer<uint8_t>& buffer, uint64_t chunkSize,
+                                       uint64_t stream, uint64_t numStreams) {
   TRI_ASSERT(_users > 0 && chunkSize > 0);
 
   CollectionIterator* cIter{nullptr};
@@ -304,8 +342,16 @@ RocksDBReplicationContext::DumpResult
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
     
+    if (numStreams == 0 || stream >= numStreams) {
+      return DumpResult(TRI_ERROR_BAD_PARAMETER);
+    }
+
     MUTEX_LOCKER(writeLocker, _contextLock);
-    cIter = getCollectionIterator(vocbase, cid, /*sorted*/false, /*create*/true);
+    if (numStreams == 1) {
+      cIter = getCollectionIterator(vocbase, cid, /*sorted*/false, /*create*/true);
+    } else {
+      cIter = getStreamIterator(vocbase, cid, stream, numStreams);
+    }
     if (!cIter || cIter->sorted() || !cIter->iter) {
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
@@ -328,7 +374,8 @@ RocksDBReplicationContext::DumpResult
   if (hasMore) {
     cIter->currentTick++;
   }
-  return DumpResult(TRI_ERROR_NO_ERROR, hasMore, cIter->currentTick);
+  return DumpResult(TRI_ERROR_NO_ERROR, hasMore, cIter->currentTick,
+                    cIter->numberStreams);
 }
 
 /// Dump all key chunks for the bound collection
@@ -358,17 +405,28 @@ arangodb::Result RocksDBReplicationContext::dumpKeyChunks(TRI_vocbase_t& vocbase
   TRI_ASSERT(cIter->lastSortedIteratorOffset == 0);
   TRI_ASSERT(cIter->bounds.columnFamily() == RocksDBColumnFamily::primary());
   
+  auto* rcoll = static_cast<RocksDBCollection*>(cIter->logical->getPhysical());
+
+  // the chunks of a collection which was not modified since they were last
+  // computed need not be hashed again
+  auto chunks = rcoll->cachedKeyChunks(_snapshot, chunkSize);
+  if (chunks != nullptr) {
+    b.add(chunks->slice());
+    return rv;
+  }
+  rocksdb::SequenceNumber const lastWrite = rcoll->keyChunksLastWrite();
+  chunks = std::make_shared<VPackBuilder>();
+
   // reserve some space in the result builder to avoid frequent reallocations
-  b.reserve(8192);
+  chunks->reserve(8192);
   char ridBuffer[21]; // temporary buffer for stringifying revision ids
   RocksDBKey docKey;
   VPackBuilder tmpHashBuilder;
   rocksdb::TransactionDB* db = globalRocksDB();
-  auto* rcoll = static_cast<RocksDBCollection*>(cIter->logical->getPhysical());
   const uint64_t cObjectId = rcoll->objectId();
   uint64_t snapNumDocs = 0;
   
-  b.openArray(true);
+  chunks->openArray(true);
   while (cIter->hasMore()) {
     // needs to be a strings because rocksdb::Slice gets invalidated
     std::string lowKey, highKey;
@@ -422,13 +480,15 @@ arangodb::Result RocksDBReplicationContext::dumpKeyChunks(TRI_vocbase_t& vocbase
       break;
     }
     TRI_ASSERT(!highKey.empty());
-    b.add(VPackValue(VPackValueType::Object));
-    b.add("low", VPackValue(lowKey));
-    b.add("high", VPackValue(highKey));
-    b.add("hash", VPackValue(std::to_string(hash)));
-    b.close();
+    chunks->add(VPackValue(VPackValueType::Object));
+    chunks->add("low", VPackValue(lowKey));
+    chunks->add("high", VPackValue(highKey));
+    chunks->add("hash", VPackValue(std::to_string(hash)));
+    chunks->close();
   }
-  b.close();
+  chunks->close();
+  b.add(chunks->slice());
+  rcoll->cacheKeyChunks(_snapshot, chunkSize, lastWrite, std::move(chunks));
 
   // reset so the next caller can dumpKeys from arbitrary location
   cIter->resetToStart();
@@ -734,11 +794,7 @@ void RocksDBReplicationContext::use(double ttl) {
   _expires = TRI_microtime() + ttl;
 
   // make sure the WAL files are not deleted
-  std::set<TRI_vocbase_t*> dbs;
-  for (auto& pair : _iterators) {
-    dbs.emplace(&pair.second->vocbase);
-  }
-  for (TRI_vocbase_t* vocbase : dbs) {
+  for (TRI_vocbase_t* vocbase : usedDatabases()) {
     vocbase->updateReplicationClient(replicationClientId(), _snapshotTick, ttl);
   }
 }
@@ -752,13 +808,21 @@ void RocksDBReplicationContext::release() {
 
   TRI_ASSERT(_ttl > 0);
   // make sure the WAL files are not deleted immediately
+  for (TRI_vocbase_t* vocbase : usedDatabases()) {
+    vocbase->updateReplicationClient(replicationClientId(), _snapshotTick, ttl);
+  }
+}
+
+std::set<TRI_vocbase_t*> RocksDBReplicationContext::usedDatabases() const {
+  _contextLock.assertLockedByCurrentThread();
   std::set<TRI_vocbase_t*> dbs;
   for (auto& pair : _iterators) {
     dbs.emplace(&pair.second->vocbase);
   }
-  for (TRI_vocbase_t* vocbase : dbs) {
-    vocbase->updateReplicationClient(replicationClientId(), _snapshotTick, ttl);
+  for (auto& pair : _streamIterators) {
+    dbs.emplace(&pair.second->vocbase);
   }
+  return dbs;
 }
 
 /// extend without using the context
@@ -791,11 +855,13 @@ RocksDBReplicationContext::CollectionIterator::CollectionIterator(
       vpackOptions{Options::Defaults},
       numberDocuments{0},
       isNumberDocumentsExclusive{false},
+      numberStreams{1},
       _resolver(vocbase),
       _cTypeHandler{},
       _readOptions{},
       _isUsed{false},
-      _sortedIterator{!sorted} // this makes sure that setSorted works
+      _sortedIterator{!sorted}, // this makes sure that setSorted works
+      _partitioned{false}
 {
   TRI_ASSERT(snapshot != nullptr && coll);
   _readOptions.snapshot = snapshot;
@@ -851,6 +917,22 @@ void RocksDBReplicationContext::CollectionIterator::setSorted(bool sorted) {
   }
 }
 
+void RocksDBReplicationContext::CollectionIterator::setPartition(
+    RocksDBKeyBounds const& partition) {
+  TRI_ASSERT(!_sortedIterator);
+  TRI_ASSERT(partition.columnFamily() == RocksDBColumnFamily::documents());
+  iter.reset();
+  _partitioned = true;
+  bounds = partition;
+  _upperLimit = bounds.end();
+  _readOptions.iterate_upper_bound = &_upperLimit;
+  iter.reset(rocksutils::globalRocksDB()->NewIterator(_readOptions,
+                                                      bounds.columnFamily()));
+  TRI_ASSERT(iter);
+  iter->Seek(bounds.start());
+  currentTick = 1;
+}
+
 // iterator convenience methods
 
 bool RocksDBReplicationContext::CollectionIterator::hasMore() const {
@@ -937,7 +1019,87 @@ RocksDBReplicationContext::getCollectionIterator(TRI_vocbase_t& vocbase,
   return cIter;
 }
 
+RocksDBReplicationContext::CollectionIterator*
+RocksDBReplicationContext::getStreamIterator(TRI_vocbase_t& vocbase,
+                                             TRI_voc_cid_t cid,
+                                             uint64_t stream,
+                                             uint64_t numStreams) {
+  _contextLock.assertLockedByCurrentThread();
+  TRI_ASSERT(stream < numStreams);
+  lazyCreateSnapshot();
+
+  // the streams of a collection must all use the same key ranges
+  auto first = _streamIterators.lower_bound(std::make_pair(cid, uint64_t(0)));
+  auto last = _streamIterators.lower_bound(std::make_pair(cid + 1, uint64_t(0)));
+  if (first != last) {
+    auto it = _streamIterators.find(std::make_pair(cid, stream));
+    if (it == _streamIterators.end() ||
+        static_cast<uint64_t>(std::distance(first, last)) != numStreams ||
+        it->second->isUsed()) {
+      // streams with a different number of streams exist, or the stream
+      // is concurrently used
+      return nullptr;
+    }
+    CollectionIterator* cIter = it->second.get();
+    TRI_ASSERT(cIter->vocbase.id() == vocbase.id());
+    cIter->use();
+    cIter->vocbase.updateReplicationClient(replicationClientId(), _snapshotTick, _ttl);
+    return cIter;
+  }
+
+  std::shared_ptr<LogicalCollection> logical{vocbase.lookupCollection(cid)};
+  if (nullptr == logical) {
+    return nullptr;
+  }
+
+  auto* rcoll = static_cast<RocksDBCollection*>(logical->getPhysical());
+  rocksdb::ReadOptions ro;
+  ro.snapshot = _snapshot;
+  std::vector<RocksDBKeyBounds> partitions =
+      rcoll->partitionDocuments(ro, static_cast<size_t>(numStreams));
+  // small collections may have less partitions than streams. the
+  // remaining streams are empty
+  uint64_t const numberStreams = partitions.size();
+  while (partitions.size() < numStreams) {
+    partitions.emplace_back(
+        RocksDBKeyBounds::CollectionDocuments(rcoll->objectId(), 0, 0));
+  }
+
+  for (uint64_t i = 0; i < numStreams; ++i) {
+    auto cIter = std::make_unique<CollectionIterator>(vocbase, logical,
+                                                      /*sorted*/ false, _snapshot);
+    cIter->setPartition(partitions[i]);
+    cIter->numberStreams = numberStreams;
+    _streamIterators.emplace(std::make_pair(cid, i), std::move(cIter));
+  }
+
+  CollectionIterator* cIter = _streamIterators[std::make_pair(cid, stream)].get();
+  cIter->use();
+  cIter->vocbase.updateReplicationClient(replicationClientId(), _snapshotTick, _ttl);
+  return cIter;
+}
+
 void RocksDBReplicationContext::releaseDumpIterator(CollectionIterator* it) {
+  if (it && it->partitioned()) {
+    // one stream of a split dump. the streams are dropped together once
+    // all of them are exhausted
+    TRI_ASSERT(it->isUsed());
+    TRI_voc_cid_t cid = it->logical->id();
+    if (!it->hasMore()) {
+      it->vocbase.updateReplicationClient(replicationClientId(), _snapshotTick, _ttl);
+    }
+    MUTEX_LOCKER(locker, _contextLock);
+    it->release();
+    auto first = _streamIterators.lower_bound(std::make_pair(cid, uint64_t(0)));
+    auto last = _streamIterators.lower_bound(std::make_pair(cid + 1, uint64_t(0)));
+    for (auto s = first; s != last; ++s) {
+      if (s->second->isUsed() || s->second->hasMore()) {
+        return;
+      }
+    }
+    _streamIterators.erase(first, last);
+    return;
+  }
   if (it) {
     TRI_ASSERT(it->isUsed());
     if (!it->hasMore()) {
@@ -81,10 +81,16 @@ class RocksDBReplicationContext {
     uint64_t numberDocuments;
     /// @brief snapshot and number documents were fetched exclusively
     bool isNumberDocumentsExclusive;
+    /// @brief number of streams of a split dump which contain documents
+    uint64_t numberStreams;
 
     rocksdb::ReadOptions const& readOptions() const { return _readOptions; }
     bool sorted() const { return _sortedIterator; }
     void setSorted(bool);
+    /// @brief restrict an unsorted iterator to a part of the documents
+    void setPartition(RocksDBKeyBounds const&);
+    /// @brief whether the iterator is one stream of a split dump
+    bool partitioned() const { return _partitioned; }
     
     void use() noexcept {
       TRI_ASSERT(!isUsed());
@@ -116,6 +122,8 @@ class RocksDBReplicationContext {
     std::atomic<bool> _isUsed;
     /// primary-index sorted iterator
     bool _sortedIterator;
+    /// restricted to a part of the documents
+    bool _partitioned;
   };
 
  public:
@@ -145,22 +153,30 @@ class RocksDBReplicationContext {
   
   struct DumpResult : arangodb::Result {
     DumpResult(int res)
-      : Result(res), hasMore(false), includedTick(0) {}
-    DumpResult(int res, bool hm, uint64_t tick)
-      : Result(res), hasMore(hm), includedTick(tick) {}
+      : Result(res), hasMore(false), includedTick(0), streams(1) {}
+    DumpResult(int res, bool hm, uint64_t tick, uint64_t streams = 1)
+      : Result(res), hasMore(hm), includedTick(tick), streams(streams) {}
     bool hasMore;
     uint64_t includedTick; // tick increases for each fetch
+    uint64_t streams; // streams of a split dump which contain documents
   };
 
   // iterates over at most 'limit' documents in the collection specified,
-  // creating a new iterator if one does not exist for this collection
+  // creating a new iterator if one does not exist for this collection.
+  // with numStreams > 1 the documents are split into numStreams disjoint
+  // key ranges, and only the range with the number stream is dumped. all
+  // streams read from the snapshot of this context and can be used
+  // concurrently
   DumpResult dumpJson(TRI_vocbase_t& vocbase, std::string const& cname,
-                      basics::StringBuffer&, uint64_t chunkSize);
+                      basics::StringBuffer&, uint64_t chunkSize,
+                      uint64_t stream = 0, uint64_t numStreams = 1);
 
   // iterates over at most 'limit' documents in the collection specified,
-  // creating a new iterator if one does not exist for this collection
+  // creating a new iterator if one does not exist for this collection.
+  // see dumpJson for the streams
   DumpResult dumpVPack(TRI_vocbase_t& vocbase, std::string const& cname,
-                       velocypack::Buffer<uint8_t>& buffer, uint64_t chunkSize);
+                       velocypack::Buffer<uint8_t>& buffer, uint64_t chunkSize,
+                       uint64_t stream = 0, uint64_t numStreams = 1);
 
   // ==================== Incremental Sync ===========================
 
@@ -206,7 +222,16 @@ class RocksDBReplicationContext {
                                             bool sorted,
                                             bool allowCreate);
   
+  /// @brief iterator for one stream of a collection dump. the iterators
+  /// of all streams of the collection are created together
+  CollectionIterator* getStreamIterator(TRI_vocbase_t& vocbase,
+                                        TRI_voc_cid_t cid, uint64_t stream,
+                                        uint64_t numStreams);
+
   void releaseDumpIterator(CollectionIterator*);
+
+  /// @brief all databases which are used by iterators
+  std::set<TRI_vocbase_t*> usedDatabases() const;
   
  private:
   
@@ -217,6 +242,10 @@ class RocksDBReplicationContext {
   uint64_t _snapshotTick; // tick in WAL from _snapshot
   rocksdb::Snapshot const* _snapshot;
   std::map<TRI_voc_cid_t, std::unique_ptr<CollectionIterator>> _iterators;
+  /// @brief iterators of dumps split into several streams, by collection
+  /// and stream number
+  std::map<std::pair<TRI_voc_cid_t, uint64_t>,
+           std::unique_ptr<CollectionIterator>> _streamIterators;
 
   double const _ttl;
   /// @brief expiration time, updated under lock by ReplicationManager
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBRestBackupHandler.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/VelocyPackHelper.h"
+#include "RocksDBEngine/RocksDBCommon.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBHotBackup.h"
+#include "Utils/ExecContext.h"
+#include "VocBase/ticks.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+RocksDBRestBackupHandler::RocksDBRestBackupHandler(GeneralRequest* request,
+                                                   GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+RestStatus RocksDBRestBackupHandler::execute() {
+  if (ExecContext::CURRENT != nullptr &&
+      !ExecContext::CURRENT->isAdminUser()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return RestStatus::DONE;
+  }
+
+  std::vector<std::string> const& suffixes = _request->suffixes();
+  auto const type = _request->requestType();
+
+  if (suffixes.empty()) {
+    if (type == rest::RequestType::GET) {
+      list();
+      return RestStatus::DONE;
+    }
+  } else if (suffixes.size() == 1) {
+    if (type == rest::RequestType::DELETE_REQ) {
+      remove(suffixes[0]);
+      return RestStatus::DONE;
+    }
+    if (type == rest::RequestType::POST) {
+      VPackSlice body;
+      try {
+        body = _request->payload();
+      } catch (...) {
+      }
+      if (body.isNone()) {
+        body = VPackSlice::emptyObjectSlice();
+      } else if (!body.isObject()) {
+        generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                      "invalid body value. expecting object");
+        return RestStatus::DONE;
+      }
+
+      std::string const& operation = suffixes[0];
+      if (operation == "create") {
+        create(body);
+      } else if (operation == "pause") {
+        pause(body);
+      } else if (operation == "resume") {
+        resume();
+      } else if (operation == "restore") {
+        restore(body);
+      } else {
+        generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                      "expecting /_admin/backup/<operation>");
+      }
+      return RestStatus::DONE;
+    }
+  } else {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting /_admin/backup/<operation>");
+    return RestStatus::DONE;
+  }
+
+  generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+  return RestStatus::DONE;
+}
+
+void RocksDBRestBackupHandler::list() {
+  RocksDBHotBackup* hotBackup = rocksutils::globalRocksEngine()->hotBackup();
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("commitsPaused", VPackValue(hotBackup->commitsPaused()));
+  builder.add("backups", VPackValue(VPackValueType::Array));
+  hotBackup->list(builder);
+  builder.close();
+  builder.close();
+  generateResult(rest::ResponseCode::OK, builder.slice());
+}
+
+void RocksDBRestBackupHandler::create(VPackSlice body) {
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  RocksDBHotBackup* hotBackup = engine->hotBackup();
+
+  std::string label = basics::VelocyPackHelper::getStringValue(
+      body, "label", std::to_string(TRI_NewTickServer()));
+  VPackSlice meta = body.get("meta");
+
+  // with "paused", the caller has paused the commits of several servers,
+  // and the pause has to outlast the creation of the checkpoint
+  bool paused = basics::VelocyPackHelper::getBooleanValue(body, "paused", false);
+  if (paused && !hotBackup->commitsPaused()) {
+    generateError(Result(TRI_ERROR_LOCK_TIMEOUT, "commits are not paused"));
+    return;
+  }
+
+  Result res;
+  bool const pauseHere = !paused && !hotBackup->commitsPaused();
+  if (pauseHere) {
+    double timeout = basics::VelocyPackHelper::getNumericValue<double>(
+        body, "timeout", 5.0);
+    res = hotBackup->pauseCommits(RocksDBHotBackup::DefaultPauseTtl, timeout);
+    if (res.fail()) {
+      generateError(res);
+      return;
+    }
+  }
+
+  {
+    auto guard = scopeGuard([hotBackup, pauseHere]() {
+      if (pauseHere) {
+        hotBackup->resumeCommits();
+      }
+    });
+    res = engine->createHotBackup(label, meta);
+  }
+
+  if (res.ok() && paused && !hotBackup->commitsPaused()) {
+    // the pause expired while the checkpoint was created, so commits may
+    // have slipped into this backup but not into those of other servers
+    hotBackup->remove(label);
+    res.reset(TRI_ERROR_LOCK_TIMEOUT,
+              "commits were resumed before the backup was complete");
+  }
+
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("label", VPackValue(label));
+  builder.close();
+  generateResult(rest::ResponseCode::CREATED, builder.slice());
+}
+
+void RocksDBRestBackupHandler::pause(VPackSlice body) {
+  double ttl = basics::VelocyPackHelper::getNumericValue<double>(
+      body, "ttl", RocksDBHotBackup::DefaultPauseTtl);
+  double timeout =
+      basics::VelocyPackHelper::getNumericValue<double>(body, "timeout", 5.0);
+
+  Result res =
+      rocksutils::globalRocksEngine()->hotBackup()->pauseCommits(ttl, timeout);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+  generateResult(rest::ResponseCode::OK, VPackSlice::emptyObjectSlice());
+}
+
+void RocksDBRestBackupHandler::resume() {
+  rocksutils::globalRocksEngine()->hotBackup()->resumeCommits();
+  generateResult(rest::ResponseCode::OK, VPackSlice::emptyObjectSlice());
+}
+
+void RocksDBRestBackupHandler::restore(VPackSlice body) {
+  std::string label =
+      basics::VelocyPackHelper::getStringValue(body, "label", "");
+
+  Result res =
+      rocksutils::globalRocksEngine()->hotBackup()->requestRestore(label);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("label", VPackValue(label));
+  builder.add("restartRequired", VPackValue(true));
+  builder.close();
+  generateResult(rest::ResponseCode::OK, builder.slice());
+}
+
+void RocksDBRestBackupHandler::remove(std::string const& label) {
+  Result res = rocksutils::globalRocksEngine()->hotBackup()->remove(label);
+  if (res.fail()) {
+    generateError(res);
+    return;
+  }
+  generateResult(rest::ResponseCode::OK, VPackSlice::emptyObjectSlice());
+}
@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ROCKSDB_REST_BACKUP_HANDLER_H
+#define ARANGOD_ROCKSDB_ROCKSDB_REST_BACKUP_HANDLER_H 1
+
+#include "Basics/Common.h"
+#include "RestHandler/RestBaseHandler.h"
+
+namespace arangodb {
+
+/// @brief hot backups of a single server or DB server:
+///   GET    /_admin/backup          lists the backups
+///   POST   /_admin/backup/create   creates a backup {label, paused, meta}
+///   POST   /_admin/backup/pause    pauses commits {ttl, timeout}
+///   POST   /_admin/backup/resume   resumes commits
+///   POST   /_admin/backup/restore  restores a backup on restart {label}
+///   DELETE /_admin/backup/<label>  removes a backup
+class RocksDBRestBackupHandler : public RestBaseHandler {
+ public:
+  RocksDBRestBackupHandler(GeneralRequest*, GeneralResponse*);
+
+ public:
+  RequestLane lane() const override final { return RequestLane::SERVER_REPLICATION; }
+  RestStatus execute() override final;
+  char const* name() const override final { return "RocksDBRestBackupHandler"; }
+
+ private:
+  void list();
+  void create(velocypack::Slice body);
+  void pause(velocypack::Slice body);
+  void resume();
+  void restore(velocypack::Slice body);
+  void remove(std::string const& label);
+};
+}
+
+#endif
@@ -27,6 +27,7 @@
 #include "GeneralServer/RestHandlerFactory.h"
 #include "RestHandler/RestHandlerCreator.h"
 #include "RestServer/QueryRegistryFeature.h"
+#include "RocksDBEngine/RocksDBRestBackupHandler.h"
 #include "RocksDBEngine/RocksDBRestCollectionHandler.h"
 #include "RocksDBEngine/RocksDBRestExportHandler.h"
 #include "RocksDBEngine/RocksDBRestReplicationHandler.h"
@@ -44,4 +45,5 @@ void RocksDBRestHandlers::registerResources(
   handlerFactory->addPrefixHandler("/_api/replication",
                                    RestHandlerCreator<RocksDBRestReplicationHandler>::createNoData);
   handlerFactory->addPrefixHandler("/_admin/wal", RestHandlerCreator<RocksDBRestWalHandler>::createNoData);
+  handlerFactory->addPrefixHandler("/_admin/backup", RestHandlerCreator<RocksDBRestBackupHandler>::createNoData);
 }
@@ -697,6 +697,16 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     return;
   }
 
+  // a dump can be split into several streams, which can be fetched
+  // concurrently. all streams use the snapshot of the context
+  uint64_t const numStreams = _request->parsedValue<uint64_t>("streams", 1);
+  uint64_t const stream = _request->parsedValue<uint64_t>("stream", 0);
+  if (numStreams == 0 || stream >= numStreams) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "invalid stream parameter");
+    return;
+  }
+
   uint64_t chunkSize = determineChunkSize();
   size_t reserve = std::max<size_t>(chunkSize, 8192);
 
@@ -706,7 +716,7 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     VPackBuffer<uint8_t> buffer;
     buffer.reserve(reserve); // avoid reallocs
 
-    res = ctx->dumpVPack(_vocbase, cname, buffer, chunkSize);
+    res = ctx->dumpVPack(_vocbase, cname, buffer, chunkSize, stream, numStreams);
     // generate the result
     if (res.fail()) {
       generateError(res);
@@ -725,6 +735,8 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
 
     _response->setHeaderNC(StaticStrings::ReplicationHeaderLastIncluded,
                            StringUtils::itoa(buffer.empty() ? 0 : res.includedTick));
+    _response->setHeaderNC(StaticStrings::ReplicationHeaderStreams,
+                           StringUtils::itoa(res.streams));
 
   } else {
     auto response = dynamic_cast<HttpResponse*>(_response.get());
@@ -734,7 +746,8 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     }
 
     // do the work!
-    res = ctx->dumpJson(_vocbase, cname, dump, determineChunkSize());
+    res = ctx->dumpJson(_vocbase, cname, dump, determineChunkSize(), stream,
+                        numStreams);
 
     if (res.fail()) {
       if (res.is(TRI_ERROR_BAD_PARAMETER)) {
@@ -761,11 +774,18 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
                            (res.hasMore ? "true" : "false"));
     _response->setHeaderNC(StaticStrings::ReplicationHeaderLastIncluded,
                            StringUtils::itoa((dump.length() == 0) ? 0 : res.includedTick));
+    _response->setHeaderNC(StaticStrings::ReplicationHeaderStreams,
+                           StringUtils::itoa(res.streams));
 
     // transfer ownership of the buffer contents
     response->body().set(dump.stringBuffer());
 
     // avoid double freeing
     TRI_StealStringBuffer(dump.stringBuffer());
+
+    int r = deflateDump(*response);
+    if (r != TRI_ERROR_NO_ERROR) {
+      generateError(rest::ResponseCode::SERVER_ERROR, r);
+    }
   }
 }
@@ -36,37 +36,69 @@ RocksDBSyncThread::RocksDBSyncThread(RocksDBEngine* engine, std::chrono::millise
       _engine(engine),
       _interval(interval),
       _lastSyncTime(std::chrono::steady_clock::now()),
-      _lastSequenceNumber(0) {}
+      _lastSequenceNumber(0),
+      _syncing(false) {}
 
 RocksDBSyncThread::~RocksDBSyncThread() { shutdown(); }
 
 Result RocksDBSyncThread::syncWal() {
+  return syncWal(_engine->db()->GetBaseDB()->GetLatestSequenceNumber());
+}
+
+Result RocksDBSyncThread::syncWal(rocksdb::SequenceNumber seq) {
   // note the following line in RocksDB documentation (rocksdb/db.h):
   // > Currently only works if allow_mmap_writes = false in Options.
   TRI_ASSERT(!_engine->rocksDBOptions().allow_mmap_writes);
 
   auto db = _engine->db()->GetBaseDB();
 
-  // set time of last syncing under the lock
-  auto const now = std::chrono::steady_clock::now();
-  {
-    CONDITION_LOCKER(guard, _condition);
-
-    if (now > _lastSyncTime) {
-      // update last sync time...
-      _lastSyncTime = now;
+  CONDITION_LOCKER(guard, _condition);
+  while (true) {
+    if (_lastSequenceNumber >= seq) {
+      // a sync of another thread has covered our writes
+      return Result();
     }
-
-    auto lastSequenceNumber = db->GetLatestSequenceNumber();
-
-    if (lastSequenceNumber > _lastSequenceNumber) {
-      // update last sequence number
-      _lastSequenceNumber = lastSequenceNumber;
+    if (!_syncing) {
+      break;
     }
+    // wait for the running sync. it may not include our writes, because
+    // it was started before them
+    guard.wait();
   }
 
+  // sync all writes made so far, including the ones of all threads which
+  // are waiting for us
+  _syncing = true;
+  auto const now = std::chrono::steady_clock::now();
+  if (now > _lastSyncTime) {
+    // update last sync time...
+    _lastSyncTime = now;
+  }
+  auto const lastSequenceNumber = db->GetLatestSequenceNumber();
+  TRI_ASSERT(lastSequenceNumber >= seq);
+
   // actual syncing is done without holding the lock
-  return sync(db);
+  guard.unlock();
+  Result res;
+  try {
+    res = sync(db);
+  } catch (...) {
+    guard.lock();
+    _syncing = false;
+    guard.broadcast();
+    throw;
+  }
+  guard.lock();
+
+  _syncing = false;
+  if (res.ok() && lastSequenceNumber > _lastSequenceNumber) {
+    // update last sequence number
+    _lastSequenceNumber = lastSequenceNumber;
+  }
+  // wake up the waiting threads. if the sync failed, the next one of them
+  // tries again
+  guard.broadcast();
+  return res;
 }
 
 Result RocksDBSyncThread::sync(rocksdb::DB* db) {
@@ -119,20 +151,16 @@ void RocksDBSyncThread::run() {
           continue;
         }
 
-        _lastSyncTime = std::chrono::steady_clock::now();
-
-        auto lastSequenceNumber = db->GetLatestSequenceNumber();
-
-        if (lastSequenceNumber == previousLastSequenceNumber) {
+        if (db->GetLatestSequenceNumber() == previousLastSequenceNumber) {
           // nothing to sync, so don't cause unnecessary load
+          _lastSyncTime = std::chrono::steady_clock::now();
           continue;
         }
-
-        _lastSequenceNumber = lastSequenceNumber;
       }
 
-      // will update last sync time, and do the actual sync
-      Result res = sync(db);
+      // will update last sync time, and do the actual sync together with
+      // concurrent committers
+      Result res = syncWal();
 
       if (res.fail()) {
         LOG_TOPIC(WARN, Logger::ENGINES)
@@ -52,6 +52,12 @@ class RocksDBSyncThread final : public Thread {
   /// this is the preferred method to call when trying to avoid redundant
   /// syncs by foreground work and the background sync thread
   Result syncWal();
+
+  /// @brief makes sure the WAL is synced up to sequence number seq.
+  /// concurrent callers are grouped: while one sync is running, all others
+  /// wait for it. if it did not cover their writes, one of them syncs all
+  /// writes made so far for the whole group
+  Result syncWal(rocksdb::SequenceNumber seq);
   
   /// @brief unconditionally syncs the RocksDB WAL, static variant
   static Result sync(rocksdb::DB* db);
@@ -71,7 +77,10 @@ class RocksDBSyncThread final : public Thread {
   /// @brief the last definitely synced RocksDB WAL sequence number
   rocksdb::SequenceNumber _lastSequenceNumber;
 
-  /// @brief protected _lastSyncTime and _lastSequenceNumber
+  /// @brief whether a sync is currently running
+  bool _syncing;
+
+  /// @brief protected _lastSyncTime, _lastSequenceNumber and _syncing
   arangodb::basics::ConditionVariable _condition;
 };
 }  // namespace arangodb
@@ -43,6 +43,9 @@
 #include "Basics/MutexLocker.h"
 #include "Logger/Logger.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
 namespace arangodb {
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,7 +97,8 @@ thread_local uint8_t gFlushStart[sizeof(std::chrono::steady_clock::time_point)];
 //
 RocksDBThrottle::RocksDBThrottle()
   : _internalRocksDB(nullptr), _threadRunning(false), _replaceIdx(2),
-    _throttleBps(0), _firstThrottle(true)
+    _throttleBps(0), _firstThrottle(true), _backlog(0), _level0Files(0),
+    _pendingCompactionBytes(0), _lowPriBps(0)
 {
   memset(&_throttleData, 0, sizeof(_throttleData));
 }
@@ -234,8 +238,10 @@ void RocksDBThrottle::SetThrottleWriteRate(std::chrono::microseconds Micros,
 
 
 void RocksDBThrottle::ThreadLoop() {
+  unsigned tick;
 
   _replaceIdx=2;
+  tick=0;
 
   // addresses race condition during fast start/stop
   {
@@ -253,23 +259,31 @@ void RocksDBThrottle::ThreadLoop() {
     // start actual throttle work
     //
     try {
-      RecalculateThrottle();
+      if (0==tick) {
+        RecalculateThrottle();
+
+        ++_replaceIdx;
+        if (THROTTLE_INTERVALS==_replaceIdx)
+          _replaceIdx=2;
+      } else {
+        ApplyBacklog();
+      } // else
     } catch (...) {
       LOG_TOPIC(ERR, arangodb::Logger::ENGINES)
           << "RecalculateThrottle() sent a throw. RocksDB?";
       _threadRunning.store(false);
     } // try/catchxs
 
-    ++_replaceIdx;
-    if (THROTTLE_INTERVALS==_replaceIdx)
-      _replaceIdx=2;
+    ++tick;
+    if (THROTTLE_SECONDS/THROTTLE_TICK_SECONDS==tick)
+      tick=0;
 
     // wait on _threadCondvar
     {
       CONDITION_LOCKER(guard, _threadCondvar);
 
       if (_threadRunning.load()) { // test in case of race at shutdown
-        _threadCondvar.wait(THROTTLE_SECONDS * 1000000);
+        _threadCondvar.wait(THROTTLE_TICK_SECONDS * 1000000);
       } //if
     } // lock
   } // while
@@ -297,6 +311,7 @@ void RocksDBThrottle::RecalculateThrottle() {
   temp_rate=0;
 
   compaction_backlog = ComputeBacklog();
+  _backlog.store(compaction_backlog);
 
   {
     MUTEX_LOCKER(mutexLocker, _threadMutex);
@@ -400,6 +415,39 @@ void RocksDBThrottle::RecalculateThrottle() {
 } // RocksDBThrottle::RecalculateThrottle
 
 
+///
+/// @brief Feedback between two recalculations: each unit the backlog grew
+///  by since the last tick takes another 10% off the throttle right away.
+///  RecalculateThrottle() applies the same 10% per unit to its goal, so the
+///  throttle does not drift back up while the backlog persists.  The new
+///  rate is handed to rocksdb with the next flush or compaction.
+///
+void RocksDBThrottle::ApplyBacklog() {
+  int64_t compaction_backlog, old_backlog;
+  uint64_t adjustment_bps;
+
+  compaction_backlog = ComputeBacklog();
+  old_backlog = _backlog.exchange(compaction_backlog);
+
+  if (old_backlog < compaction_backlog) {
+    MUTEX_LOCKER(mutexLocker, _threadMutex);
+
+    if (!_firstThrottle && kMinThrottleBps < _throttleBps) {
+      adjustment_bps = (_throttleBps * (compaction_backlog - old_backlog)) / 10;
+      if (adjustment_bps + kMinThrottleBps < _throttleBps) {
+        _throttleBps -= adjustment_bps;
+      } else {
+        _throttleBps = kMinThrottleBps;
+      } // else
+
+      LOG_TOPIC(DEBUG, arangodb::Logger::ENGINES)
+        << "ApplyBacklog(): backlog " << compaction_backlog
+        << ", throttle " << _throttleBps;
+    } // if
+  } // if
+} // RocksDBThrottle::ApplyBacklog
+
+
 ///
 /// @brief Hack a throttle rate into the WriteController object
 ///
@@ -433,6 +481,16 @@ void RocksDBThrottle::SetThrottle() {
             << "SetThrottle(): set_delayed_write_rate(" << _throttleBps << ")";
           ((WriteController&)_internalRocksDB->write_controller()).set_delayed_write_rate(_throttleBps);
         } // else
+
+        // rocksdb limits writes flagged low_pri to this rate whenever
+        //  compactions are behind, even before it delays other writes
+        uint64_t low_pri_bps = std::max<uint64_t>(_throttleBps / THROTTLE_LOW_PRI_DIVISOR,
+                                                  kMinThrottleBps);
+        if (_lowPriBps.load() != low_pri_bps) {
+          ((WriteController&)_internalRocksDB->write_controller()).low_pri_rate_limiter()
+            ->SetBytesPerSecond(static_cast<int64_t>(low_pri_bps));
+          _lowPriBps.store(low_pri_bps);
+        } // if
       } else {
         _delayToken.reset();
         LOG_TOPIC(DEBUG, arangodb::Logger::ENGINES)
@@ -449,6 +507,7 @@ void RocksDBThrottle::SetThrottle() {
 ///
 int64_t RocksDBThrottle::ComputeBacklog() {
   int64_t compaction_backlog, imm_backlog, imm_trigger;
+  uint64_t level0_files, pending_bytes, pending_limit, pending_total;
   bool ret_flag;
   std::string ret_string, property_name;
   int temp;
@@ -457,6 +516,8 @@ int64_t RocksDBThrottle::ComputeBacklog() {
   //  and therefore likely to start stalling / stopping
   compaction_backlog = 0;
   imm_backlog = 0;
+  level0_files = 0;
+  pending_total = 0;
   if (_families.size()) {
     imm_trigger = _internalRocksDB->GetOptions(_families[0]).max_write_buffer_number / 2;
   } else {
@@ -473,6 +534,7 @@ int64_t RocksDBThrottle::ComputeBacklog() {
     } else {
       temp =0;
     } // else
+    level0_files += temp;
 
     if (kL0_SlowdownWritesTrigger<=temp) {
       temp -= (kL0_SlowdownWritesTrigger -1);
@@ -489,16 +551,51 @@ int64_t RocksDBThrottle::ComputeBacklog() {
       temp=std::stoi(ret_string);
       imm_backlog += temp;
     } // if
+
+    // pending compaction bytes beyond half of the soft limit, where rocksdb
+    //  starts stalling, count one unit per 10% of the limit
+    ret_flag=_internalRocksDB->GetIntProperty(cf, rocksdb::DB::Properties::kEstimatePendingCompactionBytes,
+                                              &pending_bytes);
+    if (ret_flag) {
+      pending_total += pending_bytes;
+      pending_limit = _internalRocksDB->GetOptions(cf).soft_pending_compaction_bytes_limit;
+      if (0 != pending_limit && pending_limit/2 < pending_bytes) {
+        compaction_backlog += ((pending_bytes - pending_limit/2) * 10) / pending_limit;
+      } // if
+    } // if
   } // for
 
   if (imm_trigger<imm_backlog) {
     compaction_backlog += (imm_backlog - imm_trigger);
   } // if
 
+  _level0Files.store(level0_files);
+  _pendingCompactionBytes.store(pending_total);
+
   return compaction_backlog;
 } // RocksDBThrottle::Computebacklog
 
 
+///
+/// @brief Report the throttle's state, as of the last tick of its thread
+///
+void RocksDBThrottle::GetStatistics(velocypack::Builder& builder) {
+  uint64_t throttle_bps;
+
+  {
+    MUTEX_LOCKER(mutexLocker, _threadMutex);
+    throttle_bps = _throttleBps;
+  } // lock
+
+  builder.add("throttle.bps", VPackValue(throttle_bps));
+  builder.add("throttle.low-priority-bps", VPackValue(_lowPriBps.load()));
+  builder.add("throttle.backlog", VPackValue(_backlog.load()));
+  builder.add("throttle.level0-files", VPackValue(_level0Files.load()));
+  builder.add("throttle.pending-compaction-bytes",
+              VPackValue(_pendingCompactionBytes.load()));
+} // RocksDBThrottle::GetStatistics
+
+
 /// @brief Adjust the active thread's priority to match the work
 ///  it is performing.  The routine is called HEAVILY.
 void RocksDBThrottle::AdjustThreadPriority(int Adjustment) {
@@ -62,6 +62,9 @@ using namespace rocksdb;
 #include <db/write_controller.h>
 
 namespace arangodb {
+namespace velocypack {
+class Builder;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// If these values change, make sure to reflect the changes in
@@ -91,6 +94,9 @@ public:
 
   void StopThread();
 
+  /// @brief add the current throttle state to the engine statistics
+  void GetStatistics(velocypack::Builder& builder);
+
 protected:
   void Startup(rocksdb::DB * db);
 
@@ -106,12 +112,27 @@ protected:
 
   void RecalculateThrottle();
 
+  void ApplyBacklog();
+
 
   // I am unable to figure out static initialization of std::chrono::seconds,
   //  using old school unsigned.
   static constexpr unsigned THROTTLE_SECONDS = 60;
   static constexpr unsigned THROTTLE_INTERVALS = 63;
 
+  // the backlog is checked every tick, so the throttle can react to
+  //  growing compaction debt before the next full recalculation
+  static constexpr unsigned THROTTLE_TICK_SECONDS = 1;
+
+  // low priority writes (replication, imports, restores) only get this
+  //  fraction of the throttle while compactions are behind, so they are
+  //  slowed down before regular writes
+  static constexpr unsigned THROTTLE_LOW_PRI_DIVISOR = 4;
+
+  // neither the backlog feedback nor low priority writes go below this
+  //  rate (rocksdb's default rate for low priority writes)
+  static constexpr uint64_t kMinThrottleBps = 1 << 20;
+
   // following is a heristic value, determined by trial and error.
   //  its job is slow down the rate of change in the current throttle.
   //  do not want sudden changes in one or two intervals to swing
@@ -149,6 +170,12 @@ protected:
   uint64_t _throttleBps;
   bool _firstThrottle;
 
+  // most recent backlog and its inputs, kept for the statistics
+  std::atomic<int64_t> _backlog;
+  std::atomic<uint64_t> _level0Files;
+  std::atomic<uint64_t> _pendingCompactionBytes;
+  std::atomic<uint64_t> _lowPriBps;
+
   std::unique_ptr<WriteControllerToken> _delayToken;
   std::vector<rocksdb::ColumnFamilyHandle *> _families;
 
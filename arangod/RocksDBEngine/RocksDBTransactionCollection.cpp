@@ -45,7 +45,8 @@ RocksDBTransactionCollection::RocksDBTransactionCollection(
       _numInserts(0),
       _numUpdates(0),
       _numRemoves(0),
-      _usageLocked(false) {}
+      _usageLocked(false),
+      _writePending(false) {}
 
 RocksDBTransactionCollection::~RocksDBTransactionCollection() {}
 
@@ -280,6 +281,11 @@ void RocksDBTransactionCollection::addOperation(
 void RocksDBTransactionCollection::prepareCommit(uint64_t trxId,
                                                  uint64_t preCommitSeq) {
   TRI_ASSERT(_collection != nullptr);
+  if (_numInserts != 0 || _numUpdates != 0 || _numRemoves != 0) {
+    // invalidates cached key chunks of the collection
+    static_cast<RocksDBCollection*>(_collection->getPhysical())->beginWrite();
+    _writePending = true;
+  }
   for (auto const& pair : _trackedIndexOperations) {
     auto idx = _collection->lookupIndex(pair.first);
     if (idx == nullptr) {
@@ -296,6 +302,11 @@ void RocksDBTransactionCollection::prepareCommit(uint64_t trxId,
 
 void RocksDBTransactionCollection::abortCommit(uint64_t trxId) {
   TRI_ASSERT(_collection != nullptr);
+  if (_writePending) {
+    static_cast<RocksDBCollection*>(_collection->getPhysical())
+        ->endWrite(rocksutils::latestSequenceNumber());
+    _writePending = false;
+  }
   for (auto const& pair : _trackedIndexOperations) {
     auto idx = _collection->lookupIndex(pair.first);
     if (idx == nullptr) {
@@ -314,6 +325,11 @@ void RocksDBTransactionCollection::commitCounts(uint64_t trxId,
                                                 uint64_t commitSeq) {
   TRI_ASSERT(_collection != nullptr);
 
+  if (_writePending) {
+    static_cast<RocksDBCollection*>(_collection->getPhysical())->endWrite(commitSeq);
+    _writePending = false;
+  }
+
   // Update the collection count
   int64_t const adjustment = _numInserts - _numRemoves;
   if (commitSeq != 0) { // is '0' for filling new indexes
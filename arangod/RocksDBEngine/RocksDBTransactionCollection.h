@@ -136,6 +136,8 @@ class RocksDBTransactionCollection final : public TransactionCollection {
   uint64_t _numUpdates;
   uint64_t _numRemoves;
   bool _usageLocked;
+  /// prepareCommit() announced writes to the collection
+  bool _writePending;
 
   struct IndexOperations {
     std::vector<uint64_t> inserts;
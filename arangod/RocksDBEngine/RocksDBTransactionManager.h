@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "Basics/ReadWriteLock.h"
+#include "Basics/SharedCounter.h"
 #include "StorageEngine/TransactionManager.h"
 #include "VocBase/voc-types.h"
 
@@ -33,7 +34,7 @@ namespace arangodb {
 
 class RocksDBTransactionManager final : public TransactionManager {
  public:
-  RocksDBTransactionManager() : TransactionManager(), _nrRunning(0) {}
+  RocksDBTransactionManager() : TransactionManager() {}
   ~RocksDBTransactionManager() {}
 
   // register a list of failed transactions
@@ -53,13 +54,13 @@ class RocksDBTransactionManager final : public TransactionManager {
   void registerTransaction(TRI_voc_tid_t transactionId,
                            std::unique_ptr<TransactionData> data) override {
     TRI_ASSERT(data == nullptr);
-    ++_nrRunning;
+    _nrRunning.add(1, std::memory_order_relaxed);
   }
 
   // unregister a transaction
   void unregisterTransaction(TRI_voc_tid_t transactionId,
                              bool markAsFailed) override {
-    --_nrRunning;
+    _nrRunning.sub(1, std::memory_order_relaxed);
   }
 
   // iterate all the active transactions
@@ -67,10 +68,20 @@ class RocksDBTransactionManager final : public TransactionManager {
       std::function<void(TRI_voc_tid_t, TransactionData const*)> const&
           callback) override {}
 
-  uint64_t getActiveTransactionCount() override { return _nrRunning; }
+  uint64_t getActiveTransactionCount() override {
+    // a transaction may be unregistered by another thread than the one
+    // that registered it, so single stripes can become negative and the
+    // sum may be briefly off while it is taken
+    int64_t value = _nrRunning.value(std::memory_order_relaxed);
+    return value > 0 ? static_cast<uint64_t>(value) : 0;
+  }
 
  private:
-  std::atomic<uint64_t> _nrRunning;
+  /// @brief number of running transactions. registering and unregistering
+  /// happens for every single-document operation, so the counter is striped
+  /// by thread to keep the threads from contending on one cache line. the
+  /// total is only computed for the rare callers that need it
+  basics::SharedCounter<64> _nrRunning;
 };
 }
 
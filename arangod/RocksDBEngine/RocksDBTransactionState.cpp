@@ -24,16 +24,21 @@
 #include "RocksDBTransactionState.h"
 #include "Aql/QueryCache.h"
 #include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
 #include "Cache/CacheManagerFeature.h"
 #include "Cache/Manager.h"
 #include "Cache/Transaction.h"
 #include "Logger/Logger.h"
 #include "RestServer/TransactionManagerFeature.h"
 #include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
 #include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBHotBackup.h"
 #include "RocksDBEngine/RocksDBLogValue.h"
 #include "RocksDBEngine/RocksDBMethods.h"
+#include "RocksDBEngine/RocksDBSettingsManager.h"
 #include "RocksDBEngine/RocksDBSyncThread.h"
 #include "RocksDBEngine/RocksDBTransactionCollection.h"
 #include "StorageEngine/EngineSelectorFeature.h"
@@ -46,6 +51,7 @@
 #include "VocBase/ticks.h"
 
 #include <rocksdb/options.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/status.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
 #include <rocksdb/utilities/transaction.h>
@@ -65,6 +71,7 @@ RocksDBTransactionState::RocksDBTransactionState(
 ): TransactionState(vocbase, tid, options),
       _rocksTransaction(nullptr),
       _readSnapshot(nullptr),
+      _readSnapshotTime(0.0),
       _rocksReadOptions(),
       _cacheTx(nullptr),
       _numInserts(0),
@@ -129,10 +136,15 @@ Result RocksDBTransactionState::beginTransaction(transaction::Hints hints) {
     _rocksReadOptions.prefix_same_as_start = true;  // should always be true
 
     if (isReadOnlyTransaction()) {
-      if (_readSnapshot == nullptr) { // replication may donate a snapshot
+      if (_readSnapshot == nullptr && !isSingleRead()) {
+        // replication may donate a snapshot
         _readSnapshot = db->GetSnapshot(); // must call ReleaseSnapshot later
+        TRI_ASSERT(_readSnapshot != nullptr);
+        _readSnapshotTime = TRI_microtime();
       }
-      TRI_ASSERT(_readSnapshot != nullptr);
+      // a single point lookup is consistent without a snapshot. acquiring
+      // one takes the global DB mutex, which is contended under many
+      // concurrent document reads
       _rocksReadOptions.snapshot = _readSnapshot;
       _rocksMethods.reset(new RocksDBReadOnlyMethods(this));
     } else {
@@ -149,7 +161,15 @@ Result RocksDBTransactionState::beginTransaction(transaction::Hints hints) {
       // with exlusive locking there is no chance of conflict
       // with other transactions -> we can use untracked< Put/Delete methods
       if (isExclusiveTransactionOnSingleCollection()) {
-        _rocksMethods.reset(new RocksDBTrxUntrackedMethods(this));
+        if (hasHint(transaction::Hints::Hint::BULK_LOAD)) {
+          // collect all operations and ingest them as SST files on commit
+          _bulkLoadBatch.reset(new rocksdb::WriteBatchWithIndex(
+              rocksdb::BytewiseComparator(), 0, true));
+          _rocksMethods.reset(
+              new RocksDBBatchedMethods(this, _bulkLoadBatch.get()));
+        } else {
+          _rocksMethods.reset(new RocksDBTrxUntrackedMethods(this));
+        }
       } else {
         _rocksMethods.reset(new RocksDBTrxMethods(this));
       }
@@ -203,6 +223,9 @@ void RocksDBTransactionState::createTransaction() {
 
   // start rocks transaction
   rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
+  // low priority writes are slowed down first when compactions fall behind
+  _rocksWriteOptions.low_pri =
+      hasHint(transaction::Hints::Hint::LOW_PRIORITY);
   rocksdb::TransactionOptions trxOpts;
   trxOpts.set_snapshot = true;
   // unclear performance implications do not use for now
@@ -244,6 +267,29 @@ void RocksDBTransactionState::cleanupTransaction() noexcept {
   }
 }
 
+/// @brief moves a read-only transaction on to a new snapshot once its
+/// snapshot is older than the maxSnapshotAge option. iterators that were
+/// created earlier pin the data of their own version, so they stay valid
+void RocksDBTransactionState::refreshReadSnapshot() {
+  if (_options.maxSnapshotAge <= 0.0 || !isReadOnlyTransaction() ||
+      _readSnapshot == nullptr || _readSnapshotTime == 0.0) {
+    return;
+  }
+
+  double const now = TRI_microtime();
+  if (now - _readSnapshotTime < _options.maxSnapshotAge) {
+    return;
+  }
+
+  rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
+  rocksdb::Snapshot const* snapshot = db->GetSnapshot();
+  TRI_ASSERT(snapshot != nullptr);
+  db->ReleaseSnapshot(_readSnapshot);
+  _readSnapshot = snapshot;
+  _readSnapshotTime = now;
+  _rocksReadOptions.snapshot = _readSnapshot;
+}
+
 arangodb::Result RocksDBTransactionState::internalCommit() {
   TRI_ASSERT(_rocksTransaction != nullptr);
 
@@ -258,7 +304,12 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
 
   Result result;
   if (hasOperations()) {
-    // we are actually going to attempt a commit
+    // we are actually going to attempt a commit. this waits while commits
+    // are paused for a hot backup
+    RocksDBHotBackup* hotBackup = rocksutils::globalRocksEngine()->hotBackup();
+    hotBackup->beginCommit();
+    TRI_DEFER(hotBackup->endCommit());
+
     if (!hasHint(transaction::Hints::Hint::SINGLE_OPERATION)) {
       // add custom commit marker to increase WAL tailing reliability
       auto logValue =
@@ -319,21 +370,34 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
     }
 #endif
 
-    // total number of sequence ID consuming records
-    uint64_t numOps = _rocksTransaction->GetNumPuts() +
-                      _rocksTransaction->GetNumDeletes() +
-                      _rocksTransaction->GetNumMerges();
-    // will invaliate all counts
-    result = rocksutils::convertStatus(_rocksTransaction->Commit());
-    
-    if (result.ok()) {
-      TRI_ASSERT(numOps > 0); // simon: should hold unless we're beeing stupid
-      rocksdb::SequenceNumber postCommitSeq = _rocksTransaction->GetCommitedSeqNumber();
-      if (ADB_LIKELY(numOps > 0)) {
-        postCommitSeq += numOps - 1; // add to get to the next batch
+    rocksdb::SequenceNumber postCommitSeq = 0;
+    bool ingested = false;
+    if (_bulkLoadBatch != nullptr) {
+      result = commitBulkLoad(ingested);
+      if (result.ok()) {
+        // the rocksdb transaction only contains our log markers
+        result = rocksutils::convertStatus(_rocksTransaction->Commit());
       }
-      TRI_ASSERT(postCommitSeq <= rocksutils::globalRocksDB()->GetLatestSequenceNumber());
-      
+      postCommitSeq = rocksutils::globalRocksDB()->GetLatestSequenceNumber();
+    } else {
+      // total number of sequence ID consuming records
+      uint64_t numOps = _rocksTransaction->GetNumPuts() +
+                        _rocksTransaction->GetNumDeletes() +
+                        _rocksTransaction->GetNumMerges();
+      // will invaliate all counts
+      result = rocksutils::convertStatus(_rocksTransaction->Commit());
+
+      if (result.ok()) {
+        TRI_ASSERT(numOps > 0); // simon: should hold unless we're beeing stupid
+        postCommitSeq = _rocksTransaction->GetCommitedSeqNumber();
+        if (ADB_LIKELY(numOps > 0)) {
+          postCommitSeq += numOps - 1; // add to get to the next batch
+        }
+        TRI_ASSERT(postCommitSeq <= rocksutils::globalRocksDB()->GetLatestSequenceNumber());
+      }
+    }
+
+    if (result.ok()) {
       for (auto& trxCollection : _collections) {
         RocksDBTransactionCollection* collection =
             static_cast<RocksDBTransactionCollection*>(trxCollection);
@@ -348,14 +412,31 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
         committed = true;
       }
 
+      if (ingested) {
+        // the recovery rebuilds counts and index estimates from the WAL,
+        // which does not contain the ingested data. so persist them now
+        Result res =
+            rocksutils::globalRocksEngine()->settingsManager()->sync(true);
+        if (res.fail()) {
+          LOG_TOPIC(WARN, Logger::ENGINES)
+              << "unable to sync counts after bulk load of transaction "
+              << id() << ": " << res.errorMessage();
+          result = res;
+        }
+      }
+
+      // wake up followers which wait for new writes
+      rocksutils::globalRocksEngine()->notifyWalWrites();
+
 #ifndef _WIN32
       // wait for sync if required, for all other platforms but Windows
       if (waitForSync()) {
         RocksDBEngine* engine = static_cast<RocksDBEngine*>(EngineSelectorFeature::ENGINE);
         TRI_ASSERT(engine != nullptr);
         if (engine->syncThread()) {
-          // we do have a sync thread
-          result = engine->syncThread()->syncWal();
+          // we do have a sync thread. it batches the syncs of concurrent
+          // commits, so we only wait until our own writes are durable
+          result = engine->syncThread()->syncWal(postCommitSeq);
         } else {
           // no sync thread present... this may be the case if automatic
           // syncing is completely turned off. in this case, use the
@@ -387,6 +468,118 @@ arangodb::Result RocksDBTransactionState::internalCommit() {
   return result;
 }
 
+/// @brief write the operations of a bulk load transaction into one SST file
+/// per column family and ingest these, bypassing the WAL and the memtables.
+/// all files are written before the first one is ingested. if a file cannot
+/// be written or ingested, the whole batch is written regularly instead.
+/// this also repairs the column families that were already ingested, as
+/// applying the operations twice does not matter. ingested is set to true if
+/// at least one file was ingested
+arangodb::Result RocksDBTransactionState::commitBulkLoad(bool& ingested) {
+  TRI_ASSERT(_bulkLoadBatch != nullptr);
+  RocksDBEngine* engine = rocksutils::globalRocksEngine();
+  rocksdb::TransactionDB* db = rocksutils::globalRocksDB();
+  std::string const directory = engine->ingestPath();
+  ingested = false;
+
+  rocksdb::Status s;
+  if (!basics::FileUtils::isDirectory(directory)) {
+    long systemError;
+    std::string systemErrorStr;
+    if (!TRI_CreateRecursiveDirectory(directory.c_str(), systemError,
+                                      systemErrorStr)) {
+      s = rocksdb::Status::IOError(systemErrorStr);
+    }
+  }
+
+  std::vector<rocksdb::ColumnFamilyHandle*> const families = {
+      RocksDBColumnFamily::documents(), RocksDBColumnFamily::primary(),
+      RocksDBColumnFamily::edge(),      RocksDBColumnFamily::vpack(),
+      RocksDBColumnFamily::geo(),       RocksDBColumnFamily::fulltext()};
+
+  // column family and file, for all files to ingest
+  std::vector<std::pair<rocksdb::ColumnFamilyHandle*, std::string>> files;
+  auto removeFiles = [&files](size_t from) {
+    for (size_t i = from; i < files.size(); ++i) {
+      if (basics::FileUtils::exists(files[i].second)) {
+        basics::FileUtils::remove(files[i].second);
+      }
+    }
+  };
+
+  for (rocksdb::ColumnFamilyHandle* cf : families) {
+    if (!s.ok()) {
+      break;
+    }
+    // the batch only keeps the latest operation for each key, in the
+    // order of the column family's comparator
+    std::unique_ptr<rocksdb::WBWIIterator> it(_bulkLoadBatch->NewIterator(cf));
+    it->SeekToFirst();
+    if (!it->Valid()) {
+      continue;
+    }
+
+    std::string const file = basics::FileUtils::buildFilename(
+        directory, "trx-" + std::to_string(id()) + "-" +
+                       std::to_string(cf->GetID()) + ".sst");
+    files.emplace_back(cf, file);
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), db->GetOptions(cf),
+                                  cf);
+    s = writer.Open(file);
+    for (; s.ok() && it->Valid(); it->Next()) {
+      rocksdb::WriteEntry entry = it->Entry();
+      switch (entry.type) {
+        case rocksdb::kPutRecord:
+          s = writer.Put(entry.key, entry.value);
+          break;
+        case rocksdb::kDeleteRecord:
+        case rocksdb::kSingleDeleteRecord:
+          s = writer.Delete(entry.key);
+          break;
+        default:
+          s = rocksdb::Status::NotSupported("unexpected bulk load operation");
+          break;
+      }
+    }
+    if (s.ok()) {
+      s = writer.Finish();
+    }
+  }
+
+  // the bundled RocksDB version cannot ingest files into several column
+  // families atomically, so they are ingested one after the other
+  size_t numIngested = 0;
+  while (s.ok() && numIngested < files.size()) {
+    rocksdb::IngestExternalFileOptions ingestOptions;
+    ingestOptions.move_files = true;
+    s = db->IngestExternalFile(files[numIngested].first,
+                               {files[numIngested].second}, ingestOptions);
+    if (s.ok()) {
+      ++numIngested;
+    }
+  }
+  removeFiles(numIngested);
+
+  if (!s.ok()) {
+    LOG_TOPIC(WARN, Logger::ENGINES)
+        << "unable to ingest bulk load of transaction " << id() << ": "
+        << s.ToString() << ", writing it regularly instead";
+    rocksdb::WriteOptions wo;
+    s = db->GetBaseDB()->Write(wo, _bulkLoadBatch->GetWriteBatch());
+    if (!s.ok() && numIngested > 0) {
+      LOG_TOPIC(ERR, Logger::ENGINES)
+          << "bulk load of transaction " << id() << " was only partially "
+          << "ingested: " << s.ToString();
+    }
+  }
+  ingested = (numIngested > 0);
+  if (s.ok()) {
+    // allow an intermediate commit to continue with an empty batch
+    _bulkLoadBatch->Clear();
+  }
+  return rocksutils::convertStatus(s);
+}
+
 /// @brief commit a transaction
 Result RocksDBTransactionState::commitTransaction(transaction::Methods* activeTrx) {
   LOG_TRX(this, _nestingLevel)
@@ -525,7 +718,9 @@ Result RocksDBTransactionState::addOperation(
     TRI_voc_cid_t cid, TRI_voc_rid_t revisionId,
     TRI_voc_document_operation_e operationType,
     bool& hasPerformedIntermediateCommit) {
-  size_t currentSize = _rocksTransaction->GetWriteBatch()->GetWriteBatch()->GetDataSize();
+  size_t currentSize = (_bulkLoadBatch != nullptr)
+      ? _bulkLoadBatch->GetWriteBatch()->GetDataSize()
+      : _rocksTransaction->GetWriteBatch()->GetWriteBatch()->GetDataSize();
   if (currentSize > _options.maxTransactionSize) {
     // we hit the transaction size limit
     std::string message =
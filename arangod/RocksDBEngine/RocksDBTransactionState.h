@@ -43,6 +43,7 @@ namespace rocksdb {
 class Transaction;
 class Slice;
 class Iterator;
+class WriteBatchWithIndex;
 
 }  // namespace rocksdb
 
@@ -102,6 +103,10 @@ class RocksDBTransactionState final : public TransactionState {
     return (_numInserts > 0 || _numRemoves > 0 || _numUpdates > 0);
   }
 
+  /// @brief whether or not the operations are collected in a batch that
+  /// is ingested as SST files on commit
+  bool isBulkLoad() const { return _bulkLoadBatch != nullptr; }
+
   bool hasFailedOperations() const override {
     return (_status == transaction::Status::ABORTED) && hasOperations();
   }
@@ -164,6 +169,8 @@ class RocksDBTransactionState final : public TransactionState {
   void cleanupTransaction() noexcept;
   /// @brief internally commit a transaction
   arangodb::Result internalCommit();
+  /// @brief ingest the operations of a bulk load transaction as SST files
+  arangodb::Result commitBulkLoad(bool& ingested);
 
   /// @brief Trigger an intermediate commit.
   /// Handle with care if failing after this commit it will only
@@ -176,11 +183,18 @@ class RocksDBTransactionState final : public TransactionState {
   /// sets hasPerformedIntermediateCommit to true if an intermediate commit was performed
   Result checkIntermediateCommit(uint64_t newSize, bool& hasPerformedIntermediateCommit);
 
+  /// @brief replaces the read snapshot of a read-only transaction if it
+  /// is older than the maxSnapshotAge option allows
+  void refreshReadSnapshot();
+
   /// @brief rocksdb transaction may be null for read only transactions
   rocksdb::Transaction* _rocksTransaction;
   /// @brief used for read-only trx and intermediate commits
   /// For intermediate commits this MUST ONLY be used for iteratos
   rocksdb::Snapshot const* _readSnapshot;
+  /// @brief when the transaction acquired _readSnapshot itself, 0 if the
+  /// snapshot was donated (e.g. by replication)
+  double _readSnapshotTime;
   /// @brief shared write options used
   rocksdb::WriteOptions _rocksWriteOptions;
   /// @brief shared read options which can be used by operations
@@ -191,6 +205,9 @@ class RocksDBTransactionState final : public TransactionState {
   cache::Transaction* _cacheTx;
   /// @brief wrapper to use outside this class to access rocksdb
   std::unique_ptr<RocksDBMethods> _rocksMethods;
+  /// @brief operations of a bulk load transaction. they do not go through
+  /// the rocksdb transaction, but are ingested as SST files on commit
+  std::unique_ptr<rocksdb::WriteBatchWithIndex> _bulkLoadBatch;
 
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   /// store the number of log entries in WAL
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBTtlIndex.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Indexes/IndexIterator.h"
+#include "Transaction/Helpers.h"
+#include "Transaction/Hints.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/OperationResult.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <limits>
+
+using namespace arangodb;
+
+RocksDBTtlIndex::RocksDBTtlIndex(
+    TRI_idx_iid_t iid,
+    LogicalCollection& coll,
+    arangodb::velocypack::Slice const& info
+)
+    : RocksDBVPackIndex(iid, coll, info),
+      _expireAfter(basics::VelocyPackHelper::getNumericValue<double>(
+          info, StaticStrings::IndexExpireAfter.c_str(), 0.0)) {
+  TRI_ASSERT(_fields.size() == 1);
+  TRI_ASSERT(_sparse && !_unique);
+}
+
+void RocksDBTtlIndex::toVelocyPack(VPackBuilder& builder,
+                                   std::underlying_type<Serialize>::type flags) const {
+  builder.openObject();
+  RocksDBIndex::toVelocyPack(builder, flags);
+  builder.add(
+    arangodb::StaticStrings::IndexUnique,
+    arangodb::velocypack::Value(_unique)
+  );
+  builder.add(
+    arangodb::StaticStrings::IndexSparse,
+    arangodb::velocypack::Value(_sparse)
+  );
+  builder.add(
+    arangodb::StaticStrings::IndexExpireAfter,
+    arangodb::velocypack::Value(_expireAfter)
+  );
+  builder.close();
+}
+
+Result RocksDBTtlIndex::removeExpired(double now, size_t limit,
+                                      size_t& removed) const {
+  removed = 0;
+
+  SingleCollectionTransaction trx(
+    transaction::StandaloneContext::Create(_collection.vocbase()),
+    _collection,
+    AccessMode::Type::WRITE
+  );
+  // expiry must not slow down the regular write load
+  trx.addHint(transaction::Hints::Hint::LOW_PRIORITY);
+
+  Result res = trx.begin();
+
+  if (res.fail()) {
+    return res;
+  }
+
+  // all numeric timestamps up to the expiry point. other values
+  // are not treated as timestamps
+  VPackBuilder searchValues;
+  searchValues.openArray();
+  searchValues.openObject();
+  searchValues.add(StaticStrings::IndexGe,
+                   VPackValue(std::numeric_limits<double>::lowest()));
+  searchValues.add(StaticStrings::IndexLe, VPackValue(now - _expireAfter));
+  searchValues.close();
+  searchValues.close();
+
+  VPackBuilder keys;
+  keys.openArray();
+  {
+    std::unique_ptr<IndexIterator> it(
+        lookup(&trx, searchValues.slice(), false));
+    it->nextDocument([&keys](LocalDocumentId const&, VPackSlice doc) {
+      keys.add(transaction::helpers::extractKeyFromDocument(doc));
+    }, limit);
+  }
+  keys.close();
+
+  size_t const n = static_cast<size_t>(keys.slice().length());
+
+  if (n == 0) {
+    return trx.commit();
+  }
+
+  OperationOptions options;
+  options.silent = true;
+  options.ignoreRevs = true;
+
+  OperationResult result = trx.remove(_collection.name(), keys.slice(), options);
+  res = trx.finish(result.result);
+
+  if (res.ok()) {
+    // documents may have been removed concurrently in the meantime
+    size_t failed = 0;
+    for (auto const& it : result.countErrorCodes) {
+      failed += it.second;
+    }
+    removed = n - std::min(n, failed);
+  }
+
+  return res;
+}
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ROCKSDB_TTL_INDEX_H
+#define ARANGOD_ROCKSDB_ROCKSDB_TTL_INDEX_H 1
+
+#include "Basics/Result.h"
+#include "RocksDBEngine/RocksDBVPackIndex.h"
+
+namespace arangodb {
+
+/// @brief a sorted, sparse index over a single attribute containing a
+/// timestamp in seconds since the epoch. documents are removed by the
+/// RocksDBTtlThread once their timestamp is more than expireAfter seconds
+/// in the past. apart from that the index behaves like a skiplist index
+class RocksDBTtlIndex final : public RocksDBVPackIndex {
+ public:
+  RocksDBTtlIndex() = delete;
+
+  RocksDBTtlIndex(
+      TRI_idx_iid_t iid,
+      LogicalCollection& coll,
+      arangodb::velocypack::Slice const& info
+  );
+
+  IndexType type() const override { return Index::TRI_IDX_TYPE_TTL_INDEX; }
+
+  char const* typeName() const override { return "rocksdb-ttl"; }
+
+  bool isSorted() const override { return true; }
+
+  void toVelocyPack(VPackBuilder&,
+                    std::underlying_type<Index::Serialize>::type) const override;
+
+  /// @brief number of seconds after which a document expires
+  double expireAfter() const { return _expireAfter; }
+
+  /// @brief remove up to limit documents that expired before the given
+  /// point in time, using a transaction of its own. the removals are
+  /// regular document removals, so they are written to the WAL and are
+  /// replicated to followers
+  Result removeExpired(double now, size_t limit, size_t& removed) const;
+
+ private:
+  double const _expireAfter;
+};
+
+}
+
+#endif
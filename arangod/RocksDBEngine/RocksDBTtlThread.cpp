@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBTtlThread.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/system-functions.h"
+#include "Cluster/FollowerInfo.h"
+#include "Cluster/ServerState.h"
+#include "Logger/Logger.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBTtlIndex.h"
+#include "Utils/DatabaseGuard.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+using namespace arangodb;
+
+RocksDBTtlThread::RocksDBTtlThread(RocksDBEngine* engine, double frequency,
+                                   size_t batchSize)
+    : Thread("RocksDBTtl"),
+      _engine(engine),
+      _frequency(frequency),
+      _batchSize(batchSize) {}
+
+RocksDBTtlThread::~RocksDBTtlThread() { shutdown(); }
+
+void RocksDBTtlThread::beginShutdown() {
+  Thread::beginShutdown();
+
+  // wake up the thread that may be waiting in run()
+  CONDITION_LOCKER(guard, _condition);
+  guard.broadcast();
+}
+
+void RocksDBTtlThread::run() {
+  while (!isStopping()) {
+    {
+      CONDITION_LOCKER(guard, _condition);
+      guard.wait(static_cast<uint64_t>(_frequency * 1000000.0));
+    }
+
+    if (isStopping() || _engine->inRecovery()) {
+      continue;
+    }
+
+    try {
+      work();
+    } catch (std::exception const& ex) {
+      LOG_TOPIC(WARN, Logger::ENGINES)
+          << "caught exception in rocksdb ttl thread: " << ex.what();
+    } catch (...) {
+      LOG_TOPIC(WARN, Logger::ENGINES)
+          << "caught unknown exception in rocksdb ttl thread";
+    }
+  }
+}
+
+void RocksDBTtlThread::work() {
+  if (DatabaseFeature::DATABASE == nullptr) {
+    return;
+  }
+
+  // first collect the collections with a TTL index. the transactions must
+  // not run from within the callbacks, as these hold the database locks
+  std::vector<std::pair<TRI_voc_tick_t, TRI_voc_cid_t>> collections;
+
+  DatabaseFeature::DATABASE->enumerateDatabases(
+    [&collections](TRI_vocbase_t& vocbase) -> void {
+      vocbase.processCollections(
+        [&collections, &vocbase](LogicalCollection* collection) -> void {
+          for (auto const& idx : collection->getIndexes()) {
+            if (idx->type() == Index::TRI_IDX_TYPE_TTL_INDEX) {
+              collections.emplace_back(vocbase.id(), collection->id());
+              break;
+            }
+          }
+        }, false);
+    }
+  );
+
+  bool const isDBServer = ServerState::instance()->isDBServer();
+
+  for (auto const& it : collections) {
+    if (isStopping()) {
+      return;
+    }
+
+    std::unique_ptr<DatabaseGuard> guard;
+    try {
+      guard.reset(new DatabaseGuard(it.first));
+    } catch (...) {
+      // database was dropped in the meantime
+      continue;
+    }
+
+    auto collection = guard->database().lookupCollection(it.second);
+
+    if (collection == nullptr || collection->deleted()) {
+      continue;
+    }
+
+    if (isDBServer && !collection->followers()->getLeader().empty()) {
+      // we are a follower for this shard
+      continue;
+    }
+
+    for (auto const& idx : collection->getIndexes()) {
+      if (idx->type() != Index::TRI_IDX_TYPE_TTL_INDEX) {
+        continue;
+      }
+
+      auto ttlIndex = static_cast<RocksDBTtlIndex const*>(idx.get());
+      double const now = TRI_microtime();
+      size_t total = 0;
+      size_t removed = 0;
+
+      do {
+        Result res = ttlIndex->removeExpired(now, _batchSize, removed);
+
+        if (res.fail()) {
+          LOG_TOPIC(WARN, Logger::ENGINES)
+              << "unable to remove expired documents from collection '"
+              << guard->database().name() << "/" << collection->name()
+              << "': " << res.errorMessage();
+          break;
+        }
+        total += removed;
+      } while (removed == _batchSize && !isStopping());
+
+      if (total > 0) {
+        LOG_TOPIC(DEBUG, Logger::ENGINES)
+            << "removed " << total << " expired document(s) from collection '"
+            << guard->database().name() << "/" << collection->name() << "'";
+      }
+    }
+  }
+}
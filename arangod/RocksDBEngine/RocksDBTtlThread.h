@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_ROCKSDB_ENGINE_ROCKSDB_TTL_THREAD_H
+#define ARANGOD_ROCKSDB_ENGINE_ROCKSDB_TTL_THREAD_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Thread.h"
+
+namespace arangodb {
+
+class RocksDBEngine;
+
+/// @brief background thread that periodically removes the expired
+/// documents of all collections with a TTL index. the documents are
+/// removed in batches, each in a transaction of its own. on a DB server
+/// only the leaders of shards remove documents, the followers receive
+/// the removals via synchronous replication
+class RocksDBTtlThread final : public Thread {
+ public:
+  RocksDBTtlThread(RocksDBEngine* engine, double frequency, size_t batchSize);
+  ~RocksDBTtlThread();
+
+  void beginShutdown() override;
+
+ protected:
+  void run() override;
+
+ private:
+  /// @brief remove the expired documents of all TTL indexes
+  void work();
+
+ private:
+  RocksDBEngine* _engine;
+
+  /// @brief seconds between two runs
+  double const _frequency;
+
+  /// @brief maximum number of documents removed per transaction
+  size_t const _batchSize;
+
+  /// @brief protects the wait between two runs
+  arangodb::basics::ConditionVariable _condition;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -123,6 +123,33 @@ bool RocksDBVPackUniqueIndexIterator::next(LocalDocumentIdCallback const& cb,
   return false;
 }
 
+bool RocksDBVPackUniqueIndexIterator::nextDocument(DocumentCallback const& cb,
+                                                   size_t limit) {
+  TRI_ASSERT(_trx->state()->isRunning());
+
+  if (limit == 0 || _done) {
+    // already looked up something
+    return false;
+  }
+
+  _done = true;
+
+  auto value = RocksDBValue::Empty(RocksDBEntryType::PrimaryIndexValue);
+  RocksDBMethods* mthds = RocksDBTransactionState::toMethods(_trx);
+  arangodb::Result r =
+      mthds->Get(_index->columnFamily(), _key.ref(), value.buffer());
+
+  if (r.ok()) {
+    toRocksDBCollection(_collection->getPhysical())
+        ->readDocumentWithCallback(
+            _trx, LocalDocumentId(RocksDBValue::documentId(*value.buffer())),
+            cb);
+  }
+
+  // there is at most one element, so we are done now
+  return false;
+}
+
 bool RocksDBVPackUniqueIndexIterator::nextCovering(DocumentCallback const& cb, size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
 
@@ -145,63 +172,103 @@ bool RocksDBVPackUniqueIndexIterator::nextCovering(DocumentCallback const& cb, s
   return false;
 }
 
+namespace {
+std::vector<RocksDBKeyBounds> singleRange(RocksDBKeyBounds&& bounds) {
+  std::vector<RocksDBKeyBounds> result;
+  result.emplace_back(std::move(bounds));
+  return result;
+}
+}  // namespace
+
 RocksDBVPackIndexIterator::RocksDBVPackIndexIterator(
     LogicalCollection* collection, transaction::Methods* trx,
     arangodb::RocksDBVPackIndex const* index,
     bool reverse, RocksDBKeyBounds&& bounds)
+    : RocksDBVPackIndexIterator(collection, trx, index, reverse,
+                                singleRange(std::move(bounds))) {}
+
+RocksDBVPackIndexIterator::RocksDBVPackIndexIterator(
+    LogicalCollection* collection, transaction::Methods* trx,
+    arangodb::RocksDBVPackIndex const* index,
+    bool reverse, std::vector<RocksDBKeyBounds>&& bounds)
     : IndexIterator(collection, trx),
       _index(index),
       _cmp(index->comparator()),
       _reverse(reverse),
-      _bounds(std::move(bounds)) {
+      _bounds(std::move(bounds)),
+      _current(0) {
   TRI_ASSERT(index->columnFamily() == RocksDBColumnFamily::vpack());
+  TRI_ASSERT(!_bounds.empty());
 
   RocksDBMethods* mthds = RocksDBTransactionState::toMethods(trx);
   rocksdb::ReadOptions options = mthds->iteratorReadOptions();
   // we need to have a pointer to a slice for the upper bound
-  // so we need to assign the slice to an instance variable here
+  // so we need to assign the slice to an instance variable here.
+  // the last range is the one furthest away in iteration order
   if (reverse) {
-    _rangeBound = _bounds.start();
+    _rangeBound = _bounds.back().start();
     options.iterate_lower_bound = &_rangeBound;
   } else {
-    _rangeBound = _bounds.end();
+    _rangeBound = _bounds.back().end();
     options.iterate_upper_bound = &_rangeBound;
   }
 
   TRI_ASSERT(options.prefix_same_as_start);
   _iterator = mthds->NewIterator(options, index->columnFamily());
-  if (reverse) {
-    _iterator->SeekForPrev(_bounds.end());
-  } else {
-    _iterator->Seek(_bounds.start());
-  }
+  seekRange();
 }
 
 /// @brief Reset the cursor
 void RocksDBVPackIndexIterator::reset() {
   TRI_ASSERT(_trx->state()->isRunning());
 
+  _current = 0;
+  seekRange();
+}
+
+void RocksDBVPackIndexIterator::seekRange() {
   if (_reverse) {
-    _iterator->SeekForPrev(_bounds.end());
+    _iterator->SeekForPrev(_bounds[_current].end());
   } else {
-    _iterator->Seek(_bounds.start());
+    _iterator->Seek(_bounds[_current].start());
   }
 }
 
 bool RocksDBVPackIndexIterator::outOfRange() const {
   TRI_ASSERT(_trx->state()->isRunning());
   if (_reverse) {
-    return (_cmp->Compare(_iterator->key(), _bounds.start()) < 0);
+    return (_cmp->Compare(_iterator->key(), _bounds[_current].start()) < 0);
   } else {
-    return (_cmp->Compare(_iterator->key(), _bounds.end()) > 0);
+    return (_cmp->Compare(_iterator->key(), _bounds[_current].end()) > 0);
   }
 }
 
+bool RocksDBVPackIndexIterator::valid() {
+  while (_current < _bounds.size() && _iterator->Valid()) {
+    if (!outOfRange()) {
+      return true;
+    }
+    if (++_current == _bounds.size()) {
+      break;
+    }
+    // the ranges are sorted, so the iterator may already have reached the
+    // next one. we only have to seek if it is still in front of it
+    rocksdb::Slice key = _iterator->key();
+    if (_reverse ? (_cmp->Compare(key, _bounds[_current].end()) > 0)
+                 : (_cmp->Compare(key, _bounds[_current].start()) < 0)) {
+      seekRange();
+    }
+  }
+  // either all ranges are done, or the iterator has reached the bound
+  // of the last range
+  return false;
+}
+
 bool RocksDBVPackIndexIterator::next(LocalDocumentIdCallback const& cb,
                                      size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
 
-  if (limit == 0 || !_iterator->Valid() || outOfRange()) {
+  if (limit == 0 || !valid()) {
     // No limit no data, or we are actually done. The last call should have
     // returned false
     TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
@@ -213,7 +280,7 @@ bool RocksDBVPackIndexIterator::next(LocalDocumentIdCallback const& cb,
 
     cb(_index->_unique
            ? RocksDBValue::documentId(_iterator->value())
-           : RocksDBKey::indexDocumentId(_bounds.type(), _iterator->key()));
+           : RocksDBKey::indexDocumentId(_bounds[_current].type(), _iterator->key()));
 
     --limit;
     if (_reverse) {
@@ -222,7 +289,7 @@ bool RocksDBVPackIndexIterator::next(LocalDocumentIdCallback const& cb,
       _iterator->Next();
     }
 
-    if (!_iterator->Valid() || outOfRange()) {
+    if (!valid()) {
       return false;
     }
   }
@@ -230,10 +297,26 @@ bool RocksDBVPackIndexIterator::next(LocalDocumentIdCallback const& cb,
   return true;
 }
 
+bool RocksDBVPackIndexIterator::nextDocument(DocumentCallback const& cb,
+                                             size_t limit) {
+  // collect the document ids first, so the documents can be read from
+  // RocksDB with a single MultiGet
+  _documentIds.clear();
+  bool hasMore = next([this](LocalDocumentId const& documentId) {
+    _documentIds.emplace_back(documentId);
+  }, limit);
+
+  if (!_documentIds.empty()) {
+    toRocksDBCollection(_collection->getPhysical())
+        ->readDocumentWithCallback(_trx, _documentIds, cb);
+  }
+  return hasMore;
+}
+
 bool RocksDBVPackIndexIterator::nextCovering(DocumentCallback const& cb, size_t limit) {
   TRI_ASSERT(_trx->state()->isRunning());
 
-  if (limit == 0 || !_iterator->Valid() || outOfRange()) {
+  if (limit == 0 || !valid()) {
     // No limit no data, or we are actually done. The last call should have
     // returned false
     TRI_ASSERT(limit > 0);  // Someone called with limit == 0. Api broken
@@ -246,7 +329,7 @@ bool RocksDBVPackIndexIterator::nextCovering(DocumentCallback const& cb, size_t
     LocalDocumentId const documentId(
         _index->_unique
             ? RocksDBValue::documentId(_iterator->value())
-            : RocksDBKey::indexDocumentId(_bounds.type(), _iterator->key()));
+            : RocksDBKey::indexDocumentId(_bounds[_current].type(), _iterator->key()));
     cb(documentId, RocksDBKey::indexedVPack(_iterator->key()));
 
     --limit;
@@ -256,7 +339,7 @@ bool RocksDBVPackIndexIterator::nextCovering(DocumentCallback const& cb, size_t
       _iterator->Next();
     }
 
-    if (!_iterator->Valid() || outOfRange()) {
+    if (!valid()) {
       return false;
     }
   }
@@ -267,7 +350,7 @@ bool RocksDBVPackIndexIterator::nextCovering(DocumentCallback const& cb, size_t
 void RocksDBVPackIndexIterator::skip(uint64_t count, uint64_t& skipped) {
   TRI_ASSERT(_trx->state()->isRunning());
 
-  if (!_iterator->Valid() || outOfRange()) {
+  if (!valid()) {
     return;
   }
 
@@ -282,7 +365,7 @@ void RocksDBVPackIndexIterator::skip(uint64_t count, uint64_t& skipped) {
       _iterator->Next();
     }
 
-    if (!_iterator->Valid() || outOfRange()) {
+    if (!valid()) {
       return;
     }
   }
@@ -705,22 +788,64 @@ Result RocksDBVPackIndex::insertInternal(transaction::Methods* trx,
   }
 
   if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) {
-    LocalDocumentId documentId = RocksDBValue::documentId(existing);
-    std::string existingKey;
+    return uniqueConstraintViolation(trx, RocksDBValue::documentId(existing),
+                                     mode);
+  }
 
-    bool success = _collection.getPhysical()->readDocumentWithCallback(trx, documentId, [&](LocalDocumentId const&, VPackSlice doc) {
-      existingKey = doc.get(StaticStrings::KeyString).copyString();
-    });
-    TRI_ASSERT(success);
+  return IndexResult(res, this);
+}
 
-    if (mode == OperationMode::internal) {
-      return IndexResult(res, std::move(existingKey));
+Result RocksDBVPackIndex::checkUniqueConstraint(transaction::Methods* trx,
+                                                RocksDBMethods* mthds,
+                                                VPackSlice const& doc,
+                                                OperationMode mode) {
+  if (!_unique) {
+    return Result();
+  }
+
+  SmallVector<RocksDBKey>::allocator_type::arena_type elementsArena;
+  SmallVector<RocksDBKey> elements{elementsArena};
+  SmallVector<uint64_t>::allocator_type::arena_type hashesArena;
+  SmallVector<uint64_t> hashes{hashesArena};
+  int res = TRI_ERROR_NO_ERROR;
+  {
+    // unique index keys do not contain the document id
+    transaction::BuilderLeaser leased(trx);
+    res = fillElement(*(leased.get()), LocalDocumentId(), doc, elements,
+                      hashes);
+  }
+  if (res != TRI_ERROR_NO_ERROR) {
+    return IndexResult(res, this);
+  }
+
+  RocksDBValue existing =
+      RocksDBValue::Empty(RocksDBEntryType::UniqueVPackIndexValue);
+  for (RocksDBKey const& key : elements) {
+    if (mthds->Get(_cf, key, existing.buffer()).ok()) {
+      return uniqueConstraintViolation(
+          trx, RocksDBValue::documentId(existing), mode);
     }
+  }
+  return Result();
+}
 
-    return IndexResult(res, this, existingKey);
+Result RocksDBVPackIndex::uniqueConstraintViolation(
+    transaction::Methods* trx, LocalDocumentId const& existing,
+    OperationMode mode) {
+  std::string existingKey;
+
+  bool success = _collection.getPhysical()->readDocumentWithCallback(trx, existing, [&](LocalDocumentId const&, VPackSlice doc) {
+    existingKey = doc.get(StaticStrings::KeyString).copyString();
+  });
+  TRI_ASSERT(success);
+
+  if (mode == OperationMode::internal) {
+    return IndexResult(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED,
+                       std::move(existingKey));
   }
 
-  return IndexResult(res, this);
+  return IndexResult(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED, this,
+                     existingKey);
 }
 
 Result RocksDBVPackIndex::updateInternal(
@@ -857,6 +982,39 @@ Result RocksDBVPackIndex::removeInternal(transaction::Methods* trx,
 IndexIterator* RocksDBVPackIndex::lookup(transaction::Methods* trx,
                                          VPackSlice const searchValues,
                                          bool reverse) const {
+  if (isUniqueLookup(searchValues)) {
+    VPackBuilder leftSearch;
+    leftSearch.openArray();
+    for (auto const& it : VPackArrayIterator(searchValues)) {
+      leftSearch.add(it.get(StaticStrings::IndexEq));
+    }
+    leftSearch.close();
+
+    return new RocksDBVPackUniqueIndexIterator(
+      &_collection, trx, this, leftSearch.slice()
+    );
+  }
+
+  return new RocksDBVPackIndexIterator(
+    &_collection, trx, this, reverse, lookupBounds(searchValues)
+  );
+}
+
+bool RocksDBVPackIndex::isUniqueLookup(VPackSlice const searchValues) const {
+  TRI_ASSERT(searchValues.isArray());
+  if (!_unique || searchValues.length() != _fields.size()) {
+    return false;
+  }
+  for (auto const& it : VPackArrayIterator(searchValues)) {
+    TRI_ASSERT(it.isObject());
+    if (it.get(StaticStrings::IndexEq).isNone()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+RocksDBKeyBounds RocksDBVPackIndex::lookupBounds(VPackSlice const searchValues) const {
   TRI_ASSERT(searchValues.isArray());
   TRI_ASSERT(searchValues.length() <= _fields.size());
 
@@ -874,15 +1032,6 @@ IndexIterator* RocksDBVPackIndex::lookup(transaction::Methods* trx,
     leftSearch.add(eq);
   }
 
-  if (lastNonEq.isNone() && _unique &&
-      searchValues.length() == _fields.size()) {
-    leftSearch.close();
-
-    return new RocksDBVPackUniqueIndexIterator(
-      &_collection, trx, this, leftSearch.slice()
-    );
-  }
-
   VPackSlice leftBorder;
   VPackSlice rightBorder;
 
@@ -957,14 +1106,10 @@ IndexIterator* RocksDBVPackIndex::lookup(transaction::Methods* trx,
     }
   }
 
-  RocksDBKeyBounds bounds = _unique ? RocksDBKeyBounds::UniqueVPackIndex(
-                                          _objectId, leftBorder, rightBorder)
-                                    : RocksDBKeyBounds::VPackIndex(
-                                          _objectId, leftBorder, rightBorder);
-
-  return new RocksDBVPackIndexIterator(
-    &_collection, trx, this, reverse, std::move(bounds)
-  );
+  return _unique ? RocksDBKeyBounds::UniqueVPackIndex(
+                       _objectId, leftBorder, rightBorder)
+                 : RocksDBKeyBounds::VPackIndex(
+                       _objectId, leftBorder, rightBorder);
 }
 
 bool RocksDBVPackIndex::supportsFilterCondition(
@@ -1187,6 +1332,40 @@ IndexIterator* RocksDBVPackIndex::iteratorForCondition(
     VPackBuilder expandedSearchValues;
     expandInSearchValues(searchValues.slice(), expandedSearchValues);
     VPackSlice expandedSlice = expandedSearchValues.slice();
+
+    bool useRanges = expandedSlice.length() > 1;
+    if (useRanges) {
+      for (VPackSlice val : VPackArrayIterator(expandedSlice)) {
+        if (isUniqueLookup(val)) {
+          // point lookups in a unique index are cheaper than range scans
+          useRanges = false;
+          break;
+        }
+      }
+    }
+
+    if (useRanges) {
+      // scan all ranges with a single RocksDB iterator instead of
+      // creating and seeking a separate one for each IN value
+      std::vector<RocksDBKeyBounds> bounds;
+      bounds.reserve(static_cast<size_t>(expandedSlice.length()));
+      for (VPackSlice val : VPackArrayIterator(expandedSlice)) {
+        bounds.emplace_back(lookupBounds(val));
+      }
+      // the IN values are deduplicated and sorted already, but the
+      // index order is the authoritative one
+      rocksdb::Comparator const* cmp = comparator();
+      std::sort(bounds.begin(), bounds.end(),
+                [cmp](RocksDBKeyBounds const& lhs, RocksDBKeyBounds const& rhs) {
+                  return cmp->Compare(lhs.start(), rhs.start()) < 0;
+                });
+      if (!opts.ascending) {
+        std::reverse(bounds.begin(), bounds.end());
+      }
+      return new RocksDBVPackIndexIterator(&_collection, trx, this,
+                                           !opts.ascending, std::move(bounds));
+    }
+
     std::vector<IndexIterator*> iterators;
 
     try {
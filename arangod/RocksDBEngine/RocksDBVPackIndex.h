@@ -80,6 +80,9 @@ class RocksDBVPackUniqueIndexIterator final : public IndexIterator {
 
   /// @brief Get the next limit many element in the index
   bool next(LocalDocumentIdCallback const& cb, size_t limit) override;
+
+  /// @brief Get the document of the single matching index entry
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override;
   
   bool nextCovering(DocumentCallback const& cb, size_t limit) override;
 
@@ -108,6 +111,13 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
                             arangodb::RocksDBVPackIndex const* index,
                             bool reverse, RocksDBKeyBounds&& bounds);
 
+  /// @brief iterate over several disjoint ranges of the index with a single
+  /// RocksDB iterator. the ranges must be sorted in iteration order
+  RocksDBVPackIndexIterator(LogicalCollection* collection,
+                            transaction::Methods* trx,
+                            arangodb::RocksDBVPackIndex const* index,
+                            bool reverse, std::vector<RocksDBKeyBounds>&& bounds);
+
   ~RocksDBVPackIndexIterator() = default;
 
  public:
@@ -115,6 +125,10 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
 
   /// @brief Get the next limit many elements in the index
   bool next(LocalDocumentIdCallback const& cb, size_t limit) override;
+
+  /// @brief Get the next limit many documents in the index, reading them
+  /// with a single MultiGet
+  bool nextDocument(DocumentCallback const& cb, size_t limit) override;
   
   bool nextCovering(DocumentCallback const& cb, size_t limit) override;
   
@@ -128,15 +142,28 @@ class RocksDBVPackIndexIterator final : public IndexIterator {
   bool hasCovering() const override { return true; }
 
  private:
+  /// @brief whether the iterator has left the current range
   bool outOfRange() const;
 
+  /// @brief whether the iterator points to an entry of one of the ranges.
+  /// moves on to the next range once the current one is exhausted
+  bool valid();
+
+  /// @brief position the iterator at the start of the current range
+  void seekRange();
+
   arangodb::RocksDBVPackIndex const* _index;
   rocksdb::Comparator const* _cmp;
   std::unique_ptr<rocksdb::Iterator> _iterator;
   bool const _reverse;
-  RocksDBKeyBounds _bounds;
+  /// @brief the ranges to iterate, in iteration order
+  std::vector<RocksDBKeyBounds> _bounds;
+  /// @brief position of the current range in _bounds
+  size_t _current;
   // used for iterate_upper_bound iterate_lower_bound
   rocksdb::Slice _rangeBound;
+  // document ids collected by nextDocument, reused between calls
+  std::vector<LocalDocumentId> _documentIds;
 };
 
 class RocksDBVPackIndex : public RocksDBIndex {
@@ -187,6 +214,13 @@ class RocksDBVPackIndex : public RocksDBIndex {
   IndexIterator* lookup(transaction::Methods*,
                         arangodb::velocypack::Slice const, bool reverse) const;
 
+  /// @brief whether the search values fully specify an entry of a unique
+  /// index, so that it can be looked up directly
+  bool isUniqueLookup(arangodb::velocypack::Slice const searchValues) const;
+
+  /// @brief the key bounds of all index entries matching the search values
+  RocksDBKeyBounds lookupBounds(arangodb::velocypack::Slice const searchValues) const;
+
   bool supportsFilterCondition(std::vector<std::shared_ptr<arangodb::Index>> const& allIndexes,
                                arangodb::aql::AstNode const*,
                                arangodb::aql::Variable const*, size_t, size_t&,
@@ -215,12 +249,26 @@ class RocksDBVPackIndex : public RocksDBIndex {
   
   void afterTruncate(TRI_voc_tick_t tick) override;
 
+  /// @brief compute the index keys and estimator hashes of a document
+  /// without writing anything. this does not use a transaction, so it can
+  /// be called from several threads at once when building the index in bulk
+  int computeElements(velocypack::Builder& leased,
+                      LocalDocumentId const& documentId, VPackSlice const& doc,
+                      SmallVector<RocksDBKey>& elements,
+                      SmallVector<uint64_t>& hashes) {
+    return fillElement(leased, documentId, doc, elements, hashes);
+  }
+
  protected:
   Result insertInternal(transaction::Methods*, RocksDBMethods*,
                         LocalDocumentId const& documentId,
                         arangodb::velocypack::Slice const&,
                         OperationMode mode) override;
 
+  Result checkUniqueConstraint(transaction::Methods*, RocksDBMethods*,
+                               arangodb::velocypack::Slice const&,
+                               OperationMode mode) override;
+
   Result updateInternal(transaction::Methods* trx, RocksDBMethods*,
                         LocalDocumentId const& oldDocumentId,
                         arangodb::velocypack::Slice const& oldDoc,
@@ -241,6 +289,12 @@ class RocksDBVPackIndex : public RocksDBIndex {
   void fillPaths(std::vector<std::vector<std::string>>& paths,
                  std::vector<int>& expanding);
 
+  /// @brief builds the error for a unique constraint violation by the
+  /// document with the given id
+  Result uniqueConstraintViolation(transaction::Methods*,
+                                   LocalDocumentId const& existing,
+                                   OperationMode mode);
+
   /// @brief helper function to insert a document into any index type
   int fillElement(velocypack::Builder& leased,
                   LocalDocumentId const& documentId, VPackSlice const& doc,
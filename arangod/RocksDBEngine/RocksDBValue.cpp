@@ -72,6 +72,12 @@ RocksDBValue RocksDBValue::S2Value(S2Point const& p) {
   return RocksDBValue(p);
 }
 
+RocksDBValue RocksDBValue::S2Value(S2Point const& p, VPackSlice const& rangeValue) {
+  RocksDBValue value(p);
+  value._buffer.append(rangeValue.startAs<char>(), rangeValue.byteSize());
+  return value;
+}
+
 RocksDBValue RocksDBValue::Empty(RocksDBEntryType type) {
   return RocksDBValue(type);
 }
@@ -141,12 +147,20 @@ uint64_t RocksDBValue::keyValue(std::string const& s) {
 }
 
 S2Point RocksDBValue::centroid(rocksdb::Slice const& s) {
-  TRI_ASSERT(s.size() == sizeof(double) * 3);
+  TRI_ASSERT(s.size() >= sizeof(double) * 3);
   return S2Point(intToDouble(uint64FromPersistent(s.data())),
                  intToDouble(uint64FromPersistent(s.data() + sizeof(uint64_t))),
                  intToDouble(uint64FromPersistent(s.data() + sizeof(uint64_t) * 2)));
 }
 
+VPackSlice RocksDBValue::rangeValue(rocksdb::Slice const& s) {
+  TRI_ASSERT(s.size() >= sizeof(double) * 3);
+  if (s.size() == sizeof(double) * 3) {
+    return VPackSlice::nullSlice();
+  }
+  return VPackSlice(reinterpret_cast<uint8_t const*>(s.data() + sizeof(double) * 3));
+}
+
 RocksDBValue::RocksDBValue(RocksDBEntryType type) : _type(type), _buffer() {}
 
 RocksDBValue::RocksDBValue(RocksDBEntryType type, LocalDocumentId const& docId, TRI_voc_rid_t revision)
@@ -55,6 +55,7 @@ class RocksDBValue {
   static RocksDBValue ReplicationApplierConfig(VPackSlice const& data);
   static RocksDBValue KeyGeneratorValue(VPackSlice const& data);
   static RocksDBValue S2Value(S2Point const& c);
+  static RocksDBValue S2Value(S2Point const& c, VPackSlice const& rangeValue);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Used to construct an empty value of the given type for retrieval
@@ -112,6 +113,12 @@ class RocksDBValue {
   //////////////////////////////////////////////////////////////////////////////
   static S2Point centroid(rocksdb::Slice const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Range attribute value stored after the centroid, null if the
+  /// geo index does not store one
+  //////////////////////////////////////////////////////////////////////////////
+  static VPackSlice rangeValue(rocksdb::Slice const&);
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Returns a reference to the underlying string buffer.
@@ -22,7 +22,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RocksDBEngine/RocksDBWalAccess.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/system-functions.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RocksDBEngine/RocksDBColumnFamily.h"
 #include "RocksDBEngine/RocksDBCommon.h"
@@ -69,6 +73,72 @@ TRI_voc_tick_t RocksDBWalAccess::lastTick() const {
   return rocksutils::globalRocksDB()->GetLatestSequenceNumber();
 }
 
+bool RocksDBWalAccess::waitForWrites(TRI_voc_tick_t tick,
+                                     double timeout) const {
+  double const end = TRI_microtime() + timeout;
+  ++_waiters;
+  TRI_DEFER(--_waiters);
+
+  CONDITION_LOCKER(guard, _writeCondition);
+  while (rocksutils::globalRocksDB()->GetLatestSequenceNumber() <= tick) {
+    double remaining = end - TRI_microtime();
+    if (remaining <= 0.0) {
+      return false;
+    }
+    // writes outside of transactions are not signaled, so look again
+    // from time to time
+    guard.wait(static_cast<uint64_t>(std::min(remaining, 0.5) * 1000000.0));
+  }
+  return true;
+}
+
+void RocksDBWalAccess::waitForWritesAsync(
+    TRI_voc_tick_t tick, double timeout,
+    std::function<void()> const& callback) const {
+  auto waiter = std::make_shared<AsyncWaiter>(callback);
+  {
+    MUTEX_LOCKER(locker, _asyncWaitersLock);
+    // forget the waiters whose timer expired before a notification
+    size_t const before = _asyncWaiters.size();
+    _asyncWaiters.erase(
+        std::remove_if(_asyncWaiters.begin(), _asyncWaiters.end(),
+                       [](std::shared_ptr<AsyncWaiter> const& w) {
+                         return w->done.load();
+                       }),
+        _asyncWaiters.end());
+    _waiters -= before - _asyncWaiters.size();
+    _asyncWaiters.emplace_back(waiter);
+    ++_waiters;
+  }
+
+  // writes outside of transactions are not signaled, so look again
+  // from time to time
+  if (rocksutils::globalRocksDB()->GetLatestSequenceNumber() > tick ||
+      !startWaitTimer(std::min(timeout, 0.5),
+                      [waiter]() { waiter->invoke(); })) {
+    waiter->invoke();
+  }
+}
+
+void RocksDBWalAccess::notifyWrites() const {
+  if (_waiters.load() > 0) {
+    {
+      CONDITION_LOCKER(guard, _writeCondition);
+      guard.broadcast();
+    }
+
+    std::vector<std::shared_ptr<AsyncWaiter>> waiters;
+    {
+      MUTEX_LOCKER(locker, _asyncWaitersLock);
+      waiters.swap(_asyncWaiters);
+      _waiters -= waiters.size();
+    }
+    for (auto& waiter : waiters) {
+      waiter->invoke();
+    }
+  }
+}
+
 /// should return the list of transactions started, but not committed in that
 /// range (range can be adjusted)
 WalAccessResult RocksDBWalAccess::openTransactions(
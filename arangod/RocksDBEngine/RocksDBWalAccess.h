@@ -24,6 +24,8 @@
 #ifndef ARANGOD_ROCKSDB_ENGINE_WAL_ACCESS_H
 #define ARANGOD_ROCKSDB_ENGINE_WAL_ACCESS_H 1
 
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "StorageEngine/WalAccess.h"
 
 namespace arangodb {
@@ -32,7 +34,7 @@ namespace arangodb {
 /// TODO: add methods for _admin/wal/ and get rid of engine specific handlers
 class RocksDBWalAccess final : public WalAccess {
  public:
-  RocksDBWalAccess() {}
+  RocksDBWalAccess() : _waiters(0) {}
   virtual ~RocksDBWalAccess() {}
 
   /// {"tickMin":"123", "tickMax":"456", "version":"3.2", "serverId":"abc"}
@@ -57,6 +59,42 @@ class RocksDBWalAccess final : public WalAccess {
   WalAccessResult tail(WalAccess::Filter const& filter, size_t chunkSize,
                        TRI_voc_tick_t barrierId,
                        MarkerCallback const&) const override;
+
+  /// @brief waits for a notification about committed transactions
+  bool waitForWrites(TRI_voc_tick_t tick, double timeout) const override;
+
+  /// @brief invokes the callback after a notification about committed
+  /// transactions
+  void waitForWritesAsync(TRI_voc_tick_t tick, double timeout,
+                          std::function<void()> const&) const override;
+
+  /// @brief wake up all tailing requests waiting for writes
+  void notifyWrites() const;
+
+ private:
+  /// @brief a callback waiting for writes. it is invoked once, by a
+  /// notification or by its timer, whichever comes first
+  struct AsyncWaiter {
+    explicit AsyncWaiter(std::function<void()> const& callback)
+        : callback(callback), done(false) {}
+
+    void invoke() {
+      if (!done.exchange(true)) {
+        callback();
+      }
+    }
+
+    std::function<void()> const callback;
+    std::atomic<bool> done;
+  };
+
+  /// @brief signaled after transactions are committed
+  mutable basics::ConditionVariable _writeCondition;
+  /// @brief number of requests waiting for writes
+  mutable std::atomic<size_t> _waiters;
+  /// @brief callbacks waiting for writes, protected by _asyncWaitersLock
+  mutable Mutex _asyncWaitersLock;
+  mutable std::vector<std::shared_ptr<AsyncWaiter>> _asyncWaiters;
 };
 }
 
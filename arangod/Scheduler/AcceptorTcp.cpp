@@ -87,6 +87,15 @@ void AcceptorTcp::open() {
 #else
   _acceptor->set_option(asio_ns::ip::tcp::acceptor::reuse_address(
       ((EndpointIp*)_endpoint)->reuseAddress()));
+#ifdef SO_REUSEPORT
+  if (_server.reusePort()) {
+    // all acceptors of the endpoint bind to the same address, the kernel
+    // distributes the incoming connections among them
+    typedef asio_ns::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>
+        reuse_port;
+    _acceptor->set_option(reuse_port(true));
+  }
+#endif
 #endif
 
   _acceptor->bind(asioEndpoint, err);
@@ -110,13 +119,14 @@ void AcceptorTcp::open() {
 void AcceptorTcp::asyncAccept(AcceptHandler const& handler) {
   TRI_ASSERT(!_peer);
 
-  // select the io context for this socket
-  auto &context = _server.selectIoContext();
+  // select the io context for this socket. with several acceptors per
+  // endpoint, the kernel already spread the connections
+  auto &context = _server.reusePort() ? _context : _server.selectIoContext();
 
   if (_endpoint->encryption() == Endpoint::EncryptionType::SSL) {
 
-    auto sslContext = SslServerFeature::SSL->createSslContext();
-    _peer.reset(new SocketSslTcp(context, std::move(sslContext)));
+    _peer.reset(
+        new SocketSslTcp(context, SslServerFeature::SSL->sslContext()));
     SocketSslTcp* peer = static_cast<SocketSslTcp*>(_peer.get());
     _acceptor->async_accept(peer->_socket, peer->_peerEndpoint, handler);
   } else {
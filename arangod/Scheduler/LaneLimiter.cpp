@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "LaneLimiter.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include "Basics/MutexLocker.h"
+#include "Basics/system-functions.h"
+#include "Logger/Logger.h"
+#include "Scheduler/Scheduler.h"
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+// delay before a job which could not be handed to the scheduler is retried
+std::chrono::milliseconds const RequeueDelay(10);
+
+// in seconds
+std::vector<double> const QueueTimeCuts({0.001, 0.01, 0.05, 0.1, 0.5, 1.0});
+
+char const* const LaneNames[] = {
+    "client-fast",   "client-aql",       "client-v8",     "client-slow",
+    "agency-internal", "agency-cluster", "cluster-internal", "cluster-v8",
+    "cluster-admin", "server-replication", "task-v8"};
+
+static_assert(sizeof(LaneNames) / sizeof(LaneNames[0]) ==
+                  LaneLimiter::NUMBER_LANES,
+              "a name is required for each lane");
+}  // namespace
+
+constexpr size_t LaneLimiter::NUMBER_LANES;
+
+LaneLimiter::LaneLimiter(Scheduler* scheduler) : _scheduler(scheduler) {
+  basics::StatisticsDistribution queueTime(QueueTimeCuts);
+  for (auto& lane : _lanes) {
+    lane._queueTime = queueTime;
+  }
+}
+
+LaneLimiter::~LaneLimiter() {}
+
+char const* LaneLimiter::laneName(RequestLane lane) {
+  return LaneNames[static_cast<size_t>(lane)];
+}
+
+bool LaneLimiter::laneFromName(std::string const& name, RequestLane& lane) {
+  for (size_t i = 0; i < NUMBER_LANES; ++i) {
+    if (name == LaneNames[i]) {
+      lane = static_cast<RequestLane>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+void LaneLimiter::setLimits(RequestLane lane, Limits const& limits) {
+  Lane& l = _lanes[static_cast<size_t>(lane)];
+  MUTEX_LOCKER(locker, l._mutex);
+  l._limits = limits;
+}
+
+bool LaneLimiter::queue(RequestLane lane, RequestPriority prio,
+                        std::function<void()> const& callback) {
+  size_t const index = static_cast<size_t>(lane);
+  Job job{prio, callback, TRI_microtime()};
+
+  if (!isLimited(index)) {
+    return dispatch(index, std::move(job));
+  }
+
+  Lane& l = _lanes[index];
+  {
+    MUTEX_LOCKER(locker, l._mutex);
+    if (l._running >= l._limits._maxConcurrency) {
+      if (l._limits._maxQueued > 0 &&
+          l._pending.size() >= l._limits._maxQueued) {
+        ++l._rejected;
+        return false;
+      }
+      // started by a job of the lane when it finishes
+      l._pending.emplace_back(std::move(job));
+      return true;
+    }
+    ++l._running;
+  }
+
+  if (dispatch(index, job)) {
+    return true;
+  }
+
+  // the scheduler is full. the job is rejected and its slot is released,
+  // unless jobs of the lane were queued in the meantime. these were admitted
+  // already, so the next one takes over the slot. it is never executed on
+  // the calling thread, which may be an I/O thread
+  if (takeNext(index, job) && !dispatch(index, job)) {
+    requeue(index, std::move(job));
+  }
+  return false;
+}
+
+void LaneLimiter::toVelocyPack(velocypack::Builder& builder) const {
+  for (size_t i = 0; i < NUMBER_LANES; ++i) {
+    Lane const& l = _lanes[i];
+
+    builder.add(LaneNames[i], VPackValue(VPackValueType::Object));
+    {
+      MUTEX_LOCKER(locker, l._mutex);
+      builder.add("running", VPackValue(l._running));
+      builder.add("queued", VPackValue(l._pending.size()));
+      builder.add("rejected", VPackValue(l._rejected));
+      builder.add("maxConcurrency", VPackValue(l._limits._maxConcurrency));
+      builder.add("maxQueued", VPackValue(l._limits._maxQueued));
+    }
+
+    basics::StatisticsDistribution const& dist = l._queueTime;
+    builder.add("queueTime", VPackValue(VPackValueType::Object));
+    builder.add("sum", VPackValue(dist._total));
+    builder.add("count", VPackValue(dist._count));
+    builder.add("counts", VPackValue(VPackValueType::Array));
+    for (auto const& it : dist._counts) {
+      builder.add(VPackValue(it));
+    }
+    builder.close();
+    builder.close();
+
+    builder.close();
+  }
+}
+
+bool LaneLimiter::dispatch(size_t index, Job job) {
+  RequestPriority const prio = job._prio;
+  return _scheduler->queue(prio, [this, index, job]() mutable {
+    run(index, job);
+  });
+}
+
+void LaneLimiter::requeue(size_t index, Job job) {
+  std::shared_ptr<asio_ns::steady_timer> timer(_scheduler->newSteadyTimer());
+  timer->expires_from_now(RequeueDelay);
+  timer->async_wait([this, index, job, timer](asio_ns::error_code ec) mutable {
+    if (ec) {
+      // the scheduler is stopping
+      return;
+    }
+    if (!dispatch(index, job)) {
+      requeue(index, std::move(job));
+    }
+  });
+}
+
+void LaneLimiter::run(size_t index, Job& job) {
+  Lane& l = _lanes[index];
+
+  l._queueTime.addFigure(TRI_microtime() - job._queued);
+
+  try {
+    job._callback();
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(ERR, Logger::THREADS)
+        << "job of lane '" << LaneNames[index]
+        << "' caught exception: " << ex.what();
+  } catch (...) {
+    LOG_TOPIC(ERR, Logger::THREADS)
+        << "job of lane '" << LaneNames[index]
+        << "' caught unknown exception";
+  }
+
+  if (isLimited(index) && takeNext(index, job) && !dispatch(index, job)) {
+    // the scheduler is full. the next job was admitted already, so it is
+    // requeued instead of being executed in this thread
+    requeue(index, std::move(job));
+  }
+}
+
+bool LaneLimiter::takeNext(size_t index, Job& job) {
+  Lane& l = _lanes[index];
+  MUTEX_LOCKER(locker, l._mutex);
+
+  if (l._pending.empty()) {
+    TRI_ASSERT(l._running > 0);
+    --l._running;
+    return false;
+  }
+
+  job = std::move(l._pending.front());
+  l._pending.pop_front();
+  return true;
+}
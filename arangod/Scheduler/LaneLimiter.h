@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_SCHEDULER_LANE_LIMITER_H
+#define ARANGOD_SCHEDULER_LANE_LIMITER_H 1
+
+#include "Basics/Common.h"
+
+#include <deque>
+
+#include "Basics/Mutex.h"
+#include "GeneralServer/RequestLane.h"
+#include "Statistics/figures.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace rest {
+class Scheduler;
+
+/// @brief admission control per request lane. a lane may be limited to a
+/// number of jobs executing at the same time. further jobs of the lane wait
+/// in a queue of the lane and are handed to the scheduler when a running job
+/// of the lane finishes. if the queue of a lane is full, new jobs are
+/// rejected. the time jobs spend waiting is recorded per lane for all lanes
+class LaneLimiter {
+ public:
+  static constexpr size_t NUMBER_LANES =
+      static_cast<size_t>(RequestLane::TASK_V8) + 1;
+
+  struct Limits {
+    /// @brief maximal number of executing jobs, 0 means unlimited
+    uint64_t _maxConcurrency = 0;
+    /// @brief maximal number of waiting jobs, 0 means unlimited. only
+    /// enforced together with a concurrency limit, otherwise jobs wait in
+    /// the queues of the scheduler
+    uint64_t _maxQueued = 0;
+  };
+
+  explicit LaneLimiter(Scheduler* scheduler);
+  ~LaneLimiter();
+
+  LaneLimiter(LaneLimiter const&) = delete;
+  LaneLimiter& operator=(LaneLimiter const&) = delete;
+
+  /// @brief name of a lane as used in options and statistics
+  static char const* laneName(RequestLane lane);
+
+  /// @brief lane of a name, returns false if the name is unknown
+  static bool laneFromName(std::string const& name, RequestLane& lane);
+
+  /// @brief must be called before the first job is queued
+  void setLimits(RequestLane lane, Limits const& limits);
+
+  /// @brief queue a job of a lane. returns false if the queue of the lane
+  /// or of the scheduler is full
+  bool queue(RequestLane lane, RequestPriority prio,
+             std::function<void()> const& callback);
+
+  /// @brief add an attribute per lane to an open object
+  void toVelocyPack(velocypack::Builder& builder) const;
+
+ private:
+  struct Job {
+    RequestPriority _prio;
+    std::function<void()> _callback;
+    double _queued;
+  };
+
+  struct Lane {
+    Limits _limits;
+    mutable Mutex _mutex;
+    uint64_t _running = 0;
+    uint64_t _rejected = 0;
+    std::deque<Job> _pending;
+    basics::StatisticsDistribution _queueTime;
+  };
+
+  bool isLimited(size_t index) const {
+    return _lanes[index]._limits._maxConcurrency > 0;
+  }
+
+  /// @brief hand a job to the scheduler
+  bool dispatch(size_t index, Job job);
+
+  /// @brief hand a job which was admitted already to the scheduler again
+  /// after a short delay. used if dispatch() fails for a job which holds a
+  /// slot of its lane and must not be dropped
+  void requeue(size_t index, Job job);
+
+  /// @brief execute a job. afterwards, the slot of a limited lane is handed
+  /// to the next waiting job of the lane
+  void run(size_t index, Job& job);
+
+  /// @brief take the next waiting job, which inherits the slot of the
+  /// finished job. returns false and frees the slot if there is none
+  bool takeNext(size_t index, Job& job);
+
+ private:
+  Scheduler* _scheduler;
+  Lane _lanes[NUMBER_LANES];
+};
+
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
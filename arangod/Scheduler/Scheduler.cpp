@@ -169,13 +169,15 @@ class arangodb::SchedulerThread : public Thread {
 // -----------------------------------------------------------------------------
 
 Scheduler::Scheduler(uint64_t nrMinimum, uint64_t nrMaximum,
-                     uint64_t fifo1Size, uint64_t fifo2Size)
+                     uint64_t fifo1Size, uint64_t fifo2Size,
+                     uint64_t workStealingThreads)
     : _counters(0),
       _maxFifoSize{fifo1Size, fifo2Size, fifo2Size},
       _fifo1(_maxFifoSize[FIFO1]),
       _fifo2(_maxFifoSize[FIFO2]),
       _fifo3(_maxFifoSize[FIFO3]),
       _fifos{&_fifo1, &_fifo2, &_fifo3},
+      _laneLimiter(new LaneLimiter(this)),
       _minThreads(nrMinimum),
       _maxThreads(nrMaximum),
       _lastAllBusyStamp(0.0) {
@@ -184,6 +186,13 @@ Scheduler::Scheduler(uint64_t nrMinimum, uint64_t nrMaximum,
   _fifoSize[FIFO2] = 0;
   _fifoSize[FIFO3] = 0;
 
+  if (workStealingThreads > 0) {
+    LOG_TOPIC(DEBUG, Logger::THREADS)
+        << "Scheduler work-stealing threads: " << workStealingThreads;
+    _workStealingPool.reset(new WorkStealingPool(
+        workStealingThreads, fifo1Size, fifo2Size, fifo2Size));
+  }
+
   // setup signal handlers
   initializeSignalHandlers();
 }
@@ -250,6 +259,10 @@ void Scheduler::post(asio_ns::io_context::strand& strand,
 
 bool Scheduler::queue(RequestPriority prio,
                       std::function<void()> const& callback) {
+  if (_workStealingPool != nullptr) {
+    return _workStealingPool->queue(prio, callback);
+  }
+
   bool ok = true;
 
   switch (prio) {
@@ -333,13 +346,13 @@ void Scheduler::addQueueStatistics(velocypack::Builder& b) const {
   // if you change the names of these attributes, please make sure to
   // also change them in StatisticsWorker.cpp:computePerSeconds
   b.add("scheduler-threads", VPackValue(numRunning(counters)));
-  b.add("in-progress", VPackValue(numWorking(counters)));
+  b.add("in-progress", VPackValue(numWorking(counters) + numPoolWorking()));
   b.add("queued", VPackValue(numQueued(counters)));
-  b.add("current-fifo1", VPackValue(_fifoSize[FIFO1]));
+  b.add("current-fifo1", VPackValue(fifoSize(FIFO1)));
   b.add("fifo1-size", VPackValue(_maxFifoSize[FIFO1]));
-  b.add("current-fifo2", VPackValue(_fifoSize[FIFO2]));
+  b.add("current-fifo2", VPackValue(fifoSize(FIFO2)));
   b.add("fifo2-size", VPackValue(_maxFifoSize[FIFO2]));
-  b.add("current-fifo3", VPackValue(_fifoSize[FIFO3]));
+  b.add("current-fifo3", VPackValue(fifoSize(FIFO3)));
   b.add("fifo3-size", VPackValue(_maxFifoSize[FIFO3]));
 }
 
@@ -347,11 +360,42 @@ Scheduler::QueueStatistics Scheduler::queueStatistics() const {
   auto counters = getCounters();
 
   return QueueStatistics{numRunning(counters),
-                         numWorking(counters),
+                         numWorking(counters) + numPoolWorking(),
                          numQueued(counters),
-                         static_cast<uint64_t>(_fifoSize[FIFO1]),
-                         static_cast<uint64_t>(_fifoSize[FIFO2]),
-                         static_cast<uint64_t>(_fifoSize[FIFO3])};
+                         fifoSize(FIFO1),
+                         fifoSize(FIFO2),
+                         fifoSize(FIFO3)};
+}
+
+double Scheduler::queueFillGrade() const {
+  uint64_t used = 0;
+  uint64_t capacity = 0;
+  for (int64_t i = 0; i < NUMBER_FIFOS; ++i) {
+    if (_maxFifoSize[i] > 0) {
+      used += std::min(fifoSize(i), _maxFifoSize[i]);
+      capacity += _maxFifoSize[i];
+    }
+  }
+  if (capacity == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(used) / static_cast<double>(capacity);
+}
+
+uint64_t Scheduler::fifoSize(int64_t fifo) const {
+  if (_workStealingPool != nullptr) {
+    static RequestPriority const priorities[NUMBER_FIFOS] = {
+        RequestPriority::HIGH, RequestPriority::MED, RequestPriority::LOW};
+    return _workStealingPool->numQueued(priorities[fifo]);
+  }
+  return static_cast<uint64_t>(_fifoSize[fifo]);
+}
+
+uint64_t Scheduler::numPoolWorking() const {
+  if (_workStealingPool != nullptr) {
+    return _workStealingPool->numWorking();
+  }
+  return 0;
 }
 
 std::string Scheduler::infoStatus() {
@@ -359,13 +403,14 @@ std::string Scheduler::infoStatus() {
 
   return "scheduler " + std::to_string(numRunning(counters)) + " (" +
          std::to_string(_minThreads) + "<" + std::to_string(_maxThreads) +
-         ") in-progress " + std::to_string(numWorking(counters)) + " queued " +
+         ") in-progress " +
+         std::to_string(numWorking(counters) + numPoolWorking()) + " queued " +
          std::to_string(numQueued(counters)) +
-         " F1 " + std::to_string(_fifoSize[FIFO1]) +
+         " F1 " + std::to_string(fifoSize(FIFO1)) +
          " (<=" + std::to_string(_maxFifoSize[FIFO1]) + ") F2 " +
-         std::to_string(_fifoSize[FIFO2]) +
+         std::to_string(fifoSize(FIFO2)) +
          " (<=" + std::to_string(_maxFifoSize[FIFO2]) + ") F3 " +
-         std::to_string(_fifoSize[FIFO3]) +
+         std::to_string(fifoSize(FIFO3)) +
          " (<=" + std::to_string(_maxFifoSize[FIFO3]) + ")";
 }
 
@@ -493,6 +538,12 @@ bool Scheduler::start() {
   startManagerThread();
   startRebalancer();
 
+  if (_workStealingPool != nullptr && !_workStealingPool->start()) {
+    LOG_TOPIC(ERR, Logger::THREADS)
+        << "could not start the scheduler worker threads";
+    return false;
+  }
+
   LOG_TOPIC(TRACE, arangodb::Logger::FIXME)
       << "all scheduler threads are up and running";
 
@@ -513,6 +564,10 @@ void Scheduler::beginShutdown() {
   _serviceGuard.reset();
   _ioContext->stop();
 
+  if (_workStealingPool != nullptr) {
+    _workStealingPool->beginShutdown();
+  }
+
   // set the flag AFTER stopping the threads
   setStopping();
 }
@@ -532,6 +587,12 @@ void Scheduler::shutdown() {
     std::this_thread::sleep_for(std::chrono::microseconds(20000));
   }
 
+  // waits for the worker threads and drops the jobs they did not execute,
+  // for the same reason as the ioContext below
+  if (_workStealingPool != nullptr) {
+    _workStealingPool->shutdown();
+  }
+
   // One has to clean up the ioContext here, because there could a lambda
   // in its queue, that requires for it finalization some object (for example vocbase)
   // that would already be destroyed
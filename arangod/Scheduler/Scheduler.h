@@ -34,6 +34,8 @@
 #include "Basics/socket-utils.h"
 #include "Endpoint/Endpoint.h"
 #include "GeneralServer/RequestLane.h"
+#include "Scheduler/LaneLimiter.h"
+#include "Scheduler/WorkStealingPool.h"
 
 namespace arangodb {
 class JobGuard;
@@ -60,7 +62,8 @@ class Scheduler : public std::enable_shared_from_this<Scheduler> {
 
  public:
   Scheduler(uint64_t minThreads, uint64_t maxThreads,
-            uint64_t fifo1Size, uint64_t fifo2Size);
+            uint64_t fifo1Size, uint64_t fifo2Size,
+            uint64_t workStealingThreads = 0);
   virtual ~Scheduler();
 
   // queue handling:
@@ -85,6 +88,11 @@ class Scheduler : public std::enable_shared_from_this<Scheduler> {
   // and the number of queues jobs it will either queue the job
   // directly in the Scheduler queue or move it to the corresponding
   // FIFO.
+  //
+  // If the scheduler is created with a number of work-stealing threads,
+  // `queue` hands all jobs to a `WorkStealingPool` instead. The
+  // `io_context` threads then only serve I/O and jobs posted on strands,
+  // and the FIFO statistics report the queues of the pool.
 
  public:
   struct QueueStatistics {
@@ -97,10 +105,27 @@ class Scheduler : public std::enable_shared_from_this<Scheduler> {
   };
 
   bool queue(RequestPriority prio, std::function<void()> const&);
+
+  // queue a job of a request lane, subject to the limits of the lane
+  bool queue(RequestLane lane, RequestPriority prio,
+             std::function<void()> const& callback) {
+    return _laneLimiter->queue(lane, prio, callback);
+  }
+
+  void setLaneLimits(RequestLane lane, LaneLimiter::Limits const& limits) {
+    _laneLimiter->setLimits(lane, limits);
+  }
   void post(asio_ns::io_context::strand&, std::function<void()> const callback);
 
   void addQueueStatistics(velocypack::Builder&) const;
+  void addLaneStatistics(velocypack::Builder& b) const {
+    _laneLimiter->toVelocyPack(b);
+  }
   QueueStatistics queueStatistics() const;
+
+  // share of the FIFOs of limited size which is occupied, between 0 and 1.
+  // clients can use it to adjust their request rate
+  double queueFillGrade() const;
   std::string infoStatus();
 
   bool isRunning() const { return numRunning(_counters) > 0; }
@@ -183,6 +208,8 @@ class Scheduler : public std::enable_shared_from_this<Scheduler> {
   };
 
   bool pushToFifo(int64_t fifo, std::function<void()> const& callback);
+  uint64_t fifoSize(int64_t fifo) const;
+  uint64_t numPoolWorking() const;
   bool popFifo(int64_t fifo);
 
   static constexpr int64_t NUMBER_FIFOS = 3;
@@ -198,6 +225,11 @@ class Scheduler : public std::enable_shared_from_this<Scheduler> {
   boost::lockfree::queue<FifoJob*> _fifo3;
   boost::lockfree::queue<FifoJob*>* _fifos[NUMBER_FIFOS];
 
+  // executes the queued jobs instead of the io_context, if enabled
+  std::unique_ptr<WorkStealingPool> _workStealingPool;
+
+  std::unique_ptr<LaneLimiter> _laneLimiter;
+
   // the following methds create tasks in the `io_context`.
   // The `io_context` itself is not exposed because everything
   // should use the method `post` of the Scheduler.
@@ -86,6 +86,20 @@ void SchedulerFeature::collectOptions(
   options->addHiddenOption("--server.prio1-size", "size of the priority 1 fifo",
                            new UInt64Parameter(&_fifo1Size));
 
+  options->addOption(
+      "--server.work-stealing-threads",
+      "number of threads executing queued requests with per-thread queues "
+      "and work stealing (0 = disabled, requests are executed by the "
+      "I/O threads)",
+      new UInt64Parameter(&_workStealingThreads));
+
+  options->addOption(
+      "--server.lane-limit",
+      "limits of a request lane, as '<lane>=<max-concurrency>[:<max-queued>]' "
+      "(e.g. 'client-aql=16:1024'). requests of a lane with a full queue are "
+      "rejected with HTTP 503",
+      new VectorParameter<StringParameter>(&_laneLimits));
+
   // obsolete options
   options->addObsoleteOption("--server.threads", "number of threads", true);
 
@@ -113,6 +127,41 @@ void SchedulerFeature::validateOptions(
   if (_fifo2Size < 1) {
     _fifo2Size = 1;
   }
+
+  auto parseNumber = [](std::string const& value, uint64_t& result) -> bool {
+    if (value.empty() ||
+        value.find_first_not_of("0123456789") != std::string::npos) {
+      return false;
+    }
+    result = std::strtoull(value.c_str(), nullptr, 10);
+    return true;
+  };
+
+  _parsedLaneLimits.clear();
+  for (auto const& it : _laneLimits) {
+    size_t const eq = it.find('=');
+    RequestLane lane;
+    if (eq == std::string::npos ||
+        !LaneLimiter::laneFromName(it.substr(0, eq), lane)) {
+      LOG_TOPIC(FATAL, arangodb::Logger::THREADS)
+          << "invalid value for --server.lane-limit: '" << it
+          << "', expecting '<lane>=<max-concurrency>[:<max-queued>]'";
+      FATAL_ERROR_EXIT();
+    }
+
+    std::string const value = it.substr(eq + 1);
+    size_t const colon = value.find(':');
+    LaneLimiter::Limits limits;
+    if (!parseNumber(value.substr(0, colon), limits._maxConcurrency) ||
+        (colon != std::string::npos &&
+         !parseNumber(value.substr(colon + 1), limits._maxQueued))) {
+      LOG_TOPIC(FATAL, arangodb::Logger::THREADS)
+          << "invalid value for --server.lane-limit: '" << it
+          << "', expecting '<lane>=<max-concurrency>[:<max-queued>]'";
+      FATAL_ERROR_EXIT();
+    }
+    _parsedLaneLimits.emplace_back(lane, limits);
+  }
 }
 
 void SchedulerFeature::start() {
@@ -303,7 +352,12 @@ bool CtrlHandler(DWORD eventType) {
 
 void SchedulerFeature::buildScheduler() {
   _scheduler = std::make_shared<Scheduler>(_nrMinimalThreads, _nrMaximalThreads,
-                                           _fifo1Size, _fifo2Size);
+                                           _fifo1Size, _fifo2Size,
+                                           _workStealingThreads);
+
+  for (auto const& it : _parsedLaneLimits) {
+    _scheduler->setLaneLimits(it.first, it.second);
+  }
 
   SCHEDULER = _scheduler.get();
 }
@@ -26,6 +26,8 @@
 
 #include "ApplicationFeatures/ApplicationFeature.h"
 
+#include "GeneralServer/RequestLane.h"
+#include "Scheduler/LaneLimiter.h"
 #include "Scheduler/Socket.h"
 
 namespace arangodb {
@@ -58,6 +60,10 @@ class SchedulerFeature final : public application_features::ApplicationFeature {
   uint64_t _queueSize = 128;
   uint64_t _fifo1Size = 1024 * 1024;
   uint64_t _fifo2Size = 4096;
+  uint64_t _workStealingThreads = 0;
+  std::vector<std::string> _laneLimits;
+  std::vector<std::pair<RequestLane, rest::LaneLimiter::Limits>>
+      _parsedLaneLimits;
 
  public:
   size_t concurrency() const { return static_cast<size_t>(_nrMaximalThreads); }
@@ -25,6 +25,8 @@
 
 #include "Basics/Common.h"
 
+#include <array>
+
 #include "Basics/StringBuffer.h"
 #include "Basics/asio_ns.h"
 #include "Logger/Logger.h"
@@ -41,6 +43,10 @@ typedef std::function<void(const asio_ns::error_code& ec,
                            std::size_t transferred)>
     AsyncHandler;
 
+// data written with a single call, e.g. the header and the body of a
+// response. the buffers may be empty
+typedef std::array<asio_ns::const_buffer, 2> WriteBufferSequence;
+
 class Socket {
  public:
   Socket(rest::GeneralServer::IoContext &context, bool encrypted)
@@ -95,9 +101,9 @@ class Socket {
   virtual std::string peerAddress() const = 0;
   virtual int peerPort() const = 0;
   virtual void setNonBlocking(bool) = 0;
-  virtual size_t writeSome(basics::StringBuffer* buffer,
+  virtual size_t writeSome(WriteBufferSequence const& buffers,
                            asio_ns::error_code& ec) = 0;
-  virtual void asyncWrite(asio_ns::mutable_buffers_1 const& buffer,
+  virtual void asyncWrite(WriteBufferSequence const& buffers,
                           AsyncHandler const& handler) = 0;
   virtual size_t readSome(asio_ns::mutable_buffers_1 const& buffer,
                           asio_ns::error_code& ec) = 0;
@@ -55,6 +55,7 @@ SocketTask::SocketTask(GeneralServer &server, GeneralServer::IoContext &context,
       _readBuffer(READ_BLOCK_SIZE + 1, false),
       _stringBuffers{_stringBuffersArena},
       _writeBuffer(nullptr, nullptr),
+      _unsentBytes(0),
       _keepAliveTimeout(static_cast<long>(keepAliveTimeout * 1000)),
       _keepAliveTimer(context.newDeadlineTimer(_keepAliveTimeout)),
       _useKeepAliveTimer(keepAliveTimeout > 0.0),
@@ -156,6 +157,7 @@ void SocketTask::addWriteBuffer(WriteBuffer&& buffer) {
 
   TRI_ASSERT(!buffer.empty());
   if (!buffer.empty()) {
+    _unsentBytes.fetch_add(buffer.length(), std::memory_order_relaxed);
     if (!_writeBuffer.empty()) {
       _writeBuffers.emplace_back(std::move(buffer));
       return;
@@ -172,16 +174,20 @@ bool SocketTask::completedWriteBuffer() {
   TRI_ASSERT(_peer->runningInThisThread());
 
   RequestStatistics::SET_WRITE_END(_writeBuffer._statistics);
+  _unsentBytes.fetch_sub(_writeBuffer.length(), std::memory_order_relaxed);
   _writeBuffer.release(this);  // try to recycle the string buffer
   if (_writeBuffers.empty()) {
     if (_closeRequested) {
       closeStreamNoLock();
+    } else {
+      writeProgress();
     }
     return false;
   }
 
   _writeBuffer = std::move(_writeBuffers.front());
   _writeBuffers.pop_front();
+  writeProgress();
 
   return true;
 }
@@ -220,6 +226,7 @@ void SocketTask::closeStreamNoLock() {
   _closeRequested.store(false, std::memory_order_release);
   _keepAliveTimer->cancel();
   _keepAliveTimerActive.store(false, std::memory_order_relaxed);
+  writeProgress();
 }
 
 // -----------------------------------------------------------------------------
@@ -466,7 +473,7 @@ void SocketTask::asyncWriteSome() {
   }
 
   TRI_ASSERT(_writeBuffer._buffer != nullptr);
-  size_t total = _writeBuffer._buffer->length();
+  size_t total = _writeBuffer.length();
   size_t written = 0;
 
   TRI_ASSERT(!_abandoned);
@@ -481,9 +488,9 @@ void SocketTask::asyncWriteSome() {
       TRI_ASSERT(_writeBuffer._buffer != nullptr);
 
       // we can directly skip sending empty buffers
-      if (_writeBuffer._buffer->length() > 0) {
+      if (total > 0) {
         RequestStatistics::SET_WRITE_START(_writeBuffer._statistics);
-        written = _peer->writeSome(_writeBuffer._buffer, err);
+        written = _peer->writeSome(_writeBuffer.sequence(0), err);
         
         RequestStatistics::ADD_SENT_BYTES(_writeBuffer._statistics, written);
 
@@ -502,7 +509,7 @@ void SocketTask::asyncWriteSome() {
 
       // try to send next buffer
       TRI_ASSERT(_writeBuffer._buffer != nullptr);
-      total = _writeBuffer._buffer->length();
+      total = _writeBuffer.length();
     }
 
     // write could have blocked which is the only acceptable error
@@ -531,7 +538,7 @@ void SocketTask::asyncWriteSome() {
   auto self = shared_from_this();
 
   _peer->asyncWrite(
-      asio_ns::buffer(_writeBuffer._buffer->begin() + written, total - written),
+      _writeBuffer.sequence(written),
       [self, this](const asio_ns::error_code& ec, std::size_t transferred) {
         if (_abandoned.load(std::memory_order_acquire)) {
           return;
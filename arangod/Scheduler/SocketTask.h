@@ -42,6 +42,7 @@ class ConnectionStatistics;
 namespace rest {
 class SocketTask : virtual public IoTask {
   friend class HttpCommTask;
+  friend class H2CommTask;
 
   explicit SocketTask(SocketTask const&) = delete;
   SocketTask& operator=(SocketTask const&) = delete;
@@ -75,17 +76,26 @@ class SocketTask : virtual public IoTask {
  protected:
   struct WriteBuffer {
     basics::StringBuffer* _buffer;
+    // optional, written after _buffer without copying it into _buffer
+    basics::StringBuffer* _body;
     RequestStatistics* _statistics;
 
     WriteBuffer(basics::StringBuffer* buffer, RequestStatistics* statistics)
-        : _buffer(buffer), _statistics(statistics) {}
+        : _buffer(buffer), _body(nullptr), _statistics(statistics) {}
+
+    WriteBuffer(basics::StringBuffer* buffer, basics::StringBuffer* body,
+                RequestStatistics* statistics)
+        : _buffer(buffer), _body(body), _statistics(statistics) {}
 
     WriteBuffer(WriteBuffer const&) = delete;
     WriteBuffer& operator=(WriteBuffer const&) = delete;
 
     WriteBuffer(WriteBuffer&& other) noexcept
-        : _buffer(other._buffer), _statistics(other._statistics) {
+        : _buffer(other._buffer),
+          _body(other._body),
+          _statistics(other._statistics) {
       other._buffer = nullptr;
+      other._body = nullptr;
       other._statistics = nullptr;
     }
 
@@ -96,9 +106,11 @@ class SocketTask : virtual public IoTask {
 
         // take over ownership from other
         _buffer = other._buffer;
+        _body = other._body;
         _statistics = other._statistics;
         // fix other
         other._buffer = nullptr;
+        other._body = nullptr;
         other._statistics = nullptr;
       }
       return *this;
@@ -108,31 +120,72 @@ class SocketTask : virtual public IoTask {
 
     bool empty() const noexcept { return _buffer == nullptr; }
 
+    size_t length() const noexcept {
+      return _buffer->length() + (_body != nullptr ? _body->length() : 0);
+    }
+
+    // the data after the first offset bytes
+    WriteBufferSequence sequence(size_t offset) const {
+      size_t const bufferLength = _buffer->length();
+      size_t const bodyLength = (_body != nullptr ? _body->length() : 0);
+
+      if (offset < bufferLength) {
+        return {{asio_ns::const_buffer(_buffer->begin() + offset,
+                                       bufferLength - offset),
+                 asio_ns::const_buffer(
+                     _body != nullptr ? _body->begin() : nullptr,
+                     bodyLength)}};
+      }
+
+      offset -= bufferLength;
+      TRI_ASSERT(offset <= bodyLength);
+      return {{asio_ns::const_buffer(),
+               asio_ns::const_buffer(_body->begin() + offset,
+                                     bodyLength - offset)}};
+    }
+
     void clear() noexcept {
       _buffer = nullptr;
+      _body = nullptr;
       _statistics = nullptr;
     }
 
     void release(SocketTask* task = nullptr) {
-      if (_buffer != nullptr) {
-        if (task != nullptr) {
-          task->returnStringBuffer(_buffer);
-        } else {
-          delete _buffer;
-        }
-        _buffer = nullptr;
-      }
+      release(_buffer, task);
+      release(_body, task);
 
       if (_statistics != nullptr) {
         _statistics->release();
         _statistics = nullptr;
       }
     }
+
+   private:
+    static void release(basics::StringBuffer*& buffer, SocketTask* task) {
+      if (buffer != nullptr) {
+        if (task != nullptr) {
+          task->returnStringBuffer(buffer);
+        } else {
+          delete buffer;
+        }
+        buffer = nullptr;
+      }
+    }
   };
 
   // will be run in strand
   void addWriteBuffer(WriteBuffer&&);
 
+  // bytes of the write buffers which were added but are not yet written,
+  // no need to run on strand
+  size_t unsentBytes() const {
+    return _unsentBytes.load(std::memory_order_relaxed);
+  }
+
+  // called in the strand after a write buffer was written to the socket,
+  // or the stream was closed
+  virtual void writeProgress() {}
+
   // will be run in strand
   void closeStream();
 
@@ -181,6 +234,7 @@ class SocketTask : virtual public IoTask {
 
   WriteBuffer _writeBuffer;
   std::list<WriteBuffer> _writeBuffers;
+  std::atomic<size_t> _unsentBytes;
 
   boost::posix_time::milliseconds _keepAliveTimeout;
   std::unique_ptr<asio_ns::deadline_timer> _keepAliveTimer;
@@ -50,15 +50,14 @@ class SocketTcp final : public Socket {
 
   void setNonBlocking(bool v) override { _socket->non_blocking(v); }
 
-  size_t writeSome(basics::StringBuffer* buffer,
+  size_t writeSome(WriteBufferSequence const& buffers,
                    asio_ns::error_code& ec) override {
-    return _socket->write_some(
-        asio_ns::buffer(buffer->begin(), buffer->length()), ec);
+    return _socket->write_some(buffers, ec);
   }
 
-  void asyncWrite(asio_ns::mutable_buffers_1 const& buffer,
+  void asyncWrite(WriteBufferSequence const& buffers,
                   AsyncHandler const& handler) override {
-    return asio_ns::async_write(*_socket, buffer, handler);
+    return asio_ns::async_write(*_socket, buffers, handler);
   }
 
   size_t readSome(asio_ns::mutable_buffers_1 const& buffer,
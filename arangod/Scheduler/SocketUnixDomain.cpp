@@ -26,15 +26,14 @@
 
 using namespace arangodb;
 
-size_t SocketUnixDomain::writeSome(basics::StringBuffer* buffer,
+size_t SocketUnixDomain::writeSome(WriteBufferSequence const& buffers,
                                    asio_ns::error_code& ec) {
-  return _socket->write_some(asio_ns::buffer(buffer->begin(), buffer->length()),
-                            ec);
+  return _socket->write_some(buffers, ec);
 }
 
-void SocketUnixDomain::asyncWrite(asio_ns::mutable_buffers_1 const& buffer,
+void SocketUnixDomain::asyncWrite(WriteBufferSequence const& buffers,
                                   AsyncHandler const& handler) {
-  return asio_ns::async_write(*_socket, buffer, handler);
+  return asio_ns::async_write(*_socket, buffers, handler);
 }
 
 size_t SocketUnixDomain::readSome(asio_ns::mutable_buffers_1 const& buffer,
@@ -47,10 +47,10 @@ class SocketUnixDomain final : public Socket {
 
   void setNonBlocking(bool v) override { _socket->non_blocking(v); }
 
-  size_t writeSome(basics::StringBuffer* buffer,
+  size_t writeSome(WriteBufferSequence const& buffers,
                    asio_ns::error_code& ec) override;
 
-  void asyncWrite(asio_ns::mutable_buffers_1 const& buffer,
+  void asyncWrite(WriteBufferSequence const& buffers,
                   AsyncHandler const& handler) override;
 
   size_t readSome(asio_ns::mutable_buffers_1 const& buffer,
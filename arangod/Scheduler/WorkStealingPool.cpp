@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "WorkStealingPool.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/Thread.h"
+#include "Logger/Logger.h"
+#include "Random/RandomGenerator.h"
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+class arangodb::rest::WorkStealingThread final : public Thread {
+ public:
+  WorkStealingThread(WorkStealingPool* pool, size_t self)
+      : Thread("SchedulerWorker"), _pool(pool), _self(self) {}
+
+  ~WorkStealingThread() { shutdown(); }
+
+ protected:
+  void run() override { _pool->work(_self); }
+
+ private:
+  WorkStealingPool* _pool;
+  size_t const _self;
+};
+
+thread_local WorkStealingPool::Worker* WorkStealingPool::_currentWorker =
+    nullptr;
+
+constexpr size_t WorkStealingPool::NUMBER_PRIORITIES;
+
+WorkStealingPool::WorkStealingPool(size_t numWorkers, uint64_t maxHigh,
+                                   uint64_t maxMed, uint64_t maxLow)
+    : _maxQueued{maxHigh, maxMed, maxLow}, _sleeping(0), _stopping(false) {
+  TRI_ASSERT(numWorkers > 0);
+
+  for (size_t i = 0; i < NUMBER_PRIORITIES; ++i) {
+    _injectedSize[i].store(0, std::memory_order_relaxed);
+  }
+
+  _workers.reserve(numWorkers);
+  for (size_t i = 0; i < numWorkers; ++i) {
+    _workers.emplace_back(new Worker(this));
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  beginShutdown();
+  shutdown();
+}
+
+bool WorkStealingPool::start() {
+  _threads.reserve(_workers.size());
+  for (size_t i = 0; i < _workers.size(); ++i) {
+    _threads.emplace_back(new WorkStealingThread(this, i));
+    if (!_threads.back()->start()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WorkStealingPool::beginShutdown() {
+  _stopping.store(true);
+
+  CONDITION_LOCKER(guard, _condition);
+  guard.broadcast();
+}
+
+void WorkStealingPool::shutdown() {
+  // joins the threads
+  _threads.clear();
+
+  // jobs that were not executed are dropped, like the ones remaining in
+  // the io_context
+  Job* job = nullptr;
+  for (size_t i = 0; i < NUMBER_PRIORITIES; ++i) {
+    while (_injected[i].pop(job)) {
+      delete job;
+    }
+    _injectedSize[i].store(0, std::memory_order_relaxed);
+    for (auto& worker : _workers) {
+      while ((job = worker->_queues[i].steal()) != nullptr) {
+        delete job;
+      }
+    }
+  }
+}
+
+size_t WorkStealingPool::index(RequestPriority prio) {
+  switch (prio) {
+    case RequestPriority::HIGH:
+      return 0;
+    case RequestPriority::MED:
+      return 1;
+    case RequestPriority::LOW:
+      return 2;
+  }
+  TRI_ASSERT(false);
+  return 2;
+}
+
+bool WorkStealingPool::queue(RequestPriority prio,
+                             std::function<void()> const& callback) {
+  size_t const p = index(prio);
+  auto job = std::make_unique<Job>(callback);
+
+  Worker* worker = _currentWorker;
+  if (worker != nullptr && worker->_pool == this &&
+      worker->_queues[p].push(job.get())) {
+    // queued by a worker, e.g. a continuation. idle workers will steal it
+    // if this worker stays busy
+    job.release();
+  } else {
+    if (_maxQueued[p] > 0 &&
+        _injectedSize[p].load(std::memory_order_relaxed) >= _maxQueued[p]) {
+      return false;
+    }
+
+    try {
+      if (!_injected[p].push(job.get())) {
+        return false;
+      }
+    } catch (...) {
+      return false;
+    }
+    job.release();
+    _injectedSize[p].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  wakeUp();
+  return true;
+}
+
+uint64_t WorkStealingPool::numWorking() const {
+  uint64_t result = 0;
+  for (auto const& worker : _workers) {
+    if (worker->_working.load(std::memory_order_relaxed)) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+uint64_t WorkStealingPool::numQueued(RequestPriority prio) const {
+  size_t const p = index(prio);
+  uint64_t result = _injectedSize[p].load(std::memory_order_relaxed);
+  for (auto const& worker : _workers) {
+    result += worker->_queues[p].size();
+  }
+  return result;
+}
+
+WorkStealingPool::Job* WorkStealingPool::findJob(size_t self) {
+  Worker* worker = _workers[self].get();
+  size_t const n = _workers.size();
+
+  for (size_t p = 0; p < NUMBER_PRIORITIES; ++p) {
+    Job* job = worker->_queues[p].steal();
+    if (job != nullptr) {
+      return job;
+    }
+
+    if (_injected[p].pop(job)) {
+      _injectedSize[p].fetch_sub(1, std::memory_order_relaxed);
+      return job;
+    }
+
+    // start at a random victim, so that the thieves do not all compete
+    // for the queues of the first workers
+    size_t const start = static_cast<size_t>(
+        RandomGenerator::interval(static_cast<uint32_t>(n - 1)));
+    for (size_t i = 0; i < n; ++i) {
+      size_t const victim = (start + i) % n;
+      if (victim == self) {
+        continue;
+      }
+      job = _workers[victim]->_queues[p].steal();
+      if (job != nullptr) {
+        return job;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+void WorkStealingPool::wakeUp() {
+  // pairs with the increment in work(): either the worker sees the new job
+  // when it checks again, or we see that it is going to sleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_sleeping.load(std::memory_order_relaxed) > 0) {
+    CONDITION_LOCKER(guard, _condition);
+    guard.signal();
+  }
+}
+
+void WorkStealingPool::work(size_t self) {
+  Worker* worker = _workers[self].get();
+  _currentWorker = worker;
+
+  while (!_stopping.load(std::memory_order_relaxed)) {
+    Job* job = findJob(self);
+
+    if (job == nullptr) {
+      _sleeping.fetch_add(1, std::memory_order_seq_cst);
+      {
+        CONDITION_LOCKER(guard, _condition);
+        job = findJob(self);
+        if (job == nullptr && !_stopping.load(std::memory_order_relaxed)) {
+          // the timeout only guards against missed wake-ups
+          guard.wait(100000);
+        }
+      }
+      _sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+      if (job == nullptr) {
+        continue;
+      }
+    }
+
+    std::unique_ptr<Job> guard(job);
+    worker->_working.store(true, std::memory_order_relaxed);
+    try {
+      job->_callback();
+    } catch (std::exception const& ex) {
+      LOG_TOPIC(ERR, Logger::THREADS)
+          << "scheduler worker caught exception: " << ex.what();
+    } catch (...) {
+      LOG_TOPIC(ERR, Logger::THREADS)
+          << "scheduler worker caught unknown exception";
+    }
+    worker->_working.store(false, std::memory_order_relaxed);
+  }
+
+  _currentWorker = nullptr;
+}
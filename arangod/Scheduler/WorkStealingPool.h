@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_SCHEDULER_WORK_STEALING_POOL_H
+#define ARANGOD_SCHEDULER_WORK_STEALING_POOL_H 1
+
+#include "Basics/Common.h"
+
+#include <boost/lockfree/queue.hpp>
+
+#include "Basics/ConditionVariable.h"
+#include "GeneralServer/RequestLane.h"
+#include "Scheduler/WorkStealingQueue.h"
+
+namespace arangodb {
+namespace rest {
+class WorkStealingThread;
+
+/// @brief pool of worker threads executing the jobs of the scheduler.
+/// every worker has one lock-free queue per priority. jobs queued by a
+/// worker go to its own queue, jobs queued by other threads (e.g. the I/O
+/// threads) go to shared lock-free queues. idle workers take jobs from
+/// their own queues first, then from the shared ones and then steal them
+/// from other workers, always trying all sources of a higher priority
+/// before the ones of a lower priority
+class WorkStealingPool {
+  friend class WorkStealingThread;
+
+ public:
+  /// @brief maximal number of queued jobs per priority, only enforced for
+  /// jobs queued by non-worker threads. 0 means unlimited
+  WorkStealingPool(size_t numWorkers, uint64_t maxHigh, uint64_t maxMed,
+                   uint64_t maxLow);
+  ~WorkStealingPool();
+
+  WorkStealingPool(WorkStealingPool const&) = delete;
+  WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+
+  bool start();
+  void beginShutdown();
+  void shutdown();
+
+  /// @brief queue a job. returns false if the queue of the priority is full
+  bool queue(RequestPriority prio, std::function<void()> const& callback);
+
+  size_t numWorkers() const { return _workers.size(); }
+
+  /// @brief number of workers currently executing a job
+  uint64_t numWorking() const;
+
+  /// @brief approximate number of queued jobs of a priority
+  uint64_t numQueued(RequestPriority prio) const;
+
+ private:
+  static constexpr size_t NUMBER_PRIORITIES = 3;
+
+  struct Job {
+    explicit Job(std::function<void()> const& callback)
+        : _callback(callback) {}
+    std::function<void()> _callback;
+  };
+
+  struct Worker {
+    explicit Worker(WorkStealingPool* pool) : _pool(pool), _working(false) {}
+
+    WorkStealingPool* const _pool;
+    WorkStealingQueue<Job> _queues[NUMBER_PRIORITIES];
+    std::atomic<bool> _working;
+  };
+
+  static size_t index(RequestPriority prio);
+
+  /// @brief find the next job for a worker, or a nullptr if there is none
+  Job* findJob(size_t self);
+
+  /// @brief wake up one sleeping worker, if there is any
+  void wakeUp();
+
+  /// @brief main loop of a worker
+  void work(size_t self);
+
+ private:
+  uint64_t const _maxQueued[NUMBER_PRIORITIES];
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::vector<std::unique_ptr<WorkStealingThread>> _threads;
+
+  /// @brief jobs queued by threads that are not workers of this pool
+  boost::lockfree::queue<Job*> _injected[NUMBER_PRIORITIES];
+  std::atomic<uint64_t> _injectedSize[NUMBER_PRIORITIES];
+
+  /// @brief number of workers that are about to sleep or sleeping
+  std::atomic<size_t> _sleeping;
+  basics::ConditionVariable _condition;
+
+  std::atomic<bool> _stopping;
+
+  /// @brief the worker running in the current thread, if any
+  static thread_local Worker* _currentWorker;
+};
+
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
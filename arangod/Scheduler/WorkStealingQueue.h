@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_SCHEDULER_WORK_STEALING_QUEUE_H
+#define ARANGOD_SCHEDULER_WORK_STEALING_QUEUE_H 1
+
+#include "Basics/Common.h"
+
+#include <atomic>
+
+namespace arangodb {
+namespace rest {
+
+/// @brief bounded lock-free queue of a single worker thread, after Chase and
+/// Lev. only the owning thread may push, any thread may take elements from
+/// the front, including the owner. elements are taken in the order they were
+/// pushed, so the jobs of a worker are executed in arrival order, like in the
+/// shared FIFOs
+template <typename T, size_t Capacity = 1024>
+class WorkStealingQueue {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "capacity must be a power of 2");
+
+ public:
+  WorkStealingQueue() : _top(0), _bottom(0) {
+    for (size_t i = 0; i < Capacity; ++i) {
+      _slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  WorkStealingQueue(WorkStealingQueue const&) = delete;
+  WorkStealingQueue& operator=(WorkStealingQueue const&) = delete;
+
+  /// @brief append an element. must only be called by the owning thread.
+  /// returns false if the queue is full
+  bool push(T* value) {
+    int64_t const b = _bottom.load(std::memory_order_relaxed);
+    int64_t const t = _top.load(std::memory_order_acquire);
+    if (b - t >= static_cast<int64_t>(Capacity)) {
+      return false;
+    }
+    _slots[b & (Capacity - 1)].store(value, std::memory_order_relaxed);
+    // publish the element before the new bottom
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// @brief take the oldest element. may be called by any thread. returns a
+  /// nullptr if the queue is empty or another thread won the race for the
+  /// element
+  T* steal() {
+    int64_t t = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t const b = _bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+      return nullptr;
+    }
+    T* value = _slots[t & (Capacity - 1)].load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return value;
+  }
+
+  /// @brief approximate number of elements
+  size_t size() const {
+    int64_t const b = _bottom.load(std::memory_order_relaxed);
+    int64_t const t = _top.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+ private:
+  // top and bottom on separate cache lines, because thieves only write the
+  // former and the owner only writes the latter
+  std::atomic<int64_t> _top;
+  char _padding1[64 - sizeof(std::atomic<int64_t>)];
+  std::atomic<int64_t> _bottom;
+  char _padding2[64 - sizeof(std::atomic<int64_t>)];
+  std::atomic<T*> _slots[Capacity];
+};
+
+}  // namespace rest
+}  // namespace arangodb
+
+#endif
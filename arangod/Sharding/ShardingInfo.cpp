@@ -92,25 +92,20 @@ ShardingInfo::ShardingInfo(arangodb::velocypack::Slice info, LogicalCollection*
     bool isError = true;
     if (replicationFactorSlice.isNumber()) {
       _replicationFactor = replicationFactorSlice.getNumber<size_t>();
-      // mop: only allow satellite collections to be created explicitly
-      if (_replicationFactor > 0 && _replicationFactor <= 10) {
+      // a replicationFactor of 0 makes a satellite collection
+      if (_replicationFactor <= 10) {
         isError = false;
-#ifdef USE_ENTERPRISE
-      } else if (_replicationFactor == 0) {
-        isError = false;
-#endif
       }
-    }
-#ifdef USE_ENTERPRISE
-    else if (replicationFactorSlice.isString() &&
-             replicationFactorSlice.copyString() == "satellite") {
+    } else if (replicationFactorSlice.isString() &&
+               replicationFactorSlice.copyString() == "satellite") {
+      // a satellite collection has a single shard, which is replicated
+      // to all DB servers
       _replicationFactor = 0;
       _numberOfShards = 1;
       _distributeShardsLike = "";
       _avoidServers.clear();
       isError = false;
     }
-#endif
     if (isError) {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
                                      "invalid replicationFactor");
@@ -34,6 +34,7 @@
 
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -49,19 +50,72 @@ void preventUseOnSmartEdgeCollection(LogicalCollection const* collection, std::s
 }
 
 inline void parseAttributeAndPart(std::string const& attr,
-                                  std::string& realAttr, Part& part) {
+                                  arangodb::velocypack::StringRef& realAttr, Part& part) {
   if (attr.size() > 0 && attr.back() == ':') {
-    realAttr = attr.substr(0, attr.size() - 1);
+    realAttr = arangodb::velocypack::StringRef(attr.data(), attr.size() - 1);
     part = Part::FRONT;
   } else if (attr.size() > 0 && attr.front() == ':') {
-    realAttr = attr.substr(1);
+    realAttr = arangodb::velocypack::StringRef(attr.data() + 1, attr.size() - 1);
     part = Part::BACK;
   } else {
-    realAttr = attr;
+    realAttr = arangodb::velocypack::StringRef(attr);
     part = Part::ALL;
   }
 }
 
+/// @brief hashes a string exactly like normalizedHash() hashes a VelocyPack
+/// string with the same contents, without building one on the heap
+uint64_t hashStringValue(char const* data, size_t length, uint64_t seed) {
+  if (length <= 126) {
+    // short string: a single header byte encodes the length
+    uint8_t buffer[127];
+    buffer[0] = static_cast<uint8_t>(0x40 + length);
+    memcpy(buffer + 1, data, length);
+    return VPackSlice(buffer).hash(seed);
+  }
+  VPackBuilder temporaryBuilder;
+  temporaryBuilder.add(VPackValuePair(data, length, VPackValueType::String));
+  return temporaryBuilder.slice().hash(seed);
+}
+
+/// @brief fast path for collections sharded by _key only, producing the
+/// same hash as hashByAttributesImpl<false>. returns false for values that
+/// need the generic code path
+bool hashByKeyOnly(VPackSlice slice, std::string const& key, uint64_t& hash) {
+  uint64_t const seed = TRI_FnvHashBlockInitial();
+  slice = slice.resolveExternal();
+
+  if (slice.isObject()) {
+    VPackSlice sub = slice.get(StaticStrings::KeyString).resolveExternal();
+    if (sub.isString()) {
+      // normalizedHash() of a string is its regular hash
+      hash = sub.hash(seed);
+      return true;
+    }
+    if (sub.isNone() && !key.empty()) {
+      hash = ::hashStringValue(key.data(), key.size(), seed);
+      return true;
+    }
+    return false;
+  }
+
+  if (slice.isString() && key.empty()) {
+    VPackValueLength length;
+    char const* p = slice.getString(length);
+    char const* slash = static_cast<char const*>(memchr(p, '/', length));
+    if (slash == nullptr) {
+      hash = slice.hash(seed);
+    } else {
+      // We have an _id. Hash its key part.
+      ++slash;
+      hash = ::hashStringValue(slash, length - (slash - p), seed);
+    }
+    return true;
+  }
+
+  return false;
+}
+
 template<bool returnNullSlice>
 VPackSlice buildTemporarySlice(VPackSlice const& sub, Part const& part,
                                VPackBuilder& temporaryBuilder,
@@ -129,14 +183,16 @@ uint64_t hashByAttributesImpl(
   error = TRI_ERROR_NO_ERROR;
   slice = slice.resolveExternal();
   if (slice.isObject()) {
-    std::string realAttr;
+    arangodb::velocypack::StringRef realAttr;
     ::Part part;
+    // shared by all attributes, the slices built in it are hashed right away
+    VPackBuilder temporaryBuilder;
     for (auto const& attr : attributes) {
       ::parseAttributeAndPart(attr, realAttr, part);
       VPackSlice sub = slice.get(realAttr).resolveExternal();
-      VPackBuilder temporaryBuilder;
       if (sub.isNone()) {
-        if (realAttr == StaticStrings::KeyString && !key.empty()) {
+        if (realAttr.compare(StaticStrings::KeyString) == 0 && !key.empty()) {
+          temporaryBuilder.clear();
           temporaryBuilder.add(VPackValue(key));
           sub = temporaryBuilder.slice();
         } else {
@@ -151,10 +207,10 @@ uint64_t hashByAttributesImpl(
       hash = sub.normalizedHash(hash);
     }
   } else if (slice.isString() && attributes.size() == 1) {
-    std::string realAttr;
+    arangodb::velocypack::StringRef realAttr;
     ::Part part;
     ::parseAttributeAndPart(attributes[0], realAttr, part);
-    if (realAttr == StaticStrings::KeyString && key.empty()) {
+    if (realAttr.compare(StaticStrings::KeyString) == 0 && key.empty()) {
       // We always need the _key part. Everything else should be ignored
       // beforehand.
       VPackBuilder temporaryBuilder;
@@ -285,6 +341,13 @@ uint64_t ShardingStrategyHashBase::hashByAttributes(
     VPackSlice slice, std::vector<std::string> const& attributes,
     bool docComplete, int& error, std::string const& key) {
 
+  if (attributes.size() == 1 && attributes[0] == StaticStrings::KeyString) {
+    uint64_t hash;
+    if (::hashByKeyOnly(slice, key, hash)) {
+      error = TRI_ERROR_NO_ERROR;
+      return hash;
+    }
+  }
   return ::hashByAttributesImpl<false>(slice, attributes, docComplete, error, key);
 }
 
@@ -374,6 +374,10 @@ void stats::Descriptions::serverStatistics(velocypack::Builder& b) const {
   SchedulerFeature::SCHEDULER->addQueueStatistics(b);
 
   b.close();
+
+  b.add("lanes", VPackValue(VPackValueType::Object, true));
+  SchedulerFeature::SCHEDULER->addLaneStatistics(b);
+  b.close();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
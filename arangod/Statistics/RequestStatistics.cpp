@@ -27,6 +27,14 @@
 
 #include <iomanip>
 
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+extern "C" int mallctl(char const*, void*, size_t*, void*, size_t);
+#endif
+
 using namespace arangodb;
 using namespace arangodb::basics;
 
@@ -209,6 +217,30 @@ void RequestStatistics::fill(StatisticsDistribution& totalTime,
   bytesReceived = TRI_BytesReceivedDistributionStatistics;
 }
 
+double RequestStatistics::threadCpuTime() {
+#if defined(_WIN32) || !defined(CLOCK_THREAD_CPUTIME_ID)
+  return 0.0;
+#else
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return 0.0;
+  }
+  return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+#endif
+}
+
+uint64_t RequestStatistics::threadAllocatedBytes() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  // jemalloc keeps a monotonic per-thread counter of allocated bytes
+  uint64_t allocated = 0;
+  size_t length = sizeof(allocated);
+  if (mallctl("thread.allocated", &allocated, &length, nullptr, 0) == 0) {
+    return allocated;
+  }
+#endif
+  return 0;
+}
+
 std::string RequestStatistics::timingsCsv() {
   std::stringstream ss;
 
@@ -218,7 +250,9 @@ std::string RequestStatistics::timingsCsv() {
      << ",queue-size," << _queueSize
      << ",request," << (_requestEnd - _requestStart)
      << ",total," << (StatisticsFeature::time() - _readStart)
-     << ",error," << (_executeError ? "true" : "false");
+     << ",error," << (_executeError ? "true" : "false")
+     << ",cpu," << _cpuTime
+     << ",allocated," << _allocatedBytes;
 
   return ss.str();
 }
@@ -238,6 +272,8 @@ std::string RequestStatistics::to_string() {
      << "_writeEnd       " << _writeEnd << std::endl
      << "_receivedBytes  " << _receivedBytes << std::endl
      << "_sentBytes      " << _sentBytes << std::endl
+     << "_cpuTime        " << _cpuTime << std::endl
+     << "_allocatedBytes " << _allocatedBytes << std::endl
      << "_async          " << _async << std::endl
      << "_tooLarge       " << _tooLarge << std::endl
      << "_executeError   " << _executeError << std::endl
@@ -136,6 +136,14 @@ class RequestStatistics {
     }
   }
 
+  static void ADD_EXECUTION_COSTS(RequestStatistics* stat, double cpuTime,
+                                  uint64_t allocatedBytes) {
+    if (stat != nullptr) {
+      stat->_cpuTime += cpuTime;
+      stat->_allocatedBytes += allocatedBytes;
+    }
+  }
+
   static double ELAPSED_SINCE_READ_START(RequestStatistics* stat) {
     if (stat != nullptr) {
       return StatisticsFeature::time() - stat->_readStart;
@@ -146,6 +154,13 @@ class RequestStatistics {
 
   double requestStart() const { return _requestStart; }
 
+  /// @brief CPU time consumed by the calling thread so far
+  static double threadCpuTime();
+
+  /// @brief bytes allocated by the calling thread so far, always 0 when
+  /// not built with jemalloc
+  static uint64_t threadAllocatedBytes();
+
   static void fill(basics::StatisticsDistribution& totalTime,
                    basics::StatisticsDistribution& requestTime,
                    basics::StatisticsDistribution& queueTime,
@@ -186,6 +201,8 @@ class RequestStatistics {
     _writeEnd = 0.0;
     _receivedBytes = 0.0;
     _sentBytes = 0.0;
+    _cpuTime = 0.0;
+    _allocatedBytes = 0;
     _requestType = rest::RequestType::ILLEGAL;
     _async = false;
     _tooLarge = false;
@@ -209,6 +226,9 @@ class RequestStatistics {
   double _receivedBytes;
   double _sentBytes;
 
+  double _cpuTime;          // thread CPU time spent executing the handler
+  uint64_t _allocatedBytes; // bytes allocated while executing the handler
+
   rest::RequestType _requestType;
 
   bool _async;
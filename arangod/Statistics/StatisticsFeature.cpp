@@ -125,6 +125,8 @@ StatisticsFeature::StatisticsFeature(
 )
     : ApplicationFeature(server, "Statistics"),
       _statistics(true),
+      _statisticsHistory(true),
+      _slowRequestThreshold(0.0),
       _descriptions(new stats::Descriptions()) {
   startsAfter("AQLPhase");
   setOptional(true);
@@ -139,6 +141,17 @@ void StatisticsFeature::collectOptions(
   options->addHiddenOption("--server.statistics",
                            "turn statistics gathering on or off",
                            new BooleanParameter(&_statistics));
+
+  options->addOption("--server.statistics-history",
+                     "periodically store statistics in the _statistics system "
+                     "collections (statistics are still available via "
+                     "/_admin/statistics and /_admin/metrics if turned off)",
+                     new BooleanParameter(&_statisticsHistory));
+
+  options->addOption("--server.slow-request-threshold",
+                     "log requests taking at least this long (in seconds) "
+                     "together with their CPU time and allocations (0 = off)",
+                     new DoubleParameter(&_slowRequestThreshold));
 }
 
 void StatisticsFeature::validateOptions(
@@ -182,13 +195,18 @@ void StatisticsFeature::start() {
   }
 
   _statisticsThread.reset(new StatisticsThread);
-  _statisticsWorker.reset(new StatisticsWorker(*vocbase));
 
   if (!_statisticsThread->start()) {
     LOG_TOPIC(FATAL, arangodb::Logger::STATISTICS) << "could not start statistics thread";
     FATAL_ERROR_EXIT();
   }
 
+  if (!_statisticsHistory) {
+    return;
+  }
+
+  _statisticsWorker.reset(new StatisticsWorker(*vocbase));
+
   if (!_statisticsWorker->start()) {
     LOG_TOPIC(FATAL, arangodb::Logger::STATISTICS) << "could not start statistics worker";
     FATAL_ERROR_EXIT();
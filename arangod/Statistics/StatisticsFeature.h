@@ -72,6 +72,11 @@ class StatisticsFeature final
 
   static double time() { return TRI_microtime(); }
 
+  /// @brief requests taking at least this long are logged (0 = off)
+  static double slowRequestThreshold() {
+    return STATISTICS != nullptr ? STATISTICS->_slowRequestThreshold : 0.0;
+  }
+
  private:
   static StatisticsFeature* STATISTICS;
 
@@ -93,6 +98,8 @@ class StatisticsFeature final
 
  private:
   bool _statistics;
+  bool _statisticsHistory;
+  double _slowRequestThreshold;
 
   std::unique_ptr<stats::Descriptions> _descriptions;
   std::unique_ptr<StatisticsThread> _statisticsThread;
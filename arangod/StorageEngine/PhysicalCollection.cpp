@@ -35,6 +35,7 @@
 #include "Transaction/Methods.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
 #include "VocBase/ticks.h"
 #include "VocBase/vocbase.h"
 
@@ -71,6 +72,14 @@ void PhysicalCollection::flushClusterIndexEstimates() {
   // default-implementation is a no-op. the operation is only useful for cluster collections
 }
 
+/// @brief return iterators over disjoint partitions of the collection
+std::vector<std::unique_ptr<IndexIterator>> PhysicalCollection::getAllIterators(
+    transaction::Methods* trx, size_t /*numPartitions*/) const {
+  std::vector<std::unique_ptr<IndexIterator>> iterators;
+  iterators.emplace_back(getAllIterator(trx));
+  return iterators;
+}
+
 void PhysicalCollection::drop() {
   {
     WRITE_LOCKER(guard, _indexesLock);
@@ -84,6 +93,25 @@ void PhysicalCollection::drop() {
   }
 }
 
+Result PhysicalCollection::readMany(
+    transaction::Methods* trx, std::vector<StringRef> const& keys,
+    std::function<void(size_t, VPackSlice)> const& cb, bool lock) {
+  ManagedDocumentResult result;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i].empty()) {
+      continue;
+    }
+    result.clear();
+    Result res = read(trx, keys[i], result, lock);
+    if (res.ok()) {
+      cb(i, VPackSlice(result.vpack()));
+    } else if (res.errorNumber() != TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
+      return res;
+    }
+  }
+  return Result();
+}
+
 bool PhysicalCollection::isValidEdgeAttribute(VPackSlice const& slice) const {
   if (!slice.isString()) {
     return false;
@@ -274,6 +302,30 @@ Result PhysicalCollection::mergeObjectsForUpdate(
   return Result();
 }
 
+/// @brief inserts the members of an array one by one
+void PhysicalCollection::insertMany(transaction::Methods* trx,
+                                    VPackSlice const documents,
+                                    ManagedDocumentResult& result,
+                                    OperationOptions& options, bool lock,
+                                    InsertManyCallback const& cb) {
+  TRI_ASSERT(documents.isArray());
+
+  for (auto const& value : VPackArrayIterator(documents)) {
+    if (!value.isObject()) {
+      cb(value, Result(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID), 0, 0);
+      continue;
+    }
+
+    TRI_voc_tick_t resultMarkerTick = 0;
+    TRI_voc_rid_t revisionId = 0;
+    result.clear();
+
+    Result res = insert(trx, value, result, options, resultMarkerTick, lock,
+                        revisionId);
+    cb(value, res, resultMarkerTick, revisionId);
+  }
+}
+
 /// @brief new object for insert, computes the hash of the key
 Result PhysicalCollection::newObjectForInsert(
     transaction::Methods* trx, VPackSlice const& value,
@@ -312,25 +364,7 @@ Result PhysicalCollection::newObjectForInsert(
   }
 
   // _id
-  uint8_t* p = builder.add(StaticStrings::IdString,
-                           VPackValuePair(9ULL, VPackValueType::Custom));
-
-  *p++ = 0xf3;  // custom type for _id
-
-  if (_isDBServer && !_logicalCollection.system()) {
-    // db server in cluster, note: the local collections _statistics,
-    // _statisticsRaw and _statistics15 (which are the only system
-    // collections)
-    // must not be treated as shards but as local collections
-    encoding::storeNumber<uint64_t>(
-      p, _logicalCollection.planId(), sizeof(uint64_t)
-    );
-  } else {
-    // local server
-    encoding::storeNumber<uint64_t>(
-      p, _logicalCollection.id(), sizeof(uint64_t)
-    );
-  }
+  addIdAttribute(builder);
 
   // _from and _to
   if (isEdgeCollection) {
@@ -401,6 +435,29 @@ void PhysicalCollection::newObjectForRemove(transaction::Methods* trx,
   builder.close();
 }
 
+/// @brief adds the _id attribute of a document of this collection
+void PhysicalCollection::addIdAttribute(VPackBuilder& builder) const {
+  uint8_t* p = builder.add(StaticStrings::IdString,
+                           VPackValuePair(9ULL, VPackValueType::Custom));
+
+  *p++ = 0xf3;  // custom type for _id
+
+  if (_isDBServer && !_logicalCollection.system()) {
+    // db server in cluster, note: the local collections _statistics,
+    // _statisticsRaw and _statistics15 (which are the only system
+    // collections)
+    // must not be treated as shards but as local collections
+    encoding::storeNumber<uint64_t>(
+      p, _logicalCollection.planId(), sizeof(uint64_t)
+    );
+  } else {
+    // local server
+    encoding::storeNumber<uint64_t>(
+      p, _logicalCollection.id(), sizeof(uint64_t)
+    );
+  }
+}
+
 /// @brief new object for replace, oldValue must have _key and _id correctly
 /// set
 Result PhysicalCollection::newObjectForReplace(
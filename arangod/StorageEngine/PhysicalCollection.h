@@ -129,6 +129,14 @@ class PhysicalCollection {
   virtual std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx) const = 0;
   virtual std::unique_ptr<IndexIterator> getAnyIterator(
       transaction::Methods* trx) const = 0;
+
+  /// @brief return up to numPartitions iterators that together cover all
+  /// documents of the collection exactly once, as seen by the transaction.
+  /// the iterators are independent of each other, so that they can be used
+  /// by different threads. the default implementation returns a single
+  /// iterator over the whole collection
+  virtual std::vector<std::unique_ptr<IndexIterator>> getAllIterators(
+      transaction::Methods* trx, size_t numPartitions) const;
   virtual void invokeOnAllElements(
       transaction::Methods* trx,
       std::function<bool(LocalDocumentId const&)> callback) = 0;
@@ -159,6 +167,16 @@ class PhysicalCollection {
                       arangodb::velocypack::Slice const& key,
                       ManagedDocumentResult& result, bool) = 0;
 
+  /// @brief reads the documents with the given keys and calls the
+  /// callback with the position of the key and the document for each
+  /// document found, in the order of the keys. the document is only valid
+  /// during the callback. the default implementation reads the documents
+  /// one by one
+  virtual Result readMany(
+      transaction::Methods*, std::vector<arangodb::StringRef> const& keys,
+      std::function<void(size_t, arangodb::velocypack::Slice)> const& cb,
+      bool lock);
+
   virtual bool readDocument(transaction::Methods* trx,
                             LocalDocumentId const& token,
                             ManagedDocumentResult& result) const = 0;
@@ -183,6 +201,22 @@ class PhysicalCollection {
     return insert(trx, newSlice, result, options, resultMarkerTick, lock, unused);
   }
 
+  /// @brief callback for insertMany, called once per array member with
+  /// the member, the result of its insertion, its marker tick and revision
+  typedef std::function<void(velocypack::Slice, Result const&, TRI_voc_tick_t,
+                             TRI_voc_rid_t)> InsertManyCallback;
+
+  /// @brief inserts all members of the array <documents>, reporting each
+  /// of them to <cb> in order. <result> holds the inserted document while
+  /// the callback runs. the default implementation inserts the documents
+  /// one by one; engines can override it to share per-operation work such
+  /// as collection locking among the whole batch
+  virtual void insertMany(arangodb::transaction::Methods* trx,
+                          arangodb::velocypack::Slice const documents,
+                          arangodb::ManagedDocumentResult& result,
+                          OperationOptions& options, bool lock,
+                          InsertManyCallback const& cb);
+
   virtual Result update(arangodb::transaction::Methods* trx,
                         arangodb::velocypack::Slice const newSlice,
                         ManagedDocumentResult& result,
@@ -233,6 +267,9 @@ class PhysicalCollection {
                             bool isRestore,
                             TRI_voc_rid_t& revisionId) const;
 
+  /// @brief adds the _id attribute of a document of this collection
+  void addIdAttribute(velocypack::Builder& builder) const;
+
   /// @brief new object for remove, must have _key set
   void newObjectForRemove(transaction::Methods* trx,
                           velocypack::Slice const& oldValue,
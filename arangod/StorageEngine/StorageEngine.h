@@ -186,6 +186,10 @@ class StorageEngine : public application_features::ApplicationFeature {
 
   //// operations on databasea
 
+  /// @brief whether or not openDatabase() may be called concurrently for
+  /// different databases during startup
+  virtual bool supportsParallelDatabaseOpening() const { return false; }
+
   /// @brief opens a database
   virtual std::unique_ptr<TRI_vocbase_t> openDatabase(
     arangodb::velocypack::Slice const& args,
@@ -463,6 +467,10 @@ class StorageEngine : public application_features::ApplicationFeature {
     builder.close();
   }
 
+  /// @brief adds the memory held by the engine in bytes, by purpose, to
+  /// an open object
+  virtual void getMemoryUsage(VPackBuilder& builder) const {}
+
   // management methods for synchronizing with external persistent stores
   virtual TRI_voc_tick_t currentTick() const = 0;
   virtual TRI_voc_tick_t releasedTick() const = 0;
@@ -35,6 +35,12 @@
 
 using namespace arangodb;
 
+namespace {
+/// @brief maximum number of modified keys tracked per collection for
+/// selective query cache invalidation
+constexpr size_t maxModifiedKeys = 1000;
+}
+
 /// @brief transaction type
 TransactionState::TransactionState(
     TRI_vocbase_t& vocbase,
@@ -390,9 +396,19 @@ void TransactionState::clearQueryCache() {
     std::vector<std::string> collections;
 
     for (auto& trxCollection : _collections) {
-      if (trxCollection->hasOperations()) {
+      if (!trxCollection->hasOperations()) {
         // we're only interested in collections that may have been modified
+        continue;
+      }
+
+      auto it = _modifiedKeys.find(trxCollection->id());
+      if (it == _modifiedKeys.end() || (*it).second.all) {
+        // we don't know which documents were modified
         collections.emplace_back(trxCollection->collectionName());
+      } else {
+        // only invalidate the queries that depend on the modified keys
+        arangodb::aql::QueryCache::instance()->invalidate(
+            &_vocbase, trxCollection->collectionName(), (*it).second.keys);
       }
     }
 
@@ -406,6 +422,32 @@ void TransactionState::clearQueryCache() {
   }
 }
 
+/// @brief remember that the document with the given key was modified in
+/// the collection
+void TransactionState::trackModifiedKey(TRI_voc_cid_t cid, StringRef const& key) {
+  auto& modified = _modifiedKeys[cid];
+  if (modified.all) {
+    return;
+  }
+  if (key.empty() || modified.keys.size() >= ::maxModifiedKeys ||
+      !arangodb::aql::QueryCache::instance()->mayBeActive()) {
+    // no need to track the keys if the cache is turned off, and too many
+    // keys are not worth tracking. invalidate everything for the collection
+    modified.all = true;
+    modified.keys.clear();
+    return;
+  }
+  modified.keys.emplace(key.toString());
+}
+
+/// @brief remember that an unknown set of documents was modified in the
+/// collection
+void TransactionState::trackModifiedAll(TRI_voc_cid_t cid) {
+  auto& modified = _modifiedKeys[cid];
+  modified.all = true;
+  modified.keys.clear();
+}
+
 /// @brief update the status of a transaction
 void TransactionState::updateStatus(transaction::Status status) {
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
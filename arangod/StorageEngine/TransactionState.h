@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Basics/Result.h"
 #include "Basics/SmallVector.h"
+#include "Basics/StringRef.h"
 #include "Cluster/ServerState.h"
 #include "Transaction/Hints.h"
 #include "Transaction/Options.h"
@@ -165,6 +166,12 @@ class TransactionState {
     return hasHint(transaction::Hints::Hint::SINGLE_OPERATION);
   }
 
+  /// @brief whether or not a transaction consists of a single point lookup
+  bool isSingleRead() const {
+    return isSingleOperation() && isReadOnlyTransaction() &&
+           hasHint(transaction::Hints::Hint::SINGLE_READ);
+  }
+
   /// @brief update the status of a transaction
   void updateStatus(transaction::Status status);
 
@@ -218,6 +225,15 @@ class TransactionState {
   /// @brief whether or not a transaction is an exclusive transaction on a single collection
   bool isExclusiveTransactionOnSingleCollection() const;
 
+  /// @brief remember that the document with the given key was modified in
+  /// the collection, so only query cache entries that depend on this key
+  /// need to be invalidated on commit
+  void trackModifiedKey(TRI_voc_cid_t cid, StringRef const& key);
+
+  /// @brief remember that an unknown set of documents was modified in the
+  /// collection, so all query cache entries for it need to be invalidated
+  void trackModifiedAll(TRI_voc_cid_t cid);
+
  protected:
   /// @brief find a collection in the transaction's list of collections
   TransactionCollection* findCollection(TRI_voc_cid_t cid,
@@ -263,6 +279,14 @@ class TransactionState {
 
   /// the list of locked shards (cluster only)
   std::unordered_set<std::string> _lockedShards;
+
+  /// @brief keys of the documents modified per collection, used for
+  /// selective query cache invalidation
+  struct ModifiedKeys {
+    bool all = false;
+    std::unordered_set<std::string> keys;
+  };
+  std::unordered_map<TRI_voc_cid_t, ModifiedKeys> _modifiedKeys;
 };
 
 }
@@ -22,12 +22,55 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "WalAccess.h"
+#include "Basics/system-functions.h"
 #include "Replication/common-defines.h"
 #include "RestServer/DatabaseFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "VocBase/LogicalCollection.h"
 
+#include <chrono>
+#include <thread>
+
 using namespace arangodb;
 
+bool WalAccess::waitForWrites(TRI_voc_tick_t tick, double timeout) const {
+  double const end = TRI_microtime() + timeout;
+  while (lastTick() <= tick) {
+    double remaining = end - TRI_microtime();
+    if (remaining <= 0.0) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(
+        static_cast<uint64_t>(std::min(remaining, 0.1) * 1000000.0)));
+  }
+  return true;
+}
+
+void WalAccess::waitForWritesAsync(
+    TRI_voc_tick_t tick, double timeout,
+    std::function<void()> const& callback) const {
+  if (lastTick() > tick ||
+      !startWaitTimer(std::min(timeout, 0.1), callback)) {
+    callback();
+  }
+}
+
+bool WalAccess::startWaitTimer(double timeout,
+                               std::function<void()> const& callback) {
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr) {
+    return false;
+  }
+  std::shared_ptr<asio_ns::steady_timer> timer(scheduler->newSteadyTimer());
+  timer->expires_from_now(std::chrono::microseconds(
+      static_cast<int64_t>(timeout * 1000.0 * 1000.0)));
+  // the callback is also invoked if the scheduler is stopping
+  timer->async_wait(
+      [timer, callback](asio_ns::error_code const&) { callback(); });
+  return true;
+}
+
 /// @brief check if db should be handled, might already be deleted
 bool WalAccessContext::shouldHandleDB(TRI_voc_tick_t dbid) const {
   return _filter.vocbase == 0 || _filter.vocbase == dbid;
@@ -41,7 +84,7 @@ bool WalAccessContext::shouldHandleView(TRI_voc_tick_t dbid,
   }
   
   if (_filter.vocbase == 0 || (_filter.vocbase == dbid &&
-                               (_filter.collection == 0 || _filter.collection == vid))) {
+                               _filter.includesCollection(vid))) {
     return true;
   }
   return false;
@@ -54,7 +97,7 @@ bool WalAccessContext::shouldHandleCollection(TRI_voc_tick_t dbid,
     return false;
   }
   if (_filter.vocbase == 0 || (_filter.vocbase == dbid &&
-                               (_filter.collection == 0 || _filter.collection == cid))) {
+                               _filter.includesCollection(cid))) {
     LogicalCollection* collection = loadCollection(dbid, cid);
     if (collection == nullptr) {
       return false;
@@ -96,14 +96,18 @@ class WalAccess {
     /// last tick to include
     uint64_t tickEnd = UINT64_MAX;
 
-    /// In case collection is == 0,
+    /// In case collections is empty,
     bool includeSystem = false;
 
     /// only output markers from this database
     TRI_voc_tick_t vocbase = 0;
-    /// Only output data from this collection
-    /// FIXME: make a set of collections
-    TRI_voc_cid_t collection = 0;
+    /// Only output data from these collections, all if empty
+    std::unordered_set<TRI_voc_cid_t> collections;
+
+    /// @brief whether the filter includes the collection or view
+    bool includesCollection(TRI_voc_cid_t cid) const {
+      return collections.empty() || collections.find(cid) != collections.end();
+    }
 
     /// only include these transactions, up to
     /// (not including) firstRegularTick
@@ -138,6 +142,23 @@ class WalAccess {
   virtual WalAccessResult tail(Filter const& filter,
                                size_t chunkSize, TRI_voc_tid_t barrierId,
                                MarkerCallback const&) const = 0;
+
+  /// @brief wait until the WAL contains writes after tick, at most timeout
+  /// seconds. returns whether there are newer writes. the default
+  /// implementation polls lastTick()
+  virtual bool waitForWrites(TRI_voc_tick_t tick, double timeout) const;
+
+  /// @brief invokes the callback once the WAL may contain writes after
+  /// tick, at the latest after timeout seconds, without blocking the caller.
+  /// the callback must not do any work itself, and the caller has to look
+  /// at the WAL again. the default implementation only waits a short time
+  virtual void waitForWritesAsync(TRI_voc_tick_t tick, double timeout,
+                                  std::function<void()> const&) const;
+
+ protected:
+  /// @brief invokes the callback after timeout seconds, returns false if
+  /// the timer cannot be started
+  static bool startWaitTimer(double timeout, std::function<void()> const&);
 };
 
 /// @brief helper class used to resolve vocbases
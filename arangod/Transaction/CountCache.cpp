@@ -37,7 +37,7 @@ int64_t CountCache::get() const {
 int64_t CountCache::get(double ttl) const {
   // (1) - this acquire-load synchronizes with the release-store (2)
   double ts = timestamp.load(std::memory_order_acquire);
-  if (ts + Ttl > TRI_microtime()) {
+  if (ts + ttl > TRI_microtime()) {
     // not yet expired
     return get();
   }
@@ -50,3 +50,7 @@ void CountCache::store(int64_t value) {
   // (2) - this release-store synchronizes with the acquire-load (1)
   timestamp.store(TRI_microtime(), std::memory_order_release);
 }
+
+void CountCache::invalidate() {
+  timestamp.store(0.0, std::memory_order_release);
+}
@@ -48,9 +48,12 @@ enum class CountType {
 /// the cache is initially populated with a count value of -1
 /// this indicates that no count value has been queried/stored yet
 /// the cache values have a 15 second ttl by default. this is currently hard-coded
+/// coordinators also answer regular count requests from the cache, but only
+/// for a short time and only until the next write through the coordinator
 struct CountCache {
   static constexpr int64_t NotPopulated = -1;
   static constexpr double Ttl = 15.0; // seconds
+  static constexpr double CoordinatorTtl = 1.0; // seconds
 
   CountCache();
 
@@ -64,6 +67,10 @@ struct CountCache {
   /// @brief stores value in the cache and sets the ttl to 15 seconds
   /// in the future
   void store(int64_t value); 
+
+  /// @brief expires the cached value, so the next non-forced lookup
+  /// will query the collection again
+  void invalidate();
   
   std::atomic<int64_t> count;
   std::atomic<double> timestamp;
@@ -49,7 +49,10 @@ class Hints {
     NO_DLD = 1024, // disable deadlock detection
     NO_INDEXING = 2048, // use DisableIndexing for RocksDB
     INTERMEDIATE_COMMITS = 4096, // enable intermediate commits in rdb
-    ALLOW_RANGE_DELETE = 8192 // enable range-delete in rdb
+    ALLOW_RANGE_DELETE = 8192, // enable range-delete in rdb
+    BULK_LOAD = 16384, // ingest writes as SST files in rdb
+    LOW_PRIORITY = 32768, // writes are throttled first in rdb
+    SINGLE_READ = 65536 // single point lookup, needs no read snapshot in rdb
   };
 
   Hints() : _value(0) {}
@@ -39,7 +39,9 @@
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/FollowerInfo.h"
 #include "Cluster/ReplicationTimeoutFeature.h"
+#include "Cluster/RequestCoalescer.h"
 #include "Cluster/ServerState.h"
+#include "Futures/Utilities.h"
 #include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "RocksDBEngine/RocksDBEngine.h"
@@ -955,6 +957,8 @@ Result transaction::Methods::commit() {
 
   if (_state->isCoordinator()) {
     if (_state->isTopLevelTransaction()) {
+      // writes of AQL queries go to the DB servers directly
+      invalidateCountCaches();
       _state->updateStatus(transaction::Status::COMMITTED);
     }
   } else {
@@ -979,6 +983,7 @@ Result transaction::Methods::abort() {
 
   if (_state->isCoordinator()) {
     if (_state->isTopLevelTransaction()) {
+      invalidateCountCaches();
       _state->updateStatus(transaction::Status::ABORTED);
     }
   } else {
@@ -1466,6 +1471,45 @@ OperationResult transaction::Methods::documentCoordinator(
 }
 #endif
 
+/// @brief return a single document from a collection, without blocking
+/// a thread on a coordinator
+futures::Future<OperationResult> transaction::Methods::documentAsync(
+    std::string const& collectionName, VPackSlice const value,
+    OperationOptions& options) {
+  TRI_ASSERT(_state->status() == transaction::Status::RUNNING);
+
+  if (_state->isCoordinator() && value.isObject()) {
+    return documentCoordinatorAsync(collectionName, value, options);
+  }
+
+  return futures::makeFuture(document(collectionName, value, options));
+}
+
+/// @brief read a single document in a collection, coordinator
+#ifndef USE_ENTERPRISE
+futures::Future<OperationResult> transaction::Methods::documentCoordinatorAsync(
+    std::string const& collectionName, VPackSlice const value,
+    OperationOptions& options) {
+  TRI_ASSERT(value.isObject());
+  StringRef key(transaction::helpers::extractKeyPart(value));
+
+  if (key.empty()) {
+    return futures::makeFuture(
+        OperationResult(TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD));
+  }
+
+  return arangodb::getDocumentOnCoordinatorAsync(
+             vocbase().name(), collectionName, *this, value, options)
+      .thenValue([this](ClusterOperationResult&& result) {
+        if (result.errorCode != TRI_ERROR_NO_ERROR) {
+          return OperationResult(result.errorCode);
+        }
+        return clusterResultDocument(result.responseCode, result.resultBody,
+                                     result.errorCounter);
+      });
+}
+#endif
+
 /// @brief read one or multiple documents in a collection, local
 OperationResult transaction::Methods::documentLocal(
     std::string const& collectionName, VPackSlice const value,
@@ -1480,8 +1524,10 @@ OperationResult transaction::Methods::documentLocal(
   VPackBuilder resultBuilder;
   ManagedDocumentResult result;
 
-  auto workForOneDocument = [&](VPackSlice const value,
-                                bool isMultiple) -> Result {
+  // batchedDoc is the document if it was already read by readMany, or
+  // a none slice if readMany did not find it
+  auto workForOneDocument = [&](VPackSlice const value, bool isMultiple,
+                                VPackSlice const* batchedDoc) -> Result {
     StringRef key(transaction::helpers::extractKeyPart(value));
     if (key.empty()) {
       return TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD;
@@ -1492,21 +1538,29 @@ OperationResult transaction::Methods::documentLocal(
       expectedRevision = TRI_ExtractRevisionId(value);
     }
 
-    result.clear();
+    VPackSlice doc;
+    if (batchedDoc != nullptr) {
+      if (batchedDoc->isNone()) {
+        return TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND;
+      }
+      doc = *batchedDoc;
+    } else {
+      result.clear();
 
-    Result res = collection->read(
-      this, key, result, !isLocked(collection, AccessMode::Type::READ));
+      Result res = collection->read(
+        this, key, result, !isLocked(collection, AccessMode::Type::READ));
 
-    if (res.fail()) {
-      return res;
+      if (res.fail()) {
+        return res;
+      }
+      doc = VPackSlice(result.vpack());
     }
 
     TRI_ASSERT(isPinned(cid));
 
     if (expectedRevision != 0) {
       TRI_voc_rid_t foundRevision =
-          transaction::helpers::extractRevFromDocument(
-              VPackSlice(result.vpack()));
+          transaction::helpers::extractRevFromDocument(doc);
       if (expectedRevision != foundRevision) {
         if (!isMultiple) {
           // still return
@@ -1518,7 +1572,11 @@ OperationResult transaction::Methods::documentLocal(
     }
 
     if (!options.silent) {
-      result.addToBuilder(resultBuilder, true);
+      if (batchedDoc == nullptr) {
+        result.addToBuilder(resultBuilder, true);
+      } else {
+        resultBuilder.add(doc);
+      }
     } else if (isMultiple) {
       resultBuilder.add(VPackSlice::nullSlice());
     }
@@ -1529,16 +1587,49 @@ OperationResult transaction::Methods::documentLocal(
   Result res(TRI_ERROR_NO_ERROR);
   std::unordered_map<int, size_t> countErrorCodes;
   if (!value.isArray()) {
-    res = workForOneDocument(value, false);
+    res = workForOneDocument(value, false, nullptr);
   } else {
     VPackArrayBuilder guard(&resultBuilder);
-    for (VPackSlice s : VPackArrayIterator(value)) {
-      res = workForOneDocument(s, true);
-      if (res.fail()) {
-        createBabiesError(resultBuilder, countErrorCodes, res, options.silent);
+    VPackArrayIterator it(value);
+    auto workForNextDocument = [&](VPackSlice const* batchedDoc) {
+      Result r = workForOneDocument(it.value(), true, batchedDoc);
+      if (r.fail()) {
+        createBabiesError(resultBuilder, countErrorCodes, r, options.silent);
+      }
+      it.next();
+    };
+
+    if (value.length() <= 1) {
+      while (it.valid()) {
+        workForNextDocument(nullptr);
+      }
+    } else {
+      // read all documents at once, so that the storage engine can look
+      // them up in batches and in key order. readMany reports them in the
+      // order of the keys, so they are added to the result right from the
+      // buffers of the storage engine
+      std::vector<StringRef> keys;
+      keys.reserve(value.length());
+      for (VPackSlice s : VPackArrayIterator(value)) {
+        keys.emplace_back(transaction::helpers::extractKeyPart(s));
+      }
+      VPackSlice const notFound;
+      Result r = collection->readMany(
+          this, keys,
+          [&](size_t position, VPackSlice doc) {
+            while (it.index() < position) {
+              workForNextDocument(&notFound);
+            }
+            workForNextDocument(&doc);
+          },
+          !isLocked(collection, AccessMode::Type::READ));
+      if (r.fail()) {
+        THROW_ARANGO_EXCEPTION(r);
+      }
+      while (it.valid()) {
+        workForNextDocument(&notFound);
       }
     }
-    res = TRI_ERROR_NO_ERROR;
   }
 
   return OperationResult(std::move(res), resultBuilder.steal(),
@@ -1566,7 +1657,9 @@ OperationResult transaction::Methods::insert(std::string const& collectionName,
   OperationOptions optionsCopy = options;
 
   if (_state->isCoordinator()) {
-    return insertCoordinator(collectionName, value, optionsCopy);
+    OperationResult result = insertCoordinator(collectionName, value, optionsCopy);
+    invalidateCountCache(collectionName);
+    return result;
   }
 
   return insertLocal(collectionName, value, optionsCopy);
@@ -1613,6 +1706,74 @@ static double chooseTimeout(size_t count, size_t totalBytes) {
   return (std::min)(120.0, timeout) * ReplicationTimeoutFeature::timeoutFactor;
 }
 
+/// @brief send replicated operations to all followers of a shard. followers
+/// which fail to apply them are dropped
+static Result replicateToFollowers(
+    LogicalCollection* collection,
+    std::shared_ptr<std::vector<std::string> const> const& followers,
+    arangodb::rest::RequestType requestType, std::string const& path,
+    std::shared_ptr<std::string const> const& body, size_t count) {
+  auto cc = arangodb::ClusterComm::instance();
+
+  if (cc == nullptr) {
+    // nullptr happens only on controlled shutdown
+    return Result();
+  }
+
+  // Now prepare the requests:
+  std::vector<ClusterCommRequest> requests;
+  requests.reserve(followers->size());
+      
+  for (auto const& f : *followers) {
+    requests.emplace_back("server:" + f, requestType, path, body);
+  }
+      
+  double const timeout = chooseTimeout(count, body->size() * followers->size());
+
+  size_t nrDone = 0;
+  cc->performRequests(requests, timeout, nrDone, Logger::REPLICATION, false);
+
+  // If any would-be-follower refused to follow there must be a
+  // new leader in the meantime, in this case we must not allow
+  // this operation to succeed, we simply return with a refusal
+  // error (note that we use the follower version, since we have
+  // lost leadership):
+  if (findRefusal(requests)) {
+    return Result(TRI_ERROR_CLUSTER_SHARD_LEADER_RESIGNED);
+  }
+          
+  // Otherwise we drop all followers that were not successful:
+  for (size_t i = 0; i < followers->size(); ++i) {
+    bool replicationWorked =
+      requests[i].done &&
+      requests[i].result.status == CL_COMM_RECEIVED &&
+      (requests[i].result.answer_code == rest::ResponseCode::ACCEPTED ||
+       requests[i].result.answer_code == rest::ResponseCode::CREATED ||
+       requests[i].result.answer_code == rest::ResponseCode::OK);
+    if (replicationWorked) {
+      bool found;
+      requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
+      replicationWorked = !found;
+    }
+    if (!replicationWorked) {
+      auto const& followerInfo = collection->followers();
+      if (followerInfo->remove((*followers)[i])) {
+        LOG_TOPIC(WARN, Logger::REPLICATION)
+          << "synchronous replication: dropping follower " << (*followers)[i]
+          << " for shard " << collection->name();
+      } else {
+        LOG_TOPIC(ERR, Logger::REPLICATION)
+          << "synchronous replication: could not drop follower "
+          << (*followers)[i] << " for shard " << collection->name();
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_COULD_NOT_DROP_FOLLOWER);
+      }
+    }
+  }
+
+  // we return "ok" here still.
+  return Result();
+}
+
 /// @brief create one or multiple documents in a collection, local
 /// the single-document variant of this operation will either succeed or,
 /// if it fails, clean up after itself
@@ -1658,20 +1819,13 @@ OperationResult transaction::Methods::insertLocal(
   ManagedDocumentResult documentResult;
   TRI_voc_tick_t maxTick = 0;
 
-  auto workForOneDocument = [&](VPackSlice const value) -> Result {
-    if (!value.isObject()) {
-      return Result(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
-    }
-
-    TRI_voc_tick_t resultMarkerTick = 0;
-    TRI_voc_rid_t revisionId = 0;
-    documentResult.clear();
-
-    auto const needsLock = !isLocked(collection, AccessMode::Type::WRITE);
-
-    Result res = collection->insert(this, value, documentResult, options,
-                                    resultMarkerTick, needsLock, revisionId);
+  // the lock state of the collection does not change during the operation
+  auto const needsLock = !isLocked(collection, AccessMode::Type::WRITE);
 
+  // post-processing for one document after the low-level insert
+  auto finishOneDocument = [&](VPackSlice const value, Result res,
+                               TRI_voc_tick_t resultMarkerTick,
+                               TRI_voc_rid_t revisionId) -> Result {
     TRI_voc_rid_t previousRevisionId = 0;
     ManagedDocumentResult previousDocumentResult; // return OLD
 
@@ -1699,10 +1853,23 @@ OperationResult transaction::Methods::insertLocal(
       return res;
     }
 
+    VPackSlice keySlice;
+    if (options.silent) {
+      // the key may have been generated, in which case we don't know it
+      keySlice = value.get(StaticStrings::KeyString);
+    } else {
+      keySlice = transaction::helpers::extractKeyFromDocument(VPackSlice(documentResult.vpack()));
+    }
+    if (keySlice.isString()) {
+      _state->trackModifiedKey(cid, StringRef(keySlice));
+    } else {
+      _state->trackModifiedAll(cid);
+    }
+
     if (!options.silent) {
       TRI_ASSERT(!documentResult.empty());
 
-      StringRef keyString(transaction::helpers::extractKeyFromDocument(VPackSlice(documentResult.vpack())));
+      StringRef keyString(keySlice);
 
       bool showReplaced = false;
       if (options.returnOld && previousRevisionId) {
@@ -1718,15 +1885,44 @@ OperationResult transaction::Methods::insertLocal(
     return Result();
   };
 
+  auto workForOneDocument = [&](VPackSlice const value) -> Result {
+    if (!value.isObject()) {
+      return Result(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
+    }
+
+    TRI_voc_tick_t resultMarkerTick = 0;
+    TRI_voc_rid_t revisionId = 0;
+    documentResult.clear();
+
+    Result res = collection->insert(this, value, documentResult, options,
+                                    resultMarkerTick, needsLock, revisionId);
+    return finishOneDocument(value, std::move(res), resultMarkerTick, revisionId);
+  };
+
   Result res;
   std::unordered_map<int, size_t> countErrorCodes;
   if (value.isArray()) {
     VPackArrayBuilder b(&resultBuilder);
-    for (auto const& s : VPackArrayIterator(value)) {
-      res = workForOneDocument(s);
-      if (res.fail()) {
-        createBabiesError(resultBuilder, countErrorCodes, res, options.silent);
+    if (options.overwrite) {
+      // a failed insert may be turned into a replace, which needs to be
+      // able to acquire locks on its own
+      for (auto const& s : VPackArrayIterator(value)) {
+        res = workForOneDocument(s);
+        if (res.fail()) {
+          createBabiesError(resultBuilder, countErrorCodes, res, options.silent);
+        }
       }
+    } else {
+      // let the storage engine insert the whole batch
+      collection->insertMany(
+          this, value, documentResult, options, needsLock,
+          [&](VPackSlice s, Result const& r, TRI_voc_tick_t resultMarkerTick,
+              TRI_voc_rid_t revisionId) {
+            res = finishOneDocument(s, r, resultMarkerTick, revisionId);
+            if (res.fail()) {
+              createBabiesError(resultBuilder, countErrorCodes, res, options.silent);
+            }
+          });
     }
     // With babies the reporting is handled in the body of the result
     res = Result(TRI_ERROR_NO_ERROR);
@@ -1783,7 +1979,9 @@ OperationResult transaction::Methods::update(std::string const& collectionName,
   OperationOptions optionsCopy = options;
 
   if (_state->isCoordinator()) {
-    return updateCoordinator(collectionName, newValue, optionsCopy);
+    OperationResult result = updateCoordinator(collectionName, newValue, optionsCopy);
+    invalidateCountCache(collectionName);
+    return result;
   }
 
   return modifyLocal(collectionName, newValue, optionsCopy,
@@ -1842,7 +2040,9 @@ OperationResult transaction::Methods::replace(std::string const& collectionName,
   OperationOptions optionsCopy = options;
 
   if (_state->isCoordinator()) {
-    return replaceCoordinator(collectionName, newValue, optionsCopy);
+    OperationResult result = replaceCoordinator(collectionName, newValue, optionsCopy);
+    invalidateCountCache(collectionName);
+    return result;
   }
 
   return modifyLocal(collectionName, newValue, optionsCopy,
@@ -1976,10 +2176,17 @@ OperationResult transaction::Methods::modifyLocal(
       return res;
     }
 
+    VPackSlice keySlice = newVal.get(StaticStrings::KeyString);
+    if (keySlice.isString()) {
+      _state->trackModifiedKey(cid, StringRef(keySlice));
+    } else {
+      _state->trackModifiedAll(cid);
+    }
+
     if (!options.silent) {
       TRI_ASSERT(!previous.empty());
       TRI_ASSERT(!result.empty());
-      StringRef key(newVal.get(StaticStrings::KeyString));
+      StringRef key(keySlice);
       buildDocumentIdentity(collection, resultBuilder, cid, key,
                             TRI_ExtractRevisionId(VPackSlice(result.vpack())),
                             actualRevision,
@@ -2061,7 +2268,9 @@ OperationResult transaction::Methods::remove(std::string const& collectionName,
   OperationOptions optionsCopy = options;
 
   if (_state->isCoordinator()) {
-    return removeCoordinator(collectionName, value, optionsCopy);
+    OperationResult result = removeCoordinator(collectionName, value, optionsCopy);
+    invalidateCountCache(collectionName);
+    return result;
   }
 
   return removeLocal(collectionName, value, optionsCopy);
@@ -2185,6 +2394,8 @@ OperationResult transaction::Methods::removeLocal(
       return res;
     }
 
+    _state->trackModifiedKey(cid, key);
+
     TRI_ASSERT(!previous.empty());
     if (!options.silent) {
       buildDocumentIdentity(collection, resultBuilder, cid, key, actualRevision,
@@ -2314,6 +2525,7 @@ OperationResult transaction::Methods::truncate(
 
   if (_state->isCoordinator()) {
     result = truncateCoordinator(collectionName, optionsCopy);
+    invalidateCountCache(collectionName);
   } else {
     result = truncateLocal(collectionName, optionsCopy);
   }
@@ -2386,6 +2598,8 @@ OperationResult transaction::Methods::truncateLocal(
     return OperationResult(res);
   }
 
+  _state->trackModifiedAll(cid);
+
   // Now see whether or not we have to do synchronous replication:
   if (replicationType == ReplicationType::LEADER) {
     TRI_ASSERT(followers != nullptr);
@@ -2512,6 +2726,12 @@ OperationResult transaction::Methods::countCoordinatorHelper(
     documents = cache.get();
   } else if (type == transaction::CountType::TryCache) {
     documents = cache.get(CountCache::Ttl);
+  } else if (type == transaction::CountType::Normal &&
+             _state->collection(collinfo->id(), AccessMode::Type::WRITE) == nullptr) {
+    // coordinator writes invalidate the cache, so only counts that may
+    // have been changed via other coordinators can be slightly outdated.
+    // transactions writing to the collection always see their own writes
+    documents = cache.get(CountCache::CoordinatorTtl);
   }
 
   if (documents == CountCache::NotPopulated) {
@@ -2541,6 +2761,31 @@ OperationResult transaction::Methods::countCoordinatorHelper(
   return OperationResult(Result(), resultBuilder.buffer(), nullptr);
 }
 
+/// @brief expires the coordinator's cached count of a collection
+void transaction::Methods::invalidateCountCache(std::string const& collectionName) {
+  try {
+    auto collection = resolver()->getCollection(collectionName);
+    if (collection != nullptr) {
+      collection->countCache().invalidate();
+    }
+  } catch (...) {
+    // the write itself has happened already
+  }
+}
+
+/// @brief expires the coordinator's cached counts of all collections the
+/// transaction may have written to
+void transaction::Methods::invalidateCountCaches() {
+  _state->allCollections([](TransactionCollection* trxCollection) {
+    LogicalCollection* collection = trxCollection->collection();
+    if (trxCollection->accessType() != AccessMode::Type::READ &&
+        collection != nullptr) {
+      collection->countCache().invalidate();
+    }
+    return true;
+  });
+}
+
 /// @brief count the number of documents in a collection
 OperationResult transaction::Methods::countLocal(
     std::string const& collectionName, transaction::CountType type) {
@@ -3190,57 +3435,49 @@ Result Methods::replicateOperations(LogicalCollection* collection,
   auto body = std::make_shared<std::string>();
   *body = payload->slice().toJson();
 
-  // Now prepare the requests:
-  std::vector<ClusterCommRequest> requests;
-  requests.reserve(followers->size());
-      
-  for (auto const& f : *followers) {
-    requests.emplace_back("server:" + f, requestType, path, body);
+  RequestCoalescer* coalescer = ClusterFeature::REPLICATION_COALESCER;
+  if (coalescer == nullptr) {
+    return replicateToFollowers(collection, followers, requestType, path,
+                                body, count);
   }
-      
-  double const timeout = chooseTimeout(count, body->size() * followers->size());
-
-  size_t nrDone = 0;
-  cc->performRequests(requests, timeout, nrDone, Logger::REPLICATION, false);
 
-  // If any would-be-follower refused to follow there must be a
-  // new leader in the meantime, in this case we must not allow
-  // this operation to succeed, we simply return with a refusal
-  // error (note that we use the follower version, since we have
-  // lost leadership):
-  if (findRefusal(requests)) {
-    return Result(TRI_ERROR_CLUSTER_SHARD_LEADER_RESIGNED);
-  }
-          
-  // Otherwise we drop all followers that were not successful:
-  for (size_t i = 0; i < followers->size(); ++i) {
-    bool replicationWorked =
-      requests[i].done &&
-      requests[i].result.status == CL_COMM_RECEIVED &&
-      (requests[i].result.answer_code == rest::ResponseCode::ACCEPTED ||
-       requests[i].result.answer_code == rest::ResponseCode::CREATED ||
-       requests[i].result.answer_code == rest::ResponseCode::OK);
-    if (replicationWorked) {
-      bool found;
-      requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
-      replicationWorked = !found;
-    }
-    if (!replicationWorked) {
-      auto const& followerInfo = collection->followers();
-      if (followerInfo->remove((*followers)[i])) {
-        LOG_TOPIC(WARN, Logger::REPLICATION)
-          << "synchronous replication: dropping follower " << (*followers)[i]
-          << " for shard " << collection->name();
+  // operations of concurrent transactions on the shard are sent to the
+  // followers in one request, as long as they go to the same followers
+  std::string key = std::to_string(static_cast<int>(requestType));
+  key.push_back(' ');
+  key.append(path);
+  for (auto const& f : *followers) {
+    key.push_back(' ');
+    key.append(f);
+  }
+
+  RequestCoalescer::Operation op;
+  op._body = std::move(*body);
+  op._count = count;
+  coalescer->execute(key, op, [&](std::vector<RequestCoalescer::Operation*>& ops) {
+    auto joined = std::make_shared<std::string>();
+    size_t total = 0;
+    joined->push_back('[');
+    for (auto const* it : ops) {
+      if (total > 0) {
+        joined->push_back(',');
+      }
+      // payloads of several documents are arrays, which are flattened
+      if (!it->_body.empty() && it->_body[0] == '[') {
+        joined->append(it->_body, 1, it->_body.size() - 2);
       } else {
-        LOG_TOPIC(ERR, Logger::REPLICATION)
-          << "synchronous replication: could not drop follower "
-          << (*followers)[i] << " for shard " << collection->name();
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_COULD_NOT_DROP_FOLLOWER);
+        joined->append(it->_body);
       }
+      total += it->_count;
     }
-  }
+    joined->push_back(']');
 
-  // we return "ok" here still.
-  return Result();
+    Result res = replicateToFollowers(collection, followers, requestType,
+                                      path, joined, total);
+    for (auto* it : ops) {
+      it->_result = res;
+    }
+  });
+  return op._result;
 }
                                
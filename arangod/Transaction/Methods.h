@@ -53,6 +53,11 @@ struct AttributeName;
 class StringBuffer;
 }
 
+namespace futures {
+template <typename T>
+class Future;
+}
+
 namespace velocypack {
 class Builder;
 }
@@ -288,6 +293,14 @@ class Methods {
                            VPackSlice const value,
                            OperationOptions& options);
 
+  /// @brief return a single document from a collection. on a coordinator,
+  /// the future is fulfilled once the DB server has answered, without a
+  /// thread waiting for it. otherwise it is ready right away. the
+  /// transaction must be kept alive until the future is fulfilled
+  futures::Future<OperationResult> documentAsync(std::string const& collectionName,
+                                                 VPackSlice const value,
+                                                 OperationOptions& options);
+
   /// @brief create one or multiple documents in a collection
   /// the single-document variant of this operation will either succeed or,
   /// if it fails, clean up after itself
@@ -455,6 +468,10 @@ class Methods {
                                       VPackSlice const value,
                                       OperationOptions& options);
 
+  futures::Future<OperationResult> documentCoordinatorAsync(
+      std::string const& collectionName, VPackSlice const value,
+      OperationOptions& options);
+
   OperationResult documentLocal(std::string const& collectionName,
                                 VPackSlice const value,
                                 OperationOptions& options);
@@ -522,6 +539,13 @@ class Methods {
 
   OperationResult countLocal(std::string const& collectionName, CountType type);
 
+  /// @brief expires the coordinator's cached count of a collection
+  void invalidateCountCache(std::string const& collectionName);
+
+  /// @brief expires the coordinator's cached counts of all collections
+  /// the transaction may have written to
+  void invalidateCountCaches();
+
   /// @brief return the collection
   arangodb::LogicalCollection* documentCollection(
       TransactionCollection const*) const;
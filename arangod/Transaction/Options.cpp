@@ -38,6 +38,7 @@ Options::Options()
       maxTransactionSize(defaultMaxTransactionSize),
       intermediateCommitSize(defaultIntermediateCommitSize),
       intermediateCommitCount(defaultIntermediateCommitCount),
+      maxSnapshotAge(0.0),
       allowImplicitCollections(true),
       waitForSync(false)
 #ifdef USE_ENTERPRISE
@@ -70,6 +71,10 @@ void Options::fromVelocyPack(arangodb::velocypack::Slice const& slice) {
   if (value.isNumber()) {
     intermediateCommitCount = value.getNumber<uint64_t>();
   }
+  value = slice.get("maxSnapshotAge");
+  if (value.isNumber()) {
+    maxSnapshotAge = value.getNumber<double>();
+  }
   value = slice.get("allowImplicitCollections");
   if (value.isBool()) {
     allowImplicitCollections = value.getBool();
@@ -94,6 +99,7 @@ void Options::toVelocyPack(arangodb::velocypack::Builder& builder) const {
   builder.add("maxTransactionSize", VPackValue(maxTransactionSize));
   builder.add("intermediateCommitSize", VPackValue(intermediateCommitSize));
   builder.add("intermediateCommitCount", VPackValue(intermediateCommitCount));
+  builder.add("maxSnapshotAge", VPackValue(maxSnapshotAge));
   builder.add("allowImplicitCollections", VPackValue(allowImplicitCollections));
   builder.add("waitForSync", VPackValue(waitForSync));
 #ifdef USE_ENTERPRISE
@@ -56,6 +56,9 @@ struct Options {
   uint64_t maxTransactionSize;
   uint64_t intermediateCommitSize;
   uint64_t intermediateCommitCount;
+  /// @brief time (in seconds) after which a read-only transaction may move
+  /// on to a newer snapshot. 0 keeps the initial snapshot for its lifetime
+  double maxSnapshotAge;
   bool allowImplicitCollections; 
   bool waitForSync;
 #ifdef USE_ENTERPRISE
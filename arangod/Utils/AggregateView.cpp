@@ -0,0 +1,504 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AggregateView.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+
+std::string functionName(AggregateView::Function function) {
+  switch (function) {
+    case AggregateView::Function::COUNT:
+      return "COUNT";
+    case AggregateView::Function::SUM:
+      return "SUM";
+    case AggregateView::Function::AVERAGE:
+      return "AVERAGE";
+    case AggregateView::Function::MIN:
+      return "MIN";
+    case AggregateView::Function::MAX:
+      return "MAX";
+  }
+  return "";
+}
+
+bool parseFunction(std::string const& name,
+                   AggregateView::Function& function) {
+  std::string const upper = basics::StringUtils::toupper(name);
+  if (upper == "COUNT" || upper == "LENGTH") {
+    function = AggregateView::Function::COUNT;
+  } else if (upper == "SUM") {
+    function = AggregateView::Function::SUM;
+  } else if (upper == "AVERAGE" || upper == "AVG") {
+    function = AggregateView::Function::AVERAGE;
+  } else if (upper == "MIN") {
+    function = AggregateView::Function::MIN;
+  } else if (upper == "MAX") {
+    function = AggregateView::Function::MAX;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// @brief splits a dotted attribute name. _id is not stored in the
+/// documents, so it cannot be used
+bool parseAttribute(std::string const& attribute,
+                    std::vector<std::string>& path) {
+  path = basics::StringUtils::split(attribute, '.', '\0');
+  if (path.empty() || path[0] == StaticStrings::IdString) {
+    return false;
+  }
+  for (auto const& part : path) {
+    if (part.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+AggregateView::AggregateView(std::string const& database,
+                             std::string const& name,
+                             std::string const& collection)
+    : _database(database),
+      _name(name),
+      _collection(collection),
+      _ready(false),
+      _tick(0),
+      _hasStaleGroups(false) {}
+
+Result AggregateView::create(std::string const& database, VPackSlice definition,
+                             std::shared_ptr<AggregateView>& view) {
+  if (!definition.isObject()) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "expecting object definition");
+  }
+  std::string const name =
+      basics::VelocyPackHelper::getStringValue(definition, "name", "");
+  if (name.empty()) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "expecting non-empty <name>");
+  }
+  std::string const collection =
+      basics::VelocyPackHelper::getStringValue(definition, "collection", "");
+  if (collection.empty()) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "expecting non-empty <collection>");
+  }
+
+  std::shared_ptr<AggregateView> result(
+      new AggregateView(database, name, collection));
+  std::unordered_set<std::string> names;
+
+  VPackSlice groups = definition.get("groups");
+  if (!groups.isNone() && !groups.isArray()) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "expecting array <groups>");
+  }
+  if (groups.isArray()) {
+    for (auto const& it : VPackArrayIterator(groups)) {
+      Attribute group;
+      group.name = basics::VelocyPackHelper::getStringValue(it, "name", "");
+      std::string const attribute =
+          basics::VelocyPackHelper::getStringValue(it, "attribute", "");
+      if (group.name.empty() || !parseAttribute(attribute, group.path)) {
+        return Result(TRI_ERROR_BAD_PARAMETER,
+                      "invalid group, expecting <name> and <attribute>");
+      }
+      if (!names.emplace(group.name).second) {
+        return Result(TRI_ERROR_BAD_PARAMETER,
+                      "duplicate output name '" + group.name + "'");
+      }
+      result->_groups.emplace_back(std::move(group));
+    }
+  }
+
+  VPackSlice aggregates = definition.get("aggregates");
+  if (!aggregates.isNone() && !aggregates.isArray()) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "expecting array <aggregates>");
+  }
+  if (aggregates.isArray()) {
+    for (auto const& it : VPackArrayIterator(aggregates)) {
+      Attribute aggregate;
+      Function function;
+      aggregate.name = basics::VelocyPackHelper::getStringValue(it, "name", "");
+      if (aggregate.name.empty() ||
+          !parseFunction(basics::VelocyPackHelper::getStringValue(
+                             it, "function", ""),
+                         function)) {
+        return Result(TRI_ERROR_BAD_PARAMETER,
+                      "invalid aggregate, expecting <name> and one of the "
+                      "functions COUNT, SUM, AVERAGE, MIN and MAX");
+      }
+      std::string const attribute =
+          basics::VelocyPackHelper::getStringValue(it, "attribute", "");
+      // COUNT counts documents, so it does not need an input value
+      if ((function != Function::COUNT || !attribute.empty()) &&
+          !parseAttribute(attribute, aggregate.path)) {
+        return Result(TRI_ERROR_BAD_PARAMETER,
+                      "invalid <attribute> for aggregate '" + aggregate.name +
+                          "'");
+      }
+      if (!names.emplace(aggregate.name).second) {
+        return Result(TRI_ERROR_BAD_PARAMETER,
+                      "duplicate output name '" + aggregate.name + "'");
+      }
+      result->_aggregates.emplace_back(std::move(aggregate), function);
+    }
+  }
+
+  if (names.empty()) {
+    return Result(TRI_ERROR_BAD_PARAMETER,
+                  "expecting at least one group or aggregate");
+  }
+
+  view = std::move(result);
+  return Result();
+}
+
+void AggregateView::toVelocyPack(VPackBuilder& result) const {
+  auto joinPath = [](std::vector<std::string> const& path) {
+    return basics::StringUtils::join(path, ".");
+  };
+
+  result.openObject();
+  result.add("name", VPackValue(_name));
+  result.add("collection", VPackValue(_collection));
+  result.add("groups", VPackValue(VPackValueType::Array));
+  for (auto const& group : _groups) {
+    result.openObject();
+    result.add("name", VPackValue(group.name));
+    result.add("attribute", VPackValue(joinPath(group.path)));
+    result.close();
+  }
+  result.close();
+  result.add("aggregates", VPackValue(VPackValueType::Array));
+  for (auto const& aggregate : _aggregates) {
+    result.openObject();
+    result.add("name", VPackValue(aggregate.first.name));
+    result.add("function", VPackValue(::functionName(aggregate.second)));
+    if (!aggregate.first.path.empty()) {
+      result.add("attribute", VPackValue(joinPath(aggregate.first.path)));
+    }
+    result.close();
+  }
+  result.close();
+  result.close();
+}
+
+void AggregateView::clear() {
+  MUTEX_LOCKER(guard, _mutex);
+  _ready = false;
+  _tick = 0;
+  _hasStaleGroups = false;
+  _documents.clear();
+  _groupsByKey.clear();
+}
+
+void AggregateView::ready(TRI_voc_tick_t tick) {
+  MUTEX_LOCKER(guard, _mutex);
+  _ready = true;
+  _tick = tick;
+}
+
+bool AggregateView::isReady() const {
+  MUTEX_LOCKER(guard, _mutex);
+  return _ready;
+}
+
+void AggregateView::tick(TRI_voc_tick_t tick) {
+  MUTEX_LOCKER(guard, _mutex);
+  _tick = tick;
+}
+
+VPackSlice AggregateView::lookup(VPackSlice document,
+                                 std::vector<std::string> const& path) {
+  for (auto const& part : path) {
+    if (!document.isObject()) {
+      return VPackSlice::nullSlice();
+    }
+    document = document.get(part);
+  }
+  if (document.isNone() || document.isCustom()) {
+    return VPackSlice::nullSlice();
+  }
+  return document;
+}
+
+bool AggregateView::replacesExtreme(Aggregate const& aggregate,
+                                    VPackSlice value) {
+  // MIN ignores null, whereas MAX sorts null below all other values
+  if (aggregate.function == Function::MIN && value.isNull()) {
+    return false;
+  }
+  if (aggregate.extreme.isEmpty()) {
+    return true;
+  }
+  int cmp = basics::VelocyPackHelper::compare(value, aggregate.extreme.slice(),
+                                              true);
+  return aggregate.function == Function::MIN ? cmp < 0 : cmp > 0;
+}
+
+void AggregateView::insert(VPackSlice document) {
+  VPackSlice key = document.get(StaticStrings::KeyString);
+  if (!key.isString()) {
+    return;
+  }
+
+  VPackBuilder groupKey;
+  groupKey.openArray();
+  for (auto const& group : _groups) {
+    groupKey.add(lookup(document, group.path));
+  }
+  groupKey.close();
+
+  VPackBuilder values;
+  values.openArray();
+  for (auto const& aggregate : _aggregates) {
+    values.add(lookup(document, aggregate.first.path));
+  }
+  values.close();
+
+  MUTEX_LOCKER(guard, _mutex);
+
+  auto it = _documents.find(key.copyString());
+  if (it != _documents.end()) {
+    // a new revision replaces the contribution of the previous one
+    removeContribution(it->second);
+    _documents.erase(it);
+  }
+
+  Group* group;
+  auto groupIt = _groupsByKey.find(groupKey.slice());
+  if (groupIt == _groupsByKey.end()) {
+    auto newGroup = std::make_unique<Group>();
+    newGroup->key = std::move(groupKey);
+    newGroup->aggregates.resize(_aggregates.size());
+    for (size_t i = 0; i < _aggregates.size(); ++i) {
+      newGroup->aggregates[i].function = _aggregates[i].second;
+    }
+    group = newGroup.get();
+    _groupsByKey.emplace(group->key.slice(), std::move(newGroup));
+  } else {
+    group = groupIt->second.get();
+  }
+
+  ++group->count;
+  size_t i = 0;
+  for (auto const& value : VPackArrayIterator(values.slice())) {
+    Aggregate& aggregate = group->aggregates[i++];
+    switch (aggregate.function) {
+      case Function::COUNT:
+        break;
+      case Function::SUM:
+      case Function::AVERAGE:
+        if (value.isNumber()) {
+          aggregate.sum += value.getNumber<double>();
+          ++aggregate.numbers;
+        } else if (!value.isNull()) {
+          ++aggregate.invalid;
+        }
+        break;
+      case Function::MIN:
+      case Function::MAX:
+        // a stale value is recomputed from all documents anyway
+        if (!aggregate.stale && replacesExtreme(aggregate, value)) {
+          aggregate.extreme.clear();
+          aggregate.extreme.add(value);
+        }
+        break;
+    }
+  }
+
+  _documents.emplace(
+      key.copyString(),
+      Contribution{group, std::string(values.slice().startAs<char>(),
+                                      values.slice().byteSize())});
+}
+
+void AggregateView::remove(VPackSlice document) {
+  VPackSlice key = document.get(StaticStrings::KeyString);
+  if (!key.isString()) {
+    return;
+  }
+
+  MUTEX_LOCKER(guard, _mutex);
+
+  auto it = _documents.find(key.copyString());
+  if (it != _documents.end()) {
+    removeContribution(it->second);
+    _documents.erase(it);
+  }
+}
+
+void AggregateView::removeContribution(Contribution const& contribution) {
+  Group* group = contribution.group;
+  VPackSlice values(reinterpret_cast<uint8_t const*>(contribution.values.data()));
+
+  TRI_ASSERT(group->count > 0);
+  if (--group->count == 0) {
+    auto it = _groupsByKey.find(group->key.slice());
+    TRI_ASSERT(it != _groupsByKey.end());
+    _groupsByKey.erase(it);
+    return;
+  }
+
+  size_t i = 0;
+  for (auto const& value : VPackArrayIterator(values)) {
+    Aggregate& aggregate = group->aggregates[i++];
+    switch (aggregate.function) {
+      case Function::COUNT:
+        break;
+      case Function::SUM:
+      case Function::AVERAGE:
+        if (value.isNumber()) {
+          aggregate.sum -= value.getNumber<double>();
+          if (--aggregate.numbers == 0) {
+            // do not carry rounding errors into the next values
+            aggregate.sum = 0.0;
+          }
+        } else if (!value.isNull()) {
+          --aggregate.invalid;
+        }
+        break;
+      case Function::MIN:
+      case Function::MAX:
+        if (!aggregate.stale && !aggregate.extreme.isEmpty() &&
+            (aggregate.function == Function::MAX || !value.isNull()) &&
+            basics::VelocyPackHelper::compare(
+                value, aggregate.extreme.slice(), true) == 0) {
+          // the extreme value is gone, and the next one is unknown
+          aggregate.stale = true;
+          aggregate.extreme.clear();
+          _hasStaleGroups = true;
+        }
+        break;
+    }
+  }
+}
+
+void AggregateView::refreshStaleGroups() {
+  if (!_hasStaleGroups) {
+    return;
+  }
+
+  auto isStale = [](Group const* group) {
+    for (auto const& aggregate : group->aggregates) {
+      if (aggregate.stale) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  for (auto const& it : _documents) {
+    Group* group = it.second.group;
+    if (!isStale(group)) {
+      continue;
+    }
+    VPackSlice values(reinterpret_cast<uint8_t const*>(it.second.values.data()));
+    size_t i = 0;
+    for (auto const& value : VPackArrayIterator(values)) {
+      Aggregate& aggregate = group->aggregates[i++];
+      if (aggregate.stale && replacesExtreme(aggregate, value)) {
+        aggregate.extreme.clear();
+        aggregate.extreme.add(value);
+      }
+    }
+  }
+
+  // the stale flags can only be reset after all documents were seen
+  for (auto& it : _groupsByKey) {
+    for (auto& aggregate : it.second->aggregates) {
+      aggregate.stale = false;
+    }
+  }
+  _hasStaleGroups = false;
+}
+
+void AggregateView::toResult(VPackBuilder& result) {
+  MUTEX_LOCKER(guard, _mutex);
+
+  refreshStaleGroups();
+
+  std::vector<Group const*> groups;
+  groups.reserve(_groupsByKey.size());
+  for (auto const& it : _groupsByKey) {
+    groups.emplace_back(it.second.get());
+  }
+  std::sort(groups.begin(), groups.end(),
+            [](Group const* lhs, Group const* rhs) {
+              return basics::VelocyPackHelper::compare(
+                         lhs->key.slice(), rhs->key.slice(), true) < 0;
+            });
+
+  result.openObject();
+  result.add("name", VPackValue(_name));
+  result.add("ready", VPackValue(_ready));
+  result.add("tick", VPackValue(std::to_string(_tick)));
+  result.add("result", VPackValue(VPackValueType::Array));
+  for (Group const* group : groups) {
+    result.openObject();
+    size_t i = 0;
+    for (auto const& value : VPackArrayIterator(group->key.slice())) {
+      result.add(_groups[i++].name, value);
+    }
+    for (size_t j = 0; j < _aggregates.size(); ++j) {
+      Aggregate const& aggregate = group->aggregates[j];
+      std::string const& name = _aggregates[j].first.name;
+      switch (aggregate.function) {
+        case Function::COUNT:
+          result.add(name, VPackValue(group->count));
+          break;
+        case Function::SUM:
+          if (aggregate.invalid > 0) {
+            result.add(name, VPackValue(VPackValueType::Null));
+          } else {
+            result.add(name, VPackValue(aggregate.sum));
+          }
+          break;
+        case Function::AVERAGE:
+          if (aggregate.invalid > 0 || aggregate.numbers == 0) {
+            result.add(name, VPackValue(VPackValueType::Null));
+          } else {
+            result.add(name, VPackValue(aggregate.sum /
+                                        static_cast<double>(aggregate.numbers)));
+          }
+          break;
+        case Function::MIN:
+        case Function::MAX:
+          if (aggregate.extreme.isEmpty()) {
+            result.add(name, VPackValue(VPackValueType::Null));
+          } else {
+            result.add(name, aggregate.extreme.slice());
+          }
+          break;
+      }
+    }
+    result.close();
+  }
+  result.close();
+  result.close();
+}
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_UTILS_AGGREGATE_VIEW_H
+#define ARANGOD_UTILS_AGGREGATE_VIEW_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
+#include "Basics/VelocyPackHelper.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief a materialized aggregation over one collection, equivalent to
+///   FOR doc IN collection
+///     COLLECT g1 = doc.a, ... AGGREGATE x1 = FUNC(doc.b), ...
+/// the grouped result is maintained incrementally from the document
+/// changes, so reading it costs O(groups). COUNT, SUM and AVERAGE are
+/// updated in place. MIN and MAX are updated in place unless the current
+/// extreme value is removed, in which case the group is marked stale and
+/// recomputed from the stored per-document values on the next read
+class AggregateView {
+ public:
+  enum class Function { COUNT, SUM, AVERAGE, MIN, MAX };
+
+  struct Group;
+
+  /// @brief what a single document contributes to the view
+  struct Contribution {
+    Group* group;
+    /// @brief velocypack array with the input values of the aggregates
+    std::string values;
+  };
+
+  struct Aggregate {
+    Function function;
+    double sum = 0.0;
+    /// @brief number of numeric input values
+    uint64_t numbers = 0;
+    /// @brief number of input values that make SUM and AVERAGE null
+    uint64_t invalid = 0;
+    /// @brief current MIN/MAX value, empty if there is none
+    velocypack::Builder extreme;
+    bool stale = false;
+  };
+
+  struct Group {
+    velocypack::Builder key;
+    uint64_t count = 0;
+    std::vector<Aggregate> aggregates;
+  };
+
+  /// @brief validates the definition and creates a view from it. the
+  /// definition looks like
+  /// { "name": "...", "collection": "...",
+  ///   "groups": [ { "name": "...", "attribute": "a.b" }, ... ],
+  ///   "aggregates": [ { "name": "...", "function": "SUM",
+  ///                     "attribute": "c" }, ... ] }
+  static Result create(std::string const& database,
+                       velocypack::Slice definition,
+                       std::shared_ptr<AggregateView>& view);
+
+  std::string const& database() const { return _database; }
+  std::string const& name() const { return _name; }
+  std::string const& collection() const { return _collection; }
+
+  /// @brief adds the definition, as passed to create()
+  void toVelocyPack(velocypack::Builder& result) const;
+
+  /// @brief drops all groups. the view is not ready until the next call
+  /// of ready()
+  void clear();
+
+  /// @brief marks the view as built, up to the given tick
+  void ready(TRI_voc_tick_t tick);
+  bool isReady() const;
+
+  /// @brief remembers the tick the view is up to date with
+  void tick(TRI_voc_tick_t tick);
+
+  /// @brief applies the insertion or a new revision of a document
+  void insert(velocypack::Slice document);
+
+  /// @brief applies the removal of a document. only _key is used
+  void remove(velocypack::Slice document);
+
+  /// @brief adds an object with the state of the view and the groups
+  /// in the order of their keys
+  void toResult(velocypack::Builder& result);
+
+ private:
+  struct Attribute {
+    std::string name;
+    std::vector<std::string> path;
+  };
+
+  AggregateView(std::string const& database, std::string const& name,
+                std::string const& collection);
+
+  static velocypack::Slice lookup(velocypack::Slice document,
+                                  std::vector<std::string> const& path);
+
+  void removeContribution(Contribution const& contribution);
+
+  /// @brief recomputes the MIN/MAX values of stale groups
+  void refreshStaleGroups();
+
+  /// @brief whether value becomes the new MIN/MAX of the aggregate
+  static bool replacesExtreme(Aggregate const& aggregate,
+                              velocypack::Slice value);
+
+  std::string const _database;
+  std::string const _name;
+  std::string const _collection;
+  std::vector<Attribute> _groups;
+  std::vector<std::pair<Attribute, Function>> _aggregates;
+
+  mutable Mutex _mutex;
+  bool _ready;
+  TRI_voc_tick_t _tick;
+  bool _hasStaleGroups;
+  std::unordered_map<velocypack::Slice, std::unique_ptr<Group>,
+                     basics::VelocyPackHelper::VPackHash,
+                     basics::VelocyPackHelper::VPackEqual>
+      _groupsByKey;
+  std::unordered_map<std::string, Contribution> _documents;
+};
+
+}  // namespace arangodb
+
+#endif
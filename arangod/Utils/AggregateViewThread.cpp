@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AggregateViewThread.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Logger/Logger.h"
+#include "Replication/common-defines.h"
+#include "RestServer/AggregateViewFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+#include "StorageEngine/WalAccess.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/AggregateView.h"
+#include "Utils/DatabaseGuard.h"
+#include "Utils/OperationCursor.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+/// @brief amount of WAL data read per view and round
+size_t const chunkSize = 1024 * 1024;
+}
+
+AggregateViewThread::AggregateViewThread(AggregateViewFeature& feature)
+    : Thread("AggregateViews"), _feature(feature), _latestTick(0) {}
+
+AggregateViewThread::~AggregateViewThread() { shutdown(); }
+
+void AggregateViewThread::beginShutdown() {
+  Thread::beginShutdown();
+
+  // wake up the thread that may be waiting in run()
+  signal();
+}
+
+void AggregateViewThread::signal() {
+  CONDITION_LOCKER(guard, _condition);
+  guard.broadcast();
+}
+
+void AggregateViewThread::run() {
+  while (!isStopping()) {
+    bool more = false;
+
+    try {
+      more = work();
+    } catch (std::exception const& ex) {
+      LOG_TOPIC(WARN, Logger::VIEWS)
+          << "caught exception in aggregate view thread: " << ex.what();
+    } catch (...) {
+      LOG_TOPIC(WARN, Logger::VIEWS)
+          << "caught unknown exception in aggregate view thread";
+    }
+
+    if (more || isStopping()) {
+      continue;
+    }
+
+    if (_states.empty()) {
+      CONDITION_LOCKER(guard, _condition);
+      guard.wait(1000000);
+    } else {
+      EngineSelectorFeature::ENGINE->walAccess()->waitForWrites(_latestTick,
+                                                                0.5);
+    }
+  }
+}
+
+bool AggregateViewThread::work() {
+  auto views = _feature.views();
+
+  // forget about dropped views
+  for (auto it = _states.begin(); it != _states.end();) {
+    if (std::find(views.begin(), views.end(), it->first) == views.end()) {
+      it = _states.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  bool more = false;
+  for (auto const& view : views) {
+    if (isStopping()) {
+      return false;
+    }
+    TailState& state = _states[view];
+    if (!view->isReady()) {
+      build(*view, state);
+    }
+    if (view->isReady()) {
+      more |= follow(*view, state);
+    }
+  }
+  return more;
+}
+
+void AggregateViewThread::build(AggregateView& view, TailState& state) {
+  view.clear();
+  state = TailState();
+
+  std::unique_ptr<DatabaseGuard> guard;
+  try {
+    guard.reset(new DatabaseGuard(view.database()));
+  } catch (...) {
+    // database does not exist (anymore)
+    return;
+  }
+
+  auto collection = guard->database().lookupCollection(view.collection());
+  if (collection == nullptr || collection->deleted()) {
+    return;
+  }
+
+  // changes after this tick are applied from the WAL. changes that are
+  // also contained in the scan are applied twice, which is harmless, as
+  // every change replaces the previous state of the document
+  TRI_voc_tick_t const tick =
+      EngineSelectorFeature::ENGINE->walAccess()->lastTick();
+
+  SingleCollectionTransaction trx(
+    transaction::StandaloneContext::Create(guard->database()),
+    *collection,
+    AccessMode::Type::READ
+  );
+  Result res = trx.begin();
+  if (res.fail()) {
+    LOG_TOPIC(WARN, Logger::VIEWS)
+        << "unable to build aggregate view '" << view.database() << "/"
+        << view.name() << "': " << res.errorMessage();
+    return;
+  }
+
+  auto cursor = trx.indexScan(collection->name(),
+                              transaction::Methods::CursorType::ALL);
+  cursor->allDocuments([&view](LocalDocumentId const&, VPackSlice doc) {
+    view.insert(doc);
+  }, 1000);
+  trx.finish(res);
+
+  state.database = guard->database().id();
+  state.collection = collection->id();
+  state.tickStart = tick;
+  view.ready(tick);
+
+  LOG_TOPIC(DEBUG, Logger::VIEWS)
+      << "built aggregate view '" << view.database() << "/" << view.name()
+      << "' up to tick " << tick;
+}
+
+bool AggregateViewThread::follow(AggregateView& view, TailState& state) {
+  WalAccess::Filter filter;
+  filter.vocbase = state.database;
+  filter.collections.emplace(state.collection);
+  filter.tickStart = state.tickStart;
+  filter.tickLastScanned = state.tickLastScanned;
+
+  bool rebuild = false;
+  auto apply = [&view](bool isRemove, VPackSlice data) {
+    if (isRemove) {
+      view.remove(data);
+    } else {
+      view.insert(data);
+    }
+  };
+
+  WalAccessResult res = EngineSelectorFeature::ENGINE->walAccess()->tail(
+      filter, ::chunkSize, 0,
+      [&](TRI_vocbase_t*, VPackSlice const& marker) {
+        if (rebuild) {
+          return;
+        }
+        auto const type = static_cast<TRI_replication_operation_e>(
+            basics::VelocyPackHelper::getNumericValue<int>(marker, "type", 0));
+        TRI_voc_tid_t const tid = basics::StringUtils::uint64(
+            basics::VelocyPackHelper::getStringValue(marker, "tid", "0"));
+
+        switch (type) {
+          case REPLICATION_TRANSACTION_START:
+            state.transactions[tid];
+            break;
+          case REPLICATION_TRANSACTION_ABORT:
+            state.transactions.erase(tid);
+            break;
+          case REPLICATION_TRANSACTION_COMMIT: {
+            auto it = state.transactions.find(tid);
+            if (it != state.transactions.end()) {
+              for (auto const& change : it->second) {
+                apply(change.first, change.second.slice());
+              }
+              state.transactions.erase(it);
+            }
+            break;
+          }
+          case REPLICATION_MARKER_DOCUMENT:
+          case REPLICATION_MARKER_REMOVE: {
+            bool const isRemove = (type == REPLICATION_MARKER_REMOVE);
+            VPackSlice data = marker.get("data");
+            auto it = state.transactions.find(tid);
+            if (tid == 0 || it == state.transactions.end()) {
+              apply(isRemove, data);
+            } else {
+              VPackBuilder change;
+              change.add(data);
+              it->second.emplace_back(isRemove, std::move(change));
+            }
+            break;
+          }
+          case REPLICATION_COLLECTION_TRUNCATE:
+          case REPLICATION_COLLECTION_DROP:
+          case REPLICATION_COLLECTION_RENAME:
+            rebuild = true;
+            break;
+          default:
+            break;
+        }
+      });
+
+  if (res.fail() || rebuild) {
+    LOG_TOPIC_IF(WARN, Logger::VIEWS, res.fail())
+        << "unable to tail the WAL for aggregate view '" << view.database()
+        << "/" << view.name() << "': " << res.errorMessage();
+    // start over with a full scan
+    view.clear();
+    return rebuild;
+  }
+
+  _latestTick = std::max(_latestTick, res.latestTick());
+  if (res.lastIncludedTick() > 0) {
+    state.tickStart = res.lastIncludedTick();
+  } else if (res.lastScannedTick() > state.tickStart) {
+    // nothing relevant in the scanned batches, so they need not be
+    // scanned again
+    state.tickStart = res.lastScannedTick();
+  }
+  state.tickLastScanned = res.lastScannedTick();
+
+  bool const more = res.lastIncludedTick() > 0 &&
+                    res.lastIncludedTick() < res.latestTick();
+  if (state.transactions.empty()) {
+    view.tick(more ? state.tickStart
+                   : std::max(state.tickStart, res.latestTick()));
+  }
+
+  return more;
+}
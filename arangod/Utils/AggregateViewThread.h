@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_UTILS_AGGREGATE_VIEW_THREAD_H
+#define ARANGOD_UTILS_AGGREGATE_VIEW_THREAD_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Thread.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/Builder.h>
+
+namespace arangodb {
+
+class AggregateView;
+class AggregateViewFeature;
+
+/// @brief background thread that keeps the aggregate views up to date.
+/// a view is built by a full scan of its collection first, then the
+/// thread applies the document changes it finds when tailing the WAL.
+/// the changes of a transaction are only applied on its commit
+class AggregateViewThread final : public Thread {
+ public:
+  explicit AggregateViewThread(AggregateViewFeature& feature);
+  ~AggregateViewThread();
+
+  void beginShutdown() override;
+
+  /// @brief wakes up the thread, e.g. to build a new view
+  void signal();
+
+ protected:
+  void run() override;
+
+ private:
+  struct TailState {
+    TRI_voc_tick_t database = 0;
+    TRI_voc_cid_t collection = 0;
+    TRI_voc_tick_t tickStart = 0;
+    TRI_voc_tick_t tickLastScanned = 0;
+    /// @brief changes of transactions that are not yet committed, in
+    /// the order of the WAL. the flag is set for removals
+    std::unordered_map<TRI_voc_tid_t,
+                       std::vector<std::pair<bool, velocypack::Builder>>>
+        transactions;
+  };
+
+  /// @brief builds and updates all views. returns whether the WAL
+  /// contains more data to apply
+  bool work();
+
+  /// @brief fills the view from a full collection scan
+  void build(AggregateView& view, TailState& state);
+
+  /// @brief applies the next chunk of the WAL to the view. returns
+  /// whether there is more data
+  bool follow(AggregateView& view, TailState& state);
+
+ private:
+  AggregateViewFeature& _feature;
+
+  std::unordered_map<std::shared_ptr<AggregateView>, TailState> _states;
+
+  /// @brief the latest tick in the WAL seen when tailing
+  TRI_voc_tick_t _latestTick;
+
+  arangodb::basics::ConditionVariable _condition;
+};
+
+}  // namespace arangodb
+
+#endif
@@ -98,6 +98,9 @@ class Cursor {
 
   virtual size_t count() const = 0;
 
+  /// @brief number of bytes of result data the cursor keeps in memory
+  virtual size_t memoryUsage() const { return 0; }
+
   virtual std::shared_ptr<transaction::Context> context() const = 0;
 
   /**
@@ -52,6 +52,10 @@ using namespace arangodb;
 
 size_t const CursorRepository::MaxCollectCount = 32;
 
+std::atomic<uint64_t> CursorRepository::_memoryUsage(0);
+
+uint64_t CursorRepository::_maxMemoryUsage = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create a cursor repository
 ////////////////////////////////////////////////////////////////////////////////
@@ -93,7 +97,7 @@ CursorRepository::~CursorRepository() {
     MUTEX_LOCKER(mutexLocker, _lock);
 
     for (auto it : _cursors) {
-      delete it.second.first;
+      destroyCursor(it.second.first);
     }
 
     _cursors.clear();
@@ -117,6 +121,8 @@ Cursor* CursorRepository::addCursor(std::unique_ptr<Cursor> cursor) {
     _cursors.emplace(id, std::make_pair(cursor.get(), user));
   }
 
+  _memoryUsage.fetch_add(cursor->memoryUsage(), std::memory_order_relaxed);
+
   return cursor.release();
 }
 
@@ -205,7 +211,7 @@ bool CursorRepository::remove(CursorId id, Cursor::CursorType type) {
 
   TRI_ASSERT(cursor != nullptr);
 
-  delete cursor;
+  destroyCursor(cursor);
   return true;
 }
 
@@ -271,7 +277,7 @@ void CursorRepository::release(Cursor* cursor) {
   }
 
   // and free the cursor
-  delete cursor;
+  destroyCursor(cursor);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -339,8 +345,17 @@ bool CursorRepository::garbageCollect(bool force) {
 
   // remove cursors outside the lock
   for (auto it : found) {
-    delete it;
+    destroyCursor(it);
   }
 
   return (!found.empty());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a cursor that is no longer in the registry
+////////////////////////////////////////////////////////////////////////////////
+
+void CursorRepository::destroyCursor(Cursor* cursor) {
+  _memoryUsage.fetch_sub(cursor->memoryUsage(), std::memory_order_relaxed);
+  delete cursor;
+}
@@ -117,7 +117,37 @@ class CursorRepository {
 
   bool garbageCollect(bool);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief cumulated memory usage of the cursors of all repositories
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t memoryUsage() {
+    return _memoryUsage.load(std::memory_order_relaxed);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the memory budget for cursors of all repositories
+  /// (0 = unlimited)
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void setMaxMemoryUsage(uint64_t value) { _maxMemoryUsage = value; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the cursors use up the memory budget. while they
+  /// do, non-streaming queries should be turned into streaming cursors
+  //////////////////////////////////////////////////////////////////////////////
+
+  static bool memoryBudgetExceeded() {
+    return _maxMemoryUsage > 0 && memoryUsage() >= _maxMemoryUsage;
+  }
+
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief destroy a cursor that is no longer in the registry
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void destroyCursor(Cursor*);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief vocbase
   //////////////////////////////////////////////////////////////////////////////
@@ -141,6 +171,18 @@ class CursorRepository {
   //////////////////////////////////////////////////////////////////////////////
 
   static size_t const MaxCollectCount;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief cumulated memory usage of the cursors of all repositories
+  //////////////////////////////////////////////////////////////////////////////
+
+  static std::atomic<uint64_t> _memoryUsage;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief memory budget for the cursors of all repositories
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t _maxMemoryUsage;
 };
 
 }
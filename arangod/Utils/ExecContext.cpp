@@ -24,6 +24,8 @@
 
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
+#include "RestServer/DatabaseFeature.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
 using namespace arangodb;
@@ -109,6 +111,19 @@ auth::Level ExecContext::collectionAuthLevel(std::string const& dbname,
   }  // intentional fall through
   
   auth::UserManager* um = af->userManager();
+  if (um == nullptr && _routingCollection != 0) {
+    // DB server request with a routing token, which covers the shards
+    // of a single collection in the current database
+    if (dbname != _database) {
+      return auth::Level::NONE;
+    }
+    TRI_vocbase_t* vocbase = DatabaseFeature::DATABASE->lookupDatabase(dbname);
+    auto collection = (vocbase != nullptr) ? vocbase->lookupCollection(coll) : nullptr;
+    if (collection == nullptr || collection->planId() != _routingCollection) {
+      return auth::Level::NONE;
+    }
+    return _databaseAuthLevel;
+  }
   TRI_ASSERT(um != nullptr);
   if (um == nullptr) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unable to find userManager instance");
@@ -26,6 +26,7 @@
 #include "Auth/Common.h"
 #include "Basics/Common.h"
 #include "Rest/RequestContext.h"
+#include "VocBase/voc-types.h"
 
 namespace arangodb {
 namespace transaction {
@@ -53,7 +54,8 @@ class ExecContext : public RequestContext {
         _database(database),
         _canceled(false),
         _systemDbAuthLevel(systemLevel),
-        _databaseAuthLevel(dbLevel) {}
+        _databaseAuthLevel(dbLevel),
+        _routingCollection(0) {}
   ExecContext(ExecContext const&) = delete;
   ExecContext(ExecContext&&) = delete;
  public:
@@ -159,6 +161,9 @@ class ExecContext : public RequestContext {
   auth::Level _systemDbAuthLevel;
   /// level of current database
   auth::Level _databaseAuthLevel;
+  /// plan id of the only collection whose shards may be accessed, set
+  /// for requests with a routing token on servers without users
+  TRI_voc_cid_t _routingCollection;
 
   static ExecContext SUPERUSER;
 };
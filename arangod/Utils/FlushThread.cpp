@@ -73,18 +73,36 @@ void FlushThread::run() {
       TRI_IF_FAILURE("FlushThreadCrashAfterWalSync") {
         TRI_SegfaultDebugging("crashing before flush thread callbacks");
       }
-      flushFeature->executeCallbacks();
+      flushFeature->executeCallbacks(toRelease);
       TRI_IF_FAILURE("FlushThreadCrashAfterCallbacks") {
         TRI_SegfaultDebugging("crashing before releasing tick");
       }
       engine->waitForSyncTick(engine->currentTick());  // wait for callback trx
+      // callbacks that failed to commit still need the WAL since their
+      // last successful commit
+      toRelease = flushFeature->releasableTick(toRelease);
       engine->releaseTick(toRelease);
       LOG_TOPIC(TRACE, Logger::FLUSH)
           << "released tick " << toRelease << " for garbage collection";
 
-      // sleep if nothing to do
-      CONDITION_LOCKER(guard, _condition);
-      guard.wait(_flushInterval);
+      // sleep if nothing to do. callbacks that keep the WAL for too long
+      // are retried in between, so they release it as soon as possible
+      uint64_t waited = 0;
+      while (waited < _flushInterval && !isStopping()) {
+        uint64_t const step = flushFeature->hasLaggingCallbacks()
+                                  ? (std::max)(_flushInterval / 10, uint64_t(1000))
+                                  : _flushInterval - waited;
+        {
+          CONDITION_LOCKER(guard, _condition);
+          guard.wait(step);
+        }
+        waited += step;
+        if (waited < _flushInterval && flushFeature->hasLaggingCallbacks()) {
+          TRI_voc_tick_t tick = engine->currentTick();
+          engine->waitForSyncTick(tick);
+          flushFeature->executeCallbacks(tick, true);
+        }
+      }
     } catch(basics::Exception const& ex) {
       if (ex.code() == TRI_ERROR_SHUTTING_DOWN) {
         break;
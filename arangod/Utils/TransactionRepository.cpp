@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TransactionRepository.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+#include "Logger/Logger.h"
+#include "Transaction/Methods.h"
+#include "Transaction/Options.h"
+#include "Transaction/SmartContext.h"
+#include "Utils/ExecContext.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+std::string currentUser() {
+  return ExecContext::CURRENT != nullptr ? ExecContext::CURRENT->user() : "";
+}
+
+/// @brief whether or not the current user may use a transaction that was
+/// started by the given user
+bool authorized(std::string const& user) {
+  auto context = ExecContext::CURRENT;
+  if (context == nullptr || !ExecContext::isAuthEnabled()) {
+    return true;
+  }
+  if (context->isSuperuser()) {
+    return true;
+  }
+  return (user == context->user());
+}
+
+/// @brief reads a collection name or an array of collection names
+bool getCollections(VPackSlice collections, char const* attributeName,
+                    std::vector<std::string>& result) {
+  VPackSlice value = collections.get(attributeName);
+  if (value.isNone()) {
+    return true;
+  }
+  if (value.isString()) {
+    result.emplace_back(value.copyString());
+    return true;
+  }
+  if (!value.isArray()) {
+    return false;
+  }
+  for (auto const& name : VPackArrayIterator(value)) {
+    if (!name.isString()) {
+      return false;
+    }
+    result.emplace_back(name.copyString());
+  }
+  return true;
+}
+}
+
+struct TransactionRepository::ManagedTransaction {
+  ManagedTransaction(std::shared_ptr<transaction::Context> const& context,
+                     std::unique_ptr<transaction::Methods> trx,
+                     std::string const& user, double ttl)
+      : context(context),
+        trx(std::move(trx)),
+        user(user),
+        ttl(ttl),
+        expires(TRI_microtime() + ttl),
+        isUsed(false) {}
+
+  /// @brief the context all requests of the transaction use
+  std::shared_ptr<transaction::Context> context;
+  /// @brief the top-level transaction
+  std::unique_ptr<transaction::Methods> trx;
+  /// @brief the user that started the transaction
+  std::string const user;
+  double const ttl;
+  double expires;
+  /// @brief whether a request is currently operating on the transaction
+  bool isUsed;
+};
+
+TransactionRepository::TransactionRepository(TRI_vocbase_t& vocbase)
+    : _vocbase(vocbase) {}
+
+TransactionRepository::~TransactionRepository() {
+  try {
+    garbageCollect(true);
+  } catch (...) {
+  }
+}
+
+/// @brief starts a transaction and stores it in the repository
+Result TransactionRepository::begin(VPackSlice body, TRI_voc_tid_t& tid) {
+  tid = 0;
+
+  if (!body.isObject()) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "expecting object body");
+  }
+
+  VPackSlice collections = body.get("collections");
+  if (!collections.isObject()) {
+    return Result(TRI_ERROR_BAD_PARAMETER,
+                  "missing/invalid collections definition for transaction");
+  }
+
+  std::vector<std::string> readCollections;
+  std::vector<std::string> writeCollections;
+  std::vector<std::string> exclusiveCollections;
+
+  if (!::getCollections(collections, "read", readCollections) ||
+      !::getCollections(collections, "write", writeCollections) ||
+      !::getCollections(collections, "exclusive", exclusiveCollections)) {
+    return Result(TRI_ERROR_BAD_PARAMETER,
+                  "invalid collection definition for transaction");
+  }
+
+  transaction::Options options;
+  options.fromVelocyPack(body);
+  if (collections.get("allowImplicit").isBoolean()) {
+    options.allowImplicitCollections = collections.get("allowImplicit").getBool();
+  }
+  if (options.lockTimeout < 0.0) {
+    return Result(TRI_ERROR_BAD_PARAMETER, "<lockTimeout> needs to be positive");
+  }
+
+  double ttl = DefaultTtl;
+  VPackSlice value = body.get("ttl");
+  if (value.isNumber()) {
+    ttl = value.getNumber<double>();
+    if (ttl <= 0.0) {
+      return Result(TRI_ERROR_BAD_PARAMETER, "<ttl> needs to be positive");
+    }
+  }
+
+  // the context keeps the transaction state registered, so transaction::Methods
+  // created for later requests get embedded into this transaction
+  auto ctx = transaction::SmartContext::Create(_vocbase);
+  std::unique_ptr<transaction::Methods> trx(new transaction::Methods(
+      ctx, readCollections, writeCollections, exclusiveCollections, options));
+
+  Result res = trx->begin();
+  if (res.fail()) {
+    return res;
+  }
+
+  tid = trx->tid();
+  auto managed = std::make_unique<ManagedTransaction>(ctx, std::move(trx),
+                                                      ::currentUser(), ttl);
+
+  MUTEX_LOCKER(mutexLocker, _lock);
+  _transactions.emplace(tid, std::move(managed));
+
+  return Result();
+}
+
+/// @brief leases a transaction for the duration of a request
+std::shared_ptr<transaction::Context> TransactionRepository::lease(
+    TRI_voc_tid_t tid) {
+  MUTEX_LOCKER(mutexLocker, _lock);
+
+  ManagedTransaction* trx = nullptr;
+  Result res = find(tid, trx);
+  if (res.fail()) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  if (trx->isUsed) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_LOCKED, "transaction is used by another request");
+  }
+
+  trx->isUsed = true;
+  return trx->context;
+}
+
+/// @brief returns a leased transaction and extends its lifetime
+void TransactionRepository::release(TRI_voc_tid_t tid) {
+  MUTEX_LOCKER(mutexLocker, _lock);
+
+  auto it = _transactions.find(tid);
+  if (it == _transactions.end()) {
+    return;
+  }
+
+  TRI_ASSERT(it->second->isUsed);
+  it->second->isUsed = false;
+  it->second->expires = TRI_microtime() + it->second->ttl;
+}
+
+/// @brief returns the status of a transaction
+Result TransactionRepository::status(TRI_voc_tid_t tid,
+                                     transaction::Status& status) {
+  MUTEX_LOCKER(mutexLocker, _lock);
+
+  ManagedTransaction* trx = nullptr;
+  Result res = find(tid, trx);
+  if (res.ok()) {
+    status = trx->trx->status();
+  }
+  return res;
+}
+
+/// @brief commits or aborts a transaction and removes it from the repository
+Result TransactionRepository::finish(TRI_voc_tid_t tid, bool commit) {
+  std::unique_ptr<ManagedTransaction> managed;
+
+  {
+    MUTEX_LOCKER(mutexLocker, _lock);
+
+    ManagedTransaction* trx = nullptr;
+    Result res = find(tid, trx);
+    if (res.fail()) {
+      return res;
+    }
+
+    if (trx->isUsed) {
+      return Result(TRI_ERROR_LOCKED, "transaction is used by another request");
+    }
+
+    auto it = _transactions.find(tid);
+    managed = std::move(it->second);
+    _transactions.erase(it);
+  }
+
+  // finish the transaction outside of the lock
+  if (commit) {
+    return managed->trx->commit();
+  }
+  return managed->trx->abort();
+}
+
+/// @brief aborts expired (or with force, all unused) transactions
+bool TransactionRepository::garbageCollect(bool force) {
+  auto const now = TRI_microtime();
+  std::vector<std::unique_ptr<ManagedTransaction>> found;
+
+  {
+    MUTEX_LOCKER(mutexLocker, _lock);
+
+    for (auto it = _transactions.begin(); it != _transactions.end(); /* no hoisting */) {
+      ManagedTransaction* trx = it->second.get();
+
+      if (!trx->isUsed && (force || trx->expires < now)) {
+        found.emplace_back(std::move(it->second));
+        it = _transactions.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  // abort transactions outside the lock
+  for (auto& it : found) {
+    LOG_TOPIC(DEBUG, Logger::TRANSACTIONS)
+        << "aborting expired transaction " << it->trx->tid();
+    try {
+      it->trx->abort();
+    } catch (...) {
+    }
+  }
+
+  return (!found.empty());
+}
+
+/// @brief looks up a transaction of the current user
+Result TransactionRepository::find(TRI_voc_tid_t tid, ManagedTransaction*& trx) {
+  auto it = _transactions.find(tid);
+  if (it == _transactions.end() || !::authorized(it->second->user)) {
+    return Result(TRI_ERROR_TRANSACTION_NOT_FOUND);
+  }
+  trx = it->second.get();
+  return Result();
+}
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_UTILS_TRANSACTION_REPOSITORY_H
+#define ARANGOD_UTILS_TRANSACTION_REPOSITORY_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
+#include "Transaction/Status.h"
+#include "VocBase/voc-types.h"
+
+struct TRI_vocbase_t;
+
+namespace arangodb {
+
+namespace velocypack {
+class Slice;
+}
+
+namespace transaction {
+class Context;
+class Methods;
+}
+
+/// @brief registry of stream transactions, i.e. transactions that are
+/// started, used and finished by separate requests instead of running a
+/// JavaScript action. requests join a transaction by leasing its context,
+/// which makes their transaction::Methods embedded into the stored one
+class TransactionRepository {
+ public:
+  explicit TransactionRepository(TRI_vocbase_t& vocbase);
+  ~TransactionRepository();
+
+  /// @brief default time (in seconds) an idle transaction is kept
+  static constexpr double DefaultTtl = 60.0;
+
+  /// @brief starts a transaction on the collections and with the options
+  /// given in the object body ("collections", "lockTimeout", "ttl" etc.)
+  /// and stores it in the repository
+  Result begin(velocypack::Slice body, TRI_voc_tid_t& tid);
+
+  /// @brief leases a transaction for the duration of a request. returns
+  /// the transaction's context, or throws if the transaction does not
+  /// exist, belongs to another user or is used by another request.
+  /// a leased transaction must be returned using release()
+  std::shared_ptr<transaction::Context> lease(TRI_voc_tid_t tid);
+
+  /// @brief returns a leased transaction and extends its lifetime
+  void release(TRI_voc_tid_t tid);
+
+  /// @brief commits a transaction and removes it from the repository
+  Result commit(TRI_voc_tid_t tid) { return finish(tid, true); }
+
+  /// @brief aborts a transaction and removes it from the repository
+  Result abort(TRI_voc_tid_t tid) { return finish(tid, false); }
+
+  /// @brief returns the status of a transaction
+  Result status(TRI_voc_tid_t tid, transaction::Status& status);
+
+  /// @brief aborts expired (or with force, all unused) transactions
+  /// @return whether any transaction was aborted
+  bool garbageCollect(bool force);
+
+ private:
+  struct ManagedTransaction;
+
+  Result finish(TRI_voc_tid_t tid, bool commit);
+
+  /// @brief looks up a transaction of the current user. must be called
+  /// with _lock held
+  Result find(TRI_voc_tid_t tid, ManagedTransaction*& trx);
+
+ private:
+  TRI_vocbase_t& _vocbase;
+
+  /// @brief protects _transactions
+  Mutex _lock;
+
+  /// @brief all open transactions
+  std::unordered_map<TRI_voc_tid_t, std::unique_ptr<ManagedTransaction>> _transactions;
+};
+
+}
+
+#endif
@@ -520,6 +520,42 @@ V8Context* V8DealerFeature::addContext() {
   }
 }
 
+/// @brief creates an additional idle context. the caller must have
+/// increased _nrInflightContexts already
+void V8DealerFeature::addSpareContext() {
+  V8Context* context = nullptr;
+
+  try {
+    LOG_TOPIC(DEBUG, Logger::V8) << "creating spare V8 context";
+    context = addContext();
+  } catch (...) {
+    CONDITION_LOCKER(guard, _contextCondition);
+    --_nrInflightContexts;
+    throw;
+  }
+
+  CONDITION_LOCKER(guard, _contextCondition);
+  --_nrInflightContexts;
+
+  try {
+    _contexts.push_back(context);
+  } catch (...) {
+    delete context;
+    throw;
+  }
+
+  try {
+    _idleContexts.push_back(context);
+  } catch (...) {
+    _contexts.pop_back();
+    delete context;
+    throw;
+  }
+
+  LOG_TOPIC(DEBUG, Logger::V8) << "created spare V8 context #" << context->id() << ", number of contexts is now " << _contexts.size();
+  guard.broadcast();
+}
+
 void V8DealerFeature::unprepare() {
   shutdownContexts();
 
@@ -572,6 +608,7 @@ void V8DealerFeature::collectGarbage() {
     try {
       V8Context* context = nullptr;
       bool wasDirty = false;
+      bool createSpare = false;
 
       {
         bool gotSignal = false;
@@ -615,6 +652,21 @@ void V8DealerFeature::collectGarbage() {
         // loop
         // and waste CPU unnecessary
         useReducedWait = (context != nullptr);
+
+        if (context == nullptr && _idleContexts.empty() &&
+            _dirtyContexts.empty() && !_busyContexts.empty() && !_stopping &&
+            _contexts.size() + _nrInflightContexts < _nrMaxContexts &&
+            _dynamicContextCreationBlockers == 0) {
+          // all contexts are in use. bootstrapping a context takes long, so
+          // do it here instead of in the next request that needs one
+          ++_nrInflightContexts;
+          createSpare = true;
+        }
+      }
+
+      if (createSpare) {
+        addSpareContext();
+        continue;
       }
 
       // update last gc time
@@ -1013,6 +1065,12 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
 
     // should not fail because we reserved enough space beforehand
     _busyContexts.emplace(context);
+
+    if (_idleContexts.empty() && _dirtyContexts.empty()) {
+      // that was the last free context. wake up the GC thread, which
+      // creates a spare one in the background
+      guard.broadcast();
+    }
   }
 
   TRI_ASSERT(context != nullptr);
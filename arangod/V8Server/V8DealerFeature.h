@@ -128,6 +128,7 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   void copyInstallationFiles();
   void startGarbageCollection();
   V8Context* addContext();
+  void addSpareContext();
   V8Context* buildContext(size_t id);
   V8Context* pickFreeContextForGc();
   void shutdownContext(V8Context* context);
@@ -987,6 +987,8 @@ static void JS_QueriesCurrentAql(
                v8::Number::New(isolate, q.runTime));
       obj->Set(TRI_V8_ASCII_STRING(isolate, "state"), TRI_V8_STD_STRING(isolate, aql::QueryExecutionState::toString(q.state)));
       obj->Set(TRI_V8_ASCII_STRING(isolate, "stream"), v8::Boolean::New(isolate, q.stream));
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "memoryUsage"), v8::Number::New(isolate, static_cast<double>(q.memoryUsage)));
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "peakMemoryUsage"), v8::Number::New(isolate, static_cast<double>(q.peakMemoryUsage)));
       result->Set(i++, obj);
     }
 
@@ -1039,6 +1041,8 @@ static void JS_QueriesSlowAql(v8::FunctionCallbackInfo<v8::Value> const& args) {
                v8::Number::New(isolate, q.runTime));
       obj->Set(TRI_V8_ASCII_STRING(isolate, "state"), TRI_V8_STD_STRING(isolate, aql::QueryExecutionState::toString(q.state)));
       obj->Set(TRI_V8_ASCII_STRING(isolate, "stream"), v8::Boolean::New(isolate, q.stream));
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "memoryUsage"), v8::Number::New(isolate, static_cast<double>(q.memoryUsage)));
+      obj->Set(TRI_V8_ASCII_STRING(isolate, "peakMemoryUsage"), v8::Number::New(isolate, static_cast<double>(q.peakMemoryUsage)));
       result->Set(i++, obj);
     }
 
@@ -24,6 +24,7 @@
 
 #include "LogicalCollection.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Basics/fasthash.h"
 #include "Basics/Mutex.h"
@@ -47,6 +48,7 @@
 #include "VocBase/ManagedDocumentResult.h"
 
 #include <velocypack/Collection.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -763,14 +765,10 @@ arangodb::Result LogicalCollection::properties(
         return Result(TRI_ERROR_BAD_PARAMETER, "bad value for satellite");
       }
       // we got the string "satellite"...
-#ifdef USE_ENTERPRISE
       if (!isSatellite()) {
         // but the collection is not a satellite collection!
         return Result(TRI_ERROR_FORBIDDEN, "cannot change satellite collection status");
       }
-#else
-      return Result(TRI_ERROR_FORBIDDEN, "cannot use satellite collection status");
-#endif
       // fallthrough here if we set the string "satellite" for a satellite collection
       TRI_ASSERT(isSatellite() && _sharding->replicationFactor() == 0 && rf == 0);
     } else {
@@ -851,9 +849,7 @@ std::shared_ptr<Index> LogicalCollection::createIndex(transaction::Methods* trx,
 /// @brief drops an index, including index file removal and replication
 bool LogicalCollection::dropIndex(TRI_idx_iid_t iid) {
   TRI_ASSERT(!ServerState::instance()->isCoordinator());
-#if USE_PLAN_CACHE
-  arangodb::aql::PlanCache::instance()->invalidate(_vocbase);
-#endif
+  arangodb::aql::PlanCache::instance()->invalidate(&vocbase());
   arangodb::aql::QueryCache::instance()->invalidate(&vocbase(), name());
 
   bool result = _physical->dropIndex(iid);
@@ -906,6 +902,15 @@ Result LogicalCollection::read(transaction::Methods* trx, arangodb::velocypack::
   return getPhysical()->read(trx, key, result, lock);
 }
 
+Result LogicalCollection::readMany(
+    transaction::Methods* trx, std::vector<StringRef> const& keys,
+    std::function<void(size_t, velocypack::Slice)> const& cb, bool lock) {
+  TRI_IF_FAILURE("LogicalCollection::read") {
+    return Result(TRI_ERROR_DEBUG);
+  }
+  return getPhysical()->readMany(trx, keys, cb, lock);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief processes a truncate operation (note: currently this only clears
 /// the read-cache
@@ -937,6 +942,21 @@ Result LogicalCollection::insert(transaction::Methods* trx,
                                lock, revisionId);
 }
 
+/// @brief inserts multiple documents or edges into a collection
+void LogicalCollection::insertMany(
+    transaction::Methods* trx, VPackSlice const documents,
+    ManagedDocumentResult& result, OperationOptions& options, bool lock,
+    std::function<void(VPackSlice, Result const&, TRI_voc_tick_t,
+                       TRI_voc_rid_t)> const& cb) {
+  TRI_IF_FAILURE("LogicalCollection::insert") {
+    for (auto const& value : VPackArrayIterator(documents)) {
+      cb(value, Result(TRI_ERROR_DEBUG), 0, 0);
+    }
+    return;
+  }
+  getPhysical()->insertMany(trx, documents, result, options, lock, cb);
+}
+
 /// @brief updates a document or edge in a collection
 Result LogicalCollection::update(transaction::Methods* trx,
                                  VPackSlice const newSlice,
@@ -270,6 +270,13 @@ class LogicalCollection : public LogicalDataSource {
   Result read(transaction::Methods*, arangodb::velocypack::Slice const&,
               ManagedDocumentResult& result, bool);
 
+  /// @brief reads the documents with the given keys at once. the callback
+  /// is called with the position of the key for each document found, in
+  /// the order of the keys
+  Result readMany(transaction::Methods* trx, std::vector<StringRef> const& keys,
+                  std::function<void(size_t, velocypack::Slice)> const& cb,
+                  bool lock);
+
   /// @brief processes a truncate operation
   Result truncate(transaction::Methods* trx, OperationOptions&);
 
@@ -284,6 +291,12 @@ class LogicalCollection : public LogicalDataSource {
     return insert(trx, slice, result, options, resultMarkerTick, lock, unused);
   }
 
+  /// @brief inserts all members of an array, see PhysicalCollection::insertMany
+  void insertMany(transaction::Methods*, velocypack::Slice const,
+                  ManagedDocumentResult& result, OperationOptions&, bool lock,
+                  std::function<void(velocypack::Slice, Result const&,
+                                     TRI_voc_tick_t, TRI_voc_rid_t)> const& cb);
+
   Result update(transaction::Methods*, velocypack::Slice const,
                 ManagedDocumentResult& result, OperationOptions&,
                 TRI_voc_tick_t&, bool, TRI_voc_rid_t& prevRev,
@@ -58,6 +58,7 @@
 #include "StorageEngine/StorageEngine.h"
 #include "Utils/CollectionKeysRepository.h"
 #include "Utils/CursorRepository.h"
+#include "Utils/TransactionRepository.h"
 #include "Utils/Events.h"
 #include "Utils/ExecContext.h"
 #include "Utils/VersionTracker.h"
@@ -746,9 +747,7 @@ int TRI_vocbase_t::dropCollectionWorker(arangodb::LogicalCollection* collection,
   TRI_ASSERT(writeLocker.isLocked());
   TRI_ASSERT(locker.isLocked());
 
-#if USE_PLAN_CACHE
   arangodb::aql::PlanCache::instance()->invalidate(this);
-#endif
   arangodb::aql::QueryCache::instance()->invalidate(this);
 
   switch (collection->status()) {
@@ -856,6 +855,9 @@ void TRI_vocbase_t::shutdown() {
   // soon
   _collectionKeys->garbageCollect(true);
 
+  // abort all stream transactions that are not in use
+  _transactionRepository->garbageCollect(true);
+
   std::vector<std::shared_ptr<arangodb::LogicalCollection>> collections;
 
   {
@@ -1755,6 +1757,7 @@ TRI_vocbase_t::TRI_vocbase_t(TRI_vocbase_type_e type, TRI_voc_tick_t id,
   _queries.reset(new arangodb::aql::QueryList(this));
   _cursorRepository.reset(new arangodb::CursorRepository(*this));
   _collectionKeys.reset(new arangodb::CollectionKeysRepository());
+  _transactionRepository.reset(new arangodb::TransactionRepository(*this));
 
   // init collections
   _collections.reserve(32);
@@ -1769,6 +1772,9 @@ TRI_vocbase_t::~TRI_vocbase_t() {
     TRI_FreeUserStructuresVocBase(this);
   }
 
+  // open stream transactions must be aborted while the collections exist
+  _transactionRepository.reset();
+
   StorageEngine* engine = EngineSelectorFeature::ENGINE;
 
   engine->shutdownDatabase(*this);
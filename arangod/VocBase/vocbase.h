@@ -45,6 +45,7 @@ class QueryList;
 class CollectionNameResolver;
 class CollectionKeysRepository;
 class CursorRepository;
+class TransactionRepository;
 class DatabaseReplicationApplier;
 class LogicalCollection;
 class LogicalDataSource;
@@ -168,6 +169,7 @@ struct TRI_vocbase_t {
   std::unique_ptr<arangodb::aql::QueryList> _queries;
   std::unique_ptr<arangodb::CursorRepository> _cursorRepository;
   std::unique_ptr<arangodb::CollectionKeysRepository> _collectionKeys;
+  std::unique_ptr<arangodb::TransactionRepository> _transactionRepository;
 
   std::unique_ptr<arangodb::DatabaseReplicationApplier> _replicationApplier;
 
@@ -229,6 +231,9 @@ struct TRI_vocbase_t {
   arangodb::CollectionKeysRepository* collectionKeys() const {
     return _collectionKeys.get();
   }
+  arangodb::TransactionRepository* transactionRepository() const {
+    return _transactionRepository.get();
+  }
 
   bool isOwnAppsDirectory() const { return _isOwnAppsDirectory; }
   void setIsOwnAppsDirectory(bool value) { _isOwnAppsDirectory = value; }
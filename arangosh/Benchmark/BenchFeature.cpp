@@ -37,6 +37,9 @@
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 using namespace arangodb::arangobench;
 using namespace arangodb::basics;
@@ -75,6 +78,10 @@ BenchFeature::BenchFeature(
       _replicationFactor(1),
       _numberOfShards(1),
       _waitForSync(false),
+      _rate(0.0),
+      _jsonReportFile(""),
+      _workload("a"),
+      _records(100000),
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -132,7 +139,8 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                                            "multitrx",
                                            "multi-collection",
                                            "aqlinsert",
-                                           "aqlv8"};
+                                           "aqlv8",
+                                           "ycsb"};
 
   options->addOption(
       "--test-case", "test case to use",
@@ -141,6 +149,25 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addOption("--complexity", "complexity parameter for the test (meaning depends on test case)",
                      new UInt64Parameter(&_complexity));
 
+  std::unordered_set<std::string> workloads = {"a", "b", "c", "d", "e", "f"};
+
+  options->addOption(
+      "--workload",
+      "operation mix of the ycsb test case: a (50% read, 50% update), "
+      "b (95% read, 5% update), c (100% read), d (95% read latest, 5% insert), "
+      "e (95% scan, 5% insert), f (50% read, 50% read-modify-write)",
+      new DiscreteValuesParameter<StringParameter>(&_workload, workloads));
+
+  options->addOption("--records",
+                     "number of documents loaded by the ycsb test case",
+                     new UInt64Parameter(&_records));
+
+  options->addOption("--rate",
+                     "requests per second over all threads, sent at fixed "
+                     "intervals regardless of response times (0 = send the "
+                     "next request as soon as the previous one returned)",
+                     new DoubleParameter(&_rate));
+
   options->addOption("--delay",
                      "use a startup delay (necessary only when run in series)",
                      new BooleanParameter(&_delay));
@@ -149,6 +176,11 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      "filename to write junit style report to",
                      new StringParameter(&_junitReportFile));
 
+  options->addOption("--json-report-file",
+                     "filename to write a JSON report with latency "
+                     "percentiles to",
+                     new StringParameter(&_jsonReportFile));
+
   options->addOption(
       "--runs", "run test n times (and calculate statistics based on median)",
       new UInt64Parameter(&_runs));
@@ -226,7 +258,8 @@ void BenchFeature::start() {
       BenchmarkThread* thread = new BenchmarkThread(
           benchmark.get(), &startCondition, &BenchFeature::updateStartCounter,
           static_cast<int>(i), (unsigned long)_batchSize, &operationsCounter,
-          client, _keepAlive, _async, _verbose);
+          client, _keepAlive, _async, _verbose,
+          _rate / static_cast<double>(_concurreny));
       thread->setOffset((size_t)(i * realStep));
       thread->start();
       threads.push_back(thread);
@@ -275,9 +308,11 @@ void BenchFeature::start() {
 
     double time = TRI_microtime() - start;
     double requestTime = 0.0;
+    LatencyHistogram histogram;
 
     for (size_t i = 0; i < static_cast<size_t>(_concurreny); ++i) {
       requestTime += threads[i]->getTime();
+      histogram.merge(threads[i]->histogram());
     }
 
     if (operationsCounter.failures() > 0) {
@@ -287,6 +322,7 @@ void BenchFeature::start() {
     results.push_back({
         time, operationsCounter.failures(),
         operationsCounter.incompleteFailures(), requestTime,
+        std::move(histogram)
     });
     for (size_t i = 0; i < static_cast<size_t>(_concurreny); ++i) {
       delete threads[i];
@@ -327,7 +363,7 @@ bool BenchFeature::report(ClientFeature* client,
             << _collection << "'" << std::endl;
 
   std::sort(results.begin(), results.end(),
-            [](BenchRunResult a, BenchRunResult b) { return a.time < b.time; });
+            [](BenchRunResult const& a, BenchRunResult const& b) { return a.time < b.time; });
 
   BenchRunResult output{0, 0, 0, 0};
   if (_runs > 1) {
@@ -350,6 +386,8 @@ bool BenchFeature::report(ClientFeature* client,
           (results[mid - 1].failures + results[mid].failures) / 2,
           (results[mid - 1].incomplete + results[mid].incomplete) / 2,
           (results[mid - 1].requestTime + results[mid].requestTime) / 2);
+      output.histogram = results[mid - 1].histogram;
+      output.histogram.merge(results[mid].histogram);
     } else {
       output = results[mid];
     }
@@ -357,11 +395,55 @@ bool BenchFeature::report(ClientFeature* client,
     output = results[0];
   }
   printResult(output);
-  if (_junitReportFile.empty()) {
-    return true;
+
+  bool ok = true;
+  if (!_junitReportFile.empty()) {
+    ok = writeJunitReport(output);
+  }
+  if (!_jsonReportFile.empty()) {
+    ok = writeJsonReport(output) && ok;
   }
+  return ok;
+}
 
-  return writeJunitReport(output);
+bool BenchFeature::writeJsonReport(BenchRunResult const& result) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("testCase", VPackValue(_testCase));
+  if (_testCase == "ycsb") {
+    builder.add("workload", VPackValue(_workload));
+    builder.add("records", VPackValue(_records));
+  }
+  builder.add("complexity", VPackValue(_complexity));
+  builder.add("concurrency", VPackValue(_concurreny));
+  builder.add("operations", VPackValue(_operations));
+  builder.add("batchSize", VPackValue(_batchSize));
+  builder.add("rate", VPackValue(_rate));
+  builder.add("time", VPackValue(result.time));
+  builder.add("failures", VPackValue(result.failures));
+  builder.add("incomplete", VPackValue(result.incomplete));
+  builder.add("operationsPerSecond",
+              VPackValue(result.time > 0.0 ? _operations / result.time : 0.0));
+  builder.add("latency", VPackValue(VPackValueType::Object));
+  builder.add("count", VPackValue(result.histogram.count()));
+  builder.add("mean", VPackValue(result.histogram.mean()));
+  builder.add("p50", VPackValue(result.histogram.percentile(50.0)));
+  builder.add("p90", VPackValue(result.histogram.percentile(90.0)));
+  builder.add("p99", VPackValue(result.histogram.percentile(99.0)));
+  builder.add("p99.9", VPackValue(result.histogram.percentile(99.9)));
+  builder.add("max", VPackValue(result.histogram.max()));
+  builder.close();
+  builder.close();
+
+  std::ofstream outfile(_jsonReportFile, std::ofstream::binary);
+  if (!outfile.is_open()) {
+    std::cerr << "Could not open JSON Report File: " << _jsonReportFile
+              << std::endl;
+    return false;
+  }
+  outfile << builder.slice().toJson() << '\n';
+  outfile.close();
+  return !outfile.fail();
 }
 
 bool BenchFeature::writeJunitReport(BenchRunResult const& result) {
@@ -426,9 +508,18 @@ void BenchFeature::printResult(BenchRunResult const& result) {
             << ((double)_operations / result.time) << std::endl;
 
   std::cout << "Elapsed time since start: " << std::fixed << result.time << " s"
-            << std::endl
             << std::endl;
 
+  if (result.histogram.count() > 0) {
+    std::cout << "Request latency (ms): p50 " << std::fixed << std::setprecision(3)
+              << result.histogram.percentile(50.0) * 1000.0 << ", p99 "
+              << result.histogram.percentile(99.0) * 1000.0 << ", p99.9 "
+              << result.histogram.percentile(99.9) * 1000.0 << ", max "
+              << result.histogram.max() * 1000.0 << std::setprecision(6)
+              << std::endl;
+  }
+  std::cout << std::endl;
+
   if (result.failures > 0) {
     LOG_TOPIC(WARN, arangodb::Logger::FIXME) << result.failures << " arangobench request(s) failed!";
   }
@@ -24,6 +24,7 @@
 #define ARANGODB_BENCHMARK_BENCH_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Benchmark/BenchmarkHistogram.h"
 
 namespace arangodb {
 
@@ -34,6 +35,7 @@ struct BenchRunResult {
   size_t failures;
   size_t incomplete;
   double requestTime;
+  arangobench::LatencyHistogram histogram;
 
   void update(double _time, size_t _failures, size_t _incomplete, double _requestTime) {
     time = _time;
@@ -68,12 +70,16 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t replicationFactor() const { return _replicationFactor; }
   uint64_t numberOfShards() const { return _numberOfShards; }
   bool waitForSync() const { return _waitForSync; }
+  double rate() const { return _rate; }
+  std::string const& workload() const { return _workload; }
+  uint64_t records() const { return _records; }
 
  private:
   void status(std::string const& value);
   bool report(ClientFeature*, std::vector<BenchRunResult>);
   void printResult(BenchRunResult const& result);
   bool writeJunitReport(BenchRunResult const& result);
+  bool writeJsonReport(BenchRunResult const& result);
 
   bool _async;
   uint64_t _concurreny;
@@ -92,6 +98,10 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t _replicationFactor;
   uint64_t _numberOfShards;
   bool _waitForSync;
+  double _rate;
+  std::string _jsonReportFile;
+  std::string _workload;
+  uint64_t _records;
 
   int* _result;
 
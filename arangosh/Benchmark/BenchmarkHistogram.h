@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BENCHMARK_BENCHMARK_HISTOGRAM_H
+#define ARANGODB_BENCHMARK_BENCHMARK_HISTOGRAM_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace arangobench {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief latency histogram with microsecond resolution and a relative
+/// error of at most 1/32 (about 3%) for each recorded value.
+///
+/// values below 64us get a bucket each, larger values are recorded in 32
+/// linear sub-buckets per power of two. a histogram is owned by a single
+/// thread and merged with the others after a run
+////////////////////////////////////////////////////////////////////////////////
+
+class LatencyHistogram {
+  static constexpr int SubBucketBits = 5;
+  static constexpr uint64_t SubBuckets = uint64_t(1) << SubBucketBits;
+  static constexpr uint64_t LinearLimit = 2 * SubBuckets;
+  static constexpr int MaxExponent = 40;
+  static constexpr size_t NumBuckets =
+      LinearLimit + (MaxExponent - SubBucketBits) * SubBuckets;
+
+ public:
+  LatencyHistogram() : _buckets(NumBuckets, 0), _count(0), _sum(0), _max(0) {}
+
+  /// @brief record a latency, given in seconds
+  void add(double seconds) {
+    uint64_t value = (seconds <= 0.0) ? 0 : static_cast<uint64_t>(seconds * 1000000.0);
+    ++_buckets[bucket(value)];
+    ++_count;
+    _sum += value;
+    if (value > _max) {
+      _max = value;
+    }
+  }
+
+  /// @brief add all values recorded by another histogram
+  void merge(LatencyHistogram const& other) {
+    for (size_t i = 0; i < NumBuckets; ++i) {
+      _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    if (other._max > _max) {
+      _max = other._max;
+    }
+  }
+
+  uint64_t count() const { return _count; }
+
+  /// @brief mean latency in seconds
+  double mean() const {
+    return _count == 0 ? 0.0 : static_cast<double>(_sum) / _count / 1000000.0;
+  }
+
+  /// @brief maximum latency in seconds
+  double max() const { return static_cast<double>(_max) / 1000000.0; }
+
+  /// @brief latency in seconds below which the given percentage (0 - 100)
+  /// of all recorded values falls
+  double percentile(double p) const {
+    if (_count == 0) {
+      return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(_count) + 0.5);
+    if (rank < 1) {
+      rank = 1;
+    } else if (rank > _count) {
+      rank = _count;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NumBuckets; ++i) {
+      seen += _buckets[i];
+      if (seen >= rank) {
+        uint64_t value = (std::min)(upperBound(i), _max);
+        return static_cast<double>(value) / 1000000.0;
+      }
+    }
+    return max();
+  }
+
+ private:
+  static size_t bucket(uint64_t value) {
+    if (value < LinearLimit) {
+      return static_cast<size_t>(value);
+    }
+    int exponent = 63 - __builtin_clzll(value);
+    if (exponent >= MaxExponent) {
+      return NumBuckets - 1;
+    }
+    uint64_t sub = (value >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+    return static_cast<size_t>(LinearLimit +
+                               (exponent - SubBucketBits - 1) * SubBuckets + sub);
+  }
+
+  static uint64_t upperBound(size_t index) {
+    if (index < LinearLimit) {
+      return index;
+    }
+    uint64_t const offset = index - LinearLimit;
+    int const exponent = static_cast<int>(offset / SubBuckets) + SubBucketBits + 1;
+    uint64_t const sub = offset % SubBuckets;
+    int const shift = exponent - SubBucketBits;
+    return ((SubBuckets + sub + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> _buckets;
+  uint64_t _count;
+  uint64_t _sum;
+  uint64_t _max;
+};
+}
+}
+
+#endif
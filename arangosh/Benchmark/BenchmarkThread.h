@@ -32,6 +32,7 @@
 #include "Basics/Thread.h"
 #include "Basics/hashes.h"
 #include "Benchmark/BenchmarkCounter.h"
+#include "Benchmark/BenchmarkHistogram.h"
 #include "Benchmark/BenchmarkOperation.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpResponse.h"
@@ -50,7 +51,7 @@ class BenchmarkThread : public arangodb::Thread {
                   int threadNumber, const unsigned long batchSize,
                   BenchmarkCounter<unsigned long>* operationsCounter,
                   ClientFeature* client, bool keepAlive, bool async,
-                  bool verbose)
+                  bool verbose, double rate = 0.0)
       : Thread("BenchmarkThread"),
         _operation(operation),
         _startCondition(condition),
@@ -70,7 +71,9 @@ class BenchmarkThread : public arangodb::Thread {
         _offset(0),
         _counter(0),
         _time(0.0),
-        _verbose(verbose) {
+        _verbose(verbose),
+        _interval(rate > 0.0 ? 1.0 / rate : 0.0),
+        _nextStart(0.0) {
     _errorHeader =
         basics::StringUtils::tolower(StaticStrings::Errors);
   }
@@ -131,6 +134,8 @@ class BenchmarkThread : public arangodb::Thread {
       guard.wait();
     }
 
+    _nextStart = TRI_microtime();
+
     while (!isStopping()) {
       unsigned long numOps = _operationsCounter->next(_batchSize);
 
@@ -165,6 +170,27 @@ class BenchmarkThread : public arangodb::Thread {
   }
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief in open-loop mode, wait until the next request is due and
+  /// return its scheduled start time. latencies are measured from that
+  /// time, so that a slow response also accounts for the requests it
+  /// delayed. in closed-loop mode, this just returns the current time
+  //////////////////////////////////////////////////////////////////////////////
+
+  double waitForSchedule(unsigned long numOperations) {
+    if (_interval <= 0.0) {
+      return TRI_microtime();
+    }
+    double const scheduled = _nextStart;
+    _nextStart += _interval * numOperations;
+    double const now = TRI_microtime();
+    if (scheduled > now) {
+      std::this_thread::sleep_for(std::chrono::microseconds(
+          static_cast<int64_t>((scheduled - now) * 1000000.0)));
+    }
+    return scheduled;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief request location rewriter (injects database name)
   //////////////////////////////////////////////////////////////////////////////
@@ -251,11 +277,14 @@ class BenchmarkThread : public arangodb::Thread {
     _headers[StaticStrings::ContentTypeHeader] =
         StaticStrings::MultiPartContentType + "; boundary=" + boundary;
 
-    double start = TRI_microtime();
+    double start = waitForSchedule(numOperations);
+    double requestStart = TRI_microtime();
     httpclient::SimpleHttpResult* result = _httpClient->request(
         rest::RequestType::POST, "/_api/batch", batchPayload.c_str(),
         batchPayload.length(), _headers);
-    _time += TRI_microtime() - start;
+    double end = TRI_microtime();
+    _time += end - requestStart;
+    _histogram.add(end - start);
 
     if (result == nullptr || !result->isComplete()) {
       if (result != nullptr) {
@@ -333,10 +362,13 @@ class BenchmarkThread : public arangodb::Thread {
     char const* payload = _operation->payload(
         &payloadLength, _threadNumber, threadCounter, globalCounter, &mustFree);
 
-    double start = TRI_microtime();
+    double start = waitForSchedule(1);
+    double requestStart = TRI_microtime();
     httpclient::SimpleHttpResult* result =
         _httpClient->request(type, url, payload, payloadLength, _headers);
-    _time += TRI_microtime() - start;
+    double end = TRI_microtime();
+    _time += end - requestStart;
+    _histogram.add(end - start);
 
     if (mustFree) {
       TRI_Free((void*)payload);
@@ -382,6 +414,12 @@ class BenchmarkThread : public arangodb::Thread {
 
   double getTime() const { return _time; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the latencies recorded by the thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  LatencyHistogram const& histogram() const { return _histogram; }
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the operation to benchmark
@@ -508,6 +546,24 @@ class BenchmarkThread : public arangodb::Thread {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _verbose;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief time between two requests in open-loop mode, 0 = closed loop
+  //////////////////////////////////////////////////////////////////////////////
+
+  double const _interval;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief scheduled start time of the next request in open-loop mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  double _nextStart;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief request latencies
+  //////////////////////////////////////////////////////////////////////////////
+
+  LatencyHistogram _histogram;
 };
 }
 }
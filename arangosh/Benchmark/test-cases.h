@@ -23,8 +23,12 @@
 
 #include "Basics/Common.h"
 
+#include "Basics/fasthash.h"
+#include "Basics/tri-strings.h"
 #include "Random/RandomGenerator.h"
 
+#include <cmath>
+
 static bool DeleteCollection(SimpleHttpClient*, std::string const&);
 
 static bool CreateCollection(SimpleHttpClient*, std::string const&, int const);
@@ -1555,6 +1559,230 @@ struct AqlV8Test : public BenchmarkOperation {
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief YCSB-style workload mixes on a preloaded collection. keys are
+/// chosen with a scrambled zipfian distribution (theta = 0.99), so that a
+/// few documents are hot without being adjacent. the operation of a request
+/// is derived from a hash of its global counter, because url(), type() and
+/// payload() are called separately for the same request
+////////////////////////////////////////////////////////////////////////////////
+
+struct YcsbTest : public BenchmarkOperation {
+  enum class Operation { Read, Update, Insert, Scan, ReadModifyWrite };
+
+  YcsbTest()
+      : BenchmarkOperation(),
+        _workload(ARANGOBENCH->workload()),
+        _records((std::max)(ARANGOBENCH->records(), uint64_t(1))) {
+    // precompute the constants of the zipfian generator (Gray et al.,
+    // "Quickly Generating Billion-Record Synthetic Databases")
+    _zetan = 0.0;
+    for (uint64_t i = 1; i <= _records; ++i) {
+      _zetan += 1.0 / std::pow(static_cast<double>(i), Theta);
+    }
+    double const zeta2 = 1.0 + 1.0 / std::pow(2.0, Theta);
+    _alpha = 1.0 / (1.0 - Theta);
+    _eta = (1.0 - std::pow(2.0 / static_cast<double>(_records), 1.0 - Theta)) /
+           (1.0 - zeta2 / _zetan);
+  }
+
+  bool setUp(SimpleHttpClient* client) override {
+    if (!DeleteCollection(client, ARANGOBENCH->collection()) ||
+        !CreateCollection(client, ARANGOBENCH->collection(), 2)) {
+      return false;
+    }
+
+    // load the initial records in chunks
+    std::unordered_map<std::string, std::string> headerFields;
+    std::string const url = "/_api/import?collection=" +
+                            ARANGOBENCH->collection() + "&type=documents";
+    std::string body;
+    for (uint64_t i = 0; i < _records; ++i) {
+      body.append("{\"_key\":\"");
+      body.append(key(i));
+      body.push_back('"');
+      appendFields(body, i);
+      body.append("}\n");
+
+      if ((i + 1) % 1000 == 0 || i + 1 == _records) {
+        std::unique_ptr<SimpleHttpResult> result(client->request(
+            rest::RequestType::POST, url, body.c_str(), body.size(), headerFields));
+        if (result == nullptr || result->wasHttpError()) {
+          return false;
+        }
+        body.clear();
+      }
+    }
+    return true;
+  }
+
+  void tearDown() override {}
+
+  std::string url(int const threadNumber, size_t const threadCounter,
+                  size_t const globalCounter) override {
+    switch (operation(globalCounter)) {
+      case Operation::Read:
+      case Operation::Update:
+        return "/_api/document/" + ARANGOBENCH->collection() + "/" +
+               key(chooseKey(globalCounter));
+      case Operation::Insert:
+        return "/_api/document?collection=" + ARANGOBENCH->collection();
+      case Operation::Scan:
+      case Operation::ReadModifyWrite:
+        return "/_api/cursor";
+    }
+    return "/_api/version";
+  }
+
+  rest::RequestType type(int const threadNumber, size_t const threadCounter,
+                         size_t const globalCounter) override {
+    switch (operation(globalCounter)) {
+      case Operation::Read:
+        return rest::RequestType::GET;
+      case Operation::Update:
+        return rest::RequestType::PATCH;
+      case Operation::Insert:
+      case Operation::Scan:
+      case Operation::ReadModifyWrite:
+        return rest::RequestType::POST;
+    }
+    return rest::RequestType::GET;
+  }
+
+  char const* payload(size_t* length, int const threadNumber,
+                      size_t const threadCounter, size_t const globalCounter,
+                      bool* mustFree) override {
+    std::string body;
+
+    switch (operation(globalCounter)) {
+      case Operation::Read:
+        *length = 0;
+        *mustFree = false;
+        return nullptr;
+      case Operation::Update:
+        body.append("{\"field0\":\"");
+        body.append(std::to_string(globalCounter));
+        body.append("\"}");
+        break;
+      case Operation::Insert:
+        // inserted keys do not overlap with the loaded records
+        body.append("{\"_key\":\"");
+        body.append(key(_records + globalCounter));
+        body.push_back('"');
+        appendFields(body, globalCounter);
+        body.push_back('}');
+        break;
+      case Operation::Scan:
+        body.append("{\"query\":\"FOR doc IN @@collection FILTER doc._key >= @key "
+                    "SORT doc._key LIMIT @limit RETURN doc\",\"bindVars\":{"
+                    "\"@collection\":\"");
+        body.append(ARANGOBENCH->collection());
+        body.append("\",\"key\":\"");
+        body.append(key(chooseKey(globalCounter)));
+        body.append("\",\"limit\":");
+        body.append(std::to_string(1 + hash(globalCounter, 2) % 100));
+        body.append("},\"batchSize\":100}");
+        break;
+      case Operation::ReadModifyWrite:
+        body.append("{\"query\":\"FOR doc IN @@collection FILTER doc._key == @key "
+                    "UPDATE doc WITH { field0: CONCAT(doc.field0, '-') } IN "
+                    "@@collection\",\"bindVars\":{\"@collection\":\"");
+        body.append(ARANGOBENCH->collection());
+        body.append("\",\"key\":\"");
+        body.append(key(chooseKey(globalCounter)));
+        body.append("\"}}");
+        break;
+    }
+
+    *length = body.size();
+    *mustFree = true;
+    return TRI_DuplicateString(body.c_str(), body.size());
+  }
+
+ private:
+  static constexpr double Theta = 0.99;
+
+  static uint64_t hash(size_t globalCounter, uint64_t seed) {
+    return fasthash64_uint64(static_cast<uint64_t>(globalCounter), 0xdeadbeef + seed);
+  }
+
+  /// @brief uniformly distributed value in [0, 1) for a request
+  static double uniform(size_t globalCounter, uint64_t seed) {
+    return static_cast<double>(hash(globalCounter, seed) >> 11) /
+           static_cast<double>(uint64_t(1) << 53);
+  }
+
+  /// @brief keys are zero-padded, so that their order matches the numbers
+  static std::string key(uint64_t id) {
+    std::string result = std::to_string(id);
+    if (result.size() < 12) {
+      result.insert(0, 12 - result.size(), '0');
+    }
+    return "user" + result;
+  }
+
+  static void appendFields(std::string& body, uint64_t id) {
+    uint64_t const n = (std::max)(ARANGOBENCH->complexity(), uint64_t(1));
+    for (uint64_t i = 0; i < n; ++i) {
+      body.append(",\"field");
+      body.append(std::to_string(i));
+      body.append("\":\"");
+      body.append(std::to_string(fasthash64_uint64(id, i)));
+      body.push_back('"');
+    }
+  }
+
+  Operation operation(size_t globalCounter) const {
+    double const u = uniform(globalCounter, 0);
+    switch (_workload[0]) {
+      case 'a':
+        return u < 0.5 ? Operation::Read : Operation::Update;
+      case 'b':
+        return u < 0.95 ? Operation::Read : Operation::Update;
+      case 'c':
+        return Operation::Read;
+      case 'd':
+        return u < 0.95 ? Operation::Read : Operation::Insert;
+      case 'e':
+        return u < 0.95 ? Operation::Scan : Operation::Insert;
+      case 'f':
+        return u < 0.5 ? Operation::Read : Operation::ReadModifyWrite;
+    }
+    return Operation::Read;
+  }
+
+  /// @brief zipfian rank in [0, _records), 0 being the most popular
+  uint64_t zipfian(size_t globalCounter) const {
+    double const u = uniform(globalCounter, 1);
+    double const uz = u * _zetan;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, Theta)) {
+      return 1;
+    }
+    uint64_t rank = static_cast<uint64_t>(
+        static_cast<double>(_records) * std::pow(_eta * u - _eta + 1.0, _alpha));
+    return (std::min)(rank, _records - 1);
+  }
+
+  uint64_t chooseKey(size_t globalCounter) const {
+    uint64_t const rank = zipfian(globalCounter);
+    if (_workload[0] == 'd') {
+      // read latest: the most popular keys are the most recently loaded
+      return _records - 1 - rank;
+    }
+    // scramble, so that popular keys are spread over the key space
+    return fasthash64_uint64(rank, 0xcafe) % _records;
+  }
+
+  std::string const _workload;
+  uint64_t const _records;
+  double _zetan;
+  double _alpha;
+  double _eta;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief delete a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -1741,6 +1969,9 @@ static BenchmarkOperation* GetTestCase(std::string const& name) {
   if (name == "stream-cursor") {
     return new StreamCursorTest();
   }
+  if (name == "ycsb") {
+    return new YcsbTest();
+  }
 
   return nullptr;
 }
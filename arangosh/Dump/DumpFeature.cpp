@@ -246,7 +246,14 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
     // we are in single-server mode, we already flushed the wal
     baseUrl += "&flush=false";
   }
+  if (jobData.numStreams > 1) {
+    // dump one key range of the collection, the other ranges are dumped
+    // concurrently from the same snapshot
+    baseUrl += "&streams=" + itoa(jobData.numStreams) +
+               "&stream=" + itoa(jobData.stream);
+  }
 
+  bool first = true;
   while (true) {
     std::string url =
         baseUrl + "&from=" + itoa(fromTick) + "&chunkSize=" + itoa(chunkSize);
@@ -264,6 +271,22 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
       return check;
     }
 
+    if (first && jobData.stream == 0 && jobData.numStreams > 1) {
+      // servers which cannot split a dump ignore the streams and send the
+      // whole collection in the first one. only dump the other streams
+      // once the server has confirmed the split
+      bool found = false;
+      std::string const streams = response->getHeaderField(
+          arangodb::StaticStrings::ReplicationHeaderStreams, found);
+      if (found) {
+        check = jobData.feature.queueStreams(jobData, uint64(streams));
+        if (check.fail()) {
+          return check;
+        }
+      }
+    }
+    first = false;
+
     // find out whether there are more results to fetch
     bool checkMore = false;
 
@@ -396,6 +419,19 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& client,
   std::string const hexString(
       arangodb::rest::SslInterface::sslMD5(jobData.name));
 
+  if (jobData.stream > 0) {
+    // a further stream of a split collection, the first stream has saved
+    // the meta data
+    auto file = jobData.directory.writableFile(
+        jobData.name + "_" + hexString + "." +
+            arangodb::basics::StringUtils::itoa(jobData.stream) + ".data.json",
+        true);
+    if (!::fileOk(file.get())) {
+      return ::fileError(file.get(), true);
+    }
+    return ::handleCollection(client, jobData, *file);
+  }
+
   // found a collection!
   if (jobData.options.progress) {
     LOG_TOPIC(INFO, arangodb::Logger::DUMP)
@@ -523,6 +559,11 @@ void DumpFeature::collectOptions(
                      "maximum number of collections to process in parallel",
                      new UInt32Parameter(&_options.threadCount));
 
+  options->addOption("--streams-per-collection",
+                     "number of key ranges to split the data of a large "
+                     "collection into, which are dumped in parallel",
+                     new UInt32Parameter(&_options.streamsPerCollection));
+
   options->addOption("--dump-data", "dump collection data",
                      new BooleanParameter(&_options.dumpData));
 
@@ -597,6 +638,14 @@ void DumpFeature::validateOptions(
     LOG_TOPIC(WARN, Logger::FIXME) << "capping --threads value to " << clamped;
     _options.threadCount = clamped;
   }
+
+  clamped = boost::algorithm::clamp(_options.streamsPerCollection, 1,
+                                    _options.threadCount);
+  if (_options.streamsPerCollection != clamped) {
+    LOG_TOPIC(WARN, Logger::FIXME)
+        << "capping --streams-per-collection value to " << clamped;
+    _options.streamsPerCollection = clamped;
+  }
 }
 
 // dump data from server
@@ -716,6 +765,7 @@ Result DumpFeature::runDump(httpclient::SimpleHttpClient& client,
     auto jobData = std::make_unique<JobData>(
         *_directory, *this, _options, _stats, collection, batchId,
         std::to_string(cid), name, collectionType);
+    jobData->numStreams = _options.streamsPerCollection;
     _clientTaskQueue.queueJob(std::move(jobData));
   }
 
@@ -942,6 +992,23 @@ Result DumpFeature::storeViews(VPackSlice const& views) const {
   return {};
 }
 
+Result DumpFeature::queueStreams(JobData const& jobData, uint64_t numStreams) {
+  TRI_ASSERT(jobData.stream == 0);
+  for (uint64_t stream = 1; stream < numStreams; ++stream) {
+    auto streamJob = std::make_unique<JobData>(
+        jobData.directory, *this, jobData.options, jobData.stats,
+        jobData.collectionInfo, jobData.batchId, jobData.cid, jobData.name,
+        jobData.type);
+    streamJob->stream = stream;
+    streamJob->numStreams = jobData.numStreams;
+    if (!_clientTaskQueue.queueJob(std::move(streamJob))) {
+      return {TRI_ERROR_OUT_OF_MEMORY, "cannot queue dump of collection '" +
+                                           jobData.name + "'"};
+    }
+  }
+  return {TRI_ERROR_NO_ERROR};
+}
+
 void DumpFeature::reportError(Result const& error) {
   try {
     MUTEX_LOCKER(lock, _workerErrorLock);
@@ -67,6 +67,7 @@ class DumpFeature : public application_features::ApplicationFeature {
     uint64_t initialChunkSize{1024 * 1024 * 8};
     uint64_t maxChunkSize{1024 * 1024 * 64};
     uint32_t threadCount{2};
+    uint32_t streamsPerCollection{1};
     uint64_t tickStart{0};
     uint64_t tickEnd{0};
     bool clusterMode{false};
@@ -101,8 +102,21 @@ class DumpFeature : public application_features::ApplicationFeature {
     std::string const cid;
     std::string const name;
     std::string const type;
+
+    /// @brief stream of a collection dump split into key ranges, and the
+    /// number of streams requested from the server
+    uint64_t stream{0};
+    uint64_t numStreams{1};
   };
 
+  /**
+   * @brief Queues jobs for the further streams of a split collection dump
+   * @param jobData    Job which dumps the first stream of the collection
+   * @param numStreams Number of streams which contain documents
+   * @return           Error if a job could not be queued
+   */
+  Result queueStreams(JobData const& jobData, uint64_t numStreams);
+
  private:
   ClientManager _clientManager;
   ClientTaskQueue<JobData> _clientTaskQueue;
@@ -34,8 +34,9 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/detail/xml_parser_utils.hpp>
-#include <regex>
+#include <future>
 #include <iostream>
+#include <regex>
 
 using namespace arangodb::basics;
 using namespace arangodb::httpclient;
@@ -321,9 +322,22 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
 
     VPackBuilder post;
     post.openObject();
-    post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+    if (_typeExport == "csv") {
+      // only transfer the attributes which are exported
+      post.add("query",
+               VPackValue("FOR doc IN @@collection RETURN KEEP(doc, @fields)"));
+    } else {
+      post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+    }
     post.add("bindVars", VPackValue(VPackValueType::Object));
     post.add("@collection", VPackValue(collection));
+    if (_typeExport == "csv") {
+      post.add("fields", VPackValue(VPackValueType::Array));
+      for (auto const& field : _csvFields) {
+        post.add(VPackValue(field));
+      }
+      post.close();
+    }
     post.close();
     post.add("options", VPackValue(VPackValueType::Object));
     post.add("stream", VPackSlice::trueSlice());
@@ -332,7 +346,6 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
 
     std::shared_ptr<VPackBuilder> parsedBody =
         httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-    VPackSlice body = parsedBody->slice();
 
     int fd =
         TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
@@ -347,15 +360,9 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
 
     writeFirstLine(fd, fileName, collection);
 
-    writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
-
-    while (body.hasKey("id")) {
-      std::string const url = "/_api/cursor/" + body.get("id").copyString();
-      parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-      body = parsedBody->slice();
-
-      writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
-    }
+    writeCursor(httpClient, parsedBody, [&](VPackArrayIterator it) {
+      writeBatch(fd, it, fileName);
+    });
 
     if (_typeExport == "json") {
       std::string closingBracket = "\n]";
@@ -393,7 +400,6 @@ void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
 
   std::shared_ptr<VPackBuilder> parsedBody =
       httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-  VPackSlice body = parsedBody->slice();
 
   int fd =
       TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
@@ -408,15 +414,9 @@ void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
 
   writeFirstLine(fd, fileName, "");
 
-  writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
-
-  while (body.hasKey("id")) {
-    std::string const url = "/_api/cursor/" + body.get("id").copyString();
-    parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-    body = parsedBody->slice();
-
-    writeBatch(fd, VPackArrayIterator(body.get("result")), fileName);
-  }
+  writeCursor(httpClient, parsedBody, [&](VPackArrayIterator it) {
+    writeBatch(fd, it, fileName);
+  });
 
   if (_typeExport == "json") {
     std::string closingBracket = "\n]";
@@ -537,6 +537,30 @@ void ExportFeature::writeBatch(int fd, VPackArrayIterator it, std::string const&
   }
 }
 
+void ExportFeature::writeCursor(
+    SimpleHttpClient* httpClient, std::shared_ptr<VPackBuilder> parsedBody,
+    std::function<void(VPackArrayIterator)> const& writer) {
+  while (true) {
+    VPackSlice body = parsedBody->slice();
+
+    // fetch the next batch while the current one is written
+    std::future<std::shared_ptr<VPackBuilder>> next;
+    if (body.hasKey("id")) {
+      std::string const url = "/_api/cursor/" + body.get("id").copyString();
+      next = std::async(std::launch::async, [this, httpClient, url]() {
+        return httpCall(httpClient, url, rest::RequestType::PUT);
+      });
+    }
+
+    writer(VPackArrayIterator(body.get("result")));
+
+    if (!next.valid()) {
+      return;
+    }
+    parsedBody = next.get();
+  }
+}
+
 void ExportFeature::writeToFile(int fd, std::string const& line,
                                 std::string const& fileName) {
   if (!TRI_WritePointer(fd, line.c_str(), line.size())) {
@@ -692,17 +716,10 @@ directed="1">
 
     std::shared_ptr<VPackBuilder> parsedBody =
         httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-    VPackSlice body = parsedBody->slice();
 
-    writeGraphBatch(fd, VPackArrayIterator(body.get("result")), fileName);
-
-    while (body.hasKey("id")) {
-      std::string const url = "/_api/cursor/" + body.get("id").copyString();
-      parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-      body = parsedBody->slice();
-
-      writeGraphBatch(fd, VPackArrayIterator(body.get("result")), fileName);
-    }
+    writeCursor(httpClient, parsedBody, [&](VPackArrayIterator it) {
+      writeGraphBatch(fd, it, fileName);
+    });
   }
   std::string closingGraphTag = "</graph>\n";
   writeToFile(fd, closingGraphTag, fileName);
@@ -59,6 +59,11 @@ class ExportFeature final : public application_features::ApplicationFeature,
   void writeGraphBatch(int fd, VPackArrayIterator it, std::string const& fileName);
   void xgmmlWriteOneAtt(int fd, std::string const& fileName, VPackSlice const& slice, std::string const& name, int deep = 0);
 
+  /// @brief write all batches of a cursor, starting with the response which
+  /// created it
+  void writeCursor(httpclient::SimpleHttpClient* httpClient,
+                   std::shared_ptr<VPackBuilder> parsedBody,
+                   std::function<void(VPackArrayIterator)> const& writer);
   void writeToFile(int fd, std::string const& string, std::string const& fileName);
   std::shared_ptr<VPackBuilder> httpCall(httpclient::SimpleHttpClient* httpClient, std::string const& url, arangodb::rest::RequestType, std::string postBody = "");
 
@@ -43,6 +43,10 @@ using namespace arangodb::import;
 //
 // The pace starts "slow", 1 megabyte per second.  Each recalculation of pace adds
 //  a 20% growth factor above the actual calculation from average bytes consumed.
+//  The server reports the fill grade of its queues with each import response.
+//  There is no growth while the queues are half full, and the pace shrinks once
+//  they are three quarters full.  Requests rejected by an overloaded server
+//  (HTTP 503) are retried by the sender threads and halve the pace.
 //
 // The pacing code also notices when threads are completing quickly.  It will release
 //  a new thread early in such cases to again encourage rate growth.
@@ -91,8 +95,19 @@ void AutoTuneThread::run() {
         new_max = (current_max + ten_second_actual / 10) / 2;
       }
 
-      // grow number slowly if possible (20%)
-      new_max += new_max/5;
+      // react to the load the server reports
+      uint64_t rejected = _importHelper.rotateRejectedCount();
+      double fill_grade = _importHelper.getQueueFillGrade();
+      if (0 < rejected) {
+        // the server rejected requests, back off considerably
+        new_max = (std::min)(new_max, current_max / 2);
+      } else if (0.75 < fill_grade) {
+        // the queues of the server fill up, shrink
+        new_max -= new_max/4;
+      } else if (fill_grade < 0.5) {
+        // grow number slowly if possible (20%)
+        new_max += new_max/5;
+      }
 
       // make "per thread"
       new_max /= _importHelper.getThreadCount();
@@ -105,6 +120,8 @@ void AutoTuneThread::run() {
       LOG_TOPIC(DEBUG, arangodb::Logger::FIXME)
         << "Current: " << current_max
         << ", ten_sec: " << ten_second_actual
+        << ", rejected: " << rejected
+        << ", fill_grade: " << fill_grade
         << ", new_max: " << new_max;
 
       _importHelper.setMaxUploadSize(new_max);
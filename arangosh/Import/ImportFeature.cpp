@@ -61,6 +61,7 @@ ImportFeature::ImportFeature(
       _createCollectionType("document"),
       _typeImport("json"),
       _overwrite(false),
+      _bulkLoad(false),
       _quote("\""),
       _separator(""),
       _progress(true),
@@ -157,6 +158,12 @@ void ImportFeature::collectOptions(
       "from the collection)",
       new BooleanParameter(&_overwrite));
 
+  options->addOption(
+      "--bulk-load",
+      "let the server lock the collection exclusively and ingest each batch "
+      "as SST files (RocksDB engine only, bypasses the WAL)",
+      new BooleanParameter(&_bulkLoad));
+
   options->addOption("--quote", "quote character(s), used for csv",
                      new StringParameter(&_quote));
 
@@ -401,6 +408,7 @@ void ImportFeature::start() {
   ih.setConversion(_convert);
   ih.setRowsToSkip(static_cast<size_t>(_rowsToSkip));
   ih.setOverwrite(_overwrite);
+  ih.setBulkLoad(_bulkLoad);
   ih.useBackslash(_useBackslash);
   ih.ignoreMissing(_ignoreMissing);
 
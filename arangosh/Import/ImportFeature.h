@@ -66,6 +66,7 @@ class ImportFeature final : public application_features::ApplicationFeature,
   std::vector<std::string> _translations;
   std::vector<std::string> _removeAttributes;
   bool _overwrite;
+  bool _bulkLoad;
   std::string _quote;
   std::string _separator;
   bool _progress;
@@ -163,6 +163,7 @@ ImportHelper::ImportHelper(ClientFeature const* client,
       _convert(true),
       _createCollection(false),
       _overwrite(false),
+      _bulkLoad(false),
       _progress(false),
       _firstChunk(true),
       _ignoreMissing(false),
@@ -860,6 +861,9 @@ void ImportHelper::sendCsvBuffer() {
   if (!_toCollectionPrefix.empty()) {
     url += "&toPrefix=" + StringUtils::urlEncode(_toCollectionPrefix);
   }
+  if (_bulkLoad) {
+    url += "&bulkLoad=true";
+  }
   if (_firstChunk && _overwrite) {
     // url += "&overwrite=true";
     truncateCollection();
@@ -898,6 +902,9 @@ void ImportHelper::sendJsonBuffer(char const* str, size_t len, bool isObject) {
   if (!_toCollectionPrefix.empty()) {
     url += "&toPrefix=" + StringUtils::urlEncode(_toCollectionPrefix);
   }
+  if (_bulkLoad) {
+    url += "&bulkLoad=true";
+  }
   if (_firstChunk && _overwrite) {
     // url += "&overwrite=true";
     truncateCollection();
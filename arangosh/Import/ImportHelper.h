@@ -65,6 +65,11 @@ struct ImportStatistics {
 
   arangodb::Mutex _mutex;
   QuickHistogram _histogram;
+
+  /// @brief requests which the server rejected because it was overloaded
+  std::atomic<uint64_t> _numberRejected{0};
+  /// @brief last fill grade of the server's queues, in per mille
+  std::atomic<uint64_t> _queueFillGrade{0};
 };
 
 class ImportHelper {
@@ -175,6 +180,12 @@ class ImportHelper {
 
   void setOverwrite(bool value) { _overwrite = value; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the server should ingest the data in bulk
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setBulkLoad(bool value) { _bulkLoad = value; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set the number of rows to skip
   //////////////////////////////////////////////////////////////////////////////
@@ -262,6 +273,8 @@ class ImportHelper {
   void addPeriodByteCount(uint64_t add) {_periodByteCount.fetch_add(add);}
 
   uint32_t getThreadCount() const {return _threadCount;}
+  uint64_t rotateRejectedCount() {return _stats._numberRejected.exchange(0);}
+  double getQueueFillGrade() const {return _stats._queueFillGrade.load() / 1000.0;}
 
   static unsigned const MaxBatchSize;
 
@@ -307,6 +320,7 @@ class ImportHelper {
   bool _convert;
   bool _createCollection;
   bool _overwrite;
+  bool _bulkLoad;
   bool _progress;
   bool _firstChunk;
   bool _ignoreMissing;
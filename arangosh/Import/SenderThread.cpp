@@ -25,6 +25,7 @@
 #include "Basics/Common.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
@@ -114,13 +115,26 @@ void SenderThread::run() {
       if (_data.length() > 0) {
         TRI_ASSERT(!_idle && !_url.empty());
 
-        {
-          QuickHistogramTimer timer(_stats->_histogram);
-          std::unique_ptr<httpclient::SimpleHttpResult> result(
-            _client->request(rest::RequestType::POST, _url, _data.c_str(),
-                             _data.length()));
+        while (true) {
+          std::unique_ptr<httpclient::SimpleHttpResult> result;
+          {
+            QuickHistogramTimer timer(_stats->_histogram);
+            result.reset(_client->request(rest::RequestType::POST, _url,
+                                          _data.c_str(), _data.length()));
+          }
+
+          if (result != nullptr && result->isComplete() &&
+              result->getHttpReturnCode() ==
+                  static_cast<int>(rest::ResponseCode::SERVICE_UNAVAILABLE) &&
+              !isStopping()) {
+            // the server is overloaded, send the same data again later
+            ++_stats->_numberRejected;
+            waitForRetry(result.get());
+            continue;
+          }
 
           handleResult(result.get());
+          break;
         }
 
         _url.clear();
@@ -142,11 +156,35 @@ void SenderThread::run() {
   TRI_ASSERT(_idle);
 }
 
+void SenderThread::waitForRetry(httpclient::SimpleHttpResult* result) {
+  bool found = false;
+  std::string const& retryAfter =
+      result->getHeaderField(StaticStrings::RetryAfter, found);
+  uint64_t seconds = found ? basics::StringUtils::uint64(retryAfter) : 1;
+  seconds = std::max<uint64_t>(1, std::min<uint64_t>(seconds, 60));
+
+  LOG_TOPIC(DEBUG, arangodb::Logger::FIXME)
+      << "server is overloaded, retrying import batch in " << seconds << " s";
+
+  CONDITION_LOCKER(guard, _condition);
+  if (!isStopping()) {
+    guard.wait(std::chrono::seconds(seconds));
+  }
+}
+
 void SenderThread::handleResult(httpclient::SimpleHttpResult* result) {
   if (result == nullptr) {
     return;
   }
 
+  bool found = false;
+  std::string const& fillGrade =
+      result->getHeaderField(StaticStrings::QueueFillGrade, found);
+  if (found) {
+    _stats->_queueFillGrade.store(static_cast<uint64_t>(
+        basics::StringUtils::doubleDecimal(fillGrade) * 1000.0));
+  }
+
   std::shared_ptr<VPackBuilder> parsedBody;
   try {
     parsedBody = result->getBodyVelocyPack();
@@ -85,6 +85,8 @@ class SenderThread final : public arangodb::Thread {
   ImportStatistics* _stats;
   std::string _errorMessage;
   void handleResult(httpclient::SimpleHttpResult* result);
+  /// @brief wait as long as an overloaded server asked for
+  void waitForRetry(httpclient::SimpleHttpResult* result);
 };
 }
 }
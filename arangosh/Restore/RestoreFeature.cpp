@@ -32,6 +32,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/Result.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
@@ -326,7 +327,8 @@ arangodb::Result sendRestoreData(
 
   std::string const url =
       "/_api/replication/restore-data?collection=" + urlEncode(cname) +
-      "&force=" + (options.force ? "true" : "false");
+      "&force=" + (options.force ? "true" : "false") +
+      "&bulkLoad=" + (options.bulkLoad ? "true" : "false");
 
   std::unique_ptr<SimpleHttpResult> response(httpClient.request(
       arangodb::rest::RequestType::PUT, url, buffer, bufferSize));
@@ -399,14 +401,126 @@ arangodb::Result restoreIndexes(
   return result;
 }
 
-/// @brief Restore the data for a given collection
+/// @brief reads the data files of a collection in chunks of about the
+/// batch size. chunks end at line boundaries, so that several threads can
+/// send them to the server concurrently
+class DataChunkReader {
+ public:
+  DataChunkReader(
+      std::vector<std::unique_ptr<arangodb::ManagedDirectory::File>>&& files,
+      arangodb::RestoreFeature::JobData& jobData, std::string const& cname,
+      std::string const& collectionType)
+      : _files(std::move(files)),
+        _jobData(jobData),
+        _cname(cname),
+        _collectionType(collectionType),
+        _buffer(true),
+        _current(0),
+        _totalSize(0),
+        _numRead(0),
+        _numReadSinceLastReport(0) {
+    for (auto const& file : _files) {
+      _totalSize += TRI_SizeFile(file->path().c_str());
+    }
+  }
+
+  int64_t totalSize() const { return _totalSize; }
+
+  /// @brief the next chunk of data, empty if all files are read
+  arangodb::Result next(std::string& chunk) {
+    chunk.clear();
+
+    MUTEX_LOCKER(locker, _lock);
+    while (_current < _files.size()) {
+      arangodb::ManagedDirectory::File& file = *_files[_current];
+      bool eof = false;
+      char const* found = nullptr;
+      while (true) {
+        if (_buffer.length() >= _jobData.options.chunkSize) {
+          found = static_cast<char const*>(
+              memrchr(_buffer.begin(), '\n', _buffer.length()));
+          if (found != nullptr) {
+            break;
+          }
+          // don't have a complete line yet, read more
+        }
+        if (_buffer.reserve(16384) != TRI_ERROR_NO_ERROR) {
+          return {TRI_ERROR_OUT_OF_MEMORY, "out of memory"};
+        }
+        ssize_t numRead = file.read(_buffer.end(), 16384);
+        if (file.status().fail()) {  // error while reading
+          return file.status();
+        }
+        if (numRead == 0) {
+          eof = true;
+          break;
+        }
+        _buffer.increaseLength(numRead);
+        _jobData.stats.totalRead += static_cast<uint64_t>(numRead);
+        _numRead += numRead;
+        _numReadSinceLastReport += numRead;
+      }
+
+      // send the complete rest of a file
+      size_t const length =
+          eof ? _buffer.length() : static_cast<size_t>(found - _buffer.begin());
+      if (eof) {
+        ++_current;
+      }
+      bool const blank =
+          std::all_of(_buffer.begin(), _buffer.begin() + length, [](char c) {
+            return isspace(static_cast<unsigned char>(c)) != 0;
+          });
+      if (!blank) {
+        chunk.assign(_buffer.begin(), length);
+      }
+      _buffer.erase_front(length);
+
+      if (_jobData.options.progress && _totalSize > 0 &&
+          _numReadSinceLastReport > 1024 * 1024 * 8) {
+        // report every 8MB of transferred data
+        LOG_TOPIC(INFO, arangodb::Logger::RESTORE)
+            << "# Still loading data into " << _collectionType
+            << " collection '" << _cname << "', " << _numRead << " of "
+            << _totalSize << " byte(s) restored ("
+            << int(100. * double(_numRead) / double(_totalSize)) << " %)";
+        _numReadSinceLastReport = 0;
+      }
+
+      if (!chunk.empty()) {
+        break;
+      }
+    }
+    return {TRI_ERROR_NO_ERROR};
+  }
+
+  /// @brief make all further calls of next return no data
+  void abort() {
+    MUTEX_LOCKER(locker, _lock);
+    _current = _files.size();
+  }
+
+ private:
+  std::vector<std::unique_ptr<arangodb::ManagedDirectory::File>> _files;
+  arangodb::RestoreFeature::JobData& _jobData;
+  std::string const _cname;
+  std::string const _collectionType;
+
+  arangodb::Mutex _lock;
+  arangodb::basics::StringBuffer _buffer;
+  size_t _current;
+  int64_t _totalSize;
+  int64_t _numRead;
+  int64_t _numReadSinceLastReport;
+};
+
+/// @brief Restore the data for a given collection. the data of a large
+/// collection can be split into several files by arangodump. the data is
+/// sent in batches over up to --threads-per-collection connections, and
+/// over one connection per file
 arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
                              arangodb::RestoreFeature::JobData& jobData) {
   using arangodb::Logger;
-  using arangodb::basics::StringBuffer;
-
-  arangodb::Result result;
-  StringBuffer buffer(true);
 
   VPackSlice const parameters = jobData.collection.get("parameters");
   std::string const cname = arangodb::basics::VelocyPackHelper::getStringValue(
@@ -416,97 +530,96 @@ arangodb::Result restoreData(arangodb::httpclient::SimpleHttpClient& httpClient,
   std::string const collectionType(type == 2 ? "document" : "edge");
 
   // import data. check if we have a datafile
-  auto datafile = jobData.directory.readableFile(
-      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname) + ".data.json");
-  if (!datafile || datafile->status().fail()) {
-    datafile = jobData.directory.readableFile(cname + ".data.json");
-    if (!datafile || datafile->status().fail()) {
-      result = {TRI_ERROR_CANNOT_READ_FILE, "could not open file"};
-      return result;
+  std::string const baseName =
+      cname + "_" + arangodb::rest::SslInterface::sslMD5(cname);
+  std::vector<std::unique_ptr<arangodb::ManagedDirectory::File>> datafiles;
+  datafiles.emplace_back(
+      jobData.directory.readableFile(baseName + ".data.json"));
+  if (!datafiles[0] || datafiles[0]->status().fail()) {
+    datafiles[0] = jobData.directory.readableFile(cname + ".data.json");
+    if (!datafiles[0] || datafiles[0]->status().fail()) {
+      return {TRI_ERROR_CANNOT_READ_FILE, "could not open file"};
+    }
+  } else {
+    // further key ranges of the collection
+    while (true) {
+      std::string const filename =
+          baseName + "." +
+          arangodb::basics::StringUtils::itoa(datafiles.size()) + ".data.json";
+      if (!TRI_ExistsFile(jobData.directory.pathToFile(filename).c_str())) {
+        break;
+      }
+      datafiles.emplace_back(jobData.directory.readableFile(filename));
+      if (!datafiles.back() || datafiles.back()->status().fail()) {
+        return {TRI_ERROR_CANNOT_READ_FILE, "could not open file"};
+      }
     }
   }
 
-  int64_t const fileSize =  TRI_SizeFile(datafile->path().c_str());
+  size_t const numThreads = std::max<size_t>(
+      jobData.options.threadsPerCollection,
+      std::min<size_t>(datafiles.size(), jobData.options.threadCount));
+  DataChunkReader reader(std::move(datafiles), jobData, cname, collectionType);
 
   if (jobData.options.progress) {
     LOG_TOPIC(INFO, Logger::RESTORE) << "# Loading data into " << collectionType
-                                     << " collection '" << cname << "', data size: " << fileSize << " byte(s)";
+                                     << " collection '" << cname << "', data size: " << reader.totalSize() << " byte(s)";
   }
 
-  int64_t numReadForThisCollection = 0;
-  int64_t numReadSinceLastReport = 0;
-
-  buffer.clear();
-  while (true) {
-    if (buffer.reserve(16384) != TRI_ERROR_NO_ERROR) {
-      result = {TRI_ERROR_OUT_OF_MEMORY, "out of memory"};
-      return result;
-    }
-
-    ssize_t numRead = datafile->read(buffer.end(), 16384);
-    if (datafile->status().fail()) {  // error while reading
-      result = datafile->status();
-      return result;
-    }
-    // we read something
-    buffer.increaseLength(numRead);
-    jobData.stats.totalRead += (uint64_t)numRead;
-    numReadForThisCollection += numRead;
-    numReadSinceLastReport += numRead;
-
-    if (buffer.length() < jobData.options.chunkSize && numRead > 0) {
-      continue;  // still continue reading
-    }
-
-    // do we have a buffer?
-    if (buffer.length() > 0) {
-      // look for the last \n in the buffer
-      char* found =
-          (char*)memrchr((const void*)buffer.begin(), '\n', buffer.length());
-      size_t length;
+  arangodb::Mutex resultLock;
+  arangodb::Result result;
 
-      if (found == nullptr) {  // no \n in buffer...
-        if (numRead == 0) {
-          // we're at the end of the file, so send the complete buffer anyway
-          length = buffer.length();
-        } else {
-          continue;  // don't have a complete line yet, read more
+  auto work = [&](arangodb::httpclient::SimpleHttpClient& client) {
+    std::string chunk;
+    while (true) {
+      arangodb::Result res;
+      try {
+        res = reader.next(chunk);
+        if (res.ok()) {
+          if (chunk.empty()) {
+            return;
+          }
+          jobData.stats.totalBatches++;
+          res = ::sendRestoreData(client, jobData.options, cname,
+                                  chunk.data(), chunk.size());
+          jobData.stats.totalSent += chunk.size();
+          if (res.fail() && jobData.options.force) {
+            LOG_TOPIC(ERR, Logger::RESTORE) << res.errorMessage();
+            continue;
+          }
         }
-      } else {
-        length = found - buffer.begin();  // found a \n somewhere; break at line
+      } catch (std::exception const& ex) {
+        res.reset(TRI_ERROR_INTERNAL, ex.what());
       }
-
-      jobData.stats.totalBatches++;
-      result = ::sendRestoreData(httpClient, jobData.options, cname,
-                                 buffer.begin(), length);
-      jobData.stats.totalSent += length;
-
-      if (result.fail()) {
-        if (jobData.options.force) {
-          LOG_TOPIC(ERR, Logger::RESTORE) << result.errorMessage();
-          result.reset();
-          continue;
+      if (res.fail()) {
+        MUTEX_LOCKER(locker, resultLock);
+        if (result.ok()) {
+          result = res;
         }
-        return result;
-      }
-
-      buffer.erase_front(length);
-
-      if (jobData.options.progress &&
-          fileSize > 0 &&
-          numReadSinceLastReport > 1024 * 1024 * 8) {
-        // report every 8MB of transferred data
-        LOG_TOPIC(INFO, Logger::RESTORE) << "# Still loading data into " << collectionType
-                                         << " collection '" << cname << "', "
-                                         << numReadForThisCollection << " of " << fileSize
-                                         << " byte(s) restored (" << int(100. * double(numReadForThisCollection) / double(fileSize)) << " %)";
-        numReadSinceLastReport = 0;
+        // let the other threads stop early
+        reader.abort();
+        return;
       }
     }
-
-    if (numRead == 0) {  // EOF
+  };
+
+  // every thread needs its own connection
+  arangodb::ClientManager clientManager{Logger::RESTORE};
+  std::vector<std::unique_ptr<arangodb::httpclient::SimpleHttpClient>> clients;
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < numThreads; ++t) {
+    std::unique_ptr<arangodb::httpclient::SimpleHttpClient> client;
+    if (clientManager.getConnectedClient(client, false, false, true).fail()) {
       break;
     }
+    clients.emplace_back(std::move(client));
+  }
+  for (auto& client : clients) {
+    threads.emplace_back(work, std::ref(*client));
+  }
+  work(httpClient);
+  for (auto& thread : threads) {
+    thread.join();
   }
 
   return result;
@@ -734,7 +847,8 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& httpClient,
                             arangodb::RestoreFeature::JobData& jobData) {
   arangodb::Result result;
   if (jobData.options.indexesFirst && jobData.options.importStructure) {
-    // restore indexes first if we are using rocksdb
+    // restore indexes first if we are using rocksdb, unless requested
+    // otherwise
     result = ::restoreIndexes(httpClient, jobData);
     if (result.fail()) {
       return result;
@@ -747,7 +861,7 @@ arangodb::Result processJob(arangodb::httpclient::SimpleHttpClient& httpClient,
     }
   }
   if (!jobData.options.indexesFirst && jobData.options.importStructure) {
-    // restore indexes second if we are using mmfiles
+    // restore indexes second if we are using mmfiles, or if requested
     result = ::restoreIndexes(httpClient, jobData);
     if (result.fail()) {
       return result;
@@ -829,6 +943,11 @@ void RestoreFeature::collectOptions(
                      "maximum number of collections to process in parallel",
                      new UInt32Parameter(&_options.threadCount));
 
+  options->addOption("--threads-per-collection",
+                     "maximum number of batches of a collection to send in "
+                     "parallel",
+                     new UInt32Parameter(&_options.threadsPerCollection));
+
   options->addOption("--include-system-collections",
                      "include system collections",
                      new BooleanParameter(&_options.includeSystemCollections));
@@ -873,6 +992,18 @@ void RestoreFeature::collectOptions(
   options->addOption(
       "--force", "continue restore even in the face of some server-side errors",
       new BooleanParameter(&_options.force));
+
+  options->addOption(
+      "--bulk-load",
+      "let the server lock each collection exclusively and ingest each batch "
+      "as SST files (RocksDB engine only, bypasses the WAL)",
+      new BooleanParameter(&_options.bulkLoad));
+
+  options->addOption(
+      "--indexes-after-data",
+      "create the indexes of a collection after its data is loaded, so that "
+      "the server builds them in bulk (default with the MMFiles engine)",
+      new BooleanParameter(&_options.indexesAfterData));
 }
 
 void RestoreFeature::validateOptions(
@@ -901,6 +1032,14 @@ void RestoreFeature::validateOptions(
     LOG_TOPIC(WARN, Logger::RESTORE) << "capping --threads value to " << clamped;
     _options.threadCount = clamped;
   }
+
+  clamped = boost::algorithm::clamp(_options.threadsPerCollection, uint32_t(1),
+                                    uint32_t(4 * TRI_numberProcessors()));
+  if (_options.threadsPerCollection != clamped) {
+    LOG_TOPIC(WARN, Logger::RESTORE)
+        << "capping --threads-per-collection value to " << clamped;
+    _options.threadsPerCollection = clamped;
+  }
 }
 
 void RestoreFeature::prepare() {
@@ -1009,6 +1148,9 @@ void RestoreFeature::start() {
     _exitCode = EXIT_FAILURE;
     return;
   }
+  if (_options.indexesAfterData) {
+    _options.indexesFirst = false;
+  }
 
   if (_options.progress) {
     LOG_TOPIC(INFO, Logger::RESTORE)
@@ -81,6 +81,8 @@ class RestoreFeature final : public application_features::ApplicationFeature {
     uint64_t defaultNumberOfShards{1};
     uint64_t defaultReplicationFactor{1};
     uint32_t threadCount{2};
+    uint32_t threadsPerCollection{1};
+    bool bulkLoad{false};
     bool clusterMode{false};
     bool createDatabase{false};
     bool force{false};
@@ -90,6 +92,7 @@ class RestoreFeature final : public application_features::ApplicationFeature {
     bool importStructure{true};
     bool includeSystemCollections{false};
     bool indexesFirst{false};
+    bool indexesAfterData{false};
     bool overwrite{true};
     bool progress{true};
   };
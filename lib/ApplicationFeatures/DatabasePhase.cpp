@@ -30,6 +30,7 @@ DatabaseFeaturePhase::DatabaseFeaturePhase(ApplicationServer& server)
   setOptional(false);
   startsAfter("BasicsPhase");
 
+  startsAfter("AggregateView");
   startsAfter("Authentication");
   startsAfter("CacheManager");
   startsAfter("CheckVersion");
@@ -66,13 +66,23 @@ RocksDBOptionFeature::RocksDBOptionFeature(
         ? static_cast<uint64_t>(((TRI_PhysicalMemory - (static_cast<uint64_t>(2) << 30)) * 0.3))
         : (256 << 20)),
       _blockCacheShardBits(-1),
+      _blockCacheHighPriorityRatio(0.1),
       _tableBlockSize(std::max(rocksDBTableOptionsDefaults.block_size, static_cast<decltype(rocksDBTableOptionsDefaults.block_size)>(16 * 1024))),
+      _bloomFilterBitsPerKey(10),
+      _documentsTableBlockSize(0),
+      _documentsNumUncompressedLevels(2),
+      _documentsCompactionTtl(0),
+      _documentsCompression("snappy"),
+      _documentsCompressionDictionarySize(0),
+      _documentsCompressionDictionaryTrainingSize(0),
       _recycleLogFileNum(rocksDBDefaults.recycle_log_file_num),
       _compactionReadaheadSize(2 * 1024 * 1024),//rocksDBDefaults.compaction_readahead_size
       _level0CompactionTrigger(2),
       _level0SlowdownTrigger(rocksDBDefaults.level0_slowdown_writes_trigger),
       _level0StopTrigger(rocksDBDefaults.level0_stop_writes_trigger),
       _blockAlignDataBlocks(rocksDBTableOptionsDefaults.block_align),
+      _cacheIndexAndFilterBlocks(false),
+      _partitionIndexAndFilters(false),
       _enablePipelinedWrite(rocksDBDefaults.enable_pipelined_write),
       _optimizeFiltersForHits(rocksDBDefaults.optimize_filters_for_hits),
       _useDirectReads(rocksDBDefaults.use_direct_reads),
@@ -252,10 +262,67 @@ void RocksDBOptionFeature::collectOptions(
                      "number of shard bits to use for block cache (use -1 for default value)",
                      new Int64Parameter(&_blockCacheShardBits));
 
+  options->addOption("--rocksdb.block-cache-high-priority-ratio",
+                     "fraction of the block cache reserved for index and filter "
+                     "blocks if --rocksdb.cache-index-and-filter-blocks is set",
+                     new DoubleParameter(&_blockCacheHighPriorityRatio));
+
+  options->addOption("--rocksdb.cache-index-and-filter-blocks",
+                     "if true, index and filter blocks are kept in the block cache "
+                     "instead of outside of it, so their memory is bounded by the cache size",
+                     new BooleanParameter(&_cacheIndexAndFilterBlocks));
+
+  options->addOption("--rocksdb.partition-index-and-filters",
+                     "if true, index and filter blocks are split into partitions. "
+                     "only the small top-level blocks are pinned in memory, the "
+                     "partitions are loaded on demand",
+                     new BooleanParameter(&_partitionIndexAndFilters));
+
   options->addOption("--rocksdb.table-block-size",
                      "approximate size (in bytes) of user data packed per block",
                      new UInt64Parameter(&_tableBlockSize));
 
+  options->addOption("--rocksdb.bloom-filter-bits-per-key",
+                     "number of bits per key used for the bloom filters (0 = no bloom filters)",
+                     new UInt64Parameter(&_bloomFilterBitsPerKey));
+
+  options->addOption("--rocksdb.documents-table-block-size",
+                     "approximate size (in bytes) of user data packed per block "
+                     "for the documents column family (0 = use --rocksdb.table-block-size)",
+                     new UInt64Parameter(&_documentsTableBlockSize));
+
+  options->addOption("--rocksdb.documents-num-uncompressed-levels",
+                     "number of uncompressed levels for the documents column family "
+                     "(defaults to --rocksdb.num-uncompressed-levels)",
+                     new UInt64Parameter(&_documentsNumUncompressedLevels));
+
+  options->addOption("--rocksdb.documents-compaction-ttl",
+                     "if non-zero, files of the documents column family that are older "
+                     "than this many seconds are compacted, so that removed documents "
+                     "free up their disk space eventually",
+                     new UInt64Parameter(&_documentsCompactionTtl));
+
+  options->addOption("--rocksdb.documents-compression",
+                     "compression algorithm for the compressed levels of the "
+                     "documents column family. falls back to snappy if the "
+                     "algorithm is not supported by this build",
+                     new DiscreteValuesParameter<StringParameter>(
+                         &_documentsCompression,
+                         std::unordered_set<std::string>{"snappy", "lz4", "zstd"}));
+
+  options->addOption("--rocksdb.documents-compression-dictionary-size",
+                     "maximum size (in bytes) of the compression dictionary "
+                     "sampled from the data of each file in the bottommost level "
+                     "of the documents column family. requires lz4 or zstd "
+                     "compression (0 = no dictionary)",
+                     new UInt64Parameter(&_documentsCompressionDictionarySize));
+
+  options->addOption("--rocksdb.documents-compression-dictionary-training-size",
+                     "if non-zero, this many bytes of sample data are used to "
+                     "train the compression dictionary of the documents column "
+                     "family with zstd, instead of using the raw samples",
+                     new UInt64Parameter(&_documentsCompressionDictionaryTrainingSize));
+
   options->addHiddenOption("--rocksdb.recycle-log-file-num",
                            "number of log files to keep around for recycling",
                            new UInt64Parameter(&_recycleLogFileNum));
@@ -320,6 +387,35 @@ void RocksDBOptionFeature::validateOptions(
   if (_maxSubcompactions > _numThreadsLow) {
     _maxSubcompactions = _numThreadsLow;
   }
+  if (_bloomFilterBitsPerKey > 64) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for '--rocksdb.bloom-filter-bits-per-key'";
+    FATAL_ERROR_EXIT();
+  }
+  if (!options->processingResult().touched("rocksdb.documents-num-uncompressed-levels")) {
+    _documentsNumUncompressedLevels = _numUncompressedLevels;
+  }
+  if (_documentsTableBlockSize == 0) {
+    _documentsTableBlockSize = _tableBlockSize;
+  }
+  if (_documentsCompressionDictionarySize > UINT32_MAX ||
+      (_documentsCompressionDictionarySize > 0 && _documentsCompression == "snappy")) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for '--rocksdb.documents-compression-dictionary-size'";
+    FATAL_ERROR_EXIT();
+  }
+  if (_documentsCompressionDictionaryTrainingSize > UINT32_MAX ||
+      (_documentsCompressionDictionaryTrainingSize > 0 &&
+       (_documentsCompression != "zstd" || _documentsCompressionDictionarySize == 0))) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for '--rocksdb.documents-compression-dictionary-training-size'";
+    FATAL_ERROR_EXIT();
+  }
+  if (_blockCacheHighPriorityRatio < 0.0 || _blockCacheHighPriorityRatio > 1.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for '--rocksdb.block-cache-high-priority-ratio'";
+    FATAL_ERROR_EXIT();
+  }
   if (_blockCacheShardBits >= 20 || _blockCacheShardBits < -1) {
     // -1 is RocksDB default value, but anything less is invalid
     LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
@@ -357,7 +453,17 @@ void RocksDBOptionFeature::start() {
                                     << ", num_threads_low: " << _numThreadsLow
                                     << ", block_cache_size: " << _blockCacheSize
                                     << ", block_cache_shard_bits: " << _blockCacheShardBits
+                                    << ", block_cache_high_priority_ratio: " << _blockCacheHighPriorityRatio
+                                    << ", cache_index_and_filter_blocks: " << _cacheIndexAndFilterBlocks
+                                    << ", partition_index_and_filters: " << _partitionIndexAndFilters
                                     << ", table_block_size: " << _tableBlockSize
+                                    << ", bloom_filter_bits_per_key: " << _bloomFilterBitsPerKey
+                                    << ", documents_table_block_size: " << _documentsTableBlockSize
+                                    << ", documents_num_uncompressed_levels: " << _documentsNumUncompressedLevels
+                                    << ", documents_compaction_ttl: " << _documentsCompactionTtl
+                                    << ", documents_compression: " << _documentsCompression
+                                    << ", documents_compression_dictionary_size: " << _documentsCompressionDictionarySize
+                                    << ", documents_compression_dictionary_training_size: " << _documentsCompressionDictionaryTrainingSize
                                     << ", recycle_log_file_num: " << _recycleLogFileNum
                                     << ", compaction_read_ahead_size: " << _compactionReadaheadSize
                                     << ", level0_compaction_trigger: " << _level0CompactionTrigger
@@ -66,13 +66,23 @@ class RocksDBOptionFeature final
   uint32_t _numThreadsLow;
   uint64_t _blockCacheSize;
   int64_t _blockCacheShardBits;
+  double _blockCacheHighPriorityRatio;
   uint64_t _tableBlockSize;
+  uint64_t _bloomFilterBitsPerKey;
+  uint64_t _documentsTableBlockSize;
+  uint64_t _documentsNumUncompressedLevels;
+  uint64_t _documentsCompactionTtl;
+  std::string _documentsCompression;
+  uint64_t _documentsCompressionDictionarySize;
+  uint64_t _documentsCompressionDictionaryTrainingSize;
   uint64_t _recycleLogFileNum;
   uint64_t _compactionReadaheadSize;
   int64_t _level0CompactionTrigger;
   int64_t _level0SlowdownTrigger;
   int64_t _level0StopTrigger;
   bool _blockAlignDataBlocks;
+  bool _cacheIndexAndFilterBlocks;
+  bool _partitionIndexAndFilters;
   bool _enablePipelinedWrite;
   bool _optimizeFiltersForHits;
   bool _useDirectReads;
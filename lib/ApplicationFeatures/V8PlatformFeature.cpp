@@ -74,6 +74,8 @@ static void gcEpilogueCallback(v8::Isolate* isolate, v8::GCType type,
   size_t heapSizeAtStop = h.used_heap_size();
   size_t heapSizeAtStart =
       V8PlatformFeature::getIsolateData(isolate)->_heapSizeAtStart;
+  V8PlatformFeature::getIsolateData(isolate)->_heapSize.store(
+      heapSizeAtStop, std::memory_order_relaxed);
 
   if (heapSizeAtStop < heapSizeAtStart) {
     freed = heapSizeAtStart - heapSizeAtStop;
@@ -229,3 +231,13 @@ void V8PlatformFeature::disposeIsolate(v8::Isolate* isolate) {
   // because Isolate::Dispose() will delete isolate!
   isolate->Dispose();
 }
+
+std::pair<size_t, size_t> V8PlatformFeature::heapUsage() {
+  size_t heapSize = 0;
+
+  MUTEX_LOCKER(guard, _lock);
+  for (auto const& it : _isolateData) {
+    heapSize += it.second->_heapSize.load(std::memory_order_relaxed);
+  }
+  return {_isolateData.size(), heapSize};
+}
@@ -37,6 +37,9 @@ class V8PlatformFeature final
   struct IsolateData {
     bool _outOfMemory = false;
     size_t _heapSizeAtStart = 0;
+    /// @brief used heap size after the last garbage collection, read by
+    /// other threads
+    std::atomic<size_t> _heapSize{0};
   };
 
  public:
@@ -74,6 +77,10 @@ class V8PlatformFeature final
   v8::Isolate* createIsolate();
   void disposeIsolate(v8::Isolate*);
 
+  /// @brief return the number of isolates and the sum of their used heap
+  /// sizes as of their last garbage collection
+  std::pair<size_t, size_t> heapUsage();
+
  private:
   std::unique_ptr<v8::Platform> _platform;
   std::unique_ptr<v8::ArrayBuffer::Allocator> _allocator;
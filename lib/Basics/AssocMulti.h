@@ -186,6 +186,18 @@ class AssocMulti {
     return res;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief get the part of the memory usage that uses huge pages
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t hugePageMemoryUsage() const {
+    size_t res = 0;
+    for (auto& b : _buckets) {
+      res += b.hugePageMemoryUsage();
+    }
+    return res;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief size(), return the number of items stored
   //////////////////////////////////////////////////////////////////////////////
@@ -63,8 +63,25 @@ class AssocUnique {
   typedef arangodb::basics::IndexBucket<Element, uint64_t, SIZE_MAX> Bucket;
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief state of an incremental resize of a bucket. the previous table
+  /// is kept next to the new one, and every insert moves a few of its slots
+  /// over. lookups consult both tables. elements in slots below position
+  /// have been moved, but are left in place to keep the probe sequences of
+  /// the remaining ones intact. the _nrUsed of the previous table counts
+  /// the elements not moved yet
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Migration {
+    Migration() : position(0) {}
+
+    Bucket table;
+    uint64_t position;
+  };
+
   AssocUniqueHelper _helper;
   std::vector<Bucket> _buckets;
+  std::vector<Migration> _migrations;
   size_t _bucketsMask;
 
   std::function<std::string()> _contextCallback;
@@ -89,6 +106,7 @@ class AssocUnique {
     _bucketsMask = nr - 1;
 
     _buckets.resize(numberBuckets);
+    _migrations.resize(numberBuckets);
 
     try {
       for (size_t j = 0; j < numberBuckets; j++) {
@@ -121,12 +139,215 @@ class AssocUnique {
  private:
   static uint64_t initialSize() { return 251; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief buckets of at least this size are resized incrementally
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t incrementalResizeSize() { return 65536; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of slots of the previous table moved per insert. a resize
+  /// starts at two thirds of the old size and doubles the table, so it is
+  /// done long before the new table fills up
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t migrationStep() { return 16; }
+
+  Migration& migration(Bucket const& b) {
+    return _migrations[static_cast<size_t>(&b - _buckets.data())];
+  }
+
+  Migration const& migration(Bucket const& b) const {
+    return _migrations[static_cast<size_t>(&b - _buckets.data())];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of elements in a bucket, including those not moved yet
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t usedSlots(size_t bucketId) const {
+    return _buckets[bucketId]._nrUsed + _migrations[bucketId].table._nrUsed;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of slots of a bucket for iterating. the slots of the
+  /// previous table of a running resize follow those of the new one
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t allocatedSlots(size_t bucketId) const {
+    return _buckets[bucketId]._nrAlloc + _migrations[bucketId].table._nrAlloc;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief element in an iteration slot. moved elements are skipped
+  //////////////////////////////////////////////////////////////////////////////
+
+  Element elementAt(size_t bucketId, uint64_t position) const {
+    Bucket const& b = _buckets[bucketId];
+    if (position < b._nrAlloc) {
+      return b._table[position];
+    }
+    Migration const& m = _migrations[bucketId];
+    position -= b._nrAlloc;
+    if (position < m.position) {
+      return Element();
+    }
+    return m.table._table[position];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief places an element into the first free slot of its probe
+  /// sequence. the element must not be in the bucket yet
+  //////////////////////////////////////////////////////////////////////////////
+
+  void placeElement(Bucket& b, Element const& element) {
+    uint64_t const n = b._nrAlloc;
+    TRI_ASSERT(n > 0);
+
+    uint64_t i, k;
+    i = k = _helper.HashElement(element, true) % n;
+
+    for (; i < n && b._table[i]; ++i)
+      ;
+    if (i == n) {
+      for (i = 0; i < k && b._table[i]; ++i)
+        ;
+    }
+
+    b._table[i] = element;
+    ++b._nrUsed;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief starts an incremental resize of a bucket
+  //////////////////////////////////////////////////////////////////////////////
+
+  void startMigration(Bucket& b, uint64_t targetSize) {
+    Migration& m = migration(b);
+    TRI_ASSERT(m.table._table == nullptr);
+
+    Bucket copy;
+    copy.allocate(TRI_NearPrime(targetSize));
+
+    m.table = std::move(b);
+    m.position = 0;
+    b = std::move(copy);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves up to steps slots of a running resize to the new table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void migrate(Bucket& b, uint64_t steps) {
+    Migration& m = migration(b);
+    Bucket& old = m.table;
+    if (old._table == nullptr) {
+      return;
+    }
+
+    uint64_t const n = old._nrAlloc;
+    for (; steps > 0 && m.position < n && old._nrUsed > 0; --steps) {
+      Element const& element = old._table[m.position];
+      if (element) {
+        placeElement(b, element);
+        --old._nrUsed;
+      }
+      ++m.position;
+    }
+
+    if (old._nrUsed == 0) {
+      // all elements moved. the remaining slots hold copies only
+      old.deallocate();
+      m.position = 0;
+    }
+  }
+
+  void finishMigration(Bucket& b) {
+    Migration& m = migration(b);
+    if (m.table._table != nullptr) {
+      migrate(b, m.table._nrAlloc);
+    }
+    TRI_ASSERT(m.table._table == nullptr);
+  }
+
+  void finishMigrations() {
+    for (auto& b : _buckets) {
+      finishMigration(b);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief looks up an element in the previous table of a running resize.
+  /// returns the slot of the element, or the size of the table if the
+  /// element is not there or has been moved
+  //////////////////////////////////////////////////////////////////////////////
+
+  template <typename F>
+  uint64_t findInMigration(Migration const& m, uint64_t hash,
+                           F const& isEqual) const {
+    Bucket const& old = m.table;
+    uint64_t const n = old._nrAlloc;
+    if (old._nrUsed == 0) {
+      return n;
+    }
+
+    uint64_t i = hash % n;
+    uint64_t k = i;
+
+    for (; i < n && old._table[i] && !isEqual(old._table[i]); ++i)
+      ;
+    if (i == n) {
+      for (i = 0; i < k && old._table[i] && !isEqual(old._table[i]); ++i)
+        ;
+    }
+
+    if (!old._table[i] || i < m.position) {
+      return n;
+    }
+    return i;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes the element in slot i of the previous table of a running
+  /// resize. moving elements into the hole could hide them below the
+  /// migration position, so the rest of the cluster is moved to the new
+  /// table instead
+  //////////////////////////////////////////////////////////////////////////////
+
+  void removeFromMigration(Bucket& b, uint64_t i) {
+    Migration& m = migration(b);
+    Bucket& old = m.table;
+    uint64_t const n = old._nrAlloc;
+    TRI_ASSERT(i >= m.position && old._table[i]);
+
+    old._table[i] = Element();
+    --old._nrUsed;
+
+    uint64_t k = TRI_IncModU64(i, n);
+
+    while (old._table[k]) {
+      if (k >= m.position) {
+        placeElement(b, old._table[k]);
+        --old._nrUsed;
+      }
+      old._table[k] = Element();
+      k = TRI_IncModU64(k, n);
+    }
+
+    if (old._nrUsed == 0) {
+      old.deallocate();
+      m.position = 0;
+    }
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief resizes the array
   //////////////////////////////////////////////////////////////////////////////
 
   void resizeInternal(UserData* userData, Bucket& b, uint64_t targetSize,
                       bool allowShrink) {
+    finishMigration(b);
+
     if (b._nrAlloc > targetSize && !allowShrink) {
       return;
     }
@@ -151,25 +372,11 @@ class AssocUnique {
       uint64_t const oldAlloc = b._nrAlloc;
       TRI_ASSERT(oldAlloc > 0);
 
-      uint64_t const n = copy._nrAlloc;
-      TRI_ASSERT(n > 0);
-
       for (uint64_t j = 0; j < oldAlloc; j++) {
         Element const& element = oldTable[j];
 
         if (element) {
-          uint64_t i, k;
-          i = k = _helper.HashElement(element, true) % n;
-
-          for (; i < n && copy._table[i]; ++i)
-            ;
-          if (i == n) {
-            for (i = 0; i < k && copy._table[i]; ++i)
-              ;
-          }
-
-          copy._table[i] = element;
-          ++copy._nrUsed;
+          placeElement(copy, element);
         }
       }
     }
@@ -182,9 +389,19 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   bool checkResize(UserData* userData, Bucket& b, uint64_t expected) {
-    if (2 * b._nrAlloc < 3 * (b._nrUsed + expected)) {
+    // move on with a running resize
+    migrate(b, migrationStep());
+
+    if (2 * b._nrAlloc < 3 * (b._nrUsed + migration(b).table._nrUsed + expected)) {
       try {
-        resizeInternal(userData, b, 2 * (b._nrAlloc + expected) + 1, false);
+        uint64_t const targetSize = 2 * (b._nrAlloc + expected) + 1;
+        if (expected == 0 && b._nrAlloc >= incrementalResizeSize()) {
+          // a running resize is normally long done at this point
+          finishMigration(b);
+          startMigration(b, targetSize);
+        } else {
+          resizeInternal(userData, b, targetSize, false);
+        }
       } catch (...) {
         return false;
       }
@@ -201,14 +418,12 @@ class AssocUnique {
       UserData* userData, BucketPosition& position, uint64_t const step,
       BucketPosition const& initial) const {
     Element found;
-    Bucket const* b = &_buckets[position.bucketId];
     do {
-      found = b->_table[position.position];
+      found = elementAt(position.bucketId, position.position);
       position.position += step;
-      while (position.position >= b->_nrAlloc) {
-        position.position -= b->_nrAlloc;
+      while (position.position >= allocatedSlots(position.bucketId)) {
+        position.position -= allocatedSlots(position.bucketId);
         position.bucketId = (position.bucketId + 1) % _buckets.size();
-        b = &_buckets[position.bucketId];
       }
       if (position == initial) {
         // We are done. Return the last element we have in hand
@@ -256,6 +471,9 @@ class AssocUnique {
   void truncate(CallbackElementFuncType callback) {
     for (auto& b : _buckets) {
       invokeOnAllElements(callback, b);
+      Migration& m = migration(b);
+      m.table.deallocate();
+      m.position = 0;
       b.deallocate();
       b.allocate(initialSize());
     }
@@ -268,8 +486,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   bool isEmpty() const {
-    for (auto& b : _buckets) {
-      if (b._nrUsed > 0) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      if (usedSlots(i) > 0) {
         return false;
       }
     }
@@ -283,7 +501,19 @@ class AssocUnique {
   size_t memoryUsage() const {
     size_t res = 0;
     for (auto& b : _buckets) {
-      res += b.memoryUsage();
+      res += b.memoryUsage() + migration(b).table.memoryUsage();
+    }
+    return res;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief get the part of the memory usage that uses huge pages
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t hugePageMemoryUsage() const {
+    size_t res = 0;
+    for (auto& b : _buckets) {
+      res += b.hugePageMemoryUsage() + migration(b).table.hugePageMemoryUsage();
     }
     return res;
   }
@@ -294,16 +524,16 @@ class AssocUnique {
 
   size_t size() const {
     size_t sum = 0;
-    for (auto& b : _buckets) {
-      sum += static_cast<size_t>(b._nrUsed);
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      sum += static_cast<size_t>(usedSlots(i));
     }
     return sum;
   }
 
   size_t capacity() const {
     size_t sum = 0;
-    for (auto& b : _buckets) {
-      sum += static_cast<size_t>(b._nrAlloc);
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      sum += static_cast<size_t>(allocatedSlots(i));
     }
     return sum;
   }
@@ -313,6 +543,7 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   int resize(UserData* userData, size_t size) {
+    finishMigrations();
     size /= _buckets.size();
     for (auto& b : _buckets) {
       if (2 * (2 * size + 1) < 3 * b._nrUsed) {
@@ -338,7 +569,7 @@ class AssocUnique {
     for (auto& b : _buckets) {
       builder.openObject();
       builder.add("nrAlloc", VPackValue(b._nrAlloc));
-      builder.add("nrUsed", VPackValue(b._nrUsed));
+      builder.add("nrUsed", VPackValue(b._nrUsed + migration(b).table._nrUsed));
       builder.close();
     }
     builder.close();  // buckets
@@ -351,7 +582,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element find(UserData* userData, Element const& element) const {
-    uint64_t i = _helper.HashElement(element, true);
+    uint64_t const hash = _helper.HashElement(element, true);
+    uint64_t i = hash;
     Bucket const& b = _buckets[i & _bucketsMask];
 
     uint64_t const n = b._nrAlloc;
@@ -369,6 +601,16 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i]) {
+      Migration const& m = migration(b);
+      uint64_t const j = findInMigration(m, hash, [&](Element const& other) {
+        return _helper.IsEqualElementElementByKey(userData, element, other);
+      });
+      if (j != m.table._nrAlloc) {
+        return m.table._table[j];
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -403,6 +645,16 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i]) {
+      Migration const& m = migration(b);
+      uint64_t const j = findInMigration(m, hash, [&](Element const& other) {
+        return _helper.IsEqualKeyElement(userData, key, other);
+      });
+      if (j != m.table._nrAlloc) {
+        return m.table._table[j];
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -432,6 +684,16 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i]) {
+      Migration const& m = migration(b);
+      uint64_t const j = findInMigration(m, hash, [&](Element const& other) {
+        return _helper.IsEqualKeyElement(userData, key, other);
+      });
+      if (j != m.table._nrAlloc) {
+        return &m.table._table[j];
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -470,10 +732,21 @@ class AssocUnique {
     }
 
     // if requested, pass the position of the found element back
-    // to the caller
+    // to the caller. an element in the previous table of a running resize
+    // is returned with the position in the new table it would be placed at
     position.bucketId = static_cast<size_t>(bucketId);
     position.position = i;
 
+    if (!b._table[i]) {
+      Migration const& m = migration(b);
+      uint64_t const j = findInMigration(m, hash, [&](Element const& other) {
+        return _helper.IsEqualKeyElement(userData, key, other);
+      });
+      if (j != m.table._nrAlloc) {
+        return m.table._table[j];
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -494,6 +767,13 @@ class AssocUnique {
       return TRI_ERROR_OUT_OF_MEMORY;
     }
 
+    Migration const& m = migration(b);
+    if (findInMigration(m, hash, [&](Element const& other) {
+          return _helper.IsEqualElementElementByKey(userData, element, other);
+        }) != m.table._nrAlloc) {
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+
     return doInsert(userData, element, b, hash);
   }
 
@@ -582,6 +862,10 @@ class AssocUnique {
       return checkResize(userData, b, expected);
     };
 
+    // the inserters work on the new tables only. checkResize does not start
+    // incremental resizes for an expected number of elements
+    finishMigrations();
+
     try {
       // generate inserter tasks to be dispatched later by partitioners
       for (size_t i = 0; i < allBuckets->size(); i++) {
@@ -648,7 +932,7 @@ class AssocUnique {
       k = TRI_IncModU64(k, n);
     }
 
-    if (b._nrUsed == 0) {
+    if (b._nrUsed == 0 && migration(b).table._table == nullptr) {
       resizeInternal(userData, b, initialSize(), true);
     }
   }
@@ -660,7 +944,7 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element removeByKey(UserData* userData, Key const* key) {
-    uint64_t hash = _helper.HashKey(key);
+    uint64_t const hash = _helper.HashKey(key);
     uint64_t i = hash;
     Bucket& b = _buckets[i & _bucketsMask];
 
@@ -683,6 +967,15 @@ class AssocUnique {
 
     if (old) {
       healHole(userData, b, i);
+    } else {
+      Migration const& m = migration(b);
+      uint64_t const j = findInMigration(m, hash, [&](Element const& other) {
+        return _helper.IsEqualKeyElement(userData, key, other);
+      });
+      if (j != m.table._nrAlloc) {
+        old = m.table._table[j];
+        removeFromMigration(b, j);
+      }
     }
     return old;
   }
@@ -693,7 +986,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element remove(UserData* userData, Element const& element) {
-    uint64_t i = _helper.HashElement(element, true);
+    uint64_t const hash = _helper.HashElement(element, true);
+    uint64_t i = hash;
     Bucket& b = _buckets[i & _bucketsMask];
 
     uint64_t const n = b._nrAlloc;
@@ -715,6 +1009,15 @@ class AssocUnique {
 
     if (old) {
       healHole(userData, b, i);
+    } else {
+      Migration const& m = migration(b);
+      uint64_t const j = findInMigration(m, hash, [&](Element const& other) {
+        return _helper.IsEqualElementElement(userData, element, other);
+      });
+      if (j != m.table._nrAlloc) {
+        old = m.table._table[j];
+        removeFromMigration(b, j);
+      }
     }
 
     return old;
@@ -749,6 +1052,17 @@ class AssocUnique {
         }
       }
     }
+    Migration& m = migration(b);
+    if (m.table._nrUsed > 0) {
+      for (uint64_t i = m.position; i < m.table._nrAlloc; ++i) {
+        if (!m.table._table[i]) {
+          continue;
+        }
+        if (!callback(m.table._table[i])) {
+          return false;
+        }
+      }
+    }
     return true;
   }
 
@@ -758,6 +1072,9 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   void invokeOnAllElementsForRemoval(CallbackElementFuncType callback) {
+    // removals move elements between the tables of a running resize
+    finishMigrations();
+
     for (auto& b : _buckets) {
       if (b._table == nullptr || b._nrUsed == 0) {
         continue;
@@ -801,8 +1118,8 @@ class AssocUnique {
       if (position.bucketId == SIZE_MAX) {
         // first call, now fill total
         total = 0;
-        for (auto const& b : _buckets) {
-          total += b._nrUsed;
+        for (size_t i = 0; i < _buckets.size(); ++i) {
+          total += usedSlots(i);
         }
 
         if (total == 0) {
@@ -817,17 +1134,18 @@ class AssocUnique {
     }
 
     while (true) {
-      Bucket const& b = _buckets[position.bucketId];
-      uint64_t const n = b._nrAlloc;
+      uint64_t const n = allocatedSlots(position.bucketId);
+      Element found;
 
-      for (; position.position < n && !b._table[position.position];
-           ++position.position)
-        ;
+      for (; position.position < n; ++position.position) {
+        found = elementAt(position.bucketId, position.position);
+        if (found) {
+          break;
+        }
+      }
 
       if (position.position != n) {
         // found an element
-        Element found = b._table[position.position];
-
         // move forward the position indicator one more time
         if (++position.position == n) {
           position.position = 0;
@@ -867,13 +1185,12 @@ class AssocUnique {
       }
 
       position.bucketId = _buckets.size() - 1;
-      position.position = _buckets[position.bucketId]._nrAlloc - 1;
+      position.position = allocatedSlots(position.bucketId) - 1;
     }
 
-    Bucket const* b = &_buckets[position.bucketId];
     Element found;
     do {
-      found = b->_table[position.position];
+      found = elementAt(position.bucketId, position.position);
 
       if (position.position == 0) {
         if (position.bucketId == 0) {
@@ -883,8 +1200,7 @@ class AssocUnique {
         }
 
         --position.bucketId;
-        b = &_buckets[position.bucketId];
-        position.position = b->_nrAlloc - 1;
+        position.position = allocatedSlots(position.bucketId) - 1;
       } else {
         --position.position;
       }
@@ -911,9 +1227,9 @@ class AssocUnique {
       // Initialize
       uint64_t used = 0;
       total = 0;
-      for (auto& b : _buckets) {
-        total += b._nrAlloc;
-        used += b._nrUsed;
+      for (size_t i = 0; i < _buckets.size(); ++i) {
+        total += allocatedSlots(i);
+        used += usedSlots(i);
       }
       if (used == 0) {
         return Element();
@@ -930,14 +1246,14 @@ class AssocUnique {
             initialPositionNr = RandomGenerator::interval(UINT32_MAX) % total;
           }
           for (size_t i = 0; i < _buckets.size(); ++i) {
-            if (initialPositionNr < _buckets[i]._nrAlloc) {
+            if (initialPositionNr < allocatedSlots(i)) {
               position.bucketId = i;
               position.position = initialPositionNr;
               initialPosition.bucketId = i;
               initialPosition.position = initialPositionNr;
               break;
             }
-            initialPositionNr -= _buckets[i]._nrAlloc;
+            initialPositionNr -= allocatedSlots(i);
           }
           break;
         }
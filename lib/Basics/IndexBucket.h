@@ -43,6 +43,7 @@ struct IndexBucket {
   int _file;                // file descriptor for memory mapped file (-1 = no file)
   char* _filename;          // name of memory mapped file (nullptr = no file)
   void* _mmHandle;
+  bool _hugePages;          // whether the table is advised to use huge pages
 
   IndexBucket() 
       : _nrAlloc(0), 
@@ -51,7 +52,8 @@ struct IndexBucket {
         _table(nullptr), 
         _file(-1), 
         _filename(nullptr),
-        _mmHandle(nullptr) {}
+        _mmHandle(nullptr),
+        _hugePages(false) {}
   IndexBucket(IndexBucket const&) = delete;
   IndexBucket& operator=(IndexBucket const&) = delete;
   
@@ -63,7 +65,8 @@ struct IndexBucket {
         _table(other._table), 
         _file(other._file), 
         _filename(other._filename),
-        _mmHandle(other._mmHandle) {
+        _mmHandle(other._mmHandle),
+        _hugePages(other._hugePages) {
     other._nrAlloc = 0;
     other._nrUsed = 0;
     other._nrCollisions = 0;
@@ -71,6 +74,7 @@ struct IndexBucket {
     other._file = -1;
     other._filename = nullptr;
     other._mmHandle = nullptr;
+    other._hugePages = false;
   }
 
   IndexBucket& operator=(IndexBucket&& other) {
@@ -83,6 +87,7 @@ struct IndexBucket {
     _file = other._file;
     _filename = other._filename;
     _mmHandle = other._mmHandle;
+    _hugePages = other._hugePages;
 
     other._nrAlloc = 0;
     other._nrUsed = 0;
@@ -91,6 +96,7 @@ struct IndexBucket {
     other._file = -1;
     other._filename = nullptr;
     other._mmHandle = nullptr;
+    other._hugePages = false;
 
     return *this;
   }
@@ -103,6 +109,11 @@ struct IndexBucket {
   size_t memoryUsage() const {
     return requiredSize(_nrAlloc);
   }
+
+  // the part of the memory usage that was advised to use huge pages
+  size_t hugePageMemoryUsage() const {
+    return _hugePages ? memoryUsage() : 0;
+  }
     
   size_t requiredSize(size_t numberElements) const {
     return numberElements * sizeof(EntryType);
@@ -133,6 +144,7 @@ struct IndexBucket {
         TRI_MMFileAdvise(memptr, totalSize, TRI_MADVISE_RANDOM);
       }
 #endif
+      _hugePages = (TRI_MMFileAdviseHugePages(_table, totalSize) > 0);
 
       _nrAlloc = static_cast<IndexType>(numberElements);
     } catch (...) {
@@ -209,6 +221,7 @@ struct IndexBucket {
     _nrAlloc = 0;
     _nrUsed = 0;
     _nrCollisions = 0;
+    _hugePages = false;
   }
 
   int allocateTempfile(char*& filename, size_t filesize) {
@@ -76,6 +76,8 @@ std::string const StaticStrings::ReplicationHeaderFromPresent(
     "x-arango-replication-frompresent");
 std::string const StaticStrings::ReplicationHeaderActive(
     "x-arango-replication-active");
+std::string const StaticStrings::ReplicationHeaderStreams(
+    "x-arango-replication-streams");
 
 // database and collection names
 std::string const StaticStrings::SystemDatabase("_system");
@@ -90,6 +92,7 @@ std::string const StaticStrings::DataSourceSystem("isSystem");
 std::string const StaticStrings::DataSourceType("type");
 
 // Index definition fields
+std::string const StaticStrings::IndexExpireAfter("expireAfter");
 std::string const StaticStrings::IndexFields("fields");
 std::string const StaticStrings::IndexId("id");
 std::string const StaticStrings::IndexSparse("sparse");
@@ -147,15 +150,21 @@ std::string const StaticStrings::NoSniff("nosniff");
 std::string const StaticStrings::Origin("origin");
 std::string const StaticStrings::PotentialDirtyRead("x-arango-potential-dirty-read");
 std::string const StaticStrings::Queue("x-arango-queue");
+std::string const StaticStrings::QueueFillGrade("x-arango-queue-fill-grade");
 std::string const StaticStrings::RequestForwardedTo(
     "x-arango-request-forwarded-to");
+std::string const StaticStrings::RequestTimeout("x-arango-request-timeout");
 std::string const StaticStrings::ResponseCode("x-arango-response-code");
+std::string const StaticStrings::RetryAfter("retry-after");
 std::string const StaticStrings::Server("server");
+std::string const StaticStrings::TraceId("x-arango-trace-id");
 std::string const StaticStrings::Unlimited = "unlimited";
 std::string const StaticStrings::WwwAuthenticate("www-authenticate");
 std::string const StaticStrings::XContentTypeOptions("x-content-type-options");
 std::string const StaticStrings::XArangoNoLock("x-arango-nolock");
 std::string const StaticStrings::XArangoFrontend("x-arango-frontend");
+std::string const StaticStrings::XArangoTrxId("x-arango-trx-id");
+std::string const StaticStrings::XArangoPlanVersion("x-arango-plan-version");
 
 // mime types
 std::string const StaticStrings::MimeTypeJson(
@@ -75,6 +75,7 @@ class StaticStrings {
   static std::string const ReplicationHeaderLastTick;
   static std::string const ReplicationHeaderFromPresent;
   static std::string const ReplicationHeaderActive;
+  static std::string const ReplicationHeaderStreams;
 
   // database and collection names
   static std::string const SystemDatabase;
@@ -89,6 +90,7 @@ class StaticStrings {
   static std::string const DataSourceType; // data-source type
 
   // Index definition fields
+  static std::string const IndexExpireAfter; // ttl index expiry period
   static std::string const IndexFields; // index fields
   static std::string const IndexId; // index id
   static std::string const IndexSparse; // index sparsness marker
@@ -136,14 +138,20 @@ class StaticStrings {
   static std::string const Origin;
   static std::string const PotentialDirtyRead;
   static std::string const Queue;
+  static std::string const QueueFillGrade;
   static std::string const RequestForwardedTo;
+  static std::string const RequestTimeout;
   static std::string const ResponseCode;
+  static std::string const RetryAfter;
   static std::string const Server;
+  static std::string const TraceId;
   static std::string const Unlimited;
   static std::string const WwwAuthenticate;
   static std::string const XContentTypeOptions;
   static std::string const XArangoNoLock;
   static std::string const XArangoFrontend;
+  static std::string const XArangoTrxId;
+  static std::string const XArangoPlanVersion;
 
   // mime types
   static std::string const MimeTypeJson;
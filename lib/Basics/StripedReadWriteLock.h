@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ARANGO_STRIPED_READ_WRITE_LOCK_H
+#define ARANGO_STRIPED_READ_WRITE_LOCK_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ReadWriteLock.h"
+#include "Basics/Thread.h"
+
+namespace arangodb {
+namespace basics {
+
+/// @brief read-write lock that is split into multiple stripes. a reader
+/// only acquires the stripe determined by its thread, so readers running
+/// on different threads do not contend on the same cache line. a writer
+/// has to acquire all stripes, so writing is more expensive than with a
+/// single ReadWriteLock. can be used with READ_LOCKER and WRITE_LOCKER
+template <size_t numberOfStripes>
+class StripedReadWriteLock {
+ public:
+  StripedReadWriteLock() = default;
+  StripedReadWriteLock(StripedReadWriteLock const&) = delete;
+  StripedReadWriteLock& operator=(StripedReadWriteLock const&) = delete;
+
+  /// @brief locks for writing
+  void writeLock() {
+    for (auto& it : _stripes) {
+      it.lock.writeLock();
+    }
+  }
+
+  /// @brief locks for writing, but only tries
+  bool tryWriteLock() {
+    for (size_t i = 0; i < numberOfStripes; ++i) {
+      if (!_stripes[i].lock.tryWriteLock()) {
+        // release the stripes we already acquired
+        while (i > 0) {
+          _stripes[--i].lock.unlockWrite();
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief locks for reading
+  void readLock() { stripe().readLock(); }
+
+  /// @brief locks for reading, tries only
+  bool tryReadLock() { return stripe().tryReadLock(); }
+
+  /// @brief releases the write-lock
+  void unlockWrite() {
+    for (size_t i = numberOfStripes; i > 0; --i) {
+      _stripes[i - 1].lock.unlockWrite();
+    }
+  }
+
+  /// @brief releases the read-lock. must be called from the same thread
+  /// that acquired the read-lock
+  void unlockRead() { stripe().unlockRead(); }
+
+ private:
+  /// @brief return the stripe for the current thread
+  ReadWriteLock& stripe() {
+    return _stripes[Thread::currentThreadNumber() % numberOfStripes].lock;
+  }
+
+ private:
+  /// @brief a single stripe, padded to a cache line
+  struct alignas(64) Stripe {
+    ReadWriteLock lock;
+  };
+
+  Stripe _stripes[numberOfStripes];
+};
+
+}  // namespace basics
+}  // namespace arangodb
+
+#endif
@@ -33,10 +33,52 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace arangodb::basics;
 
 static size_t const MinReserveValue = 32;
 
+namespace {
+
+/// @brief returns the length of the longest prefix of [p, e) that can be
+/// copied verbatim into a JSON string, i.e. that contains only ASCII
+/// characters which never need escaping. '/' is excluded because it is
+/// escaped on request
+inline size_t plainPrefixLength(uint8_t const* p, uint8_t const* e) {
+  uint8_t const* start = p;
+#ifdef __SSE2__
+  __m128i const quote = _mm_set1_epi8('"');
+  __m128i const backslash = _mm_set1_epi8('\\');
+  __m128i const slash = _mm_set1_epi8('/');
+  __m128i const space = _mm_set1_epi8(0x20);
+  while (e - p >= 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    // signed comparison, so bytes >= 0x80 count as less than 0x20, too
+    __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmplt_epi8(v, space), _mm_cmpeq_epi8(v, quote)),
+        _mm_or_si128(_mm_cmpeq_epi8(v, backslash), _mm_cmpeq_epi8(v, slash)));
+    int mask = _mm_movemask_epi8(special);
+    if (mask != 0) {
+      return (p - start) + __builtin_ctz(static_cast<unsigned int>(mask));
+    }
+    p += 16;
+  }
+#endif
+  while (p < e) {
+    uint8_t c = *p;
+    if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\' || c == '/') {
+      break;
+    }
+    ++p;
+  }
+  return p - start;
+}
+
+}
+
 void VelocyPackDumper::handleUnsupportedType(VPackSlice const* /*slice*/) {
   TRI_string_buffer_t* buffer = _buffer->stringBuffer(); 
 
@@ -310,6 +352,16 @@ void VelocyPackDumper::appendString(char const* src, VPackValueLength len) {
   uint8_t const* p = reinterpret_cast<uint8_t const*>(src);
   uint8_t const* e = p + len;
   while (p < e) {
+    // copy runs of characters that need no escaping in one go
+    size_t const plain = ::plainPrefixLength(p, e);
+    if (plain > 0) {
+      TRI_AppendStringUnsafeStringBuffer(buffer, reinterpret_cast<char const*>(p), plain);
+      p += plain;
+      if (p >= e) {
+        break;
+      }
+    }
+
     uint8_t c = *p;
 
     if ((c & 0x80U) == 0) {
@@ -431,6 +483,7 @@ void VelocyPackDumper::dumpValue(VPackSlice const* slice, VPackSlice const* base
           }
         }
         dumpValue(it.value(), slice);
+        flushIfFull();
         it.next();
       }
       if (TRI_AppendCharStringBuffer(buffer, ']') != TRI_ERROR_NO_ERROR) {
@@ -453,6 +506,7 @@ void VelocyPackDumper::dumpValue(VPackSlice const* slice, VPackSlice const* base
           THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
         }
         dumpValue(it.value(), slice);
+        flushIfFull();
         it.next();
       }
       if (TRI_AppendCharStringBuffer(buffer, '}') != TRI_ERROR_NO_ERROR) {
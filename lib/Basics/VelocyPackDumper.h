@@ -45,7 +45,7 @@ class VelocyPackDumper {
 
  public:
   explicit VelocyPackDumper(StringBuffer* buffer, velocypack::Options const* options = &velocypack::Options::Defaults)
-      : options(options), _buffer(buffer) {
+      : options(options), _buffer(buffer), _flushThreshold(0) {
     TRI_ASSERT(buffer != nullptr);
     TRI_ASSERT(options != nullptr);
   }
@@ -58,6 +58,14 @@ class VelocyPackDumper {
     dumpValue(&slice, base);
   }
 
+  /// @brief the flush function is called between two values of an array or
+  /// object whenever the buffer holds at least threshold bytes. it must take
+  /// over the content of the buffer and leave it empty
+  void setFlush(size_t threshold, std::function<void()> const& flush) {
+    _flushThreshold = threshold;
+    _flush = flush;
+  }
+
  private:
   void appendUnicodeCharacter(uint16_t);
 
@@ -71,11 +79,19 @@ class VelocyPackDumper {
 
   void dumpInteger(velocypack::Slice const*);
 
+  inline void flushIfFull() {
+    if (_flushThreshold > 0 && _buffer->length() >= _flushThreshold) {
+      _flush();
+    }
+  }
+
  public:
   velocypack::Options const* options;
 
  private:
   StringBuffer* _buffer;
+  size_t _flushThreshold;
+  std::function<void()> _flush;
 };
 
 }
@@ -30,9 +30,17 @@
 
 #include <sys/mman.h>
 
+#include <atomic>
+
 using namespace arangodb;
 
 namespace {
+/// @brief whether or not transparent huge page hints are enabled
+std::atomic<bool> HugePages(false);
+
+/// @brief size of a transparent huge page on x86_64
+constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
 static std::string flagify(int flags) {
   std::string result;
 
@@ -233,6 +241,60 @@ int TRI_MMFileAdvise(void* memoryAddress, size_t numOfBytes, int advice) {
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enables or disables transparent huge page hints
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_SetHugePagesMMFile(bool value) {
+  HugePages.store(value, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not transparent huge page hints are enabled
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HugePagesMMFile() {
+  return HugePages.load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief asks the kernel to back a region with transparent huge pages
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_MMFileAdviseHugePages(void* memoryAddress, size_t numOfBytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (!HugePages.load(std::memory_order_relaxed) ||
+      numOfBytes < HugePageSize) {
+    return 0;
+  }
+
+  // madvise requires a page-aligned start address. the region may start
+  // in the middle of a page if it was allocated on the heap
+  uintptr_t pageSize = static_cast<uintptr_t>(getpagesize());
+  uintptr_t begin = reinterpret_cast<uintptr_t>(memoryAddress);
+  uintptr_t end = begin + numOfBytes;
+  begin = ((begin + pageSize - 1) / pageSize) * pageSize;
+  end = (end / pageSize) * pageSize;
+
+  if (end <= begin) {
+    return 0;
+  }
+
+  void* start = reinterpret_cast<void*>(begin);
+  size_t size = static_cast<size_t>(end - begin);
+  LOG_TOPIC(TRACE, Logger::MMAP) << "madvise hugepage for range " << Logger::RANGE(start, size);
+
+  if (madvise(start, size, MADV_HUGEPAGE) == 0) {
+    return size;
+  }
+
+  // EINVAL means the kernel has no transparent huge page support
+  int res = errno;
+  LOG_TOPIC(DEBUG, Logger::MMAP) << "madvise hugepage for range " << Logger::RANGE(start, size) << " failed with: " << strerror(res);
+#endif
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locks a region in memory
 ////////////////////////////////////////////////////////////////////////////////
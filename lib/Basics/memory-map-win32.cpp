@@ -334,6 +334,29 @@ int TRI_MMFileAdvise(void*, size_t, int) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enables or disables transparent huge page hints
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_SetHugePagesMMFile(bool) {
+  // Not on Windows
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not transparent huge page hints are enabled
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HugePagesMMFile() { return false; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief asks the kernel to back a region with transparent huge pages
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_MMFileAdviseHugePages(void*, size_t) {
+  // Not on Windows
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locks a region in memory
 ////////////////////////////////////////////////////////////////////////////////
@@ -88,6 +88,27 @@ int TRI_ProtectMMFile(void* memoryAddress, size_t numOfBytesToProtect,
 
 int TRI_MMFileAdvise(void* memoryAddress, size_t numOfBytes, int advice);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enables or disables transparent huge page hints (off by default)
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_SetHugePagesMMFile(bool value);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not transparent huge page hints are enabled
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HugePagesMMFile();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief asks the kernel to back the page-aligned part of a region with
+/// transparent huge pages. returns the number of bytes advised, which is 0
+/// if the hints are disabled or unsupported, the region is smaller than a
+/// huge page or the advice failed
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_MMFileAdviseHugePages(void* memoryAddress, size_t numOfBytes);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locks a region in memory
 ////////////////////////////////////////////////////////////////////////////////
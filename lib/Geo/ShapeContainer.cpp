@@ -214,6 +214,18 @@ void ShapeContainer::updateBounds(QueryParams& qp) const noexcept {
   }
 }
 
+/// The bounds of polygons are computed once on construction and those of
+/// rectangles are trivial. Checking them first avoids running the exact S2
+/// predicates against large area shapes for most non-matching candidates
+bool ShapeContainer::mayIntersectBounds(ShapeContainer const* cc) const {
+  if (!isAreaType() || cc->_type == Type::S2_POINT ||
+      cc->_type == Type::EMPTY) {
+    return true;  // not worth it, points are checked via the shape index
+  }
+  S2LatLngRect const other = cc->_data->GetRectBound();
+  return other.is_empty() || _data->GetRectBound().Intersects(other);
+}
+
 bool ShapeContainer::contains(S2Point const& pp) const {
   if (_type == ShapeContainer::Type::EMPTY) {
     return false;
@@ -374,6 +386,9 @@ bool ShapeContainer::contains(S2Polygon const* poly) const {
 }
 
 bool ShapeContainer::contains(ShapeContainer const* cc) const {
+  if (!mayIntersectBounds(cc)) {
+    return false;  // cheap rejection
+  }
   switch (cc->_type) {
     case ShapeContainer::Type::S2_POINT: {
       S2Point const& p = static_cast<S2PointRegion*>(cc->_data)->point();
@@ -645,6 +660,9 @@ bool ShapeContainer::intersects(S2Polygon const* other) const {
 }
 
 bool ShapeContainer::intersects(ShapeContainer const* cc) const {
+  if (!mayIntersectBounds(cc)) {
+    return false;  // cheap rejection
+  }
   switch (cc->_type) {
     case ShapeContainer::Type::S2_POINT: {
       S2Point const& p = static_cast<S2PointRegion*>(cc->_data)->point();
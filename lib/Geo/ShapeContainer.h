@@ -127,6 +127,10 @@ class ShapeContainer final {
 
   S2Region const* region() const;
 
+ private:
+  /// @brief false if the bounding rectangles rule out any overlap
+  bool mayIntersectBounds(ShapeContainer const*) const;
+
  private:
   S2Region* _data;
   Type _type;
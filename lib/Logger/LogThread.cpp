@@ -30,6 +30,8 @@ using namespace arangodb;
 
 arangodb::basics::ConditionVariable* LogThread::CONDITION = nullptr;
 boost::lockfree::queue<LogMessage*>* LogThread::MESSAGES = nullptr;
+std::atomic<size_t> LogThread::PENDING(0);
+std::atomic<uint64_t> LogThread::DROPPED(0);
 
 LogThread::LogThread(std::string const& name) : Thread(name), _messages(0) {
   MESSAGES = &_messages;
@@ -49,9 +51,15 @@ void LogThread::log(std::unique_ptr<LogMessage>& message) {
     // only release message if adding to the queue succeeded
     // otherwise we would leak here
     message.release();
+    PENDING.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
+bool LogThread::hasCapacity() {
+  size_t const maxQueued = Logger::maxQueuedMessages();
+  return (maxQueued == 0 || PENDING.load(std::memory_order_relaxed) < maxQueued);
+}
+
 void LogThread::flush() {
   int tries = 0;
 
@@ -79,6 +87,7 @@ void LogThread::run() {
 
   while (!isStopping() && Logger::_active.load()) {
     while (_messages.pop(msg)) {
+      PENDING.fetch_sub(1, std::memory_order_relaxed);
       try {
         LogAppender::log(msg);
       } catch (...) {
@@ -87,11 +96,19 @@ void LogThread::run() {
       delete msg;
     }
 
+    uint64_t dropped = DROPPED.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+      LOG_TOPIC(WARN, Logger::FIXME)
+          << "dropped " << dropped
+          << " log message(s) because the logging thread could not keep up";
+    }
+
     CONDITION_LOCKER(guard, *CONDITION);
     guard.wait(25 * 1000);
   }
 
   while (_messages.pop(msg)) {
+    PENDING.fetch_sub(1, std::memory_order_relaxed);
     try {
       LogAppender::log(msg);
     } catch (...) {
@@ -41,6 +41,11 @@ class LogThread final : public Thread {
   static void log(std::unique_ptr<LogMessage>&);
   // flush all pending log messages
   static void flush();
+  // whether or not another message may be queued without exceeding
+  // Logger::maxQueuedMessages()
+  static bool hasCapacity();
+  // count a message that was dropped because the queue was full
+  static void countDropped() { DROPPED.fetch_add(1, std::memory_order_relaxed); }
 
  public:
   explicit LogThread(std::string const& name);
@@ -59,6 +64,8 @@ class LogThread final : public Thread {
  private:
   static arangodb::basics::ConditionVariable* CONDITION;
   static boost::lockfree::queue<LogMessage*>* MESSAGES;
+  static std::atomic<size_t> PENDING;
+  static std::atomic<uint64_t> DROPPED;
 
   arangodb::basics::ConditionVariable _condition;
   boost::lockfree::queue<LogMessage*> _messages;
@@ -67,6 +67,7 @@ bool Logger::_keepLogRotate(false);
 bool Logger::_useMicrotime(false);
 bool Logger::_logRequestParameters(true);
 bool Logger::_showRole(false);
+size_t Logger::_maxQueuedMessages(16384);
 char Logger::_role('\0');
 TRI_pid_t Logger::_cachedPid(0);
 std::string Logger::_outputPrefix("");
@@ -271,6 +272,15 @@ void Logger::setLogRequestParameters(bool log) {
   _logRequestParameters = log;
 }
 
+void Logger::setMaxQueuedMessages(size_t value) {
+  if (_active) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "cannot change maximum number of queued messages if logging is active");
+  }
+
+  _maxQueuedMessages = value;
+}
+
 std::string const& Logger::translateLogLevel(LogLevel level) {
   switch (level) {
     case LogLevel::DEFAULT:
@@ -313,7 +323,19 @@ void Logger::log(char const* function, char const* file, int line,
     return;
   }
 
-  std::stringstream out;
+  bool const isDirectLogLevel = (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
+
+  if (_threaded && !isDirectLogLevel && !_loggingThread->hasCapacity()) {
+    // the logging thread cannot keep up. drop the message instead of
+    // letting the queue grow without bounds
+    _loggingThread->countDropped();
+    return;
+  }
+
+  // the message is assembled in a single buffer, so that only the
+  // final string is allocated
+  std::string out;
+  out.reserve(_outputPrefix.size() + message.size() + 128);
   char buf[64];
 
   // time prefix
@@ -333,11 +355,12 @@ void Logger::log(char const* function, char const* file, int line,
       strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S ", &tb);
     }
   }
-  out << buf;
+  out.append(buf);
 
   // output prefix
   if (!_outputPrefix.empty()) {
-    out << _outputPrefix << ' ';
+    out.append(_outputPrefix);
+    out.push_back(' ');
   }
 
   // append the process / thread identifier
@@ -351,10 +374,12 @@ void Logger::log(char const* function, char const* file, int line,
     _cachedPid = Thread::currentProcessId();
   }
   TRI_ASSERT(_cachedPid != 0);
-  out << '[' << _cachedPid;
+  out.push_back('[');
+  out.append(std::to_string(_cachedPid));
 
   if (_showThreadIdentifier) {
-    out << '-' << Thread::currentThreadNumber();
+    out.push_back('-');
+    out.append(std::to_string(Thread::currentThreadNumber()));
   }
 
   // log thread name
@@ -364,17 +389,20 @@ void Logger::log(char const* function, char const* file, int line,
       threadName = "main";
     }
    
-    out << '-' << threadName;
+    out.push_back('-');
+    out.append(threadName);
   }
 
-  out << "] ";
+  out.append("] ");
   
   if (_showRole && _role != '\0') {
-    out << _role << ' ';
+    out.push_back(_role);
+    out.push_back(' ');
   }
 
   // log level
-  out << Logger::translateLogLevel(level) << ' ';
+  out.append(Logger::translateLogLevel(level));
+  out.push_back(' ');
 
   // check if we must display the line number
   if (_showLineNumber && file != nullptr && function != nullptr) {
@@ -387,21 +415,25 @@ void Logger::log(char const* function, char const* file, int line,
         filename = shortened + 1;
       }
     }
-    out << '[' << function << "@" << filename << ':' << line << "] ";
+    out.push_back('[');
+    out.append(function);
+    out.push_back('@');
+    out.append(filename);
+    out.push_back(':');
+    out.append(std::to_string(line));
+    out.append("] ");
   }
 
   // generate the complete message
-  out << message;
-  std::string ostreamContent = out.str();
-  size_t offset = ostreamContent.size() - message.size();
-  auto msg = std::make_unique<LogMessage>(level, topicId, std::move(ostreamContent), offset);
+  size_t offset = out.size();
+  out.append(message);
+  auto msg = std::make_unique<LogMessage>(level, topicId, std::move(out), offset);
 
   // now either queue or output the message
   if (_threaded) {
     try {
       _loggingThread->log(msg);
-      bool const isDirectLogLevel = (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
-      if (isDirectLogLevel) {
+      if (isDirectLogLevel && !_loggingThread->runningInThisThread()) {
         _loggingThread->flush();
       }
       return;
@@ -238,6 +238,8 @@ class Logger {
   static void setKeepLogrotate(bool);
   static void setLogRequestParameters(bool);
   static bool logRequestParameters() { return _logRequestParameters; }
+  static void setMaxQueuedMessages(size_t);
+  static size_t maxQueuedMessages() { return _maxQueuedMessages; }
 
   // can be called after fork()
   static void clearCachedPid() { _cachedPid = 0; }
@@ -282,6 +284,7 @@ class Logger {
   static bool _keepLogRotate;
   static bool _useMicrotime;
   static bool _logRequestParameters;
+  static size_t _maxQueuedMessages;
   static char _role; // current server role to log
   static TRI_pid_t _cachedPid;
   static std::string _outputPrefix;
@@ -137,6 +137,10 @@ void LoggerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addHiddenOption("--log.request-parameters",
                            "include full URLs and HTTP request parameters in trace logs",
                            new BooleanParameter(&_logRequestParameters));
+
+  options->addHiddenOption("--log.max-queued-messages",
+                           "maximum number of info, debug and trace messages queued for the logging thread. further messages are dropped and counted (0 = unlimited)",
+                           new UInt64Parameter(&_maxQueuedMessages));
 }
 
 void LoggerFeature::loadOptions(
@@ -186,6 +190,7 @@ void LoggerFeature::prepare() {
   Logger::setOutputPrefix(_prefix);
   Logger::setKeepLogrotate(_keepLogRotate);
   Logger::setLogRequestParameters(_logRequestParameters);
+  Logger::setMaxQueuedMessages(static_cast<size_t>(_maxQueuedMessages));
 
   for (auto const& definition : _output) {
     if (_supervisor && StringUtils::isPrefix(definition, "file://")) {
@@ -62,6 +62,7 @@ class LoggerFeature final : public application_features::ApplicationFeature {
   bool _useMicrotime = false;
   bool _showRole = false;
   bool _logRequestParameters = true;
+  uint64_t _maxQueuedMessages = 16384;
   bool _supervisor = false;
   bool _backgrounded = false;
   bool _threaded = false;
@@ -370,6 +370,7 @@ rest::ResponseCode GeneralResponse::responseCode(int code) {
     case TRI_ERROR_ARANGO_ENDPOINT_NOT_FOUND:
     case TRI_ERROR_ARANGO_INDEX_NOT_FOUND:
     case TRI_ERROR_CURSOR_NOT_FOUND:
+    case TRI_ERROR_TRANSACTION_NOT_FOUND:
     case TRI_ERROR_QUERY_FUNCTION_NOT_FOUND:
     case TRI_ERROR_QUERY_GEO_INDEX_MISSING:
     case TRI_ERROR_QUERY_FULLTEXT_INDEX_MISSING:
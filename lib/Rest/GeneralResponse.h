@@ -155,6 +155,20 @@ class GeneralResponse {
                   bool resolveExternals = true) = 0;
   
   virtual int reservePayload(std::size_t size) { return TRI_ERROR_NO_ERROR; }
+
+  /// @brief allow large bodies to be sent while they are still generated,
+  /// if the protocol supports it. the response code and all headers must be
+  /// set before the payload is added. a handler which allows streaming must
+  /// check payloadPending() after adding the payload
+  virtual void allowStreaming() {}
+
+  /// @brief whether the generation of a streamed body was paused, because
+  /// the client has not yet read the part sent so far. the handler must then
+  /// return WAITING, have itself continued by the callback passed to
+  /// waitForPayload() and call continuePayload()
+  virtual bool payloadPending() const { return false; }
+  virtual void waitForPayload(std::function<void()> const&) {}
+  virtual void continuePayload() {}
   
   /// used for head
   bool generateBody() const { return _generateBody; };
@@ -25,6 +25,8 @@
 #include "HttpRequest.h"
 #include "Basics/NumberUtils.h"
 
+#include <algorithm>
+
 #include <velocypack/Builder.h>
 #include <velocypack/Options.h>
 #include <velocypack/Parser.h>
@@ -40,6 +42,21 @@
 using namespace arangodb;
 using namespace arangodb::basics;
 
+namespace {
+// inserts or overwrites an entry without temporary strings, a later
+// occurrence of a key wins
+void setEntry(std::unordered_map<std::string, std::string>& map,
+              char const* key, size_t keyLength, char const* value,
+              size_t valueLength) {
+  auto it = map.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(key, keyLength),
+                        std::forward_as_tuple(value, valueLength));
+  if (!it.second) {
+    it.first->second.assign(value, valueLength);
+  }
+}
+}  // namespace
+
 HttpRequest::HttpRequest(ConnectionInfo const& connectionInfo,
                          char const* header, size_t length,
                          bool allowMethodOverride)
@@ -55,6 +72,9 @@ HttpRequest::HttpRequest(ConnectionInfo const& connectionInfo,
     memcpy(_header.get(), header, length);
 
     (_header.get())[length] = 0;
+
+    // one line per header, so that the map is not rehashed while parsing
+    _headers.reserve(std::count(header, header + length, '\n'));
     parseHeader(length);
   }
 }
@@ -477,7 +497,8 @@ void HttpRequest::setValues(char* buffer, char* end) {
         *(key - 2) = '\0';
         setArrayValue(keyBegin, key - keyBegin - 2, valueBegin);
       } else {
-        _values[std::string(keyBegin, key - keyBegin)] = std::string(valueBegin, value - valueBegin);
+        setEntry(_values, keyBegin, key - keyBegin, valueBegin,
+                 value - valueBegin);
       }
 
       keyBegin = key = buffer + 1;
@@ -536,7 +557,8 @@ void HttpRequest::setValues(char* buffer, char* end) {
       *(key - 2) = '\0';
       setArrayValue(keyBegin, key - keyBegin - 2, valueBegin);
     } else {
-      _values[std::string(keyBegin, key - keyBegin)] = std::string(valueBegin, value - valueBegin);
+      setEntry(_values, keyBegin, key - keyBegin, valueBegin,
+               value - valueBegin);
     }
   }
 }
@@ -594,12 +616,12 @@ void HttpRequest::setHeader(char const* key, size_t keyLength,
     }
   }
 
-  _headers[std::string(key, keyLength)] = std::string(value, valueLength);
+  setEntry(_headers, key, keyLength, value, valueLength);
 }
 
 /// @brief sets a key-only header
 void HttpRequest::setHeader(char const* key, size_t keyLength) {
-  _headers[std::string(key, keyLength)] = StaticStrings::Empty;
+  setEntry(_headers, key, keyLength, "", 0);
 }
 
 void HttpRequest::setCookie(char* key, size_t length, char const* value) {
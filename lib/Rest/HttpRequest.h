@@ -33,6 +33,7 @@ class RestBatchHandler;
 
 namespace rest {
 class GeneralCommTask;
+class H2CommTask;
 class HttpCommTask;
 }
 
@@ -43,6 +44,7 @@ struct Options;
 
 class HttpRequest final : public GeneralRequest {
   friend class rest::HttpCommTask;
+  friend class rest::H2CommTask;
   friend class rest::GeneralCommTask;
   friend class RestBatchHandler;  // TODO must be removed
 
@@ -72,6 +74,10 @@ class HttpRequest final : public GeneralRequest {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
+  // the id of the HTTP/2 stream, 1 for HTTP/1.x
+  uint64_t messageId() const override { return _messageId; }
+  void setMessageId(uint64_t messageId) { _messageId = messageId; }
+
   std::string const& cookieValue(std::string const& key) const;
   std::string const& cookieValue(std::string const& key, bool& found) const;
   std::unordered_map<std::string, std::string> cookieValues() const {
@@ -119,6 +125,7 @@ class HttpRequest final : public GeneralRequest {
  private:
   std::unordered_map<std::string, std::string> _cookies;
   int64_t _contentLength;
+  uint64_t _messageId = 1;
   std::unique_ptr<char[]> _header;
   std::string _body;
 
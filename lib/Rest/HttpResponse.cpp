@@ -26,6 +26,7 @@
 
 #include <velocypack/Builder.h>
 #include <velocypack/Dumper.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/Options.h>
 #include <velocypack/velocypack-aliases.h>
 
@@ -42,8 +43,25 @@
 using namespace arangodb;
 using namespace arangodb::basics;
 
+namespace {
+// size of the parts in which a streamed body is handed to the comm task
+size_t const StreamChunkSize = 64 * 1024;
+}
+
 bool HttpResponse::HIDE_PRODUCT_HEADER = false;
 
+// a streamed JSON body is generated one member of the top-level array, or of
+// an array in the top-level object, at a time. the generation can pause in
+// between while the client is behind
+struct HttpResponse::PendingPayload {
+  // holds the payload, without externals and custom types
+  VPackBuffer<uint8_t> buffer;
+  VPackOptions options;
+  // the iterators point into the buffer
+  std::unique_ptr<VPackObjectIterator> attributes;
+  std::unique_ptr<VPackArrayIterator> members;
+};
+
 HttpResponse::HttpResponse(ResponseCode code)
   : HttpResponse(code, new StringBuffer(false)) {}
 
@@ -52,7 +70,11 @@ HttpResponse::HttpResponse(ResponseCode code,
     : GeneralResponse(code),
       _isHeadResponse(false),
       _body(buffer),
-      _bodySize(0) {
+      _bodySize(0),
+      _allowStreaming(false),
+      _streamed(false),
+      _streamBroken(false),
+      _streamedLength(0) {
   TRI_ASSERT(buffer);
   _generateBody = false;
   _contentType = ContentType::TEXT;
@@ -78,6 +100,11 @@ void HttpResponse::reset(ResponseCode code) {
   TRI_ASSERT(_body != nullptr);
   _body->clear();
   _bodySize = 0;
+  _pendingPayload.reset();
+  if (_streamed) {
+    // the client already received the original header
+    _streamBroken = true;
+  }
 }
 
 void HttpResponse::setCookie(std::string const& name, std::string const& value,
@@ -147,7 +174,17 @@ size_t HttpResponse::bodySize() const {
     return _bodySize;
   }
   TRI_ASSERT(_body != nullptr);
-  return _body->length();
+  return _streamedLength + _body->length();
+}
+
+int HttpResponse::deflate(size_t bufferSize) {
+  TRI_ASSERT(_body != nullptr);
+  int res = _body->deflate(bufferSize);
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+  setHeaderNC(StaticStrings::ContentEncoding, "deflate");
+  return TRI_ERROR_NO_ERROR;
 }
 
 void HttpResponse::writeHeader(StringBuffer* output) {
@@ -341,13 +378,14 @@ void HttpResponse::addPayload(VPackBuffer<uint8_t>&& buffer,
 
   if (buffer.size() > 0) {
     addPayloadInternal(VPackSlice(buffer.data()), buffer.length(),
-                       options, resolveExternals);
+                       options, resolveExternals, &buffer);
   }
 }
 
 void HttpResponse::addPayloadInternal(VPackSlice output, size_t inputLength,
                                       VPackOptions const* options,
-                                      bool resolveExternals) {
+                                      bool resolveExternals,
+                                      VPackBuffer<uint8_t>* buffer) {
   if (!options) {
     options = &velocypack::Options::Defaults;
   }
@@ -378,7 +416,38 @@ void HttpResponse::addPayloadInternal(VPackSlice output, size_t inputLength,
     }
     default: {
       setContentType(rest::ContentType::JSON);
-      if (_generateBody) {
+      if (_generateBody && _allowStreaming && _bodyStream &&
+          inputLength >= StreamChunkSize &&
+          (output.isObject() || output.isArray())) {
+        // the generation of the body may pause, so the payload must outlive
+        // the call
+        auto pending = std::make_unique<PendingPayload>();
+        pending->options = *options;
+        if (VelocyPackHelper::hasNonClientTypes(output, true, true)) {
+          pending->buffer.reserve(inputLength);
+          VPackBuilder builder(pending->buffer, options);
+          VelocyPackHelper::sanitizeNonClientTypes(
+              output, VPackSlice::noneSlice(), builder, options, true, true);
+        } else if (buffer != nullptr) {
+          pending->buffer = std::move(*buffer);
+        } else {
+          pending->buffer.append(output.start(), output.byteSize());
+        }
+        // the handler of the custom types may be gone when the generation
+        // continues
+        pending->options.customTypeHandler = nullptr;
+
+        VPackSlice const value(pending->buffer.data());
+        if (value.isObject()) {
+          _body->appendChar('{');
+          pending->attributes.reset(new VPackObjectIterator(value, true));
+        } else {
+          _body->appendChar('[');
+          pending->members.reset(new VPackArrayIterator(value));
+        }
+        _pendingPayload = std::move(pending);
+        continuePayload();
+      } else if (_generateBody) {
         arangodb::basics::VelocyPackDumper dumper(_body, options);
         dumper.dumpValue(output);
       } else {
@@ -399,3 +468,66 @@ void HttpResponse::addPayloadInternal(VPackSlice output, size_t inputLength,
   }
 }
 
+void HttpResponse::waitForPayload(std::function<void()> const& callback) {
+  TRI_ASSERT(_pendingPayload != nullptr);
+  TRI_ASSERT(_bodyStreamWait);
+  _bodyStreamWait(callback);
+}
+
+void HttpResponse::continuePayload() {
+  TRI_ASSERT(_pendingPayload != nullptr);
+  PendingPayload& pending = *_pendingPayload;
+  VPackSlice const value(pending.buffer.data());
+
+  arangodb::basics::VelocyPackDumper dumper(_body, &pending.options);
+  // a single large value is sent in parts, but not paused
+  dumper.setFlush(StreamChunkSize, [this]() { _bodyStream(*this); });
+
+  while (true) {
+    if (pending.members != nullptr) {
+      VPackArrayIterator& it = *pending.members;
+      if (it.valid()) {
+        if (_body->length() >= StreamChunkSize && _bodyStream(*this)) {
+          // the client is behind. the handler is continued once it has
+          // caught up
+          return;
+        }
+        if (!it.isFirst()) {
+          _body->appendChar(',');
+        }
+        dumper.dumpValue(it.value(), &value);
+        it.next();
+        continue;
+      }
+      _body->appendChar(']');
+      pending.members.reset();
+      if (pending.attributes == nullptr) {
+        // the top-level array is complete
+        break;
+      }
+      pending.attributes->next();
+      continue;
+    }
+
+    VPackObjectIterator& it = *pending.attributes;
+    if (!it.valid()) {
+      _body->appendChar('}');
+      break;
+    }
+    if (!it.isFirst()) {
+      _body->appendChar(',');
+    }
+    dumper.dumpValue(it.key().makeKey(), &value);
+    _body->appendChar(':');
+    VPackSlice const attribute = it.value();
+    if (attribute.isArray()) {
+      _body->appendChar('[');
+      pending.members.reset(new VPackArrayIterator(attribute));
+      continue;
+    }
+    dumper.dumpValue(attribute, &value);
+    it.next();
+  }
+
+  _pendingPayload.reset();
+}
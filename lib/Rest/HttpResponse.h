@@ -34,11 +34,13 @@ class RestBatchHandler;
 
 namespace rest {
 class HttpCommTask;
+class H2CommTask;
 class GeneralCommTask;
 }
 
 class HttpResponse : public GeneralResponse {
   friend class rest::HttpCommTask;
+  friend class rest::H2CommTask;
   friend class rest::GeneralCommTask;
   friend class RestBatchHandler;  // TODO must be removed
 
@@ -73,6 +75,7 @@ class HttpResponse : public GeneralResponse {
     TRI_ASSERT(_body);
     return *_body;
   }
+  // includes the parts of the body which were already sent
   size_t bodySize() const;
 
   // you should call writeHeader only after the body has been created
@@ -95,15 +98,27 @@ class HttpResponse : public GeneralResponse {
   }
   
   int reservePayload(std::size_t size) override { return _body->reserve(size); }
+
+  void allowStreaming() override { _allowStreaming = true; }
+
+  bool payloadPending() const override { return _pendingPayload != nullptr; }
+  void waitForPayload(std::function<void()> const&) override;
+  void continuePayload() override;
   
   arangodb::Endpoint::TransportType transportType() override {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
- private:
-  // the body must already be set. deflate is then run on the existing body
+  // the id of the HTTP/2 stream, 1 for HTTP/1.x
+  uint64_t messageId() const override { return _messageId; }
+  void setMessageId(uint64_t messageId) { _messageId = messageId; }
+
+  // the body must already be set. deflate is then run on the existing body,
+  // and the content-encoding header is set
   int deflate(size_t = 16384);
 
+ private:
+
   std::unique_ptr<basics::StringBuffer> stealBody() {
     std::unique_ptr<basics::StringBuffer> bb(_body);
     _body = nullptr;
@@ -112,12 +127,32 @@ class HttpResponse : public GeneralResponse {
   
  private:
   bool _isHeadResponse;
+  uint64_t _messageId = 1;
   std::vector<std::string> _cookies;
   basics::StringBuffer *_body;
   size_t _bodySize;
+
+  // takes over the part of the body generated so far, and returns true if
+  // the client is behind. set by the comm task if the connection can send a
+  // body in chunks
+  std::function<bool(HttpResponse&)> _bodyStream;
+  // invokes the callback once the client has caught up, or the connection
+  // is closed
+  std::function<void(std::function<void()> const&)> _bodyStreamWait;
+  bool _allowStreaming;
+  // a part of the body was sent, the header can no longer be changed
+  bool _streamed;
+  // the response was reset after a part of the body was sent
+  bool _streamBroken;
+  size_t _streamedLength;
+
+  // the rest of a JSON body whose generation was paused
+  struct PendingPayload;
+  std::unique_ptr<PendingPayload> _pendingPayload;
     
   void addPayloadInternal(velocypack::Slice, size_t,
-                          velocypack::Options const*, bool);
+                          velocypack::Options const*, bool,
+                          velocypack::Buffer<uint8_t>* = nullptr);
 };
 }
 
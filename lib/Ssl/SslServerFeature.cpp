@@ -34,6 +34,28 @@ using namespace arangodb::options;
 
 SslServerFeature* SslServerFeature::SSL = nullptr;
 
+#if defined(USE_NGHTTP2) && OPENSSL_VERSION_NUMBER >= 0x10002000L
+namespace {
+// prefer HTTP/2 if the client offers it. the protocols are length-prefixed
+int selectAlpnProtocol(SSL*, unsigned char const** out, unsigned char* outlen,
+                       unsigned char const* in, unsigned int inlen, void*) {
+  for (char const* protocol : {"h2", "http/1.1"}) {
+    size_t const length = strlen(protocol);
+
+    for (unsigned int i = 0; i < inlen; i += 1 + in[i]) {
+      if (in[i] == length && i + 1 + length <= inlen &&
+          memcmp(in + i + 1, protocol, length) == 0) {
+        *out = in + i + 1;
+        *outlen = in[i];
+        return SSL_TLSEXT_ERR_OK;
+      }
+    }
+  }
+  return SSL_TLSEXT_ERR_NOACK;
+}
+}  // namespace
+#endif
+
 SslServerFeature::SslServerFeature(
     application_features::ApplicationServer& server
 )
@@ -41,6 +63,9 @@ SslServerFeature::SslServerFeature(
       _cafile(),
       _keyfile(),
       _sessionCache(false),
+      _sessionTickets(true),
+      _sessionTimeout(300),
+      _kernelTls(false),
       _cipherList("HIGH:!EXPORT:!aNULL@STRENGTH"),
       _sslProtocol(TLS_V12),
       _sslOptions(asio::ssl::context::default_workarounds | asio::ssl::context::single_dh_use),
@@ -69,6 +94,21 @@ void SslServerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      "enable the session cache for connections",
                      new BooleanParameter(&_sessionCache));
 
+  options->addOption("--ssl.session-tickets",
+                     "enable session tickets for connections",
+                     new BooleanParameter(&_sessionTickets));
+
+  options->addHiddenOption("--ssl.session-timeout",
+                           "lifetime of cached sessions and session tickets "
+                           "in seconds",
+                           new UInt64Parameter(&_sessionTimeout));
+
+  options->addHiddenOption("--ssl.kernel-tls",
+                           "let the kernel encrypt and decrypt connections "
+                           "after the handshake (kTLS, Linux only, needs "
+                           "OpenSSL 3.0 or higher built with kTLS support)",
+                           new BooleanParameter(&_kernelTls));
+
   options->addOption("--ssl.cipher-list",
                      "ssl ciphers to use, see OpenSSL documentation",
                      new StringParameter(&_cipherList));
@@ -96,6 +136,15 @@ void SslServerFeature::validateOptions(std::shared_ptr<ProgramOptions> options)
     LOG_TOPIC(FATAL, arangodb::Logger::SSL) << "SSLv2 is not supported any longer because of security vulnerabilities in this protocol";
     FATAL_ERROR_EXIT();
   }
+
+#ifndef SSL_OP_ENABLE_KTLS
+  if (_kernelTls) {
+    LOG_TOPIC(WARN, arangodb::Logger::SSL)
+        << "kernel TLS is not supported by this OpenSSL version, ignoring "
+           "'--ssl.kernel-tls'";
+    _kernelTls = false;
+  }
+#endif
 }
 
 void SslServerFeature::prepare() {
@@ -145,7 +194,7 @@ void SslServerFeature::verifySslOptions() {
   }
 
   try {
-    createSslContext();
+    _sslContext = std::make_shared<asio::ssl::context>(createSslContext());
   } catch (...) {
     LOG_TOPIC(FATAL, arangodb::Logger::SSL) << "cannot create SSL context";
     FATAL_ERROR_EXIT();
@@ -181,10 +230,23 @@ asio::ssl::context SslServerFeature::createSslContext() const {
     if (_sessionCache) {
       LOG_TOPIC(TRACE, arangodb::Logger::SSL) << "using SSL session caching";
     }
+    SSL_CTX_set_timeout(nativeContext, static_cast<long>(_sessionTimeout));
 
     // set options
     sslContext.set_options(static_cast<long>(_sslOptions));
 
+    if (!_sessionTickets) {
+      SSL_CTX_set_options(nativeContext, SSL_OP_NO_TICKET);
+    }
+
+#ifdef SSL_OP_ENABLE_KTLS
+    if (_kernelTls) {
+      // OpenSSL hands the keys to the kernel after the handshake, if the
+      // kernel supports the cipher. otherwise it silently stays in user space
+      SSL_CTX_set_options(nativeContext, SSL_OP_ENABLE_KTLS);
+    }
+#endif
+
     if (!_cipherList.empty()) {
       if (SSL_CTX_set_cipher_list(nativeContext, _cipherList.c_str()) != 1) {
         LOG_TOPIC(ERR, arangodb::Logger::SSL) << "cannot set SSL cipher list '"
@@ -286,6 +348,11 @@ asio::ssl::context SslServerFeature::createSslContext() const {
       SSL_CTX_set_client_CA_list(nativeContext, certNames);
     }
 
+#if defined(USE_NGHTTP2) && OPENSSL_VERSION_NUMBER >= 0x10002000L
+    // HTTP/2 over TLS is negotiated via ALPN
+    SSL_CTX_set_alpn_select_cb(nativeContext, selectAlpnProtocol, nullptr);
+#endif
+
     sslContext.set_verify_mode(SSL_VERIFY_NONE);
 
     return sslContext;
@@ -47,10 +47,21 @@ class SslServerFeature : public application_features::ApplicationFeature {
 
   virtual asio::ssl::context createSslContext() const;
 
+  /// @brief the context shared by all server connections, so that they
+  /// share the session cache and the session ticket keys. created by
+  /// verifySslOptions
+  std::shared_ptr<asio::ssl::context> sslContext() const {
+    TRI_ASSERT(_sslContext != nullptr);
+    return _sslContext;
+  }
+
  protected:
   std::string _cafile;
   std::string _keyfile;
   bool _sessionCache;
+  bool _sessionTickets;
+  uint64_t _sessionTimeout;
+  bool _kernelTls;
   std::string _cipherList;
   uint64_t _sslProtocol;
   uint64_t _sslOptions;
@@ -60,6 +71,7 @@ class SslServerFeature : public application_features::ApplicationFeature {
   std::string stringifySslOptions(uint64_t opts) const;
 
   std::string _rctx;
+  std::shared_ptr<asio::ssl::context> _sslContext;
 };
 
 }
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for RebalanceShards job
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include "fakeit.hpp"
+
+#include "Agency/AgentInterface.h"
+#include "Agency/Node.h"
+#include "Agency/RebalanceShards.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::consensus;
+using namespace fakeit;
+
+namespace arangodb {
+namespace tests {
+namespace rebalance_shards_test {
+
+const std::string PREFIX = "arango";
+const std::string JOBID = "1";
+
+const char *agency =
+#include "RebalanceShardsTest.json"
+;
+
+Node createAgency() {
+  VPackOptions options;
+  options.checkAttributeUniqueness = true;
+  VPackParser parser(&options);
+  parser.parse(agency);
+
+  VPackBuilder builder;
+  { VPackObjectBuilder a(&builder);
+    builder.add("new", parser.steal()->slice()); }
+
+  Node root("");
+  root.handle<SET>(builder.slice());
+  return root(PREFIX);
+}
+
+VPackBuilder createJob() {
+  VPackBuilder builder;
+  {
+    VPackObjectBuilder a(&builder);
+    builder.add("creator", VPackValue("unittest"));
+    builder.add("type", VPackValue("rebalanceShards"));
+    builder.add("maxMoves", VPackValue(2));
+    builder.add("jobId", VPackValue(JOBID));
+    builder.add("timeCreated", VPackValue(
+                           timepointToString(std::chrono::system_clock::now())));
+  }
+  return builder;
+}
+
+TEST_CASE("RebalanceShards", "[agency][supervision]") {
+
+SECTION("leaders are moved before followers") {
+  Node agency = createAgency();
+  auto servers = RebalanceShards::candidateServers(agency);
+  REQUIRE(servers.size() == 3);
+
+  auto moves = RebalanceShards::planMoves(agency, servers, 10);
+  REQUIRE(moves.size() == 3);
+
+  // "b" holds all shards, so leaders can only go to "c"
+  CHECK(moves[0].isLeader);
+  CHECK(moves[0].from == "a");
+  CHECK(moves[0].to == "c");
+  CHECK(moves[1].isLeader);
+  CHECK(moves[1].from == "a");
+  CHECK(moves[1].to == "c");
+  CHECK(moves[0].shard != moves[1].shard);
+
+  CHECK(!moves[2].isLeader);
+  CHECK(moves[2].from == "b");
+  CHECK(moves[2].to == "c");
+  CHECK(moves[2].shard != moves[0].shard);
+  CHECK(moves[2].shard != moves[1].shard);
+}
+
+SECTION("the number of moves is limited") {
+  Node agency = createAgency();
+  auto moves = RebalanceShards::planMoves(
+    agency, RebalanceShards::candidateServers(agency), 1);
+  REQUIRE(moves.size() == 1);
+  CHECK(moves[0].isLeader);
+}
+
+SECTION("a balanced plan needs no moves") {
+  Node agency = createAgency();
+  VPackBuilder builder;
+  { VPackArrayBuilder a(&builder);
+    builder.add(VPackValue("c"));
+    builder.add(VPackValue("a")); }
+  agency("/Plan/Collections/database/collection/shards/s1") = builder.slice();
+  agency("/Plan/Collections/database/collection/shards/s2") = builder.slice();
+  builder.clear();
+  { VPackArrayBuilder a(&builder);
+    builder.add(VPackValue("b"));
+    builder.add(VPackValue("c")); }
+  agency("/Plan/Collections/database/collection/shards/s3") = builder.slice();
+
+  auto moves = RebalanceShards::planMoves(
+    agency, RebalanceShards::candidateServers(agency), 10);
+  CHECK(moves.empty());
+}
+
+SECTION("blocked shards and unhealthy servers are left alone") {
+  Node agency = createAgency();
+  agency("/Supervision/Shards/s1") = VPackParser::fromJson("\"2\"")->slice();
+  agency("/Supervision/Health/c/Status") = VPackParser::fromJson("\"BAD\"")->slice();
+
+  auto servers = RebalanceShards::candidateServers(agency);
+  CHECK(servers.size() == 2);
+  CHECK(RebalanceShards::planMoves(agency, servers, 10).empty());
+
+  agency("/Supervision/Health/c/Status") = VPackParser::fromJson("\"GOOD\"")->slice();
+  auto moves = RebalanceShards::planMoves(
+    agency, RebalanceShards::candidateServers(agency), 10);
+  REQUIRE(!moves.empty());
+  for (auto const& move : moves) {
+    CHECK(move.shard != "s1");
+  }
+}
+
+SECTION("distributeShardsLike followers add to the weight of a shard") {
+  auto countLeaderMoves = [](Node const& agency) {
+    size_t count = 0;
+    for (auto const& move : RebalanceShards::planMoves(
+           agency, RebalanceShards::candidateServers(agency), 10)) {
+      if (move.isLeader) {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  Node agency = createAgency();
+  agency("/Plan/Collections/database/other/shards/t1") =
+    VPackParser::fromJson("[\"c\", \"b\"]")->slice();
+  CHECK(countLeaderMoves(agency) == 1);
+
+  // with a follower, every shard of "collection" weighs 2, which makes a
+  // second leader move to "c" worthwhile
+  agency("/Plan/Collections/database/follower/distributeShardsLike") =
+    VPackParser::fromJson("\"collection\"")->slice();
+  CHECK(countLeaderMoves(agency) == 2);
+}
+
+SECTION("starting the job schedules the first batch of moves") {
+  Node agency = createAgency();
+  agency("/Target/ToDo/" + JOBID) = createJob().slice();
+
+  write_ret_t fakeWriteResult {true, "", std::vector<apply_ret_t> {APPLIED}, std::vector<index_t> {1}};
+  Mock<AgentInterface> mockAgent;
+  When(Method(mockAgent, write)).Do([&](query_t const& q, consensus::AgentInterface::WriteMode w) -> write_ret_t {
+    INFO("WRITE: " << q->toJson());
+    REQUIRE(q->slice().length() == 1);
+    auto writes = q->slice()[0][0];
+    CHECK(writes.get("/arango/Target/ToDo/" + JOBID).get("op").copyString() == "delete");
+    auto job = writes.get("/arango/Target/Pending/" + JOBID);
+    REQUIRE(job.isObject());
+    CHECK(job.get("movesScheduled").getNumber<uint64_t>() == 2);
+    CHECK(writes.get("/arango/Target/ToDo/" + JOBID + "-0").get("type").copyString() == "moveShard");
+    CHECK(writes.get("/arango/Target/ToDo/" + JOBID + "-1").get("type").copyString() == "moveShard");
+    CHECK(writes.get("/arango/Target/ToDo/" + JOBID + "-2").isNone());
+    return fakeWriteResult;
+  });
+  AgentInterface &agent = mockAgent.get();
+
+  RebalanceShards job(agency, &agent, JOB_STATUS::TODO, JOBID);
+  CHECK(job.start());
+  Verify(Method(mockAgent, write));
+}
+
+}
+
+}}}
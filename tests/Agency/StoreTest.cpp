@@ -30,6 +30,9 @@
 
 #include "Agency/Store.h"
 
+#include <velocypack/Compare.h>
+#include <velocypack/Parser.h>
+
 TEST_CASE("Store", "[agency]") {
 
   SECTION("Store preconditions") {
@@ -72,5 +75,61 @@ TEST_CASE("Store", "[agency]") {
     REQUIRE(node == other.slice());
 
   }
+
+  SECTION("Reads see writes to serialized subtrees") {
+
+    using namespace arangodb::consensus;
+
+    Store store(nullptr);
+    auto write = [&store](std::string const& json) {
+      auto query = VPackParser::fromJson(json);
+      auto result = store.applyTransactions(query);
+      REQUIRE(result.size() == 1);
+      REQUIRE(result[0] == APPLIED);
+    };
+    auto read = [&store](std::string const& json, std::string const& expected) {
+      auto query = VPackParser::fromJson(json);
+      auto result = std::make_shared<VPackBuilder>();
+      store.read(query, result);
+      return arangodb::velocypack::NormalizedCompare::equals(
+          result->slice()[0], VPackParser::fromJson(expected)->slice());
+    };
+
+    write(R"=([[{"/a/b":{"c":1,"d":2}}]])=");
+    REQUIRE(read(R"=([["/a/b"]])=", R"=({"a":{"b":{"c":1,"d":2}}})="));
+    REQUIRE(read(R"=([["/a/b"]])=", R"=({"a":{"b":{"c":1,"d":2}}})="));
+
+    // below, above and at the serialized path
+    write(R"=([[{"/a/b/c":3}]])=");
+    REQUIRE(read(R"=([["/a/b"]])=", R"=({"a":{"b":{"c":3,"d":2}}})="));
+    write(R"=([[{"/a":{"b":{"e":4}}}]])=");
+    REQUIRE(read(R"=([["/a/b"]])=", R"=({"a":{"b":{"e":4}}})="));
+    write(R"=([[{"/a/b":{"op":"delete"}}]])=");
+    REQUIRE(read(R"=([["/a/b"]])=", R"=({})="));
+
+  }
+
+  SECTION("Serializations of unmodified nodes are reused") {
+
+    using namespace arangodb::consensus;
+
+    Node node("node");
+    node("a/b") = VPackParser::fromJson(R"=({"x":1})=")->slice();
+    node("a/c") = VPackParser::fromJson(R"=({"y":2})=")->slice();
+
+    auto all = node.serialized();
+    auto b = node("a/b").serialized();
+    REQUIRE(node.serialized() == all);
+
+    node("a/c") = VPackParser::fromJson(R"=({"y":3})=")->slice();
+    node.invalidateSerialized({"a", "c"});
+
+    REQUIRE(node.serialized() != all);
+    REQUIRE(node("a/b").serialized() == b);
+    REQUIRE(arangodb::velocypack::NormalizedCompare::equals(
+        node.serialized()->slice(),
+        VPackParser::fromJson(R"=({"a":{"b":{"x":1},"c":{"y":3}}})=")->slice()));
+
+  }
   
 }
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ResourceUsage.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql_item_block_binary {
+
+static void appendUInt(std::string& out, uint64_t value, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    out.push_back(static_cast<char>(value & 0xffU));
+    value >>= 8;
+  }
+}
+
+static std::string makeBinary(uint32_t nrItems, uint32_t nrRegs,
+                              std::string const& payload) {
+  std::string result;
+  result.push_back(static_cast<char>(AqlItemBlock::BinaryFormatVersion));
+  result.push_back(0);
+  appendUInt(result, 0, 2);
+  appendUInt(result, nrItems, 4);
+  appendUInt(result, nrRegs, 4);
+  appendUInt(result, payload.size(), 4);
+  result.append(payload);
+  return result;
+}
+
+static void appendValue(std::string& out, VPackSlice slice) {
+  out.push_back(1);
+  out.append(slice.startAs<char>(), slice.byteSize());
+}
+
+static std::unique_ptr<AqlItemBlock> decode(ResourceMonitor& monitor,
+                                            std::string const& data) {
+  return AqlItemBlock::fromBinary(
+      &monitor, reinterpret_cast<uint8_t const*>(data.data()), data.size());
+}
+
+TEST_CASE("AqlItemBlockBinaryTest", "[aql][item-block]") {
+  ResourceMonitor monitor;
+
+  SECTION("test_decode_cells") {
+    VPackBuilder number;
+    number.add(VPackValue(42));
+    VPackBuilder string;
+    string.add(VPackValue("this is a string value that is not inlined"));
+
+    std::string payload;
+    // row 0: number, empty, range 1..3
+    appendValue(payload, number.slice());
+    payload.push_back(0);
+    payload.push_back(3);
+    appendUInt(payload, 1, 8);
+    appendUInt(payload, 3, 8);
+    // row 1: string, empty, repeated range
+    appendValue(payload, string.slice());
+    payload.push_back(0);
+    payload.push_back(2);
+    // row 2: repeated string, number, repeated range
+    payload.push_back(2);
+    appendValue(payload, number.slice());
+    payload.push_back(2);
+
+    auto block = decode(monitor, makeBinary(3, 3, payload));
+    REQUIRE(block->size() == 3);
+    REQUIRE(block->getNrRegs() == 3);
+
+    CHECK(block->getValueReference(0, 0).slice().getNumber<int>() == 42);
+    CHECK(block->getValueReference(0, 1).isEmpty());
+    REQUIRE(block->getValueReference(0, 2).isRange());
+    CHECK(block->getValueReference(0, 2).range()->_low == 1);
+    CHECK(block->getValueReference(0, 2).range()->_high == 3);
+
+    CHECK(block->getValueReference(1, 0).slice().copyString() ==
+          "this is a string value that is not inlined");
+    CHECK(block->getValueReference(1, 1).isEmpty());
+    CHECK(block->getValueReference(1, 2).range() ==
+          block->getValueReference(0, 2).range());
+
+    // repeated values are shared within the block
+    CHECK(block->getValueReference(2, 0).slice().start() ==
+          block->getValueReference(1, 0).slice().start());
+    CHECK(block->valueCount(block->getValueReference(1, 0)) == 2);
+    CHECK(block->getValueReference(2, 1).slice().getNumber<int>() == 42);
+    CHECK(block->valueCount(block->getValueReference(0, 2)) == 3);
+  }
+
+  SECTION("test_decode_invalid") {
+    VPackBuilder number;
+    number.add(VPackValue(42));
+
+    // wrong version
+    std::string data = makeBinary(1, 1, std::string(1, '\0'));
+    data[0] = static_cast<char>(AqlItemBlock::BinaryFormatVersion + 1);
+    CHECK_THROWS(decode(monitor, data));
+
+    // truncated header
+    CHECK_THROWS(decode(monitor, std::string(8, '\0')));
+
+    // zero rows
+    CHECK_THROWS(decode(monitor, makeBinary(0, 1, "")));
+
+    // repeated value in the first row
+    CHECK_THROWS(decode(monitor, makeBinary(1, 1, std::string(1, '\x02'))));
+
+    // unknown tag
+    CHECK_THROWS(decode(monitor, makeBinary(1, 1, std::string(1, '\x07'))));
+
+    // too few cells
+    CHECK_THROWS(decode(monitor, makeBinary(2, 1, std::string(1, '\0'))));
+
+    // trailing garbage
+    CHECK_THROWS(decode(monitor, makeBinary(1, 1, std::string(2, '\0'))));
+
+    // truncated value
+    std::string payload;
+    appendValue(payload, number.slice());
+    payload.resize(payload.size() - 1);
+    CHECK_THROWS(decode(monitor, makeBinary(1, 1, payload)));
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for AqlItemBlockColumn
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2018, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemBlockColumn.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ResourceUsage.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql_item_block_column {
+
+TEST_CASE("AqlItemBlockColumnTest", "[aql][item-block]") {
+  ResourceMonitor monitor;
+
+  SECTION("test_numbers") {
+    AqlItemBlock block(&monitor, 3, 2);
+    block.emplaceValue(0, 1, AqlValueHintInt(42));
+    block.emplaceValue(1, 1, AqlValueHintDouble(-1.5));
+    block.emplaceValue(2, 1, AqlValueHintUInt(uint64_t(7)));
+    block.emplaceValue(0, 0, AqlValueHintBool(true));
+
+    AqlItemBlockColumn column(block, 1);
+    CHECK(column.type() == AqlItemBlockColumn::Type::NUMBERS);
+    REQUIRE(column.size() == 3);
+    CHECK(column.numbers()[0] == 42.0);
+    CHECK(column.numbers()[1] == -1.5);
+    CHECK(column.numbers()[2] == 7.0);
+    CHECK(&column.value(1) == &block.getValueReference(1, 1));
+  }
+
+  SECTION("test_bools") {
+    AqlItemBlock block(&monitor, 2, 1);
+    block.emplaceValue(0, 0, AqlValueHintBool(true));
+    block.emplaceValue(1, 0, AqlValueHintBool(false));
+
+    AqlItemBlockColumn column(block, 0);
+    CHECK(column.type() == AqlItemBlockColumn::Type::BOOLS);
+    REQUIRE(column.size() == 2);
+    CHECK(column.bools()[0] == 1);
+    CHECK(column.bools()[1] == 0);
+  }
+
+  SECTION("test_mixed") {
+    AqlItemBlock block(&monitor, 3, 1);
+    block.emplaceValue(0, 0, AqlValueHintInt(1));
+    block.emplaceValue(1, 0, AqlValueHintNull());
+    // row 2 stays empty
+
+    AqlItemBlockColumn column(block, 0);
+    CHECK(column.type() == AqlItemBlockColumn::Type::VALUES);
+    REQUIRE(column.size() == 3);
+    CHECK(column.value(0).isNumber());
+    CHECK(column.value(1).isNull(false));
+    CHECK(column.value(2).isEmpty());
+  }
+
+  SECTION("test_reset") {
+    AqlItemBlock numbers(&monitor, 2, 1);
+    numbers.emplaceValue(0, 0, AqlValueHintInt(1));
+    numbers.emplaceValue(1, 0, AqlValueHintInt(2));
+
+    AqlItemBlock bools(&monitor, 1, 1);
+    bools.emplaceValue(0, 0, AqlValueHintBool(true));
+
+    AqlItemBlockColumn column(numbers, 0);
+    CHECK(column.type() == AqlItemBlockColumn::Type::NUMBERS);
+    CHECK(column.size() == 2);
+
+    column.reset(bools, 0);
+    CHECK(column.type() == AqlItemBlockColumn::Type::BOOLS);
+    CHECK(column.size() == 1);
+  }
+}
+
+}
+}
+}
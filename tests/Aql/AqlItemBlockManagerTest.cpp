@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for AqlItemBlockManager
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2018, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemBlockManager.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ResourceUsage.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql_item_block_manager {
+
+TEST_CASE("AqlItemBlockManagerTest", "[aql][item-block]") {
+
+  SECTION("test_blocks_are_reused_across_managers") {
+    ResourceMonitor first;
+    ResourceMonitor second;
+    AqlItemBlock* block = nullptr;
+
+    {
+      AqlItemBlockManager manager(&first);
+      block = manager.requestBlock(500, 30);
+      CHECK(first.currentResources.memoryUsage == sizeof(AqlValue) * 500 * 30);
+      block->emplaceValue(0, 0, AqlValueHintInt(42));
+
+      AqlItemBlock* returned = block;
+      manager.returnBlock(returned);
+      CHECK(returned == nullptr);
+    }
+
+    // the block is not accounted for in the first monitor anymore
+    CHECK(first.currentResources.memoryUsage == 0);
+
+    AqlItemBlockManager manager(&second);
+    AqlItemBlock* reused = manager.requestBlock(400, 30);
+    CHECK(reused == block);
+    CHECK(reused->size() == 400);
+    CHECK(reused->getValueReference(0, 0).isEmpty());
+    CHECK(second.currentResources.memoryUsage == sizeof(AqlValue) * 400 * 30);
+
+    manager.returnBlock(reused);
+  }
+
+  SECTION("test_reuse_respects_memory_limit") {
+    {
+      ResourceMonitor monitor;
+      AqlItemBlockManager manager(&monitor);
+      manager.returnBlock(std::unique_ptr<AqlItemBlock>(manager.requestBlock(500, 30)));
+    }
+
+    ResourceMonitor limited(ResourceUsage(1024));
+    AqlItemBlockManager manager(&limited);
+    CHECK_THROWS(manager.requestBlock(500, 30));
+    CHECK(limited.currentResources.memoryUsage == 0);
+  }
+
+  SECTION("test_pooled_blocks_do_not_use_the_global_budget") {
+    GlobalResourceMonitor& global = GlobalResourceMonitor::instance();
+    global.setMemoryLimit(1024 * 1024 * 1024);
+
+    {
+      ResourceMonitor monitor;
+      AqlItemBlockManager manager(&monitor);
+      manager.returnBlock(std::unique_ptr<AqlItemBlock>(manager.requestBlock(500, 30)));
+      CHECK(global.currentMemoryUsage() == sizeof(AqlValue) * 500 * 30);
+    }
+
+    // the block is kept in the pool of this thread, but no query uses it
+    CHECK(global.currentMemoryUsage() == 0);
+
+    {
+      ResourceMonitor monitor;
+      AqlItemBlockManager manager(&monitor);
+      AqlItemBlock* reused = manager.requestBlock(500, 30);
+      CHECK(global.currentMemoryUsage() == sizeof(AqlValue) * 500 * 30);
+      manager.returnBlock(reused);
+    }
+
+    CHECK(global.currentMemoryUsage() == 0);
+    global.setMemoryLimit(0);
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for CompiledExpression
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+
+#include "catch.hpp"
+
+#include "QueryTestSetup.h"
+
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace batch_expression {
+
+// documents whose attribute v has all types, so that a block mixes numbers
+// with other values and the comparisons leave the numeric fast path. some
+// documents lack v, and some rows are not documents at all
+static std::string const mixed =
+    "[ { v: 0 }, { v: 1 }, { v: -2.5 }, { v: 9007199254740993 }, "
+    "{ v: null }, { }, { v: true }, { v: false }, { v: '' }, { v: 'a' }, "
+    "{ v: 'A' }, { v: 'b' }, { v: 'B' }, { v: 'ä' }, { v: 'z' }, "
+    "{ v: '1' }, { v: [ ] }, { v: [ 1 ] }, { v: { } }, { v: { w: 1 } }, "
+    "1, 'a', null ]";
+
+// documents whose attribute v is always a number, so that the comparisons
+// take the numeric fast path. the large integers are not exactly
+// representable as doubles
+static std::string const numbers =
+    "[ { v: 0 }, { v: 1 }, { v: -2.5 }, { v: 3.5 }, { v: 7 }, "
+    "{ v: 9007199254740992 }, { v: 9007199254740993 }, "
+    "{ v: -9007199254740993 } ]";
+
+static std::string query(std::string const& values,
+                         std::string const& expression) {
+  return "FOR a IN " + values + " RETURN " + expression;
+}
+
+/// @brief executes the expression, which is evaluated for the whole block
+/// at once, and wrapped into NOOPT, which is evaluated row by row via
+/// Expression::execute, and compares the results
+static void compare(TRI_vocbase_t& vocbase, std::string const& values,
+                    std::string const& expression) {
+  INFO(expression);
+
+  auto batch = executeQuery(vocbase, query(values, expression));
+  REQUIRE(TRI_ERROR_NO_ERROR == batch.code);
+  auto interpreted =
+      executeQuery(vocbase, query(values, "NOOPT(" + expression + ")"));
+  REQUIRE(TRI_ERROR_NO_ERROR == interpreted.code);
+
+  VPackSlice batchSlice = batch.result->slice();
+  VPackSlice interpretedSlice = interpreted.result->slice();
+  REQUIRE(batchSlice.length() == interpretedSlice.length());
+
+  VPackArrayIterator it(interpretedSlice);
+  for (auto const& value : VPackArrayIterator(batchSlice)) {
+    INFO(value.toJson() + " vs. " + (*it).toJson());
+    CHECK(0 == basics::VelocyPackHelper::compare(value, *it, true));
+    it.next();
+  }
+}
+
+TEST_CASE("BatchExpressionTest", "[aql][expression]") {
+  AqlQuerySetup s;
+  UNUSED(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  SECTION("test_numbers") {
+    for (auto const& op : { "==", "!=", "<", "<=", ">", ">=" }) {
+      std::string const o(op);
+      compare(vocbase, numbers, "a.v " + o + " 1");
+      compare(vocbase, numbers, "a.v " + o + " 3.5");
+      compare(vocbase, numbers, "a.v " + o + " 9007199254740992");
+      compare(vocbase, numbers, "9007199254740993 " + o + " a.v");
+    }
+  }
+
+  SECTION("test_mixed_types") {
+    for (auto const& op : { "==", "!=", "<", "<=", ">", ">=" }) {
+      std::string const o(op);
+      compare(vocbase, mixed, "a.v " + o + " 1");
+      compare(vocbase, mixed, "a.v " + o + " null");
+      compare(vocbase, mixed, "a.v " + o + " false");
+      compare(vocbase, mixed, "a.v " + o + " [ 1 ]");
+      compare(vocbase, mixed, "a.v " + o + " { w: 1 }");
+      compare(vocbase, mixed, "a.v.w " + o + " 1");
+      compare(vocbase, mixed, "a " + o + " 1");
+      compare(vocbase, mixed, "null " + o + " a.v");
+    }
+  }
+
+  SECTION("test_strings") {
+    // == and != compare strings binary, the ordering comparisons use the
+    // collation
+    for (auto const& op : { "==", "!=", "<", "<=", ">", ">=" }) {
+      std::string const o(op);
+      compare(vocbase, mixed, "a.v " + o + " 'a'");
+      compare(vocbase, mixed, "a.v " + o + " 'B'");
+      compare(vocbase, mixed, "a.v " + o + " 'ä'");
+      compare(vocbase, mixed, "a.v " + o + " '1'");
+      compare(vocbase, mixed, "'b' " + o + " a.v");
+    }
+  }
+
+  SECTION("test_logic") {
+    compare(vocbase, mixed, "a.v > 0 && a.v < 'b'");
+    compare(vocbase, mixed, "a.v == null || a.v >= 'B'");
+    compare(vocbase, mixed, "!(a.v <= 1)");
+    compare(vocbase, mixed, "!(a.v == 'a' || a.v == 'A') && a.v != null");
+    compare(vocbase, numbers, "a.v > 0 && !(a.v >= 9007199254740993)");
+  }
+
+  SECTION("test_logic_on_non_booleans") {
+    // && and || return one of their operands, and ! converts its operand
+    // to a boolean. these are left to Expression::execute
+    compare(vocbase, mixed, "a.v && a.v > 0");
+    compare(vocbase, mixed, "a.v > 0 || a.v");
+    compare(vocbase, mixed, "a.v.w || a.v == 'a'");
+    compare(vocbase, mixed, "!a.v");
+    compare(vocbase, mixed, "!a.v && a.v != null");
+    compare(vocbase, mixed, "!(a.v > 0) || !a");
+  }
+}
+
+}
+}
+}
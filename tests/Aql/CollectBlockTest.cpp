@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for CompiledExpression
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+
+#include "catch.hpp"
+
+#include "QueryTestSetup.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace collect_block {
+
+TEST_CASE("CollectBlockTest", "[aql][collect]") {
+  AqlQuerySetup s;
+  UNUSED(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  // the table for 100000 groups needs several megabytes
+  std::string const options = "{ \"memoryLimit\": 2000000 }";
+
+  SECTION("test_few_groups_within_memory_limit") {
+    auto result = executeQueryWithOptions(
+        vocbase,
+        "FOR i IN 1..100000 COLLECT x = i % 10 WITH COUNT INTO n "
+        "RETURN [ x, n ]",
+        options);
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    CHECK(10 == result.result->slice().length());
+  }
+
+  SECTION("test_many_groups_exceed_memory_limit") {
+    auto result = executeQueryWithOptions(
+        vocbase,
+        "FOR i IN 1..100000 COLLECT x = i WITH COUNT INTO n "
+        "OPTIONS { method: 'hash' } RETURN [ x, n ]",
+        options);
+    CHECK(TRI_ERROR_RESOURCE_LIMIT == result.code);
+  }
+
+  SECTION("test_many_groups_without_memory_limit") {
+    auto result = executeQueryWithOptions(
+        vocbase,
+        "FOR i IN 1..100000 COLLECT x = i WITH COUNT INTO n "
+        "OPTIONS { method: 'hash' } RETURN [ x, n ]",
+        "{ }");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    CHECK(100000 == result.result->slice().length());
+  }
+}
+
+}
+}
+}
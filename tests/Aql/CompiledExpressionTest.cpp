@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for CompiledExpression
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "QueryTestSetup.h"
+
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace compiled_expression {
+
+// operands of all types, which the compiled expressions convert to numbers
+// the same way the interpreter does
+static std::string const values =
+    "[ 0, 1, -2, 3.5, 7, null, true, false, '', '12', 'abc', [ ], [ 4 ], "
+    "[ 1, 2 ], { }, { a: 1 } ]";
+
+static std::string query(std::string const& expression) {
+  return "FOR a IN " + values + " FOR b IN " + values + " RETURN " + expression;
+}
+
+/// @brief whether the calculation of the returned value is compiled
+static bool isCompiled(TRI_vocbase_t& vocbase, std::string const& queryString) {
+  auto result = explainQueryWithOptions(vocbase, queryString, "{ }");
+  REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+  VPackSlice nodes = result.result->slice().get("nodes");
+
+  uint64_t returned = 0;
+  for (auto const& node : VPackArrayIterator(nodes)) {
+    if (node.get("type").copyString() == "ReturnNode") {
+      returned = node.get("inVariable").get("id").getNumber<uint64_t>();
+    }
+  }
+  for (auto const& node : VPackArrayIterator(nodes)) {
+    if (node.get("type").copyString() == "CalculationNode" &&
+        node.get("outVariable").get("id").getNumber<uint64_t>() == returned) {
+      return node.get("expressionType").copyString() == "compiled";
+    }
+  }
+  return false;
+}
+
+/// @brief executes the expression compiled, and wrapped into NOOPT, which
+/// is not compiled, and compares the results and warnings
+static void compare(TRI_vocbase_t& vocbase, std::string const& expression) {
+  INFO(expression);
+
+  std::string const compiledQuery = query(expression);
+  std::string const interpretedQuery = query("NOOPT(" + expression + ")");
+  CHECK(isCompiled(vocbase, compiledQuery));
+  CHECK(!isCompiled(vocbase, interpretedQuery));
+
+  auto compiled = executeQuery(vocbase, compiledQuery);
+  REQUIRE(TRI_ERROR_NO_ERROR == compiled.code);
+  auto interpreted = executeQuery(vocbase, interpretedQuery);
+  REQUIRE(TRI_ERROR_NO_ERROR == interpreted.code);
+
+  VPackSlice compiledSlice = compiled.result->slice();
+  VPackSlice interpretedSlice = interpreted.result->slice();
+  REQUIRE(compiledSlice.length() == interpretedSlice.length());
+
+  VPackArrayIterator it(interpretedSlice);
+  for (auto const& value : VPackArrayIterator(compiledSlice)) {
+    INFO(value.toJson() + " vs. " + (*it).toJson());
+    // integers and doubles compare equal, other types do not
+    CHECK(0 == basics::VelocyPackHelper::compare(value, *it, true));
+    it.next();
+  }
+
+  // division by zero is reported the same way
+  CHECK(0 == basics::VelocyPackHelper::compare(
+                 compiled.extra->slice().get("warnings"),
+                 interpreted.extra->slice().get("warnings"), true));
+}
+
+TEST_CASE("CompiledExpressionTest", "[aql][expression]") {
+  AqlQuerySetup s;
+  UNUSED(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  SECTION("test_arithmetic") {
+    compare(vocbase, "a + b * 2");
+    compare(vocbase, "(a - b) * (a + b)");
+    compare(vocbase, "a * b - a");
+    compare(vocbase, "(a + b) / 3");
+    compare(vocbase, "a % 3 + b");
+    compare(vocbase, "-(a + b) * 2");
+    compare(vocbase, "+(a - b) - 1");
+  }
+
+  SECTION("test_division_by_zero") {
+    compare(vocbase, "a / b + 1");
+    compare(vocbase, "a % b - 1");
+    compare(vocbase, "a / (b - b) * 2");
+  }
+
+  SECTION("test_comparison") {
+    compare(vocbase, "a + 0 == b + 0");
+    compare(vocbase, "a * 1 != b * 1");
+    compare(vocbase, "a + 1 < b - 1");
+    compare(vocbase, "a + b <= a - b");
+    compare(vocbase, "a * 2 > b * 2");
+    compare(vocbase, "a - b >= 1 + 1");
+  }
+
+  SECTION("test_logic") {
+    compare(vocbase, "a + 1 > 2 && b - 1 < 0");
+    compare(vocbase, "a + b == 0 || a * b == 0");
+    compare(vocbase, "!(a * b) && a + b > 0");
+    compare(vocbase, "a + b > 1 ? a * 2 : b * 3");
+    compare(vocbase, "(a + 1) && (b + 1)");
+    compare(vocbase, "(a / b) || (b / a)");
+  }
+
+  SECTION("test_null_and_type_coercion") {
+    compare(vocbase, "(a + null) * 2");
+    compare(vocbase, "a / b == null");
+    compare(vocbase, "a / b < b / a");
+    compare(vocbase, "(a > b) + (a < b) * 2");
+    compare(vocbase, "(a + b > 0) == (a - b > 0)");
+    compare(vocbase, "a / b > 0 ? a / b : null + 1");
+  }
+}
+
+}
+}
+}
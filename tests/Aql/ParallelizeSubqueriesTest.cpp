@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for the parallelize-subqueries optimizer rule
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "QueryTestSetup.h"
+
+#include "Aql/ExecutionPlan.h"
+#include "Aql/OptimizerRules.h"
+#include "Aql/OptimizerRulesFeature.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace parallelize_subqueries {
+
+static std::string const rule = "parallelize-subqueries";
+
+static std::string const disabled =
+    "{ \"optimizer\": { \"rules\": [ \"-" + rule + "\" ] } }";
+
+/// @brief number of interleaved SubqueryNodes in the plan of the query, or
+/// -1 if the rule was not applied
+static int interleavedSubqueries(TRI_vocbase_t& vocbase,
+                                 std::string const& queryString,
+                                 std::string const& options) {
+  auto result = explainQueryWithOptions(vocbase, queryString, options);
+  REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+  VPackSlice explanation = result.result->slice();
+
+  bool applied = false;
+  for (auto const& it : VPackArrayIterator(explanation.get("rules"))) {
+    if (it.copyString() == rule) {
+      applied = true;
+    }
+  }
+
+  int interleaved = 0;
+  for (auto const& node : VPackArrayIterator(explanation.get("nodes"))) {
+    if (node.get("type").copyString() == "SubqueryNode" &&
+        node.get("interleaved").isTrue()) {
+      ++interleaved;
+    }
+  }
+  CHECK(applied == (interleaved > 0));
+
+  return applied ? interleaved : -1;
+}
+
+/// @brief executes the query with and without the rule and compares
+/// the results
+static void compare(TRI_vocbase_t& vocbase, std::string const& queryString,
+                    size_t expectedLength) {
+  INFO(queryString);
+
+  auto expected = executeQueryWithOptions(vocbase, queryString, disabled);
+  REQUIRE(TRI_ERROR_NO_ERROR == expected.code);
+  auto actual = executeQuery(vocbase, queryString);
+  REQUIRE(TRI_ERROR_NO_ERROR == actual.code);
+
+  CHECK(actual.result->slice().length() == expectedLength);
+  CHECK(0 == basics::VelocyPackHelper::compare(expected.result->slice(),
+                                               actual.result->slice(), true));
+}
+
+TEST_CASE("ParallelizeSubqueriesTest", "[aql][optimizer]") {
+  AqlQuerySetup s;
+  UNUSED(s);
+
+  // the rule is only registered on coordinators. it finds nothing to overlap
+  // on a single server, but executes the subqueries the same way
+  if (aql::OptimizerRulesFeature::translateRule(
+          aql::OptimizerRule::parallelizeSubqueriesRule) == nullptr) {
+    aql::OptimizerRulesFeature::registerRule(
+        rule, aql::parallelizeSubqueriesRule,
+        aql::OptimizerRule::parallelizeSubqueriesRule, false, true);
+  }
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  SECTION("test_independent_subqueries") {
+    // enough rows for several input blocks
+    std::string const query =
+        "FOR i IN 1..2500 "
+        "LET a = (FOR j IN 1..(i % 7) RETURN j * i) "
+        "LET b = (FOR k IN 1..3 FILTER k != i % 4 RETURN k) "
+        "RETURN { i, a, b }";
+
+    CHECK(1 == interleavedSubqueries(vocbase, query, "{ }"));
+    CHECK(-1 == interleavedSubqueries(vocbase, query, disabled));
+    compare(vocbase, query, 2500);
+  }
+
+  SECTION("test_chain_of_subqueries") {
+    std::string const query =
+        "FOR i IN 1..1500 "
+        "LET a = (FOR j IN 1..10 FILTER j > i % 11 RETURN j) "
+        "LET b = (FOR j IN 1..5 FILTER j <= i % 3 RETURN j) "
+        "LET c = (FOR j IN [ i, i + 1 ] COLLECT x = j % 2 WITH COUNT INTO n "
+        "RETURN { x, n }) "
+        "RETURN [ i, a, b, c ]";
+
+    CHECK(2 == interleavedSubqueries(vocbase, query, "{ }"));
+    compare(vocbase, query, 1500);
+  }
+
+  SECTION("test_subqueries_with_limit") {
+    std::string const query =
+        "FOR i IN 1..2000 "
+        "LET a = (FOR j IN 1..(i % 100) RETURN j) "
+        "LET b = (FOR j IN 1..(i % 50) RETURN -j) "
+        "LIMIT 1000, 10 "
+        "RETURN [ LENGTH(a), SUM(a) + SUM(b) ]";
+
+    CHECK(1 == interleavedSubqueries(vocbase, query, "{ }"));
+    compare(vocbase, query, 10);
+  }
+
+  SECTION("test_dependent_subqueries") {
+    // the second subquery uses the result of the first one
+    std::string const query =
+        "FOR i IN 1..1500 "
+        "LET a = (FOR j IN 1..(i % 5) RETURN j) "
+        "LET b = (FOR x IN a RETURN x * 2) "
+        "RETURN [ a, b ]";
+
+    CHECK(-1 == interleavedSubqueries(vocbase, query, "{ }"));
+    compare(vocbase, query, 1500);
+  }
+}
+
+}
+}
+}
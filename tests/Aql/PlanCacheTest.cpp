@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for PlanCache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2018, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/PlanCache.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace plan_cache {
+
+static uint64_t hashOf(char const* json) {
+  auto parsed = VPackParser::fromJson(json);
+  return PlanCache::hashBindParameters(parsed->slice(), 0);
+}
+
+TEST_CASE("PlanCacheTest", "[aql][plan-cache]") {
+
+  SECTION("test_hash_uses_types_of_scalar_values") {
+    CHECK(hashOf("{\"a\":1,\"b\":\"foo\"}") == hashOf("{\"a\":42,\"b\":\"bar\"}"));
+    CHECK(hashOf("{\"a\":true}") == hashOf("{\"a\":false}"));
+    CHECK(hashOf("{\"a\":1}") != hashOf("{\"a\":\"1\"}"));
+    CHECK(hashOf("{\"a\":1}") != hashOf("{\"a\":1.5}"));
+    CHECK(hashOf("{\"a\":1}") != hashOf("{\"a\":null}"));
+    CHECK(hashOf("{\"a\":1}") != hashOf("{\"b\":1}"));
+  }
+
+  SECTION("test_hash_uses_collections_and_compound_values") {
+    CHECK(hashOf("{\"@c\":\"foo\"}") != hashOf("{\"@c\":\"bar\"}"));
+    CHECK(hashOf("{\"a\":[1,2]}") != hashOf("{\"a\":[1,3]}"));
+    CHECK(hashOf("{\"a\":{\"b\":1}}") != hashOf("{\"a\":{\"b\":2}}"));
+    CHECK(hashOf("{\"a\":[1,2]}") == hashOf("{\"a\":[1,2]}"));
+  }
+
+  SECTION("test_instantiate") {
+    auto plan = VPackParser::fromJson(
+      "{\"nodes\":[{\"type\":\"CalculationNode\",\"expression\":"
+      "{\"type\":\"compare ==\",\"subNodes\":["
+      "{\"type\":\"value\",\"typeID\":40,\"value\":1,\"vType\":\"int\",\"vTypeID\":2,\"bindParameter\":1},"
+      "{\"type\":\"value\",\"typeID\":40,\"value\":\"x\",\"vType\":\"string\",\"vTypeID\":4}]}}]}");
+    PlanCacheEntry entry(std::string("RETURN @a == 'x'"), std::move(plan),
+                         std::vector<std::string>{"a"});
+
+    auto bindParameters = VPackParser::fromJson("{\"a\":23}");
+    auto result = PlanCache::instantiate(entry, bindParameters->slice());
+
+    VPackSlice members = result->slice().get("nodes").at(0).get("expression").get("subNodes");
+    REQUIRE(members.length() == 2);
+    CHECK(members.at(0).get("value").getNumber<int64_t>() == 23);
+    CHECK(members.at(0).get("vTypeID").getNumber<int>() == 2);
+    CHECK(members.at(0).get("bindParameter").isNone());
+    CHECK(members.at(1).get("value").copyString() == "x");
+  }
+
+  SECTION("test_instantiate_missing_bind_parameter") {
+    auto plan = VPackParser::fromJson(
+      "{\"type\":\"value\",\"typeID\":40,\"value\":1,\"vType\":\"int\",\"vTypeID\":2,\"bindParameter\":1}");
+    PlanCacheEntry entry(std::string("RETURN @a"), std::move(plan),
+                         std::vector<std::string>{"a"});
+
+    auto bindParameters = VPackParser::fromJson("{}");
+    CHECK_THROWS(PlanCache::instantiate(entry, bindParameters->slice()));
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for QueryCache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2018, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/QueryCache.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace query_cache {
+
+static std::shared_ptr<QueryCacheResultEntry> makeEntry(
+    uint64_t hash, std::string const& query,
+    std::vector<std::string>&& dataSources) {
+  auto result = std::make_shared<VPackBuilder>();
+  result->openArray();
+  result->close();
+  return std::make_shared<QueryCacheResultEntry>(
+      hash, QueryString(query), result, nullptr, std::move(dataSources));
+}
+
+TEST_CASE("QueryCacheTest", "[aql][query-cache]") {
+  QueryCacheDatabaseEntry cache;
+
+  auto byKey = makeEntry(1, "FOR d IN c FILTER d._key == 'a' RETURN d",
+                         std::vector<std::string>{"c"});
+  byKey->_dataSourceKeys["c"] = std::unordered_set<std::string>{"a"};
+  auto full = makeEntry(2, "FOR d IN c RETURN d", std::vector<std::string>{"c"});
+  auto mixed = makeEntry(3, "FOR d IN c FOR x IN e FILTER d._key == 'b' RETURN x",
+                         std::vector<std::string>{"c", "e"});
+  mixed->_dataSourceKeys["c"] = std::unordered_set<std::string>{"b"};
+
+  cache.store(std::move(byKey), 16, 1024 * 1024);
+  cache.store(std::move(full), 16, 1024 * 1024);
+  cache.store(std::move(mixed), 16, 1024 * 1024);
+  REQUIRE(cache._entriesByHash.size() == 3);
+
+  SECTION("test_depends_on_keys") {
+    auto const& entry = cache._entriesByHash[1];
+    CHECK(entry->dependsOnKeys("c", std::unordered_set<std::string>{"a", "z"}));
+    CHECK_FALSE(entry->dependsOnKeys("c", std::unordered_set<std::string>{"z"}));
+    CHECK(cache._entriesByHash[2]->dependsOnKeys("c", std::unordered_set<std::string>{"z"}));
+  }
+
+  SECTION("test_invalidate_unrelated_key") {
+    cache.invalidate("c", std::unordered_set<std::string>{"z"});
+    CHECK(cache._entriesByHash.size() == 2);
+    CHECK(cache._entriesByHash.find(1) != cache._entriesByHash.end());
+    CHECK(cache._entriesByHash.find(3) != cache._entriesByHash.end());
+  }
+
+  SECTION("test_invalidate_matching_key") {
+    cache.invalidate("c", std::unordered_set<std::string>{"b"});
+    CHECK(cache._entriesByHash.size() == 1);
+    CHECK(cache._entriesByHash.find(1) != cache._entriesByHash.end());
+    // the removed entry must not be registered for other data sources anymore
+    CHECK(cache._entriesByDataSource["e"].empty());
+  }
+
+  SECTION("test_invalidate_other_data_source") {
+    cache.invalidate("e", std::unordered_set<std::string>{"z"});
+    CHECK(cache._entriesByHash.size() == 2);
+    CHECK(cache._entriesByHash.find(3) == cache._entriesByHash.end());
+  }
+
+  SECTION("test_second_chance_eviction") {
+    // the oldest entry was used recently, so the next one is evicted
+    cache._entriesByHash[1]->increaseHits();
+    cache.store(makeEntry(4, "RETURN 4", std::vector<std::string>{"d"}), 3, 1024 * 1024);
+    CHECK(cache._entriesByHash.size() == 3);
+    CHECK(cache._entriesByHash.find(1) != cache._entriesByHash.end());
+    CHECK(cache._entriesByHash.find(2) == cache._entriesByHash.end());
+    CHECK(cache._tail->_hash == 4);
+  }
+
+  SECTION("test_memory_usage") {
+    auto const& entry = cache._entriesByHash[1];
+    CHECK(entry->memoryUsage() > entry->_queryString.size() + entry->_queryResult->size());
+    CHECK(cache._sizeResults >= entry->_size);
+  }
+
+  SECTION("test_invalidate_data_source") {
+    cache.invalidate(std::string("c"));
+    CHECK(cache._entriesByHash.empty());
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for RegexCache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2018, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/RegexCache.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace regex_cache {
+
+static SimpleLikePattern inspect(std::string const& pattern) {
+  return RegexCache::inspectSimpleLikePattern(pattern.data(), pattern.size());
+}
+
+static bool matches(std::string const& pattern, std::string const& value) {
+  auto simple = inspect(pattern);
+  REQUIRE(simple.type != SimpleLikePattern::Type::REGEX);
+  return simple.matches(value.data(), value.size());
+}
+
+TEST_CASE("RegexCacheTest", "[aql][regex]") {
+
+  SECTION("test_simple_like_pattern_types") {
+    CHECK(inspect("abc").type == SimpleLikePattern::Type::EXACT);
+    CHECK(inspect("abc%").type == SimpleLikePattern::Type::PREFIX);
+    CHECK(inspect("%abc").type == SimpleLikePattern::Type::SUFFIX);
+    CHECK(inspect("%abc%").type == SimpleLikePattern::Type::CONTAINS);
+    CHECK(inspect("%").type == SimpleLikePattern::Type::CONTAINS);
+    CHECK(inspect("%%ab%%").type == SimpleLikePattern::Type::CONTAINS);
+    CHECK(inspect("a%c").type == SimpleLikePattern::Type::REGEX);
+    CHECK(inspect("a_c").type == SimpleLikePattern::Type::REGEX);
+    CHECK(inspect("%a_").type == SimpleLikePattern::Type::REGEX);
+  }
+
+  SECTION("test_simple_like_pattern_escapes") {
+    auto simple = inspect("a\\%b\\_c%");
+    CHECK(simple.type == SimpleLikePattern::Type::PREFIX);
+    CHECK(simple.literal == "a%b_c");
+
+    simple = inspect("%a\\\\b");
+    CHECK(simple.type == SimpleLikePattern::Type::SUFFIX);
+    CHECK(simple.literal == "a\\b");
+
+    simple = inspect("a\\b.");
+    CHECK(simple.type == SimpleLikePattern::Type::EXACT);
+    CHECK(simple.literal == "a\\b.");
+  }
+
+  SECTION("test_simple_like_pattern_matches") {
+    CHECK(matches("abc", "abc"));
+    CHECK_FALSE(matches("abc", "abcd"));
+    CHECK(matches("abc%", "abcd"));
+    CHECK_FALSE(matches("abc%", "xabc"));
+    CHECK(matches("%abc", "xabc"));
+    CHECK_FALSE(matches("%abc", "abcx"));
+    CHECK(matches("%abc%", "xxabcxx"));
+    CHECK_FALSE(matches("%abc%", "xxabxcx"));
+    CHECK(matches("%", ""));
+    CHECK(matches("%ab%", "\nab\n"));
+  }
+}
+
+}
+}
+}
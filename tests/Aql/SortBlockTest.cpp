@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for SortBlock
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "QueryTestSetup.h"
+
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace sort_block {
+
+// the input spans many AqlItemBlocks, and 7919 is coprime to the number of
+// rows, so the sort input is a permutation of 0 .. rows - 1
+static size_t const rows = 200000;
+
+static std::string permutation() {
+  return "FOR i IN 0.." + std::to_string(rows - 1) +
+         " LET v = (i * 7919) % " + std::to_string(rows);
+}
+
+/// @brief the limit the sort-limit rule set on the SortNode of the query,
+/// or 0 if the SortNode sorts its entire input
+static size_t sortLimit(TRI_vocbase_t& vocbase, std::string const& queryString,
+                        std::string const& options) {
+  auto result = explainQueryWithOptions(vocbase, queryString, options);
+  REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+
+  for (auto const& node :
+       VPackArrayIterator(result.result->slice().get("nodes"))) {
+    if (node.get("type").copyString() == "SortNode") {
+      return node.get("limit").getNumber<size_t>();
+    }
+  }
+  return 0;
+}
+
+/// @brief runs the query with the constrained heap sort and with a full
+/// sort, and compares the results
+static void compareSortLimit(TRI_vocbase_t& vocbase,
+                             std::string const& queryString,
+                             size_t expectedLimit, size_t expectedLength) {
+  INFO(queryString);
+  std::string const disabled =
+      "{ \"optimizer\": { \"rules\": [ \"-sort-limit\" ] } }";
+
+  CHECK(expectedLimit == sortLimit(vocbase, queryString, "{ }"));
+  CHECK(0 == sortLimit(vocbase, queryString, disabled));
+
+  auto expected = executeQueryWithOptions(vocbase, queryString, disabled);
+  REQUIRE(TRI_ERROR_NO_ERROR == expected.code);
+  auto actual = executeQuery(vocbase, queryString);
+  REQUIRE(TRI_ERROR_NO_ERROR == actual.code);
+
+  CHECK(actual.result->slice().length() == expectedLength);
+  CHECK(0 == basics::VelocyPackHelper::compare(expected.result->slice(),
+                                               actual.result->slice(), true));
+}
+
+TEST_CASE("SortBlockTest", "[aql][sort]") {
+  AqlQuerySetup s;
+  UNUSED(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  SECTION("test_large_input_ascending") {
+    auto result = executeQuery(vocbase, permutation() + " SORT v RETURN v");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    VPackSlice slice = result.result->slice();
+    REQUIRE(slice.length() == rows);
+
+    int64_t expected = 0;
+    for (auto const& it : VPackArrayIterator(slice)) {
+      CHECK(it.getNumber<int64_t>() == expected);
+      ++expected;
+    }
+  }
+
+  SECTION("test_large_input_descending") {
+    auto result = executeQuery(vocbase, permutation() + " SORT v DESC RETURN v");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    VPackSlice slice = result.result->slice();
+    REQUIRE(slice.length() == rows);
+
+    int64_t expected = rows - 1;
+    for (auto const& it : VPackArrayIterator(slice)) {
+      CHECK(it.getNumber<int64_t>() == expected);
+      --expected;
+    }
+  }
+
+  SECTION("test_large_input_multiple_criteria") {
+    auto result = executeQuery(
+        vocbase, permutation() + " SORT v % 10 DESC, v RETURN v");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    VPackSlice slice = result.result->slice();
+    REQUIRE(slice.length() == rows);
+
+    int64_t previous = -1;
+    for (auto const& it : VPackArrayIterator(slice)) {
+      int64_t const value = it.getNumber<int64_t>();
+      if (previous >= 0) {
+        if (previous % 10 == value % 10) {
+          CHECK(previous < value);
+        } else {
+          CHECK(previous % 10 > value % 10);
+        }
+      }
+      previous = value;
+    }
+  }
+
+  SECTION("test_large_input_strings") {
+    auto result = executeQuery(
+        vocbase, permutation() + " SORT CONCAT('k', v) RETURN CONCAT('k', v)");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    VPackSlice slice = result.result->slice();
+    REQUIRE(slice.length() == rows);
+
+    VPackSlice previous;
+    for (auto const& it : VPackArrayIterator(slice)) {
+      if (!previous.isNone()) {
+        CHECK(basics::VelocyPackHelper::compare(previous, it, true) <= 0);
+      }
+      previous = it;
+    }
+  }
+
+  SECTION("test_large_input_mixed_scalars") {
+    // null < false < true < numbers < strings
+    auto result = executeQuery(
+        vocbase, permutation() +
+        " LET k = v % 5 == 0 ? null : v % 5 == 1 ? (v % 2 == 0) :"
+        " v % 5 == 2 ? v : CONCAT('k', v) SORT k RETURN k");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    VPackSlice slice = result.result->slice();
+    REQUIRE(slice.length() == rows);
+
+    VPackSlice previous;
+    for (auto const& it : VPackArrayIterator(slice)) {
+      if (!previous.isNone()) {
+        CHECK(basics::VelocyPackHelper::compare(previous, it, true) <= 0);
+      }
+      previous = it;
+    }
+    CHECK(slice.at(0).isNull());
+    CHECK(slice.at(rows - 1).isString());
+  }
+
+  SECTION("test_large_input_objects") {
+    // objects are compared with the transaction, on the query thread
+    auto result = executeQuery(
+        vocbase, permutation() + " SORT { a: v % 100, b: v } DESC RETURN v");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    VPackSlice slice = result.result->slice();
+    REQUIRE(slice.length() == rows);
+
+    int64_t previous = -1;
+    for (auto const& it : VPackArrayIterator(slice)) {
+      int64_t const value = it.getNumber<int64_t>();
+      if (previous >= 0) {
+        if (previous % 100 == value % 100) {
+          CHECK(previous > value);
+        } else {
+          CHECK(previous % 100 > value % 100);
+        }
+      }
+      previous = value;
+    }
+  }
+
+  SECTION("test_large_input_with_limit") {
+    auto result = executeQuery(
+        vocbase, permutation() + " SORT v LIMIT 100000, 5 RETURN v");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+    VPackSlice slice = result.result->slice();
+    REQUIRE(slice.length() == 5);
+
+    int64_t expected = 100000;
+    for (auto const& it : VPackArrayIterator(slice)) {
+      CHECK(it.getNumber<int64_t>() == expected);
+      ++expected;
+    }
+  }
+
+  SECTION("test_constrained_heap") {
+    // the heap is spread over several blocks, the last one shrunk
+    compareSortLimit(vocbase, permutation() + " SORT v LIMIT 1500, 7 RETURN v",
+                     1507, 7);
+    // a single, shrunk heap block
+    compareSortLimit(vocbase, permutation() + " SORT v DESC LIMIT 10 RETURN v",
+                     10, 10);
+    // the heap blocks are all full
+    compareSortLimit(vocbase, permutation() + " SORT v % 1000, v LIMIT 2000 RETURN v",
+                     2000, 2000);
+    // the input is smaller than the limit, so the heap never fills up
+    compareSortLimit(vocbase,
+                     "FOR i IN 1..500 SORT CONCAT('k', i) DESC LIMIT 5, 1000 "
+                     "RETURN i",
+                     1005, 495);
+  }
+
+  SECTION("test_mixed_types") {
+    auto result = executeQuery(
+        vocbase,
+        "FOR v IN [ 'b', 1, null, [ 1 ], false, { a: 1 }, 'a', 0.5, true ] "
+        "SORT v RETURN v");
+    REQUIRE(TRI_ERROR_NO_ERROR == result.code);
+
+    auto expected = VPackParser::fromJson(
+        "[ null, false, true, 0.5, 1, \"a\", \"b\", [ 1 ], { \"a\": 1 } ]");
+    CHECK(0 == basics::VelocyPackHelper::compare(expected->slice(),
+                                                 result.result->slice(), true));
+  }
+}
+
+}
+}
+}
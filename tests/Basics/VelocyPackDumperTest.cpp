@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for VelocyPackDumper
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackDumper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Options.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+namespace {
+std::string dump(std::string const& value,
+                 VPackOptions const* options = &VPackOptions::Defaults) {
+  VPackBuilder builder;
+  builder.add(VPackValue(value));
+  StringBuffer buffer(true);
+  VelocyPackDumper dumper(&buffer, options);
+  dumper.dumpValue(builder.slice());
+  return std::string(buffer.c_str(), buffer.length());
+}
+}
+
+TEST_CASE("VelocyPackDumperTest", "[vpack]") {
+
+SECTION("test_plain_strings") {
+  CHECK(dump("") == "\"\"");
+  CHECK(dump("abc") == "\"abc\"");
+  std::string const longValue(1000, 'x');
+  CHECK(dump(longValue) == "\"" + longValue + "\"");
+}
+
+SECTION("test_escapes_at_all_positions") {
+  // place the special character at every offset of a long string, so that
+  // it is found both in bulk-scanned blocks and in the remainder
+  for (size_t i = 0; i < 40; ++i) {
+    std::string value(40, 'a');
+    value[i] = '"';
+    std::string expected = "\"" + value.substr(0, i) + "\\\"" + value.substr(i + 1) + "\"";
+    CHECK(dump(value) == expected);
+
+    value[i] = '\n';
+    expected = "\"" + value.substr(0, i) + "\\n" + value.substr(i + 1) + "\"";
+    CHECK(dump(value) == expected);
+
+    value[i] = '\x01';
+    expected = "\"" + value.substr(0, i) + "\\u0001" + value.substr(i + 1) + "\"";
+    CHECK(dump(value) == expected);
+  }
+}
+
+SECTION("test_backslash_and_slash") {
+  CHECK(dump("a\\b/c") == "\"a\\\\b/c\"");
+
+  VPackOptions options;
+  options.escapeForwardSlashes = true;
+  CHECK(dump("a\\b/c", &options) == "\"a\\\\b\\/c\"");
+}
+
+SECTION("test_utf8") {
+  std::string const value = "0123456789abcdef\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80 0123456789abcdef";
+  CHECK(dump(value) == "\"" + value + "\"");
+
+  VPackOptions options;
+  options.escapeUnicode = true;
+  CHECK(dump("\xc3\xa4-\xe2\x82\xac", &options) == "\"\\u00E4-\\u20AC\"");
+}
+
+}
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for AssocUnique
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/AssocUnique.h"
+#include "Basics/fasthash.h"
+
+#include <unordered_set>
+
+namespace {
+
+struct TestElement {
+  TestElement() : key(0), value(0) {}
+  TestElement(uint64_t key, uint64_t value) : key(key), value(value) {}
+
+  operator bool() const { return key != 0; }
+
+  uint64_t key;
+  uint64_t value;
+};
+
+struct TestHelper {
+  static inline uint64_t HashKey(uint64_t const* key) {
+    return fasthash64_uint64(*key, 0x12345678);
+  }
+
+  static inline uint64_t HashElement(TestElement const& element, bool) {
+    return fasthash64_uint64(element.key, 0x12345678);
+  }
+
+  inline bool IsEqualKeyElement(void*, uint64_t const* key,
+                                TestElement const& element) const {
+    return *key == element.key;
+  }
+
+  inline bool IsEqualElementElement(void*, TestElement const& left,
+                                    TestElement const& right) const {
+    return left.key == right.key;
+  }
+
+  inline bool IsEqualElementElementByKey(void*, TestElement const& left,
+                                         TestElement const& right) const {
+    return left.key == right.key;
+  }
+};
+
+typedef arangodb::basics::AssocUnique<uint64_t, TestElement, TestHelper> TestIndex;
+
+size_t countSequential(TestIndex const& index) {
+  arangodb::basics::BucketPosition position;
+  uint64_t total = 0;
+  std::unordered_set<uint64_t> seen;
+  while (true) {
+    TestElement element = index.findSequential(nullptr, position, total);
+    if (!element) {
+      break;
+    }
+    CHECK(seen.emplace(element.key).second);
+  }
+  return seen.size();
+}
+
+}
+
+TEST_CASE("AssocUniqueTest", "[assocunique]") {
+
+// the tables grow past the size from which they are resized incrementally,
+// so lookups, removals and iteration run while resizes are in progress
+SECTION("tst_incremental_resize") {
+  TestIndex index(TestHelper(), 2);
+  uint64_t const n = 300000;
+
+  for (uint64_t i = 1; i <= n; ++i) {
+    REQUIRE(TRI_ERROR_NO_ERROR == index.insert(nullptr, TestElement(i, i)));
+    REQUIRE(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED ==
+            index.insert(nullptr, TestElement(i, 0)));
+
+    if (i % 1000 == 0) {
+      uint64_t const key = i / 2;
+      CHECK(index.findByKey(nullptr, &key).value == key);
+    }
+  }
+
+  CHECK(index.size() == n);
+  CHECK(countSequential(index) == n);
+
+  for (uint64_t i = 1; i <= n; ++i) {
+    TestElement element = index.findByKey(nullptr, &i);
+    REQUIRE(element);
+    CHECK(element.value == i);
+  }
+
+  // remove every third element, interleaved with inserts that move on
+  // with running resizes
+  for (uint64_t i = 3; i <= n; i += 3) {
+    CHECK(index.removeByKey(nullptr, &i).value == i);
+    uint64_t const key = n + i;
+    CHECK(TRI_ERROR_NO_ERROR == index.insert(nullptr, TestElement(key, key)));
+  }
+
+  CHECK(index.size() == n);
+  CHECK(countSequential(index) == n);
+
+  for (uint64_t i = 1; i <= n; ++i) {
+    TestElement element = index.findByKey(nullptr, &i);
+    if (i % 3 == 0) {
+      CHECK(!element);
+      uint64_t const key = n + i;
+      CHECK(index.findByKey(nullptr, &key).value == key);
+    } else {
+      CHECK(element.value == i);
+    }
+  }
+
+  size_t visited = 0;
+  index.invokeOnAllElements([&visited](TestElement&) {
+    ++visited;
+    return true;
+  });
+  CHECK(visited == n);
+
+  index.truncate([](TestElement&) { return true; });
+  CHECK(index.isEmpty());
+  CHECK(countSequential(index) == 0);
+}
+
+}
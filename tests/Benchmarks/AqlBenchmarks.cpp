@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief microbenchmarks for AqlItemBlock and AqlValue
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemBlockManager.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ResourceUsage.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace arangodb {
+namespace tests {
+namespace aql_benchmarks {
+
+TEST_CASE("AqlItemBlock benchmarks", "[benchmark][aql][!hide]") {
+  ResourceMonitor monitor;
+  AqlItemBlockManager manager(&monitor);
+
+  BENCHMARK("request and return 1000x10 block") {
+    AqlItemBlock* block = manager.requestBlock(1000, 10);
+    manager.returnBlock(block);
+  }
+
+  BENCHMARK("fill 1000x10 block with integers") {
+    AqlItemBlock* block = manager.requestBlock(1000, 10);
+    for (size_t row = 0; row < 1000; ++row) {
+      for (RegisterId reg = 0; reg < 10; ++reg) {
+        block->emplaceValue(row, reg, AqlValueHintInt(static_cast<int64_t>(row)));
+      }
+    }
+    manager.returnBlock(block);
+  }
+
+  std::vector<size_t> chosen;
+  for (size_t row = 0; row < 1000; row += 2) {
+    chosen.emplace_back(row);
+  }
+
+  BENCHMARK("steal every other row of 1000x10 block") {
+    AqlItemBlock* block = manager.requestBlock(1000, 10);
+    for (size_t row = 0; row < 1000; ++row) {
+      block->emplaceValue(row, 0, AqlValueHintInt(static_cast<int64_t>(row)));
+    }
+    std::unique_ptr<AqlItemBlock> stolen(block->steal(chosen, 0, chosen.size()));
+    manager.returnBlock(block);
+    manager.returnBlock(std::move(stolen));
+  }
+}
+
+TEST_CASE("AqlValue benchmarks", "[benchmark][aql][!hide]") {
+  VPackBuilder builder;
+  builder.openArray();
+  for (int64_t i = 0; i < 1000; ++i) {
+    builder.add(VPackValue("value-" + std::to_string(i * 7919 % 1000)));
+  }
+  builder.close();
+
+  std::vector<AqlValue> values;
+  for (auto const& it : VPackArrayIterator(builder.slice())) {
+    values.emplace_back(it);
+  }
+
+  BENCHMARK("compare 1000 string AqlValues pairwise") {
+    int result = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+      result += basics::VelocyPackHelper::compare(values[i - 1].slice(),
+                                                  values[i].slice(), true);
+    }
+    CHECK(result != 1000000);
+  }
+
+  BENCHMARK("sort 1000 string AqlValues") {
+    std::vector<AqlValue> copy(values);
+    std::sort(copy.begin(), copy.end(), [](AqlValue const& lhs, AqlValue const& rhs) {
+      return basics::VelocyPackHelper::compare(lhs.slice(), rhs.slice(), true) < 0;
+    });
+  }
+
+  for (auto& it : values) {
+    it.destroy();
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief microbenchmarks for the in-memory caches
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/Common.h"
+#include "Cache/Common.h"
+#include "Cache/Manager.h"
+#include "Cache/PlainCache.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::cache;
+
+namespace arangodb {
+namespace tests {
+namespace cache_benchmarks {
+
+namespace {
+void fill(std::shared_ptr<Cache> const& cache, uint64_t from, uint64_t to) {
+  for (uint64_t i = from; i < to; ++i) {
+    CachedValue* value =
+        CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+    TRI_ASSERT(value != nullptr);
+    if (!cache->insert(value).ok()) {
+      delete value;
+    }
+  }
+}
+}
+
+TEST_CASE("cache::PlainCache benchmarks", "[benchmark][cache][!hide]") {
+  uint64_t const cacheLimit = 64 * 1024 * 1024;
+  auto postFn = [](std::function<void()>) -> bool { return false; };
+  Manager manager(postFn, 4 * cacheLimit);
+  auto cache = manager.createCache(CacheType::Plain, false, cacheLimit);
+  fill(cache, 0, 100000);
+
+  BENCHMARK("insert 100000 values") {
+    fill(cache, 100000, 200000);
+  }
+
+  BENCHMARK("find 100000 values") {
+    uint64_t found = 0;
+    for (uint64_t i = 0; i < 100000; ++i) {
+      auto f = cache->find(&i, sizeof(uint64_t));
+      if (f.found()) {
+        ++found;
+      }
+    }
+    CHECK(found <= 100000);
+  }
+
+  size_t const numThreads = (std::max)(size_t(2), size_t(std::thread::hardware_concurrency()));
+
+  BENCHMARK("find and insert from " + std::to_string(numThreads) + " threads") {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&cache, t]() {
+        uint64_t const base = 1000000 * (t + 1);
+        for (uint64_t i = 0; i < 20000; ++i) {
+          uint64_t key = i % 100000;
+          cache->find(&key, sizeof(uint64_t));
+          if (i % 4 == 0) {
+            fill(cache, base + i, base + i + 1);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  manager.destroyCache(cache);
+}
+
+}
+}
+}
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief microbenchmarks for RocksDB key encoding
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "RocksDBEngine/RocksDBFormat.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBTypes.h"
+#include "VocBase/LocalDocumentId.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace rocksdb_key_benchmarks {
+
+TEST_CASE("RocksDBKey benchmarks", "[benchmark][rocksdb][!hide]") {
+  rocksutils::setRocksDBKeyFormatEndianess(RocksDBEndianness::Big);
+
+  BENCHMARK("construct 100000 document keys") {
+    RocksDBKey key;
+    size_t total = 0;
+    for (uint64_t i = 0; i < 100000; ++i) {
+      key.constructDocument(42, LocalDocumentId::create(i));
+      total += key.string().size();
+    }
+    CHECK(total > 0);
+  }
+
+  BENCHMARK("construct 100000 primary index keys") {
+    RocksDBKey key;
+    size_t total = 0;
+    std::string primaryKey;
+    for (uint64_t i = 0; i < 100000; ++i) {
+      primaryKey = "key-" + std::to_string(i);
+      key.constructPrimaryIndexValue(42, arangodb::StringRef(primaryKey));
+      total += key.string().size();
+    }
+    CHECK(total > 0);
+  }
+
+  VPackBuilder values;
+  values.openArray();
+  values.add(VPackValue("some indexed value"));
+  values.add(VPackValue(12345));
+  values.close();
+
+  BENCHMARK("construct 100000 vpack index keys") {
+    RocksDBKey key;
+    size_t total = 0;
+    for (uint64_t i = 0; i < 100000; ++i) {
+      key.constructVPackIndexValue(42, values.slice(), LocalDocumentId::create(i));
+      total += key.string().size();
+    }
+    CHECK(total > 0);
+  }
+}
+
+}
+}
+}
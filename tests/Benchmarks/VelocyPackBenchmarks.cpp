@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief microbenchmarks for VelocyPackHelper
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace arangodb {
+namespace tests {
+namespace velocypack_benchmarks {
+
+TEST_CASE("VelocyPackHelper benchmarks", "[benchmark][velocypack][!hide]") {
+  auto ints = VPackParser::fromJson("[1, 2, 3, 4, 5, 6, 7, 8, 9, 10]");
+  auto ints2 = VPackParser::fromJson("[1, 2, 3, 4, 5, 6, 7, 8, 9, 11]");
+  auto obj = VPackParser::fromJson(
+      "{\"_key\":\"abc\",\"name\":\"test\",\"value\":12.5,\"tags\":[\"a\",\"b\"],"
+      "\"nested\":{\"x\":1,\"y\":\"z\"}}");
+  auto obj2 = VPackParser::fromJson(
+      "{\"_key\":\"abc\",\"name\":\"test\",\"value\":12.5,\"tags\":[\"a\",\"b\"],"
+      "\"nested\":{\"x\":1,\"y\":\"zz\"}}");
+
+  BENCHMARK("compare integer arrays 10000 times") {
+    int result = 0;
+    for (int i = 0; i < 10000; ++i) {
+      result += basics::VelocyPackHelper::compare(ints->slice(), ints2->slice(), true);
+    }
+    CHECK(result < 0);
+  }
+
+  BENCHMARK("compare objects 10000 times") {
+    int result = 0;
+    for (int i = 0; i < 10000; ++i) {
+      result += basics::VelocyPackHelper::compare(obj->slice(), obj2->slice(), true);
+    }
+    CHECK(result < 0);
+  }
+
+  BENCHMARK("compare strings (utf8) 10000 times") {
+    VPackBuilder lhs;
+    lhs.add(VPackValue("Überprüfung der Ergebnisse"));
+    VPackBuilder rhs;
+    rhs.add(VPackValue("Überprüfung der ergebnisse"));
+    int result = 0;
+    for (int i = 0; i < 10000; ++i) {
+      result += basics::VelocyPackHelper::compare(lhs.slice(), rhs.slice(), true);
+    }
+    CHECK(result != 0);
+  }
+}
+
+}
+}
+}
@@ -96,4 +96,38 @@ TEST_CASE("cache::BucketState", "[cache]") {
     REQUIRE(!state.isSet(BucketState::Flag::migrated));
     state.unlock();
   }
+
+  SECTION("test snapshot validation") {
+    BucketState state;
+    bool success;
+
+    uint32_t snapshot = state.snapshot();
+    REQUIRE(!BucketState::isSet(snapshot, BucketState::Flag::locked));
+    REQUIRE(state.validate(snapshot));
+
+    // locking invalidates the snapshot
+    success = state.lock();
+    REQUIRE(success);
+    REQUIRE(!state.validate(snapshot));
+    uint32_t locked = state.snapshot();
+    REQUIRE(BucketState::isSet(locked, BucketState::Flag::locked));
+
+    // unlocking increments the version, so the snapshot stays invalid
+    state.unlock();
+    REQUIRE(!state.validate(snapshot));
+    REQUIRE(!state.validate(locked));
+    REQUIRE(!state.isLocked());
+
+    // clearing keeps the version
+    snapshot = state.snapshot();
+    success = state.lock();
+    REQUIRE(success);
+    state.toggleFlag(BucketState::Flag::migrated);
+    state.clear();
+    state.unlock();
+    REQUIRE(!state.validate(snapshot));
+    REQUIRE(!BucketState::isSet(state.snapshot(),
+                                BucketState::Flag::migrated));
+    REQUIRE(state.snapshot() != snapshot);
+  }
 }
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::cache::FrequencySketch
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/FrequencySketch.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <stdint.h>
+
+using namespace arangodb::cache;
+
+TEST_CASE("cache::FrequencySketch", "[cache]") {
+  SECTION("test memory usage") {
+    FrequencySketch sketch(1024);
+    REQUIRE(sketch.memoryUsage() ==
+            sizeof(FrequencySketch) + FrequencySketch::allocationSize(1024));
+    REQUIRE(FrequencySketch::allocationSize(1024) == 64 * sizeof(uint64_t));
+  }
+
+  SECTION("test frequency estimates") {
+    FrequencySketch sketch(1024);
+
+    REQUIRE(0 == sketch.frequency(1));
+    for (uint32_t i = 0; i < 5; i++) {
+      sketch.record(1);
+    }
+    REQUIRE(5 <= sketch.frequency(1));
+
+    // counters saturate
+    for (uint32_t i = 0; i < 100; i++) {
+      sketch.record(2);
+    }
+    REQUIRE(static_cast<uint32_t>(FrequencySketch::maxFrequency) ==
+            sketch.frequency(2));
+
+    // a scan over many keys does not exceed the frequency of the hot key
+    for (uint32_t i = 1000; i < 1100; i++) {
+      sketch.record(i);
+    }
+    uint32_t higher = 0;
+    for (uint32_t i = 1000; i < 1100; i++) {
+      if (sketch.frequency(i) >= sketch.frequency(2)) {
+        higher++;
+      }
+    }
+    REQUIRE(higher < 5);
+  }
+
+  SECTION("test aging") {
+    FrequencySketch sketch(1024);
+
+    for (uint32_t i = 0; i < 8; i++) {
+      sketch.record(7);
+    }
+    uint32_t before = sketch.frequency(7);
+    REQUIRE(8 <= before);
+
+    // enough other accesses to halve all counters several times
+    for (uint32_t i = 100; i < 100 + 2 * 10 * 64; i++) {
+      sketch.record(i);
+    }
+    REQUIRE(sketch.frequency(7) < before);
+  }
+}
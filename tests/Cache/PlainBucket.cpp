@@ -200,4 +200,82 @@ TEST_CASE("cache::PlainBucket", "[cache]") {
       delete ptrs[i];
     }
   }
+
+  SECTION("verify that optimistic lookups work correctly") {
+    auto bucket = std::make_unique<PlainBucket>();
+    bool success;
+
+    uint32_t hashes[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    uint64_t keys[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint64_t values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    CachedValue* ptrs[10];
+    for (size_t i = 0; i < 10; i++) {
+      ptrs[i] = CachedValue::construct(&(keys[i]), sizeof(uint64_t),
+                                       &(values[i]), sizeof(uint64_t));
+      TRI_ASSERT(ptrs[i] != nullptr);
+    }
+
+    // each insert moves the value to the front, so the last five values
+    // end up in the front half of the bucket
+    success = bucket->lock(-1LL);
+    REQUIRE(success);
+    for (size_t i = 0; i < 10; i++) {
+      bucket->insert(hashes[i], ptrs[i]);
+    }
+
+    // locked buckets are never read optimistically
+    {
+      Finding result;
+      REQUIRE(!bucket->findOptimistic(hashes[9], ptrs[9]->key(),
+                                      ptrs[9]->keySize(), result));
+      REQUIRE(!result.found());
+    }
+    bucket->unlock();
+
+    // values in the front half are found and leased
+    for (size_t i = 5; i < 10; i++) {
+      Finding result;
+      REQUIRE(bucket->findOptimistic(hashes[i], ptrs[i]->key(),
+                                     ptrs[i]->keySize(), result));
+      REQUIRE(result.found());
+      REQUIRE(result.value() == ptrs[i]);
+      REQUIRE(ptrs[i]->refCount() == 1);
+    }
+
+    // values in the back half are left to a locked lookup
+    for (size_t i = 0; i < 5; i++) {
+      Finding result;
+      REQUIRE(!bucket->findOptimistic(hashes[i], ptrs[i]->key(),
+                                      ptrs[i]->keySize(), result));
+      REQUIRE(!result.found());
+      REQUIRE(ptrs[i]->isFreeable());
+    }
+
+    // misses are answered
+    {
+      uint64_t missing = 42;
+      Finding result;
+      REQUIRE(bucket->findOptimistic(hashes[9], &missing, sizeof(uint64_t),
+                                     result));
+      REQUIRE(!result.found());
+      REQUIRE(bucket->findOptimistic(11, &missing, sizeof(uint64_t), result));
+      REQUIRE(!result.found());
+    }
+
+    // migrated buckets are never read optimistically
+    success = bucket->lock(-1LL);
+    REQUIRE(success);
+    bucket->_state.toggleFlag(BucketState::Flag::migrated);
+    bucket->unlock();
+    {
+      Finding result;
+      REQUIRE(!bucket->findOptimistic(hashes[9], ptrs[9]->key(),
+                                      ptrs[9]->keySize(), result));
+    }
+
+    // cleanup
+    for (size_t i = 0; i < 10; i++) {
+      delete ptrs[i];
+    }
+  }
 }
@@ -374,4 +374,51 @@ TEST_CASE("cache::PlainCache", "[cache][!hide][longRunning]") {
     manager.destroyCache(cacheMiss);
     manager.destroyCache(cacheMixed);
   }
+
+  SECTION("test hot set sampling") {
+    uint64_t cacheLimit = 256 * 1024;
+    auto postFn = [](std::function<void()>) -> bool { return false; };
+    Manager manager(postFn, 4 * cacheLimit);
+    auto named = manager.createCache(CacheType::Plain, false, cacheLimit);
+    auto unnamed = manager.createCache(CacheType::Plain, false, cacheLimit);
+    manager.setHotSetName(named->id(), "named");
+
+    for (uint64_t i = 0; i < 1024; i++) {
+      for (auto& cache : {named, unnamed}) {
+        CachedValue* value =
+            CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+        TRI_ASSERT(value != nullptr);
+        auto status = cache->insert(value);
+        if (status.fail()) {
+          delete value;
+        }
+      }
+    }
+    // make the first keys much hotter than the others
+    for (size_t round = 0; round < 8; round++) {
+      for (uint64_t i = 0; i < 16; i++) {
+        auto f = named->find(&i, sizeof(uint64_t));
+      }
+    }
+
+    auto hotSets = manager.sampleHotSets(16);
+    REQUIRE(hotSets.size() == 1);
+    REQUIRE(hotSets.find("named") != hotSets.end());
+    auto const& keys = hotSets["named"];
+    REQUIRE(keys.size() == 16);
+    for (auto const& key : keys) {
+      REQUIRE(key.size() == sizeof(uint64_t));
+      uint64_t i;
+      memcpy(&i, key.data(), sizeof(uint64_t));
+      REQUIRE(i < 16);
+    }
+
+    manager.setLoadedHotSets(std::move(hotSets));
+    REQUIRE(manager.takeLoadedHotSet("named").size() == 16);
+    REQUIRE(manager.takeLoadedHotSet("named").empty());
+
+    manager.destroyCache(named);
+    manager.destroyCache(unnamed);
+    REQUIRE(manager.sampleHotSets(16).empty());
+  }
 }
@@ -312,4 +312,64 @@ TEST_CASE("cache::Rebalancer", "[cache][!hide][longRunning]") {
 
     RandomGenerator::shutdown();
   }
+
+  SECTION("test utility rebalancing with PlainCache") {
+    RandomGenerator::initialize(RandomGenerator::RandomType::MERSENNE);
+    MockScheduler scheduler(4);
+    auto postFn = [&scheduler](std::function<void()> fn) -> bool {
+      scheduler.post(fn);
+      return true;
+    };
+    Manager manager(postFn, 128 * 1024 * 1024, true,
+                    Manager::RebalancingMode::utility);
+    Rebalancer rebalancer(&manager);
+
+    // the first cache has a working set far larger than its initial size,
+    // the second one a tiny working set that always fits
+    auto large = manager.createCache(CacheType::Plain);
+    auto small = manager.createCache(CacheType::Plain);
+
+    std::atomic<bool> doneRebalancing(false);
+    auto rebalanceWorker = [&rebalancer, &doneRebalancing]() -> void {
+      while (!doneRebalancing) {
+        int status = rebalancer.rebalance();
+        if (status != TRI_ERROR_ARANGO_BUSY) {
+          std::this_thread::sleep_for(std::chrono::microseconds(100 * 1000));
+        } else {
+          std::this_thread::sleep_for(std::chrono::microseconds(10 * 1000));
+        }
+      }
+    };
+    auto rebalancerThread = new std::thread(rebalanceWorker);
+
+    auto lookup = [](std::shared_ptr<Cache>& cache, uint64_t item) -> void {
+      Finding f = cache->find(&item, sizeof(uint64_t));
+      if (!f.found()) {
+        CachedValue* value = CachedValue::construct(&item, sizeof(uint64_t),
+                                                    &item, sizeof(uint64_t));
+        TRI_ASSERT(value != nullptr);
+        auto status = cache->insert(value);
+        if (status.fail()) {
+          delete value;
+        }
+      }
+    };
+
+    for (uint64_t i = 0; i < 4 * 1024 * 1024; i++) {
+      lookup(large, RandomGenerator::interval(static_cast<uint32_t>(
+                        256 * 1024 - 1)));
+      lookup(small, RandomGenerator::interval(static_cast<uint32_t>(255)));
+    }
+
+    doneRebalancing = true;
+    rebalancerThread->join();
+    delete rebalancerThread;
+
+    REQUIRE(large->size() > small->size());
+
+    manager.destroyCache(large);
+    manager.destroyCache(small);
+
+    RandomGenerator::shutdown();
+  }
 }
@@ -28,6 +28,7 @@
 #include "Cache/Table.h"
 #include "Basics/Common.h"
 #include "Cache/Common.h"
+#include "Cache/NumaPlacement.h"
 #include "Cache/PlainBucket.h"
 
 #include "catch.hpp"
@@ -41,7 +42,8 @@ TEST_CASE("cache::Table", "[cache]") {
   SECTION("test static allocation size method") {
     for (uint32_t i = Table::minLogSize; i <= Table::maxLogSize; i++) {
       REQUIRE(Table::allocationSize(i) ==
-              (sizeof(Table) + (BUCKET_SIZE << i) + Table::padding));
+              (sizeof(Table) + (BUCKET_SIZE << i) + Table::padding +
+               (sizeof(uint64_t) << i) + (sizeof(uint32_t) << i)));
     }
   }
 
@@ -50,12 +52,29 @@ TEST_CASE("cache::Table", "[cache]") {
       auto table = std::make_shared<Table>(i);
       REQUIRE(table.get() != nullptr);
       REQUIRE(table->memoryUsage() ==
-              (sizeof(Table) + (BUCKET_SIZE << i) + Table::padding));
+              (sizeof(Table) + (BUCKET_SIZE << i) + Table::padding +
+               (sizeof(uint64_t) << i) + (sizeof(uint32_t) << i)));
       REQUIRE(table->logSize() == i);
       REQUIRE(table->size() == (static_cast<uint64_t>(1) << i));
     }
   }
 
+  SECTION("test constructor with interleaved memory") {
+    auto table = std::make_shared<Table>(16, true);
+    REQUIRE(table.get() != nullptr);
+    REQUIRE(table->memoryUsage() == Table::allocationSize(16));
+    table->enable();
+    for (uint64_t i = 0; i < table->size(); i++) {
+      uint32_t hash = static_cast<uint32_t>(i << (32 - 16));
+      auto pair = table->fetchAndLockBucket(hash, -1);
+      auto bucket = reinterpret_cast<PlainBucket*>(pair.first);
+      REQUIRE(bucket != nullptr);
+      REQUIRE(bucket->isLocked());
+      REQUIRE(NumaPlacement::nodeOf(bucket) < NumaPlacement::nodes());
+      bucket->unlock();
+    }
+  }
+
   SECTION("test basic bucket-fetching behavior") {
     auto table = std::make_shared<Table>(Table::minLogSize);
     REQUIRE(table.get() != nullptr);
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::RequestCoalescer
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cluster/RequestCoalescer.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace arangodb;
+
+TEST_CASE("RequestCoalescer", "[cluster]") {
+  SECTION("a single operation is executed on its own") {
+    RequestCoalescer coalescer(1000, 100);
+    size_t executed = 0;
+
+    RequestCoalescer::Operation op;
+    op._body = "a";
+    coalescer.execute("key", op,
+                      [&executed](std::vector<RequestCoalescer::Operation*>& ops) {
+                        ++executed;
+                        REQUIRE(ops.size() == 1);
+                        ops[0]->_responseCode = rest::ResponseCode::CREATED;
+                      });
+
+    CHECK(executed == 1);
+    CHECK(op._result.ok());
+    CHECK(op._responseCode == rest::ResponseCode::CREATED);
+  }
+
+  SECTION("concurrent operations of a key are executed in batches") {
+    size_t const n = 32;
+    RequestCoalescer coalescer(200000, 8);
+    std::atomic<size_t> batches(0);
+    std::atomic<size_t> executed(0);
+    std::atomic<size_t> largest(0);
+
+    std::vector<RequestCoalescer::Operation> ops(n);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < n; ++i) {
+      ops[i]._body = std::to_string(i);
+      threads.emplace_back([&, i]() {
+        coalescer.execute("key", ops[i],
+                          [&](std::vector<RequestCoalescer::Operation*>& batch) {
+                            ++batches;
+                            executed += batch.size();
+                            // assertions are not thread-safe
+                            size_t size = largest.load();
+                            while (batch.size() > size &&
+                                   !largest.compare_exchange_weak(size, batch.size())) {
+                            }
+                            for (auto* op : batch) {
+                              op->_responseCode = rest::ResponseCode::ACCEPTED;
+                            }
+                          });
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    CHECK(executed.load() == n);
+    CHECK(largest.load() <= 8);
+    CHECK(batches.load() < n);
+    for (auto const& op : ops) {
+      CHECK(op._responseCode == rest::ResponseCode::ACCEPTED);
+    }
+  }
+
+  SECTION("operations of different keys are not merged") {
+    RequestCoalescer coalescer(50000, 100);
+    std::atomic<size_t> batches(0);
+    std::atomic<size_t> merged(0);
+
+    std::vector<RequestCoalescer::Operation> ops(2);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 2; ++i) {
+      threads.emplace_back([&, i]() {
+        coalescer.execute("key" + std::to_string(i), ops[i],
+                          [&](std::vector<RequestCoalescer::Operation*>& batch) {
+                            ++batches;
+                            if (batch.size() != 1) {
+                              ++merged;
+                            }
+                          });
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    CHECK(batches.load() == 2);
+    CHECK(merged.load() == 0);
+  }
+
+  SECTION("an exception of the executor fails all operations of the batch") {
+    RequestCoalescer coalescer(1000, 100);
+
+    RequestCoalescer::Operation op;
+    coalescer.execute("key", op,
+                      [](std::vector<RequestCoalescer::Operation*>&) {
+                        throw std::runtime_error("boom");
+                      });
+
+    CHECK(op._result.errorNumber() == TRI_ERROR_INTERNAL);
+  }
+}
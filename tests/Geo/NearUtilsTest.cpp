@@ -193,6 +193,30 @@ TEST_CASE("Simple near queries", "[geo][s2index]") {
     REQUIRE(coords[4] == S2LatLng::FromDegrees(1,0));
   }
 
+  SECTION("repeated query with limit uses same covering") {
+    params.ascending = true;
+    params.origin = S2LatLng::FromDegrees(10.0001, 20.0001);
+    geo::QueryParams params2;
+    params2.sorted = true;
+    params2.ascending = true;
+    AscIterator near(std::move(params));
+    std::vector<LocalDocumentId> result = nearSearch(index, docs, near, 5);
+    REQUIRE(result.size() == 5);
+
+    // slightly shifted origin, should get the same quantized covering
+    params2.origin = S2LatLng::FromDegrees(10.0002, 20.0002);
+    AscIterator near2(std::move(params2));
+    std::vector<LocalDocumentId> result2 = nearSearch(index, docs, near2, 5);
+    REQUIRE(result2.size() == 5);
+
+    std::vector<S2LatLng> coords = convert(docs, result);
+    std::vector<S2LatLng> coords2 = convert(docs, result2);
+    REQUIRE(coords[0] == S2LatLng::FromDegrees(10,20));
+    std::sort(coords.begin(), coords.end());
+    std::sort(coords2.begin(), coords2.end());
+    REQUIRE(coords == coords2);
+  }
+
   SECTION("query sorted ascending with limit and max distance") {
     params.ascending = true;
     params.maxDistance = 111200.0;
@@ -438,6 +438,27 @@ TEST_CASE("Shape container tests", "[geo][s2index]") {
     REQUIRE(!shape.contains(S2LatLng::FromDegrees(1.0, 1.0).ToPoint()));
     REQUIRE(!shape.intersects(S2LatLng::FromDegrees(1.0, 1.0).ToPoint()));
 
+    // shapes with disjoint bounds
+    VPackBuilder farBuilder;
+    {
+      ObjectBuilder object(&farBuilder);
+      object->add("type", VPackValue("Polygon"));
+      ArrayBuilder rings(&farBuilder, "coordinates");
+      ArrayBuilder points(&farBuilder);
+      for (auto const& lngLat : std::vector<std::pair<double, double>>{
+               {10.0, 10.0}, {11.0, 10.0}, {10.0, 11.0}, {10.0, 10.0}}) {
+        ArrayBuilder point(&farBuilder);
+        point->add(VPackValue(lngLat.first));
+        point->add(VPackValue(lngLat.second));
+      }
+    }
+    ShapeContainer far;
+    REQUIRE(parseRegion(farBuilder.slice(), far).ok());
+    REQUIRE(!shape.contains(&far));
+    REQUIRE(!shape.intersects(&far));
+    REQUIRE(!far.intersects(&shape));
+    REQUIRE(shape.intersects(&shape));
+
     // query params
     QueryParams qp;
     shape.updateBounds(qp);
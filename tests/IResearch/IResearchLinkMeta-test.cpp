@@ -566,6 +566,32 @@ SECTION("test_writeCustomizedValues") {
   CHECK(true == expectedAnalyzers.empty());
 }
 
+SECTION("test_storedValues") {
+  arangodb::iresearch::IResearchLinkMeta meta;
+  std::string tmpString;
+
+  // invalid entry
+  {
+    auto json = arangodb::velocypack::Parser::fromJson("{ \"storedValues\": [ \"a\", 1 ] }");
+    CHECK((false == meta.init(json->slice(), tmpString)));
+    CHECK((std::string("storedValues=>[1]") == tmpString));
+  }
+
+  // sorted and unique
+  {
+    auto json = arangodb::velocypack::Parser::fromJson("{ \"storedValues\": [ \"b\", \"a\", \"b\" ] }");
+    CHECK((true == meta.init(json->slice(), tmpString)));
+    CHECK((std::vector<std::string>{ "a", "b" } == meta._storedValues));
+
+    arangodb::velocypack::Builder builder;
+    CHECK((true == meta.json(arangodb::velocypack::ObjectBuilder(&builder))));
+    auto tmpSlice = builder.slice().get("storedValues");
+    CHECK((true == tmpSlice.isArray() && 2 == tmpSlice.length()));
+    CHECK((std::string("a") == tmpSlice.at(0).copyString()));
+    CHECK((std::string("b") == tmpSlice.at(1).copyString()));
+  }
+}
+
 SECTION("test_readMaskAll") {
   arangodb::iresearch::IResearchLinkMeta meta;
   arangodb::iresearch::IResearchLinkMeta::Mask mask;
@@ -576,6 +602,7 @@ SECTION("test_readMaskAll") {
     \"includeAllFields\": true, \
     \"trackListPositions\": true, \
     \"storeValues\": \"full\", \
+    \"storedValues\": [], \
     \"analyzers\": [] \
   }");
   CHECK(true == meta.init(json->slice(), tmpString, arangodb::iresearch::IResearchLinkMeta::DEFAULT(), &mask));
@@ -583,6 +610,7 @@ SECTION("test_readMaskAll") {
   CHECK(true == mask._includeAllFields);
   CHECK(true == mask._trackListPositions);
   CHECK((true == mask._storeValues));
+  CHECK((true == mask._storedValues));
   CHECK(true == mask._analyzers);
 }
 
@@ -597,6 +625,7 @@ SECTION("test_readMaskNone") {
   CHECK(false == mask._includeAllFields);
   CHECK(false == mask._trackListPositions);
   CHECK((false == mask._storeValues));
+  CHECK((false == mask._storedValues));
   CHECK(false == mask._analyzers);
 }
 
@@ -895,6 +895,7 @@ SECTION("serialize") {
       CHECK(node.sortCondition() == deserialized.sortCondition());
       CHECK(node.volatility() == deserialized.volatility());
       CHECK(node.options().forceSync == deserialized.options().forceSync);
+      CHECK(node.scoreLimit() == deserialized.scoreLimit());
 
       CHECK(node.getCost() == deserialized.getCost());
     }
@@ -919,6 +920,7 @@ SECTION("serialize") {
       CHECK(node.sortCondition() == deserialized.sortCondition());
       CHECK(node.volatility() == deserialized.volatility());
       CHECK(node.options().forceSync == deserialized.options().forceSync);
+      CHECK(node.scoreLimit() == deserialized.scoreLimit());
 
       CHECK(node.getCost() == deserialized.getCost());
     }
@@ -951,6 +953,8 @@ SECTION("serialize") {
     CHECK(node.collections().empty()); // view has no links
     CHECK(node.shards().empty());
     CHECK(true == node.options().forceSync);
+    CHECK(0 == node.scoreLimit());
+    node.scoreLimit(10);
 
     arangodb::velocypack::Builder builder;
     unsigned flags = arangodb::aql::ExecutionNode::SERIALIZE_DETAILS;
@@ -983,6 +987,7 @@ SECTION("serialize") {
       CHECK(node.sortCondition() == deserialized.sortCondition());
       CHECK(node.volatility() == deserialized.volatility());
       CHECK(node.options().forceSync == deserialized.options().forceSync);
+      CHECK(node.scoreLimit() == deserialized.scoreLimit());
 
       CHECK(node.getCost() == deserialized.getCost());
     }
@@ -1007,6 +1012,7 @@ SECTION("serialize") {
       CHECK(node.sortCondition() == deserialized.sortCondition());
       CHECK(node.volatility() == deserialized.volatility());
       CHECK(node.options().forceSync == deserialized.options().forceSync);
+      CHECK(node.scoreLimit() == deserialized.scoreLimit());
 
       CHECK(node.getCost() == deserialized.getCost());
     }
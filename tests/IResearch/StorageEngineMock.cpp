@@ -410,6 +410,81 @@ class EdgeIndexMock final : public arangodb::Index {
   EdgeIndexIteratorMock::Map _edgesTo;
 }; // EdgeIndexMock
 
+class HashIndexMock final : public arangodb::Index {
+ public:
+  static std::shared_ptr<arangodb::Index> make(
+      TRI_idx_iid_t iid,
+      arangodb::LogicalCollection& collection,
+      arangodb::velocypack::Slice const& definition
+  ) {
+    auto const type = arangodb::basics::VelocyPackHelper::getStringRef(
+      definition.get("type"),
+      arangodb::velocypack::StringRef()
+    );
+
+    if (type.compare("hash") != 0) {
+      return nullptr;
+    }
+
+    return std::make_shared<HashIndexMock>(iid, collection, definition);
+  }
+
+  HashIndexMock(
+      TRI_idx_iid_t iid,
+      arangodb::LogicalCollection& collection,
+      arangodb::velocypack::Slice const& definition
+  ): arangodb::Index(iid, collection, definition) {
+  }
+
+  IndexType type() const override { return Index::TRI_IDX_TYPE_HASH_INDEX; }
+
+  char const* typeName() const override { return "hash"; }
+
+  bool canBeDropped() const override { return true; }
+
+  bool isSorted() const override { return false; }
+
+  bool hasSelectivityEstimate() const override { return false; }
+
+  size_t memory() const override { return sizeof(HashIndexMock); }
+
+  bool hasBatchInsert() const override { return false; }
+
+  void load() override {}
+  void unload() override {}
+
+  void toVelocyPack(
+      VPackBuilder& builder,
+      std::underlying_type<arangodb::Index::Serialize>::type flags
+  ) const override {
+    builder.openObject();
+    Index::toVelocyPack(builder, flags);
+    builder.add("unique", VPackValue(unique()));
+    builder.add("sparse", VPackValue(sparse()));
+    builder.close();
+  }
+
+  // only the definition is of interest, so no values are stored and
+  // queries do not use the index
+  arangodb::Result insert(
+      arangodb::transaction::Methods*,
+      arangodb::LocalDocumentId const&,
+      arangodb::velocypack::Slice const&,
+      OperationMode
+  ) override {
+    return {}; // ok
+  }
+
+  arangodb::Result remove(
+      arangodb::transaction::Methods*,
+      arangodb::LocalDocumentId const&,
+      arangodb::velocypack::Slice const&,
+      OperationMode
+  ) override {
+    return {}; // ok
+  }
+}; // HashIndexMock
+
 class ReverseAllIteratorMock final : public arangodb::IndexIterator {
  public:
   ReverseAllIteratorMock(
@@ -552,6 +627,8 @@ std::shared_ptr<arangodb::Index> PhysicalCollectionMock::createIndex(arangodb::t
 
   if (0 == type.compare("edge")) {
     index = EdgeIndexMock::make(++lastId, _logicalCollection, info);
+  } else if (0 == type.compare("hash")) {
+    index = HashIndexMock::make(++lastId, _logicalCollection, info);
 #ifdef USE_IRESEARCH
   } else if (0 == type.compare(arangodb::iresearch::DATA_SOURCE_TYPE.name())) {
 
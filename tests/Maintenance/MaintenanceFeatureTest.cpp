@@ -66,6 +66,10 @@ public:
       _labels.emplace(FAST_TRACK);
     }
 
+    if (description.get("priority", value).ok()) {
+      _priority = std::atoi(value.c_str());
+    }
+
     if (description.get("result_code", value).ok()) {
       _resultCode = std::atol(value.c_str());
     } // if
@@ -388,6 +392,38 @@ TEST_CASE("MaintenanceFeatureUnthreaded", "[cluster][maintenance][devel]") {
     REQUIRE(tf._recentAction->getStartTime() <= tf._recentAction->getDoneTime());
     REQUIRE(tf._recentAction->getLastStatTime() <= tf._recentAction->getDoneTime());
   }
+
+  SECTION("Ready actions of higher priority are found first") {
+    std::shared_ptr<arangodb::options::ProgramOptions> po =
+      std::make_shared<arangodb::options::ProgramOptions>(
+        "test", std::string(), std::string(), "path");
+    arangodb::application_features::ApplicationServer as(po, nullptr);
+
+    TestMaintenanceFeature tf(as);
+
+    std::unique_ptr<ActionBase> action_base_ptr;
+    action_base_ptr.reset(
+      (ActionBase*) new TestActionBasic(
+        tf, ActionDescription(std::map<std::string,std::string>{
+            {"name","TestActionBasic"},{"iterate_count","1"}})));
+    REQUIRE(tf.addAction(
+      std::make_shared<Action>(std::move(action_base_ptr)), false).ok());
+    auto normal = tf._recentAction;
+
+    action_base_ptr.reset(
+      (ActionBase*) new TestActionBasic(
+        tf, ActionDescription(std::map<std::string,std::string>{
+            {"name","TestActionBasic"},{"iterate_count","2"},
+            {"priority",std::to_string(ActionBase::HIGH_PRIORITY)}})));
+    REQUIRE(tf.addAction(
+      std::make_shared<Action>(std::move(action_base_ptr)), false).ok());
+    auto high = tf._recentAction;
+
+    REQUIRE(tf.findReadyAction() == high);
+    REQUIRE(high->getState() == EXECUTING);
+    REQUIRE(tf.findReadyAction() == normal);
+    REQUIRE(normal->getState() == EXECUTING);
+  }
 } // MaintenanceFeatureUnthreaded
 
 TEST_CASE("MaintenanceFeatureThreaded", "[cluster][maintenance][devel]") {
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include "../Aql/QueryTestSetup.h"
+#include "../IResearch/RestHandlerMock.h"
+#include "Basics/StaticStrings.h"
+#include "RestHandler/RestSimpleHandler.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "velocypack/Iterator.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <set>
+
+namespace {
+
+/// @brief sends a lookup request to the simple handler. the handler is
+/// returned, because the documents in its response point into its query
+/// result
+std::shared_ptr<arangodb::RestSimpleHandler> lookup(
+    TRI_vocbase_t& vocbase, std::string const& body) {
+  auto requestPtr = std::make_unique<GeneralRequestMock>(vocbase);
+  auto responsePtr = std::make_unique<GeneralResponseMock>();
+  requestPtr->setRequestType(arangodb::rest::RequestType::PUT);
+  requestPtr->setRequestPath(arangodb::RestVocbaseBaseHandler::SIMPLE_LOOKUP_PATH);
+  requestPtr->_payload.add(arangodb::velocypack::Parser::fromJson(body)->slice());
+
+  auto handler = std::make_shared<arangodb::RestSimpleHandler>(
+    requestPtr.release(), responsePtr.release(),
+    arangodb::QueryRegistryFeature::registry()
+  );
+  CHECK((arangodb::RestStatus::DONE == handler->execute()));
+
+  return handler;
+}
+
+arangodb::velocypack::Slice payload(arangodb::RestSimpleHandler const& handler) {
+  return static_cast<GeneralResponseMock*>(handler.response())->_payload.slice();
+}
+
+/// @brief the keys of the documents found by a lookup
+std::set<std::string> foundKeys(arangodb::RestSimpleHandler const& handler) {
+  auto const documents = payload(handler).get("documents").resolveExternal();
+  REQUIRE((documents.isArray()));
+
+  std::set<std::string> keys;
+  for (auto const& doc : arangodb::velocypack::ArrayIterator(documents)) {
+    keys.emplace(doc.get(arangodb::StaticStrings::KeyString).copyString());
+  }
+  return keys;
+}
+
+int errorNum(arangodb::velocypack::Slice const& slice) {
+  return slice.get(arangodb::StaticStrings::ErrorNum).getNumber<int>();
+}
+
+}
+
+TEST_CASE("RestSimpleHandlerTest", "[rest]") {
+  arangodb::tests::AqlQuerySetup s;
+  UNUSED(s);
+
+  TRI_vocbase_t vocbase(TRI_vocbase_type_e::TRI_VOCBASE_TYPE_NORMAL, 1, "testVocbase");
+
+  auto createJson = arangodb::velocypack::Parser::fromJson("{ \"name\": \"testCollection\" }");
+  auto collection = vocbase.createCollection(createJson->slice());
+  REQUIRE((nullptr != collection));
+
+  // k<i> has the unique code c<i>, but shares its group with other documents
+  {
+    arangodb::OperationOptions options;
+    arangodb::SingleCollectionTransaction trx(
+      arangodb::transaction::StandaloneContext::Create(vocbase),
+      *collection,
+      arangodb::AccessMode::Type::WRITE
+    );
+    REQUIRE((trx.begin().ok()));
+
+    for (size_t i = 0; i < 10; ++i) {
+      auto doc = arangodb::velocypack::Parser::fromJson(
+        "{ \"_key\": \"k" + std::to_string(i) + "\", \"code\": \"c" +
+        std::to_string(i) + "\", \"group\": " + std::to_string(i % 3) +
+        ", \"a\": " + std::to_string(i) + ", \"b\": " + std::to_string(i) + " }"
+      );
+      CHECK((trx.insert(collection->name(), doc->slice(), options).ok()));
+    }
+
+    CHECK((trx.commit().ok()));
+  }
+
+  for (auto const& definition : {
+         "{ \"type\": \"hash\", \"fields\": [ \"code\" ], \"unique\": true }",
+         "{ \"type\": \"hash\", \"fields\": [ \"group\" ], \"unique\": false }",
+         "{ \"type\": \"hash\", \"fields\": [ \"a\", \"b\" ], \"unique\": true }" }) {
+    bool created = false;
+    auto indexJson = arangodb::velocypack::Parser::fromJson(definition);
+    REQUIRE((nullptr != collection->createIndex(nullptr, indexJson->slice(), created)));
+    CHECK((created));
+  }
+
+  SECTION("test_lookup_by_key_with_missing_keys") {
+    auto handler = lookup(vocbase,
+      "{ \"collection\": \"testCollection\", "
+      "\"keys\": [ \"k2\", \"missing\", \"testCollection/k5\", \"k11\" ] }");
+    CHECK((arangodb::rest::ResponseCode::OK == handler->response()->responseCode()));
+    CHECK((false == payload(*handler).get(arangodb::StaticStrings::Error).getBoolean()));
+    CHECK((std::set<std::string>{ "k2", "k5" } == foundKeys(*handler)));
+  }
+
+  SECTION("test_lookup_by_unique_attribute") {
+    auto handler = lookup(vocbase,
+      "{ \"collection\": \"testCollection\", \"attribute\": \"code\", "
+      "\"keys\": [ \"c1\", \"c4\", \"c7\" ] }");
+    CHECK((arangodb::rest::ResponseCode::OK == handler->response()->responseCode()));
+    CHECK((std::set<std::string>{ "k1", "k4", "k7" } == foundKeys(*handler)));
+  }
+
+  SECTION("test_lookup_by_unique_attribute_with_missing_keys") {
+    auto handler = lookup(vocbase,
+      "{ \"collection\": \"testCollection\", \"attribute\": \"code\", "
+      "\"keys\": [ \"missing\", \"c3\", \"k3\", \"c10\", \"c9\" ] }");
+    CHECK((arangodb::rest::ResponseCode::OK == handler->response()->responseCode()));
+    CHECK((std::set<std::string>{ "k3", "k9" } == foundKeys(*handler)));
+
+    auto none = lookup(vocbase,
+      "{ \"collection\": \"testCollection\", \"attribute\": \"code\", "
+      "\"keys\": [ \"missing\" ] }");
+    CHECK((arangodb::rest::ResponseCode::OK == none->response()->responseCode()));
+    CHECK((foundKeys(*none).empty()));
+  }
+
+  SECTION("test_lookup_by_non_unique_attribute") {
+    auto handler = lookup(vocbase,
+      "{ \"collection\": \"testCollection\", \"attribute\": \"group\", "
+      "\"keys\": [ 1 ] }");
+    CHECK((arangodb::rest::ResponseCode::BAD == handler->response()->responseCode()));
+    CHECK((TRI_ERROR_BAD_PARAMETER == errorNum(payload(*handler))));
+  }
+
+  SECTION("test_lookup_by_attribute_without_unique_index") {
+    // only covered by a unique index on several attributes
+    auto combined = lookup(vocbase,
+      "{ \"collection\": \"testCollection\", \"attribute\": \"a\", "
+      "\"keys\": [ 1 ] }");
+    CHECK((arangodb::rest::ResponseCode::BAD == combined->response()->responseCode()));
+    CHECK((TRI_ERROR_BAD_PARAMETER == errorNum(payload(*combined))));
+
+    auto unindexed = lookup(vocbase,
+      "{ \"collection\": \"testCollection\", \"attribute\": \"value\", "
+      "\"keys\": [ 1 ] }");
+    CHECK((arangodb::rest::ResponseCode::BAD == unindexed->response()->responseCode()));
+    CHECK((TRI_ERROR_BAD_PARAMETER == errorNum(payload(*unindexed))));
+  }
+
+  SECTION("test_read_many_documents") {
+    arangodb::OperationOptions options;
+    arangodb::SingleCollectionTransaction trx(
+      arangodb::transaction::StandaloneContext::Create(vocbase),
+      *collection,
+      arangodb::AccessMode::Type::READ
+    );
+    REQUIRE((trx.begin().ok()));
+
+    // the documents are read at once, but reported in request order, with
+    // the errors in between
+    auto keys = arangodb::velocypack::Parser::fromJson(
+      "[ { \"_key\": \"k3\" }, \"missing\", \"k1\", "
+      "{ \"_key\": \"k2\", \"_rev\": \"1\" }, \"\", \"k3\", \"k11\" ]");
+    auto res = trx.document(collection->name(), keys->slice(), options);
+    REQUIRE((res.ok()));
+
+    auto const docs = res.slice();
+    REQUIRE((docs.isArray()));
+    REQUIRE((7 == docs.length()));
+    CHECK((std::string("k3") == docs.at(0).get(arangodb::StaticStrings::KeyString).copyString()));
+    CHECK((std::string("c3") == docs.at(0).get("code").copyString()));
+    CHECK((TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND == errorNum(docs.at(1))));
+    CHECK((std::string("k1") == docs.at(2).get(arangodb::StaticStrings::KeyString).copyString()));
+    CHECK((TRI_ERROR_ARANGO_CONFLICT == errorNum(docs.at(3))));
+    CHECK((TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD == errorNum(docs.at(4))));
+    CHECK((std::string("k3") == docs.at(5).get(arangodb::StaticStrings::KeyString).copyString()));
+    CHECK((TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND == errorNum(docs.at(6))));
+
+    CHECK((2 == res.countErrorCodes[TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND]));
+    CHECK((1 == res.countErrorCodes[TRI_ERROR_ARANGO_CONFLICT]));
+
+    CHECK((trx.commit().ok()));
+  }
+}
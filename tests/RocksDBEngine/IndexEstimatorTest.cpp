@@ -33,6 +33,8 @@
 #include "RocksDBEngine/RocksDBFormat.h"
 #include "RocksDBEngine/RocksDBTypes.h"
 
+#include <thread>
+
 using namespace arangodb;
 
 // -----------------------------------------------------------------------------
@@ -271,5 +273,56 @@ TEST_CASE("IndexEstimator", "[rocksdb][indexestimator]") {
     REQUIRE(0.1 == est.computeEstimate());
   }
 
+  SECTION("test_blocker_logic_concurrent") {
+    std::string serialization;
+    RocksDBCuckooIndexEstimator<uint64_t> est(2048);
+    std::atomic<rocksdb::SequenceNumber> currentSeq(0);
+    std::atomic<bool> failed(false);
+
+    // all threads buffer the same values concurrently, each with its own
+    // blocker. the updates have to be merged from all buffers
+    size_t const numThreads = 8;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; t++) {
+      threads.emplace_back([&est, &currentSeq, &failed, t]() {
+        for (size_t iteration = 0; iteration < 10; iteration++) {
+          uint64_t trxId = t * 100 + iteration;
+          uint64_t index = 0;
+          std::vector<uint64_t> toInsert(10);
+          std::vector<uint64_t> toRemove(0);
+          std::generate(toInsert.begin(), toInsert.end(),
+                        [&index] { return ++index; });
+          auto res = est.placeBlocker(trxId, ++currentSeq);
+          if (res.fail()) {
+            failed = true;
+          }
+          est.bufferUpdates(++currentSeq, std::move(toInsert),
+                            std::move(toRemove));
+          est.removeBlocker(trxId);
+        }
+      });
+    }
+    for (auto& it : threads) {
+      it.join();
+    }
+    REQUIRE(!failed);
+
+    auto expected = ++currentSeq;
+    auto actual = est.serialize(serialization, expected);
+    REQUIRE(actual == expected);
+    REQUIRE(!est.needToPersist());
+    REQUIRE((1.0 / static_cast<double>(numThreads * 10)) ==
+            est.computeEstimate());
+
+    // the serialized state has to match the applied one
+    rocksdb::SequenceNumber seq = rocksutils::uint64FromPersistent(serialization.data());
+    StringRef ref(serialization.data() + sizeof(uint64_t),
+                  serialization.size() - sizeof(uint64_t));
+    RocksDBCuckooIndexEstimator<uint64_t> copy(seq, ref);
+    REQUIRE(seq == expected);
+    REQUIRE(est.nrUsed() == copy.nrUsed());
+    REQUIRE(est.computeEstimate() == copy.computeEstimate());
+  }
+
   // @brief generate tests
 }
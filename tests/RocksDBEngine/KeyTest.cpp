@@ -496,6 +496,30 @@ TEST_CASE("RocksDBKeyBoundsTest Little-Endian", "[rocksdb][keybounds]") {
     CHECK(cmp->Compare(key.string(), bb2.end()) < 0);
   }*/
   
+  /// @brief test partitioning of the documents of a collection
+  SECTION("test_document_partitions") {
+    rocksdb::Comparator const* cmp = rocksdb::BytewiseComparator();
+    RocksDBKeyBounds all = RocksDBKeyBounds::CollectionDocuments(7);
+    RocksDBKeyBounds p1 = RocksDBKeyBounds::CollectionDocuments(7, 0, 0x8000000000000000ULL);
+    RocksDBKeyBounds p2 = RocksDBKeyBounds::CollectionDocuments(7, 0x8000000000000000ULL, UINT64_MAX);
+
+    // adjacent partitions cover the collection without gaps
+    CHECK(cmp->Compare(all.start(), p1.start()) <= 0);
+    CHECK(cmp->Compare(p1.end(), p2.start()) == 0);
+    CHECK(cmp->Compare(p2.end(), all.end()) == 0);
+
+    // every document belongs to exactly one partition
+    for (uint64_t id : {1ULL, 255ULL, 256ULL, 0x00FF00FF00FF00FFULL, 0xFF00000000000000ULL}) {
+      RocksDBKey key;
+      key.constructDocument(7, LocalDocumentId(id));
+      bool inP1 = cmp->Compare(p1.start(), key.string()) <= 0 &&
+                  cmp->Compare(key.string(), p1.end()) < 0;
+      bool inP2 = cmp->Compare(p2.start(), key.string()) <= 0 &&
+                  cmp->Compare(key.string(), p2.end()) < 0;
+      CHECK(inP1 != inP2);
+    }
+  }
+
   /// @brief test edge index with dynamic prefix extractor
   SECTION("test_edge_index") {
     
@@ -635,6 +659,30 @@ TEST_CASE("RocksDBKeyBoundsTest Big-Endian", "[rocksdb][keybounds]") {
     CHECK(cmp->Compare(key.string(), bb2.end()) < 0);
   }*/
   
+  /// @brief test partitioning of the documents of a collection
+  SECTION("test_document_partitions") {
+    rocksdb::Comparator const* cmp = rocksdb::BytewiseComparator();
+    RocksDBKeyBounds all = RocksDBKeyBounds::CollectionDocuments(7);
+    RocksDBKeyBounds p1 = RocksDBKeyBounds::CollectionDocuments(7, 0, 0x8000000000000000ULL);
+    RocksDBKeyBounds p2 = RocksDBKeyBounds::CollectionDocuments(7, 0x8000000000000000ULL, UINT64_MAX);
+
+    // adjacent partitions cover the collection without gaps
+    CHECK(cmp->Compare(all.start(), p1.start()) <= 0);
+    CHECK(cmp->Compare(p1.end(), p2.start()) == 0);
+    CHECK(cmp->Compare(p2.end(), all.end()) == 0);
+
+    // every document belongs to exactly one partition
+    for (uint64_t id : {1ULL, 255ULL, 256ULL, 0x00FF00FF00FF00FFULL, 0xFF00000000000000ULL}) {
+      RocksDBKey key;
+      key.constructDocument(7, LocalDocumentId(id));
+      bool inP1 = cmp->Compare(p1.start(), key.string()) <= 0 &&
+                  cmp->Compare(key.string(), p1.end()) < 0;
+      bool inP2 = cmp->Compare(p2.start(), key.string()) <= 0 &&
+                  cmp->Compare(key.string(), p2.end()) < 0;
+      CHECK(inP1 != inP2);
+    }
+  }
+
   /// @brief test edge index with dynamic prefix extractor
   SECTION("test_edge_index") {
     
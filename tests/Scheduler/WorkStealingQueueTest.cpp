@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::rest::WorkStealingQueue
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Scheduler/WorkStealingQueue.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+using namespace arangodb::rest;
+
+TEST_CASE("rest::WorkStealingQueue", "[scheduler]") {
+  SECTION("test elements are taken in arrival order") {
+    WorkStealingQueue<uint64_t, 16> queue;
+    std::vector<uint64_t> values(16);
+
+    REQUIRE(queue.empty());
+    REQUIRE(nullptr == queue.steal());
+
+    for (uint64_t i = 0; i < 16; i++) {
+      values[i] = i;
+      REQUIRE(queue.push(&values[i]));
+    }
+    REQUIRE(16 == queue.size());
+
+    // the queue is full now
+    uint64_t other = 0;
+    REQUIRE(!queue.push(&other));
+
+    for (uint64_t i = 0; i < 16; i++) {
+      uint64_t* value = queue.steal();
+      REQUIRE(nullptr != value);
+      REQUIRE(i == *value);
+    }
+    REQUIRE(queue.empty());
+    REQUIRE(nullptr == queue.steal());
+
+    // the slots are reused after wrapping around
+    REQUIRE(queue.push(&other));
+    REQUIRE(&other == queue.steal());
+  }
+
+  SECTION("test concurrent stealing takes every element once") {
+    constexpr uint64_t numValues = 100000;
+    constexpr size_t numThieves = 4;
+
+    WorkStealingQueue<uint64_t, 256> queue;
+    std::vector<uint64_t> values(numValues);
+    std::vector<std::atomic<uint64_t>> taken(numValues);
+    for (uint64_t i = 0; i < numValues; i++) {
+      values[i] = i;
+      taken[i].store(0);
+    }
+
+    std::atomic<bool> done(false);
+    std::atomic<uint64_t> total(0);
+    auto thief = [&]() {
+      while (true) {
+        bool finished = done.load();
+        uint64_t* value = queue.steal();
+        if (value != nullptr) {
+          taken[*value]++;
+          total++;
+        } else if (finished) {
+          break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThieves; i++) {
+      threads.emplace_back(thief);
+    }
+
+    // the owner also takes elements, like a worker running its own jobs
+    for (uint64_t i = 0; i < numValues; i++) {
+      while (!queue.push(&values[i])) {
+        uint64_t* value = queue.steal();
+        if (value != nullptr) {
+          taken[*value]++;
+          total++;
+        }
+      }
+    }
+    done.store(true);
+
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    REQUIRE(numValues == total.load());
+    for (uint64_t i = 0; i < numValues; i++) {
+      REQUIRE(1 == taken[i].load());
+    }
+  }
+}
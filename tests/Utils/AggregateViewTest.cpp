@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test case for AggregateView
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2018 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Utils/AggregateView.h"
+
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+
+std::shared_ptr<AggregateView> createView() {
+  auto definition = VPackParser::fromJson(
+    "{\"name\":\"v\",\"collection\":\"c\","
+    "\"groups\":[{\"name\":\"g\",\"attribute\":\"group\"}],"
+    "\"aggregates\":[{\"name\":\"count\",\"function\":\"COUNT\"},"
+    "{\"name\":\"sum\",\"function\":\"SUM\",\"attribute\":\"value\"},"
+    "{\"name\":\"avg\",\"function\":\"AVERAGE\",\"attribute\":\"value\"},"
+    "{\"name\":\"min\",\"function\":\"MIN\",\"attribute\":\"value\"},"
+    "{\"name\":\"max\",\"function\":\"MAX\",\"attribute\":\"value\"}]}");
+  std::shared_ptr<AggregateView> view;
+  REQUIRE(AggregateView::create("db", definition->slice(), view).ok());
+  return view;
+}
+
+void insert(AggregateView& view, std::string const& json) {
+  view.insert(VPackParser::fromJson(json)->slice());
+}
+
+VPackBuilder result(AggregateView& view) {
+  VPackBuilder builder;
+  view.toResult(builder);
+  return builder;
+}
+
+}
+
+TEST_CASE("AggregateView", "[aggregateview]") {
+
+SECTION("invalid definitions are rejected") {
+  std::shared_ptr<AggregateView> view;
+  for (auto const& json : {
+         "{\"collection\":\"c\",\"groups\":[{\"name\":\"g\",\"attribute\":\"a\"}]}",
+         "{\"name\":\"v\",\"collection\":\"c\"}",
+         "{\"name\":\"v\",\"collection\":\"c\",\"groups\":[{\"name\":\"g\",\"attribute\":\"_id\"}]}",
+         "{\"name\":\"v\",\"collection\":\"c\",\"aggregates\":[{\"name\":\"a\",\"function\":\"MEDIAN\",\"attribute\":\"a\"}]}",
+         "{\"name\":\"v\",\"collection\":\"c\",\"aggregates\":[{\"name\":\"a\",\"function\":\"SUM\"}]}",
+         "{\"name\":\"v\",\"collection\":\"c\",\"groups\":[{\"name\":\"a\",\"attribute\":\"a\"}],"
+         "\"aggregates\":[{\"name\":\"a\",\"function\":\"COUNT\"}]}"}) {
+    CHECK(AggregateView::create("db", VPackParser::fromJson(json)->slice(), view).fail());
+  }
+}
+
+SECTION("aggregates follow inserts, updates and removals") {
+  auto view = createView();
+  insert(*view, "{\"_key\":\"1\",\"group\":\"a\",\"value\":1}");
+  insert(*view, "{\"_key\":\"2\",\"group\":\"a\",\"value\":5}");
+  insert(*view, "{\"_key\":\"3\",\"group\":\"b\",\"value\":2}");
+  insert(*view, "{\"_key\":\"4\",\"value\":3}");
+
+  VPackBuilder builder = result(*view);
+  VPackSlice groups = builder.slice().get("result");
+  REQUIRE(groups.length() == 3);
+  // groups are sorted by their keys, null first
+  CHECK(groups[0].get("g").isNull());
+  VPackSlice a = groups[1];
+  CHECK(a.get("g").copyString() == "a");
+  CHECK(a.get("count").getNumber<uint64_t>() == 2);
+  CHECK(a.get("sum").getNumber<double>() == 6.0);
+  CHECK(a.get("avg").getNumber<double>() == 3.0);
+  CHECK(a.get("min").getNumber<int>() == 1);
+  CHECK(a.get("max").getNumber<int>() == 5);
+
+  // updating the minimum makes it stale, so it is recomputed
+  insert(*view, "{\"_key\":\"1\",\"group\":\"a\",\"value\":4}");
+  builder = result(*view);
+  a = builder.slice().get("result")[1];
+  CHECK(a.get("count").getNumber<uint64_t>() == 2);
+  CHECK(a.get("sum").getNumber<double>() == 9.0);
+  CHECK(a.get("min").getNumber<int>() == 4);
+
+  view->remove(VPackParser::fromJson("{\"_key\":\"2\"}")->slice());
+  builder = result(*view);
+  a = builder.slice().get("result")[1];
+  CHECK(a.get("count").getNumber<uint64_t>() == 1);
+  CHECK(a.get("max").getNumber<int>() == 4);
+
+  // moving the last document into another group removes the group
+  insert(*view, "{\"_key\":\"1\",\"group\":\"b\",\"value\":4}");
+  builder = result(*view);
+  groups = builder.slice().get("result");
+  REQUIRE(groups.length() == 2);
+  CHECK(groups[1].get("g").copyString() == "b");
+  CHECK(groups[1].get("count").getNumber<uint64_t>() == 2);
+  CHECK(groups[1].get("min").getNumber<int>() == 2);
+}
+
+SECTION("null and invalid values follow the AQL semantics") {
+  auto view = createView();
+  insert(*view, "{\"_key\":\"1\",\"group\":\"a\",\"value\":null}");
+  insert(*view, "{\"_key\":\"2\",\"group\":\"a\",\"value\":2}");
+
+  VPackBuilder builder = result(*view);
+  VPackSlice a = builder.slice().get("result")[0];
+  CHECK(a.get("sum").getNumber<double>() == 2.0);
+  CHECK(a.get("avg").getNumber<double>() == 2.0);
+  CHECK(a.get("min").getNumber<int>() == 2);
+  CHECK(a.get("max").getNumber<int>() == 2);
+
+  insert(*view, "{\"_key\":\"3\",\"group\":\"a\",\"value\":\"foo\"}");
+  builder = result(*view);
+  a = builder.slice().get("result")[0];
+  CHECK(a.get("sum").isNull());
+  CHECK(a.get("avg").isNull());
+  CHECK(a.get("max").copyString() == "foo");
+
+  view->remove(VPackParser::fromJson("{\"_key\":\"3\"}")->slice());
+  builder = result(*view);
+  a = builder.slice().get("result")[0];
+  CHECK(a.get("sum").getNumber<double>() == 2.0);
+  CHECK(a.get("max").getNumber<int>() == 2);
+
+  view->clear();
+  builder = result(*view);
+  CHECK(!builder.slice().get("ready").getBool());
+  CHECK(builder.slice().get("result").length() == 0);
+}
+
+}